@@ -34,7 +34,13 @@ rapids_find_package(CUDAToolkit REQUIRED
   INSTALL_EXPORT_SET ${PROJECT_NAME}-core-exports
 )
 
-rapids_find_package(ZLIB
+rapids_find_package(ZLIB REQUIRED
+  BUILD_EXPORT_SET ${PROJECT_NAME}-core-exports
+  INSTALL_EXPORT_SET ${PROJECT_NAME}-core-exports
+)
+
+# UCX, used by the boundary stages spanning two nodes
+rapids_find_package(ucx REQUIRED
   BUILD_EXPORT_SET ${PROJECT_NAME}-core-exports
   INSTALL_EXPORT_SET ${PROJECT_NAME}-core-exports
 )
@@ -0,0 +1,92 @@
+# =============================================================================
+# Copyright (c) 2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+# in compliance with the License. You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software distributed under the License
+# is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+# or implied. See the License for the specific language governing permissions and limitations under
+# the License.
+# =============================================================================
+
+# TensorRT is installed either from the system packages or from the tar archive. For the archive, run
+# `set(TensorRT_ROOT "/path/to/TensorRT")` before calling this file
+
+# Create a scope to allow variables to be set locally without altering the parent scope
+block(SCOPE_FOR VARIABLES
+  PROPAGATE
+    TensorRT_FOUND
+    TensorRT_VERSION
+)
+
+  # The runtime is usually installed on the host, allow it to be searched for
+  set("CMAKE_FIND_ROOT_PATH_MODE_INCLUDE" BOTH)
+  set("CMAKE_FIND_ROOT_PATH_MODE_LIBRARY" BOTH)
+
+  # Find the include path
+  find_path(
+    TensorRT_INCLUDE_DIR NvInfer.h
+    PATH_SUFFIXES include
+  )
+  mark_as_advanced(TensorRT_INCLUDE_DIR)
+
+  # Only the runtime is needed to deserialize and run engines
+  find_library(
+    TensorRT_LIBRARY
+    NAMES nvinfer
+    PATH_SUFFIXES lib lib64
+  )
+  mark_as_advanced(TensorRT_LIBRARY)
+
+  macro(parse_define_number define_name file_string output_variable)
+    string(REGEX MATCH "#define ${define_name} ([0-9]+)" _ "${file_string}")
+    set(${output_variable} "${CMAKE_MATCH_1}")
+  endmacro()
+
+  # Parse the version number
+  if (TensorRT_INCLUDE_DIR)
+
+    find_file(TensorRT_VERSION_FILE
+      NAMES NvInferVersion.h
+      PATHS ${TensorRT_INCLUDE_DIR}
+      NO_DEFAULT_PATH
+    )
+    mark_as_advanced(TensorRT_VERSION_FILE)
+
+    if (TensorRT_VERSION_FILE)
+
+      file(READ ${TensorRT_VERSION_FILE} version_file_string)
+
+      parse_define_number(NV_TENSORRT_MAJOR "${version_file_string}" TensorRT_VERSION_MAJOR)
+      parse_define_number(NV_TENSORRT_MINOR "${version_file_string}" TensorRT_VERSION_MINOR)
+      parse_define_number(NV_TENSORRT_PATCH "${version_file_string}" TensorRT_VERSION_PATCH)
+
+      # Set the version variable
+      set(TensorRT_VERSION "${TensorRT_VERSION_MAJOR}.${TensorRT_VERSION_MINOR}.${TensorRT_VERSION_PATCH}")
+
+    endif()
+
+  endif()
+
+  include(FindPackageHandleStandardArgs)
+  find_package_handle_standard_args(TensorRT
+    FOUND_VAR TensorRT_FOUND
+    REQUIRED_VARS
+      TensorRT_INCLUDE_DIR
+      TensorRT_LIBRARY
+    VERSION_VAR TensorRT_VERSION
+  )
+
+  if(TensorRT_FOUND AND NOT TARGET TensorRT::nvinfer)
+    add_library(TensorRT::nvinfer UNKNOWN IMPORTED GLOBAL)
+    set_target_properties(TensorRT::nvinfer PROPERTIES
+      IMPORTED_LINK_INTERFACE_LANGUAGES "CXX"
+      IMPORTED_LOCATION "${TensorRT_LIBRARY}"
+      INTERFACE_INCLUDE_DIRECTORIES "${TensorRT_INCLUDE_DIR}"
+    )
+  endif()
+
+endblock()
@@ -11,5 +11,5 @@ __all__ = [
 
 
 class RabbitMQSourceStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, host: str, exchange: str, exchange_type: str = 'fanout', queue_name: str = '', poll_interval: datetime.timedelta = datetime.timedelta(microseconds=100000)) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, host: str, exchange: str, exchange_type: str = 'fanout', queue_name: str = '', poll_interval: datetime.timedelta = datetime.timedelta(microseconds=100000), batch_size: int = 128, batch_timeout: datetime.timedelta = datetime.timedelta(microseconds=10000), prefetch_count: int = 256) -> None: ...
     pass
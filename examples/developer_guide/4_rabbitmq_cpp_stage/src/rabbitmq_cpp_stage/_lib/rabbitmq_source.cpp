@@ -20,7 +20,7 @@
 #include <SimpleAmqpClient/BasicMessage.h>
 #include <SimpleAmqpClient/Channel.h>
 #include <SimpleAmqpClient/Envelope.h>
-#include <cudf/io/json.hpp>
+#include <cudf/io/types.hpp>  // for table_with_metadata
 #include <glog/logging.h>
 #include <morpheus/messages/meta.hpp>
 #include <pybind11/attr.h>
@@ -28,10 +28,13 @@
 #include <pybind11/pybind11.h>
 #include <pymrc/utils.hpp>
 
+#include <algorithm>  // for max
 #include <exception>
 #include <sstream>
-#include <thread>  // for std::this_thread::sleep_for
+#include <stdexcept>  // for invalid_argument
+#include <string_view>
 #include <utility>
+#include <vector>
 
 // IWYU pragma: no_include <boost/smart_ptr/detail/operator_bool.hpp>
 // IWYU pragma: no_include <boost/smart_ptr/shared_ptr.hpp>
@@ -42,11 +45,24 @@ RabbitMQSourceStage::RabbitMQSourceStage(const std::string& host,
                                          const std::string& exchange,
                                          const std::string& exchange_type,
                                          const std::string& queue_name,
-                                         std::chrono::milliseconds poll_interval) :
+                                         std::chrono::milliseconds poll_interval,
+                                         std::size_t batch_size,
+                                         std::chrono::milliseconds batch_timeout,
+                                         uint16_t prefetch_count,
+                                         const std::string& payload_format) :
   PythonSource(build()),
   m_poll_interval{poll_interval},
-  m_channel{AmqpClient::Channel::Create(host)}
+  m_batch_size{batch_size},
+  m_batch_timeout{batch_timeout},
+  m_prefetch_count{prefetch_count},
+  m_decoder{PayloadDecoder::create(payload_format)}
 {
+    if (m_batch_size == 0 || m_prefetch_count < m_batch_size)
+    {
+        throw std::invalid_argument("prefetch_count must be at least batch_size, and batch_size greater than zero");
+    }
+
+    m_channel = AmqpClient::Channel::Create(host);
     m_channel->DeclareExchange(exchange, exchange_type);
     m_queue_name = m_channel->DeclareQueue(queue_name);
     m_channel->BindQueue(m_queue_name, exchange);
@@ -73,36 +89,95 @@ RabbitMQSourceStage::subscriber_fn_t RabbitMQSourceStage::build()
 
 void RabbitMQSourceStage::source_generator(rxcpp::subscriber<RabbitMQSourceStage::source_type_t> subscriber)
 {
-    const std::string consumer_tag = m_channel->BasicConsume(m_queue_name, "", true, false);
+    // The prefetch count is set with basic.qos, the broker pushing messages ahead of the calls to BasicConsumeMessage
+    const std::string consumer_tag = m_channel->BasicConsume(m_queue_name, "", true, false, true, m_prefetch_count);
     while (subscriber.is_subscribed())
     {
-        AmqpClient::Envelope::ptr_t envelope;
-        if (m_channel->BasicConsumeMessage(consumer_tag, envelope, 0))
+        auto envelopes = consume_batch(consumer_tag);
+        if (envelopes.empty())
         {
-            try
-            {
-                auto table   = from_json(envelope->Message()->Body());
-                auto message = MessageMeta::create_from_cpp(std::move(table), 0);
-                subscriber.on_next(std::move(message));
-            } catch (const std::exception& e)
-            {
-                LOG(ERROR) << "Error occurred converting RabbitMQ message to Dataframe: " << e.what();
-            }
-            m_channel->BasicAck(envelope);
+            continue;
         }
-        else
+
+        emit_batch(subscriber, envelopes);
+
+        // Acknowledges every message of the batch, delivery tags being increasing on a channel
+        m_channel->BasicAck(envelopes.back()->GetDeliveryInfo(), true);
+    }
+}
+
+std::vector<AmqpClient::Envelope::ptr_t> RabbitMQSourceStage::consume_batch(const std::string& consumer_tag)
+{
+    std::vector<AmqpClient::Envelope::ptr_t> envelopes;
+    AmqpClient::Envelope::ptr_t envelope;
+
+    // Blocks until a message arrives, waking up every poll interval to check whether we are still subscribed
+    if (!m_channel->BasicConsumeMessage(consumer_tag, envelope, static_cast<int>(m_poll_interval.count())))
+    {
+        return envelopes;
+    }
+
+    envelopes.reserve(m_batch_size);
+    envelopes.push_back(std::move(envelope));
+
+    const auto deadline = std::chrono::steady_clock::now() + m_batch_timeout;
+    while (envelopes.size() < m_batch_size)
+    {
+        const auto remaining =
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+
+        // A timeout of zero would not wait for the messages already on their way
+        if (remaining.count() <= 0 ||
+            !m_channel->BasicConsumeMessage(consumer_tag, envelope, std::max<int>(remaining.count(), 1)))
         {
-            // Sleep when there are no messages
-            std::this_thread::sleep_for(m_poll_interval);
+            break;
         }
+
+        envelopes.push_back(std::move(envelope));
     }
+
+    return envelopes;
 }
 
-cudf::io::table_with_metadata RabbitMQSourceStage::from_json(const std::string& body) const
+void RabbitMQSourceStage::emit_batch(rxcpp::subscriber<source_type_t>& subscriber,
+                                     const std::vector<AmqpClient::Envelope::ptr_t>& envelopes) const
 {
-    cudf::io::source_info source{body.c_str(), body.size()};
-    auto options = cudf::io::json_reader_options::builder(source).lines(true);
-    return cudf::io::read_json(options.build());
+    // The bodies are owned by the envelopes, which outlive the decoding
+    std::vector<std::string_view> payloads;
+    payloads.reserve(envelopes.size());
+    for (const auto& envelope : envelopes)
+    {
+        payloads.emplace_back(envelope->Message()->Body());
+    }
+
+    std::shared_ptr<MessageMeta> message;
+    try
+    {
+        message = MessageMeta::create_from_cpp(m_decoder->decode(payloads), 0);
+    } catch (const std::exception& e)
+    {
+        LOG(WARNING) << "Error occurred converting a batch of " << envelopes.size()
+                     << " RabbitMQ messages to Dataframe, converting them one at a time: " << e.what();
+    }
+
+    if (message)
+    {
+        subscriber.on_next(std::move(message));
+        return;
+    }
+
+    for (const auto& payload : payloads)
+    {
+        try
+        {
+            auto table   = m_decoder->decode({payload});
+            auto message = MessageMeta::create_from_cpp(std::move(table), 0);
+            subscriber.on_next(std::move(message));
+        } catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Error occurred converting RabbitMQ message to Dataframe: " << e.what();
+        }
+    }
 }
 
 void RabbitMQSourceStage::close()
@@ -121,10 +196,22 @@ std::shared_ptr<mrc::segment::Object<RabbitMQSourceStage>> RabbitMQSourceStageIn
     const std::string& exchange,
     const std::string& exchange_type,
     const std::string& queue_name,
-    std::chrono::milliseconds poll_interval)
+    std::chrono::milliseconds poll_interval,
+    std::size_t batch_size,
+    std::chrono::milliseconds batch_timeout,
+    uint16_t prefetch_count,
+    const std::string& payload_format)
 {
-    return builder.construct_object<RabbitMQSourceStage>(
-        name, host, exchange, exchange_type, queue_name, poll_interval);
+    return builder.construct_object<RabbitMQSourceStage>(name,
+                                                         host,
+                                                         exchange,
+                                                         exchange_type,
+                                                         queue_name,
+                                                         poll_interval,
+                                                         batch_size,
+                                                         batch_timeout,
+                                                         prefetch_count,
+                                                         payload_format);
 }
 
 namespace py = pybind11;
@@ -144,8 +231,12 @@ PYBIND11_MODULE(rabbitmq_cpp_stage, m)
              py::arg("host"),
              py::arg("exchange"),
              py::arg("exchange_type") = "fanout",
-             py::arg("queue_name")    = "",
-             py::arg("poll_interval") = 100ms);
+             py::arg("queue_name")     = "",
+             py::arg("poll_interval")  = 100ms,
+             py::arg("batch_size")     = 128,
+             py::arg("batch_timeout")  = 10ms,
+             py::arg("prefetch_count") = 256,
+             py::arg("payload_format") = "json");
 }
 
 }  // namespace morpheus_rabbit
@@ -18,18 +18,21 @@
 #pragma once
 
 #include <SimpleAmqpClient/Channel.h>
-#include <cudf/io/types.hpp>           // for cudf::io::table_with_metadata
-#include <morpheus/messages/meta.hpp>  // for MessageMeta
-#include <mrc/segment/builder.hpp>     // for Segment Builder
-#include <mrc/segment/object.hpp>      // for Segment Object
-#include <pymrc/node.hpp>              // for mrc::pymrc::PythonSource
+#include <SimpleAmqpClient/Envelope.h>
+#include <morpheus/io/payload_decoder.hpp>  // for PayloadDecoder
+#include <morpheus/messages/meta.hpp>         // for MessageMeta
+#include <mrc/segment/builder.hpp>            // for Segment Builder
+#include <mrc/segment/object.hpp>             // for Segment Object
+#include <pymrc/node.hpp>                     // for mrc::pymrc::PythonSource
 #include <rxcpp/rx.hpp>
 
-#include <chrono>  // for chrono::milliseconds
-#include <memory>  // for shared_ptr
+#include <chrono>   // for chrono::milliseconds
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint16_t
+#include <memory>   // for shared_ptr
 #include <string>
-#include <string_view>
 #include <thread>
+#include <vector>
 
 // IWYU pragma: no_include "morpheus/objects/data_table.hpp"
 // IWYU pragma: no_include <boost/fiber/context.hpp>
@@ -42,6 +45,12 @@ namespace morpheus_rabbit {
 using namespace std::literals;
 using namespace morpheus;
 
+/**
+ * @brief Source stage reading messages from a RabbitMQ queue, decoded by the `PayloadDecoder` registered as
+ * `payload_format`. Up to `batch_size` messages received within `batch_timeout` of the first one are decoded into a
+ * single DataFrame and acknowledged at once, the broker pushing up to `prefetch_count` unacknowledged messages ahead of
+ * the stage.
+ */
 class RabbitMQSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<MessageMeta>>
 {
   public:
@@ -49,21 +58,47 @@ class RabbitMQSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<Mess
     using typename base_t::source_type_t;
     using typename base_t::subscriber_fn_t;
 
+    /**
+     * @throws std::invalid_argument If `batch_size` is zero or `prefetch_count` is less than `batch_size`, as a batch
+     * could then never fill up
+     * @throws std::runtime_error If no decoder is registered as `payload_format`
+     */
     RabbitMQSourceStage(const std::string& host,
                         const std::string& exchange,
                         const std::string& exchange_type        = "fanout"s,
                         const std::string& queue_name           = ""s,
-                        std::chrono::milliseconds poll_interval = 100ms);
+                        std::chrono::milliseconds poll_interval = 100ms,
+                        std::size_t batch_size                  = 128,
+                        std::chrono::milliseconds batch_timeout = 10ms,
+                        uint16_t prefetch_count                 = 256,
+                        const std::string& payload_format       = "json"s);
 
     ~RabbitMQSourceStage() override = default;
 
   private:
     subscriber_fn_t build();
     void source_generator(rxcpp::subscriber<source_type_t> subscriber);
-    cudf::io::table_with_metadata from_json(const std::string& body) const;
+
+    /**
+     * @brief Waits up to `poll_interval` for a first message, then collects the messages received within
+     * `batch_timeout` of it, returning an empty batch when the queue stayed empty.
+     */
+    std::vector<AmqpClient::Envelope::ptr_t> consume_batch(const std::string& consumer_tag);
+
+    /**
+     * @brief Decodes the bodies of `envelopes` with a single call to the decoder. When this fails each body is decoded
+     * on its own, such that a malformed message only drops itself.
+     */
+    void emit_batch(rxcpp::subscriber<source_type_t>& subscriber,
+                    const std::vector<AmqpClient::Envelope::ptr_t>& envelopes) const;
+
     void close();
 
     std::chrono::milliseconds m_poll_interval;
+    std::size_t m_batch_size;
+    std::chrono::milliseconds m_batch_timeout;
+    uint16_t m_prefetch_count;
+    std::shared_ptr<PayloadDecoder> m_decoder;
     std::string m_queue_name;
     AmqpClient::Channel::ptr_t m_channel;
 };
@@ -83,7 +118,11 @@ struct RabbitMQSourceStageInterfaceProxy
                                                                            const std::string& exchange,
                                                                            const std::string& exchange_type,
                                                                            const std::string& queue_name,
-                                                                           std::chrono::milliseconds poll_interval);
+                                                                           std::chrono::milliseconds poll_interval,
+                                                                           std::size_t batch_size,
+                                                                           std::chrono::milliseconds batch_timeout,
+                                                                           uint16_t prefetch_count,
+                                                                           const std::string& payload_format);
 };
 #pragma GCC visibility pop
 }  // namespace morpheus_rabbit
@@ -15,16 +15,14 @@
 
 import logging
 import time
-from io import StringIO
 
 import mrc
 import pandas as pd
 import pika
 
-import cudf
-
 from morpheus.cli.register_stage import register_stage
 from morpheus.config import Config
+from morpheus.io.utils import decode_payloads
 from morpheus.messages.message_meta import MessageMeta
 from morpheus.pipeline.preallocator_mixin import PreallocatorMixin
 from morpheus.pipeline.single_output_source import SingleOutputSource
@@ -52,6 +50,17 @@ class RabbitMQSourceStage(PreallocatorMixin, SingleOutputSource):
         Name of the queue to listen to. If left blank, RabbitMQ will generate a random queue name bound to the exchange.
     poll_interval : str, optional
         Amount of time  between polling RabbitMQ for new messages
+    batch_size : int, optional
+        Maximum number of RabbitMQ messages parsed into a single DataFrame, only used by the C++ implementation.
+    batch_timeout : str, optional
+        Amount of time to wait for a batch to fill up after its first message, only used by the C++ implementation.
+    prefetch_count : int, optional
+        Number of unacknowledged messages RabbitMQ sends ahead of the stage, must be at least `batch_size`. Only used
+        by the C++ implementation.
+    payload_format : str, optional
+        Wire format of the message bodies, one of 'json' (JSON lines), 'arrow' (an Arrow IPC stream per message),
+        'parquet' or 'avro' (an object container file per message). The C++ implementation also accepts the formats of
+        decoders registered with the `PayloadDecoderRegistry`.
     """
 
     def __init__(self,
@@ -60,7 +69,11 @@ class RabbitMQSourceStage(PreallocatorMixin, SingleOutputSource):
                  exchange: str,
                  exchange_type: str = 'fanout',
                  queue_name: str = '',
-                 poll_interval: str = '100millis'):
+                 poll_interval: str = '100millis',
+                 batch_size: int = 128,
+                 batch_timeout: str = '10millis',
+                 prefetch_count: int = 256,
+                 payload_format: str = 'json'):
         super().__init__(config)
         self._host = host
         self._exchange = exchange
@@ -71,6 +84,10 @@ class RabbitMQSourceStage(PreallocatorMixin, SingleOutputSource):
         self._channel = None
 
         self._poll_interval = pd.Timedelta(poll_interval)
+        self._batch_size = batch_size
+        self._batch_timeout = pd.Timedelta(batch_timeout)
+        self._prefetch_count = prefetch_count
+        self._payload_format = payload_format
 
         # Flag to indicate whether or not we should stop
         self._stop_requested = False
@@ -95,7 +112,11 @@ class RabbitMQSourceStage(PreallocatorMixin, SingleOutputSource):
                                                           self._exchange,
                                                           self._exchange_type,
                                                           self._queue_name,
-                                                          self._poll_interval.to_pytimedelta())
+                                                          self._poll_interval.to_pytimedelta(),
+                                                          self._batch_size,
+                                                          self._batch_timeout.to_pytimedelta(),
+                                                          self._prefetch_count,
+                                                          self._payload_format)
         else:
             self.connect()
             node = builder.make_source(self.unique_name, self.source_generator)
@@ -121,8 +142,7 @@ class RabbitMQSourceStage(PreallocatorMixin, SingleOutputSource):
                 (method_frame, _, body) = self._channel.basic_get(self._queue_name)
                 if method_frame is not None:
                     try:
-                        buffer = StringIO(body.decode("utf-8"))
-                        df = cudf.io.read_json(buffer, orient='records', lines=True)
+                        df = decode_payloads([body], self._payload_format)
                         yield MessageMeta(df=df)
                     except Exception as ex:
                         logger.exception("Error occurred converting RabbitMQ message to Dataframe: %s", ex)
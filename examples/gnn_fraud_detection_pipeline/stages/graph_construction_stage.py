@@ -31,8 +31,7 @@ from morpheus.messages.message_meta import MessageMeta
 from morpheus.pipeline.single_port_stage import SinglePortStage
 from morpheus.pipeline.stage_schema import StageSchema
 
-from .model import build_fsi_graph
-from .model import prepare_data
+from .model import FsiGraphBuilder
 
 
 @dataclasses.dataclass
@@ -70,6 +69,7 @@ class FraudGraphConstructionStage(SinglePortStage):
         super().__init__(config)
         self._training_data = cudf.read_csv(training_file)
         self._column_names = self._training_data.columns.values.tolist()
+        self._graph_builder = FsiGraphBuilder(self._training_data)
 
     @property
     def name(self) -> str:
@@ -86,15 +86,7 @@ class FraudGraphConstructionStage(SinglePortStage):
 
     def _process_message(self, message: MultiMessage) -> FraudGraphMultiMessage:
 
-        _, _, _, test_index, _, graph_data = prepare_data(self._training_data, message.get_meta(self._column_names))
-
-        # meta columns to remove as node features
-        meta_cols = ['client_node', 'merchant_node', 'index']
-        graph, node_features = build_fsi_graph(graph_data, meta_cols)
-
-        # Convert to torch.tensor from cupy
-        test_index = torch.from_dlpack(test_index.values.toDlpack()).long()
-        node_features = node_features.float()
+        graph, node_features, test_index = self._graph_builder.build(message.get_meta(self._column_names))
 
         return FraudGraphMultiMessage.from_message(message,
                                                    graph=graph,
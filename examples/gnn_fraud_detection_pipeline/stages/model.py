@@ -508,3 +508,82 @@ def prepare_data(
                                                                 cdf['index'][train_size:],
                                                                 cdf)
     return train_data, test_data, train_index, test_index, labels, all_data
+
+
+def _to_tensor(values: cupy.ndarray) -> torch.Tensor:
+    return torch.from_dlpack(values.toDlpack())
+
+
+def _encode_nodes(training_nodes: torch.Tensor, test_nodes: torch.Tensor) -> torch.Tensor:
+    """Node index of each of the training then test node values, as assigned by `cudf.CategoricalIndex` codes."""
+    nodes = torch.cat([training_nodes, test_nodes])
+    categories = torch.unique(nodes, sorted=True)
+
+    return torch.searchsorted(categories, nodes)
+
+
+class FsiGraphBuilder:
+    """
+    Builds the graph of the training data extended by each batch of test data, producing the same graph, features and
+    test index as `build_fsi_graph` does for the combined data returned by `prepare_data`.
+
+    The training data is converted to device tensors once, each batch only concatenating its own tensors to them,
+    rather than having the whole training DataFrame concatenated, re-indexed and categorized again for every batch.
+
+    Parameters
+    ----------
+    training_data : cudf.DataFrame
+        Training data seeding the graph, with the `client_node`, `merchant_node`, `index` and `fraud_label` columns.
+    """
+
+    NON_FEATURE_COLUMNS = ['client_node', 'merchant_node', 'index', 'fraud_label']
+
+    def __init__(self, training_data: cf.DataFrame):
+        self._feature_columns = [col for col in training_data.columns if col not in self.NON_FEATURE_COLUMNS]
+
+        (self._features, self._clients, self._merchants,
+         self._transactions) = self._to_tensors(training_data)
+
+    def _to_tensors(self, data: cf.DataFrame) -> (torch.Tensor, torch.Tensor, torch.Tensor, torch.Tensor):
+        features = _to_tensor(data[self._feature_columns].values.astype(cupy.float64))
+        clients = _to_tensor(data['client_node'].values).long()
+        merchants = _to_tensor(data['merchant_node'].values).long()
+
+        # Like the `reset_index` of `prepare_data`, the transaction nodes are the row labels of the DataFrames
+        transactions = _to_tensor(data.index.values).long()
+
+        return features, clients, merchants, transactions
+
+    def build(self, test_data: cf.DataFrame) -> (dgl.DGLHeteroGraph, torch.Tensor, torch.Tensor):
+        """
+        Build the graph of the training data and `test_data`.
+
+        Parameters
+        ----------
+        test_data : cudf.DataFrame
+            Test data, with the same columns as the training data.
+
+        Returns
+        -------
+        tuple
+            The graph, the normalized feature tensor of the training then test transactions, and the transaction node
+            of each row of `test_data`.
+        """
+        features, clients, merchants, transactions = self._to_tensors(test_data)
+
+        features = torch.cat([self._features, features])
+        features = (features - features.mean(0, keepdim=True)) / (0.0001 + features.std(0, keepdim=True))
+
+        client_tensor = _encode_nodes(self._clients, clients)
+        merchant_tensor = _encode_nodes(self._merchants, merchants)
+        transaction_tensor = torch.cat([self._transactions, transactions])
+
+        edge_list = {
+            ('client', 'buy', 'transaction'): (client_tensor, transaction_tensor),
+            ('transaction', 'bought', 'client'): (transaction_tensor, client_tensor),
+            ('transaction', 'issued', 'merchant'): (transaction_tensor, merchant_tensor),
+            ('merchant', 'sell', 'transaction'): (merchant_tensor, transaction_tensor)
+        }
+        graph = dgl.heterograph(edge_list)
+
+        return graph, features, transactions
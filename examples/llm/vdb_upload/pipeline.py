@@ -24,6 +24,7 @@ from morpheus.stages.general.monitor_stage import MonitorStage
 from morpheus.stages.general.trigger_stage import TriggerStage
 from morpheus.stages.inference.triton_inference_stage import TritonInferenceStage
 from morpheus.stages.output.write_to_vector_db_stage import WriteToVectorDBStage
+from morpheus.stages.postprocess.normalize_embeddings_stage import NormalizeEmbeddingsStage
 from morpheus.stages.preprocess.preprocess_nlp_stage import PreprocessNLPStage
 
 logger = logging.getLogger(__name__)
@@ -59,6 +60,7 @@ def pipeline(pipeline_config: Config,
     """
 
     isolate_embeddings = embeddings_config.get('isolate_embeddings', False)
+    normalize_embeddings = embeddings_config.get('normalize_embeddings', False)
 
     pipe = Pipeline(pipeline_config)
 
@@ -78,6 +80,10 @@ def pipeline(pipeline_config: Config,
     monitor_2 = pipe.add_stage(
         MonitorStage(pipeline_config, description="Inference rate", unit="events", delayed_start=True))
 
+    normalize_stage = None
+    if (normalize_embeddings):
+        normalize_stage = pipe.add_stage(NormalizeEmbeddingsStage(pipeline_config))
+
     vector_db = pipe.add_stage(WriteToVectorDBStage(pipeline_config, **vdb_config))
 
     monitor_3 = pipe.add_stage(
@@ -96,7 +102,12 @@ def pipeline(pipeline_config: Config,
     pipe.add_edge(nlp_stage, monitor_1)
     pipe.add_edge(monitor_1, embedding_stage)
     pipe.add_edge(embedding_stage, monitor_2)
-    pipe.add_edge(monitor_2, vector_db)
+
+    if (normalize_stage is not None):
+        pipe.add_edge(monitor_2, normalize_stage)
+        pipe.add_edge(normalize_stage, vector_db)
+    else:
+        pipe.add_edge(monitor_2, vector_db)
     pipe.add_edge(vector_db, monitor_3)
 
     start_time = time.time()
@@ -48,6 +48,9 @@ class LogParsingPostProcessingStage(SinglePortStage):
             Model vocab file to use for post-processing
         model_config_path : pathlib.Path, exists = True, dir_okay = False
             Model config file
+
+        When the C++ execution is enabled, the entities are decoded on the GPU for the whole message at once, with the
+        same output as the python implementation.
         """
         super().__init__(c)
 
@@ -72,7 +75,7 @@ class LogParsingPostProcessingStage(SinglePortStage):
         return "logparsing-postproc"
 
     def supports_cpp_node(self):
-        return False
+        return True
 
     def accepted_types(self) -> typing.Tuple:
         return (MultiResponseMessage, )
@@ -165,8 +168,15 @@ class LogParsingPostProcessingStage(SinglePortStage):
 
     def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
 
-        # Convert the messages to rows of strings
-        node = builder.make_node(self.unique_name, ops.map(self._postprocess))
+        if self._build_cpp_node():
+            import morpheus._lib.stages as _stages
+            node = _stages.LogParsingPostprocessStage(builder,
+                                                      self.unique_name,
+                                                      vocab_path=str(self._vocab_path),
+                                                      id2label=self._label_map)
+        else:
+            # Convert the messages to rows of strings
+            node = builder.make_node(self.unique_name, ops.map(self._postprocess))
 
         builder.make_edge(input_node, node)
 
@@ -15,6 +15,7 @@
 import dataclasses
 import typing
 
+import cupy as cp
 import pandas as pd
 
 
@@ -31,11 +32,12 @@ class FeatureConfig:
 @dataclasses.dataclass
 class SnapshotData:
     """
-    This dataclass holds appshield snapshot data.
+    This dataclass holds the appshield snapshots of a process, the features of each snapshot being a row of `data`,
+    which stays on the device.
     """
 
-    snapshot_id: int
-    data: typing.List[float]
+    snapshot_ids: typing.List[int]
+    data: cp.ndarray
 
 
 @dataclasses.dataclass
@@ -15,8 +15,11 @@
 import typing
 
 import mrc
+import numpy as np
+import pandas as pd
 from mrc.core import operators as ops
 
+import cudf
 from dask.distributed import Client
 
 from common.data_models import FeatureConfig  # pylint: disable=no-name-in-module
@@ -24,6 +27,7 @@ from common.feature_extractor import FeatureExtractor  # pylint: disable=no-name
 from morpheus.cli.register_stage import register_stage
 from morpheus.config import Config
 from morpheus.config import PipelineModes
+from morpheus.messages import MessageMeta
 from morpheus.messages import MultiMessage
 from morpheus.pipeline.multi_message_stage import MultiMessageStage
 from morpheus.stages.input.appshield_source_stage import AppShieldMessageMeta
@@ -48,6 +52,9 @@ class CreateFeaturesRWStage(MultiMessageStage):
         Number of dask workers.
     threads_per_worker: int, default = 2
         Number of threads for each dask worker.
+
+    When the C++ execution is enabled, the features of all the snapshots of a batch are computed on the GPU by a
+    single groupby, and the dask workers are not used.
     """
 
     def __init__(
@@ -61,6 +68,7 @@ class CreateFeaturesRWStage(MultiMessageStage):
     ):
         self._client = Client(threads_per_worker=threads_per_worker, n_workers=n_workers)
         self._feature_config = FeatureConfig(file_extns, interested_plugins)
+        self._feature_columns = feature_columns
         self._feas_all_zeros = dict.fromkeys(feature_columns, 0)
 
         # FeatureExtractor instance to extract features from the snapshots.
@@ -79,7 +87,22 @@ class CreateFeaturesRWStage(MultiMessageStage):
         return (AppShieldMessageMeta, )
 
     def supports_cpp_node(self):
-        return False
+        return True
+
+    def to_cpp_meta(self, x: AppShieldMessageMeta) -> MessageMeta:
+        """
+        Moves the snapshots to a cudf backed `MessageMeta`, read by the C++ stage.
+        """
+
+        df = x.df
+
+        # The plugins mix numbers and strings in some columns, which cudf can't hold
+        for col in df.columns[df.dtypes == object]:
+            df[col] = df[col].where(df[col].isna(), df[col].astype(str))
+
+        df["CommitCharge"] = pd.to_numeric(df["CommitCharge"], errors="coerce")
+
+        return MessageMeta(cudf.from_pandas(df, nan_as_null=True).reset_index(drop=True))
 
     def on_next(self, x: AppShieldMessageMeta):
 
@@ -127,24 +150,23 @@ class CreateFeaturesRWStage(MultiMessageStage):
 
         return meta
 
-    def create_multi_messages(self, x: AppShieldMessageMeta) -> typing.List[MultiMessage]:
+    def create_multi_messages(self, x: MessageMeta) -> typing.List[MultiMessage]:
 
         multi_messages = []
 
-        df = x.df
+        with x.mutable_dataframe() as df:
+            pid_processes = df["pid_process"]
+            if (isinstance(pid_processes, cudf.Series)):
+                pid_processes = pid_processes.to_pandas()
 
-        pid_processes = df.pid_process.unique()
+            pid_processes = pid_processes.to_numpy()
 
         # Create multi messaage per pid_process, this assumes that the DF has been sorted by the `pid_process` column
-        for pid_process in pid_processes:
-
-            pid_process_index = df[df.pid_process == pid_process].index
+        starts = np.flatnonzero(np.r_[True, pid_processes[1:] != pid_processes[:-1]])
+        stops = np.r_[starts[1:], len(pid_processes)]
 
-            start = pid_process_index.min()
-            stop = pid_process_index.max() + 1
-            mess_count = stop - start
-
-            multi_message = MultiMessage(meta=x, mess_offset=start, mess_count=mess_count)
+        for (start, stop) in zip(starts, stops):
+            multi_message = MultiMessage(meta=x, mess_offset=int(start), mess_count=int(stop - start))
             multi_messages.append(multi_message)
 
         return multi_messages
@@ -154,6 +176,26 @@ class CreateFeaturesRWStage(MultiMessageStage):
         self._client.close()
 
     def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if self._build_cpp_node():
+            import morpheus._lib.stages as _stages
+
+            to_cpp_node = builder.make_node(self.unique_name + "-to-cpp", ops.map(self.to_cpp_meta))
+            builder.make_edge(input_node, to_cpp_node)
+
+            features_node = _stages.AppShieldFeaturesStage(builder,
+                                                           self.unique_name,
+                                                           feature_columns=self._feature_columns,
+                                                           file_extns=self._feature_config.file_extns)
+            builder.make_edge(to_cpp_node, features_node)
+
+            node = builder.make_node(self.unique_name + "-split",
+                                     ops.map(self.create_multi_messages),
+                                     ops.on_completed(self.on_completed),
+                                     ops.flatten())
+            builder.make_edge(features_node, node)
+
+            return node
+
         node = builder.make_node(self.unique_name,
                                  ops.map(self.on_next),
                                  ops.map(self.create_multi_messages),
@@ -16,6 +16,7 @@ import typing
 
 import cupy as cp
 import mrc
+import numpy as np
 import pandas as pd
 
 from common.data_models import SnapshotData  # pylint: disable=no-name-in-module
@@ -55,7 +56,7 @@ class PreprocessingRWStage(PreprocessBaseStage):
         self._features_len = len(self._feature_columns)
 
         # Stateful member to hold unprocessed snapshots.
-        self._snapshot_dict: typing.Dict[str, typing.List[SnapshotData]] = {}
+        self._snapshot_dict: typing.Dict[str, SnapshotData] = {}
 
         # Padding data to map inference response with input messages.
         self._padding_data = [0 for i in range(self._features_len * sliding_window)]
@@ -90,36 +91,38 @@ class PreprocessingRWStage(PreprocessBaseStage):
     def _rollover_pending_snapshots(self,
                                     snapshot_ids: typing.List[int],
                                     source_pid_process: str,
-                                    snapshot_df: pd.DataFrame):
+                                    snapshot_data: cp.ndarray):
         """
         Store the unprocessed snapshots from current run to a stateful member to process them in the next run.
+        The rows of `snapshot_data` hold the features of `snapshot_ids`, the pending rows are copied so the rest of the
+        batch can be released.
         """
 
-        pending_snapshots = []
+        pending_ids = list(snapshot_ids[1 - self._sliding_window:])
 
-        for snapshot_id in snapshot_ids[1 - self._sliding_window:]:
-            pending_snapshot_data = snapshot_df[snapshot_df.index == snapshot_id].values[0]
-            pending_snapshot = SnapshotData(snapshot_id, pending_snapshot_data)
-            pending_snapshots.append(pending_snapshot)
+        if pending_ids:
+            pending_data = snapshot_data[len(snapshot_ids) - len(pending_ids):].copy()
+            self._snapshot_dict[source_pid_process] = SnapshotData(pending_ids, pending_data)
 
-        if pending_snapshots:
-            self._snapshot_dict[source_pid_process] = pending_snapshots
-
-    def _merge_curr_and_prev_snapshots(self, snapshot_df: pd.DataFrame, source_pid_process: str) -> pd.DataFrame:
+    def _merge_curr_and_prev_snapshots(self, snapshot_ids: np.ndarray, snapshot_data: cp.ndarray,
+                                       source_pid_process: str) -> typing.Tuple[np.ndarray, cp.ndarray]:
         """
-        Merge current run snapshots with previous unprocessed snapshots.
+        Merge current run snapshots with previous unprocessed snapshots, returning the ids and the data of the snapshots
+        sorted by id. A pending snapshot replaces the current snapshot with the same id.
         """
 
-        prev_pending_snapshots = self._snapshot_dict[source_pid_process]
+        pending = self._snapshot_dict[source_pid_process]
+        pending_ids = np.asarray(pending.snapshot_ids, dtype=snapshot_ids.dtype)
+
+        is_current = ~np.isin(snapshot_ids, pending_ids)
 
-        # If previous pending snapshots that exists in the memory. Just get them to process in this run.
-        for prev_pending_snapshot in prev_pending_snapshots:
-            snapshot_df.loc[prev_pending_snapshot.snapshot_id] = prev_pending_snapshot.data
+        merged_ids = np.concatenate([pending_ids, snapshot_ids[is_current]])
+        merged_data = cp.concatenate([pending.data.astype(snapshot_data.dtype), snapshot_data[cp.asarray(is_current)]])
 
         # Keep snapshot_ids in order to generate sequence.
-        snapshot_df = snapshot_df.sort_index()
+        order = np.argsort(merged_ids, kind="stable")
 
-        return snapshot_df
+        return merged_ids[order], merged_data[cp.asarray(order)]
 
     def _pre_process_batch(self, x: MultiMessage) -> MultiInferenceFILMessage:
         """
@@ -131,52 +134,56 @@ class PreprocessingRWStage(PreprocessBaseStage):
         Current run's unprocessed snapshots will be rolled over to the next.
         """
 
-        snapshot_df = x.get_meta()
-        curr_snapshots_size = len(snapshot_df)
+        snapshot_ids = x.get_meta("snapshot_id")
+        curr_snapshots_size = len(snapshot_ids)
+
+        # Only the ids are copied to the host, the features of the snapshots stay on the device
+        if (not isinstance(snapshot_ids, pd.Series)):
+            snapshot_ids = snapshot_ids.to_pandas()
 
-        # Set snapshot_id as index this is used to get ordered snapshots based on sliding window.
-        snapshot_df.index = snapshot_df.snapshot_id
+        snapshot_ids = snapshot_ids.to_numpy()
 
         # Get source_pid_process.
-        source_pid_process = snapshot_df.source_pid_process.iloc[0]
+        source_pid_process = x.get_meta("source_pid_process").iloc[0]
 
         # Get only feature columns from the dataframe
-        snapshot_df = snapshot_df[self._feature_columns]
+        snapshot_data = cp.asarray(x.get_meta(self._feature_columns).values, dtype=cp.float64)
 
         # Get if there are any previous pending snapshots.
         if source_pid_process in self._snapshot_dict:
-            snapshot_df = self._merge_curr_and_prev_snapshots(snapshot_df, source_pid_process)
+            snapshot_ids, snapshot_data = self._merge_curr_and_prev_snapshots(snapshot_ids,
+                                                                              snapshot_data,
+                                                                              source_pid_process)
 
-        snapshot_ids = snapshot_df.index.values
-
-        curr_and_prev_snapshots_size = len(snapshot_df)
+        curr_and_prev_snapshots_size = len(snapshot_ids)
 
         # Make a dummy set of data and a dummy sequence.
         # When the number of snapshots received for the pid process is less than the sliding window supplied,
         # this is used. For each input message, this is used to construct inference output.
-        data = [self._padding_data] * curr_snapshots_size
+        data = cp.tile(cp.asarray(self._padding_data, dtype=snapshot_data.dtype), (curr_snapshots_size, 1))
         sequence = ["dummy"] * curr_snapshots_size
 
         if curr_and_prev_snapshots_size >= self._sliding_window:
             # Rollover and current snapshots are used to generate sliding window offsets
-            offsets = self._sliding_window_offsets(snapshot_ids,
+            offsets = self._sliding_window_offsets(list(snapshot_ids),
                                                    curr_and_prev_snapshots_size,
                                                    window=self._sliding_window)
 
-            # Generate data from the sliding window offsets.
+            if offsets:
+                # Gather the rows of every window at once, each window being flattened to a single row
+                starts = cp.asarray([start for (start, _) in offsets])
+                window_rows = starts[:, None] + cp.arange(self._sliding_window)
+                data[starts] = snapshot_data[window_rows].reshape(len(offsets), -1)
+
             for start, stop in offsets:
-                data[start] = list(snapshot_df[start:stop].values.ravel())
-                sequence[start] = str(snapshot_df.index[start]) + "-" + str(snapshot_df.index[stop - 1])
+                sequence[start] = str(snapshot_ids[start]) + "-" + str(snapshot_ids[stop - 1])
 
         # Rollover pending snapshots
-        self._rollover_pending_snapshots(snapshot_ids, source_pid_process, snapshot_df)
+        self._rollover_pending_snapshots(snapshot_ids, source_pid_process, snapshot_data)
 
         # This column is used to identify whether sequence is genuine or dummy
         x.set_meta('sequence', sequence)
 
-        # Convert data to cupy array
-        data = cp.asarray(data)
-
         seg_ids = cp.zeros((curr_snapshots_size, 3), dtype=cp.uint32)
         seg_ids[:, 0] = cp.arange(x.mess_offset, x.mess_offset + curr_snapshots_size, dtype=cp.uint32)
         seg_ids[:, 2] = self._features_len * 3
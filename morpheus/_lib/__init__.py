@@ -11,11 +11,8 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from . import common
-from . import llm
-from . import messages
-from . import modules
-from . import stages
+import importlib
+import typing
 
 __all__ = [
     "common",
@@ -24,3 +21,18 @@ __all__ = [
     "modules",
     "stages",
 ]
+
+# The extension modules are only loaded when first used, sparing processes which never use the LLM or module bindings
+# the cost of loading and registering them, along with the python modules they import. Importing a submodule directly,
+# such as `morpheus._lib.stages`, only loads it and the modules it depends on.
+
+
+def __getattr__(name: str) -> typing.Any:
+    if (name in __all__):
+        return importlib.import_module(f".{name}", __name__)
+
+    raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+
+
+def __dir__() -> typing.List[str]:
+    return sorted(list(globals().keys()) + __all__)
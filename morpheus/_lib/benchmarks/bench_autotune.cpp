@@ -0,0 +1,355 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Searches the options of the benchmark pipeline for the highest throughput meeting a latency SLO, on a sample of
+ * recorded input, with successive halving: every candidate runs on a few messages, the better half runs again on twice
+ * as many, and so on until a single one is left. Candidates meeting the SLO on their p99 batch latency rank by their
+ * throughput, ahead of those missing it, which rank by their latency.
+ *
+ *   bench_autotune --input=sample.jsonlines --model=fil --slo_ms=50 [--triton_url=localhost:8000 --model_name=abp]
+ *
+ * Infers with a mock client unless `--triton_url` is given. Writes the best options, and the throughput and latency of
+ * every candidate at every round, as JSON to `--output`, or to stdout.
+ */
+
+#include "pipeline_harness.hpp"
+
+#include "morpheus/io/deserializers.hpp"        // for load_table_from_file
+#include "morpheus/stages/triton_inference.hpp"  // for TritonInferenceClient, HttpTritonClient
+#include "morpheus/types.hpp"                    // for TensorIndex
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>  // for json
+#include <pybind11/embed.h>   // for scoped_interpreter
+#include <pybind11/gil.h>     // for gil_scoped_release
+
+#include <algorithm>  // for stable_sort, max, min
+#include <cstddef>    // for size_t
+#include <cstdint>    // for int64_t
+#include <exception>  // for exception
+#include <fstream>    // for ofstream
+#include <iostream>   // for cout, cerr
+#include <map>        // for map
+#include <memory>     // for make_unique
+#include <sstream>    // for istringstream
+#include <stdexcept>  // for invalid_argument
+#include <string>     // for string, stoll
+#include <utility>    // for move
+#include <vector>     // for vector
+
+using namespace morpheus;
+using namespace morpheus::bench;
+
+namespace {
+
+// Options of the tool, each given as `--name=value`, with their defaults
+const std::map<std::string, std::string> DefaultFlags{
+    {"input", ""},                           // Recorded input, in any format read by `load_table_from_file`
+    {"model", "fil"},                        // `fil`, every column being a feature, or `nlp`, tokenizing `data`
+    {"vocab", ""},                           // Vocabulary of `nlp`, defaults to the one of the repository
+    {"slo_ms", "100"},                       // p99 batch latency to meet
+    {"messages", "8"},                       // Copies of the input emitted by the first round
+    {"max_messages", "256"},                 // Copies of the input emitted by any round
+    {"batch_sizes", "256,1024,4096,16384"},  // `DeserializeStage` batch sizes
+    {"max_batch_rows", "0,8192,32768"},      // Rows the inference stage merges batches up to
+    {"sessions", "1,2,4"},                   // Inference sessions, the batches in flight
+    {"preprocess_threads", "1,2"},           // Threads of the preprocessing stage
+    {"triton_url", ""},                      // Triton HTTP endpoint, a mock client is used when empty
+    {"model_name", ""},                      // Triton model
+    {"output_name", "output__0"},            // Output of the model holding the scores
+    {"num_labels", "1"},                     // Columns of the scores
+    {"output", ""},                          // JSON report, written to stdout when empty
+};
+
+std::map<std::string, std::string> parse_flags(int argc, char** argv)
+{
+    auto flags = DefaultFlags;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg{argv[i]};
+        const auto equals = arg.find('=');
+
+        if (!arg.starts_with("--") || equals == std::string::npos || !flags.contains(arg.substr(2, equals - 2)))
+        {
+            throw std::invalid_argument("Unrecognized argument '" + arg + "'");
+        }
+
+        flags[arg.substr(2, equals - 2)] = arg.substr(equals + 1);
+    }
+
+    if (flags["input"].empty())
+    {
+        throw std::invalid_argument("--input is required");
+    }
+
+    if (flags["model"] != "fil" && flags["model"] != "nlp")
+    {
+        throw std::invalid_argument("--model must be one of fil or nlp");
+    }
+
+    if (!flags["triton_url"].empty() && flags["model_name"].empty())
+    {
+        throw std::invalid_argument("--model_name is required with --triton_url");
+    }
+
+    return flags;
+}
+
+std::vector<int64_t> parse_list(const std::string& values)
+{
+    std::vector<int64_t> list;
+
+    std::istringstream in_stream{values};
+    std::string value;
+    while (std::getline(in_stream, value, ','))
+    {
+        list.push_back(std::stoll(value));
+    }
+
+    if (list.empty())
+    {
+        throw std::invalid_argument("Empty list of candidate values");
+    }
+
+    return list;
+}
+
+struct Candidate
+{
+    PipelineOptions options;
+    PipelineResult result;
+
+    bool meets_slo(double slo_ms) const
+    {
+        return result.num_rows > 0 && result.latency_ms(0.99) <= slo_ms;
+    }
+
+    nlohmann::json to_json(double slo_ms) const
+    {
+        return {{"batch_size", options.batch_size},
+                {"max_batch_rows", options.max_batch_rows},
+                {"sessions", options.num_sessions},
+                {"preprocess_threads", options.preprocess_threads},
+                {"rows_per_second", result.rows_per_second()},
+                {"latency_p50_ms", result.latency_ms(0.50)},
+                {"latency_p90_ms", result.latency_ms(0.90)},
+                {"latency_p99_ms", result.latency_ms(0.99)},
+                {"meets_slo", meets_slo(slo_ms)}};
+    }
+};
+
+std::vector<Candidate> make_candidates(std::map<std::string, std::string>& flags)
+{
+    std::vector<Candidate> candidates;
+    for (auto batch_size : parse_list(flags["batch_sizes"]))
+    {
+        for (auto max_batch_rows : parse_list(flags["max_batch_rows"]))
+        {
+            // Merging batches up to fewer rows than a single one holds is a no-op
+            if (max_batch_rows > 0 && max_batch_rows < batch_size)
+            {
+                continue;
+            }
+
+            for (auto num_sessions : parse_list(flags["sessions"]))
+            {
+                for (auto preprocess_threads : parse_list(flags["preprocess_threads"]))
+                {
+                    Candidate candidate;
+                    candidate.options.batch_size         = static_cast<TensorIndex>(batch_size);
+                    candidate.options.max_batch_rows     = static_cast<TensorIndex>(max_batch_rows);
+                    candidate.options.num_sessions       = static_cast<std::size_t>(num_sessions);
+                    candidate.options.preprocess_threads = static_cast<std::size_t>(preprocess_threads);
+                    candidates.push_back(std::move(candidate));
+                }
+            }
+        }
+    }
+
+    return candidates;
+}
+
+int autotune(std::map<std::string, std::string>& flags)
+{
+    const auto slo_ms       = std::stod(flags["slo_ms"]);
+    const auto max_messages = std::stoll(flags["max_messages"]);
+    const auto num_labels   = static_cast<std::size_t>(std::stoll(flags["num_labels"]));
+    const auto is_nlp       = flags["model"] == "nlp";
+    const auto table        = load_table_from_file(flags["input"]);
+
+    std::vector<std::string> features;
+    for (const auto& column : table.metadata.schema_info)
+    {
+        features.push_back(column.name);
+    }
+
+    std::vector<std::string> model_inputs{"input__0"};
+    if (is_nlp)
+    {
+        model_inputs = {"input_ids", "input_mask"};
+    }
+
+    make_client_fn_t make_client = [&]() -> std::unique_ptr<IInferenceClient> {
+        if (flags["triton_url"].empty())
+        {
+            return std::make_unique<MockInferenceClient>(model_inputs, static_cast<TensorIndex>(num_labels));
+        }
+
+        return std::make_unique<TritonInferenceClient>(std::make_unique<HttpTritonClient>(flags["triton_url"]),
+                                                       flags["model_name"]);
+    };
+
+    auto vocab_file = flags["vocab"];
+    if (is_nlp && vocab_file.empty())
+    {
+        vocab_file = (get_morpheus_root() / "morpheus/data/bert-base-cased-hash.txt").string();
+    }
+
+    auto candidates = make_candidates(flags);
+    if (candidates.empty())
+    {
+        throw std::invalid_argument("No candidate options to search");
+    }
+
+    auto rounds     = nlohmann::json::array();
+
+    for (auto num_messages = std::stoll(flags["messages"]);; num_messages = std::min(2 * num_messages, max_messages))
+    {
+        benchmark::ClearRegisteredBenchmarks();
+        for (auto& candidate : candidates)
+        {
+            benchmark::RegisterBenchmark(
+                ("autotune/messages:" + std::to_string(num_messages) + "/" + candidate.options.to_string()).c_str(),
+                [&, num_messages](benchmark::State& state) {
+                    if (is_nlp)
+                    {
+                        candidate.result = run_pipeline(state,
+                                                        table,
+                                                        num_messages,
+                                                        candidate.options,
+                                                        make_client,
+                                                        flags["output_name"],
+                                                        num_labels,
+                                                        make_nlp_preprocess(vocab_file));
+                    }
+                    else
+                    {
+                        candidate.result = run_pipeline(state,
+                                                        table,
+                                                        num_messages,
+                                                        candidate.options,
+                                                        make_client,
+                                                        flags["output_name"],
+                                                        num_labels,
+                                                        make_fil_preprocess(features));
+                    }
+                })
+                ->Iterations(1)
+                ->Unit(benchmark::kMillisecond)
+                ->UseManualTime();
+        }
+
+        for (auto& candidate : candidates)
+        {
+            candidate.result = {};
+        }
+
+        benchmark::RunSpecifiedBenchmarks();
+
+        std::stable_sort(candidates.begin(), candidates.end(), [slo_ms](const Candidate& a, const Candidate& b) {
+            if (a.meets_slo(slo_ms) != b.meets_slo(slo_ms))
+            {
+                return a.meets_slo(slo_ms);
+            }
+
+            if (a.meets_slo(slo_ms))
+            {
+                return a.result.rows_per_second() > b.result.rows_per_second();
+            }
+
+            // Candidates filtered out by `--benchmark_filter` were not measured, and rank last
+            if ((a.result.num_rows > 0) != (b.result.num_rows > 0))
+            {
+                return a.result.num_rows > 0;
+            }
+
+            return a.result.latency_ms(0.99) < b.result.latency_ms(0.99);
+        });
+
+        auto measured = nlohmann::json::array();
+        for (const auto& candidate : candidates)
+        {
+            measured.push_back(candidate.to_json(slo_ms));
+        }
+
+        rounds.push_back({{"messages", num_messages}, {"candidates", std::move(measured)}});
+
+        if (candidates.size() == 1)
+        {
+            break;
+        }
+
+        candidates.resize(candidates.size() / 2);
+    }
+
+    const auto& best = candidates.front();
+    if (!best.meets_slo(slo_ms))
+    {
+        std::cerr << "No candidate meets the SLO of " << slo_ms << "ms, reporting the one of the lowest latency\n";
+    }
+
+    nlohmann::json report{{"slo_ms", slo_ms}, {"best", best.to_json(slo_ms)}, {"rounds", std::move(rounds)}};
+
+    if (flags["output"].empty())
+    {
+        std::cout << report.dump(2) << std::endl;
+    }
+    else
+    {
+        std::ofstream(flags["output"]) << report.dump(2) << std::endl;
+    }
+
+    return best.meets_slo(slo_ms) ? 0 : 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    // The stages are Python nodes and the inference stage runs an asyncio loop, the interpreter is initialized as it
+    // is by the tests
+    pybind11::scoped_interpreter interpreter;
+    pybind11::gil_scoped_release no_gil;
+
+    // Removes the `--benchmark_*` arguments, leaving those of the tool
+    benchmark::Initialize(&argc, argv);
+
+    int result = 1;
+    try
+    {
+        auto flags = parse_flags(argc, argv);
+        result     = autotune(flags);
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+    }
+
+    benchmark::Shutdown();
+
+    return result;
+}
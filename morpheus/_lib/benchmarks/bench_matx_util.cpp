@@ -0,0 +1,275 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/objects/dev_mem_info.hpp"       // for DevMemInfo
+#include "morpheus/objects/dtype.hpp"              // for DType, TypeId
+#include "morpheus/objects/memory_descriptor.hpp"  // for MemoryDescriptor
+#include "morpheus/types.hpp"                      // for ShapeType, TensorIndex
+#include "morpheus/utilities/matx_util.hpp"        // for MatxUtil
+
+#include <benchmark/benchmark.h>
+#include <cuda_runtime.h>                         // for cudaEventCreate, cudaEventElapsedTime, cudaDeviceGetAttribute
+#include <mrc/cuda/common.hpp>                    // for MRC_CHECK_CUDA
+#include <rmm/cuda_stream_view.hpp>               // for cuda_stream_per_thread
+#include <rmm/device_buffer.hpp>                  // for device_buffer
+#include <rmm/mr/device/per_device_resource.hpp>  // for get_current_device_resource
+
+#include <cstdint>  // for int64_t
+#include <memory>   // for make_shared, shared_ptr
+#include <utility>  // for move
+#include <vector>   // for vector
+
+using namespace morpheus;
+
+namespace {
+
+// Layout of the 2D inputs, `Padded` being row major with twice as many columns allocated as used
+enum class Layout : int64_t
+{
+    RowMajor    = 0,
+    ColumnMajor = 1,
+    Padded      = 2
+};
+
+// Input dtypes of the sweeps, by index
+const std::vector<TypeId> InputTypes{TypeId::FLOAT32, TypeId::FLOAT64};
+
+// Theoretical peak bandwidth of the current device in bytes per second, double data rate memory
+double peak_bytes_per_second()
+{
+    int device          = 0;
+    int memory_clock    = 0;  // kHz
+    int memory_bus_bits = 0;
+    MRC_CHECK_CUDA(cudaGetDevice(&device));
+    MRC_CHECK_CUDA(cudaDeviceGetAttribute(&memory_clock, cudaDevAttrMemoryClockRate, device));
+    MRC_CHECK_CUDA(cudaDeviceGetAttribute(&memory_bus_bits, cudaDevAttrGlobalMemoryBusWidth, device));
+
+    return 2.0 * memory_clock * 1000.0 * (memory_bus_bits / 8.0);
+}
+
+// A 2D input of `rows` by `cols` elements of `dtype` laid out as `layout`, filled with a constant such that every
+// value takes the same path through the kernels
+DevMemInfo make_input(TensorIndex rows, TensorIndex cols, DType dtype, Layout layout)
+{
+    const auto allocated_cols = layout == Layout::Padded ? 2 * cols : cols;
+
+    auto buffer =
+        std::make_shared<rmm::device_buffer>(rows * allocated_cols * dtype.item_size(), rmm::cuda_stream_per_thread);
+    MRC_CHECK_CUDA(cudaMemsetAsync(buffer->data(), 0, buffer->size(), rmm::cuda_stream_per_thread));
+
+    ShapeType stride;
+    switch (layout)
+    {
+    case Layout::RowMajor:
+        stride = {cols, 1};
+        break;
+    case Layout::ColumnMajor:
+        stride = {1, rows};
+        break;
+    case Layout::Padded:
+        stride = {allocated_cols, 1};
+        break;
+    }
+
+    return {std::move(buffer), std::move(dtype), {rows, cols}, std::move(stride)};
+}
+
+/**
+ * Runs `launch` once per iteration, reporting the GPU time of each call measured with events on the default stream,
+ * which the per-thread default stream the kernels run on synchronizes with. `bytes` is the minimum number of bytes
+ * each call reads and writes, the achieved bandwidth `gb_per_s` and its `peak_fraction` of the device's theoretical
+ * peak are derived from it. Output buffers are allocated by every call, as they are by the stages.
+ */
+template <typename LaunchFn>
+void run_kernel(benchmark::State& state, int64_t bytes, LaunchFn&& launch)
+{
+    cudaEvent_t start;
+    cudaEvent_t stop;
+    MRC_CHECK_CUDA(cudaEventCreate(&start));
+    MRC_CHECK_CUDA(cudaEventCreate(&stop));
+
+    // Warm up, the first call may initialize the allocator or load the kernel
+    launch();
+    MRC_CHECK_CUDA(cudaDeviceSynchronize());
+
+    double gpu_seconds = 0;
+
+    for (auto _ : state)
+    {
+        MRC_CHECK_CUDA(cudaEventRecord(start, 0));
+        launch();
+        MRC_CHECK_CUDA(cudaEventRecord(stop, 0));
+        MRC_CHECK_CUDA(cudaEventSynchronize(stop));
+
+        float elapsed_ms = 0;
+        MRC_CHECK_CUDA(cudaEventElapsedTime(&elapsed_ms, start, stop));
+        state.SetIterationTime(elapsed_ms / 1000.0);
+        gpu_seconds += elapsed_ms / 1000.0;
+    }
+
+    MRC_CHECK_CUDA(cudaEventDestroy(start));
+    MRC_CHECK_CUDA(cudaEventDestroy(stop));
+
+    const auto bytes_per_second = static_cast<double>(bytes) * state.iterations() / gpu_seconds;
+
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["gb_per_s"]      = benchmark::Counter(bytes_per_second / 1e9);
+    state.counters["peak_fraction"] = benchmark::Counter(bytes_per_second / peak_bytes_per_second());
+}
+
+// Args: rows, cols, input dtype
+void bench_cast(benchmark::State& state)
+{
+    const auto rows = state.range(0);
+    const auto cols = state.range(1);
+    DType dtype(InputTypes[state.range(2)]);
+
+    auto input = make_input(rows, cols, dtype, Layout::RowMajor);
+
+    // Casting to float64 is a copy when the input is already float64, cast to the other type of the sweep instead
+    const auto output_type = dtype.type_id() == TypeId::FLOAT64 ? TypeId::FLOAT32 : TypeId::FLOAT64;
+    const auto bytes       = rows * cols * (dtype.item_size() + DType(output_type).item_size());
+
+    run_kernel(state, bytes, [&]() {
+        benchmark::DoNotOptimize(MatxUtil::cast(input, output_type));
+    });
+}
+
+// Args: rows, output dtype (0 for int32, 1 for int64)
+void bench_create_seq_ids(benchmark::State& state)
+{
+    const auto rows = state.range(0);
+    DType dtype(state.range(1) == 0 ? TypeId::INT32 : TypeId::INT64);
+
+    const auto bytes = rows * 3 * dtype.item_size();
+
+    auto md = std::make_shared<MemoryDescriptor>(rmm::cuda_stream_per_thread, rmm::mr::get_current_device_resource());
+
+    run_kernel(state, bytes, [&]() {
+        benchmark::DoNotOptimize(MatxUtil::create_seq_ids(rows, 128, dtype.type_id(), md));
+    });
+}
+
+// Args: rows, cols, input dtype
+void bench_logits(benchmark::State& state)
+{
+    const auto rows = state.range(0);
+    const auto cols = state.range(1);
+    DType dtype(InputTypes[state.range(2)]);
+
+    auto input       = make_input(rows, cols, dtype, Layout::RowMajor);
+    const auto bytes = 2 * rows * cols * dtype.item_size();
+
+    run_kernel(state, bytes, [&]() {
+        benchmark::DoNotOptimize(MatxUtil::logits(input));
+    });
+}
+
+// Args: rows, cols, input dtype
+void bench_transpose(benchmark::State& state)
+{
+    const auto rows = state.range(0);
+    const auto cols = state.range(1);
+    DType dtype(InputTypes[state.range(2)]);
+
+    auto input       = make_input(rows, cols, dtype, Layout::RowMajor);
+    const auto bytes = 2 * rows * cols * dtype.item_size();
+
+    run_kernel(state, bytes, [&]() {
+        benchmark::DoNotOptimize(MatxUtil::transpose(input));
+    });
+}
+
+// Args: rows, cols, input dtype, layout, by_row. Padding is not counted as bytes read.
+void bench_threshold(benchmark::State& state)
+{
+    const auto rows   = state.range(0);
+    const auto cols   = state.range(1);
+    const bool by_row = state.range(4) != 0;
+    DType dtype(InputTypes[state.range(2)]);
+
+    auto input       = make_input(rows, cols, dtype, static_cast<Layout>(state.range(3)));
+    const auto bytes = rows * cols * dtype.item_size() + (by_row ? rows : rows * cols) * sizeof(bool);
+
+    run_kernel(state, bytes, [&]() {
+        benchmark::DoNotOptimize(MatxUtil::threshold(input, 0.5, by_row));
+    });
+}
+
+// Args: rows, cols, input dtype, layout. Every pair of input rows is reduced to one output row, the copy of the host
+// `seq_ids` to the device being part of each call.
+void bench_reduce_max(benchmark::State& state)
+{
+    const auto rows = state.range(0);
+    const auto cols = state.range(1);
+    DType dtype(InputTypes[state.range(2)]);
+
+    auto input = make_input(rows, cols, dtype, static_cast<Layout>(state.range(3)));
+
+    ShapeType seq_ids(rows);
+    for (TensorIndex row = 0; row < rows; ++row)
+    {
+        seq_ids[row] = row / 2;
+    }
+
+    const ShapeType output_shape{(rows + 1) / 2, cols};
+    const auto bytes = (rows + output_shape[0]) * cols * dtype.item_size();
+
+    run_kernel(state, bytes, [&]() {
+        benchmark::DoNotOptimize(MatxUtil::reduce_max(input, seq_ids, 0, output_shape));
+    });
+}
+
+}  // namespace
+
+BENCHMARK(bench_cast)
+    ->ArgNames({"rows", "cols", "dtype"})
+    ->ArgsProduct({{1 << 14, 1 << 20}, {1, 32}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseManualTime();
+
+BENCHMARK(bench_create_seq_ids)
+    ->ArgNames({"rows", "dtype"})
+    ->ArgsProduct({{1 << 14, 1 << 20}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseManualTime();
+
+BENCHMARK(bench_logits)
+    ->ArgNames({"rows", "cols", "dtype"})
+    ->ArgsProduct({{1 << 14, 1 << 20}, {1, 32}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseManualTime();
+
+BENCHMARK(bench_transpose)
+    ->ArgNames({"rows", "cols", "dtype"})
+    ->ArgsProduct({{1 << 14, 1 << 20}, {2, 32}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseManualTime();
+
+BENCHMARK(bench_threshold)
+    ->ArgNames({"rows", "cols", "dtype", "layout", "by_row"})
+    ->ArgsProduct({{1 << 14, 1 << 20}, {1, 32}, {0, 1}, {0, 1, 2}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseManualTime();
+
+BENCHMARK(bench_reduce_max)
+    ->ArgNames({"rows", "cols", "dtype", "layout"})
+    ->ArgsProduct({{1 << 14, 1 << 20}, {1, 32}, {0, 1}, {0, 1, 2}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseManualTime();
+
+BENCHMARK_MAIN();
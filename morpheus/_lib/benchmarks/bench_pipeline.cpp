@@ -0,0 +1,156 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline_harness.hpp"
+
+#include "morpheus/types.hpp"  // for TensorIndex
+
+#include <benchmark/benchmark.h>
+#include <pybind11/embed.h>  // for scoped_interpreter
+#include <pybind11/gil.h>    // for gil_scoped_release
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+#include <fstream>  // for ofstream
+#include <memory>   // for make_unique
+#include <random>   // for mt19937, uniform_int_distribution, uniform_real_distribution
+#include <string>   // for string, to_string
+#include <vector>   // for vector
+
+using namespace morpheus;
+using namespace morpheus::bench;
+
+namespace {
+
+// Strings of 1 to 63 words, such that a few overflow the sequence and are split across several rows of the tensors
+void bench_pipeline_nlp(benchmark::State& state)
+{
+    const auto rows_per_message = state.range(0);
+    const auto num_messages     = state.range(1);
+    const auto batch_size       = static_cast<TensorIndex>(state.range(2));
+
+    static const std::vector<std::string> words{
+        "failed", "password", "for", "user", "root", "from", "port", "ssh", "the", "account", "was", "locked"};
+
+    auto table = make_table("nlp", [&](std::ofstream& file) {
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<int64_t> num_words(1, 63);
+        std::uniform_int_distribution<std::size_t> word(0, words.size() - 1);
+
+        file << "data\n";
+        for (int64_t row = 0; row < rows_per_message; ++row)
+        {
+            for (auto i = num_words(generator); i > 0; --i)
+            {
+                file << words[word(generator)] << (i > 1 ? " " : "\n");
+            }
+        }
+    });
+
+    const auto vocab_file = (get_morpheus_root() / "morpheus/data/bert-base-cased-hash.txt").string();
+
+    PipelineOptions options;
+    options.batch_size = batch_size;
+
+    run_pipeline(
+        state,
+        table,
+        num_messages,
+        options,
+        [] { return std::make_unique<MockInferenceClient>(std::vector<std::string>{"input_ids", "input_mask"}, 10); },
+        "output__0",
+        10,
+        make_nlp_preprocess(vocab_file));
+}
+
+void bench_pipeline_fil(benchmark::State& state)
+{
+    const auto rows_per_message = state.range(0);
+    const auto num_messages     = state.range(1);
+    const auto batch_size       = static_cast<TensorIndex>(state.range(2));
+    const int64_t num_features  = 29;
+
+    std::vector<std::string> features;
+    for (int64_t i = 0; i < num_features; ++i)
+    {
+        features.push_back("feature_" + std::to_string(i));
+    }
+
+    auto table = make_table("fil", [&](std::ofstream& file) {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float> value(0, 100);
+
+        for (int64_t i = 0; i < num_features; ++i)
+        {
+            file << features[i] << (i + 1 < num_features ? "," : "\n");
+        }
+
+        for (int64_t row = 0; row < rows_per_message; ++row)
+        {
+            for (int64_t i = 0; i < num_features; ++i)
+            {
+                file << value(generator) << (i + 1 < num_features ? "," : "\n");
+            }
+        }
+    });
+
+    PipelineOptions options;
+    options.batch_size = batch_size;
+
+    run_pipeline(
+        state,
+        table,
+        num_messages,
+        options,
+        [] { return std::make_unique<MockInferenceClient>(std::vector<std::string>{"input__0"}, 1); },
+        "output__0",
+        1,
+        make_fil_preprocess(features));
+}
+
+}  // namespace
+
+BENCHMARK(bench_pipeline_nlp)
+    ->ArgNames({"rows", "messages", "batch_size"})
+    ->ArgsProduct({{4096}, {64}, {256, 1024}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK(bench_pipeline_fil)
+    ->ArgNames({"rows", "messages", "batch_size"})
+    ->ArgsProduct({{65536}, {64}, {1024, 8192}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+int main(int argc, char** argv)
+{
+    // The stages are Python nodes and the inference stage runs an asyncio loop, the interpreter is initialized as it
+    // is by the tests
+    pybind11::scoped_interpreter interpreter;
+    pybind11::gil_scoped_release no_gil;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
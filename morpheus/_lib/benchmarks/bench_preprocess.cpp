@@ -0,0 +1,220 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/io/deserializers.hpp"               // for load_table_from_file
+#include "morpheus/messages/memory/tensor_memory.hpp"  // for TensorMemory
+#include "morpheus/messages/meta.hpp"                  // for MessageMeta
+#include "morpheus/messages/multi.hpp"                 // for MultiMessage
+#include "morpheus/stages/preprocess_fil.hpp"          // for PreprocessFILStageMM
+#include "morpheus/stages/preprocess_nlp.hpp"          // for PreprocessNLPStageMM
+
+#include <benchmark/benchmark.h>
+#include <cuda_runtime.h>                                 // for cudaEventCreate, cudaEventElapsedTime
+#include <mrc/cuda/common.hpp>                            // for MRC_CHECK_CUDA
+#include <pybind11/embed.h>                               // for scoped_interpreter
+#include <pybind11/gil.h>                                 // for gil_scoped_release
+#include <rmm/mr/device/per_device_resource.hpp>          // for set_current_device_resource
+#include <rmm/mr/device/statistics_resource_adaptor.hpp>  // for statistics_resource_adaptor
+
+#include <cstdint>     // for int64_t
+#include <cstdlib>     // for getenv
+#include <filesystem>  // for path, temp_directory_path
+#include <fstream>     // for ofstream
+#include <memory>      // for make_shared, shared_ptr
+#include <random>      // for mt19937, uniform_int_distribution, uniform_real_distribution
+#include <stdexcept>   // for runtime_error
+#include <string>      // for string, to_string
+#include <vector>      // for vector
+
+using namespace morpheus;
+
+namespace {
+
+using statistics_mr_t = rmm::mr::statistics_resource_adaptor<rmm::mr::device_memory_resource>;
+
+std::filesystem::path get_morpheus_root()
+{
+    auto root = std::getenv("MORPHEUS_ROOT");
+
+    if (root == nullptr)
+    {
+        throw std::runtime_error("MORPHEUS_ROOT env variable is not set");
+    }
+
+    return std::filesystem::path{root};
+}
+
+// Loads a synthetic table written to a temporary CSV file by `write_rows`
+template <typename WriteRowsFn>
+std::shared_ptr<MessageMeta> make_meta(const std::string& name, WriteRowsFn&& write_rows)
+{
+    auto path = std::filesystem::temp_directory_path() / ("morpheus_bench_" + name + ".csv");
+    {
+        std::ofstream file(path);
+        write_rows(file);
+    }
+
+    auto meta = MessageMeta::create_from_cpp(load_table_from_file(path));
+    std::filesystem::remove(path);
+
+    return meta;
+}
+
+// Runs `on_data` once per iteration, reporting the rows per second along with the GPU time and peak device memory of
+// each call. Device memory is counted by wrapping the current resource for the duration of the benchmark.
+template <typename StageT>
+void run_stage(benchmark::State& state, StageT& stage, const std::shared_ptr<MultiMessage>& message)
+{
+    auto* upstream_mr = rmm::mr::get_current_device_resource();
+    statistics_mr_t statistics_mr(upstream_mr);
+    rmm::mr::set_current_device_resource(&statistics_mr);
+
+    cudaEvent_t start;
+    cudaEvent_t stop;
+    MRC_CHECK_CUDA(cudaEventCreate(&start));
+    MRC_CHECK_CUDA(cudaEventCreate(&stop));
+
+    double gpu_ms = 0;
+
+    for (auto _ : state)
+    {
+        MRC_CHECK_CUDA(cudaEventRecord(start, 0));
+
+        auto output = stage.on_data(message);
+        output->memory->synchronize_event();
+
+        MRC_CHECK_CUDA(cudaEventRecord(stop, 0));
+        MRC_CHECK_CUDA(cudaEventSynchronize(stop));
+
+        float elapsed_ms = 0;
+        MRC_CHECK_CUDA(cudaEventElapsedTime(&elapsed_ms, start, stop));
+        gpu_ms += elapsed_ms;
+
+        benchmark::DoNotOptimize(output);
+    }
+
+    MRC_CHECK_CUDA(cudaEventDestroy(start));
+    MRC_CHECK_CUDA(cudaEventDestroy(stop));
+
+    rmm::mr::set_current_device_resource(upstream_mr);
+
+    const auto num_rows = static_cast<int64_t>(message->mess_count);
+    state.SetItemsProcessed(state.iterations() * num_rows);
+    state.counters["gpu_ms"] = benchmark::Counter(gpu_ms / state.iterations());
+    state.counters["peak_device_bytes"] = benchmark::Counter(
+        statistics_mr.get_bytes_counter().peak, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+}
+
+// Strings of a number of words drawn uniformly from [1, 2 * mean_words - 1], such that a few overflow the sequence
+void bench_preprocess_nlp(benchmark::State& state)
+{
+    const auto num_rows        = state.range(0);
+    const auto mean_words      = state.range(1);
+    const auto sequence_length = static_cast<uint32_t>(state.range(2));
+
+    static const std::vector<std::string> words{
+        "failed", "password", "for", "user", "root", "from", "port", "ssh", "the", "account", "was", "locked"};
+
+    auto meta = make_meta("nlp", [&](std::ofstream& file) {
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<int64_t> num_words(1, 2 * mean_words - 1);
+        std::uniform_int_distribution<std::size_t> word(0, words.size() - 1);
+
+        file << "data\n";
+        for (int64_t row = 0; row < num_rows; ++row)
+        {
+            for (auto i = num_words(generator); i > 0; --i)
+            {
+                file << words[word(generator)] << (i > 1 ? " " : "\n");
+            }
+        }
+    });
+
+    PreprocessNLPStageMM stage((get_morpheus_root() / "morpheus/data/bert-base-cased-hash.txt").string(),
+                               sequence_length,
+                               false /*truncation*/,
+                               false /*do_lower_case*/,
+                               false /*add_special_token*/);
+
+    run_stage(state, stage, std::make_shared<MultiMessage>(meta));
+}
+
+void bench_preprocess_fil(benchmark::State& state)
+{
+    const auto num_rows     = state.range(0);
+    const auto num_features = state.range(1);
+
+    std::vector<std::string> features;
+    for (int64_t i = 0; i < num_features; ++i)
+    {
+        features.push_back("feature_" + std::to_string(i));
+    }
+
+    auto meta = make_meta("fil", [&](std::ofstream& file) {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float> value(0, 100);
+
+        for (int64_t i = 0; i < num_features; ++i)
+        {
+            file << features[i] << (i + 1 < num_features ? "," : "\n");
+        }
+
+        for (int64_t row = 0; row < num_rows; ++row)
+        {
+            for (int64_t i = 0; i < num_features; ++i)
+            {
+                file << value(generator) << (i + 1 < num_features ? "," : "\n");
+            }
+        }
+    });
+
+    PreprocessFILStageMM stage(features);
+
+    run_stage(state, stage, std::make_shared<MultiMessage>(meta));
+}
+
+}  // namespace
+
+BENCHMARK(bench_preprocess_nlp)
+    ->ArgNames({"rows", "mean_words", "sequence_length"})
+    ->ArgsProduct({{1024, 16384}, {8, 64}, {128, 256}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(bench_preprocess_fil)
+    ->ArgNames({"rows", "features"})
+    ->ArgsProduct({{1024, 65536}, {8, 64}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+int main(int argc, char** argv)
+{
+    // The stages are Python nodes, the interpreter is initialized as it is by the tests
+    pybind11::scoped_interpreter interpreter;
+    pybind11::gil_scoped_release no_gil;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,320 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/io/deserializers.hpp"            // for load_table_from_file
+#include "morpheus/io/serializers.hpp"              // for df_to_csv, df_to_json, ChunkedParquetWriter
+#include "morpheus/messages/meta.hpp"               // for MessageMeta
+#include "morpheus/objects/file_types.hpp"          // for FileTypes
+#include "morpheus/objects/pinned_host_buffer.hpp"  // for PinnedHostBuffer
+
+#include <benchmark/benchmark.h>
+#include <cudf/io/data_sink.hpp>  // for data_sink
+#include <pybind11/embed.h>       // for scoped_interpreter
+#include <pybind11/gil.h>         // for gil_scoped_release
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t
+#include <filesystem>  // for path, temp_directory_path, file_size
+#include <fstream>     // for ofstream
+#include <memory>      // for make_unique, shared_ptr, unique_ptr
+#include <random>      // for mt19937, uniform_int_distribution, uniform_real_distribution
+#include <sstream>     // for ostringstream
+#include <stdexcept>   // for invalid_argument
+#include <string>      // for string
+#include <vector>      // for vector
+
+using namespace morpheus;
+
+namespace {
+
+// Where the serialized output of a benchmark is written
+enum class SinkType : int64_t
+{
+    OStringStream = 0,
+    File          = 1,
+    Pinned        = 2
+};
+
+// Appends everything written to it to a pinned host buffer, which is reused across iterations. Device buffers are
+// copied to host memory by cudf before being written.
+class PinnedSink : public cudf::io::data_sink
+{
+  public:
+    PinnedSink(PinnedHostBuffer& buffer) : m_buffer(buffer) {}
+
+    void host_write(void const* data, std::size_t size) override
+    {
+        m_buffer.append(static_cast<char const*>(data), size);
+    }
+
+    void flush() override {}
+
+    std::size_t bytes_written() override
+    {
+        return m_buffer.size();
+    }
+
+  private:
+    PinnedHostBuffer& m_buffer;
+};
+
+std::filesystem::path temp_path(const std::string& name)
+{
+    return std::filesystem::temp_directory_path() / ("morpheus_bench_" + name);
+}
+
+// A table of `num_columns` columns, `string_percent` of which hold strings of a few words and the rest floats
+std::shared_ptr<MessageMeta> make_meta(int64_t num_rows, int64_t num_columns, int64_t string_percent)
+{
+    static const std::vector<std::string> words{
+        "failed", "password", "for", "user", "root", "from", "port", "ssh", "the", "account", "was", "locked"};
+
+    const auto num_string_columns = num_columns * string_percent / 100;
+
+    auto path = temp_path("serializers.csv");
+    {
+        std::ofstream file(path);
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<std::size_t> word(0, words.size() - 1);
+        std::uniform_real_distribution<float> value(0, 100);
+
+        for (int64_t i = 0; i < num_columns; ++i)
+        {
+            file << "column_" << i << (i + 1 < num_columns ? "," : "\n");
+        }
+
+        for (int64_t row = 0; row < num_rows; ++row)
+        {
+            for (int64_t i = 0; i < num_columns; ++i)
+            {
+                if (i < num_string_columns)
+                {
+                    file << words[word(generator)] << " " << words[word(generator)] << " " << words[word(generator)];
+                }
+                else
+                {
+                    file << value(generator);
+                }
+
+                file << (i + 1 < num_columns ? "," : "\n");
+            }
+        }
+    }
+
+    auto meta = MessageMeta::create_from_cpp(load_table_from_file(path));
+    std::filesystem::remove(path);
+
+    return meta;
+}
+
+const char* extension(FileTypes file_type)
+{
+    switch (file_type)
+    {
+    case FileTypes::JSON:
+        return ".jsonlines";
+    case FileTypes::PARQUET:
+        return ".parquet";
+    default:
+        return ".csv";
+    }
+}
+
+// Serializes `tbl` to `sink` in the `file_type` format
+void serialize(const TableInfo& tbl, FileTypes file_type, cudf::io::data_sink& sink)
+{
+    switch (file_type)
+    {
+    case FileTypes::JSON:
+        df_to_json(tbl, sink, false);
+        break;
+    case FileTypes::CSV:
+        df_to_csv(tbl, sink, true, false);
+        break;
+    default:
+        throw std::invalid_argument("Parquet files are written by a ChunkedParquetWriter");
+    }
+}
+
+// Serializes `tbl` in the `file_type` format to a sink of `sink_type`, returning the number of bytes written
+std::size_t serialize(const TableInfo& tbl,
+                      FileTypes file_type,
+                      SinkType sink_type,
+                      const std::filesystem::path& path,
+                      PinnedHostBuffer& pinned_buffer)
+{
+    switch (sink_type)
+    {
+    case SinkType::OStringStream: {
+        std::ostringstream out_stream;
+
+        if (file_type == FileTypes::PARQUET)
+        {
+            ChunkedParquetWriter writer(out_stream, false);
+            writer.write(tbl);
+            writer.close();
+        }
+        else if (file_type == FileTypes::JSON)
+        {
+            df_to_json(tbl, out_stream, false);
+        }
+        else
+        {
+            df_to_csv(tbl, out_stream, true, false);
+        }
+
+        return static_cast<std::size_t>(out_stream.tellp());
+    }
+    case SinkType::File: {
+        if (file_type == FileTypes::PARQUET)
+        {
+            ChunkedParquetWriter writer(create_file_sink(path.string()), false);
+            writer.write(tbl);
+            writer.close();
+            return writer.bytes_written();
+        }
+
+        auto sink = create_file_sink(path.string());
+        serialize(tbl, file_type, *sink);
+        sink->flush();
+        return sink->bytes_written();
+    }
+    case SinkType::Pinned:
+    default: {
+        pinned_buffer.clear();
+
+        if (file_type == FileTypes::PARQUET)
+        {
+            ChunkedParquetWriter writer(std::make_unique<PinnedSink>(pinned_buffer), false);
+            writer.write(tbl);
+            writer.close();
+            return writer.bytes_written();
+        }
+
+        PinnedSink sink(pinned_buffer);
+        serialize(tbl, file_type, sink);
+        return sink.bytes_written();
+    }
+    }
+}
+
+// Reports the throughput of each iteration handling `num_rows` rows making up `num_bytes` bytes of encoded data
+void set_throughput(benchmark::State& state, int64_t num_rows, std::size_t num_bytes)
+{
+    state.SetItemsProcessed(state.iterations() * num_rows);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(num_bytes));
+    state.counters["encoded_bytes"] =
+        benchmark::Counter(static_cast<double>(num_bytes), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+}
+
+template <FileTypes FileTypeV>
+void bench_serialize(benchmark::State& state)
+{
+    const auto num_rows       = state.range(0);
+    const auto num_columns    = state.range(1);
+    const auto string_percent = state.range(2);
+    const auto sink_type      = static_cast<SinkType>(state.range(3));
+
+    auto meta = make_meta(num_rows, num_columns, string_percent);
+    auto tbl  = meta->get_info();
+    auto path = temp_path(std::string("serialized") + extension(FileTypeV));
+
+    PinnedHostBuffer pinned_buffer;
+    std::size_t num_bytes = 0;
+
+    for (auto _ : state)
+    {
+        num_bytes = serialize(tbl, FileTypeV, sink_type, path, pinned_buffer);
+        benchmark::DoNotOptimize(num_bytes);
+    }
+
+    std::filesystem::remove(path);
+
+    set_throughput(state, num_rows, num_bytes);
+}
+
+template <FileTypes FileTypeV>
+void bench_deserialize(benchmark::State& state)
+{
+    const auto num_rows       = state.range(0);
+    const auto num_columns    = state.range(1);
+    const auto string_percent = state.range(2);
+
+    auto path = temp_path(std::string("deserialized") + extension(FileTypeV));
+    {
+        auto meta = make_meta(num_rows, num_columns, string_percent);
+        PinnedHostBuffer pinned_buffer;
+        serialize(meta->get_info(), FileTypeV, SinkType::File, path, pinned_buffer);
+    }
+
+    const auto num_bytes = std::filesystem::file_size(path);
+
+    for (auto _ : state)
+    {
+        auto table = load_table_from_file(path.string(), FileTypeV);
+        benchmark::DoNotOptimize(table);
+    }
+
+    std::filesystem::remove(path);
+
+    set_throughput(state, num_rows, num_bytes);
+}
+
+// Rows, columns, percent of string columns and, when serializing, the `SinkType`
+void serialize_args(benchmark::internal::Benchmark* bench)
+{
+    bench->ArgNames({"rows", "columns", "string_percent", "sink"})
+        ->ArgsProduct({{16384, 262144}, {4, 32}, {0, 50, 100}, {0, 1, 2}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+}
+
+void deserialize_args(benchmark::internal::Benchmark* bench)
+{
+    bench->ArgNames({"rows", "columns", "string_percent"})
+        ->ArgsProduct({{16384, 262144}, {4, 32}, {0, 50, 100}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(bench_serialize, FileTypes::CSV)->Apply(serialize_args);
+BENCHMARK_TEMPLATE(bench_serialize, FileTypes::JSON)->Apply(serialize_args);
+BENCHMARK_TEMPLATE(bench_serialize, FileTypes::PARQUET)->Apply(serialize_args);
+
+BENCHMARK_TEMPLATE(bench_deserialize, FileTypes::CSV)->Apply(deserialize_args);
+BENCHMARK_TEMPLATE(bench_deserialize, FileTypes::JSON)->Apply(deserialize_args);
+BENCHMARK_TEMPLATE(bench_deserialize, FileTypes::PARQUET)->Apply(deserialize_args);
+
+int main(int argc, char** argv)
+{
+    // Loading and serializing tables may call into python, the interpreter is initialized as it is by the tests
+    pybind11::scoped_interpreter interpreter;
+    pybind11::gil_scoped_release no_gil;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
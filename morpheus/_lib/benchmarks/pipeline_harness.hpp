@@ -0,0 +1,508 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/io/deserializers.hpp"               // for load_table_from_file
+#include "morpheus/messages/meta.hpp"                  // for MessageMeta
+#include "morpheus/messages/multi.hpp"                 // for MultiMessage
+#include "morpheus/messages/multi_inference.hpp"       // for MultiInferenceMessage
+#include "morpheus/messages/multi_response.hpp"        // for MultiResponseMessage
+#include "morpheus/objects/dtype.hpp"                  // for DType
+#include "morpheus/objects/tensor.hpp"                 // for Tensor
+#include "morpheus/stages/add_scores.hpp"              // for AddScoresStageMM
+#include "morpheus/stages/deserialize.hpp"             // for DeserializeStage
+#include "morpheus/stages/inference_client_stage.hpp"  // for InferenceClientStage, IInferenceClient
+#include "morpheus/stages/preprocess_fil.hpp"          // for PreprocessFILStageMM
+#include "morpheus/stages/preprocess_nlp.hpp"          // for PreprocessNLPStageMM
+#include "morpheus/stages/serialize.hpp"               // for SerializeStageMM
+#include "morpheus/types.hpp"                          // for TensorIndex, TensorMap
+
+#include <benchmark/benchmark.h>
+#include <cuda_runtime.h>                 // for cudaMemsetAsync
+#include <cudf/io/types.hpp>              // for table_with_metadata
+#include <cudf/table/table.hpp>           // for table
+#include <mrc/coroutines/scheduler.hpp>   // for Scheduler
+#include <mrc/coroutines/task.hpp>        // for Task
+#include <mrc/cuda/common.hpp>            // for MRC_CHECK_CUDA
+#include <mrc/options/engine_groups.hpp>  // for EngineGroups
+#include <mrc/options/options.hpp>        // for Options
+#include <mrc/pipeline/executor.hpp>      // for Executor
+#include <mrc/pipeline/pipeline.hpp>      // for make_pipeline
+#include <mrc/runnable/types.hpp>         // for EngineType
+#include <mrc/segment/builder.hpp>        // for Builder
+#include <rmm/cuda_stream_view.hpp>       // for cuda_stream_per_thread
+#include <rmm/device_buffer.hpp>          // for device_buffer
+#include <rxcpp/rx.hpp>                   // for subscriber, map
+
+#include <algorithm>   // for find_if, sort, max
+#include <array>       // for array
+#include <chrono>      // for steady_clock, duration, milliseconds
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t
+#include <cstdlib>     // for getenv
+#include <deque>       // for deque
+#include <filesystem>  // for path, temp_directory_path
+#include <fstream>     // for ofstream
+#include <functional>  // for function
+#include <map>         // for map
+#include <memory>      // for make_shared, make_unique, shared_ptr, unique_ptr
+#include <mutex>       // for mutex, lock_guard
+#include <numeric>     // for accumulate
+#include <stdexcept>   // for runtime_error
+#include <string>      // for string, to_string
+#include <utility>     // for move, pair
+#include <vector>      // for vector
+
+/**
+ * Pipeline shared by the end-to-end benchmark and the autotuner, running
+ * `source -> DeserializeStage -> preprocess -> InferenceClientStage -> AddScoresStage -> SerializeStage -> sink`
+ */
+namespace morpheus::bench {
+
+using clock_type_t = std::chrono::steady_clock;
+
+inline std::filesystem::path get_morpheus_root()
+{
+    auto root = std::getenv("MORPHEUS_ROOT");
+
+    if (root == nullptr)
+    {
+        throw std::runtime_error("MORPHEUS_ROOT env variable is not set");
+    }
+
+    return std::filesystem::path{root};
+}
+
+// Loads a synthetic table written to a temporary CSV file by `write_rows`, copied by the source for every message
+template <typename WriteRowsFn>
+cudf::io::table_with_metadata make_table(const std::string& name, WriteRowsFn&& write_rows)
+{
+    auto path = std::filesystem::temp_directory_path() / ("morpheus_bench_pipeline_" + name + ".csv");
+    {
+        std::ofstream file(path);
+        write_rows(file);
+    }
+
+    auto table = load_table_from_file(path);
+    std::filesystem::remove(path);
+
+    return table;
+}
+
+// Session of `MockInferenceClient`, the outputs are zeroed device tensors of one row per row of the first input
+class MockInferenceClientSession : public IInferenceClientSession
+{
+  public:
+    MockInferenceClientSession(std::vector<std::string> input_names, TensorIndex num_labels) :
+      m_input_names(std::move(input_names)),
+      m_num_labels(num_labels)
+    {}
+
+    std::vector<TensorModelMapping> get_input_mappings(std::vector<TensorModelMapping> input_map_overrides) override
+    {
+        std::vector<TensorModelMapping> mappings;
+        for (const auto& name : m_input_names)
+        {
+            mappings.emplace_back(TensorModelMapping{name, name});
+        }
+
+        mappings.insert(mappings.end(), input_map_overrides.begin(), input_map_overrides.end());
+
+        return mappings;
+    }
+
+    std::vector<TensorModelMapping> get_output_mappings(std::vector<TensorModelMapping> output_map_overrides) override
+    {
+        std::vector<TensorModelMapping> mappings{{"output__0", "output__0"}};
+
+        for (const auto& mapping : output_map_overrides)
+        {
+            auto pos = std::find_if(mappings.begin(), mappings.end(), [&mapping](const TensorModelMapping& m) {
+                return m.model_field_name == mapping.model_field_name;
+            });
+
+            if (pos != mappings.end())
+            {
+                mappings.erase(pos);
+            }
+
+            mappings.push_back(mapping);
+        }
+
+        return mappings;
+    }
+
+    mrc::coroutines::Task<TensorMap> infer(TensorMap&& inputs, std::shared_ptr<mrc::coroutines::Scheduler> on) override
+    {
+        const auto num_rows = inputs.begin()->second.shape(0);
+        const auto stream   = rmm::cuda_stream_per_thread;
+
+        auto probs = std::make_shared<rmm::device_buffer>(num_rows * m_num_labels * sizeof(float), stream);
+        MRC_CHECK_CUDA(cudaMemsetAsync(probs->data(), 0, probs->size(), stream));
+        stream.synchronize();
+
+        TensorMap outputs;
+        outputs["output__0"] =
+            Tensor::create(std::move(probs), DType::create<float>(), {num_rows, m_num_labels}, {}, 0);
+
+        co_return outputs;
+    }
+
+  private:
+    std::vector<std::string> m_input_names;
+    TensorIndex m_num_labels;
+};
+
+// Stands in for Triton, such that the benchmark measures the stages rather than the model
+class MockInferenceClient : public IInferenceClient
+{
+  public:
+    MockInferenceClient(std::vector<std::string> input_names, TensorIndex num_labels) :
+      m_input_names(std::move(input_names)),
+      m_num_labels(num_labels)
+    {}
+
+    std::unique_ptr<IInferenceClientSession> create_session() override
+    {
+        return std::make_unique<MockInferenceClientSession>(m_input_names, m_num_labels);
+    }
+
+  private:
+    std::vector<std::string> m_input_names;
+    TensorIndex m_num_labels;
+};
+
+// Points of the pipeline at which a batch is stamped, the time of a stage being the time between two of them
+enum TracePoint : std::size_t
+{
+    Emitted = 0,
+    Deserialized,
+    Preprocessed,
+    Inferred,
+    Scored,
+    Serialized,
+    NumTracePoints
+};
+
+inline const std::array<std::string, NumTracePoints - 1> StageNames{
+    "deserialize", "preprocess", "inference", "add_scores", "serialize"};
+
+/**
+ * Stamps each batch as it passes through the pipeline. Batches are identified by their `MessageMeta` and offset, which
+ * the stages between `DeserializeStage` and `SerializeStage` carry over. `SerializeStage` emits new `MessageMeta`s in
+ * the order it receives batches, those waiting on it are kept in order instead. The emitted `MessageMeta`s are held
+ * until the end of the run, such that their addresses are not reused.
+ */
+class PipelineTrace
+{
+  public:
+    void emitted(std::shared_ptr<MessageMeta> meta)
+    {
+        const auto now = clock_type_t::now();
+
+        std::lock_guard lock(m_mutex);
+        if (m_emitted.empty())
+        {
+            m_first = now;
+        }
+
+        m_emitted[meta.get()] = {std::move(meta), now};
+    }
+
+    void stamp(TracePoint point, const MultiMessage& message)
+    {
+        const auto now = clock_type_t::now();
+        const key_t key{message.meta.get(), message.mess_offset};
+
+        std::lock_guard lock(m_mutex);
+        auto& batch = m_batches[key];
+        if (point == Deserialized)
+        {
+            batch.num_rows        = message.mess_count;
+            batch.points[Emitted] = m_emitted.at(message.meta.get()).second;
+        }
+
+        batch.points[point] = now;
+
+        if (point == Scored)
+        {
+            m_serializing.push_back(key);
+        }
+    }
+
+    void serialized()
+    {
+        const auto now = clock_type_t::now();
+
+        std::lock_guard lock(m_mutex);
+        m_batches.at(m_serializing.front()).points[Serialized] = now;
+        m_serializing.pop_front();
+        m_last = now;
+    }
+
+    double elapsed_seconds() const
+    {
+        return std::chrono::duration<double>(m_last - m_first).count();
+    }
+
+    // Appends the time spent in each stage and the latency of every batch, returning the number of rows
+    int64_t collect(std::array<std::vector<double>, NumTracePoints - 1>& stage_seconds,
+                    std::vector<double>& latency_seconds) const
+    {
+        int64_t num_rows = 0;
+        for (const auto& [key, batch] : m_batches)
+        {
+            for (std::size_t i = 0; i + 1 < NumTracePoints; ++i)
+            {
+                const auto seconds = std::chrono::duration<double>(batch.points[i + 1] - batch.points[i]).count();
+                stage_seconds[i].push_back(seconds);
+            }
+
+            latency_seconds.push_back(
+                std::chrono::duration<double>(batch.points[Serialized] - batch.points[Emitted]).count());
+            num_rows += batch.num_rows;
+        }
+
+        return num_rows;
+    }
+
+  private:
+    using key_t = std::pair<const MessageMeta*, TensorIndex>;
+
+    struct Batch
+    {
+        TensorIndex num_rows{0};
+        std::array<clock_type_t::time_point, NumTracePoints> points;
+    };
+
+    std::mutex m_mutex;
+    clock_type_t::time_point m_first;
+    clock_type_t::time_point m_last;
+    std::map<const MessageMeta*, std::pair<std::shared_ptr<MessageMeta>, clock_type_t::time_point>> m_emitted;
+    std::map<key_t, Batch> m_batches;
+    std::deque<key_t> m_serializing;
+};
+
+// Pass-through node stamping each batch at `point`
+template <typename InputT, typename OutputT>
+auto make_tap(mrc::segment::Builder& builder, const std::string& name, PipelineTrace& trace, TracePoint point)
+{
+    return builder.make_node<std::shared_ptr<InputT>, std::shared_ptr<OutputT>>(
+        name, rxcpp::operators::map([&trace, point](std::shared_ptr<InputT> x) -> std::shared_ptr<OutputT> {
+            trace.stamp(point, *x);
+            return x;
+        }));
+}
+
+// Nearest rank percentile of sorted `values`
+inline double percentile(const std::vector<double>& values, double p)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+
+    auto rank = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+    return values[std::min(rank, values.size() - 1)];
+}
+
+// Tunable options of the pipeline
+struct PipelineOptions
+{
+    TensorIndex batch_size{256};        // Rows of the batches emitted by `DeserializeStage`
+    TensorIndex max_batch_rows{0};      // Rows the inference stage merges batches up to, 0 to not merge them
+    std::size_t num_sessions{1};        // Inference sessions, the number of batches in flight
+    std::size_t preprocess_threads{1};  // Threads of the preprocessing stage
+
+    std::string to_string() const
+    {
+        return "batch_size:" + std::to_string(batch_size) + "/max_batch_rows:" + std::to_string(max_batch_rows) +
+               "/sessions:" + std::to_string(num_sessions) +
+               "/preprocess_threads:" + std::to_string(preprocess_threads);
+    }
+};
+
+// Rows and batch latencies measured over every iteration of `run_pipeline`
+struct PipelineResult
+{
+    int64_t num_rows{0};
+    double seconds{0};
+    std::vector<double> latency_seconds;  // Sorted
+
+    double rows_per_second() const
+    {
+        return seconds > 0 ? static_cast<double>(num_rows) / seconds : 0;
+    }
+
+    double latency_ms(double p) const
+    {
+        return 1000 * percentile(latency_seconds, p);
+    }
+};
+
+using make_client_fn_t = std::function<std::unique_ptr<IInferenceClient>()>;
+
+/**
+ * Runs the pipeline once per iteration, the source emitting `num_messages` copies of `table`, and inferring through the
+ * client returned by `make_client`. The time of an iteration is the time between the first message being emitted and
+ * the last being serialized, excluding building and starting the pipeline. Reports the rows per second, the mean time
+ * spent in each stage, queueing included, and the percentiles of the latency of each batch.
+ */
+template <typename MakePreprocessFn>
+PipelineResult run_pipeline(benchmark::State& state,
+                            const cudf::io::table_with_metadata& table,
+                            int64_t num_messages,
+                            const PipelineOptions& pipeline_options,
+                            const make_client_fn_t& make_client,
+                            const std::string& output_name,
+                            std::size_t num_labels,
+                            MakePreprocessFn&& make_preprocess)
+{
+    using namespace mrc;
+
+    std::map<std::size_t, std::string> idx2label;
+    for (std::size_t i = 0; i < num_labels; ++i)
+    {
+        idx2label[i] = "label_" + std::to_string(i);
+    }
+
+    std::array<std::vector<double>, NumTracePoints - 1> stage_seconds;
+    PipelineResult result;
+
+    for (auto _ : state)
+    {
+        PipelineTrace trace;
+
+        auto init = [&](segment::Builder& builder) {
+            auto source = builder.make_source<std::shared_ptr<MessageMeta>>(
+                "source", [&](rxcpp::subscriber<std::shared_ptr<MessageMeta>>& sub) {
+                    for (int64_t i = 0; i < num_messages && sub.is_subscribed(); ++i)
+                    {
+                        auto meta = MessageMeta::create_from_cpp(
+                            {std::make_unique<cudf::table>(table.tbl->view()), table.metadata});
+                        trace.emitted(meta);
+                        sub.on_next(std::move(meta));
+                    }
+
+                    sub.on_completed();
+                });
+
+            auto deserialize =
+                builder.construct_object<DeserializeStage<MultiMessage>>("deserialize", pipeline_options.batch_size);
+
+            auto deserialized = make_tap<MultiMessage, MultiMessage>(builder, "deserialized", trace, Deserialized);
+
+            auto preprocess = make_preprocess(builder);
+            preprocess->launch_options().pe_count = pipeline_options.preprocess_threads;
+
+            auto preprocessed =
+                make_tap<MultiInferenceMessage, MultiInferenceMessage>(builder, "preprocessed", trace, Preprocessed);
+
+            auto inference = builder.construct_object<InferenceClientStage>(
+                "inference",
+                make_client(),
+                "model",
+                false /*needs_logits*/,
+                std::vector<TensorModelMapping>{},
+                std::vector<TensorModelMapping>{{output_name, "probs"}},
+                false /*use_cuda_graphs*/,
+                pipeline_options.max_batch_rows,
+                std::chrono::milliseconds(1),
+                pipeline_options.num_sessions);
+
+            auto inferred = make_tap<MultiResponseMessage, MultiResponseMessage>(builder, "inferred", trace, Inferred);
+
+            auto add_scores = builder.construct_object<AddScoresStageMM>("add_scores", idx2label);
+
+            // Also upcasts to the input of `SerializeStage`
+            auto scored = make_tap<MultiResponseMessage, MultiMessage>(builder, "scored", trace, Scored);
+
+            auto serialize = builder.construct_object<SerializeStageMM>(
+                "serialize", std::vector<std::string>{}, std::vector<std::string>{});
+
+            auto sink = builder.make_sink<std::shared_ptr<MessageMeta>>("sink", [&trace](std::shared_ptr<MessageMeta>) {
+                trace.serialized();
+            });
+
+            builder.make_edge(source, deserialize);
+            builder.make_edge(deserialize, deserialized);
+            builder.make_edge(deserialized, preprocess);
+            builder.make_edge(preprocess, preprocessed);
+            builder.make_edge(preprocessed, inference);
+            builder.make_edge(inference, inferred);
+            builder.make_edge(inferred, add_scores);
+            builder.make_edge(add_scores, scored);
+            builder.make_edge(scored, serialize);
+            builder.make_edge(serialize, sink);
+        };
+
+        auto pipeline = make_pipeline();
+        pipeline->make_segment("main", init);
+
+        auto options = std::make_shared<Options>();
+        options->engine_factories().set_default_engine_type(runnable::EngineType::Thread);
+
+        Executor executor(options);
+        executor.register_pipeline(std::move(pipeline));
+        executor.start();
+        executor.join();
+
+        state.SetIterationTime(trace.elapsed_seconds());
+        result.seconds += trace.elapsed_seconds();
+        result.num_rows += trace.collect(stage_seconds, result.latency_seconds);
+    }
+
+    state.SetItemsProcessed(result.num_rows);
+
+    for (std::size_t i = 0; i < StageNames.size(); ++i)
+    {
+        state.counters[StageNames[i] + "_ms"] = benchmark::Counter(
+            1000 * std::accumulate(stage_seconds[i].begin(), stage_seconds[i].end(), 0.0) /
+            static_cast<double>(std::max<std::size_t>(stage_seconds[i].size(), 1)));
+    }
+
+    std::sort(result.latency_seconds.begin(), result.latency_seconds.end());
+    state.counters["latency_p50_ms"] = benchmark::Counter(result.latency_ms(0.50));
+    state.counters["latency_p90_ms"] = benchmark::Counter(result.latency_ms(0.90));
+    state.counters["latency_p99_ms"] = benchmark::Counter(result.latency_ms(0.99));
+
+    return result;
+}
+
+// Preprocessing of the NLP pipelines, tokenizing the `data` column
+inline auto make_nlp_preprocess(std::string vocab_file, int sequence_length = 256)
+{
+    return [vocab_file = std::move(vocab_file), sequence_length](mrc::segment::Builder& builder) {
+        return builder.construct_object<PreprocessNLPStageMM>("preprocess",
+                                                              vocab_file,
+                                                              sequence_length,
+                                                              false /*truncation*/,
+                                                              false /*do_lower_case*/,
+                                                              true /*add_special_token*/);
+    };
+}
+
+// Preprocessing of the FIL pipelines, stacking `features` into a single tensor
+inline auto make_fil_preprocess(std::vector<std::string> features)
+{
+    return [features = std::move(features)](mrc::segment::Builder& builder) {
+        return builder.construct_object<PreprocessFILStageMM>("preprocess", features);
+    };
+}
+
+}  // namespace morpheus::bench
@@ -17,22 +17,37 @@ include(GenerateExportHeader)
 add_library(morpheus
 
   # Keep these sorted!
+  src/io/async_file_writer.cpp
+  src/io/batch_file_reader.cpp
+  src/io/cuda_ipc_ring.cpp
+  src/io/data_load_scheduler.cpp
   src/io/data_loader_registry.cpp
   src/io/data_loader.cpp
+  src/io/data_loader_cache.cpp
   src/io/deserializers.cpp
   src/io/loaders/file.cpp
   src/io/loaders/grpc.cpp
   src/io/loaders/lambda.cpp
   src/io/loaders/payload.cpp
   src/io/loaders/rest.cpp
+  src/io/loaders/s3.cpp
+  src/io/payload_decoder.cpp
   src/io/serializers.cpp
+  src/io/source_capture.cpp
+  src/io/ucx_transport.cpp
+  src/llm/async_semaphore.cpp
   src/llm/input_map.cpp
+  src/llm/llm_admission_controller.cpp
+  src/llm/llm_batching_node.cpp
   src/llm/llm_context.cpp
   src/llm/llm_engine.cpp
   src/llm/llm_node_runner.cpp
   src/llm/llm_node.cpp
+  src/llm/llm_output_stream.cpp
+  src/llm/llm_prompt_template_node.cpp
   src/llm/llm_task_handler_runner.cpp
   src/llm/llm_task.cpp
+  src/llm/llm_trace.cpp
   src/llm/utils.cpp
   src/messages/control.cpp
   src/messages/memory/inference_memory_fil.cpp
@@ -51,41 +66,90 @@ add_library(morpheus
   src/messages/multi_tensor.cpp
   src/messages/multi.cpp
   src/modules/data_loader_module.cpp
+  src/modules/payload_batcher_module.cpp
+  src/objects/cpp_data_table.cpp
+  src/objects/cuda_graph_cache.cpp
   src/objects/data_table.cpp
+  src/objects/dense_model_store.cpp
   src/objects/dev_mem_info.cpp
+  src/objects/device_resources.cpp
   src/objects/dtype.cpp
+  src/objects/feature_scalers.cpp
   src/objects/fiber_queue.cpp
   src/objects/file_types.cpp
+  src/objects/inference_result_cache.cpp
   src/objects/memory_descriptor.cpp
+  src/objects/memory_governor.cpp
+  src/objects/message_timestamps.cpp
   src/objects/mutable_table_ctx_mgr.cpp
+  src/objects/pinned_host_buffer.cpp
+  src/objects/pinned_staging_pool.cpp
   src/objects/python_data_table.cpp
   src/objects/rmm_tensor.cpp
+  src/objects/stage_memory_resource.cpp
   src/objects/table_info.cpp
+  src/objects/tensor_buffer_pool.cpp
   src/objects/tensor_object.cpp
   src/objects/tensor.cpp
+  src/objects/tokenizer.cpp
+  src/objects/user_history_store.cpp
   src/objects/wrapped_tensor.cpp
   src/stages/add_classification.cpp
   src/stages/add_scores_stage_base.cpp
   src/stages/add_scores.cpp
+  src/stages/appshield_features.cpp
+  src/stages/cidr_lookup.cpp
+  src/stages/cuda_ipc.cpp
+  src/stages/deduplicate.cpp
   src/stages/deserialize.cpp
+  src/stages/enrich.cpp
   src/stages/file_source.cpp
   src/stages/filter_detection.cpp
+  src/stages/filter_rows.cpp
+  src/stages/grouped_dense_inference.cpp
+  src/stages/hash_partition.cpp
+  src/stages/http_client_sink_stage.cpp
   src/stages/http_server_source_stage.cpp
   src/stages/inference_client_stage.cpp
   src/stages/kafka_source.cpp
+  src/stages/load_shedding.cpp
+  src/stages/log_parsing_postprocess.cpp
+  src/stages/monitor.cpp
+  src/stages/multi_endpoint_triton_client.cpp
+  src/stages/multi_file_source.cpp
+  src/stages/normalize_embeddings.cpp
+  src/stages/nvml_source.cpp
+  src/stages/preprocess_ae.cpp
   src/stages/preprocess_fil.cpp
   src/stages/preprocess_nlp.cpp
+  src/stages/replay_source.cpp
+  src/stages/rolling_window.cpp
   src/stages/serialize.cpp
+  src/stages/split_users.cpp
+  src/stages/timestamp.cpp
   src/stages/triton_inference.cpp
+  src/stages/ucx_boundary.cpp
+  src/stages/window_aggregate.cpp
+  src/stages/write_to_elasticsearch.cpp
   src/stages/write_to_file.cpp
+  src/stages/write_to_kafka.cpp
+  src/utilities/cuda_util.cpp
   src/utilities/cudf_util.cpp
   src/utilities/cupy_util.cpp
+  src/utilities/http_client.cpp
   src/utilities/http_server.cpp
+  src/utilities/kafka_transactions.cpp
   src/utilities/matx_util.cu
+  src/utilities/metrics.cpp
+  src/utilities/pool_allocator.cpp
   src/utilities/python_util.cpp
+  src/utilities/state_checkpoint.cpp
   src/utilities/string_util.cpp
   src/utilities/table_util.cpp
   src/utilities/tensor_util.cpp
+  src/utilities/topology.cpp
+  src/utilities/trace_buffer.cpp
+  src/utilities/warm_start_cache.cpp
 )
 
 add_library(${PROJECT_NAME}::morpheus ALIAS morpheus)
@@ -93,14 +157,18 @@ add_library(${PROJECT_NAME}::morpheus ALIAS morpheus)
 target_link_libraries(morpheus
   PRIVATE
     matx::matx
-    $<$<CONFIG:Debug>:ZLIB::ZLIB>
+    ZLIB::ZLIB
   PUBLIC
     $<TARGET_NAME_IF_EXISTS:conda_env>
     cudf::cudf
+    CUDA::cuda_driver
+    CUDA::nvml
     CUDA::nvtx3
     mrc::pymrc
     RDKAFKA::RDKAFKA
+    TritonClient::grpcclient_static
     TritonClient::httpclient_static
+    ucx::ucp
 )
 
 target_include_directories(morpheus
@@ -110,6 +178,22 @@ target_include_directories(morpheus
     $<INSTALL_INTERFACE:include>
 )
 
+# NVTX ranges are compiled out unless enabled, see morpheus/utilities/nvtx_util.hpp
+if(MORPHEUS_ENABLE_NVTX)
+  target_compile_definitions(morpheus
+    PUBLIC
+      MORPHEUS_ENABLE_NVTX
+  )
+endif()
+
+# Limits the pairs of types MatxUtil casts are compiled for, see src/utilities/matx_util.cu
+if(MORPHEUS_REDUCED_MATX_DISPATCH)
+  target_compile_definitions(morpheus
+    PRIVATE
+      MORPHEUS_REDUCED_MATX_DISPATCH
+  )
+endif()
+
 # Add the include directories of the cudf_helpers_project since we dont want to link directly to it
 get_target_property(cudf_helpers_include ${cudf_helpers_target} INTERFACE_INCLUDE_DIRECTORIES)
 
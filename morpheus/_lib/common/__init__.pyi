@@ -10,27 +10,217 @@ import typing
 import os
 
 __all__ = [
+    "BytePairTokenizer",
+    "DeduplicatingTokenizer",
+    "DenseActivation",
+    "DenseLayer",
+    "DenseModelStore",
+    "DeviceResourceType",
+    "DeviceResources",
+    "FeatureScalers",
     "FiberQueue",
     "FileTypes",
     "FilterSource",
     "HttpServer",
+    "MemoryConfig",
+    "MemoryGovernor",
+    "MetricsServer",
+    "StateCheckpoint",
     "Tensor",
+    "Tokenizer",
+    "TraceBuffer",
     "TypeId",
+    "WarmStartCache",
+    "WordPieceTokenizer",
     "determine_file_type",
     "read_file_to_df",
+    "serialize_metrics",
     "typeid_to_numpy_str",
     "write_df_to_file"
 ]
 
 
+class Tokenizer():
+    """
+    Tokenizer of the `PreprocessNLPStage`, tokenizing strings on the device.
+    """
+    pass
+class BytePairTokenizer(Tokenizer):
+    def __init__(self, merges_file: str, vocab_file: str, unknown_token: str = '<unk>', word_prefix: str = '\u0120') -> None: ...
+    pass
+class DeduplicatingTokenizer(Tokenizer):
+    def __init__(self, tokenizer: Tokenizer) -> None: ...
+    pass
+class DenseActivation():
+    """
+    Activation applied to the outputs of a DenseLayer
+
+    Members:
+
+      NONE
+
+      RELU
+
+      SIGMOID
+
+      TANH
+
+      LEAKY_RELU
+    """
+    def __eq__(self, other: object) -> bool: ...
+    def __getstate__(self) -> int: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> int: ...
+    def __init__(self, value: int) -> None: ...
+    def __int__(self) -> int: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __repr__(self) -> str: ...
+    def __setstate__(self, state: int) -> None: ...
+    @property
+    def name(self) -> str:
+        """
+        :type: str
+        """
+    @property
+    def value(self) -> int:
+        """
+        :type: int
+        """
+    LEAKY_RELU: morpheus._lib.common.DenseActivation # value = <DenseActivation.LEAKY_RELU: 4>
+    NONE: morpheus._lib.common.DenseActivation # value = <DenseActivation.NONE: 0>
+    RELU: morpheus._lib.common.DenseActivation # value = <DenseActivation.RELU: 1>
+    SIGMOID: morpheus._lib.common.DenseActivation # value = <DenseActivation.SIGMOID: 2>
+    TANH: morpheus._lib.common.DenseActivation # value = <DenseActivation.TANH: 3>
+    __members__: dict # value = {'NONE': <DenseActivation.NONE: 0>, 'RELU': <DenseActivation.RELU: 1>, 'SIGMOID': <DenseActivation.SIGMOID: 2>, 'TANH': <DenseActivation.TANH: 3>, 'LEAKY_RELU': <DenseActivation.LEAKY_RELU: 4>}
+    pass
+class DenseLayer():
+    """
+    Fully connected layer of a model held by a DenseModelStore, the weights being the row major `output_size` by `input_size` values of `torch.nn.Linear.weight`.
+    """
+    def __init__(self) -> None: ...
+    @property
+    def activation(self) -> DenseActivation:
+        """
+        :type: DenseActivation
+        """
+    @activation.setter
+    def activation(self, arg0: DenseActivation) -> None:
+        pass
+    @property
+    def biases(self) -> typing.List[float]:
+        """
+        :type: typing.List[float]
+        """
+    @biases.setter
+    def biases(self, arg0: typing.List[float]) -> None:
+        pass
+    @property
+    def input_size(self) -> int:
+        """
+        :type: int
+        """
+    @input_size.setter
+    def input_size(self, arg0: int) -> None:
+        pass
+    @property
+    def output_size(self) -> int:
+        """
+        :type: int
+        """
+    @output_size.setter
+    def output_size(self, arg0: int) -> None:
+        pass
+    @property
+    def weights(self) -> typing.List[float]:
+        """
+        :type: typing.List[float]
+        """
+    @weights.setter
+    def weights(self, arg0: typing.List[float]) -> None:
+        pass
+    pass
+class DenseModelStore():
+    """
+    Device resident store of many small fully connected models, such as one autoencoder per user, run by the `GroupedDenseInferenceStage`.
+    """
+    def __init__(self, max_models: int, loader: typing.Optional[typing.Callable[[str], typing.List[DenseLayer]]] = None, fallback_model_name: str = '') -> None: ...
+    def is_resident(self, model_name: str) -> bool: ...
+    def model_index(self, model_name: str) -> int: ...
+    def num_resident(self) -> int: ...
+    def set_model(self, model_name: str, layers: typing.List[DenseLayer]) -> None: ...
+    pass
+class DeviceResourceType():
+    """
+    Device memory resource at the bottom of the stack installed by DeviceResources
+
+    Members:
+
+      CUDA
+
+      POOL
+
+      ASYNC
+    """
+    def __eq__(self, other: object) -> bool: ...
+    def __getstate__(self) -> int: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> int: ...
+    def __init__(self, value: int) -> None: ...
+    def __int__(self) -> int: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __repr__(self) -> str: ...
+    def __setstate__(self, state: int) -> None: ...
+    @property
+    def name(self) -> str:
+        """
+        :type: str
+        """
+    @property
+    def value(self) -> int:
+        """
+        :type: int
+        """
+    ASYNC: morpheus._lib.common.DeviceResourceType # value = <DeviceResourceType.ASYNC: 2>
+    CUDA: morpheus._lib.common.DeviceResourceType # value = <DeviceResourceType.CUDA: 0>
+    POOL: morpheus._lib.common.DeviceResourceType # value = <DeviceResourceType.POOL: 1>
+    __members__: dict # value = {'CUDA': <DeviceResourceType.CUDA: 0>, 'POOL': <DeviceResourceType.POOL: 1>, 'ASYNC': <DeviceResourceType.ASYNC: 2>}
+    pass
+class DeviceResources():
+    """
+    Installs the stack of device memory resources described by a MemoryConfig on the current device.
+    """
+    @staticmethod
+    def install(config: MemoryConfig) -> None: ...
+    @staticmethod
+    def is_installed() -> bool: ...
+    pass
+class FeatureScalers():
+    """
+    Precomputed standard, min-max and one-hot scalers of the features of an autoencoder, global or per user, applied on the device by the `PreprocessAEStage`.
+    """
+    def __init__(self, filename: str) -> None: ...
+    def has_user(self, user_id: str) -> bool: ...
+    @property
+    def feature_columns(self) -> typing.List[str]:
+        """
+        :type: typing.List[str]
+        """
+    @property
+    def num_inputs(self) -> int:
+        """
+        :type: int
+        """
+    pass
 class FiberQueue():
     def __enter__(self) -> FiberQueue: ...
     def __exit__(self, arg0: object, arg1: object, arg2: object) -> None: ...
-    def __init__(self, max_size: int) -> None: ...
+    def __init__(self, max_size: int, lock_free: bool = False) -> None: ...
     def close(self) -> None: ...
     def get(self, block: bool = True, timeout: float = 0.0) -> object: ...
+    def get_many(self, max_items: int, block: bool = True, timeout: float = 0.0) -> list: ...
     def is_closed(self) -> bool: ...
     def put(self, item: object, block: bool = True, timeout: float = 0.0) -> None: ...
+    def put_many(self, items: list, block: bool = True, timeout: float = 0.0) -> None: ...
     pass
 class FileTypes():
     """
@@ -110,12 +300,129 @@ class FilterSource():
 class HttpServer():
     def __enter__(self) -> HttpServer: ...
     def __exit__(self, arg0: object, arg1: object, arg2: object) -> None: ...
-    def __init__(self, parse_fn: function, bind_address: str = '127.0.0.1', port: int = 8080, endpoint: str = '/message', method: str = 'POST', num_threads: int = 1, max_payload_size: int = 10485760, request_timeout: int = 30) -> None: ...
+    def __init__(self, parse_fn: function, bind_address: str = '127.0.0.1', port: int = 8080, endpoint: str = '/message', method: str = 'POST', num_threads: int = 1, max_payload_size: int = 10485760, request_timeout: int = 30, stream_chunk_size: int = 0) -> None: ...
+    def is_running(self) -> bool: ...
+    def start(self) -> None: ...
+    def stop(self) -> None: ...
+    pass
+class MemoryConfig():
+    """
+    Configuration of the device memory resources and streams used by the C++ stages.
+    """
+    def __init__(self) -> None: ...
+    @property
+    def arena_size(self) -> int:
+        """
+        :type: int
+        """
+    @arena_size.setter
+    def arena_size(self, arg0: int) -> None:
+        pass
+    @property
+    def dedicated_streams(self) -> bool:
+        """
+        :type: bool
+        """
+    @dedicated_streams.setter
+    def dedicated_streams(self, arg0: bool) -> None:
+        pass
+    @property
+    def initial_pool_size(self) -> int:
+        """
+        :type: int
+        """
+    @initial_pool_size.setter
+    def initial_pool_size(self, arg0: int) -> None:
+        pass
+    @property
+    def limit(self) -> int:
+        """
+        :type: int
+        """
+    @limit.setter
+    def limit(self, arg0: int) -> None:
+        pass
+    @property
+    def log_file(self) -> str:
+        """
+        :type: str
+        """
+    @log_file.setter
+    def log_file(self, arg0: str) -> None:
+        pass
+    @property
+    def maximum_pool_size(self) -> int:
+        """
+        :type: int
+        """
+    @maximum_pool_size.setter
+    def maximum_pool_size(self, arg0: int) -> None:
+        pass
+    @property
+    def resource_type(self) -> DeviceResourceType:
+        """
+        :type: DeviceResourceType
+        """
+    @resource_type.setter
+    def resource_type(self, arg0: DeviceResourceType) -> None:
+        pass
+    @property
+    def use_arena(self) -> bool:
+        """
+        :type: bool
+        """
+    @use_arena.setter
+    def use_arena(self, arg0: bool) -> None:
+        pass
+    pass
+class MemoryGovernor():
+    """
+    Tracks the device memory allocated by the C++ stages, pausing the Kafka and HTTP sources while it is above the high watermark.
+    """
+    @staticmethod
+    def get() -> MemoryGovernor: ...
+    @staticmethod
+    def install(high_watermark: float, low_watermark: float) -> MemoryGovernor: ...
+    def is_throttled(self) -> bool: ...
+    @property
+    def high_watermark(self) -> int:
+        """
+        :type: int
+        """
+    @property
+    def live_bytes(self) -> int:
+        """
+        :type: int
+        """
+    @property
+    def low_watermark(self) -> int:
+        """
+        :type: int
+        """
+    pass
+class MetricsServer():
+    """
+    Serves the metrics reported by the C++ stages to Prometheus, answering GET requests on `endpoint`.
+    """
+    def __enter__(self) -> MetricsServer: ...
+    def __exit__(self, arg0: object, arg1: object, arg2: object) -> None: ...
+    def __init__(self, bind_address: str = '127.0.0.1', port: int = 9464, endpoint: str = '/metrics', num_threads: int = 1) -> None: ...
     def is_running(self) -> bool: ...
     def start(self) -> None: ...
     def stop(self) -> None: ...
     pass
+class StateCheckpoint():
+    """
+    Directory of the checkpoints of the state of the C++ stages, such as deduplication windows and rolling window histories, restored by a restarted pipeline.
+    """
+    @staticmethod
+    def get_directory() -> str: ...
+    @staticmethod
+    def set_directory(directory: str) -> None: ...
+    pass
 class Tensor():
+    def __dlpack__(self, stream: typing.Optional[int] = None) -> object: ...
+    def __dlpack_device__(self) -> tuple: ...
     @staticmethod
     def from_cupy(arg0: object) -> Tensor: ...
     def to_cupy(self) -> object: ...
@@ -125,6 +432,27 @@ class Tensor():
         :type: dict
         """
     pass
+class TraceBuffer():
+    """
+    Per-thread ring buffers of the most recent trace events recorded by the C++ stages, decoded by `morpheus.utils.trace_decoder`.
+    """
+    @staticmethod
+    def dump(path: str) -> None: ...
+    @staticmethod
+    def dump_on_error(path: str, min_interval_seconds: int = 10) -> None: ...
+    @staticmethod
+    def dump_on_signal(signal: int, path: str) -> None: ...
+    @staticmethod
+    def event_names() -> typing.List[str]: ...
+    @staticmethod
+    def is_enabled() -> bool: ...
+    @staticmethod
+    def record(event: int, arg0: int = 0, arg1: int = 0, arg2: int = 0, arg3: int = 0) -> None: ...
+    @staticmethod
+    def register_event(name: str) -> int: ...
+    @staticmethod
+    def set_enabled(enabled: bool) -> None: ...
+    pass
 class TypeId():
     """
     Supported Morpheus types
@@ -156,6 +484,10 @@ class TypeId():
       BOOL8
 
       STRING
+
+      FLOAT16
+
+      BFLOAT16
     """
     def __eq__(self, other: object) -> bool: ...
     def __getstate__(self) -> int: ...
@@ -176,8 +508,10 @@ class TypeId():
         """
         :type: int
         """
+    BFLOAT16: morpheus._lib.common.TypeId # value = <TypeId.BFLOAT16: 14>
     BOOL8: morpheus._lib.common.TypeId # value = <TypeId.BOOL8: 11>
     EMPTY: morpheus._lib.common.TypeId # value = <TypeId.EMPTY: 0>
+    FLOAT16: morpheus._lib.common.TypeId # value = <TypeId.FLOAT16: 13>
     FLOAT32: morpheus._lib.common.TypeId # value = <TypeId.FLOAT32: 9>
     FLOAT64: morpheus._lib.common.TypeId # value = <TypeId.FLOAT64: 10>
     INT16: morpheus._lib.common.TypeId # value = <TypeId.INT16: 2>
@@ -189,7 +523,19 @@ class TypeId():
     UINT32: morpheus._lib.common.TypeId # value = <TypeId.UINT32: 7>
     UINT64: morpheus._lib.common.TypeId # value = <TypeId.UINT64: 8>
     UINT8: morpheus._lib.common.TypeId # value = <TypeId.UINT8: 5>
-    __members__: dict # value = {'EMPTY': <TypeId.EMPTY: 0>, 'INT8': <TypeId.INT8: 1>, 'INT16': <TypeId.INT16: 2>, 'INT32': <TypeId.INT32: 3>, 'INT64': <TypeId.INT64: 4>, 'UINT8': <TypeId.UINT8: 5>, 'UINT16': <TypeId.UINT16: 6>, 'UINT32': <TypeId.UINT32: 7>, 'UINT64': <TypeId.UINT64: 8>, 'FLOAT32': <TypeId.FLOAT32: 9>, 'FLOAT64': <TypeId.FLOAT64: 10>, 'BOOL8': <TypeId.BOOL8: 11>, 'STRING': <TypeId.STRING: 12>}
+    __members__: dict # value = {'EMPTY': <TypeId.EMPTY: 0>, 'INT8': <TypeId.INT8: 1>, 'INT16': <TypeId.INT16: 2>, 'INT32': <TypeId.INT32: 3>, 'INT64': <TypeId.INT64: 4>, 'UINT8': <TypeId.UINT8: 5>, 'UINT16': <TypeId.UINT16: 6>, 'UINT32': <TypeId.UINT32: 7>, 'UINT64': <TypeId.UINT64: 8>, 'FLOAT32': <TypeId.FLOAT32: 9>, 'FLOAT64': <TypeId.FLOAT64: 10>, 'BOOL8': <TypeId.BOOL8: 11>, 'STRING': <TypeId.STRING: 12>, 'FLOAT16': <TypeId.FLOAT16: 13>, 'BFLOAT16': <TypeId.BFLOAT16: 14>}
+    pass
+class WarmStartCache():
+    """
+    On-disk cache of the artifacts the C++ stages derive from their input files, such as the device-ready layout of a vocabulary, kept across restarts.
+    """
+    @staticmethod
+    def get_directory() -> str: ...
+    @staticmethod
+    def set_directory(directory: str) -> None: ...
+    pass
+class WordPieceTokenizer(Tokenizer):
+    def __init__(self, vocab_hash_file: str, do_lower_case: bool = False) -> None: ...
     pass
 @typing.overload
 def determine_file_type(filename: os.PathLike) -> FileTypes:
@@ -197,8 +543,12 @@ def determine_file_type(filename: os.PathLike) -> FileTypes:
 @typing.overload
 def determine_file_type(filename: str) -> FileTypes:
     pass
-def read_file_to_df(filename: str, file_type: FileTypes = FileTypes.Auto) -> object:
+def read_file_to_df(filename: str, file_type: FileTypes = FileTypes.Auto, json_lines: typing.Optional[bool] = None, record_path: str = '', flatten: bool = False, explode_lists: bool = False) -> object:
     pass
+def serialize_metrics() -> str:
+    """
+    Serializes the metrics reported by the C++ stages in the Prometheus text exposition format.
+    """
 def typeid_to_numpy_str(arg0: TypeId) -> str:
     pass
 def write_df_to_file(df: object, filename: str, file_type: FileTypes = FileTypes.Auto, **kwargs) -> None:
@@ -21,22 +21,35 @@
 #include "morpheus/io/loaders/grpc.hpp"
 #include "morpheus/io/loaders/payload.hpp"
 #include "morpheus/io/loaders/rest.hpp"
+#include "morpheus/io/loaders/s3.hpp"
 #include "morpheus/io/serializers.hpp"
-#include "morpheus/objects/dtype.hpp"  // for TypeId
+#include "morpheus/objects/dense_model_store.hpp"  // for DenseModelStore, DenseLayer
+#include "morpheus/objects/device_resources.hpp"   // for DeviceResources, MemoryConfig
+#include "morpheus/objects/dtype.hpp"              // for TypeId
+#include "morpheus/objects/feature_scalers.hpp"    // for FeatureScalers
 #include "morpheus/objects/fiber_queue.hpp"
 #include "morpheus/objects/file_types.hpp"  // for FileTypes, determine_file_type
 #include "morpheus/objects/filter_source.hpp"
+#include "morpheus/objects/memory_governor.hpp"
 #include "morpheus/objects/tensor_object.hpp"  // for TensorObject
+#include "morpheus/objects/tokenizer.hpp"      // for ITokenizer, WordPieceTokenizer, BytePairTokenizer, Dedup...
 #include "morpheus/objects/wrapped_tensor.hpp"
 #include "morpheus/utilities/cudf_util.hpp"
 #include "morpheus/utilities/http_server.hpp"
+#include "morpheus/utilities/matx_util.hpp"  // for DenseActivation
+#include "morpheus/utilities/metrics.hpp"
+#include "morpheus/utilities/state_checkpoint.hpp"  // for StateCheckpoint
+#include "morpheus/utilities/trace_buffer.hpp"      // for TraceBuffer
+#include "morpheus/utilities/warm_start_cache.hpp"  // for WarmStartCache
 #include "morpheus/version.hpp"
 
 #include <mrc/utils/string_utils.hpp>
 #include <nlohmann/json.hpp>
 #include <pybind11/attr.h>
+#include <pybind11/functional.h>  // IWYU pragma: keep
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>  // for return_value_policy::reference
+#include <pybind11/stl.h>      // IWYU pragma: keep
 // for pathlib.Path -> std::filesystem::path conversions
 #include <pybind11/stl/filesystem.h>  // IWYU pragma: keep
 
@@ -84,18 +97,36 @@ PYBIND11_MODULE(common, _module)
             return std::make_unique<RESTDataLoader>(config);
         },
         false);
+    LoaderRegistry::register_factory_fn(
+        "s3",
+        [](nlohmann::json config) {
+            return std::make_unique<S3DataLoader>(config);
+        },
+        false);
 
     py::class_<TensorObject>(_module, "Tensor")
         .def_property_readonly("__cuda_array_interface__", &TensorObjectInterfaceProxy::cuda_array_interface)
+        .def("__dlpack__", &TensorObjectInterfaceProxy::dlpack, py::arg("stream") = py::none())
+        .def("__dlpack_device__", &TensorObjectInterfaceProxy::dlpack_device)
         // No need to keep_alive here since cupy arrays have an owner object
         .def("to_cupy", &TensorObjectInterfaceProxy::to_cupy)
         // Need to set keep_alive here to keep the cupy array alive as long as the Tensor is
         .def_static("from_cupy", &TensorObjectInterfaceProxy::from_cupy, py::keep_alive<0, 1>());
 
     py::class_<FiberQueue, std::shared_ptr<FiberQueue>>(_module, "FiberQueue")
-        .def(py::init<>(&FiberQueueInterfaceProxy::init), py::arg("max_size"))
+        .def(py::init<>(&FiberQueueInterfaceProxy::init), py::arg("max_size"), py::arg("lock_free") = false)
         .def("get", &FiberQueueInterfaceProxy::get, py::arg("block") = true, py::arg("timeout") = 0.0)
         .def("put", &FiberQueueInterfaceProxy::put, py::arg("item"), py::arg("block") = true, py::arg("timeout") = 0.0)
+        .def("get_many",
+             &FiberQueueInterfaceProxy::get_many,
+             py::arg("max_items"),
+             py::arg("block")   = true,
+             py::arg("timeout") = 0.0)
+        .def("put_many",
+             &FiberQueueInterfaceProxy::put_many,
+             py::arg("items"),
+             py::arg("block")   = true,
+             py::arg("timeout") = 0.0)
         .def("close", &FiberQueueInterfaceProxy::close)
         .def("is_closed", &FiberQueueInterfaceProxy::is_closed)
         .def("__enter__", &FiberQueueInterfaceProxy::enter, py::return_value_policy::reference)
@@ -114,7 +145,9 @@ PYBIND11_MODULE(common, _module)
         .value("FLOAT32", TypeId::FLOAT32)
         .value("FLOAT64", TypeId::FLOAT64)
         .value("BOOL8", TypeId::BOOL8)
-        .value("STRING", TypeId::STRING);
+        .value("STRING", TypeId::STRING)
+        .value("FLOAT16", TypeId::FLOAT16)
+        .value("BFLOAT16", TypeId::BFLOAT16);
 
     py::enum_<FileTypes>(_module,
                          "FileTypes",
@@ -134,7 +167,14 @@ PYBIND11_MODULE(common, _module)
     _module.def("determine_file_type",
                 py::overload_cast<const std::filesystem::path&>(&determine_file_type),
                 py::arg("filename"));
-    _module.def("read_file_to_df", &read_file_to_df, py::arg("filename"), py::arg("file_type") = FileTypes::Auto);
+    _module.def("read_file_to_df",
+                &read_file_to_df,
+                py::arg("filename"),
+                py::arg("file_type")     = FileTypes::Auto,
+                py::arg("json_lines")    = py::none(),
+                py::arg("record_path")   = "",
+                py::arg("flatten")       = false,
+                py::arg("explode_lists") = false);
     _module.def("write_df_to_file",
                 &SerializersProxy::write_df_to_file,
                 py::arg("df"),
@@ -150,19 +190,183 @@ PYBIND11_MODULE(common, _module)
     py::class_<HttpServer, std::shared_ptr<HttpServer>>(_module, "HttpServer")
         .def(py::init<>(&HttpServerInterfaceProxy::init),
              py::arg("parse_fn"),
-             py::arg("bind_address")     = "127.0.0.1",
-             py::arg("port")             = 8080,
-             py::arg("endpoint")         = "/message",
-             py::arg("method")           = "POST",
-             py::arg("num_threads")      = 1,
-             py::arg("max_payload_size") = DefaultMaxPayloadSize,
-             py::arg("request_timeout")  = 30)
+             py::arg("bind_address")      = "127.0.0.1",
+             py::arg("port")              = 8080,
+             py::arg("endpoint")          = "/message",
+             py::arg("method")            = "POST",
+             py::arg("num_threads")       = 1,
+             py::arg("max_payload_size")  = DefaultMaxPayloadSize,
+             py::arg("request_timeout")   = 30,
+             py::arg("stream_chunk_size") = 0)
         .def("start", &HttpServerInterfaceProxy::start)
         .def("stop", &HttpServerInterfaceProxy::stop)
         .def("is_running", &HttpServerInterfaceProxy::is_running)
         .def("__enter__", &HttpServerInterfaceProxy::enter, py::return_value_policy::reference)
         .def("__exit__", &HttpServerInterfaceProxy::exit);
 
+    py::class_<MetricsServer, std::shared_ptr<MetricsServer>>(
+        _module,
+        "MetricsServer",
+        "Serves the metrics reported by the C++ stages to Prometheus, answering GET requests on `endpoint`.")
+        .def(py::init<std::string, unsigned short, std::string, unsigned short>(),
+             py::arg("bind_address") = "127.0.0.1",
+             py::arg("port")         = 9464,
+             py::arg("endpoint")     = "/metrics",
+             py::arg("num_threads")  = 1)
+        .def("start", &MetricsServerInterfaceProxy::start)
+        .def("stop", &MetricsServerInterfaceProxy::stop)
+        .def("is_running", &MetricsServerInterfaceProxy::is_running)
+        .def("__enter__", &MetricsServerInterfaceProxy::enter, py::return_value_policy::reference)
+        .def("__exit__", &MetricsServerInterfaceProxy::exit);
+
+    py::enum_<DeviceResourceType>(
+        _module, "DeviceResourceType", "Device memory resource at the bottom of the stack installed by DeviceResources")
+        .value("CUDA", DeviceResourceType::CUDA)
+        .value("POOL", DeviceResourceType::POOL)
+        .value("ASYNC", DeviceResourceType::ASYNC);
+
+    py::class_<MemoryConfig>(
+        _module, "MemoryConfig", "Configuration of the device memory resources and streams used by the C++ stages.")
+        .def(py::init<>())
+        .def_readwrite("resource_type", &MemoryConfig::resource_type)
+        .def_readwrite("initial_pool_size", &MemoryConfig::initial_pool_size)
+        .def_readwrite("maximum_pool_size", &MemoryConfig::maximum_pool_size)
+        .def_readwrite("use_arena", &MemoryConfig::use_arena)
+        .def_readwrite("arena_size", &MemoryConfig::arena_size)
+        .def_readwrite("limit", &MemoryConfig::limit)
+        .def_readwrite("log_file", &MemoryConfig::log_file)
+        .def_readwrite("dedicated_streams", &MemoryConfig::dedicated_streams);
+
+    py::class_<DeviceResources>(
+        _module,
+        "DeviceResources",
+        "Installs the stack of device memory resources described by a MemoryConfig on the current device.")
+        .def_static("install", &DeviceResources::install, py::arg("config"))
+        .def_static("is_installed", &DeviceResources::is_installed);
+
+    py::class_<TraceBuffer>(_module,
+                            "TraceBuffer",
+                            "Per-thread ring buffers of the most recent trace events recorded by the C++ stages, "
+                            "decoded by `morpheus.utils.trace_decoder`.")
+        .def_static("is_enabled", &TraceBuffer::is_enabled)
+        .def_static("set_enabled", &TraceBuffer::set_enabled, py::arg("enabled"))
+        .def_static("register_event", &TraceBuffer::register_event, py::arg("name"))
+        .def_static("record",
+                    &TraceBuffer::record,
+                    py::arg("event"),
+                    py::arg("arg0") = 0,
+                    py::arg("arg1") = 0,
+                    py::arg("arg2") = 0,
+                    py::arg("arg3") = 0)
+        .def_static("event_names", &TraceBuffer::event_names)
+        .def_static("dump", &TraceBuffer::dump, py::arg("path"), py::call_guard<py::gil_scoped_release>())
+        .def_static("dump_on_signal", &TraceBuffer::dump_on_signal, py::arg("signal"), py::arg("path"))
+        .def_static("dump_on_error",
+                    &TraceBuffer::dump_on_error,
+                    py::arg("path"),
+                    py::arg("min_interval_seconds") = 10);
+
+    py::class_<StateCheckpoint>(_module,
+                                "StateCheckpoint",
+                                "Directory of the checkpoints of the state of the C++ stages, such as deduplication "
+                                "windows and rolling window histories, restored by a restarted pipeline.")
+        .def_static("set_directory", &StateCheckpoint::set_directory, py::arg("directory"))
+        .def_static("get_directory", &StateCheckpoint::get_directory);
+
+    py::class_<WarmStartCache>(_module,
+                               "WarmStartCache",
+                               "On-disk cache of the artifacts the C++ stages derive from their input files, such as "
+                               "the device-ready layout of a vocabulary, kept across restarts.")
+        .def_static("set_directory", &WarmStartCache::set_directory, py::arg("directory"))
+        .def_static("get_directory", &WarmStartCache::get_directory);
+
+    // The governor lives for the duration of the process, it is never deleted from python
+    py::class_<MemoryGovernor, std::unique_ptr<MemoryGovernor, py::nodelete>>(
+        _module,
+        "MemoryGovernor",
+        "Tracks the device memory allocated by the C++ stages, pausing the Kafka and HTTP sources while it is above "
+        "the high watermark.")
+        .def_static("install",
+                    &MemoryGovernorInterfaceProxy::install,
+                    py::arg("high_watermark"),
+                    py::arg("low_watermark"),
+                    py::return_value_policy::reference)
+        .def_static("get", &MemoryGovernor::get, py::return_value_policy::reference)
+        .def_property_readonly("high_watermark", &MemoryGovernor::high_watermark)
+        .def_property_readonly("low_watermark", &MemoryGovernor::low_watermark)
+        .def_property_readonly("live_bytes", &MemoryGovernor::live_bytes)
+        .def("is_throttled", &MemoryGovernor::is_throttled);
+
+    py::class_<ITokenizer, std::shared_ptr<ITokenizer>>(
+        _module, "Tokenizer", "Tokenizer of the `PreprocessNLPStage`, tokenizing strings on the device.");
+
+    py::class_<WordPieceTokenizer, ITokenizer, std::shared_ptr<WordPieceTokenizer>>(_module, "WordPieceTokenizer")
+        .def(py::init<std::string, bool>(), py::arg("vocab_hash_file"), py::arg("do_lower_case") = false);
+
+    py::class_<BytePairTokenizer, ITokenizer, std::shared_ptr<BytePairTokenizer>>(_module, "BytePairTokenizer")
+        .def(py::init<const std::string&, const std::string&, const std::string&, std::string>(),
+             py::arg("merges_file"),
+             py::arg("vocab_file"),
+             py::arg("unknown_token") = "<unk>",
+             py::arg("word_prefix")   = "\u0120");
+
+    py::class_<DeduplicatingTokenizer, ITokenizer, std::shared_ptr<DeduplicatingTokenizer>>(_module,
+                                                                                          "DeduplicatingTokenizer")
+        .def(py::init<std::shared_ptr<ITokenizer>>(), py::arg("tokenizer"));
+
+    py::enum_<DenseActivation>(_module, "DenseActivation", "Activation applied to the outputs of a DenseLayer")
+        .value("NONE", DenseActivation::NONE)
+        .value("RELU", DenseActivation::RELU)
+        .value("SIGMOID", DenseActivation::SIGMOID)
+        .value("TANH", DenseActivation::TANH)
+        .value("LEAKY_RELU", DenseActivation::LEAKY_RELU);
+
+    py::class_<DenseLayer>(_module,
+                           "DenseLayer",
+                           "Fully connected layer of a model held by a DenseModelStore, the weights being the row major "
+                           "`output_size` by `input_size` values of `torch.nn.Linear.weight`.")
+        .def(py::init<>())
+        .def_readwrite("input_size", &DenseLayer::input_size)
+        .def_readwrite("output_size", &DenseLayer::output_size)
+        .def_readwrite("weights", &DenseLayer::weights)
+        .def_readwrite("biases", &DenseLayer::biases)
+        .def_readwrite("activation", &DenseLayer::activation);
+
+    py::class_<DenseModelStore, std::shared_ptr<DenseModelStore>>(
+        _module,
+        "DenseModelStore",
+        "Device resident store of many small fully connected models, such as one autoencoder per user, run by the "
+        "`GroupedDenseInferenceStage`.")
+        .def(py::init<std::size_t, DenseModelStore::loader_fn_t, std::string>(),
+             py::arg("max_models"),
+             py::arg("loader")              = nullptr,
+             py::arg("fallback_model_name") = "")
+        .def("model_index", &DenseModelStore::model_index, py::arg("model_name"))
+        .def("set_model",
+             &DenseModelStore::set_model,
+             py::arg("model_name"),
+             py::arg("layers"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("num_resident", &DenseModelStore::num_resident)
+        .def("is_resident", &DenseModelStore::is_resident, py::arg("model_name"));
+
+    py::class_<FeatureScalers, std::shared_ptr<FeatureScalers>>(
+        _module,
+        "FeatureScalers",
+        "Precomputed standard, min-max and one-hot scalers of the features of an autoencoder, global or per user, "
+        "applied on the device by the `PreprocessAEStage`.")
+        .def(py::init<std::string>(), py::arg("filename"))
+        .def_property_readonly("feature_columns", &FeatureScalers::feature_columns)
+        .def_property_readonly("num_inputs", &FeatureScalers::num_inputs)
+        .def("has_user", &FeatureScalers::has_user, py::arg("user_id"));
+
+    _module.def(
+        "serialize_metrics",
+        []() {
+            return MetricsRegistry::get_instance().serialize();
+        },
+        "Serializes the metrics reported by the C++ stages in the Prometheus text exposition format.");
+
     _module.attr("__version__") =
         MRC_CONCAT_STR(morpheus_VERSION_MAJOR << "." << morpheus_VERSION_MINOR << "." << morpheus_VERSION_PATCH);
 }
@@ -5,10 +5,25 @@ import morpheus._lib.messages
 import mrc.core.segment
 
 __all__ = [
-    "DocaSourceStage"
+    "DocaFlowAggregationStage",
+    "DocaPcapSourceStage",
+    "DocaSourceStage",
+    "DocaStreamReassemblyStage"
 ]
 
 
+class DocaFlowAggregationStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, max_flows: int = 262144, idle_timeout: float = 15.0, active_timeout: float = 120.0) -> None: ...
+    pass
+
+class DocaPcapSourceStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, pcap_file: str, traffic_type: str, packets_per_second: float = 0.0, repeat: int = 1, numeric_addresses: bool = False) -> None: ...
+    pass
+
 class DocaSourceStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, nic_pci_address: str, gpu_pci_address: str, traffic_type: str) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, nic_pci_address: str, gpu_pci_address: str, traffic_type: str, numeric_addresses: bool = False, src_ports: typing.List[str] = [], dst_ports: typing.List[str] = [], src_networks: typing.List[str] = [], dst_networks: typing.List[str] = [], min_payload_size: int = 0, max_payload_size: int = -1, tcp_flags_mask: int = 0, tcp_flags_value: int = 0, bind_to_nic: bool = False, capture_path: str = '') -> None: ...
+    pass
+
+class DocaStreamReassemblyStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, max_streams: int = 262144, max_buffered_bytes: int = 268435456, idle_timeout: float = 60.0, gap_timeout: float = 0.5) -> None: ...
     pass
@@ -45,17 +45,22 @@ struct packets_info
     int32_t packet_count_out;
     int32_t payload_size_total_out;
 
+    // Payloads packed back to back, the layout of the chars and offsets of a strings column
     char* payload_buffer_out;
-    int32_t* payload_sizes_out;
+    int32_t* payload_offsets_out;  // packet_count_out + 1 offsets
 
     int64_t* src_mac_out;
     int64_t* dst_mac_out;
     int64_t* src_ip_out;
     int64_t* dst_ip_out;
+    uint64_t* src_ip6_out;  // 128-bit addresses, two words per packet (low, high)
+    uint64_t* dst_ip6_out;
     uint16_t* src_port_out;
     uint16_t* dst_port_out;
     int32_t* tcp_flags_out;
+    uint32_t* tcp_seq_out;  // 0 for UDP
     int32_t* ether_type_out;
+    int32_t* vlan_id_out;
     int32_t* next_proto_id_out;
     uint32_t* timestamp_out;
 };
\ No newline at end of file
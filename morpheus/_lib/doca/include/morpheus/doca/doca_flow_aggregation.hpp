@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Aggregates the packets emitted by `DocaSourceStage` into flows keyed by 5-tuple on the GPU, emitting a
+ * `MessageMeta` of flow records (packet and byte counts, TCP flag counts and inter-arrival time statistics) each time
+ * flows expire. Any remaining flows are emitted once the input completes.
+ *
+ * Requires the source to be configured with `numeric_addresses`, flows are keyed by the 128-bit `src_ip6` and `dst_ip6`
+ * addresses and the `src_ip` and `dst_ip` columns of the flow records hold these 128-bit addresses. The flow table is
+ * shared by all of the packets received by the stage, so the stage should run with a single progress engine.
+ */
+class DocaFlowAggregationStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Doca Flow Aggregation Stage object
+     *
+     * @param max_flows : Maximum number of concurrent flows, packets of new flows are dropped once the table is full
+     * @param idle_timeout : A flow is expired once no packets have been received for this long
+     * @param active_timeout : A flow is expired once it has been active for this long, long-lived flows are emitted as
+     * multiple records
+     */
+    DocaFlowAggregationStage(std::size_t max_flows                    = 1 << 18,
+                             std::chrono::milliseconds idle_timeout   = std::chrono::seconds(15),
+                             std::chrono::milliseconds active_timeout = std::chrono::seconds(120));
+
+  private:
+    subscribe_fn_t build_operator();
+
+    std::size_t m_max_flows;
+    std::chrono::milliseconds m_idle_timeout;
+    std::chrono::milliseconds m_active_timeout;
+};
+
+/****** DocaFlowAggregationStageInterfaceProxy**************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct DocaFlowAggregationStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a DocaFlowAggregationStage, and return the result.
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param max_flows : Maximum number of concurrent flows
+     * @param idle_timeout : Idle timeout in seconds
+     * @param active_timeout : Active timeout in seconds
+     */
+    static std::shared_ptr<mrc::segment::Object<DocaFlowAggregationStage>> init(mrc::segment::Builder& builder,
+                                                                                std::string const& name,
+                                                                                std::size_t max_flows,
+                                                                                double idle_timeout,
+                                                                                double active_timeout);
+};
+
+#pragma GCC visibility pop
+
+}  // namespace morpheus
@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cudf/column/column_view.hpp>
+#include <cudf/table/table.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus::doca {
+
+/**
+ * @brief Packet columns aggregated by `FlowTable`, as emitted by `DocaSourceStage` with `numeric_addresses` enabled.
+ */
+struct FlowPacketColumns
+{
+    cudf::column_view src_ip;      // DECIMAL128, IPv6 or IPv4-mapped IPv6 address
+    cudf::column_view dst_ip;      // DECIMAL128
+    cudf::column_view src_port;    // UINT16
+    cudf::column_view dst_port;    // UINT16
+    cudf::column_view next_proto;  // INT32
+    cudf::column_view tcp_flags;   // INT32, only read for TCP packets
+    cudf::column_view timestamp;   // UINT32, milliseconds
+    cudf::column_view data;        // STRING, payload
+};
+
+/**
+ * @brief Device resident table of flows keyed by 5-tuple (source/destination address and port, and protocol).
+ *
+ * Each batch of packets is sorted by flow and reduced on the GPU before being merged into an open addressing hash map,
+ * so each flow is updated by a single thread. A flow is expired once no packets have been seen for `idle_timeout`, or
+ * once it has been active for `active_timeout`, measured against the packet timestamps rather than wall time. Expired
+ * flows are removed from the table and returned as flow records.
+ *
+ * Slots of expired flows are only reused once the table is rebuilt, which happens when the used slots exceed three
+ * quarters of the capacity. Packets of new flows which do not fit in the table are dropped and counted.
+ */
+class FlowTable
+{
+  public:
+    /**
+     * @brief Construct a new Flow Table object
+     *
+     * @param max_flows : Capacity of the table, rounded up to a power of two
+     * @param idle_timeout : Time since the last packet of a flow after which the flow is expired
+     * @param active_timeout : Time since the first packet of a flow after which the flow is expired
+     * @param stream : Stream used to allocate the table
+     */
+    FlowTable(std::size_t max_flows,
+              std::chrono::milliseconds idle_timeout,
+              std::chrono::milliseconds active_timeout,
+              rmm::cuda_stream_view stream);
+
+    ~FlowTable();
+
+    /**
+     * @brief Aggregates `packets` into the table, returning the flows which expired as of the latest packet timestamp,
+     * or nullptr if no flows expired.
+     */
+    std::unique_ptr<cudf::table> update(const FlowPacketColumns& packets, rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Expires all of the flows in the table, returning them or nullptr if the table is empty.
+     */
+    std::unique_ptr<cudf::table> flush(rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Total number of packets dropped because the table was full.
+     */
+    std::size_t num_dropped_packets() const;
+
+    /**
+     * @brief Names of the columns of the flow records returned by `update` and `flush`.
+     */
+    static const std::vector<std::string>& column_names();
+
+  private:
+    std::unique_ptr<cudf::table> expire(uint32_t now, bool force, rmm::cuda_stream_view stream);
+
+    void rebuild(rmm::cuda_stream_view stream);
+
+    std::size_t m_capacity;
+    uint32_t m_idle_timeout_ms;
+    uint32_t m_active_timeout_ms;
+
+    rmm::device_buffer m_entries;
+    rmm::device_buffer m_expired;
+    rmm::device_buffer m_counters;
+
+    // Slots which are either holding a flow or the tombstone of an expired flow
+    std::size_t m_num_used{0};
+    std::size_t m_num_dropped{0};
+};
+
+}  // namespace morpheus::doca
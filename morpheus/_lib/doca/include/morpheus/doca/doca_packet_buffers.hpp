@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/doca/common.hpp"
+
+#include <cudf/io/types.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_uvector.hpp>
+
+#include <cstdint>
+
+namespace morpheus::doca {
+
+/**
+ * @brief Device buffers for a single batch of up to `MAX_PKT_RECEIVE` packets in the `packets_info` layout written by
+ * the receive kernels, along with the conversion of a received batch into a table.
+ *
+ * Shared by the sources receiving packets from a NIC and replaying them from a capture, so both emit the same columns.
+ */
+class PacketBuffers
+{
+  public:
+    PacketBuffers(rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Points the outputs of `info` at these buffers.
+     */
+    void set_outputs(packets_info& info);
+
+    /**
+     * @brief Builds a table of the `info.packet_count_out` packets written to these buffers.
+     *
+     * The columns are handed off as-is rather than copied, the buffers are replaced with freshly allocated ones and
+     * `info` is pointed at them. The payloads were packed by the kernel, so the payload buffer and offsets become the
+     * chars and offsets of the `data` strings column, `info.payload_size_total_out` giving the size of the chars. The
+     * payload bytes are thus copied once, from the receive buffers, before reaching the tokenizer; in exchange each
+     * batch holds on to a full-sized payload buffer for as long as its `data` column is alive. The replacement buffers
+     * are allocated on `stream`, the caller must synchronize `stream` before they are written to.
+     *
+     * @param info : Outputs of the batch, as set by `set_outputs`
+     * @param numeric_addresses : If true, the MAC and IP address columns are emitted as integers, along with the
+     * 128-bit `src_ip6` and `dst_ip6` columns, rather than strings
+     * @param stream : Stream used to build the table
+     */
+    cudf::io::table_with_metadata make_table(packets_info& info,
+                                             bool numeric_addresses,
+                                             rmm::cuda_stream_view stream);
+
+  private:
+    rmm::device_uvector<char> m_payload_buffer;
+    rmm::device_uvector<int32_t> m_payload_offsets;
+    rmm::device_uvector<int64_t> m_src_mac;
+    rmm::device_uvector<int64_t> m_dst_mac;
+    rmm::device_uvector<int64_t> m_src_ip;
+    rmm::device_uvector<int64_t> m_dst_ip;
+    rmm::device_uvector<__int128_t> m_src_ip6;
+    rmm::device_uvector<__int128_t> m_dst_ip6;
+    rmm::device_uvector<uint16_t> m_src_port;
+    rmm::device_uvector<uint16_t> m_dst_port;
+    rmm::device_uvector<int32_t> m_tcp_flags;
+    rmm::device_uvector<uint32_t> m_tcp_seq;
+    rmm::device_uvector<int32_t> m_ether_type;
+    rmm::device_uvector<int32_t> m_vlan_id;
+    rmm::device_uvector<int32_t> m_next_proto_id;
+    rmm::device_uvector<uint32_t> m_timestamp;
+};
+
+}  // namespace morpheus::doca
@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/doca/common.hpp"
+#include "morpheus/messages/meta.hpp"
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Replays the packets of a pcap or pcapng capture through the same GPU parsing and table-building code as
+ * `DocaSourceStage`, emitting identical columns without requiring a NIC. Intended for benchmarking the post-receive
+ * path and everything downstream of it reproducibly.
+ *
+ * The capture is memory mapped and read in batches of up to `MAX_PKT_RECEIVE` packets, each of which is staged into
+ * GPU memory and parsed by the replay kernel into the `packets_info` layout written by the receive kernel. As with the
+ * flow pipe of the receive path, only TCP or UDP packets over IPv4 or IPv6 matching `traffic_type` are replayed,
+ * frames longer than `MAX_PKT_SIZE` are truncated. The `timestamp` column holds the capture timestamps, offset on each
+ * pass so that they keep increasing. The replay throughput is logged once the replay completes.
+ */
+class DocaPcapSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonSource<std::shared_ptr<MessageMeta>>;
+    using typename base_t::source_type_t;
+    using typename base_t::subscriber_fn_t;
+
+    /**
+     * @brief Construct a new Doca Pcap Source Stage object
+     *
+     * @param pcap_file : Path of the pcap or pcapng capture to replay
+     * @param traffic_type : Type of traffic to replay, either "udp" or "tcp"
+     * @param packets_per_second : Rate at which packets are replayed, or 0 to replay as fast as possible
+     * @param repeat : Number of times to replay the capture
+     * @param numeric_addresses : If true, the MAC and IP address columns are emitted as integers rather than strings
+     */
+    DocaPcapSourceStage(std::string pcap_file,
+                        std::string const& traffic_type,
+                        double packets_per_second = 0,
+                        std::size_t repeat        = 1,
+                        bool numeric_addresses    = false);
+
+  private:
+    subscriber_fn_t build();
+
+    std::string m_pcap_file;
+    enum doca_traffic_type m_traffic_type;
+    double m_packets_per_second;
+    std::size_t m_repeat;
+    bool m_numeric_addresses;
+};
+
+/****** DocaPcapSourceStageInterfaceProxy*******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct DocaPcapSourceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a DocaPcapSourceStage, and return the result.
+     */
+    static std::shared_ptr<mrc::segment::Object<DocaPcapSourceStage>> init(mrc::segment::Builder& builder,
+                                                                           std::string const& name,
+                                                                           std::string pcap_file,
+                                                                           std::string const& traffic_type,
+                                                                           double packets_per_second,
+                                                                           std::size_t repeat,
+                                                                           bool numeric_addresses);
+};
+
+#pragma GCC visibility pop
+
+}  // namespace morpheus
@@ -19,6 +19,7 @@
 
 #include "morpheus/doca/doca_context.hpp"
 #include "morpheus/doca/doca_rx_queue.hpp"
+#include "morpheus/doca/packet_filter.hpp"
 
 namespace morpheus::doca {
 
@@ -30,8 +31,12 @@ namespace morpheus::doca {
  * TCP/UDP as well as other types of filtering is done with GPUNetIO. Eventually packets will be
  * placed in a Receive Queue at which point they can be read using a Semaphore.
  *
- * In this implementation, a single Root Pipe is connected to a single TCP-filtering Pipe which is
- * then connected to the given Receive Queue.
+ * In this implementation, a single Root Pipe is connected to one TCP or UDP filtering Pipe for IPv4 and one for IPv6,
+ * both of which spread packets across the given Receive Queues.
+ *
+ * When the destination ports of the packet filter can be offloaded, see `offloadable_dst_ports`, both Pipes hold one
+ * entry per port so packets to any other port are dropped by the NIC. The remaining rules are only evaluated by the
+ * receive kernel.
  */
 struct DocaRxPipe
 {
@@ -40,12 +45,14 @@ struct DocaRxPipe
     std::vector<std::shared_ptr<morpheus::doca::DocaRxQueue>> m_rxq;
     enum doca_traffic_type m_traffic_type;
     doca_flow_pipe* m_pipe;
+    doca_flow_pipe* m_pipe_ipv6;
     doca_flow_pipe* m_root_pipe;
 
   public:
     DocaRxPipe(std::shared_ptr<DocaContext> context,
                std::vector<std::shared_ptr<morpheus::doca::DocaRxQueue>> rxq,
-               doca_traffic_type const type);
+               doca_traffic_type const type,
+               packet_filter const& filter = {});
     ~DocaRxPipe();
 };
 
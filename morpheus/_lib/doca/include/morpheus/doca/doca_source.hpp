@@ -18,12 +18,16 @@
 #pragma once
 
 #include "morpheus/doca/common.hpp"
+#include "morpheus/doca/packet_filter.hpp"
+#include "morpheus/io/source_capture.hpp"
 #include "morpheus/messages/meta.hpp"
 
 #include <mrc/segment/builder.hpp>
 #include <pymrc/node.hpp>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace morpheus {
 
@@ -40,6 +44,17 @@ struct DocaSemaphore;
 /**
  * @brief Receives a firehose of raw packets from a GPUNetIO-enabled device.
  *
+ * Each CPU thread services the receive queues `rank`, `rank + size`, ..., launching a single persistent receive
+ * kernel for all of them and draining the semaphore slots as they become ready.
+ *
+ * IPv4 and IPv6 packets are received, including frames with up to two VLAN tags whose IDs are emitted in the
+ * `vlan_id` column. Addresses are formatted as strings covering both versions, or with `numeric_addresses` the IPv4
+ * addresses are emitted as integers alongside the `src_ip6` and `dst_ip6` columns holding the 128-bit addresses of
+ * both versions, with IPv4 addresses mapped into IPv6 (`::ffff:a.b.c.d`).
+ *
+ * Packets are filtered by the receive kernel with a `doca::packet_filter`, before their headers and payload are copied,
+ * with the destination ports matched by the NIC when they can be offloaded.
+ *
  * Tested only on ConnectX 6-Dx with a single GPU on the same NUMA node running firmware 24.35.2000
  */
 class DocaSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<MessageMeta>>
@@ -49,9 +64,27 @@ class DocaSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<MessageM
     using typename base_t::source_type_t;
     using typename base_t::subscriber_fn_t;
 
+    /**
+     * @brief Construct a new Doca Source Stage object
+     *
+     * @param nic_pci_address : The PCI Address of the NIC from which to receive packets
+     * @param gpu_pci_address : The PCI Address of the GPU which will receive packets
+     * @param traffic_type : Type of traffic to receive, either "udp" or "tcp"
+     * @param numeric_addresses : If true, the MAC and IP address columns are emitted as integers rather than strings,
+     * skipping the string conversion for pipelines which only need numeric features
+     * @param filter : Rules the packets must match to be emitted, every packet is emitted by default
+     * @param bind_to_nic : If true, each thread receiving packets is bound to the CPUs local to the NIC, keeping the
+     * polling of its queues on the socket of the NIC. The placement of each thread is logged when it starts.
+     * @param capture_path : When not empty, the table of every received batch of packets is also recorded to this
+     * capture log, to be replayed by the `ReplaySourceStage`, see `SourceCaptureWriter`
+     */
     DocaSourceStage(std::string const& nic_pci_address,
                     std::string const& gpu_pci_address,
-                    std::string const& traffic_type);
+                    std::string const& traffic_type,
+                    bool numeric_addresses                      = false,
+                    morpheus::doca::packet_filter const& filter = {},
+                    bool bind_to_nic                            = false,
+                    std::string const& capture_path             = "");
 
   private:
     subscriber_fn_t build();
@@ -61,6 +94,11 @@ class DocaSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<MessageM
     std::vector<std::shared_ptr<morpheus::doca::DocaSemaphore>> m_semaphore;
     std::shared_ptr<morpheus::doca::DocaRxPipe> m_rxpipe;
     enum doca_traffic_type m_traffic_type;
+    bool m_numeric_addresses;
+    morpheus::doca::packet_filter m_filter;
+    std::string m_nic_pci_address;
+    bool m_bind_to_nic;
+    std::shared_ptr<SourceCaptureWriter> m_capture;  // Unset unless capturing
     rmm::cuda_stream rstream;
 };
 
@@ -71,13 +109,25 @@ class DocaSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<MessageM
 struct DocaSourceStageInterfaceProxy
 {
     /**
-     * @brief Create and initialize a DocaSourceStage, and return the result.
+     * @brief Create and initialize a DocaSourceStage, and return the result. The filter rules are parsed with
+     * `doca::make_packet_filter`.
      */
     static std::shared_ptr<mrc::segment::Object<DocaSourceStage>> init(mrc::segment::Builder& builder,
                                                                        std::string const& name,
                                                                        std::string const& nic_pci_address,
                                                                        std::string const& gpu_pci_address,
-                                                                       std::string const& traffic_type);
+                                                                       std::string const& traffic_type,
+                                                                       bool numeric_addresses,
+                                                                       std::vector<std::string> const& src_ports,
+                                                                       std::vector<std::string> const& dst_ports,
+                                                                       std::vector<std::string> const& src_networks,
+                                                                       std::vector<std::string> const& dst_networks,
+                                                                       int32_t min_payload_size,
+                                                                       int32_t max_payload_size,
+                                                                       uint8_t tcp_flags_mask,
+                                                                       uint8_t tcp_flags_value,
+                                                                       bool bind_to_nic,
+                                                                       std::string const& capture_path);
 };
 
 #pragma GCC visibility pop
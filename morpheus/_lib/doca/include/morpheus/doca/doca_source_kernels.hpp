@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include "morpheus/doca/common.hpp"
+#include "morpheus/doca/packet_filter.hpp"
+
 #include <cudf/column/column.hpp>
 #include <cudf/column/column_view.hpp>
 #include <doca_eth_rxq.h>
@@ -29,26 +32,60 @@
 
 namespace morpheus::doca {
 
-std::unique_ptr<cudf::column> gather_payload(
-    int32_t packet_count,
-    char* payload_buffer,
-    int32_t* payload_sizes,
+std::unique_ptr<cudf::column> integers_to_mac(
+    cudf::column_view const& integers,
     rmm::cuda_stream_view stream        = cudf::detail::default_stream_value,
     rmm::mr::device_memory_resource* mr = rmm::mr::get_current_device_resource());
 
-std::unique_ptr<cudf::column> integers_to_mac(
-    cudf::column_view const& integers,
+/**
+ * @brief Converts a DECIMAL128 column of 128-bit addresses to strings, IPv4-mapped addresses are formatted in dotted
+ * decimal and all other addresses as compressed IPv6 text.
+ */
+std::unique_ptr<cudf::column> ip_addresses_to_strings(
+    cudf::column_view const& addresses,
     rmm::cuda_stream_view stream        = cudf::detail::default_stream_value,
     rmm::mr::device_memory_resource* mr = rmm::mr::get_current_device_resource());
 
-void packet_receive_kernel(doca_gpu_eth_rxq* rxq,
-                           doca_gpu_semaphore_gpu* sem,
-                           uint16_t sem_idx,
+/**
+ * @brief Receive queues serviced by a single launch of `packet_receive_kernel`, along with the semaphore of each queue.
+ * Passed to the kernel by value.
+ */
+struct packet_receive_queues
+{
+    doca_gpu_eth_rxq* rxq[MAX_QUEUE];
+    doca_gpu_semaphore_gpu* sem[MAX_QUEUE];
+};
+
+/**
+ * @brief Launches a persistent receive kernel servicing the first `num_queues` queues of `queues`, one block per queue.
+ * Each block fills the semaphore slots of its queue in order, waiting for the CPU to free a slot before reusing it, and
+ * returns once `exit_condition` is set. The kernel does not return on its own, callers should set `exit_condition` from
+ * the host before synchronizing `stream`.
+ *
+ * Packets which do not pass `filter` are dropped before anything is copied, the kept packets being compacted to the
+ * front of the slot. Bursts where every packet was dropped do not consume a slot. The payloads are copied once, from
+ * the receive buffers straight into the packed layout of a strings column.
+ */
+void packet_receive_kernel(packet_receive_queues const& queues,
+                           uint32_t num_queues,
                            bool is_tcp,
+                           packet_filter const& filter,
                            uint32_t* exit_condition,
                            cudaStream_t stream);
 
-void packet_gather_kernel(
-    int32_t packet_count, char* packet_buffer, int32_t* payload_sizes, char* payload_chars_out, cudaStream_t stream);
+/**
+ * @brief Parses `packet_count` captured frames already staged in device memory into `info`, writing the same outputs as
+ * `packet_receive_kernel`. Frame `i` starts at `frames + frame_offsets[i]` and holds `frame_lengths[i]` bytes, the
+ * timestamps are written as-is. Unlike the receive kernel, `info.packet_count_out` and `info.payload_size_total_out`
+ * are not written, the total being the last of the `packet_count + 1` payload offsets.
+ */
+void packet_replay_kernel(uint8_t const* frames,
+                          uint32_t const* frame_offsets,
+                          uint32_t const* frame_lengths,
+                          uint32_t const* timestamps,
+                          int32_t packet_count,
+                          bool is_tcp,
+                          packets_info const& info,
+                          cudaStream_t stream);
 
 }  // namespace morpheus::doca
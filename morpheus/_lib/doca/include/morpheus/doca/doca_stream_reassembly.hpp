@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Reassembles the TCP segments emitted by `DocaSourceStage` into ordered byte streams keyed by 5-tuple on the
+ * GPU, emitting a `MessageMeta` holding a chunk per stream which advanced in each batch. See `doca::StreamTable`.
+ *
+ * Each chunk holds the addresses and ports of its stream, the `timestamp` of its latest segment, the `stream_offset`
+ * of its first byte within the stream, whether bytes were skipped before or within it (`gap`), whether it ends the
+ * stream (`fin`) and the reassembled bytes as the `data` strings column. Concatenating the chunks of a stream in order
+ * yields the stream, ready for application-layer parsing.
+ *
+ * Requires the source to be configured with `numeric_addresses`. The stream table is shared by all of the packets
+ * received by the stage, so the stage should run with a single progress engine.
+ */
+class DocaStreamReassemblyStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Doca Stream Reassembly Stage object
+     *
+     * @param max_streams : Maximum number of concurrent streams, segments of new streams are dropped once the table is
+     * full
+     * @param max_buffered_bytes : Payload bytes of out of order segments held on the device, gaps are skipped once
+     * exceeded
+     * @param idle_timeout : A stream is removed once no segments have been received for this long
+     * @param gap_timeout : Missing bytes are skipped once the segment following them has waited this long
+     */
+    DocaStreamReassemblyStage(std::size_t max_streams                = 1 << 18,
+                              std::size_t max_buffered_bytes         = 1 << 28,
+                              std::chrono::milliseconds idle_timeout = std::chrono::seconds(60),
+                              std::chrono::milliseconds gap_timeout  = std::chrono::milliseconds(500));
+
+  private:
+    subscribe_fn_t build_operator();
+
+    std::size_t m_max_streams;
+    std::size_t m_max_buffered_bytes;
+    std::chrono::milliseconds m_idle_timeout;
+    std::chrono::milliseconds m_gap_timeout;
+};
+
+/****** DocaStreamReassemblyStageInterfaceProxy*************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct DocaStreamReassemblyStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a DocaStreamReassemblyStage, and return the result.
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param max_streams : Maximum number of concurrent streams
+     * @param max_buffered_bytes : Payload bytes of out of order segments held on the device
+     * @param idle_timeout : Idle timeout in seconds
+     * @param gap_timeout : Gap timeout in seconds
+     */
+    static std::shared_ptr<mrc::segment::Object<DocaStreamReassemblyStage>> init(mrc::segment::Builder& builder,
+                                                                                 std::string const& name,
+                                                                                 std::size_t max_streams,
+                                                                                 std::size_t max_buffered_bytes,
+                                                                                 double idle_timeout,
+                                                                                 double gap_timeout);
+};
+
+#pragma GCC visibility pop
+
+}  // namespace morpheus
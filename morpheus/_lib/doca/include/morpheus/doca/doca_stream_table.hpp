@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cudf/column/column_view.hpp>
+#include <cudf/table/table.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus::doca {
+
+/**
+ * @brief Packet columns reassembled by `StreamTable`, as emitted by `DocaSourceStage` with `numeric_addresses` enabled.
+ */
+struct StreamPacketColumns
+{
+    cudf::column_view src_ip;      // DECIMAL128, IPv6 or IPv4-mapped IPv6 address
+    cudf::column_view dst_ip;      // DECIMAL128
+    cudf::column_view src_port;    // UINT16
+    cudf::column_view dst_port;    // UINT16
+    cudf::column_view next_proto;  // INT32, packets other than TCP are ignored
+    cudf::column_view tcp_flags;   // INT32
+    cudf::column_view tcp_seq;     // UINT32
+    cudf::column_view timestamp;   // UINT32, milliseconds
+    cudf::column_view data;        // STRING, payload
+};
+
+/**
+ * @brief Device resident reassembly of TCP byte streams keyed by 5-tuple, each direction of a connection being a
+ * separate stream.
+ *
+ * Each batch of segments is sorted by stream and sequence number, and the segments which continue a stream are
+ * appended to a single chunk per stream and batch, with retransmitted bytes trimmed. Segments following a gap are held
+ * in a pool of device memory until the missing bytes arrive. A gap is skipped, flagging the chunk, once the segment
+ * following it has waited for `gap_timeout`, or as soon as the held segments exceed `max_buffered_bytes`. A stream is
+ * closed by a FIN or RST once every byte before it has been reassembled, and is removed from the table once no segment
+ * has been seen for `idle_timeout`. Time is measured against the packet timestamps.
+ *
+ * Streams are tracked from their SYN, or from the first segment seen for streams which were already established.
+ * Segments of new streams which do not fit in the table are dropped and counted.
+ */
+class StreamTable
+{
+  public:
+    /**
+     * @brief Construct a new Stream Table object
+     *
+     * @param max_streams : Capacity of the table, rounded up to a power of two
+     * @param max_buffered_bytes : Payload bytes of out of order segments held across batches
+     * @param idle_timeout : Time since the last segment of a stream after which the stream is removed
+     * @param gap_timeout : Time a segment waits for the bytes preceding it before they are skipped
+     * @param stream : Stream used to allocate the table
+     */
+    StreamTable(std::size_t max_streams,
+                std::size_t max_buffered_bytes,
+                std::chrono::milliseconds idle_timeout,
+                std::chrono::milliseconds gap_timeout,
+                rmm::cuda_stream_view stream);
+
+    ~StreamTable();
+
+    /**
+     * @brief Reassembles the TCP segments of `packets`, returning a chunk per stream which advanced, or nullptr if no
+     * stream advanced.
+     */
+    std::unique_ptr<cudf::table> update(const StreamPacketColumns& packets, rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Skips every gap, returning the chunks of the held segments or nullptr if no segments are held.
+     */
+    std::unique_ptr<cudf::table> flush(rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Total number of segments dropped because the table was full.
+     */
+    std::size_t num_dropped_segments() const;
+
+    /**
+     * @brief Total number of gaps skipped, either on timeout or because too many bytes were held.
+     */
+    std::size_t num_skipped_gaps() const;
+
+    /**
+     * @brief Names of the columns of the chunks returned by `update` and `flush`.
+     */
+    static const std::vector<std::string>& column_names();
+
+  private:
+    struct segments;
+
+    std::unique_ptr<cudf::table> reassemble(segments& batch, uint32_t now, bool force, rmm::cuda_stream_view stream);
+
+    void expire(uint32_t now, rmm::cuda_stream_view stream);
+
+    void rebuild(rmm::cuda_stream_view stream);
+
+    std::size_t m_capacity;
+    std::size_t m_max_buffered_bytes;
+    uint32_t m_idle_timeout_ms;
+    uint32_t m_gap_timeout_ms;
+
+    rmm::device_buffer m_entries;
+    rmm::device_buffer m_counters;
+
+    // Segments held for a gap, their payloads are packed in `m_pending_chars`
+    rmm::device_buffer m_pending;
+    rmm::device_buffer m_pending_chars;
+    std::size_t m_num_pending{0};
+
+    // Slots which are either holding a stream or the tombstone of a removed stream
+    std::size_t m_num_used{0};
+    std::size_t m_num_dropped{0};
+    std::size_t m_num_gaps{0};
+};
+
+}  // namespace morpheus::doca
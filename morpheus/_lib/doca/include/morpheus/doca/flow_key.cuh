@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cudf/column/column.hpp>
+#include <cudf/fixed_point/fixed_point.hpp>
+#include <cudf/types.hpp>
+#include <rmm/device_buffer.hpp>
+#include <rmm/device_uvector.hpp>
+
+#include <cstdint>
+#include <memory>
+
+// Device helpers shared by the GPU tables keyed by 5-tuple, `FlowTable` and `StreamTable`
+namespace morpheus::doca::detail {
+
+int32_t const SLOT_EMPTY    = 0;
+int32_t const SLOT_BUSY     = 1;
+int32_t const SLOT_OCCUPIED = 2;
+int32_t const SLOT_EXPIRED  = 3;
+
+struct flow_key
+{
+    __int128_t src_ip;     // IPv6, or IPv4-mapped IPv6 address
+    __int128_t dst_ip;
+    uint64_t ports_proto;  // src_port << 24 | dst_port << 8 | protocol
+
+    __device__ bool operator==(flow_key const& other) const
+    {
+        return src_ip == other.src_ip && dst_ip == other.dst_ip && ports_proto == other.ports_proto;
+    }
+
+    __device__ bool operator<(flow_key const& other) const
+    {
+        if (src_ip != other.src_ip)
+        {
+            return src_ip < other.src_ip;
+        }
+
+        if (dst_ip != other.dst_ip)
+        {
+            return dst_ip < other.dst_ip;
+        }
+
+        return ports_proto < other.ports_proto;
+    }
+};
+
+struct flow_key_equal
+{
+    __device__ bool operator()(flow_key const& lhs, flow_key const& rhs) const
+    {
+        return lhs == rhs;
+    }
+};
+
+// Timestamps are 32-bit milliseconds which wrap, compare them by their signed difference
+__device__ __forceinline__ bool ts_before(uint32_t lhs, uint32_t rhs)
+{
+    return static_cast<int32_t>(lhs - rhs) < 0;
+}
+
+__device__ __forceinline__ uint32_t ts_elapsed(uint32_t from, uint32_t to)
+{
+    auto elapsed = static_cast<int32_t>(to - from);
+    return elapsed > 0 ? static_cast<uint32_t>(elapsed) : 0;
+}
+
+__device__ __forceinline__ uint32_t hash_key(flow_key const& key)
+{
+    // 64-bit mix (splitmix64 finalizer) of the words of the key
+    auto src   = static_cast<unsigned __int128>(key.src_ip);
+    auto dst   = static_cast<unsigned __int128>(key.dst_ip);
+    uint64_t h = static_cast<uint64_t>(src) ^ (static_cast<uint64_t>(src >> 64) * 0xC2B2AE3D27D4EB4Full) ^
+                 (static_cast<uint64_t>(dst) * 0x165667B19E3779F9ull) ^ static_cast<uint64_t>(dst >> 64) ^
+                 (key.ports_proto * 0x9E3779B97F4A7C15ull);
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 31;
+    return static_cast<uint32_t>(h);
+}
+
+struct make_flow_key
+{
+    __int128_t const* src_ip;
+    __int128_t const* dst_ip;
+    uint16_t const* src_port;
+    uint16_t const* dst_port;
+    int32_t const* next_proto;
+
+    __device__ flow_key operator()(cudf::size_type idx) const
+    {
+        return flow_key{src_ip[idx],
+                        dst_ip[idx],
+                        (static_cast<uint64_t>(src_port[idx]) << 24) | (static_cast<uint64_t>(dst_port[idx]) << 8) |
+                            static_cast<uint8_t>(next_proto[idx])};
+    }
+};
+
+template <typename T>
+std::unique_ptr<cudf::column> make_column(rmm::device_uvector<T>&& buffer)
+{
+    return std::make_unique<cudf::column>(std::move(buffer), rmm::device_buffer{}, 0);
+}
+
+// Addresses are stored as DECIMAL128 with a scale of 0, the only 128-bit integer type supported by cudf
+inline std::unique_ptr<cudf::column> make_address_column(rmm::device_uvector<__int128_t>&& buffer)
+{
+    auto size = static_cast<cudf::size_type>(buffer.size());
+    return std::make_unique<cudf::column>(cudf::data_type{cudf::type_id::DECIMAL128, numeric::scale_type{0}},
+                                          size,
+                                          buffer.release(),
+                                          rmm::device_buffer{},
+                                          0);
+}
+
+}  // namespace morpheus::doca::detail
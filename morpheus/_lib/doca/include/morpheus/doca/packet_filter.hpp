@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace morpheus::doca {
+
+uint32_t const MAX_FILTER_PORT_RANGES = 16;
+uint32_t const MAX_FILTER_IP_PREFIXES = 16;
+uint32_t const MAX_OFFLOADED_PORTS    = 64;
+
+/**
+ * @brief Inclusive range of L4 ports, in host byte order.
+ */
+struct port_range
+{
+    uint16_t first;
+    uint16_t last;
+};
+
+/**
+ * @brief IP prefix over 128-bit addresses stored as (low, high) words, the layout of the `src_ip6` and `dst_ip6`
+ * columns. IPv4 prefixes are mapped into IPv6 (`::ffff:a.b.c.d/96+n`) so both versions are matched alike.
+ */
+struct ip_prefix
+{
+    uint64_t address[2];
+    uint64_t mask[2];
+};
+
+/**
+ * @brief Compact rule set evaluated by the receive kernel for every packet before it is copied into the semaphore
+ * slot, so packets which are not wanted never reach the payload gather, the string conversion or cudf.
+ *
+ * A packet is kept when it matches every criterion. Port and prefix lists match when any of their entries matches, an
+ * empty list matches every packet. The payload size bounds are inclusive and the TCP flags are matched as
+ * `(flags & tcp_flags_mask) == tcp_flags_value`. A default constructed filter keeps every packet.
+ *
+ * Passed to the kernel by value, the struct must remain trivially copyable.
+ */
+struct packet_filter
+{
+    uint32_t num_src_port_ranges = 0;
+    uint32_t num_dst_port_ranges = 0;
+    port_range src_ports[MAX_FILTER_PORT_RANGES];
+    port_range dst_ports[MAX_FILTER_PORT_RANGES];
+
+    uint32_t num_src_prefixes = 0;
+    uint32_t num_dst_prefixes = 0;
+    ip_prefix src_prefixes[MAX_FILTER_IP_PREFIXES];
+    ip_prefix dst_prefixes[MAX_FILTER_IP_PREFIXES];
+
+    int32_t min_payload_size = 0;
+    int32_t max_payload_size = std::numeric_limits<int32_t>::max();
+
+    uint8_t tcp_flags_mask  = 0;
+    uint8_t tcp_flags_value = 0;
+};
+
+/**
+ * @brief Parses a port (`"443"`) or an inclusive port range (`"8000-8100"`).
+ *
+ * @throws std::invalid_argument If `ports` is not a port or a range of ports
+ */
+port_range parse_port_range(std::string const& ports);
+
+/**
+ * @brief Parses an IPv4 or IPv6 network in CIDR notation (`"10.0.0.0/8"`, `"fd00::/8"`), a bare address matching only
+ * itself.
+ *
+ * @throws std::invalid_argument If `network` is not an address or the prefix length is out of range
+ */
+ip_prefix parse_ip_prefix(std::string const& network);
+
+/**
+ * @brief Builds a filter from the textual rules of the stage config, see `parse_port_range` and `parse_ip_prefix`. A
+ * negative `max_payload_size` leaves the payload size unbounded.
+ *
+ * @throws std::invalid_argument If a rule is malformed, a list has too many entries, the payload size bounds are
+ * inverted, `tcp_flags_value` has bits outside of `tcp_flags_mask` or TCP flags are given for UDP traffic
+ */
+packet_filter make_packet_filter(std::vector<std::string> const& src_ports,
+                                 std::vector<std::string> const& dst_ports,
+                                 std::vector<std::string> const& src_networks,
+                                 std::vector<std::string> const& dst_networks,
+                                 int32_t min_payload_size,
+                                 int32_t max_payload_size,
+                                 uint8_t tcp_flags_mask,
+                                 uint8_t tcp_flags_value,
+                                 bool is_tcp);
+
+/**
+ * @brief Destination ports which can be matched by the NIC, dropping every other packet before it reaches the receive
+ * queues. Empty when the destination ports are unrestricted or span more than `MAX_OFFLOADED_PORTS` ports, in which
+ * case they are only matched by the receive kernel.
+ */
+std::vector<uint16_t> offloadable_dst_ports(packet_filter const& filter);
+
+}  // namespace morpheus::doca
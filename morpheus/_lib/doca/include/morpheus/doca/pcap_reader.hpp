@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace morpheus::doca {
+
+/**
+ * @brief A single captured frame, pointing into the memory mapped capture.
+ */
+struct PcapPacket
+{
+    uint8_t const* data;
+    uint32_t captured_length;  // Bytes of the frame present in the capture
+    uint32_t original_length;  // Length of the frame on the wire
+    uint64_t timestamp_ns;     // Nanoseconds since the epoch
+};
+
+/**
+ * @brief Reads Ethernet frames from a pcap or pcapng capture, memory mapping the file so frames are handed out without
+ * copying.
+ *
+ * Both byte orders and the microsecond and nanosecond variants of pcap are supported. For pcapng, enhanced and simple
+ * packet blocks are read and the timestamp resolution of each interface is honored, simple packet blocks carry no
+ * timestamp and are given the timestamp of the preceding packet. Captures with a link type other than Ethernet are
+ * rejected.
+ */
+class PcapReader
+{
+  public:
+    PcapReader(std::string const& filename);
+    ~PcapReader();
+
+    PcapReader(PcapReader const&)            = delete;
+    PcapReader& operator=(PcapReader const&) = delete;
+
+    /**
+     * @brief Reads the next frame into `packet`, returning false once the end of the capture is reached.
+     */
+    bool next(PcapPacket& packet);
+
+    /**
+     * @brief Restarts reading from the first frame of the capture.
+     */
+    void rewind();
+
+  private:
+    struct interface_info
+    {
+        uint32_t link_type;
+        uint64_t ticks_per_second;
+    };
+
+    bool next_pcap(PcapPacket& packet);
+    bool next_pcapng(PcapPacket& packet);
+
+    uint16_t read16(std::size_t offset) const;
+    uint32_t read32(std::size_t offset) const;
+    uint64_t to_ns(uint64_t ticks, uint64_t ticks_per_second) const;
+
+    std::string m_filename;
+    uint8_t const* m_data{nullptr};
+    std::size_t m_size{0};
+    std::size_t m_offset{0};
+
+    bool m_is_pcapng{false};
+    bool m_swapped{false};  // Byte order of the capture, or of the current section for pcapng, differs from the host
+    uint64_t m_ticks_per_second{0};
+    uint64_t m_last_timestamp_ns{0};
+    std::vector<interface_info> m_interfaces;
+};
+
+}  // namespace morpheus::doca
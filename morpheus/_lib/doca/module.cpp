@@ -15,15 +15,21 @@
  * limitations under the License.
  */
 
+#include "morpheus/doca/doca_flow_aggregation.hpp"
+#include "morpheus/doca/doca_pcap_source.hpp"
 #include "morpheus/doca/doca_source.hpp"
+#include "morpheus/doca/doca_stream_reassembly.hpp"
 
 #include <mrc/segment/builder.hpp>  // IWYU pragma: keep
 #include <mrc/segment/object.hpp>
 #include <pybind11/attr.h>
 #include <pybind11/pybind11.h>  // for str_attr_accessor
+#include <pybind11/stl.h>       // IWYU pragma: keep
 #include <pymrc/utils.hpp>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace morpheus {
 
@@ -42,7 +48,54 @@ PYBIND11_MODULE(doca, m)
              py::arg("name"),
              py::arg("nic_pci_address"),
              py::arg("gpu_pci_address"),
-             py::arg("traffic_type"));
+             py::arg("traffic_type"),
+             py::arg("numeric_addresses") = false,
+             py::arg("src_ports")         = std::vector<std::string>{},
+             py::arg("dst_ports")         = std::vector<std::string>{},
+             py::arg("src_networks")      = std::vector<std::string>{},
+             py::arg("dst_networks")      = std::vector<std::string>{},
+             py::arg("min_payload_size")  = 0,
+             py::arg("max_payload_size")  = -1,
+             py::arg("tcp_flags_mask")    = 0,
+             py::arg("tcp_flags_value")   = 0,
+             py::arg("bind_to_nic")       = false,
+             py::arg("capture_path")      = "");
+
+    py::class_<mrc::segment::Object<DocaPcapSourceStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<DocaPcapSourceStage>>>(
+        m, "DocaPcapSourceStage", py::multiple_inheritance())
+        .def(py::init<>(&DocaPcapSourceStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("pcap_file"),
+             py::arg("traffic_type"),
+             py::arg("packets_per_second") = 0.0,
+             py::arg("repeat")             = 1,
+             py::arg("numeric_addresses")  = false);
+
+    py::class_<mrc::segment::Object<DocaFlowAggregationStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<DocaFlowAggregationStage>>>(
+        m, "DocaFlowAggregationStage", py::multiple_inheritance())
+        .def(py::init<>(&DocaFlowAggregationStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("max_flows")      = 1 << 18,
+             py::arg("idle_timeout")   = 15.0,
+             py::arg("active_timeout") = 120.0);
+
+    py::class_<mrc::segment::Object<DocaStreamReassemblyStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<DocaStreamReassemblyStage>>>(
+        m, "DocaStreamReassemblyStage", py::multiple_inheritance())
+        .def(py::init<>(&DocaStreamReassemblyStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("max_streams")        = 1 << 18,
+             py::arg("max_buffered_bytes") = 1 << 28,
+             py::arg("idle_timeout")       = 60.0,
+             py::arg("gap_timeout")        = 0.5);
 }
 
 }  // namespace morpheus
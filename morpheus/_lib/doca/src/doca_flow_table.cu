@@ -0,0 +1,644 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/doca/doca_flow_table.hpp"
+
+#include "morpheus/doca/flow_key.cuh"
+#include "morpheus/utilities/error.hpp"
+
+#include <cudf/column/column.hpp>
+#include <cudf/fixed_point/fixed_point.hpp>
+#include <cudf/strings/attributes.hpp>
+#include <cudf/strings/strings_column_view.hpp>
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/reduce.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+
+#include <array>
+#include <bit>
+#include <memory>
+
+#define TCP_PROTOCOL_ID 0x6
+
+namespace morpheus::doca {
+
+namespace {
+
+using namespace detail;
+
+uint32_t const NUM_TCP_FLAGS     = 8;
+uint32_t const FLOW_THREADS      = 256;
+std::size_t const NUM_COUNTERS   = 3;
+std::size_t const COUNTER_ADDED  = 0;
+std::size_t const COUNTER_DROP   = 1;
+std::size_t const COUNTER_EXPIRE = 2;
+
+struct flow_stats
+{
+    uint64_t packet_count;
+    uint64_t byte_count;
+    uint32_t first_timestamp;
+    uint32_t last_timestamp;
+    uint32_t flag_counts[NUM_TCP_FLAGS];
+    uint32_t iat_count;
+    uint32_t iat_min;
+    uint32_t iat_max;
+    double iat_sum;
+    double iat_sum_sq;
+};
+
+struct flow_entry
+{
+    flow_key key;
+    int32_t state;
+    flow_stats stats;
+};
+
+__device__ __forceinline__ void add_iat(flow_stats& stats, uint32_t iat)
+{
+    stats.iat_count += 1;
+    stats.iat_min = min(stats.iat_min, iat);
+    stats.iat_max = max(stats.iat_max, iat);
+    stats.iat_sum += iat;
+    stats.iat_sum_sq += static_cast<double>(iat) * iat;
+}
+
+struct combine_flow_stats
+{
+    __device__ flow_stats operator()(flow_stats const& lhs, flow_stats const& rhs) const
+    {
+        flow_stats out;
+        out.packet_count    = lhs.packet_count + rhs.packet_count;
+        out.byte_count      = lhs.byte_count + rhs.byte_count;
+        out.first_timestamp = ts_before(rhs.first_timestamp, lhs.first_timestamp) ? rhs.first_timestamp
+                                                                                  : lhs.first_timestamp;
+        out.last_timestamp = ts_before(lhs.last_timestamp, rhs.last_timestamp) ? rhs.last_timestamp
+                                                                               : lhs.last_timestamp;
+        for (uint32_t i = 0; i < NUM_TCP_FLAGS; i++)
+        {
+            out.flag_counts[i] = lhs.flag_counts[i] + rhs.flag_counts[i];
+        }
+        out.iat_count  = lhs.iat_count + rhs.iat_count;
+        out.iat_min    = min(lhs.iat_min, rhs.iat_min);
+        out.iat_max    = max(lhs.iat_max, rhs.iat_max);
+        out.iat_sum    = lhs.iat_sum + rhs.iat_sum;
+        out.iat_sum_sq = lhs.iat_sum_sq + rhs.iat_sum_sq;
+        return out;
+    }
+};
+
+// Orders packets by flow, then by timestamp within a flow
+struct packet_order
+{
+    flow_key const* keys;
+    uint32_t const* timestamps;
+
+    __device__ bool operator()(cudf::size_type lhs, cudf::size_type rhs) const
+    {
+        auto const& lhs_key = keys[lhs];
+        auto const& rhs_key = keys[rhs];
+
+        if (lhs_key.src_ip != rhs_key.src_ip)
+        {
+            return lhs_key.src_ip < rhs_key.src_ip;
+        }
+
+        if (lhs_key.dst_ip != rhs_key.dst_ip)
+        {
+            return lhs_key.dst_ip < rhs_key.dst_ip;
+        }
+
+        if (lhs_key.ports_proto != rhs_key.ports_proto)
+        {
+            return lhs_key.ports_proto < rhs_key.ports_proto;
+        }
+
+        return ts_before(timestamps[lhs], timestamps[rhs]);
+    }
+};
+
+// Stats of the single packet at a sorted position, including the inter-arrival time since the previous packet of the
+// same flow in the batch
+struct make_packet_stats
+{
+    cudf::size_type const* order;
+    flow_key const* sorted_keys;
+    int32_t const* next_proto;
+    int32_t const* tcp_flags;
+    uint32_t const* timestamps;
+    int32_t const* payload_sizes;
+
+    __device__ flow_stats operator()(cudf::size_type pos) const
+    {
+        auto idx = order[pos];
+
+        flow_stats stats{};
+        stats.packet_count    = 1;
+        stats.byte_count      = static_cast<uint64_t>(payload_sizes[idx]);
+        stats.first_timestamp = timestamps[idx];
+        stats.last_timestamp  = timestamps[idx];
+        stats.iat_min         = UINT32_MAX;
+
+        // The flags column is not populated for UDP packets
+        if (next_proto[idx] == TCP_PROTOCOL_ID)
+        {
+            for (uint32_t i = 0; i < NUM_TCP_FLAGS; i++)
+            {
+                stats.flag_counts[i] = (tcp_flags[idx] >> i) & 1;
+            }
+        }
+
+        if (pos > 0 && sorted_keys[pos - 1] == sorted_keys[pos])
+        {
+            add_iat(stats, ts_elapsed(timestamps[order[pos - 1]], timestamps[idx]));
+        }
+
+        return stats;
+    }
+};
+
+/**
+ * @brief Inserts a flow into the table, or merges it with the existing flow of the same key. Only inserts into empty
+ * slots, expired slots are kept as tombstones so probe sequences are never broken.
+ */
+__device__ void merge_flow(flow_entry* table,
+                           uint32_t capacity_mask,
+                           flow_key const& key,
+                           flow_stats const& stats,
+                           unsigned long long* counters)
+{
+    auto slot = hash_key(key) & capacity_mask;
+
+    for (uint32_t probe = 0; probe <= capacity_mask;)
+    {
+        auto& entry = table[slot];
+        auto state  = atomicAdd(&entry.state, 0);
+
+        if (state == SLOT_EMPTY)
+        {
+            if (atomicCAS(&entry.state, SLOT_EMPTY, SLOT_BUSY) == SLOT_EMPTY)
+            {
+                entry.key   = key;
+                entry.stats = stats;
+                __threadfence();
+                atomicExch(&entry.state, SLOT_OCCUPIED);
+                atomicAdd(&counters[COUNTER_ADDED], 1ull);
+                return;
+            }
+
+            // Lost the slot to another flow, check it again once that flow has been written
+            continue;
+        }
+
+        if (state == SLOT_BUSY)
+        {
+            continue;
+        }
+
+        if (state == SLOT_OCCUPIED && entry.key == key)
+        {
+            // Each flow appears once per batch, this thread is the only writer of the entry
+            auto& existing = entry.stats;
+            auto merged    = combine_flow_stats{}(existing, stats);
+
+            // Packets of a flow can arrive out of order across batches, only count the gap when the batch follows
+            if (!ts_before(stats.first_timestamp, existing.last_timestamp))
+            {
+                add_iat(merged, ts_elapsed(existing.last_timestamp, stats.first_timestamp));
+            }
+
+            existing = merged;
+            return;
+        }
+
+        slot = (slot + 1) & capacity_mask;
+        probe++;
+    }
+
+    atomicAdd(&counters[COUNTER_DROP], static_cast<unsigned long long>(stats.packet_count));
+}
+
+__global__ void _merge_flows_kernel(flow_entry* table,
+                                    uint32_t capacity_mask,
+                                    flow_key const* keys,
+                                    flow_stats const* stats,
+                                    uint32_t count,
+                                    unsigned long long* counters)
+{
+    auto idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx < count)
+    {
+        merge_flow(table, capacity_mask, keys[idx], stats[idx], counters);
+    }
+}
+
+__global__ void _rehash_flows_kernel(flow_entry const* old_table,
+                                     uint32_t capacity,
+                                     flow_entry* table,
+                                     unsigned long long* counters)
+{
+    auto idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx < capacity && old_table[idx].state == SLOT_OCCUPIED)
+    {
+        merge_flow(table, capacity - 1, old_table[idx].key, old_table[idx].stats, counters);
+    }
+}
+
+__global__ void _expire_flows_kernel(flow_entry* table,
+                                     uint32_t capacity,
+                                     uint32_t now,
+                                     uint32_t idle_timeout_ms,
+                                     uint32_t active_timeout_ms,
+                                     bool force,
+                                     flow_entry* expired,
+                                     unsigned long long* counters)
+{
+    auto idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= capacity || table[idx].state != SLOT_OCCUPIED)
+    {
+        return;
+    }
+
+    auto const& stats = table[idx].stats;
+
+    if (force || ts_elapsed(stats.last_timestamp, now) >= idle_timeout_ms ||
+        ts_elapsed(stats.first_timestamp, stats.last_timestamp) >= active_timeout_ms)
+    {
+        auto out_idx     = atomicAdd(&counters[COUNTER_EXPIRE], 1ull);
+        expired[out_idx] = table[idx];
+        table[idx].state = SLOT_EXPIRED;
+    }
+}
+
+struct flow_record_columns
+{
+    __int128_t* src_ip;
+    __int128_t* dst_ip;
+    uint16_t* src_port;
+    uint16_t* dst_port;
+    int32_t* protocol;
+    uint32_t* first_timestamp;
+    uint32_t* last_timestamp;
+    uint32_t* duration_ms;
+    int64_t* packet_count;
+    int64_t* byte_count;
+    int32_t* flag_counts[NUM_TCP_FLAGS];
+    double* iat_mean_ms;
+    double* iat_std_ms;
+    uint32_t* iat_min_ms;
+    uint32_t* iat_max_ms;
+};
+
+__global__ void _flow_records_kernel(flow_entry const* expired, uint32_t count, flow_record_columns out)
+{
+    auto idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= count)
+    {
+        return;
+    }
+
+    auto const& key   = expired[idx].key;
+    auto const& stats = expired[idx].stats;
+
+    out.src_ip[idx]          = key.src_ip;
+    out.dst_ip[idx]          = key.dst_ip;
+    out.src_port[idx]        = static_cast<uint16_t>(key.ports_proto >> 24);
+    out.dst_port[idx]        = static_cast<uint16_t>(key.ports_proto >> 8);
+    out.protocol[idx]        = static_cast<int32_t>(key.ports_proto & 0xFF);
+    out.first_timestamp[idx] = stats.first_timestamp;
+    out.last_timestamp[idx]  = stats.last_timestamp;
+    out.duration_ms[idx]     = ts_elapsed(stats.first_timestamp, stats.last_timestamp);
+    out.packet_count[idx]    = static_cast<int64_t>(stats.packet_count);
+    out.byte_count[idx]      = static_cast<int64_t>(stats.byte_count);
+
+    for (uint32_t i = 0; i < NUM_TCP_FLAGS; i++)
+    {
+        out.flag_counts[i][idx] = static_cast<int32_t>(stats.flag_counts[i]);
+    }
+
+    if (stats.iat_count > 0)
+    {
+        auto mean             = stats.iat_sum / stats.iat_count;
+        auto variance         = stats.iat_sum_sq / stats.iat_count - mean * mean;
+        out.iat_mean_ms[idx] = mean;
+        out.iat_std_ms[idx]  = variance > 0 ? sqrt(variance) : 0.0;
+        out.iat_min_ms[idx]  = stats.iat_min;
+        out.iat_max_ms[idx]  = stats.iat_max;
+    }
+    else
+    {
+        out.iat_mean_ms[idx] = 0.0;
+        out.iat_std_ms[idx]  = 0.0;
+        out.iat_min_ms[idx]  = 0;
+        out.iat_max_ms[idx]  = 0;
+    }
+}
+
+uint32_t num_blocks(std::size_t count)
+{
+    return static_cast<uint32_t>((count + FLOW_THREADS - 1) / FLOW_THREADS);
+}
+
+}  // namespace
+
+FlowTable::FlowTable(std::size_t max_flows,
+                     std::chrono::milliseconds idle_timeout,
+                     std::chrono::milliseconds active_timeout,
+                     rmm::cuda_stream_view stream) :
+  m_capacity(std::bit_ceil(std::max<std::size_t>(max_flows, FLOW_THREADS))),
+  m_idle_timeout_ms(static_cast<uint32_t>(idle_timeout.count())),
+  m_active_timeout_ms(static_cast<uint32_t>(active_timeout.count())),
+  m_entries(m_capacity * sizeof(flow_entry), stream),
+  m_expired(m_capacity * sizeof(flow_entry), stream),
+  m_counters(NUM_COUNTERS * sizeof(unsigned long long), stream)
+{
+    MORPHEUS_EXPECTS(m_capacity <= UINT32_MAX, "max_flows must fit in 32 bits");
+
+    CUDA_TRY(cudaMemsetAsync(m_entries.data(), 0, m_entries.size(), stream.value()));
+}
+
+FlowTable::~FlowTable() = default;
+
+std::unique_ptr<cudf::table> FlowTable::update(const FlowPacketColumns& packets, rmm::cuda_stream_view stream)
+{
+    auto num_packets = packets.src_ip.size();
+
+    if (num_packets == 0)
+    {
+        return nullptr;
+    }
+
+    MORPHEUS_EXPECTS(packets.src_ip.type().id() == cudf::type_id::DECIMAL128 &&
+                         packets.dst_ip.type().id() == cudf::type_id::DECIMAL128,
+                     "Flow aggregation requires 128-bit numeric IP address columns");
+
+    auto policy        = rmm::exec_policy(stream);
+    auto payload_sizes = cudf::strings::count_bytes(cudf::strings_column_view(packets.data));
+    auto timestamps    = packets.timestamp.data<uint32_t>();
+    auto next_proto    = packets.next_proto.data<int32_t>();
+
+    // Sort the batch by flow so each flow can be reduced to a single update of the table
+    rmm::device_uvector<flow_key> keys(num_packets, stream);
+    thrust::transform(policy,
+                      thrust::make_counting_iterator<cudf::size_type>(0),
+                      thrust::make_counting_iterator<cudf::size_type>(num_packets),
+                      keys.begin(),
+                      make_flow_key{packets.src_ip.data<__int128_t>(),
+                                    packets.dst_ip.data<__int128_t>(),
+                                    packets.src_port.data<uint16_t>(),
+                                    packets.dst_port.data<uint16_t>(),
+                                    next_proto});
+
+    rmm::device_uvector<cudf::size_type> order(num_packets, stream);
+    thrust::sequence(policy, order.begin(), order.end());
+    thrust::sort(policy, order.begin(), order.end(), packet_order{keys.data(), timestamps});
+
+    rmm::device_uvector<flow_key> sorted_keys(num_packets, stream);
+    thrust::gather(policy, order.begin(), order.end(), keys.begin(), sorted_keys.begin());
+
+    rmm::device_uvector<flow_stats> packet_stats(num_packets, stream);
+    thrust::transform(policy,
+                      thrust::make_counting_iterator<cudf::size_type>(0),
+                      thrust::make_counting_iterator<cudf::size_type>(num_packets),
+                      packet_stats.begin(),
+                      make_packet_stats{order.data(),
+                                        sorted_keys.data(),
+                                        next_proto,
+                                        packets.tcp_flags.data<int32_t>(),
+                                        timestamps,
+                                        payload_sizes->view().data<int32_t>()});
+
+    rmm::device_uvector<flow_key> flow_keys(num_packets, stream);
+    rmm::device_uvector<flow_stats> flows(num_packets, stream);
+    auto [keys_end, flows_end] = thrust::reduce_by_key(policy,
+                                                       sorted_keys.begin(),
+                                                       sorted_keys.end(),
+                                                       packet_stats.begin(),
+                                                       flow_keys.begin(),
+                                                       flows.begin(),
+                                                       flow_key_equal{},
+                                                       combine_flow_stats{});
+    auto num_flows = static_cast<uint32_t>(keys_end - flow_keys.begin());
+
+    auto* counters = static_cast<unsigned long long*>(m_counters.data());
+    CUDA_TRY(cudaMemsetAsync(counters, 0, m_counters.size(), stream.value()));
+
+    _merge_flows_kernel<<<num_blocks(num_flows), FLOW_THREADS, 0, stream.value()>>>(
+        static_cast<flow_entry*>(m_entries.data()),
+        m_capacity - 1,
+        flow_keys.data(),
+        flows.data(),
+        num_flows,
+        counters);
+    CHECK_CUDA(stream);
+
+    std::array<unsigned long long, NUM_COUNTERS> host_counters{};
+    CUDA_TRY(cudaMemcpyAsync(
+        host_counters.data(), counters, m_counters.size(), cudaMemcpyDeviceToHost, stream.value()));
+    stream.synchronize();
+
+    m_num_used += host_counters[COUNTER_ADDED];
+    m_num_dropped += host_counters[COUNTER_DROP];
+
+    // Packet time rather than wall time, flows expire consistently regardless of how far behind the pipeline is
+    auto now = thrust::reduce(policy,
+                              timestamps,
+                              timestamps + num_packets,
+                              static_cast<uint32_t>(0),
+                              thrust::maximum<uint32_t>());
+
+    auto expired = this->expire(now, false, stream);
+
+    if (m_num_used > m_capacity / 4 * 3)
+    {
+        this->rebuild(stream);
+    }
+
+    return expired;
+}
+
+std::unique_ptr<cudf::table> FlowTable::flush(rmm::cuda_stream_view stream)
+{
+    return this->expire(0, true, stream);
+}
+
+std::size_t FlowTable::num_dropped_packets() const
+{
+    return m_num_dropped;
+}
+
+const std::vector<std::string>& FlowTable::column_names()
+{
+    // Flag counts are in bit order of the TCP flags field
+    static const std::vector<std::string> names{"src_ip",
+                                                "dst_ip",
+                                                "src_port",
+                                                "dst_port",
+                                                "protocol",
+                                                "first_timestamp",
+                                                "last_timestamp",
+                                                "duration_ms",
+                                                "packet_count",
+                                                "byte_count",
+                                                "fin_count",
+                                                "syn_count",
+                                                "rst_count",
+                                                "psh_count",
+                                                "ack_count",
+                                                "urg_count",
+                                                "ece_count",
+                                                "cwr_count",
+                                                "iat_mean_ms",
+                                                "iat_std_ms",
+                                                "iat_min_ms",
+                                                "iat_max_ms"};
+
+    return names;
+}
+
+std::unique_ptr<cudf::table> FlowTable::expire(uint32_t now, bool force, rmm::cuda_stream_view stream)
+{
+    auto* counters = static_cast<unsigned long long*>(m_counters.data());
+    auto* expired  = static_cast<flow_entry*>(m_expired.data());
+
+    CUDA_TRY(cudaMemsetAsync(counters + COUNTER_EXPIRE, 0, sizeof(unsigned long long), stream.value()));
+
+    _expire_flows_kernel<<<num_blocks(m_capacity), FLOW_THREADS, 0, stream.value()>>>(
+        static_cast<flow_entry*>(m_entries.data()),
+        m_capacity,
+        now,
+        m_idle_timeout_ms,
+        m_active_timeout_ms,
+        force,
+        expired,
+        counters);
+    CHECK_CUDA(stream);
+
+    unsigned long long num_expired = 0;
+    CUDA_TRY(cudaMemcpyAsync(
+        &num_expired, counters + COUNTER_EXPIRE, sizeof(num_expired), cudaMemcpyDeviceToHost, stream.value()));
+    stream.synchronize();
+
+    if (num_expired == 0)
+    {
+        return nullptr;
+    }
+
+    auto count = static_cast<cudf::size_type>(num_expired);
+
+    rmm::device_uvector<__int128_t> src_ip(count, stream);
+    rmm::device_uvector<__int128_t> dst_ip(count, stream);
+    rmm::device_uvector<uint16_t> src_port(count, stream);
+    rmm::device_uvector<uint16_t> dst_port(count, stream);
+    rmm::device_uvector<int32_t> protocol(count, stream);
+    rmm::device_uvector<uint32_t> first_timestamp(count, stream);
+    rmm::device_uvector<uint32_t> last_timestamp(count, stream);
+    rmm::device_uvector<uint32_t> duration_ms(count, stream);
+    rmm::device_uvector<int64_t> packet_count(count, stream);
+    rmm::device_uvector<int64_t> byte_count(count, stream);
+    std::vector<rmm::device_uvector<int32_t>> flag_counts;
+    rmm::device_uvector<double> iat_mean_ms(count, stream);
+    rmm::device_uvector<double> iat_std_ms(count, stream);
+    rmm::device_uvector<uint32_t> iat_min_ms(count, stream);
+    rmm::device_uvector<uint32_t> iat_max_ms(count, stream);
+
+    flow_record_columns out{};
+    out.src_ip = src_ip.data();
+    out.dst_ip = dst_ip.data();
+    out.src_port = src_port.data();
+    out.dst_port = dst_port.data();
+    out.protocol = protocol.data();
+    out.first_timestamp = first_timestamp.data();
+    out.last_timestamp = last_timestamp.data();
+    out.duration_ms = duration_ms.data();
+    out.packet_count = packet_count.data();
+    out.byte_count = byte_count.data();
+    out.iat_mean_ms = iat_mean_ms.data();
+    out.iat_std_ms = iat_std_ms.data();
+    out.iat_min_ms = iat_min_ms.data();
+    out.iat_max_ms = iat_max_ms.data();
+
+    flag_counts.reserve(NUM_TCP_FLAGS);
+    for (uint32_t i = 0; i < NUM_TCP_FLAGS; i++)
+    {
+        flag_counts.emplace_back(count, stream);
+        out.flag_counts[i] = flag_counts.back().data();
+    }
+
+    _flow_records_kernel<<<num_blocks(count), FLOW_THREADS, 0, stream.value()>>>(expired, count, out);
+    CHECK_CUDA(stream);
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    columns.reserve(column_names().size());
+    columns.emplace_back(make_address_column(std::move(src_ip)));
+    columns.emplace_back(make_address_column(std::move(dst_ip)));
+    columns.emplace_back(make_column(std::move(src_port)));
+    columns.emplace_back(make_column(std::move(dst_port)));
+    columns.emplace_back(make_column(std::move(protocol)));
+    columns.emplace_back(make_column(std::move(first_timestamp)));
+    columns.emplace_back(make_column(std::move(last_timestamp)));
+    columns.emplace_back(make_column(std::move(duration_ms)));
+    columns.emplace_back(make_column(std::move(packet_count)));
+    columns.emplace_back(make_column(std::move(byte_count)));
+    for (auto& flag_count : flag_counts)
+    {
+        columns.emplace_back(make_column(std::move(flag_count)));
+    }
+    columns.emplace_back(make_column(std::move(iat_mean_ms)));
+    columns.emplace_back(make_column(std::move(iat_std_ms)));
+    columns.emplace_back(make_column(std::move(iat_min_ms)));
+    columns.emplace_back(make_column(std::move(iat_max_ms)));
+
+    return std::make_unique<cudf::table>(std::move(columns));
+}
+
+void FlowTable::rebuild(rmm::cuda_stream_view stream)
+{
+    // Re-inserting the live flows into a fresh table drops the tombstones left behind by expired flows
+    rmm::device_buffer entries(m_entries.size(), stream);
+    CUDA_TRY(cudaMemsetAsync(entries.data(), 0, entries.size(), stream.value()));
+
+    auto* counters = static_cast<unsigned long long*>(m_counters.data());
+    CUDA_TRY(cudaMemsetAsync(counters, 0, m_counters.size(), stream.value()));
+
+    _rehash_flows_kernel<<<num_blocks(m_capacity), FLOW_THREADS, 0, stream.value()>>>(
+        static_cast<flow_entry const*>(m_entries.data()),
+        m_capacity,
+        static_cast<flow_entry*>(entries.data()),
+        counters);
+    CHECK_CUDA(stream);
+
+    unsigned long long num_added = 0;
+    CUDA_TRY(cudaMemcpyAsync(
+        &num_added, counters + COUNTER_ADDED, sizeof(num_added), cudaMemcpyDeviceToHost, stream.value()));
+    stream.synchronize();
+
+    m_entries  = std::move(entries);
+    m_num_used = num_added;
+}
+
+}  // namespace morpheus::doca
@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/doca/doca_packet_buffers.hpp"
+
+#include "morpheus/doca/doca_source_kernels.hpp"
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>
+#include <cudf/fixed_point/fixed_point.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/utilities/type_dispatcher.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+/**
+ * @brief Moves the first `size` elements of `buffer` into a new column, replacing `buffer` with a newly allocated
+ * buffer of the same capacity. Avoids copying the column, at the cost of the column holding on to the full-sized
+ * allocation.
+ */
+template <typename T>
+std::unique_ptr<cudf::column> take_column(rmm::device_uvector<T>& buffer,
+                                          cudf::size_type size,
+                                          rmm::cuda_stream_view stream,
+                                          cudf::data_type type = cudf::data_type{cudf::type_to_id<T>()})
+{
+    auto capacity = buffer.capacity();
+    buffer.resize(size, stream);
+    auto column = std::make_unique<cudf::column>(type, size, buffer.release(), rmm::device_buffer{}, 0);
+    buffer      = rmm::device_uvector<T>(capacity, stream);
+
+    return column;
+}
+
+// 128-bit addresses are stored as DECIMAL128 with a scale of 0, the only 128-bit integer type supported by cudf
+const cudf::data_type ip6_address_type{cudf::type_id::DECIMAL128, numeric::scale_type{0}};
+}  // namespace
+
+namespace morpheus::doca {
+
+PacketBuffers::PacketBuffers(rmm::cuda_stream_view stream) :
+  m_payload_buffer(MAX_PKT_RECEIVE * MAX_PKT_SIZE, stream),
+  m_payload_offsets(MAX_PKT_RECEIVE + 1, stream),
+  m_src_mac(MAX_PKT_RECEIVE, stream),
+  m_dst_mac(MAX_PKT_RECEIVE, stream),
+  m_src_ip(MAX_PKT_RECEIVE, stream),
+  m_dst_ip(MAX_PKT_RECEIVE, stream),
+  m_src_ip6(MAX_PKT_RECEIVE, stream),
+  m_dst_ip6(MAX_PKT_RECEIVE, stream),
+  m_src_port(MAX_PKT_RECEIVE, stream),
+  m_dst_port(MAX_PKT_RECEIVE, stream),
+  m_tcp_flags(MAX_PKT_RECEIVE, stream),
+  m_tcp_seq(MAX_PKT_RECEIVE, stream),
+  m_ether_type(MAX_PKT_RECEIVE, stream),
+  m_vlan_id(MAX_PKT_RECEIVE, stream),
+  m_next_proto_id(MAX_PKT_RECEIVE, stream),
+  m_timestamp(MAX_PKT_RECEIVE, stream)
+{}
+
+void PacketBuffers::set_outputs(packets_info& info)
+{
+    info.payload_buffer_out  = m_payload_buffer.data();
+    info.payload_offsets_out = m_payload_offsets.data();
+    info.src_mac_out         = m_src_mac.data();
+    info.dst_mac_out         = m_dst_mac.data();
+    info.src_ip_out          = m_src_ip.data();
+    info.dst_ip_out          = m_dst_ip.data();
+    info.src_ip6_out         = reinterpret_cast<uint64_t*>(m_src_ip6.data());
+    info.dst_ip6_out         = reinterpret_cast<uint64_t*>(m_dst_ip6.data());
+    info.src_port_out        = m_src_port.data();
+    info.dst_port_out        = m_dst_port.data();
+    info.tcp_flags_out       = m_tcp_flags.data();
+    info.tcp_seq_out         = m_tcp_seq.data();
+    info.ether_type_out      = m_ether_type.data();
+    info.vlan_id_out         = m_vlan_id.data();
+    info.next_proto_id_out   = m_next_proto_id.data();
+    info.timestamp_out       = m_timestamp.data();
+}
+
+cudf::io::table_with_metadata PacketBuffers::make_table(packets_info& info,
+                                                        bool numeric_addresses,
+                                                        rmm::cuda_stream_view stream)
+{
+    auto packet_count = info.packet_count_out;
+
+    // The payloads were packed by the kernel, the buffers are adopted as the children of the strings column as-is
+    auto payload_offsets = take_column(m_payload_offsets, packet_count + 1, stream);
+    auto payload_chars   = take_column(
+        m_payload_buffer, info.payload_size_total_out, stream, cudf::data_type{cudf::type_id::INT8});
+    auto payload_col =
+        cudf::make_strings_column(packet_count, std::move(payload_offsets), std::move(payload_chars), 0, {});
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    columns.reserve(15);
+    columns.emplace_back(take_column(m_src_mac, packet_count, stream));
+    columns.emplace_back(take_column(m_dst_mac, packet_count, stream));
+    columns.emplace_back(take_column(m_src_ip, packet_count, stream));
+    columns.emplace_back(take_column(m_dst_ip, packet_count, stream));
+    columns.emplace_back(take_column(m_src_port, packet_count, stream));
+    columns.emplace_back(take_column(m_dst_port, packet_count, stream));
+    columns.emplace_back(take_column(m_tcp_flags, packet_count, stream));
+    columns.emplace_back(take_column(m_ether_type, packet_count, stream));
+    columns.emplace_back(take_column(m_next_proto_id, packet_count, stream));
+    columns.emplace_back(take_column(m_timestamp, packet_count, stream));
+    columns.emplace_back(take_column(m_vlan_id, packet_count, stream));
+    columns.emplace_back(take_column(m_tcp_seq, packet_count, stream));
+
+    auto src_ip6_col = take_column(m_src_ip6, packet_count, stream, ip6_address_type);
+    auto dst_ip6_col = take_column(m_dst_ip6, packet_count, stream, ip6_address_type);
+    set_outputs(info);
+
+    if (numeric_addresses)
+    {
+        // src_ip/dst_ip only hold IPv4 addresses, the 128-bit columns hold both
+        columns.emplace_back(std::move(src_ip6_col));
+        columns.emplace_back(std::move(dst_ip6_col));
+    }
+    else
+    {
+        // post-processing for mac addresses
+        columns[0] = integers_to_mac(columns[0]->view(), stream);
+        columns[1] = integers_to_mac(columns[1]->view(), stream);
+
+        // post-processing for ip addresses, formatted from the 128-bit addresses to cover IPv6
+        columns[2] = ip_addresses_to_strings(src_ip6_col->view(), stream);
+        columns[3] = ip_addresses_to_strings(dst_ip6_col->view(), stream);
+    }
+
+    columns.emplace_back(std::move(payload_col));
+
+    auto metadata = cudf::io::table_metadata();
+    // assemble metadata
+    metadata.schema_info.emplace_back("src_mac");
+    metadata.schema_info.emplace_back("dst_mac");
+    metadata.schema_info.emplace_back("src_ip");
+    metadata.schema_info.emplace_back("dst_ip");
+    metadata.schema_info.emplace_back("src_port");
+    metadata.schema_info.emplace_back("dst_port");
+    metadata.schema_info.emplace_back("tcp_flags");
+    metadata.schema_info.emplace_back("ether_type");
+    metadata.schema_info.emplace_back("next_proto");
+    metadata.schema_info.emplace_back("timestamp");
+    metadata.schema_info.emplace_back("vlan_id");
+    metadata.schema_info.emplace_back("tcp_seq");
+    if (numeric_addresses)
+    {
+        metadata.schema_info.emplace_back("src_ip6");
+        metadata.schema_info.emplace_back("dst_ip6");
+    }
+    metadata.schema_info.emplace_back("data");
+
+    return cudf::io::table_with_metadata{std::make_unique<cudf::table>(std::move(columns)), std::move(metadata)};
+}
+
+}  // namespace morpheus::doca
@@ -0,0 +1,309 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/doca/doca_pcap_source.hpp"
+
+#include "morpheus/doca/doca_packet_buffers.hpp"
+#include "morpheus/doca/doca_source_kernels.hpp"
+#include "morpheus/doca/pcap_reader.hpp"
+#include "morpheus/utilities/error.hpp"
+
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+#include <netinet/in.h>
+#include <rmm/cuda_stream.hpp>
+#include <rmm/device_uvector.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace morpheus {
+
+namespace {
+uint16_t const ETHER_TYPE_IPV4 = 0x0800;
+uint16_t const ETHER_TYPE_IPV6 = 0x86DD;
+uint16_t const ETHER_TYPE_VLAN = 0x8100;
+uint16_t const ETHER_TYPE_QINQ = 0x88A8;
+
+uint16_t load_be16(uint8_t const* data)
+{
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+/**
+ * @brief Mirrors the filtering of the flow pipe, returning true for frames holding a complete TCP or UDP header over
+ * IPv4 or IPv6, behind at most two VLAN tags.
+ */
+bool matches_traffic_type(doca::PcapPacket const& packet, bool is_tcp)
+{
+    std::size_t const length = packet.captured_length;
+    std::size_t offset       = 14;
+
+    if (length < offset)
+    {
+        return false;
+    }
+
+    auto ether_type = load_be16(packet.data + 12);
+    for (int tag = 0; tag < 2 && (ether_type == ETHER_TYPE_VLAN || ether_type == ETHER_TYPE_QINQ); tag++)
+    {
+        if (length < offset + 4)
+        {
+            return false;
+        }
+
+        ether_type = load_be16(packet.data + offset + 2);
+        offset += 4;
+    }
+
+    uint8_t next_proto;
+    if (ether_type == ETHER_TYPE_IPV4)
+    {
+        if (length < offset + 20)
+        {
+            return false;
+        }
+
+        next_proto = packet.data[offset + 9];
+        offset += (packet.data[offset] & 0x0F) * 4;
+    }
+    else if (ether_type == ETHER_TYPE_IPV6)
+    {
+        if (length < offset + 40)
+        {
+            return false;
+        }
+
+        next_proto = packet.data[offset + 6];
+        offset += 40;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (is_tcp)
+    {
+        return next_proto == IPPROTO_TCP && length >= offset + 20;
+    }
+
+    return next_proto == IPPROTO_UDP && length >= offset + 8;
+}
+
+template <typename T>
+struct pinned_buffer
+{
+    pinned_buffer(std::size_t size)
+    {
+        CUDA_TRY(cudaMallocHost(&data, size * sizeof(T)));
+    }
+
+    ~pinned_buffer()
+    {
+        cudaFreeHost(data);
+    }
+
+    pinned_buffer(pinned_buffer const&)            = delete;
+    pinned_buffer& operator=(pinned_buffer const&) = delete;
+
+    T* data{nullptr};
+};
+}  // namespace
+
+DocaPcapSourceStage::DocaPcapSourceStage(std::string pcap_file,
+                                         std::string const& traffic_type,
+                                         double packets_per_second,
+                                         std::size_t repeat,
+                                         bool numeric_addresses) :
+  PythonSource(build()),
+  m_pcap_file(std::move(pcap_file)),
+  m_packets_per_second(packets_per_second),
+  m_repeat(repeat),
+  m_numeric_addresses(numeric_addresses)
+{
+    m_traffic_type = DOCA_TRAFFIC_TYPE_UDP;
+    if (traffic_type == "tcp")
+        m_traffic_type = DOCA_TRAFFIC_TYPE_TCP;
+
+    if (m_packets_per_second < 0)
+    {
+        throw std::invalid_argument("packets_per_second must be greater than or equal to 0");
+    }
+
+    if (m_repeat == 0)
+    {
+        throw std::invalid_argument("repeat must be greater than 0");
+    }
+}
+
+DocaPcapSourceStage::subscriber_fn_t DocaPcapSourceStage::build()
+{
+    return [this](rxcpp::subscriber<source_type_t> output) {
+        bool const is_tcp = m_traffic_type == DOCA_TRAFFIC_TYPE_TCP;
+
+        doca::PcapReader reader(m_pcap_file);
+
+        rmm::cuda_stream stream;
+        doca::PacketBuffers packet_buffers(stream.view());
+        packets_info info{};
+        packet_buffers.set_outputs(info);
+
+        // Frames are staged contiguously in pinned memory and copied to the GPU with a single copy per batch, the frame
+        // offsets, lengths and timestamps follow each other in `frame_info`
+        pinned_buffer<uint8_t> frames_h(MAX_PKT_RECEIVE * MAX_PKT_SIZE);
+        pinned_buffer<uint32_t> frame_info_h(3 * MAX_PKT_RECEIVE);
+        rmm::device_uvector<uint8_t> frames_d(MAX_PKT_RECEIVE * MAX_PKT_SIZE, stream.view());
+        rmm::device_uvector<uint32_t> frame_info_d(3 * MAX_PKT_RECEIVE, stream.view());
+
+        uint32_t* frame_offsets    = frame_info_h.data;
+        uint32_t* frame_lengths    = frame_info_h.data + MAX_PKT_RECEIVE;
+        uint32_t* frame_timestamps = frame_info_h.data + 2 * MAX_PKT_RECEIVE;
+
+        std::size_t num_packets = 0;
+        std::size_t num_bytes   = 0;
+        std::size_t num_skipped = 0;
+
+        // Capture timestamps are offset on each pass by the duration of the capture, keeping them increasing
+        uint64_t pass_offset_ns = 0;
+        uint64_t first_ts_ns    = UINT64_MAX;
+        uint64_t last_ts_ns     = 0;
+
+        auto start_time = std::chrono::steady_clock::now();
+
+        for (std::size_t pass = 0; pass < m_repeat && output.is_subscribed(); pass++)
+        {
+            while (output.is_subscribed())
+            {
+                uint32_t packet_count = 0;
+                uint32_t frame_bytes  = 0;
+                doca::PcapPacket packet;
+
+                while (packet_count < MAX_PKT_RECEIVE && reader.next(packet))
+                {
+                    if (!matches_traffic_type(packet, is_tcp))
+                    {
+                        num_skipped++;
+                        continue;
+                    }
+
+                    if (pass == 0)
+                    {
+                        first_ts_ns = std::min(first_ts_ns, packet.timestamp_ns);
+                        last_ts_ns  = std::max(last_ts_ns, packet.timestamp_ns);
+                    }
+
+                    auto length = std::min<uint32_t>(packet.captured_length, MAX_PKT_SIZE);
+                    std::memcpy(frames_h.data + frame_bytes, packet.data, length);
+
+                    frame_offsets[packet_count]    = frame_bytes;
+                    frame_lengths[packet_count]    = length;
+                    frame_timestamps[packet_count] = static_cast<uint32_t>((packet.timestamp_ns + pass_offset_ns) /
+                                                                           1000000);
+
+                    frame_bytes += length;
+                    packet_count++;
+                }
+
+                if (packet_count == 0)
+                {
+                    break;
+                }
+
+                if (m_packets_per_second > 0)
+                {
+                    // Pace whole batches, the batch is released once the rate allows for all of its packets
+                    auto due = start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                std::chrono::duration<double>((num_packets + packet_count) /
+                                                                              m_packets_per_second));
+                    std::this_thread::sleep_until(due);
+                }
+
+                CUDA_TRY(cudaMemcpyAsync(
+                    frames_d.data(), frames_h.data, frame_bytes, cudaMemcpyHostToDevice, stream.value()));
+                for (uint32_t i = 0; i < 3; i++)
+                {
+                    CUDA_TRY(cudaMemcpyAsync(frame_info_d.data() + i * MAX_PKT_RECEIVE,
+                                             frame_info_h.data + i * MAX_PKT_RECEIVE,
+                                             packet_count * sizeof(uint32_t),
+                                             cudaMemcpyHostToDevice,
+                                             stream.value()));
+                }
+
+                doca::packet_replay_kernel(frames_d.data(),
+                                           frame_info_d.data(),
+                                           frame_info_d.data() + MAX_PKT_RECEIVE,
+                                           frame_info_d.data() + 2 * MAX_PKT_RECEIVE,
+                                           static_cast<int32_t>(packet_count),
+                                           is_tcp,
+                                           info,
+                                           stream.value());
+
+                info.packet_count_out = static_cast<int32_t>(packet_count);
+
+                // The size of the packed payloads is needed on the host to build the strings column
+                CUDA_TRY(cudaMemcpyAsync(&info.payload_size_total_out,
+                                         info.payload_offsets_out + packet_count,
+                                         sizeof(int32_t),
+                                         cudaMemcpyDeviceToHost,
+                                         stream.value()));
+                stream.synchronize();
+
+                auto table = packet_buffers.make_table(info, m_numeric_addresses, stream.view());
+                auto meta  = MessageMeta::create_from_cpp(std::move(table), 0);
+
+                // The staging and packet buffers are reused by the next batch
+                stream.synchronize();
+
+                num_packets += packet_count;
+                num_bytes += frame_bytes;
+
+                output.on_next(std::move(meta));
+            }
+
+            pass_offset_ns += (first_ts_ns <= last_ts_ns ? last_ts_ns - first_ts_ns : 0) + 1000000;
+            reader.rewind();
+        }
+
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        LOG(INFO) << "DocaPcapSourceStage replayed " << num_packets << " packets (" << num_bytes << " bytes) from '"
+                  << m_pcap_file << "' in " << elapsed << "s, " << (elapsed > 0 ? num_packets / elapsed : 0)
+                  << " packets/s, skipped " << num_skipped << " packets not matching the traffic type";
+
+        output.on_completed();
+    };
+}
+
+std::shared_ptr<mrc::segment::Object<DocaPcapSourceStage>> DocaPcapSourceStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    std::string const& name,
+    std::string pcap_file,
+    std::string const& traffic_type,
+    double packets_per_second,
+    std::size_t repeat,
+    bool numeric_addresses)
+{
+    return builder.construct_object<DocaPcapSourceStage>(
+        name, std::move(pcap_file), traffic_type, packets_per_second, repeat, numeric_addresses);
+}
+
+}  // namespace morpheus
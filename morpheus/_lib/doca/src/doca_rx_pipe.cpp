@@ -20,44 +20,51 @@
 #include <glog/logging.h>
 #include <netinet/in.h>
 
+#include <array>
+#include <utility>
+#include <vector>
+
 namespace morpheus::doca {
 
-/* Create more Queues/Different Flows */
-DocaRxPipe::DocaRxPipe(std::shared_ptr<DocaContext> context,
-                       std::vector<std::shared_ptr<morpheus::doca::DocaRxQueue>> rxq,
-                       enum doca_traffic_type const type) :
-  m_context(context),
-  m_rxq(rxq),
-  m_traffic_type(type),
-  m_pipe(nullptr)
+namespace {
+
+/**
+ * @brief Creates a pipe matching TCP or UDP packets of the given L3 type, spreading them across the receive queues
+ * with RSS. VLAN tagged frames are matched as well, as the NIC parses the L3 header past any VLAN tags.
+ *
+ * When `dst_ports` is not empty the destination port is matched as well, with one entry per port, otherwise a single
+ * entry matches every port.
+ */
+doca_flow_pipe* create_gpu_pipe(std::shared_ptr<DocaContext> const& context,
+                                std::array<uint16_t, MAX_QUEUE>& rss_queues,
+                                uint32_t num_queues,
+                                enum doca_traffic_type const type,
+                                enum doca_flow_l3_type const l3_type,
+                                std::vector<uint16_t> const& dst_ports,
+                                char const* name)
 {
-    auto rss_queues = std::array<uint16_t, MAX_QUEUE>();
-    for (int idx = 0; idx < m_rxq.size(); idx++)
-        doca_eth_rxq_get_flow_queue_id(m_rxq[idx]->rxq_info_cpu(), &(rss_queues[idx]));
+    bool const is_tcp  = type == DOCA_TRAFFIC_TYPE_TCP;
+    bool const is_ipv6 = l3_type == DOCA_FLOW_L3_TYPE_IP6;
 
     doca_flow_match match_mask{0};
     doca_flow_match match{};
-    match.outer.l3_type = DOCA_FLOW_L3_TYPE_IP4;
-    if (m_traffic_type == DOCA_TRAFFIC_TYPE_TCP)
-    {
-        match.outer.ip4.next_proto = IPPROTO_TCP;
-        match.outer.l4_type_ext    = DOCA_FLOW_L4_TYPE_EXT_TCP;
-    }
+    match.outer.l3_type     = l3_type;
+    match.outer.l4_type_ext = is_tcp ? DOCA_FLOW_L4_TYPE_EXT_TCP : DOCA_FLOW_L4_TYPE_EXT_UDP;
+    if (is_ipv6)
+        match.outer.ip6.next_proto = is_tcp ? IPPROTO_TCP : IPPROTO_UDP;
     else
-    {
-        match.outer.ip4.next_proto = IPPROTO_UDP;
-        match.outer.l4_type_ext    = DOCA_FLOW_L4_TYPE_EXT_UDP;
-    }
+        match.outer.ip4.next_proto = is_tcp ? IPPROTO_TCP : IPPROTO_UDP;
 
-    doca_flow_fwd fwd{};
-    fwd.type = DOCA_FLOW_FWD_RSS;
+    // Set to all ones the destination port is changeable, each entry providing its own value
+    if (!dst_ports.empty())
+        match.outer.transport.dst_port = 0xffff;
 
-    if (m_traffic_type == DOCA_TRAFFIC_TYPE_TCP)
-        fwd.rss_outer_flags = DOCA_FLOW_RSS_IPV4 | DOCA_FLOW_RSS_TCP;
-    else
-        fwd.rss_outer_flags = DOCA_FLOW_RSS_IPV4 | DOCA_FLOW_RSS_UDP;
+    doca_flow_fwd fwd{};
+    fwd.type            = DOCA_FLOW_FWD_RSS;
+    fwd.rss_outer_flags = (is_ipv6 ? DOCA_FLOW_RSS_IPV6 : DOCA_FLOW_RSS_IPV4) |
+                          (is_tcp ? DOCA_FLOW_RSS_TCP : DOCA_FLOW_RSS_UDP);
     fwd.rss_queues    = rss_queues.begin();
-    fwd.num_of_queues = m_rxq.size();
+    fwd.num_of_queues = num_queues;
 
     doca_flow_fwd miss_fwd{};
     miss_fwd.type = DOCA_FLOW_FWD_DROP;
@@ -66,7 +73,7 @@ DocaRxPipe::DocaRxPipe(std::shared_ptr<DocaContext> context,
     monitor.counter_type = DOCA_FLOW_RESOURCE_TYPE_NON_SHARED;
 
     doca_flow_pipe_cfg pipe_cfg{};
-    pipe_cfg.attr.name                   = "GPU_RXQ_PIPE";
+    pipe_cfg.attr.name                   = name;
     pipe_cfg.attr.enable_strict_matching = true;
     pipe_cfg.attr.type                   = DOCA_FLOW_PIPE_BASIC;
     pipe_cfg.attr.nb_actions             = 0;
@@ -76,15 +83,54 @@ DocaRxPipe::DocaRxPipe(std::shared_ptr<DocaContext> context,
     pipe_cfg.monitor                     = &monitor;
     pipe_cfg.port                        = context->flow_port();
 
-    DOCA_TRY(doca_flow_pipe_create(&pipe_cfg, &fwd, &miss_fwd, &m_pipe));
+    doca_flow_pipe* pipe = nullptr;
+    DOCA_TRY(doca_flow_pipe_create(&pipe_cfg, &fwd, &miss_fwd, &pipe));
+
+    if (dst_ports.empty())
+    {
+        doca_flow_pipe_entry* placeholder_entry = nullptr;
+        DOCA_TRY(doca_flow_pipe_add_entry(
+            0, pipe, &match, nullptr, nullptr, nullptr, DOCA_FLOW_NO_WAIT, nullptr, &placeholder_entry));
+    }
+
+    for (auto port : dst_ports)
+    {
+        doca_flow_match entry_match          = match;
+        entry_match.outer.transport.dst_port = htons(port);
+
+        doca_flow_pipe_entry* port_entry = nullptr;
+        DOCA_TRY(doca_flow_pipe_add_entry(
+            0, pipe, &entry_match, nullptr, nullptr, nullptr, DOCA_FLOW_NO_WAIT, nullptr, &port_entry));
+    }
 
-    doca_flow_pipe_entry* placeholder_entry = nullptr;
-    DOCA_TRY(doca_flow_pipe_add_entry(
-        0, m_pipe, &match, nullptr, nullptr, nullptr, DOCA_FLOW_NO_WAIT, nullptr, &placeholder_entry));
     DOCA_TRY(doca_flow_entries_process(context->flow_port(), 0, 0, 0));
 
-    uint32_t priority_high = 1;
-    uint32_t priority_low  = 3;
+    return pipe;
+}
+
+}  // namespace
+
+/* Create more Queues/Different Flows */
+DocaRxPipe::DocaRxPipe(std::shared_ptr<DocaContext> context,
+                       std::vector<std::shared_ptr<morpheus::doca::DocaRxQueue>> rxq,
+                       enum doca_traffic_type const type,
+                       packet_filter const& filter) :
+  m_context(context),
+  m_rxq(rxq),
+  m_traffic_type(type),
+  m_pipe(nullptr),
+  m_pipe_ipv6(nullptr)
+{
+    auto rss_queues = std::array<uint16_t, MAX_QUEUE>();
+    for (int idx = 0; idx < m_rxq.size(); idx++)
+        doca_eth_rxq_get_flow_queue_id(m_rxq[idx]->rxq_info_cpu(), &(rss_queues[idx]));
+
+    auto dst_ports = offloadable_dst_ports(filter);
+
+    m_pipe = create_gpu_pipe(
+        context, rss_queues, m_rxq.size(), m_traffic_type, DOCA_FLOW_L3_TYPE_IP4, dst_ports, "GPU_RXQ_PIPE");
+    m_pipe_ipv6 = create_gpu_pipe(
+        context, rss_queues, m_rxq.size(), m_traffic_type, DOCA_FLOW_L3_TYPE_IP6, dst_ports, "GPU_RXQ_IPV6_PIPE");
 
     doca_flow_match root_match_mask = {0};
     doca_flow_monitor root_monitor  = {};
@@ -101,45 +147,41 @@ DocaRxPipe::DocaRxPipe(std::shared_ptr<DocaContext> context,
 
     DOCA_TRY(doca_flow_pipe_create(&root_pipe_cfg, nullptr, nullptr, &m_root_pipe));
 
-    struct doca_flow_match root_match_gpu = {};
-    struct doca_flow_fwd root_fwd_gpu     = {};
-    doca_flow_pipe_entry* root_tcp_entry_gpu;
-
-    if (m_traffic_type == DOCA_TRAFFIC_TYPE_TCP)
+    for (auto [l3_type, next_pipe] :
+         {std::pair{DOCA_FLOW_L3_TYPE_IP4, m_pipe}, std::pair{DOCA_FLOW_L3_TYPE_IP6, m_pipe_ipv6}})
     {
-        root_match_gpu.outer.l3_type     = DOCA_FLOW_L3_TYPE_IP4;
-        root_match_gpu.outer.l4_type_ext = DOCA_FLOW_L4_TYPE_EXT_TCP;
-        root_fwd_gpu.type                = DOCA_FLOW_FWD_PIPE;
-        root_fwd_gpu.next_pipe           = m_pipe;
-    }
-    else
-    {
-        root_match_gpu.outer.l3_type     = DOCA_FLOW_L3_TYPE_IP4;
-        root_match_gpu.outer.l4_type_ext = DOCA_FLOW_L4_TYPE_EXT_UDP;
+        struct doca_flow_match root_match_gpu = {};
+        struct doca_flow_fwd root_fwd_gpu     = {};
+        doca_flow_pipe_entry* root_entry_gpu;
+
+        root_match_gpu.outer.l3_type     = l3_type;
+        root_match_gpu.outer.l4_type_ext = m_traffic_type == DOCA_TRAFFIC_TYPE_TCP ? DOCA_FLOW_L4_TYPE_EXT_TCP
+                                                                                   : DOCA_FLOW_L4_TYPE_EXT_UDP;
         root_fwd_gpu.type                = DOCA_FLOW_FWD_PIPE;
-        root_fwd_gpu.next_pipe           = m_pipe;
+        root_fwd_gpu.next_pipe           = next_pipe;
+
+        DOCA_TRY(doca_flow_pipe_control_add_entry(0,
+                                                  0, /*priority_low,*/
+                                                  m_root_pipe,
+                                                  &root_match_gpu,
+                                                  nullptr,
+                                                  nullptr,
+                                                  nullptr,
+                                                  nullptr,
+                                                  nullptr,
+                                                  nullptr,
+                                                  &root_fwd_gpu,
+                                                  nullptr,
+                                                  &root_entry_gpu));
     }
 
-    DOCA_TRY(doca_flow_pipe_control_add_entry(0,
-                                              0, /*priority_low,*/
-                                              m_root_pipe,
-                                              &root_match_gpu,
-                                              nullptr,
-                                              nullptr,
-                                              nullptr,
-                                              nullptr,
-                                              nullptr,
-                                              nullptr,
-                                              &root_fwd_gpu,
-                                              nullptr,
-                                              &root_tcp_entry_gpu));
-
     DOCA_TRY(doca_flow_entries_process(context->flow_port(), 0, 0, 0));
 }
 
 DocaRxPipe::~DocaRxPipe()
 {
     doca_flow_pipe_destroy(m_root_pipe);
+    doca_flow_pipe_destroy(m_pipe_ipv6);
     doca_flow_pipe_destroy(m_pipe);
 }
 
@@ -16,6 +16,8 @@
  */
 
 #include "morpheus/doca/common.hpp"
+#include "morpheus/doca/doca_source_kernels.hpp"
+#include "morpheus/doca/packet_filter.hpp"
 
 #include "morpheus/utilities/error.hpp"
 
@@ -33,6 +35,8 @@
 #include <doca_gpunetio_dev_buf.cuh>
 #include <doca_gpunetio_dev_eth_rxq.cuh>
 #include <doca_gpunetio_dev_sem.cuh>
+#include <netinet/in.h>
+#include <rmm/device_uvector.hpp>
 #include <rmm/exec_policy.hpp>
 #include <rte_ether.h>
 #include <rte_ip.h>
@@ -41,6 +45,8 @@
 #include <thrust/gather.h>
 #include <thrust/iterator/constant_iterator.h>
 #include <thrust/iterator/counting_iterator.h>
+#include <thrust/scan.h>
+#include <thrust/transform.h>
 
 #include <memory>
 
@@ -49,6 +55,10 @@
 #define BYTE_SWAP16(v) \
     ((((uint16_t)(v) & UINT16_C(0x00ff)) << 8) | (((uint16_t)(v) & UINT16_C(0xff00)) >> 8))
 
+#define BYTE_SWAP32(v) \
+    ((((uint32_t)(v) & UINT32_C(0x000000ff)) << 24) | (((uint32_t)(v) & UINT32_C(0x0000ff00)) << 8) | \
+     (((uint32_t)(v) & UINT32_C(0x00ff0000)) >> 8) | (((uint32_t)(v) & UINT32_C(0xff000000)) >> 24))
+
 #define TCP_PROTOCOL_ID 0x6
 #define UDP_PROTOCOL_ID 0x11
 #define TIMEOUT_NS 500000 //500us
@@ -103,12 +113,6 @@ struct tcp_hdr {
     uint16_t tcp_urp;	/* TCP urgent pointer, if any */
 } __attribute__((__packed__));
 
-struct eth_ip_tcp_hdr {
-    struct ether_hdr l2_hdr;	/* Ethernet header */
-    struct ipv4_hdr l3_hdr;		/* IP header */
-    struct tcp_hdr l4_hdr;		/* TCP header */
-} __attribute__((__packed__));
-
 struct udp_hdr {
     uint16_t src_port;	/* UDP source port */
     uint16_t dst_port;	/* UDP destination port */
@@ -116,29 +120,33 @@ struct udp_hdr {
     uint16_t dgram_cksum;	/* UDP datagram checksum */
 } __attribute__((__packed__));
 
-struct eth_ip_udp_hdr {
-    struct ether_hdr l2_hdr;	/* Ethernet header */
-    struct ipv4_hdr l3_hdr;		/* IP header */
-    struct udp_hdr l4_hdr;		/* UDP header */
+struct vlan_hdr {
+    uint16_t vlan_tci;		/* Priority, DEI and VLAN ID */
+    uint16_t ether_type;	/* Type of the encapsulated frame */
 } __attribute__((__packed__));
 
-__device__ __inline__ int
-raw_to_tcp(const uintptr_t buf_addr, struct eth_ip_tcp_hdr **hdr, uint8_t **packet_data)
-{
-    (*hdr) = (struct eth_ip_tcp_hdr *) buf_addr;
-    (*packet_data) = (uint8_t *) (buf_addr + sizeof(struct ether_hdr) + sizeof(struct ipv4_hdr) + (((*hdr)->l4_hdr.dt_off >> 4) * sizeof(int)));
-
-    return 0;
-}
-
-__device__ __inline__ int
-raw_to_udp(const uintptr_t buf_addr, struct eth_ip_udp_hdr **hdr, uint8_t **packet_data)
-{
-    (*hdr) = (struct eth_ip_udp_hdr *) buf_addr;
-    (*packet_data) = (uint8_t *) (buf_addr + sizeof(struct eth_ip_udp_hdr));
+struct ipv6_hdr {
+    uint32_t vtc_flow;		/* version, traffic class and flow label */
+    uint16_t payload_len;	/* length of the payload, including extension headers */
+    uint8_t  next_header;	/* type of the next header */
+    uint8_t  hop_limit;		/* hop limit */
+    uint8_t  src_addr[16];	/* source address */
+    uint8_t  dst_addr[16];	/* destination address */
+} __attribute__((__packed__));
 
-    return 0;
-}
+/* Headers of a received packet, after any VLAN tags and IPv6 extension headers have been skipped */
+struct packet_headers {
+    struct ether_hdr *l2_hdr;
+    uint16_t ether_type;	/* Type of the frame after any VLAN tags, in network byte order */
+    int32_t vlan_id;		/* Outermost VLAN ID, 0 when untagged */
+    uint8_t next_proto;		/* L4 protocol */
+    uint32_t src_ip4;		/* IPv4 addresses in network byte order, 0 for IPv6 */
+    uint32_t dst_ip4;
+    uint64_t src_ip6[2];	/* 128-bit addresses as (low, high) words, IPv4 addresses are IPv4-mapped */
+    uint64_t dst_ip6[2];
+    uint8_t *l4_hdr;		/* Start of the L4 header */
+    int32_t l4_len;			/* Length of the L4 header and payload */
+};
 
 __device__ __forceinline__ uint8_t
 gpu_ipv4_hdr_len(const struct ipv4_hdr& packet_l3)
@@ -146,33 +154,184 @@ gpu_ipv4_hdr_len(const struct ipv4_hdr& packet_l3)
     return (uint8_t)((packet_l3.version_ihl & RTE_IPV4_HDR_IHL_MASK) * RTE_IPV4_IHL_MULTIPLIER);
 };
 
-__device__ __forceinline__ uint32_t
-get_packet_size(ipv4_hdr& packet_l3)
+__device__ __forceinline__ uint64_t
+be_bytes_to_u64(const uint8_t *bytes)
 {
-    return static_cast<int32_t>(BYTE_SWAP16(packet_l3.total_length));
+    uint64_t value = 0;
+    for (auto i = 0; i < 8; i++)
+        value = (value << 8) | bytes[i];
+    return value;
 }
 
-__device__ __forceinline__ int32_t
-get_payload_tcp_size(ipv4_hdr& packet_l3, tcp_hdr& packet_l4)
+__device__ __inline__ bool
+parse_headers(const uintptr_t buf_addr, struct packet_headers *hdrs)
 {
-    auto packet_size       = get_packet_size(packet_l3);
-    auto ip_header_length  = gpu_ipv4_hdr_len(packet_l3);
-    auto tcp_header_length = static_cast<int32_t>(packet_l4.dt_off >> 4) * sizeof(int32_t);
-    auto payload_size      = packet_size - ip_header_length - tcp_header_length;
+    auto *l2_hdr = (struct ether_hdr *) buf_addr;
+    auto *l3 = (uint8_t *) (buf_addr + sizeof(struct ether_hdr));
+    uint16_t ether_type = l2_hdr->ether_type;
+
+    hdrs->l2_hdr = l2_hdr;
+    hdrs->vlan_id = 0;
+
+    // 802.1Q and 802.1ad (QinQ) tags
+    for (auto tag = 0;
+         tag < 2 && (ether_type == RTE_BE16(RTE_ETHER_TYPE_VLAN) || ether_type == RTE_BE16(RTE_ETHER_TYPE_QINQ));
+         tag++) {
+        auto *vlan = (struct vlan_hdr *) l3;
+        if (tag == 0)
+            hdrs->vlan_id = BYTE_SWAP16(vlan->vlan_tci) & 0x0FFF;
+        ether_type = vlan->ether_type;
+        l3 += sizeof(struct vlan_hdr);
+    }
 
-    return payload_size;
+    hdrs->ether_type = ether_type;
+
+    if (ether_type == RTE_BE16(RTE_ETHER_TYPE_IPV4)) {
+        auto *ip4 = (struct ipv4_hdr *) l3;
+        auto header_len = gpu_ipv4_hdr_len(*ip4);
+
+        hdrs->next_proto = ip4->next_proto_id;
+        hdrs->src_ip4 = ip4->src_addr;
+        hdrs->dst_ip4 = ip4->dst_addr;
+        hdrs->src_ip6[0] = 0x0000FFFF00000000ull | BYTE_SWAP32(ip4->src_addr);
+        hdrs->src_ip6[1] = 0;
+        hdrs->dst_ip6[0] = 0x0000FFFF00000000ull | BYTE_SWAP32(ip4->dst_addr);
+        hdrs->dst_ip6[1] = 0;
+        hdrs->l4_hdr = l3 + header_len;
+        hdrs->l4_len = static_cast<int32_t>(BYTE_SWAP16(ip4->total_length)) - header_len;
+        return true;
+    }
+
+    if (ether_type == RTE_BE16(RTE_ETHER_TYPE_IPV6)) {
+        auto *ip6 = (struct ipv6_hdr *) l3;
+        auto *next = l3 + sizeof(struct ipv6_hdr);
+        int32_t len = BYTE_SWAP16(ip6->payload_len);
+        uint8_t next_header = ip6->next_header;
+
+        // Skip the hop-by-hop, routing, fragment and destination options extension headers
+        for (auto ext = 0; ext < 4 && len > 0; ext++) {
+            int32_t ext_len;
+            if (next_header == IPPROTO_HOPOPTS || next_header == IPPROTO_ROUTING || next_header == IPPROTO_DSTOPTS)
+                ext_len = (next[1] + 1) * 8;
+            else if (next_header == IPPROTO_FRAGMENT)
+                ext_len = 8;
+            else
+                break;
+
+            next_header = next[0];
+            next += ext_len;
+            len -= ext_len;
+        }
+
+        hdrs->next_proto = next_header;
+        hdrs->src_ip4 = 0;
+        hdrs->dst_ip4 = 0;
+        hdrs->src_ip6[0] = be_bytes_to_u64(ip6->src_addr + 8);
+        hdrs->src_ip6[1] = be_bytes_to_u64(ip6->src_addr);
+        hdrs->dst_ip6[0] = be_bytes_to_u64(ip6->dst_addr + 8);
+        hdrs->dst_ip6[1] = be_bytes_to_u64(ip6->dst_addr);
+        hdrs->l4_hdr = next;
+        hdrs->l4_len = len;
+        return true;
+    }
+
+    return false;
 }
 
 __device__ __forceinline__ int32_t
-get_payload_udp_size(ipv4_hdr& packet_l3, udp_hdr& packet_l4)
+clamp_payload_size(int32_t payload_size)
 {
-    auto packet_size       = get_packet_size(packet_l3);
-    auto ip_header_length  = gpu_ipv4_hdr_len(packet_l3);
-    auto payload_size      = packet_size - ip_header_length - sizeof(struct udp_hdr);
+    // Guards against malformed length fields overrunning the per-packet buffer
+    return max(0, min(payload_size, static_cast<int32_t>(MAX_PKT_SIZE)));
+}
+
+// Locates the payload of the packet parsed into `hdrs` at `buf_addr`, returning its size. Captured frames may be
+// truncated, the payload never extends past the `frame_len` bytes of the frame.
+__device__ __forceinline__ int32_t
+payload_extent(const uintptr_t buf_addr,
+               const int32_t frame_len,
+               const struct packet_headers& hdrs,
+               const bool is_tcp,
+               uint8_t **payload)
+{
+    int32_t payload_size;
+
+    if (is_tcp) {
+        auto *l4_hdr = (struct tcp_hdr *) hdrs.l4_hdr;
+        auto tcp_header_length = static_cast<int32_t>(l4_hdr->dt_off >> 4) * sizeof(int32_t);
+        *payload = hdrs.l4_hdr + tcp_header_length;
+        payload_size = clamp_payload_size(hdrs.l4_len - tcp_header_length);
+    } else {
+        *payload = hdrs.l4_hdr + sizeof(struct udp_hdr);
+        payload_size = clamp_payload_size(hdrs.l4_len - static_cast<int32_t>(sizeof(struct udp_hdr)));
+    }
+
+    auto frame_remaining = static_cast<intptr_t>(buf_addr + frame_len) - reinterpret_cast<intptr_t>(*payload);
+    if (frame_remaining < payload_size)
+        payload_size = static_cast<int32_t>(max(intptr_t{0}, frame_remaining));
 
     return payload_size;
 }
 
+__device__ __forceinline__ bool
+match_port(const uint16_t port, const morpheus::doca::port_range *ranges, const uint32_t num_ranges)
+{
+    if (num_ranges == 0)
+        return true;
+
+    for (uint32_t r = 0; r < num_ranges; r++) {
+        if (port >= ranges[r].first && port <= ranges[r].last)
+            return true;
+    }
+
+    return false;
+}
+
+__device__ __forceinline__ bool
+match_ip(const uint64_t *address, const morpheus::doca::ip_prefix *prefixes, const uint32_t num_prefixes)
+{
+    if (num_prefixes == 0)
+        return true;
+
+    for (uint32_t p = 0; p < num_prefixes; p++) {
+        if ((address[0] & prefixes[p].mask[0]) == prefixes[p].address[0] &&
+            (address[1] & prefixes[p].mask[1]) == prefixes[p].address[1])
+            return true;
+    }
+
+    return false;
+}
+
+// Evaluates `filter` against the parsed headers of a packet, before anything is written to the semaphore slot
+__device__ __inline__ bool
+filter_packet(const struct packet_headers& hdrs, const bool is_tcp, const morpheus::doca::packet_filter& filter)
+{
+    uint16_t src_port;
+    uint16_t dst_port;
+    int32_t payload_size;
+
+    if (is_tcp) {
+        auto *l4_hdr = (struct tcp_hdr *) hdrs.l4_hdr;
+        if ((l4_hdr->tcp_flags & filter.tcp_flags_mask) != filter.tcp_flags_value)
+            return false;
+
+        src_port = BYTE_SWAP16(l4_hdr->src_port);
+        dst_port = BYTE_SWAP16(l4_hdr->dst_port);
+        payload_size = clamp_payload_size(hdrs.l4_len - static_cast<int32_t>(l4_hdr->dt_off >> 4) * 4);
+    } else {
+        auto *l4_hdr = (struct udp_hdr *) hdrs.l4_hdr;
+        src_port = BYTE_SWAP16(l4_hdr->src_port);
+        dst_port = BYTE_SWAP16(l4_hdr->dst_port);
+        payload_size = clamp_payload_size(hdrs.l4_len - static_cast<int32_t>(sizeof(struct udp_hdr)));
+    }
+
+    return payload_size >= filter.min_payload_size && payload_size <= filter.max_payload_size &&
+           match_port(dst_port, filter.dst_ports, filter.num_dst_port_ranges) &&
+           match_port(src_port, filter.src_ports, filter.num_src_port_ranges) &&
+           match_ip(hdrs.dst_ip6, filter.dst_prefixes, filter.num_dst_prefixes) &&
+           match_ip(hdrs.src_ip6, filter.src_prefixes, filter.num_src_prefixes);
+}
+
 __device__ char to_hex_16(uint8_t value)
 {
     return "0123456789ABCDEF"[value];
@@ -220,6 +379,79 @@ __device__ int64_t mac_int64_to_chars(int64_t mac, char* out)
     out[16] = to_hex_16(mac_5 % 16);
 }
 
+// Formats a 128-bit address as text, IPv4-mapped addresses in dotted decimal and the rest as compressed IPv6 text
+// (RFC 5952). Returns the length of the text, which is only written when `out` is not null.
+__device__ int32_t format_ip_address(uint64_t lo, uint64_t hi, char* out)
+{
+    int32_t pos = 0;
+    auto put = [&](char c) {
+        if (out != nullptr)
+            out[pos] = c;
+        pos++;
+    };
+
+    if (hi == 0 && (lo >> 32) == 0xFFFF) {
+        for (auto octet = 0; octet < 4; octet++) {
+            auto value = static_cast<uint32_t>((lo >> (24 - 8 * octet)) & 0xFF);
+            if (octet > 0)
+                put('.');
+            if (value >= 100)
+                put('0' + value / 100);
+            if (value >= 10)
+                put('0' + (value / 10) % 10);
+            put('0' + value % 10);
+        }
+        return pos;
+    }
+
+    uint16_t groups[8];
+    for (auto i = 0; i < 8; i++)
+        groups[i] = ((i < 4 ? hi : lo) >> (48 - 16 * (i % 4))) & 0xFFFF;
+
+    // The longest run of two or more zero groups is replaced with "::", the first one on a tie
+    int32_t run_start = -1;
+    int32_t run_len = 0;
+    for (int32_t i = 0; i < 8;) {
+        if (groups[i] != 0) {
+            i++;
+            continue;
+        }
+
+        int32_t j = i;
+        while (j < 8 && groups[j] == 0)
+            j++;
+
+        if (j - i >= 2 && j - i > run_len) {
+            run_start = i;
+            run_len = j - i;
+        }
+        i = j;
+    }
+
+    for (int32_t i = 0; i < 8; i++) {
+        if (i == run_start) {
+            put(':');
+            put(':');
+            i += run_len - 1;
+            continue;
+        }
+
+        if (i > 0 && i != run_start + run_len)
+            put(':');
+
+        bool leading = true;
+        for (auto shift = 12; shift >= 0; shift -= 4) {
+            auto nibble = (groups[i] >> shift) & 0xF;
+            if (leading && nibble == 0 && shift > 0)
+                continue;
+            leading = false;
+            put("0123456789abcdef"[nibble]);
+        }
+    }
+
+    return pos;
+}
+
 __device__ uint32_t tcp_parse_timestamp(rte_tcp_hdr const *tcp)
 {
     const uint8_t *tcp_opt = (typeof(tcp_opt))tcp + RTE_TCP_MIN_HDR_LEN;
@@ -252,275 +484,282 @@ __device__ uint32_t tcp_parse_timestamp(rte_tcp_hdr const *tcp)
 
 #define DEVICE_GET_TIME(globaltimer) asm volatile("mov.u64 %0, %globaltimer;" : "=l"(globaltimer))
 
+// Parses the packet at `buf_addr` into slot `packet_idx` of `pkt_info`, reading at most `frame_len` bytes of the packet.
+// The payload is written at `payload_offset` of the packed payload buffer, the caller having sized the payloads
+// beforehand with `payload_extent`. Shared by the receive and replay kernels, returns the payload size or -1 if the
+// packet is not an IP packet.
+__device__ __inline__ int32_t
+process_packet(const uintptr_t buf_addr,
+               const int32_t frame_len,
+               const uint32_t packet_idx,
+               const int32_t payload_offset,
+               const bool is_tcp,
+               const uint32_t timestamp,
+               struct packets_info *pkt_info)
+{
+    struct packet_headers hdrs;
+    uint8_t *payload;
+    int32_t payload_size;
+
+    // IP address conversion
+    auto ip_to_int64 = []__device__(auto address){
+    return (address & 0x000000ff) << 24
+            | (address & 0x0000ff00) << 8
+            | (address & 0x00ff0000) >> 8
+            | (address & 0xff000000) >> 24;
+    };
+
+    if (!parse_headers(buf_addr, &hdrs)) [[unlikely]] {
+        return -1;
+    }
+
+    payload_size = payload_extent(buf_addr, frame_len, hdrs, is_tcp, &payload);
+
+    if (is_tcp) {
+        auto *l4_hdr = (struct tcp_hdr *) hdrs.l4_hdr;
+        // ports
+        pkt_info->src_port_out[packet_idx] = BYTE_SWAP16(l4_hdr->src_port);
+        pkt_info->dst_port_out[packet_idx] = BYTE_SWAP16(l4_hdr->dst_port);
+        // tcp flags
+        pkt_info->tcp_flags_out[packet_idx] = static_cast<int32_t> (l4_hdr->tcp_flags);
+        pkt_info->tcp_seq_out[packet_idx] = BYTE_SWAP32(l4_hdr->sent_seq);
+    } else {
+        auto *l4_hdr = (struct udp_hdr *) hdrs.l4_hdr;
+        // ports
+        pkt_info->src_port_out[packet_idx] = BYTE_SWAP16(l4_hdr->src_port);
+        pkt_info->dst_port_out[packet_idx] = BYTE_SWAP16(l4_hdr->dst_port);
+        pkt_info->tcp_seq_out[packet_idx] = 0;
+    }
+
+    // Payload, packed so the buffer is the chars of the strings column as-is
+    for(auto j = 0; j < payload_size; j++)
+        pkt_info->payload_buffer_out[payload_offset + j] = payload[j];
+    pkt_info->payload_offsets_out[packet_idx] = payload_offset;
+    // mac address
+    pkt_info->src_mac_out[packet_idx] = mac_bytes_to_int64(hdrs.l2_hdr->s_addr_bytes);
+    pkt_info->dst_mac_out[packet_idx] = mac_bytes_to_int64(hdrs.l2_hdr->d_addr_bytes);
+    // ip address, IPv4 only
+    pkt_info->src_ip_out[packet_idx] = ip_to_int64(hdrs.src_ip4);
+    pkt_info->dst_ip_out[packet_idx] = ip_to_int64(hdrs.dst_ip4);
+    // ip address, 128-bit
+    pkt_info->src_ip6_out[packet_idx * 2] = hdrs.src_ip6[0];
+    pkt_info->src_ip6_out[packet_idx * 2 + 1] = hdrs.src_ip6[1];
+    pkt_info->dst_ip6_out[packet_idx * 2] = hdrs.dst_ip6[0];
+    pkt_info->dst_ip6_out[packet_idx * 2 + 1] = hdrs.dst_ip6[1];
+    // frame type, after any VLAN tags
+    pkt_info->ether_type_out[packet_idx] = static_cast<int32_t> (hdrs.ether_type);
+    pkt_info->vlan_id_out[packet_idx] = hdrs.vlan_id;
+    // protocol id
+    pkt_info->next_proto_id_out[packet_idx] = static_cast<int32_t> (hdrs.next_proto);
+    pkt_info->timestamp_out[packet_idx] = timestamp;
+
+    return payload_size;
+}
+
 __global__ void _packet_receive_kernel(
-    doca_gpu_eth_rxq*       rxq,
-    doca_gpu_semaphore_gpu* sem,
-    uint16_t sem_idx,
+    morpheus::doca::packet_receive_queues queues,
     const bool is_tcp,
+    const morpheus::doca::packet_filter filter,
     uint32_t* exit_condition
 )
 {
     __shared__ uint32_t packet_count_received;
     __shared__ uint64_t packet_offset_received;
     __shared__ struct packets_info *pkt_info;
-    // Specialize BlockReduce for a 1D block of 128 threads of type int
-    using BlockReduce = cub::BlockReduce<int32_t, THREADS_PER_BLOCK>;
-    // Allocate shared memory for BlockReduce
-    __shared__ typename BlockReduce::TempStorage temp_storage;
-#if RUN_PERSISTENT
+    __shared__ bool exit_requested;
+    using BlockScan = cub::BlockScan<int32_t, THREADS_PER_BLOCK>;
+    __shared__ typename BlockScan::TempStorage temp_storage;
     doca_gpu_semaphore_status sem_status;
-#endif
     int32_t _payload_sizes[PACKETS_PER_THREAD];
-    int32_t _payload_flags[PACKETS_PER_THREAD];
+    int32_t _payload_offsets[PACKETS_PER_THREAD];
+    int32_t _packet_flags[PACKETS_PER_THREAD];
+    int32_t _packet_slots[PACKETS_PER_THREAD];
+    uintptr_t _buf_addrs[PACKETS_PER_THREAD];
+    struct packet_headers hdrs;
     doca_gpu_buf *buf_ptr;
-    uintptr_t buf_addr;
     doca_error_t doca_ret;
-    struct eth_ip_tcp_hdr *hdr_tcp;
-    struct eth_ip_udp_hdr *hdr_udp;
-    uint8_t *payload;
-    // unsigned long long rx_start = 0, rx_stop = 0, pkt_proc = 0, reduce_stop =0, reduce_start = 0;
 
-    // IP address conversion
-    auto ip_to_int64 = []__device__(auto address){
-    return (address & 0x000000ff) << 24
-            | (address & 0x0000ff00) << 8
-            | (address & 0x00ff0000) >> 8
-            | (address & 0xff000000) >> 24;
-    };
+    // Persistent kernel, each block services a single receive queue filling its semaphore slots in a round-robin
+    // fashion while the CPU drains the slots which are ready, until the exit condition is set.
+    doca_gpu_eth_rxq* rxq       = queues.rxq[blockIdx.x];
+    doca_gpu_semaphore_gpu* sem = queues.sem[blockIdx.x];
+    uint32_t sem_idx            = 0;
 
-    //Initial semaphore index 0, assume it's free!
-    doca_ret = doca_gpu_dev_semaphore_get_custom_info_addr(sem, sem_idx, (void **)&pkt_info);
-    if (doca_ret != DOCA_SUCCESS) {
-        printf("Error %d doca_gpu_dev_semaphore_get_custom_info_addr\n", doca_ret);
-        DOCA_GPUNETIO_VOLATILE(*exit_condition) = 1;
-        return;
-    }
+    while (true) {
+        // Wait for the CPU to release the next slot
+        if (threadIdx.x == 0) {
+            do {
+                exit_requested = (DOCA_GPUNETIO_VOLATILE(*exit_condition) != 0);
+                if (exit_requested)
+                    break;
+
+                doca_ret = doca_gpu_dev_semaphore_get_status(sem, sem_idx, &sem_status);
+                if (doca_ret != DOCA_SUCCESS) {
+                    printf("Error %d doca_gpu_dev_semaphore_get_status\n", doca_ret);
+                    DOCA_GPUNETIO_VOLATILE(*exit_condition) = 1;
+                    exit_requested = true;
+                    break;
+                }
+            } while (sem_status != DOCA_GPU_SEMAPHORE_STATUS_FREE);
+
+            if (!exit_requested) {
+                doca_ret = doca_gpu_dev_semaphore_get_custom_info_addr(sem, sem_idx, (void **)&pkt_info);
+                if (doca_ret != DOCA_SUCCESS) {
+                    printf("Error %d doca_gpu_dev_semaphore_get_custom_info_addr\n", doca_ret);
+                    DOCA_GPUNETIO_VOLATILE(*exit_condition) = 1;
+                    exit_requested = true;
+                } else {
+                    DOCA_GPUNETIO_VOLATILE(pkt_info->packet_count_out) = 0;
+                    DOCA_GPUNETIO_VOLATILE(pkt_info->payload_size_total_out) = 0;
+                }
+            }
 
-    if (threadIdx.x == 0) {
-        DOCA_GPUNETIO_VOLATILE(pkt_info->packet_count_out) = 0;
-        DOCA_GPUNETIO_VOLATILE(pkt_info->payload_size_total_out) = 0;
-        DOCA_GPUNETIO_VOLATILE(packet_count_received) = 0;
-    }
-    __syncthreads();
+            DOCA_GPUNETIO_VOLATILE(packet_count_received) = 0;
+        }
+        __syncthreads();
+
+        if (exit_requested)
+            break;
 
-    // do {
-        // if (threadIdx.x == 0) DEVICE_GET_TIME(rx_start);
         doca_ret = doca_gpu_dev_eth_rxq_receive_block(rxq, PACKETS_PER_BLOCK, PACKET_RX_TIMEOUT_NS, &packet_count_received, &packet_offset_received);
         if (doca_ret != DOCA_SUCCESS) [[unlikely]] {
             DOCA_GPUNETIO_VOLATILE(*exit_condition) = 1;
-            return;
+            break;
         }
         __threadfence();
-        if (DOCA_GPUNETIO_VOLATILE(packet_count_received) == 0)
-            return;
 
-        // if (threadIdx.x == 0)
-        //   printf("Block %d sem id %d received %d\n", blockIdx.x, sem_idx, DOCA_GPUNETIO_VOLATILE(packet_count_received));
-        // if (threadIdx.x == 0) DEVICE_GET_TIME(rx_stop);
+        // Nothing received before the timeout, the slot stays free and is filled on the next pass
+        if (DOCA_GPUNETIO_VOLATILE(packet_count_received) == 0) {
+            __syncthreads();
+            continue;
+        }
 
+        // Evaluate the filter first, the packets which are kept are then compacted to the front of the slot so the
+        // CPU and the table never see the dropped ones
         for (auto i = 0; i < PACKETS_PER_THREAD; i++) {
             auto packet_idx = threadIdx.x * PACKETS_PER_THREAD + i;
+            _payload_sizes[i] = 0;
+            _packet_flags[i] = 0;
+
             if (packet_idx >= DOCA_GPUNETIO_VOLATILE(packet_count_received)) {
-                _payload_sizes[i] = 0;
-                _payload_flags[i] = 0;
                 continue;
             }
 
+            // Returning early would leave the rest of the block waiting at the next barrier, drop the packet and let
+            // the exit condition stop the kernel at the top of the loop instead
             doca_ret = doca_gpu_dev_eth_rxq_get_buf(rxq, DOCA_GPUNETIO_VOLATILE(packet_offset_received) + packet_idx, &buf_ptr);
             if (doca_ret != DOCA_SUCCESS) [[unlikely]] {
                 DOCA_GPUNETIO_VOLATILE(*exit_condition) = 1;
-                return;
+                continue;
             }
 
-            doca_ret = doca_gpu_dev_buf_get_addr(buf_ptr, &buf_addr);
+            doca_ret = doca_gpu_dev_buf_get_addr(buf_ptr, &_buf_addrs[i]);
             if (doca_ret != DOCA_SUCCESS) [[unlikely]] {
                 DOCA_GPUNETIO_VOLATILE(*exit_condition) = 1;
-                return;
+                continue;
             }
 
-            if (is_tcp) {
-                raw_to_tcp(buf_addr, &hdr_tcp, &payload);
-                //Payload
-                auto payload_size = get_payload_tcp_size(hdr_tcp->l3_hdr, hdr_tcp->l4_hdr);
-                for(auto j = 0; j < payload_size; j++)
-                    pkt_info->payload_buffer_out[packet_idx * MAX_PKT_SIZE + j] = payload[j];
-                _payload_sizes[i] = payload_size;
-                _payload_flags[i] = 1;
-                pkt_info->payload_sizes_out[packet_idx] = payload_size;
-                // mac address
-                pkt_info->src_mac_out[packet_idx] = mac_bytes_to_int64(hdr_tcp->l2_hdr.s_addr_bytes);
-                pkt_info->dst_mac_out[packet_idx] = mac_bytes_to_int64(hdr_tcp->l2_hdr.d_addr_bytes);
-                // ip address
-                pkt_info->src_ip_out[packet_idx] = ip_to_int64(hdr_tcp->l3_hdr.src_addr);
-                pkt_info->dst_ip_out[packet_idx] = ip_to_int64(hdr_tcp->l3_hdr.dst_addr);
-                // ports
-                pkt_info->src_port_out[packet_idx] = BYTE_SWAP16(hdr_tcp->l4_hdr.src_port);
-                pkt_info->dst_port_out[packet_idx] = BYTE_SWAP16(hdr_tcp->l4_hdr.dst_port);
-                // tcp flags
-                pkt_info->tcp_flags_out[packet_idx] = static_cast<int32_t> (hdr_tcp->l4_hdr.tcp_flags);
-                // frame type
-                pkt_info->ether_type_out[packet_idx] = static_cast<int32_t> (hdr_tcp->l2_hdr.ether_type);
-                // protocol id
-                pkt_info->next_proto_id_out[packet_idx] = static_cast<int32_t> (hdr_tcp->l3_hdr.next_proto_id);
-            } else {
-                raw_to_udp(buf_addr, &hdr_udp, &payload);
-                //Payload
-                auto payload_size = get_payload_udp_size(hdr_udp->l3_hdr, hdr_udp->l4_hdr);
-                for(auto j = 0; j < payload_size; j++)
-                    pkt_info->payload_buffer_out[packet_idx * MAX_PKT_SIZE + j] = payload[j];
-                _payload_sizes[i] = payload_size;
-                _payload_flags[i] = 1;
-                pkt_info->payload_sizes_out[packet_idx] = payload_size;
-                // mac address
-                pkt_info->src_mac_out[packet_idx] = mac_bytes_to_int64(hdr_udp->l2_hdr.s_addr_bytes);
-                pkt_info->dst_mac_out[packet_idx] = mac_bytes_to_int64(hdr_udp->l2_hdr.d_addr_bytes);
-                // ip address
-                pkt_info->src_ip_out[packet_idx] = ip_to_int64(hdr_udp->l3_hdr.src_addr);
-                pkt_info->dst_ip_out[packet_idx] = ip_to_int64(hdr_udp->l3_hdr.dst_addr);
-                // ports
-                pkt_info->src_port_out[packet_idx] = BYTE_SWAP16(hdr_udp->l4_hdr.src_port);
-                pkt_info->dst_port_out[packet_idx] = BYTE_SWAP16(hdr_udp->l4_hdr.dst_port);
-                // frame type
-                pkt_info->ether_type_out[packet_idx] = static_cast<int32_t> (hdr_udp->l2_hdr.ether_type);
-                // protocol id
-                pkt_info->next_proto_id_out[packet_idx] = static_cast<int32_t> (hdr_udp->l3_hdr.next_proto_id);
+            // Not an IP packet when the headers can't be parsed, the flow pipe should not have forwarded it
+            if (parse_headers(_buf_addrs[i], &hdrs) && filter_packet(hdrs, is_tcp, filter)) {
+                uint8_t *payload;
+                _packet_flags[i] = 1;
+                _payload_sizes[i] = payload_extent(_buf_addrs[i], MAX_PKT_SIZE, hdrs, is_tcp, &payload);
             }
-
-            auto now = cuda::std::chrono::system_clock::now();
-            auto now_ms = cuda::std::chrono::time_point_cast<cuda::std::chrono::milliseconds>(now);
-            auto epoch = now_ms.time_since_epoch();
-            pkt_info->timestamp_out[packet_idx] = epoch.count();
         }
 
-        // if (threadIdx.x == 0) DEVICE_GET_TIME(reduce_start);
-        auto payload_size_total = BlockReduce(temp_storage).Sum(_payload_sizes);
+        int32_t packet_count;
+        BlockScan(temp_storage).ExclusiveSum(_packet_flags, _packet_slots, packet_count);
+        __syncthreads();
+
+        // Everything was filtered out, the slot stays free and is filled on the next pass
+        if (packet_count == 0)
+            continue;
+
+        // The payloads of the kept packets are packed in slot order, the offsets being those of the strings column
+        int32_t payload_size_total;
+        BlockScan(temp_storage).ExclusiveSum(_payload_sizes, _payload_offsets, payload_size_total);
         __syncthreads();
-        auto packet_count = BlockReduce(temp_storage).Sum(_payload_flags);
+
+        auto now = cuda::std::chrono::system_clock::now();
+        auto now_ms = cuda::std::chrono::time_point_cast<cuda::std::chrono::milliseconds>(now);
+        auto epoch = now_ms.time_since_epoch();
+
+        // The headers are parsed again rather than kept in registers for every packet of the thread
+        for (auto i = 0; i < PACKETS_PER_THREAD; i++) {
+            if (_packet_flags[i] == 0)
+                continue;
+
+            process_packet(
+                _buf_addrs[i], MAX_PKT_SIZE, _packet_slots[i], _payload_offsets[i], is_tcp, epoch.count(), pkt_info);
+        }
         __syncthreads();
-        // if (threadIdx.x == 0) DEVICE_GET_TIME(reduce_stop);
 
         if (threadIdx.x == 0) {
-            // DEVICE_GET_TIME(pkt_proc);
+            pkt_info->payload_offsets_out[packet_count] = payload_size_total;
             DOCA_GPUNETIO_VOLATILE(pkt_info->packet_count_out) = packet_count;
             DOCA_GPUNETIO_VOLATILE(pkt_info->payload_size_total_out) = payload_size_total;
-            // printf("Block %d Update semaphore %d with %d packets %d size\n",
-            //   blockIdx.x,
-            //   sem_idx, DOCA_GPUNETIO_VOLATILE(pkt_info->packet_count_out), DOCA_GPUNETIO_VOLATILE(pkt_info->payload_size_total_out));
+            // Make the packets visible to the CPU before handing over the slot
+            __threadfence_system();
             doca_ret = doca_gpu_dev_semaphore_set_status(sem, sem_idx, DOCA_GPU_SEMAPHORE_STATUS_READY);
             if (doca_ret != DOCA_SUCCESS) {
                 printf("Error %d doca_gpu_dev_semaphore_set_status\n", doca_ret);
                 DOCA_GPUNETIO_VOLATILE(*exit_condition) = 1;
-                // break;
             }
-
-            // printf("CUDA rx time %ld proc time %ld pkt conv %ld block reduce %ld\n",
-            //         rx_stop - rx_start,
-            //         pkt_proc - rx_stop,
-            //         reduce_start - rx_stop,
-            //         reduce_stop - reduce_start);
         }
         __syncthreads();
 
-#if RUN_PERSISTENT
-        // sem_idx = (sem_idx+1)%MAX_SEM_X_QUEUE;
-
-        // Get packets' info from next semaphore
-        // if (threadIdx.x == 0) {
-            // do {
-            //     doca_ret = doca_gpu_dev_semaphore_get_status(sem, sem_idx, &sem_status);
-            //     if (doca_ret != DOCA_SUCCESS) {
-            //         printf("Error %d doca_gpu_dev_semaphore_get_status\n", doca_ret);
-            //         DOCA_GPUNETIO_VOLATILE(*exit_condition) = 1;
-            //         break;
-            //     }
-
-            //     if (sem_status == DOCA_GPU_SEMAPHORE_STATUS_FREE) {
-            //         doca_ret = doca_gpu_dev_semaphore_get_custom_info_addr(sem, sem_idx, (void **)&pkt_info);
-            //         if (doca_ret != DOCA_SUCCESS) {
-            //             printf("Error %d doca_gpu_dev_semaphore_get_custom_info_addr\n", doca_ret);
-            //             DOCA_GPUNETIO_VOLATILE(*exit_condition) = 1;
-            //         }
-
-            //         DOCA_GPUNETIO_VOLATILE(pkt_info->packet_count_out) = 0;
-            //         DOCA_GPUNETIO_VOLATILE(pkt_info->payload_size_total_out) = 0;
-            //         DOCA_GPUNETIO_VOLATILE(packet_count_received) = 0;
-
-            //         break;
-            //     }
-            // } while (DOCA_GPUNETIO_VOLATILE(*exit_condition) == 0);
-          // }
-        // __syncthreads();
-    // } while (DOCA_GPUNETIO_VOLATILE(*exit_condition) == 0)
-
-  if (threadIdx.x == 0)
-    doca_gpu_dev_sem_set_status(sem_in, *sem_idx, DOCA_GPU_SEMAPHORE_STATUS_FREE);
-  // __threadfence();
-  // __syncthreads();
-#endif
+        sem_idx = (sem_idx + 1) % MAX_SEM_X_QUEUE;
+    }
 }
 
-__global__ void _packet_gather_kernel(
-  int32_t  packet_count,
-  char*    payload_buffer,
-  int32_t* payload_sizes,
-  char*    payload_chars_out
+__global__ void _packet_payload_size_kernel(
+    const uint8_t *frames,
+    const uint32_t *frame_offsets,
+    const uint32_t *frame_lengths,
+    const int32_t packet_count,
+    const bool is_tcp,
+    int32_t *payload_sizes_out
 )
 {
-  // Specialize BlockScan for a 1D block of 128 threads of type int
-  using BlockScan = cub::BlockScan<int32_t, THREADS_PER_BLOCK>;
-
-  // Allocate shared memory for BlockScan
-  __shared__ typename BlockScan::TempStorage temp_storage;
-
-  int32_t payload_capture[PACKETS_PER_THREAD];
-  int32_t payload_offsets[PACKETS_PER_THREAD];
-
-  for (auto i = 0; i < PACKETS_PER_THREAD; i++)
-  {
-    auto packet_idx = threadIdx.x * PACKETS_PER_THREAD + i;
+    auto packet_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
     if (packet_idx >= packet_count) {
-      payload_capture[i] = 0;
-      payload_offsets[i] = 0;
-    } else {
-      payload_capture[i] = 1;
-      payload_offsets[i] = payload_sizes[packet_idx];
+        return;
     }
-  }
-
-  __syncthreads();
 
-  int32_t data_offsets_agg;
-  BlockScan(temp_storage).ExclusiveSum(payload_offsets, payload_offsets, data_offsets_agg);
-
-  __syncthreads();
-
-  int32_t data_capture_agg;
-  BlockScan(temp_storage).ExclusiveSum(payload_capture, payload_capture, data_capture_agg);
+    struct packet_headers hdrs;
+    uint8_t *payload;
+    auto buf_addr = reinterpret_cast<uintptr_t>(frames + frame_offsets[packet_idx]);
 
-  __syncthreads();
+    // Frames are filtered before being staged, but keep the payload column consistent regardless
+    payload_sizes_out[packet_idx] = parse_headers(buf_addr, &hdrs)
+        ? payload_extent(buf_addr, static_cast<int32_t>(frame_lengths[packet_idx]), hdrs, is_tcp, &payload)
+        : 0;
+}
 
-  for (auto i = 0; i < PACKETS_PER_THREAD; i++)
-  {
-    auto packet_idx = threadIdx.x * PACKETS_PER_THREAD + i;
+__global__ void _packet_replay_kernel(
+    const uint8_t *frames,
+    const uint32_t *frame_offsets,
+    const uint32_t *frame_lengths,
+    const uint32_t *timestamps,
+    const int32_t packet_count,
+    const bool is_tcp,
+    struct packets_info info
+)
+{
+    auto packet_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
     if (packet_idx >= packet_count) {
-      continue;
+        return;
     }
 
-    auto payload_size = payload_sizes[packet_idx];
-
-    for (auto j = 0; j < payload_size; j++)
-    {
-      auto value = payload_buffer[packet_idx * MAX_PKT_SIZE + j];
-
-      auto payload_chars_out_idx = payload_offsets[i] + j;
-
-      if (payload_chars_out_idx) {
-        payload_chars_out[payload_chars_out_idx] = value;
-      }
-    }
-  }
+    process_packet(reinterpret_cast<uintptr_t>(frames + frame_offsets[packet_idx]),
+                   static_cast<int32_t>(frame_lengths[packet_idx]),
+                   packet_idx,
+                   info.payload_offsets_out[packet_idx],
+                   is_tcp,
+                   timestamps[packet_idx],
+                   &info);
 }
 
 namespace morpheus {
@@ -588,6 +827,85 @@ std::unique_ptr<cudf::column> integers_to_mac(
     {});
 }
 
+namespace {
+
+struct ip_address_size_fn {
+  __int128_t const* d_addresses;
+
+  __device__ int32_t operator()(cudf::size_type idx) const
+  {
+    auto address = static_cast<unsigned __int128>(d_addresses[idx]);
+    return format_ip_address(static_cast<uint64_t>(address), static_cast<uint64_t>(address >> 64), nullptr);
+  }
+};
+
+struct ip_address_to_chars_fn {
+  __int128_t const* d_addresses;
+  int32_t const* d_offsets;
+  char* d_chars;
+
+  __device__ void operator()(cudf::size_type idx)
+  {
+    auto address = static_cast<unsigned __int128>(d_addresses[idx]);
+    format_ip_address(
+      static_cast<uint64_t>(address), static_cast<uint64_t>(address >> 64), d_chars + d_offsets[idx]);
+  }
+};
+
+}
+
+std::unique_ptr<cudf::column> ip_addresses_to_strings(
+  cudf::column_view const& addresses,
+  rmm::cuda_stream_view stream,
+  rmm::mr::device_memory_resource* mr
+)
+{
+  CUDF_EXPECTS(addresses.type().id() == cudf::type_id::DECIMAL128, "Input column must be type_id::DECIMAL128 type");
+  CUDF_EXPECTS(addresses.null_count() == 0, "ip_addresses_to_strings does not support null values.");
+
+  cudf::size_type strings_count = addresses.size();
+
+  if (strings_count == 0)
+  {
+    return cudf::make_empty_column(cudf::type_id::STRING);
+  }
+
+  auto d_addresses = addresses.data<__int128_t>();
+
+  rmm::device_uvector<int32_t> sizes(strings_count, stream);
+  thrust::transform(
+    rmm::exec_policy(stream),
+    thrust::make_counting_iterator<cudf::size_type>(0),
+    thrust::make_counting_iterator<cudf::size_type>(strings_count),
+    sizes.begin(),
+    ip_address_size_fn{d_addresses}
+  );
+
+  auto [offsets_column, bytes] = cudf::detail::make_offsets_child_column(
+    sizes.begin(),
+    sizes.end(),
+    stream,
+    mr
+  );
+
+  auto d_offsets    = offsets_column->view().data<int32_t>();
+  auto chars_column = cudf::strings::detail::create_chars_child_column(bytes, stream, mr);
+  auto d_chars      = chars_column->mutable_view().data<char>();
+
+  thrust::for_each_n(
+    rmm::exec_policy(stream),
+    thrust::make_counting_iterator<cudf::size_type>(0),
+    strings_count,
+    ip_address_to_chars_fn{d_addresses, d_offsets, d_chars}
+  );
+
+  return cudf::make_strings_column(strings_count,
+    std::move(offsets_column),
+    std::move(chars_column),
+    0,
+    {});
+}
+
 void cuda_memory_test1()
 {
     const unsigned int N = 10485760;
@@ -621,46 +939,55 @@ void cuda_memory_test2()
 }
 
 void packet_receive_kernel(
-  doca_gpu_eth_rxq*       rxq,
-  doca_gpu_semaphore_gpu* sem,
-  uint16_t sem_idx,
-  bool is_tcp,
+  packet_receive_queues const& queues,
+  uint32_t                num_queues,
+  bool                    is_tcp,
+  packet_filter const&    filter,
   uint32_t*               exit_condition,
   cudaStream_t            stream
 )
 {
-  _packet_receive_kernel<<<1, THREADS_PER_BLOCK, 0, stream>>>(rxq, sem, sem_idx, is_tcp, exit_condition);
+  // One block per queue, the kernel runs until the exit condition is set
+  _packet_receive_kernel<<<num_queues, THREADS_PER_BLOCK, 0, stream>>>(queues, is_tcp, filter, exit_condition);
 }
 
-std::unique_ptr<cudf::column> gather_payload(
-  int32_t      packet_count,
-  char*        payload_buffer,
-  int32_t*     payload_sizes,
-  rmm::cuda_stream_view stream,
-  rmm::mr::device_memory_resource* mr)
+void packet_replay_kernel(
+  uint8_t const*          frames,
+  uint32_t const*         frame_offsets,
+  uint32_t const*         frame_lengths,
+  uint32_t const*         timestamps,
+  int32_t                 packet_count,
+  bool                    is_tcp,
+  packets_info const&     info,
+  cudaStream_t            stream
+)
 {
-  auto [offsets_column, bytes] = cudf::detail::make_offsets_child_column(
-    payload_sizes,
-    payload_sizes + packet_count,
-    stream,
-    mr
-  );
+  auto num_blocks = (packet_count + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
 
-  auto chars_column = cudf::strings::detail::create_chars_child_column(bytes, stream, mr);
-  auto d_chars      = chars_column->mutable_view().data<char>();
-
-  _packet_gather_kernel<<<1, THREADS_PER_BLOCK, 0, stream>>>(
+  // Size the payloads first so each packet knows where to write its payload in the packed buffer
+  _packet_payload_size_kernel<<<num_blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    frames,
+    frame_offsets,
+    frame_lengths,
     packet_count,
-    payload_buffer,
-    payload_sizes,
-    d_chars
+    is_tcp,
+    info.payload_offsets_out + 1
+  );
+  CUDA_TRY(cudaMemsetAsync(info.payload_offsets_out, 0, sizeof(int32_t), stream));
+  thrust::inclusive_scan(rmm::exec_policy(stream),
+                         info.payload_offsets_out + 1,
+                         info.payload_offsets_out + 1 + packet_count,
+                         info.payload_offsets_out + 1);
+
+  _packet_replay_kernel<<<num_blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    frames,
+    frame_offsets,
+    frame_lengths,
+    timestamps,
+    packet_count,
+    is_tcp,
+    info
   );
-
-  return cudf::make_strings_column(packet_count,
-    std::move(offsets_column),
-    std::move(chars_column),
-    0,
-    {});
 }
 
 }
@@ -0,0 +1,162 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/doca/doca_stream_reassembly.hpp"
+
+#include "morpheus/doca/doca_stream_table.hpp"
+#include "morpheus/objects/table_info.hpp"
+#include "morpheus/utilities/string_util.hpp"
+
+#include <cudf/io/types.hpp>
+#include <glog/logging.h>
+#include <rmm/cuda_stream.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+
+namespace {
+cudf::column_view get_packet_column(const TableInfo& info,
+                                    const std::vector<std::string>& column_names,
+                                    const std::string& name)
+{
+    auto found = std::find(column_names.begin(), column_names.end(), name);
+
+    if (found == column_names.end())
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Packet column '" << name << "' not found"));
+    }
+
+    return info.get_column(static_cast<cudf::size_type>(found - column_names.begin()));
+}
+
+std::shared_ptr<MessageMeta> make_stream_chunks(std::unique_ptr<cudf::table>&& table)
+{
+    cudf::io::table_metadata metadata;
+
+    for (const auto& name : doca::StreamTable::column_names())
+    {
+        metadata.schema_info.emplace_back(name);
+    }
+
+    return MessageMeta::create_from_cpp(cudf::io::table_with_metadata{std::move(table), std::move(metadata)}, 0);
+}
+}  // namespace
+
+DocaStreamReassemblyStage::DocaStreamReassemblyStage(std::size_t max_streams,
+                                                     std::size_t max_buffered_bytes,
+                                                     std::chrono::milliseconds idle_timeout,
+                                                     std::chrono::milliseconds gap_timeout) :
+  PythonNode(base_t::op_factory_from_sub_fn(build_operator())),
+  m_max_streams(max_streams),
+  m_max_buffered_bytes(max_buffered_bytes),
+  m_idle_timeout(idle_timeout),
+  m_gap_timeout(gap_timeout)
+{
+    if (m_max_streams == 0 || m_max_buffered_bytes == 0)
+    {
+        throw std::invalid_argument("max_streams and max_buffered_bytes must be greater than 0");
+    }
+
+    if (m_idle_timeout.count() <= 0 || m_gap_timeout.count() <= 0)
+    {
+        throw std::invalid_argument("idle_timeout and gap_timeout must be greater than 0");
+    }
+}
+
+DocaStreamReassemblyStage::subscribe_fn_t DocaStreamReassemblyStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        rmm::cuda_stream stream;
+        doca::StreamTable stream_table(
+            m_max_streams, m_max_buffered_bytes, m_idle_timeout, m_gap_timeout, stream.view());
+
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [&](sink_type_t msg) {
+                std::unique_ptr<cudf::table> chunks;
+
+                {
+                    auto info         = msg->get_info();
+                    auto column_names = info.get_column_names();
+
+                    doca::StreamPacketColumns packets{get_packet_column(info, column_names, "src_ip6"),
+                                                      get_packet_column(info, column_names, "dst_ip6"),
+                                                      get_packet_column(info, column_names, "src_port"),
+                                                      get_packet_column(info, column_names, "dst_port"),
+                                                      get_packet_column(info, column_names, "next_proto"),
+                                                      get_packet_column(info, column_names, "tcp_flags"),
+                                                      get_packet_column(info, column_names, "tcp_seq"),
+                                                      get_packet_column(info, column_names, "timestamp"),
+                                                      get_packet_column(info, column_names, "data")};
+
+                    chunks = stream_table.update(packets, stream.view());
+                }
+
+                if (chunks)
+                {
+                    output.on_next(make_stream_chunks(std::move(chunks)));
+                }
+            },
+            [&](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&]() {
+                if (auto remaining = stream_table.flush(stream.view()); remaining)
+                {
+                    output.on_next(make_stream_chunks(std::move(remaining)));
+                }
+
+                if (auto num_dropped = stream_table.num_dropped_segments(); num_dropped > 0)
+                {
+                    LOG(WARNING) << "DocaStreamReassemblyStage dropped " << num_dropped
+                                 << " segments of new streams while the stream table was full, consider increasing "
+                                    "max_streams";
+                }
+
+                if (auto num_gaps = stream_table.num_skipped_gaps(); num_gaps > 0)
+                {
+                    LOG(WARNING) << "DocaStreamReassemblyStage skipped " << num_gaps
+                                 << " gaps in reassembled streams, consider increasing gap_timeout or "
+                                    "max_buffered_bytes";
+                }
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ DocaStreamReassemblyStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<DocaStreamReassemblyStage>> DocaStreamReassemblyStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    std::string const& name,
+    std::size_t max_streams,
+    std::size_t max_buffered_bytes,
+    double idle_timeout,
+    double gap_timeout)
+{
+    auto to_ms = [](double seconds) {
+        return std::chrono::milliseconds(static_cast<int64_t>(seconds * 1000));
+    };
+
+    return builder.construct_object<DocaStreamReassemblyStage>(
+        name, max_streams, max_buffered_bytes, to_ms(idle_timeout), to_ms(gap_timeout));
+}
+
+}  // namespace morpheus
@@ -0,0 +1,1049 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/doca/doca_stream_table.hpp"
+
+#include "morpheus/doca/flow_key.cuh"
+#include "morpheus/utilities/error.hpp"
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>
+#include <cudf/strings/detail/strings_children.cuh>
+#include <cudf/strings/detail/utilities.hpp>
+#include <cudf/strings/strings_column_view.hpp>
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+#include <rmm/mr/device/per_device_resource.hpp>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/transform_reduce.h>
+
+#include <array>
+#include <bit>
+#include <memory>
+#include <utility>
+
+#define TCP_PROTOCOL_ID 0x6
+
+namespace morpheus::doca {
+
+namespace {
+
+using namespace detail;
+
+int32_t const TCP_FIN = 0x01;
+int32_t const TCP_SYN = 0x02;
+int32_t const TCP_RST = 0x04;
+
+uint32_t const STREAM_THREADS    = 256;
+std::size_t const NUM_COUNTERS   = 2;
+std::size_t const COUNTER_ADDED  = 0;
+std::size_t const COUNTER_DROP   = 1;
+int32_t const SEGMENT_DROP       = 0;
+int32_t const SEGMENT_EMIT       = 1;
+int32_t const SEGMENT_PENDING    = 2;
+
+struct segment
+{
+    flow_key key;
+    uint32_t seq;
+    uint32_t timestamp;
+    int32_t flags;
+    int32_t length;
+    char const* payload;
+    bool is_new;  // Received in the current batch rather than held for a gap
+};
+
+struct stream_entry
+{
+    flow_key key;
+    int32_t state;
+    uint32_t next_seq;  // Sequence number of the next byte to reassemble
+    uint32_t last_timestamp;
+    int64_t offset;     // Bytes of the stream reassembled or skipped so far
+};
+
+// Summary of the segments of a single stream in a batch
+struct stream_group
+{
+    uint32_t base_seq;  // Sequence number a new stream starts at, taken from its earliest segment
+    uint32_t first_timestamp;
+    uint32_t last_timestamp;
+    uint32_t num_segments;
+    bool syn;
+    bool any_new;
+    bool opens;         // Holds a SYN or payload, control segments alone never open a stream
+};
+
+struct stream_result
+{
+    uint32_t advance;  // Sequence numbers consumed, including skipped gaps and the FIN
+    int32_t emitted;   // Bytes appended to the chunk
+    bool gap;
+    bool closed;
+};
+
+__device__ __forceinline__ bool seq_before(uint32_t lhs, uint32_t rhs)
+{
+    return static_cast<int32_t>(lhs - rhs) < 0;
+}
+
+struct combine_stream_groups
+{
+    __device__ stream_group operator()(stream_group const& lhs, stream_group const& rhs) const
+    {
+        // Timestamps only have millisecond resolution, on ties the SYN then the lowest sequence number starts a stream
+        bool rhs_first = ts_before(rhs.first_timestamp, lhs.first_timestamp) ||
+                         (rhs.first_timestamp == lhs.first_timestamp &&
+                          ((rhs.syn && !lhs.syn) || (rhs.syn == lhs.syn && seq_before(rhs.base_seq, lhs.base_seq))));
+        auto const& first = rhs_first ? rhs : lhs;
+
+        stream_group out;
+        out.base_seq        = first.base_seq;
+        out.first_timestamp = first.first_timestamp;
+        out.syn             = first.syn;
+        out.last_timestamp  = ts_before(lhs.last_timestamp, rhs.last_timestamp) ? rhs.last_timestamp
+                                                                                : lhs.last_timestamp;
+        out.num_segments = lhs.num_segments + rhs.num_segments;
+        out.any_new      = lhs.any_new || rhs.any_new;
+        out.opens        = lhs.opens || rhs.opens;
+        return out;
+    }
+};
+
+struct make_stream_group
+{
+    segment const* segments;
+    cudf::size_type const* order;
+
+    __device__ stream_group operator()(cudf::size_type pos) const
+    {
+        auto const& s = segments[order[pos]];
+        bool syn      = (s.flags & TCP_SYN) != 0;
+
+        stream_group group;
+        group.base_seq        = syn ? s.seq + 1 : s.seq;
+        group.first_timestamp = s.timestamp;
+        group.last_timestamp  = s.timestamp;
+        group.num_segments    = 1;
+        group.syn             = syn;
+        group.any_new         = s.is_new;
+        group.opens           = syn || s.length > 0;
+        return group;
+    }
+};
+
+// Pure ACKs carry nothing to reassemble
+struct is_tcp_segment
+{
+    int32_t const* next_proto;
+    int32_t const* tcp_flags;
+    cudf::size_type const* offsets;
+
+    __device__ bool operator()(cudf::size_type idx) const
+    {
+        return next_proto[idx] == TCP_PROTOCOL_ID &&
+               (offsets[idx + 1] > offsets[idx] || (tcp_flags[idx] & (TCP_SYN | TCP_FIN | TCP_RST)) != 0);
+    }
+};
+
+struct make_segment
+{
+    make_flow_key make_key;
+    int32_t const* tcp_flags;
+    uint32_t const* tcp_seq;
+    uint32_t const* timestamps;
+    cudf::size_type const* offsets;
+    char const* chars;
+
+    __device__ segment operator()(cudf::size_type idx) const
+    {
+        return segment{make_key(idx),
+                       tcp_seq[idx],
+                       timestamps[idx],
+                       tcp_flags[idx],
+                       offsets[idx + 1] - offsets[idx],
+                       chars + offsets[idx],
+                       true};
+    }
+};
+
+struct segment_key_order
+{
+    segment const* segments;
+
+    __device__ bool operator()(cudf::size_type lhs, cudf::size_type rhs) const
+    {
+        return segments[lhs].key < segments[rhs].key;
+    }
+};
+
+struct segment_key
+{
+    segment const* segments;
+
+    __device__ flow_key operator()(cudf::size_type idx) const
+    {
+        return segments[idx].key;
+    }
+};
+
+struct segment_length
+{
+    segment const* segments;
+    cudf::size_type const* order;
+
+    __device__ int64_t operator()(cudf::size_type pos) const
+    {
+        return segments[order[pos]].length;
+    }
+};
+
+struct is_group_start
+{
+    flow_key const* sorted_keys;
+
+    __device__ cudf::size_type operator()(cudf::size_type pos) const
+    {
+        return (pos > 0 && sorted_keys[pos - 1] == sorted_keys[pos]) ? 0 : 1;
+    }
+};
+
+// Orders the segments of each stream by their sequence number relative to the next byte of the stream, so wrapping
+// sequence numbers and retransmissions of reassembled bytes sort first
+struct make_seq_order
+{
+    segment const* segments;
+    cudf::size_type const* order;
+    cudf::size_type const* group_ids;  // One-based, as produced by an inclusive scan of the group starts
+    uint32_t const* next_seqs;
+
+    __device__ uint64_t operator()(cudf::size_type pos) const
+    {
+        auto group = group_ids[pos] - 1;
+        auto rel   = segments[order[pos]].seq - next_seqs[group];
+        return (static_cast<uint64_t>(group) << 32) | (rel ^ 0x80000000u);
+    }
+};
+
+struct is_held
+{
+    __device__ bool operator()(int32_t status) const
+    {
+        return status == SEGMENT_PENDING;
+    }
+};
+
+/**
+ * @brief Looks up the stream of a group, inserting it when the group opens a new stream. Held segments of a stream
+ * which has since been removed do not re-open it. Each stream appears once per batch, this thread is the only writer
+ * of the entry.
+ */
+__global__ void _merge_streams_kernel(stream_entry* table,
+                                      uint32_t capacity_mask,
+                                      flow_key const* keys,
+                                      stream_group const* groups,
+                                      uint32_t count,
+                                      int32_t* slots,
+                                      uint32_t* next_seqs,
+                                      int64_t* offsets,
+                                      unsigned long long* counters)
+{
+    auto idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= count)
+    {
+        return;
+    }
+
+    auto const& key   = keys[idx];
+    auto const& group = groups[idx];
+    auto slot         = hash_key(key) & capacity_mask;
+    slots[idx]        = -1;
+
+    for (uint32_t probe = 0; probe <= capacity_mask;)
+    {
+        auto& entry = table[slot];
+        auto state  = atomicAdd(&entry.state, 0);
+
+        if (state == SLOT_EMPTY)
+        {
+            if (!group.any_new || !group.opens)
+            {
+                return;
+            }
+
+            if (atomicCAS(&entry.state, SLOT_EMPTY, SLOT_BUSY) == SLOT_EMPTY)
+            {
+                entry.key            = key;
+                entry.next_seq       = group.base_seq;
+                entry.last_timestamp = group.last_timestamp;
+                entry.offset         = 0;
+                __threadfence();
+                atomicExch(&entry.state, SLOT_OCCUPIED);
+                atomicAdd(&counters[COUNTER_ADDED], 1ull);
+
+                slots[idx]     = static_cast<int32_t>(slot);
+                next_seqs[idx] = group.base_seq;
+                offsets[idx]   = 0;
+                return;
+            }
+
+            // Lost the slot to another stream, check it again once that stream has been written
+            continue;
+        }
+
+        if (state == SLOT_BUSY)
+        {
+            continue;
+        }
+
+        if (state == SLOT_OCCUPIED && entry.key == key)
+        {
+            if (ts_before(entry.last_timestamp, group.last_timestamp))
+            {
+                entry.last_timestamp = group.last_timestamp;
+            }
+
+            slots[idx]     = static_cast<int32_t>(slot);
+            next_seqs[idx] = entry.next_seq;
+            offsets[idx]   = entry.offset;
+            return;
+        }
+
+        slot = (slot + 1) & capacity_mask;
+        probe++;
+    }
+
+    if (group.any_new)
+    {
+        atomicAdd(&counters[COUNTER_DROP], static_cast<unsigned long long>(group.num_segments));
+    }
+}
+
+/**
+ * @brief Walks the segments of each stream in sequence order, one thread per stream, deciding which bytes of each
+ * segment are appended to the chunk of the stream and which segments are held for a gap.
+ */
+__global__ void _walk_streams_kernel(segment const* segments,
+                                     cudf::size_type const* order,
+                                     cudf::size_type const* group_starts,
+                                     uint32_t num_groups,
+                                     cudf::size_type num_segments,
+                                     int32_t const* slots,
+                                     uint32_t const* next_seqs,
+                                     uint32_t now,
+                                     uint32_t gap_timeout_ms,
+                                     bool force,
+                                     int32_t* status,
+                                     int32_t* trims,
+                                     int32_t* emit_lengths,
+                                     stream_result* results)
+{
+    auto group = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (group >= num_groups)
+    {
+        return;
+    }
+
+    auto begin = group_starts[group];
+    auto end   = group + 1 < num_groups ? group_starts[group + 1] : num_segments;
+
+    stream_result result{};
+    bool held   = false;
+    int64_t cur = 0;  // Relative to the next sequence number of the stream
+
+    for (auto pos = begin; pos < end; pos++)
+    {
+        auto const& s     = segments[order[pos]];
+        status[pos]       = SEGMENT_DROP;
+        trims[pos]        = 0;
+        emit_lengths[pos] = 0;
+
+        if (slots[group] < 0 || result.closed)
+        {
+            continue;
+        }
+
+        if (held)
+        {
+            status[pos] = SEGMENT_PENDING;
+            continue;
+        }
+
+        int64_t rel = static_cast<int32_t>(s.seq - next_seqs[group]);
+
+        if (rel > cur)
+        {
+            if (!force && ts_elapsed(s.timestamp, now) < gap_timeout_ms)
+            {
+                held        = true;
+                status[pos] = SEGMENT_PENDING;
+                continue;
+            }
+
+            result.gap = true;
+            cur        = rel;
+        }
+
+        // Retransmitted bytes which were already reassembled are trimmed
+        auto trim = cur - rel;
+        if (trim < s.length)
+        {
+            status[pos]       = SEGMENT_EMIT;
+            trims[pos]        = static_cast<int32_t>(trim);
+            emit_lengths[pos] = static_cast<int32_t>(s.length - trim);
+            result.emitted += emit_lengths[pos];
+            cur = rel + s.length;
+        }
+
+        if (rel + s.length >= cur && (s.flags & TCP_FIN) != 0)
+        {
+            cur += 1;
+            result.closed = true;
+        }
+
+        if ((s.flags & TCP_RST) != 0)
+        {
+            result.closed = true;
+        }
+    }
+
+    result.advance = static_cast<uint32_t>(cur);
+    results[group] = result;
+}
+
+__global__ void _apply_streams_kernel(
+    stream_entry* table, int32_t const* slots, stream_result const* results, uint32_t num_groups)
+{
+    auto group = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (group >= num_groups || slots[group] < 0)
+    {
+        return;
+    }
+
+    auto& entry = table[slots[group]];
+    entry.next_seq += results[group].advance;
+    entry.offset += results[group].advance;
+
+    if (results[group].closed)
+    {
+        entry.state = SLOT_EXPIRED;
+    }
+}
+
+__global__ void _copy_chunks_kernel(segment const* segments,
+                                    cudf::size_type const* order,
+                                    cudf::size_type num_segments,
+                                    int32_t const* status,
+                                    int32_t const* trims,
+                                    int32_t const* emit_lengths,
+                                    cudf::size_type const* char_offsets,
+                                    char* chars)
+{
+    auto pos = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (pos >= num_segments || status[pos] != SEGMENT_EMIT)
+    {
+        return;
+    }
+
+    auto const* payload = segments[order[pos]].payload + trims[pos];
+    auto* out           = chars + char_offsets[pos];
+
+    for (int32_t i = 0; i < emit_lengths[pos]; i++)
+    {
+        out[i] = payload[i];
+    }
+}
+
+__global__ void _hold_segments_kernel(segment const* segments,
+                                      cudf::size_type const* order,
+                                      cudf::size_type const* held_positions,
+                                      int64_t const* held_offsets,
+                                      uint32_t num_held,
+                                      segment* held,
+                                      char* held_chars)
+{
+    auto idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= num_held)
+    {
+        return;
+    }
+
+    auto s    = segments[order[held_positions[idx]]];
+    auto* out = held_chars + held_offsets[idx];
+
+    for (int32_t i = 0; i < s.length; i++)
+    {
+        out[i] = s.payload[i];
+    }
+
+    s.payload = out;
+    s.is_new  = false;
+    held[idx] = s;
+}
+
+__global__ void _expire_streams_kernel(stream_entry* table, uint32_t capacity, uint32_t now, uint32_t idle_timeout_ms)
+{
+    auto idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx < capacity && table[idx].state == SLOT_OCCUPIED &&
+        ts_elapsed(table[idx].last_timestamp, now) >= idle_timeout_ms)
+    {
+        table[idx].state = SLOT_EXPIRED;
+    }
+}
+
+__global__ void _rehash_streams_kernel(stream_entry const* old_table,
+                                       uint32_t capacity,
+                                       stream_entry* table,
+                                       unsigned long long* counters)
+{
+    auto idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= capacity || old_table[idx].state != SLOT_OCCUPIED)
+    {
+        return;
+    }
+
+    // Keys are unique, the first empty slot of the probe sequence is claimed
+    auto const& old_entry = old_table[idx];
+    auto slot             = hash_key(old_entry.key) & (capacity - 1);
+
+    while (atomicCAS(&table[slot].state, SLOT_EMPTY, SLOT_OCCUPIED) != SLOT_EMPTY)
+    {
+        slot = (slot + 1) & (capacity - 1);
+    }
+
+    table[slot] = old_entry;
+    atomicAdd(&counters[COUNTER_ADDED], 1ull);
+}
+
+struct chunk_columns
+{
+    __int128_t* src_ip;
+    __int128_t* dst_ip;
+    uint16_t* src_port;
+    uint16_t* dst_port;
+    uint32_t* timestamp;
+    int64_t* stream_offset;
+    bool* gap;
+    bool* fin;
+};
+
+__global__ void _chunk_records_kernel(cudf::size_type const* row_groups,
+                                      cudf::size_type num_rows,
+                                      flow_key const* keys,
+                                      stream_group const* groups,
+                                      int64_t const* offsets,
+                                      stream_result const* results,
+                                      chunk_columns out)
+{
+    auto row = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (row >= num_rows)
+    {
+        return;
+    }
+
+    auto group = row_groups[row];
+    auto key   = keys[group];
+
+    out.src_ip[row]        = key.src_ip;
+    out.dst_ip[row]        = key.dst_ip;
+    out.src_port[row]      = static_cast<uint16_t>(key.ports_proto >> 24);
+    out.dst_port[row]      = static_cast<uint16_t>(key.ports_proto >> 8);
+    out.timestamp[row]     = groups[group].last_timestamp;
+    out.stream_offset[row] = offsets[group];
+    out.gap[row]           = results[group].gap;
+    out.fin[row]           = results[group].closed;
+}
+
+struct advanced_stream
+{
+    int32_t const* slots;
+    stream_result const* results;
+
+    __device__ bool operator()(cudf::size_type group) const
+    {
+        return slots[group] >= 0 && (results[group].emitted > 0 || results[group].gap || results[group].closed);
+    }
+};
+
+struct chunk_size
+{
+    stream_result const* results;
+
+    __device__ cudf::size_type operator()(cudf::size_type group) const
+    {
+        return results[group].emitted;
+    }
+};
+
+struct has_gap
+{
+    __device__ bool operator()(stream_result const& result) const
+    {
+        return result.gap;
+    }
+};
+
+struct held_size
+{
+    segment const* segments;
+    cudf::size_type const* order;
+    int32_t const* status;
+
+    // Control segments are accounted for a byte, bounding the number of held segments as well
+    __device__ int64_t operator()(cudf::size_type pos) const
+    {
+        return status[pos] == SEGMENT_PENDING ? max(segments[order[pos]].length, 1) : 0;
+    }
+};
+
+uint32_t num_blocks(std::size_t count)
+{
+    return static_cast<uint32_t>((count + STREAM_THREADS - 1) / STREAM_THREADS);
+}
+
+}  // namespace
+
+struct StreamTable::segments
+{
+    rmm::device_uvector<segment> items;
+};
+
+StreamTable::StreamTable(std::size_t max_streams,
+                         std::size_t max_buffered_bytes,
+                         std::chrono::milliseconds idle_timeout,
+                         std::chrono::milliseconds gap_timeout,
+                         rmm::cuda_stream_view stream) :
+  m_capacity(std::bit_ceil(std::max<std::size_t>(max_streams, STREAM_THREADS))),
+  m_max_buffered_bytes(max_buffered_bytes),
+  m_idle_timeout_ms(static_cast<uint32_t>(idle_timeout.count())),
+  m_gap_timeout_ms(static_cast<uint32_t>(gap_timeout.count())),
+  m_entries(m_capacity * sizeof(stream_entry), stream),
+  m_counters(NUM_COUNTERS * sizeof(unsigned long long), stream),
+  m_pending(0, stream),
+  m_pending_chars(0, stream)
+{
+    MORPHEUS_EXPECTS(m_capacity <= INT32_MAX, "max_streams must fit in 31 bits");
+
+    CUDA_TRY(cudaMemsetAsync(m_entries.data(), 0, m_entries.size(), stream.value()));
+}
+
+StreamTable::~StreamTable() = default;
+
+std::unique_ptr<cudf::table> StreamTable::update(const StreamPacketColumns& packets, rmm::cuda_stream_view stream)
+{
+    auto num_packets = packets.src_ip.size();
+
+    if (num_packets == 0)
+    {
+        return nullptr;
+    }
+
+    MORPHEUS_EXPECTS(packets.src_ip.type().id() == cudf::type_id::DECIMAL128 &&
+                         packets.dst_ip.type().id() == cudf::type_id::DECIMAL128,
+                     "Stream reassembly requires 128-bit numeric IP address columns");
+
+    auto policy     = rmm::exec_policy(stream);
+    auto payloads   = cudf::strings_column_view(packets.data);
+    auto offsets    = payloads.offsets().data<cudf::size_type>() + payloads.offset();
+    auto timestamps = packets.timestamp.data<uint32_t>();
+
+    rmm::device_uvector<cudf::size_type> selected(num_packets, stream);
+    auto selected_end = thrust::copy_if(policy,
+                                        thrust::make_counting_iterator<cudf::size_type>(0),
+                                        thrust::make_counting_iterator<cudf::size_type>(num_packets),
+                                        selected.begin(),
+                                        is_tcp_segment{packets.next_proto.data<int32_t>(),
+                                                       packets.tcp_flags.data<int32_t>(),
+                                                       offsets});
+    auto num_selected = static_cast<std::size_t>(selected_end - selected.begin());
+
+    // Held segments come first, followed by the segments of this batch
+    segments batch{rmm::device_uvector<segment>(m_num_pending + num_selected, stream)};
+    if (m_num_pending > 0)
+    {
+        CUDA_TRY(cudaMemcpyAsync(batch.items.data(),
+                                 m_pending.data(),
+                                 m_num_pending * sizeof(segment),
+                                 cudaMemcpyDeviceToDevice,
+                                 stream.value()));
+    }
+
+    thrust::transform(policy,
+                      selected.begin(),
+                      selected_end,
+                      batch.items.begin() + m_num_pending,
+                      make_segment{make_flow_key{packets.src_ip.data<__int128_t>(),
+                                                 packets.dst_ip.data<__int128_t>(),
+                                                 packets.src_port.data<uint16_t>(),
+                                                 packets.dst_port.data<uint16_t>(),
+                                                 packets.next_proto.data<int32_t>()},
+                                   packets.tcp_flags.data<int32_t>(),
+                                   packets.tcp_seq.data<uint32_t>(),
+                                   timestamps,
+                                   offsets,
+                                   payloads.chars_begin(stream)});
+
+    // Packet time rather than wall time, gaps and streams expire consistently regardless of how far behind the
+    // pipeline is
+    auto now = thrust::reduce(policy,
+                              timestamps,
+                              timestamps + num_packets,
+                              static_cast<uint32_t>(0),
+                              thrust::maximum<uint32_t>());
+
+    auto chunks = this->reassemble(batch, now, false, stream);
+
+    this->expire(now, stream);
+
+    if (m_num_used > m_capacity / 4 * 3)
+    {
+        this->rebuild(stream);
+    }
+
+    return chunks;
+}
+
+std::unique_ptr<cudf::table> StreamTable::flush(rmm::cuda_stream_view stream)
+{
+    if (m_num_pending == 0)
+    {
+        return nullptr;
+    }
+
+    segments batch{rmm::device_uvector<segment>(m_num_pending, stream)};
+    CUDA_TRY(cudaMemcpyAsync(batch.items.data(),
+                             m_pending.data(),
+                             m_num_pending * sizeof(segment),
+                             cudaMemcpyDeviceToDevice,
+                             stream.value()));
+
+    return this->reassemble(batch, 0, true, stream);
+}
+
+std::size_t StreamTable::num_dropped_segments() const
+{
+    return m_num_dropped;
+}
+
+std::size_t StreamTable::num_skipped_gaps() const
+{
+    return m_num_gaps;
+}
+
+const std::vector<std::string>& StreamTable::column_names()
+{
+    static const std::vector<std::string> names{
+        "src_ip", "dst_ip", "src_port", "dst_port", "timestamp", "stream_offset", "gap", "fin", "data"};
+
+    return names;
+}
+
+std::unique_ptr<cudf::table> StreamTable::reassemble(segments& batch,
+                                                     uint32_t now,
+                                                     bool force,
+                                                     rmm::cuda_stream_view stream)
+{
+    auto num_segments = static_cast<cudf::size_type>(batch.items.size());
+
+    if (num_segments == 0)
+    {
+        return nullptr;
+    }
+
+    auto policy = rmm::exec_policy(stream);
+
+    // Group the segments by stream
+    rmm::device_uvector<cudf::size_type> order(num_segments, stream);
+    thrust::sequence(policy, order.begin(), order.end());
+    thrust::sort(policy, order.begin(), order.end(), segment_key_order{batch.items.data()});
+
+    rmm::device_uvector<flow_key> sorted_keys(num_segments, stream);
+    thrust::transform(policy, order.begin(), order.end(), sorted_keys.begin(), segment_key{batch.items.data()});
+
+    rmm::device_uvector<flow_key> group_keys(num_segments, stream);
+    rmm::device_uvector<stream_group> groups(num_segments, stream);
+    auto [keys_end, groups_end] =
+        thrust::reduce_by_key(policy,
+                              sorted_keys.begin(),
+                              sorted_keys.end(),
+                              thrust::make_transform_iterator(thrust::make_counting_iterator<cudf::size_type>(0),
+                                                              make_stream_group{batch.items.data(), order.data()}),
+                              group_keys.begin(),
+                              groups.begin(),
+                              flow_key_equal{},
+                              combine_stream_groups{});
+    auto num_groups = static_cast<uint32_t>(keys_end - group_keys.begin());
+
+    rmm::device_uvector<int32_t> slots(num_groups, stream);
+    rmm::device_uvector<uint32_t> next_seqs(num_groups, stream);
+    rmm::device_uvector<int64_t> stream_offsets(num_groups, stream);
+
+    auto* counters = static_cast<unsigned long long*>(m_counters.data());
+    CUDA_TRY(cudaMemsetAsync(counters, 0, m_counters.size(), stream.value()));
+
+    _merge_streams_kernel<<<num_blocks(num_groups), STREAM_THREADS, 0, stream.value()>>>(
+        static_cast<stream_entry*>(m_entries.data()),
+        m_capacity - 1,
+        group_keys.data(),
+        groups.data(),
+        num_groups,
+        slots.data(),
+        next_seqs.data(),
+        stream_offsets.data(),
+        counters);
+    CHECK_CUDA(stream);
+
+    // Group of each sorted segment, and the first segment of each group
+    rmm::device_uvector<cudf::size_type> group_ids(num_segments, stream);
+    thrust::transform(policy,
+                      thrust::make_counting_iterator<cudf::size_type>(0),
+                      thrust::make_counting_iterator<cudf::size_type>(num_segments),
+                      group_ids.begin(),
+                      is_group_start{sorted_keys.data()});
+
+    rmm::device_uvector<cudf::size_type> group_starts(num_groups, stream);
+    thrust::copy_if(policy,
+                    thrust::make_counting_iterator<cudf::size_type>(0),
+                    thrust::make_counting_iterator<cudf::size_type>(num_segments),
+                    group_ids.begin(),
+                    group_starts.begin(),
+                    thrust::identity<cudf::size_type>());
+    thrust::inclusive_scan(policy, group_ids.begin(), group_ids.end(), group_ids.begin());
+
+    // Order the segments of each stream by sequence number, the groups keep their positions
+    rmm::device_uvector<uint64_t> seq_order(num_segments, stream);
+    thrust::transform(policy,
+                      thrust::make_counting_iterator<cudf::size_type>(0),
+                      thrust::make_counting_iterator<cudf::size_type>(num_segments),
+                      seq_order.begin(),
+                      make_seq_order{batch.items.data(), order.data(), group_ids.data(), next_seqs.data()});
+    thrust::sort_by_key(policy, seq_order.begin(), seq_order.end(), order.begin());
+
+    rmm::device_uvector<int32_t> status(num_segments, stream);
+    rmm::device_uvector<int32_t> trims(num_segments, stream);
+    rmm::device_uvector<int32_t> emit_lengths(num_segments, stream);
+    rmm::device_uvector<stream_result> results(num_groups, stream);
+
+    auto walk = [&](bool force_gaps) {
+        _walk_streams_kernel<<<num_blocks(num_groups), STREAM_THREADS, 0, stream.value()>>>(batch.items.data(),
+                                                                                            order.data(),
+                                                                                            group_starts.data(),
+                                                                                            num_groups,
+                                                                                            num_segments,
+                                                                                            slots.data(),
+                                                                                            next_seqs.data(),
+                                                                                            now,
+                                                                                            m_gap_timeout_ms,
+                                                                                            force_gaps,
+                                                                                            status.data(),
+                                                                                            trims.data(),
+                                                                                            emit_lengths.data(),
+                                                                                            results.data());
+        CHECK_CUDA(stream);
+
+        return thrust::transform_reduce(policy,
+                                        thrust::make_counting_iterator<cudf::size_type>(0),
+                                        thrust::make_counting_iterator<cudf::size_type>(num_segments),
+                                        held_size{batch.items.data(), order.data(), status.data()},
+                                        int64_t{0},
+                                        thrust::plus<int64_t>());
+    };
+
+    // Walking is side effect free, when too many bytes would be held every gap is skipped instead
+    auto held_bytes = walk(force);
+    if (!force && static_cast<std::size_t>(held_bytes) > m_max_buffered_bytes)
+    {
+        held_bytes = walk(true);
+    }
+
+    _apply_streams_kernel<<<num_blocks(num_groups), STREAM_THREADS, 0, stream.value()>>>(
+        static_cast<stream_entry*>(m_entries.data()), slots.data(), results.data(), num_groups);
+    CHECK_CUDA(stream);
+
+    // Hold the segments waiting for a gap, packing their payloads as the batch buffers are released
+    rmm::device_uvector<cudf::size_type> held_positions(num_segments, stream);
+    auto held_end = thrust::copy_if(policy,
+                                    thrust::make_counting_iterator<cudf::size_type>(0),
+                                    thrust::make_counting_iterator<cudf::size_type>(num_segments),
+                                    status.begin(),
+                                    held_positions.begin(),
+                                    is_held{});
+    auto num_held = static_cast<uint32_t>(held_end - held_positions.begin());
+
+    rmm::device_uvector<int64_t> held_offsets(num_held, stream);
+    thrust::transform_exclusive_scan(policy,
+                                     held_positions.begin(),
+                                     held_end,
+                                     held_offsets.begin(),
+                                     segment_length{batch.items.data(), order.data()},
+                                     int64_t{0},
+                                     thrust::plus<int64_t>());
+
+    // The held bytes account for control segments as well, covering the payloads
+    rmm::device_buffer pending(num_held * sizeof(segment), stream);
+    rmm::device_buffer pending_chars(static_cast<std::size_t>(held_bytes), stream);
+    _hold_segments_kernel<<<num_blocks(num_held), STREAM_THREADS, 0, stream.value()>>>(
+        batch.items.data(),
+        order.data(),
+        held_positions.data(),
+        held_offsets.data(),
+        num_held,
+        static_cast<segment*>(pending.data()),
+        static_cast<char*>(pending_chars.data()));
+    CHECK_CUDA(stream);
+
+    // A chunk per stream which advanced, the chunks of the streams are contiguous in sequence order so the offset of
+    // each emitted segment in the chars of the column is a scan over all segments
+    rmm::device_uvector<cudf::size_type> row_groups(num_groups, stream);
+    auto rows_end = thrust::copy_if(policy,
+                                    thrust::make_counting_iterator<cudf::size_type>(0),
+                                    thrust::make_counting_iterator<cudf::size_type>(num_groups),
+                                    row_groups.begin(),
+                                    advanced_stream{slots.data(), results.data()});
+    auto num_rows = static_cast<cudf::size_type>(rows_end - row_groups.begin());
+
+    std::array<unsigned long long, NUM_COUNTERS> host_counters{};
+    CUDA_TRY(cudaMemcpyAsync(
+        host_counters.data(), counters, m_counters.size(), cudaMemcpyDeviceToHost, stream.value()));
+
+    auto num_gaps = thrust::count_if(policy, results.begin(), results.end(), has_gap{});
+    stream.synchronize();
+
+    m_num_used += host_counters[COUNTER_ADDED];
+    m_num_dropped += host_counters[COUNTER_DROP];
+    m_num_gaps += num_gaps;
+
+    // The batch still references the previous held payloads, they are released once the chunks have been copied
+    auto previous_chars = std::exchange(m_pending_chars, std::move(pending_chars));
+    m_pending           = std::move(pending);
+    m_num_pending       = num_held;
+
+    if (num_rows == 0)
+    {
+        return nullptr;
+    }
+
+    rmm::device_uvector<cudf::size_type> row_sizes(num_rows, stream);
+    thrust::transform(policy, row_groups.begin(), rows_end, row_sizes.begin(), chunk_size{results.data()});
+
+    auto* mr = rmm::mr::get_current_device_resource();
+    auto [offsets_column, bytes] =
+        cudf::detail::make_offsets_child_column(row_sizes.begin(), row_sizes.end(), stream, mr);
+    auto chars_column = cudf::strings::detail::create_chars_child_column(bytes, stream, mr);
+
+    rmm::device_uvector<cudf::size_type> char_offsets(num_segments, stream);
+    thrust::exclusive_scan(policy, emit_lengths.begin(), emit_lengths.end(), char_offsets.begin());
+
+    _copy_chunks_kernel<<<num_blocks(num_segments), STREAM_THREADS, 0, stream.value()>>>(
+        batch.items.data(),
+        order.data(),
+        num_segments,
+        status.data(),
+        trims.data(),
+        emit_lengths.data(),
+        char_offsets.data(),
+        chars_column->mutable_view().data<char>());
+    CHECK_CUDA(stream);
+
+    rmm::device_uvector<__int128_t> src_ip(num_rows, stream);
+    rmm::device_uvector<__int128_t> dst_ip(num_rows, stream);
+    rmm::device_uvector<uint16_t> src_port(num_rows, stream);
+    rmm::device_uvector<uint16_t> dst_port(num_rows, stream);
+    rmm::device_uvector<uint32_t> timestamp(num_rows, stream);
+    rmm::device_uvector<int64_t> stream_offset(num_rows, stream);
+    rmm::device_uvector<bool> gap(num_rows, stream);
+    rmm::device_uvector<bool> fin(num_rows, stream);
+
+    chunk_columns out{src_ip.data(),
+                      dst_ip.data(),
+                      src_port.data(),
+                      dst_port.data(),
+                      timestamp.data(),
+                      stream_offset.data(),
+                      gap.data(),
+                      fin.data()};
+
+    _chunk_records_kernel<<<num_blocks(num_rows), STREAM_THREADS, 0, stream.value()>>>(
+        row_groups.data(), num_rows, group_keys.data(), groups.data(), stream_offsets.data(), results.data(), out);
+    CHECK_CUDA(stream);
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    columns.reserve(column_names().size());
+    columns.emplace_back(make_address_column(std::move(src_ip)));
+    columns.emplace_back(make_address_column(std::move(dst_ip)));
+    columns.emplace_back(make_column(std::move(src_port)));
+    columns.emplace_back(make_column(std::move(dst_port)));
+    columns.emplace_back(make_column(std::move(timestamp)));
+    columns.emplace_back(make_column(std::move(stream_offset)));
+    columns.emplace_back(make_column(std::move(gap)));
+    columns.emplace_back(make_column(std::move(fin)));
+    columns.emplace_back(
+        cudf::make_strings_column(num_rows, std::move(offsets_column), std::move(chars_column), 0, {}));
+
+    return std::make_unique<cudf::table>(std::move(columns));
+}
+
+void StreamTable::expire(uint32_t now, rmm::cuda_stream_view stream)
+{
+    _expire_streams_kernel<<<num_blocks(m_capacity), STREAM_THREADS, 0, stream.value()>>>(
+        static_cast<stream_entry*>(m_entries.data()), m_capacity, now, m_idle_timeout_ms);
+    CHECK_CUDA(stream);
+}
+
+void StreamTable::rebuild(rmm::cuda_stream_view stream)
+{
+    // Re-inserting the live streams into a fresh table drops the tombstones left behind by removed streams
+    rmm::device_buffer entries(m_entries.size(), stream);
+    CUDA_TRY(cudaMemsetAsync(entries.data(), 0, entries.size(), stream.value()));
+
+    auto* counters = static_cast<unsigned long long*>(m_counters.data());
+    CUDA_TRY(cudaMemsetAsync(counters, 0, m_counters.size(), stream.value()));
+
+    _rehash_streams_kernel<<<num_blocks(m_capacity), STREAM_THREADS, 0, stream.value()>>>(
+        static_cast<stream_entry const*>(m_entries.data()),
+        m_capacity,
+        static_cast<stream_entry*>(entries.data()),
+        counters);
+    CHECK_CUDA(stream);
+
+    unsigned long long num_added = 0;
+    CUDA_TRY(cudaMemcpyAsync(
+        &num_added, counters + COUNTER_ADDED, sizeof(num_added), cudaMemcpyDeviceToHost, stream.value()));
+    stream.synchronize();
+
+    m_entries  = std::move(entries);
+    m_num_used = num_added;
+}
+
+}  // namespace morpheus::doca
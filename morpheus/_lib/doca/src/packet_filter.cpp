@@ -0,0 +1,253 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/doca/packet_filter.hpp"
+
+#include "morpheus/utilities/string_util.hpp"
+
+#include <arpa/inet.h>
+
+#include <algorithm>  // for all_of
+#include <cstddef>
+#include <stdexcept>
+
+namespace {
+
+uint64_t load_be64(uint8_t const* bytes)
+{
+    uint64_t value = 0;
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+/**
+ * @brief Parses a decimal number of at most `max_value`. Unlike `std::stoul` alone, leading whitespace and signs are
+ * rejected, "-1" would otherwise wrap around to a valid value.
+ */
+bool parse_decimal(std::string const& text, unsigned long max_value, unsigned long& value)
+{
+    auto is_digit = [](char c) {
+        return c >= '0' && c <= '9';
+    };
+
+    if (text.empty() || !std::all_of(text.begin(), text.end(), is_digit))
+    {
+        return false;
+    }
+
+    try
+    {
+        value = std::stoul(text);
+    } catch (std::out_of_range const&)
+    {
+        return false;
+    }
+
+    return value <= max_value;
+}
+
+uint16_t parse_port(std::string const& port, std::string const& rule)
+{
+    unsigned long value = 0;
+
+    if (!parse_decimal(port, 0xFFFF, value))
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Invalid port in filter rule '" << rule << "'"));
+    }
+
+    return static_cast<uint16_t>(value);
+}
+
+}  // namespace
+
+namespace morpheus::doca {
+
+port_range parse_port_range(std::string const& ports)
+{
+    auto separator = ports.find('-');
+    if (separator == std::string::npos)
+    {
+        auto port = parse_port(ports, ports);
+        return {port, port};
+    }
+
+    port_range range{parse_port(ports.substr(0, separator), ports), parse_port(ports.substr(separator + 1), ports)};
+    if (range.first > range.last)
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Inverted port range in filter rule '" << ports << "'"));
+    }
+
+    return range;
+}
+
+ip_prefix parse_ip_prefix(std::string const& network)
+{
+    auto separator = network.find('/');
+    auto address   = network.substr(0, separator);
+
+    // Addresses are parsed into IPv6 byte order, IPv4 addresses being mapped into ::ffff:0:0/96
+    uint8_t bytes[16]{};
+    uint32_t max_length;
+    uint32_t mapped_bits;
+    if (inet_pton(AF_INET, address.c_str(), bytes + 12) == 1)
+    {
+        bytes[10]   = 0xFF;
+        bytes[11]   = 0xFF;
+        max_length  = 32;
+        mapped_bits = 96;
+    }
+    else if (inet_pton(AF_INET6, address.c_str(), bytes) == 1)
+    {
+        max_length  = 128;
+        mapped_bits = 0;
+    }
+    else
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Invalid address in filter rule '" << network << "'"));
+    }
+
+    uint32_t length = max_length;
+    if (separator != std::string::npos)
+    {
+        unsigned long parsed_length = 0;
+
+        if (!parse_decimal(network.substr(separator + 1), max_length, parsed_length))
+        {
+            throw std::invalid_argument(
+                MORPHEUS_CONCAT_STR("Invalid prefix length in filter rule '" << network << "'"));
+        }
+
+        length = static_cast<uint32_t>(parsed_length);
+    }
+
+    uint8_t mask_bytes[16]{};
+    for (uint32_t bit = 0; bit < mapped_bits + length; bit++)
+    {
+        mask_bytes[bit / 8] |= static_cast<uint8_t>(0x80 >> (bit % 8));
+    }
+
+    ip_prefix prefix{};
+    prefix.mask[0]    = load_be64(mask_bytes + 8);
+    prefix.mask[1]    = load_be64(mask_bytes);
+    prefix.address[0] = load_be64(bytes + 8) & prefix.mask[0];
+    prefix.address[1] = load_be64(bytes) & prefix.mask[1];
+
+    return prefix;
+}
+
+packet_filter make_packet_filter(std::vector<std::string> const& src_ports,
+                                 std::vector<std::string> const& dst_ports,
+                                 std::vector<std::string> const& src_networks,
+                                 std::vector<std::string> const& dst_networks,
+                                 int32_t min_payload_size,
+                                 int32_t max_payload_size,
+                                 uint8_t tcp_flags_mask,
+                                 uint8_t tcp_flags_value,
+                                 bool is_tcp)
+{
+    packet_filter filter{};
+
+    auto check_count = [](std::size_t count, uint32_t max_count, char const* rules) {
+        if (count > max_count)
+        {
+            throw std::invalid_argument(
+                MORPHEUS_CONCAT_STR("At most " << max_count << " " << rules << " filter rules are supported"));
+        }
+    };
+
+    check_count(src_ports.size(), MAX_FILTER_PORT_RANGES, "source port");
+    check_count(dst_ports.size(), MAX_FILTER_PORT_RANGES, "destination port");
+    check_count(src_networks.size(), MAX_FILTER_IP_PREFIXES, "source network");
+    check_count(dst_networks.size(), MAX_FILTER_IP_PREFIXES, "destination network");
+
+    for (auto const& ports : src_ports)
+    {
+        filter.src_ports[filter.num_src_port_ranges++] = parse_port_range(ports);
+    }
+
+    for (auto const& ports : dst_ports)
+    {
+        filter.dst_ports[filter.num_dst_port_ranges++] = parse_port_range(ports);
+    }
+
+    for (auto const& network : src_networks)
+    {
+        filter.src_prefixes[filter.num_src_prefixes++] = parse_ip_prefix(network);
+    }
+
+    for (auto const& network : dst_networks)
+    {
+        filter.dst_prefixes[filter.num_dst_prefixes++] = parse_ip_prefix(network);
+    }
+
+    if (min_payload_size < 0)
+    {
+        throw std::invalid_argument("min_payload_size must not be negative");
+    }
+
+    if (max_payload_size >= 0 && max_payload_size < min_payload_size)
+    {
+        throw std::invalid_argument("max_payload_size must not be less than min_payload_size");
+    }
+
+    filter.min_payload_size = min_payload_size;
+    if (max_payload_size >= 0)
+    {
+        filter.max_payload_size = max_payload_size;
+    }
+
+    if ((tcp_flags_value & ~tcp_flags_mask) != 0)
+    {
+        throw std::invalid_argument("tcp_flags_value must only set bits of tcp_flags_mask");
+    }
+
+    if (tcp_flags_mask != 0 && !is_tcp)
+    {
+        throw std::invalid_argument("TCP flag filter rules require tcp traffic");
+    }
+
+    filter.tcp_flags_mask  = tcp_flags_mask;
+    filter.tcp_flags_value = tcp_flags_value;
+
+    return filter;
+}
+
+std::vector<uint16_t> offloadable_dst_ports(packet_filter const& filter)
+{
+    std::vector<uint16_t> ports;
+
+    for (uint32_t idx = 0; idx < filter.num_dst_port_ranges; idx++)
+    {
+        auto const& range = filter.dst_ports[idx];
+        if (ports.size() + (range.last - range.first) + 1 > MAX_OFFLOADED_PORTS)
+        {
+            return {};
+        }
+
+        for (uint32_t port = range.first; port <= range.last; port++)
+        {
+            ports.push_back(static_cast<uint16_t>(port));
+        }
+    }
+
+    return ports;
+}
+
+}  // namespace morpheus::doca
@@ -0,0 +1,336 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/doca/pcap_reader.hpp"
+
+#include "morpheus/utilities/string_util.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+uint32_t const PCAP_MAGIC_US         = 0xA1B2C3D4;
+uint32_t const PCAP_MAGIC_NS         = 0xA1B23C4D;
+std::size_t const PCAP_HEADER_SIZE   = 24;
+std::size_t const PCAP_RECORD_SIZE   = 16;
+uint32_t const PCAPNG_SHB            = 0x0A0D0D0A;
+uint32_t const PCAPNG_IDB            = 0x00000001;
+uint32_t const PCAPNG_SPB            = 0x00000003;
+uint32_t const PCAPNG_EPB            = 0x00000006;
+uint32_t const PCAPNG_BYTE_ORDER     = 0x1A2B3C4D;
+uint16_t const PCAPNG_OPT_TSRESOL    = 9;
+uint32_t const LINKTYPE_ETHERNET     = 1;
+uint64_t const NS_PER_SECOND         = 1000000000ull;
+uint64_t const DEFAULT_TICKS_PER_SEC = 1000000ull;
+
+uint32_t load32(uint8_t const* data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+}  // namespace
+
+namespace morpheus::doca {
+
+PcapReader::PcapReader(std::string const& filename) : m_filename(filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error(
+            MORPHEUS_CONCAT_STR("Unable to open capture '" << filename << "': " << std::strerror(errno)));
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size < 4)
+    {
+        close(fd);
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Capture '" << filename << "' is empty or unreadable"));
+    }
+
+    m_size        = static_cast<std::size_t>(file_stat.st_size);
+    void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error(
+            MORPHEUS_CONCAT_STR("Unable to map capture '" << filename << "': " << std::strerror(errno)));
+    }
+
+    m_data = static_cast<uint8_t const*>(mapping);
+    madvise(mapping, m_size, MADV_SEQUENTIAL);
+
+    try
+    {
+        auto magic = load32(m_data);
+        if (magic == PCAPNG_SHB)
+        {
+            m_is_pcapng = true;
+        }
+        else if (magic == PCAP_MAGIC_US || magic == __builtin_bswap32(PCAP_MAGIC_US))
+        {
+            m_swapped          = magic != PCAP_MAGIC_US;
+            m_ticks_per_second = 1000000ull;
+        }
+        else if (magic == PCAP_MAGIC_NS || magic == __builtin_bswap32(PCAP_MAGIC_NS))
+        {
+            m_swapped          = magic != PCAP_MAGIC_NS;
+            m_ticks_per_second = NS_PER_SECOND;
+        }
+        else
+        {
+            throw std::runtime_error(MORPHEUS_CONCAT_STR("'" << filename << "' is not a pcap or pcapng capture"));
+        }
+
+        if (!m_is_pcapng)
+        {
+            if (m_size < PCAP_HEADER_SIZE)
+            {
+                throw std::runtime_error(MORPHEUS_CONCAT_STR("Capture '" << filename << "' is truncated"));
+            }
+
+            // The upper bits of the link type field hold the FCS length
+            auto link_type = read32(20) & 0xFFFF;
+            if (link_type != LINKTYPE_ETHERNET)
+            {
+                throw std::runtime_error(MORPHEUS_CONCAT_STR("Capture '" << filename << "' has link type " << link_type
+                                                                         << ", only Ethernet is supported"));
+            }
+        }
+    } catch (...)
+    {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+        throw;
+    }
+
+    rewind();
+}
+
+PcapReader::~PcapReader()
+{
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+}
+
+void PcapReader::rewind()
+{
+    m_offset            = m_is_pcapng ? 0 : PCAP_HEADER_SIZE;
+    m_last_timestamp_ns = 0;
+    m_interfaces.clear();
+}
+
+bool PcapReader::next(PcapPacket& packet)
+{
+    return m_is_pcapng ? next_pcapng(packet) : next_pcap(packet);
+}
+
+bool PcapReader::next_pcap(PcapPacket& packet)
+{
+    if (m_offset + PCAP_RECORD_SIZE > m_size)
+    {
+        return false;
+    }
+
+    auto seconds         = read32(m_offset);
+    auto fraction        = read32(m_offset + 4);
+    auto captured_length = read32(m_offset + 8);
+    auto original_length = read32(m_offset + 12);
+
+    auto data_offset = m_offset + PCAP_RECORD_SIZE;
+    if (data_offset + captured_length > m_size)
+    {
+        // A capture which was cut short, typically by stopping the capture while it was being written
+        m_offset = m_size;
+        return false;
+    }
+
+    packet.data            = m_data + data_offset;
+    packet.captured_length = captured_length;
+    packet.original_length = original_length;
+    packet.timestamp_ns    = seconds * NS_PER_SECOND + to_ns(fraction, m_ticks_per_second);
+
+    m_offset = data_offset + captured_length;
+
+    return true;
+}
+
+bool PcapReader::next_pcapng(PcapPacket& packet)
+{
+    while (m_offset + 12 <= m_size)
+    {
+        auto block_type = load32(m_data + m_offset);
+
+        // The byte order of a section is given by its header, the block type itself is a palindrome
+        if (block_type == PCAPNG_SHB)
+        {
+            auto byte_order = load32(m_data + m_offset + 8);
+            if (byte_order != PCAPNG_BYTE_ORDER && byte_order != __builtin_bswap32(PCAPNG_BYTE_ORDER))
+            {
+                throw std::runtime_error(
+                    MORPHEUS_CONCAT_STR("Capture '" << m_filename << "' has an invalid section header"));
+            }
+
+            m_swapped = byte_order != PCAPNG_BYTE_ORDER;
+            m_interfaces.clear();
+        }
+
+        block_type      = read32(m_offset);
+        auto block_size = read32(m_offset + 4);
+
+        if (block_size < 12 || block_size % 4 != 0 || m_offset + block_size > m_size)
+        {
+            // A capture which was cut short, or a corrupt block, neither of which can be recovered from
+            m_offset = m_size;
+            return false;
+        }
+
+        auto block_offset = m_offset;
+        auto block_end    = m_offset + block_size - 4;
+        m_offset += block_size;
+
+        if (block_type == PCAPNG_IDB)
+        {
+            interface_info interface{read16(block_offset + 8), DEFAULT_TICKS_PER_SEC};
+
+            // Options follow the link type, reserved field and snap length, each padded to 32 bits
+            for (auto option = block_offset + 16; option + 4 <= block_end;)
+            {
+                auto code   = read16(option);
+                auto length = read16(option + 2);
+
+                if (code == 0 || option + 4 + length > block_end)
+                {
+                    break;
+                }
+
+                if (code == PCAPNG_OPT_TSRESOL && length >= 1)
+                {
+                    // The high bit selects a power of two rather than a power of ten
+                    auto resolution = m_data[option + 4];
+                    if (resolution & 0x80)
+                    {
+                        interface.ticks_per_second = 1ull << std::min<uint8_t>(resolution & 0x7F, 63);
+                    }
+                    else
+                    {
+                        interface.ticks_per_second = 1;
+                        for (uint8_t i = 0; i < std::min<uint8_t>(resolution, 19); i++)
+                        {
+                            interface.ticks_per_second *= 10;
+                        }
+                    }
+                }
+
+                option += 4 + ((length + 3u) & ~3u);
+            }
+
+            m_interfaces.push_back(interface);
+            continue;
+        }
+
+        uint32_t interface_id;
+        std::size_t data_offset;
+        uint32_t captured_length;
+        uint32_t original_length;
+
+        if (block_type == PCAPNG_EPB && block_size >= 32)
+        {
+            interface_id    = read32(block_offset + 8);
+            auto ticks      = (static_cast<uint64_t>(read32(block_offset + 12)) << 32) | read32(block_offset + 16);
+            captured_length = read32(block_offset + 20);
+            original_length = read32(block_offset + 24);
+            data_offset     = block_offset + 28;
+
+            if (interface_id < m_interfaces.size())
+            {
+                m_last_timestamp_ns = to_ns(ticks, m_interfaces[interface_id].ticks_per_second);
+            }
+        }
+        else if (block_type == PCAPNG_SPB && block_size >= 16)
+        {
+            // Simple packet blocks always belong to the first interface and carry no timestamp
+            interface_id    = 0;
+            original_length = read32(block_offset + 8);
+            data_offset     = block_offset + 12;
+            captured_length = std::min<uint32_t>(original_length, block_end - data_offset);
+        }
+        else
+        {
+            continue;
+        }
+
+        if (interface_id >= m_interfaces.size() || data_offset + captured_length > block_end)
+        {
+            throw std::runtime_error(
+                MORPHEUS_CONCAT_STR("Capture '" << m_filename << "' has a packet block without a matching interface"));
+        }
+
+        if (m_interfaces[interface_id].link_type != LINKTYPE_ETHERNET)
+        {
+            throw std::runtime_error(MORPHEUS_CONCAT_STR("Capture '" << m_filename << "' has link type "
+                                                                     << m_interfaces[interface_id].link_type
+                                                                     << ", only Ethernet is supported"));
+        }
+
+        packet.data            = m_data + data_offset;
+        packet.captured_length = captured_length;
+        packet.original_length = original_length;
+        packet.timestamp_ns    = m_last_timestamp_ns;
+
+        return true;
+    }
+
+    return false;
+}
+
+uint16_t PcapReader::read16(std::size_t offset) const
+{
+    uint16_t value;
+    std::memcpy(&value, m_data + offset, sizeof(value));
+    return m_swapped ? __builtin_bswap16(value) : value;
+}
+
+uint32_t PcapReader::read32(std::size_t offset) const
+{
+    auto value = load32(m_data + offset);
+    return m_swapped ? __builtin_bswap32(value) : value;
+}
+
+uint64_t PcapReader::to_ns(uint64_t ticks, uint64_t ticks_per_second) const
+{
+    if (ticks_per_second <= NS_PER_SECOND && NS_PER_SECOND % ticks_per_second == 0)
+    {
+        return ticks * (NS_PER_SECOND / ticks_per_second);
+    }
+
+    return static_cast<uint64_t>(static_cast<unsigned __int128>(ticks) * NS_PER_SECOND / ticks_per_second);
+}
+
+}  // namespace morpheus::doca
@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>  // for size_t
+#include <deque>
+#include <exception>  // for exception_ptr
+#include <filesystem>
+#include <fstream>
+#include <ios>  // for openmode
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace morpheus {
+#pragma GCC visibility push(default)
+/**
+ * @addtogroup IO
+ * @{
+ * @file
+ */
+
+class GzipDeflater;
+
+/**
+ * @brief Writes host buffers to a sequence of files from a dedicated I/O thread, such that callers only pay for
+ * serialization. Up to `max_queue_depth` buffers are queued, beyond which `write` blocks until the I/O thread catches
+ * up. Errors raised by the I/O thread are rethrown by the next call to `open`, `write` or `close`.
+ *
+ * When `max_queue_depth` is zero buffers are written on the calling thread instead.
+ */
+class AsyncFileWriter
+{
+  public:
+    /**
+     * @brief Construct a new Async File Writer object, nothing is written until the first call to `open`
+     *
+     * @param max_queue_depth : Maximum number of buffers waiting to be written, zero writes on the calling thread
+     * @param gzip : Compress each file as a gzip stream on the I/O thread
+     * @param flush : Flush the file after each buffer is written
+     */
+    AsyncFileWriter(std::size_t max_queue_depth, bool gzip = false, bool flush = false);
+
+    /**
+     * @brief Waits for the queued buffers to be written and closes the current file, errors are logged
+     */
+    ~AsyncFileWriter();
+
+    /**
+     * @brief Closes the current file, once its queued buffers are written, and opens `path`. Subsequent buffers are
+     * written to `path`.
+     *
+     * @param path : File to write to
+     * @param mode : Mode to open the file with, binary is always added
+     */
+    void open(std::filesystem::path path, std::ios::openmode mode = std::ios::out | std::ios::trunc);
+
+    /**
+     * @brief Queues `buffer` to be written to the current file
+     *
+     * @param buffer
+     * @throws std::logic_error If no file was opened
+     */
+    void write(std::string buffer);
+
+    /**
+     * @brief Waits for every queued buffer to be written, then closes the current file and stops the I/O thread
+     */
+    void close();
+
+    /**
+     * @brief Number of bytes given to `write` since the current file was opened, before compression
+     */
+    std::size_t bytes_queued() const;
+
+  private:
+    /**
+     * @brief Either a buffer to write or, when `path` is not empty, a file to open
+     */
+    struct Task
+    {
+        std::filesystem::path path;
+        std::ios::openmode mode{};
+        std::string buffer;
+    };
+
+    void enqueue(Task&& task);
+    void run();
+    void process(Task& task);
+    void close_file();
+    void rethrow_error();
+
+    std::size_t m_max_queue_depth;
+    bool m_gzip;
+    bool m_flush;
+    std::size_t m_bytes_queued{0};
+    bool m_has_file{false};
+
+    // Only used by the I/O thread, or by the calling thread when there is none
+    std::ofstream m_fstream;
+    std::unique_ptr<GzipDeflater> m_deflater;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Task> m_tasks;             // Guarded by `m_mutex`
+    bool m_is_closed{false};              // Guarded by `m_mutex`
+    std::exception_ptr m_error{nullptr};  // Guarded by `m_mutex`
+    std::thread m_thread;
+};
+
+/** @} */  // end of group
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/objects/pinned_host_buffer.hpp"
+
+#include <cstddef>  // for size_t
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace morpheus {
+#pragma GCC visibility push(default)
+/**
+ * @addtogroup IO
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Reads many whole files into a single pinned host buffer, such that they can be parsed by `cudf::io` straight
+ * out of host memory. The reads of every file are submitted at once through an io_uring, keeping up to `queue_depth`
+ * of them in flight on the device instead of paying the latency of each file in turn.
+ *
+ * Falls back to reading the files one after the other when io_uring is not available, either because the library was
+ * built against kernel headers without it or because the running kernel does not allow it.
+ *
+ * @note This object is not thread-safe. Each thread should own its own reader.
+ */
+class BatchFileReader
+{
+  public:
+    /**
+     * @brief Construct a new Batch File Reader object
+     *
+     * @param queue_depth : Maximum number of reads in flight
+     */
+    explicit BatchFileReader(unsigned queue_depth = 64);
+
+    ~BatchFileReader();
+
+    BatchFileReader(const BatchFileReader& other)            = delete;
+    BatchFileReader& operator=(const BatchFileReader& other) = delete;
+
+    /**
+     * @brief Reads each of `filenames` no larger than `max_file_size` into `buffer`, replacing its contents
+     *
+     * @param filenames
+     * @param buffer : Buffer holding the files read, back to back
+     * @param max_file_size : Larger files are skipped, to be read by other means
+     * @return std::vector<std::optional<std::string_view>> : Contents of each file within `buffer`, empty for the
+     * files skipped
+     * @throws std::runtime_error If a file can not be opened or read
+     */
+    std::vector<std::optional<std::string_view>> read(const std::vector<std::string>& filenames,
+                                                      PinnedHostBuffer& buffer,
+                                                      std::size_t max_file_size);
+
+    /**
+     * @brief Whether the reads are submitted through an io_uring
+     */
+    bool uses_io_uring() const;
+
+  private:
+    class Ring;
+
+    std::unique_ptr<Ring> m_ring;
+};
+
+/** @} */  // end of group
+#pragma GCC visibility pop
+}  // namespace morpheus
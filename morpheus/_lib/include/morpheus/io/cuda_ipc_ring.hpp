@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <chrono>   // for milliseconds, seconds
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t, uint64_t
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/**
+ * @addtogroup IO
+ * @{
+ * @file
+ */
+
+/****** Component public implementations *******************/
+/****** CudaIpcBuffer **************************************/
+
+/**
+ * @brief A device buffer pushed to a `CudaIpcRing`, or mapped from one
+ */
+struct MORPHEUS_EXPORT CudaIpcBuffer
+{
+    const void* data{nullptr};
+    std::size_t size{0};
+};
+
+/****** CudaIpcMessage *************************************/
+/**
+ * @brief A message popped from a `CudaIpcRing`. Its buffers point into the device memory of the producer, mapped into
+ * this process, and are valid as long as `owner`, or any copy of it, is alive. The slot of the message is released to
+ * the producer once the last copy of `owner` is destroyed, the producer then freeing the buffers.
+ */
+struct MORPHEUS_EXPORT CudaIpcMessage
+{
+    std::vector<uint8_t> header;
+    std::vector<CudaIpcBuffer> buffers;
+    std::shared_ptr<void> owner;
+};
+
+/****** CudaIpcRing ****************************************/
+/**
+ * @brief Single producer, single consumer queue of messages between two processes sharing a host, each message holding
+ * a small header along with device buffers. The buffers are never copied: the producer exports them through CUDA IPC
+ * memory handles, which the consumer maps into its own address space. Only descriptors of the messages are written to a
+ * POSIX shared memory segment, a fixed ring of `num_slots` slots.
+ *
+ * A slot is reused once the consumer released its message, which bounds the device memory held on behalf of the
+ * consumer, `push` blocking while the ring is full. Buffers allocated from stream ordered memory pools, which cannot be
+ * exported through IPC handles, are first copied into an allocation of their own.
+ */
+class MORPHEUS_EXPORT CudaIpcRing
+{
+  public:
+    using stop_fn_t = std::function<bool()>;
+
+    // Buffers of a single message
+    static constexpr std::size_t MaxBuffers = 64;
+
+    /**
+     * @brief Creates the ring `name` as its producer, replacing a ring of the same name left by a previous producer
+     *
+     * @param name : Name of the shared memory segment, such as `morpheus-scores`
+     * @param num_slots : Messages pushed and not yet released by the consumer
+     * @param max_header_bytes : Size of the largest header
+     * @return std::unique_ptr<CudaIpcRing>
+     * @throws std::runtime_error If the shared memory segment cannot be created
+     */
+    static std::unique_ptr<CudaIpcRing> create(const std::string& name,
+                                               std::size_t num_slots        = 64,
+                                               std::size_t max_header_bytes = 65536);
+
+    /**
+     * @brief Opens the ring `name` as its consumer, waiting up to `timeout` for the producer to create it
+     *
+     * @param name
+     * @param timeout
+     * @param should_stop : Polled while waiting, returns nullptr once it returns true
+     * @return std::unique_ptr<CudaIpcRing>
+     * @throws std::runtime_error If the ring was not created within `timeout`
+     */
+    static std::unique_ptr<CudaIpcRing> open(const std::string& name,
+                                             std::chrono::milliseconds timeout = std::chrono::seconds(60),
+                                             const stop_fn_t& should_stop      = nullptr);
+
+    ~CudaIpcRing();
+
+    CudaIpcRing(const CudaIpcRing&)            = delete;
+    CudaIpcRing& operator=(const CudaIpcRing&) = delete;
+
+    /**
+     * @brief Pushes a message, waiting for a free slot. The buffers must be ready, their work synchronized, and are
+     * kept alive through `owner` until the consumer releases the message.
+     *
+     * @param header
+     * @param buffers : Device buffers of the message, at most `MaxBuffers`
+     * @param owner : Owner of the buffers
+     * @param should_stop : Polled while the ring is full, the push being cancelled once it returns true
+     * @return true : When the message was pushed, false when stopped
+     * @throws std::invalid_argument If the header or the buffers do not fit in a slot
+     */
+    bool push(const std::vector<uint8_t>& header,
+              const std::vector<CudaIpcBuffer>& buffers,
+              std::shared_ptr<void> owner,
+              const stop_fn_t& should_stop = nullptr);
+
+    /**
+     * @brief Ends the stream of the consumer, then waits up to `timeout` for it to release every message
+     *
+     * @return true : When every message was released, the buffers being freed in any case
+     */
+    bool close(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Pops the next message, waiting for the producer to push it
+     *
+     * @param should_stop : Polled while waiting, the pop being cancelled once it returns true
+     * @return std::optional<CudaIpcMessage> : Empty once the producer closed the ring and every message was popped, or
+     * when stopped
+     */
+    std::optional<CudaIpcMessage> pop(const stop_fn_t& should_stop = nullptr);
+
+  private:
+    struct Segment;
+
+    CudaIpcRing(std::shared_ptr<Segment> segment);
+
+    /**
+     * @brief Maps the allocation exported through `handle`, reusing the mapping of a previous message still alive
+     */
+    std::shared_ptr<void> map_allocation(const std::string& handle);
+
+    std::shared_ptr<Segment> m_segment;
+    uint64_t m_sequence{0};
+
+    // Producer side, the buffers of the message of each slot, held until the consumer released it
+    std::vector<std::vector<std::shared_ptr<void>>> m_owners;
+
+    // Consumer side, the allocations mapped by the messages alive, by handle
+    std::mutex m_mappings_mutex;
+    std::map<std::string, std::weak_ptr<void>> m_mappings;
+};
+/** @} */  // end of group
+}  // namespace morpheus
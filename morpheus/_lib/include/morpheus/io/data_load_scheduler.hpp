@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+
+#include <condition_variable>
+#include <cstddef>  // for size_t
+#include <deque>
+#include <exception>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace morpheus {
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Runs the loads of control messages on a pool of `max_concurrent_loads` worker threads, such that a slow load
+ * does not hold back the messages submitted after it.
+ *
+ * Each message is classed by the `loader_id` of its first load task, at most `loader_limits[loader_id]` messages of a
+ * class being loaded at once, the other workers picking messages of other classes meanwhile. Loaded messages are
+ * popped in the order they were submitted when `preserve_order` is set, or only among the messages sharing the value
+ * of the `ordering_key` metadata when one is given, and as soon as they are loaded otherwise.
+ */
+class DataLoadScheduler
+{
+  public:
+    using load_fn_t = std::function<std::shared_ptr<ControlMessage>(std::shared_ptr<ControlMessage>)>;
+
+    /**
+     * @brief Constructor for the DataLoadScheduler class, starting the workers.
+     * @param load_fn Function loading a message, typically `DataLoader::load`, called concurrently by the workers.
+     * @param max_concurrent_loads Number of workers.
+     * @param max_queued_loads Messages submitted and not yet popped, `submit` blocking beyond that.
+     * @param loader_limits Maximum number of messages loaded at once, by loader id. Loaders not listed are only
+     * limited by `max_concurrent_loads`.
+     * @param preserve_order Whether messages are popped in the order they were submitted.
+     * @param ordering_key Name of the metadata whose value scopes the order, the order being global when empty.
+     * @throws std::invalid_argument If `max_concurrent_loads`, `max_queued_loads` or a limit is 0.
+     */
+    DataLoadScheduler(load_fn_t load_fn,
+                      std::size_t max_concurrent_loads,
+                      std::size_t max_queued_loads,
+                      std::map<std::string, std::size_t> loader_limits = {},
+                      bool preserve_order                              = true,
+                      std::string ordering_key                         = "");
+
+    /**
+     * @brief Destructor for the DataLoadScheduler class, cancelling the messages not yet loaded and joining the
+     * workers.
+     */
+    ~DataLoadScheduler();
+
+    DataLoadScheduler(const DataLoadScheduler&)            = delete;
+    DataLoadScheduler& operator=(const DataLoadScheduler&) = delete;
+
+    /**
+     * @brief Queues `message` to be loaded, waiting while `max_queued_loads` messages are queued.
+     * @return true : When the message was queued, false once the scheduler was closed or cancelled.
+     */
+    bool submit(std::shared_ptr<ControlMessage> message);
+
+    /**
+     * @brief Signals that no more messages will be submitted, `pop` returning empty once every queued message was
+     * popped.
+     */
+    void close();
+
+    /**
+     * @brief Drops the messages not yet loaded, and wakes any caller of `submit` or `pop`.
+     */
+    void cancel();
+
+    /**
+     * @brief Pops the next loaded message, waiting for it to be loaded.
+     * @return std::optional<std::shared_ptr<ControlMessage>> : Empty once closed and drained, or once cancelled.
+     * @throws The exception thrown by the load of the message, when the load failed.
+     */
+    std::optional<std::shared_ptr<ControlMessage>> pop();
+
+  private:
+    struct Entry
+    {
+        std::shared_ptr<ControlMessage> message;
+        std::string loader_id;
+        std::string order_key;
+        bool loaded{false};
+        std::exception_ptr error;
+    };
+
+    void work();
+
+    // Whether a message of `loader_id` may be picked, the lock must be held
+    bool has_capacity(const std::string& loader_id) const;
+
+    // Moves the loaded messages at the head of the order of `key` to the ready queue, the lock must be held
+    void release_loaded(const std::string& key);
+
+    load_fn_t m_load_fn;
+    std::size_t m_max_queued_loads;
+    std::map<std::string, std::size_t> m_loader_limits;
+    bool m_preserve_order;
+    std::string m_ordering_key;
+
+    std::mutex m_mutex;
+    std::condition_variable m_work_cv;   // Signaled when a message may be picked by a worker
+    std::condition_variable m_ready_cv;  // Signaled when a message may be popped
+    std::condition_variable m_queue_cv;  // Signaled when a message may be submitted
+    bool m_closed{false};
+    bool m_cancelled{false};
+    std::size_t m_num_queued{0};  // Submitted and not yet popped
+
+    std::list<std::shared_ptr<Entry>> m_pending;                          // Not yet picked, in submission order
+    std::map<std::string, std::size_t> m_active;                          // Messages being loaded, by loader id
+    std::map<std::string, std::deque<std::shared_ptr<Entry>>> m_ordered;  // Not yet released, by ordering key
+    std::deque<std::shared_ptr<Entry>> m_ready;
+
+    std::vector<std::thread> m_workers;
+};
+
+#pragma GCC visibility pop
+}  // namespace morpheus
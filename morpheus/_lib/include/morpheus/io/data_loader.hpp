@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "morpheus/io/data_loader_cache.hpp"
 #include "morpheus/messages/control.hpp"
 #include "morpheus/messages/meta.hpp"
 
@@ -98,7 +99,9 @@ class DataLoader
     DataLoader() = default;
 
     /**
-     * @brief Constructor with config for the DataLoader class.
+     * @brief Constructor with config for the DataLoader class. Payloads of the tasks loading files are cached when
+     * `cache_device_bytes` is greater than 0, see `DataLoaderCache`, least recently used ones being spilled to up to
+     * `cache_host_bytes` of host memory.
      */
     DataLoader(nlohmann::json config);
 
@@ -134,6 +137,7 @@ class DataLoader
   private:
     std::map<std::string, std::shared_ptr<Loader>> m_loaders{};  // Map of registered loader instances.
     nlohmann::json m_config;
+    std::shared_ptr<DataLoaderCache> m_cache;  // Null when caching is disabled.
 };
 
 #pragma GCC visibility pop
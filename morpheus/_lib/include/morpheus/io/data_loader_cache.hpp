@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"
+
+#include <cudf/io/types.hpp>  // for table_metadata
+#include <nlohmann/json.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace morpheus {
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Least recently used cache of the payloads loaded by `DataLoader`, keyed by the task along with the
+ * modification time and size of each of its files.
+ *
+ * Tables are kept in device memory up to `max_device_bytes`. Beyond that, the least recently used ones are spilled to
+ * host memory up to `max_host_bytes`, and evicted once both limits are reached.
+ */
+class DataLoaderCache
+{
+  public:
+    /**
+     * @brief Constructor for the DataLoaderCache class.
+     * @param max_device_bytes Maximum size of the tables held in device memory.
+     * @param max_host_bytes Maximum size of the tables spilled to host memory, 0 evicts tables instead of spilling them.
+     */
+    DataLoaderCache(std::size_t max_device_bytes, std::size_t max_host_bytes = 0);
+
+    /**
+     * @brief Returns the key of `task`, or `std::nullopt` when the task cannot be cached: tasks without a list of
+     * `files`, or whose files cannot be accessed.
+     */
+    static std::optional<std::string> make_key(const nlohmann::json& task);
+
+    /**
+     * @brief Returns the payload cached for `key`, or `nullptr` on a miss. Since payloads are modified in place by
+     * downstream stages, each hit returns its own device copy of the cached table.
+     */
+    std::shared_ptr<MessageMeta> get(const std::string& key);
+
+    /**
+     * @brief Caches a copy of `payload` for `key`, replacing any previous entry. Payloads larger than
+     * `max_device_bytes` are not cached.
+     */
+    void put(const std::string& key, const std::shared_ptr<MessageMeta>& payload);
+
+    /**
+     * @brief Size of the tables currently held in device memory.
+     */
+    std::size_t device_bytes() const;
+
+    /**
+     * @brief Size of the tables currently spilled to host memory.
+     */
+    std::size_t host_bytes() const;
+
+  private:
+    struct Entry
+    {
+        std::vector<uint8_t> packed_metadata;
+        std::unique_ptr<rmm::device_buffer> device_data;  // null when spilled to host memory
+        std::vector<uint8_t> host_data;
+        std::size_t data_bytes{0};
+        cudf::io::table_metadata metadata;
+        int num_indices{0};
+        std::list<std::string>::iterator lru_position;
+    };
+
+    // Spills and evicts the least recently used tables until both limits are met, the lock must be held
+    void enforce_limits();
+
+    void erase(std::unordered_map<std::string, Entry>::iterator entry);
+
+    std::size_t m_max_device_bytes;
+    std::size_t m_max_host_bytes;
+    std::size_t m_device_bytes{0};
+    std::size_t m_host_bytes{0};
+
+    mutable std::mutex m_mutex;
+    std::list<std::string> m_lru;  // Most recently used first
+    std::unordered_map<std::string, Entry> m_entries;
+};
+
+#pragma GCC visibility pop
+}  // namespace morpheus
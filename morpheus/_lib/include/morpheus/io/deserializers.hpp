@@ -20,12 +20,24 @@
 #include "morpheus/objects/file_types.hpp"  // for FileTypes
 
 #include <cudf/io/types.hpp>
-#include <pybind11/pytypes.h>  // for pybind11::object
+#include <cudf/types.hpp>                     // for data_type
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
+#include <pybind11/pytypes.h>                 // for pybind11::object
+#include <rmm/cuda_stream_view.hpp>           // for cuda_stream_view
 
+#include <cstddef>  // for size_t
+#include <map>
+#include <memory>  // for unique_ptr
 #include <optional>
+#include <regex>
 #include <string>
+#include <utility>  // for pair
 #include <vector>
 
+namespace cudf::io {
+class chunked_parquet_reader;
+}  // namespace cudf::io
+
 namespace morpheus {
 #pragma GCC visibility push(default)
 /**
@@ -34,6 +46,92 @@ namespace morpheus {
  * @file
  */
 
+/**
+ * @brief Known schema of a file, the columns to read along with their types. Readers parse only these columns, directly
+ * at their types, skipping type inference. An empty schema reads every column of the file, inferring their types.
+ *
+ * Low cardinality string columns, such as addresses, user or event names, can be given a `DICTIONARY32` type. They are
+ * parsed as strings then dictionary encoded, each distinct string being held once along with an index per row. cuDF
+ * gathers, filters and concatenates such columns without decoding them.
+ */
+struct TableSchema
+{
+    std::vector<std::string> column_names;
+    std::vector<cudf::data_type> column_types;
+
+    bool empty() const;
+
+    /**
+     * @brief Returns the type of each column keyed by its name, as expected by the CSV and JSON readers. Dictionary
+     * columns are reported as strings, the type they are parsed at.
+     */
+    std::map<std::string, cudf::data_type> dtypes() const;
+
+    /**
+     * @brief Builds a schema from pairs of column names and type names, types being named as in pandas: `"bool"`,
+     * `"int8"` through `"uint64"`, `"float32"`, `"float64"`, `"str"`, `"category"` for dictionary encoded strings and
+     * `"datetime64[s|ms|us|ns]"`
+     *
+     * @throws std::invalid_argument If a type name is not supported or a column is listed more than once
+     */
+    static TableSchema from_type_names(const std::vector<std::pair<std::string, std::string>>& columns);
+};
+
+/**
+ * @brief Projects `table` to the columns of `schema`, in their order, casting any column whose type differs from the
+ * schema and dictionary encoding the string columns of a `DICTIONARY32` type. Does nothing when `schema` is empty.
+ *
+ * @throws std::runtime_error If a column of the schema is missing from `table` or can not be cast to its type
+ */
+void apply_table_schema(cudf::io::table_with_metadata& table, const TableSchema& schema);
+
+/**
+ * @brief Columns read by the stages downstream of a source, as case insensitive regular expressions searched in the
+ * column names like the include and exclude lists of `SerializeStage`. Sources drop the other columns right after
+ * parsing, such that they are neither kept in memory nor copied by downstream stages. An empty projection keeps every
+ * column.
+ */
+class ColumnProjection
+{
+  public:
+    ColumnProjection() = default;
+    explicit ColumnProjection(const std::vector<std::string>& patterns);
+
+    bool empty() const;
+
+    /**
+     * @brief Returns whether `column_name` matches any of the patterns of the projection
+     */
+    bool keeps(const std::string& column_name) const;
+
+  private:
+    std::vector<std::regex> m_patterns;
+};
+
+/**
+ * @brief Drops the columns of `table` not kept by `projection`. The index column, see `get_index_col_count`, is always
+ * kept, as is the first column when no other one would be, since a table without columns has no rows. Does nothing
+ * when `projection` is empty.
+ */
+void apply_column_projection(cudf::io::table_with_metadata& table, const ColumnProjection& projection);
+
+/**
+ * @brief Expands each struct column of `table`, such as the nested objects of JSON records, into a top level column per
+ * field named after the path of the field joined with dots, as `pandas.json_normalize` does. The fields are moved out
+ * of their struct without any copy. With `explode_lists`, list columns are then exploded into a row per element, the
+ * rows of empty or null lists being kept with a null element, and the struct elements are flattened in turn.
+ */
+void flatten_nested_columns(cudf::io::table_with_metadata& table, bool explode_lists = false);
+
+/**
+ * @brief Replaces `table` by the records held in its `record_path` column, with a column per field of the records. This
+ * is the counterpart of `pandas.json_normalize(df[record_path])`, typically used to read the `Records` array of a
+ * CloudTrail log file. A list column holds several records per row, a struct column a single one.
+ *
+ * @throws std::invalid_argument If `table` has no `record_path` column
+ */
+void select_records(cudf::io::table_with_metadata& table, const std::string& record_path);
+
 /**
  * @brief Get the column names from table object. Looks at both column_names as well as schema_info and returns the
  * correct one.
@@ -47,11 +145,54 @@ std::vector<std::string> get_column_names_from_table(const cudf::io::table_with_
  * @brief Loads a cudf table from either CSV or JSON file
  *
  * @param filename : Name of the file that should be loaded into a table
+ * @param schema : Columns to read along with their types, empty to read every column inferring their types
+ * @param stream : Stream the table is read on, the caller must synchronize it before using the table on another one
  * @return cudf::io::table_with_metadata
  */
 cudf::io::table_with_metadata load_table_from_file(const std::string& filename,
                                                    FileTypes file_type            = FileTypes::Auto,
-                                                   std::optional<bool> json_lines = std::nullopt);
+                                                   std::optional<bool> json_lines = std::nullopt,
+                                                   const TableSchema& schema      = {},
+                                                   rmm::cuda_stream_view stream   = cudf::get_default_stream());
+
+/**
+ * @brief Loads a cudf table from a CSV, JSON or Parquet file held in host memory
+ *
+ * @param data : Contents of the file, pinned host memory avoids a staging copy when the data is sent to the device
+ * @param size : Size of the contents in bytes
+ * @param file_type : Type of the file, can not be `FileTypes::Auto`
+ * @param schema : Columns to read along with their types, empty to read every column inferring their types
+ * @param stream : Stream the table is read on, the caller must synchronize it before using the table on another one
+ * @return cudf::io::table_with_metadata
+ */
+cudf::io::table_with_metadata load_table_from_buffer(const char* data,
+                                                     std::size_t size,
+                                                     FileTypes file_type,
+                                                     std::optional<bool> json_lines = std::nullopt,
+                                                     const TableSchema& schema      = {},
+                                                     rmm::cuda_stream_view stream   = cudf::get_default_stream());
+
+/**
+ * @brief Reads JSON lines held in host memory, dropping the malformed lines rather than failing on them. The lines are
+ * first parsed as they are, and only when that fails parsed again in cuDF's recovery mode, which reads malformed lines
+ * as rows of nulls that are then dropped, such that only buffers holding malformed lines pay for a second parse. A
+ * valid line whose fields are all null is dropped along with them.
+ *
+ * @param data : Contents of the buffer
+ * @param size : Size of the contents in bytes
+ * @param schema : Types of the columns, unlike `load_table_from_buffer` the schema is not applied, see
+ * `apply_table_schema`
+ * @param always_recover : Parses in recovery mode right away, for buffers expected to hold malformed lines
+ * @param num_malformed : Set to the number of dropped lines
+ * @param stream : Stream the table is read on
+ * @return cudf::io::table_with_metadata
+ */
+cudf::io::table_with_metadata read_json_lines_recovering(const char* data,
+                                                         std::size_t size,
+                                                         const TableSchema& schema,
+                                                         bool always_recover,
+                                                         cudf::size_type& num_malformed,
+                                                         rmm::cuda_stream_view stream = cudf::get_default_stream());
 
 /**
  * @brief Returns the number of index columns in `data_table`, in practice this will be a `0` or `1`
@@ -74,9 +215,73 @@ int prepare_df_index(cudf::io::table_with_metadata& data_table);
  * @brief Loads a cudf table from either CSV or JSON file returning the DataFrame as a Python object
  *
  * @param filename : Name of the file that should be loaded into a table
+ * @param file_type : Type of the file, determined from its extension when `FileTypes::Auto`
+ * @param json_lines : Whether JSON files hold a record per line or a single document, JSON lines by default
+ * @param record_path : When not empty, only the records of this column are kept, see `select_records`
+ * @param flatten : Expands nested records into dotted top level columns, see `flatten_nested_columns`
+ * @param explode_lists : With `flatten`, also explodes the list columns into a row per element
  * @return pybind11::object
  */
-pybind11::object read_file_to_df(const std::string& filename, FileTypes file_type = FileTypes::Auto);
+pybind11::object read_file_to_df(const std::string& filename,
+                                 FileTypes file_type            = FileTypes::Auto,
+                                 std::optional<bool> json_lines = std::nullopt,
+                                 const std::string& record_path = "",
+                                 bool flatten                   = false,
+                                 bool explode_lists             = false);
+
+/**
+ * @brief Reads a CSV, JSON lines or Parquet file one chunk at a time, such that files larger than device memory can be
+ * loaded. CSV and JSON lines files are read through cudf byte ranges, each chunk holding the rows starting within the
+ * next `chunk_bytes` bytes of the file, and Parquet files through a cudf chunked reader limiting each chunk to about
+ * `chunk_bytes` bytes of output. Every chunk has the columns and types of the first one.
+ */
+class ChunkedTableReader
+{
+  public:
+    /**
+     * @brief Construct a new Chunked Table Reader object, nothing is read until the first call to `next`
+     *
+     * @param filename : Name of the file to read
+     * @param file_type : Type of the file, `FileTypes::Auto` determines it from the extension of `filename`
+     * @param chunk_bytes : Number of bytes of each chunk, must be greater than zero
+     * @param json_lines : Whether to force json or jsonlines parsing, only JSON lines files can be read in chunks
+     * @param schema : Columns to read along with their types, empty to read every column inferring their types
+     * @throws std::invalid_argument If `chunk_bytes` is zero or the file is a JSON file not in the lines format
+     */
+    ChunkedTableReader(std::string filename,
+                       FileTypes file_type            = FileTypes::Auto,
+                       std::size_t chunk_bytes        = 0,
+                       std::optional<bool> json_lines = std::nullopt,
+                       TableSchema schema             = {});
+    ~ChunkedTableReader();
+
+    /**
+     * @brief Reads the next chunk of the file, skipping ranges holding no rows
+     *
+     * @return std::optional<cudf::io::table_with_metadata> : The next chunk or `std::nullopt` once the whole file has
+     * been read
+     */
+    std::optional<cudf::io::table_with_metadata> next();
+
+  private:
+    // Reads the byte range starting at `m_offset` of a CSV or JSON lines file
+    cudf::io::table_with_metadata read_byte_range();
+
+    std::string m_filename;
+    FileTypes m_file_type;
+    std::size_t m_chunk_bytes;
+    TableSchema m_schema;
+    std::size_t m_file_bytes{0};
+    std::size_t m_offset{0};
+
+    // Read from the first chunk of CSV and JSON lines files, before applying the schema, the following chunks being
+    // parsed the same way
+    std::vector<std::string> m_column_names;
+    std::vector<cudf::data_type> m_column_types;
+
+    // Only set when reading Parquet files
+    std::unique_ptr<cudf::io::chunked_parquet_reader> m_parquet_reader;
+};
 
 #pragma GCC visibility pop
 /** @} */  // end of group
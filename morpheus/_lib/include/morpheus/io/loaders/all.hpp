@@ -22,3 +22,4 @@
 #include "lambda.hpp"
 #include "payload.hpp"
 #include "rest.hpp"
+#include "s3.hpp"
@@ -30,6 +30,8 @@ namespace morpheus {
  * @brief Very simple raw data loader that takes a list of files containing data that can be converted into a cuDF
  * DataFrame. Loads the files into a cuDF DataFrame and returns a ControlMessage containing the DataFrame.
  *
+ * CSV, JSON, Parquet, ORC and Avro files are read and concatenated by libcudf without acquiring the GIL, and must
+ * share the same columns. Tasks including Feather or HDF files are loaded through the cudf python module.
  */
 class FileDataLoader : public Loader
 {
@@ -27,8 +27,12 @@
 namespace morpheus {
 #pragma GCC visibility push(default)
 /**
- * @brief Very simple raw data loader that takes payload data on the control message and returns it
+ * @brief Data loader making the server-streaming gRPC call described by the task, the streamed messages holding JSON
+ * lines records which are loaded into a cuDF DataFrame.
  *
+ * The method is called without generated stubs: the task provides the serialized request as `request_base64`, and
+ * `payload_field` selects the length-delimited field of each response holding the records, 0 using the whole message.
+ * Records are parsed in batches of up to `batch_bytes` (loader config, default 16MiB) while the stream is being read.
  */
 class GRPCDataLoader : public Loader
 {
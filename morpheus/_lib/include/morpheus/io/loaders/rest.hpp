@@ -27,8 +27,10 @@
 namespace morpheus {
 #pragma GCC visibility push(default)
 /**
- * @brief Very simple raw data loader that takes payload data on the control message and returns it
+ * @brief Data loader sending the REST queries of the task and loading the JSON responses into a cuDF DataFrame.
  *
+ * Requests are sent asynchronously from the calling thread with up to `max_concurrent_requests` (default 8) in flight,
+ * reusing the connections to each host. Responses are parsed and concatenated by libcudf without acquiring the GIL.
  */
 class RESTDataLoader : public Loader
 {
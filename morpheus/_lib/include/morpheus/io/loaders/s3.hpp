@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/io/data_loader.hpp"
+#include "morpheus/messages/control.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <memory>
+
+namespace morpheus {
+#pragma GCC visibility push(default)
+/**
+ * @brief Data loader fetching the objects listed by the `files` of the task, as `s3://bucket/key` URIs, from an S3
+ * compatible object store and loading them into a cuDF DataFrame.
+ *
+ * Each object is fetched with concurrent ranged GETs of `part_bytes` into pinned host memory, and decoded by libcudf
+ * straight from that memory. Up to `max_concurrent_requests` requests are in flight at once, objects being fetched
+ * that many at a time. Requests are signed with AWS Signature Version 4 when credentials are configured, and sent
+ * unsigned otherwise. Only plain HTTP endpoints are supported.
+ */
+class S3DataLoader : public Loader
+{
+  public:
+    ~S3DataLoader() = default;
+
+    S3DataLoader() = default;
+    S3DataLoader(nlohmann::json config);
+
+    std::shared_ptr<ControlMessage> load(std::shared_ptr<ControlMessage> message, nlohmann::json task) final;
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/objects/factory_registry.hpp"
+
+#include <cudf/io/types.hpp>
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
+#include <nlohmann/json.hpp>
+#include <rmm/cuda_stream_view.hpp>  // for cuda_stream_view
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace morpheus {
+#pragma GCC visibility push(default)
+/**
+ * @addtogroup IO
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Decodes the payloads received by a source stage, such as the messages of a Kafka batch or the body of an HTTP
+ * request, into a single table. Decoders are created by name from the `PayloadDecoderRegistry`, which holds the built
+ * in `json`, `arrow`, `parquet` and `avro` decoders and to which the decoders of other wire formats can be registered.
+ */
+class PayloadDecoder
+{
+  public:
+    virtual ~PayloadDecoder() = default;
+
+    /**
+     * @brief Decodes `payloads`, each holding one or more records, into a table with a row per record in the order of
+     * the payloads
+     *
+     * @throws std::runtime_error If a payload can not be decoded or the payloads do not hold the same columns
+     */
+    virtual cudf::io::table_with_metadata decode(const std::vector<std::string_view>& payloads,
+                                                 rmm::cuda_stream_view stream = cudf::get_default_stream()) const = 0;
+
+    /**
+     * @brief Creates the decoder registered as `name`, the built in decoders being registered on first use
+     *
+     * @param name : Wire format of the payloads, one of `json`, `arrow`, `parquet`, `avro` or a registered format
+     * @param config : Options of the decoder, the `json` decoder accepting `{"lines": false}` for payloads holding a
+     * JSON array of records rather than JSON lines
+     * @throws std::runtime_error If no decoder is registered as `name`
+     */
+    static std::shared_ptr<PayloadDecoder> create(const std::string& name, nlohmann::json config = {});
+};
+
+extern template class FactoryRegistry<PayloadDecoder>;
+
+using PayloadDecoderRegistry = FactoryRegistry<PayloadDecoder>;  // NOLINT
+
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
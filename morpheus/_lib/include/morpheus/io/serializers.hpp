@@ -21,14 +21,22 @@
 #include "morpheus/objects/table_info.hpp"
 #include "morpheus/utilities/string_util.hpp"
 
+#include <cudf/io/data_sink.hpp>  // for data_sink
+#include <cudf/io/types.hpp>      // for compression_type
 #include <pybind11/pytypes.h>
 
+#include <cstddef>  // for size_t
 #include <fstream>  // IWYU pragma: keep
+#include <memory>   // for unique_ptr
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <utility>
 
+namespace cudf::io {
+class parquet_chunked_writer;
+}  // namespace cudf::io
+
 namespace morpheus {
 #pragma GCC visibility push(default)
 /**
@@ -37,6 +45,16 @@ namespace morpheus {
  * @file
  */
 
+/**
+ * @brief Creates a sink writing to `filename`, truncating it. Unlike a sink over an output stream, cudf writes device
+ * buffers to it directly through KvikIO, using GPUDirect Storage when the file system supports it and KvikIO is not in
+ * compatibility mode, rather than first copying them to host memory.
+ *
+ * @param filename : Name of the file to write to
+ * @return std::unique_ptr<cudf::io::data_sink>
+ */
+std::unique_ptr<cudf::io::data_sink> create_file_sink(const std::string& filename);
+
 /**
  * @brief Serialize a dataframe to an output stream in CSV format
  *
@@ -62,6 +80,21 @@ void df_to_csv(const TableInfo& tbl,
  */
 std::string df_to_csv(const TableInfo& tbl, bool include_header, bool include_index_col = true);
 
+/**
+ * @brief Serialize a dataframe to a cudf data sink in CSV format
+ *
+ * @param tbl : A wrapper around data in the dataframe
+ * @param sink : Sink to write the results to, such as one returned by `create_file_sink`
+ * @param include_header : Determines whether or not to include the header
+ * @param include_index_col : Determines whether or not to include the dataframe index
+ * @param flush : When `true` flush `sink`.
+ */
+void df_to_csv(const TableInfo& tbl,
+               cudf::io::data_sink& sink,
+               bool include_header,
+               bool include_index_col = true,
+               bool flush             = false);
+
 /**
  * @brief Serialize a dataframe into a JSON formatted string
  * @param tbl : A wrapper around data in the dataframe
@@ -82,6 +115,15 @@ void df_to_json(const TableInfo& tbl, std::ostream& out_stream, bool include_ind
  */
 std::string df_to_json(const TableInfo& tbl, bool include_index_col = true);
 
+/**
+ * @brief Serialize a dataframe to a cudf data sink in JSON format
+ * @param tbl : A wrapper around data in the dataframe
+ * @param sink : Sink to write the results to, such as one returned by `create_file_sink`
+ * @param include_index_col : Determines whether or not to include the dataframe index
+ * @param flush : When `true` flush `sink`.
+ */
+void df_to_json(const TableInfo& tbl, cudf::io::data_sink& sink, bool include_index_col = true, bool flush = false);
+
 /**
  * @brief Serialize a dataframe to an output stream in Parquet format
  *
@@ -107,6 +149,69 @@ void df_to_parquet(const TableInfo& tbl,
  */
 std::string df_to_parquet(const TableInfo& tbl, bool include_header, bool include_index_col = true);
 
+/**
+ * @brief Writes a sequence of dataframes sharing the same columns to an output stream as a single Parquet file, each
+ * dataframe being written as one or more row groups. Unlike `df_to_parquet` the footer is only written once, by
+ * `close`.
+ */
+class ChunkedParquetWriter
+{
+  public:
+    /**
+     * @brief Construct a new Chunked Parquet Writer object, nothing is written until the first call to `write`
+     *
+     * @param out_stream : Output stream to write the file to, must outlive the writer
+     * @param include_index_col : Determines whether or not to include the dataframe index
+     * @param compression : One of "none", "snappy" or "zstd"
+     * @param row_group_size_rows : Maximum number of rows of a row group, zero uses the cudf default
+     * @throws std::invalid_argument If `compression` is not supported
+     */
+    ChunkedParquetWriter(std::ostream& out_stream,
+                         bool include_index_col          = true,
+                         const std::string& compression  = "snappy",
+                         std::size_t row_group_size_rows = 0);
+
+    /**
+     * @brief Construct a new Chunked Parquet Writer object writing to `sink`, such as one returned by
+     * `create_file_sink`
+     *
+     * @param sink : Sink to write the file to
+     * @param include_index_col : Determines whether or not to include the dataframe index
+     * @param compression : One of "none", "snappy" or "zstd"
+     * @param row_group_size_rows : Maximum number of rows of a row group, zero uses the cudf default
+     * @throws std::invalid_argument If `compression` is not supported
+     */
+    ChunkedParquetWriter(std::unique_ptr<cudf::io::data_sink> sink,
+                         bool include_index_col          = true,
+                         const std::string& compression  = "snappy",
+                         std::size_t row_group_size_rows = 0);
+    ~ChunkedParquetWriter();
+
+    /**
+     * @brief Appends the rows of `tbl` to the file, the column names of the file are those of the first dataframe
+     *
+     * @param tbl : A wrapper around data in the dataframe
+     */
+    void write(const TableInfo& tbl);
+
+    /**
+     * @brief Writes the footer, completing the file. Does nothing when nothing was written or when already closed.
+     */
+    void close();
+
+    /**
+     * @brief Returns the number of bytes written to the output stream or sink so far
+     */
+    std::size_t bytes_written() const;
+
+  private:
+    bool m_include_index_col;
+    cudf::io::compression_type m_compression;
+    std::size_t m_row_group_size_rows;
+    std::unique_ptr<cudf::io::data_sink> m_sink;
+    std::unique_ptr<cudf::io::parquet_chunked_writer> m_writer;
+};
+
 /**
  * @brief Loads a cudf table from a CSV, JSON or Parquet file returning the DataFrame as a Python object
  *
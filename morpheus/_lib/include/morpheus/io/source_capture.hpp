@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/io/async_file_writer.hpp"
+
+#include <cudf/io/types.hpp>                  // for table_metadata, table_with_metadata
+#include <cudf/table/table_view.hpp>          // for table_view
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
+#include <rmm/cuda_stream_view.hpp>           // for cuda_stream_view
+
+#include <chrono>  // for system_clock
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace arrow::io {
+class ReadableFile;
+}  // namespace arrow::io
+
+namespace morpheus {
+#pragma GCC visibility push(default)
+/**
+ * @addtogroup IO
+ * @{
+ * @file
+ */
+
+/**
+ * @brief A batch read back from a capture log, along with the time it was received by the captured source
+ */
+struct CapturedBatch
+{
+    cudf::io::table_with_metadata table;
+    std::chrono::system_clock::time_point arrival_time;
+};
+
+/**
+ * @brief Records the batches emitted by a source stage, along with their arrival times, such that production traffic
+ * can be replayed by the `ReplaySourceStage`. The log is a sequence of Arrow IPC streams, one per batch, such that the
+ * columns may differ between batches. Each stream holds the arrival time in the metadata of its schema, under
+ * `ArrivalTimeKey` as nanoseconds since the epoch.
+ *
+ * Batches are copied to the host on the calling thread, and written to the file from a dedicated I/O thread. `write`
+ * may be called concurrently, by the runnables of a source.
+ */
+class SourceCaptureWriter
+{
+  public:
+    static constexpr const char* ArrivalTimeKey = "morpheus.arrival_time_ns";
+
+    /**
+     * @brief Creates the capture log `path`, replacing any existing file
+     *
+     * @param path : File to write the batches to
+     */
+    explicit SourceCaptureWriter(std::filesystem::path path);
+
+    /**
+     * @brief Waits for the batches to be written and closes the log, errors are logged
+     */
+    ~SourceCaptureWriter();
+
+    /**
+     * @brief Appends a batch to the log
+     *
+     * @param table : Columns of the batch
+     * @param metadata : Names of the columns
+     * @param arrival_time : Time the batch was received, the batches being replayed with the same intervals
+     * @param stream : Stream the columns were written on, the copy to the host being ordered after
+     * @throws std::runtime_error If the batch cannot be converted to Arrow
+     */
+    void write(const cudf::table_view& table,
+               const cudf::io::table_metadata& metadata,
+               std::chrono::system_clock::time_point arrival_time = std::chrono::system_clock::now(),
+               rmm::cuda_stream_view stream                       = cudf::get_default_stream());
+
+    /**
+     * @brief Waits for every batch to be written, then closes the log
+     */
+    void close();
+
+  private:
+    std::mutex m_mutex;
+    AsyncFileWriter m_writer;  // Guarded by `m_mutex`
+};
+
+/**
+ * @brief Reads back the batches of a capture log written by `SourceCaptureWriter`, in the order they were written
+ */
+class SourceCaptureReader
+{
+  public:
+    /**
+     * @brief Opens the capture log `path`
+     *
+     * @throws std::runtime_error If the file cannot be opened
+     */
+    explicit SourceCaptureReader(const std::filesystem::path& path);
+
+    ~SourceCaptureReader();
+
+    /**
+     * @brief Reads the next batch onto the device
+     *
+     * @return std::optional<CapturedBatch> : Empty at the end of the log. A log truncated by a source which did not
+     * close it ends at its last complete batch.
+     */
+    std::optional<CapturedBatch> next(rmm::cuda_stream_view stream = cudf::get_default_stream());
+
+    /**
+     * @brief Reads the log again from its first batch
+     */
+    void rewind();
+
+  private:
+    std::filesystem::path m_path;
+    std::shared_ptr<arrow::io::ReadableFile> m_file;
+};
+
+/** @} */  // end of group
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <chrono>   // for milliseconds
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint16_t, uint64_t
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/**
+ * @addtogroup IO
+ * @{
+ * @file
+ */
+
+/****** Component public implementations *******************/
+/****** UcxConnection **************************************/
+
+/**
+ * @brief Point to point connection between two processes over UCX, carrying an ordered stream of buffers in host or
+ * device memory. UCX detects device buffers and, when built with CUDA support on nodes with GPUDirect RDMA capable
+ * NICs, moves them between the GPUs of both nodes without staging them through host memory. The transports used are
+ * chosen by UCX, see the `UCX_TLS` environment variable.
+ *
+ * Buffers are received in the order they were sent, each `recv` being matched with the `send` of the same rank. Both
+ * sides must agree on the size of every buffer, such as by sending it in a header first.
+ *
+ * A connection is used by a single thread at a time.
+ */
+class MORPHEUS_EXPORT UcxConnection
+{
+  public:
+    using stop_fn_t = std::function<bool()>;
+
+    /**
+     * @brief Listens on `bind_address`:`port` and waits for a peer to connect
+     *
+     * @param bind_address
+     * @param port
+     * @param should_stop : Polled while waiting, returns nullptr once it returns true
+     * @return std::unique_ptr<UcxConnection>
+     * @throws std::runtime_error If the address cannot be listened on
+     */
+    static std::unique_ptr<UcxConnection> accept(const std::string& bind_address,
+                                                 uint16_t port,
+                                                 const stop_fn_t& should_stop = nullptr);
+
+    /**
+     * @brief Connects to a peer waiting in `accept`, retrying until `timeout` while the peer is not listening yet
+     *
+     * @param address
+     * @param port
+     * @param timeout
+     * @return std::unique_ptr<UcxConnection>
+     * @throws std::runtime_error If the peer could not be reached within `timeout`
+     */
+    static std::unique_ptr<UcxConnection> connect(const std::string& address,
+                                                  uint16_t port,
+                                                  std::chrono::milliseconds timeout = std::chrono::seconds(60));
+
+    ~UcxConnection();
+
+    UcxConnection(const UcxConnection&)            = delete;
+    UcxConnection& operator=(const UcxConnection&) = delete;
+
+    /**
+     * @brief Sends `size` bytes of `data`, in host or device memory, returning once `data` may be reused
+     *
+     * @throws std::runtime_error If the peer disconnected
+     */
+    void send(const void* data, std::size_t size);
+
+    /**
+     * @brief Receives the next buffer sent by the peer into `data`, in host or device memory, which must hold `size`
+     * bytes
+     *
+     * @param should_stop : Polled while waiting, the receive being cancelled once it returns true
+     * @return true : When the buffer was received, false when stopped
+     * @throws std::runtime_error If the peer disconnected
+     */
+    bool recv(void* data, std::size_t size, const stop_fn_t& should_stop = nullptr);
+
+  private:
+    struct Worker;
+
+    UcxConnection(std::unique_ptr<Worker> worker);
+
+    std::unique_ptr<Worker> m_worker;
+    uint64_t m_num_sent{0};
+    uint64_t m_num_received{0};
+};
+/** @} */  // end of group
+}  // namespace morpheus
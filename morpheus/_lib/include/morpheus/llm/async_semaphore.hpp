@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace morpheus::llm {
+
+/**
+ * @brief Counting semaphore for coroutines, used to bound the number of contexts executing concurrently. Acquiring
+ * suspends the awaiting coroutine until a permit is available instead of blocking the thread. Permits are handed to
+ * waiting coroutines in the order they started waiting, the waiter being resumed on the thread releasing the permit.
+ */
+class MORPHEUS_EXPORT AsyncSemaphore
+{
+  public:
+    /**
+     * @brief Permit acquired from an `AsyncSemaphore`, released when destroyed.
+     */
+    class MORPHEUS_EXPORT Permit
+    {
+      public:
+        Permit() = default;
+        explicit Permit(AsyncSemaphore* semaphore) : m_semaphore(semaphore) {}
+
+        Permit(Permit&& other) noexcept;
+        Permit& operator=(Permit&& other) noexcept;
+
+        Permit(const Permit&)            = delete;
+        Permit& operator=(const Permit&) = delete;
+
+        ~Permit();
+
+        /**
+         * @brief Release the permit before the end of its lifetime.
+         */
+        void release();
+
+      private:
+        AsyncSemaphore* m_semaphore{nullptr};
+    };
+
+    class MORPHEUS_EXPORT Awaiter
+    {
+      public:
+        explicit Awaiter(AsyncSemaphore& semaphore) : m_semaphore(semaphore) {}
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        Permit await_resume() noexcept
+        {
+            return Permit(&m_semaphore);
+        }
+
+      private:
+        AsyncSemaphore& m_semaphore;
+    };
+
+    /**
+     * @brief Construct a new AsyncSemaphore object.
+     *
+     * @param count : Number of permits
+     * @throws std::invalid_argument If `count` is 0
+     */
+    explicit AsyncSemaphore(std::size_t count);
+
+    AsyncSemaphore(const AsyncSemaphore&)            = delete;
+    AsyncSemaphore& operator=(const AsyncSemaphore&) = delete;
+
+    /**
+     * @brief Acquire a permit, `co_await semaphore.acquire()` returning a `Permit` once one is available.
+     *
+     * @return Awaiter
+     */
+    Awaiter acquire()
+    {
+        return Awaiter(*this);
+    }
+
+    /**
+     * @brief Get the number of permits which are not currently held.
+     *
+     * @return std::size_t
+     */
+    std::size_t available() const;
+
+  private:
+    void release();
+
+    mutable std::mutex m_mutex;
+    std::size_t m_available;
+    std::deque<std::coroutine_handle<>> m_waiting;
+};
+
+}  // namespace morpheus::llm
@@ -37,12 +37,18 @@ class LLMNodeRunner;
 
 class LLMNode;
 
+class LLMOutputStream;
+
 class LLMTaskHandlerRunner;
 
 class LLMTaskHandler;
 
 struct LLMTask;
 
+class LLMTrace;
+
+struct ResolvedInputMappings;
+
 // IWYU pragma: end_exports
 
 }  // namespace morpheus::llm
@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/types.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace morpheus::llm {
+
+/**
+ * @brief Admits the calls made to an LLM service, shared by every node calling the service so that their concurrent
+ * contexts stay within the requests per second and tokens per minute budgets of the service together. Calls beyond
+ * the budgets wait in a single queue and are admitted in the order they arrived, rather than failing with a rate limit
+ * error and retrying.
+ *
+ * The request rate adapts to the service with AIMD: it decreases multiplicatively, at most once per second, when the
+ * service reports a rate limit error, and increases additively with each successful call up to
+ * `max_requests_per_second`. Rate limit response headers (`retry-after`, `retry-after-ms` and the
+ * `x-ratelimit-remaining-*` / `x-ratelimit-reset-*` headers of OpenAI) additionally pause admissions until the service
+ * is expected to accept calls again.
+ *
+ * Waiting calls are resumed from the timer thread of the controller.
+ */
+class MORPHEUS_EXPORT LLMAdmissionController
+{
+  public:
+    using headers_t = std::map<std::string, std::string>;
+
+    /**
+     * @brief Construct a new LLMAdmissionController object.
+     *
+     * @param max_requests_per_second : Maximum rate of requests
+     * @param max_tokens_per_minute : Maximum rate of tokens, 0 for no limit
+     * @param min_rate_fraction : Fraction of `max_requests_per_second` the rate is never decreased below
+     * @param increase_fraction : Fraction of `max_requests_per_second` the rate increases by with each successful call
+     * @throws std::invalid_argument If `max_requests_per_second` is not positive or a fraction is not in (0, 1]
+     */
+    LLMAdmissionController(double max_requests_per_second,
+                           double max_tokens_per_minute = 0,
+                           double min_rate_fraction     = 0.1,
+                           double increase_fraction     = 0.05);
+
+    /**
+     * @brief Destroy the LLMAdmissionController object, the calls still waiting throwing `std::runtime_error`.
+     */
+    ~LLMAdmissionController();
+
+    LLMAdmissionController(const LLMAdmissionController&)            = delete;
+    LLMAdmissionController& operator=(const LLMAdmissionController&) = delete;
+
+    /**
+     * @brief Wait for a call using `tokens` tokens, prompt and completion, to be admitted. Calls larger than the token
+     * budget are admitted once the whole budget is available.
+     *
+     * @param tokens : Estimated number of tokens used by the call
+     * @return Task<double> Seconds the call waited
+     */
+    Task<double> acquire(std::size_t tokens = 0);
+
+    /**
+     * @brief Report a successful call, increasing the request rate.
+     *
+     * @param headers : Response headers of the call, used to pause admissions when a budget of the service is spent
+     */
+    void on_success(const headers_t& headers = {});
+
+    /**
+     * @brief Report a call which failed with a rate limit error, such as a 429 response, decreasing the request rate.
+     *
+     * @param headers : Response headers of the call, used to pause admissions until the service accepts calls again
+     */
+    void on_rate_limited(const headers_t& headers = {});
+
+    /**
+     * @brief Get the current request rate.
+     *
+     * @return double
+     */
+    double requests_per_second() const;
+
+    /**
+     * @brief Get the number of calls waiting to be admitted.
+     *
+     * @return std::size_t
+     */
+    std::size_t num_waiting() const;
+
+  private:
+    using clock_t = std::chrono::steady_clock;
+
+    class Admission;
+
+    /**
+     * @brief Adds the budget accumulated since the last refill. Requires `m_mutex`.
+     */
+    void refill(clock_t::time_point now);
+
+    /**
+     * @brief Time until a call using `tokens` can be admitted, zero when it can be now. Requires `m_mutex`.
+     */
+    clock_t::duration time_until_admissible(std::size_t tokens, clock_t::time_point now) const;
+
+    /**
+     * @brief Consumes the budget of a call using `tokens`. Requires `m_mutex`.
+     */
+    void consume(std::size_t tokens);
+
+    /**
+     * @brief Pauses admissions until the reset reported by `headers`, if any. Requires `m_mutex`.
+     */
+    void pause_from_headers(const headers_t& headers, bool rate_limited, clock_t::time_point now);
+
+    void run_timer();
+
+    double m_max_requests_per_second;
+    double m_max_tokens_per_minute;
+    double m_min_requests_per_second;
+    double m_increase;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_timer_cv;
+
+    double m_requests_per_second;
+    double m_request_budget;
+    double m_token_budget;
+    clock_t::time_point m_last_refill;
+    clock_t::time_point m_paused_until;
+    clock_t::time_point m_last_decrease;
+
+    std::deque<Admission*> m_waiting;
+    bool m_stopping{false};
+    std::thread m_timer_thread;
+};
+
+}  // namespace morpheus::llm
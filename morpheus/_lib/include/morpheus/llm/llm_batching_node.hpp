@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/llm/fwd.hpp"
+#include "morpheus/llm/llm_node_base.hpp"
+#include "morpheus/types.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace morpheus::llm {
+
+/**
+ * @brief Wraps a node whose inputs are lists, such as the `LLMGenerateNode` taking a list of prompts, combining the
+ * inputs of concurrently executing contexts into a single execution of the wrapped node. Since the `LLMEngineStage`
+ * runs several messages at once, this turns one service call per message into one call per batch.
+ *
+ * The first context to arrive opens a batch, which is dispatched once it holds `max_batch_size` rows or `max_delay` has
+ * elapsed. Each input of the wrapped node is concatenated across the contexts of the batch, the wrapped node executing
+ * on a context of its own with the `task` and `message` of the first context. Its output, either a list or an object of
+ * lists with one value per row, is then split back into the output of each context.
+ *
+ * The batch is dispatched by the first context it holds, resumed from the thread closing the batch. This is either the
+ * thread of the context filling the batch, or the timer thread of this node when `max_delay` elapses.
+ */
+class MORPHEUS_EXPORT LLMBatchingNode : public LLMNodeBase
+{
+  public:
+    /**
+     * @brief Construct a new LLMBatchingNode object.
+     *
+     * @param node : Node to execute on the batched inputs
+     * @param max_batch_size : Maximum number of rows in a batch, contexts holding more rows are dispatched on their own
+     * @param max_delay : Maximum time a batch waits for more contexts before being dispatched
+     * @throws std::invalid_argument If `node` is null or `max_batch_size` is 0
+     */
+    LLMBatchingNode(std::shared_ptr<LLMNodeBase> node,
+                    std::size_t max_batch_size          = 32,
+                    std::chrono::milliseconds max_delay = std::chrono::milliseconds(10));
+
+    /**
+     * @brief Destroy the LLMBatchingNode object, dispatching any open batch.
+     */
+    ~LLMBatchingNode() override;
+
+    /**
+     * @brief Get the input names of the wrapped node.
+     *
+     * @return std::vector<std::string>
+     */
+    std::vector<std::string> get_input_names() const override;
+
+    /**
+     * @brief Add the inputs of `context` to a batch, returning once the wrapped node has executed on the batch and the
+     * outputs for `context` have been set.
+     *
+     * @param context context for node's execution
+     * @return Task<std::shared_ptr<LLMContext>>
+     * @throws std::invalid_argument If the inputs are not lists of the same length
+     */
+    Task<std::shared_ptr<LLMContext>> execute(std::shared_ptr<LLMContext> context) override;
+
+  private:
+    struct Batch;
+    class BatchClosed;
+
+    /**
+     * @brief Executes the wrapped node on the combined inputs of `batch`, setting the outputs of every context
+     */
+    Task<void> dispatch(std::shared_ptr<Batch> batch);
+
+    /**
+     * @brief Closes `batch`, returning the coroutine waiting for it to be closed if any. Requires `m_mutex`.
+     */
+    std::coroutine_handle<> close_batch(Batch& batch);
+
+    void run_timer();
+
+    std::shared_ptr<LLMNodeBase> m_node;
+    std::size_t m_max_batch_size;
+    std::chrono::milliseconds m_max_delay;
+
+    std::mutex m_mutex;
+    std::condition_variable m_timer_cv;
+    std::shared_ptr<Batch> m_open_batch;
+    std::multimap<std::chrono::steady_clock::time_point, std::weak_ptr<Batch>> m_deadlines;
+    bool m_stopping{false};
+    std::thread m_timer_thread;
+};
+
+}  // namespace morpheus::llm
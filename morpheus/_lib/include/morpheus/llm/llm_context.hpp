@@ -20,13 +20,19 @@
 #include "morpheus/export.h"
 #include "morpheus/llm/fwd.hpp"
 #include "morpheus/llm/input_map.hpp"
+#include "morpheus/llm/llm_output_column.hpp"
 #include "morpheus/llm/llm_task.hpp"
 
 #include <mrc/types.hpp>
 #include <nlohmann/json.hpp>
 
+#include <cstddef>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace morpheus::llm {
@@ -36,11 +42,48 @@ struct LLMContextState
     LLMTask task;
     std::shared_ptr<ControlMessage> message;
     nlohmann::json values;
+    std::shared_ptr<LLMOutputStream> output_stream;
+    std::shared_ptr<LLMTrace> trace;
+};
+
+/**
+ * @brief Input mappings of a context, resolved once such that looking up an input at runtime neither searches the
+ * mappings nor parses the external name. `LLMNodeRunner` and `LLMTaskHandlerRunner` resolve their mappings when the
+ * graph is built, sharing them with every context they push.
+ */
+struct MORPHEUS_EXPORT ResolvedInputMappings
+{
+    /**
+     * @brief Resolve the given input mappings.
+     *
+     * @param inputs input mappings
+     */
+    explicit ResolvedInputMappings(input_mappings_t inputs);
+
+    /**
+     * @brief Get the index of the mapping of internal input `internal_name`.
+     *
+     * @param internal_name internal input name
+     * @return std::size_t
+     * @throws std::runtime_error If no mapping has this internal name
+     */
+    std::size_t index_of(const std::string& internal_name) const;
+
+    input_mappings_t inputs;
+
+    // Parsed external names of the inputs read from sibling outputs, empty for inputs read from the parent inputs
+    std::vector<std::optional<nlohmann::json::json_pointer>> pointers;
+
+    std::unordered_map<std::string, std::size_t> indices;
 };
 
 /**
  * @brief Holds and manages information related to LLM tasks and input mappings required for LLMNode execution.
  * Outputs of node executions are also saved here for use by nodes and task handlers in LLMEngine.
+ *
+ * Outputs can also be set as an `LLMOutputColumn`, which `get_input_column` returns without any conversion. Any other
+ * access to the column, through `get_input`, `get_inputs`, `all_outputs` or `view_outputs`, converts it to JSON in
+ * place on first use.
  */
 class MORPHEUS_EXPORT LLMContext : public std::enable_shared_from_this<LLMContext>
 {
@@ -68,6 +111,17 @@ class MORPHEUS_EXPORT LLMContext : public std::enable_shared_from_this<LLMContex
      */
     LLMContext(std::shared_ptr<LLMContext> parent, std::string name, input_mappings_t inputs);
 
+    /**
+     * @brief Construct a new LLMContext object.
+     *
+     * @param parent parent context
+     * @param name new context name
+     * @param inputs resolved input mappings for new context
+     */
+    LLMContext(std::shared_ptr<LLMContext> parent,
+               std::string name,
+               std::shared_ptr<const ResolvedInputMappings> inputs);
+
     /**
      * @brief Destroy the LLMContext object.
      */
@@ -131,6 +185,16 @@ class MORPHEUS_EXPORT LLMContext : public std::enable_shared_from_this<LLMContex
      */
     std::shared_ptr<LLMContext> push(std::string name, input_mappings_t inputs);
 
+    /**
+     * @brief Create new context from this context using provided name and resolved input mappings, which are shared
+     * rather than copied.
+     *
+     * @param name name of new context
+     * @param inputs resolved input mappings for new context
+     * @return std::shared_ptr<LLMContext>
+     */
+    std::shared_ptr<LLMContext> push_resolved(std::string name, std::shared_ptr<const ResolvedInputMappings> inputs);
+
     /**
      * @brief Moves output map from this context to parent context. Outputs to move can be selected using
      * set_output_names, otherwise all outputs are noved by default.
@@ -160,6 +224,15 @@ class MORPHEUS_EXPORT LLMContext : public std::enable_shared_from_this<LLMContex
      */
     nlohmann::json get_inputs() const;
 
+    /**
+     * @brief Get the parent output column corresponding to given internal input name, if the output was set as a
+     * column which has not been converted to JSON yet.
+     *
+     * @param node_name internal input name
+     * @return std::shared_ptr<LLMOutputColumn> The column, or null when the output is held as JSON
+     */
+    std::shared_ptr<LLMOutputColumn> get_input_column(const std::string& node_name) const;
+
     /**
      * @brief Set output mappings for this context.
      *
@@ -175,6 +248,21 @@ class MORPHEUS_EXPORT LLMContext : public std::enable_shared_from_this<LLMContex
      */
     void set_output(const std::string& output_name, nlohmann::json output);
 
+    /**
+     * @brief Set the outputs of this context to a column.
+     *
+     * @param outputs output column
+     */
+    void set_output_column(std::shared_ptr<LLMOutputColumn> outputs);
+
+    /**
+     * @brief Set an output value for this context to a column.
+     *
+     * @param output_name output name
+     * @param output output column
+     */
+    void set_output_column(const std::string& output_name, std::shared_ptr<LLMOutputColumn> output);
+
     /**
      * @brief Set the output names to propagate from this context when using pop.
      *
@@ -182,19 +270,102 @@ class MORPHEUS_EXPORT LLMContext : public std::enable_shared_from_this<LLMContex
      */
     void set_output_names(std::vector<std::string> output_names);
 
+    /**
+     * @brief Set the stream receiving the partial outputs of the nodes executing under this root context.
+     *
+     * @param output_stream output stream, null to drop partial outputs
+     */
+    void set_output_stream(std::shared_ptr<LLMOutputStream> output_stream);
+
+    /**
+     * @brief Get the stream receiving the partial outputs of the nodes, which is set on the root context.
+     *
+     * @return std::shared_ptr<LLMOutputStream> The stream, or null when partial outputs are not consumed
+     */
+    std::shared_ptr<LLMOutputStream> output_stream() const;
+
+    /**
+     * @brief Whether partial outputs written with `stream_output` are consumed. Nodes can skip requesting a streamed
+     * generation otherwise.
+     *
+     * @return bool
+     */
+    bool is_streaming() const;
+
+    /**
+     * @brief Write a partial output of this context, such as the tokens generated so far, before its outputs are set.
+     * The chunk is tagged with the full name of this context, and dropped when no stream is set.
+     *
+     * @param chunk partial output
+     */
+    void stream_output(nlohmann::json chunk) const;
+
+    /**
+     * @brief Set the trace recording the spans of the nodes executing under this root context.
+     *
+     * @param trace trace, null to disable tracing
+     */
+    void set_trace(std::shared_ptr<LLMTrace> trace);
+
+    /**
+     * @brief Get the trace recording the spans of the nodes, which is set on the root context.
+     *
+     * @return std::shared_ptr<LLMTrace> The trace, or null when tracing is disabled
+     */
+    std::shared_ptr<LLMTrace> trace() const;
+
     void outputs_complete();
 
     nlohmann::json::const_reference view_outputs() const;
 
   private:
+    /**
+     * @brief Get the value of the input mapped by the mapping at `index`.
+     */
+    nlohmann::json::const_reference get_mapped_input(std::size_t index) const;
+
+    /**
+     * @brief Get the output at `pointer`, which is the parsed `path`.
+     */
+    nlohmann::json::const_reference get_output(const nlohmann::json::json_pointer& pointer,
+                                               const std::string& path) const;
+
+    /**
+     * @brief Converts the columns at, above or below the JSON pointer `path` of the outputs to JSON.
+     */
+    void materialize_columns(const std::string& path) const;
+
+    /**
+     * @brief Converts the column holding all of the outputs to JSON, if any.
+     */
+    void materialize_root_column() const;
+
+    /**
+     * @brief Removes the columns at or below the JSON pointer `path`, returning them keyed by their path under `path`.
+     * Requires `m_outputs_mutex`.
+     */
+    std::map<std::string, std::shared_ptr<LLMOutputColumn>> extract_columns(const std::string& path);
+
+    /**
+     * @brief Sets the output `output_name` along with the columns it holds, keyed by their path under the output.
+     */
+    void set_output_with_columns(const std::string& output_name,
+                                 nlohmann::json output,
+                                 std::map<std::string, std::shared_ptr<LLMOutputColumn>> columns);
+
     std::shared_ptr<LLMContext> m_parent{nullptr};
     std::string m_name;
-    input_mappings_t m_inputs;
+    std::shared_ptr<const ResolvedInputMappings> m_inputs;
     std::vector<std::string> m_output_names;  // Names of keys to be used as the output. Empty means use all keys
 
     std::shared_ptr<LLMContextState> m_state;
 
-    nlohmann::json m_outputs;
+    // Guards the insertion of outputs, siblings executing concurrently writing their outputs while others read theirs
+    mutable std::mutex m_outputs_mutex;
+
+    // Columns are held aside, keyed by their JSON pointer in the outputs, until they are converted to JSON in place
+    mutable nlohmann::json m_outputs;
+    mutable std::map<std::string, std::shared_ptr<LLMOutputColumn>> m_columns;
 
     mrc::Promise<void> m_outputs_promise;
     mrc::SharedFuture<void> m_outputs_future;
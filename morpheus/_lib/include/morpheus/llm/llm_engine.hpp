@@ -18,9 +18,11 @@
 #pragma once
 
 #include "morpheus/export.h"
+#include "morpheus/llm/async_semaphore.hpp"
 #include "morpheus/llm/fwd.hpp"
 #include "morpheus/llm/input_map.hpp"
 #include "morpheus/llm/llm_node.hpp"
+#include "morpheus/llm/llm_trace.hpp"
 #include "morpheus/types.hpp"
 
 #include <memory>
@@ -67,10 +69,36 @@ class MORPHEUS_EXPORT LLMEngine : public LLMNode
      */
     virtual Task<std::vector<std::shared_ptr<ControlMessage>>> run(std::shared_ptr<ControlMessage> input_message);
 
+    /**
+     * @brief Execute nodes in this engine for each 'llm_engine' task of the message, bounding the number of contexts
+     * executing concurrently with `concurrency_limit`. The tasks of a message are independent and execute concurrently,
+     * each holding a permit of `concurrency_limit` while the nodes execute. The task handlers then run one task at a
+     * time in the order of the tasks, as they may update the same message.
+     *
+     * The partial outputs written by the nodes with `LLMContext::stream_output` are sent to `output_stream`, which the
+     * caller reads while the engine runs and closes once it has completed.
+     *
+     * When `trace` is set, the spans of the nodes and task handlers of each task, along with the time it waited for a
+     * permit, are appended to the `llm_trace` metadata of its output messages as a list of `LLMSpan::to_json` objects.
+     *
+     * @param input_message input control message
+     * @param concurrency_limit semaphore shared by every message of a stage, no limit when null
+     * @param output_stream stream receiving the partial outputs of the nodes, dropped when null
+     * @param trace whether to trace the execution of each task
+     * @return Task<std::vector<std::shared_ptr<ControlMessage>>>
+     */
+    Task<std::vector<std::shared_ptr<ControlMessage>>> run(std::shared_ptr<ControlMessage> input_message,
+                                                           std::shared_ptr<AsyncSemaphore> concurrency_limit,
+                                                           std::shared_ptr<LLMOutputStream> output_stream = nullptr,
+                                                           bool trace                                      = false);
+
   private:
+    Task<void> execute_limited(std::shared_ptr<LLMContext> context, std::shared_ptr<AsyncSemaphore> concurrency_limit);
+
     Task<std::vector<std::shared_ptr<ControlMessage>>> handle_tasks(std::shared_ptr<LLMContext> context);
 
     std::vector<std::shared_ptr<LLMTaskHandlerRunner>> m_task_handlers;
+    LLMSpanRecorder m_queue_recorder{"queue"};
 };
 
 }  // namespace morpheus::llm
@@ -85,7 +85,10 @@ class MORPHEUS_EXPORT LLMNode : public LLMNodeBase
     size_t node_count() const;
 
     /**
-     * @brief Execute all child nodes and save output from output node(s) to context.
+     * @brief Execute all child nodes and save output from output node(s) to context. Each child node starts as soon as
+     * the sibling nodes it takes inputs from have completed, such that independent child nodes run concurrently. Nodes
+     * are started in the order they were added. If a child node throws, the nodes depending on it are skipped and the
+     * first exception, in the order the nodes were added, is rethrown once every other node has completed.
      *
      * @param context context for node's execution
      * @return Task<std::shared_ptr<LLMContext>>
@@ -94,6 +97,7 @@ class MORPHEUS_EXPORT LLMNode : public LLMNodeBase
 
   private:
     std::vector<std::shared_ptr<LLMNodeRunner>> m_child_runners;
+    std::vector<std::vector<std::size_t>> m_child_dependencies;  // Indices of the siblings each child takes inputs from
 
     std::vector<std::string> m_input_names;
     std::vector<std::string> m_output_node_names;  // Names of nodes to be used as the output
@@ -20,6 +20,7 @@
 #include "morpheus/export.h"
 #include "morpheus/llm/fwd.hpp"
 #include "morpheus/llm/input_map.hpp"
+#include "morpheus/llm/llm_trace.hpp"
 #include "morpheus/types.hpp"
 
 #include <memory>
@@ -89,7 +90,9 @@ class MORPHEUS_EXPORT LLMNodeRunner
   private:
     std::string m_name;
     input_mappings_t m_inputs;
+    std::shared_ptr<const ResolvedInputMappings> m_resolved_inputs;
     std::shared_ptr<LLMNodeBase> m_node;
+    LLMSpanRecorder m_span_recorder{"node"};
 
     std::vector<std::string> m_sibling_input_names;
     std::vector<std::string> m_parent_input_names;
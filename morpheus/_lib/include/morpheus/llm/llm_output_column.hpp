@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <nlohmann/json.hpp>
+
+namespace morpheus::llm {
+
+/**
+ * @brief Output value held by an `LLMContext` in a columnar representation, such as an Arrow array or a cudf column
+ * with one value per row. The column is passed as is between nodes reading it as a column, and only converted to JSON
+ * the first time a node reads it as JSON.
+ */
+class MORPHEUS_EXPORT LLMOutputColumn
+{
+  public:
+    virtual ~LLMOutputColumn() = default;
+
+    /**
+     * @brief Convert the column to a JSON array holding one value per row.
+     *
+     * @return nlohmann::json
+     */
+    virtual nlohmann::json to_json() const = 0;
+};
+
+}  // namespace morpheus::llm
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <nlohmann/json.hpp>
+
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace morpheus::llm {
+
+/**
+ * @brief Partial output streamed by a node before its outputs are set.
+ */
+struct LLMStreamChunk
+{
+    // Full name of the context of the node, as returned by `LLMContext::full_name`
+    std::string node_name;
+    nlohmann::json chunk;
+};
+
+/**
+ * @brief Channel carrying the partial outputs of the nodes of an `LLMEngine`, such as the tokens of a generation, while
+ * they execute. Nodes write to it through `LLMContext::stream_output` from any thread without blocking, while a single
+ * reader consumes the chunks in the order they were written with `co_await stream.read()`. The reader is resumed
+ * through `resume_fn`, letting it be rescheduled on its own scheduler rather than resumed on the writer's thread.
+ */
+class MORPHEUS_EXPORT LLMOutputStream
+{
+  public:
+    using resume_fn_t = std::function<void(std::coroutine_handle<>)>;
+
+    class MORPHEUS_EXPORT Awaiter
+    {
+      public:
+        explicit Awaiter(LLMOutputStream& stream) : m_stream(stream) {}
+
+        bool await_ready() const;
+
+        bool await_suspend(std::coroutine_handle<> handle);
+
+        std::optional<LLMStreamChunk> await_resume();
+
+      private:
+        LLMOutputStream& m_stream;
+    };
+
+    /**
+     * @brief Construct a new LLMOutputStream object.
+     *
+     * @param resume_fn : Function resuming the waiting reader, the reader being resumed inline by the writer when null
+     */
+    explicit LLMOutputStream(resume_fn_t resume_fn = nullptr);
+
+    LLMOutputStream(const LLMOutputStream&)            = delete;
+    LLMOutputStream& operator=(const LLMOutputStream&) = delete;
+
+    /**
+     * @brief Write a chunk to the stream. Chunks written after the stream is closed are dropped.
+     *
+     * @param node_name : Full name of the context of the node writing the chunk
+     * @param chunk : Partial output
+     */
+    void write(std::string node_name, nlohmann::json chunk);
+
+    /**
+     * @brief Close the stream, the reader receiving `std::nullopt` once the remaining chunks are read.
+     */
+    void close();
+
+    /**
+     * @brief Whether the stream has been closed.
+     */
+    bool is_closed() const;
+
+    /**
+     * @brief Read the next chunk, `co_await stream.read()` returning `std::nullopt` once the stream is closed and
+     * drained. Only one coroutine may read at a time.
+     *
+     * @return Awaiter
+     */
+    Awaiter read()
+    {
+        return Awaiter(*this);
+    }
+
+  private:
+    void resume_reader(std::unique_lock<std::mutex>& lock);
+
+    resume_fn_t m_resume_fn;
+
+    mutable std::mutex m_mutex;
+    std::deque<LLMStreamChunk> m_chunks;
+    bool m_closed{false};
+    std::coroutine_handle<> m_reader{nullptr};
+};
+
+}  // namespace morpheus::llm
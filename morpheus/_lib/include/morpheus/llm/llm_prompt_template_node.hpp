@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/llm/fwd.hpp"
+#include "morpheus/llm/llm_node_base.hpp"
+#include "morpheus/types.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace morpheus::llm {
+
+/**
+ * @brief Populates an f-string style template, such as `"Hello {name}!"`, with the values of its inputs for every row of
+ * the batch. The template is parsed once into literal and placeholder segments when the node is constructed, such that
+ * formatting a row only appends the segments, without any python code executing per row.
+ *
+ * Placeholders are named fields, `{{` and `}}` being escaped braces. Format specs, conversions, and attribute or index
+ * lookups are not supported. String values are inserted as is, booleans and null as python would (`True`, `False` and
+ * `None`), and any other value as its JSON representation.
+ */
+class MORPHEUS_EXPORT LLMPromptTemplateNode : public LLMNodeBase
+{
+  public:
+    /**
+     * @brief Construct a new LLMPromptTemplateNode object.
+     *
+     * @param template_str : Template to populate
+     * @throws std::invalid_argument If the template holds an unnamed or unsupported field, or an unmatched brace
+     */
+    explicit LLMPromptTemplateNode(const std::string& template_str);
+
+    /**
+     * @brief Get the names of the fields of the template, in the order they first appear.
+     *
+     * @return std::vector<std::string>
+     */
+    std::vector<std::string> get_input_names() const override;
+
+    /**
+     * @brief Populate the template for each row of the inputs, setting the list of prompts as the output of `context`.
+     *
+     * @param context context for node's execution
+     * @return Task<std::shared_ptr<LLMContext>>
+     * @throws std::invalid_argument If the inputs are not lists of the same length
+     */
+    Task<std::shared_ptr<LLMContext>> execute(std::shared_ptr<LLMContext> context) override;
+
+    /**
+     * @brief Whether `template_str` is supported by this node.
+     *
+     * @param template_str : Template to check
+     * @return bool
+     */
+    static bool is_supported(const std::string& template_str);
+
+  private:
+    struct Segment
+    {
+        // Literal text when `input_index` is not set
+        std::string literal;
+        std::optional<std::size_t> input_index;
+    };
+
+    static std::vector<Segment> parse(const std::string& template_str, std::vector<std::string>& input_names);
+
+    std::vector<std::string> m_input_names;
+    std::vector<Segment> m_segments;
+    std::size_t m_literal_size{0};
+};
+
+}  // namespace morpheus::llm
@@ -21,6 +21,7 @@
 #include "morpheus/llm/fwd.hpp"
 #include "morpheus/llm/input_map.hpp"
 #include "morpheus/llm/llm_task_handler.hpp"
+#include "morpheus/llm/llm_trace.hpp"
 #include "morpheus/types.hpp"
 
 #include <memory>
@@ -67,7 +68,9 @@ class MORPHEUS_EXPORT LLMTaskHandlerRunner
 
   private:
     input_mappings_t m_inputs;
+    std::shared_ptr<const ResolvedInputMappings> m_resolved_inputs;
     std::shared_ptr<LLMTaskHandler> m_handler;
+    LLMSpanRecorder m_span_recorder{"task_handler"};
 };
 
 }  // namespace morpheus::llm
@@ -0,0 +1,123 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/llm/fwd.hpp"
+#include "morpheus/utilities/metrics.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace morpheus::llm {
+
+/**
+ * @brief Time spent by the engine on a context, such as the execution of a node.
+ */
+struct MORPHEUS_EXPORT LLMSpan
+{
+    // Full name of the context, as returned by `LLMContext::full_name`, empty for the root context
+    std::string node_name;
+
+    // One of `node`, `task_handler`, `queue` (waiting for a concurrency permit) or `gil` (waiting for the GIL)
+    std::string kind;
+
+    std::chrono::system_clock::time_point start;
+    std::chrono::system_clock::time_point end;
+
+    /**
+     * @brief Convert the span to JSON, using the field names of OpenTelemetry spans for its timestamps.
+     *
+     * @return nlohmann::json
+     */
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Spans recorded while the engine executes a task, set on the root context to enable tracing.
+ */
+class MORPHEUS_EXPORT LLMTrace
+{
+  public:
+    /**
+     * @brief Add a span, safe to call from concurrently executing nodes.
+     *
+     * @param span span to add
+     */
+    void add_span(LLMSpan span);
+
+    /**
+     * @brief Get the spans in the order they were added, which is the order they ended.
+     *
+     * @return std::vector<LLMSpan>
+     */
+    std::vector<LLMSpan> spans() const;
+
+    /**
+     * @brief Convert the spans to a JSON array.
+     *
+     * @return nlohmann::json
+     */
+    nlohmann::json to_json() const;
+
+  private:
+    mutable std::mutex m_mutex;
+    std::vector<LLMSpan> m_spans;
+};
+
+/**
+ * @brief Records the spans of one kind, held by the component executing them such as an `LLMNodeRunner`. Each span is
+ * observed by the `morpheus_llm_span_seconds` histogram of its node and kind, and added to the trace of the context
+ * when tracing is enabled.
+ */
+class MORPHEUS_EXPORT LLMSpanRecorder
+{
+  public:
+    /**
+     * @brief Construct a new LLMSpanRecorder object.
+     *
+     * @param kind : Kind of the recorded spans
+     */
+    explicit LLMSpanRecorder(std::string kind);
+
+    /**
+     * @brief Record a span of `context`.
+     *
+     * @param context : Context the span was spent on
+     * @param start : Start of the span
+     * @param end : End of the span
+     */
+    void record(const LLMContext& context,
+                std::chrono::system_clock::time_point start,
+                std::chrono::system_clock::time_point end);
+
+  private:
+    std::string m_kind;
+
+    // The histogram of each node recorded, saving a registry lookup per span
+    std::mutex m_mutex;
+    std::map<std::string, std::shared_ptr<Histogram>> m_histograms;
+};
+
+}  // namespace morpheus::llm
@@ -17,16 +17,19 @@
 
 #pragma once
 
-#include "morpheus/messages/meta.hpp"  // for MessageMeta
+#include "morpheus/messages/meta.hpp"               // for MessageMeta
+#include "morpheus/objects/message_timestamps.hpp"  // for MessageTimestamps, time_point_t, timestamp_key_t
 
 #include <nlohmann/json.hpp>   // for json, basic_json
 #include <pybind11/pytypes.h>  // for object, dict, list, none
 
 #include <chrono>    // for system_clock, time_point
+#include <deque>     // for deque
 #include <map>       // for map
 #include <memory>    // for shared_ptr
 #include <optional>  // for optional
 #include <string>    // for string
+#include <utility>   // for move
 #include <vector>    // for vector
 
 namespace morpheus {
@@ -163,9 +166,6 @@ enum class ControlMessageType
 
 class TensorMemory;
 
-// System-clock for better compatibility with pybind11/chrono
-using time_point_t = std::chrono::time_point<std::chrono::system_clock>;
-
 /**
  * @brief Class representing a control message for coordinating data processing tasks.
  *
@@ -181,6 +181,15 @@ class ControlMessage
 
     ControlMessage(const ControlMessage& other);  // Copies config and metadata, but not payload
 
+    /**
+     * @brief Creates a copy of this message sharing its payload and tensors by pointer, along with its task type and
+     * timestamps. The config and tasks are shared until either message modifies them, such that cloning costs O(1)
+     * regardless of their size.
+     *
+     * @return A shared_ptr to the new ControlMessage.
+     */
+    [[nodiscard]] std::shared_ptr<ControlMessage> clone() const;
+
     /**
      * @brief Set the configuration object for the control message.
      * @param config A json object containing configuration information.
@@ -193,6 +202,14 @@ class ControlMessage
      */
     [[nodiscard]] const nlohmann::json& config() const;
 
+    /**
+     * @brief Returns the tasks and metadata of the control message as a config, such that
+     * `ControlMessage(message.to_config())` holds the same tasks, in the same order, and the same metadata. Used to send
+     * messages across process boundaries.
+     * @return A json object in the form accepted by `config`.
+     */
+    [[nodiscard]] nlohmann::json to_config() const;
+
     /**
      * @brief Add a task of the given type to the control message.
      * @param task_type A string indicating the type of the task.
@@ -208,16 +225,19 @@ class ControlMessage
     [[nodiscard]] bool has_task(const std::string& task_type) const;
 
     /**
-     * @brief Remove and return a task of the given type from the control message.
+     * @brief Remove and return the oldest task of the given type from the control message.
      * @param task_type A string indicating the type of the task.
      * @return A json object describing the task.
+     * @throws std::runtime_error If there is no task of the given type.
      */
     nlohmann::json remove_task(const std::string& task_type);
 
     /**
-     * @brief Get the tasks for the control message.
+     * @brief Get the tasks for the control message, as a json object holding an array of tasks for each task type.
+     * The view is built on each call, use `has_task` and `remove_task` on hot paths.
+     * @return A temporary, bind it to a local before iterating over it, `for (... : get_tasks().items())` dangles.
      */
-    [[nodiscard]] const nlohmann::json& get_tasks() const;
+    [[nodiscard]] nlohmann::json get_tasks() const;
 
     /**
      * @brief Add a key-value pair to the metadata for the control message.
@@ -235,8 +255,9 @@ class ControlMessage
 
     /**
      * @brief Get the metadata for the control message.
+     * @return A const reference to the json object holding every metadata entry, invalidated by `set_metadata`.
      */
-    [[nodiscard]] nlohmann::json get_metadata() const;
+    [[nodiscard]] const nlohmann::json& get_metadata() const;
 
     /**
      * @brief Get the metadata value for the given key from the control message.
@@ -249,6 +270,28 @@ class ControlMessage
      */
     [[nodiscard]] nlohmann::json get_metadata(const std::string& key, bool fail_on_nonexist = false) const;
 
+    /**
+     * @brief Looks up the metadata value for the given key without copying it.
+     *
+     * @param key A string indicating the metadata key.
+     * @return A pointer to the value, or nullptr if the key does not exist. Invalidated by `set_metadata`.
+     */
+    [[nodiscard]] const nlohmann::json* find_metadata(const std::string& key) const;
+
+    /**
+     * @brief Get the metadata value for the given key converted to `T`, without copying the json value.
+     *
+     * @param key A string indicating the metadata key.
+     * @param default_value Returned when the key does not exist.
+     * @return The converted value, or `default_value` if the key does not exist.
+     */
+    template <typename T>
+    [[nodiscard]] T get_metadata_value(const std::string& key, T default_value) const
+    {
+        const auto* value = this->find_metadata(key);
+        return value == nullptr ? std::move(default_value) : value->get<T>();
+    }
+
     /**
      * @brief Lists all metadata keys currently stored in the control message.
      *
@@ -339,6 +382,21 @@ class ControlMessage
      */
     void set_timestamp(const std::string& key, time_point_t timestamp_ns);
 
+    /**
+     * @brief Sets a timestamp for a key interned with `TimestampKeys::intern`, which neither hashes nor copies the key.
+     *
+     * @param key The interned key for which the timestamp is to be set.
+     * @param timestamp The timestamp to be associated with the key.
+     */
+    void set_timestamp(timestamp_key_t key, time_point_t timestamp_ns);
+
+    /**
+     * @brief Returns the timestamps of the message
+     *
+     * @return const MessageTimestamps&
+     */
+    const MessageTimestamps& timestamps() const;
+
     /**
      * @brief Retrieves the timestamp for a specific key.
      *
@@ -372,10 +430,27 @@ class ControlMessage
     std::shared_ptr<MessageMeta> m_payload{nullptr};
     std::shared_ptr<TensorMemory> m_tensors{nullptr};
 
-    nlohmann::json m_tasks{};
-    nlohmann::json m_config{};
+    // Queue of the tasks of each task type, in the order the types were first added. Messages carry few task types, so
+    // scanning this is cheaper than a map lookup
+    using task_queues_t = std::vector<std::pair<std::string, std::deque<nlohmann::json>>>;
+
+    /**
+     * @brief Returns the queue of tasks of `task_type`, or nullptr if no task of this type was ever added.
+     */
+    const std::deque<nlohmann::json>* find_tasks(const std::string& task_type) const;
+
+    /**
+     * @brief Returns the tasks or the config for modification, first copying them if they are shared with another
+     * message.
+     */
+    task_queues_t& mutable_tasks();
+    nlohmann::json& mutable_config();
+
+    // Copy-on-write, shared between copies of a message until either one modifies them
+    std::shared_ptr<task_queues_t> m_tasks;
+    std::shared_ptr<nlohmann::json> m_config;
 
-    std::map<std::string, time_point_t> m_timestamps{};
+    MessageTimestamps m_timestamps;
 };
 
 struct ControlMessageProxy
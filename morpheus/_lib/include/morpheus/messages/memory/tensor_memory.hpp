@@ -21,9 +21,15 @@
 #include "morpheus/types.hpp"                  // for TensorMap, TensorIndex
 #include "morpheus/utilities/cupy_util.hpp"    // for CupyUtil
 
+#include <cuda_runtime.h>      // for cudaEvent_t
 #include <pybind11/pytypes.h>  // for object
+#include <rmm/cuda_stream_view.hpp>
 
+#include <atomic>
+#include <functional>  // for function
+#include <map>
 #include <memory>  // for shared_ptr
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -46,6 +52,11 @@ namespace morpheus {
 class TensorMemory
 {
   public:
+    /**
+     * @brief Computes the value of a lazy tensor, see `set_lazy_tensor`
+     */
+    using tensor_factory_fn_t = std::function<TensorObject()>;
+
     /**
      * @brief Construct a new Tensor Memory object
      *
@@ -60,7 +71,7 @@ class TensorMemory
      * @param tensors
      */
     TensorMemory(TensorIndex count, TensorMap&& tensors);
-    virtual ~TensorMemory() = default;
+    virtual ~TensorMemory();
 
     TensorIndex count{0};
 
@@ -100,6 +111,33 @@ class TensorMemory
      */
     void set_tensor(const std::string& name, TensorObject&& tensor);
 
+    /**
+     * @brief Set the tensor identified by `name` to the one returned by `factory` the first time it is accessed, with
+     * `get_tensor`, `get_tensors` or `copy_tensor_ranges`. This lets producers defer work which only some consumers
+     * need, such as reducing the rows of each output of a model, tensors which are never accessed never being computed.
+     * `has_tensor` reports lazy tensors without computing them.
+     *
+     * @param name
+     * @param factory : Called once, by the first thread accessing the tensor, returning a tensor of `count` rows
+     */
+    void set_lazy_tensor(const std::string& name, tensor_factory_fn_t factory);
+
+    /**
+     * @brief Whether the tensor identified by `name` was set with `set_lazy_tensor` and has not been computed yet
+     *
+     * @param name
+     * @return true
+     * @return false
+     */
+    bool is_lazy_tensor(const std::string& name) const;
+
+    /**
+     * @brief Names of the tensors, including the lazy tensors which are not computed
+     *
+     * @return std::vector<std::string>
+     */
+    std::vector<std::string> tensor_names() const;
+
     /**
      * @brief Get a reference to the internal tensors map
      *
@@ -124,6 +162,36 @@ class TensorMemory
      */
     TensorMap copy_tensor_ranges(const std::vector<RangeType>& ranges, TensorIndex num_selected_rows) const;
 
+    /**
+     * @brief Device holding the tensors, the current device of the thread which created the memory
+     *
+     * @return int
+     */
+    int device_id() const;
+
+    /**
+     * @brief Records an event on `stream` marking the completion of asynchronous writes to the tensors, allowing
+     * producers to hand off the memory without synchronizing. Consumers working on another stream should call
+     * `wait_for_event`, those reading the tensors on the host or from Python `synchronize_event`.
+     *
+     * @param stream
+     */
+    void record_event(rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Makes `stream` wait on the most recently recorded event without blocking the host. Does nothing when no
+     * event was recorded.
+     *
+     * @param stream
+     */
+    void wait_for_event(rmm::cuda_stream_view stream) const;
+
+    /**
+     * @brief Blocks the host until the most recently recorded event has completed. Does nothing when no event was
+     * recorded.
+     */
+    void synchronize_event() const;
+
   protected:
     /**
      * @brief Checks if the number of rows in `tensor` matches `count`
@@ -131,7 +199,7 @@ class TensorMemory
      * @param tensor
      * @throws std::length_error If the number of rows in `tensor` do not match `count`.
      */
-    void check_tensor_length(const TensorObject& tensor);
+    void check_tensor_length(const TensorObject& tensor) const;
 
     /**
      * @brief Checks each tesnor in `tensors` verifying that the number of rows matches count
@@ -150,7 +218,23 @@ class TensorMemory
     void verify_tensor_exists(const std::string& name) const;
 
   private:
-    TensorMap m_tensors;
+    // Computes the lazy tensor identified by `name`, if any
+    void materialize_tensor(const std::string& name) const;
+
+    // Computes all of the lazy tensors
+    void materialize_tensors() const;
+
+    // Lazy tensors hold an empty placeholder until computed, such that computing one never invalidates references to
+    // the other tensors
+    mutable TensorMap m_tensors;
+    int m_device_id;
+
+    mutable std::mutex m_lazy_mutex;
+    mutable std::map<std::string, tensor_factory_fn_t> m_lazy_tensors;  // Guarded by `m_lazy_mutex`
+    mutable std::atomic<bool> m_has_lazy_tensors{false};
+
+    mutable std::mutex m_event_mutex;
+    cudaEvent_t m_event{nullptr};  // Guarded by `m_event_mutex`
 };
 
 /****** TensorMemoryInterfaceProxy *************************/
@@ -201,7 +285,8 @@ struct TensorMemoryInterfaceProxy
     static CupyUtil::py_tensor_map_t get_tensors(TensorMemory& self);
 
     /**
-     * @brief Set the tensors object converting a map of CuPy arrays to Tensors
+     * @brief Set the tensors object converting a map of CuPy arrays to Tensors. The arrays are copied in bulk, with the
+     * GIL released once for all of them.
      *
      * @param self
      * @param tensors
@@ -218,6 +303,37 @@ struct TensorMemoryInterfaceProxy
      */
     static pybind11::object get_tensor(TensorMemory& self, const std::string name);
 
+    /**
+     * @brief Get the tensor object identified by `name` without converting it to a CuPy array. The returned tensor
+     * implements `__cuda_array_interface__` and `__dlpack__`, deferring the creation of an array to its consumer.
+     *
+     * @param self
+     * @param name
+     * @return TensorObject
+     * @throws pybind11::key_error When no matching tensor exists.
+     */
+    static TensorObject get_tensor_object(TensorMemory& self, const std::string& name);
+
+    /**
+     * @brief Get the shape of the tensor identified by `name`, without creating a CuPy array
+     *
+     * @param self
+     * @param name
+     * @return ShapeType
+     * @throws pybind11::key_error When no matching tensor exists.
+     */
+    static ShapeType get_tensor_shape(TensorMemory& self, const std::string& name);
+
+    /**
+     * @brief Get the numpy type string (ex: "<f4") of the tensor identified by `name`, without creating a CuPy array
+     *
+     * @param self
+     * @param name
+     * @return std::string
+     * @throws pybind11::key_error When no matching tensor exists.
+     */
+    static std::string get_tensor_dtype(TensorMemory& self, const std::string& name);
+
     /**
      * @brief Same as `get_tensor` but used when the method is being bound to a python property
      *
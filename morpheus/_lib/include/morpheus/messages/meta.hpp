@@ -17,14 +17,20 @@
 
 #pragma once
 
-#include "morpheus/objects/data_table.hpp"  // for IDataTable
+#include "morpheus/objects/data_table.hpp"          // for IDataTable
+#include "morpheus/objects/message_timestamps.hpp"  // for MessageTimestamps, time_point_t, timestamp_key_t
 #include "morpheus/objects/table_info.hpp"
 #include "morpheus/objects/tensor_object.hpp"
 #include "morpheus/types.hpp"  // for TensorIndex
 
 #include <cudf/io/types.hpp>
 #include <pybind11/pytypes.h>
+#include <rmm/cuda_stream_view.hpp>
 
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+#include <functional>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -43,6 +49,7 @@ namespace morpheus {
  */
 
 class MutableTableCtxMgr;
+struct MessageMetaAcknowledgement;
 
 /**
  * @brief Container for class holding a data table, in practice a cudf DataFrame, with the ability to return both
@@ -98,6 +105,19 @@ class MessageMeta
      */
     virtual void set_data(const std::vector<std::string>& column_names, const std::vector<TensorObject>& tensors);
 
+    /**
+     * @brief Set the data for multiple columns from a vector of TensorObjects, enqueuing the copies on `stream` without
+     * blocking the host. Once enqueued an event is recorded on the underlying table, `get_info` orders the cudf
+     * default stream after it while consumers on other streams should use `IDataTable::wait_for_event`.
+     *
+     * @param column_names The names of the columns to set
+     * @param tensors The tensors to set the columns to
+     * @param stream The stream to copy the tensors on
+     */
+    virtual void set_data(const std::vector<std::string>& column_names,
+                          const std::vector<TensorObject>& tensors,
+                          rmm::cuda_stream_view stream);
+
     /**
      * TODO(Documentation)
      */
@@ -113,6 +133,30 @@ class MessageMeta
      */
     bool has_sliceable_index() const;
 
+    /**
+     * @brief Device holding the data of the table, the current device of the thread which created the meta. Stages
+     * processing the message should run their work on this device.
+     *
+     * @return int
+     */
+    int device_id() const;
+
+    /**
+     * @brief Moves the data of the table to pinned host memory while it waits to be processed, such as when held in a
+     * queue while device memory is scarce. The data is copied back to the device the next time the table is accessed.
+     * Only tables owned by C++ which are not being accessed are spilled, slices spill the whole table they view.
+     *
+     * @return std::size_t : Number of bytes moved to host memory, zero if the table was not spilled
+     */
+    std::size_t spill();
+
+    /**
+     * @brief Returns true while the data of the table is held in host memory
+     *
+     * @return bool
+     */
+    bool is_spilled() const;
+
     /**
      * @brief Replaces the index in the underlying dataframe if the existing one is not unique and monotonic. The old
      * index will be preserved in a column named `_index_{old_index.name}`. If `has_sliceable_index() == true`, this is
@@ -122,6 +166,39 @@ class MessageMeta
      */
     virtual std::optional<std::string> ensure_sliceable_index();
 
+    /**
+     * @brief Sets the timestamp of `key`, replacing any previous value. Slices of the meta start with a copy of the
+     * timestamps set so far.
+     *
+     * @param key The key, either a name or an id interned with `TimestampKeys::intern`
+     * @param timestamp The timestamp to be associated with the key
+     */
+    void set_timestamp(const std::string& key, time_point_t timestamp);
+    void set_timestamp(timestamp_key_t key, time_point_t timestamp);
+
+    /**
+     * @brief Returns the timestamps of the meta
+     *
+     * @return const MessageTimestamps&
+     */
+    const MessageTimestamps& timestamps() const;
+
+    /**
+     * @brief Acknowledges that the data has been fully handled, invoking the callback registered with
+     * `set_acknowledgement` at most once. Sinks call this once the data has been durably written. Releasing the meta
+     * without calling it is never treated as an acknowledgement, so data dropped by a failing or filtering stage is not
+     * acknowledged. Slices share the acknowledgement of the meta they were taken from. A no-op when no callback is set.
+     */
+    void acknowledge();
+
+    /**
+     * @brief Registers the callback invoked by `acknowledge`, replacing any previous one. Used by sources which need
+     * to know when the data they emitted has reached a sink.
+     *
+     * @param on_ack Callback to invoke on the first call to `acknowledge`
+     */
+    void set_acknowledgement(std::function<void()> on_ack);
+
     /**
      * @brief Create MessageMeta cpp object from a python object
      *
@@ -135,10 +212,24 @@ class MessageMeta
      *
      * @param data_table
      * @param index_col_count
+     * @param range_start : First value of the range index created when `index_col_count` is zero
      * @return std::shared_ptr<MessageMeta>
      */
     static std::shared_ptr<MessageMeta> create_from_cpp(cudf::io::table_with_metadata&& data_table,
-                                                        int index_col_count = 0);
+                                                        int index_col_count = 0,
+                                                        int64_t range_start = 0);
+
+    /**
+     * @brief Copies each of `tensors` into the matching column of `table_meta` with a single kernel launch on
+     * `stream`, then records an event on the table. Shared by `set_data` and `MultiMessage::set_meta`.
+     *
+     * @param table_meta The columns to write to, in the same order as `tensors`
+     * @param tensors Single column tensors holding one element per row of `table_meta`
+     * @param stream The stream to copy the tensors on
+     */
+    static void copy_tensors_to_columns(const TableInfo& table_meta,
+                                        const std::vector<TensorObject>& tensors,
+                                        rmm::cuda_stream_view stream);
 
   protected:
     MessageMeta(std::shared_ptr<IDataTable> data);
@@ -153,6 +244,9 @@ class MessageMeta
     static pybind11::object cpp_to_py(cudf::io::table_with_metadata&& table, int index_col_count = 0);
 
     std::shared_ptr<IDataTable> m_data;
+    int m_device_id;
+    MessageTimestamps m_timestamps;
+    std::shared_ptr<MessageMetaAcknowledgement> m_acknowledgement;
 };
 
 /**
@@ -297,6 +391,23 @@ struct MessageMetaInterfaceProxy
      * @return std::string The name of the column with the old index or nullopt if no changes were made.
      */
     static std::optional<std::string> ensure_sliceable_index(MessageMeta& self);
+
+    /**
+     * @brief Sets the timestamp of `key` from a datetime.datetime object
+     */
+    static void set_timestamp(MessageMeta& self, const std::string& key, pybind11::object timestamp);
+
+    /**
+     * @brief Returns the timestamp of `key` as a datetime.datetime object, or None if it does not exist and
+     * `fail_if_nonexist` is false
+     * @throws std::runtime_error if the timestamp does not exist and `fail_if_nonexist` is true
+     */
+    static pybind11::object get_timestamp(MessageMeta& self, const std::string& key, bool fail_if_nonexist = false);
+
+    /**
+     * @brief Returns a dictionary of the timestamps whose key matches `regex_filter`
+     */
+    static pybind11::dict filter_timestamp(MessageMeta& self, const std::string& regex_filter);
 };
 
 #pragma GCC visibility pop
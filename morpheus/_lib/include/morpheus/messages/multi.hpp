@@ -20,11 +20,14 @@
 #include "morpheus/messages/meta.hpp"
 #include "morpheus/objects/table_info.hpp"
 #include "morpheus/objects/tensor_object.hpp"
-#include "morpheus/types.hpp"  // for TensorIndex
+#include "morpheus/types.hpp"                     // for TensorIndex
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
 
+#include <cudf/column/column.hpp>
 #include <mrc/utils/macros.hpp>  // for MRC_PTR_CAST
 #include <pybind11/pytypes.h>
 #include <pybind11/stl.h>  // IWYU pragma: keep
+#include <rmm/cuda_stream_view.hpp>
 
 #include <memory>
 #include <string>
@@ -132,7 +135,7 @@ class DerivedMultiMessage : public BasesT...
         auto derived_this = static_cast<const DerivedT*>(this);
 
         // Use copy constructor to make a clone
-        return std::make_shared<DerivedT>(*derived_this);
+        return make_pooled<DerivedT>(*derived_this);
     }
 };
 
@@ -182,7 +185,7 @@ class DerivedMultiMessage<DerivedT, BaseT> : public BaseT
         auto derived_this = static_cast<const DerivedT*>(this);
 
         // Use copy constructor to make a clone
-        return std::make_shared<DerivedT>(*derived_this);
+        return make_pooled<DerivedT>(*derived_this);
     }
 };
 
@@ -227,7 +230,7 @@ class DerivedMultiMessage<DerivedT>
         auto derived_this = static_cast<const DerivedT*>(this);
 
         // Use copy constructor to make a clone
-        return std::make_shared<DerivedT>(*derived_this);
+        return make_pooled<DerivedT>(*derived_this);
     }
 };
 
@@ -300,6 +303,18 @@ class MultiMessage : public DerivedMultiMessage<MultiMessage>
      */
     void set_meta(const std::vector<std::string>& column_names, const std::vector<TensorObject>& tensors);
 
+    /**
+     * @brief Set the meta object with a given column names, enqueuing the copies on `stream` without blocking the
+     * host. See `MessageMeta::set_data`.
+     *
+     * @param column_names
+     * @param tensors
+     * @param stream
+     */
+    void set_meta(const std::vector<std::string>& column_names,
+                  const std::vector<TensorObject>& tensors,
+                  rmm::cuda_stream_view stream);
+
   protected:
     void get_slice_impl(std::shared_ptr<MultiMessage> new_message, TensorIndex start, TensorIndex stop) const override;
 
@@ -308,13 +323,24 @@ class MultiMessage : public DerivedMultiMessage<MultiMessage>
                           TensorIndex num_selected_rows) const override;
 
     /**
-     * @brief Creates a deep copy of `meta` with the specified ranges.
+     * @brief Creates a deep copy of `meta` with the specified ranges. Multiple ranges are copied with a single gather
+     * of the rows rather than slicing and concatenating each range.
      *
      * @param ranges
      * @return std::shared_ptr<MessageMeta>
      */
     virtual std::shared_ptr<MessageMeta> copy_meta_ranges(const std::vector<RangeType>& ranges) const;
 
+    /**
+     * @brief Expands `ranges`, offset by `offset`, into a column of row indices built on the device.
+     *
+     * @param ranges
+     * @param offset
+     * @return std::unique_ptr<cudf::column>
+     */
+    static std::unique_ptr<cudf::column> ranges_to_gather_map(const std::vector<RangeType>& ranges,
+                                                              TensorIndex offset);
+
     /**
      * @brief Applies the message offset to the elements in `ranges` casting the results to `TensorIndex`
      *
@@ -17,16 +17,29 @@
 
 #pragma once
 
+#include "morpheus/io/data_load_scheduler.hpp"
 #include "morpheus/io/data_loader.hpp"
 
 #include <mrc/modules/properties/persistent.hpp>
 #include <mrc/modules/segment_modules.hpp>
 #include <nlohmann/json.hpp>
 
+#include <cstddef>  // for size_t
+#include <memory>
 #include <string>
 
 namespace morpheus {
 #pragma GCC visibility push(default)
+/**
+ * @brief Loads the data of each incoming `ControlMessage` using the loaders listed in the `loaders` config.
+ *
+ * Messages are loaded one at a time, in order, unless `max_concurrent_loads` is greater than 1. Loads then run on a
+ * `DataLoadScheduler`, configured by:
+ * - `max_queued_loads`: messages received and not yet emitted, defaults to twice `max_concurrent_loads`
+ * - `loader_limits`: maximum number of messages loaded at once by loader id, such as `{"rest": 2}`
+ * - `preserve_order`: whether messages are emitted in the order they were received, defaults to true
+ * - `ordering_key`: metadata whose value scopes that order, messages of different values being emitted independently
+ */
 class DataLoaderModule : public mrc::modules::SegmentModule, public mrc::modules::PersistentModule
 {
     using type_t = DataLoaderModule;
@@ -42,9 +55,14 @@ class DataLoaderModule : public mrc::modules::SegmentModule, public mrc::modules
     std::string module_type_name() const override;
 
   private:
+    // Builds separate input and output nodes around `m_scheduler`
+    void initialize_concurrent(mrc::segment::IBuilder& builder);
+
     static const std::string s_config_schema;  // NOLINT
 
     DataLoader m_data_loader{};
+    std::size_t m_max_concurrent_loads{1};
+    std::unique_ptr<DataLoadScheduler> m_scheduler;
 };
 #pragma GCC visibility pop
 }  // namespace morpheus
@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+
+#include <cudf/types.hpp>
+#include <mrc/modules/properties/persistent.hpp>
+#include <mrc/modules/segment_modules.hpp>
+#include <nlohmann/json.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+#pragma GCC visibility push(default)
+/**
+ * @brief Native counterpart of the `PayloadBatcher` python module, splitting the payload of each control message into
+ * batches of at most `max_batch_size` rows, optionally grouping the rows by the values of `group_by_columns` and by the
+ * `period` holding the value of `timestamp_column_name`. Rows are grouped on the GPU with a single `cudf::groupby`, each
+ * batch being gathered into its own table such that downstream stages can modify it independently. Each batch is sent
+ * in a clone of the incoming message, with a range index starting at zero.
+ */
+class PayloadBatcherModule : public mrc::modules::SegmentModule, public mrc::modules::PersistentModule
+{
+    using type_t = PayloadBatcherModule;
+
+  public:
+    ~PayloadBatcherModule() override;
+
+    PayloadBatcherModule(std::string module_name);
+    PayloadBatcherModule(std::string module_name, nlohmann::json _config);
+
+    /**
+     * @brief Splits the payload of `message` into batches. Messages flagged as failed, or without a payload, are
+     * returned as is, as are the ones whose payload fits in a single batch when no grouping is requested.
+     *
+     * @throws std::runtime_error If a column of the configuration is missing from the payload, and `raise_on_failure`
+     * is set, otherwise the message is returned flagged as failed
+     */
+    std::vector<std::shared_ptr<ControlMessage>> batch(const std::shared_ptr<ControlMessage>& message) const;
+
+  protected:
+    void initialize(mrc::segment::IBuilder& builder) override;
+    std::string module_type_name() const override;
+
+  private:
+    std::vector<std::shared_ptr<ControlMessage>> batch_payload(const std::shared_ptr<ControlMessage>& message) const;
+
+    static const std::string s_config_schema;  // NOLINT
+
+    cudf::size_type m_max_batch_size{256};
+    bool m_raise_on_failure{false};
+    std::vector<std::string> m_group_by_columns;
+    bool m_disable_max_batch_size{false};
+    std::string m_timestamp_column_name;
+    std::string m_timestamp_pattern;
+    std::string m_period{"D"};
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,176 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/objects/data_table.hpp"  // for IDataTable
+#include "morpheus/objects/table_info_data.hpp"
+
+#include <cudf/column/column.hpp>
+#include <cudf/io/types.hpp>   // for table_with_metadata
+#include <cudf/types.hpp>      // for size_type
+#include <pybind11/pytypes.h>  // for object
+
+#include <atomic>
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** CppDataTable***************************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Implementation of `IDataTable` which owns a `cudf::table` and its metadata directly in C++. The python
+ * DataFrame is only created the first time `get_py_object()` is called (i.e. when a Python stage accesses the data or
+ * the structure of the table is modified). Until then, all accesses through `TableInfo` are served from the C++ table
+ * without acquiring the GIL.
+ *
+ * Until the conversion, the table can be spilled to pinned host memory with `spill()`, and is copied back to the
+ * device the next time it is accessed.
+ *
+ * @note Once the table has been converted to python, the python object becomes the source of truth and all further
+ * calls are forwarded to it in the same manner as `PyDataTable`.
+ */
+struct MORPHEUS_EXPORT CppDataTable : public IDataTable
+{
+    /**
+     * @brief Construct a new CppDataTable object
+     *
+     * @param table The cudf table and metadata. Ownership is transferred to this object
+     * @param index_col_count Number of leading columns in `table` which make up the index
+     * @param range_start First value of the range index created when `index_col_count` is zero
+     */
+    CppDataTable(cudf::io::table_with_metadata&& table, int index_col_count = 0, int64_t range_start = 0);
+    ~CppDataTable() override;
+
+    /**
+     * @brief cuDF table rows count
+     *
+     * @return cudf::size_type
+     */
+    cudf::size_type count() const override;
+
+    /**
+     * @brief Returns the python DataFrame for this table, converting the C++ table on the first call. Requires the GIL
+     * which will be acquired if not already held.
+     *
+     * @return const pybind11::object&
+     */
+    const pybind11::object& get_py_object() const override;
+
+    /**
+     * @brief Returns true if the table has been converted to a python DataFrame.
+     *
+     * @return bool
+     */
+    bool is_py_object_created() const;
+
+    /**
+     * @brief Returns true if the underlying index is unique and monotonic. The default range index used when
+     * `index_col_count == 0` is always sliceable, and index columns are checked on the device, without converting to
+     * python.
+     *
+     * @return bool
+     */
+    bool has_sliceable_index() const override;
+
+    /**
+     * @brief Replaces each of `column_names` with the matching entry of `columns`. Until the table has been converted
+     * to python, the columns of the C++ table are swapped without acquiring the GIL.
+     *
+     * @param column_names
+     * @param columns
+     * @return TableInfoData
+     */
+    TableInfoData replace_columns(const std::vector<std::string>& column_names,
+                                  std::vector<std::unique_ptr<cudf::column>>&& columns) const override;
+
+    /**
+     * @brief Moves the index to a first column named `column_prefix` followed by the name of the index, and replaces it
+     * with a range index starting at zero. Until the table has been converted to python, a table with a single index
+     * column is updated without the GIL, the column being renamed in place and the range index generated on the device.
+     *
+     * @param column_prefix
+     * @return TableInfoData
+     */
+    TableInfoData reset_index(const std::string& column_prefix) const override;
+
+    /**
+     * @brief Returns true while the columns of the C++ table are held in host memory.
+     *
+     * @return bool
+     */
+    bool is_spilled() const override;
+
+  private:
+    struct SpilledTable;
+
+    TableInfoData get_table_data() const override;
+
+    // Copies the columns of the C++ table to a single pinned host buffer and frees them, unless the table is already
+    // spilled or has been converted to python
+    std::size_t spill_to_host() const override;
+
+    // Copies the spilled columns back to the device, if spilled. Must be called while holding `m_spill_mutex`
+    void restore() const;
+
+    // Builds the view of the C++ table, with the index columns first
+    TableInfoData make_table_data() const;
+
+    // Mutable since the index is reset from const methods while holding the exclusive lock
+    mutable int m_index_col_count{0};
+    mutable int64_t m_range_start{0};
+
+    // The number of rows of the C++ table never changes, and is known while it is spilled
+    cudf::size_type m_num_rows{0};
+
+    // When there are no index columns, python will create a RangeIndex. To match the view that python would provide
+    // (index columns first), we materialize an equivalent sequence column. This is kept alive for the lifetime of the
+    // object since any outstanding `TableInfo` may still reference it after conversion to python. Only ever created
+    // once, either at construction or when the index is reset.
+    mutable std::unique_ptr<cudf::column> m_range_index;
+
+    // View of the C++ table. Converting to python moves the device buffers without reallocating them so this view
+    // remains valid for any `TableInfo` created before the conversion. Mutable since columns are replaced from const
+    // methods while holding the exclusive lock
+    mutable TableInfoData m_table_data;
+
+    // Mutable since the conversion to python occurs lazily from const methods. Both are only modified while holding
+    // the GIL
+    mutable std::unique_ptr<cudf::io::table_with_metadata> m_table;
+    mutable pybind11::object m_py_table;
+    mutable std::atomic<bool> m_has_py_object{false};
+
+    // Serializes spilling and restoring the C++ table. Restoring happens under the shared lock of `IDataTable`, from
+    // any number of readers at once
+    mutable std::mutex m_spill_mutex;
+    mutable std::unique_ptr<SpilledTable> m_spilled;
+    mutable std::atomic<bool> m_is_spilled{false};
+};
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <cuda_runtime.h>  // for cudaGraphExec_t
+#include <rmm/cuda_stream_view.hpp>
+
+#include <cstddef>  // for size_t
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** CudaGraphCache**************************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Cache of instantiated CUDA graphs keyed by a caller provided string, typically describing the shapes and
+ * types of the tensors the graph operates on. Used to replace a chain of small kernel launches, whose launch overhead
+ * dominates at small batch sizes, with a single graph launch.
+ *
+ * Each call to `launch` captures the work enqueued by `enqueue` into a graph. When an executable graph already exists
+ * for the key it is updated in place with the new graph, which is far cheaper than instantiating a new one and
+ * succeeds whenever the topology is unchanged, only the kernel arguments such as the buffer pointers differ. Work
+ * enqueued by `enqueue` must therefore be a pure function of the key apart from its pointers and scalar arguments, and
+ * must not allocate, free or synchronize.
+ *
+ * @note This object is thread-safe, concurrent launches with the same key instantiate separate graphs.
+ */
+class MORPHEUS_EXPORT CudaGraphCache
+{
+  public:
+    using enqueue_fn_t = std::function<void(rmm::cuda_stream_view)>;
+
+    /**
+     * @brief Construct a new CudaGraphCache
+     *
+     * @param max_entries : Maximum number of executable graphs kept, the least recently used is destroyed beyond it
+     */
+    CudaGraphCache(std::size_t max_entries = DefaultMaxEntries);
+    ~CudaGraphCache();
+
+    CudaGraphCache(const CudaGraphCache& other)            = delete;
+    CudaGraphCache& operator=(const CudaGraphCache& other) = delete;
+
+    /**
+     * @brief Captures the work enqueued by `enqueue` and launches it as a graph on `stream`. The launch is
+     * asynchronous, `stream` must be synchronized before the results are read. `stream` must not be the legacy default
+     * stream, which cannot be captured.
+     *
+     * @param key : Identifies the topology of the enqueued work
+     * @param stream : Stream passed to `enqueue` and used to launch the graph
+     * @param enqueue : Enqueues the work to capture onto the stream it is given
+     */
+    void launch(const std::string& key, rmm::cuda_stream_view stream, const enqueue_fn_t& enqueue);
+
+    /**
+     * @brief Number of executable graphs held by the cache
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Number of graphs instantiated, as opposed to updated, since the cache was created
+     *
+     * @return std::size_t
+     */
+    std::size_t num_instantiations() const;
+
+    static constexpr std::size_t DefaultMaxEntries = 16;
+
+  private:
+    struct Entry
+    {
+        cudaGraphExec_t exec{nullptr};
+        uint64_t last_used{0};
+    };
+
+    cudaGraphExec_t take(const std::string& key);
+    void put(const std::string& key, cudaGraphExec_t exec);
+
+    std::size_t m_max_entries;
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, Entry> m_entries;
+    uint64_t m_use_counter{0};
+    std::size_t m_num_instantiations{0};
+};
+
+/** @} */  // end of group
+}  // namespace morpheus
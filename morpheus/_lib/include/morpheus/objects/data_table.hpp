@@ -17,11 +17,19 @@
 
 #pragma once
 
+#include <cuda_runtime.h>  // for cudaEvent_t
+#include <cudf/column/column.hpp>
 #include <cudf/types.hpp>
 #include <pybind11/pytypes.h>
+#include <rmm/cuda_stream_view.hpp>
 
+#include <cstddef>  // for size_t
+#include <map>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <string>
+#include <vector>
 
 namespace morpheus {
 
@@ -48,8 +56,8 @@ struct IDataTable : public std::enable_shared_from_this<IDataTable>
      * @brief Construct a new IDataTable object
      *
      */
-    IDataTable()          = default;
-    virtual ~IDataTable() = default;
+    IDataTable() = default;
+    virtual ~IDataTable();
 
     /**
      * @brief cuDF dataframe rows count.
@@ -96,6 +104,95 @@ struct IDataTable : public std::enable_shared_from_this<IDataTable>
      */
     virtual const pybind11::object& get_py_object() const = 0;
 
+    /**
+     * @brief Returns true if the underlying DataFrame's index is unique and monotonic. The default implementation
+     * queries the python object. Derived classes can override this to avoid the GIL when possible.
+     *
+     * @return bool
+     */
+    virtual bool has_sliceable_index() const;
+
+    /**
+     * @brief Replaces each of `column_names` with the matching entry of `columns`, keeping the position of the
+     * columns in the table. Must only be called while holding the exclusive lock, use
+     * `MutableTableInfo::replace_columns` instead. The default implementation assigns the columns to the python
+     * DataFrame, derived classes can override this to avoid the GIL when possible.
+     *
+     * @param column_names
+     * @param columns : New columns, each with the same number of rows as the table
+     * @return TableInfoData : The information of the table after the replacement
+     */
+    virtual TableInfoData replace_columns(const std::vector<std::string>& column_names,
+                                          std::vector<std::unique_ptr<cudf::column>>&& columns) const;
+
+    /**
+     * @brief Moves the index of the table to a first column named `column_prefix` followed by the name of the index,
+     * if any, replacing it with a range index starting at zero like pandas' `reset_index`. Must only be called while
+     * holding the exclusive lock, use `MutableTableInfo::ensure_sliceable_index` instead. The default implementation
+     * resets the index of the python DataFrame, derived classes can override this to avoid the GIL when possible.
+     *
+     * @param column_prefix
+     * @return TableInfoData : The information of the table after the reset
+     */
+    virtual TableInfoData reset_index(const std::string& column_prefix) const;
+
+    /**
+     * @brief Called when a `MutableTableInfo` is created and again when it is released, the structure of the table may
+     * change in between. Derived classes caching the data of the table must drop it. The default does nothing.
+     *
+     * @param released : Whether the `MutableTableInfo` is being released
+     */
+    virtual void on_mutable_access(bool released) const;
+
+    /**
+     * @brief Records an event on `stream` for each of `column_names`, marking the completion of asynchronous writes to
+     * those columns such as the ones made by `MessageMeta::set_data`. Events are tracked per column, so writers of
+     * disjoint columns on different streams do not replace each other's events. `get_info` and `get_mutable_info`
+     * order the cudf default stream after every recorded event, consumers working on other streams should call
+     * `wait_for_event`.
+     *
+     * @param column_names
+     * @param stream
+     */
+    void record_event(const std::vector<std::string>& column_names, rmm::cuda_stream_view stream) const;
+
+    /**
+     * @brief Makes `stream` wait on the most recently recorded event of each of `column_names` without blocking the
+     * host. Columns without a recorded event are skipped.
+     *
+     * @param column_names
+     * @param stream
+     */
+    void wait_for_event(const std::vector<std::string>& column_names, rmm::cuda_stream_view stream) const;
+
+    /**
+     * @brief Makes `stream` wait on the most recently recorded event of every column without blocking the host.
+     *
+     * @param stream
+     */
+    void wait_for_event(rmm::cuda_stream_view stream) const;
+
+    /**
+     * @brief Blocks the host until the most recently recorded event of every column has completed.
+     */
+    void synchronize_event() const;
+
+    /**
+     * @brief Moves the device buffers of the table to pinned host memory, freeing the device memory until the table is
+     * next accessed through `get_info` or `get_mutable_info` which copy them back transparently. Does nothing, without
+     * blocking, while any `TableInfo` or `MutableTableInfo` object exists, and for tables which cannot be spilled.
+     *
+     * @return std::size_t : Number of bytes moved to host memory
+     */
+    std::size_t spill() const;
+
+    /**
+     * @brief Returns true while the device buffers of the table are held in host memory. The default returns false.
+     *
+     * @return bool
+     */
+    virtual bool is_spilled() const;
+
   private:
     /**
      * @brief Gets the necessary information to build a `TableInfo` object from this interface. Must be implemented by
@@ -105,9 +202,21 @@ struct IDataTable : public std::enable_shared_from_this<IDataTable>
      */
     virtual TableInfoData get_table_data() const = 0;
 
+    /**
+     * @brief Moves the device buffers of the table to host memory, called by `spill` while holding the exclusive lock
+     * once pending writes have completed. The default spills nothing.
+     *
+     * @return std::size_t : Number of bytes moved to host memory
+     */
+    virtual std::size_t spill_to_host() const;
+
     // Used to prevent locking to shared resources. Will need to be a boost fibers
     // supported mutex if we support C++ nodes with Fiber runables in the future
     mutable std::shared_mutex m_mutex{};
+
+    // Guards `m_column_events` which is updated by writers holding only a shared lock on `m_mutex`
+    mutable std::mutex m_event_mutex{};
+    mutable std::map<std::string, cudaEvent_t> m_column_events;
 };
 /** @} */  // end of group
 }  // namespace morpheus
@@ -0,0 +1,179 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/types.hpp"                // for TensorIndex
+#include "morpheus/utilities/matx_util.hpp"  // for DenseActivation
+#include "morpheus/utilities/metrics.hpp"
+
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** DenseModelStore*************************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief A fully connected layer of a model held by the `DenseModelStore`, on the host.
+ */
+struct MORPHEUS_EXPORT DenseLayer
+{
+    TensorIndex input_size{0};
+    TensorIndex output_size{0};
+
+    // Row major `output_size` by `input_size` weights, the layout of `torch.nn.Linear.weight`
+    std::vector<float> weights;
+    std::vector<float> biases;
+
+    DenseActivation activation{DenseActivation::NONE};
+};
+
+/**
+ * @brief Device resident store of many small models made of fully connected layers, such as one autoencoder per user,
+ * running the rows of any number of models with a single kernel launch per layer.
+ *
+ * Models sharing the same layer sizes and activations share an architecture, the weights of each layer of an
+ * architecture being held in a single device allocation with one slot per model. Each row of a batch is computed with
+ * the weights of its model's slot, such that the cost of a batch depends on its number of rows and architectures
+ * rather than on its number of models.
+ *
+ * Models are referred to in the input tensors by a stable integer index given by `model_index`. Models missing from the
+ * device are loaded by the `loader`, and the least recently used models are evicted once more than `max_models` are
+ * resident. Models added by `set_model` are kept on the host when there is no loader to reload them.
+ *
+ * @note This object is thread-safe, batches being run one at a time.
+ */
+class MORPHEUS_EXPORT DenseModelStore
+{
+  public:
+    using loader_fn_t = std::function<std::vector<DenseLayer>(const std::string& model_name)>;
+
+    /**
+     * @brief Construct a new Dense Model Store object
+     *
+     * @param max_models : Maximum number of models resident on the device once a batch has completed
+     * @param loader : Returns the layers of a model by name, or an empty list when there is no such model. Optional
+     * @param fallback_model_name : Model used by the rows of models which cannot be loaded, disabled when empty
+     */
+    DenseModelStore(std::size_t max_models, loader_fn_t loader = nullptr, std::string fallback_model_name = "");
+    ~DenseModelStore();
+
+    /**
+     * @brief Returns the index of the model named `model_name`, which never changes once given. The model does not
+     * need to exist yet.
+     *
+     * @param model_name
+     * @return int32_t
+     */
+    int32_t model_index(const std::string& model_name);
+
+    /**
+     * @brief Adds or replaces the model named `model_name`, copying its layers to the device.
+     *
+     * @param model_name
+     * @param layers
+     * @throws std::invalid_argument If the layers are empty, their sizes do not chain, or their weights and biases do
+     * not match their sizes
+     */
+    void set_model(const std::string& model_name, std::vector<DenseLayer> layers);
+
+    /**
+     * @brief Runs each row of the row major float32 `input` through the model of the matching entry of `model_indices`,
+     * loading the missing models first. All of the models must share the same input size, matching the number of
+     * columns of `input`, and the same output size.
+     *
+     * @param input : Device array of `model_indices.size()` rows of `input_size` values
+     * @param input_size
+     * @param model_indices : Model index of each row, as given by `model_index`
+     * @param stream
+     * @param output_size : Set to the number of columns of the output
+     * @return std::shared_ptr<rmm::device_buffer> : Row major float32 outputs, completed on return
+     * @throws std::runtime_error If a model cannot be loaded, and there is no fallback model
+     * @throws std::invalid_argument If the input or output sizes of the models differ
+     */
+    std::shared_ptr<rmm::device_buffer> infer(const float* input,
+                                              TensorIndex input_size,
+                                              const std::vector<int32_t>& model_indices,
+                                              rmm::cuda_stream_view stream,
+                                              TensorIndex& output_size);
+
+    /**
+     * @brief Number of models resident on the device.
+     *
+     * @return std::size_t
+     */
+    std::size_t num_resident() const;
+
+    /**
+     * @brief Returns true if the model named `model_name` is resident on the device.
+     *
+     * @param model_name
+     * @return bool
+     */
+    bool is_resident(const std::string& model_name) const;
+
+  private:
+    struct Architecture;
+    struct Model;
+
+    // Makes the model `index` resident, loading it if needed. Returns false when the model cannot be loaded. Must be
+    // called while holding `m_mutex`
+    bool make_resident(int32_t index, rmm::cuda_stream_view stream);
+
+    // Copies `layers` to a slot of their architecture for the model `index`. Must be called while holding `m_mutex`
+    void upload(int32_t index, const std::vector<DenseLayer>& layers, rmm::cuda_stream_view stream);
+
+    // Frees the slot of the model `index`. Must be called while holding `m_mutex`
+    void evict(int32_t index);
+
+    std::size_t m_max_models;
+    loader_fn_t m_loader;
+    std::string m_fallback_model_name;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, int32_t> m_model_indices;
+    std::vector<Model> m_models;
+    std::map<std::string, std::unique_ptr<Architecture>> m_architectures;
+
+    // Indices of the resident models, the most recently used first
+    std::list<int32_t> m_lru;
+
+    std::shared_ptr<Gauge> m_resident_gauge;
+    std::shared_ptr<Counter> m_loads;
+};
+/** @} */  // end of group
+}  // namespace morpheus
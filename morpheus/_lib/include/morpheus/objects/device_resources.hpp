@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <rmm/cuda_stream_view.hpp>
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int32_t
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** DeviceResources*************************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Device memory resource at the bottom of the stack installed by `DeviceResources`
+ */
+enum class DeviceResourceType : int32_t
+{
+    CUDA,   // cudaMalloc for every allocation
+    POOL,   // rmm pool sub-allocating a cudaMalloc'ed pool
+    ASYNC,  // cudaMallocAsync, the pool of the driver
+};
+
+/**
+ * @brief Configuration of the device memory resources and streams used by the C++ stages of a pipeline
+ */
+struct MORPHEUS_EXPORT MemoryConfig
+{
+    DeviceResourceType resource_type{DeviceResourceType::POOL};
+
+    // Initial size of the pool, half of the free device memory when zero. Ignored by `CUDA`
+    std::size_t initial_pool_size{0};
+
+    // Size the pool may grow to, unbounded when zero. Only used by `POOL`
+    std::size_t maximum_pool_size{0};
+
+    // Whether to layer an arena over the resource, which serves small allocations from per thread arenas without
+    // contending on the lock of the pool. The size of its global arena is `arena_size`, half of the free device
+    // memory when zero
+    bool use_arena{false};
+    std::size_t arena_size{0};
+
+    // Maximum number of bytes allocated at once, allocations beyond it throw `rmm::out_of_memory`. Unlimited when zero
+    std::size_t limit{0};
+
+    // Logs every allocation and deallocation to this CSV file when not empty
+    std::string log_file;
+
+    // Whether each thread uses a dedicated non-blocking stream, instead of its per-thread default stream
+    bool dedicated_streams{false};
+};
+
+/**
+ * @brief Builds the stack of device memory resources described by a `MemoryConfig` and installs it as the current
+ * resource of a device, which the stages allocate from. From the bottom up: the `resource_type` resource, the optional
+ * arena, limiting and logging adaptors. Also selects the streams returned by `stream()`.
+ *
+ * @note Must be installed before anything allocates from the current resource of the device, the resources are never
+ * destroyed since buffers may be released until the process exits.
+ */
+class MORPHEUS_EXPORT DeviceResources
+{
+  public:
+    /**
+     * @brief Installs the stack described by `config` on the current device
+     *
+     * @param config
+     * @throws std::logic_error If a stack is already installed on the current device
+     */
+    static void install(const MemoryConfig& config);
+
+    /**
+     * @brief Returns true if a stack is installed on the current device
+     *
+     * @return bool
+     */
+    static bool is_installed();
+
+    /**
+     * @brief Returns the stream the stages enqueue their work on from the calling thread. A dedicated non-blocking
+     * stream of the thread when `MemoryConfig::dedicated_streams` was set, else the per-thread default stream.
+     * Work on a non-blocking stream is not implicitly ordered with the legacy default stream.
+     *
+     * @return rmm::cuda_stream_view
+     */
+    static rmm::cuda_stream_view stream();
+};
+
+/** @} */  // end of group
+}  // namespace morpheus
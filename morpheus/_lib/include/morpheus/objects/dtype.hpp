@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <cuda_bf16.h>  // for __nv_bfloat16
+#include <cuda_fp16.h>  // for __half
 #include <cudf/types.hpp>
 
 #include <climits>  // for CHAR_BIT
@@ -58,6 +60,10 @@ enum class TypeId : int32_t
     BOOL8,    ///< Boolean using one byte per value, 0 == false, else true
     STRING,   ///< String elements, not supported by cupy
 
+    // Not supported by cudf, appended to keep the values above in sync with cudf
+    FLOAT16,   ///< 2 byte IEEE half precision floating point
+    BFLOAT16,  ///< 2 byte brain floating point, not supported by cupy
+
     //   TIMESTAMP_DAYS,          ///< point in time in days since Unix Epoch in int32
     //   TIMESTAMP_SECONDS,       ///< point in time in seconds since Unix Epoch in int64
     //   TIMESTAMP_MILLISECONDS,  ///< point in time in milliseconds since Unix Epoch in int64
@@ -96,7 +102,7 @@ struct DType
     // Returns the numpy string representation
     std::string type_str() const;
 
-    // Cudf representation
+    // Cudf representation, throws for the half precision types which cudf does not support
     cudf::type_id cudf_type_id() const;
 
     // Returns the triton string representation
@@ -147,6 +153,14 @@ struct DType
         {
             return {TypeId::UINT64};
         }
+        else if constexpr (std::is_same_v<T, __half>)
+        {
+            return {TypeId::FLOAT16};
+        }
+        else if constexpr (std::is_same_v<T, __nv_bfloat16>)
+        {
+            return {TypeId::BFLOAT16};
+        }
         else if constexpr (std::is_floating_point_v<T> && size_in_bits<T>() == 32)
         {
             return {TypeId::FLOAT32};
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/objects/table_info.hpp"     // for TableInfoBase
+#include "morpheus/objects/tensor_object.hpp"  // for TensorObject
+#include "morpheus/types.hpp"                  // for TensorIndex
+
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/mr/device/device_memory_resource.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** FeatureScalers**************************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Precomputed scaling of the features of an autoencoder, applied on the device by the `PreprocessAEStage`.
+ *
+ * Loaded once from a JSON file listing the features in the order of the model's inputs, each feature being a column
+ * of the messages scaled with a `standard` (`mean` and `std`), `minmax` (`min` and `max`), `onehot` (`vocabulary`) or
+ * `none` scaler:
+ *
+ *     {
+ *       "features": [
+ *         {"column": "logcount", "scaler": "standard", "mean": 3.2, "std": 1.1},
+ *         {"column": "locincrement", "scaler": "minmax", "min": 0, "max": 12},
+ *         {"column": "appDisplayName", "scaler": "onehot", "vocabulary": ["Office 365", "Teams"]}
+ *       ],
+ *       "users": {
+ *         "alice": {"logcount": {"mean": 2.0, "std": 0.5}}
+ *       }
+ *     }
+ *
+ * The global parameters of the standard and min-max scalers may be overridden per user. Vocabularies are global, such
+ * that every user shares the same inputs. A one-hot feature has one input per entry of its vocabulary, any other
+ * feature a single input.
+ *
+ * @note This object is thread-safe, its device copies being created on first use of each device.
+ */
+class MORPHEUS_EXPORT FeatureScalers
+{
+  public:
+    /**
+     * @brief Loads the scalers of `filename`
+     *
+     * @param filename
+     * @throws std::invalid_argument If the file cannot be opened, or does not describe valid scalers
+     */
+    explicit FeatureScalers(const std::string& filename);
+    ~FeatureScalers();
+
+    /**
+     * @brief Columns of the features, in the order of the inputs
+     *
+     * @return const std::vector<std::string>&
+     */
+    const std::vector<std::string>& feature_columns() const;
+
+    /**
+     * @brief Number of inputs built from the features
+     *
+     * @return TensorIndex
+     */
+    TensorIndex num_inputs() const;
+
+    /**
+     * @brief Returns true if `user_id` has scalers of their own
+     *
+     * @param user_id
+     * @return bool
+     */
+    bool has_user(const std::string& user_id) const;
+
+    /**
+     * @brief Builds the row major float32 `num_rows` by `num_inputs` matrix of the scaled features of `features`,
+     * along with its Nx3 `seq_ids` starting at `seq_id_offset`, with a single kernel launch. Nulls, and one-hot values
+     * missing from the vocabulary, are written as zeros. Completed on return.
+     *
+     * @param features : Table holding the columns of `feature_columns`, in order
+     * @param user_id : User whose scalers are applied, the global scalers being applied to the features they have none
+     * for, and to every feature of an unknown or empty user
+     * @param seq_id_offset
+     * @param stream
+     * @param mr : Resource of the device memory of the tensors
+     * @return std::pair<TensorObject, TensorObject> : The features and their seq ids
+     * @throws std::invalid_argument If the table does not match the features
+     */
+    std::pair<TensorObject, TensorObject> transform(const TableInfoBase& features,
+                                                    const std::string& user_id,
+                                                    TensorIndex seq_id_offset,
+                                                    rmm::cuda_stream_view stream,
+                                                    rmm::mr::device_memory_resource* mr) const;
+
+  private:
+    struct Feature;
+    struct DeviceCopy;
+
+    // Returns the copy of the scalers on the current device, creating it on first use
+    const DeviceCopy& device_copy(rmm::cuda_stream_view stream) const;
+
+    std::vector<Feature> m_features;
+    std::vector<std::string> m_feature_columns;
+    TensorIndex m_num_inputs{0};
+
+    // Shift and scale of each feature, for the global scalers followed by each user
+    std::vector<float> m_params;
+    std::unordered_map<std::string, std::size_t> m_user_params;
+
+    mutable std::mutex m_mutex;
+    mutable std::map<int, std::unique_ptr<DeviceCopy>> m_device_copies;
+};
+/** @} */  // end of group
+}  // namespace morpheus
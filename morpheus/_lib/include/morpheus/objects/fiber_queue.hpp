@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include "morpheus/objects/mpmc_ring_buffer.hpp"
+
 #include <boost/fiber/buffered_channel.hpp>
 #include <boost/fiber/channel_op_status.hpp>
 #include <pybind11/pybind11.h>  // IWYU pragma: keep
@@ -24,8 +26,12 @@
 
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace morpheus {
+class MessageMeta;
+
+#pragma GCC visibility push(default)
 /****** Component public implementations *******************/
 /****** FiberQueue****************************************/
 
@@ -37,13 +43,27 @@ namespace morpheus {
 
 /**
  * @brief This class acts as a collection or linear data structure that stores elements in FIFO (First In, First Out)
- * order
+ * order. Instantiated for python objects as `FiberQueue` and for `MessageMeta` objects as `MessageMetaFiberQueue`, the
+ * latter allowing C++ stages to exchange messages without touching python objects.
+ *
+ * Items are held either by a `boost::fibers::buffered_channel`, or by a lock-free `MpmcRingBuffer` better suited to
+ * exchanging items between threads at high rates.
  *
+ * @tparam ItemT Type of the items of the queue
  */
-class FiberQueue
+template <typename ItemT>
+class BasicFiberQueue
 {
   public:
-    FiberQueue(std::size_t max_size);
+    using item_t = ItemT;
+
+    /**
+     * @brief Construct a new queue
+     *
+     * @param max_size : Capacity of the queue, must be a power of 2
+     * @param lock_free : Whether to hold the items in a lock-free ring buffer rather than a fiber channel
+     */
+    BasicFiberQueue(std::size_t max_size, bool lock_free = false);
 
     /**
      * @brief Item to the queue. Await the acknowledgement delays based on the timeout that has been specified.
@@ -53,7 +73,7 @@ class FiberQueue
      * @param timeout
      * @return boost::fibers::channel_op_status
      */
-    boost::fibers::channel_op_status put(pybind11::object&& item, bool block = true, float timeout = 0.0);
+    boost::fibers::channel_op_status put(item_t&& item, bool block = true, float timeout = 0.0);
 
     /**
      * @brief Retrieves item from head of the queue.
@@ -63,7 +83,40 @@ class FiberQueue
      * @param timeout
      * @return boost::fibers::channel_op_status
      */
-    boost::fibers::channel_op_status get(pybind11::object& item, bool block = true, float timeout = 0.0);
+    boost::fibers::channel_op_status get(item_t& item, bool block = true, float timeout = 0.0);
+
+    /**
+     * @brief Adds `items` to the queue in order, stopping at the first one which could not be added. When blocking,
+     * `timeout` bounds the time spent waiting for all of the items rather than for each of them.
+     *
+     * @param items Items to add, the ones which could not be added are left untouched
+     * @param num_put Set to the number of items added to the queue
+     * @param block
+     * @param timeout
+     * @return boost::fibers::channel_op_status : Status of the first item which could not be added, `success` when all
+     * of them were added
+     */
+    boost::fibers::channel_op_status put_many(std::vector<item_t>& items,
+                                              std::size_t& num_put,
+                                              bool block    = true,
+                                              float timeout = 0.0);
+
+    /**
+     * @brief Retrieves up to `max_items` items from the head of the queue, appending them to `items`. The first item is
+     * awaited as `get` does. When blocking with a `timeout`, further items are awaited until `timeout` has elapsed
+     * since the call, otherwise only the items already in the queue are retrieved.
+     *
+     * @param items
+     * @param max_items
+     * @param block
+     * @param timeout
+     * @return boost::fibers::channel_op_status : `success` if at least one item was retrieved, otherwise the status of
+     * the first item
+     */
+    boost::fibers::channel_op_status get_many(std::vector<item_t>& items,
+                                              std::size_t max_items,
+                                              bool block    = true,
+                                              float timeout = 0.0);
 
     /**
      * TODO(Documentation)
@@ -81,10 +134,25 @@ class FiberQueue
     void join();
 
   private:
-    boost::fibers::buffered_channel<pybind11::object> m_queue;
+    // Calls `func` with whichever of the channel or the ring buffer holds the items
+    template <typename FuncT>
+    auto visit_queue(FuncT&& func)
+    {
+        if (m_ring)
+        {
+            return func(*m_ring);
+        }
+
+        return func(*m_channel);
+    }
+
+    std::unique_ptr<boost::fibers::buffered_channel<item_t>> m_channel;
+    std::unique_ptr<MpmcRingBuffer<item_t>> m_ring;
 };
 
-#pragma GCC visibility push(default)
+using FiberQueue            = BasicFiberQueue<pybind11::object>;              // NOLINT(readability-identifier-naming)
+using MessageMetaFiberQueue = BasicFiberQueue<std::shared_ptr<MessageMeta>>;  // NOLINT(readability-identifier-naming)
+
 /****** FiberQueueInterfaceProxy *************************/
 /**
  * @brief Interface proxy, used to insulate python bindings.
@@ -95,9 +163,10 @@ struct FiberQueueInterfaceProxy
      * @brief Create and initialize a FIberQueue, and return a shared pointer to the result
      *
      * @param max_size
+     * @param lock_free
      * @return std::shared_ptr<morpheus::FiberQueue>
      */
-    static std::shared_ptr<morpheus::FiberQueue> init(std::size_t max_size);
+    static std::shared_ptr<morpheus::FiberQueue> init(std::size_t max_size, bool lock_free = false);
 
     /**
      * TODO(Documentation)
@@ -109,6 +178,21 @@ struct FiberQueueInterfaceProxy
      */
     static pybind11::object get(morpheus::FiberQueue& self, bool block = true, float timeout = 0.0);
 
+    /**
+     * @brief Adds each of `items` to the queue, releasing the GIL once for all of them. Raises `queue.Full` or `Closed`
+     * if an item can not be added, the items preceding it having been added.
+     */
+    static void put_many(morpheus::FiberQueue& self, pybind11::list items, bool block = true, float timeout = 0.0);
+
+    /**
+     * @brief Retrieves up to `max_items` items from the queue, releasing the GIL once for all of them. Raises
+     * `queue.Empty` or `Closed` if no item could be retrieved.
+     */
+    static pybind11::list get_many(morpheus::FiberQueue& self,
+                                   std::size_t max_items,
+                                   bool block    = true,
+                                   float timeout = 0.0);
+
     /**
      * TODO(Documentation)
      */
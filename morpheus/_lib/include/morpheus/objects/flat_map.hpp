@@ -0,0 +1,333 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <algorithm>   // for lower_bound
+#include <cstddef>     // for size_t
+#include <functional>  // for less
+#include <initializer_list>
+#include <stdexcept>  // for out_of_range
+#include <tuple>      // for forward_as_tuple
+#include <utility>    // for pair, piecewise_construct
+#include <vector>
+
+namespace morpheus {
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Associative container with the interface of `std::map` for the handful of entries of a message, such as its
+ * tensors, keeping its entries in a single vector sorted by key. Looking up one of a few keys is then a binary search
+ * over contiguous memory rather than a walk through heap allocated tree nodes, and copying the map a single allocation.
+ * Lookups accept any type comparable with `KeyT`, such as a `std::string_view` or a string literal, without creating a
+ * temporary key.
+ *
+ * Entries are iterated in ascending order of key, as with `std::map`. Unlike `std::map`, inserting or erasing an entry
+ * invalidates the iterators and references to the other entries.
+ *
+ * Entries are only ever moved by constructing or swapping them, never by assigning them, since assigning some value
+ * types, such as `TensorObject`, copies their data rather than rebinding them.
+ *
+ * @tparam KeyT Type of the keys
+ * @tparam ValueT Type of the values, must be default constructible and swappable
+ * @tparam CompareT Ordering of the keys, must be transparent for heterogeneous lookups
+ */
+template <typename KeyT, typename ValueT, typename CompareT = std::less<>>
+class FlatMap
+{
+  public:
+    using key_type        = KeyT;
+    using mapped_type     = ValueT;
+    using value_type      = std::pair<KeyT, ValueT>;
+    using size_type       = std::size_t;
+    using container_t     = std::vector<value_type>;
+    using iterator        = typename container_t::iterator;
+    using const_iterator  = typename container_t::const_iterator;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+    FlatMap() = default;
+
+    FlatMap(std::initializer_list<value_type> values)
+    {
+        m_values.reserve(values.size());
+        for (const auto& value : values)
+        {
+            insert(value);
+        }
+    }
+
+    FlatMap(const FlatMap& other)     = default;
+    FlatMap(FlatMap&& other) noexcept = default;
+
+    FlatMap& operator=(const FlatMap& other)
+    {
+        // Copying into a new vector, assigning over the existing entries would assign their values
+        container_t values(other.m_values);
+        m_values.swap(values);
+        return *this;
+    }
+
+    FlatMap& operator=(FlatMap&& other) noexcept = default;
+
+    iterator begin() noexcept
+    {
+        return m_values.begin();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return m_values.begin();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return m_values.cbegin();
+    }
+
+    iterator end() noexcept
+    {
+        return m_values.end();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return m_values.end();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return m_values.cend();
+    }
+
+    bool empty() const noexcept
+    {
+        return m_values.empty();
+    }
+
+    size_type size() const noexcept
+    {
+        return m_values.size();
+    }
+
+    void clear() noexcept
+    {
+        m_values.clear();
+    }
+
+    void reserve(size_type count)
+    {
+        m_values.reserve(count);
+    }
+
+    template <typename K>
+    iterator find(const K& key)
+    {
+        auto pos = lower_bound(key);
+        return (pos != m_values.end() && !m_compare(key, pos->first)) ? pos : m_values.end();
+    }
+
+    template <typename K>
+    const_iterator find(const K& key) const
+    {
+        auto pos = lower_bound(key);
+        return (pos != m_values.end() && !m_compare(key, pos->first)) ? pos : m_values.end();
+    }
+
+    template <typename K>
+    bool contains(const K& key) const
+    {
+        return find(key) != m_values.end();
+    }
+
+    template <typename K>
+    size_type count(const K& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief Returns the value of `key`
+     *
+     * @throws std::out_of_range If the map has no such key
+     */
+    template <typename K>
+    ValueT& at(const K& key)
+    {
+        auto pos = find(key);
+        if (pos == m_values.end())
+        {
+            throw std::out_of_range("FlatMap::at");
+        }
+
+        return pos->second;
+    }
+
+    template <typename K>
+    const ValueT& at(const K& key) const
+    {
+        auto pos = find(key);
+        if (pos == m_values.end())
+        {
+            throw std::out_of_range("FlatMap::at");
+        }
+
+        return pos->second;
+    }
+
+    /**
+     * @brief Returns the value of `key`, inserting a default constructed value if the map has no such key
+     */
+    ValueT& operator[](const KeyT& key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    ValueT& operator[](KeyT&& key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    /**
+     * @brief Inserts a value constructed from `args` for `key` if the map has no such key, otherwise leaves the map
+     * untouched and `args` unused
+     *
+     * @return std::pair<iterator, bool> : The entry of `key`, and whether it was inserted
+     */
+    template <typename K, typename... ArgsT>
+    std::pair<iterator, bool> try_emplace(K&& key, ArgsT&&... args)
+    {
+        auto pos = lower_bound(key);
+        if (pos != m_values.end() && !m_compare(key, pos->first))
+        {
+            return {pos, false};
+        }
+
+        const auto index = pos - m_values.begin();
+        m_values.emplace_back(std::piecewise_construct,
+                              std::forward_as_tuple(std::forward<K>(key)),
+                              std::forward_as_tuple(std::forward<ArgsT>(args)...));
+
+        return {move_back_to(index), true};
+    }
+
+    template <typename... ArgsT>
+    std::pair<iterator, bool> emplace(ArgsT&&... args)
+    {
+        value_type value(std::forward<ArgsT>(args)...);
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return try_emplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    /**
+     * @brief Removes the entry at `pos`
+     *
+     * @return iterator : The entry following the removed one
+     */
+    iterator erase(const_iterator pos)
+    {
+        const auto index = pos - m_values.cbegin();
+
+        // Swapping the entry to the back, keeping the order of the following entries
+        using std::swap;
+        for (auto i = index; i + 1 < static_cast<decltype(index)>(m_values.size()); ++i)
+        {
+            swap(m_values[i], m_values[i + 1]);
+        }
+
+        m_values.pop_back();
+
+        return m_values.begin() + index;
+    }
+
+    iterator erase(iterator pos)
+    {
+        return erase(const_iterator(pos));
+    }
+
+    template <typename K>
+    size_type erase(const K& key)
+    {
+        auto pos = find(key);
+        if (pos == m_values.end())
+        {
+            return 0;
+        }
+
+        erase(pos);
+        return 1;
+    }
+
+    friend bool operator==(const FlatMap& lhs, const FlatMap& rhs)
+    {
+        return lhs.m_values == rhs.m_values;
+    }
+
+    friend bool operator!=(const FlatMap& lhs, const FlatMap& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+  private:
+    template <typename K>
+    iterator lower_bound(const K& key)
+    {
+        return std::lower_bound(m_values.begin(), m_values.end(), key, [this](const value_type& value, const K& k) {
+            return m_compare(value.first, k);
+        });
+    }
+
+    template <typename K>
+    const_iterator lower_bound(const K& key) const
+    {
+        return std::lower_bound(m_values.begin(), m_values.end(), key, [this](const value_type& value, const K& k) {
+            return m_compare(value.first, k);
+        });
+    }
+
+    // Moves the last entry to `index` by swapping it with the entries in between
+    iterator move_back_to(std::ptrdiff_t index)
+    {
+        using std::swap;
+        for (auto i = static_cast<std::ptrdiff_t>(m_values.size()) - 1; i > index; --i)
+        {
+            swap(m_values[i], m_values[i - 1]);
+        }
+
+        return m_values.begin() + index;
+    }
+
+    container_t m_values;
+    [[no_unique_address]] CompareT m_compare;
+};
+
+/** @} */  // end of group
+}  // namespace morpheus
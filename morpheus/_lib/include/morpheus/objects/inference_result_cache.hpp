@@ -0,0 +1,166 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/objects/dtype.hpp"
+#include "morpheus/objects/tensor_buffer_pool.hpp"
+#include "morpheus/types.hpp"  // for TensorIndex, TensorMap
+#include "morpheus/utilities/metrics.hpp"
+
+#include <cuda_runtime.h>  // for cudaEvent_t
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** InferenceResultCache********************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Device resident cache of the model outputs of individual rows, keyed by a 64-bit hash of the row's values
+ * across all of the model inputs. Lets repeated rows, such as recurring log lines, skip inference.
+ *
+ * The hashes are computed on the device and copied to the host, where an index maps each hash to a slot. The outputs of
+ * each slot stay in device memory and are copied by a single kernel per output, so neither hits nor inserts copy any
+ * outputs through host memory. Once `capacity` rows are cached, slots are evicted by the CLOCK algorithm, giving each
+ * recently hit row a second chance. Rows are identified by their hash alone, the chance of two distinct rows colliding
+ * is negligible for any practical capacity.
+ *
+ * Hits, misses and the number of cached rows are reported to the `MetricsRegistry`.
+ *
+ * @note This object is thread-safe. Work on the cache is ordered across the per-thread streams of its users by an
+ * event, without blocking the host.
+ */
+class MORPHEUS_EXPORT InferenceResultCache
+{
+  public:
+    /**
+     * @brief Outcome of a lookup, passed back to `insert` and `merge` once the rows which missed have been inferred
+     */
+    struct Lookup
+    {
+        TensorIndex num_rows{0};
+        std::vector<uint64_t> hashes;        // Hash of each row
+        std::vector<TensorIndex> hit_rows;   // Rows found in the cache, in increasing order
+        std::vector<TensorIndex> miss_rows;  // Rows missing from the cache, in increasing order
+        TensorMap hit_outputs;               // Cached outputs with one row for each of `hit_rows`
+    };
+
+    /**
+     * @brief Construct a new Inference Result Cache
+     *
+     * @param capacity : Maximum number of rows cached, must be greater than zero
+     * @param model_name : Labels the metrics of the cache
+     */
+    InferenceResultCache(std::size_t capacity, const std::string& model_name);
+    ~InferenceResultCache();
+
+    InferenceResultCache(const InferenceResultCache& other)            = delete;
+    InferenceResultCache& operator=(const InferenceResultCache& other) = delete;
+
+    /**
+     * @brief Hashes the rows of `inputs` and copies the outputs of those found into `Lookup::hit_outputs`
+     *
+     * @param inputs : 2D model inputs sharing the same number of rows
+     */
+    Lookup lookup(const TensorMap& inputs);
+
+    /**
+     * @brief Caches the outputs of the rows which missed. Outputs which are not row major are not cached.
+     *
+     * @param lookup : Result of `lookup` for the inputs
+     * @param miss_outputs : Model outputs with one row for each of `Lookup::miss_rows`
+     */
+    void insert(const Lookup& lookup, const TensorMap& miss_outputs);
+
+    /**
+     * @brief Combines the cached outputs of the rows which hit with `miss_outputs` into outputs with a row for each row
+     * of the inputs
+     *
+     * @param lookup : Result of `lookup` for the inputs
+     * @param miss_outputs : Model outputs with one row for each of `Lookup::miss_rows`
+     */
+    TensorMap merge(Lookup&& lookup, TensorMap&& miss_outputs);
+
+    /**
+     * @brief Number of rows currently cached
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Fraction of the rows looked up which were found, since the cache was created
+     */
+    double hit_rate() const;
+
+  private:
+    /**
+     * @brief Cached rows of a single model output, row `i` belonging to slot `i`
+     */
+    struct CachedOutput
+    {
+        std::string name;
+        DType dtype;
+        TensorIndex num_columns;
+        std::unique_ptr<rmm::device_buffer> rows;
+    };
+
+    // Makes the calling thread's stream wait for, and then take over, the last work on the cache
+    void acquire_stream();
+    void release_stream();
+
+    bool matches_layout(const TensorMap& outputs) const;
+    void reset_layout(const TensorMap& outputs);
+
+    // Returns the slot for a new row, evicting a row once the cache is full
+    std::size_t next_slot();
+
+    std::size_t m_capacity;
+    std::shared_ptr<TensorBufferPool> m_buffer_pool{TensorBufferPool::create()};
+
+    mutable std::mutex m_mutex;
+    std::vector<CachedOutput> m_outputs;
+    std::unordered_map<uint64_t, std::size_t> m_index;  // Slot of each cached hash
+    std::vector<uint64_t> m_slot_hashes;
+    std::vector<bool> m_slot_referenced;
+    std::size_t m_num_slots_used{0};
+    std::size_t m_clock_hand{0};
+    cudaEvent_t m_last_use;
+
+    std::size_t m_num_hits{0};
+    std::size_t m_num_lookups{0};
+
+    std::shared_ptr<Counter> m_hits_metric;
+    std::shared_ptr<Counter> m_misses_metric;
+    std::shared_ptr<Gauge> m_size_metric;
+};
+
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/utilities/metrics.hpp"
+
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/mr/device/device_memory_resource.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** MemoryGovernor********************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Device memory resource tracking the bytes allocated through it and still in use, such that sources can stop
+ * producing before the device runs out of memory. Once the live bytes rise above the high watermark the governor is
+ * throttled, and it stays throttled until they fall below the low watermark.
+ *
+ * A single governor is installed per process, as the current device resource of the device it is installed on, layered
+ * on the resource which was current until then, typically the shared pool. It should be installed before the stages are
+ * built, allocations made through resources obtained earlier are not counted. While throttled the C++
+ * `KafkaSourceStage` pauses its partitions and the C++ `HttpServerSourceStage` answers with a 503 status. The live
+ * bytes and the state are published to the `MetricsRegistry` as `morpheus_gpu_memory_live_bytes` and
+ * `morpheus_gpu_memory_throttled`, along with the `morpheus_gpu_memory_throttle_events_total` counter.
+ */
+class MORPHEUS_EXPORT MemoryGovernor final : public rmm::mr::device_memory_resource
+{
+  public:
+    /**
+     * @brief Installs the governor of the process on the current device, or updates its watermarks when it is already
+     * installed.
+     *
+     * @param high_watermark : Live bytes above which the governor is throttled
+     * @param low_watermark : Live bytes at or below which a throttled governor is released
+     * @return MemoryGovernor*
+     * @throws std::invalid_argument If the watermarks are invalid, see `set_watermarks`
+     */
+    static MemoryGovernor* install(std::size_t high_watermark, std::size_t low_watermark);
+
+    /**
+     * @brief Returns the governor of the process, or nullptr when none is installed
+     *
+     * @return MemoryGovernor*
+     */
+    static MemoryGovernor* get();
+
+    MemoryGovernor(rmm::mr::device_memory_resource* upstream,
+                   int device_id,
+                   std::size_t high_watermark,
+                   std::size_t low_watermark);
+
+    rmm::mr::device_memory_resource* get_upstream() const noexcept;
+
+    /**
+     * @brief Sets the watermarks, updating the state of the governor against the current live bytes
+     *
+     * @param high_watermark
+     * @param low_watermark
+     * @throws std::invalid_argument If `high_watermark` is zero or `low_watermark` is above it
+     */
+    void set_watermarks(std::size_t high_watermark, std::size_t low_watermark);
+
+    std::size_t high_watermark() const;
+
+    std::size_t low_watermark() const;
+
+    int64_t live_bytes() const;
+
+    bool is_throttled() const;
+
+    /**
+     * @brief Waits up to `timeout` for a throttled governor to be released
+     *
+     * @param timeout
+     * @return true When the governor is not throttled
+     */
+    bool wait_for_release(std::chrono::milliseconds timeout);
+
+  private:
+    void* do_allocate(std::size_t bytes, rmm::cuda_stream_view stream) override;
+
+    void do_deallocate(void* ptr, std::size_t bytes, rmm::cuda_stream_view stream) override;
+
+    bool do_is_equal(const rmm::mr::device_memory_resource& other) const noexcept override;
+
+    /**
+     * @brief Throttles or releases the governor according to `live_bytes`
+     */
+    void update_state(int64_t live_bytes);
+
+    rmm::mr::device_memory_resource* m_upstream;
+
+    std::atomic<std::size_t> m_high_watermark;
+    std::atomic<std::size_t> m_low_watermark;
+    std::atomic<int64_t> m_live_bytes{0};
+    std::atomic<bool> m_throttled{false};
+
+    // Only used to wake up the waiters of `wait_for_release`
+    std::mutex m_mutex;
+    std::condition_variable m_released;
+
+    std::shared_ptr<Gauge> m_live_bytes_gauge;
+    std::shared_ptr<Gauge> m_throttled_gauge;
+    std::shared_ptr<Counter> m_throttle_events;
+};
+
+/****** MemoryGovernorInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct MORPHEUS_EXPORT MemoryGovernorInterfaceProxy
+{
+    /**
+     * @brief Installs the governor of the process with watermarks given as fractions of the total memory of the
+     * current device
+     *
+     * @param high_watermark : Fraction of the device memory above which the governor is throttled
+     * @param low_watermark : Fraction of the device memory below which a throttled governor is released
+     * @return MemoryGovernor*
+     */
+    static MemoryGovernor* install(double high_watermark, double low_watermark);
+};
+/** @} */  // end of group
+}  // namespace morpheus
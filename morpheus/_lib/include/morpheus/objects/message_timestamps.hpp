@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/utilities/metrics.hpp"
+
+#include <chrono>  // for system_clock, time_point
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>  // for pair
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** MessageTimestamps***********************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+// System-clock for better compatibility with pybind11/chrono
+using time_point_t = std::chrono::time_point<std::chrono::system_clock>;
+
+using timestamp_key_t = uint32_t;
+
+/**
+ * @brief Process wide table of the timestamp keys, mapping each key name to a small integer id. Stamping a message with
+ * a key interned ahead of time neither hashes nor copies its name.
+ */
+class MORPHEUS_EXPORT TimestampKeys
+{
+  public:
+    /**
+     * @brief Returns the id of `name`, adding it to the table the first time it is seen
+     */
+    static timestamp_key_t intern(const std::string& name);
+
+    /**
+     * @brief Returns the id of `name` without adding it to the table, or nullopt if it was never interned
+     */
+    static std::optional<timestamp_key_t> find(const std::string& name);
+
+    /**
+     * @brief Returns the name of an interned key
+     * @throws std::out_of_range if `key` was not returned by `intern`
+     */
+    static const std::string& name(timestamp_key_t key);
+
+    /**
+     * @brief Keys stamped by the pipeline when a message enters and exits the stage `stage_name`
+     */
+    static std::string entry_key(const std::string& stage_name);
+    static std::string exit_key(const std::string& stage_name);
+};
+
+/**
+ * @brief Timestamps carried by a message, keyed by interned ids in the order they were first set. Messages carry a
+ * handful of timestamps, so scanning them is cheaper than a map lookup.
+ *
+ * @note This object is thread-safe, a message may be stamped by the stages of several branches at once.
+ */
+class MORPHEUS_EXPORT MessageTimestamps
+{
+  public:
+    MessageTimestamps() = default;
+    MessageTimestamps(const MessageTimestamps& other);
+    MessageTimestamps& operator=(const MessageTimestamps& other);
+
+    /**
+     * @brief Sets the timestamp of `key`, replacing any previous value
+     */
+    void set(timestamp_key_t key, time_point_t timestamp);
+    void set(const std::string& key, time_point_t timestamp);
+
+    std::optional<time_point_t> get(timestamp_key_t key) const;
+    std::optional<time_point_t> get(const std::string& key) const;
+
+    /**
+     * @brief Returns the timestamps whose key matches `regex_filter`. The compiled expressions are cached per thread.
+     */
+    std::map<std::string, time_point_t> filter(const std::string& regex_filter) const;
+
+    /**
+     * @brief Returns a copy of the timestamps, in the order they were first set
+     */
+    std::vector<std::pair<timestamp_key_t, time_point_t>> entries() const;
+
+  private:
+    mutable std::mutex m_mutex;
+    std::vector<std::pair<timestamp_key_t, time_point_t>> m_entries;
+};
+
+/**
+ * @brief Records the timestamps of the messages reaching a sink to the `MetricsRegistry`. Each recorded message adds
+ * the time since its earliest timestamp to `morpheus_message_latency_seconds` labeled with the sink, and the time
+ * between the entry and exit timestamps of each stage it went through to `morpheus_stage_latency_seconds` labeled with
+ * the stage.
+ */
+class MORPHEUS_EXPORT TimestampTraceExporter
+{
+  public:
+    explicit TimestampTraceExporter(std::string sink_name);
+
+    void record(const std::vector<std::pair<timestamp_key_t, time_point_t>>& entries,
+                time_point_t now = std::chrono::system_clock::now());
+
+  private:
+    struct StageLatency
+    {
+        std::optional<timestamp_key_t> entry_key;
+        std::shared_ptr<Histogram> histogram;
+    };
+
+    // Resolves the stage an exit key belongs to the first time it is recorded
+    const StageLatency& stage_latency(timestamp_key_t exit_key);
+
+    std::string m_sink_name;
+    std::shared_ptr<Histogram> m_message_latency;
+
+    std::mutex m_mutex;
+    std::unordered_map<timestamp_key_t, StageLatency> m_stage_latencies;
+};
+
+/****** TimestampTraceExporterInterfaceProxy****************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct MORPHEUS_EXPORT TimestampTraceExporterInterfaceProxy
+{
+    /**
+     * @brief Records the timestamps of a message implemented in Python, as returned by `filter_timestamp`
+     */
+    static void record(TimestampTraceExporter& self, const std::map<std::string, time_point_t>& timestamps);
+};
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,349 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <boost/fiber/channel_op_status.hpp>
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/mutex.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>  // for intptr_t
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace morpheus {
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Bounded multi-producer multi-consumer queue, exposing the interface of `boost::fibers::buffered_channel`.
+ * Items are exchanged through a ring of slots, each with a sequence number telling whether it holds an item, such that
+ * producers and consumers only contend on a compare and swap of their position in the ring. Threads and fibers only park
+ * on a fiber aware condition variable when the ring is full or empty, which producers and consumers only notify when
+ * someone is waiting.
+ *
+ * Unlike `buffered_channel`, which holds at most `capacity - 1` items, the ring holds `capacity` items.
+ *
+ * @tparam ItemT Type of the items, must be default constructible and move assignable
+ */
+template <typename ItemT>
+class MpmcRingBuffer
+{
+  public:
+    using item_t       = ItemT;
+    using clock_type_t = std::chrono::steady_clock;
+
+    /**
+     * @brief Construct a new ring buffer
+     *
+     * @param capacity : Number of slots of the ring, must be a power of 2
+     * @throws std::invalid_argument If `capacity` is not a power of 2
+     */
+    explicit MpmcRingBuffer(std::size_t capacity) : m_mask(capacity - 1)
+    {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+        {
+            throw std::invalid_argument("capacity must be greater than 1 and a power of 2.");
+        }
+
+        m_slots = std::make_unique<Slot[]>(capacity);
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRingBuffer(const MpmcRingBuffer&)            = delete;
+    MpmcRingBuffer& operator=(const MpmcRingBuffer&) = delete;
+
+    boost::fibers::channel_op_status try_push(item_t&& item)
+    {
+        auto status = try_push_slot(std::move(item));
+        if (status == boost::fibers::channel_op_status::success)
+        {
+            notify_waiters(m_num_waiting_consumers, m_not_empty);
+        }
+
+        return status;
+    }
+
+    boost::fibers::channel_op_status try_pop(item_t& item)
+    {
+        auto status = try_pop_slot(item);
+        if (status == boost::fibers::channel_op_status::success)
+        {
+            notify_waiters(m_num_waiting_producers, m_not_full);
+        }
+
+        return status;
+    }
+
+    boost::fibers::channel_op_status push(item_t&& item)
+    {
+        return push_until(std::move(item), std::nullopt);
+    }
+
+    template <typename ClockT, typename DurationT>
+    boost::fibers::channel_op_status push_wait_until(item_t&& item,
+                                                     const std::chrono::time_point<ClockT, DurationT>& deadline)
+    {
+        return push_until(std::move(item), to_steady_deadline(deadline));
+    }
+
+    boost::fibers::channel_op_status pop(item_t& item)
+    {
+        return pop_until(item, std::nullopt);
+    }
+
+    template <typename ClockT, typename DurationT>
+    boost::fibers::channel_op_status pop_wait_until(item_t& item,
+                                                    const std::chrono::time_point<ClockT, DurationT>& deadline)
+    {
+        return pop_until(item, to_steady_deadline(deadline));
+    }
+
+    /**
+     * @brief Closes the ring, waking up every waiting producer and consumer. Pushing to a closed ring fails, while the
+     * items it holds can still be popped.
+     */
+    void close()
+    {
+        m_closed.store(true, std::memory_order_seq_cst);
+
+        std::lock_guard<boost::fibers::mutex> lock(m_wait_mutex);
+        m_not_empty.notify_all();
+        m_not_full.notify_all();
+    }
+
+    bool is_closed() const
+    {
+        return m_closed.load(std::memory_order_acquire);
+    }
+
+  private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence{0};
+        item_t item{};
+    };
+
+    // Claims the next free slot, without notifying waiting consumers
+    boost::fibers::channel_op_status try_push_slot(item_t&& item)
+    {
+        if (is_closed())
+        {
+            return boost::fibers::channel_op_status::closed;
+        }
+
+        std::size_t position = m_push_position.load(std::memory_order_relaxed);
+        Slot* slot           = nullptr;
+        while (true)
+        {
+            slot            = &m_slots[position & m_mask];
+            const auto diff = static_cast<std::intptr_t>(slot->sequence.load(std::memory_order_acquire)) -
+                              static_cast<std::intptr_t>(position);
+            if (diff == 0)
+            {
+                if (m_push_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The slot still holds the item pushed one lap ago
+                return boost::fibers::channel_op_status::full;
+            }
+            else
+            {
+                position = m_push_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Only moved from once a slot has been claimed
+        slot->item = std::move(item);
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        return boost::fibers::channel_op_status::success;
+    }
+
+    // Takes the item of the next full slot, without notifying waiting producers
+    boost::fibers::channel_op_status try_pop_slot(item_t& item)
+    {
+        std::size_t position = m_pop_position.load(std::memory_order_relaxed);
+        Slot* slot           = nullptr;
+        while (true)
+        {
+            slot            = &m_slots[position & m_mask];
+            const auto diff = static_cast<std::intptr_t>(slot->sequence.load(std::memory_order_acquire)) -
+                              static_cast<std::intptr_t>(position + 1);
+            if (diff == 0)
+            {
+                if (m_pop_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // Items pushed before closing the ring can still be popped
+                return is_closed() ? boost::fibers::channel_op_status::closed
+                                   : boost::fibers::channel_op_status::empty;
+            }
+            else
+            {
+                position = m_pop_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        item = std::move(slot->item);
+        slot->sequence.store(position + m_mask + 1, std::memory_order_release);
+
+        return boost::fibers::channel_op_status::success;
+    }
+
+    template <typename ClockT, typename DurationT>
+    static clock_type_t::time_point to_steady_deadline(const std::chrono::time_point<ClockT, DurationT>& deadline)
+    {
+        return clock_type_t::now() + std::chrono::duration_cast<clock_type_t::duration>(deadline - ClockT::now());
+    }
+
+    boost::fibers::channel_op_status push_until(item_t&& item, std::optional<clock_type_t::time_point> deadline)
+    {
+        // Fast path, the ring has a free slot or is closed
+        auto status = try_push(std::move(item));
+        if (status != boost::fibers::channel_op_status::full)
+        {
+            return status;
+        }
+
+        status = wait_until(m_num_waiting_producers, m_not_full, deadline, [&]() {
+            return try_push_slot(std::move(item));
+        });
+
+        if (status == boost::fibers::channel_op_status::success)
+        {
+            notify_waiters(m_num_waiting_consumers, m_not_empty);
+        }
+
+        return status;
+    }
+
+    boost::fibers::channel_op_status pop_until(item_t& item, std::optional<clock_type_t::time_point> deadline)
+    {
+        // Fast path, the ring holds an item or is closed
+        auto status = try_pop(item);
+        if (status != boost::fibers::channel_op_status::empty)
+        {
+            return status;
+        }
+
+        status = wait_until(m_num_waiting_consumers, m_not_empty, deadline, [&]() {
+            return try_pop_slot(item);
+        });
+
+        if (status == boost::fibers::channel_op_status::success)
+        {
+            notify_waiters(m_num_waiting_producers, m_not_full);
+        }
+
+        return status;
+    }
+
+    // Parks until `attempt` succeeds or fails for another reason than the ring being full or empty. Waiters register
+    // themselves before attempting, while holding the wait mutex, and notifiers check for waiters after publishing
+    // their change, such that either the attempt sees the change or the notifier sees the waiter. Waiters notify the
+    // other side once they have released the mutex.
+    template <typename AttemptT>
+    boost::fibers::channel_op_status wait_until(std::atomic<std::size_t>& num_waiting,
+                                                boost::fibers::condition_variable& condition,
+                                                const std::optional<clock_type_t::time_point>& deadline,
+                                                AttemptT&& attempt)
+    {
+        std::unique_lock<boost::fibers::mutex> lock(m_wait_mutex);
+        num_waiting.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        boost::fibers::channel_op_status status;
+        while (true)
+        {
+            status = attempt();
+            if (status == boost::fibers::channel_op_status::success ||
+                status == boost::fibers::channel_op_status::closed)
+            {
+                break;
+            }
+
+            if (!deadline.has_value())
+            {
+                condition.wait(lock);
+            }
+            else if (condition.wait_until(lock, *deadline) == boost::fibers::cv_status::timeout)
+            {
+                status = attempt();
+                if (status != boost::fibers::channel_op_status::success &&
+                    status != boost::fibers::channel_op_status::closed)
+                {
+                    status = boost::fibers::channel_op_status::timeout;
+                }
+
+                break;
+            }
+        }
+
+        num_waiting.fetch_sub(1, std::memory_order_relaxed);
+
+        return status;
+    }
+
+    void notify_waiters(const std::atomic<std::size_t>& num_waiting, boost::fibers::condition_variable& condition)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (num_waiting.load(std::memory_order_relaxed) > 0)
+        {
+            // Taking the mutex ensures the waiter is either parked or has yet to make its attempt
+            std::lock_guard<boost::fibers::mutex> lock(m_wait_mutex);
+            condition.notify_one();
+        }
+    }
+
+    const std::size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+
+    // Kept on their own cache lines, producers and consumers only contending with each other
+    alignas(64) std::atomic<std::size_t> m_push_position{0};
+    alignas(64) std::atomic<std::size_t> m_pop_position{0};
+    alignas(64) std::atomic<bool> m_closed{false};
+
+    std::atomic<std::size_t> m_num_waiting_producers{0};
+    std::atomic<std::size_t> m_num_waiting_consumers{0};
+    boost::fibers::mutex m_wait_mutex;
+    boost::fibers::condition_variable m_not_full;
+    boost::fibers::condition_variable m_not_empty;
+};
+
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <cstddef>  // for size_t
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** PinnedHostBuffer************************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Growable byte buffer backed by page-locked (pinned) host memory. Intended to be reused across batches so
+ * that host to device copies of the contents can be performed without an additional staging copy by the CUDA driver.
+ * The allocation is only grown, never shrunk, so after a short warm-up no further allocations are made.
+ *
+ * When given a NUMA node, such as the node local to the GPU the contents are copied to, the pages are bound to that
+ * node rather than to the node of the allocating thread, see `TopologyUtil`.
+ *
+ * @note This object is not thread-safe. Each thread/runnable should own its own buffer.
+ */
+class MORPHEUS_EXPORT PinnedHostBuffer
+{
+  public:
+    /**
+     * @brief Construct a new PinnedHostBuffer object
+     *
+     * @param initial_capacity : Number of bytes to reserve up-front
+     * @param numa_node : NUMA node the pages are allocated on, -1 for the node of the allocating thread
+     */
+    PinnedHostBuffer(std::size_t initial_capacity = 0, int numa_node = -1);
+    ~PinnedHostBuffer();
+
+    PinnedHostBuffer(const PinnedHostBuffer& other)            = delete;
+    PinnedHostBuffer& operator=(const PinnedHostBuffer& other) = delete;
+
+    PinnedHostBuffer(PinnedHostBuffer&& other) noexcept;
+    PinnedHostBuffer& operator=(PinnedHostBuffer&& other) noexcept;
+
+    /**
+     * @brief Pointer to the start of the buffer
+     *
+     * @return char*
+     */
+    char* data();
+
+    /**
+     * @brief Pointer to the start of the buffer
+     *
+     * @return const char*
+     */
+    const char* data() const;
+
+    /**
+     * @brief Number of bytes currently stored in the buffer
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Number of bytes which can be stored before a reallocation is required
+     *
+     * @return std::size_t
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief NUMA node the pages are allocated on, -1 when not bound to a node
+     *
+     * @return int
+     */
+    int numa_node() const;
+
+    /**
+     * @brief Returns true if the buffer contains no data
+     *
+     * @return bool
+     */
+    bool empty() const;
+
+    /**
+     * @brief Sets the size to zero without releasing the allocation
+     */
+    void clear();
+
+    /**
+     * @brief Ensures the buffer can hold at least `new_capacity` bytes. Existing contents are preserved.
+     *
+     * @param new_capacity
+     */
+    void reserve(std::size_t new_capacity);
+
+    /**
+     * @brief Appends `num_bytes` from `data` to the end of the buffer
+     *
+     * @param data
+     * @param num_bytes
+     */
+    void append(const char* data, std::size_t num_bytes);
+
+    /**
+     * @brief Appends a single character to the end of the buffer
+     *
+     * @param c
+     */
+    void push_back(char c);
+
+    /**
+     * @brief Sets the size to `new_size`, growing the allocation if needed. Bytes past the previous size are left
+     * uninitialized, to be written in place through `data`.
+     *
+     * @param new_size
+     */
+    void resize(std::size_t new_size);
+
+  private:
+    void release();
+
+    char* m_data{nullptr};
+    std::size_t m_size{0};
+    std::size_t m_capacity{0};
+    int m_numa_node{-1};
+    bool m_is_registered{false};  // Mapped and registered with CUDA when bound to a NUMA node
+};
+
+/** @} */  // end of group
+}  // namespace morpheus
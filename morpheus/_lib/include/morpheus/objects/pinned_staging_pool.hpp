@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/objects/pinned_host_buffer.hpp"
+
+#include <cuda_runtime.h>  // for cudaEvent_t
+#include <rmm/cuda_stream_view.hpp>
+
+#include <cstddef>  // for size_t
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** PinnedStagingBuffer*********************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief A pinned host buffer leased from the `PinnedStagingPool`, used to stage asynchronous copies between host
+ * and device memory. After enqueueing copies using the buffer call `record` on the same stream, the buffer can then
+ * be waited on with `synchronize`. The buffer is synchronized before being returned to the pool, so it is never
+ * reused while a copy is still in flight.
+ */
+class MORPHEUS_EXPORT PinnedStagingBuffer
+{
+  public:
+    /**
+     * @brief Construct a new PinnedStagingBuffer object
+     *
+     * @param numa_node : NUMA node the buffer is allocated on, -1 for the node of the allocating thread
+     */
+    PinnedStagingBuffer(int numa_node = -1);
+    ~PinnedStagingBuffer();
+
+    PinnedStagingBuffer(const PinnedStagingBuffer& other)            = delete;
+    PinnedStagingBuffer& operator=(const PinnedStagingBuffer& other) = delete;
+
+    /**
+     * @brief Pointer to the start of the buffer
+     *
+     * @return char*
+     */
+    char* data();
+
+    /**
+     * @brief Pointer to the start of the buffer
+     *
+     * @return const char*
+     */
+    const char* data() const;
+
+    /**
+     * @brief Number of bytes requested when the buffer was leased
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Records an event on `stream` marking the completion of the copies enqueued on it using this buffer
+     *
+     * @param stream
+     */
+    void record(rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Blocks until the copies preceding the last call to `record` have completed. A no-op if `record` has not
+     * been called since the buffer was leased.
+     */
+    void synchronize();
+
+  private:
+    void reset(std::size_t size);
+
+    PinnedHostBuffer m_buffer;
+    std::size_t m_size{0};
+    cudaEvent_t m_event{nullptr};
+    bool m_is_recorded{false};
+
+    friend class PinnedStagingPool;
+};
+
+/****** PinnedStagingPool***********************************/
+/**
+ * @brief Process wide pool of pinned host buffers used to stage device to host and host to device transfers, which
+ * pageable memory limits to a fraction of the available bandwidth and forces to be synchronous. Leased buffers are
+ * returned to the pool once the last reference to them is released. Buffers are only grown, never shrunk, so after a
+ * short warm-up no further pinned allocations are made.
+ *
+ * A pool may allocate its buffers on a given NUMA node, `get_local_instance` returning the pool local to the current
+ * GPU, such that copies to the GPU do not cross the socket interconnect of multi-socket hosts.
+ *
+ * @note This object is thread-safe.
+ */
+class MORPHEUS_EXPORT PinnedStagingPool : public std::enable_shared_from_this<PinnedStagingPool>
+{
+  public:
+    /**
+     * @brief Create a new PinnedStagingPool, most callers should use the shared pool from `get_instance`
+     *
+     * @param max_idle_buffers : Maximum number of idle buffers kept by the pool, buffers returned beyond it are freed
+     * @param numa_node : NUMA node the buffers are allocated on, -1 for the node of the allocating thread
+     * @return std::shared_ptr<PinnedStagingPool>
+     */
+    static std::shared_ptr<PinnedStagingPool> create(std::size_t max_idle_buffers = DefaultMaxIdleBuffers,
+                                                     int numa_node                = -1);
+
+    /**
+     * @brief Returns the pool shared by the process
+     *
+     * @return PinnedStagingPool&
+     */
+    static PinnedStagingPool& get_instance();
+
+    /**
+     * @brief Returns the pool shared by the process allocating its buffers on the NUMA node local to the current GPU,
+     * or the pool of `get_instance` when the node of the GPU is unknown. The placement of each pool is logged once
+     * on creation.
+     *
+     * @return PinnedStagingPool&
+     */
+    static PinnedStagingPool& get_local_instance();
+
+    PinnedStagingPool(const PinnedStagingPool& other)            = delete;
+    PinnedStagingPool& operator=(const PinnedStagingPool& other) = delete;
+
+    /**
+     * @brief Leases a buffer of at least `bytes` bytes, reusing the smallest idle buffer which is large enough, or
+     * else growing the largest one
+     *
+     * @param bytes
+     * @return std::shared_ptr<PinnedStagingBuffer>
+     */
+    std::shared_ptr<PinnedStagingBuffer> acquire(std::size_t bytes);
+
+    /**
+     * @brief Number of idle buffers held by the pool
+     *
+     * @return std::size_t
+     */
+    std::size_t num_idle_buffers() const;
+
+    /**
+     * @brief NUMA node the buffers are allocated on, -1 when not bound to a node
+     *
+     * @return int
+     */
+    int numa_node() const;
+
+    static constexpr std::size_t DefaultMaxIdleBuffers = 64;
+
+  private:
+    PinnedStagingPool(std::size_t max_idle_buffers, int numa_node);
+
+    void release(std::unique_ptr<PinnedStagingBuffer>&& buffer);
+
+    std::size_t m_max_idle_buffers;
+    int m_numa_node;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<PinnedStagingBuffer>> m_idle_buffers;
+};
+
+/** @} */  // end of group
+}  // namespace morpheus
@@ -23,6 +23,10 @@
 #include <cudf/types.hpp>      // for size_type
 #include <pybind11/pytypes.h>  // for object
 
+#include <cstddef>  // for size_t
+#include <mutex>
+#include <optional>
+
 namespace morpheus {
 /****** Component public implementations *******************/
 /****** PyDataTable****************************************/
@@ -34,7 +38,9 @@ namespace morpheus {
  */
 
 /**
- * TODO(Documentation)
+ * @brief Data table wrapping a python DataFrame. The `TableInfoData` extracted from the DataFrame is cached, such that
+ * only the first read of the table requires the GIL. The cache is dropped whenever a `MutableTableInfo` is created and
+ * released, changes to the structure of the DataFrame must be made through one.
  */
 struct PyDataTable : public IDataTable
 {
@@ -60,10 +66,19 @@ struct PyDataTable : public IDataTable
      */
     const pybind11::object& get_py_object() const override;
 
+    void on_mutable_access(bool released) const override;
+
   private:
     TableInfoData get_table_data() const override;
 
     pybind11::object m_py_table;
+
+    // The cache mutex is never held while acquiring the GIL, as callers may already hold the GIL
+    mutable std::mutex m_cache_mutex;
+    mutable std::optional<TableInfoData> m_table_data;
+    // Incremented whenever the cache is dropped, so that data extracted before then is not cached
+    mutable std::size_t m_cache_generation{0};
+    mutable bool m_is_mutable{false};
 };
 /** @} */  // end of group
 }  // namespace morpheus
@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/utilities/metrics.hpp"
+
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/mr/device/device_memory_resource.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** StageMemoryResource********************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Device memory resource attributing the allocations of a stage, layered on the device resource which was current
+ * when it was created, typically the shared pool. The bytes currently allocated, their peak and the number of
+ * allocations are tracked without a lock and published to the `MetricsRegistry` as
+ * `morpheus_stage_gpu_memory_bytes`, `morpheus_stage_gpu_memory_peak_bytes` and
+ * `morpheus_stage_gpu_allocations_total`, labeled with the stage and the device.
+ *
+ * Buffers routinely outlive the stage allocating them, such as the tensors of a message held by a sink, so resources
+ * are obtained from `get` and live until the process exits. The memory of a stage is then the memory it allocated which
+ * is still in use anywhere in the pipeline.
+ */
+class MORPHEUS_EXPORT StageMemoryResource final : public rmm::mr::device_memory_resource
+{
+  public:
+    /**
+     * @brief Returns the resource of `stage_name` on the current device, created on first use
+     *
+     * @param stage_name : Label of the allocations, all the instances of a stage share its resource
+     * @return StageMemoryResource*
+     */
+    static StageMemoryResource* get(const std::string& stage_name);
+
+    StageMemoryResource(std::string stage_name, int device_id, rmm::mr::device_memory_resource* upstream);
+
+    rmm::mr::device_memory_resource* get_upstream() const noexcept;
+
+    int64_t current_bytes() const;
+
+    int64_t peak_bytes() const;
+
+    uint64_t allocation_count() const;
+
+  private:
+    void* do_allocate(std::size_t bytes, rmm::cuda_stream_view stream) override;
+
+    void do_deallocate(void* ptr, std::size_t bytes, rmm::cuda_stream_view stream) override;
+
+    bool do_is_equal(const rmm::mr::device_memory_resource& other) const noexcept override;
+
+    rmm::mr::device_memory_resource* m_upstream;
+
+    std::atomic<int64_t> m_current_bytes{0};
+    std::atomic<int64_t> m_peak_bytes{0};
+    std::atomic<uint64_t> m_allocation_count{0};
+
+    std::shared_ptr<Gauge> m_current_bytes_gauge;
+    std::shared_ptr<Gauge> m_peak_bytes_gauge;
+    std::shared_ptr<Counter> m_allocations_total;
+};
+/** @} */  // end of group
+}  // namespace morpheus
@@ -22,10 +22,12 @@
 #include "morpheus/objects/dtype.hpp"
 #include "morpheus/objects/table_info_data.hpp"
 
+#include <cudf/column/column.hpp>
 #include <cudf/column/column_view.hpp>  // for column_view
 #include <cudf/table/table_view.hpp>
 #include <cudf/types.hpp>      // for size_type
 #include <pybind11/pytypes.h>  // for object
+#include <rmm/cuda_stream_view.hpp>
 
 #include <memory>
 #include <mutex>
@@ -108,6 +110,22 @@ struct MORPHEUS_EXPORT TableInfoBase
      */
     bool has_sliceable_index() const;
 
+    /**
+     * @brief Records an event on `stream` in the underlying table for each column of this table, marking the
+     * completion of asynchronous writes made to them on `stream`. See `IDataTable::record_event`.
+     *
+     * @param stream
+     */
+    void record_event(rmm::cuda_stream_view stream) const;
+
+    /**
+     * @brief Makes `stream` wait on the most recent events recorded in the underlying table for the columns of this
+     * table. See `IDataTable::wait_for_event`.
+     *
+     * @param stream
+     */
+    void wait_for_event(rmm::cuda_stream_view stream) const;
+
   protected:
     TableInfoBase() = default;
 
@@ -180,6 +198,17 @@ struct MORPHEUS_EXPORT MutableTableInfo : public TableInfoBase
      */
     void insert_missing_columns(const std::vector<std::tuple<std::string, morpheus::DType>>& columns);
 
+    /**
+     * @brief Replaces each of `column_names` with the matching entry of `columns`, keeping the position of the
+     * columns. Tables created in C++ which have not been converted to python are updated without the GIL. Must be
+     * called on the info of the entire table, not a slice of it.
+     *
+     * @param column_names : Names of existing columns
+     * @param columns : New columns, each with the same number of rows as the table
+     */
+    void replace_columns(const std::vector<std::string>& column_names,
+                         std::vector<std::unique_ptr<cudf::column>>&& columns);
+
     /**
      * @brief Allows the python object to be "checked out" which gives exclusive access to the python object during the
      * lifetime of `MutableTableInfo`. Use this method when it is necessary to make changes to the python object using
@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/objects/memory_descriptor.hpp"
+
+#include <cuda_runtime.h>  // for cudaEvent_t
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>  // for size_t
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** TensorBufferPool************************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Pool of device buffers keyed by their size in bytes, intended to be owned by a stage which allocates tensors
+ * of the same shapes for every batch. Buffers handed out by `get_buffer` return themselves to the pool once the last
+ * reference to them is released, typically when the `TensorMemory` holding them is destroyed along with its message,
+ * so steady-state pipelines stop allocating after the first few batches. Buffers returned after the pool has been
+ * destroyed are freed.
+ *
+ * All buffers are allocated on the stream and memory resource of the pool's memory descriptor. When a buffer is
+ * released an event is recorded on that stream, as seen by the releasing thread, and the stream of the thread reusing
+ * the buffer waits on it, so work enqueued by the previous owner completes before the buffer is reused without blocking
+ * the host. Work enqueued on any other stream must be synchronized before the buffer is released.
+ *
+ * @note This object is thread-safe.
+ */
+class MORPHEUS_EXPORT TensorBufferPool : public std::enable_shared_from_this<TensorBufferPool>
+{
+  public:
+    /**
+     * @brief Create a new TensorBufferPool
+     *
+     * @param mem_descriptor : Stream and memory resource used to allocate the buffers
+     * @param max_cached_bytes : Upper bound on the bytes held by idle buffers, buffers returned beyond it are freed
+     * @return std::shared_ptr<TensorBufferPool>
+     */
+    static std::shared_ptr<TensorBufferPool> create(std::shared_ptr<MemoryDescriptor> mem_descriptor,
+                                                    std::size_t max_cached_bytes = DefaultMaxCachedBytes);
+
+    /**
+     * @brief Create a new TensorBufferPool allocating on `rmm::cuda_stream_per_thread` from the current device
+     * resource
+     *
+     * @param max_cached_bytes : Upper bound on the bytes held by idle buffers, buffers returned beyond it are freed
+     * @return std::shared_ptr<TensorBufferPool>
+     */
+    static std::shared_ptr<TensorBufferPool> create(std::size_t max_cached_bytes = DefaultMaxCachedBytes);
+
+    ~TensorBufferPool();
+
+    TensorBufferPool(const TensorBufferPool& other)            = delete;
+    TensorBufferPool& operator=(const TensorBufferPool& other) = delete;
+
+    /**
+     * @brief Returns a buffer of exactly `bytes` bytes, reusing an idle buffer of the same size when one is available.
+     * The contents of the buffer are undefined.
+     *
+     * @param bytes
+     * @return std::shared_ptr<rmm::device_buffer>
+     */
+    std::shared_ptr<rmm::device_buffer> get_buffer(std::size_t bytes);
+
+    /**
+     * @brief Frees all of the idle buffers. Buffers currently in use are unaffected.
+     */
+    void clear();
+
+    /**
+     * @brief Number of bytes held by idle buffers
+     *
+     * @return std::size_t
+     */
+    std::size_t cached_bytes() const;
+
+    /**
+     * @brief Number of buffers allocated by the pool, as opposed to reused, since it was created
+     *
+     * @return std::size_t
+     */
+    std::size_t num_allocations() const;
+
+    static constexpr std::size_t DefaultMaxCachedBytes = 256 * 1024 * 1024;
+
+  private:
+    /**
+     * @brief An idle buffer along with the event marking the completion of the work enqueued by its last owner
+     */
+    struct IdleBuffer
+    {
+        IdleBuffer(std::unique_ptr<rmm::device_buffer>&& buffer, cudaEvent_t release_event);
+        ~IdleBuffer();
+
+        IdleBuffer(IdleBuffer&& other) noexcept;
+        IdleBuffer& operator=(IdleBuffer&& other) = delete;
+
+        std::unique_ptr<rmm::device_buffer> buffer;
+        cudaEvent_t release_event{nullptr};
+    };
+
+    TensorBufferPool(std::shared_ptr<MemoryDescriptor> mem_descriptor, std::size_t max_cached_bytes);
+
+    void return_buffer(std::unique_ptr<rmm::device_buffer>&& buffer);
+
+    std::shared_ptr<MemoryDescriptor> m_mem_descriptor;
+    std::size_t m_max_cached_bytes;
+
+    mutable std::mutex m_mutex;
+    std::multimap<std::size_t, IdleBuffer> m_idle_buffers;
+    std::vector<cudaEvent_t> m_spare_events;  // Events of reused buffers, recycled to avoid creating new ones
+    std::size_t m_cached_bytes{0};
+    std::size_t m_num_allocations{0};
+};
+
+/** @} */  // end of group
+}  // namespace morpheus
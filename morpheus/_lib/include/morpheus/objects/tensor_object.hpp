@@ -182,7 +182,7 @@ struct TensorObject final
 
     TensorObject(const TensorObject& other) = default;
 
-    TensorObject(TensorObject&& other) :
+    TensorObject(TensorObject&& other) noexcept :
       m_md(std::exchange(other.m_md, nullptr)),
       m_tensor(std::exchange(other.m_tensor, nullptr))
     {}
@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <cudf/strings/strings_column_view.hpp>  // for strings_column_view
+#include <nvtext/byte_pair_encoding.hpp>         // for bpe_merge_pairs
+#include <nvtext/subword_tokenize.hpp>           // for tokenizer_result, hashed_vocabulary
+#include <nvtext/tokenize.hpp>                   // for tokenize_vocabulary
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** ITokenizer******************************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Tokenizes a column of strings on the device into the rows of token ids, attention mask and metadata consumed
+ * by `PreprocessNLPStage`.
+ */
+class MORPHEUS_EXPORT ITokenizer
+{
+  public:
+    virtual ~ITokenizer() = default;
+
+    /**
+     * @brief Tokenizes each string of `input` into rows of `sequence_length` tokens, padded with zeros. The metadata
+     * holds the index of the string, followed by the first and last of the row's tokens not repeated from the previous
+     * row, for each row.
+     *
+     * @param input
+     * @param sequence_length
+     * @param truncation : When true each string is truncated to a single row, otherwise strings longer than
+     * `sequence_length` continue on further rows, each starting `stride` tokens after the start of the previous one.
+     * @param stride
+     * @return nvtext::tokenizer_result
+     */
+    virtual nvtext::tokenizer_result tokenize(const cudf::strings_column_view& input,
+                                              uint32_t sequence_length,
+                                              bool truncation,
+                                              int stride) = 0;
+};
+
+/**
+ * @brief WordPiece tokenizer of BERT style models, backed by `nvtext::subword_tokenize`. The vocabulary is loaded once
+ * per device and shared by every tokenizer using the same file, each tokenizer holding the copy of every device it ran
+ * on.
+ */
+class MORPHEUS_EXPORT WordPieceTokenizer : public ITokenizer
+{
+  public:
+    /**
+     * @brief Construct a new WordPiece Tokenizer object
+     *
+     * @param vocab_hash_file : Path to hash file containing vocabulary of words with token-ids. This can be created
+     * from the raw vocabulary using the `cudf.utils.hash_vocab_utils.hash_vocab` function.
+     * @param do_lower_case : If set to true, original text will be lowercased before encoding.
+     */
+    WordPieceTokenizer(std::string vocab_hash_file, bool do_lower_case);
+
+    nvtext::tokenizer_result tokenize(const cudf::strings_column_view& input,
+                                      uint32_t sequence_length,
+                                      bool truncation,
+                                      int stride) override;
+
+  private:
+    // Returns the vocabulary of the current device, loading it on the first call from that device
+    std::shared_ptr<const nvtext::hashed_vocabulary> vocabulary();
+
+    std::string m_vocab_hash_file;
+    bool m_do_lower_case;
+
+    std::mutex m_vocab_mutex;
+    std::map<int, std::shared_ptr<const nvtext::hashed_vocabulary>> m_vocabs;  // By device id
+};
+
+/**
+ * @brief Byte-pair encoding tokenizer of RoBERTa and GPT-2 style models, backed by `nvtext::byte_pair_encoding` and
+ * `nvtext::tokenize_with_vocabulary`. The merge pairs and vocabulary are loaded onto the device the tokenizer is
+ * constructed on.
+ *
+ * Spaces are encoded as `word_prefix` ahead of the following word. Text is otherwise encoded as it is, without the
+ * byte to unicode mapping of GPT-2, such that the vocabulary is expected to hold the characters of the text.
+ */
+class MORPHEUS_EXPORT BytePairTokenizer : public ITokenizer
+{
+  public:
+    /**
+     * @brief Construct a new Byte Pair Tokenizer object
+     *
+     * @param merges_file : Path to the ranked merge pairs of the encoding, one space separated pair per line in the
+     * format of a `merges.txt` file. A leading `#version` line is skipped.
+     * @param vocab_file : Path to the vocabulary of the encoding, a JSON object mapping each token to its id in the
+     * format of a `vocab.json` file.
+     * @param unknown_token : Token whose id is given to any token missing from the vocabulary, or zero when the
+     * vocabulary does not hold it.
+     * @param word_prefix : Prefix marking the tokens which follow a space, the `Ġ` of GPT-2 by default
+     */
+    BytePairTokenizer(const std::string& merges_file,
+                      const std::string& vocab_file,
+                      const std::string& unknown_token = "<unk>",
+                      std::string word_prefix          = "\u0120");
+
+    nvtext::tokenizer_result tokenize(const cudf::strings_column_view& input,
+                                      uint32_t sequence_length,
+                                      bool truncation,
+                                      int stride) override;
+
+  private:
+    std::unique_ptr<nvtext::bpe_merge_pairs> m_merge_pairs;
+    std::unique_ptr<nvtext::tokenize_vocabulary> m_vocab;
+    int32_t m_unknown_id{0};
+    std::string m_word_prefix;
+};
+
+/**
+ * @brief Tokenizes only the distinct strings of each column with another tokenizer, copying the rows of each distinct
+ * string to every one of its duplicates. Suited to inputs holding many exact duplicates, such as the repeated templates
+ * of log lines, where it saves the work of the wrapped tokenizer at the cost of finding the distinct strings.
+ */
+class MORPHEUS_EXPORT DeduplicatingTokenizer : public ITokenizer
+{
+  public:
+    /**
+     * @brief Construct a new Deduplicating Tokenizer object
+     *
+     * @param tokenizer : Tokenizer of the distinct strings
+     * @throws std::invalid_argument If `tokenizer` is null
+     */
+    DeduplicatingTokenizer(std::shared_ptr<ITokenizer> tokenizer);
+
+    nvtext::tokenizer_result tokenize(const cudf::strings_column_view& input,
+                                      uint32_t sequence_length,
+                                      bool truncation,
+                                      int stride) override;
+
+  private:
+    std::shared_ptr<ITokenizer> m_tokenizer;
+};
+/** @} */  // end of group
+}  // namespace morpheus
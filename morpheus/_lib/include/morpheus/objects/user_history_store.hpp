@@ -0,0 +1,231 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/utilities/state_checkpoint.hpp"
+
+#include <cudf/column/column_view.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>  // for size_type
+
+#include <chrono>   // for nanoseconds
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** UserHistoryStore************************************/
+
+/**
+ * @addtogroup objects
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Outcome of appending a batch of rows to the history of a user
+ */
+enum class HistoryAppendStatus
+{
+    APPENDED,          // Every row of the batch is newer than the history and was appended
+    NOTHING_NEW,       // Every row of the batch lies within the history, nothing was appended
+    PRECEDES_HISTORY,  // Rows of the batch are older than the oldest row of the history, nothing was appended
+    OVERLAPS_HISTORY   // Only some rows of the batch are newer than the history, nothing was appended
+};
+
+/**
+ * @brief Device resident, append-only history of the rows of each user, backing `RollingWindowStage`.
+ *
+ * The history of a user is a list of chunks, one per appended batch, each holding the rows of the batch sorted by
+ * timestamp in its own `MessageMeta`. Since a batch is only appended when all of its rows are newer than the history,
+ * the history is sorted by timestamp across chunks, and the chunks along with the offset of their first live row index
+ * the rows of the user. Trimming the history drops whole chunks and advances the offset into the first one.
+ *
+ * A window is returned as the `MessageMeta` of a chunk, without copying, when it spans a single whole chunk. Otherwise
+ * the live rows are first compacted into a single chunk, which the history and the window then share. Consumers of a
+ * window may add columns to it but must not modify the existing ones in place.
+ *
+ * When `max_device_bytes` is non-zero, the chunks of the least recently appended users are spilled to pinned host
+ * memory once the chunks held on the device exceed it, and copied back the next time a window is built for the user.
+ *
+ * Snapshots hold the live rows of every user, ordered from the least recently appended user, along with the number of
+ * rows of each user not yet part of a window.
+ */
+class MORPHEUS_EXPORT UserHistoryStore : public Checkpointable
+{
+  public:
+    /**
+     * @brief Construct a new UserHistoryStore object
+     *
+     * @param timestamp_column Name of the timestamp column of the rows
+     * @param max_history_rows Windows hold at most this many rows, plus any rows appended since the last window of the
+     * user. Disabled when 0
+     * @param max_history_duration Windows hold the rows at most this old relative to the newest row, plus any rows
+     * appended since the last window of the user. Disabled when 0
+     * @param max_device_bytes Spill the chunks of the least recently appended users to host memory above this many
+     * bytes. Disabled when 0
+     */
+    UserHistoryStore(std::string timestamp_column,
+                     int64_t max_history_rows,
+                     std::chrono::nanoseconds max_history_duration,
+                     std::size_t max_device_bytes = 0);
+    ~UserHistoryStore();
+
+    /**
+     * @brief Appends the rows of `rows` to the history of `user_id`, when all of them are newer than the history.
+     *
+     * @throws std::invalid_argument When `rows` lacks the timestamp column or a column of the history
+     *
+     * @param user_id
+     * @param rows
+     * @return HistoryAppendStatus
+     */
+    HistoryAppendStatus append(const std::string& user_id, const MessageMeta& rows);
+
+    /**
+     * @brief Trims the history of `user_id` to the window configured by the constructor and returns the rows of the
+     * window, marking them as seen. Returns nullptr when the user has no history.
+     *
+     * @param user_id
+     * @return std::shared_ptr<MessageMeta>
+     */
+    std::shared_ptr<MessageMeta> window(const std::string& user_id);
+
+    /**
+     * @brief Drops the history of `user_id`
+     *
+     * @param user_id
+     */
+    void flush(const std::string& user_id);
+
+    /**
+     * @brief Number of rows held for `user_id`
+     *
+     * @param user_id
+     * @return int64_t
+     */
+    int64_t count(const std::string& user_id) const;
+
+    /**
+     * @brief Number of rows appended for `user_id` since its last window
+     *
+     * @param user_id
+     * @return int64_t
+     */
+    int64_t pending_count(const std::string& user_id) const;
+
+    /**
+     * @brief Number of users with a history
+     *
+     * @return std::size_t
+     */
+    std::size_t num_users() const;
+
+    /**
+     * @brief Number of bytes held on the device by the chunks of every user
+     *
+     * @return std::size_t
+     */
+    std::size_t device_bytes() const;
+
+    /**
+     * @brief Copies the live rows of every user. Spilled chunks are copied back to the device, and spilled again
+     * afterwards when above `max_device_bytes`
+     *
+     * @return StateSnapshot
+     */
+    StateSnapshot snapshot() override;
+
+    /**
+     * @brief Replaces the histories of every user by those of `snapshot`
+     *
+     * @throws std::invalid_argument If the snapshot lacks the timestamp column
+     *
+     * @param snapshot
+     */
+    void restore(StateSnapshot snapshot) override;
+
+  private:
+    struct Chunk
+    {
+        std::shared_ptr<MessageMeta> meta;
+        cudf::size_type begin{0};
+        cudf::size_type num_rows{0};
+        int64_t min_timestamp{0};
+        int64_t max_timestamp{0};
+        std::size_t num_bytes{0};
+        bool is_spilled{false};
+    };
+
+    struct UserHistory
+    {
+        std::deque<Chunk> chunks;
+        int64_t count{0};
+        int64_t pending_count{0};
+        int64_t pending_min_timestamp{0};
+        int64_t min_timestamp{0};
+        int64_t max_timestamp{0};
+
+        // Position in `m_lru`
+        std::list<std::string>::iterator lru;
+    };
+
+    // Builds a chunk holding `rows` sorted by timestamp. `timestamps` are those of `rows` in nanoseconds
+    Chunk make_chunk(const cudf::table_view& rows, const cudf::column_view& timestamps) const;
+
+    // Drops the rows of `history` older than its window
+    void trim(UserHistory& history);
+
+    // Replaces the chunks of `history` by a single chunk holding its live rows
+    void compact(UserHistory& history);
+
+    // Timestamp of the row `row` of `chunk` in nanoseconds
+    int64_t timestamp_at(const Chunk& chunk, cudf::size_type row) const;
+
+    // Spills the chunks of the least recently appended users, other than `user_id`, until under `m_max_device_bytes`
+    void spill_idle(const std::string& user_id);
+
+    const std::string m_timestamp_column;
+    const int64_t m_max_history_rows;
+    const std::chrono::nanoseconds m_max_history_duration;
+    const std::size_t m_max_device_bytes;
+
+    // Columns of the history, set by the first appended batch
+    std::vector<std::string> m_column_names;
+    std::size_t m_timestamp_index{0};
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, UserHistory> m_users;
+
+    // Users ordered by their last append, the least recent first
+    std::list<std::string> m_lru;
+
+    std::size_t m_device_bytes{0};
+};
+/** @} */  // end of group
+}  // namespace morpheus
@@ -22,6 +22,8 @@
 
 #include <pybind11/pytypes.h>
 
+#include <optional>
+
 namespace morpheus {
 /****** Component public implementations *******************/
 /****** TensorObject****************************************/
@@ -40,6 +42,17 @@ namespace morpheus {
 struct TensorObjectInterfaceProxy
 {
     static pybind11::dict cuda_array_interface(TensorObject& self);
+
+    /**
+     * @brief Implements `__dlpack__`, exporting the tensor without copying it. When the consumer passes the stream it
+     * will use the tensor on, the stream of the tensor is synchronized first.
+     */
+    static pybind11::capsule dlpack(TensorObject& self, std::optional<intptr_t> stream);
+
+    /**
+     * @brief Implements `__dlpack_device__`, returning the `(kDLCUDA, device_id)` tuple.
+     */
+    static pybind11::tuple dlpack_device(TensorObject& self);
     static pybind11::object to_cupy(TensorObject& self);
     static TensorObject from_cupy(pybind11::object cupy_array);
 };
@@ -55,8 +55,17 @@ class AddClassificationsStage : public AddScoresStageBase<InputT, OutputT>
      *
      * @param threshold : Threshold to consider true/false for each class
      * @param idx2label : Index to classification labels map
+     * @param top_k : When greater than zero, write the `top_k` largest scores of each row rather than a column per
+     * label, see `AddScoresStageBase`
+     * @param top_k_prefix : Prefix of the names of the top-k columns
+     * @param packed_column : When set, the name of a uint64 column holding the thresholded labels of each row as bits
+     * rather than a column per label, see `AddScoresStageBase`
      */
-    AddClassificationsStage(std::map<std::size_t, std::string> idx2label, float threshold);
+    AddClassificationsStage(std::map<std::size_t, std::string> idx2label,
+                            float threshold,
+                            std::size_t top_k                = 0,
+                            const std::string& top_k_prefix  = "",
+                            const std::string& packed_column = "");
 };
 
 using AddClassificationsStageMM =  // NOLINT(readability-identifier-naming)
@@ -78,6 +87,10 @@ struct AddClassificationStageInterfaceProxy
      * @param name : Name of a stage reference
      * @param idx2label : Index to classification labels map
      * @param threshold : Threshold to consider true/false for each class
+     * @param top_k : When greater than zero, write the `top_k` largest scores of each row rather than a column per
+     * label
+     * @param top_k_prefix : Prefix of the names of the top-k columns
+     * @param packed_column : When set, the name of a uint64 column holding the thresholded labels as bits
      * @return std::shared_ptr<mrc::segment::Object<AddClassificationsStage<MultiResponseMessage,
      * MultiResponseMessage>>>
      */
@@ -85,7 +98,10 @@ struct AddClassificationStageInterfaceProxy
     init_multi(mrc::segment::Builder& builder,
                const std::string& name,
                std::map<std::size_t, std::string> idx2label,
-               float threshold);
+               float threshold,
+               std::size_t top_k                = 0,
+               const std::string& top_k_prefix  = "",
+               const std::string& packed_column = "");
 
     /**
      * @brief Create and initialize a AddClassificationStage that receives ControlMessage and emits ControlMessage, and
@@ -95,13 +111,20 @@ struct AddClassificationStageInterfaceProxy
      * @param name : Name of a stage reference
      * @param idx2label : Index to classification labels map
      * @param threshold : Threshold to consider true/false for each class
+     * @param top_k : When greater than zero, write the `top_k` largest scores of each row rather than a column per
+     * label
+     * @param top_k_prefix : Prefix of the names of the top-k columns
+     * @param packed_column : When set, the name of a uint64 column holding the thresholded labels as bits
      * @return std::shared_ptr<mrc::segment::Object<AddClassificationsStage<ControlMessage, ControlMessage>>>
      */
     static std::shared_ptr<mrc::segment::Object<AddClassificationsStage<ControlMessage, ControlMessage>>> init_cm(
         mrc::segment::Builder& builder,
         const std::string& name,
         std::map<std::size_t, std::string> idx2label,
-        float threshold);
+        float threshold,
+        std::size_t top_k                = 0,
+        const std::string& top_k_prefix  = "",
+        const std::string& packed_column = "");
 };
 
 #pragma GCC visibility pop
@@ -53,8 +53,13 @@ class AddScoresStage : public AddScoresStageBase<InputT, OutputT>
      * @brief Construct a new Add Scores Stage object
      *
      * @param idx2label : Index to classification labels map
+     * @param top_k : When greater than zero, write the `top_k` largest scores of each row rather than a column per
+     * label, see `AddScoresStageBase`
+     * @param top_k_prefix : Prefix of the names of the top-k columns
      */
-    AddScoresStage(std::map<std::size_t, std::string> idx2label);
+    AddScoresStage(std::map<std::size_t, std::string> idx2label,
+                   std::size_t top_k               = 0,
+                   const std::string& top_k_prefix = "");
 };
 
 using AddScoresStageMM =  // NOLINT(readability-identifier-naming)
@@ -76,10 +81,17 @@ struct AddScoresStageInterfaceProxy
      * @param name : Name of a stage reference
      * @param num_class_labels : Number of classification labels
      * @param idx2label : Index to classification labels map
+     * @param top_k : When greater than zero, write the `top_k` largest scores of each row rather than a column per
+     * label
+     * @param top_k_prefix : Prefix of the names of the top-k columns
      * @return std::shared_ptr<mrc::segment::Object<AddScoresStage<MultiResponseMessage, MultiResponseMessage>>>
      */
     static std::shared_ptr<mrc::segment::Object<AddScoresStage<MultiResponseMessage, MultiResponseMessage>>> init_multi(
-        mrc::segment::Builder& builder, const std::string& name, std::map<std::size_t, std::string> idx2label);
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::map<std::size_t, std::string> idx2label,
+        std::size_t top_k               = 0,
+        const std::string& top_k_prefix = "");
 
     /**
      * @brief Create and initialize a AddScoresStage that receives ControlMessage and emits ControlMessage,
@@ -89,10 +101,17 @@ struct AddScoresStageInterfaceProxy
      * @param name : Name of a stage reference
      * @param num_class_labels : Number of classification labels
      * @param idx2label : Index to classification labels map
+     * @param top_k : When greater than zero, write the `top_k` largest scores of each row rather than a column per
+     * label
+     * @param top_k_prefix : Prefix of the names of the top-k columns
      * @return std::shared_ptr<mrc::segment::Object<AddScoresStage<ControlMessage, ControlMessage>>>
      */
     static std::shared_ptr<mrc::segment::Object<AddScoresStage<ControlMessage, ControlMessage>>> init_cm(
-        mrc::segment::Builder& builder, const std::string& name, std::map<std::size_t, std::string> idx2label);
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::map<std::size_t, std::string> idx2label,
+        std::size_t top_k               = 0,
+        const std::string& top_k_prefix = "");
 };
 
 #pragma GCC visibility pop
@@ -19,6 +19,10 @@
 
 #include "morpheus/messages/control.hpp"
 #include "morpheus/messages/multi_response.hpp"
+#include "morpheus/objects/tensor_buffer_pool.hpp"
+#include "morpheus/objects/tensor_object.hpp"
+#include "morpheus/types.hpp"  // for TensorIndex
+#include "morpheus/utilities/cuda_util.hpp"
 
 #include <boost/fiber/context.hpp>
 #include <pymrc/node.hpp>
@@ -30,6 +34,7 @@
 #include <optional>
 #include <string>
 #include <thread>
+#include <vector>
 
 // IWYU pragma: no_include "rxcpp/sources/rx-iterate.hpp"
 
@@ -46,6 +51,15 @@ namespace morpheus {
 #pragma GCC visibility push(default)
 /**
  * @brief Base class for both `AddScoresStage` and `AddClassificationStage`
+ *
+ * By default one column is written per label. When `top_k` is set, the `top_k` largest scores among the labels are
+ * written instead, rank `j` of each row being written to an int32 `{top_k_prefix}top_{j}_id` column holding the index
+ * of the label in the model output and a float32 `{top_k_prefix}top_{j}_score` column. With a threshold, ids of ranks
+ * whose score is not above it are -1.
+ *
+ * When `packed_column` is set, the thresholded labels of each row are instead packed into a single uint64 column of
+ * that name, bit `i` being set when the `i`-th label, in increasing order of index, has a score above the threshold.
+ * Unlike a column per label, this writes a single column with a single kernel launch.
  */
 template <typename InputT, typename OutputT>
 class AddScoresStageBase : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>, std::shared_ptr<OutputT>>
@@ -61,8 +75,20 @@ class AddScoresStageBase : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>
      *
      * @param threshold : Threshold to consider true/false for each class
      * @param idx2label : Index to classification labels map
+     * @param top_k : When greater than zero, write the `top_k` largest scores of each row rather than a column per
+     * label
+     * @param top_k_prefix : Prefix of the names of the top-k columns
+     * @param packed_column : When set, the name of a uint64 column holding the thresholded labels of each row as bits
+     * rather than a column per label
+     * @throws std::invalid_argument If `top_k` is greater than the number of labels or `MatxUtil::MaxTopK`, or if
+     * `packed_column` is set without a threshold, along with `top_k`, or with more than `MatxUtil::MaxPackedLabels`
+     * labels
      */
-    AddScoresStageBase(std::map<std::size_t, std::string> idx2label, std::optional<float> threshold);
+    AddScoresStageBase(std::map<std::size_t, std::string> idx2label,
+                       std::optional<float> threshold,
+                       std::size_t top_k                = 0,
+                       const std::string& top_k_prefix  = "",
+                       const std::string& packed_column = "");
 
     /**
      * Called every time a message is passed to this stage
@@ -72,11 +98,29 @@ class AddScoresStageBase : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>
   private:
     void on_multi_response_message(std::shared_ptr<MultiResponseMessage> x);
     void on_control_message(std::shared_ptr<ControlMessage> x);
+
+    /**
+     * @brief Appends the columns to write to the dataframe, along with their values computed from `probs`
+     */
+    void compute_outputs(TensorObject probs, std::vector<std::string>& columns, std::vector<TensorObject>& tensors);
+
     std::map<std::size_t, std::string> m_idx2label;
     std::optional<float> m_threshold;
 
+    std::vector<TensorIndex> m_label_columns;  // Model output columns of the labels, in increasing order
+
+    std::size_t m_top_k;
+    std::vector<std::string> m_top_k_columns;  // The id then score column of each rank
+
+    std::string m_packed_column;
+
     // The minimum number of columns needed to extract the label data
     std::size_t m_min_col_count;
+
+    // Threshold outputs only live until they are copied into the dataframe, reused across messages on the device the
+    // pool was created on. Messages on any other device allocate their outputs directly.
+    std::shared_ptr<TensorBufferPool> m_buffer_pool{TensorBufferPool::create()};
+    int m_device_id{CudaUtil::current_device()};
 };
 
 using AddScoresStageBaseMM =  // NOLINT(readability-identifier-naming)
@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** AppShieldFeaturesStage******************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Computes the ransomware detection features of each process of each AppShield snapshot held by `meta`, the
+ * C++ counterpart of the `FeatureExtractor` of the ransomware detection example. Rather than filtering the rows of
+ * each process and plugin in turn, every feature is computed over the whole batch by a single groupby keyed by the
+ * source, snapshot and process of the rows.
+ *
+ * The rows of `meta` are those of the `ldrmodules`, `threadlist`, `envars`, `vadinfo` and `handles` plugins as read by
+ * the `AppShieldSourceStage`, with the plugin of each row in the `plugin` column.
+ *
+ * @param meta
+ * @param feature_columns : Names of the feature columns to return, in order. Features which are not computed, such as
+ * features of other plugins, are zero
+ * @param file_extns : File extensions, without the leading dot, of the documents targeted by ransomware
+ * @return std::shared_ptr<MessageMeta> : One row per process of each snapshot holding `feature_columns` along with
+ * the `pid_process`, `snapshot_id`, `timestamp` and `source_pid_process` columns, sorted by source, `pid_process` and
+ * `snapshot_id`
+ * @throws std::invalid_argument If a column read by the features is missing
+ */
+std::shared_ptr<MessageMeta> create_appshield_features(const std::shared_ptr<MessageMeta>& meta,
+                                                       const std::vector<std::string>& feature_columns,
+                                                       const std::vector<std::string>& file_extns);
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Replaces the AppShield snapshots of each incoming `MessageMeta` by the ransomware detection features of their
+ * processes, as computed by `create_appshield_features`.
+ */
+class AppShieldFeaturesStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new AppShield Features Stage object
+     *
+     * @param feature_columns : Names of the feature columns to emit, in order
+     * @param file_extns : File extensions, without the leading dot, of the documents targeted by ransomware
+     */
+    AppShieldFeaturesStage(std::vector<std::string> feature_columns, std::vector<std::string> file_extns);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    std::vector<std::string> m_feature_columns;
+    std::vector<std::string> m_file_extns;
+};
+
+/****** AppShieldFeaturesStageInterfaceProxy****************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct AppShieldFeaturesStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize an AppShieldFeaturesStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param feature_columns : Names of the feature columns to emit, in order
+     * @param file_extns : File extensions, without the leading dot, of the documents targeted by ransomware
+     * @return std::shared_ptr<mrc::segment::Object<AppShieldFeaturesStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<AppShieldFeaturesStage>> init(mrc::segment::Builder& builder,
+                                                                              const std::string& name,
+                                                                              std::vector<std::string> feature_columns,
+                                                                              std::vector<std::string> file_extns);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
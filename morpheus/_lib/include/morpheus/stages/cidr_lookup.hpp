@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/objects/file_types.hpp"
+
+#include <cudf/column/column_view.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>  // for size_type
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rmm/device_uvector.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t, int32_t
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** NetworkTable ***************************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Table of labelled networks, such as a GeoIP, ASN or internal zone database, resolving addresses to the labels
+ * of the most specific network holding them.
+ *
+ * Each row of the file holds an IPv4 or IPv6 network in CIDR notation (`"10.0.0.0/8"`, `"2001:db8::/32"`) along with
+ * its labels. On load, the networks are flattened on the host into disjoint address ranges, each mapped to the row of
+ * the longest prefix covering it, then copied to the device sorted by their first address. Addresses are then resolved
+ * by a binary search per address, see `MatxUtil::lookup_address_ranges`. When a network is listed more than once, its
+ * last row is kept.
+ *
+ * Addresses are resolved from IPv4 strings, integer IPv4 addresses such as the `src_ip` and `dst_ip` columns of
+ * `DocaSourceStage` with `numeric_addresses`, or 128-bit IPv4 mapped or IPv6 addresses such as its `src_ip6` and
+ * `dst_ip6` columns. IPv6 strings are not parsed on the device, and are not resolved.
+ */
+class NetworkTable
+{
+  public:
+    /**
+     * @brief Loads the table
+     *
+     * @param filename : Parquet, CSV or JSON file of the table
+     * @param file_type : Type of the file, `FileTypes::Auto` to infer it from its extension
+     * @param network_column : String column of the networks in CIDR notation
+     * @param label_columns : Columns returned for each address, every other column when empty
+     * @throws std::invalid_argument If a column is missing from the file, or a network is invalid or null
+     */
+    NetworkTable(const std::string& filename,
+                 FileTypes file_type,
+                 const std::string& network_column,
+                 std::vector<std::string> label_columns);
+
+    /**
+     * @brief Returns the labels of the network holding each address, in the order of `addresses`. Addresses outside of
+     * every network, null or which cannot be parsed hold nulls.
+     *
+     * @param addresses : Column of IPv4 strings, of integer IPv4 addresses or of 128-bit addresses (`DECIMAL128`)
+     * @return std::unique_ptr<cudf::table>
+     * @throws std::invalid_argument If `addresses` is of another type
+     */
+    std::unique_ptr<cudf::table> lookup(const cudf::column_view& addresses) const;
+
+    /**
+     * @brief Names of the columns returned by `lookup`
+     */
+    const std::vector<std::string>& label_columns() const;
+
+    /**
+     * @brief Number of networks loaded, one per row of the file
+     */
+    cudf::size_type num_networks() const;
+
+    /**
+     * @brief Number of disjoint address ranges the networks were flattened into
+     */
+    std::size_t num_ranges() const;
+
+  private:
+    std::vector<std::string> m_label_columns;
+    std::unique_ptr<cudf::table> m_labels;
+    cudf::size_type m_num_networks{0};
+
+    // Sorted disjoint ranges, bounds as (low, high) words, and the row of `m_labels` of each range
+    rmm::device_uvector<uint64_t> m_range_firsts;
+    rmm::device_uvector<uint64_t> m_range_lasts;
+    rmm::device_uvector<int32_t> m_range_rows;
+};
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Labels the addresses of the payload of each `ControlMessage` with the `NetworkTable` loaded from `filename`,
+ * such as the country of a GeoIP database, the ASN of an address or its internal network zone. Each label is appended
+ * as a column named `<address column>_<label>`, replacing any column of the payload of the same name, and holds nulls
+ * for the addresses outside of every network.
+ *
+ * The payload is replaced by a new table holding the columns of the payload followed by the appended ones. A message
+ * without a payload, or whose payload fails to be labelled such as when an address column is missing, is an error
+ * passed to `on_error`.
+ */
+class CidrLookupStage : public mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Cidr Lookup Stage object
+     *
+     * @param filename : Parquet, CSV or JSON file of the networks
+     * @param file_type : Type of the file
+     * @param network_column : Column of the networks in CIDR notation
+     * @param label_columns : Columns of the table appended for each address, every other column when empty
+     * @param address_columns : Columns of the payload holding the addresses to label
+     */
+    CidrLookupStage(const std::string& filename,
+                    FileTypes file_type,
+                    const std::string& network_column,
+                    std::vector<std::string> label_columns,
+                    std::vector<std::string> address_columns);
+
+    /**
+     * @brief Returns `meta` with the labels of each of its address columns appended
+     *
+     * @param meta
+     * @return std::shared_ptr<MessageMeta>
+     * @throws std::invalid_argument If an address column is missing from `meta` or of an unsupported type
+     */
+    std::shared_ptr<MessageMeta> label(const std::shared_ptr<MessageMeta>& meta) const;
+
+  private:
+    subscribe_fn_t build_operator();
+
+    NetworkTable m_table;
+    std::vector<std::string> m_address_columns;
+};
+
+/****** CidrLookupStageInterfaceProxy***********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct CidrLookupStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a CidrLookupStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param filename : Parquet, CSV or JSON file of the networks
+     * @param file_type : Type of the file
+     * @param network_column : Column of the networks in CIDR notation
+     * @param label_columns : Columns of the table appended for each address, every other column when empty
+     * @param address_columns : Columns of the payload holding the addresses to label
+     * @return std::shared_ptr<mrc::segment::Object<CidrLookupStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<CidrLookupStage>> init(mrc::segment::Builder& builder,
+                                                                        const std::string& name,
+                                                                        const std::string& filename,
+                                                                        FileTypes file_type,
+                                                                        const std::string& network_column,
+                                                                        std::vector<std::string> label_columns,
+                                                                        std::vector<std::string> address_columns);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/io/cuda_ipc_ring.hpp"
+#include "morpheus/messages/control.hpp"
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>   // for milliseconds
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** CudaIpcSinkStage************************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Exports each `ControlMessage` to a process sharing the host, through the `CudaIpcRing` named `ring_name`,
+ * then passes it through. Only a compact header, holding the config of the message along with the names and layout of
+ * its columns and tensors, is written to the ring. The columns of the payload, packed into a single contiguous device
+ * buffer, and the tensors are exported through CUDA IPC handles and mapped by the consumer without a copy. They are
+ * held until the consumer releases the message.
+ *
+ * The ring is created on the first message, or on completion when there was none, such that the consumer is always
+ * told the stream ended.
+ */
+class CudaIpcSinkStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Cuda Ipc Sink Stage object
+     *
+     * @param ring_name : Name of the ring, shared with the consumer
+     * @param num_slots : Messages exported and not yet released by the consumer, further messages waiting for a slot
+     * @param max_header_bytes : Size of the largest header
+     * @param close_timeout : Time to wait on completion for the consumer to release every message
+     */
+    CudaIpcSinkStage(std::string ring_name,
+                     std::size_t num_slots,
+                     std::size_t max_header_bytes,
+                     std::chrono::milliseconds close_timeout);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    CudaIpcRing& ring();
+
+    void push(std::shared_ptr<ControlMessage> message, const CudaIpcRing::stop_fn_t& should_stop);
+
+    std::string m_ring_name;
+    std::size_t m_num_slots;
+    std::size_t m_max_header_bytes;
+    std::chrono::milliseconds m_close_timeout;
+
+    std::unique_ptr<CudaIpcRing> m_ring;
+};
+
+/****** CudaIpcSourceStage**********************************/
+/**
+ * @brief Emits the messages exported by the `CudaIpcSinkStage` of another process sharing the host. The exported
+ * buffers are mapped, and copied device to device into buffers owned by the emitted message, which cuDF tables and
+ * tensors require, the message being released to the producer right after. The stage completes once the sink
+ * completes.
+ */
+class CudaIpcSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<ControlMessage>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonSource<std::shared_ptr<ControlMessage>>;
+    using typename base_t::source_type_t;
+    using typename base_t::subscriber_fn_t;
+
+    /**
+     * @brief Construct a new Cuda Ipc Source Stage object
+     *
+     * @param ring_name : Name of the ring, shared with the producer
+     * @param open_timeout : Time to wait for the producer to create the ring
+     */
+    CudaIpcSourceStage(std::string ring_name, std::chrono::milliseconds open_timeout);
+
+  private:
+    subscriber_fn_t build();
+
+    /**
+     * @brief Copies the message exported by the producer into a new `ControlMessage`
+     */
+    static std::shared_ptr<ControlMessage> import_message(const CudaIpcMessage& exported);
+
+    std::string m_ring_name;
+    std::chrono::milliseconds m_open_timeout;
+};
+
+/****** CudaIpcSinkStageInterfaceProxy**********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct CudaIpcSinkStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a CudaIpcSinkStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param ring_name : Name of the ring, shared with the consumer
+     * @param num_slots : Messages exported and not yet released by the consumer
+     * @param max_header_bytes : Size of the largest header
+     * @param close_timeout_ms : Time to wait on completion for the consumer to release every message, in milliseconds
+     * @return std::shared_ptr<mrc::segment::Object<CudaIpcSinkStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<CudaIpcSinkStage>> init(mrc::segment::Builder& builder,
+                                                                         const std::string& name,
+                                                                         std::string ring_name,
+                                                                         std::size_t num_slots,
+                                                                         std::size_t max_header_bytes,
+                                                                         int64_t close_timeout_ms);
+};
+
+/****** CudaIpcSourceStageInterfaceProxy********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct CudaIpcSourceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a CudaIpcSourceStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param ring_name : Name of the ring, shared with the producer
+     * @param open_timeout_ms : Time to wait for the producer to create the ring, in milliseconds
+     * @return std::shared_ptr<mrc::segment::Object<CudaIpcSourceStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<CudaIpcSourceStage>> init(mrc::segment::Builder& builder,
+                                                                           const std::string& name,
+                                                                           std::string ring_name,
+                                                                           int64_t open_timeout_ms);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,201 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/objects/table_info.hpp"
+#include "morpheus/utilities/metrics.hpp"
+#include "morpheus/utilities/state_checkpoint.hpp"
+
+#include <cudf/column/column.hpp>
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>   // for milliseconds, steady_clock
+#include <cstddef>  // for size_t
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** DeduplicateStage*************************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Device resident set of the 64-bit hashes of the keys of the rows seen over a sliding time window. The window
+ * is split into `num_buckets` buckets of the same duration, the hashes of each bucket being held in a device column of
+ * their own. Once the newest bucket is older than its duration a new one is started, and buckets are dropped as a
+ * whole once all of their keys are older than the window. When more than `max_keys` hashes are held the oldest
+ * buckets are dropped early, bounding the device memory to 8 bytes per key.
+ *
+ * Rows are identified by the hash of their keys alone, the chance of two distinct keys colliding is negligible for any
+ * practical number of keys.
+ *
+ * Snapshots hold the hashes of every bucket along with the age of the bucket, the time elapsed until the snapshot is
+ * restored counting towards the age of its keys.
+ */
+class DeduplicationWindow : public Checkpointable
+{
+  public:
+    using clock_t = std::chrono::steady_clock;
+
+    /**
+     * @brief Construct a new Deduplication Window
+     *
+     * @param key_columns : Columns identifying duplicate rows
+     * @param window : Duration after which a key is forgotten
+     * @param num_buckets : Number of buckets the window is split into
+     * @param max_keys : Maximum number of hashes held
+     * @throws std::invalid_argument If `key_columns` is empty, or `window`, `num_buckets` or `max_keys` is zero
+     */
+    DeduplicationWindow(std::vector<std::string> key_columns,
+                        std::chrono::milliseconds window,
+                        std::size_t num_buckets,
+                        std::size_t max_keys);
+
+    /**
+     * @brief Returns which rows of `table` have keys not seen within the window, nor by a previous row of `table`, and
+     * adds their keys to the window
+     *
+     * @param table
+     * @param now : Time the rows are seen at
+     * @return std::unique_ptr<cudf::column> : BOOL8 column without nulls, true for the first row of each key
+     * @throws std::invalid_argument If a key column is missing from `table`
+     */
+    std::unique_ptr<cudf::column> insert(const TableInfo& table, clock_t::time_point now = clock_t::now());
+
+    /**
+     * @brief Number of hashes currently held
+     */
+    std::size_t size() const;
+
+    StateSnapshot snapshot() override;
+
+    /**
+     * @throws std::invalid_argument If the snapshot was taken with other key columns
+     */
+    void restore(StateSnapshot snapshot) override;
+
+  private:
+    struct Bucket
+    {
+        clock_t::time_point start;
+        std::unique_ptr<cudf::column> hashes;
+    };
+
+    void roll_over(clock_t::time_point now);
+
+    std::vector<std::string> m_key_columns;
+    std::chrono::milliseconds m_window;
+    std::chrono::milliseconds m_bucket_duration;
+    std::size_t m_max_keys;
+
+    std::deque<Bucket> m_buckets;  // Ordered from the oldest bucket to the newest
+    std::size_t m_num_keys{0};
+};
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Drops the rows of the payload of each `ControlMessage` whose key columns have already been seen within a
+ * sliding time window, such as retried deliveries or the repeated events of chatty agents, before they consume
+ * inference capacity. See `DeduplicationWindow`.
+ *
+ * Kept rows are compacted into a new table, the incoming payload being passed through untouched when every row is
+ * kept, and messages without any row left are not emitted. The number of duplicate rows dropped from each message is
+ * set as its `duplicate_rows` metadata, and the number of unique and duplicate rows as well as the number of keys held
+ * are reported to the `MetricsRegistry`.
+ *
+ * When checkpoints are enabled, the window is restored from the latest checkpoint of the stage on construction and
+ * saved periodically as well as once the input completes.
+ */
+class DeduplicateStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Deduplicate Stage object
+     *
+     * @param key_columns : Columns identifying duplicate rows
+     * @param window : Duration after which a key is forgotten
+     * @param num_buckets : Number of buckets the window is split into
+     * @param max_keys : Maximum number of keys held on the device
+     * @param metrics_name : Labels the metrics of the stage, and names its checkpoints
+     * @param checkpoint_interval : Minimum duration between two checkpoints of the window, see `StateCheckpoint`.
+     * Disabled when zero
+     */
+    DeduplicateStage(std::vector<std::string> key_columns,
+                     std::chrono::milliseconds window,
+                     std::size_t num_buckets,
+                     std::size_t max_keys,
+                     const std::string& metrics_name,
+                     std::chrono::milliseconds checkpoint_interval = std::chrono::milliseconds(0));
+
+  private:
+    subscribe_fn_t build_operator();
+
+    DeduplicationWindow m_window;
+    StateCheckpoint m_checkpoint;
+
+    std::shared_ptr<Counter> m_unique_rows;
+    std::shared_ptr<Counter> m_duplicate_rows;
+    std::shared_ptr<Gauge> m_num_keys;
+};
+
+/****** DeduplicateStageInterfaceProxy***********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct DeduplicateStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a DeduplicateStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param key_columns : Columns identifying duplicate rows
+     * @param window_ms : Duration in milliseconds after which a key is forgotten
+     * @param num_buckets : Number of buckets the window is split into
+     * @param max_keys : Maximum number of keys held on the device
+     * @param checkpoint_interval_ms : Minimum duration in milliseconds between two checkpoints, disabled when 0
+     * @return std::shared_ptr<mrc::segment::Object<DeduplicateStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<DeduplicateStage>> init(mrc::segment::Builder& builder,
+                                                                         const std::string& name,
+                                                                         std::vector<std::string> key_columns,
+                                                                         std::size_t window_ms,
+                                                                         std::size_t num_buckets,
+                                                                         std::size_t max_keys,
+                                                                         std::size_t checkpoint_interval_ms);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -20,9 +20,11 @@
 #include "morpheus/messages/control.hpp"
 #include "morpheus/messages/meta.hpp"
 #include "morpheus/messages/multi.hpp"
-#include "morpheus/types.hpp"                  // for TensorIndex
-#include "morpheus/utilities/python_util.hpp"  // for show_warning_message
-#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+#include "morpheus/objects/memory_governor.hpp"  // for MemoryGovernor
+#include "morpheus/types.hpp"                    // for TensorIndex
+#include "morpheus/utilities/nvtx_util.hpp"      // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+#include "morpheus/utilities/python_util.hpp"    // for show_warning_message
+#include "morpheus/utilities/string_util.hpp"    // for MORPHEUS_CONCAT_STR
 
 #include <glog/logging.h>
 #include <mrc/segment/builder.hpp>
@@ -34,11 +36,14 @@
 #include <rxcpp/rx.hpp>
 
 #include <algorithm>  // IWYU pragma: keep for std::min
+#include <chrono>     // for milliseconds, steady_clock
+#include <cstdint>    // for int64_t
 #include <exception>  // for exception_ptr
 #include <memory>
 #include <sstream>  // IWYU pragma: keep for glog
 #include <string>
 #include <utility>  // for pair
+#include <vector>
 
 namespace morpheus {
 /****** Component public implementations *******************/
@@ -50,6 +55,10 @@ namespace morpheus {
  */
 
 #pragma GCC visibility push(default)
+namespace detail {
+MORPHEUS_NVTX_DOMAIN(DeserializeNvtxDomain, "DeserializeStage");
+}  // namespace detail
+
 using cm_task_t = std::pair<std::string, nlohmann::json>;
 
 void make_output_message(std::shared_ptr<MessageMeta>& incoming_message,
@@ -64,7 +73,28 @@ void make_output_message(std::shared_ptr<MessageMeta>& incoming_message,
                          cm_task_t* task,
                          std::shared_ptr<ControlMessage>& windowed_message);
 
+/**
+ * @brief Concatenates the rows of `metas`, which must all have the same columns, into a single C++ backed
+ * `MessageMeta`. The indexes of the inputs are not carried over, the result having a new range index, except for named
+ * indexes which are kept as regular columns.
+ *
+ * @param metas
+ * @return std::shared_ptr<MessageMeta>
+ */
+std::shared_ptr<MessageMeta> coalesce_message_metas(const std::vector<std::shared_ptr<MessageMeta>>& metas);
+
 /****** DeserializationStage********************************/
+/**
+ * @brief Windows each incoming `MessageMeta` into messages of at most `batch_size` rows.
+ *
+ * When `coalesce` is set, consecutive messages holding fewer than `batch_size` rows are held back and concatenated
+ * natively with `coalesce_message_metas` into a single message of up to `batch_size` rows, such that downstream stages
+ * are not left processing tiny batches when the source emits small frames. Pending messages are emitted once adding
+ * the next one would exceed `batch_size`, when a message with different columns or of at least `batch_size` rows
+ * arrives, when the oldest of them has been held for `max_linger` (checked as messages arrive) and once the input
+ * completes. While an installed `MemoryGovernor` is throttled, the messages held back are spilled to host memory until
+ * they are emitted.
+ */
 template <typename OutputT>
 class DeserializeStage : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<OutputT>>
 {
@@ -80,21 +110,50 @@ class DeserializeStage : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMe
      * @param batch_size Number of messages to be divided into each batch
      * @param ensure_sliceable_index Whether or not to call `ensure_sliceable_index()` on all incoming `MessageMeta`
      * @param task Optional task to be added to all outgoing `ControlMessage`s, ignored when `OutputT` is `MultiMessage`
+     * @param coalesce Whether or not to concatenate consecutive messages of fewer than `batch_size` rows
+     * @param max_linger Maximum time a message is held back when coalescing, zero only bounds the held back rows
      */
     DeserializeStage(TensorIndex batch_size,
-                     bool ensure_sliceable_index     = true,
-                     std::unique_ptr<cm_task_t> task = nullptr) :
+                     bool ensure_sliceable_index          = true,
+                     std::unique_ptr<cm_task_t> task      = nullptr,
+                     bool coalesce                        = false,
+                     std::chrono::milliseconds max_linger = std::chrono::milliseconds(0)) :
       base_t(base_t::op_factory_from_sub_fn(build_operator())),
       m_batch_size(batch_size),
       m_ensure_sliceable_index(ensure_sliceable_index),
-      m_task(std::move(task)){};
+      m_task(std::move(task)),
+      m_coalesce(coalesce),
+      m_max_linger(max_linger){};
 
   private:
+    /**
+     * @brief Messages held back while coalescing, owned by a single subscription
+     */
+    struct PendingMetas
+    {
+        std::vector<std::shared_ptr<MessageMeta>> metas;
+        std::vector<std::string> column_names;
+        TensorIndex num_rows{0};
+        std::chrono::steady_clock::time_point oldest;
+    };
+
     subscribe_fn_t build_operator();
 
+    /**
+     * @brief Emits `incoming_message` as windows of at most `m_batch_size` rows
+     */
+    void emit_windows(std::shared_ptr<MessageMeta> incoming_message, rxcpp::subscriber<source_type_t>& output);
+
+    /**
+     * @brief Emits the messages held back in `pending` as a single message, if any
+     */
+    void flush(PendingMetas& pending, rxcpp::subscriber<source_type_t>& output);
+
     TensorIndex m_batch_size;
     bool m_ensure_sliceable_index{true};
     std::unique_ptr<cm_task_t> m_task{nullptr};
+    bool m_coalesce{false};
+    std::chrono::milliseconds m_max_linger{0};
 };
 
 /****** DeserializationStageInterfaceProxy******************/
@@ -110,10 +169,17 @@ struct DeserializeStageInterfaceProxy
      * @param name : Name of a stage reference
      * @param batch_size : Number of messages to be divided into each batch
      * @param ensure_sliceable_index Whether or not to call `ensure_sliceable_index()` on all incoming `MessageMeta`
+     * @param coalesce : Whether or not to concatenate consecutive messages of fewer than `batch_size` rows
+     * @param max_linger_ms : Maximum time in milliseconds a message is held back when coalescing, zero for no limit
      * @return std::shared_ptr<mrc::segment::Object<DeserializeStage<MultiMessage>>>
      */
     static std::shared_ptr<mrc::segment::Object<DeserializeStage<MultiMessage>>> init_multi(
-        mrc::segment::Builder& builder, const std::string& name, TensorIndex batch_size, bool ensure_sliceable_index);
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        TensorIndex batch_size,
+        bool ensure_sliceable_index,
+        bool coalesce         = false,
+        int64_t max_linger_ms = 0);
 
     /**
      * @brief Create and initialize a DeserializationStage that emits ControlMessage's, and return the result.
@@ -125,6 +191,8 @@ struct DeserializeStageInterfaceProxy
      * @param ensure_sliceable_index Whether or not to call `ensure_sliceable_index()` on all incoming `MessageMeta`
      * @param task_type : Optional task type to be added to all outgoing messages
      * @param task_payload : Optional json object describing the task to be added to all outgoing messages
+     * @param coalesce : Whether or not to concatenate consecutive messages of fewer than `batch_size` rows
+     * @param max_linger_ms : Maximum time in milliseconds a message is held back when coalescing, zero for no limit
      * @return std::shared_ptr<mrc::segment::Object<DeserializeStage<ControlMessage>>>
      */
     static std::shared_ptr<mrc::segment::Object<DeserializeStage<ControlMessage>>> init_cm(
@@ -133,54 +201,130 @@ struct DeserializeStageInterfaceProxy
         TensorIndex batch_size,
         bool ensure_sliceable_index,
         const pybind11::object& task_type,
-        const pybind11::object& task_payload);
+        const pybind11::object& task_payload,
+        bool coalesce         = false,
+        int64_t max_linger_ms = 0);
 };
 
+template <typename OutputT>
+void DeserializeStage<OutputT>::emit_windows(std::shared_ptr<MessageMeta> incoming_message,
+                                             rxcpp::subscriber<source_type_t>& output)
+{
+    MORPHEUS_NVTX_RANGE(detail::DeserializeNvtxDomain, "emit_windows", incoming_message->count());
+
+    if (!incoming_message->has_sliceable_index())
+    {
+        if (m_ensure_sliceable_index)
+        {
+            auto old_index_name = incoming_message->ensure_sliceable_index();
+
+            if (old_index_name.has_value())
+            {
+                // Generate a warning
+                LOG(WARNING) << MORPHEUS_CONCAT_STR(
+                    "Incoming MessageMeta does not have a unique and monotonic index. Updating index "
+                    "to be unique. Existing index will be retained in column '"
+                    << *old_index_name << "'");
+            }
+        }
+        else
+        {
+            utilities::show_warning_message(
+                "Detected a non-sliceable index on an incoming MessageMeta. Performance when taking slices "
+                "of messages may be degraded. Consider setting `ensure_sliceable_index==True`",
+                PyExc_RuntimeWarning);
+        }
+    }
+    // Loop over the MessageMeta and create sub-batches
+    for (TensorIndex i = 0; i < incoming_message->count(); i += this->m_batch_size)
+    {
+        std::shared_ptr<OutputT> windowed_message{nullptr};
+        make_output_message(incoming_message,
+                            i,
+                            std::min(i + this->m_batch_size, incoming_message->count()),
+                            m_task.get(),
+                            windowed_message);
+        output.on_next(std::move(windowed_message));
+    }
+}
+
+template <typename OutputT>
+void DeserializeStage<OutputT>::flush(PendingMetas& pending, rxcpp::subscriber<source_type_t>& output)
+{
+    if (pending.metas.empty())
+    {
+        return;
+    }
+
+    MORPHEUS_NVTX_RANGE(detail::DeserializeNvtxDomain, "flush", pending.num_rows);
+
+    auto meta = pending.metas.size() == 1 ? pending.metas.front() : coalesce_message_metas(pending.metas);
+
+    pending.metas.clear();
+    pending.num_rows = 0;
+
+    emit_windows(std::move(meta), output);
+}
+
 template <typename OutputT>
 typename DeserializeStage<OutputT>::subscribe_fn_t DeserializeStage<OutputT>::build_operator()
 {
     return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        auto pending = std::make_shared<PendingMetas>();
+
         return input.subscribe(rxcpp::make_observer<sink_type_t>(
-            [this, &output](sink_type_t incoming_message) {
-                if (!incoming_message->has_sliceable_index())
+            [this, &output, pending](sink_type_t incoming_message) {
+                const auto num_rows = incoming_message->count();
+
+                if (!m_coalesce || num_rows >= m_batch_size)
                 {
-                    if (m_ensure_sliceable_index)
-                    {
-                        auto old_index_name = incoming_message->ensure_sliceable_index();
-
-                        if (old_index_name.has_value())
-                        {
-                            // Generate a warning
-                            LOG(WARNING) << MORPHEUS_CONCAT_STR(
-                                "Incoming MessageMeta does not have a unique and monotonic index. Updating index "
-                                "to be unique. Existing index will be retained in column '"
-                                << *old_index_name << "'");
-                        }
-                    }
-                    else
-                    {
-                        utilities::show_warning_message(
-                            "Detected a non-sliceable index on an incoming MessageMeta. Performance when taking slices "
-                            "of messages may be degraded. Consider setting `ensure_sliceable_index==True`",
-                            PyExc_RuntimeWarning);
-                    }
+                    // Keeps the messages in order
+                    this->flush(*pending, output);
+                    this->emit_windows(std::move(incoming_message), output);
+                    return;
+                }
+
+                if (num_rows == 0)
+                {
+                    return;
+                }
+
+                auto column_names = incoming_message->get_column_names();
+                if (pending->num_rows + num_rows > m_batch_size || column_names != pending->column_names)
+                {
+                    this->flush(*pending, output);
+                }
+
+                if (pending->metas.empty())
+                {
+                    pending->oldest       = std::chrono::steady_clock::now();
+                    pending->column_names = std::move(column_names);
                 }
-                // Loop over the MessageMeta and create sub-batches
-                for (TensorIndex i = 0; i < incoming_message->count(); i += this->m_batch_size)
+
+                pending->metas.push_back(std::move(incoming_message));
+                pending->num_rows += num_rows;
+
+                const bool is_full = pending->num_rows >= m_batch_size;
+                const bool is_old  = m_max_linger.count() > 0 &&
+                                    (std::chrono::steady_clock::now() - pending->oldest) >= m_max_linger;
+                if (is_full || is_old)
                 {
-                    std::shared_ptr<OutputT> windowed_message{nullptr};
-                    make_output_message(incoming_message,
-                                        i,
-                                        std::min(i + this->m_batch_size, incoming_message->count()),
-                                        m_task.get(),
-                                        windowed_message);
-                    output.on_next(std::move(windowed_message));
+                    this->flush(*pending, output);
+                }
+                else if (auto* governor = MemoryGovernor::get(); governor != nullptr && governor->is_throttled())
+                {
+                    // Spilling an already spilled message does nothing
+                    for (auto& meta : pending->metas)
+                    {
+                        meta->spill();
+                    }
                 }
             },
             [&](std::exception_ptr error_ptr) {
                 output.on_error(error_ptr);
             },
-            [&]() {
+            [this, &output, pending]() {
+                this->flush(*pending, output);
                 output.on_completed();
             }));
     };
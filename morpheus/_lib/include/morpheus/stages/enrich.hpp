@@ -0,0 +1,262 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/objects/file_types.hpp"
+#include "morpheus/utilities/metrics.hpp"
+
+#include <cudf/join.hpp>  // for hash_join
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>  // for size_type
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rmm/cuda_stream.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>  // for milliseconds
+#include <condition_variable>
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uintmax_t
+#include <filesystem>  // for file_time_type
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>  // for pair
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** ReferenceTable *************************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Reference table, such as an asset inventory or threat intelligence feed, held in device memory along with the
+ * hash table of its keys, built once per version of the file and probed by every batch enriched.
+ *
+ * The file is loaded with `load_table_from_file`, the last row of each key being kept when keys are repeated. When
+ * `reload_interval` is not zero, a background thread checks the size and modification time of the file at that
+ * interval, and loads a changed file on a stream of its own. The new version replaces the current one once its hash
+ * table is built, batches being enriched with the previous version meanwhile and never waiting on a reload. A version
+ * which fails to load is logged, the previous one being kept.
+ */
+class ReferenceTable
+{
+  public:
+    /**
+     * @brief Loads the first version of the reference table
+     *
+     * @param filename : Parquet, CSV or JSON file of the table
+     * @param file_type : Type of the file, `FileTypes::Auto` to infer it from its extension
+     * @param key_columns : Columns of the table matched against the keys of the rows
+     * @param value_columns : Columns appended to the rows, every other column of the first version when empty
+     * @param reload_interval : Duration between two checks of the file for a new version, disabled when zero
+     * @throws std::invalid_argument If `key_columns` is empty, or a column is missing from the file
+     * @throws std::runtime_error If the file cannot be loaded
+     */
+    ReferenceTable(std::string filename,
+                   FileTypes file_type,
+                   std::vector<std::string> key_columns,
+                   std::vector<std::string> value_columns,
+                   std::chrono::milliseconds reload_interval);
+
+    /**
+     * @brief Stops the background thread, waiting for a reload in progress
+     */
+    ~ReferenceTable();
+
+    ReferenceTable(const ReferenceTable&)            = delete;
+    ReferenceTable& operator=(const ReferenceTable&) = delete;
+
+    /**
+     * @brief Returns the columns of the reference table matched by each row of `keys`, in the order of the rows. Rows
+     * without a match, or with a null key, hold nulls.
+     *
+     * @param keys : Keys of the rows, of the same number and types as the key columns
+     * @return std::pair<std::unique_ptr<cudf::table>, cudf::size_type> : The matched values, and the number of rows
+     * which matched
+     */
+    std::pair<std::unique_ptr<cudf::table>, cudf::size_type> lookup(const cudf::table_view& keys) const;
+
+    /**
+     * @brief Names of the columns returned by `lookup`
+     */
+    const std::vector<std::string>& value_columns() const;
+
+    /**
+     * @brief Loads the file when its size or modification time changed since the current version was loaded
+     *
+     * @return true : When a new version replaced the current one
+     */
+    bool reload();
+
+    /**
+     * @brief Number of versions loaded, including the first one
+     */
+    std::size_t num_versions() const;
+
+    /**
+     * @brief Number of rows of the current version
+     */
+    cudf::size_type num_rows() const;
+
+  private:
+    struct FileState
+    {
+        std::uintmax_t size{0};
+        std::filesystem::file_time_type write_time{};
+
+        bool operator==(const FileState& other) const;
+    };
+
+    struct Version
+    {
+        FileState file_state;
+        std::unique_ptr<cudf::table> keys;
+        std::unique_ptr<cudf::table> values;
+        std::unique_ptr<cudf::hash_join> join;  // Refers to `keys`
+    };
+
+    FileState stat_file() const;
+
+    // Loads the file and builds its hash table on `m_reload_stream`
+    std::shared_ptr<const Version> load(FileState file_state);
+
+    std::shared_ptr<const Version> current() const;
+
+    void reload_loop();
+
+    std::string m_filename;
+    FileTypes m_file_type;
+    std::vector<std::string> m_key_columns;
+    std::vector<std::string> m_value_columns;
+    std::chrono::milliseconds m_reload_interval;
+
+    rmm::cuda_stream m_reload_stream;
+
+    mutable std::mutex m_mutex;
+    std::shared_ptr<const Version> m_current;
+    std::size_t m_num_versions{0};
+
+    std::condition_variable m_stop_cv;
+    bool m_stopping{false};
+    std::thread m_reload_thread;
+};
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Enriches the payload of each `ControlMessage` with the columns of a `ReferenceTable`, such as the owner of an
+ * asset or the reputation of an address, matched by the key columns of its rows through a hash join on the device.
+ * Rows without a match hold nulls. Appended columns are named after the columns of the table with `prefix`, replacing
+ * any column of the payload of the same name.
+ *
+ * The payload is replaced by a new table holding the columns of the payload followed by the appended ones. A message
+ * without a payload, or whose payload fails to be enriched such as when its keys are missing, is an error passed to
+ * `on_error`. Several tables are joined by chaining several stages.
+ */
+class EnrichStage : public mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Enrich Stage object
+     *
+     * @param filename : Parquet, CSV or JSON file of the reference table
+     * @param file_type : Type of the file
+     * @param key_columns : Key columns of the reference table
+     * @param value_columns : Columns of the reference table appended to the rows, every other column when empty
+     * @param event_key_columns : Key columns of the rows, in the order of `key_columns`, the same names when empty
+     * @param prefix : Prepended to the names of the appended columns
+     * @param reload_interval : Duration between two checks of the file for a new version, disabled when zero
+     * @param metrics_name : Labels the metrics of the stage
+     */
+    EnrichStage(std::string filename,
+                FileTypes file_type,
+                std::vector<std::string> key_columns,
+                std::vector<std::string> value_columns,
+                std::vector<std::string> event_key_columns,
+                std::string prefix,
+                std::chrono::milliseconds reload_interval,
+                const std::string& metrics_name);
+
+    /**
+     * @brief Returns `meta` with the matched columns of the reference table appended
+     *
+     * @param meta
+     * @return std::shared_ptr<MessageMeta>
+     * @throws std::invalid_argument If a key column is missing from `meta`
+     */
+    std::shared_ptr<MessageMeta> enrich(const std::shared_ptr<MessageMeta>& meta);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    std::vector<std::string> m_event_key_columns;
+    std::string m_prefix;
+    ReferenceTable m_table;
+
+    std::shared_ptr<Counter> m_matched_rows;
+    std::shared_ptr<Counter> m_unmatched_rows;
+    std::shared_ptr<Gauge> m_versions;
+};
+
+/****** EnrichStageInterfaceProxy***************************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct EnrichStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize an EnrichStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param filename : Parquet, CSV or JSON file of the reference table
+     * @param file_type : Type of the file
+     * @param key_columns : Key columns of the reference table
+     * @param value_columns : Columns of the reference table appended to the rows, every other column when empty
+     * @param event_key_columns : Key columns of the rows, the same names as `key_columns` when empty
+     * @param prefix : Prepended to the names of the appended columns
+     * @param reload_interval_ms : Milliseconds between two checks of the file for a new version, disabled when 0
+     * @return std::shared_ptr<mrc::segment::Object<EnrichStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<EnrichStage>> init(mrc::segment::Builder& builder,
+                                                                    const std::string& name,
+                                                                    std::string filename,
+                                                                    FileTypes file_type,
+                                                                    std::vector<std::string> key_columns,
+                                                                    std::vector<std::string> value_columns,
+                                                                    std::vector<std::string> event_key_columns,
+                                                                    std::string prefix,
+                                                                    std::size_t reload_interval_ms);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
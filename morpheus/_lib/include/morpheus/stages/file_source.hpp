@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "morpheus/io/deserializers.hpp"  // for ColumnProjection, TableSchema
 #include "morpheus/messages/meta.hpp"
 
 #include <boost/fiber/context.hpp>
@@ -26,11 +27,14 @@
 #include <pymrc/node.hpp>
 #include <rxcpp/rx.hpp>  // for apply, make_subscriber, observable_member, is_on_error<>::not_void, is_on_next_of<>::not_void, trace_activity
 
+#include <cstddef>     // for size_t
 #include <filesystem>  // for path
 #include <memory>
 #include <optional>
 #include <string>
 #include <thread>
+#include <utility>  // for pair
+#include <vector>
 
 namespace morpheus {
 /****** Component public implementations *******************/
@@ -46,6 +50,11 @@ namespace morpheus {
 /**
  * @brief Load messages from a file. Source stage is used to load messages from a file and
  * dumping the contents into the pipeline immediately. Useful for testing performance and accuracy of a pipeline.
+ *
+ * When `chunk_bytes` is greater than zero the file is read by a `ChunkedTableReader`, one `MessageMeta` being emitted
+ * per chunk such that files larger than device memory can be read and downstream stages start on the first chunk. The
+ * next chunk is read on a separate thread while the current one is being emitted. Unless the file holds its own index
+ * column, the range index of each chunk continues from the previous one.
  */
 class FileSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<MessageMeta>>
 {
@@ -60,15 +69,31 @@ class FileSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<MessageM
      * @param filename : Name of the file from which the messages will be read
      * @param repeat : Repeats the input dataset multiple times. Useful to extend small datasets for debugging
      * @param json_lines: Whether to force json or jsonlines parsing
+     * @param chunk_bytes : When greater than zero, the file is read in chunks of about this many bytes
+     * @param schema : Columns to read along with their types, empty to read every column inferring their types
+     * @param projection : Columns read by the downstream stages, the other columns are dropped once parsed
      */
-    FileSourceStage(std::string filename, int repeat = 1, std::optional<bool> json_lines = std::nullopt);
+    FileSourceStage(std::string filename,
+                    int repeat                     = 1,
+                    std::optional<bool> json_lines = std::nullopt,
+                    std::size_t chunk_bytes        = 0,
+                    TableSchema schema             = {},
+                    ColumnProjection projection    = {});
 
   private:
     subscriber_fn_t build();
 
+    /**
+     * @brief Reads and emits the file one chunk at a time, see `ChunkedTableReader`
+     */
+    void emit_chunks(rxcpp::subscriber<source_type_t>& output);
+
     std::string m_filename;
     int m_repeat{1};
     std::optional<bool> m_json_lines;
+    std::size_t m_chunk_bytes{0};
+    TableSchema m_schema;
+    ColumnProjection m_projection;
 };
 
 /****** FileSourceStageInterfaceProxy***********************/
@@ -85,18 +110,31 @@ struct FileSourceStageInterfaceProxy
      * @param filename : Name of the file from which the messages will be read.
      * @param repeat : Repeats the input dataset multiple times. Useful to extend small datasets for debugging.
      * @param parser_kwargs : Optional arguments to pass to the file parser.
+     * @param chunk_bytes : When greater than zero, the file is read in chunks of about this many bytes.
+     * @param schema : Pairs of column names and type names of the columns to read, see `TableSchema::from_type_names`.
+     * An empty schema reads every column inferring their types.
+     * @param projection : Patterns of the columns read by the downstream stages, see `ColumnProjection`. An empty
+     * projection keeps every column.
      * @return std::shared_ptr<mrc::segment::Object<FileSourceStage>>
      */
-    static std::shared_ptr<mrc::segment::Object<FileSourceStage>> init(mrc::segment::Builder& builder,
-                                                                       const std::string& name,
-                                                                       std::string filename,
-                                                                       int repeat                   = 1,
-                                                                       pybind11::dict parser_kwargs = pybind11::dict());
-    static std::shared_ptr<mrc::segment::Object<FileSourceStage>> init(mrc::segment::Builder& builder,
-                                                                       const std::string& name,
-                                                                       std::filesystem::path filename,
-                                                                       int repeat                   = 1,
-                                                                       pybind11::dict parser_kwargs = pybind11::dict());
+    static std::shared_ptr<mrc::segment::Object<FileSourceStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::string filename,
+        int repeat                                              = 1,
+        pybind11::dict parser_kwargs                            = pybind11::dict(),
+        std::size_t chunk_bytes                                 = 0,
+        std::vector<std::pair<std::string, std::string>> schema = {},
+        const std::vector<std::string>& projection              = {});
+    static std::shared_ptr<mrc::segment::Object<FileSourceStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::filesystem::path filename,
+        int repeat                                              = 1,
+        pybind11::dict parser_kwargs                            = pybind11::dict(),
+        std::size_t chunk_bytes                                 = 0,
+        std::vector<std::pair<std::string, std::string>> schema = {},
+        const std::vector<std::string>& projection              = {});
 };
 #pragma GCC visibility pop
 /** @} */  // end of group
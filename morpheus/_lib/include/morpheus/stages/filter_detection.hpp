@@ -17,14 +17,18 @@
 
 #pragma once
 
+#include "morpheus/messages/control.hpp"
 #include "morpheus/messages/multi.hpp"
 #include "morpheus/objects/dev_mem_info.hpp"  // for DevMemInfo
 #include "morpheus/objects/filter_source.hpp"
+#include "morpheus/objects/tensor_buffer_pool.hpp"
+#include "morpheus/types.hpp"  // for RangeType, TensorIndex
 
 #include <boost/fiber/context.hpp>
 #include <mrc/segment/builder.hpp>
 #include <mrc/segment/object.hpp>
 #include <pymrc/node.hpp>
+#include <rmm/device_buffer.hpp>
 #include <rxcpp/rx.hpp>
 
 #include <cstddef>  // for size_t
@@ -32,6 +36,7 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace morpheus {
 /****** Component public implementations *******************/
@@ -49,7 +54,7 @@ namespace morpheus {
  * using a specified criteria. Rows in the `meta` dataframe are excluded if their associated value in the datasource
  * indicated by `field_name` is less than or equal to `threshold`.
  *
- * This stage can operate in two different modes set by the `copy` argument.
+ * This stage can operate in three different modes set by the `copy` and `mask_column` arguments.
  * When the `copy` argument is `true` (default), rows that meet the filter criteria are copied into a new dataframe.
  * When `false` sliced views are used instead.
  *
@@ -67,12 +72,19 @@ namespace morpheus {
  * messages could be high (in the worst case scenario as high as half the number of records in the incoming message).
  * Depending on the downstream stages, this can cause performance issues, especially if those stages need to acquire
  * the Python GIL.
+ *
+ * When `mask_column` is not empty, `copy` is ignored and every incoming message is emitted whole with the result of
+ * the filter written to the boolean `mask_column` of its dataframe. Neither the rows nor the ranges of matching rows
+ * are copied, leaving downstream stages to apply the mask themselves. The column must have been allocated upstream.
+ *
+ * Both `MultiMessage` and `ControlMessage` are supported. The slices of a `ControlMessage` are views of both its
+ * payload and its tensors.
  */
-class FilterDetectionsStage
-  : public mrc::pymrc::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>>
+template <typename MessageT>
+class FilterDetectionsStage : public mrc::pymrc::PythonNode<std::shared_ptr<MessageT>, std::shared_ptr<MessageT>>
 {
   public:
-    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>>;
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageT>, std::shared_ptr<MessageT>>;
     using typename base_t::sink_type_t;
     using typename base_t::source_type_t;
     using typename base_t::subscribe_fn_t;
@@ -85,22 +97,47 @@ class FilterDetectionsStage
      * @param filter_source : Indicate if the values used for filtering exist in either an output tensor
      * (`FilterSource::TENSOR`) or a column in a Dataframe (`FilterSource::DATAFRAME`).
      * @param field_name : Name of the tensor or Dataframe column to filter on default="probs"
+     * @param mask_column : When not empty, name of the boolean Dataframe column the filter is written to instead of
+     * filtering the rows default=""
      */
-    FilterDetectionsStage(float threshold, bool copy, FilterSource filter_source, std::string field_name = "probs");
+    FilterDetectionsStage(float threshold,
+                          bool copy,
+                          FilterSource filter_source,
+                          std::string field_name  = "probs",
+                          std::string mask_column = "");
 
   private:
     subscribe_fn_t build_operator();
-    DevMemInfo get_tensor_filter_source(const std::shared_ptr<morpheus::MultiMessage>& x);
-    DevMemInfo get_column_filter_source(const std::shared_ptr<morpheus::MultiMessage>& x);
+    DevMemInfo get_tensor_filter_source(const sink_type_t& x);
+    DevMemInfo get_column_filter_source(const sink_type_t& x);
+
+    /**
+     * @brief Writes the `num_rows` elements of `mask` to `m_mask_column` without waiting for the copy to complete
+     */
+    void set_mask(const sink_type_t& x, const std::shared_ptr<rmm::device_buffer>& mask, TensorIndex num_rows);
+
+    source_type_t slice(const sink_type_t& x, TensorIndex start, TensorIndex stop) const;
+    source_type_t copy_ranges(const sink_type_t& x,
+                              const std::vector<RangeType>& ranges,
+                              TensorIndex num_selected_rows) const;
 
     float m_threshold;
     bool m_copy;
     FilterSource m_filter_source;
     std::string m_field_name;
+    std::string m_mask_column;
     std::size_t m_num_class_labels;
     std::map<std::size_t, std::string> m_idx2label;
+
+    // Threshold outputs only live for the duration of a message, reused across messages
+    std::shared_ptr<TensorBufferPool> m_buffer_pool{TensorBufferPool::create()};
 };
 
+using FilterDetectionsStageMM =  // NOLINT(readability-identifier-naming)
+    FilterDetectionsStage<MultiMessage>;
+using FilterDetectionsStageCM =  // NOLINT(readability-identifier-naming)
+    FilterDetectionsStage<ControlMessage>;
+
 /****** FilterDetectionStageInterfaceProxy******************/
 /**
  * @brief Interface proxy, used to insulate python bindings.
@@ -108,7 +145,29 @@ class FilterDetectionsStage
 struct FilterDetectionStageInterfaceProxy
 {
     /**
-     * @brief Create and initialize a FilterDetectionStage, and return the result
+     * @brief Create and initialize a FilterDetectionStage that receives and emits MultiMessage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param threshold : Threshold to classify
+     * @param copy : Whether or not to perform a copy default=true
+     * @param filter_source : Indicate if the values used for filtering exist in either an output tensor
+     * (`FilterSource::TENSOR`) or a column in a Dataframe (`FilterSource::DATAFRAME`).
+     * @param field_name : Name of the tensor or Dataframe column to filter on default="probs"
+     * @param mask_column : When not empty, name of the boolean Dataframe column the filter is written to default=""
+     * @return std::shared_ptr<mrc::segment::Object<FilterDetectionsStageMM>>
+     */
+    static std::shared_ptr<mrc::segment::Object<FilterDetectionsStageMM>> init_multi(mrc::segment::Builder& builder,
+                                                                                     const std::string& name,
+                                                                                     float threshold,
+                                                                                     bool copy,
+                                                                                     FilterSource filter_source,
+                                                                                     std::string field_name,
+                                                                                     std::string mask_column);
+
+    /**
+     * @brief Create and initialize a FilterDetectionStage that receives and emits ControlMessage, and return the
+     * result
      *
      * @param builder : Pipeline context object reference
      * @param name : Name of a stage reference
@@ -117,14 +176,16 @@ struct FilterDetectionStageInterfaceProxy
      * @param filter_source : Indicate if the values used for filtering exist in either an output tensor
      * (`FilterSource::TENSOR`) or a column in a Dataframe (`FilterSource::DATAFRAME`).
      * @param field_name : Name of the tensor or Dataframe column to filter on default="probs"
-     * @return std::shared_ptr<mrc::segment::Object<FilterDetectionsStage>>
+     * @param mask_column : When not empty, name of the boolean Dataframe column the filter is written to default=""
+     * @return std::shared_ptr<mrc::segment::Object<FilterDetectionsStageCM>>
      */
-    static std::shared_ptr<mrc::segment::Object<FilterDetectionsStage>> init(mrc::segment::Builder& builder,
-                                                                             const std::string& name,
-                                                                             float threshold,
-                                                                             bool copy,
-                                                                             FilterSource filter_source,
-                                                                             std::string field_name);
+    static std::shared_ptr<mrc::segment::Object<FilterDetectionsStageCM>> init_cm(mrc::segment::Builder& builder,
+                                                                                  const std::string& name,
+                                                                                  float threshold,
+                                                                                  bool copy,
+                                                                                  FilterSource filter_source,
+                                                                                  std::string field_name,
+                                                                                  std::string mask_column);
 };
 
 #pragma GCC visibility pop
@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/objects/table_info.hpp"
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_view.hpp>
+#include <cudf/strings/regex/regex_program.hpp>  // for regex_program
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <cstdint>  // for int64_t
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>  // for pair
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** FilterRowsStage*************************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief A predicate on the values of a column, `op` being one of:
+ * - `matches` : the string contains a match of the regular expression `value`
+ * - `in_cidr` : the string is an IPv4 address within one of the comma separated CIDR blocks of `value`, such as
+ * `10.0.0.0/8,192.168.1.7`
+ * - `==`, `!=`, `<`, `<=`, `>`, `>=` : the value compares to `value`, parsed as a number for numeric columns
+ *
+ * Null values never match.
+ */
+struct RowPredicate
+{
+    std::string column;
+    std::string op;
+    std::string value;
+};
+
+/**
+ * @brief A set of predicates compiled once, such that evaluating them over a table only launches device work. Regular
+ * expressions are compiled to cuDF regex programs, CIDR blocks and numbers are parsed on the host.
+ */
+class RowFilter
+{
+  public:
+    /**
+     * @brief Compiles `predicates`
+     *
+     * @param predicates
+     * @param match_all : Whether a row matches when all of the predicates match, rather than any of them
+     * @param exclude : Whether the matching rows are dropped, rather than kept
+     * @throws std::invalid_argument If `predicates` is empty, an operator is unknown or a value can not be parsed
+     */
+    RowFilter(std::vector<RowPredicate> predicates, bool match_all, bool exclude);
+
+    /**
+     * @brief Evaluates the predicates over the rows of `table` as a single boolean mask
+     *
+     * @return std::unique_ptr<cudf::column> : BOOL8 column without nulls, true for the rows to keep
+     * @throws std::invalid_argument If a column is missing or its type does not support its operator
+     */
+    std::unique_ptr<cudf::column> keep_mask(const TableInfo& table) const;
+
+  private:
+    struct CompiledPredicate
+    {
+        RowPredicate predicate;
+        std::unique_ptr<cudf::strings::regex_program> program;
+        std::vector<std::pair<int64_t, int64_t>> networks;  // Network address and netmask of each CIDR block
+        double number{0};
+        bool is_number{false};
+    };
+
+    std::unique_ptr<cudf::column> evaluate(const CompiledPredicate& compiled, const TableInfo& table) const;
+
+    /**
+     * @brief Evaluates the predicate on `column`, which is not dictionary encoded, nulls being left in the result
+     */
+    std::unique_ptr<cudf::column> evaluate_values(const CompiledPredicate& compiled,
+                                                  const cudf::column_view& column) const;
+
+    std::vector<CompiledPredicate> m_predicates;
+    bool m_match_all;
+    bool m_exclude;
+};
+
+/**
+ * @brief Returns the rows of `meta` set in `keep_mask`, compacted into a new C++ backed table keeping the index of the
+ * rows. `meta` itself is returned when every row is kept, and `nullptr` when none is.
+ *
+ * @param meta
+ * @param keep_mask : BOOL8 column without nulls, with one row per row of `meta`
+ */
+std::shared_ptr<MessageMeta> filter_rows(const std::shared_ptr<MessageMeta>& meta, const cudf::column_view& keep_mask);
+
+/**
+ * @brief Returns the rows of `meta` kept by `filter`, see `filter_rows` above
+ */
+std::shared_ptr<MessageMeta> filter_rows(const std::shared_ptr<MessageMeta>& meta, const RowFilter& filter);
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Drops rows early in a pipeline, before they are copied to tensors and sent to inference, such as the requests
+ * to health check URLs or the traffic of allow listed addresses. The predicates are evaluated on the device as a
+ * single boolean mask per message, see `RowFilter`, and messages without any row left are not emitted.
+ */
+class FilterRowsStage : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Filter Rows Stage object
+     *
+     * @param predicates : Predicates on the columns of the rows, see `RowPredicate`
+     * @param match_all : Whether a row matches when all of the predicates match, rather than any of them
+     * @param exclude : Whether the matching rows are dropped, rather than kept
+     */
+    FilterRowsStage(std::vector<RowPredicate> predicates, bool match_all, bool exclude);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    RowFilter m_filter;
+};
+
+/****** FilterRowsStageInterfaceProxy***********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct FilterRowsStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a FilterRowsStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param predicates : Tuples of the column, operator and value of each predicate, see `RowPredicate`
+     * @param match_all : Whether a row matches when all of the predicates match, rather than any of them
+     * @param exclude : Whether the matching rows are dropped, rather than kept
+     * @return std::shared_ptr<mrc::segment::Object<FilterRowsStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<FilterRowsStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        const std::vector<std::tuple<std::string, std::string, std::string>>& predicates,
+        bool match_all,
+        bool exclude);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
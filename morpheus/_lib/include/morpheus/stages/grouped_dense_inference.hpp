@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/objects/dense_model_store.hpp"
+#include "morpheus/stages/inference_client_stage.hpp"
+#include "morpheus/types.hpp"  // for TensorMap, TensorIndex
+
+#include <mrc/coroutines/scheduler.hpp>
+#include <mrc/coroutines/task.hpp>
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** GroupedDenseInferenceClient*************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Inference session running the rows of many per-entity models of a `DenseModelStore`, such as one autoencoder
+ * per user, by batch rather than by model.
+ *
+ * Expects a row major float32 `input__0` tensor of features, and an integer `model_index` tensor holding the model
+ * index of each row as given by `DenseModelStore::model_index`. Returns the outputs of the models as a float32
+ * `output__0` tensor.
+ */
+class MORPHEUS_EXPORT GroupedDenseInferenceClientSession : public IInferenceClientSession
+{
+  public:
+    GroupedDenseInferenceClientSession(std::shared_ptr<DenseModelStore> store);
+
+    /**
+      @brief Gets the inference input mappings
+    */
+    std::vector<TensorModelMapping> get_input_mappings(std::vector<TensorModelMapping> input_map_overrides) override;
+
+    /**
+      @brief Gets the inference output mappings
+    */
+    std::vector<TensorModelMapping> get_output_mappings(std::vector<TensorModelMapping> output_map_overrides) override;
+
+    /**
+      @brief Runs each row of the inputs through its model. The inference completes before returning.
+    */
+    mrc::coroutines::Task<TensorMap> infer(TensorMap&& inputs, std::shared_ptr<mrc::coroutines::Scheduler> on) override;
+
+  private:
+    std::shared_ptr<DenseModelStore> m_store;
+};
+
+/**
+ * @brief Inference client of the `InferenceClientStage` running the per-entity models of a `DenseModelStore`. Paired
+ * with the batching of the stage (`max_batch_rows`), the messages of many entities are run together, a kernel launch
+ * per layer covering every entity of the batch.
+ */
+class MORPHEUS_EXPORT GroupedDenseInferenceClient : public IInferenceClient
+{
+  public:
+    GroupedDenseInferenceClient(std::shared_ptr<DenseModelStore> store);
+
+    /**
+      @brief Creates an inference session, every session sharing the store of the client.
+    */
+    std::unique_ptr<IInferenceClientSession> create_session() override;
+
+  private:
+    std::shared_ptr<DenseModelStore> m_store;
+};
+
+/****** GroupedDenseInferenceStageInterfaceProxy************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct MORPHEUS_EXPORT GroupedDenseInferenceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize an InferenceClientStage running the models of `model_store`, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param model_store : Store of the models the rows are run through
+     * @param needs_logits : Determines if logits are required.
+     * @param input_mapping : Dictionary where the keys are the names the model expects (`input__0` and `model_index`)
+     * and the values are the names of the tensors of the messages.
+     * @param output_mapping : Dictionary where the keys are the names the model outputs (`output__0`) and the values
+     * are the names of the tensors of the responses.
+     * @param max_batch_rows : Maximum number of rows of a batch merging the inputs of several messages, or zero to run
+     * each message separately.
+     * @param max_batch_delay_ms : Maximum time in milliseconds a message waits for others to be merged with.
+     * @param num_sessions : Number of sessions, sharing the models of the store.
+     * @return std::shared_ptr<mrc::segment::Object<InferenceClientStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<InferenceClientStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::shared_ptr<DenseModelStore> model_store,
+        bool needs_logits,
+        std::map<std::string, std::string> input_mapping,
+        std::map<std::string, std::string> output_mapping,
+        TensorIndex max_batch_rows = 0,
+        int64_t max_batch_delay_ms = 1,
+        std::size_t num_sessions   = 1);
+};
+/** @} */  // end of group
+}  // namespace morpheus
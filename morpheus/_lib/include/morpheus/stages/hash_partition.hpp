@@ -0,0 +1,202 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+
+#include <boost/fiber/context.hpp>
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <cstddef>  // for size_t
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** HashPartitionStage**********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief The partitions of a single message, `nullptr` for the partitions without any row
+ */
+template <typename MessageT>
+struct MessagePartitions
+{
+    std::vector<std::shared_ptr<MessageT>> partitions;
+};
+
+/**
+ * @brief Splits the rows of `meta` into `num_partitions` C++ backed tables by the hash of their `key_columns`, such
+ * that the rows sharing the same keys always land in the same partition. The index of the rows is kept. Each partition
+ * owns its rows, sharing nothing with `meta` or the other partitions.
+ *
+ * @param meta
+ * @param key_columns : Columns hashed to select the partition of each row
+ * @param num_partitions
+ * @return std::vector<std::shared_ptr<MessageMeta>> : One entry per partition, `nullptr` for the empty ones. `meta`
+ * itself when `num_partitions` is one
+ * @throws std::invalid_argument If a key column is missing from `meta`
+ */
+std::vector<std::shared_ptr<MessageMeta>> hash_partition(const std::shared_ptr<MessageMeta>& meta,
+                                                         const std::vector<std::string>& key_columns,
+                                                         std::size_t num_partitions);
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Partitions the rows of each message by the hash of their key columns, computed once per message on the
+ * device, see `hash_partition`. Paired with one `PartitionSelectStage` per partition, the partitions are routed to
+ * replicas of stateful stages, such as rolling windows or deduplication, each replica seeing every row of its keys and
+ * none of the others, without sharing any state.
+ *
+ * The partitions of a `ControlMessage` copy its config and metadata, but not its tensors.
+ */
+template <typename MessageT>
+class HashPartitionStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<MessageT>, std::shared_ptr<MessagePartitions<MessageT>>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageT>, std::shared_ptr<MessagePartitions<MessageT>>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Hash Partition Stage object
+     *
+     * @param key_columns : Columns hashed to select the partition of each row
+     * @param num_partitions : Number of partitions, at least one
+     */
+    HashPartitionStage(std::vector<std::string> key_columns, std::size_t num_partitions);
+
+    /**
+     * Called every time a message is passed to this stage
+     */
+    source_type_t on_data(sink_type_t x);
+
+  private:
+    std::vector<std::string> m_key_columns;
+    std::size_t m_num_partitions;
+};
+
+/**
+ * @brief Emits a single partition of the messages of a `HashPartitionStage`, dropping the messages without any row in
+ * it.
+ */
+template <typename MessageT>
+class PartitionSelectStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<MessagePartitions<MessageT>>, std::shared_ptr<MessageT>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessagePartitions<MessageT>>, std::shared_ptr<MessageT>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Partition Select Stage object
+     *
+     * @param partition : Index of the emitted partition
+     */
+    PartitionSelectStage(std::size_t partition);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    std::size_t m_partition;
+};
+
+using HashPartitionStageMeta   = HashPartitionStage<MessageMeta>;       // NOLINT(readability-identifier-naming)
+using HashPartitionStageCM     = HashPartitionStage<ControlMessage>;    // NOLINT(readability-identifier-naming)
+using PartitionSelectStageMeta = PartitionSelectStage<MessageMeta>;     // NOLINT(readability-identifier-naming)
+using PartitionSelectStageCM   = PartitionSelectStage<ControlMessage>;  // NOLINT(readability-identifier-naming)
+
+/****** HashPartitionStageInterfaceProxy********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct HashPartitionStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a HashPartitionStage receiving `MessageMeta`, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param key_columns : Columns hashed to select the partition of each row
+     * @param num_partitions : Number of partitions
+     * @return std::shared_ptr<mrc::segment::Object<HashPartitionStageMeta>>
+     */
+    static std::shared_ptr<mrc::segment::Object<HashPartitionStageMeta>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::vector<std::string> key_columns,
+        std::size_t num_partitions);
+
+    /**
+     * @brief Create and initialize a HashPartitionStage receiving `ControlMessage`, and return the result. See `init`
+     * for the parameters.
+     *
+     * @return std::shared_ptr<mrc::segment::Object<HashPartitionStageCM>>
+     */
+    static std::shared_ptr<mrc::segment::Object<HashPartitionStageCM>> init_cm(mrc::segment::Builder& builder,
+                                                                               const std::string& name,
+                                                                               std::vector<std::string> key_columns,
+                                                                               std::size_t num_partitions);
+};
+
+/****** PartitionSelectStageInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct PartitionSelectStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a PartitionSelectStage emitting `MessageMeta`, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param partition : Index of the emitted partition
+     * @return std::shared_ptr<mrc::segment::Object<PartitionSelectStageMeta>>
+     */
+    static std::shared_ptr<mrc::segment::Object<PartitionSelectStageMeta>> init(mrc::segment::Builder& builder,
+                                                                                 const std::string& name,
+                                                                                 std::size_t partition);
+
+    /**
+     * @brief Create and initialize a PartitionSelectStage emitting `ControlMessage`, and return the result. See
+     * `init` for the parameters.
+     *
+     * @return std::shared_ptr<mrc::segment::Object<PartitionSelectStageCM>>
+     */
+    static std::shared_ptr<mrc::segment::Object<PartitionSelectStageCM>> init_cm(mrc::segment::Builder& builder,
+                                                                                 const std::string& name,
+                                                                                 std::size_t partition);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,162 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"
+
+#include <boost/beast/http/verb.hpp>  // for verb
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** HttpClientSinkStage********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Write all messages to an HTTP endpoint. Each `MessageMeta` is split into payloads of at most
+ * `max_rows_per_payload` rows which are serialized to JSON on the GPU and sent by a pool of `max_connections` workers,
+ * each holding a persistent connection to the server. This bounds the number of requests in flight to
+ * `max_connections`, once all of the workers are busy, incoming messages are held back until a worker is available.
+ *
+ * Failed requests are retried with an exponential backoff starting at `error_sleep_time`. A request which fails after
+ * `max_retries` attempts is reported as an error on the next message, or once the input completes.
+ */
+class HttpClientSinkStage : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Http Client Sink Stage object
+     *
+     * @param host : Host name or address of the server
+     * @param port : Port of the server
+     * @param target : Request target, the path including any query string
+     * @param method : HTTP method to use, one of "POST", "PUT" or "PATCH"
+     * @param headers : Headers to include in each request
+     * @param error_sleep_time : Amount of time to sleep after the first failed request, doubling on each retry
+     * @param respect_retry_after_header : If true, a `Retry-After` header sent by the server takes precedence over
+     * `error_sleep_time`
+     * @param request_timeout : Maximum amount of time to wait for each request
+     * @param accept_status_codes : Status codes indicating the request succeeded
+     * @param max_retries : Maximum number of attempts for each payload
+     * @param max_rows_per_payload : Maximum number of rows in a single request
+     * @param lines : If true, payloads are serialized as JSON lines, otherwise as a JSON array of objects
+     * @param max_connections : Number of persistent connections, and concurrent requests, to the server
+     */
+    HttpClientSinkStage(std::string host,
+                        unsigned short port,
+                        std::string target,
+                        std::string method                         = "POST",
+                        std::map<std::string, std::string> headers = {},
+                        std::chrono::milliseconds error_sleep_time = std::chrono::milliseconds(100),
+                        bool respect_retry_after_header            = true,
+                        std::chrono::seconds request_timeout       = std::chrono::seconds(30),
+                        std::vector<unsigned> accept_status_codes  = {200, 201, 202},
+                        std::size_t max_retries                    = 10,
+                        std::size_t max_rows_per_payload           = 10000,
+                        bool lines                                 = false,
+                        std::size_t max_connections                = 8);
+
+    ~HttpClientSinkStage() override = default;
+
+  private:
+    subscribe_fn_t build_operator();
+
+    std::string m_host;
+    std::string m_port;
+    std::string m_target;
+    boost::beast::http::verb m_method;
+    std::map<std::string, std::string> m_headers;
+    std::chrono::milliseconds m_error_sleep_time;
+    bool m_respect_retry_after_header;
+    std::chrono::seconds m_request_timeout;
+    std::vector<unsigned> m_accept_status_codes;
+    std::size_t m_max_retries;
+    std::size_t m_max_rows_per_payload;
+    bool m_lines;
+    std::size_t m_max_connections;
+};
+
+/****** HttpClientSinkStageInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct HttpClientSinkStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a HttpClientSinkStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param host : Host name or address of the server
+     * @param port : Port of the server
+     * @param target : Request target, the path including any query string
+     * @param method : HTTP method to use, one of "POST", "PUT" or "PATCH"
+     * @param headers : Headers to include in each request
+     * @param error_sleep_time : Amount of time in seconds to sleep after the first failed request
+     * @param respect_retry_after_header : If true, a `Retry-After` header sent by the server is respected
+     * @param request_timeout : Maximum amount of time in seconds to wait for each request
+     * @param accept_status_codes : Status codes indicating the request succeeded
+     * @param max_retries : Maximum number of attempts for each payload
+     * @param max_rows_per_payload : Maximum number of rows in a single request
+     * @param lines : If true, payloads are serialized as JSON lines, otherwise as a JSON array of objects
+     * @param max_connections : Number of persistent connections, and concurrent requests, to the server
+     * @return std::shared_ptr<mrc::segment::Object<HttpClientSinkStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<HttpClientSinkStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::string host,
+        unsigned short port,
+        std::string target,
+        std::string method,
+        std::map<std::string, std::string> headers,
+        float error_sleep_time,
+        bool respect_retry_after_header,
+        int64_t request_timeout,
+        std::vector<unsigned> accept_status_codes,
+        std::size_t max_retries,
+        std::size_t max_rows_per_payload,
+        bool lines,
+        std::size_t max_connections);
+};
+
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -17,29 +17,40 @@
 
 #pragma once
 
+#include "morpheus/io/deserializers.hpp"       // for ColumnProjection
+#include "morpheus/io/payload_decoder.hpp"     // for PayloadDecoder
+#include "morpheus/io/source_capture.hpp"      // for SourceCaptureWriter
 #include "morpheus/messages/meta.hpp"          // for MessageMeta
 #include "morpheus/utilities/http_server.hpp"  // for HttpServer
 
-#include <boost/fiber/buffered_channel.hpp>  // for buffered_channel
-#include <boost/fiber/context.hpp>           // for context
-#include <cudf/io/types.hpp>                 // for table_with_metadata
-#include <mrc/segment/builder.hpp>           // for segment::Builder
-#include <mrc/segment/object.hpp>            // for segment::Object
-#include <pymrc/node.hpp>                    // for PythonSource
-#include <rxcpp/rx.hpp>                      // for subscriber
+#include <boost/fiber/buffered_channel.hpp>   // for buffered_channel
+#include <boost/fiber/context.hpp>            // for context
+#include <cudf/io/types.hpp>                  // for table_with_metadata
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
+#include <mrc/segment/builder.hpp>            // for segment::Builder
+#include <mrc/segment/object.hpp>             // for segment::Object
+#include <pymrc/node.hpp>                     // for PythonSource
+#include <rmm/cuda_stream_view.hpp>           // for cuda_stream_view
+#include <rxcpp/rx.hpp>                       // for subscriber
 
+#include <atomic>   // for atomic
 #include <chrono>   // for duration
 #include <cstddef>  // for size_t
 #include <cstdint>  // for int64_t
 #include <memory>   // for shared_ptr & unique_ptr
-#include <ratio>    // for std::milli
 #include <string>   // for string & to_string
+#include <string_view>
+#include <thread>  // for thread
+#include <vector>  // for vector
 // IWYU thinks we're using thread::operator<<
 // IWYU pragma: no_include <thread>
 
 namespace morpheus {
 using table_t         = std::unique_ptr<cudf::io::table_with_metadata>;
 using request_queue_t = boost::fibers::buffered_channel<table_t>;
+using payload_queue_t = boost::fibers::buffered_channel<std::string>;
+
+constexpr std::size_t DefaultMaxBatchBytes = 8 * 1024 * 1024;
 
 /****** Component public implementations *******************/
 /****** HttpServerSourceStage *************************************/
@@ -61,19 +72,28 @@ class HttpServerSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<Me
     using typename base_t::source_type_t;
     using typename base_t::subscriber_fn_t;
 
-    HttpServerSourceStage(std::string bind_address             = "127.0.0.1",
-                          unsigned short port                  = 8080,
-                          std::string endpoint                 = "/message",
-                          std::string method                   = "POST",
-                          unsigned accept_status               = 201,
-                          float sleep_time                     = 0.1f,
-                          long queue_timeout                   = 5,
-                          std::size_t max_queue_size           = 1024,
-                          unsigned short num_server_threads    = 1,
-                          std::size_t max_payload_size         = DefaultMaxPayloadSize,
-                          std::chrono::seconds request_timeout = std::chrono::seconds(30),
-                          bool lines                           = false,
-                          std::size_t stop_after               = 0);
+    HttpServerSourceStage(std::string bind_address                  = "127.0.0.1",
+                          unsigned short port                       = 8080,
+                          std::string endpoint                      = "/message",
+                          std::string method                        = "POST",
+                          unsigned accept_status                    = 201,
+                          float sleep_time                          = 0.1f,
+                          long queue_timeout                        = 5,
+                          std::size_t max_queue_size                = 1024,
+                          unsigned short num_server_threads         = 1,
+                          std::size_t max_payload_size              = DefaultMaxPayloadSize,
+                          std::chrono::seconds request_timeout      = std::chrono::seconds(30),
+                          bool lines                                = false,
+                          std::size_t stop_after                    = 0,
+                          bool coalesce_payloads                    = false,
+                          std::size_t max_batch_bytes               = DefaultMaxBatchBytes,
+                          std::size_t max_batch_rows                = 0,
+                          std::chrono::milliseconds max_batch_delay = std::chrono::milliseconds(10),
+                          std::size_t stream_chunk_size             = 0,
+                          std::size_t num_parse_workers             = 0,
+                          ColumnProjection projection               = {},
+                          const std::string& payload_format         = "json",
+                          const std::string& capture_path           = "");
     ~HttpServerSourceStage() override;
 
     void close();
@@ -82,12 +102,59 @@ class HttpServerSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<Me
     subscriber_fn_t build();
     void source_generator(rxcpp::subscriber<source_type_t> subscriber);
 
-    std::chrono::duration<float, std::milli> m_sleep_time;
+    /**
+     * @brief Used when `coalesce_payloads` is set. Collects raw payloads until either `max_batch_bytes`,
+     * `max_batch_rows` or `max_batch_delay` is reached and parses them with a single call to `read_json`.
+     */
+    void coalescing_source_generator(rxcpp::subscriber<source_type_t> subscriber);
+
+    void emit_table(cudf::io::table_with_metadata&& table, rxcpp::subscriber<source_type_t>& subscriber);
+
+    /**
+     * @brief Parses the body of a single request, with `m_decoder` when the payloads are not JSON
+     */
+    cudf::io::table_with_metadata parse_payload(std::string_view payload,
+                                                rmm::cuda_stream_view stream = cudf::get_default_stream()) const;
+
+    /**
+     * @brief Used when `num_parse_workers` is set. Parses payloads from `m_payload_queue` pushing the results to
+     * `m_queue` until the payload queue is closed.
+     */
+    void parse_worker();
+
+    // Maximum amount of time to wait for a request before checking if the server is still running
+    std::chrono::microseconds m_sleep_time;
     std::chrono::duration<long> m_queue_timeout;
     std::unique_ptr<HttpServer> m_server;
     request_queue_t m_queue;
     std::size_t m_stop_after;
     std::size_t m_records_emitted;
+
+    bool m_lines;
+
+    // Only used when coalescing payloads
+    bool m_coalesce_payloads;
+    std::size_t m_max_batch_bytes;
+    std::size_t m_max_batch_rows;
+    std::chrono::milliseconds m_max_batch_delay;
+
+    // Only used with parse workers
+    std::size_t m_num_parse_workers;
+    std::vector<std::thread> m_parse_workers;
+
+    // Used when either coalescing payloads or with parse workers, holds the raw payloads until they are parsed.
+    // `m_pending_payloads` counts payloads which have been accepted but not yet emitted by a parse worker.
+    payload_queue_t m_payload_queue;
+    std::atomic<std::size_t> m_pending_payloads{0};
+
+    // Columns read by the downstream stages, the other columns are dropped once a payload is parsed
+    ColumnProjection m_projection;
+
+    // Unset for JSON payloads, which are read from the request body without any copy
+    std::shared_ptr<PayloadDecoder> m_decoder;
+
+    // Unset unless every emitted batch is recorded to a capture log, see `SourceCaptureWriter`
+    std::shared_ptr<SourceCaptureWriter> m_capture;
 };
 
 /****** HttpServerSourceStageInterfaceProxy***********************/
@@ -96,21 +163,31 @@ class HttpServerSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<Me
  */
 struct HttpServerSourceStageInterfaceProxy
 {
-    static std::shared_ptr<mrc::segment::Object<HttpServerSourceStage>> init(mrc::segment::Builder& builder,
-                                                                             const std::string& name,
-                                                                             std::string bind_address,
-                                                                             unsigned short port,
-                                                                             std::string endpoint,
-                                                                             std::string method,
-                                                                             unsigned accept_status,
-                                                                             float sleep_time,
-                                                                             long queue_timeout,
-                                                                             std::size_t max_queue_size,
-                                                                             unsigned short num_server_threads,
-                                                                             std::size_t max_payload_size,
-                                                                             int64_t request_timeout,
-                                                                             bool lines,
-                                                                             std::size_t stop_after);
+    static std::shared_ptr<mrc::segment::Object<HttpServerSourceStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::string bind_address,
+        unsigned short port,
+        std::string endpoint,
+        std::string method,
+        unsigned accept_status,
+        float sleep_time,
+        long queue_timeout,
+        std::size_t max_queue_size,
+        unsigned short num_server_threads,
+        std::size_t max_payload_size,
+        int64_t request_timeout,
+        bool lines,
+        std::size_t stop_after,
+        bool coalesce_payloads,
+        std::size_t max_batch_bytes,
+        std::size_t max_batch_rows,
+        int64_t max_batch_delay_ms,
+        std::size_t stream_chunk_size,
+        std::size_t num_parse_workers,
+        const std::vector<std::string>& projection,
+        const std::string& payload_format,
+        const std::string& capture_path);
 };
 #pragma GCC visibility pop
 /** @} */  // end of group
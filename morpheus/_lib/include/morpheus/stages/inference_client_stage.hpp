@@ -20,7 +20,12 @@
 #include "morpheus/export.h"
 #include "morpheus/messages/multi_inference.hpp"
 #include "morpheus/messages/multi_response.hpp"
+#include "morpheus/objects/cuda_graph_cache.hpp"
+#include "morpheus/objects/inference_result_cache.hpp"
+#include "morpheus/objects/tensor_buffer_pool.hpp"
 #include "morpheus/types.hpp"
+#include "morpheus/utilities/cuda_util.hpp"
+#include "morpheus/utilities/metrics.hpp"
 
 #include <mrc/coroutines/async_generator.hpp>
 #include <mrc/coroutines/scheduler.hpp>
@@ -30,6 +35,8 @@
 #include <pybind11/pybind11.h>
 #include <pymrc/asyncio_runnable.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -68,9 +75,11 @@ class MORPHEUS_EXPORT IInferenceClientSession
         std::vector<TensorModelMapping> output_map_overrides) = 0;
 
     /**
-      @brief Invokes a single tensor inference
+      @brief Invokes a single tensor inference. Inferences completing asynchronously are resumed on `on`, rather than
+      on the thread of the client completing them.
     */
-    virtual mrc::coroutines::Task<TensorMap> infer(TensorMap&& inputs) = 0;
+    virtual mrc::coroutines::Task<TensorMap> infer(TensorMap&& inputs,
+                                                   std::shared_ptr<mrc::coroutines::Scheduler> on) = 0;
 };
 
 class MORPHEUS_EXPORT IInferenceClient
@@ -92,6 +101,10 @@ class MORPHEUS_EXPORT IInferenceClient
 /**
  * @brief Perform inference with Triton Inference Server.
  * This class specifies which inference implementation category (Ex: NLP/FIL) is needed for inferencing.
+ *
+ * The duration of each phase of a message, waiting for a merged request to be sent, inference and post-processing, is
+ * recorded by the `morpheus_inference_phase_seconds` histograms along with the number of retries, labelled by model.
+ * Messages are post-processed on the device of their `TensorMemory`.
  */
 class MORPHEUS_EXPORT InferenceClientStage
   : public mrc::pymrc::AsyncioRunnable<std::shared_ptr<MultiInferenceMessage>, std::shared_ptr<MultiResponseMessage>>
@@ -109,12 +122,32 @@ class MORPHEUS_EXPORT InferenceClientStage
      * @param needs_logits : Determines if logits are required.
      * @param inout_mapping : Dictionary used to map pipeline input/output names to Triton input/output names. Use this
      * if the Morpheus names do not match the model.
+     * @param use_cuda_graphs : Launch the post-processing of all output tensors as a single CUDA graph, cached by the
+     * shapes of the outputs. Reduces the launch overhead when consecutive batches share the same shapes.
+     * @param max_batch_rows : When greater than zero, the inputs of messages arriving within `max_batch_delay` of each
+     * other are merged into a single request of up to `max_batch_rows` rows, the outputs of which are split back up by
+     * row. Typically the `max_batch_size` of the model. Only messages whose inputs share the same row shapes, such as
+     * those tokenized to the same sequence length, are merged. Zero disables the merging of messages.
+     * @param max_batch_delay : Maximum time the first message of a merged request waits for more messages to arrive.
+     * @param num_sessions : Number of inference sessions, each message is inferred with the session with the fewest
+     * messages in flight. A session which fails is replaced without affecting the others.
+     * @param cache_capacity : When greater than zero, the outputs of up to `cache_capacity` rows are cached on the
+     * device by a hash of their inputs, only the rows missing from the cache are inferred. Zero disables the cache.
+     * @param warm_up : Create every session when the stage is constructed, connecting to the server and querying the
+     * model ahead of the first message. A session which cannot be created is left to be created by the first message
+     * using it.
      */
     InferenceClientStage(std::unique_ptr<IInferenceClient>&& client,
                          std::string model_name,
                          bool needs_logits,
                          std::vector<TensorModelMapping> input_mapping,
-                         std::vector<TensorModelMapping> output_mapping);
+                         std::vector<TensorModelMapping> output_mapping,
+                         bool use_cuda_graphs                      = false,
+                         TensorIndex max_batch_rows                = 0,
+                         std::chrono::milliseconds max_batch_delay = std::chrono::milliseconds(1),
+                         std::size_t num_sessions                  = 1,
+                         std::size_t cache_capacity                = 0,
+                         bool warm_up                              = false);
 
     /**
      * Process a single MultiInferenceMessage by running the constructor-provided inference client against it's Tensor,
@@ -124,17 +157,131 @@ class MORPHEUS_EXPORT InferenceClientStage
         std::shared_ptr<MultiInferenceMessage>&& data, std::shared_ptr<mrc::coroutines::Scheduler> on) override;
 
   private:
+    struct PendingBatch;
+
+    /**
+     * @brief A session of the pool along with the number of messages currently using it
+     */
+    struct SessionSlot
+    {
+        std::shared_ptr<IInferenceClientSession> session;
+        std::size_t num_in_flight{0};
+    };
+
+    /**
+     * @brief Returns the session with the fewest messages in flight, creating it if needed. The index of its slot is
+     * written to `slot_index` and must be given to `release_session`.
+     */
+    std::shared_ptr<IInferenceClientSession> acquire_session(std::size_t& slot_index);
+
+    /**
+     * @brief Releases a session acquired by `acquire_session`, removing it from the pool when `failed` is true
+     */
+    void release_session(std::size_t slot_index, const std::shared_ptr<IInferenceClientSession>& session, bool failed);
+
+    /**
+     * @brief Infers `inputs` as part of a request shared with other messages. The first message of a request waits up
+     * to `m_max_batch_delay` for others to join it, and whichever message closes the request, either by filling it or
+     * by waiting out the delay, sends it. Only messages on the same `device_id` share a request. Returns this
+     * message's rows of the outputs.
+     */
+    mrc::coroutines::Task<TensorMap> infer_batched(std::shared_ptr<IInferenceClientSession> session,
+                                                   TensorMap&& inputs,
+                                                   TensorIndex num_rows,
+                                                   int device_id,
+                                                   std::shared_ptr<mrc::coroutines::Scheduler> on);
+
+    /**
+     * @brief Infers only the rows of `inputs` missing from `m_result_cache`, returning the outputs of every row
+     */
+    mrc::coroutines::Task<TensorMap> infer_cached(std::shared_ptr<IInferenceClientSession> session,
+                                                  TensorMap&& inputs,
+                                                  TensorIndex num_rows,
+                                                  std::shared_ptr<mrc::coroutines::Scheduler> on);
+
+    /**
+     * @brief Sends a closed batch as a single request and wakes up each message waiting on it.
+     */
+    mrc::coroutines::Task<> send_batch(std::shared_ptr<PendingBatch> batch,
+                                       std::shared_ptr<mrc::coroutines::Scheduler> on);
+
     std::string m_model_name;
     std::shared_ptr<IInferenceClient> m_client;
-    std::shared_ptr<IInferenceClientSession> m_session;
+    std::vector<SessionSlot> m_sessions;  // Guarded by `m_session_mutex`
     bool m_needs_logits{true};
     std::vector<TensorModelMapping> m_input_mapping;
     std::vector<TensorModelMapping> m_output_mapping;
     std::mutex m_session_mutex;
 
+    // Reduced and logits outputs are returned to the pool once the response messages holding them are destroyed
+    std::shared_ptr<TensorBufferPool> m_buffer_pool{TensorBufferPool::create()};
+
+    // Only set when CUDA graphs are enabled
+    std::unique_ptr<CudaGraphCache> m_graph_cache;
+
+    // Only set when the result cache is enabled
+    std::unique_ptr<InferenceResultCache> m_result_cache;
+
+    // Device the buffer pool and caches were created on
+    int m_device_id{CudaUtil::current_device()};
+
+    std::shared_ptr<Histogram> m_queue_seconds;
+    std::shared_ptr<Histogram> m_infer_seconds;
+    std::shared_ptr<Histogram> m_post_process_seconds;
+    std::shared_ptr<Counter> m_retries;
+
+    TensorIndex m_max_batch_rows;
+    std::chrono::milliseconds m_max_batch_delay;
+    std::mutex m_batch_mutex;
+    // Batches still accepting messages, keyed by the types and row shapes of their inputs, guarded by `m_batch_mutex`
+    std::map<std::string, std::shared_ptr<PendingBatch>> m_open_batches;
+
     int32_t m_retry_max = 10;
 };
 
+/**
+ * @brief Infers each message with several models at once, such as a classifier and a NER model sharing a tokenizer,
+ * so that the inputs are prepared a single time rather than once per pipeline. Each model is inferred by an
+ * `InferenceClientStage` of its own, with the sessions, batching and caching of that stage, and the outputs of all
+ * models are merged into the `ResponseMemory` of a single `MultiResponseMessage`.
+ *
+ * The output mapping of each model must name its outputs apart from those of the other models, e.g. `ner_probs` and
+ * `cls_probs`, a message whose models return outputs of the same name fails.
+ */
+class MORPHEUS_EXPORT FanOutInferenceClientStage
+  : public mrc::pymrc::AsyncioRunnable<std::shared_ptr<MultiInferenceMessage>, std::shared_ptr<MultiResponseMessage>>
+{
+  public:
+    using sink_type_t   = std::shared_ptr<MultiInferenceMessage>;
+    using source_type_t = std::shared_ptr<MultiResponseMessage>;
+
+    /**
+     * @brief Construct a new Fan Out Inference Client Stage object
+     *
+     * @param models : Stages inferring each of the models, they are only used through their `on_data` and are not
+     * part of the segment.
+     */
+    FanOutInferenceClientStage(std::vector<std::unique_ptr<InferenceClientStage>>&& models);
+
+    /**
+     * Infers a single MultiInferenceMessage with every model concurrently, and yields the merged outputs as a single
+     * MultiResponseMessage
+     */
+    mrc::coroutines::AsyncGenerator<std::shared_ptr<MultiResponseMessage>> on_data(
+        std::shared_ptr<MultiInferenceMessage>&& data, std::shared_ptr<mrc::coroutines::Scheduler> on) override;
+
+  private:
+    /**
+     * @brief Infers `data` with a single model, returning its response
+     */
+    static mrc::coroutines::Task<std::shared_ptr<MultiResponseMessage>> infer_model(
+        InferenceClientStage& model,
+        std::shared_ptr<MultiInferenceMessage> data,
+        std::shared_ptr<mrc::coroutines::Scheduler> on);
+
+    std::vector<std::unique_ptr<InferenceClientStage>> m_models;
+};
+
 /****** InferenceClientStageInferenceProxy******************/
 /**
  * @brief Interface proxy, used to insulate python bindings.
@@ -148,10 +295,30 @@ struct MORPHEUS_EXPORT InferenceClientStageInterfaceProxy
      * @param name : Name of a stage reference
      * @param model_name : Name of the model specifies which model can handle the inference requests that are sent to
      * Triton inference
-     * @param server_url : Triton server URL.
+     * @param server_url : Triton server URL, or a comma separated list of the URLs of several servers serving the
+     * model. Requests are routed across the servers by their latency and error rate.
      * @param needs_logits : Determines if logits are required.
      * @param inout_mapping : Dictionary used to map pipeline input/output names to Triton input/output names. Use this
      * if the Morpheus names do not match the model.
+     * @param use_cuda_graphs : Launch the post-processing of all output tensors as a single CUDA graph.
+     * @param use_shared_memory : Connect to Triton over gRPC, exchanging the inputs and outputs through CUDA shared
+     * memory. Requires Triton to be running on the same machine.
+     * @param max_concurrent_batches : Maximum number of mini-batches of a single message in flight at once, when
+     * greater than one requests are sent asynchronously over gRPC. HTTP requests are always sent one at a time.
+     * @param max_batch_rows : Maximum number of rows of a request merging the inputs of several messages, or zero to
+     * send each message separately.
+     * @param max_batch_delay_ms : Maximum time in milliseconds a message waits for others to be merged with.
+     * @param num_connections : Number of sessions, each connecting to Triton with a client of its own.
+     * @param hedge_requests : Send a duplicate of requests outstanding for longer than the 95th percentile of their
+     * server's latency to a second server. The servers are then connected over gRPC, which sends requests
+     * asynchronously.
+     * @param cache_size : Maximum number of rows whose outputs are cached by a hash of their inputs, or zero to disable
+     * the cache.
+     * @param warm_up : Connect every session to Triton when the stage is built rather than on its first message.
+     * @param ragged_offsets_input : When not empty, the inputs are sent without their padding as ragged batches, the
+     * offsets of the sequences being sent as this input of the model, see `TritonRaggedBatching`.
+     * @param ragged_token_outputs : Outputs of a ragged model holding a row per token, padded back to a row per
+     * sequence.
      * @return std::shared_ptr<mrc::segment::Object<InferenceClientStage>>
      */
     static std::shared_ptr<mrc::segment::Object<InferenceClientStage>> init(
@@ -161,7 +328,72 @@ struct MORPHEUS_EXPORT InferenceClientStageInterfaceProxy
         std::string server_url,
         bool needs_logits,
         std::map<std::string, std::string> input_mapping,
-        std::map<std::string, std::string> output_mapping);
+        std::map<std::string, std::string> output_mapping,
+        bool use_cuda_graphs                          = false,
+        bool use_shared_memory                        = false,
+        std::size_t max_concurrent_batches            = 1,
+        TensorIndex max_batch_rows                    = 0,
+        int64_t max_batch_delay_ms                    = 1,
+        std::size_t num_connections                   = 1,
+        bool hedge_requests                           = false,
+        std::size_t cache_size                        = 0,
+        bool warm_up                                  = false,
+        std::string ragged_offsets_input              = "",
+        std::vector<std::string> ragged_token_outputs = {});
+};
+
+/****** FanOutInferenceClientStageInterfaceProxy************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct MORPHEUS_EXPORT FanOutInferenceClientStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a FanOutInferenceClientStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param server_url : Triton server URL, or a comma separated list of the URLs of several servers serving the
+     * models.
+     * @param model_output_mappings : Output mapping of each model, keyed by the name of the model. Outputs must be
+     * mapped to distinct names across the models.
+     * @param needs_logits : Determines if logits are required.
+     * @param input_mapping : Dictionary used to map pipeline input names to Triton input names, shared by the models.
+     * @param use_cuda_graphs : Launch the post-processing of all output tensors as a single CUDA graph.
+     * @param use_shared_memory : Connect to Triton over gRPC, exchanging the inputs and outputs through CUDA shared
+     * memory.
+     * @param max_concurrent_batches : Maximum number of mini-batches of a single message in flight at once per model.
+     * @param max_batch_rows : Maximum number of rows of a request merging the inputs of several messages, or zero to
+     * send each message separately.
+     * @param max_batch_delay_ms : Maximum time in milliseconds a message waits for others to be merged with.
+     * @param num_connections : Number of sessions of each model.
+     * @param hedge_requests : Send a duplicate of slow requests to a second server.
+     * @param cache_size : Maximum number of rows whose outputs are cached per model, or zero to disable the cache.
+     * @param warm_up : Connect every session to Triton when the stage is built rather than on its first message.
+     * @param ragged_offsets_input : When not empty, the inputs are sent without their padding as ragged batches, the
+     * offsets of the sequences being sent as this input of every model.
+     * @param ragged_token_outputs : Outputs of the ragged models holding a row per token, padded back to a row per
+     * sequence.
+     * @return std::shared_ptr<mrc::segment::Object<FanOutInferenceClientStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<FanOutInferenceClientStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::string server_url,
+        std::map<std::string, std::map<std::string, std::string>> model_output_mappings,
+        bool needs_logits,
+        std::map<std::string, std::string> input_mapping,
+        bool use_cuda_graphs                          = false,
+        bool use_shared_memory                        = false,
+        std::size_t max_concurrent_batches            = 1,
+        TensorIndex max_batch_rows                    = 0,
+        int64_t max_batch_delay_ms                    = 1,
+        std::size_t num_connections                   = 1,
+        bool hedge_requests                           = false,
+        std::size_t cache_size                        = 0,
+        bool warm_up                                  = false,
+        std::string ragged_offsets_input              = "",
+        std::vector<std::string> ragged_token_outputs = {});
 };
 /** @} */  // end of group
 
@@ -17,8 +17,14 @@
 
 #pragma once
 
+#include "morpheus/io/deserializers.hpp"    // for ColumnProjection, TableSchema
+#include "morpheus/io/payload_decoder.hpp"  // for PayloadDecoder
+#include "morpheus/io/source_capture.hpp"   // for SourceCaptureWriter
 #include "morpheus/messages/meta.hpp"
+#include "morpheus/objects/pinned_host_buffer.hpp"
 #include "morpheus/types.hpp"
+#include "morpheus/utilities/cuda_util.hpp"
+#include "morpheus/utilities/metrics.hpp"
 
 #include <boost/fiber/context.hpp>
 #include <cudf/io/types.hpp>
@@ -29,14 +35,18 @@
 #include <pymrc/node.hpp>
 #include <rxcpp/rx.hpp>  // for apply, make_subscriber, observable_member, is_on_error<>::not_void, is_on_next_of<>::not_void, trace_activity
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>  // for size_t
 #include <cstdint>  // for uuint32_t
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <thread>
+#include <utility>  // for pair
 #include <vector>
 
 namespace morpheus {
@@ -62,6 +72,141 @@ class KafkaOAuthCallback : public RdKafka::OAuthBearerTokenRefreshCb
   private:
     const std::function<std::map<std::string, std::string>()>& m_oauth_callback;
 };
+/**
+ * @brief Adjusts the Kafka batch size and batch timeout based on the observed traffic. When there is a backlog
+ * (batches fill up or the consumer lag exceeds the batch size), the batch size is doubled up to `max_batch_size` to
+ * make the best use of the GPU. When traffic is light, the batch size is reduced towards the number of messages
+ * received and the batch timeout is chosen so that the time spent waiting plus the p99 processing time stays within
+ * `latency_target_ms`.
+ *
+ * @note This class is thread-safe.
+ */
+class KafkaBatchController
+{
+  public:
+    /**
+     * @brief Construct a new Kafka Batch Controller object
+     *
+     * @param max_batch_size : Upper bound (and target under load) for the batch size
+     * @param max_batch_timeout_ms : Upper bound for the batch timeout
+     * @param latency_target_ms : Target for the p99 latency of a message through the source
+     * @param min_batch_size : Lower bound for the batch size
+     */
+    KafkaBatchController(TensorIndex max_batch_size,
+                         uint32_t max_batch_timeout_ms,
+                         uint32_t latency_target_ms,
+                         TensorIndex min_batch_size = 1);
+
+    /**
+     * @return The current batch size
+     */
+    TensorIndex batch_size() const;
+
+    /**
+     * @return The current batch timeout in ms
+     */
+    uint32_t batch_timeout_ms() const;
+
+    /**
+     * @brief Update the controller with the results of a single batch.
+     *
+     * @param num_messages : Number of messages in the batch
+     * @param processing_time : Time spent parsing and emitting the batch
+     * @param lag : Number of messages available on the broker but not yet consumed. Negative if unknown
+     */
+    void update(TensorIndex num_messages, std::chrono::microseconds processing_time, int64_t lag = -1);
+
+  private:
+    // Number of processing times used to estimate the p99
+    static constexpr std::size_t WindowSize = 128;
+
+    const TensorIndex m_min_batch_size;
+    const TensorIndex m_max_batch_size;
+    const uint32_t m_max_batch_timeout_ms;
+    const uint32_t m_latency_target_ms;
+
+    std::atomic<TensorIndex> m_batch_size;
+    std::atomic<uint32_t> m_batch_timeout_ms;
+
+    std::mutex m_mutex;
+    std::vector<std::chrono::microseconds> m_processing_times;
+    std::size_t m_next_processing_idx{0};
+};
+
+/**
+ * @brief A contiguous range of offsets `[first_offset, next_offset)` from a single partition
+ */
+struct KafkaOffsetRange
+{
+    std::string topic;
+    int32_t partition{-1};
+    int64_t first_offset{-1};
+    int64_t next_offset{-1};
+};
+
+/**
+ * @brief Tracks the offset ranges of every emitted `MessageMeta` until a sink has explicitly acknowledged it. For each
+ * partition a watermark is advanced over the contiguous prefix of acknowledged ranges, only the watermark is ever
+ * committed so an offset is never committed while an earlier one is still in flight. A range which is never
+ * acknowledged, for example because its message was dropped by a failing or filtering stage, holds the watermark back
+ * and is redelivered after a restart.
+ *
+ * @note This class is thread-safe, acknowledgements can arrive from any thread.
+ */
+class KafkaOffsetTracker : public std::enable_shared_from_this<KafkaOffsetTracker>
+{
+  public:
+    /**
+     * @brief Starts tracking `ranges` and returns the callback which acknowledges them, intended to be registered with
+     * `MessageMeta::set_acknowledgement` before the message is emitted. The callback only holds a weak reference to
+     * the tracker, acknowledgements which arrive after the tracker has been destroyed are dropped.
+     *
+     * @param ranges : The offset ranges covered by a single message
+     * @return std::function<void()>
+     */
+    std::function<void()> track(std::vector<KafkaOffsetRange> ranges);
+
+    /**
+     * @brief Returns the offsets to commit for every partition whose watermark has advanced since the last call.
+     *
+     * @param partitions : Limits the offsets to these partitions when not null
+     * @return std::vector<std::unique_ptr<RdKafka::TopicPartition>>
+     */
+    std::vector<std::unique_ptr<RdKafka::TopicPartition>> take_commits(
+        const std::vector<RdKafka::TopicPartition*>* partitions = nullptr);
+
+    /**
+     * @brief Stops tracking the revoked `partitions`. Any acknowledgement which arrives later for these partitions is
+     * ignored, the new owner will resume from the last committed offset.
+     */
+    void remove(const std::vector<RdKafka::TopicPartition*>& partitions);
+
+    /**
+     * @brief Stops tracking every partition
+     */
+    void clear();
+
+  private:
+    struct InFlightRange
+    {
+        int64_t next_offset{-1};
+        bool acknowledged{false};
+    };
+
+    struct PartitionState
+    {
+        // Keyed by the first offset of each range
+        std::map<int64_t, InFlightRange> in_flight;
+        int64_t watermark{-1};
+        bool dirty{false};
+    };
+
+    void ack(const std::vector<KafkaOffsetRange>& ranges);
+
+    std::mutex m_mutex;
+    std::map<std::pair<std::string, int32_t>, PartitionState> m_partitions;
+};
+
 /**
  * This class loads messages from the Kafka cluster by serving as a Kafka consumer.
  */
@@ -82,10 +227,37 @@ class KafkaSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<Message
      * @param disable_commit : Enabling this option will skip committing messages as they are pulled off the server.
      * This is only useful for debugging, allowing the user to process the same messages multiple times
      * @param disable_pre_filtering : Enabling this option will skip pre-filtering of json messages.
-     * This is only useful when inputs are known to be valid json.
+     * This is only useful when inputs are known to be valid json. A batch holding malformed messages is parsed a second
+     * time, dropping only the malformed messages.
      * @param stop_after : Stops ingesting after emitting `stop_after` records (rows in the table).
      * Useful for testing. Disabled if `0`
      * @param async_commits : Asynchronously acknowledge consuming Kafka messages
+     * @param oauth_callback : Callback used when an OAuth token needs to be generated.
+     * @param gpu_pre_filtering : When pre-filtering is enabled, validate the messages on the GPU as part of parsing
+     * instead of on the CPU. Malformed messages are parsed as null rows and removed, note that this will also remove
+     * valid messages where every field is null.
+     * @param parallel_partitions : Consume each assigned partition from its own librdkafka partition queue on a
+     * dedicated thread. Batches are parsed in parallel and the offsets are committed per partition.
+     * @param latency_target_ms : When greater than zero, the batch size and batch timeout are adjusted at runtime.
+     * Batches grow towards `max_batch_size` when there is a backlog and shrink when traffic is light, choosing the
+     * timeout to keep the p99 latency within `latency_target_ms`. In this mode `batch_timeout_ms` is an upper bound.
+     * Disabled if `0`
+     * @param commit_on_ack : When true, offsets are only committed once a sink has called `acknowledge` on the emitted
+     * `MessageMeta`, instead of as soon as the message is emitted. Messages which are dropped without being
+     * acknowledged are never committed. Committed offsets form a per-partition watermark which only advances over
+     * contiguous acknowledged ranges.
+     * @param device_ids : Devices the batches are parsed on in turn, spreading them across GPUs. The batches are parsed
+     * on the device of the pipeline thread if empty.
+     * @param schema : Fields to read from the messages along with their types, parsed directly at these types. Every
+     * field is read inferring its type if empty.
+     * @param projection : Fields read by the downstream stages, the other fields are dropped once parsed
+     * @param payload_format : Wire format of the message payloads, the name of a `PayloadDecoder` such as `json` for
+     * JSON objects or `arrow` for Arrow IPC streams. Pre-filtering only applies to `json` payloads.
+     * @param placement : Where the partition worker threads are bound and the pinned batch buffers allocated, such as
+     * `gpu` for the NUMA node local to the GPU or the PCI address of the NIC, see `TopologyUtil::resolve_placement`.
+     * Nothing is bound if empty.
+     * @param capture_path : When not empty, every batch is also recorded to this capture log along with its arrival
+     * time, to be replayed by the `ReplaySourceStage`, see `SourceCaptureWriter`
      */
     KafkaSourceStage(TensorIndex max_batch_size,
                      std::string topic,
@@ -95,7 +267,17 @@ class KafkaSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<Message
                      bool disable_pre_filtering                         = false,
                      std::size_t stop_after                             = 0,
                      bool async_commits                                 = true,
-                     std::unique_ptr<KafkaOAuthCallback> oauth_callback = nullptr);
+                     std::unique_ptr<KafkaOAuthCallback> oauth_callback = nullptr,
+                     bool gpu_pre_filtering                             = false,
+                     bool parallel_partitions                           = false,
+                     uint32_t latency_target_ms                         = 0,
+                     bool commit_on_ack                                 = false,
+                     std::vector<int> device_ids                        = {},
+                     TableSchema schema                                 = {},
+                     ColumnProjection projection                        = {},
+                     const std::string& payload_format                  = "json",
+                     std::string placement                              = "",
+                     const std::string& capture_path                    = "");
 
     /**
      * @brief Construct a new Kafka Source Stage object
@@ -107,10 +289,37 @@ class KafkaSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<Message
      * @param disable_commit : Enabling this option will skip committing messages as they are pulled off the server.
      * This is only useful for debugging, allowing the user to process the same messages multiple times
      * @param disable_pre_filtering : Enabling this option will skip pre-filtering of json messages.
-     * This is only useful when inputs are known to be valid json.
+     * This is only useful when inputs are known to be valid json. A batch holding malformed messages is parsed a second
+     * time, dropping only the malformed messages.
      * @param stop_after : Stops ingesting after emitting `stop_after` records (rows in the table).
      * Useful for testing. Disabled if `0`
      * @param async_commits : Asynchronously acknowledge consuming Kafka messages
+     * @param oauth_callback : Callback used when an OAuth token needs to be generated.
+     * @param gpu_pre_filtering : When pre-filtering is enabled, validate the messages on the GPU as part of parsing
+     * instead of on the CPU. Malformed messages are parsed as null rows and removed, note that this will also remove
+     * valid messages where every field is null.
+     * @param parallel_partitions : Consume each assigned partition from its own librdkafka partition queue on a
+     * dedicated thread. Batches are parsed in parallel and the offsets are committed per partition.
+     * @param latency_target_ms : When greater than zero, the batch size and batch timeout are adjusted at runtime.
+     * Batches grow towards `max_batch_size` when there is a backlog and shrink when traffic is light, choosing the
+     * timeout to keep the p99 latency within `latency_target_ms`. In this mode `batch_timeout_ms` is an upper bound.
+     * Disabled if `0`
+     * @param commit_on_ack : When true, offsets are only committed once a sink has called `acknowledge` on the emitted
+     * `MessageMeta`, instead of as soon as the message is emitted. Messages which are dropped without being
+     * acknowledged are never committed. Committed offsets form a per-partition watermark which only advances over
+     * contiguous acknowledged ranges.
+     * @param device_ids : Devices the batches are parsed on in turn, spreading them across GPUs. The batches are parsed
+     * on the device of the pipeline thread if empty.
+     * @param schema : Fields to read from the messages along with their types, parsed directly at these types. Every
+     * field is read inferring its type if empty.
+     * @param projection : Fields read by the downstream stages, the other fields are dropped once parsed
+     * @param payload_format : Wire format of the message payloads, the name of a `PayloadDecoder` such as `json` for
+     * JSON objects or `arrow` for Arrow IPC streams. Pre-filtering only applies to `json` payloads.
+     * @param placement : Where the partition worker threads are bound and the pinned batch buffers allocated, such as
+     * `gpu` for the NUMA node local to the GPU or the PCI address of the NIC, see `TopologyUtil::resolve_placement`.
+     * Nothing is bound if empty.
+     * @param capture_path : When not empty, every batch is also recorded to this capture log along with its arrival
+     * time, to be replayed by the `ReplaySourceStage`, see `SourceCaptureWriter`
      */
     KafkaSourceStage(TensorIndex max_batch_size,
                      std::vector<std::string> topics,
@@ -120,7 +329,17 @@ class KafkaSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<Message
                      bool disable_pre_filtering                         = false,
                      std::size_t stop_after                             = 0,
                      bool async_commits                                 = true,
-                     std::unique_ptr<KafkaOAuthCallback> oauth_callback = nullptr);
+                     std::unique_ptr<KafkaOAuthCallback> oauth_callback = nullptr,
+                     bool gpu_pre_filtering                             = false,
+                     bool parallel_partitions                           = false,
+                     uint32_t latency_target_ms                         = 0,
+                     bool commit_on_ack                                 = false,
+                     std::vector<int> device_ids                        = {},
+                     TableSchema schema                                 = {},
+                     ColumnProjection projection                        = {},
+                     const std::string& payload_format                  = "json",
+                     std::string placement                              = "",
+                     const std::string& capture_path                    = "");
 
     ~KafkaSourceStage() override = default;
 
@@ -157,22 +376,37 @@ class KafkaSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<Message
     std::unique_ptr<RdKafka::KafkaConsumer> create_consumer(RdKafka::RebalanceCb& rebalancer);
 
     /**
-     * @brief Load messages from a buffer/file to a cuDF table.
+     * @brief Load messages from a host buffer to a cuDF table.
+     *
+     * @param buffer : Buffer containing newline delimited JSON messages
+     * @return cudf::io::table_with_metadata
+     */
+    cudf::io::table_with_metadata load_table(const PinnedHostBuffer& buffer);
+
+    /**
+     * @brief Decodes the payloads of a batch of messages in a non JSON format with `m_decoder`.
      *
-     * @param buffer : Reference of a messages buffer
+     * @param message_batch : Messages whose payloads are decoded
      * @return cudf::io::table_with_metadata
      */
-    cudf::io::table_with_metadata load_table(const std::string& buffer);
+    cudf::io::table_with_metadata decode_table(const std::vector<std::unique_ptr<RdKafka::Message>>& message_batch);
 
     /**
      * @brief This function combines JSON messages from Kafka, parses them, then loads them onto a MessageMeta.
-     * and returns the shared pointer as a result.
+     * and returns the shared pointer as a result. Payloads in other formats are decoded with `decode_table` instead.
      *
      * @param message_batch : Reference of a message batch that needs to be processed.
+     * @param buffer : Reusable buffer which the message payloads are written into before parsing. Owned by the calling
+     * runnable so that the allocation is reused across batches.
      * @return std::shared_ptr<morpheus::MessageMeta>
      */
-    std::shared_ptr<morpheus::MessageMeta> process_batch(
-        std::vector<std::unique_ptr<RdKafka::Message>>&& message_batch);
+    std::shared_ptr<morpheus::MessageMeta> process_batch(std::vector<std::unique_ptr<RdKafka::Message>>&& message_batch,
+                                                         PinnedHostBuffer& buffer);
+
+    /**
+     * @brief Registers the metrics shared by every runnable of this stage with the `MetricsRegistry`.
+     */
+    void register_metrics();
 
     TensorIndex m_max_batch_size{128};
     uint32_t m_batch_timeout_ms{100};
@@ -184,11 +418,24 @@ class KafkaSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<Message
     bool m_disable_pre_filtering{false};
     bool m_requires_commit{false};  // Whether or not manual committing is required
     bool m_async_commits{true};
+    bool m_gpu_pre_filtering{false};
+    bool m_parallel_partitions{false};
+    uint32_t m_latency_target_ms{0};
+    bool m_commit_on_ack{false};
     std::size_t m_stop_after{0};
+    DeviceRoundRobin m_devices;
+    TableSchema m_schema;
+    ColumnProjection m_projection;
+    std::shared_ptr<PayloadDecoder> m_decoder;  // Unset for JSON payloads, parsed from a reusable pinned buffer
+    std::string m_placement;
+    std::shared_ptr<SourceCaptureWriter> m_capture;  // Unset unless capturing
 
     void* m_rebalancer;
 
     std::unique_ptr<KafkaOAuthCallback> m_oauth_callback;
+
+    std::shared_ptr<Counter> m_load_table_seconds;
+    std::shared_ptr<Counter> m_create_meta_seconds;
 };
 
 /****** KafkaSourceStageInferenceProxy**********************/
@@ -209,11 +456,24 @@ struct KafkaSourceStageInterfaceProxy
      * @param disable_commit : Enabling this option will skip committing messages as they are pulled off the server.
      * This is only useful for debugging, allowing the user to process the same messages multiple times
      * @param disable_pre_filtering : Enabling this option will skip pre-filtering of json messages.
-     * This is only useful when inputs are known to be valid json.
+     * This is only useful when inputs are known to be valid json. A batch holding malformed messages is parsed a second
+     * time, dropping only the malformed messages.
      * @param stop_after : Stops ingesting after emitting `stop_after` records (rows in the table).
      * Useful for testing. Disabled if `0`
      * @param async_commits : Asynchronously acknowledge consuming Kafka messages
      * @param oauth_callback : Callback used when an OAuth token needs to be generated.
+     * @param gpu_pre_filtering : When pre-filtering is enabled, validate the messages on the GPU as part of parsing
+     * instead of on the CPU.
+     * @param parallel_partitions : Consume each assigned partition from its own partition queue on a dedicated thread.
+     * @param latency_target_ms : Target p99 latency in ms for adaptive batching. Disabled if `0`
+     * @param commit_on_ack : Commit offsets only after downstream acknowledgement
+     * @param device_ids : Devices the batches are parsed on in turn
+     * @param schema : Pairs of field names and type names of the fields to read, see `TableSchema::from_type_names`
+     * @param projection : Patterns of the fields read by the downstream stages, see `ColumnProjection`
+     * @param payload_format : Wire format of the message payloads, see `PayloadDecoder::create`
+     * @param placement : Where the partition worker threads and pinned batch buffers are placed, see
+     * `TopologyUtil::resolve_placement`
+     * @param capture_path : Capture log every batch is recorded to, see `SourceCaptureWriter`. Disabled if empty
      */
     static std::shared_ptr<mrc::segment::Object<KafkaSourceStage>> init_with_single_topic(
         mrc::segment::Builder& builder,
@@ -224,9 +484,19 @@ struct KafkaSourceStageInterfaceProxy
         std::map<std::string, std::string> config,
         bool disable_commit,
         bool disable_pre_filtering,
-        std::size_t stop_after                           = 0,
-        bool async_commits                               = true,
-        std::optional<pybind11::function> oauth_callback = std::nullopt);
+        std::size_t stop_after                                  = 0,
+        bool async_commits                                      = true,
+        std::optional<pybind11::function> oauth_callback        = std::nullopt,
+        bool gpu_pre_filtering                                  = false,
+        bool parallel_partitions                                = false,
+        uint32_t latency_target_ms                              = 0,
+        bool commit_on_ack                                      = false,
+        std::vector<int> device_ids                             = {},
+        std::vector<std::pair<std::string, std::string>> schema = {},
+        const std::vector<std::string>& projection              = {},
+        const std::string& payload_format                       = "json",
+        const std::string& placement                            = "",
+        const std::string& capture_path                         = "");
 
     /**
      * @brief Create and initialize a KafkaSourceStage, and return the result
@@ -240,11 +510,24 @@ struct KafkaSourceStageInterfaceProxy
      * @param disable_commit : Enabling this option will skip committing messages as they are pulled off the server.
      * This is only useful for debugging, allowing the user to process the same messages multiple times
      * @param disable_pre_filtering : Enabling this option will skip pre-filtering of json messages.
-     * This is only useful when inputs are known to be valid json.
+     * This is only useful when inputs are known to be valid json. A batch holding malformed messages is parsed a second
+     * time, dropping only the malformed messages.
      * @param stop_after : Stops ingesting after emitting `stop_after` records (rows in the table).
      * Useful for testing. Disabled if `0`
      * @param async_commits : Asynchronously acknowledge consuming Kafka messages
      * @param oauth_callback : Callback used when an OAuth token needs to be generated.
+     * @param gpu_pre_filtering : When pre-filtering is enabled, validate the messages on the GPU as part of parsing
+     * instead of on the CPU.
+     * @param parallel_partitions : Consume each assigned partition from its own partition queue on a dedicated thread.
+     * @param latency_target_ms : Target p99 latency in ms for adaptive batching. Disabled if `0`
+     * @param commit_on_ack : Commit offsets only after downstream acknowledgement
+     * @param device_ids : Devices the batches are parsed on in turn
+     * @param schema : Pairs of field names and type names of the fields to read, see `TableSchema::from_type_names`
+     * @param projection : Patterns of the fields read by the downstream stages, see `ColumnProjection`
+     * @param payload_format : Wire format of the message payloads, see `PayloadDecoder::create`
+     * @param placement : Where the partition worker threads and pinned batch buffers are placed, see
+     * `TopologyUtil::resolve_placement`
+     * @param capture_path : Capture log every batch is recorded to, see `SourceCaptureWriter`. Disabled if empty
      */
     static std::shared_ptr<mrc::segment::Object<KafkaSourceStage>> init_with_multiple_topics(
         mrc::segment::Builder& builder,
@@ -255,9 +538,19 @@ struct KafkaSourceStageInterfaceProxy
         std::map<std::string, std::string> config,
         bool disable_commit,
         bool disable_pre_filtering,
-        std::size_t stop_after                           = 0,
-        bool async_commits                               = true,
-        std::optional<pybind11::function> oauth_callback = std::nullopt);
+        std::size_t stop_after                                  = 0,
+        bool async_commits                                      = true,
+        std::optional<pybind11::function> oauth_callback        = std::nullopt,
+        bool gpu_pre_filtering                                  = false,
+        bool parallel_partitions                                = false,
+        uint32_t latency_target_ms                              = 0,
+        bool commit_on_ack                                      = false,
+        std::vector<int> device_ids                             = {},
+        std::vector<std::pair<std::string, std::string>> schema = {},
+        const std::vector<std::string>& projection              = {},
+        const std::string& payload_format                       = "json",
+        const std::string& placement                            = "",
+        const std::string& capture_path                         = "");
 
   private:
     /**
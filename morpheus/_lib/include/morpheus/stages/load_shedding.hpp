@@ -0,0 +1,186 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/objects/table_info.hpp"
+#include "morpheus/utilities/metrics.hpp"
+
+#include <cudf/column/column.hpp>
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <cstdint>  // for uint32_t, uint64_t
+#include <map>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** LoadSheddingStage***********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Samples the rows of the low priority classes of a priority column, at rates lowered as the pressure on the
+ * pipeline grows. The pressure is read from a metric of the `MetricsRegistry`, such as the consumer lag of a source or
+ * the latency of a downstream stage, and scaled linearly from 0 at `low_watermark` to 1 at `high_watermark`. The
+ * sampling rate of each class goes from 1 without pressure down to its minimum rate at full pressure.
+ *
+ * Rows are sampled on the device by hashing a running row number, so that neither the rows nor a random mask go
+ * through host memory. Rows of priorities without a minimum rate, including null priorities, always pass through.
+ */
+class LoadSheddingSampler
+{
+  public:
+    /**
+     * @brief Construct a new Load Shedding Sampler
+     *
+     * @param priority_column : Column holding the priority class of each row, either strings or integers
+     * @param min_rates : Minimum sampling rate of each low priority class, at full pressure
+     * @param pressure_metric : Name of the gauge, or histogram, read as the pressure
+     * @param pressure_labels : Labels of the series of `pressure_metric`
+     * @param from_histogram : Whether `pressure_metric` is a histogram, the pressure being the mean of the values
+     * observed since the previous read, such as a latency, rather than a gauge
+     * @param low_watermark : Value of the metric below which every row is kept
+     * @param high_watermark : Value of the metric from which the classes are sampled at their minimum rates
+     * @param seed : Seed of the sampling
+     * @throws std::invalid_argument If `min_rates` is empty or holds a rate outside of [0, 1], or `high_watermark` is
+     * not greater than `low_watermark`
+     */
+    LoadSheddingSampler(std::string priority_column,
+                        std::map<std::string, double> min_rates,
+                        const std::string& pressure_metric,
+                        const metric_labels_t& pressure_labels,
+                        bool from_histogram,
+                        double low_watermark,
+                        double high_watermark,
+                        uint32_t seed = 0);
+
+    /**
+     * @brief Reads the pressure metric, returning the pressure between 0 and 1
+     */
+    double read_pressure();
+
+    /**
+     * @brief Sampling rate of each low priority class under `pressure`
+     */
+    std::map<std::string, double> sampling_rates(double pressure) const;
+
+    /**
+     * @brief Samples the rows of `table` at `rates`
+     *
+     * @return std::unique_ptr<cudf::column> : BOOL8 column without nulls, true for the rows to keep
+     * @throws std::invalid_argument If the priority column is missing or is neither a string nor an integer column, or
+     * a class of `rates` is not an integer for an integer column
+     */
+    std::unique_ptr<cudf::column> keep_mask(const TableInfo& table, const std::map<std::string, double>& rates);
+
+  private:
+    std::string m_priority_column;
+    std::map<std::string, double> m_min_rates;
+    double m_low_watermark;
+    double m_high_watermark;
+    uint32_t m_seed;
+
+    std::shared_ptr<Gauge> m_gauge;
+    std::shared_ptr<Histogram> m_histogram;
+    double m_last_sum{0};
+    uint64_t m_last_count{0};
+    double m_last_pressure{0};
+
+    uint64_t m_rows_sampled{0};  // Running row number, so that each message draws different samples
+};
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Sheds load during bursts by sampling the rows of the low priority classes of the payload of each
+ * `ControlMessage`, rather than falling behind on every row, see `LoadSheddingSampler`. Messages without any row left
+ * are not emitted.
+ *
+ * The sampling rate of each class is set as the `sampling_rates` metadata of the messages, so that downstream counts
+ * can be re-weighted by the inverse of the rates. The pressure and the number of rows dropped are reported to the
+ * `MetricsRegistry`.
+ */
+class LoadSheddingStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Load Shedding Stage object
+     *
+     * @param sampler : Samples the rows of each message
+     * @param metrics_name : Labels the metrics of the stage
+     */
+    LoadSheddingStage(LoadSheddingSampler sampler, const std::string& metrics_name);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    LoadSheddingSampler m_sampler;
+
+    std::shared_ptr<Gauge> m_pressure;
+    std::shared_ptr<Counter> m_dropped_rows;
+};
+
+/****** LoadSheddingStageInterfaceProxy**********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct LoadSheddingStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a LoadSheddingStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param priority_column : Column holding the priority class of each row, either strings or integers
+     * @param min_rates : Minimum sampling rate of each low priority class, at full pressure
+     * @param pressure_metric : Name of the gauge, or histogram, read as the pressure
+     * @param pressure_labels : Labels of the series of `pressure_metric`
+     * @param from_histogram : Whether `pressure_metric` is a histogram rather than a gauge
+     * @param low_watermark : Value of the metric below which every row is kept
+     * @param high_watermark : Value of the metric from which the classes are sampled at their minimum rates
+     * @param seed : Seed of the sampling
+     * @return std::shared_ptr<mrc::segment::Object<LoadSheddingStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<LoadSheddingStage>> init(mrc::segment::Builder& builder,
+                                                                          const std::string& name,
+                                                                          std::string priority_column,
+                                                                          std::map<std::string, double> min_rates,
+                                                                          const std::string& pressure_metric,
+                                                                          const metric_labels_t& pressure_labels,
+                                                                          bool from_histogram,
+                                                                          double low_watermark,
+                                                                          double high_watermark,
+                                                                          uint32_t seed);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/messages/multi_response.hpp"
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_view.hpp>
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <cstdint>  // for int32_t
+#include <map>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** LogParsingPostprocessStage**************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Loads the tokens of a WordPiece vocabulary file to the device, the token of each line being its first word.
+ *
+ * @param vocab_path
+ * @return std::unique_ptr<cudf::column> : Strings column holding the token of each id
+ * @throws std::invalid_argument If the file can't be opened
+ */
+std::unique_ptr<cudf::column> load_log_parsing_vocab(const std::string& vocab_path);
+
+/**
+ * @brief Decodes the entities of the logs predicted by a NER model, the C++ counterpart of the postprocessing of the
+ * log parsing example. The `labels` and `input_ids` tensors of `message` hold the label and token id of each token of
+ * each inference row, and its `seq_ids` tensor the log and the range of tokens of each row. The tokens of the rows of
+ * each log are decoded with `vocab`, and the WordPiece continuations (tokens starting with `##` or `.`) take the label
+ * of the token they continue. The tokens of each `B-` label are then joined, followed by those of the matching `I-`
+ * label, and the spacing around punctuation is removed the same way the python stage does.
+ *
+ * Everything runs on the device over the whole message, the tokens being grouped by log and label with a single sort.
+ *
+ * @param message
+ * @param vocab : Token of each id, as loaded by `load_log_parsing_vocab`
+ * @param id2label : Name of each label id, such as `B-time`
+ * @return std::shared_ptr<MessageMeta> : One row per log in ascending order of log, with one strings column per `B-`
+ * label found in the message named after the label without its prefix, null for the logs without such an entity
+ * @throws std::invalid_argument If a tensor is missing or is not a 2D row major tensor
+ */
+std::shared_ptr<MessageMeta> decode_log_entities(const MultiResponseMessage& message,
+                                                 const cudf::column_view& vocab,
+                                                 const std::map<int32_t, std::string>& id2label);
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Replaces each incoming `MultiResponseMessage` of a log parsing NER model by the entities of its logs, as
+ * decoded by `decode_log_entities`.
+ */
+class LogParsingPostprocessStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<MultiResponseMessage>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MultiResponseMessage>, std::shared_ptr<MessageMeta>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Log Parsing Postprocess Stage object
+     *
+     * @param vocab_path : Path of the vocabulary file of the model
+     * @param id2label : Name of each label id of the model
+     */
+    LogParsingPostprocessStage(const std::string& vocab_path, std::map<int32_t, std::string> id2label);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    std::unique_ptr<cudf::column> m_vocab;
+    std::map<int32_t, std::string> m_id2label;
+};
+
+/****** LogParsingPostprocessStageInterfaceProxy************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct LogParsingPostprocessStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a LogParsingPostprocessStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param vocab_path : Path of the vocabulary file of the model
+     * @param id2label : Name of each label id of the model
+     * @return std::shared_ptr<mrc::segment::Object<LogParsingPostprocessStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<LogParsingPostprocessStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        const std::string& vocab_path,
+        std::map<int32_t, std::string> id2label);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,183 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/messages/multi.hpp"
+#include "morpheus/utilities/metrics.hpp"
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>  // for hash
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** MonitorStage********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Counter spread over cache line aligned shards, each thread incrementing the shard its id hashes to, such that
+ * threads incrementing the counter concurrently rarely contend on the same cache line. Reading the counter sums the
+ * shards.
+ */
+class ShardedCounter
+{
+  public:
+    void increment(uint64_t value = 1)
+    {
+        m_shards[shard_index()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t load() const
+    {
+        uint64_t total = 0;
+        for (const auto& shard : m_shards)
+        {
+            total += shard.value.load(std::memory_order_relaxed);
+        }
+
+        return total;
+    }
+
+  private:
+    static constexpr std::size_t NumShards = 16;
+
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> value{0};
+    };
+
+    static std::size_t shard_index()
+    {
+        thread_local const std::size_t index = std::hash<std::thread::id>{}(std::this_thread::get_id()) % NumShards;
+        return index;
+    }
+
+    std::array<Shard, NumShards> m_shards;
+};
+
+/**
+ * @brief Pass-through stage counting the messages and rows flowing through it, the native counterpart of the python
+ * `MonitorStage`. Counting only increments a `ShardedCounter`, the row count of a message being the cached number of
+ * rows of its payload. A background thread wakes up every `report_interval_ms` to compute the rates, which are
+ * published to the `MetricsRegistry` and optionally logged. In the Python bindings the stage is bound as
+ * `MonitorMessageMetaStage`, `MonitorMultiMessageStage` and `MonitorControlMessageStage`.
+ */
+template <typename MessageT>
+class MonitorStage : public mrc::pymrc::PythonNode<std::shared_ptr<MessageT>, std::shared_ptr<MessageT>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageT>, std::shared_ptr<MessageT>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Monitor Stage object
+     *
+     * @param description : Name of the monitor, used as the `description` label of the metrics and in the logs
+     * @param report_interval_ms : Interval at which the rates are computed and reported
+     * @param log_progress : When true, the rates are logged at `INFO` level at every interval, otherwise they are only
+     * published to the `MetricsRegistry`
+     */
+    MonitorStage(std::string description, std::size_t report_interval_ms = 1000, bool log_progress = true);
+
+    ~MonitorStage() override;
+
+  private:
+    subscribe_fn_t build_operator();
+
+    void start_reporter();
+    void stop_reporter();
+
+    /**
+     * @brief Publishes the counts since the previous report along with the rates, when `is_final` the totals over the
+     * lifetime of the stage are logged as well
+     */
+    void report(bool is_final);
+
+    std::string m_description;
+    std::chrono::milliseconds m_report_interval;
+    bool m_log_progress;
+
+    ShardedCounter m_message_count;
+    ShardedCounter m_row_count;
+
+    std::shared_ptr<Counter> m_messages_total;
+    std::shared_ptr<Counter> m_rows_total;
+    std::shared_ptr<Gauge> m_messages_per_second;
+    std::shared_ptr<Gauge> m_rows_per_second;
+
+    // Only accessed by the reporter, or once it has been stopped
+    uint64_t m_reported_messages{0};
+    uint64_t m_reported_rows{0};
+    std::chrono::steady_clock::time_point m_start_time;
+    std::chrono::steady_clock::time_point m_last_report_time;
+
+    std::mutex m_reporter_mutex;
+    std::condition_variable m_reporter_cv;
+    bool m_stop_reporter{false};
+    std::thread m_reporter;
+};
+
+/****** MonitorStageInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+template <typename MessageT>
+struct MonitorStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a MonitorStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param description : Name of the monitor, used as the `description` label of the metrics and in the logs
+     * @param report_interval_ms : Interval at which the rates are computed and reported
+     * @param log_progress : When true, the rates are logged at every interval
+     * @return std::shared_ptr<mrc::segment::Object<MonitorStage<MessageT>>>
+     */
+    static std::shared_ptr<mrc::segment::Object<MonitorStage<MessageT>>> init(mrc::segment::Builder& builder,
+                                                                              const std::string& name,
+                                                                              std::string description,
+                                                                              std::size_t report_interval_ms,
+                                                                              bool log_progress);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
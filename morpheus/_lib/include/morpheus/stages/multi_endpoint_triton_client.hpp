@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+#include "morpheus/stages/triton_inference.hpp"
+
+#include <http_client.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** MultiEndpointTritonClient***************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Spreads requests across several Triton servers serving the same model, such as the pods of a deployment.
+ *
+ * Each request is routed to the endpoint with the lowest expected latency, estimated from an exponentially weighted
+ * moving average of its latency, its requests in flight and its error rate. A request which cannot be sent, or fails,
+ * is immediately retried on the next best endpoint rather than waiting for the stage to back off and retry. When
+ * hedging is enabled, a duplicate of a request still outstanding after the 95th percentile of its endpoint's recent
+ * latencies is sent to a second endpoint, and whichever response arrives first is used.
+ *
+ * An endpoint failing `failure_threshold` requests in a row is ejected for `ejection_time`, after which it is sent
+ * requests again and ejected once more on its next failure. Endpoints are only sent requests while ejected when every
+ * endpoint is ejected.
+ *
+ * Hedging requires the endpoints to send requests asynchronously. CUDA shared memory is not supported.
+ *
+ * @note This object is thread-safe.
+ */
+class MORPHEUS_EXPORT MultiEndpointTritonClient : public ITritonClient
+{
+  public:
+    /**
+     * @brief Construct a new Multi Endpoint Triton Client
+     *
+     * @param endpoints : Clients of each of the servers, at least one
+     * @param hedge_requests : Send a duplicate of slow requests to a second endpoint
+     * @param failure_threshold : Consecutive failures after which an endpoint is ejected
+     * @param ejection_time : Time for which an endpoint is ejected
+     */
+    MultiEndpointTritonClient(std::vector<std::unique_ptr<ITritonClient>>&& endpoints,
+                              bool hedge_requests                     = false,
+                              std::size_t failure_threshold           = DefaultFailureThreshold,
+                              std::chrono::milliseconds ejection_time = DefaultEjectionTime);
+    ~MultiEndpointTritonClient() override;
+
+    MultiEndpointTritonClient(const MultiEndpointTritonClient& other)            = delete;
+    MultiEndpointTritonClient& operator=(const MultiEndpointTritonClient& other) = delete;
+
+    /**
+     * @brief Checks if any of the servers is live
+     */
+    triton::client::Error is_server_live(bool* live) override;
+
+    /**
+     * @brief Checks if any of the servers is ready
+     */
+    triton::client::Error is_server_ready(bool* ready) override;
+
+    /**
+     * @brief Checks if the given model is ready on any of the servers
+     */
+    triton::client::Error is_model_ready(bool* ready, std::string& model_name) override;
+
+    /**
+     * @brief Gets metadata for the given model from the best endpoint which responds
+     */
+    triton::client::Error model_metadata(std::string* model_metadata, std::string& model_name) override;
+
+    /**
+     * @brief Gets the config for the given model from the best endpoint which responds
+     */
+    triton::client::Error model_config(std::string* model_config, std::string& model_name) override;
+
+    /**
+     * @brief Gets the inference statistics of the given model from every endpoint which responds, combining their
+     * `model_stats`
+     */
+    triton::client::Error model_inference_statistics(std::string* statistics, std::string& model_name) override;
+
+    /**
+     * @brief Runs inference on the best endpoint, failing over to the others and hedging as described above
+     */
+    triton::client::Error async_infer(triton::client::InferenceServerHttpClient::OnCompleteFn callback,
+                                      const triton::client::InferOptions& options,
+                                      const std::vector<TritonInferInput>& inputs,
+                                      const std::vector<TritonInferRequestedOutput>& outputs) override;
+
+    /**
+     * @brief Number of endpoints which are currently ejected
+     */
+    std::size_t num_ejected_endpoints() const;
+
+    /**
+     * @brief Number of duplicate requests sent by hedging since the client was created
+     */
+    std::size_t num_hedged_requests() const;
+
+    static constexpr std::size_t DefaultFailureThreshold = 5;
+    static constexpr std::chrono::milliseconds DefaultEjectionTime{10000};
+
+  private:
+    // Latencies kept by each endpoint for the hedging timeout, which is only estimated once enough are known
+    static constexpr std::size_t LatencyWindow   = 128;
+    static constexpr std::size_t MinHedgeSamples = 20;
+
+    struct Endpoint
+    {
+        std::unique_ptr<ITritonClient> client;
+        double latency_ms{0};  // Moving average of the latency of successful requests
+        double error_rate{0};  // Moving average of the fraction of failed requests
+        std::size_t num_samples{0};
+        std::array<double, LatencyWindow> recent_latency_ms{};
+        std::size_t in_flight{0};
+        std::size_t consecutive_failures{0};
+        std::chrono::steady_clock::time_point ejected_until{};
+    };
+
+    struct Request;
+
+    /**
+     * @brief Returns the endpoint with the lowest expected latency which has not been `tried`, only returning an
+     * ejected endpoint when `allow_ejected` is true and every endpoint which has not been tried is ejected
+     */
+    std::optional<std::size_t> select_endpoint(const std::vector<bool>& tried, bool allow_ejected);
+
+    /**
+     * @brief Sends `request` to the endpoint at `index`, returning the error when it could not be sent
+     */
+    triton::client::Error send(const std::shared_ptr<Request>& request, std::size_t index);
+
+    /**
+     * @brief Sends `request` to each endpoint which has not been tried until one accepts it, returning false when
+     * none did
+     */
+    bool fail_over(const std::shared_ptr<Request>& request, triton::client::Error& status);
+
+    void complete(const std::shared_ptr<Request>& request,
+                  std::size_t index,
+                  std::chrono::steady_clock::time_point start,
+                  triton::client::InferResult* result);
+    void record_result(std::size_t index, std::chrono::steady_clock::duration latency, bool failed);
+
+    std::optional<std::chrono::steady_clock::duration> hedge_delay(std::size_t index);
+    void hedge(const std::shared_ptr<Request>& request);
+    void hedge_loop();
+
+    std::vector<Endpoint> m_endpoints;
+    bool m_hedge_requests;
+    std::size_t m_failure_threshold;
+    std::chrono::milliseconds m_ejection_time;
+
+    mutable std::mutex m_mutex;  // Guards the state of the endpoints
+    std::size_t m_num_hedged_requests{0};
+
+    std::mutex m_hedge_mutex;
+    std::condition_variable m_hedge_cv;
+    std::multimap<std::chrono::steady_clock::time_point, std::weak_ptr<Request>> m_pending_hedges;
+    std::atomic<bool> m_stopping{false};
+    std::thread m_hedge_thread;
+};
+
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"  // for MessageMeta
+#include "morpheus/types.hpp"          // for TensorIndex
+
+#include <boost/fiber/context.hpp>
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pybind11/pytypes.h>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <cstddef>  // for size_t
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** MultiFileSourceStage********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Load messages from a list of files, each entry of which may be a glob pattern. The matching files are read
+ * concurrently by `num_readers` threads, each reading on its own CUDA stream, with up to two batches of files per
+ * reader read ahead of the messages being emitted. Messages are emitted in the order of the files when
+ * `preserve_order` is set and in the order they finish being read otherwise.
+ *
+ * Each reader takes up to `files_per_read` files at a time. The small uncompressed files of a batch are read together
+ * into a pinned host buffer with a `BatchFileReader`, then parsed one by one out of that buffer, amortizing the latency
+ * of reading each file over the batch. Larger and compressed files are read by `cudf::io` directly.
+ *
+ * When `batch_rows` is greater than zero, consecutive files with the same columns are concatenated into messages of up
+ * to `batch_rows` rows with `coalesce_message_metas`, files of at least `batch_rows` rows being emitted on their own.
+ */
+class MultiFileSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonSource<std::shared_ptr<MessageMeta>>;
+    using typename base_t::source_type_t;
+    using typename base_t::subscriber_fn_t;
+
+    /**
+     * @brief Construct a new Multi File Source Stage object
+     *
+     * @param filenames : Names of the files to read, or glob patterns matching them
+     * @param num_readers : Number of files read concurrently, must be at least one
+     * @param preserve_order : Emits the messages in the order of the files rather than in the order they are read
+     * @param json_lines : Whether to force json or jsonlines parsing
+     * @param batch_rows : When greater than zero, small files are concatenated into messages of up to this many rows
+     * @param files_per_read : Maximum number of files taken by a reader at a time, must be at least one. Bounds the
+     * number of files read ahead along with `num_readers`, a smaller value limits the memory used for large files.
+     */
+    MultiFileSourceStage(std::vector<std::string> filenames,
+                         std::size_t num_readers        = 4,
+                         bool preserve_order            = true,
+                         std::optional<bool> json_lines = std::nullopt,
+                         TensorIndex batch_rows         = 0,
+                         std::size_t files_per_read     = 16);
+
+    /**
+     * @brief Expands each glob pattern of `filenames` into the sorted list of files matching it, entries without any
+     * wildcard being kept as they are
+     *
+     * @throws std::runtime_error If a pattern does not match any file
+     */
+    static std::vector<std::string> expand_globs(const std::vector<std::string>& filenames);
+
+  private:
+    subscriber_fn_t build();
+
+    /**
+     * @brief Emits `meta`, or holds it back to be concatenated with the following files when `m_batch_rows` is set
+     */
+    void emit(std::shared_ptr<MessageMeta> meta, rxcpp::subscriber<source_type_t>& output);
+
+    /**
+     * @brief Emits the files held back by `emit` as a single message, if any
+     */
+    void flush(rxcpp::subscriber<source_type_t>& output);
+
+    std::vector<std::string> m_filenames;
+    std::size_t m_num_readers;
+    bool m_preserve_order;
+    std::optional<bool> m_json_lines;
+    TensorIndex m_batch_rows;
+    std::size_t m_files_per_read;
+
+    // Files held back by `emit`, only accessed by the thread emitting messages
+    std::vector<std::shared_ptr<MessageMeta>> m_pending;
+    std::vector<std::string> m_pending_columns;
+    TensorIndex m_pending_rows{0};
+};
+
+/****** MultiFileSourceStageInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct MultiFileSourceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a MultiFileSourceStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param filenames : Names of the files to read, or glob patterns matching them.
+     * @param num_readers : Number of files read concurrently.
+     * @param preserve_order : Emits the messages in the order of the files rather than in the order they are read.
+     * @param parser_kwargs : Optional arguments to pass to the file parser.
+     * @param batch_rows : When greater than zero, small files are concatenated into messages of up to this many rows.
+     * @param files_per_read : Maximum number of files taken by a reader at a time.
+     * @return std::shared_ptr<mrc::segment::Object<MultiFileSourceStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<MultiFileSourceStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::vector<std::string> filenames,
+        std::size_t num_readers      = 4,
+        bool preserve_order          = true,
+        pybind11::dict parser_kwargs = pybind11::dict(),
+        TensorIndex batch_rows       = 0,
+        std::size_t files_per_read   = 16);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/multi_response.hpp"
+#include "morpheus/objects/dtype.hpp"  // for TypeId
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** NormalizeEmbeddingsStage****************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Returns a copy of `message` whose `tensor_name` tensor is replaced by a contiguous row major tensor of
+ * `output_type`, each row being scaled to a unit L2 norm when `normalize` is set. The other tensors of the message are
+ * kept as they are, the new message only holding the rows of `message`.
+ *
+ * @param message
+ * @param tensor_name : Name of the 2D embeddings tensor
+ * @param output_type : One of float16, float32 or float64
+ * @param normalize
+ * @return std::shared_ptr<MultiResponseMessage>
+ * @throws std::invalid_argument If the tensor is not 2D or `output_type` is not a floating point type
+ */
+std::shared_ptr<MultiResponseMessage> normalize_embeddings(const MultiResponseMessage& message,
+                                                           const std::string& tensor_name,
+                                                           TypeId output_type,
+                                                           bool normalize);
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Converts the embeddings computed by an inference stage to a single contiguous tensor per message, such as a
+ * float16 tensor of unit vectors ready to be written to a vector database or compared with an inner product. The
+ * conversion and normalization of a whole message are done with a single kernel launch.
+ */
+class NormalizeEmbeddingsStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<MultiResponseMessage>, std::shared_ptr<MultiResponseMessage>>
+{
+  public:
+    using base_t =
+        mrc::pymrc::PythonNode<std::shared_ptr<MultiResponseMessage>, std::shared_ptr<MultiResponseMessage>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Normalize Embeddings Stage object
+     *
+     * @param tensor_name : Name of the 2D embeddings tensor
+     * @param output_type : One of float16, float32 or float64
+     * @param normalize : Whether to scale each embedding to a unit L2 norm
+     */
+    NormalizeEmbeddingsStage(std::string tensor_name, TypeId output_type, bool normalize);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    std::string m_tensor_name;
+    TypeId m_output_type;
+    bool m_normalize;
+};
+
+/****** NormalizeEmbeddingsStageInterfaceProxy**************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct NormalizeEmbeddingsStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a NormalizeEmbeddingsStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param tensor_name : Name of the 2D embeddings tensor
+     * @param output_type : One of float16, float32 or float64
+     * @param normalize : Whether to scale each embedding to a unit L2 norm
+     * @return std::shared_ptr<mrc::segment::Object<NormalizeEmbeddingsStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<NormalizeEmbeddingsStage>> init(mrc::segment::Builder& builder,
+                                                                                const std::string& name,
+                                                                                std::string tensor_name,
+                                                                                TypeId output_type,
+                                                                                bool normalize);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
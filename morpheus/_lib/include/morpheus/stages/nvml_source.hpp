@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"
+
+#include <cudf/io/types.hpp>  // for table_with_metadata
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <nvml.h>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>   // for milliseconds
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int32_t
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** NvmlSampler*****************************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Polls the telemetry of every GPU of the node through NVML, accumulating one row per GPU and poll on the host
+ * until the rows are copied to the device as a table.
+ *
+ * The table holds a `timestamp` column, in seconds since the epoch, the `nvidia_smi_log.gpu.minor_number` of each GPU
+ * and the features of the ABP nvsmi model named as in `data/columns_fil.txt`, in the units of `nvidia-smi`. Values a
+ * GPU does not report are null.
+ */
+class NvmlSampler
+{
+  public:
+    /**
+     * @brief Initializes NVML and enumerates the GPUs
+     *
+     * @throws std::runtime_error If NVML could not be initialized
+     */
+    NvmlSampler();
+    ~NvmlSampler();
+
+    NvmlSampler(const NvmlSampler&)            = delete;
+    NvmlSampler& operator=(const NvmlSampler&) = delete;
+
+    /**
+     * @brief Names of the feature columns, in the order of the features of the ABP nvsmi model
+     */
+    static const std::vector<std::string>& feature_columns();
+
+    std::size_t num_devices() const;
+
+    /**
+     * @brief Number of rows sampled since the last call to `flush`
+     */
+    std::size_t num_rows() const;
+
+    /**
+     * @brief Samples every GPU, appending a row per GPU
+     *
+     * @throws std::runtime_error If a GPU could not be queried for a reason other than the query not being supported
+     */
+    void sample();
+
+    /**
+     * @brief Copies the rows sampled since the last call to the device, clearing them
+     */
+    cudf::io::table_with_metadata flush();
+
+  private:
+    std::vector<nvmlDevice_t> m_devices;
+    std::vector<int32_t> m_minor_numbers;
+
+    std::vector<double> m_timestamps;
+    std::vector<int32_t> m_row_minor_numbers;
+    std::vector<std::vector<std::optional<double>>> m_features;  // One vector per feature column
+};
+
+#pragma GCC visibility push(default)
+/****** NvmlSourceStage*************************************/
+/**
+ * @brief Source polling the GPUs of the node through NVML every `interval`, emitting the telemetry of
+ * `polls_per_message` polls as a single `MessageMeta`, see `NvmlSampler`. The feature columns are built straight into a
+ * cudf table, without going through `nvidia-smi` output or any text parsing, ready for `PreprocessFILStage`.
+ */
+class NvmlSourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonSource<std::shared_ptr<MessageMeta>>;
+    using typename base_t::source_type_t;
+    using typename base_t::subscriber_fn_t;
+
+    /**
+     * @brief Construct a new Nvml Source Stage object
+     *
+     * @param interval : Time between two polls
+     * @param polls_per_message : Number of polls emitted as a single message
+     * @param max_polls : Number of polls after which the stage completes, polling until stopped when zero
+     * @throws std::invalid_argument If `polls_per_message` is zero
+     */
+    NvmlSourceStage(std::chrono::milliseconds interval, std::size_t polls_per_message, std::size_t max_polls);
+
+  private:
+    subscriber_fn_t build();
+
+    std::chrono::milliseconds m_interval;
+    std::size_t m_polls_per_message;
+    std::size_t m_max_polls;
+};
+
+/****** NvmlSourceStageInterfaceProxy***********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct NvmlSourceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a NvmlSourceStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param interval_ms : Time between two polls, in milliseconds
+     * @param polls_per_message : Number of polls emitted as a single message
+     * @param max_polls : Number of polls after which the stage completes, polling until stopped when zero
+     * @return std::shared_ptr<mrc::segment::Object<NvmlSourceStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<NvmlSourceStage>> init(mrc::segment::Builder& builder,
+                                                                        const std::string& name,
+                                                                        int64_t interval_ms,
+                                                                        std::size_t polls_per_message,
+                                                                        std::size_t max_polls);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
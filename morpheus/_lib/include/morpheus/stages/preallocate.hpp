@@ -28,6 +28,7 @@
 #include <pymrc/node.hpp>
 #include <rxcpp/rx.hpp>
 
+#include <algorithm>  // for find, none_of
 #include <memory>
 #include <string>
 #include <tuple>
@@ -47,6 +48,19 @@ namespace {
 void preallocate(std::shared_ptr<morpheus::MessageMeta> msg,
                  const std::vector<std::tuple<std::string, morpheus::DType>>& columns)
 {
+    // Check with a shared lock first, in the common case the columns already exist and the exclusive lock, which
+    // would block every other reader and writer of the table, is not needed
+    auto column_names = msg->get_column_names();
+    auto is_missing   = [&column_names](const auto& column) {
+        return std::find(column_names.begin(), column_names.end(), std::get<0>(column)) == column_names.end();
+    };
+
+    if (std::none_of(columns.begin(), columns.end(), is_missing))
+    {
+        return;
+    }
+
+    // The columns are checked again under the exclusive lock, another writer may have inserted them in the meantime
     auto table = msg->get_mutable_info();
     table.insert_missing_columns(columns);
 }
@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/multi.hpp"
+#include "morpheus/messages/multi_inference.hpp"
+#include "morpheus/objects/dense_model_store.hpp"
+#include "morpheus/objects/feature_scalers.hpp"
+
+#include <boost/fiber/context.hpp>
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// IWYU pragma: no_include "rxcpp/sources/rx-iterate.hpp"
+
+namespace morpheus {
+
+/****** Component public implementations *******************/
+/****** PreprocessAEStage***********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Autoencoder input data for inference. Scales the feature columns of each message with precomputed
+ * `FeatureScalers` into a row major float32 `input` tensor, along with its `seq_ids`, with a single kernel launch.
+ *
+ * The scalers of the user held by the `user_id_key` metadata of a `ControlMessage` are applied, such as the messages
+ * of the `SplitUsersStage`, falling back to the global scalers. A `MultiMessage` is always scaled with the global
+ * scalers. When given a `DenseModelStore`, an int32 `model_index` tensor of the model of the user is also added, the
+ * inputs of the `GroupedDenseInferenceStage`.
+ */
+template <typename InputT, typename OutputT>
+class PreprocessAEStage : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>, std::shared_ptr<OutputT>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<InputT>, std::shared_ptr<OutputT>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Constructor for a class `PreprocessAEStage`
+     *
+     * @param scalers : Scalers of the features, loaded once and shared by every message
+     * @param model_store : Store of the per-user models, adding a `model_index` tensor to each `ControlMessage`.
+     * Optional
+     * @param user_id_key : Metadata key of the user of a `ControlMessage`
+     */
+    PreprocessAEStage(std::shared_ptr<FeatureScalers> scalers,
+                      std::shared_ptr<DenseModelStore> model_store = nullptr,
+                      std::string user_id_key                      = "user_id");
+
+    /**
+     * Called every time a message is passed to this stage
+     */
+    source_type_t on_data(sink_type_t x);
+
+  private:
+    std::shared_ptr<MultiInferenceMessage> on_multi_message(std::shared_ptr<MultiMessage> x);
+    std::shared_ptr<ControlMessage> on_control_message(std::shared_ptr<ControlMessage> x);
+
+    std::shared_ptr<FeatureScalers> m_scalers;
+    std::shared_ptr<DenseModelStore> m_model_store;
+    std::string m_user_id_key;
+};
+
+using PreprocessAEStageMM =  // NOLINT(readability-identifier-naming)
+    PreprocessAEStage<MultiMessage, MultiInferenceMessage>;
+using PreprocessAEStageCM =  // NOLINT(readability-identifier-naming)
+    PreprocessAEStage<ControlMessage, ControlMessage>;
+
+/****** PreprocessAEStageInferenceProxy*********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct PreprocessAEStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a PreprocessAEStage that receives MultiMessage and emits MultiInferenceMessage,
+     * and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param scalers : Scalers of the features
+     * @return std::shared_ptr<mrc::segment::Object<PreprocessAEStage<MultiMessage, MultiInferenceMessage>>>
+     */
+    static std::shared_ptr<mrc::segment::Object<PreprocessAEStage<MultiMessage, MultiInferenceMessage>>> init_multi(
+        mrc::segment::Builder& builder, const std::string& name, std::shared_ptr<FeatureScalers> scalers);
+
+    /**
+     * @brief Create and initialize a PreprocessAEStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param scalers : Scalers of the features
+     * @param model_store : Store of the per-user models, adding a `model_index` tensor. Optional
+     * @param user_id_key : Metadata key of the user of each message
+     * @return std::shared_ptr<mrc::segment::Object<PreprocessAEStage<ControlMessage, ControlMessage>>>
+     */
+    static std::shared_ptr<mrc::segment::Object<PreprocessAEStage<ControlMessage, ControlMessage>>> init_cm(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::shared_ptr<FeatureScalers> scalers,
+        std::shared_ptr<DenseModelStore> model_store,
+        std::string user_id_key);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -20,20 +20,23 @@
 #include "morpheus/messages/control.hpp"          // for ControlMessage
 #include "morpheus/messages/multi.hpp"            // for MultiMessage
 #include "morpheus/messages/multi_inference.hpp"  // for MultiInferenceMessage
+#include "morpheus/objects/tokenizer.hpp"         // for ITokenizer
+#include "morpheus/types.hpp"                     // for TensorIndex
+#include "morpheus/utilities/cuda_util.hpp"       // for CudaUtil
 
-#include <boost/fiber/context.hpp>                   // for operator<<
-#include <cudf/strings/strings_column_view.hpp>      // for strings_column_view
-#include <mrc/segment/builder.hpp>                   // for Builder
-#include <mrc/segment/object.hpp>                    // for Object
-#include <nvtext/subword_tokenize.hpp>               // for tokenizer_result
-#include <pymrc/node.hpp>                            // for PythonNode
-#include <rmm/mr/device/device_memory_resource.hpp>  // for device_memory_resource
-#include <rxcpp/rx.hpp>                              // for observable_member, trace_activity, decay_t
+#include <boost/fiber/context.hpp>   // for operator<<
+#include <mrc/segment/builder.hpp>   // for Builder
+#include <mrc/segment/object.hpp>    // for Object
+#include <pymrc/node.hpp>            // for PythonNode
+#include <rmm/cuda_stream_pool.hpp>  // for cuda_stream_pool
+#include <rmm/cuda_stream_view.hpp>  // for cuda_stream_view
+#include <rxcpp/rx.hpp>              // for observable_member, trace_activity, decay_t
 
 #include <cstdint>  // for uint32_t
 #include <memory>   // for shared_ptr, allocator
 #include <string>   // for string
 #include <thread>   // for operator<<
+#include <vector>   // for vector
 
 // IWYU pragma: no_include "rxcpp/sources/rx-iterate.hpp"
 
@@ -64,7 +67,8 @@ class PreprocessNLPStage : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>
      * @brief Construct a new Preprocess NLP Stage object
      *
      * @param vocab_hash_file : Path to hash file containing vocabulary of words with token-ids. This can be created
-     * from the raw vocabulary using the `cudf.utils.hash_vocab_utils.hash_vocab` function.
+     * from the raw vocabulary using the `cudf.utils.hash_vocab_utils.hash_vocab` function. The vocabulary is loaded
+     * once per device and shared by every stage using the same file.
      * @param sequence_length : Sequence Length to use (We add to special tokens for NER classification job).
      * @param truncation : If set to true, strings will be truncated and padded to max_length. Each input string will
      * result in exactly one output sequence. If set to false, there may be multiple output sequences when the
@@ -77,6 +81,11 @@ class PreprocessNLPStage : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>
      * equal to stride there are no duplicated-id tokens. If stride is 80% of max_length, 20% of the first sequence will
      * be repeated on the second sequence and so on until the entire sentence is encoded.
      * @param column : Name of the string column to operate on, defaults to "data".
+     * @param uint32_tokens : Emit `input_ids` and `input_mask` as the uint32 tensors produced by the tokenizer,
+     * adopting its buffers rather than casting them to int32. Suited to models accepting uint32 inputs.
+     * @param sequence_length_buckets : When not empty, the columns of `input_ids` and `input_mask` are trimmed to the
+     * smallest of these lengths holding the longest sequence of the message, or `sequence_length` when none do, rather
+     * than padding every message to `sequence_length`. Requires a model accepting a variable sequence length.
      */
     PreprocessNLPStage(std::string vocab_hash_file,
                        uint32_t sequence_length,
@@ -84,7 +93,34 @@ class PreprocessNLPStage : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>
                        bool do_lower_case,
                        bool add_special_token,
                        int stride         = -1,
-                       std::string column = "data");
+                       std::string column                               = "data",
+                       bool uint32_tokens                               = false,
+                       std::vector<TensorIndex> sequence_length_buckets = {});
+
+    /**
+     * @brief Construct a new Preprocess NLP Stage object tokenizing with `tokenizer`, such as a `BytePairTokenizer`
+     *
+     * @param tokenizer : Tokenizer producing the `input_ids`, `input_mask` and `seq_ids` of each message.
+     * @param sequence_length : Sequence Length to use (We add to special tokens for NER classification job).
+     * @param truncation : If set to true, strings will be truncated and padded to max_length. Each input string will
+     * result in exactly one output sequence. If set to false, there may be multiple output sequences when the
+     * max_length is smaller than generated tokens.
+     * @param add_special_token : Whether or not to encode the sequences with the special tokens of the BERT
+     * classification model.
+     * @param stride : Number of tokens between the starts of consecutive sequences of a string when `truncation` is
+     * false, defaults to 75% of `sequence_length`.
+     * @param column : Name of the string column to operate on, defaults to "data".
+     * @param uint32_tokens : Emit `input_ids` and `input_mask` as the uint32 tensors produced by the tokenizer.
+     * @param sequence_length_buckets : Lengths to trim the columns of `input_ids` and `input_mask` to.
+     */
+    PreprocessNLPStage(std::shared_ptr<ITokenizer> tokenizer,
+                       uint32_t sequence_length,
+                       bool truncation,
+                       bool add_special_token,
+                       int stride                                       = -1,
+                       std::string column                               = "data",
+                       bool uint32_tokens                               = false,
+                       std::vector<TensorIndex> sequence_length_buckets = {});
 
     /**
      * Called every time a message is passed to this stage
@@ -92,22 +128,29 @@ class PreprocessNLPStage : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>
     source_type_t on_data(sink_type_t x);
 
   private:
-    std::shared_ptr<MultiInferenceMessage> on_multi_message(std::shared_ptr<MultiMessage> x);
-    std::shared_ptr<ControlMessage> on_control_message(std::shared_ptr<ControlMessage> x);
-    nvtext::tokenizer_result subword_tokenize(const std::string& vocab_hash_file,
-                                              uint32_t sequence_length,
-                                              bool do_lower_case,
-                                              bool truncation,
-                                              cudf::strings_column_view const& string_col,
-                                              int stride,
-                                              rmm::mr::device_memory_resource* mr);
-    std::string m_vocab_hash_file;
+    std::shared_ptr<MultiInferenceMessage> on_multi_message(std::shared_ptr<MultiMessage> x,
+                                                            rmm::cuda_stream_view stream);
+    std::shared_ptr<ControlMessage> on_control_message(std::shared_ptr<ControlMessage> x, rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Returns the stream to build the tensors of the next message on. Messages on the device the stage was
+     * constructed on take turns on the streams of `m_streams`, others use the cudf default stream.
+     */
+    rmm::cuda_stream_view next_stream() const;
+
+    std::shared_ptr<ITokenizer> m_tokenizer;
     std::string m_column;
     uint32_t m_sequence_length;
     bool m_truncation;
-    bool m_do_lower_case;
     bool m_add_special_token;
     int m_stride{-1};
+    bool m_uint32_tokens{false};
+    std::vector<TensorIndex> m_sequence_length_buckets;  // Ascending, each shorter than `m_sequence_length`
+
+    // Streams of the device the stage was constructed on, allowing the tensors of consecutive messages to be built
+    // while the previous ones are still in use downstream
+    int m_device_id{CudaUtil::current_device()};
+    rmm::cuda_stream_pool m_streams;
 };
 
 using PreprocessNLPStageMM =  // NOLINT(readability-identifier-naming)
@@ -141,6 +184,13 @@ struct PreprocessNLPStageInterfaceProxy
      * equal to stride there are no duplicated-id tokens. If stride is 80% of max_length, 20% of the first sequence will
      * be repeated on the second sequence and so on until the entire sentence is encoded.
      * @param column : Name of the string column to operate on, defaults to "data".
+     * @param uint32_tokens : Emit `input_ids` and `input_mask` as the uint32 tensors produced by the tokenizer,
+     * adopting its buffers rather than casting them to int32. Suited to models accepting uint32 inputs.
+     * @param sequence_length_buckets : When not empty, the columns of `input_ids` and `input_mask` are trimmed to the
+     * smallest of these lengths holding the longest sequence of the message, or `sequence_length` when none do, rather
+     * than padding every message to `sequence_length`. Requires a model accepting a variable sequence length.
+     * @param tokenizer : When set, tokenizes with this tokenizer instead of the WordPiece vocabulary of
+     * `vocab_hash_file`, for instance a `BytePairTokenizer` for RoBERTa style models.
      * @return std::shared_ptr<mrc::segment::Object<PreprocessNLPStage<MultiMessage, MultiInferenceMessage>>>
      */
     static std::shared_ptr<mrc::segment::Object<PreprocessNLPStage<MultiMessage, MultiInferenceMessage>>> init_multi(
@@ -151,8 +201,11 @@ struct PreprocessNLPStageInterfaceProxy
         bool truncation,
         bool do_lower_case,
         bool add_special_token,
-        int stride         = -1,
-        std::string column = "data");
+        int stride                                       = -1,
+        std::string column                               = "data",
+        bool uint32_tokens                               = false,
+        std::vector<TensorIndex> sequence_length_buckets = {},
+        std::shared_ptr<ITokenizer> tokenizer            = nullptr);
     /**
      * @brief Create and initialize a ProcessNLPStage that receives ControlMessage and emits ControlMessage, and return
      * the result
@@ -173,6 +226,13 @@ struct PreprocessNLPStageInterfaceProxy
      * equal to stride there are no duplicated-id tokens. If stride is 80% of max_length, 20% of the first sequence will
      * be repeated on the second sequence and so on until the entire sentence is encoded.
      * @param column : Name of the string column to operate on, defaults to "data".
+     * @param uint32_tokens : Emit `input_ids` and `input_mask` as the uint32 tensors produced by the tokenizer,
+     * adopting its buffers rather than casting them to int32. Suited to models accepting uint32 inputs.
+     * @param sequence_length_buckets : When not empty, the columns of `input_ids` and `input_mask` are trimmed to the
+     * smallest of these lengths holding the longest sequence of the message, or `sequence_length` when none do, rather
+     * than padding every message to `sequence_length`. Requires a model accepting a variable sequence length.
+     * @param tokenizer : When set, tokenizes with this tokenizer instead of the WordPiece vocabulary of
+     * `vocab_hash_file`, for instance a `BytePairTokenizer` for RoBERTa style models.
      * @return std::shared_ptr<mrc::segment::Object<PreprocessNLPStage<ControlMessage, ControlMessage>>>
      */
     static std::shared_ptr<mrc::segment::Object<PreprocessNLPStage<ControlMessage, ControlMessage>>> init_cm(
@@ -183,8 +243,11 @@ struct PreprocessNLPStageInterfaceProxy
         bool truncation,
         bool do_lower_case,
         bool add_special_token,
-        int stride         = -1,
-        std::string column = "data");
+        int stride                                       = -1,
+        std::string column                               = "data",
+        bool uint32_tokens                               = false,
+        std::vector<TensorIndex> sequence_length_buckets = {},
+        std::shared_ptr<ITokenizer> tokenizer            = nullptr);
 };
 
 #pragma GCC visibility pop
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <cstddef>  // for size_t
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** ReplaySourceStage***********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Replays the batches recorded by a source stage in capture mode, see `SourceCaptureWriter`, such that a build
+ * can be measured against recorded production traffic rather than synthetic data. Batches are emitted with the
+ * intervals they were received with divided by `speed`, or back to back when `speed` is zero. Each batch is read onto
+ * the device before waiting for its emission time, such that reading the log does not delay the emissions.
+ *
+ * The number of batches and rows replayed, along with the achieved rate, are logged once the stage completes.
+ */
+class ReplaySourceStage : public mrc::pymrc::PythonSource<std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonSource<std::shared_ptr<MessageMeta>>;
+    using typename base_t::source_type_t;
+    using typename base_t::subscriber_fn_t;
+
+    /**
+     * @brief Construct a new Replay Source Stage object
+     *
+     * @param filename : Capture log to replay
+     * @param speed : Factor the recorded rate is multiplied by, `1` replaying at the original rate and `0` as fast as
+     * possible
+     * @param repeat : Number of times the log is replayed
+     * @throws std::invalid_argument If `speed` is negative or `repeat` is zero
+     */
+    ReplaySourceStage(std::filesystem::path filename, double speed, std::size_t repeat);
+
+  private:
+    subscriber_fn_t build();
+
+    std::filesystem::path m_filename;
+    double m_speed;
+    std::size_t m_repeat;
+};
+
+/****** ReplaySourceStageInterfaceProxy*********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct ReplaySourceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a ReplaySourceStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param filename : Capture log to replay
+     * @param speed : Factor the recorded rate is multiplied by, `0` replaying as fast as possible
+     * @param repeat : Number of times the log is replayed
+     * @return std::shared_ptr<mrc::segment::Object<ReplaySourceStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<ReplaySourceStage>> init(mrc::segment::Builder& builder,
+                                                                          const std::string& name,
+                                                                          std::filesystem::path filename,
+                                                                          double speed,
+                                                                          std::size_t repeat);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/objects/user_history_store.hpp"
+#include "morpheus/utilities/metrics.hpp"           // for Gauge
+#include "morpheus/utilities/state_checkpoint.hpp"  // for StateCheckpoint
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>   // for milliseconds
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** RollingWindowStage**********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Groups the rows of each user into a rolling window, the C++ counterpart of the rolling window of the DFP
+ * pipelines. The rows of incoming `ControlMessage`s with a `data_type` of `streaming` (the default) are appended to the
+ * device resident history of the user named by their `user_id` metadata, held by a `UserHistoryStore`. Once the
+ * history of a user holds at least `min_history` rows, and at least `min_increment` rows have been appended since its
+ * last window, the message is emitted with the window as its payload and a `data_type` of `payload`. Messages with a
+ * `data_type` of `payload` are passed through.
+ *
+ * Batches overlapping the history of the user, or preceding it, are dropped along with their message.
+ *
+ * When checkpoints are enabled, the histories are restored from the latest checkpoint of the stage on construction and
+ * saved periodically as well as once the input completes. Batches replayed from before the checkpoint lie within the
+ * restored histories and are dropped.
+ */
+class RollingWindowStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Rolling Window Stage object
+     *
+     * @param timestamp_column : Name of the timestamp column of the rows
+     * @param min_history : Minimum number of rows held for a user before a window is emitted
+     * @param min_increment : Minimum number of rows appended for a user since its last window before another one is
+     * emitted
+     * @param max_history_rows : Windows hold at most this many rows, besides the rows not yet part of a window.
+     * Disabled when 0
+     * @param max_history_ns : Windows hold the rows at most this many nanoseconds older than the newest row, besides
+     * the rows not yet part of a window. Disabled when 0
+     * @param max_device_bytes : Spill the histories of the least recently active users to host memory above this many
+     * bytes. Disabled when 0
+     * @param checkpoint_name : Names the checkpoints of the histories
+     * @param checkpoint_interval : Minimum duration between two checkpoints of the histories, see `StateCheckpoint`.
+     * Disabled when zero
+     */
+    RollingWindowStage(std::string timestamp_column,
+                       int64_t min_history,
+                       int64_t min_increment,
+                       int64_t max_history_rows,
+                       int64_t max_history_ns,
+                       std::size_t max_device_bytes,
+                       std::string checkpoint_name                   = "rolling_window",
+                       std::chrono::milliseconds checkpoint_interval = std::chrono::milliseconds(0));
+
+  private:
+    subscribe_fn_t build_operator();
+
+    // Appends the rows of `message` to the history of its user, returning the message with its window or nullptr
+    std::shared_ptr<ControlMessage> on_data(std::shared_ptr<ControlMessage> message);
+
+    int64_t m_min_history;
+    int64_t m_min_increment;
+    UserHistoryStore m_store;
+    StateCheckpoint m_checkpoint;
+
+    std::shared_ptr<Gauge> m_users_gauge;
+    std::shared_ptr<Gauge> m_device_bytes_gauge;
+};
+
+/****** RollingWindowStageInterfaceProxy********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct RollingWindowStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a RollingWindowStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param timestamp_column : Name of the timestamp column of the rows
+     * @param min_history : Minimum number of rows held for a user before a window is emitted
+     * @param min_increment : Minimum number of rows appended for a user between two windows
+     * @param max_history_rows : Maximum number of rows of a window, disabled when 0
+     * @param max_history_ns : Maximum age of the rows of a window relative to the newest row, disabled when 0
+     * @param max_device_bytes : Spill the histories of idle users to host memory above this many bytes, disabled when 0
+     * @param checkpoint_interval_ms : Minimum duration in milliseconds between two checkpoints, disabled when 0
+     * @return std::shared_ptr<mrc::segment::Object<RollingWindowStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<RollingWindowStage>> init(mrc::segment::Builder& builder,
+                                                                          const std::string& name,
+                                                                          std::string timestamp_column,
+                                                                          int64_t min_history,
+                                                                          int64_t min_increment,
+                                                                          int64_t max_history_rows,
+                                                                          int64_t max_history_ns,
+                                                                          std::size_t max_device_bytes,
+                                                                          std::size_t checkpoint_interval_ms);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
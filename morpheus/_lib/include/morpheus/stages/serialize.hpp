@@ -27,10 +27,12 @@
 #include <pymrc/node.hpp>
 #include <rxcpp/rx.hpp>  // for apply, make_subscriber, observable_member, is_on_error<>::not_void, is_on_next_of<>::not_void, from
 
+#include <cstddef>  // for size_t
 #include <memory>
 #include <regex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>  // for vector
 
 // IWYU pragma: no_include "rxcpp/sources/rx-iterate.hpp"
@@ -65,13 +67,24 @@ class SerializeStage : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>, st
      * @param include : Attributes that are required send to downstream stage.
      * @param exclude : Attributes that are not required send to downstream stage.
      * @param fixed_columns : When `True` `SerializeStage` will assume that the Dataframe in all messages contain
-     * the same columns as the first message received.
+     * the same columns as the first message received. Otherwise the columns are resolved once per distinct set of
+     * column names, rather than once per message.
      */
     SerializeStage(const std::vector<std::string>& include,
                    const std::vector<std::string>& exclude,
                    bool fixed_columns = true);
 
   private:
+    /**
+     * @brief Columns of a schema passing the include & exclude patterns, along with the columns of the schema itself
+     * to tell apart schemas whose names hash to the same value
+     */
+    struct ColumnPlan
+    {
+        std::vector<std::string> input_columns;
+        std::vector<std::string> columns;
+    };
+
     void make_regex_objs(const std::vector<std::string>& regex_strs, std::vector<std::regex>& regex_objs);
 
     bool match_column(const std::vector<std::regex>& patterns, const std::string& column) const;
@@ -80,6 +93,12 @@ class SerializeStage : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>, st
 
     bool exclude_column(const std::string& column) const;
 
+    /**
+     * @brief Returns the columns of `column_names` passing the include & exclude patterns. Only the first message of
+     * each schema pays for matching the patterns, the result is cached by a hash of the column names.
+     */
+    const std::vector<std::string>& resolve_columns(const std::vector<std::string>& column_names);
+
     std::shared_ptr<SlicedMessageMeta> get_meta(sink_type_t& msg);
 
     subscribe_fn_t build_operator();
@@ -88,6 +107,9 @@ class SerializeStage : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>, st
     std::vector<std::regex> m_include;
     std::vector<std::regex> m_exclude;
     std::vector<std::string> m_column_names;
+
+    // Keyed by a hash of the input column names, cleared once `MaxColumnPlans` schemas have been seen
+    std::unordered_map<std::size_t, ColumnPlan> m_column_plans;
 };
 
 using SerializeStageMM = SerializeStage<MultiMessage>;    // NOLINT(readability-identifier-naming)
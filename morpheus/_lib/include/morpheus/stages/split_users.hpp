@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>  // for pair
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** SplitUsersStage*************************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Splits the rows of `meta` by the value of its `userid_column` string column. A dictionary encoded column is
+ * grouped by its indices, only the id of each user being decoded. The rows are grouped by user
+ * with a single sort into one new C++ backed table, and each user is returned as a `SlicedMessageMeta` over its rows
+ * of that table, such that all of the users share a single allocation. Rows with a null user id are dropped.
+ *
+ * @param meta
+ * @param userid_column
+ * @return std::vector<std::pair<std::string, std::shared_ptr<MessageMeta>>> : The user ids along with their rows, in
+ * ascending order of user id
+ * @throws std::invalid_argument If `userid_column` is missing or is not a string column
+ */
+std::vector<std::pair<std::string, std::shared_ptr<MessageMeta>>> split_by_user(
+    const std::shared_ptr<MessageMeta>& meta, const std::string& userid_column);
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Splits the payload of each incoming `ControlMessage` into one message per user, the C++ counterpart of the
+ * split users stage of the DFP pipelines. Each emitted message is a copy of the incoming one, holding the rows of a
+ * single user as its payload and the user id as its `user_id` metadata. When `include_generic` is set, an additional
+ * message holding the rows of every user is emitted with a `user_id` of `fallback_username`.
+ *
+ * Messages are emitted in ascending order of user id. Unlike the python stage, the index of the rows is not reset per
+ * user.
+ */
+class SplitUsersStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Split Users Stage object
+     *
+     * @param userid_column : Name of the string column holding the user id of the rows
+     * @param fallback_username : User id of the message holding the rows of every user
+     * @param include_generic : Whether to emit a message holding the rows of every user
+     * @param include_individual : Whether to emit a message per user
+     * @param skip_users : User ids whose rows are dropped
+     * @param only_users : When not empty, the only user ids whose rows are kept
+     */
+    SplitUsersStage(std::string userid_column,
+                    std::string fallback_username,
+                    bool include_generic,
+                    bool include_individual,
+                    const std::vector<std::string>& skip_users,
+                    const std::vector<std::string>& only_users);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    // Splits the payload of `message`, returning the messages to emit
+    std::vector<std::shared_ptr<ControlMessage>> on_data(const std::shared_ptr<ControlMessage>& message);
+
+    bool is_kept(const std::string& user_id) const;
+
+    std::string m_userid_column;
+    std::string m_fallback_username;
+    bool m_include_generic;
+    bool m_include_individual;
+    std::set<std::string> m_skip_users;
+    std::set<std::string> m_only_users;
+};
+
+/****** SplitUsersStageInterfaceProxy***********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct SplitUsersStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a SplitUsersStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param userid_column : Name of the string column holding the user id of the rows
+     * @param fallback_username : User id of the message holding the rows of every user
+     * @param include_generic : Whether to emit a message holding the rows of every user
+     * @param include_individual : Whether to emit a message per user
+     * @param skip_users : User ids whose rows are dropped
+     * @param only_users : When not empty, the only user ids whose rows are kept
+     * @return std::shared_ptr<mrc::segment::Object<SplitUsersStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<SplitUsersStage>> init(mrc::segment::Builder& builder,
+                                                                       const std::string& name,
+                                                                       std::string userid_column,
+                                                                       std::string fallback_username,
+                                                                       bool include_generic,
+                                                                       bool include_individual,
+                                                                       const std::vector<std::string>& skip_users,
+                                                                       const std::vector<std::string>& only_users);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
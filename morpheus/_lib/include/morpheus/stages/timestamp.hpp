@@ -0,0 +1,108 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/messages/multi.hpp"
+#include "morpheus/objects/message_timestamps.hpp"
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** TimestampStage********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Pass-through node stamping the messages entering or exiting a stage, inserted by the pipeline when
+ * `Config.trace_timestamps` is set. The key is interned once when the node is constructed, so stamping a message only
+ * reads the clock and appends to its timestamps. `MultiMessage`s are stamped on their `MessageMeta`.
+ *
+ * When `sample_interval` is non-zero the node sits at a sink of the pipeline, and the timestamps of every
+ * `sample_interval`-th message are recorded by a `TimestampTraceExporter`. In the Python bindings the stage is bound as
+ * `TimestampMessageMetaStage`, `TimestampMultiMessageStage` and `TimestampControlMessageStage`.
+ */
+template <typename MessageT>
+class TimestampStage : public mrc::pymrc::PythonNode<std::shared_ptr<MessageT>, std::shared_ptr<MessageT>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageT>, std::shared_ptr<MessageT>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Timestamp Stage object
+     *
+     * @param stage_name : Name of the stage whose entry or exit is stamped
+     * @param is_exit : Stamp the `<stage_name>::exit` key when true, otherwise the `<stage_name>::entry` key
+     * @param sample_interval : Record the timestamps of every `sample_interval`-th message, 0 to only stamp them
+     */
+    TimestampStage(std::string stage_name, bool is_exit, std::size_t sample_interval = 0);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    timestamp_key_t m_key;
+    std::size_t m_sample_interval;
+    std::atomic<std::size_t> m_message_count{0};
+    std::unique_ptr<TimestampTraceExporter> m_exporter;
+};
+
+/****** TimestampStageInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+template <typename MessageT>
+struct TimestampStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a TimestampStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param stage_name : Name of the stage whose entry or exit is stamped
+     * @param is_exit : Stamp the exit key of the stage when true, otherwise its entry key
+     * @param sample_interval : Record the timestamps of every `sample_interval`-th message, 0 to only stamp them
+     * @return std::shared_ptr<mrc::segment::Object<TimestampStage<MessageT>>>
+     */
+    static std::shared_ptr<mrc::segment::Object<TimestampStage<MessageT>>> init(mrc::segment::Builder& builder,
+                                                                                const std::string& name,
+                                                                                std::string stage_name,
+                                                                                bool is_exit,
+                                                                                std::size_t sample_interval);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -18,17 +18,29 @@
 #pragma once
 
 #include "morpheus/export.h"
+#include "morpheus/objects/pinned_staging_pool.hpp"
+#include "morpheus/objects/tensor_buffer_pool.hpp"
 #include "morpheus/objects/triton_in_out.hpp"
 #include "morpheus/stages/inference_client_stage.hpp"
 #include "morpheus/types.hpp"
+#include "morpheus/utilities/metrics.hpp"
 
+#include <cuda_runtime.h>  // for cudaEvent_t, cudaIpcMemHandle_t
+#include <grpc_client.h>
 #include <http_client.h>
+#include <mrc/coroutines/scheduler.hpp>
 #include <mrc/coroutines/task.hpp>
+#include <rmm/device_buffer.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 // IWYU pragma: no_include "rxcpp/sources/rx-iterate.hpp"
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -54,14 +66,67 @@ struct MORPHEUS_EXPORT TritonInferInput
     std::string type;
 
     /**
-     * @brief The triton inference input data
+     * @brief The triton inference input data, staged in pinned host memory. Unset when the input is read from a
+     * shared memory region
      */
-    std::vector<uint8_t> data;
+    std::shared_ptr<PinnedStagingBuffer> data;
+
+    /**
+     * @brief Name of the registered CUDA shared memory region holding the input, empty to send `data` in the request
+     */
+    std::string shared_memory_region;
+
+    /**
+     * @brief Offset of the input in the shared memory region, in bytes
+     */
+    std::size_t shared_memory_offset{0};
+
+    /**
+     * @brief Size of the input in the shared memory region, in bytes
+     */
+    std::size_t shared_memory_bytes{0};
 };
 
 struct MORPHEUS_EXPORT TritonInferRequestedOutput
 {
     std::string name;
+
+    /**
+     * @brief Name of the registered CUDA shared memory region Triton writes the output to, empty to return the output
+     * in the response
+     */
+    std::string shared_memory_region;
+
+    /**
+     * @brief Offset of the output in the shared memory region, in bytes
+     */
+    std::size_t shared_memory_offset{0};
+
+    /**
+     * @brief Space reserved for the output in the shared memory region, in bytes
+     */
+    std::size_t shared_memory_bytes{0};
+};
+
+/**
+ * @brief Sends the inputs of each mini-batch as the concatenation of their sequences without their padding, along
+ * with the offset of each sequence, to models accepting ragged batches such as TensorRT models built with the variable
+ * sequence length BERT plugins. The length of each sequence is the length of its longest row across the inputs, not
+ * counting trailing zeros. Disabled when `offsets_input` is empty.
+ */
+struct MORPHEUS_EXPORT TritonRaggedBatching
+{
+    /**
+     * @brief Model input receiving the `num_rows + 1` offsets of the sequences in the concatenated inputs, starting at
+     * zero. Either an INT32 or an INT64 input.
+     */
+    std::string offsets_input;
+
+    /**
+     * @brief Model outputs holding a row per token rather than per sequence, which are padded back into a row per
+     * sequence of `sequence_length` times the width of the output
+     */
+    std::vector<std::string> token_outputs;
 };
 
 class MORPHEUS_EXPORT ITritonClient
@@ -101,6 +166,31 @@ class MORPHEUS_EXPORT ITritonClient
                                               const triton::client::InferOptions& options,
                                               const std::vector<TritonInferInput>& inputs,
                                               const std::vector<TritonInferRequestedOutput>& outputs) = 0;
+
+    /**
+     * @brief Whether inputs and outputs should be exchanged through CUDA shared memory regions registered with
+     * `register_cuda_shared_memory`, rather than sent in the requests and responses
+     */
+    virtual bool uses_cuda_shared_memory() const;
+
+    /**
+     * @brief Registers a CUDA shared memory region with Triton Server, by default shared memory is unsupported
+     */
+    virtual triton::client::Error register_cuda_shared_memory(const std::string& name,
+                                                              const cudaIpcMemHandle_t& handle,
+                                                              std::size_t device_id,
+                                                              std::size_t byte_size);
+
+    /**
+     * @brief Unregisters a CUDA shared memory region from Triton Server, by default shared memory is unsupported
+     */
+    virtual triton::client::Error unregister_cuda_shared_memory(const std::string& name);
+
+    /**
+     * @brief Gets the cumulative inference statistics of the given model as JSON in the format returned by the HTTP
+     * protocol, by default statistics are unsupported
+     */
+    virtual triton::client::Error model_inference_statistics(std::string* statistics, std::string& model_name);
 };
 
 class MORPHEUS_EXPORT HttpTritonClient : public ITritonClient
@@ -109,6 +199,12 @@ class MORPHEUS_EXPORT HttpTritonClient : public ITritonClient
     std::unique_ptr<triton::client::InferenceServerHttpClient> m_client;
 
   public:
+    /**
+     * @brief Construct a new HTTP Triton client. Requests are sent synchronously, `async_infer` completing them before
+     * returning.
+     *
+     * @param server_url : Triton server URL, the default gRPC port of 8001 is retried as the default HTTP port 8000
+     */
     HttpTritonClient(std::string server_url);
 
     /**
@@ -136,6 +232,11 @@ class MORPHEUS_EXPORT HttpTritonClient : public ITritonClient
      */
     triton::client::Error model_metadata(std::string* model_metadata, std::string& model_name) override;
 
+    /**
+     * @brief Gets the inference statistics of the given model using HTTP protocal
+     */
+    triton::client::Error model_inference_statistics(std::string* statistics, std::string& model_name) override;
+
     /**
      * @brief Runs Triton Server inference given the model options, inputs, and outputs, using HTTP protocal
      */
@@ -145,17 +246,214 @@ class MORPHEUS_EXPORT HttpTritonClient : public ITritonClient
                                       const std::vector<TritonInferRequestedOutput>& outputs) override;
 };
 
+class MORPHEUS_EXPORT GrpcTritonClient : public ITritonClient
+{
+  private:
+    std::unique_ptr<triton::client::InferenceServerGrpcClient> m_client;
+    bool m_use_cuda_shared_memory;
+    bool m_use_async_infer;
+
+  public:
+    /**
+     * @brief Construct a new gRPC Triton client
+     *
+     * @param server_url : Triton server URL, the default HTTP port of 8000 is retried as the default gRPC port 8001
+     * @param use_cuda_shared_memory : Exchange inputs and outputs through CUDA shared memory, avoiding all copies
+     * through host memory. Requires Triton to be running on the same machine.
+     * @param use_async_infer : Send requests without blocking, completing them on the client's completion thread.
+     * Required for a session to have more than one request in flight.
+     */
+    GrpcTritonClient(std::string server_url, bool use_cuda_shared_memory = false, bool use_async_infer = false);
+
+    /**
+     * @brief Checks if Triton Server is live using gRPC protocol
+     */
+    triton::client::Error is_server_live(bool* live) override;
+
+    /**
+     * @brief Checks if Triton Server is ready using gRPC protocol
+     */
+    triton::client::Error is_server_ready(bool* ready) override;
+
+    /**
+     * @brief Checks if the given model is ready using gRPC protocol
+     */
+    triton::client::Error is_model_ready(bool* ready, std::string& model_name) override;
+
+    /**
+     * @brief Gets the config for the given model using gRPC protocol, as JSON holding the `max_batch_size`
+     */
+    triton::client::Error model_config(std::string* model_config, std::string& model_name) override;
+
+    /**
+     * @brief Gets metadata for the given model using gRPC protocol, as JSON in the format returned by the HTTP protocol
+     */
+    triton::client::Error model_metadata(std::string* model_metadata, std::string& model_name) override;
+
+    /**
+     * @brief Gets the inference statistics of the given model using gRPC protocol, as JSON in the format returned by
+     * the HTTP protocol
+     */
+    triton::client::Error model_inference_statistics(std::string* statistics, std::string& model_name) override;
+
+    /**
+     * @brief Runs Triton Server inference given the model options, inputs, and outputs, using gRPC protocol
+     */
+    triton::client::Error async_infer(triton::client::InferenceServerHttpClient::OnCompleteFn callback,
+                                      const triton::client::InferOptions& options,
+                                      const std::vector<TritonInferInput>& inputs,
+                                      const std::vector<TritonInferRequestedOutput>& outputs) override;
+
+    bool uses_cuda_shared_memory() const override;
+
+    triton::client::Error register_cuda_shared_memory(const std::string& name,
+                                                      const cudaIpcMemHandle_t& handle,
+                                                      std::size_t device_id,
+                                                      std::size_t byte_size) override;
+
+    triton::client::Error unregister_cuda_shared_memory(const std::string& name) override;
+};
+
+/**
+ * @brief Inputs, outputs and batch size of a model, as parsed from its metadata and config
+ */
+struct MORPHEUS_EXPORT TritonModelInfo
+{
+    TensorIndex max_batch_size = -1;
+    std::vector<TritonInOut> inputs;
+    std::vector<TritonInOut> outputs;
+};
+
 class MORPHEUS_EXPORT TritonInferenceClientSession : public IInferenceClientSession
 {
   private:
+    /**
+     * @brief A device allocation registered with Triton as a CUDA shared memory region, holding the inputs of a single
+     * batch at the offsets given by `offsets`
+     */
+    struct SharedMemoryRegion
+    {
+        SharedMemoryRegion(std::string name, std::size_t bytes);
+        ~SharedMemoryRegion();
+
+        SharedMemoryRegion(const SharedMemoryRegion& other)            = delete;
+        SharedMemoryRegion& operator=(const SharedMemoryRegion& other) = delete;
+
+        std::string name;
+        std::size_t bytes;
+        uint8_t* data{nullptr};
+        cudaEvent_t event{nullptr};  // Recorded once the copies using the region have been enqueued
+        std::map<std::string, std::size_t> offsets;
+    };
+
+    std::shared_ptr<SharedMemoryRegion> acquire_shared_memory_region();
+    void release_shared_memory_region(std::unique_ptr<SharedMemoryRegion>&& region);
+
+    /**
+     * @brief A full output buffer registered with Triton as a CUDA shared memory region, allowing Triton to write the
+     * outputs of each batch directly into their rows of the buffer. Registrations outlive the inferences using them
+     * and are reused whenever the output pool hands out the same buffer.
+     */
+    struct OutputRegistration
+    {
+        std::string name;
+        const uint8_t* data;
+        cudaIpcMemHandle_t handle;  // Distinguishes a new allocation at the address of a freed buffer
+        std::size_t num_users{0};
+    };
+
+    std::shared_ptr<OutputRegistration> acquire_output_registration(const rmm::device_buffer& buffer);
+    void release_output_registration(OutputRegistration* registration);
+    void unregister_output(const std::string& name);
+
+    /**
+     * @brief Infers rows `start` to `stop` of `inputs`, copying the results into the same rows of `outputs`. When
+     * `output_registrations` is given Triton writes the results into the registered `outputs` itself. Returns the
+     * staging buffers of the copies to the device which may still be in flight. The response is handled on `on`. When
+     * `row_lengths` is not empty the rows are sent as a ragged batch of sequences of those lengths.
+     *
+     * The duration of each phase is recorded: staging the inputs, the request itself covering the network and
+     * Triton, waiting for `on` to resume the batch, and staging the outputs for their copy to the device.
+     */
+    mrc::coroutines::Task<std::vector<std::shared_ptr<PinnedStagingBuffer>>> infer_batch(
+        TensorMap& inputs,
+        TensorMap& outputs,
+        const std::map<std::string, std::shared_ptr<OutputRegistration>>& output_registrations,
+        const std::vector<TensorIndex>& row_lengths,
+        TensorIndex start,
+        TensorIndex stop,
+        std::shared_ptr<mrc::coroutines::Scheduler> on);
+
+    /**
+     * @brief Returns the number of tokens of each row of `inputs`, see `TritonRaggedBatching`
+     */
+    static std::vector<TensorIndex> ragged_row_lengths(const TensorMap& inputs, TensorIndex num_rows);
+
     std::string m_model_name;
+    std::shared_ptr<const TritonModelInfo> m_model_info;
     TensorIndex m_max_batch_size = -1;
+    std::size_t m_max_concurrent_batches;
     std::vector<TritonInOut> m_model_inputs;
     std::vector<TritonInOut> m_model_outputs;
     std::shared_ptr<ITritonClient> m_client;
+    TritonRaggedBatching m_ragged_batching;
+
+    // Full output buffers are returned to the pool once the tensors holding them are destroyed. With shared memory
+    // each buffer is a separate allocation, allowing it to be registered with Triton.
+    std::shared_ptr<TensorBufferPool> m_output_pool{TensorBufferPool::create()};
+
+    // Shared memory regions are only registered when the client uses shared memory, one per concurrent inference
+    std::mutex m_region_mutex;
+    std::vector<std::unique_ptr<SharedMemoryRegion>> m_idle_regions;
+    std::size_t m_num_regions{0};
+    std::map<const uint8_t*, OutputRegistration> m_output_registrations;
+    std::size_t m_num_output_registrations{0};
+
+    /**
+     * @brief Reports the server side durations of the model's inferences, at most once per `StatisticsUpdateInterval`
+     * across the coroutines sharing the session.
+     */
+    void update_server_statistics();
+
+    static constexpr std::chrono::seconds StatisticsUpdateInterval{10};
+
+    std::mutex m_statistics_mutex;
+    std::chrono::steady_clock::time_point m_next_statistics_update{};
+
+    // Durations of the phases of each mini-batch, see `infer_batch`
+    std::shared_ptr<Histogram> m_stage_inputs_seconds;
+    std::shared_ptr<Histogram> m_request_seconds;
+    std::shared_ptr<Histogram> m_resume_seconds;
+    std::shared_ptr<Histogram> m_copy_outputs_seconds;
+
+    // Cumulative totals reported by Triton, keyed by the phase of the server
+    std::map<std::string, std::shared_ptr<Gauge>> m_server_seconds;
+    std::shared_ptr<Gauge> m_server_inferences;
 
   public:
-    TritonInferenceClientSession(std::shared_ptr<ITritonClient> client, std::string model_name);
+    /**
+     * @brief Construct a new Triton Inference Client Session
+     *
+     * @param client : Triton client shared by the sessions of a TritonInferenceClient
+     * @param model_name : Name of the model to infer with
+     * @param max_concurrent_batches : Maximum number of mini-batches of a single message in flight at once, the
+     * client must send requests asynchronously for batches to overlap
+     * @param model_info : Model info cached by a previous session, when null it is queried from the server
+     * @param ragged_batching : Sends the inputs without their padding when its `offsets_input` is set
+     * @throws std::invalid_argument If the `offsets_input` of `ragged_batching` is not an input of the model, or
+     * ragged batches are sent with CUDA shared memory
+     */
+    TritonInferenceClientSession(std::shared_ptr<ITritonClient> client,
+                                 std::string model_name,
+                                 std::size_t max_concurrent_batches                = 1,
+                                 std::shared_ptr<const TritonModelInfo> model_info = nullptr,
+                                 TritonRaggedBatching ragged_batching              = {});
+    ~TritonInferenceClientSession() override;
+
+    /**
+      @brief Gets the model info used by the session, allowing it to be shared with later sessions
+    */
+    std::shared_ptr<const TritonModelInfo> get_model_info() const;
 
     /**
       @brief Gets the inference input mappings for Triton
@@ -168,22 +466,60 @@ class MORPHEUS_EXPORT TritonInferenceClientSession : public IInferenceClientSess
     std::vector<TensorModelMapping> get_output_mappings(std::vector<TensorModelMapping> output_map_overrides) override;
 
     /**
-      @brief Invokes a single tensor inference using the constructor-provided ITritonClient
+      @brief Invokes a single tensor inference using the constructor-provided ITritonClient. Responses are handled on
+      `on` rather than on the thread of the client delivering them, keeping the copies of the outputs off the client's
+      callback thread.
     */
-    mrc::coroutines::Task<TensorMap> infer(TensorMap&& inputs) override;
+    mrc::coroutines::Task<TensorMap> infer(TensorMap&& inputs, std::shared_ptr<mrc::coroutines::Scheduler> on) override;
 };
 
 class MORPHEUS_EXPORT TritonInferenceClient : public IInferenceClient
 {
+  public:
+    using client_factory_t = std::function<std::unique_ptr<ITritonClient>()>;
+
   private:
     std::shared_ptr<ITritonClient> m_client;
+    client_factory_t m_client_factory;  // When set each session connects with a client of its own
     std::string m_model_name;
+    std::size_t m_max_concurrent_batches;
+    TritonRaggedBatching m_ragged_batching;
+
+    // Queried by the first session to connect and reused by every later session, including those replacing a session
+    // which failed
+    std::mutex m_model_info_mutex;
+    std::shared_ptr<const TritonModelInfo> m_model_info;
 
   public:
-    TritonInferenceClient(std::unique_ptr<ITritonClient>&& client, std::string model_name);
+    /**
+     * @brief Construct a new Triton Inference Client
+     *
+     * @param client : Triton client used by every session
+     * @param model_name : Name of the model to infer with
+     * @param max_concurrent_batches : Maximum number of mini-batches of a single message in flight at once
+     * @param ragged_batching : Sends the inputs without their padding when its `offsets_input` is set
+     */
+    TritonInferenceClient(std::unique_ptr<ITritonClient>&& client,
+                          std::string model_name,
+                          std::size_t max_concurrent_batches   = 1,
+                          TritonRaggedBatching ragged_batching = {});
+
+    /**
+     * @brief Construct a new Triton Inference Client, connecting each session with a new client from
+     * `client_factory`. Sessions used at the same time then never contend for a single connection.
+     *
+     * @param client_factory : Creates the Triton client of each session
+     * @param model_name : Name of the model to infer with
+     * @param max_concurrent_batches : Maximum number of mini-batches of a single message in flight at once
+     * @param ragged_batching : Sends the inputs without their padding when its `offsets_input` is set
+     */
+    TritonInferenceClient(client_factory_t client_factory,
+                          std::string model_name,
+                          std::size_t max_concurrent_batches   = 1,
+                          TritonRaggedBatching ragged_batching = {});
 
     /**
-      @brief Creates a TritonInferenceClientSession
+      @brief Creates a TritonInferenceClientSession, reusing the model info of previous sessions
     */
     std::unique_ptr<IInferenceClientSession> create_session() override;
 };
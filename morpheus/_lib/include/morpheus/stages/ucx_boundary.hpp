@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/io/ucx_transport.hpp"
+#include "morpheus/messages/control.hpp"
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>   // for milliseconds
+#include <cstdint>  // for uint16_t
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** UcxEgressStage**************************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Egress of a pipeline segment spanning two nodes, forwarding each `ControlMessage` to the `UcxIngressStage` of
+ * the other node over a `UcxConnection`, then passing it through. Only a compact header, holding the config of the
+ * message along with the names and layout of its columns and tensors, is serialized. The device buffers of the columns
+ * of the payload, packed into a single contiguous buffer, and of the tensors are sent as they are, GPU to GPU when
+ * GPUDirect RDMA is available.
+ *
+ * The connection is made on the first message, or on completion when there was none, such that the ingress is always
+ * told the stream ended.
+ */
+class UcxEgressStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Ucx Egress Stage object
+     *
+     * @param address : Address of the node running the ingress
+     * @param port : Port the ingress listens on
+     * @param connect_timeout : Time to wait for the ingress to listen
+     */
+    UcxEgressStage(std::string address, uint16_t port, std::chrono::milliseconds connect_timeout);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    UcxConnection& connection();
+
+    void send(ControlMessage& message);
+
+    std::string m_address;
+    uint16_t m_port;
+    std::chrono::milliseconds m_connect_timeout;
+
+    std::unique_ptr<UcxConnection> m_connection;
+};
+
+/****** UcxIngressStage*************************************/
+/**
+ * @brief Ingress of a pipeline segment spanning two nodes, emitting the messages sent by the `UcxEgressStage` of the
+ * other node. The columns and tensors are received straight into device memory.
+ */
+class UcxIngressStage : public mrc::pymrc::PythonSource<std::shared_ptr<ControlMessage>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonSource<std::shared_ptr<ControlMessage>>;
+    using typename base_t::source_type_t;
+    using typename base_t::subscriber_fn_t;
+
+    /**
+     * @brief Construct a new Ucx Ingress Stage object
+     *
+     * @param bind_address : Address to listen on for the egress, an empty address listening on every interface
+     * @param port : Port to listen on
+     */
+    UcxIngressStage(std::string bind_address, uint16_t port);
+
+  private:
+    subscriber_fn_t build();
+
+    /**
+     * @brief Receives the next message
+     *
+     * @return std::shared_ptr<ControlMessage> : nullptr once the egress completed or the stage was stopped
+     */
+    std::shared_ptr<ControlMessage> receive(UcxConnection& connection, const UcxConnection::stop_fn_t& should_stop);
+
+    std::string m_bind_address;
+    uint16_t m_port;
+};
+
+/****** UcxEgressStageInterfaceProxy************************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct UcxEgressStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a UcxEgressStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param address : Address of the node running the ingress
+     * @param port : Port the ingress listens on
+     * @param connect_timeout_ms : Time to wait for the ingress to listen, in milliseconds
+     * @return std::shared_ptr<mrc::segment::Object<UcxEgressStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<UcxEgressStage>> init(mrc::segment::Builder& builder,
+                                                                       const std::string& name,
+                                                                       std::string address,
+                                                                       uint16_t port,
+                                                                       int64_t connect_timeout_ms);
+};
+
+/****** UcxIngressStageInterfaceProxy***********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct UcxIngressStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a UcxIngressStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param bind_address : Address to listen on for the egress, an empty address listening on every interface
+     * @param port : Port to listen on
+     * @return std::shared_ptr<mrc::segment::Object<UcxIngressStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<UcxIngressStage>> init(mrc::segment::Builder& builder,
+                                                                        const std::string& name,
+                                                                        std::string bind_address,
+                                                                        uint16_t port);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,230 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/objects/table_info.hpp"
+#include "morpheus/utilities/metrics.hpp"
+
+#include <cudf/aggregation.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>  // for size_type
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>   // for nanoseconds
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** WindowAggregator ***********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Device resident aggregates of the rows of each key over event time windows of `window` nanoseconds, starting
+ * every `slide` nanoseconds, windows being tumbling when both are equal. Each row is counted in the `window / slide`
+ * windows which hold its timestamp.
+ *
+ * The partial aggregates of every open (key, window) are held in a single device table. Each batch is aggregated by a
+ * `cudf::groupby`, then merged into that table by a second one, such that the state grows with the number of open
+ * windows rather than with the number of rows.
+ *
+ * Windows close once the watermark, the newest timestamp seen less `allowed_lateness`, passes their end. Rows which
+ * only belong to closed windows are late, and dropped. Rows with a null key are ignored.
+ *
+ * Supported aggregations are `count` (of the valid values), `sum`, `min`, `max` and `mean`, each output as a column
+ * named `<column>_<aggregation>`, along with the `window_start` and `window_end` of each window and its number of rows
+ * as `count`.
+ */
+class WindowAggregator
+{
+  public:
+    /**
+     * @brief Construct a new Window Aggregator
+     *
+     * @param key_columns : Columns identifying the keys
+     * @param timestamp_column : Column holding the event time of the rows, of a timestamp type without nulls
+     * @param aggregations : Aggregations of each column, such as `{"bytes": {"sum", "max"}}`
+     * @param window : Duration of the windows
+     * @param slide : Duration between the starts of two windows, which must divide `window`
+     * @param allowed_lateness : Duration the watermark trails the newest timestamp seen
+     * @throws std::invalid_argument If `key_columns` is empty, an aggregation is unsupported, `window` or `slide` is
+     * not positive or `slide` does not divide `window`, or `allowed_lateness` is negative
+     */
+    WindowAggregator(std::vector<std::string> key_columns,
+                     std::string timestamp_column,
+                     const std::map<std::string, std::vector<std::string>>& aggregations,
+                     std::chrono::nanoseconds window,
+                     std::chrono::nanoseconds slide,
+                     std::chrono::nanoseconds allowed_lateness);
+
+    /**
+     * @brief Adds the rows of `table` to the aggregates of their windows, then advances the watermark
+     *
+     * @param table
+     * @return cudf::size_type : Number of late rows dropped
+     * @throws std::invalid_argument If a column is missing from `table`, or the timestamps hold nulls
+     */
+    cudf::size_type update(const TableInfo& table);
+
+    /**
+     * @brief Removes the windows closed by the watermark, or every window when `flush` is set
+     *
+     * @param flush
+     * @return std::shared_ptr<MessageMeta> : The aggregates of the windows, ordered by window then key. Null when no
+     * window was closed
+     */
+    std::shared_ptr<MessageMeta> take_closed(bool flush = false);
+
+    /**
+     * @brief Number of (key, window) aggregates currently held
+     */
+    cudf::size_type num_open() const;
+
+    /**
+     * @brief Current watermark in nanoseconds, empty until a row was seen
+     */
+    std::optional<int64_t> watermark() const;
+
+  private:
+    struct Partial
+    {
+        std::string column;
+        cudf::aggregation::Kind kind;
+    };
+
+    struct Output
+    {
+        std::string name;
+        std::string aggregation;
+        std::size_t partial;
+        std::size_t count_partial;  // Only used by `mean`
+    };
+
+    // Index of the partial aggregate `kind` of `column`, added when not yet computed
+    std::size_t add_partial(const std::string& column, cudf::aggregation::Kind kind);
+
+    // Groups `table`, holding the key columns, the window start and the partial inputs, into partial aggregates
+    std::unique_ptr<cudf::table> aggregate(const cudf::table_view& table, bool merge) const;
+
+    std::vector<std::string> m_key_columns;
+    std::string m_timestamp_column;
+    int64_t m_window;
+    int64_t m_slide;
+    int64_t m_allowed_lateness;
+
+    std::vector<Partial> m_partials;
+    std::vector<Output> m_outputs;
+
+    // The key columns, the window start, the number of rows, then the partial aggregates
+    std::unique_ptr<cudf::table> m_state;
+    std::optional<int64_t> m_watermark;
+};
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Aggregates the rows of the payload of each `ControlMessage` per key over event time windows, such as the
+ * failed logins of each user per minute or the bytes sent by each host over 5 minutes, see `WindowAggregator`. Each
+ * time windows close, their aggregates are emitted as a `MessageMeta`. Every window still open is emitted once the
+ * input completes.
+ *
+ * The number of late rows dropped and the number of open windows are reported to the `MetricsRegistry`.
+ */
+class WindowAggregateStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<ControlMessage>, std::shared_ptr<MessageMeta>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Window Aggregate Stage object
+     *
+     * @param key_columns : Columns identifying the keys
+     * @param timestamp_column : Column holding the event time of the rows
+     * @param aggregations : Aggregations of each column
+     * @param window : Duration of the windows
+     * @param slide : Duration between the starts of two windows, equal to `window` for tumbling windows
+     * @param allowed_lateness : Duration the watermark trails the newest timestamp seen
+     * @param metrics_name : Labels the metrics of the stage
+     */
+    WindowAggregateStage(std::vector<std::string> key_columns,
+                         std::string timestamp_column,
+                         const std::map<std::string, std::vector<std::string>>& aggregations,
+                         std::chrono::nanoseconds window,
+                         std::chrono::nanoseconds slide,
+                         std::chrono::nanoseconds allowed_lateness,
+                         const std::string& metrics_name);
+
+  private:
+    subscribe_fn_t build_operator();
+
+    WindowAggregator m_aggregator;
+
+    std::shared_ptr<Counter> m_late_rows;
+    std::shared_ptr<Gauge> m_open_windows;
+};
+
+/****** WindowAggregateStageInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct WindowAggregateStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a WindowAggregateStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param key_columns : Columns identifying the keys
+     * @param timestamp_column : Column holding the event time of the rows
+     * @param aggregations : Aggregations of each column
+     * @param window_ns : Duration of the windows in nanoseconds
+     * @param slide_ns : Duration between the starts of two windows in nanoseconds, `window_ns` when 0
+     * @param allowed_lateness_ns : Duration in nanoseconds the watermark trails the newest timestamp seen
+     * @return std::shared_ptr<mrc::segment::Object<WindowAggregateStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<WindowAggregateStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::vector<std::string> key_columns,
+        std::string timestamp_column,
+        const std::map<std::string, std::vector<std::string>>& aggregations,
+        int64_t window_ns,
+        int64_t slide_ns,
+        int64_t allowed_lateness_ns);
+};
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
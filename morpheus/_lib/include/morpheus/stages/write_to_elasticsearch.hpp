@@ -0,0 +1,190 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"
+
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <chrono>
+#include <cstddef>  // for size_t
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** WriteToElasticsearchStage********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+/**
+ * @brief The body of a `_bulk` request, an action line followed by a document per item, along with the position of
+ * each item so that a request holding a subset of the items can be built for a partial retry.
+ */
+struct ElasticsearchBulkRequest
+{
+    std::string body;
+    std::vector<std::size_t> offsets;  // Start of each item in `body`, followed by the size of `body`
+
+    std::size_t num_items() const;
+
+    /**
+     * @brief Builds a request holding the items at the `items` positions of this request, in order.
+     */
+    ElasticsearchBulkRequest subset(const std::vector<std::size_t>& items) const;
+};
+
+/**
+ * @brief Outcome of a `_bulk` request, as reported per item by Elasticsearch.
+ */
+struct ElasticsearchBulkResult
+{
+    std::vector<std::size_t> retry_items;  // Positions of the items rejected with 429 or 503, worth retrying
+    std::size_t num_failed{0};             // Items rejected for any other reason, such as a mapping error
+    std::string first_error;               // Reason given for the first failed item
+};
+
+/**
+ * @brief Splits the JSON lines of `json_lines`, one document per line, into `_bulk` request bodies prefixing each
+ * document with `action_line`. A request holds at most `max_docs` documents and `max_bytes` bytes, save for a single
+ * document larger than `max_bytes` which is sent on its own.
+ */
+std::vector<ElasticsearchBulkRequest> make_bulk_requests(const std::string& json_lines,
+                                                         const std::string& action_line,
+                                                         std::size_t max_bytes,
+                                                         std::size_t max_docs);
+
+/**
+ * @brief Parses the response to a `_bulk` request of `num_items` items. Throws if the response is not a valid bulk
+ * response for that many items.
+ */
+ElasticsearchBulkResult parse_bulk_response(const std::string& response_body, std::size_t num_items);
+
+/**
+ * @brief Write all messages as documents to an Elasticsearch index. Each `MessageMeta` is serialized to JSON lines on
+ * the GPU and split into `_bulk` requests bounded by `max_bulk_bytes` and `max_bulk_docs`, which are sent concurrently
+ * over up to `max_concurrent_requests` pooled connections.
+ *
+ * Requests rejected as a whole with 429 Too Many Requests are retried, as are the items of a request which were
+ * individually rejected with 429 or 503, only those items being sent again. Retries back off exponentially from
+ * `retry_interval`. Items which are rejected for any other reason, or are still rejected after `max_retries` attempts,
+ * are logged, and reported as an error when `raise_on_exception` is set.
+ */
+class WriteToElasticsearchStage
+  : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Write To Elasticsearch Stage object
+     *
+     * @param host : Host name or address of the Elasticsearch node
+     * @param port : HTTP port of the Elasticsearch node
+     * @param index : Index to write the documents to
+     * @param headers : Headers to include in each request, such as `Authorization`
+     * @param max_bulk_bytes : Maximum size of the body of a single `_bulk` request
+     * @param max_bulk_docs : Maximum number of documents in a single `_bulk` request
+     * @param max_concurrent_requests : Number of requests in flight at once, and of pooled connections
+     * @param max_retries : Maximum number of attempts for each document
+     * @param retry_interval : Delay before the first retry, doubling on each attempt
+     * @param raise_on_exception : If true, documents which could not be written are reported as an error rather than
+     * only being logged
+     */
+    WriteToElasticsearchStage(std::string host,
+                              unsigned short port,
+                              std::string index,
+                              std::map<std::string, std::string> headers = {},
+                              std::size_t max_bulk_bytes                 = 5 << 20,
+                              std::size_t max_bulk_docs                  = 5000,
+                              std::size_t max_concurrent_requests        = 8,
+                              std::size_t max_retries                    = 5,
+                              std::chrono::milliseconds retry_interval   = std::chrono::milliseconds(500),
+                              bool raise_on_exception                    = false);
+
+    ~WriteToElasticsearchStage() override = default;
+
+  private:
+    subscribe_fn_t build_operator();
+
+    std::string m_host;
+    std::string m_port;
+    std::string m_target;
+    std::map<std::string, std::string> m_headers;
+    std::size_t m_max_bulk_bytes;
+    std::size_t m_max_bulk_docs;
+    std::size_t m_max_concurrent_requests;
+    std::size_t m_max_retries;
+    std::chrono::milliseconds m_retry_interval;
+    bool m_raise_on_exception;
+};
+
+/****** WriteToElasticsearchStageInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct WriteToElasticsearchStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a WriteToElasticsearchStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param host : Host name or address of the Elasticsearch node
+     * @param port : HTTP port of the Elasticsearch node
+     * @param index : Index to write the documents to
+     * @param headers : Headers to include in each request
+     * @param max_bulk_bytes : Maximum size of the body of a single `_bulk` request
+     * @param max_bulk_docs : Maximum number of documents in a single `_bulk` request
+     * @param max_concurrent_requests : Number of requests in flight at once
+     * @param max_retries : Maximum number of attempts for each document
+     * @param retry_interval : Delay in seconds before the first retry
+     * @param raise_on_exception : If true, documents which could not be written are reported as an error
+     * @return std::shared_ptr<mrc::segment::Object<WriteToElasticsearchStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<WriteToElasticsearchStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::string host,
+        unsigned short port,
+        std::string index,
+        std::map<std::string, std::string> headers,
+        std::size_t max_bulk_bytes,
+        std::size_t max_bulk_docs,
+        std::size_t max_concurrent_requests,
+        std::size_t max_retries,
+        float retry_interval,
+        bool raise_on_exception);
+};
+
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
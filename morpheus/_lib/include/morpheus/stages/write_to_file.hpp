@@ -17,20 +17,32 @@
 
 #pragma once
 
+#include "morpheus/io/async_file_writer.hpp"  // for AsyncFileWriter
+#include "morpheus/io/serializers.hpp"        // for ChunkedParquetWriter
+#include "morpheus/messages/control.hpp"
 #include "morpheus/messages/meta.hpp"
 #include "morpheus/objects/file_types.hpp"
+#include "morpheus/objects/table_info.hpp"  // for TableInfo
 
 #include <boost/fiber/context.hpp>
+#include <cudf/io/data_sink.hpp>  // for data_sink
 #include <mrc/segment/builder.hpp>
 #include <mrc/segment/object.hpp>
 #include <pymrc/node.hpp>
 #include <rxcpp/rx.hpp>
 
+#include <atomic>
+#include <chrono>      // for seconds, steady_clock
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t
+#include <filesystem>  // for path
 #include <fstream>
 #include <functional>  // for function
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace morpheus {
 /****** Component public implementations *******************/
@@ -45,12 +57,34 @@ namespace morpheus {
 #pragma GCC visibility push(default)
 /**
  * @brief Write all messages to a file. Messages are written to a file by this class.
- * This class does not maintain an open file or buffer messages.
+ * This class does not buffer messages.
+ *
+ * Parquet files are written by a single chunked writer, each message being appended as one or more row groups and the
+ * footer written once the stream completes. When `max_file_bytes` or `max_file_age` are set, the file is closed and a
+ * new one started before writing the next message once either limit is reached. The n-th file after the first is
+ * named by inserting `.n` before the extension of `filename`, such that `out.parquet` is followed by `out.1.parquet`.
+ *
+ * CSV and JSON messages are serialized to host buffers on the pipeline thread. When `max_queued_writes` is greater than
+ * zero or the output is gzip compressed, the buffers are handed to an `AsyncFileWriter` such that writing and
+ * compressing them does not hold up the pipeline. Gzip compressed files have `.gz` appended to their name.
+ *
+ * When `device_write` is set, files are written through a cudf file sink rather than an output stream, allowing cudf
+ * to write large device buffers straight to disk using GPUDirect Storage instead of first copying them to host memory.
+ *
+ * When `num_shards` is greater than one, the output is split across that many files, each with its own writer, the
+ * i-th one being named by inserting `.shard-i` before the extension of `filename`. Shards are rotated independently.
+ * When `shard_column` is set the rows of each message are hash partitioned on that column, such that equal values
+ * always end up in the same shard. Otherwise each message is written whole to the first shard not being written to by
+ * another thread, allowing as many pipeline threads as there are shards to write concurrently. In both cases the order
+ * of the messages is only preserved within a shard.
+ *
+ * @tparam InputT Either `MessageMeta` or `ControlMessage`, in which case the payload of each message is written
  */
-class WriteToFileStage : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>
+template <typename InputT>
+class WriteToFileStage : public mrc::pymrc::PythonNode<std::shared_ptr<InputT>, std::shared_ptr<InputT>>
 {
   public:
-    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<InputT>, std::shared_ptr<InputT>>;
     using typename base_t::sink_type_t;
     using typename base_t::source_type_t;
     using typename base_t::subscribe_fn_t;
@@ -63,49 +97,157 @@ class WriteToFileStage : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMe
      * @param file_type : FileTypes
      * @param include_index_col : Write out the index as a column, by default true
      * @param flush : When `true` flush the output buffer to disk on each message.
+     * @param compression : One of "none", "snappy" or "zstd" for Parquet files and "none" or "gzip" for CSV and JSON
+     * files. Empty uses "snappy" for Parquet files and "none" otherwise.
+     * @param row_group_size_rows : Maximum number of rows of a Parquet row group, zero uses the cudf default.
+     * @param max_file_bytes : When greater than zero, files are rotated once they reach this size, before compression
+     * for CSV and JSON files.
+     * @param max_file_age : When greater than zero, files are rotated once they have been open for this long.
+     * @param max_queued_writes : Maximum number of CSV or JSON buffers waiting to be written by the I/O thread, zero
+     * writes on the pipeline thread.
+     * @param device_write : Write files through a cudf file sink, see `create_file_sink`. Not supported along with
+     * appending, gzip compression or `max_queued_writes`.
+     * @param num_shards : Number of files the output is split across, must be at least one.
+     * @param shard_column : Column whose hash selects the shard of each row, empty writes each message whole.
      */
     WriteToFileStage(const std::string& filename,
-                     std::ios::openmode mode = std::ios::out,
-                     FileTypes file_type     = FileTypes::Auto,
-                     bool include_index_col  = true,
-                     bool flush              = false);
+                     std::ios::openmode mode           = std::ios::out,
+                     FileTypes file_type               = FileTypes::Auto,
+                     bool include_index_col            = true,
+                     bool flush                        = false,
+                     const std::string& compression    = "",
+                     std::size_t row_group_size_rows   = 0,
+                     std::size_t max_file_bytes        = 0,
+                     std::chrono::seconds max_file_age = std::chrono::seconds(0),
+                     std::size_t max_queued_writes     = 0,
+                     bool device_write                 = false,
+                     std::size_t num_shards            = 1,
+                     const std::string& shard_column   = "");
 
   private:
     /**
-     * @brief Close the file
+     * @brief The file currently being written to by one shard along with its writers. Only one thread writes to a
+     * shard at a time, holding `mutex`.
+     */
+    struct Shard
+    {
+        std::mutex mutex;
+        std::filesystem::path filename;
+        bool is_first{true};
+        std::ofstream fstream;
+        std::size_t file_index{0};
+        std::chrono::steady_clock::time_point file_opened;
+
+        // Only set when writing Parquet files
+        std::unique_ptr<ChunkedParquetWriter> parquet_writer;
+
+        // Only set when writing CSV or JSON files asynchronously or compressed
+        std::unique_ptr<AsyncFileWriter> file_writer;
+
+        // Only set when writing CSV or JSON files through a cudf file sink
+        std::unique_ptr<cudf::io::data_sink> sink;
+    };
+
+    /**
+     * @brief Close every shard
      */
     void close();
 
+    /**
+     * @brief Writes `tbl` to the shards, the calling thread must not hold any of the shard locks
+     *
+     * @param tbl
+     */
+    void write(const TableInfo& tbl);
+
+    /**
+     * @brief Writes `tbl` to `shard`, rotating it beforehand if needed. The calling thread must hold `shard.mutex`.
+     *
+     * @param shard
+     * @param tbl
+     */
+    void write_shard(Shard& shard, const TableInfo& tbl);
+
     /**
      * @brief Write messages (rows in a DataFrame) to a JSON format
      *
-     * @param msg
+     * @param shard
+     * @param tbl
      */
-    void write_json(sink_type_t& msg);
+    void write_json(Shard& shard, const TableInfo& tbl);
 
     /**
      * @brief Write messages (rows in a DataFrame) to a CSV format
      *
-     * @param msg
+     * @param shard
+     * @param tbl
      */
-    void write_csv(sink_type_t& msg);
+    void write_csv(Shard& shard, const TableInfo& tbl);
 
     /**
      * @brief Write messages (rows in a DataFrame) to a Parquet format
      *
-     * @param msg
+     * @param shard
+     * @param tbl
+     */
+    void write_parquet(Shard& shard, const TableInfo& tbl);
+
+    /**
+     * @brief Closes the current file of `shard` and opens the next one once one of the rotation limits has been
+     * reached. Rotating before a write rather than after one avoids leaving an empty file behind once the stream
+     * completes.
+     */
+    void rotate_if_needed(Shard& shard);
+
+    /**
+     * @brief Number of bytes written to the current file of `shard`
      */
-    void write_parquet(sink_type_t& msg);
+    std::size_t file_bytes(Shard& shard);
+
+    /**
+     * @brief Opens the `file_index`-th file of `shard`, along with the Parquet writer over it when writing Parquet
+     * files
+     */
+    void open_file(Shard& shard);
+
+    /**
+     * @brief Closes the current file of `shard`, leaving its `file_writer` running
+     */
+    void close_file(Shard& shard);
+
+    /**
+     * @brief Inserts `.suffix` before the extension of `path`, keeping the `.gz` suffix of compressed files last
+     */
+    std::filesystem::path insert_suffix(const std::filesystem::path& path, const std::string& suffix) const;
 
     subscribe_fn_t build_operator();
 
-    bool m_is_first{};
+    std::filesystem::path m_filename;
+    std::ios::openmode m_mode;
+    FileTypes m_file_type;
     bool m_include_index_col;
     bool m_flush;
-    std::ofstream m_fstream;
-    std::function<void(sink_type_t&)> m_write_func;
+    std::function<void(Shard&, const TableInfo&)> m_write_func;
+
+    std::string m_compression;
+    bool m_gzip{false};
+    std::size_t m_max_file_bytes;
+    std::chrono::seconds m_max_file_age;
+    std::size_t m_row_group_size_rows;
+    std::size_t m_max_queued_writes;
+    bool m_device_write;
+
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::string m_shard_column;
+    std::atomic<std::size_t> m_next_shard{0};
+
+    // Number of subscriptions still running, the shards are closed by the last one to complete
+    std::atomic<std::size_t> m_active_subscriptions{0};
 };
 
+using WriteToFileStageMeta = WriteToFileStage<MessageMeta>;     // NOLINT(readability-identifier-naming)
+using WriteToFileStageCM   = WriteToFileStage<ControlMessage>;  // NOLINT(readability-identifier-naming)
+
 /****** WriteToFileStageInterfaceProxy******************/
 /**
  * @brief Interface proxy, used to insulate python bindings.
@@ -113,7 +255,7 @@ class WriteToFileStage : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMe
 struct WriteToFileStageInterfaceProxy
 {
     /**
-     * @brief Create and initialize a WriteToFileStage, and return the result
+     * @brief Create and initialize a WriteToFileStage receiving `MessageMeta`, and return the result
      *
      * @param builder : Pipeline context object reference
      * @param name : Name of a stage reference
@@ -122,15 +264,57 @@ struct WriteToFileStageInterfaceProxy
      * @param file_type : FileTypes
      * @param include_index_col : Write out the index as a column, by default true
      * @param flush : When `true` flush the output buffer to disk on each message.
-     * @return std::shared_ptr<mrc::segment::Object<WriteToFileStage>>
+     * @param compression : One of "none", "snappy" or "zstd" for Parquet files and "none" or "gzip" for CSV and JSON
+     * files. Empty uses "snappy" for Parquet files and "none" otherwise.
+     * @param row_group_size_rows : Maximum number of rows of a Parquet row group, zero uses the cudf default.
+     * @param max_file_bytes : When greater than zero, files are rotated once they reach this size.
+     * @param max_file_age_secs : When greater than zero, files are rotated once open for this many seconds.
+     * @param max_queued_writes : Maximum number of CSV or JSON buffers waiting to be written, zero writes them
+     * synchronously.
+     * @param device_write : Write files through a cudf file sink, see `create_file_sink`.
+     * @param num_shards : Number of files the output is split across.
+     * @param shard_column : Column whose hash selects the shard of each row, empty writes each message whole.
+     * @return std::shared_ptr<mrc::segment::Object<WriteToFileStageMeta>>
+     */
+    static std::shared_ptr<mrc::segment::Object<WriteToFileStageMeta>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        const std::string& filename,
+        const std::string& mode         = "w",
+        FileTypes file_type             = FileTypes::Auto,
+        bool include_index_col          = true,
+        bool flush                      = false,
+        const std::string& compression  = "",
+        std::size_t row_group_size_rows = 0,
+        std::size_t max_file_bytes      = 0,
+        int64_t max_file_age_secs       = 0,
+        std::size_t max_queued_writes   = 0,
+        bool device_write               = false,
+        std::size_t num_shards          = 1,
+        const std::string& shard_column = "");
+
+    /**
+     * @brief Create and initialize a WriteToFileStage receiving `ControlMessage`, and return the result. See `init`
+     * for the parameters.
+     *
+     * @return std::shared_ptr<mrc::segment::Object<WriteToFileStageCM>>
      */
-    static std::shared_ptr<mrc::segment::Object<WriteToFileStage>> init(mrc::segment::Builder& builder,
-                                                                        const std::string& name,
-                                                                        const std::string& filename,
-                                                                        const std::string& mode = "w",
-                                                                        FileTypes file_type     = FileTypes::Auto,
-                                                                        bool include_index_col  = true,
-                                                                        bool flush              = false);
+    static std::shared_ptr<mrc::segment::Object<WriteToFileStageCM>> init_cm(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        const std::string& filename,
+        const std::string& mode         = "w",
+        FileTypes file_type             = FileTypes::Auto,
+        bool include_index_col          = true,
+        bool flush                      = false,
+        const std::string& compression  = "",
+        std::size_t row_group_size_rows = 0,
+        std::size_t max_file_bytes      = 0,
+        int64_t max_file_age_secs       = 0,
+        std::size_t max_queued_writes   = 0,
+        bool device_write               = false,
+        std::size_t num_shards          = 1,
+        const std::string& shard_column = "");
 };
 
 #pragma GCC visibility pop
@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/utilities/kafka_transactions.hpp"
+
+#include <librdkafka/rdkafkacpp.h>
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <pymrc/node.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** WriteToKafkaStage********************************/
+
+/**
+ * @addtogroup stages
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+/**
+ * @brief Write all messages to a Kafka topic. Each `MessageMeta` is serialized to JSON lines on the GPU and every row
+ * is produced as a separate Kafka message directly out of the serialized buffer without copying. Batching, linger and
+ * compression are left to librdkafka while delivery reports are served by a background thread.
+ *
+ * When `consumer_group_id` is set the rows are produced in transactions which also commit the offsets consumed by the
+ * `KafkaSourceStage` of that consumer group, see `KafkaTransactionCoordinator`, such that every consumed message has
+ * its rows written exactly once. The sink should then be the last stage of the pipeline.
+ */
+class WriteToKafkaStage : public mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = mrc::pymrc::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+    using typename base_t::sink_type_t;
+    using typename base_t::source_type_t;
+    using typename base_t::subscribe_fn_t;
+
+    /**
+     * @brief Construct a new Write To Kafka Stage object
+     *
+     * @param topic : Kafka topic to write to
+     * @param config : Kafka producer configuration values, these take precedence over the defaults applied by this
+     * stage.
+     * @param key_column : Optional name of a string column whose values are used as the message keys, causing rows with
+     * the same key to be written to the same partition.
+     * @param poll_interval_ms : Interval at which the background thread serves delivery reports.
+     * @param consumer_group_id : Optional `group.id` of a `KafkaSourceStage` of this pipeline whose offsets are
+     * committed in the same transactions as the rows. Requires `transactional.id` to be set in `config`.
+     * @param transaction_interval_ms : Interval at which the open transaction is committed, longer intervals amortize
+     * the cost of each commit over more rows at the expense of latency for consumers reading committed messages only.
+     */
+    WriteToKafkaStage(std::string topic,
+                      std::map<std::string, std::string> config,
+                      std::optional<std::string> key_column        = std::nullopt,
+                      uint32_t poll_interval_ms                    = 100,
+                      std::optional<std::string> consumer_group_id = std::nullopt,
+                      uint32_t transaction_interval_ms             = 1000);
+
+    ~WriteToKafkaStage() override = default;
+
+  private:
+    /**
+     * @brief Create kafka producer configuration and returns unique pointer to the result.
+     *
+     * @param config_in : Configuration map provided by the user.
+     * @return std::unique_ptr<RdKafka::Conf>
+     */
+    std::unique_ptr<RdKafka::Conf> build_kafka_conf(const std::map<std::string, std::string>& config_in);
+
+    subscribe_fn_t build_operator();
+
+    std::string m_topic;
+    std::map<std::string, std::string> m_config;
+    std::optional<std::string> m_key_column;
+    uint32_t m_poll_interval_ms{100};
+    uint32_t m_transaction_interval_ms{1000};
+
+    // Only set when producing transactionally
+    std::shared_ptr<KafkaTransactionCoordinator> m_transactions;
+};
+
+/****** WriteToKafkaStageInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct WriteToKafkaStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a WriteToKafkaStage, and return the result
+     *
+     * @param builder : Pipeline context object reference
+     * @param name : Name of a stage reference
+     * @param topic : Kafka topic to write to
+     * @param config : Kafka producer configuration values
+     * @param key_column : Optional name of a string column whose values are used as the message keys
+     * @param poll_interval_ms : Interval at which the background thread serves delivery reports
+     * @param consumer_group_id : Optional `group.id` of a Kafka source whose offsets are committed with the rows
+     * @param transaction_interval : Interval in seconds at which the open transaction is committed
+     * @return std::shared_ptr<mrc::segment::Object<WriteToKafkaStage>>
+     */
+    static std::shared_ptr<mrc::segment::Object<WriteToKafkaStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        std::string topic,
+        std::map<std::string, std::string> config,
+        std::optional<std::string> key_column        = std::nullopt,
+        uint32_t poll_interval_ms                    = 100,
+        std::optional<std::string> consumer_group_id = std::nullopt,
+        float transaction_interval                   = 1.0);
+};
+
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include "morpheus/objects/flat_map.hpp"
+
 #include <cudf/types.hpp>
 
 #include <cstddef>  // for size_t
@@ -46,7 +48,7 @@ using RankType    = int;
 
 using ShapeType = std::vector<TensorIndex>;
 using RangeType = std::pair<TensorIndex, TensorIndex>;
-using TensorMap = std::map<std::string, TensorObject>;
+using TensorMap = FlatMap<std::string, TensorObject>;
 
 template <typename T = void>
 using Task = mrc::coroutines::Task<T>;
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** CudaUtil ******************************************/
+
+/**
+ * @addtogroup utilities
+ * @{
+ * @file
+ */
+
+/**
+ * @brief A struct that encapsulates CUDA device utilities.
+ */
+struct MORPHEUS_EXPORT CudaUtil
+{
+    /**
+     * @brief Returns the device of the calling thread
+     *
+     * @return int
+     */
+    static int current_device();
+
+    /**
+     * @brief Returns the number of visible devices
+     *
+     * @return int
+     */
+    static int device_count();
+};
+
+/**
+ * @brief Makes `device_id` the device of the calling thread for the lifetime of the guard, restoring the previous
+ * device on destruction. Must be destroyed on the thread which constructed it, so it cannot be held across the
+ * suspension of a coroutine.
+ */
+class MORPHEUS_EXPORT CudaDeviceGuard
+{
+  public:
+    CudaDeviceGuard(int device_id);
+    ~CudaDeviceGuard();
+
+    CudaDeviceGuard(const CudaDeviceGuard&)            = delete;
+    CudaDeviceGuard& operator=(const CudaDeviceGuard&) = delete;
+
+  private:
+    int m_previous_device;
+    int m_device;
+};
+
+/**
+ * @brief Hands out devices in turn, used by sources to spread their batches across GPUs. Thread safe.
+ */
+class MORPHEUS_EXPORT DeviceRoundRobin
+{
+  public:
+    /**
+     * @brief Construct a new Device Round Robin object
+     *
+     * @param device_ids : Devices to hand out, when empty the current device is always returned
+     * @throws std::invalid_argument If any of `device_ids` is not a visible device
+     */
+    DeviceRoundRobin(std::vector<int> device_ids = {});
+
+    /**
+     * @brief Returns the next device
+     *
+     * @return int
+     */
+    int next();
+
+  private:
+    std::vector<int> m_device_ids;
+    std::atomic<std::size_t> m_next{0};
+};
+/** @} */  // end of group
+}  // namespace morpheus
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "morpheus/objects/tensor_object.hpp"
+#include "morpheus/types.hpp"  // for TensorMap
 
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
@@ -40,11 +41,12 @@ namespace morpheus {
  */
 struct CupyUtil
 {
-    using tensor_map_t    = std::map<std::string, TensorObject>;
+    using tensor_map_t    = TensorMap;
     using py_tensor_map_t = std::map<std::string, pybind11::object>;
 
     /**
-     * @brief Import and return the cupy module. Requires GIL to have already been aqcuired.
+     * @brief Import and return the cupy module, which is only imported once. Requires GIL to have already been
+     * aqcuired.
      *
      * @return pybind11::module_
      */
@@ -60,7 +62,29 @@ struct CupyUtil
     static bool is_cupy_array(pybind11::object test_obj);
 
     /**
-     * @brief Convert a TensorObject to a CuPy array. Requires GIL to have already been aqcuired.
+     * @brief Export a TensorObject as a DLPack capsule without copying it, the capsule keeping the memory of the
+     * tensor alive until its consumer releases it. Requires GIL to have already been aqcuired.
+     *
+     * @param tensor
+     * @return pybind11::capsule
+     * @throws std::invalid_argument If the type of the tensor is not supported by DLPack
+     */
+    static pybind11::capsule tensor_to_dlpack(const TensorObject& tensor);
+
+    /**
+     * @brief Convert a DLPack capsule into a TensorObject, consuming the capsule. The data is copied on
+     * `rmm::cuda_stream_per_thread`, since tensors are backed by RMM device buffers. Requires GIL to have already been
+     * aqcuired.
+     *
+     * @param dlpack_capsule
+     * @return TensorObject
+     * @throws std::invalid_argument If the capsule was already consumed, or does not hold a CUDA device tensor
+     */
+    static TensorObject dlpack_to_tensor(pybind11::capsule dlpack_capsule);
+
+    /**
+     * @brief Convert a TensorObject to a CuPy array through DLPack, the array sharing the memory of the tensor.
+     * Requires GIL to have already been aqcuired.
      *
      * @param tensor
      * @return pybind11::object
@@ -68,7 +92,8 @@ struct CupyUtil
     static pybind11::object tensor_to_cupy(const TensorObject& tensor);
 
     /**
-     * @brief Convert a CuPy array into a TensorObject. Requires GIL to have already been aqcuired.
+     * @brief Convert a CuPy array into a TensorObject. Arrays implementing `__dlpack__` are read through DLPack,
+     * others through `__cuda_array_interface__`. Requires GIL to have already been aqcuired.
      *
      * @param cupy_array
      * @return TensorObject
@@ -77,6 +102,7 @@ struct CupyUtil
 
     /**
      * @brief Convert a map of CuPy arrays into a map of TensorObjects. Requires GIL to have already been aqcuired.
+     * Arrays implementing `__dlpack__` are copied all at once with the GIL released.
      *
      * @param cupy_tensors
      * @return tensor_map_t
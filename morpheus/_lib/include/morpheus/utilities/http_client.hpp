@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <boost/asio/io_context.hpp>         // for io_context
+#include <boost/asio/ip/tcp.hpp>             // for tcp::resolver
+#include <boost/beast/core/error.hpp>        // for error_code
+#include <boost/beast/core/tcp_stream.hpp>   // for tcp_stream
+#include <boost/beast/http/message.hpp>      // for request, response
+#include <boost/beast/http/string_body.hpp>  // for string_body
+
+#include <chrono>     // for milliseconds
+#include <cstddef>    // for size_t
+#include <exception>  // for exception_ptr
+#include <map>        // for map
+#include <memory>     // for unique_ptr
+#include <string>     // for string
+#include <utility>    // for pair
+#include <vector>     // for vector
+
+namespace morpheus {
+/**
+ * @addtogroup utilities
+ * @{
+ * @file
+ */
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief A request along with the host and port of the server to send it to
+ */
+struct HttpClientRequest
+{
+    boost::beast::http::request<boost::beast::http::string_body> request;
+    std::string host;
+    std::string port;
+};
+
+/**
+ * @brief Sends requests from the calling thread with up to `max_concurrent_requests` of them in flight. Connections to
+ * each host are kept open between requests, and between calls to `send_all`, and each host is resolved once. Requests
+ * answered with 503 Service Unavailable or 504 Gateway Timeout are retried after a timer, which does not hold up the
+ * other requests.
+ */
+class AsyncHttpClient
+{
+  public:
+    /**
+     * @brief Construct a new Async Http Client object
+     *
+     * @param max_concurrent_requests : Maximum number of requests in flight at once
+     * @param max_retry : Number of attempts of a request answered with 503 or 504 before failing
+     * @param retry_interval : Delay before the first retry of a request, doubled after each attempt
+     */
+    AsyncHttpClient(std::size_t max_concurrent_requests, int max_retry, std::chrono::milliseconds retry_interval);
+    ~AsyncHttpClient();
+
+    /**
+     * @brief Sends `requests`, returning the response to each one in the order of the requests. Throws on any network
+     * error, or when a request is still answered with 503 or 504 after `max_retry` attempts.
+     */
+    std::vector<boost::beast::http::response<boost::beast::http::string_body>> send_all(
+        std::vector<HttpClientRequest> requests);
+
+  private:
+    struct Lane;
+
+    void start_next(Lane& lane);
+    void send(Lane& lane);
+    void connect(Lane& lane, const boost::asio::ip::tcp::resolver::results_type& endpoints);
+    void write(Lane& lane);
+    void on_network_error(Lane& lane, boost::beast::error_code ec);
+    void on_response(Lane& lane);
+    void close(Lane& lane);
+    void fail(std::exception_ptr error);
+
+    std::size_t m_max_concurrent_requests;
+    int m_max_retry;
+    std::chrono::milliseconds m_retry_interval;
+
+    boost::asio::io_context m_io_context;
+    std::vector<std::unique_ptr<Lane>> m_lanes;
+    std::map<std::string, boost::asio::ip::tcp::resolver::results_type> m_dns_cache;
+    std::map<std::string, std::vector<std::unique_ptr<boost::beast::tcp_stream>>> m_idle_connections;
+
+    std::vector<HttpClientRequest> m_requests;
+    std::vector<boost::beast::http::response<boost::beast::http::string_body>> m_responses;
+    std::size_t m_next_request{0};
+    std::exception_ptr m_error;
+};
+
+/**
+ * @brief Percent-encodes `value` in the same way as python's `urllib.parse.quote`, leaving the characters of `safe`
+ * as they are. When `plus_spaces` is set, spaces are encoded as '+' as done by `urllib.parse.quote_plus`.
+ */
+std::string url_quote(const std::string& value, const std::string& safe, bool plus_spaces = false);
+
+/**
+ * @brief Encodes `params` in the same way as python's `urllib.parse.urlencode`, returns an empty string when there are
+ * no parameters and the query prefixed with '?' otherwise.
+ */
+std::string url_encode(const std::vector<std::pair<std::string, std::string>>& params);
+
+#pragma GCC visibility pop
+/** @} */  // end of group
+}  // namespace morpheus
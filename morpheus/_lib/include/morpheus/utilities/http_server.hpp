@@ -79,6 +79,9 @@ constexpr std::size_t DefaultMaxPayloadSize{1024 * 1024 * 10};  // 10MB
  * @details The server is started on a separate thread(s) and will call the provided payload_parse_fn_t
  *          function when an incoming request is received. The payload_parse_fn_t function is expected to
  *          return a tuple conforming to `parse_status_t` (ex: `std::make_tuple(200, "text/plain"s, "OK"s, nullptr)`).
+ *          Connections are persistent with pipelined requests answered in order. Request bodies with a
+ *          `Content-Encoding` of `gzip` or `deflate` are decompressed as they are read, other encodings are rejected
+ *          with a 415 status.
  *
  * @param payload_parse_fn The function that will be called when a POST request is received.
  * @param bind_address The address to bind the server to.
@@ -86,8 +89,15 @@ constexpr std::size_t DefaultMaxPayloadSize{1024 * 1024 * 10};  // 10MB
  * @param endpoint The endpoint to listen for POST requests on.
  * @param method The HTTP method to listen for.
  * @param num_threads The number of threads to use for the server.
- * @param max_payload_size The maximum size in bytes of the payload that the server will accept in a single request.
+ * @param max_payload_size The maximum size in bytes of the payload that the server will accept in a single request,
+ *        applies to both the compressed and decompressed size of the body.
  * @param request_timeout The timeout for a request.
+ * @param stream_chunk_size When greater than zero, request bodies are handed to `payload_parse_fn` as they arrive, in
+ *        chunks of complete lines of up to `stream_chunk_size` bytes. This allows JSON lines bodies of any size,
+ *        including `Transfer-Encoding: chunked` uploads, to be ingested while only buffering a single chunk. The
+ *        response is taken from the last chunk, or from the first chunk which was rejected with a non-2xx status
+ *        which also stops the rest of the body from being read. When streaming, `max_payload_size` limits the amount of
+ *        the body buffered at any one time rather than the size of the body.
  */
 class HttpServer
 {
@@ -99,7 +109,8 @@ class HttpServer
                std::string method                   = "POST",
                unsigned short num_threads           = 1,
                std::size_t max_payload_size         = DefaultMaxPayloadSize,
-               std::chrono::seconds request_timeout = std::chrono::seconds(30));
+               std::chrono::seconds request_timeout = std::chrono::seconds(30),
+               std::size_t stream_chunk_size        = 0);
     ~HttpServer();
     void start();
     void stop();
@@ -115,6 +126,7 @@ class HttpServer
     unsigned short m_num_threads;
     std::chrono::seconds m_request_timeout;
     std::size_t m_max_payload_size;
+    std::size_t m_stream_chunk_size;
     std::vector<std::thread> m_listener_threads;
     boost::asio::io_context m_io_context;
     std::shared_ptr<Listener> m_listener;
@@ -122,6 +134,31 @@ class HttpServer
     std::atomic<bool> m_is_running;
 };
 
+/**
+ * @brief Serves the metrics of the `MetricsRegistry` in the Prometheus text exposition format, answering GET requests
+ * on `endpoint`. The metrics are serialized on the server's threads, scrapes do not touch the pipeline.
+ *
+ * @param bind_address The address to bind the server to.
+ * @param port The port to bind the server to.
+ * @param endpoint The endpoint scraped by Prometheus.
+ * @param num_threads The number of threads to use for the server.
+ */
+class MetricsServer
+{
+  public:
+    MetricsServer(std::string bind_address   = "127.0.0.1",
+                  unsigned short port        = 9464,
+                  std::string endpoint       = "/metrics",
+                  unsigned short num_threads = 1);
+
+    void start();
+    void stop();
+    bool is_running() const;
+
+  private:
+    HttpServer m_server;
+};
+
 /**
  * @brief A class that listens for incoming HTTP requests.
  *
@@ -137,7 +174,8 @@ class Listener : public std::enable_shared_from_this<Listener>
              const std::string& endpoint,
              boost::beast::http::verb method,
              std::size_t max_payload_size,
-             std::chrono::seconds request_timeout);
+             std::chrono::seconds request_timeout,
+             std::size_t stream_chunk_size);
 
     ~Listener() = default;
 
@@ -158,6 +196,7 @@ class Listener : public std::enable_shared_from_this<Listener>
     boost::beast::http::verb m_method;
     std::size_t m_max_payload_size;
     std::chrono::seconds m_request_timeout;
+    std::size_t m_stream_chunk_size;
     std::atomic<bool> m_is_running;
 };
 
@@ -174,7 +213,8 @@ struct HttpServerInterfaceProxy
                                             std::string method,
                                             unsigned short num_threads,
                                             std::size_t max_payload_size,
-                                            int64_t request_timeout);
+                                            int64_t request_timeout,
+                                            std::size_t stream_chunk_size);
     static void start(HttpServer& self);
     static void stop(HttpServer& self);
     static bool is_running(const HttpServer& self);
@@ -187,4 +227,22 @@ struct HttpServerInterfaceProxy
                      const pybind11::object& traceback);
 };
 
+/****** MetricsServerInterfaceProxy *************************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct MetricsServerInterfaceProxy
+{
+    static void start(MetricsServer& self);
+    static void stop(MetricsServer& self);
+    static bool is_running(const MetricsServer& self);
+
+    // Context manager methods
+    static MetricsServer& enter(MetricsServer& self);
+    static void exit(MetricsServer& self,
+                     const pybind11::object& type,
+                     const pybind11::object& value,
+                     const pybind11::object& traceback);
+};
+
 }  // namespace morpheus
@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <boost/fiber/mutex.hpp>
+#include <librdkafka/rdkafkacpp.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/**
+ * @addtogroup utilities
+ * @{
+ * @file
+ */
+
+/****** Component public implementations *******************/
+/****** KafkaTransactionCoordinator ************************/
+
+/**
+ * @brief Commits the rows produced by a transactional `WriteToKafkaStage` atomically with the offsets consumed by the
+ * `KafkaSourceStage` of the same process whose consumer group is `group_id`, using the librdkafka transactional
+ * producer. Each transaction carries the offsets acknowledged by the time it commits, see `commit_on_ack`.
+ *
+ * The sink claims the coordinator of the consumer group when it is constructed, the source then attaches its consumer
+ * when it starts and hands over its acknowledged offsets rather than committing them itself. The sink opens a
+ * transaction with the first rows produced after a commit and commits it periodically, large transactions amortizing
+ * the cost of the commit. The source commits the open transaction before its partitions are revoked.
+ *
+ * The sink acknowledges a message once its rows have been produced, while holding the open transaction, its offsets
+ * are therefore committed in the same transaction as its rows. A transaction which fails is aborted and every later
+ * commit fails, the offsets it carried having been handed over, such that the pipeline is restarted from the last
+ * committed offsets.
+ */
+class MORPHEUS_EXPORT KafkaTransactionCoordinator
+{
+  public:
+    using offsets_t         = std::vector<std::unique_ptr<RdKafka::TopicPartition>>;
+    using take_offsets_fn_t = std::function<offsets_t()>;
+
+    /**
+     * @brief Returns the coordinator of `group_id` for a sink
+     *
+     * @param group_id : `group.id` of the consumer whose offsets are committed
+     * @throws std::invalid_argument If another sink claimed the consumer group
+     */
+    static std::shared_ptr<KafkaTransactionCoordinator> claim(const std::string& group_id);
+
+    /**
+     * @brief Returns the coordinator of `group_id` for a source, or nullptr when no sink claimed the consumer group
+     *
+     * @param group_id
+     */
+    static std::shared_ptr<KafkaTransactionCoordinator> find(const std::string& group_id);
+
+    explicit KafkaTransactionCoordinator(std::string group_id);
+
+    /**
+     * @brief Attaches the consumer of the source, its offsets are committed by the transactions from now on
+     *
+     * @param consumer : Consumer of the source, providing the group metadata which fences out older generations
+     * @param take_offsets : Returns the offsets acknowledged since the last call
+     */
+    void attach_consumer(RdKafka::KafkaConsumer* consumer, take_offsets_fn_t take_offsets);
+
+    void detach_consumer();
+
+    /**
+     * @brief Attaches the producer of the sink, initializing its transactions
+     *
+     * @param producer : Producer configured with a `transactional.id`
+     * @param timeout : Timeout of each transactional request
+     * @throws std::runtime_error If the transactions could not be initialized
+     */
+    void attach_producer(RdKafka::Producer* producer, std::chrono::milliseconds timeout);
+
+    void detach_producer();
+
+    /**
+     * @brief Opens a transaction when none is open, returning a lock which prevents it from being committed while the
+     * sink produces its rows and releases its message
+     *
+     * @throws std::runtime_error If a previous transaction failed
+     */
+    std::unique_lock<boost::fibers::mutex> begin();
+
+    /**
+     * @brief Commits the open transaction along with the acknowledged offsets. Opens a transaction for the offsets
+     * alone when none is open, does nothing when there are neither rows nor offsets to commit.
+     *
+     * @throws std::runtime_error If the transaction failed, after it was aborted
+     */
+    void commit();
+
+    /**
+     * @brief Same as `commit`, unless the sink is producing in which case nothing is done and false is returned
+     */
+    bool try_commit();
+
+  private:
+    void commit_locked();
+
+    void check_failed() const;
+
+    std::string m_group_id;
+
+    // Serializes the transactional requests, a fiber mutex as the sink and the source may run as fibers on the same
+    // thread
+    boost::fibers::mutex m_mutex;
+
+    RdKafka::KafkaConsumer* m_consumer{nullptr};
+    take_offsets_fn_t m_take_offsets;
+    RdKafka::Producer* m_producer{nullptr};
+    int m_timeout_ms{0};
+
+    bool m_in_transaction{false};
+    std::optional<std::string> m_failure;
+};
+/** @} */  // end of group
+}  // namespace morpheus
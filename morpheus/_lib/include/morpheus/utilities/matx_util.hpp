@@ -20,10 +20,16 @@
 #include "morpheus/objects/dev_mem_info.hpp"
 #include "morpheus/objects/dtype.hpp"
 #include "morpheus/objects/rmm_tensor.hpp"
+#include "morpheus/objects/tensor_buffer_pool.hpp"
 #include "morpheus/objects/tensor_object.hpp"
-#include "morpheus/types.hpp"  // for ShapeType, TensorIndex
+#include "morpheus/types.hpp"  // for RangeType, ShapeType, TensorIndex
 
+#include <rmm/cuda_stream_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace morpheus {
@@ -34,8 +40,90 @@ namespace morpheus {
  * @file
  */
 
+/**
+ * @brief Describes the copy of a single strided column of `num_rows` elements into a contiguous destination. Half
+ * precision sources, which cudf has no column type for, are widened to a float32 destination.
+ */
+struct StridedColumnCopy
+{
+    void* destination;
+    const void* source;
+    TensorIndex source_stride;  // Stride between consecutive source elements, in elements
+    TensorIndex num_rows;
+    std::size_t item_size;              // Size of each destination element
+    TypeId source_type{TypeId::EMPTY};  // FLOAT16 or BFLOAT16 to widen the source, otherwise copied as is
+};
+
+/**
+ * @brief Describes a single numeric column of the feature matrix built by `MatxUtil::pack_feature_matrix`
+ */
+struct FeatureColumn
+{
+    const void* data;                    // Start of the column's data, before `offset` is applied
+    const uint32_t* null_mask{nullptr};  // cudf bitmask of the valid rows, nullptr when the column has no nulls
+    TensorIndex offset{0};               // Index of the first row in both `data` and `null_mask`
+    TypeId type{TypeId::EMPTY};
+};
+
+/**
+ * @brief Activation applied to the outputs of a layer by `MatxUtil::grouped_dense`
+ */
+enum class DenseActivation : int32_t
+{
+    NONE       = 0,
+    RELU       = 1,
+    SIGMOID    = 2,
+    TANH       = 3,
+    LEAKY_RELU = 4  // Negative slope of 0.01, the default of torch
+};
+
+/**
+ * @brief Scaling applied to a feature by `MatxUtil::scale_feature_matrix`
+ */
+enum class FeatureScaling : int32_t
+{
+    NONE     = 0,
+    STANDARD = 1,  // (value - mean) / std
+    MINMAX   = 2,  // (value - min) / (max - min)
+    ONEHOT   = 3   // One output per entry of a vocabulary, set to one for the entry of the value
+};
+
+/**
+ * @brief Describes a single feature of the matrix built by `MatxUtil::scale_feature_matrix`
+ */
+struct ScaledFeature
+{
+    // Numeric values, or for a one-hot feature the int32 position of each value in the vocabulary, null when absent
+    FeatureColumn column;
+    FeatureScaling scaling{FeatureScaling::NONE};
+    TensorIndex first_output{0};    // Index of the first output column written by the feature
+    TensorIndex num_outputs{1};     // Size of the vocabulary of a one-hot feature, one otherwise
+    const int32_t* slots{nullptr};  // Device array of the output, from `first_output`, of each vocabulary position
+};
+
+/**
+ * @brief Outputs of `MatxUtil::reduce_logits_threshold`
+ */
+struct PostInferenceOutput
+{
+    std::shared_ptr<rmm::device_buffer> probs;
+    ShapeType shape;
+
+    // In elements, the mask shares this stride unless it was computed by row
+    ShapeType stride;
+
+    // Only set when a threshold was given
+    std::shared_ptr<rmm::device_buffer> mask;
+};
+
 struct MatxUtil
 {
+    // Largest `k` supported by `MatxUtil::top_k`, each thread keeps the best `k` values of its row in registers
+    static constexpr TensorIndex MaxTopK = 32;
+
+    // Largest number of columns packed by `MatxUtil::pack_labels`, one bit each of a uint64
+    static constexpr TensorIndex MaxPackedLabels = 64;
+
     /**
      * @brief Convert one device_buffer type to another
      *
@@ -45,6 +133,36 @@ struct MatxUtil
      */
     static std::shared_ptr<rmm::device_buffer> cast(const DevMemInfo& input, TypeId output_type);
 
+    /**
+     * @brief Asynchronous form of `cast`, allocating the output and enqueueing the conversion on `stream` without
+     * synchronizing.
+     *
+     * @param input
+     * @param output_type
+     * @param stream
+     * @return std::shared_ptr<rmm::device_buffer>
+     */
+    static std::shared_ptr<rmm::device_buffer> enqueue_cast(const DevMemInfo& input,
+                                                            TypeId output_type,
+                                                            rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Converts the 2D `input` of any strides to a row major matrix of `output_type` written to `output`, without
+     * allocating. `output` can be device memory or pinned host memory mapped in the device address space, in which
+     * case the conversion and the transfer to the host are done by the same kernel. Enqueued on `stream` without
+     * synchronizing.
+     *
+     * @param input
+     * @param output_type
+     * @param output : Device accessible pointer to at least `input.count()` elements of `output_type`
+     * @param stream
+     * @throws std::invalid_argument If `input` is not 2D or the conversion is not supported
+     */
+    static void enqueue_cast_into(const DevMemInfo& input,
+                                  TypeId output_type,
+                                  void* output,
+                                  rmm::cuda_stream_view stream);
+
     /**
      * @brief Builds a Nx3 segment ID matrix
      *
@@ -68,13 +186,24 @@ struct MatxUtil
      */
     static void offset_seq_ids(const DevMemInfo& input, TensorIndex offset);
 
+    /**
+     * @brief Asynchronous form of `offset_seq_ids`, enqueueing the kernel on `stream` without synchronizing
+     *
+     * @param input
+     * @param offset
+     * @param stream
+     */
+    static void enqueue_offset_seq_ids(const DevMemInfo& input, TensorIndex offset, rmm::cuda_stream_view stream);
+
     /**
      * @brief Calculate logits on device_buffer
      *
      * @param input
+     * @param pool : Optional pool to take the output buffer from, should allocate on the same stream as `input`
      * @return std::shared_ptr<rmm::device_buffer>
      */
-    static std::shared_ptr<rmm::device_buffer> logits(const DevMemInfo& input);
+    static std::shared_ptr<rmm::device_buffer> logits(const DevMemInfo& input,
+                                                      const std::shared_ptr<TensorBufferPool>& pool = nullptr);
 
     /**
      * @brief Perform transpose
@@ -91,9 +220,66 @@ struct MatxUtil
      * @param input
      * @param thresh_val
      * @param by_row
+     * @param pool : Optional pool to take the output buffer from, should allocate on the same stream as `input`
      * @return std::shared_ptr<rmm::device_buffer>
      */
-    static std::shared_ptr<rmm::device_buffer> threshold(const DevMemInfo& input, double thresh_val, bool by_row);
+    static std::shared_ptr<rmm::device_buffer> threshold(const DevMemInfo& input,
+                                                         double thresh_val,
+                                                         bool by_row,
+                                                         const std::shared_ptr<TensorBufferPool>& pool = nullptr);
+
+    /**
+     * @brief Returns the ranges of consecutive rows of `mask` which are true, in increasing order. The ranges are found
+     * on the device and only they are copied back to the host. Synchronizes `stream`.
+     *
+     * @param mask : Device array of `num_rows` booleans, such as the output of `threshold`
+     * @param num_rows
+     * @param stream
+     * @return std::vector<RangeType>
+     */
+    static std::vector<RangeType> selected_ranges(const bool* mask, TensorIndex num_rows, rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Finds the `k` largest values of each row of the 2D `input` among `columns`, writing their column indices
+     * to `ids` and the values, as float32, to `scores` in decreasing order of the values. Ties are broken by the order
+     * of `columns`. Both outputs are column major arrays of `input.shape(0)` rows by `k`, such that each rank is a
+     * contiguous column. When `thresh_val` is set, ranks whose value is not above it have an id of -1. Enqueued
+     * asynchronously on `stream` with a single kernel launch.
+     *
+     * @param input
+     * @param columns : Columns of `input` to pick from, at least `k` of them
+     * @param k : Number of values to find per row, at most `MaxTopK`
+     * @param thresh_val
+     * @param ids : Device array of `input.shape(0) * k` elements
+     * @param scores : Device array of `input.shape(0) * k` elements
+     * @param stream
+     * @throws std::invalid_argument If `k` is out of range or `input` is not numeric
+     */
+    static void top_k(const DevMemInfo& input,
+                      const std::vector<TensorIndex>& columns,
+                      TensorIndex k,
+                      std::optional<double> thresh_val,
+                      int32_t* ids,
+                      float* scores,
+                      rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Packs the thresholded values of each row of the 2D `input` among `columns` into a single uint64, bit `i`
+     * being set when the value of `columns[i]` is above `thresh_val`. Enqueued asynchronously on `stream` with a single
+     * kernel launch.
+     *
+     * @param input
+     * @param columns : Columns of `input` to pack, at most `MaxPackedLabels` of them
+     * @param thresh_val
+     * @param output : Device array of `input.shape(0)` elements
+     * @param stream
+     * @throws std::invalid_argument If there are more than `MaxPackedLabels` columns or `input` is not numeric
+     */
+    static void pack_labels(const DevMemInfo& input,
+                            const std::vector<TensorIndex>& columns,
+                            double thresh_val,
+                            uint64_t* output,
+                            rmm::cuda_stream_view stream);
 
     /**
      * @brief Returns a buffer with `output_shape` containing the max value from values in `input` mapped according to
@@ -110,12 +296,388 @@ struct MatxUtil
      * @param seq_ids
      * @param seq_id_offset
      * @param output_shape
+     * @param pool : Optional pool to take the output buffer from, should allocate on the same stream as `input`
      * @return std::shared_ptr<rmm::device_buffer>
      */
     static std::shared_ptr<rmm::device_buffer> reduce_max(const DevMemInfo& input,
                                                           const ShapeType& seq_ids,
                                                           TensorIndex seq_id_offset,
-                                                          const ShapeType& output_shape);
+                                                          const ShapeType& output_shape,
+                                                          const std::shared_ptr<TensorBufferPool>& pool = nullptr);
+
+    /**
+     * @brief Fused equivalent of `reduce_max`, followed by `logits` and then `threshold`, performing all three in a
+     * single pass over `input` with a single synchronization of the stream. Each step is optional: the reduction is
+     * skipped when `seq_ids` is empty, the sigmoid when `apply_logits` is false and the mask when `thresh_val` is not
+     * set.
+     *
+     * @param input 2D tensor of model outputs
+     * @param seq_ids : Output row of each input row, offset by `seq_id_offset`. Empty to skip the reduction
+     * @param seq_id_offset
+     * @param num_output_rows : Number of rows after the reduction, must match the rows of `input` without one
+     * @param apply_logits : Apply the sigmoid function after the reduction
+     * @param thresh_val : Threshold for the boolean mask, compared against the values after the sigmoid
+     * @param by_row : When true the mask has one element per row which is true if any value in the row is above the
+     * threshold
+     * @param pool : Optional pool to take the output buffers from, should allocate on the same stream as `input`
+     * @return PostInferenceOutput
+     */
+    static PostInferenceOutput reduce_logits_threshold(const DevMemInfo& input,
+                                                       const ShapeType& seq_ids,
+                                                       TensorIndex seq_id_offset,
+                                                       TensorIndex num_output_rows,
+                                                       bool apply_logits,
+                                                       std::optional<double> thresh_val             = std::nullopt,
+                                                       bool by_row                                   = false,
+                                                       const std::shared_ptr<TensorBufferPool>& pool = nullptr);
+
+    /**
+     * @brief Overload of `reduce_logits_threshold` which always reduces, reading the sequence ids directly from the
+     * device rather than requiring a copy on the host. The segment of each output row is found by a kernel over the
+     * first column of `seq_ids`, so no host copy or host loop is needed.
+     *
+     * @param input 2D tensor of model outputs
+     * @param seq_ids : Integer seq_ids tensor with one row per row of `input`, the first column holding the output row
+     * @param num_output_rows : Number of rows after the reduction
+     * @param apply_logits : Apply the sigmoid function after the reduction
+     * @param thresh_val : Threshold for the boolean mask, compared against the values after the sigmoid
+     * @param by_row : When true the mask has one element per row which is true if any value in the row is above the
+     * threshold
+     * @param pool : Optional pool to take the output buffers from, should allocate on the same stream as `input`
+     * @return PostInferenceOutput
+     */
+    static PostInferenceOutput reduce_logits_threshold(const DevMemInfo& input,
+                                                       const DevMemInfo& seq_ids,
+                                                       TensorIndex num_output_rows,
+                                                       bool apply_logits,
+                                                       std::optional<double> thresh_val             = std::nullopt,
+                                                       bool by_row                                   = false,
+                                                       const std::shared_ptr<TensorBufferPool>& pool = nullptr);
+
+    /**
+     * @brief Allocates the outputs of `reduce_logits_threshold` without enqueueing any work, to be filled in by
+     * `enqueue_reduce_logits_threshold`
+     *
+     * @param input 2D tensor of model outputs
+     * @param num_output_rows : Number of rows after the reduction, or the rows of `input` without one
+     * @param thresh_val : Allocates the mask when set
+     * @param by_row : Allocates a mask with one element per row
+     * @param pool : Optional pool to take the output buffers from, should allocate on the same stream as `input`
+     * @return PostInferenceOutput
+     */
+    static PostInferenceOutput allocate_post_inference_output(
+        const DevMemInfo& input,
+        TensorIndex num_output_rows,
+        std::optional<double> thresh_val             = std::nullopt,
+        bool by_row                                   = false,
+        const std::shared_ptr<TensorBufferPool>& pool = nullptr);
+
+    /**
+     * @brief Finds the first input row of each of the `num_output_rows` output rows from the first column of the
+     * sorted `seq_ids`, writing `num_output_rows + 1` offsets to `row_offsets` for use by
+     * `enqueue_reduce_logits_threshold`. Neither allocates nor synchronizes.
+     *
+     * @param seq_ids : Integer seq_ids tensor
+     * @param num_output_rows : Number of rows after the reduction
+     * @param row_offsets : Device buffer of `num_output_rows + 1` elements
+     * @param stream : Stream to enqueue the kernel on
+     */
+    static void enqueue_seq_id_offsets(const DevMemInfo& seq_ids,
+                                       TensorIndex num_output_rows,
+                                       TensorIndex* row_offsets,
+                                       rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Asynchronous form of `reduce_logits_threshold`, enqueueing its kernels on `stream` into the buffers of
+     * `output`. Neither allocates nor synchronizes, so the enqueued work can be captured into a CUDA graph by the
+     * `CudaGraphCache`.
+     *
+     * @param input 2D tensor of model outputs
+     * @param row_offsets : Offsets from `enqueue_seq_id_offsets`, or null to skip the reduction
+     * @param output : Outputs allocated by `allocate_post_inference_output`
+     * @param apply_logits : Apply the sigmoid function after the reduction
+     * @param thresh_val : Threshold for the boolean mask, compared against the values after the sigmoid
+     * @param by_row : When true the mask has one element per row which is true if any value in the row is above the
+     * threshold
+     * @param stream : Stream to enqueue the kernels on
+     */
+    static void enqueue_reduce_logits_threshold(const DevMemInfo& input,
+                                                const TensorIndex* row_offsets,
+                                                PostInferenceOutput& output,
+                                                bool apply_logits,
+                                                std::optional<double> thresh_val,
+                                                bool by_row,
+                                                rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Copies the rows of a 2D `input` selected by `ranges` into a new row major buffer of `num_rows` rows, in
+     * the order the ranges are given. All of the ranges are copied by a single kernel launch rather than a copy per
+     * range, followed by a single synchronization of the stream.
+     *
+     * @param input
+     * @param ranges : Half-open `[start, stop)` row ranges of `input`, their combined length must equal `num_rows`
+     * @param num_rows
+     * @return std::shared_ptr<rmm::device_buffer>
+     */
+    static std::shared_ptr<rmm::device_buffer> gather_rows(const DevMemInfo& input,
+                                                           const std::vector<RangeType>& ranges,
+                                                           TensorIndex num_rows);
+
+    /**
+     * @brief Copies the rows selected by `ranges` of each of the 2D `inputs` into a new row major buffer per input, as
+     * `gather_rows` does for a single input. The rows of every input are copied by a single kernel launch followed by a
+     * single synchronization, regardless of the number of inputs and ranges.
+     *
+     * @param inputs : 2D tensors of any number of columns and type of 1, 2, 4 or 8 bytes, at most 65535 of them
+     * @param ranges : Half-open `[start, stop)` row ranges of the inputs, their combined length must equal `num_rows`
+     * @param num_rows
+     * @return std::vector<std::shared_ptr<rmm::device_buffer>> : Buffer of each input, in the order of `inputs`
+     */
+    static std::vector<std::shared_ptr<rmm::device_buffer>> gather_rows(const std::vector<DevMemInfo>& inputs,
+                                                                        const std::vector<RangeType>& ranges,
+                                                                        TensorIndex num_rows);
+
+    /**
+     * @brief Performs each of `copies` with a single kernel launch on `stream`. The copies are enqueued
+     * asynchronously and are not synchronized with the host.
+     *
+     * @param copies
+     * @param stream
+     */
+    static void copy_strided_columns(const std::vector<StridedColumnCopy>& copies, rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Mixes the values of each row of the 2D `input` into `hashes`, which holds one 64-bit hash per row and
+     * seeds the hash of each row, allowing the rows of several tensors to be hashed together. Rows holding the same
+     * values hash the same regardless of the strides of `input`. Enqueued asynchronously on `stream`.
+     *
+     * @param input
+     * @param hashes : Device array of `input.shape(0)` hashes
+     * @param stream
+     */
+    static void hash_rows(const DevMemInfo& input, uint64_t* hashes, rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Copies row `input_rows[i]` of the row major `input` to row `output_rows[i]` of the row major `output` for
+     * each of the rows, with a single kernel launch on `stream`. The copies are enqueued asynchronously.
+     *
+     * @param input
+     * @param output
+     * @param row_bytes : Size of a row of both `input` and `output`
+     * @param input_rows
+     * @param output_rows : Must be the same length as `input_rows`
+     * @param stream
+     */
+    static void copy_rows(const void* input,
+                          void* output,
+                          std::size_t row_bytes,
+                          const std::vector<TensorIndex>& input_rows,
+                          const std::vector<TensorIndex>& output_rows,
+                          rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Returns the length of the longest row of the 2D `input`, not counting the zeros trailing each row. For an
+     * attention mask this is the number of tokens of the longest sequence. Synchronizes `stream`.
+     *
+     * @param input
+     * @param stream
+     * @return TensorIndex
+     */
+    static TensorIndex max_row_length(const DevMemInfo& input, rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Packs rows of `tokens` into the row major `token_ids` and `attention_mask`, both of `row_starts.size()`
+     * rows of `sequence_length`. Row `i` holds the `row_lengths[i]` tokens starting at `row_starts[i]`, followed by
+     * zeros, its mask holds a one for each of those tokens. Enqueued asynchronously on `stream`.
+     *
+     * @param tokens
+     * @param row_starts
+     * @param row_lengths : Must be the same length as `row_starts`, each at most `sequence_length`
+     * @param sequence_length
+     * @param token_ids
+     * @param attention_mask
+     * @param stream
+     */
+    static void pack_token_rows(const int32_t* tokens,
+                                const std::vector<TensorIndex>& row_starts,
+                                const std::vector<TensorIndex>& row_lengths,
+                                TensorIndex sequence_length,
+                                uint32_t* token_ids,
+                                uint32_t* attention_mask,
+                                rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Raises each of the `input.shape(0)` values of `lengths` to the length of the matching row of the 2D
+     * `input`, not counting the zeros trailing the row. Starting from zeroed `lengths`, calling it for each input of
+     * the same rows gives the number of tokens of each sequence. Enqueued asynchronously on `stream`.
+     *
+     * @param input
+     * @param lengths : Device memory
+     * @param stream
+     */
+    static void enqueue_row_lengths(const DevMemInfo& input, TensorIndex* lengths, rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Concatenates the rows of the row major `padded` without their padding into `packed`, as sent to models
+     * accepting ragged batches. Each row of `padded` holds `padded.shape(1) / token_width` tokens of `token_width`
+     * values, the tokens of row `i` are the first `offsets[i + 1] - offsets[i]` and are written to `packed` starting at
+     * token `offsets[i]`. Enqueued asynchronously on `stream`.
+     *
+     * @param padded
+     * @param offsets : Device memory holding `padded.shape(0) + 1` offsets, starting at zero
+     * @param token_width
+     * @param packed : Device memory of `offsets[padded.shape(0)] * token_width` values of the type of `padded`
+     * @param stream
+     * @throws std::invalid_argument If `padded` is not row major
+     */
+    static void pack_ragged_rows(const DevMemInfo& padded,
+                                 const TensorIndex* offsets,
+                                 TensorIndex token_width,
+                                 void* packed,
+                                 rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Reverses `pack_ragged_rows`, copying the tokens of each row of `packed` into the row major `padded`
+     * followed by zeros. Enqueued asynchronously on `stream`.
+     *
+     * @param packed
+     * @param offsets : Device memory holding `padded.shape(0) + 1` offsets, starting at zero
+     * @param token_width
+     * @param padded
+     * @param stream
+     * @throws std::invalid_argument If `padded` is not row major
+     */
+    static void unpack_ragged_rows(const void* packed,
+                                   const TensorIndex* offsets,
+                                   TensorIndex token_width,
+                                   const DevMemInfo& padded,
+                                   rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Builds the row major float32 `features` matrix of `num_rows` by `columns.size()` from the numeric
+     * `columns`, casting each value and writing `fill_value` in place of nulls, along with the Nx3 `seq_ids` matrix of
+     * `MatxUtil::create_seq_ids` starting at `seq_id_offset`. Both are written by a single kernel launch enqueued
+     * asynchronously on `stream`.
+     *
+     * @param columns : Integer, floating point or boolean columns of at least `num_rows` rows each
+     * @param num_rows
+     * @param fill_value
+     * @param features
+     * @param seq_ids
+     * @param seq_id_offset
+     * @param stream
+     */
+    static void pack_feature_matrix(const std::vector<FeatureColumn>& columns,
+                                    TensorIndex num_rows,
+                                    float fill_value,
+                                    float* features,
+                                    TensorIndex* seq_ids,
+                                    TensorIndex seq_id_offset,
+                                    rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Builds the row major float32 `output` matrix of `num_rows` by `num_outputs` from the `features`, scaling
+     * each numeric value to `(value - shift) * scale` and setting the outputs of one-hot features to one for the
+     * vocabulary entry of the value and zero otherwise, along with the Nx3 `seq_ids` matrix of
+     * `MatxUtil::create_seq_ids` starting at `seq_id_offset`. Nulls, and one-hot values missing from the vocabulary,
+     * are written as zeros. Both are written by a single kernel launch enqueued asynchronously on `stream`.
+     *
+     * @param features : Features covering the outputs in order, each starting where the previous one ends
+     * @param params : Device array of the shift and scale of each feature, read for the standard and min-max features
+     * @param num_rows
+     * @param num_outputs
+     * @param output
+     * @param seq_ids
+     * @param seq_id_offset
+     * @param stream
+     * @throws std::invalid_argument If the features do not cover the outputs, or a column type is not supported
+     */
+    static void scale_feature_matrix(const std::vector<ScaledFeature>& features,
+                                     const float* params,
+                                     TensorIndex num_rows,
+                                     TensorIndex num_outputs,
+                                     float* output,
+                                     TensorIndex* seq_ids,
+                                     TensorIndex seq_id_offset,
+                                     rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Applies a dense layer to each row of the row major float32 `input`, the weights of the layer being
+     * selected per row, such that the rows of many models sharing the same layer sizes are computed by a single kernel
+     * launch rather than one per model. Row `r` of the row major `output` is set to
+     * `activation(biases[s] + input[r] x weights[s])` with `s = slots[r]`, where `weights[s]` is the `input_size` by
+     * `output_size` transposed weight matrix of slot `s` and `biases[s]` its `output_size` biases, both laid out
+     * contiguously per slot. Enqueued asynchronously on `stream`.
+     *
+     * @param input : Device array of `num_rows` by `input_size` values
+     * @param num_rows
+     * @param input_size
+     * @param output_size
+     * @param weights : Device array of `input_size * output_size` values per slot
+     * @param biases : Device array of `output_size` values per slot
+     * @param slots : Device array of `num_rows` slots
+     * @param activation
+     * @param output : Device array of `num_rows` by `output_size` values
+     * @param stream
+     */
+    static void grouped_dense(const float* input,
+                              TensorIndex num_rows,
+                              TensorIndex input_size,
+                              TensorIndex output_size,
+                              const float* weights,
+                              const float* biases,
+                              const int32_t* slots,
+                              DenseActivation activation,
+                              float* output,
+                              rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Copies the 2D `input` of any layout to a new row major buffer of `output_type`, scaling each row to a unit
+     * L2 norm when `normalize` is set. Rows of zeros are copied as is. Enqueued asynchronously on `stream` with a
+     * single kernel launch, each row being handled by one warp.
+     *
+     * @param input
+     * @param output_type : One of float16, float32 or float64
+     * @param normalize
+     * @param stream
+     * @return std::shared_ptr<rmm::device_buffer>
+     * @throws std::invalid_argument If `input` is not numeric or `output_type` is not a floating point type
+     */
+    static std::shared_ptr<rmm::device_buffer> normalize_rows(const DevMemInfo& input,
+                                                              TypeId output_type,
+                                                              bool normalize,
+                                                              rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Resolves each address to the row of the range holding it, with one binary search per address over
+     * `num_ranges` disjoint ranges sorted by their first address. Addresses and range bounds are 128-bit values stored
+     * as (low, high) words, the layout of the `src_ip6` and `dst_ip6` columns, IPv4 addresses being mapped into IPv6.
+     * Addresses outside of every range, or null in `null_mask`, are resolved to `not_found`. Enqueued asynchronously
+     * on `stream`.
+     *
+     * @param addresses : Device array of the `2 * num_addresses` words of the addresses
+     * @param ipv4 : Whether `addresses` rather holds `num_addresses` IPv4 addresses, in the low 32 bits of each word
+     * @param null_mask : Device bitmask of the valid addresses starting at bit 0, every address being valid when null
+     * @param num_addresses
+     * @param range_firsts : Device array of the `2 * num_ranges` words of the first address of each range
+     * @param range_lasts : Device array of the `2 * num_ranges` words of the last address of each range
+     * @param range_rows : Device array of the row of each range
+     * @param num_ranges
+     * @param not_found
+     * @param rows : Device array of `num_addresses` elements
+     * @param stream
+     */
+    static void lookup_address_ranges(const uint64_t* addresses,
+                                      bool ipv4,
+                                      const uint32_t* null_mask,
+                                      TensorIndex num_addresses,
+                                      const uint64_t* range_firsts,
+                                      const uint64_t* range_lasts,
+                                      const int32_t* range_rows,
+                                      TensorIndex num_ranges,
+                                      int32_t not_found,
+                                      int32_t* rows,
+                                      rmm::cuda_stream_view stream);
 };
 /** @} */  // end of group
 }  // namespace morpheus
@@ -0,0 +1,257 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace morpheus {
+/**
+ * @addtogroup utilities
+ * @{
+ * @file
+ */
+
+using metric_labels_t = std::map<std::string, std::string>;
+
+/**
+ * @brief Number of shards counters and histograms accumulate into. Each thread updates the shard picked by
+ * `metric_shard()`, so threads updating the same metric rarely contend for the same cache line.
+ */
+constexpr std::size_t MetricShards = 16;
+
+/**
+ * @brief Index of the shard the calling thread accumulates into, assigned round-robin to threads on first use.
+ */
+MORPHEUS_EXPORT std::size_t metric_shard();
+
+/****** Component public implementations *******************/
+/****** Counter ****************************************/
+
+/**
+ * @brief A monotonically increasing value, such as the number of records processed. Rates are derived from counters by
+ * the scraper. Incrementing does not take a lock, each thread accumulating into a shard of its own.
+ */
+class MORPHEUS_EXPORT Counter
+{
+  public:
+    void increment(double value = 1.0);
+
+    double value() const;
+
+  private:
+    struct alignas(64) Shard
+    {
+        std::atomic<double> value{0.0};
+    };
+
+    std::array<Shard, MetricShards> m_shards;
+};
+
+/****** Gauge ****************************************/
+
+/**
+ * @brief A value which can go up and down, such as the consumer lag of a partition.
+ */
+class MORPHEUS_EXPORT Gauge
+{
+  public:
+    void set(double value);
+
+    void increment(double value = 1.0);
+
+    void decrement(double value = 1.0);
+
+    double value() const;
+
+  private:
+    std::atomic<double> m_value{0.0};
+};
+
+/****** Histogram ****************************************/
+
+/**
+ * @brief Distribution of observed values, such as latencies, counted in buckets by their upper bounds. Exponentially
+ * increasing bounds keep the relative error of the reported quantiles constant across many orders of magnitude.
+ * Observing a value does not take a lock, each thread accumulating into a shard of its own.
+ */
+class MORPHEUS_EXPORT Histogram
+{
+  public:
+    /**
+     * @brief Construct a new Histogram
+     *
+     * @param upper_bounds : Inclusive upper bound of each bucket in increasing order, values larger than the last bound
+     * are only counted by the implicit `+Inf` bucket
+     * @throws std::invalid_argument if `upper_bounds` is not increasing
+     */
+    explicit Histogram(std::vector<double> upper_bounds);
+
+    /**
+     * @brief Returns `count` bounds starting at `start`, each `factor` times the previous
+     */
+    static std::vector<double> exponential_buckets(double start, double factor, std::size_t count);
+
+    /**
+     * @brief Bounds suited to durations in seconds, doubling from 10µs to roughly 84s
+     */
+    static std::vector<double> duration_buckets();
+
+    void observe(double value);
+
+    const std::vector<double>& upper_bounds() const;
+
+    /**
+     * @brief Number of values observed in each bucket, not cumulative, followed by the `+Inf` bucket
+     */
+    std::vector<uint64_t> bucket_counts() const;
+
+    double sum() const;
+
+    uint64_t count() const;
+
+  private:
+    struct alignas(64) Shard
+    {
+        std::atomic<double> sum{0.0};
+        std::atomic<uint64_t> count{0};
+    };
+
+    // The bucket counts of a shard start on a cache line of their own
+    struct alignas(64) BucketLine
+    {
+        static constexpr std::size_t Size = 8;
+        std::array<std::atomic<uint64_t>, Size> counts{};
+    };
+
+    std::atomic<uint64_t>& bucket_count(std::size_t shard, std::size_t bucket) const;
+
+    std::vector<double> m_upper_bounds;
+    std::size_t m_lines_per_shard;
+    std::unique_ptr<BucketLine[]> m_bucket_lines;
+    std::array<Shard, MetricShards> m_shards;
+};
+
+/****** MetricsRegistry ****************************************/
+
+/**
+ * @brief Process-wide registry of metrics. Each metric is identified by its name and labels, requesting the same
+ * metric twice returns the same instance, allowing multiple instances of a stage to share a series. Updating a metric
+ * does not require the registry lock, so stages should hold on to the returned pointers rather than looking them up
+ * per message.
+ */
+class MORPHEUS_EXPORT MetricsRegistry
+{
+  public:
+    static MetricsRegistry& get_instance();
+
+    /**
+     * @brief Returns the counter `name` with `labels`, creating it if needed.
+     *
+     * @param name : Metric name, should follow the Prometheus naming conventions, counters ending in `_total`
+     * @param help : Description of the metric
+     * @param labels : Labels identifying the series
+     * @return std::shared_ptr<Counter>
+     * @throws std::invalid_argument if `name` has already been registered as a different type of metric
+     */
+    std::shared_ptr<Counter> get_counter(const std::string& name,
+                                         const std::string& help,
+                                         const metric_labels_t& labels = {});
+
+    /**
+     * @brief Returns the gauge `name` with `labels`, creating it if needed.
+     *
+     * @param name : Metric name, should follow the Prometheus naming conventions
+     * @param help : Description of the metric
+     * @param labels : Labels identifying the series
+     * @return std::shared_ptr<Gauge>
+     * @throws std::invalid_argument if `name` has already been registered as a different type of metric
+     */
+    std::shared_ptr<Gauge> get_gauge(const std::string& name,
+                                     const std::string& help,
+                                     const metric_labels_t& labels = {});
+
+    /**
+     * @brief Returns the histogram `name` with `labels`, creating it with `upper_bounds` if needed.
+     *
+     * @param name : Metric name, should follow the Prometheus naming conventions, ending in the unit such as `_seconds`
+     * @param help : Description of the metric
+     * @param labels : Labels identifying the series, must not contain `le`
+     * @param upper_bounds : Bucket bounds, only used by the first request for the series
+     * @return std::shared_ptr<Histogram>
+     * @throws std::invalid_argument if `name` has already been registered as a different type of metric
+     */
+    std::shared_ptr<Histogram> get_histogram(const std::string& name,
+                                             const std::string& help,
+                                             const metric_labels_t& labels           = {},
+                                             const std::vector<double>& upper_bounds = Histogram::duration_buckets());
+
+    /**
+     * @brief Removes the series `name` with `labels`. Existing pointers remain valid but are no longer reported.
+     */
+    void remove(const std::string& name, const metric_labels_t& labels);
+
+    /**
+     * @brief Removes all metrics
+     */
+    void clear();
+
+    /**
+     * @brief Serializes all of the metrics in the Prometheus text exposition format
+     *
+     * @return std::string
+     */
+    std::string serialize() const;
+
+  private:
+    MetricsRegistry() = default;
+
+    enum class MetricType
+    {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    using metric_t = std::variant<std::shared_ptr<Counter>, std::shared_ptr<Gauge>, std::shared_ptr<Histogram>>;
+
+    struct MetricFamily
+    {
+        MetricType type;
+        std::string help;
+        std::map<metric_labels_t, metric_t> series;
+    };
+
+    MetricFamily& get_family(const std::string& name, const std::string& help, MetricType type);
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, MetricFamily> m_families;
+};
+
+/** @} */  // end of group
+}  // namespace morpheus
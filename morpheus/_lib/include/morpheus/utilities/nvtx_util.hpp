@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>  // for uint64_t
+
+#ifdef MORPHEUS_ENABLE_NVTX
+    #include <nvtx3/nvtx3.hpp>
+#endif
+
+/**
+ * @addtogroup utilities
+ * @{
+ * @file
+ *
+ * NVTX ranges, compiled in when building with `MORPHEUS_ENABLE_NVTX=ON`. Every stage records its ranges in an NVTX
+ * domain of its own, declared with `MORPHEUS_NVTX_DOMAIN`, and each range carries the number of rows it processed as
+ * its payload. When NVTX is disabled the range macros expand to nothing and their arguments are not evaluated.
+ */
+
+/**
+ * @brief Declare `DomainT`, the tag type of the NVTX domain named `domain_name`.
+ */
+#define MORPHEUS_NVTX_DOMAIN(DomainT, domain_name)      \
+    struct DomainT                                      \
+    {                                                   \
+        static constexpr const char* name{domain_name}; \
+    }
+
+#define MORPHEUS_NVTX_CONCAT_IMPL(a, b) a##b
+#define MORPHEUS_NVTX_CONCAT(a, b) MORPHEUS_NVTX_CONCAT_IMPL(a, b)
+
+#ifdef MORPHEUS_ENABLE_NVTX
+
+    // The message is registered once per call site, the range only passing its handle to NVTX
+    #define MORPHEUS_NVTX_RANGE_IMPL(RangeT, DomainT, message, rows, id)                                      \
+        static const ::nvtx3::registered_string_in<DomainT> MORPHEUS_NVTX_CONCAT(morpheus_nvtx_message_, id){ \
+            message};                                                                                         \
+        const RangeT<DomainT> MORPHEUS_NVTX_CONCAT(morpheus_nvtx_range_, id)                                  \
+        {                                                                                                     \
+            ::nvtx3::event_attributes                                                                         \
+            {                                                                                                 \
+                MORPHEUS_NVTX_CONCAT(morpheus_nvtx_message_, id), ::nvtx3::payload                            \
+                {                                                                                             \
+                    static_cast<std::uint64_t>(rows)                                                          \
+                }                                                                                             \
+            }                                                                                                 \
+        }
+
+    /**
+     * @brief Push a range named `message` in the domain `DomainT`, popped at the end of the enclosing scope. Must not
+     * span the suspension of a coroutine, ranges being pushed and popped on the stack of the calling thread.
+     */
+    #define MORPHEUS_NVTX_RANGE(DomainT, message, rows) \
+        MORPHEUS_NVTX_RANGE_IMPL(::nvtx3::scoped_range_in, DomainT, message, rows, __LINE__)
+
+    /**
+     * @brief Start a range named `message` in the domain `DomainT`, ended at the end of the enclosing scope, which may
+     * be on another thread. Used by coroutines, whose scope can span suspensions.
+     */
+    #define MORPHEUS_NVTX_ASYNC_RANGE(DomainT, message, rows) \
+        MORPHEUS_NVTX_RANGE_IMPL(::nvtx3::unique_range_in, DomainT, message, rows, __LINE__)
+
+#else
+
+    #define MORPHEUS_NVTX_RANGE(DomainT, message, rows) static_cast<void>(0)
+    #define MORPHEUS_NVTX_ASYNC_RANGE(DomainT, message, rows) static_cast<void>(0)
+
+#endif
+
+/** @} */  // end of group
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <cstddef>  // for size_t, max_align_t
+#include <memory>   // for allocate_shared, shared_ptr
+#include <new>      // for operator new, operator delete
+#include <utility>  // for forward
+
+namespace morpheus {
+/**
+ * @addtogroup utilities
+ * @{
+ * @file
+ */
+
+namespace detail {
+/**
+ * @brief Per-thread caches of the freed blocks of a few small size classes, backing `PoolAllocator`. Blocks freed by
+ * a thread are reused by the next allocations of that thread, up to `MaxCachedBlocks` blocks per size class, beyond
+ * which they are returned to the heap. Blocks may be freed by a different thread than the one allocating them, such as
+ * a message created by one stage and destroyed by the next.
+ */
+struct MORPHEUS_EXPORT BlockCache
+{
+    static constexpr std::size_t Granularity     = alignof(std::max_align_t);
+    static constexpr std::size_t NumSizeClasses  = 32;
+    static constexpr std::size_t MaxBlockBytes   = Granularity * NumSizeClasses;
+    static constexpr std::size_t MaxCachedBlocks = 1024;
+
+    /**
+     * @brief Returns a block of at least `bytes`, which must not exceed `MaxBlockBytes`
+     */
+    static void* allocate(std::size_t bytes);
+
+    /**
+     * @brief Frees a block returned by `allocate` for the same `bytes`
+     */
+    static void deallocate(void* block, std::size_t bytes) noexcept;
+};
+}  // namespace detail
+
+/****** Component public implementations *******************/
+/****** PoolAllocator **************************************/
+
+/**
+ * @brief Allocator reusing the blocks freed by the calling thread, sparing the heap the churn of the small objects
+ * created for each message, such as the messages themselves, their memory and the control blocks of their
+ * `shared_ptr`. Single objects of up to `detail::BlockCache::MaxBlockBytes` are pooled, anything else is forwarded to
+ * the heap. Stateless, every instance can free the blocks of any other.
+ */
+template <typename T>
+struct PoolAllocator
+{
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& /*other*/) noexcept
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        if (is_pooled(n))
+        {
+            return static_cast<T*>(detail::BlockCache::allocate(sizeof(T)));
+        }
+
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        if (is_pooled(n))
+        {
+            detail::BlockCache::deallocate(ptr, sizeof(T));
+            return;
+        }
+
+        ::operator delete(ptr);
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& /*other*/) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& /*other*/) const noexcept
+    {
+        return false;
+    }
+
+  private:
+    static constexpr bool is_pooled(std::size_t n)
+    {
+        return n == 1 && sizeof(T) <= detail::BlockCache::MaxBlockBytes &&
+               alignof(T) <= detail::BlockCache::Granularity;
+    }
+};
+
+/**
+ * @brief Equivalent of `std::make_shared` allocating the object along with its control block from a `PoolAllocator`
+ */
+template <typename T, typename... ArgsT>
+std::shared_ptr<T> make_pooled(ArgsT&&... args)
+{
+    return std::allocate_shared<T>(PoolAllocator<T>{}, std::forward<ArgsT>(args)...);
+}
+/** @} */  // end of group
+}  // namespace morpheus
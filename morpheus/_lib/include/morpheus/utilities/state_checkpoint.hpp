@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <cudf/table/table.hpp>
+#include <nlohmann/json.hpp>
+
+#include <chrono>   // for milliseconds, steady_clock
+#include <cstdint>  // for int32_t, int64_t
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/**
+ * @addtogroup utilities
+ * @{
+ * @file
+ */
+
+/****** Component public implementations *******************/
+/****** StateSnapshot **************************************/
+
+/**
+ * @brief Copy of the state of a stage, its device resident part held as a table and the rest as JSON metadata
+ */
+struct MORPHEUS_EXPORT StateSnapshot
+{
+    std::unique_ptr<cudf::table> table;
+    std::vector<std::string> column_names;
+    nlohmann::json metadata;
+};
+
+/****** Checkpointable *************************************/
+
+/**
+ * @brief Interface of the state of a stage which can be saved by a `StateCheckpoint` and restored after a restart
+ */
+class MORPHEUS_EXPORT Checkpointable
+{
+  public:
+    virtual ~Checkpointable() = default;
+
+    /**
+     * @brief Copies the current state. The copy must not share any buffer which the state modifies later, since it is
+     * written out in the background.
+     *
+     * @return StateSnapshot : Snapshot without any column when there is no state to save
+     */
+    virtual StateSnapshot snapshot() = 0;
+
+    /**
+     * @brief Replaces the current state by `snapshot`, as returned by `snapshot` in a previous process
+     *
+     * @param snapshot
+     * @throws std::invalid_argument If the snapshot does not match the configuration of the state
+     */
+    virtual void restore(StateSnapshot snapshot) = 0;
+};
+
+/****** StateCheckpoint ************************************/
+
+/**
+ * @brief Periodically saves the state of a stage to a Parquet file named after the stage, such that a restarted
+ * pipeline resumes from the latest checkpoint rather than rebuilding its state by replaying hours of input.
+ *
+ * The state is copied on the device by the calling thread, then copied to the host and written by a background
+ * thread, to a temporary file renamed into place once complete. A checkpoint is skipped while the previous one is
+ * still being written.
+ *
+ * Checkpoints are coordinated with the offsets committed by the Kafka sources of the process, each checkpoint
+ * recording the offsets committed before its state was copied. Restoring a checkpoint asks the Kafka sources to resume
+ * their partitions from these offsets rather than from the offsets committed since, replaying the messages whose
+ * effect on the state was lost. The messages replayed are seen again by every stage of the pipeline.
+ *
+ * Checkpoints are disabled until a directory is set, which may be a local disk or a mounted object store. Failures to
+ * read or write a checkpoint are logged, the stage then running as if checkpoints were disabled.
+ */
+class MORPHEUS_EXPORT StateCheckpoint
+{
+  public:
+    using clock_t = std::chrono::steady_clock;
+
+    /**
+     * @brief Sets the directory holding the checkpoints, created on the first write. An empty directory disables
+     * checkpoints.
+     *
+     * @param directory
+     */
+    static void set_directory(std::string directory);
+
+    static std::string get_directory();
+
+    /**
+     * @brief Records the offset committed by a Kafka source for a partition, saved along with the next checkpoints
+     *
+     * @param topic
+     * @param partition
+     * @param offset : Offset of the next message to consume
+     */
+    static void record_committed_offset(const std::string& topic, int32_t partition, int64_t offset);
+
+    /**
+     * @brief Returns, and forgets, the offset a Kafka source should resume a newly assigned partition from, the lowest
+     * offset recorded by the checkpoints restored for it
+     *
+     * @param topic
+     * @param partition
+     * @return std::optional<int64_t> : Empty when no restored checkpoint recorded an offset for the partition
+     */
+    static std::optional<int64_t> take_replay_offset(const std::string& topic, int32_t partition);
+
+    /**
+     * @brief Construct a new State Checkpoint object
+     *
+     * @param name : Name of the stage, naming the file of its checkpoints
+     * @param interval : Minimum duration between two checkpoints. Checkpoints are disabled when zero
+     */
+    StateCheckpoint(std::string name, std::chrono::milliseconds interval);
+
+    /**
+     * @brief Waits for the checkpoint being written, if any
+     */
+    ~StateCheckpoint();
+
+    /**
+     * @brief Restores `state` from the latest checkpoint, registering the offsets it recorded for the Kafka sources
+     *
+     * @param state
+     * @return true : When a checkpoint was restored
+     */
+    bool restore(Checkpointable& state);
+
+    /**
+     * @brief Saves `state` when `interval` has elapsed since the last checkpoint and the previous one has been
+     * written
+     *
+     * @param state
+     * @param now
+     * @return true : When a checkpoint was started
+     */
+    bool maybe_save(Checkpointable& state, clock_t::time_point now = clock_t::now());
+
+    /**
+     * @brief Saves `state`, waiting for the previous checkpoint to be written first
+     *
+     * @param state
+     */
+    void save(Checkpointable& state);
+
+    /**
+     * @brief Waits for the checkpoint being written, if any
+     */
+    void wait();
+
+  private:
+    std::optional<std::filesystem::path> checkpoint_path() const;
+
+    // Writes `snapshot` along with `kafka_offsets` to `path`, run by the background thread
+    static void write(StateSnapshot snapshot, const nlohmann::json& kafka_offsets, const std::filesystem::path& path);
+
+    std::string m_name;
+    std::chrono::milliseconds m_interval;
+    clock_t::time_point m_last_save;
+
+    std::future<void> m_pending;
+};
+/** @} */  // end of group
+}  // namespace morpheus
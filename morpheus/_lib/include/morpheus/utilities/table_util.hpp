@@ -16,9 +16,12 @@
  */
 
 #include <cudf/io/types.hpp>
-#include <cudf/table/table.hpp>  // IWYU pragma: keep
+#include <cudf/table/table.hpp>       // IWYU pragma: keep
+#include <cudf/table/table_view.hpp>  // for table_view
 
+#include <memory>  // for unique_ptr
 #include <string>
+#include <vector>
 
 #pragma once
 
@@ -41,6 +44,43 @@ struct CuDFTableUtil
      * TODO(Documentation)
      */
     static cudf::io::table_with_metadata load_table(const std::string& filename);
+
+    /**
+     * @brief Concatenates the rows of `tables` into a single table, keeping the metadata of the first one.
+     *
+     * @throws std::runtime_error If `tables` is empty or the tables do not share the same column names
+     */
+    static cudf::io::table_with_metadata concatenate_tables(std::vector<cudf::io::table_with_metadata>&& tables);
+
+    /**
+     * @brief Returns whether the rows of `index` can be sliced by value, the same way as pandas' `is_unique and
+     * (is_monotonic_increasing or is_monotonic_decreasing)`. The check runs on the device, with one sort check per
+     * direction and a count of the distinct rows, without going through python. Indexes with nulls are not sliceable.
+     *
+     * @param index : Columns of the index, several columns being compared lexicographically like a `MultiIndex`
+     * @return bool
+     */
+    static bool is_sliceable_index(const cudf::table_view& index);
+
+    /**
+     * @brief Returns `table` with each of its dictionary columns decoded into a column of its values, for consumers
+     * which do not support dictionaries such as the CSV, JSON and Parquet writers. The decoded columns are appended to
+     * `decoded`, which must outlive the returned view. The other columns are not copied.
+     *
+     * @param table
+     * @param decoded : Owns the decoded columns
+     * @return cudf::table_view
+     */
+    static cudf::table_view decode_dictionaries(const cudf::table_view& table,
+                                                std::vector<std::unique_ptr<cudf::column>>& decoded);
+
+    /**
+     * @brief Copies the values of the string column `column`, which must not hold nulls, to host.
+     *
+     * @param column
+     * @return std::vector<std::string>
+     */
+    static std::vector<std::string> copy_strings_to_host(const cudf::column_view& column);
 };
 /** @} */  // end of group
 }  // namespace morpheus
@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <cstddef>  // for size_t
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** DeviceLocality*************************************/
+
+/**
+ * @addtogroup utilities
+ * @{
+ * @file
+ */
+
+/**
+ * @brief The NUMA node and the CPUs closest to a PCIe device, such as a GPU or a NIC, or to a NUMA node itself. Threads
+ * bound to these CPUs and host memory allocated on this node reach the device without crossing the socket
+ * interconnect.
+ */
+struct MORPHEUS_EXPORT DeviceLocality
+{
+    std::string pci_address;  // Empty unless located from a PCIe device
+    int numa_node{-1};        // -1 when unknown, such as on single socket hosts
+    std::vector<int> cpus;
+
+    /**
+     * @brief Returns true when nothing is known of the locality, nothing is bound to it then
+     *
+     * @return bool
+     */
+    bool empty() const;
+
+    /**
+     * @brief Human readable description of the locality, for logging
+     *
+     * @return std::string
+     */
+    std::string to_string() const;
+};
+
+/****** TopologyUtil***************************************/
+/**
+ * @brief Discovers the host topology from sysfs, and places threads and host memory on it. Only supported on Linux,
+ * every locality being empty otherwise.
+ */
+struct MORPHEUS_EXPORT TopologyUtil
+{
+    /**
+     * @brief Returns the locality of the GPU `device_id`
+     *
+     * @param device_id
+     * @return DeviceLocality
+     */
+    static DeviceLocality gpu_locality(int device_id);
+
+    /**
+     * @brief Returns the locality of the PCIe device at `pci_address`, such as `0000:3b:00.0` or `3b:00.0`
+     *
+     * @param pci_address
+     * @return DeviceLocality
+     */
+    static DeviceLocality pci_locality(const std::string& pci_address);
+
+    /**
+     * @brief Returns the locality of the NUMA node `numa_node`
+     *
+     * @param numa_node
+     * @return DeviceLocality
+     */
+    static DeviceLocality numa_locality(int numa_node);
+
+    /**
+     * @brief Resolves the placement option of a stage, one of:
+     * - empty : no placement, the locality is empty
+     * - `gpu` : the current GPU
+     * - `gpu:N` : the GPU `N`
+     * - `numa:N` : the NUMA node `N`
+     * - a PCI address : the PCIe device at this address, such as a NIC
+     *
+     * @param placement
+     * @return DeviceLocality
+     * @throws std::invalid_argument If `placement` is malformed
+     */
+    static DeviceLocality resolve_placement(const std::string& placement);
+
+    /**
+     * @brief Parses a sysfs CPU list, such as `0-3,8,10-11`
+     *
+     * @param cpu_list
+     * @return std::vector<int>
+     * @throws std::invalid_argument If `cpu_list` is malformed
+     */
+    static std::vector<int> parse_cpu_list(const std::string& cpu_list);
+
+    /**
+     * @brief Binds the calling thread to the CPUs of `locality`. A no-op returning false for an empty locality, or
+     * when the binding fails.
+     *
+     * @param locality
+     * @return bool : Whether the thread was bound
+     */
+    static bool bind_current_thread(const DeviceLocality& locality);
+
+    /**
+     * @brief Binds the pages of `[data, data + bytes)` to `numa_node`, before they are first touched. `data` must be
+     * page aligned.
+     *
+     * @param data
+     * @param bytes
+     * @param numa_node
+     * @return bool : Whether the memory was bound
+     */
+    static bool bind_memory(void* data, std::size_t bytes, int numa_node);
+
+    /**
+     * @brief Human readable description of the CPUs the calling thread may run on and of the NUMA node it runs on,
+     * for logging
+     *
+     * @return std::string
+     */
+    static std::string describe_current_thread();
+};
+/** @} */  // end of group
+}  // namespace morpheus
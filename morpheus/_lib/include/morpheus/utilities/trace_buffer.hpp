@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/**
+ * @addtogroup utilities
+ * @{
+ * @file
+ */
+
+/**
+ * @brief Id of a traced event, assigned by `TraceBuffer::register_event`
+ */
+using trace_event_t = uint32_t;
+
+/**
+ * @brief Fixed size record of a traced event
+ */
+struct TraceRecord
+{
+    uint64_t timestamp_ns;  // Nanoseconds since the epoch of the system clock
+    trace_event_t event;
+    uint32_t thread;  // Index of the thread, assigned in order of first use
+    std::array<int64_t, 4> args;
+};
+
+/****** Component public implementations *******************/
+/****** TraceBuffer ****************************************/
+
+/**
+ * @brief Binary tracing of hot paths, cheap enough to be left enabled at production rates. Each thread records into a
+ * ring buffer of its own the last `RecordsPerThread` events, as fixed size records of an event id, a timestamp and a
+ * few integer arguments. Recording takes no lock and makes no allocation, save for the buffer of a thread on its first
+ * record. The buffers are dumped to a binary file on demand, on a signal or when a traced component reports an error,
+ * to be decoded by `morpheus.utils.trace_decoder`.
+ *
+ * Events are recorded with the `MORPHEUS_TRACE` macro, which does nothing while tracing is disabled.
+ */
+class MORPHEUS_EXPORT TraceBuffer
+{
+  public:
+    static constexpr std::size_t RecordsPerThread = 1 << 14;
+
+    static bool is_enabled();
+
+    static void set_enabled(bool enabled);
+
+    /**
+     * @brief Returns the id of the event named `name`, registering it on the first call
+     *
+     * @param name
+     * @return trace_event_t
+     */
+    static trace_event_t register_event(const std::string& name);
+
+    /**
+     * @brief Records `event` into the buffer of the calling thread, regardless of whether tracing is enabled
+     */
+    static void record(trace_event_t event, int64_t arg0 = 0, int64_t arg1 = 0, int64_t arg2 = 0, int64_t arg3 = 0);
+
+    /**
+     * @brief Returns the records held by the buffers of every thread, ordered by timestamp. Records being overwritten
+     * while they are read are skipped.
+     *
+     * @return std::vector<TraceRecord>
+     */
+    static std::vector<TraceRecord> snapshot();
+
+    /**
+     * @brief Returns the names of the registered events, indexed by id
+     *
+     * @return std::vector<std::string>
+     */
+    static std::vector<std::string> event_names();
+
+    /**
+     * @brief Writes the event names and the records of every thread to `path`, replacing it
+     *
+     * @param path
+     * @throws std::runtime_error If the file cannot be written
+     */
+    static void dump(const std::string& path);
+
+    /**
+     * @brief Dumps the buffers to `path` each time the process receives `signal`, from a thread started by the first
+     * call. Later calls replace the signal and path.
+     *
+     * @param signal : Signal number, such as SIGUSR2
+     * @param path
+     */
+    static void dump_on_signal(int signal, const std::string& path);
+
+    /**
+     * @brief Dumps the buffers to `path` each time `on_error` is called, at most once every `min_interval_seconds`.
+     * Later calls replace the path and interval.
+     *
+     * @param path
+     * @param min_interval_seconds
+     */
+    static void dump_on_error(const std::string& path, int min_interval_seconds = 10);
+
+    /**
+     * @brief Called by traced components on errors, such as a failed consume, to dump the buffers to the path given to
+     * `dump_on_error`. Does nothing when none was given. Failures to dump are logged rather than thrown.
+     */
+    static void on_error();
+};
+
+/**
+ * @brief Records the event named by the string literal `name` with up to four integer arguments, when tracing is
+ * enabled. The id of the event is registered by the first record.
+ */
+#define MORPHEUS_TRACE(name, ...)                                                           \
+    do                                                                                      \
+    {                                                                                       \
+        if (::morpheus::TraceBuffer::is_enabled())                                          \
+        {                                                                                   \
+            static const auto _trace_event = ::morpheus::TraceBuffer::register_event(name); \
+            ::morpheus::TraceBuffer::record(_trace_event __VA_OPT__(, ) __VA_ARGS__);       \
+        }                                                                                   \
+    } while (0)
+
+/** @} */  // end of group
+}  // namespace morpheus
@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "morpheus/export.h"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace morpheus {
+/**
+ * @addtogroup utilities
+ * @{
+ * @file
+ */
+
+/****** Component public implementations *******************/
+/****** WarmStartCache *************************************/
+
+/**
+ * @brief On-disk cache of artifacts derived from input files, such as the device-ready layout of a vocabulary,
+ * allowing a restarted process to skip deriving them again. Each entry is keyed by the kind of artifact along with the
+ * path, size and modification time of the file it was derived from, such that a changed file misses the cache.
+ *
+ * The cache is disabled until a directory is set. Failures to read or write an entry are logged, the caller then
+ * deriving the artifact as if the cache were disabled.
+ */
+class MORPHEUS_EXPORT WarmStartCache
+{
+  public:
+    /**
+     * @brief Sets the directory holding the entries, created on the first write. An empty directory disables the
+     * cache.
+     *
+     * @param directory
+     */
+    static void set_directory(std::string directory);
+
+    static std::string get_directory();
+
+    /**
+     * @brief Reads the entry of `kind` derived from `source_file`
+     *
+     * @param kind : Kind of artifact, such as `vocab`, part of the file name of the entry
+     * @param source_file
+     * @return std::optional<std::string> : Contents of the entry, empty when the cache is disabled or misses
+     */
+    static std::optional<std::string> read(const std::string& kind, const std::string& source_file);
+
+    /**
+     * @brief Writes `contents` as the entry of `kind` derived from `source_file`, replacing any previous entry. The
+     * entry is written to a temporary file renamed into place, such that concurrent processes never read a partial
+     * entry. Does nothing when the cache is disabled.
+     *
+     * @param kind : Kind of artifact, such as `vocab`, part of the file name of the entry
+     * @param source_file
+     * @param contents
+     */
+    static void write(const std::string& kind, const std::string& source_file, const std::string& contents);
+
+  private:
+    static std::optional<std::filesystem::path> entry_path(const std::string& kind, const std::string& source_file);
+};
+/** @} */  // end of group
+}  // namespace morpheus
@@ -14,6 +14,8 @@ import mrc.core.segment
 
 __all__ = [
     "InputMap",
+    "LLMAdmissionController",
+    "LLMBatchingNode",
     "LLMContext",
     "LLMEngine",
     "LLMEngineStage",
@@ -21,6 +23,7 @@ __all__ = [
     "LLMNode",
     "LLMNodeBase",
     "LLMNodeRunner",
+    "LLMPromptTemplateNode",
     "LLMTask",
     "LLMTaskHandler"
 ]
@@ -68,12 +71,24 @@ class LLMContext():
     @typing.overload
     def get_input(self, node_name: str) -> object: ...
     def get_inputs(self) -> dict: ...
+    def is_streaming(self) -> bool: ...
     def message(self) -> morpheus._lib.messages.ControlMessage: ...
     def push(self, name: str, inputs: typing.List[InputMap]) -> LLMContext: ...
     @typing.overload
-    def set_output(self, output_name: str, output: object) -> None: ...
+    def set_output(self, output_name: str, output: object) -> None: 
+        """
+        Set an output value for this context. Columnar values, such as a `pyarrow.Array` or a `cudf.Series`,
+        are held as is and returned as is to python nodes reading them, they are only converted to lists when
+        read from C++ nodes or through `view_outputs`.
+        """
     @typing.overload
     def set_output(self, outputs: object) -> None: ...
+    def stream_output(self, chunk: object) -> None: 
+        """
+        Write a partial output of this context, such as the tokens generated so far, before its outputs are
+        set. The chunk is dropped unless the engine runs in an `LLMEngineStage` with `streaming` set, which
+        emits it as a `ControlMessage` ahead of the output messages.
+        """
     def task(self) -> LLMTask: ...
     @property
     def full_name(self) -> str:
@@ -128,13 +143,90 @@ class LLMNodeBase():
         """
     pass
 class LLMEngineStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, engine: LLMEngine) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, engine: LLMEngine, max_concurrency: int = 0, streaming: bool = False, trace: bool = False) -> None: ...
+    pass
+class LLMAdmissionController():
+    def __init__(self, max_requests_per_second: float, max_tokens_per_minute: float = 0.0, min_rate_fraction: float = 0.1, increase_fraction: float = 0.05) -> None: 
+        """
+        Admits the calls made to an LLM service, shared by the clients of the service such that their
+        concurrent calls stay within its budgets together. Calls beyond the budgets wait in a single queue and
+        are admitted in the order they arrived. The request rate decreases multiplicatively on rate limit
+        errors and increases additively with each successful call.
+
+        Parameters
+        ----------
+        max_requests_per_second : float
+            Maximum rate of requests.
+
+        max_tokens_per_minute : float, optional
+            Maximum rate of tokens, prompt and completion, by default 0 for no limit.
+
+        min_rate_fraction : float, optional
+            Fraction of `max_requests_per_second` the rate is never decreased below, by default 0.1
+
+        increase_fraction : float, optional
+            Fraction of `max_requests_per_second` the rate increases by with each successful call, by
+            default 0.05
+        """
+    def acquire(self, tokens: int = 0) -> typing.Awaitable[float]: 
+        """
+        Wait for a call using `tokens` tokens to be admitted, returning the seconds it waited.
+        """
+    def on_rate_limited(self, headers: typing.Dict[str, str] = {}) -> None: ...
+    def on_success(self, headers: typing.Dict[str, str] = {}) -> None: ...
+    @property
+    def num_waiting(self) -> int:
+        """
+        :type: int
+        """
+    @property
+    def requests_per_second(self) -> float:
+        """
+        :type: float
+        """
+    pass
+class LLMBatchingNode(LLMNodeBase):
+    def __init__(self, node: LLMNodeBase, max_batch_size: int = 32, max_delay_ms: float = 10.0) -> None: 
+        """
+        Wrap a node whose inputs are lists, such as `LLMGenerateNode`, batching the inputs of the contexts
+        executing concurrently across messages into a single execution of the wrapped node.
+
+        Parameters
+        ----------
+        node : LLMNodeBase
+            The node to execute on the batched inputs. Its output must be a list, or a dict of lists, holding
+            one value per input row.
+
+        max_batch_size : int, optional
+            Maximum number of rows in a batch, by default 32
+
+        max_delay_ms : float, optional
+            Maximum time in milliseconds a batch waits for more contexts before being dispatched, by default 10
+        """
+    def execute(self, context: LLMContext) -> typing.Awaitable[LLMContext]: ...
+    def get_input_names(self) -> typing.List[str]: ...
     pass
 class LLMLambdaNode(LLMNodeBase):
     def __init__(self, fn: function) -> None: ...
     def execute(self, context: LLMContext) -> typing.Awaitable[LLMContext]: ...
     def get_input_names(self) -> typing.List[str]: ...
     pass
+class LLMPromptTemplateNode(LLMNodeBase):
+    def __init__(self, template: str) -> None: 
+        """
+        Populate an f-string style template, such as `"Hello {name}!"`, with the values of its inputs for
+        every row. The template is parsed once, rows being formatted without executing any python code.
+
+        Parameters
+        ----------
+        template : str
+            The template to populate. Fields must be named, without a format spec or conversion.
+        """
+    def execute(self, context: LLMContext) -> typing.Awaitable[LLMContext]: ...
+    def get_input_names(self) -> typing.List[str]: ...
+    @staticmethod
+    def is_supported(template: str) -> bool: ...
+    pass
 class LLMNode(LLMNodeBase):
     def __init__(self) -> None: ...
     def add_node(self, name: str, *, inputs: object = None, node: LLMNodeBase, is_output: bool = False) -> LLMNodeRunner: 
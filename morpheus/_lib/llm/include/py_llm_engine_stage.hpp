@@ -19,8 +19,10 @@
 #include "py_llm_node.hpp"
 
 #include "morpheus/export.h"
+#include "morpheus/llm/async_semaphore.hpp"
 #include "morpheus/llm/input_map.hpp"
 #include "morpheus/llm/llm_engine.hpp"
+#include "morpheus/llm/llm_output_stream.hpp"
 #include "morpheus/llm/llm_task_handler.hpp"
 #include "morpheus/messages/control.hpp"
 #include "morpheus/types.hpp"
@@ -50,6 +52,7 @@
 #include <mrc/runnable/runnable.hpp>
 #include <mrc/segment/builder.hpp>
 #include <mrc/segment/object.hpp>
+#include <nlohmann/json.hpp>
 #include <pybind11/gil.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
@@ -63,6 +66,7 @@
 #include <condition_variable>
 #include <coroutine>
 #include <cstddef>
+#include <exception>
 #include <functional>
 #include <map>
 #include <memory>
@@ -71,23 +75,49 @@
 #include <stdexcept>
 #include <stop_token>
 #include <utility>
+#include <vector>
 
 namespace morpheus::llm {
 namespace py = pybind11;
 
+/**
+ * @brief Runs an `LLMEngine` on each message. Messages are processed concurrently by the `AsyncioRunnable`, while the
+ * `llm_engine` tasks of a message execute concurrently within the engine. When `max_concurrency` is not 0, the number
+ * of contexts executing across every message is bounded by a semaphore, keeping the requests made to rate limited LLM
+ * services under their quota while the remaining tasks wait without blocking the event loop.
+ *
+ * When `streaming` is set, the partial outputs written by the nodes with `LLMContext::stream_output` are emitted as they
+ * arrive, ahead of the output messages. Each is emitted as a `ControlMessage` sharing the payload of the input message,
+ * with its `llm_stream` metadata holding the `node` which wrote the `chunk`.
+ *
+ * When `trace` is set, the spans of each task are appended to the `llm_trace` metadata of its output messages, see
+ * `LLMEngine::run`.
+ */
 class MORPHEUS_EXPORT PyLLMEngineStage
   : public mrc::pymrc::AsyncioRunnable<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>
 {
   public:
-    PyLLMEngineStage(std::shared_ptr<LLMEngine> engine) : m_engine(std::move(engine)) {}
+    PyLLMEngineStage(std::shared_ptr<LLMEngine> engine,
+                     std::size_t max_concurrency = 0,
+                     bool streaming              = false,
+                     bool trace                  = false) :
+      m_engine(std::move(engine)),
+      m_concurrency_limit(max_concurrency > 0 ? std::make_shared<AsyncSemaphore>(max_concurrency) : nullptr),
+      m_streaming(streaming),
+      m_trace(trace)
+    {}
 
     ~PyLLMEngineStage() override = default;
 
     static std::shared_ptr<mrc::segment::Object<PyLLMEngineStage>> init(mrc::segment::Builder& builder,
                                                                         const std::string& name,
-                                                                        std::shared_ptr<LLMEngine> engine)
+                                                                        std::shared_ptr<LLMEngine> engine,
+                                                                        std::size_t max_concurrency,
+                                                                        bool streaming,
+                                                                        bool trace)
     {
-        auto stage = builder.construct_object<PyLLMEngineStage>(name, std::move(engine));
+        auto stage = builder.construct_object<PyLLMEngineStage>(
+            name, std::move(engine), max_concurrency, streaming, trace);
 
         return stage;
     }
@@ -96,9 +126,51 @@ class MORPHEUS_EXPORT PyLLMEngineStage
     mrc::coroutines::AsyncGenerator<std::shared_ptr<ControlMessage>> on_data(
         std::shared_ptr<ControlMessage>&& data, std::shared_ptr<mrc::coroutines::Scheduler> on) override
     {
-        auto result = co_await m_engine->run(std::move(data));
+        if (!m_streaming)
+        {
+            auto result = co_await m_engine->run(std::move(data), m_concurrency_limit, nullptr, m_trace);
+
+            // Push the output messages
+            for (auto&& out_message : result)
+            {
+                co_yield std::move(out_message);
+            }
+
+            co_return;
+        }
+
+        // Nodes write chunks from whichever thread they run on, the reader is rescheduled rather than resumed there
+        auto output_stream = std::make_shared<LLMOutputStream>([on](std::coroutine_handle<> handle) {
+            on->resume(handle);
+        });
+
+        auto payload = data->payload();
+
+        std::vector<std::shared_ptr<ControlMessage>> result;
+        std::exception_ptr error;
+
+        mrc::coroutines::TaskContainer tasks(on);
+
+        tasks.start(this->run_engine(std::move(data), output_stream, result, error));
+
+        while (auto chunk = co_await output_stream->read())
+        {
+            auto partial_message = std::make_shared<ControlMessage>();
+            partial_message->payload(payload);
+            partial_message->set_metadata("llm_stream",
+                                          nlohmann::json{{"node", chunk->node_name}, {"chunk", std::move(chunk->chunk)}});
+
+            co_yield std::move(partial_message);
+        }
+
+        // The stream is closed as the engine completes, wait for the task to finish before reading its result
+        co_await tasks.garbage_collect_and_yield_until_empty();
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
 
-        // Push the output messages
         for (auto&& out_message : result)
         {
             co_yield std::move(out_message);
@@ -107,7 +179,26 @@ class MORPHEUS_EXPORT PyLLMEngineStage
         co_return;
     }
 
+    Task<void> run_engine(std::shared_ptr<ControlMessage> data,
+                          std::shared_ptr<LLMOutputStream> output_stream,
+                          std::vector<std::shared_ptr<ControlMessage>>& result,
+                          std::exception_ptr& error)
+    {
+        try
+        {
+            result = co_await m_engine->run(std::move(data), m_concurrency_limit, output_stream, m_trace);
+        } catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        output_stream->close();
+    }
+
     std::shared_ptr<LLMEngine> m_engine;
+    std::shared_ptr<AsyncSemaphore> m_concurrency_limit;
+    bool m_streaming;
+    bool m_trace;
 };
 
 }  // namespace morpheus::llm
@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/llm/llm_output_column.hpp"
+
+#include <nlohmann/json.hpp>
+#include <pybind11/pytypes.h>
+
+namespace morpheus::llm {
+
+/**
+ * @brief Output column backed by a python object, such as a `pyarrow.Array` or a `cudf.Series`. Python nodes reading
+ * the column receive the object itself, while nodes reading it as JSON convert it through `to_pylist`.
+ */
+class PyLLMOutputColumn : public LLMOutputColumn
+{
+  public:
+    PyLLMOutputColumn(pybind11::object column);
+
+    ~PyLLMOutputColumn() override;
+
+    /**
+     * @brief Whether `value` has a columnar representation which can be held without converting it to JSON.
+     */
+    static bool is_column(const pybind11::handle& value);
+
+    pybind11::object get_column() const;
+
+    nlohmann::json to_json() const override;
+
+  private:
+    pybind11::object m_column;
+};
+
+}  // namespace morpheus::llm
@@ -21,14 +21,18 @@
 #include "./include/py_llm_task_handler.hpp"
 #include "py_llm_engine_stage.hpp"
 #include "py_llm_lambda_node.hpp"
+#include "py_llm_output_column.hpp"
 
 #include "morpheus/llm/fwd.hpp"
 #include "morpheus/llm/input_map.hpp"
+#include "morpheus/llm/llm_admission_controller.hpp"
+#include "morpheus/llm/llm_batching_node.hpp"
 #include "morpheus/llm/llm_context.hpp"
 #include "morpheus/llm/llm_engine.hpp"
 #include "morpheus/llm/llm_node.hpp"
 #include "morpheus/llm/llm_node_base.hpp"
 #include "morpheus/llm/llm_node_runner.hpp"
+#include "morpheus/llm/llm_prompt_template_node.hpp"
 #include "morpheus/llm/llm_task.hpp"
 #include "morpheus/llm/llm_task_handler.hpp"
 #include "morpheus/messages/control.hpp"    // IWYU pragma: keep
@@ -59,6 +63,31 @@
 namespace morpheus::llm {
 namespace py = pybind11;
 
+namespace {
+// Returns python columns as is, converting other inputs from JSON
+py::object get_input_object(const LLMContext& self, const std::string& node_name)
+{
+    if (auto column = std::dynamic_pointer_cast<PyLLMOutputColumn>(self.get_input_column(node_name)))
+    {
+        return column->get_column();
+    }
+
+    return mrc::pymrc::cast_from_json(self.get_input(node_name));
+}
+
+void set_output_object(LLMContext& self, const std::string& output_name, py::object output)
+{
+    if (PyLLMOutputColumn::is_column(output))
+    {
+        self.set_output_column(output_name, std::make_shared<PyLLMOutputColumn>(std::move(output)));
+    }
+    else
+    {
+        self.set_output(output_name, mrc::pymrc::cast_from_pyobject(output));
+    }
+}
+}  // namespace
+
 PYBIND11_MODULE(llm, _module)
 {
     _module.doc() = R"pbdoc(
@@ -194,20 +223,60 @@ PYBIND11_MODULE(llm, _module)
         .def_property_readonly("parent", &LLMContext::parent)
         .def("task", &LLMContext::task)
         .def("message", &LLMContext::message)
-        .def("get_input", py::overload_cast<>(&LLMContext::get_input, py::const_))
         .def("get_input",
-             py::overload_cast<const std::string&>(&LLMContext::get_input, py::const_),
-             py::arg("node_name"))
+             [](LLMContext& self) {
+                 if (self.input_map().size() != 1)
+                 {
+                     return mrc::pymrc::cast_from_json(self.get_input());
+                 }
+
+                 return get_input_object(self, self.input_map()[0].internal_name);
+             })
+        .def("get_input", &get_input_object, py::arg("node_name"))
         .def("get_inputs",
              [](LLMContext& self) {
-                 // Convert the return value
-                 return mrc::pymrc::cast_from_json(self.get_inputs()).cast<py::dict>();
+                 py::dict inputs;
+                 for (const auto& input : self.input_map())
+                 {
+                     inputs[py::str(input.internal_name)] = get_input_object(self, input.internal_name);
+                 }
+
+                 return inputs;
              })
-        .def("set_output", py::overload_cast<nlohmann::json>(&LLMContext::set_output), py::arg("outputs"))
+        .def(
+            "set_output",
+            [](LLMContext& self, py::object outputs) {
+                if (PyLLMOutputColumn::is_column(outputs))
+                {
+                    self.set_output_column(std::make_shared<PyLLMOutputColumn>(std::move(outputs)));
+                }
+                else
+                {
+                    self.set_output(mrc::pymrc::cast_from_pyobject(outputs));
+                }
+            },
+            py::arg("outputs"))
         .def("set_output",
-             py::overload_cast<const std::string&, nlohmann::json>(&LLMContext::set_output),
+             &set_output_object,
              py::arg("output_name"),
-             py::arg("output"))
+             py::arg("output"),
+             R"pbdoc(
+                Set an output value for this context. Columnar values, such as a `pyarrow.Array` or a `cudf.Series`,
+                are held as is and returned as is to python nodes reading them, they are only converted to lists when
+                read from C++ nodes or through `view_outputs`.
+            )pbdoc")
+        .def("is_streaming", &LLMContext::is_streaming)
+        .def(
+            "stream_output",
+            [](LLMContext& self, py::object chunk) {
+                self.stream_output(mrc::pymrc::cast_from_pyobject(chunk));
+            },
+            py::arg("chunk"),
+            R"pbdoc(
+                Write a partial output of this context, such as the tokens generated so far, before its outputs are
+                set. The chunk is dropped unless the engine runs in an `LLMEngineStage` with `streaming` set, which
+                emits it as a `ControlMessage` ahead of the output messages.
+            )pbdoc")
         .def("push", &LLMContext::push, py::arg("name"), py::arg("inputs"));
 
     py::class_<LLMNodeBase, PyLLMNodeBase<>, std::shared_ptr<LLMNodeBase>>(_module, "LLMNodeBase")
@@ -328,7 +397,7 @@ PYBIND11_MODULE(llm, _module)
     py::class_<LLMEngine, LLMNode, PyLLMEngine, std::shared_ptr<LLMEngine>>(_module, "LLMEngine")
         .def(py::init_alias<>())
         .def("add_task_handler", &LLMEngine::add_task_handler, py::arg("inputs"), py::arg("handler"))
-        .def("run", &LLMEngine::run, py::arg("message"));
+        .def("run", py::overload_cast<std::shared_ptr<ControlMessage>>(&LLMEngine::run), py::arg("message"));
 
     py::class_<PyLLMLambdaNode, LLMNodeBase, std::shared_ptr<PyLLMLambdaNode>>(_module, "LLMLambdaNode")
         .def(py::init<>([](py::function fn) {
@@ -338,11 +407,111 @@ PYBIND11_MODULE(llm, _module)
         .def("get_input_names", &PyLLMLambdaNode::get_input_names)
         .def("execute", &PyLLMLambdaNode::execute, py::arg("context"));
 
+    py::class_<LLMBatchingNode, LLMNodeBase, std::shared_ptr<LLMBatchingNode>>(_module, "LLMBatchingNode")
+        .def(py::init<>([](std::shared_ptr<LLMNodeBase> node, std::size_t max_batch_size, double max_delay_ms) {
+                 return std::make_shared<LLMBatchingNode>(
+                     std::move(node),
+                     max_batch_size,
+                     std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::duration<double, std::milli>(max_delay_ms)));
+             }),
+             py::arg("node"),
+             py::arg("max_batch_size") = 32,
+             py::arg("max_delay_ms")   = 10.0,
+             // The wrapped node may be implemented in python
+             py::keep_alive<1, 2>(),
+             R"pbdoc(
+                Wrap a node whose inputs are lists, such as `LLMGenerateNode`, batching the inputs of the contexts
+                executing concurrently across messages into a single execution of the wrapped node.
+
+                Parameters
+                ----------
+                node : LLMNodeBase
+                    The node to execute on the batched inputs. Its output must be a list, or a dict of lists, holding
+                    one value per input row.
+
+                max_batch_size : int, optional
+                    Maximum number of rows in a batch, by default 32
+
+                max_delay_ms : float, optional
+                    Maximum time in milliseconds a batch waits for more contexts before being dispatched, by default 10
+
+            )pbdoc")
+        .def("get_input_names", &LLMBatchingNode::get_input_names)
+        .def("execute", &LLMBatchingNode::execute, py::arg("context"));
+
+    py::class_<LLMAdmissionController, std::shared_ptr<LLMAdmissionController>>(_module, "LLMAdmissionController")
+        .def(py::init<double, double, double, double>(),
+             py::arg("max_requests_per_second"),
+             py::arg("max_tokens_per_minute") = 0.0,
+             py::arg("min_rate_fraction")     = 0.1,
+             py::arg("increase_fraction")     = 0.05,
+             R"pbdoc(
+                Admits the calls made to an LLM service, shared by the clients of the service such that their
+                concurrent calls stay within its budgets together. Calls beyond the budgets wait in a single queue and
+                are admitted in the order they arrived. The request rate decreases multiplicatively on rate limit
+                errors and increases additively with each successful call.
+
+                Parameters
+                ----------
+                max_requests_per_second : float
+                    Maximum rate of requests.
+
+                max_tokens_per_minute : float, optional
+                    Maximum rate of tokens, prompt and completion, by default 0 for no limit.
+
+                min_rate_fraction : float, optional
+                    Fraction of `max_requests_per_second` the rate is never decreased below, by default 0.1
+
+                increase_fraction : float, optional
+                    Fraction of `max_requests_per_second` the rate increases by with each successful call, by
+                    default 0.05
+
+            )pbdoc")
+        .def("acquire",
+             &LLMAdmissionController::acquire,
+             py::arg("tokens") = 0,
+             R"pbdoc(
+                Wait for a call using `tokens` tokens to be admitted, returning the seconds it waited.
+            )pbdoc")
+        .def("on_success", &LLMAdmissionController::on_success, py::arg("headers") = LLMAdmissionController::headers_t{})
+        .def("on_rate_limited",
+             &LLMAdmissionController::on_rate_limited,
+             py::arg("headers") = LLMAdmissionController::headers_t{})
+        .def_property_readonly("requests_per_second", &LLMAdmissionController::requests_per_second)
+        .def_property_readonly("num_waiting", &LLMAdmissionController::num_waiting);
+
+    py::class_<LLMPromptTemplateNode, LLMNodeBase, std::shared_ptr<LLMPromptTemplateNode>>(_module,
+                                                                                         "LLMPromptTemplateNode")
+        .def(py::init<>([](const std::string& template_str) {
+                 return std::make_shared<LLMPromptTemplateNode>(template_str);
+             }),
+             py::arg("template"),
+             R"pbdoc(
+                Populate an f-string style template, such as `"Hello {name}!"`, with the values of its inputs for
+                every row. The template is parsed once, rows being formatted without executing any python code.
+
+                Parameters
+                ----------
+                template : str
+                    The template to populate. Fields must be named, without a format spec or conversion.
+
+            )pbdoc")
+        .def_static("is_supported", &LLMPromptTemplateNode::is_supported, py::arg("template"))
+        .def("get_input_names", &LLMPromptTemplateNode::get_input_names)
+        .def("execute", &LLMPromptTemplateNode::execute, py::arg("context"));
+
     py::class_<mrc::segment::Object<PyLLMEngineStage>,
                mrc::segment::ObjectProperties,
                std::shared_ptr<mrc::segment::Object<PyLLMEngineStage>>>(
         _module, "LLMEngineStage", py::multiple_inheritance())
-        .def(py::init<>(&PyLLMEngineStage::init), py::arg("builder"), py::arg("name"), py::arg("engine"));
+        .def(py::init<>(&PyLLMEngineStage::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("engine"),
+             py::arg("max_concurrency") = 0,
+             py::arg("streaming")       = false,
+             py::arg("trace")           = false);
 
     _module.attr("__version__") =
         MRC_CONCAT_STR(morpheus_VERSION_MAJOR << "." << morpheus_VERSION_MINOR << "." << morpheus_VERSION_PATCH);
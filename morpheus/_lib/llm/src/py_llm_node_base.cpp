@@ -21,12 +21,15 @@
 #include "morpheus/llm/llm_engine.hpp"
 #include "morpheus/llm/llm_node.hpp"
 #include "morpheus/llm/llm_node_base.hpp"
+#include "morpheus/llm/llm_trace.hpp"
 
 #include <mrc/coroutines/task.hpp>  // IWYU pragma: keep
+#include <pybind11/gil.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>  // IWYU pragma: keep
 #include <pymrc/coro.hpp>  // IWYU pragma: keep
 
+#include <chrono>
 #include <coroutine>
 
 namespace morpheus::llm {
@@ -40,9 +43,28 @@ std::vector<std::string> PyLLMNodeBase<BaseT>::get_input_names() const
     MRC_PYBIND11_OVERRIDE_PURE_TEMPLATE(std::vector<std::string>, LLMNodeBase, BaseT, get_input_names);
 }
 
+namespace {
+LLMSpanRecorder& gil_span_recorder()
+{
+    static LLMSpanRecorder recorder{"gil"};
+    return recorder;
+}
+}  // namespace
+
 template <class BaseT>
 Task<std::shared_ptr<LLMContext>> PyLLMNodeBase<BaseT>::execute(std::shared_ptr<LLMContext> context)
 {
+    if (context->trace())
+    {
+        // Probes how long the node waits for the GIL before its python code can run, only paid when tracing
+        auto started_at = std::chrono::system_clock::now();
+        {
+            pybind11::gil_scoped_acquire gil;
+        }
+
+        gil_span_recorder().record(*context, started_at, std::chrono::system_clock::now());
+    }
+
     MRC_PYBIND11_OVERRIDE_CORO_PURE_TEMPLATE(std::shared_ptr<LLMContext>, LLMNodeBase, BaseT, execute, context);
 }
 
@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "py_llm_output_column.hpp"
+
+#include <pybind11/gil.h>
+#include <pybind11/pybind11.h>
+#include <pymrc/utils.hpp>
+
+#include <utility>
+
+namespace morpheus::llm {
+namespace py = pybind11;
+
+PyLLMOutputColumn::PyLLMOutputColumn(pybind11::object column) : m_column(std::move(column)) {}
+
+PyLLMOutputColumn::~PyLLMOutputColumn()
+{
+    // The last reference can be released by a thread which does not hold the GIL
+    py::gil_scoped_acquire gil;
+    m_column = py::object();
+}
+
+bool PyLLMOutputColumn::is_column(const pybind11::handle& value)
+{
+    // pyarrow arrays expose `to_pylist`, cudf series expose `to_arrow`
+    return py::hasattr(value, "to_pylist") || py::hasattr(value, "to_arrow");
+}
+
+pybind11::object PyLLMOutputColumn::get_column() const
+{
+    py::gil_scoped_acquire gil;
+    return m_column;
+}
+
+nlohmann::json PyLLMOutputColumn::to_json() const
+{
+    py::gil_scoped_acquire gil;
+
+    py::object column = m_column;
+    if (!py::hasattr(column, "to_pylist"))
+    {
+        column = column.attr("to_arrow")();
+    }
+
+    return mrc::pymrc::cast_from_pyobject(column.attr("to_pylist")());
+}
+
+}  // namespace morpheus::llm
@@ -7,6 +7,7 @@
         """
 from __future__ import annotations
 import morpheus._lib.messages
+import datetime
 import typing
 import cupy
 import morpheus._lib.common
@@ -32,6 +33,7 @@ __all__ = [
     "ResponseMemory",
     "ResponseMemoryProbs",
     "TensorMemory",
+    "TimestampTraceExporter",
     "cupy"
 ]
 
@@ -48,6 +50,7 @@ class ControlMessage():
     def config(self) -> dict: ...
     @typing.overload
     def config(self, config: dict) -> None: ...
+    def clone(self) -> ControlMessage: ...
     def copy(self) -> ControlMessage: ...
     def filter_timestamp(self, regex_filter: str) -> dict: 
         """
@@ -132,6 +135,9 @@ class DataTable():
 class TensorMemory():
     def __init__(self, *, count: int, tensors: object = None) -> None: ...
     def get_tensor(self, name: str) -> object: ...
+    def get_tensor_dtype(self, name: str) -> str: ...
+    def get_tensor_object(self, name: str) -> morpheus._lib.common.Tensor: ...
+    def get_tensor_shape(self, name: str) -> typing.List[int]: ...
     def get_tensors(self) -> typing.Dict[str, object]: ...
     def has_tensor(self, arg0: str) -> bool: ...
     def set_tensor(self, name: str, tensor: object) -> None: ...
@@ -142,6 +148,11 @@ class TensorMemory():
         :type: int
         """
     @property
+    def device_id(self) -> int:
+        """
+        :type: int
+        """
+    @property
     def tensor_names(self) -> typing.List[str]:
         """
         :type: typing.List[str]
@@ -181,11 +192,23 @@ class InferenceMemoryNLP(InferenceMemory, TensorMemory):
     pass
 class MessageMeta():
     def __init__(self, df: object) -> None: ...
+    def acknowledge(self) -> None: 
+        """
+        Acknowledge that the data has been fully handled, called by sinks once it has been written.
+        """
     def copy_dataframe(self) -> object: ...
     def ensure_sliceable_index(self) -> typing.Optional[str]: ...
+    def filter_timestamp(self, regex_filter: str) -> dict: 
+        """
+        Retrieve timestamps matching a regex filter.
+        """
     def get_column_names(self) -> typing.List[str]: ...
     @typing.overload
     def get_data(self) -> object: ...
+    def get_timestamp(self, key: str, fail_if_nonexist: bool = False) -> object: 
+        """
+        Retrieve the timestamp for a given key. Returns None if the timestamp does not exist and fail_if_nonexist is False.
+        """
     @typing.overload
     def get_data(self, columns: None) -> object: ...
     @typing.overload
@@ -193,16 +216,30 @@ class MessageMeta():
     @typing.overload
     def get_data(self, columns: typing.List[str]) -> object: ...
     def has_sliceable_index(self) -> bool: ...
+    def is_spilled(self) -> bool: ...
     @staticmethod
     def make_from_file(arg0: str) -> MessageMeta: ...
     def mutable_dataframe(self) -> MutableTableCtxMgr: ...
     def set_data(self, arg0: object, arg1: object) -> None: ...
+    def set_timestamp(self, key: str, timestamp: object) -> None: 
+        """
+        Set a timestamp for a given key.
+        """
+    def spill(self) -> int: 
+        """
+        Move the data of the table to host memory until it is next accessed, returning the number of bytes moved.
+        """
     @property
     def count(self) -> int:
         """
         :type: int
         """
     @property
+    def device_id(self) -> int:
+        """
+        :type: int
+        """
+    @property
     def df(self) -> object:
         """
         :type: object
@@ -339,6 +376,10 @@ class ResponseMemoryProbs(ResponseMemory, TensorMemory):
     def probs(self, arg1: object) -> None:
         pass
     pass
+class TimestampTraceExporter():
+    def __init__(self, sink_name: str) -> None: ...
+    def record(self, timestamps: typing.Dict[str, datetime.datetime]) -> None: ...
+    pass
 class InferenceMemoryFIL(InferenceMemory, TensorMemory):
     def __init__(self, *, count: int, input__0: object, seq_ids: object) -> None: ...
     @property
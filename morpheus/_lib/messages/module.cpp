@@ -34,12 +34,14 @@
 #include "morpheus/messages/multi_response_probs.hpp"
 #include "morpheus/messages/multi_tensor.hpp"
 #include "morpheus/objects/data_table.hpp"
+#include "morpheus/objects/message_timestamps.hpp"
 #include "morpheus/objects/mutable_table_ctx_mgr.hpp"
 #include "morpheus/utilities/cudf_util.hpp"
 #include "morpheus/utilities/string_util.hpp"
 #include "morpheus/version.hpp"
 
 #include <mrc/edge/edge_connector.hpp>
+#include <pybind11/chrono.h>      // IWYU pragma: keep
 #include <pybind11/functional.h>  // IWYU pragma: keep
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
@@ -159,11 +161,15 @@ PYBIND11_MODULE(messages, _module)
              py::arg("count"),
              py::arg("tensors") = py::none())
         .def_readonly("count", &TensorMemory::count)
+        .def_property_readonly("device_id", &TensorMemory::device_id)
         .def_property_readonly("tensor_names", &TensorMemoryInterfaceProxy::tensor_names_getter)
         .def("has_tensor", &TensorMemoryInterfaceProxy::has_tensor)
         .def("get_tensors", &TensorMemoryInterfaceProxy::get_tensors, py::return_value_policy::move)
         .def("set_tensors", &TensorMemoryInterfaceProxy::set_tensors, py::arg("tensors"))
         .def("get_tensor", &TensorMemoryInterfaceProxy::get_tensor, py::arg("name"), py::return_value_policy::move)
+        .def("get_tensor_object", &TensorMemoryInterfaceProxy::get_tensor_object, py::arg("name"))
+        .def("get_tensor_shape", &TensorMemoryInterfaceProxy::get_tensor_shape, py::arg("name"))
+        .def("get_tensor_dtype", &TensorMemoryInterfaceProxy::get_tensor_dtype, py::arg("name"))
         .def("set_tensor", &TensorMemoryInterfaceProxy::set_tensor, py::arg("name"), py::arg("tensor"));
 
     py::class_<InferenceMemory, TensorMemory, std::shared_ptr<InferenceMemory>>(_module, "InferenceMemory")
@@ -228,6 +234,17 @@ PYBIND11_MODULE(messages, _module)
     py::class_<MessageMeta, std::shared_ptr<MessageMeta>>(_module, "MessageMeta")
         .def(py::init<>(&MessageMetaInterfaceProxy::init_python), py::arg("df"))
         .def_property_readonly("count", &MessageMetaInterfaceProxy::count)
+        .def_property_readonly("device_id", &MessageMeta::device_id)
+        .def("spill",
+             &MessageMeta::spill,
+             "Move the data of the table to host memory until it is next accessed, returning the number of bytes "
+             "moved.",
+             py::call_guard<py::gil_scoped_release>())
+        .def("is_spilled", &MessageMeta::is_spilled)
+        .def("acknowledge",
+             &MessageMeta::acknowledge,
+             "Acknowledge that the data has been fully handled, called by sinks once it has been written.",
+             py::call_guard<py::gil_scoped_release>())
         .def_property_readonly("df", &MessageMetaInterfaceProxy::df_property, py::return_value_policy::move)
         .def("get_data",
              py::overload_cast<MessageMeta&>(&MessageMetaInterfaceProxy::get_data),
@@ -250,6 +267,21 @@ PYBIND11_MODULE(messages, _module)
         .def("mutable_dataframe", &MessageMetaInterfaceProxy::mutable_dataframe, py::return_value_policy::move)
         .def("has_sliceable_index", &MessageMetaInterfaceProxy::has_sliceable_index)
         .def("ensure_sliceable_index", &MessageMetaInterfaceProxy::ensure_sliceable_index)
+        .def("filter_timestamp",
+             &MessageMetaInterfaceProxy::filter_timestamp,
+             "Retrieve timestamps matching a regex filter.",
+             py::arg("regex_filter"))
+        .def("get_timestamp",
+             &MessageMetaInterfaceProxy::get_timestamp,
+             "Retrieve the timestamp for a given key. Returns None if the timestamp does not exist and "
+             "fail_if_nonexist is False.",
+             py::arg("key"),
+             py::arg("fail_if_nonexist") = false)
+        .def("set_timestamp",
+             &MessageMetaInterfaceProxy::set_timestamp,
+             "Set a timestamp for a given key.",
+             py::arg("key"),
+             py::arg("timestamp"))
         .def_static("make_from_file", &MessageMetaInterfaceProxy::init_cpp);
 
     py::class_<MultiMessage, std::shared_ptr<MultiMessage>>(_module, "MultiMessage")
@@ -391,6 +423,7 @@ PYBIND11_MODULE(messages, _module)
              pybind11::overload_cast<ControlMessage&, py::dict&>(&ControlMessageProxy::config),
              py::arg("config"))
         .def("config", pybind11::overload_cast<ControlMessage&>(&ControlMessageProxy::config))
+        .def("clone", &ControlMessage::clone)
         .def("copy", &ControlMessageProxy::copy)
         .def("get_metadata",
              &ControlMessageProxy::get_metadata,
@@ -442,6 +475,10 @@ PYBIND11_MODULE(messages, _module)
                     py::arg("name"),
                     py::arg("throw_if_not_exists") = true);
 
+    py::class_<TimestampTraceExporter, std::shared_ptr<TimestampTraceExporter>>(_module, "TimestampTraceExporter")
+        .def(py::init<std::string>(), py::arg("sink_name"))
+        .def("record", &TimestampTraceExporterInterfaceProxy::record, py::arg("timestamps"));
+
     _module.attr("__version__") =
         MORPHEUS_CONCAT_STR(morpheus_VERSION_MAJOR << "." << morpheus_VERSION_MINOR << "." << morpheus_VERSION_PATCH);
 }
@@ -0,0 +1,307 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/io/async_file_writer.hpp"
+
+#include <glog/logging.h>
+#include <zlib.h>  // for deflate, z_stream
+
+#include <array>
+#include <exception>  // for current_exception, rethrow_exception
+#include <ostream>
+#include <stdexcept>  // for logic_error, runtime_error
+#include <string>
+#include <utility>  // for move, swap
+
+namespace morpheus {
+
+/**
+ * @brief Compresses the buffers of a single file into one gzip stream
+ */
+class GzipDeflater
+{
+  public:
+    GzipDeflater()
+    {
+        // 15 is the maximum window size, adding 16 writes a gzip rather than a zlib header
+        if (deflateInit2(&m_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            throw std::runtime_error("Failed to initialize gzip compression");
+        }
+    }
+
+    ~GzipDeflater()
+    {
+        deflateEnd(&m_stream);
+    }
+
+    /**
+     * @brief Compresses `buffer` into `out_stream`, when `flush` is true everything written so far can be decompressed
+     */
+    void write(const std::string& buffer, std::ostream& out_stream, bool flush)
+    {
+        m_stream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(buffer.data()));
+        m_stream.avail_in = static_cast<uInt>(buffer.size());
+
+        deflate_all(out_stream, flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+    }
+
+    /**
+     * @brief Writes the remaining compressed data along with the gzip trailer
+     */
+    void finish(std::ostream& out_stream)
+    {
+        m_stream.next_in  = nullptr;
+        m_stream.avail_in = 0;
+
+        deflate_all(out_stream, Z_FINISH);
+    }
+
+  private:
+    void deflate_all(std::ostream& out_stream, int flush_mode)
+    {
+        do
+        {
+            m_stream.next_out  = reinterpret_cast<Bytef*>(m_output.data());
+            m_stream.avail_out = static_cast<uInt>(m_output.size());
+
+            auto result = deflate(&m_stream, flush_mode);
+            if (result == Z_STREAM_ERROR)
+            {
+                throw std::runtime_error("Failed to gzip compress the output");
+            }
+
+            out_stream.write(m_output.data(), m_output.size() - m_stream.avail_out);
+        } while (m_stream.avail_out == 0);
+    }
+
+    z_stream m_stream{};
+    std::array<char, 64 * 1024> m_output{};
+};
+
+AsyncFileWriter::AsyncFileWriter(std::size_t max_queue_depth, bool gzip, bool flush) :
+  m_max_queue_depth(max_queue_depth),
+  m_gzip(gzip),
+  m_flush(flush)
+{
+    // Enable throwing exceptions in case something fails.
+    m_fstream.exceptions(std::fstream::failbit | std::fstream::badbit);
+
+    if (m_max_queue_depth > 0)
+    {
+        m_thread = std::thread(&AsyncFileWriter::run, this);
+    }
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+    try
+    {
+        close();
+    } catch (const std::exception& e)
+    {
+        LOG(ERROR) << "Error closing file writer: " << e.what();
+    }
+}
+
+void AsyncFileWriter::open(std::filesystem::path path, std::ios::openmode mode)
+{
+    m_bytes_queued = 0;
+    m_has_file     = true;
+
+    enqueue({std::move(path), mode, {}});
+}
+
+void AsyncFileWriter::write(std::string buffer)
+{
+    if (!m_has_file)
+    {
+        throw std::logic_error("AsyncFileWriter::open must be called before writing");
+    }
+
+    m_bytes_queued += buffer.size();
+
+    enqueue({{}, {}, std::move(buffer)});
+}
+
+void AsyncFileWriter::close()
+{
+    if (m_max_queue_depth == 0)
+    {
+        close_file();
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_is_closed = true;
+    }
+    m_cv.notify_all();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    rethrow_error();
+}
+
+std::size_t AsyncFileWriter::bytes_queued() const
+{
+    return m_bytes_queued;
+}
+
+void AsyncFileWriter::enqueue(Task&& task)
+{
+    if (m_max_queue_depth == 0)
+    {
+        process(task);
+        return;
+    }
+
+    {
+        std::unique_lock lock(m_mutex);
+
+        if (m_is_closed)
+        {
+            throw std::logic_error("AsyncFileWriter has already been closed");
+        }
+
+        m_cv.wait(lock, [this]() {
+            return m_tasks.size() < m_max_queue_depth || m_error != nullptr;
+        });
+
+        if (m_error != nullptr)
+        {
+            std::rethrow_exception(m_error);
+        }
+
+        m_tasks.push_back(std::move(task));
+    }
+    m_cv.notify_all();
+}
+
+void AsyncFileWriter::run()
+{
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [this]() {
+                return !m_tasks.empty() || m_is_closed;
+            });
+
+            // Only stop once every queued buffer has been written
+            if (m_tasks.empty())
+            {
+                break;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        // Wakes up callers waiting for room in the queue
+        m_cv.notify_all();
+
+        try
+        {
+            process(task);
+        } catch (...)
+        {
+            std::lock_guard lock(m_mutex);
+            m_error = std::current_exception();
+            m_tasks.clear();
+            break;
+        }
+    }
+
+    try
+    {
+        close_file();
+    } catch (...)
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_error == nullptr)
+        {
+            m_error = std::current_exception();
+        }
+    }
+
+    m_cv.notify_all();
+}
+
+void AsyncFileWriter::process(Task& task)
+{
+    if (!task.path.empty())
+    {
+        close_file();
+
+        m_fstream.open(task.path, task.mode | std::ios::binary);
+        if (m_gzip)
+        {
+            m_deflater = std::make_unique<GzipDeflater>();
+        }
+
+        return;
+    }
+
+    if (m_deflater)
+    {
+        m_deflater->write(task.buffer, m_fstream, m_flush);
+    }
+    else
+    {
+        m_fstream.write(task.buffer.data(), task.buffer.size());
+    }
+
+    if (m_flush)
+    {
+        m_fstream.flush();
+    }
+}
+
+void AsyncFileWriter::close_file()
+{
+    if (m_fstream.is_open())
+    {
+        if (m_deflater)
+        {
+            m_deflater->finish(m_fstream);
+            m_deflater.reset();
+        }
+
+        m_fstream.close();
+    }
+}
+
+void AsyncFileWriter::rethrow_error()
+{
+    std::exception_ptr error;
+    {
+        std::lock_guard lock(m_mutex);
+        std::swap(error, m_error);
+    }
+
+    if (error != nullptr)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace morpheus
@@ -0,0 +1,441 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/io/batch_file_reader.hpp"
+
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <fcntl.h>  // for open, O_RDONLY, O_CLOEXEC
+#include <glog/logging.h>
+#include <sys/stat.h>  // for fstat
+#include <sys/uio.h>   // for iovec
+#include <unistd.h>    // for pread, close
+
+#if __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>     // for mmap, munmap
+    #include <sys/syscall.h>  // for __NR_io_uring_setup, __NR_io_uring_enter
+    #define MORPHEUS_HAS_IO_URING 1
+#endif
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>  // for memset, strerror
+#include <deque>
+#include <stdexcept>  // for runtime_error
+#include <utility>    // for move
+
+namespace morpheus {
+namespace {
+
+/**
+ * @brief Closes the files of a batch, however the batch ends
+ */
+struct FileDescriptors
+{
+    std::vector<int> fds;
+
+    ~FileDescriptors()
+    {
+        for (int fd : fds)
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Progress of reading a single file into the buffer
+ */
+struct FileRead
+{
+    int fd{-1};
+    char* data{nullptr};
+    std::size_t size{0};
+    std::size_t num_read{0};
+    iovec iov{};  // Only read by the kernel once the read has been submitted
+};
+
+std::runtime_error make_read_error(const std::string& filename, int error)
+{
+    return std::runtime_error(
+        MORPHEUS_CONCAT_STR("Failed to read file '" << filename << "'. Error: " << std::strerror(error)));
+}
+
+}  // namespace
+
+// ************ BatchFileReader::Ring **************************** //
+#ifdef MORPHEUS_HAS_IO_URING
+/**
+ * @brief Minimal io_uring, driven through the raw system calls so as not to depend on liburing. Every read is submitted
+ * by, and every completion reaped on, the thread owning the reader.
+ */
+class BatchFileReader::Ring
+{
+  public:
+    /**
+     * @brief Returns nullptr when the kernel does not allow io_uring
+     */
+    static std::unique_ptr<Ring> create(unsigned queue_depth)
+    {
+        auto ring = std::unique_ptr<Ring>(new Ring());
+
+        io_uring_params params{};
+        ring->m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, queue_depth, &params));
+
+        if (ring->m_fd < 0)
+        {
+            VLOG(1) << "io_uring is not available, files are read one at a time. Error: " << std::strerror(errno);
+            return nullptr;
+        }
+
+        ring->m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring->m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        ring->m_sqes_size    = params.sq_entries * sizeof(io_uring_sqe);
+
+        ring->m_sq_ring = ring->map(ring->m_sq_ring_size, IORING_OFF_SQ_RING);
+        ring->m_cq_ring = ring->map(ring->m_cq_ring_size, IORING_OFF_CQ_RING);
+        ring->m_sqes    = static_cast<io_uring_sqe*>(ring->map(ring->m_sqes_size, IORING_OFF_SQES));
+
+        if (ring->m_sq_ring == nullptr || ring->m_cq_ring == nullptr || ring->m_sqes == nullptr)
+        {
+            VLOG(1) << "Failed to map the io_uring, files are read one at a time. Error: " << std::strerror(errno);
+            return nullptr;
+        }
+
+        auto* sq_ring    = static_cast<char*>(ring->m_sq_ring);
+        ring->m_sq_tail  = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.tail);
+        ring->m_sq_mask  = *reinterpret_cast<unsigned*>(sq_ring + params.sq_off.ring_mask);
+        ring->m_sq_array = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.array);
+        ring->m_capacity = params.sq_entries;
+
+        auto* cq_ring   = static_cast<char*>(ring->m_cq_ring);
+        ring->m_cq_head = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.head);
+        ring->m_cq_tail = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.tail);
+        ring->m_cq_mask = *reinterpret_cast<unsigned*>(cq_ring + params.cq_off.ring_mask);
+        ring->m_cqes    = reinterpret_cast<io_uring_cqe*>(cq_ring + params.cq_off.cqes);
+
+        return ring;
+    }
+
+    ~Ring()
+    {
+        unmap(m_sqes, m_sqes_size);
+        unmap(m_cq_ring, m_cq_ring_size);
+        unmap(m_sq_ring, m_sq_ring_size);
+
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+        }
+    }
+
+    /**
+     * @brief Maximum number of reads in flight, the completion queue being at least as large
+     */
+    unsigned capacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * @brief Queues a read of `iov` from `fd` at `offset`, submitted by the next call to `wait`
+     */
+    void push_read(int fd, const iovec* iov, std::size_t offset, uint64_t user_data)
+    {
+        // Only this thread writes the tail
+        unsigned tail  = *m_sq_tail;
+        unsigned index = tail & m_sq_mask;
+
+        auto* sqe = &m_sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode    = IORING_OP_READV;
+        sqe->fd        = fd;
+        sqe->addr      = reinterpret_cast<uint64_t>(iov);
+        sqe->len       = 1;
+        sqe->off       = offset;
+        sqe->user_data = user_data;
+
+        m_sq_array[index] = index;
+        __atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+        ++m_num_queued;
+    }
+
+    /**
+     * @brief Submits the queued reads and waits for at least one completion
+     */
+    void wait()
+    {
+        while (true)
+        {
+            auto result = ::syscall(__NR_io_uring_enter, m_fd, m_num_queued, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+            if (result >= 0)
+            {
+                m_num_queued -= static_cast<unsigned>(result);
+                return;
+            }
+
+            if (errno != EINTR)
+            {
+                throw std::runtime_error(
+                    MORPHEUS_CONCAT_STR("Failed to submit reads to the io_uring. Error: " << std::strerror(errno)));
+            }
+        }
+    }
+
+    /**
+     * @brief Calls `fn(user_data, result)` for every completed read, `result` being the number of bytes read or a
+     * negated errno
+     */
+    template <typename FnT>
+    void reap(FnT&& fn)
+    {
+        unsigned head = *m_cq_head;
+        unsigned tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+
+        for (; head != tail; ++head)
+        {
+            const auto& cqe = m_cqes[head & m_cq_mask];
+            fn(cqe.user_data, cqe.res);
+        }
+
+        __atomic_store_n(m_cq_head, head, __ATOMIC_RELEASE);
+    }
+
+  private:
+    Ring() = default;
+
+    void* map(std::size_t size, off_t offset)
+    {
+        void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    static void unmap(void* ptr, std::size_t size)
+    {
+        if (ptr != nullptr)
+        {
+            ::munmap(ptr, size);
+        }
+    }
+
+    int m_fd{-1};
+
+    void* m_sq_ring{nullptr};
+    void* m_cq_ring{nullptr};
+    io_uring_sqe* m_sqes{nullptr};
+    std::size_t m_sq_ring_size{0};
+    std::size_t m_cq_ring_size{0};
+    std::size_t m_sqes_size{0};
+
+    unsigned* m_sq_tail{nullptr};
+    unsigned* m_sq_array{nullptr};
+    unsigned m_sq_mask{0};
+    unsigned* m_cq_head{nullptr};
+    unsigned* m_cq_tail{nullptr};
+    unsigned m_cq_mask{0};
+    io_uring_cqe* m_cqes{nullptr};
+
+    unsigned m_capacity{0};
+    unsigned m_num_queued{0};
+};
+#else
+class BatchFileReader::Ring
+{
+  public:
+    static std::unique_ptr<Ring> create(unsigned /*queue_depth*/)
+    {
+        return nullptr;
+    }
+};
+#endif
+
+// Component public implementations
+// ************ BatchFileReader ************************* //
+BatchFileReader::BatchFileReader(unsigned queue_depth) : m_ring(Ring::create(queue_depth)) {}
+
+BatchFileReader::~BatchFileReader() = default;
+
+bool BatchFileReader::uses_io_uring() const
+{
+    return m_ring != nullptr;
+}
+
+std::vector<std::optional<std::string_view>> BatchFileReader::read(const std::vector<std::string>& filenames,
+                                                                   PinnedHostBuffer& buffer,
+                                                                   std::size_t max_file_size)
+{
+    FileDescriptors descriptors;
+    std::vector<FileRead> files(filenames.size());
+    std::size_t total_size = 0;
+
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+    {
+        int fd = ::open(filenames[i].c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0)
+        {
+            throw make_read_error(filenames[i], errno);
+        }
+
+        descriptors.fds.push_back(fd);
+
+        struct stat file_stat;
+
+        if (::fstat(fd, &file_stat) != 0)
+        {
+            throw make_read_error(filenames[i], errno);
+        }
+
+        if (static_cast<std::size_t>(file_stat.st_size) <= max_file_size)
+        {
+            files[i].fd   = fd;
+            files[i].size = static_cast<std::size_t>(file_stat.st_size);
+            total_size += files[i].size;
+        }
+    }
+
+    // The buffer is not reallocated past this point, the kernel writes straight into it
+    buffer.clear();
+    buffer.resize(total_size);
+
+    std::size_t offset = 0;
+    std::deque<std::size_t> pending;
+
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        if (files[i].fd >= 0)
+        {
+            files[i].data = buffer.data() + offset;
+            offset += files[i].size;
+
+            if (files[i].size > 0)
+            {
+                pending.push_back(i);
+            }
+        }
+    }
+
+#ifdef MORPHEUS_HAS_IO_URING
+    if (m_ring != nullptr)
+    {
+        unsigned num_in_flight = 0;
+        std::optional<std::pair<std::size_t, int>> first_error;
+
+        while (!pending.empty() || num_in_flight > 0)
+        {
+            // Nothing more is submitted after an error, but the reads in flight still write into the buffer
+            while (!first_error && !pending.empty() && num_in_flight < m_ring->capacity())
+            {
+                auto& file = files[pending.front()];
+                file.iov   = iovec{file.data + file.num_read, file.size - file.num_read};
+
+                m_ring->push_read(file.fd, &file.iov, file.num_read, pending.front());
+                pending.pop_front();
+                ++num_in_flight;
+            }
+
+            if (num_in_flight == 0)
+            {
+                break;
+            }
+
+            m_ring->wait();
+
+            m_ring->reap([&](uint64_t idx, int result) {
+                --num_in_flight;
+                auto& file = files[idx];
+
+                if (result < 0)
+                {
+                    if (!first_error)
+                    {
+                        first_error = std::make_pair(static_cast<std::size_t>(idx), -result);
+                    }
+                    return;
+                }
+
+                file.num_read += static_cast<std::size_t>(result);
+
+                // A short read is resumed, unless the file was truncated since it was opened
+                if (result == 0)
+                {
+                    file.size = file.num_read;
+                }
+                else if (file.num_read < file.size)
+                {
+                    pending.push_back(idx);
+                }
+            });
+        }
+
+        if (first_error)
+        {
+            throw make_read_error(filenames[first_error->first], first_error->second);
+        }
+    }
+    else
+#endif
+    {
+        for (auto idx : pending)
+        {
+            auto& file = files[idx];
+
+            while (file.num_read < file.size)
+            {
+                auto result = ::pread(file.fd, file.data + file.num_read, file.size - file.num_read, file.num_read);
+
+                if (result < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (result < 0)
+                {
+                    throw make_read_error(filenames[idx], errno);
+                }
+
+                if (result == 0)
+                {
+                    file.size = file.num_read;
+                    break;
+                }
+
+                file.num_read += static_cast<std::size_t>(result);
+            }
+        }
+    }
+
+    std::vector<std::optional<std::string_view>> contents(files.size());
+
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        if (files[i].fd >= 0)
+        {
+            contents[i] = std::string_view(files[i].data, files[i].size);
+        }
+    }
+
+    return contents;
+}
+
+}  // namespace morpheus
@@ -0,0 +1,469 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/io/cuda_ipc_ring.hpp"
+
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <cuda.h>          // for cuMemGetAddressRange
+#include <cuda_runtime.h>  // for cudaIpcGetMemHandle, cudaIpcOpenMemHandle, cudaIpcCloseMemHandle
+#include <fcntl.h>         // for O_CREAT, O_EXCL, O_RDWR
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <sys/mman.h>           // for mmap, munmap, shm_open, shm_unlink
+#include <sys/stat.h>           // for fstat
+#include <unistd.h>             // for ftruncate, close
+
+#include <atomic>
+#include <cerrno>     // for errno
+#include <cstring>    // for memcpy, strerror
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <thread>     // for sleep_for
+#include <utility>    // for move
+
+namespace morpheus {
+namespace {
+
+constexpr uint64_t RingMagic    = 0x4d4f525048495043ULL;
+constexpr uint32_t RingVersion  = 1;
+constexpr std::size_t Alignment = 64;
+
+// Waiting on the other process polls the ring
+constexpr auto PollInterval = std::chrono::microseconds(50);
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "The ring is shared between processes through lock free atomics");
+
+enum SlotState : uint32_t
+{
+    Free = 0,  // Writable by the producer
+    Ready,     // Pushed, waiting for the consumer
+    Popped     // Held by the consumer until it releases the message
+};
+
+struct BufferDescriptor
+{
+    cudaIpcMemHandle_t handle;
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct SlotHeader
+{
+    std::atomic<uint32_t> state;
+    uint32_t header_size;
+    uint32_t num_buffers;
+    BufferDescriptor buffers[CudaIpcRing::MaxBuffers];
+};
+
+struct RingHeader
+{
+    std::atomic<uint64_t> magic;  // Written last by the producer, once the ring is initialized
+    uint32_t version;
+    uint32_t num_slots;
+    uint64_t max_header_bytes;
+    uint64_t slot_stride;
+    std::atomic<uint64_t> num_pushed;
+    std::atomic<uint32_t> closed;
+};
+
+constexpr std::size_t align_up(std::size_t size)
+{
+    return (size + Alignment - 1) / Alignment * Alignment;
+}
+
+std::string shm_name(const std::string& name)
+{
+    return name.starts_with("/") ? name : "/" + name;
+}
+
+std::string errno_str()
+{
+    return std::strerror(errno);
+}
+
+}  // namespace
+
+// Component private implementations
+// ************ CudaIpcRing::Segment ************************ //
+struct CudaIpcRing::Segment
+{
+    Segment(std::string name, void* data, std::size_t size, bool is_producer) :
+      name(std::move(name)),
+      data(data),
+      size(size),
+      is_producer(is_producer)
+    {}
+
+    ~Segment()
+    {
+        ::munmap(data, size);
+        if (is_producer)
+        {
+            ::shm_unlink(name.c_str());
+        }
+    }
+
+    RingHeader& ring() const
+    {
+        return *static_cast<RingHeader*>(data);
+    }
+
+    SlotHeader& slot(uint64_t sequence) const
+    {
+        return *reinterpret_cast<SlotHeader*>(slot_data(sequence));
+    }
+
+    uint8_t* header_bytes(uint64_t sequence) const
+    {
+        return slot_data(sequence) + align_up(sizeof(SlotHeader));
+    }
+
+    uint8_t* slot_data(uint64_t sequence) const
+    {
+        const auto& header = ring();
+        return static_cast<uint8_t*>(data) + align_up(sizeof(RingHeader)) +
+               (sequence % header.num_slots) * header.slot_stride;
+    }
+
+    std::string name;
+    void* data;
+    std::size_t size;
+    bool is_producer;
+};
+
+// Component public implementations
+// ************ CudaIpcRing ********************************* //
+CudaIpcRing::CudaIpcRing(std::shared_ptr<Segment> segment) : m_segment(std::move(segment))
+{
+    if (m_segment->is_producer)
+    {
+        m_owners.resize(m_segment->ring().num_slots);
+    }
+}
+
+CudaIpcRing::~CudaIpcRing() = default;
+
+std::unique_ptr<CudaIpcRing> CudaIpcRing::create(const std::string& name,
+                                                 std::size_t num_slots,
+                                                 std::size_t max_header_bytes)
+{
+    if (num_slots == 0)
+    {
+        throw std::invalid_argument("num_slots must be greater than 0");
+    }
+
+    const auto path        = shm_name(name);
+    const auto slot_stride = align_up(sizeof(SlotHeader)) + align_up(max_header_bytes);
+    const auto size        = align_up(sizeof(RingHeader)) + num_slots * slot_stride;
+
+    // A ring left by a crashed producer is replaced, its consumer keeps its own mapping of it
+    ::shm_unlink(path.c_str());
+
+    const int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Unable to create the ring '" << path << "': " << errno_str()));
+    }
+
+    void* data = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(size)) == 0)
+    {
+        data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    const auto error = errno_str();
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        ::shm_unlink(path.c_str());
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Unable to map the ring '" << path << "': " << error));
+    }
+
+    auto segment = std::make_shared<Segment>(path, data, size, true);
+
+    // The segment is zero filled, leaving every slot free
+    auto& ring            = segment->ring();
+    ring.version          = RingVersion;
+    ring.num_slots        = static_cast<uint32_t>(num_slots);
+    ring.max_header_bytes = max_header_bytes;
+    ring.slot_stride      = slot_stride;
+    ring.magic.store(RingMagic, std::memory_order_release);
+
+    return std::unique_ptr<CudaIpcRing>(new CudaIpcRing(std::move(segment)));
+}
+
+std::unique_ptr<CudaIpcRing> CudaIpcRing::open(const std::string& name,
+                                               std::chrono::milliseconds timeout,
+                                               const stop_fn_t& should_stop)
+{
+    const auto path     = shm_name(name);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (true)
+    {
+        const int fd = ::shm_open(path.c_str(), O_RDWR, 0600);
+        if (fd >= 0)
+        {
+            struct stat stats = {};
+            void* data        = MAP_FAILED;
+            if (::fstat(fd, &stats) == 0 && stats.st_size >= static_cast<off_t>(sizeof(RingHeader)))
+            {
+                data = ::mmap(nullptr, stats.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+
+            ::close(fd);
+
+            if (data != MAP_FAILED)
+            {
+                auto segment = std::make_shared<Segment>(path, data, static_cast<std::size_t>(stats.st_size), false);
+                if (segment->ring().magic.load(std::memory_order_acquire) == RingMagic)
+                {
+                    if (segment->ring().version != RingVersion)
+                    {
+                        throw std::runtime_error(MORPHEUS_CONCAT_STR("Unsupported version "
+                                                                     << segment->ring().version << " of the ring '"
+                                                                     << path << "'"));
+                    }
+
+                    return std::unique_ptr<CudaIpcRing>(new CudaIpcRing(std::move(segment)));
+                }
+            }
+        }
+
+        if (should_stop && should_stop())
+        {
+            return nullptr;
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            throw std::runtime_error(MORPHEUS_CONCAT_STR("Timed out waiting for the producer of the ring '" << path
+                                                                                                         << "'"));
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+bool CudaIpcRing::push(const std::vector<uint8_t>& header,
+                       const std::vector<CudaIpcBuffer>& buffers,
+                       std::shared_ptr<void> owner,
+                       const stop_fn_t& should_stop)
+{
+    auto& ring = m_segment->ring();
+    if (header.size() > ring.max_header_bytes || buffers.size() > MaxBuffers)
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to push a message of "
+                                                        << header.size() << " header bytes and " << buffers.size()
+                                                        << " buffers, at most " << ring.max_header_bytes
+                                                        << " bytes and " << MaxBuffers << " buffers fit in a slot"));
+    }
+
+    auto& slot = m_segment->slot(m_sequence);
+    while (slot.state.load(std::memory_order_acquire) != SlotState::Free)
+    {
+        if (should_stop && should_stop())
+        {
+            return false;
+        }
+
+        std::this_thread::sleep_for(PollInterval);
+    }
+
+    // The consumer released the previous message of the slot
+    auto& owners = m_owners[m_sequence % ring.num_slots];
+    owners.clear();
+    owners.push_back(std::move(owner));
+
+    for (std::size_t i = 0; i < buffers.size(); ++i)
+    {
+        auto& descriptor = slot.buffers[i];
+        descriptor.size  = buffers[i].size;
+
+        const void* data = buffers[i].data;
+        if (data == nullptr || buffers[i].size == 0)
+        {
+            descriptor.size = 0;
+            continue;
+        }
+
+        // Handles are exported for whole allocations, such as the blocks of a pool, the buffer being at an offset
+        CUdeviceptr base      = 0;
+        std::size_t base_size = 0;
+        if (cuMemGetAddressRange(&base, &base_size, reinterpret_cast<CUdeviceptr>(data)) != CUDA_SUCCESS ||
+            cudaIpcGetMemHandle(&descriptor.handle, reinterpret_cast<void*>(base)) != cudaSuccess)
+        {
+            // Allocations of stream ordered pools are not exportable, they are copied into one of their own
+            LOG_FIRST_N(WARNING, 1) << "Copying buffers which cannot be exported through CUDA IPC handles, such as "
+                                       "those of stream ordered memory pools";
+            cudaGetLastError();
+
+            void* copy = nullptr;
+            MRC_CHECK_CUDA(cudaMalloc(&copy, buffers[i].size));
+            owners.emplace_back(copy, [](void* ptr) {
+                cudaFree(ptr);
+            });
+
+            MRC_CHECK_CUDA(cudaMemcpy(copy, data, buffers[i].size, cudaMemcpyDeviceToDevice));
+            MRC_CHECK_CUDA(cudaIpcGetMemHandle(&descriptor.handle, copy));
+
+            base = reinterpret_cast<CUdeviceptr>(copy);
+            data = copy;
+        }
+
+        descriptor.offset = reinterpret_cast<CUdeviceptr>(data) - base;
+    }
+
+    slot.header_size = static_cast<uint32_t>(header.size());
+    slot.num_buffers = static_cast<uint32_t>(buffers.size());
+    std::memcpy(m_segment->header_bytes(m_sequence), header.data(), header.size());
+
+    slot.state.store(SlotState::Ready, std::memory_order_release);
+    ring.num_pushed.store(++m_sequence, std::memory_order_release);
+
+    return true;
+}
+
+bool CudaIpcRing::close(std::chrono::milliseconds timeout)
+{
+    auto& ring = m_segment->ring();
+    ring.closed.store(1, std::memory_order_release);
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    bool released = true;
+    for (uint64_t i = 0; i < ring.num_slots; ++i)
+    {
+        auto& slot = m_segment->slot(i);
+        while (slot.state.load(std::memory_order_acquire) != SlotState::Free)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                released = false;
+                break;
+            }
+
+            std::this_thread::sleep_for(PollInterval);
+        }
+    }
+
+    if (!released)
+    {
+        LOG(WARNING) << "The consumer of the ring '" << m_segment->name
+                     << "' did not release every message, freeing their buffers";
+    }
+
+    m_owners.clear();
+
+    return released;
+}
+
+std::shared_ptr<void> CudaIpcRing::map_allocation(const std::string& handle)
+{
+    std::lock_guard lock(m_mappings_mutex);
+
+    auto mapping = m_mappings[handle].lock();
+    if (mapping == nullptr)
+    {
+        cudaIpcMemHandle_t ipc_handle;
+        std::memcpy(&ipc_handle, handle.data(), sizeof(ipc_handle));
+
+        void* base = nullptr;
+        MRC_CHECK_CUDA(cudaIpcOpenMemHandle(&base, ipc_handle, cudaIpcMemLazyEnablePeerAccess));
+
+        mapping = std::shared_ptr<void>(base, [](void* ptr) {
+            cudaIpcCloseMemHandle(ptr);
+        });
+
+        m_mappings[handle] = mapping;
+    }
+
+    // Drops the mappings closed since
+    std::erase_if(m_mappings, [](const auto& entry) {
+        return entry.second.expired();
+    });
+
+    return mapping;
+}
+
+std::optional<CudaIpcMessage> CudaIpcRing::pop(const stop_fn_t& should_stop)
+{
+    auto& ring = m_segment->ring();
+    auto& slot = m_segment->slot(m_sequence);
+
+    while (slot.state.load(std::memory_order_acquire) != SlotState::Ready)
+    {
+        if ((ring.closed.load(std::memory_order_acquire) != 0 &&
+             ring.num_pushed.load(std::memory_order_acquire) == m_sequence) ||
+            (should_stop && should_stop()))
+        {
+            return std::nullopt;
+        }
+
+        std::this_thread::sleep_for(PollInterval);
+    }
+
+    slot.state.store(SlotState::Popped, std::memory_order_relaxed);
+
+    // Releases the slot once the message, and every buffer mapped for it, is destroyed
+    struct Lease
+    {
+        std::shared_ptr<Segment> segment;
+        SlotHeader* slot;
+        std::vector<std::shared_ptr<void>> mappings;
+
+        ~Lease()
+        {
+            mappings.clear();
+            slot->state.store(SlotState::Free, std::memory_order_release);
+        }
+    };
+
+    auto lease     = std::make_shared<Lease>();
+    lease->segment = m_segment;
+    lease->slot    = &slot;
+
+    CudaIpcMessage message;
+    const auto* header_bytes = m_segment->header_bytes(m_sequence);
+    message.header.assign(header_bytes, header_bytes + slot.header_size);
+
+    for (uint32_t i = 0; i < slot.num_buffers; ++i)
+    {
+        const auto& descriptor = slot.buffers[i];
+        if (descriptor.size == 0)
+        {
+            message.buffers.push_back({nullptr, 0});
+            continue;
+        }
+
+        auto mapping = this->map_allocation(
+            std::string(reinterpret_cast<const char*>(&descriptor.handle), sizeof(descriptor.handle)));
+
+        message.buffers.push_back({static_cast<const uint8_t*>(mapping.get()) + descriptor.offset, descriptor.size});
+        lease->mappings.push_back(std::move(mapping));
+    }
+
+    message.owner = std::move(lease);
+    ++m_sequence;
+
+    return message;
+}
+
+}  // namespace morpheus
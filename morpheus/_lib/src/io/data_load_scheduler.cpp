@@ -0,0 +1,272 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/io/data_load_scheduler.hpp"
+
+#include "morpheus/messages/control.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>  // for find_if
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move
+
+namespace {
+// The loader of the first load task of `message`, messages without one being classed together
+std::string first_loader_id(const morpheus::ControlMessage& message)
+{
+    auto tasks = message.get_tasks();
+    if (tasks.contains("load") && !tasks["load"].empty())
+    {
+        return tasks["load"][0].value("loader_id", "");
+    }
+
+    return "";
+}
+}  // namespace
+
+namespace morpheus {
+
+DataLoadScheduler::DataLoadScheduler(load_fn_t load_fn,
+                                     std::size_t max_concurrent_loads,
+                                     std::size_t max_queued_loads,
+                                     std::map<std::string, std::size_t> loader_limits,
+                                     bool preserve_order,
+                                     std::string ordering_key) :
+  m_load_fn(std::move(load_fn)),
+  m_max_queued_loads(max_queued_loads),
+  m_loader_limits(std::move(loader_limits)),
+  m_preserve_order(preserve_order),
+  m_ordering_key(std::move(ordering_key))
+{
+    if (max_concurrent_loads == 0 || m_max_queued_loads == 0)
+    {
+        throw std::invalid_argument("max_concurrent_loads and max_queued_loads must be greater than 0");
+    }
+
+    for (const auto& [loader_id, limit] : m_loader_limits)
+    {
+        if (limit == 0)
+        {
+            throw std::invalid_argument("The limit of loader '" + loader_id + "' must be greater than 0");
+        }
+    }
+
+    for (std::size_t i = 0; i < max_concurrent_loads; ++i)
+    {
+        m_workers.emplace_back(&DataLoadScheduler::work, this);
+    }
+}
+
+DataLoadScheduler::~DataLoadScheduler()
+{
+    cancel();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+bool DataLoadScheduler::submit(std::shared_ptr<ControlMessage> message)
+{
+    auto entry       = std::make_shared<Entry>();
+    entry->loader_id = first_loader_id(*message);
+    if (m_preserve_order && !m_ordering_key.empty())
+    {
+        const auto* value = message->find_metadata(m_ordering_key);
+        if (value != nullptr)
+        {
+            entry->order_key = value->is_string() ? value->get<std::string>() : value->dump();
+        }
+    }
+
+    entry->message = std::move(message);
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_queue_cv.wait(lock, [this] {
+            return m_cancelled || m_closed || m_num_queued < m_max_queued_loads;
+        });
+
+        if (m_cancelled || m_closed)
+        {
+            return false;
+        }
+
+        ++m_num_queued;
+        m_pending.push_back(entry);
+        if (m_preserve_order)
+        {
+            m_ordered[entry->order_key].push_back(entry);
+        }
+    }
+
+    m_work_cv.notify_one();
+
+    return true;
+}
+
+void DataLoadScheduler::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+    }
+
+    m_work_cv.notify_all();
+    m_ready_cv.notify_all();
+    m_queue_cv.notify_all();
+}
+
+void DataLoadScheduler::cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cancelled = true;
+        m_pending.clear();
+    }
+
+    m_work_cv.notify_all();
+    m_ready_cv.notify_all();
+    m_queue_cv.notify_all();
+}
+
+std::optional<std::shared_ptr<ControlMessage>> DataLoadScheduler::pop()
+{
+    std::shared_ptr<Entry> entry;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_ready_cv.wait(lock, [this] {
+            return m_cancelled || !m_ready.empty() || (m_closed && m_num_queued == 0);
+        });
+
+        if (m_cancelled || m_ready.empty())
+        {
+            return std::nullopt;
+        }
+
+        entry = std::move(m_ready.front());
+        m_ready.pop_front();
+        --m_num_queued;
+    }
+
+    m_queue_cv.notify_one();
+
+    if (entry->error)
+    {
+        std::rethrow_exception(entry->error);
+    }
+
+    return std::move(entry->message);
+}
+
+void DataLoadScheduler::work()
+{
+    while (true)
+    {
+        std::shared_ptr<Entry> entry;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            auto pending = m_pending.end();
+            m_work_cv.wait(lock, [this, &pending] {
+                if (m_cancelled)
+                {
+                    return true;
+                }
+
+                // The first message whose loader is below its limit, the others waiting for a load of theirs to end
+                pending = std::find_if(m_pending.begin(), m_pending.end(), [this](const auto& pending_entry) {
+                    return has_capacity(pending_entry->loader_id);
+                });
+
+                return pending != m_pending.end() || (m_closed && m_pending.empty());
+            });
+
+            if (m_cancelled || pending == m_pending.end())
+            {
+                return;
+            }
+
+            entry = std::move(*pending);
+            m_pending.erase(pending);
+            ++m_active[entry->loader_id];
+        }
+
+        try
+        {
+            entry->message = m_load_fn(std::move(entry->message));
+        } catch (...)
+        {
+            entry->error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_active[entry->loader_id];
+            entry->loaded = true;
+
+            if (m_preserve_order)
+            {
+                release_loaded(entry->order_key);
+            }
+            else
+            {
+                m_ready.push_back(std::move(entry));
+            }
+        }
+
+        // The load ending may let another worker pick a message of the same loader
+        m_work_cv.notify_all();
+        m_ready_cv.notify_all();
+    }
+}
+
+bool DataLoadScheduler::has_capacity(const std::string& loader_id) const
+{
+    auto limit = m_loader_limits.find(loader_id);
+    if (limit == m_loader_limits.end())
+    {
+        return true;
+    }
+
+    auto active = m_active.find(loader_id);
+    return active == m_active.end() || active->second < limit->second;
+}
+
+void DataLoadScheduler::release_loaded(const std::string& key)
+{
+    auto ordered = m_ordered.find(key);
+    if (ordered == m_ordered.end())
+    {
+        return;
+    }
+
+    auto& queue = ordered->second;
+    while (!queue.empty() && queue.front()->loaded)
+    {
+        m_ready.push_back(std::move(queue.front()));
+        queue.pop_front();
+    }
+
+    if (queue.empty())
+    {
+        m_ordered.erase(ordered);
+    }
+}
+}  // namespace morpheus
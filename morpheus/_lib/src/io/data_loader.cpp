@@ -21,8 +21,10 @@
 
 #include <glog/logging.h>
 
+#include <cstddef>  // for size_t
 #include <exception>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
 #include <utility>
 
@@ -59,7 +61,15 @@ std::shared_ptr<ControlMessage> Loader::load(std::shared_ptr<ControlMessage> mes
     return std::move(message);
 }
 
-DataLoader::DataLoader(nlohmann::json config) : m_config(std::move(config)) {}
+DataLoader::DataLoader(nlohmann::json config) : m_config(std::move(config))
+{
+    std::size_t cache_device_bytes = m_config.value("cache_device_bytes", std::size_t{0});
+    if (cache_device_bytes > 0)
+    {
+        m_cache = std::make_shared<DataLoaderCache>(cache_device_bytes,
+                                                    m_config.value("cache_host_bytes", std::size_t{0}));
+    }
+}
 
 std::shared_ptr<ControlMessage> DataLoader::load(std::shared_ptr<ControlMessage> control_message)
 {
@@ -83,7 +93,23 @@ std::shared_ptr<ControlMessage> DataLoader::load(std::shared_ptr<ControlMessage>
                     << " for message: " << control_message->config().dump() << std::endl;
             try
             {
-                loader->second->load(control_message, task);
+                auto cache_key = m_cache ? DataLoaderCache::make_key(task) : std::nullopt;
+                auto payload   = cache_key ? m_cache->get(*cache_key) : nullptr;
+
+                if (payload)
+                {
+                    VLOG(5) << "Loaded data from the cache for loader: " << loader_id;
+                    control_message->payload(std::move(payload));
+                }
+                else
+                {
+                    loader->second->load(control_message, task);
+
+                    if (cache_key && control_message->payload())
+                    {
+                        m_cache->put(*cache_key, control_message->payload());
+                    }
+                }
             } catch (std::exception& e)
             {
                 process_failures(e.what(), control_message, processes_failures_as_errors);
@@ -0,0 +1,229 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/io/data_loader_cache.hpp"
+
+#include "morpheus/objects/table_info.hpp"  // for TableInfo
+
+#include <cudf/contiguous_split.hpp>  // for pack, unpack
+#include <cudf/table/table.hpp>
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+
+#include <filesystem>    // for last_write_time, file_size
+#include <iterator>      // for next
+#include <system_error>  // for error_code
+#include <utility>
+
+namespace morpheus {
+
+DataLoaderCache::DataLoaderCache(std::size_t max_device_bytes, std::size_t max_host_bytes) :
+  m_max_device_bytes(max_device_bytes),
+  m_max_host_bytes(max_host_bytes)
+{}
+
+std::optional<std::string> DataLoaderCache::make_key(const nlohmann::json& task)
+{
+    if (!task.contains("files") || !task["files"].is_array())
+    {
+        return std::nullopt;
+    }
+
+    // Object keys are sorted, making the dump of the task canonical
+    auto key = task.dump();
+
+    for (const auto& file : task["files"])
+    {
+        std::filesystem::path path = file.is_string() ? file.get<std::string>() : file.value("path", "");
+
+        std::error_code ec;
+        auto mtime = std::filesystem::last_write_time(path, ec);
+        if (ec)
+        {
+            return std::nullopt;
+        }
+
+        auto size = std::filesystem::file_size(path, ec);
+        if (ec)
+        {
+            return std::nullopt;
+        }
+
+        key += "|" + std::to_string(mtime.time_since_epoch().count()) + ":" + std::to_string(size);
+    }
+
+    return key;
+}
+
+std::shared_ptr<MessageMeta> DataLoaderCache::get(const std::string& key)
+{
+    cudf::io::table_with_metadata table;
+    int num_indices;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto found = m_entries.find(key);
+        if (found == m_entries.end())
+        {
+            return nullptr;
+        }
+
+        auto& entry = found->second;
+        m_lru.splice(m_lru.begin(), m_lru, entry.lru_position);
+
+        if (!entry.device_data)
+        {
+            // Brings the table back to device memory, it is the most recently used one
+            entry.device_data = std::make_unique<rmm::device_buffer>(
+                entry.host_data.data(), entry.data_bytes, cudf::get_default_stream());
+            entry.host_data = std::vector<uint8_t>();
+            m_host_bytes -= entry.data_bytes;
+            m_device_bytes += entry.data_bytes;
+        }
+
+        auto view = cudf::unpack(entry.packed_metadata.data(), static_cast<const uint8_t*>(entry.device_data->data()));
+
+        table.tbl      = std::make_unique<cudf::table>(view);
+        table.metadata = entry.metadata;
+        num_indices    = entry.num_indices;
+
+        this->enforce_limits();
+    }
+
+    return MessageMeta::create_from_cpp(std::move(table), num_indices);
+}
+
+void DataLoaderCache::put(const std::string& key, const std::shared_ptr<MessageMeta>& payload)
+{
+    Entry entry;
+
+    {
+        auto info = payload->get_info();
+
+        auto packed           = cudf::pack(info.get_view());
+        entry.packed_metadata = std::move(*packed.metadata);
+        entry.device_data     = std::move(packed.gpu_data);
+        entry.data_bytes      = entry.device_data->size();
+        entry.num_indices     = info.num_indices();
+
+        for (const auto& name : info.get_index_names())
+        {
+            entry.metadata.schema_info.emplace_back(name);
+        }
+        for (const auto& name : info.get_column_names())
+        {
+            entry.metadata.schema_info.emplace_back(name);
+        }
+    }
+
+    if (entry.data_bytes > m_max_device_bytes)
+    {
+        VLOG(10) << "Payload of " << entry.data_bytes << " bytes is too large to be cached";
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto existing = m_entries.find(key);
+    if (existing != m_entries.end())
+    {
+        this->erase(existing);
+    }
+
+    m_lru.push_front(key);
+    entry.lru_position = m_lru.begin();
+    m_device_bytes += entry.data_bytes;
+    m_entries.emplace(key, std::move(entry));
+
+    this->enforce_limits();
+}
+
+std::size_t DataLoaderCache::device_bytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_device_bytes;
+}
+
+std::size_t DataLoaderCache::host_bytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_host_bytes;
+}
+
+void DataLoaderCache::enforce_limits()
+{
+    // Spills the least recently used tables held in device memory
+    for (auto key = m_lru.rbegin(); m_device_bytes > m_max_device_bytes && key != m_lru.rend(); ++key)
+    {
+        auto& entry = m_entries.at(*key);
+        if (!entry.device_data)
+        {
+            continue;
+        }
+
+        if (m_max_host_bytes > 0)
+        {
+            auto stream = cudf::get_default_stream();
+
+            entry.host_data.resize(entry.data_bytes);
+            MRC_CHECK_CUDA(cudaMemcpyAsync(entry.host_data.data(),
+                                           entry.device_data->data(),
+                                           entry.data_bytes,
+                                           cudaMemcpyDeviceToHost,
+                                           stream.value()));
+            stream.synchronize();
+
+            m_host_bytes += entry.data_bytes;
+        }
+
+        entry.device_data.reset();
+        m_device_bytes -= entry.data_bytes;
+    }
+
+    // Evicts the least recently used spilled tables until host memory is within its limit
+    auto position = m_lru.end();
+    while (position != m_lru.begin())
+    {
+        --position;
+
+        auto entry = m_entries.find(*position);
+        if (!entry->second.device_data && (m_max_host_bytes == 0 || m_host_bytes > m_max_host_bytes))
+        {
+            auto next = std::next(position);
+            this->erase(entry);
+            position = next;
+        }
+    }
+}
+
+void DataLoaderCache::erase(std::unordered_map<std::string, Entry>::iterator entry)
+{
+    if (entry->second.device_data)
+    {
+        m_device_bytes -= entry->second.data_bytes;
+    }
+    else
+    {
+        m_host_bytes -= entry->second.host_data.size();
+    }
+
+    m_lru.erase(entry->second.lru_position);
+    m_entries.erase(entry);
+}
+}  // namespace morpheus
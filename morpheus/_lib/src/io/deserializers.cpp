@@ -22,64 +22,154 @@
 #include "morpheus/utilities/string_util.hpp"
 
 #include <cudf/column/column.hpp>
+#include <cudf/dictionary/encode.hpp>  // for encode
 #include <cudf/io/csv.hpp>
 #include <cudf/io/json.hpp>
 #include <cudf/io/parquet.hpp>
-#include <cudf/table/table.hpp>  // IWYU pragma: keep
-#include <cudf/types.hpp>        // for cudf::type_id
-#include <pybind11/pybind11.h>   // IWYU pragma: keep
+#include <cudf/lists/explode.hpp>      // for explode, explode_outer
+#include <cudf/stream_compaction.hpp>  // for drop_nulls
+#include <cudf/table/table.hpp>        // IWYU pragma: keep
+#include <cudf/types.hpp>              // for cudf::type_id
+#include <cudf/unary.hpp>              // for cast
+#include <cudf/utilities/traits.hpp>   // for is_fixed_width
+#include <glog/logging.h>
+#include <pybind11/pybind11.h>  // IWYU pragma: keep
 
 #include <algorithm>
+#include <cctype>      // for isspace, tolower
+#include <exception>   // for exception
+#include <filesystem>  // for file_size
 #include <iterator>
+#include <map>
 #include <memory>
+#include <numeric>  // for iota
 #include <regex>
+#include <set>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 #include <utility>
 // We're already including pybind11.h, and including only gil.h as IWYU suggests yields an undefined symbol error
 // IWYU pragma: no_include <pybind11/gil.h>
 
 namespace {
-const std::regex IndexRegex(R"(^\s*(unnamed: 0|id)\s*$)",
-                            std::regex_constants::ECMAScript | std::regex_constants::icase);
+using namespace morpheus;
 
-const std::regex UnnamedRegex(R"(^\s*unnamed: 0\s*$)", std::regex_constants::ECMAScript | std::regex_constants::icase);
-}  // namespace
+const std::map<std::string, cudf::type_id> TypeNames = {{"bool", cudf::type_id::BOOL8},
+                                                        {"int8", cudf::type_id::INT8},
+                                                        {"int16", cudf::type_id::INT16},
+                                                        {"int32", cudf::type_id::INT32},
+                                                        {"int64", cudf::type_id::INT64},
+                                                        {"uint8", cudf::type_id::UINT8},
+                                                        {"uint16", cudf::type_id::UINT16},
+                                                        {"uint32", cudf::type_id::UINT32},
+                                                        {"uint64", cudf::type_id::UINT64},
+                                                        {"float32", cudf::type_id::FLOAT32},
+                                                        {"float64", cudf::type_id::FLOAT64},
+                                                        {"str", cudf::type_id::STRING},
+                                                        {"string", cudf::type_id::STRING},
+                                                        {"object", cudf::type_id::STRING},
+                                                        {"category", cudf::type_id::DICTIONARY32},
+                                                        {"datetime64[s]", cudf::type_id::TIMESTAMP_SECONDS},
+                                                        {"datetime64[ms]", cudf::type_id::TIMESTAMP_MILLISECONDS},
+                                                        {"datetime64[us]", cudf::type_id::TIMESTAMP_MICROSECONDS},
+                                                        {"datetime64[ns]", cudf::type_id::TIMESTAMP_NANOSECONDS}};
 
-namespace morpheus {
+// Case insensitive comparison of `name`, ignoring leading and trailing whitespace, with the lower case `expected`
+bool name_matches(std::string_view name, std::string_view expected)
+{
+    while (!name.empty() && std::isspace(static_cast<unsigned char>(name.front())) != 0)
+    {
+        name.remove_prefix(1);
+    }
+    while (!name.empty() && std::isspace(static_cast<unsigned char>(name.back())) != 0)
+    {
+        name.remove_suffix(1);
+    }
 
-std::vector<std::string> get_column_names_from_table(const cudf::io::table_with_metadata& table)
+    return std::equal(name.begin(), name.end(), expected.begin(), expected.end(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == b;
+    });
+}
+
+// Names the element of an exploded list column after the list, keeping the names of the fields of struct elements
+cudf::io::column_name_info element_name_info(cudf::io::column_name_info&& list_info)
 {
-    return foreach_map(table.metadata.schema_info, [](auto schema) { return schema.name; });
+    // The readers name the children of a list column `offsets` and `element`
+    cudf::io::column_name_info info{std::move(list_info.name)};
+    if (!list_info.children.empty())
+    {
+        info.children = std::move(list_info.children.back().children);
+    }
+
+    return info;
 }
 
-cudf::io::table_with_metadata load_table_from_file(const std::string& filename,
-                                                   FileTypes file_type,
-                                                   std::optional<bool> json_lines)
+/**
+ * @brief Appends `col` to `columns` as `name`, or when it is a struct column each of its fields named `name.field`,
+ * recursively. The fields are released from the struct without being copied, the readers and gathers having already
+ * pushed down the nulls of the struct rows to the rows of their fields.
+ */
+void flatten_column(std::unique_ptr<cudf::column>&& col,
+                    cudf::io::column_name_info&& info,
+                    const std::string& name,
+                    std::vector<std::unique_ptr<cudf::column>>& columns,
+                    std::vector<cudf::io::column_name_info>& schema_info)
 {
-    if (file_type == FileTypes::Auto)
+    if (col->type().id() != cudf::type_id::STRUCT)
     {
-        file_type = determine_file_type(filename);  // throws if it is unable to determine the type
+        info.name = name;
+        columns.push_back(std::move(col));
+        schema_info.push_back(std::move(info));
+        return;
     }
 
+    auto contents = col->release();
+    for (std::size_t i = 0; i < contents.children.size(); ++i)
+    {
+        auto field_info = i < info.children.size() ? std::move(info.children[i])
+                                                   : cudf::io::column_name_info{std::to_string(i)};
+        auto field_name = name + "." + field_info.name;
+        flatten_column(std::move(contents.children[i]), std::move(field_info), field_name, columns, schema_info);
+    }
+}
+
+cudf::io::table_with_metadata read_table(const cudf::io::source_info& source,
+                                         FileTypes file_type,
+                                         std::optional<bool> json_lines,
+                                         const TableSchema& schema,
+                                         rmm::cuda_stream_view stream)
+{
     cudf::io::table_with_metadata table;
 
+    // JSON readers parse every column, the columns not in the schema are dropped by `apply_table_schema`
     switch (file_type)
     {
     case FileTypes::JSON: {
-        auto options =
-            cudf::io::json_reader_options::builder(cudf::io::source_info{filename}).lines(json_lines.value_or(true));
-        table        = cudf::io::read_json(options.build());
+        auto options = cudf::io::json_reader_options::builder(source).lines(json_lines.value_or(true));
+        if (!schema.empty())
+        {
+            options.dtypes(schema.dtypes());
+        }
+        table = cudf::io::read_json(options.build(), stream);
         break;
     }
     case FileTypes::CSV: {
-        auto options = cudf::io::csv_reader_options::builder(cudf::io::source_info{filename});
-        table        = cudf::io::read_csv(options.build());
+        auto options = cudf::io::csv_reader_options::builder(source);
+        if (!schema.empty())
+        {
+            options.use_cols_names(schema.column_names).dtypes(schema.dtypes());
+        }
+        table = cudf::io::read_csv(options.build(), stream);
         break;
     }
     case FileTypes::PARQUET: {
-        auto options = cudf::io::parquet_reader_options::builder(cudf::io::source_info{filename});
-        table        = cudf::io::read_parquet(options.build());
+        auto options = cudf::io::parquet_reader_options::builder(source);
+        if (!schema.empty())
+        {
+            options.columns(schema.column_names);
+        }
+        table = cudf::io::read_parquet(options.build(), stream);
         break;
     }
     case FileTypes::Auto:
@@ -87,6 +177,268 @@ cudf::io::table_with_metadata load_table_from_file(const std::string& filename,
         throw std::logic_error(MORPHEUS_CONCAT_STR("Unsupported filetype: " << file_type));
     }
 
+    if (table.tbl)
+    {
+        apply_table_schema(table, schema);
+    }
+
+    return table;
+}
+}  // namespace
+
+namespace morpheus {
+
+bool TableSchema::empty() const
+{
+    return column_names.empty();
+}
+
+std::map<std::string, cudf::data_type> TableSchema::dtypes() const
+{
+    std::map<std::string, cudf::data_type> dtypes;
+    for (std::size_t i = 0; i < column_names.size(); ++i)
+    {
+        // Dictionary columns are parsed as strings, then encoded by `apply_table_schema`
+        const bool is_dictionary = column_types[i].id() == cudf::type_id::DICTIONARY32;
+        dtypes.emplace(column_names[i], is_dictionary ? cudf::data_type{cudf::type_id::STRING} : column_types[i]);
+    }
+
+    return dtypes;
+}
+
+TableSchema TableSchema::from_type_names(const std::vector<std::pair<std::string, std::string>>& columns)
+{
+    TableSchema schema;
+    std::set<std::string> seen;
+
+    for (const auto& [name, type_name] : columns)
+    {
+        auto found = TypeNames.find(type_name);
+        if (found == TypeNames.end())
+        {
+            throw std::invalid_argument(
+                MORPHEUS_CONCAT_STR("Unsupported type '" << type_name << "' for column '" << name << "'"));
+        }
+
+        if (!seen.insert(name).second)
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("Column '" << name << "' is listed more than once"));
+        }
+
+        schema.column_names.push_back(name);
+        schema.column_types.emplace_back(found->second);
+    }
+
+    return schema;
+}
+
+void apply_table_schema(cudf::io::table_with_metadata& table, const TableSchema& schema)
+{
+    if (schema.empty())
+    {
+        return;
+    }
+
+    const auto names = get_column_names_from_table(table);
+    auto columns     = table.tbl->release();
+
+    std::vector<std::unique_ptr<cudf::column>> projected;
+    std::vector<cudf::io::column_name_info> schema_info;
+
+    for (std::size_t i = 0; i < schema.column_names.size(); ++i)
+    {
+        const auto& name = schema.column_names[i];
+        auto found       = std::find(names.begin(), names.end(), name);
+        if (found == names.end() || !columns[std::distance(names.begin(), found)])
+        {
+            throw std::runtime_error(MORPHEUS_CONCAT_STR("Column '" << name << "' of the schema was not found"));
+        }
+
+        const auto idx = std::distance(names.begin(), found);
+        auto column    = std::move(columns[idx]);
+
+        if (schema.column_types[i].id() == cudf::type_id::DICTIONARY32 && column->type().id() == cudf::type_id::STRING)
+        {
+            // Each distinct string is held once, the rows holding an index into them
+            column = cudf::dictionary::encode(column->view());
+        }
+        else if (column->type() != schema.column_types[i])
+        {
+            if (!cudf::is_fixed_width(column->type()) || !cudf::is_fixed_width(schema.column_types[i]))
+            {
+                throw std::runtime_error(
+                    MORPHEUS_CONCAT_STR("Column '" << name << "' can not be cast to the type of the schema"));
+            }
+
+            column = cudf::cast(column->view(), schema.column_types[i]);
+        }
+
+        projected.push_back(std::move(column));
+        schema_info.push_back(std::move(table.metadata.schema_info[idx]));
+    }
+
+    table.tbl                  = std::make_unique<cudf::table>(std::move(projected));
+    table.metadata.schema_info = std::move(schema_info);
+}
+
+ColumnProjection::ColumnProjection(const std::vector<std::string>& patterns)
+{
+    m_patterns.reserve(patterns.size());
+    for (const auto& pattern : patterns)
+    {
+        m_patterns.emplace_back(pattern, std::regex_constants::ECMAScript | std::regex_constants::icase);
+    }
+}
+
+bool ColumnProjection::empty() const
+{
+    return m_patterns.empty();
+}
+
+bool ColumnProjection::keeps(const std::string& column_name) const
+{
+    return std::any_of(m_patterns.cbegin(), m_patterns.cend(), [&column_name](const std::regex& pattern) {
+        return std::regex_search(column_name, pattern);
+    });
+}
+
+void apply_column_projection(cudf::io::table_with_metadata& table, const ColumnProjection& projection)
+{
+    if (projection.empty() || table.tbl->num_columns() == 0)
+    {
+        return;
+    }
+
+    const auto names          = get_column_names_from_table(table);
+    const int index_col_count = get_index_col_count(table);
+    auto columns              = table.tbl->release();
+
+    std::vector<std::unique_ptr<cudf::column>> projected;
+    std::vector<cudf::io::column_name_info> schema_info;
+
+    for (std::size_t i = 0; i < columns.size(); ++i)
+    {
+        if (static_cast<int>(i) < index_col_count || projection.keeps(names[i]))
+        {
+            projected.push_back(std::move(columns[i]));
+            schema_info.push_back(std::move(table.metadata.schema_info[i]));
+        }
+    }
+
+    if (projected.empty())
+    {
+        projected.push_back(std::move(columns[0]));
+        schema_info.push_back(std::move(table.metadata.schema_info[0]));
+    }
+
+    table.tbl                  = std::make_unique<cudf::table>(std::move(projected));
+    table.metadata.schema_info = std::move(schema_info);
+}
+
+void flatten_nested_columns(cudf::io::table_with_metadata& table, bool explode_lists)
+{
+    while (true)
+    {
+        auto columns = table.tbl->release();
+
+        std::vector<std::unique_ptr<cudf::column>> flattened;
+        std::vector<cudf::io::column_name_info> schema_info;
+        for (std::size_t i = 0; i < columns.size(); ++i)
+        {
+            auto& info = table.metadata.schema_info[i];
+            auto name  = info.name;
+            flatten_column(std::move(columns[i]), std::move(info), name, flattened, schema_info);
+        }
+
+        table.tbl                  = std::make_unique<cudf::table>(std::move(flattened));
+        table.metadata.schema_info = std::move(schema_info);
+
+        if (!explode_lists)
+        {
+            return;
+        }
+
+        const auto num_columns   = table.tbl->num_columns();
+        cudf::size_type list_col = 0;
+        while (list_col < num_columns && table.tbl->get_column(list_col).type().id() != cudf::type_id::LIST)
+        {
+            ++list_col;
+        }
+
+        if (list_col == num_columns)
+        {
+            return;
+        }
+
+        // Exploding replaces the list by its elements, whose struct fields are flattened by the next iteration
+        table.tbl  = cudf::explode_outer(table.tbl->view(), list_col);
+        auto& info = table.metadata.schema_info[list_col];
+        info       = element_name_info(std::move(info));
+    }
+}
+
+void select_records(cudf::io::table_with_metadata& table, const std::string& record_path)
+{
+    const auto names = get_column_names_from_table(table);
+    const auto found = std::find(names.cbegin(), names.cend(), record_path);
+    if (found == names.cend())
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Table has no '" << record_path << "' column"));
+    }
+
+    const auto col_idx = static_cast<std::size_t>(std::distance(names.cbegin(), found));
+    auto info          = std::move(table.metadata.schema_info[col_idx]);
+    auto records       = std::move(table.tbl->release()[col_idx]);
+
+    if (records->type().id() == cudf::type_id::LIST)
+    {
+        // Unlike `flatten_nested_columns`, empty lists hold no record and produce no row
+        records = std::move(cudf::explode(cudf::table_view({records->view()}), 0)->release().front());
+        info    = element_name_info(std::move(info));
+    }
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    std::vector<cudf::io::column_name_info> schema_info;
+    if (records->type().id() == cudf::type_id::STRUCT)
+    {
+        // The fields of the records become the columns, without the name of the records as a prefix
+        auto contents = records->release();
+        for (std::size_t i = 0; i < contents.children.size(); ++i)
+        {
+            auto field_info = i < info.children.size() ? std::move(info.children[i])
+                                                       : cudf::io::column_name_info{std::to_string(i)};
+            auto name       = field_info.name;
+            flatten_column(std::move(contents.children[i]), std::move(field_info), name, columns, schema_info);
+        }
+    }
+    else
+    {
+        columns.push_back(std::move(records));
+        schema_info.push_back(std::move(info));
+    }
+
+    table.tbl                  = std::make_unique<cudf::table>(std::move(columns));
+    table.metadata.schema_info = std::move(schema_info);
+}
+
+std::vector<std::string> get_column_names_from_table(const cudf::io::table_with_metadata& table)
+{
+    return foreach_map(table.metadata.schema_info, [](auto schema) { return schema.name; });
+}
+
+cudf::io::table_with_metadata load_table_from_file(const std::string& filename,
+                                                   FileTypes file_type,
+                                                   std::optional<bool> json_lines,
+                                                   const TableSchema& schema,
+                                                   rmm::cuda_stream_view stream)
+{
+    if (file_type == FileTypes::Auto)
+    {
+        file_type = determine_file_type(filename);  // throws if it is unable to determine the type
+    }
+
+    auto table = read_table(cudf::io::source_info{filename}, file_type, json_lines, schema, stream);
+
     if (!table.tbl)
     {
         throw std::runtime_error(MORPHEUS_CONCAT_STR("Failed to load file '" << filename << "' as type " << file_type));
@@ -95,9 +447,97 @@ cudf::io::table_with_metadata load_table_from_file(const std::string& filename,
     return table;
 }
 
-pybind11::object read_file_to_df(const std::string& filename, FileTypes file_type)
+cudf::io::table_with_metadata load_table_from_buffer(const char* data,
+                                                     std::size_t size,
+                                                     FileTypes file_type,
+                                                     std::optional<bool> json_lines,
+                                                     const TableSchema& schema,
+                                                     rmm::cuda_stream_view stream)
 {
-    auto table          = load_table_from_file(filename, file_type);
+    auto table = read_table(cudf::io::source_info{data, size}, file_type, json_lines, schema, stream);
+
+    if (!table.tbl)
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Failed to load buffer as type " << file_type));
+    }
+
+    return table;
+}
+
+cudf::io::table_with_metadata read_json_lines_recovering(const char* data,
+                                                         std::size_t size,
+                                                         const TableSchema& schema,
+                                                         bool always_recover,
+                                                         cudf::size_type& num_malformed,
+                                                         rmm::cuda_stream_view stream)
+{
+    num_malformed = 0;
+
+    auto read = [&](bool recover) {
+        auto options = cudf::io::json_reader_options::builder(cudf::io::source_info{data, size}).lines(true);
+        if (recover)
+        {
+            options.recovery_mode(cudf::io::json_recovery_mode_t::RECOVER_WITH_NULL);
+        }
+
+        if (!schema.empty())
+        {
+            options.dtypes(schema.dtypes());
+        }
+
+        return cudf::io::read_json(options.build(), stream);
+    };
+
+    if (!always_recover)
+    {
+        try
+        {
+            return read(false);
+        } catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Failed to parse JSON lines, parsing them again skipping the malformed lines: " << e.what();
+        }
+    }
+
+    auto table = read(true);
+
+    if (table.tbl && table.tbl->num_columns() > 0)
+    {
+        // Keep any row with at least one valid value
+        std::vector<cudf::size_type> keys(table.tbl->num_columns());
+        std::iota(keys.begin(), keys.end(), 0);
+
+        auto filtered = cudf::drop_nulls(table.tbl->view(), keys, 1, stream);
+
+        num_malformed = table.tbl->num_rows() - filtered->num_rows();
+        if (num_malformed > 0)
+        {
+            table.tbl = std::move(filtered);
+        }
+    }
+
+    return table;
+}
+
+pybind11::object read_file_to_df(const std::string& filename,
+                                 FileTypes file_type,
+                                 std::optional<bool> json_lines,
+                                 const std::string& record_path,
+                                 bool flatten,
+                                 bool explode_lists)
+{
+    auto table = load_table_from_file(filename, file_type, json_lines);
+
+    if (!record_path.empty())
+    {
+        select_records(table, record_path);
+    }
+
+    if (flatten)
+    {
+        flatten_nested_columns(table, explode_lists);
+    }
+
     int index_col_count = prepare_df_index(table);
 
     pybind11::gil_scoped_acquire gil;
@@ -120,7 +560,7 @@ int get_index_col_count(const cudf::io::table_with_metadata& data_table)
         const auto& col_name = names[0];
 
         // Check it against some common terms
-        if (std::regex_search(col_name, IndexRegex))
+        if (name_matches(col_name, "unnamed: 0") || name_matches(col_name, "id"))
         {
             index_col_count = 1;
         }
@@ -138,7 +578,7 @@ int prepare_df_index(cudf::io::table_with_metadata& data_table)
         auto& col_name = data_table.metadata.schema_info[0].name;
 
         // Also, if its the hideous 'Unnamed: 0', then just use an empty string
-        if (std::regex_search(col_name, UnnamedRegex))
+        if (name_matches(col_name, "unnamed: 0"))
         {
             col_name.clear();
         }
@@ -147,4 +587,160 @@ int prepare_df_index(cudf::io::table_with_metadata& data_table)
     return index_col_count;
 }
 
+ChunkedTableReader::ChunkedTableReader(std::string filename,
+                                       FileTypes file_type,
+                                       std::size_t chunk_bytes,
+                                       std::optional<bool> json_lines,
+                                       TableSchema schema) :
+  m_filename(std::move(filename)),
+  m_file_type(file_type),
+  m_chunk_bytes(chunk_bytes),
+  m_schema(std::move(schema))
+{
+    if (m_chunk_bytes == 0)
+    {
+        throw std::invalid_argument("chunk_bytes must be greater than zero");
+    }
+
+    if (m_file_type == FileTypes::Auto)
+    {
+        m_file_type = determine_file_type(m_filename);  // throws if it is unable to determine the type
+    }
+
+    switch (m_file_type)
+    {
+    case FileTypes::JSON: {
+        if (!json_lines.value_or(true))
+        {
+            throw std::invalid_argument("Only JSON lines files can be read in chunks");
+        }
+        m_file_bytes = std::filesystem::file_size(m_filename);
+        break;
+    }
+    case FileTypes::CSV: {
+        m_file_bytes = std::filesystem::file_size(m_filename);
+        break;
+    }
+    case FileTypes::PARQUET: {
+        auto options = cudf::io::parquet_reader_options::builder(cudf::io::source_info{m_filename}).build();
+        if (!m_schema.empty())
+        {
+            options.set_columns(m_schema.column_names);
+        }
+        m_parquet_reader = std::make_unique<cudf::io::chunked_parquet_reader>(m_chunk_bytes, options);
+        break;
+    }
+    case FileTypes::Auto:
+    default:
+        throw std::logic_error(MORPHEUS_CONCAT_STR("Unsupported filetype: " << m_file_type));
+    }
+}
+
+ChunkedTableReader::~ChunkedTableReader() = default;
+
+std::optional<cudf::io::table_with_metadata> ChunkedTableReader::next()
+{
+    if (m_parquet_reader)
+    {
+        while (m_parquet_reader->has_next())
+        {
+            auto table = m_parquet_reader->read_chunk();
+            if (table.tbl && table.tbl->num_rows() > 0)
+            {
+                apply_table_schema(table, m_schema);
+                return table;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    while (m_offset < m_file_bytes)
+    {
+        auto table = read_byte_range();
+        m_offset += m_chunk_bytes;
+
+        // A range may not hold the start of any row when rows are longer than `m_chunk_bytes`
+        if (table.tbl && table.tbl->num_rows() > 0)
+        {
+            return table;
+        }
+    }
+
+    return std::nullopt;
+}
+
+cudf::io::table_with_metadata ChunkedTableReader::read_byte_range()
+{
+    const bool is_first = m_offset == 0;
+    cudf::io::table_with_metadata table;
+
+    if (m_file_type == FileTypes::JSON)
+    {
+        auto options = cudf::io::json_reader_options::builder(cudf::io::source_info{m_filename})
+                           .lines(true)
+                           .byte_range_offset(m_offset)
+                           .byte_range_size(m_chunk_bytes);
+
+        if (is_first && !m_schema.empty())
+        {
+            options.dtypes(m_schema.dtypes());
+        }
+        else if (!is_first)
+        {
+            // Keeps the types of the columns from changing between chunks, nested types are left to be inferred since
+            // their children are not described by a `data_type`
+            std::map<std::string, cudf::data_type> dtypes;
+            for (std::size_t i = 0; i < m_column_names.size(); ++i)
+            {
+                const auto type_id = m_column_types[i].id();
+                if (type_id != cudf::type_id::LIST && type_id != cudf::type_id::STRUCT)
+                {
+                    dtypes.emplace(m_column_names[i], m_column_types[i]);
+                }
+            }
+            options.dtypes(dtypes);
+        }
+
+        table = cudf::io::read_json(options.build());
+    }
+    else
+    {
+        auto options = cudf::io::csv_reader_options::builder(cudf::io::source_info{m_filename})
+                           .byte_range_offset(m_offset)
+                           .byte_range_size(m_chunk_bytes);
+
+        if (!is_first)
+        {
+            // Only the first range holds the header
+            options.header(-1).names(m_column_names).dtypes(m_column_types);
+        }
+        else if (!m_schema.empty())
+        {
+            options.dtypes(m_schema.dtypes());
+        }
+
+        table = cudf::io::read_csv(options.build());
+    }
+
+    if (!table.tbl)
+    {
+        throw std::runtime_error(
+            MORPHEUS_CONCAT_STR("Failed to load byte range " << m_offset << " of file '" << m_filename << "'"));
+    }
+
+    if (is_first)
+    {
+        m_column_names = get_column_names_from_table(table);
+        for (cudf::size_type i = 0; i < table.tbl->num_columns(); ++i)
+        {
+            m_column_types.push_back(table.tbl->get_column(i).type());
+        }
+    }
+
+    apply_table_schema(table, m_schema);
+
+    return table;
+}
+
 }  // namespace morpheus
@@ -17,9 +17,17 @@
 
 #include "morpheus/io/loaders/file.hpp"
 
+#include "morpheus/io/deserializers.hpp"  // for load_table_from_file
 #include "morpheus/messages/control.hpp"
 #include "morpheus/messages/meta.hpp"
-
+#include "morpheus/objects/file_types.hpp"  // for FileTypes
+#include "morpheus/utilities/cudf_util.hpp"  // for CudfHelper
+#include "morpheus/utilities/string_util.hpp"
+#include "morpheus/utilities/table_util.hpp"  // for CuDFTableUtil
+
+#include <cudf/io/avro.hpp>   // for read_avro
+#include <cudf/io/orc.hpp>    // for read_orc
+#include <cudf/io/types.hpp>  // for table_with_metadata, source_info
 #include <glog/logging.h>
 #include <nlohmann/json.hpp>
 #include <pybind11/gil.h>
@@ -34,99 +42,141 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace py = pybind11;
 
-namespace morpheus {
+namespace {
+using namespace morpheus;
 
-FileDataLoader::FileDataLoader(nlohmann::json config) : Loader(config) {}
+// File types libcudf has no reader for, loaded through the cudf python module
+bool requires_python(const std::string& file_type)
+{
+    return file_type == "feather" || file_type == "hdf";
+}
 
-std::shared_ptr<ControlMessage> FileDataLoader::load(std::shared_ptr<ControlMessage> message, nlohmann::json task)
+std::string get_file_type(const nlohmann::json& file)
 {
-    VLOG(30) << "Called FileDataLoader::load()";
+    std::filesystem::path path(file.value("path", ""));
+    std::string extension = file.value("type", path.extension().string());
+    // Remove the leading period
+    if (!extension.empty() && extension[0] == '.')
+    {
+        extension = extension.substr(1);
+    }
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
-    // Aggregate dataframes for each file
-    py::gil_scoped_acquire gil;
-    py::module_ mod_cudf;
+    return extension;
+}
 
-    auto& cache_handle = mrc::pymrc::PythonObjectCache::get_handle();
-    mod_cudf           = cache_handle.get_module("cudf");
+cudf::io::table_with_metadata read_file(const nlohmann::json& file, const std::string& file_type)
+{
+    std::string path = file.value("path", "");
 
-    // TODO(Devin) : error checking + improve robustness
-    if (!task["files"].is_array() or task.empty())
+    if (file_type == "csv")
     {
-        throw std::runtime_error("'File Loader' control message specified no files to load");
+        return load_table_from_file(path, FileTypes::CSV);
     }
 
-    std::string strategy = task.value("strategy", "aggregate");
-    if (strategy != "aggregate")
+    if (file_type == "json" || file_type == "jsonlines")
     {
-        throw std::runtime_error("Only 'aggregate' strategy is currently supported");
+        // Matches `cudf.read_json` which does not default to JSON lines
+        return load_table_from_file(path, FileTypes::JSON, file.value("lines", file_type == "jsonlines"));
     }
 
-    auto files           = task["files"];
-    py::object dataframe = py::none();
-    // TODO(Devin) : Migrate this to use the cudf::io interface
-    for (auto& file : files)
+    if (file_type == "parquet")
     {
-        std::filesystem::path path(file.value("path", ""));
-        std::string extension = file.value("type", path.extension().string());
-        // Remove the leading period
-        if (!extension.empty() && extension[0] == '.')
-        {
-            extension = extension.substr(1);
-        }
-        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        return load_table_from_file(path, FileTypes::PARQUET);
+    }
 
-        VLOG(5) << "Loading file: " << file.dump(2);
+    if (file_type == "orc")
+    {
+        auto options = cudf::io::orc_reader_options::builder(cudf::io::source_info{path});
+        return cudf::io::read_orc(options.build());
+    }
 
-        // TODO(Devin): Any extensions missing?
-        auto current_df = mod_cudf.attr("DataFrame")();
-        if (extension == "csv")
-        {
-            current_df = mod_cudf.attr("read_csv")(path.string());
-        }
-        else if (extension == "parquet")
-        {
-            current_df = mod_cudf.attr("read_parquet")(path.string());
-        }
-        else if (extension == "orc")
-        {
-            current_df = mod_cudf.attr("read_orc")(path.string());
-        }
-        else if (extension == "json")
-        {
-            current_df = mod_cudf.attr("read_json")(path.string());
-        }
-        else if (extension == "feather")
+    if (file_type == "avro")
+    {
+        auto options = cudf::io::avro_reader_options::builder(cudf::io::source_info{path});
+        return cudf::io::read_avro(options.build());
+    }
+
+    throw std::runtime_error(MORPHEUS_CONCAT_STR("Unsupported file type '" << file_type << "' for file '" << path << "'"));
+}
+
+std::shared_ptr<MessageMeta> load_with_python(const nlohmann::json& files)
+{
+    py::gil_scoped_acquire gil;
+
+    auto& cache_handle = mrc::pymrc::PythonObjectCache::get_handle();
+    auto mod_cudf      = cache_handle.get_module("cudf");
+
+    py::list dataframes;
+    for (const auto& file : files)
+    {
+        auto file_type = get_file_type(file);
+        auto path      = file.value("path", "");
+
+        if (file_type == "feather")
         {
-            current_df = mod_cudf.attr("read_feather")(path.string());
+            dataframes.append(mod_cudf.attr("read_feather")(path));
         }
-        else if (extension == "hdf")
+        else if (file_type == "hdf")
         {
-            current_df = mod_cudf.attr("read_hdf")(path.string());
+            dataframes.append(mod_cudf.attr("read_hdf")(path));
         }
-        else if (extension == "avro")
+        else
         {
-            current_df = mod_cudf.attr("read_avro")(path.string());
+            dataframes.append(CudfHelper::table_from_table_with_metadata(read_file(file, file_type), 0));
         }
+    }
 
-        if (dataframe.is_none())
-        {
-            dataframe = current_df;
-            continue;
-        }
+    return MessageMeta::create_from_python(mod_cudf.attr("concat")(dataframes));
+}
 
-        if (strategy == "aggregate")
-        {
-            py::list args;
-            args.attr("append")(dataframe);
-            args.attr("append")(current_df);
-            dataframe = mod_cudf.attr("concat")(args);
-        }
+std::shared_ptr<MessageMeta> load_with_cudf(const nlohmann::json& files)
+{
+    std::vector<cudf::io::table_with_metadata> tables;
+    for (const auto& file : files)
+    {
+        tables.emplace_back(read_file(file, get_file_type(file)));
+    }
+
+    return MessageMeta::create_from_cpp(CuDFTableUtil::concatenate_tables(std::move(tables)));
+}
+}  // namespace
+
+namespace morpheus {
+
+FileDataLoader::FileDataLoader(nlohmann::json config) : Loader(config) {}
+
+std::shared_ptr<ControlMessage> FileDataLoader::load(std::shared_ptr<ControlMessage> message, nlohmann::json task)
+{
+    VLOG(30) << "Called FileDataLoader::load()";
+
+    if (!task["files"].is_array() || task["files"].empty())
+    {
+        throw std::runtime_error("'File Loader' control message specified no files to load");
     }
 
-    message->payload(MessageMeta::create_from_python(std::move(dataframe)));
+    std::string strategy = task.value("strategy", "aggregate");
+    if (strategy != "aggregate")
+    {
+        throw std::runtime_error("Only 'aggregate' strategy is currently supported");
+    }
+
+    const auto& files = task["files"];
+    for (const auto& file : files)
+    {
+        VLOG(5) << "Loading file: " << file.dump(2);
+    }
+
+    // Files are read and aggregated by libcudf without holding the GIL, unless one of them can only be read by python
+    bool use_python = std::any_of(files.begin(), files.end(), [](const auto& file) {
+        return requires_python(get_file_type(file));
+    });
+
+    message->payload(use_python ? load_with_python(files) : load_with_cudf(files));
     return message;
 }
 }  // namespace morpheus
@@ -17,12 +17,260 @@
 
 #include "morpheus/io/loaders/grpc.hpp"
 
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/utilities/table_util.hpp"  // for CuDFTableUtil
+
+#include <cudf/io/json.hpp>   // for read_json
+#include <cudf/io/types.hpp>  // for table_with_metadata, source_info
 #include <glog/logging.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/grpcpp.h>
 #include <nlohmann/json.hpp>
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <ostream>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr std::size_t DefaultBatchBytes = 16 * 1024 * 1024;
+
+std::string decode_base64(const std::string& encoded)
+{
+    static const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string decoded;
+    decoded.reserve(encoded.size() * 3 / 4);
+
+    std::uint32_t bits = 0;
+    int num_bits       = 0;
+    for (char c : encoded)
+    {
+        if (c == '=')
+        {
+            break;
+        }
+
+        auto value = alphabet.find(c);
+        if (value == std::string::npos)
+        {
+            throw std::runtime_error("'GRPC Loader' received an invalid base64 request");
+        }
+
+        bits = (bits << 6) | static_cast<std::uint32_t>(value);
+        num_bits += 6;
+        if (num_bits >= 8)
+        {
+            num_bits -= 8;
+            decoded.push_back(static_cast<char>((bits >> num_bits) & 0xff));
+        }
+    }
+
+    return decoded;
+}
+
+/**
+ * @brief Appends the contents of the length-delimited field `field_number` of the serialized protobuf `message` to
+ * `batch` followed by a new line, a `field_number` of 0 appends the whole message.
+ */
+void append_payload(const std::string& message, std::uint64_t field_number, std::string& batch)
+{
+    if (field_number == 0)
+    {
+        batch += message;
+    }
+    else
+    {
+        std::size_t pos  = 0;
+        auto read_varint = [&]() {
+            std::uint64_t value = 0;
+            for (int shift = 0; pos < message.size() && shift < 64; shift += 7)
+            {
+                auto byte = static_cast<std::uint8_t>(message[pos++]);
+                value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return value;
+                }
+            }
+
+            throw std::runtime_error("'GRPC Loader' received a malformed message");
+        };
+
+        while (pos < message.size())
+        {
+            auto tag = read_varint();
+            switch (tag & 0x7)
+            {
+            case 0:  // varint
+                read_varint();
+                break;
+            case 1:  // 64-bit
+                pos += 8;
+                break;
+            case 2: {  // length-delimited
+                auto length = read_varint();
+                if (length > message.size() - pos)
+                {
+                    throw std::runtime_error("'GRPC Loader' received a malformed message");
+                }
+                if ((tag >> 3) == field_number)
+                {
+                    batch.append(message, pos, length);
+                }
+                pos += length;
+                break;
+            }
+            case 5:  // 32-bit
+                pos += 4;
+                break;
+            default:
+                throw std::runtime_error("'GRPC Loader' received a malformed message");
+            }
+        }
+    }
+
+    // Each message holds one or more JSON lines records
+    if (!batch.empty() && batch.back() != '\n')
+    {
+        batch += '\n';
+    }
+}
+
+cudf::io::table_with_metadata parse_batch(const std::string& batch)
+{
+    auto options =
+        cudf::io::json_reader_options::builder(cudf::io::source_info{batch.data(), batch.size()}).lines(true);
+
+    return cudf::io::read_json(options.build());
+}
+
+/**
+ * @brief A server-streaming call to a method known only by its name, the request and responses being serialized
+ * messages. A single read is outstanding at a time, leaving the flow control of the stream to apply backpressure to
+ * the server while the received messages are being parsed.
+ */
+class GenericStreamingCall
+{
+  public:
+    GenericStreamingCall(std::shared_ptr<grpc::Channel> channel,
+                         const std::string& method,
+                         const nlohmann::json& metadata,
+                         std::chrono::milliseconds timeout) :
+      m_stub(std::move(channel))
+    {
+        for (const auto& [key, value] : metadata.items())
+        {
+            m_context.AddMetadata(key, value.get<std::string>());
+        }
+
+        if (timeout.count() > 0)
+        {
+            m_context.set_deadline(std::chrono::system_clock::now() + timeout);
+        }
+
+        m_call = m_stub.PrepareCall(&m_context, method, &m_queue);
+    }
+
+    ~GenericStreamingCall()
+    {
+        if (m_call && !m_finished)
+        {
+            m_context.TryCancel();
+            this->finish();
+        }
+
+        m_queue.Shutdown();
+
+        void* tag;
+        bool ok;
+        while (m_queue.Next(&tag, &ok)) {}
+    }
+
+    /**
+     * @brief Starts the call and sends `request`, returns false when the call failed
+     */
+    bool start(const std::string& request)
+    {
+        grpc::Slice slice(request);
+        grpc::ByteBuffer buffer(&slice, 1);
+
+        m_call->StartCall(this);
+        if (!this->wait())
+        {
+            return false;
+        }
+
+        m_call->Write(buffer, this);
+        if (!this->wait())
+        {
+            return false;
+        }
+
+        m_call->WritesDone(this);
+        return this->wait();
+    }
+
+    /**
+     * @brief Reads the next message of the stream into `message`, returns false at the end of the stream
+     */
+    bool read(std::string& message)
+    {
+        grpc::ByteBuffer buffer;
+        m_call->Read(&buffer, this);
+        if (!this->wait())
+        {
+            return false;
+        }
+
+        std::vector<grpc::Slice> slices;
+        buffer.Dump(&slices);
+
+        message.clear();
+        for (const auto& slice : slices)
+        {
+            message.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+        }
+
+        return true;
+    }
+
+    void cancel()
+    {
+        m_context.TryCancel();
+    }
+
+    grpc::Status finish()
+    {
+        grpc::Status status;
+        m_call->Finish(&status, this);
+        this->wait();
+        m_finished = true;
+
+        return status;
+    }
+
+  private:
+    bool wait()
+    {
+        void* tag;
+        bool ok = false;
+
+        return m_queue.Next(&tag, &ok) && ok;
+    }
+
+    grpc::GenericStub m_stub;
+    grpc::ClientContext m_context;
+    grpc::CompletionQueue m_queue;
+    std::unique_ptr<grpc::GenericClientAsyncReaderWriter> m_call;
+    bool m_finished{false};
+};
+}  // namespace
 
 namespace morpheus {
 GRPCDataLoader::GRPCDataLoader(nlohmann::json config) : Loader(config) {}
@@ -31,7 +279,94 @@ std::shared_ptr<ControlMessage> GRPCDataLoader::load(std::shared_ptr<ControlMess
 {
     VLOG(30) << "Called GRPCDataLoader::load()";
 
-    // TODO(Devin): Implement this
-    throw std::runtime_error("GRPCDataLoader::load() not implemented yet");
+    if (!task.is_object())
+    {
+        throw std::runtime_error("'GRPC Loader' control message specified no call to make");
+    }
+
+    auto conf = this->config().is_object() ? this->config() : nlohmann::json::object();
+
+    std::size_t batch_bytes = conf.value("batch_bytes", DefaultBatchBytes);
+    bool use_tls            = conf.value("use_tls", false);
+
+    std::string endpoint = task.value("endpoint", "");
+    std::string method   = task.value("method", "");
+    if (endpoint.empty() || method.empty())
+    {
+        throw std::runtime_error("'GRPC Loader' control message must specify an endpoint and a method");
+    }
+
+    std::string strategy = task.value("strategy", "aggregate");
+    if (strategy != "aggregate")
+    {
+        throw std::runtime_error("Only 'aggregate' strategy is currently supported");
+    }
+
+    std::string format = task.value("format", "jsonlines");
+    if (format != "jsonlines")
+    {
+        throw std::runtime_error("'GRPC Loader' received format not supported: " + format);
+    }
+
+    auto request       = decode_base64(task.value("request_base64", ""));
+    auto field_number  = task.value("payload_field", std::uint64_t{0});
+    auto max_messages  = task.value("max_messages", std::size_t{0});
+    auto timeout       = std::chrono::milliseconds(task.value("timeout_ms", 0));
+    const auto& fields = task.value("metadata", nlohmann::json::object());
+
+    grpc::ChannelArguments args;
+    args.SetMaxReceiveMessageSize(-1);
+    auto credentials = use_tls ? grpc::SslCredentials(grpc::SslCredentialsOptions())
+                               : grpc::InsecureChannelCredentials();
+
+    GenericStreamingCall call(grpc::CreateCustomChannel(endpoint, credentials, args), method, fields, timeout);
+
+    // Messages are accumulated into batches of JSON lines, each batch being parsed once it reaches `batch_bytes`
+    std::vector<cudf::io::table_with_metadata> tables;
+    std::string batch;
+    std::string response;
+    std::size_t num_messages = 0;
+    bool cancelled           = false;
+
+    if (call.start(request))
+    {
+        while (call.read(response))
+        {
+            append_payload(response, field_number, batch);
+
+            if (batch.size() >= batch_bytes)
+            {
+                tables.emplace_back(parse_batch(batch));
+                batch.clear();
+            }
+
+            if (max_messages > 0 && ++num_messages >= max_messages)
+            {
+                call.cancel();
+                cancelled = true;
+                break;
+            }
+        }
+    }
+
+    auto status = call.finish();
+    if (!status.ok() && !(cancelled && status.error_code() == grpc::StatusCode::CANCELLED))
+    {
+        throw std::runtime_error("'GRPC Loader' call to " + method + " failed: " + status.error_message());
+    }
+
+    if (!batch.empty())
+    {
+        tables.emplace_back(parse_batch(batch));
+    }
+
+    if (tables.empty())
+    {
+        throw std::runtime_error("'GRPC Loader' received no data");
+    }
+
+    message->payload(MessageMeta::create_from_cpp(CuDFTableUtil::concatenate_tables(std::move(tables))));
+
+    return message;
 }
-}  // namespace morpheus
\ No newline at end of file
+}  // namespace morpheus
@@ -19,39 +19,18 @@
 
 #include "morpheus/messages/control.hpp"
 #include "morpheus/messages/meta.hpp"
+#include "morpheus/utilities/http_client.hpp"  // for AsyncHttpClient, HttpClientRequest, url_encode, url_quote
+#include "morpheus/utilities/table_util.hpp"  // for CuDFTableUtil
 
-#include <boost/asio.hpp>
-#include <boost/asio/any_io_executor.hpp>
-#include <boost/asio/io_context.hpp>
-#include <boost/asio/ip/tcp.hpp>
-#include <boost/beast/core.hpp>
-#include <boost/beast/core/buffers_to_string.hpp>
-#include <boost/beast/core/error.hpp>
-#include <boost/beast/core/flat_buffer.hpp>
-#include <boost/beast/core/multi_buffer.hpp>
-#include <boost/beast/core/rate_policy.hpp>
-#include <boost/beast/core/tcp_stream.hpp>
-#include <boost/beast/http.hpp>
-#include <boost/beast/http/basic_dynamic_body.hpp>
-#include <boost/beast/http/dynamic_body.hpp>
-#include <boost/beast/http/error.hpp>
 #include <boost/beast/http/field.hpp>
-#include <boost/beast/http/fields.hpp>
 #include <boost/beast/http/message.hpp>
-#include <boost/beast/http/status.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/http/verb.hpp>
 #include <boost/beast/version.hpp>
-#include <boost/intrusive/detail/algo_type.hpp>
-#include <boost/intrusive/link_mode.hpp>
-#include <boost/system/detail/errc.hpp>
-#include <boost/system/detail/error_code.hpp>
+#include <cudf/io/json.hpp>   // for read_json
+#include <cudf/io/types.hpp>  // for table_with_metadata, source_info
 #include <glog/logging.h>
 #include <nlohmann/json.hpp>
-#include <pybind11/gil.h>
-#include <pybind11/pybind11.h>
-#include <pybind11/pytypes.h>
-#include <pymrc/utilities/object_cache.hpp>
 
 #include <algorithm>
 #include <cctype>
@@ -60,16 +39,17 @@
 #include <ostream>
 #include <stdexcept>
 #include <string>
-#include <thread>
 #include <utility>
-
-namespace py = pybind11;
+#include <vector>
 
 namespace beast = boost::beast;
 namespace http  = beast::http;
-namespace net   = boost::asio;
 
 namespace {
+using namespace morpheus;
+
+using url_params_t = std::vector<std::pair<std::string, std::string>>;
+
 void extract_query_fields(nlohmann::json& query,
                           std::string& method,
                           std::string& endpoint,
@@ -134,10 +114,7 @@ void construct_request(http::request<http::string_body>& request,
     //     https://www.boost.org/doc/libs/1_82_0/libs/beast/doc/html/beast/design_choices/faq.html)
     //   - The default value of http_version is 1.1 if not specified within REST loader's config, since Beast sets
     //     to 1.1 by default.
-    //   - Beast provides http client examples compatible with HTTP/1.0 (see
-    //     https://www.boost.org/doc/libs/1_82_0/libs/beast/example/http/client/sync/http_client_sync.cpp). REST loader
-    //     implements the http client in the same way as Beast's example, providing support to HTTP/1.0 if explicitly
-    //     specified in the config.
+    //   - HTTP/1.0 connections are closed by the server after each response, and are not reused.
     if (http_version != "1.1" && http_version != "1.0")
     {
         throw std::runtime_error("'REST Loader' received http version not supported: " + http_version);
@@ -159,170 +136,116 @@ void construct_request(http::request<http::string_body>& request,
     }
 }
 
-void get_response_with_retry(http::request<http::string_body>& request,
-                             const std::string& port,
-                             http::response<http::dynamic_body>& response,
-                             int max_retry,
-                             int retry_interval_milliseconds)
+void set_url_param(url_params_t& params, std::string key, std::string value)
 {
-    net::io_context ioc;
-    net::ip::tcp::resolver resolver(ioc);
-    beast::tcp_stream stream(ioc);
-    auto const endpoint_results = resolver.resolve(std::string(request[http::field::host]), port);
-    while (max_retry > 0)
+    auto existing = std::find_if(params.begin(), params.end(), [&key](const auto& param) {
+        return param.first == key;
+    });
+
+    if (existing != params.end())
     {
-        stream.connect(endpoint_results);
-        http::write(stream, request);
-        beast::flat_buffer buffer;
-        http::read(stream, buffer, response);
-        beast::error_code ec;
-        stream.socket().shutdown(net::ip::tcp::socket::shutdown_both, ec);
-        if (ec && ec != beast::errc::not_connected)
-        {
-            throw beast::system_error{ec};
-        }
-        unsigned status = response.result_int();
-        // Retry only if status is 503 Service Unavailable / 504 Gateway Timeout
-        if (status != (unsigned)http::status::service_unavailable && status != (unsigned)http::status::gateway_timeout)
-        {
-            break;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(retry_interval_milliseconds));
-        retry_interval_milliseconds *= 2;
-        max_retry--;
+        existing->second = std::move(value);
     }
-    if (max_retry == 0)
+    else
     {
-        throw std::runtime_error("'REST loader' reaches max_retry count");
+        params.emplace_back(std::move(key), std::move(value));
     }
 }
 
-py::dict convert_url_query_to_dict(const py::str& raw_query)
+url_params_t convert_url_query_to_params(const std::string& raw_query)
 {
-    // Convert query string (param1=true&param2=false) into Python dict ({"param1": "true", "param2": "false"}) for
+    // Convert query string (param1=true&param2=false) into key/value pairs ({"param1": "true", "param2": "false"}) for
     // encoding
-    py::dict params_dict;
-    if (py::len(raw_query) > 0)
+    url_params_t params;
+    std::size_t start = 0;
+    while (start < raw_query.size())
     {
-        py::list split_by_amp = raw_query.attr("split")("&");
-
-        for (auto& query_kv : split_by_amp)
+        auto end = std::min(raw_query.find('&', start), raw_query.size());
+        auto kv  = raw_query.substr(start, end - start);
+        auto eq  = kv.find('=');
+        if (eq == std::string::npos)
         {
-            py::list split_by_eq = query_kv.attr("split")("=");
-            if (py::len(split_by_eq) < 2)
-            {
-                throw std::runtime_error("'REST Loader' failed to parse URL query: " + raw_query.cast<std::string>());
-            }
-            params_dict[split_by_eq[0]] = split_by_eq[1];
+            throw std::runtime_error("'REST Loader' failed to parse URL query: " + raw_query);
         }
+
+        set_url_param(params, kv.substr(0, eq), kv.substr(eq + 1, kv.find('=', eq + 1) - eq - 1));
+        start = end + 1;
     }
-    return params_dict;
+
+    return params;
 }
 
 void parse_endpoint(std::string& endpoint, std::string& host, std::string& target, std::string& query)
 {
-    py::gil_scoped_acquire gil;
-    py::module_ urllib = py::module::import("urllib.parse");
-
-    // Following the syntax specifications in RFC 1808, urlparse recognizes a netloc only if it is properly
-    // introduced by ‘//’. Otherwise the input is presumed to be a relative URL and thus to start with a path component
-    // ref: https://docs.python.org/3/library/urllib.parse.html
+    // Following the syntax specifications in RFC 1808, a netloc is only recognized if it is properly introduced by
+    // ‘//’. Otherwise the input is presumed to be a relative URL and thus to start with a path component.
     // Workaround here is to prepend "http://" if endpoint does not already include one
     if (endpoint.find("//") == std::string::npos)
     {
         endpoint = "http://" + endpoint;
     }
 
-    py::object result = urllib.attr("urlparse")(endpoint);
+    const auto netloc_start = endpoint.find("//") + 2;
+    const auto netloc_end   = std::min(endpoint.find_first_of("/?#", netloc_start), endpoint.size());
+    auto netloc             = endpoint.substr(netloc_start, netloc_end - netloc_start);
+
+    // Remove any user info and port
+    netloc = netloc.substr(netloc.rfind('@') == std::string::npos ? 0 : netloc.rfind('@') + 1);
+    if (!netloc.empty() && netloc.front() == '[')
+    {
+        host = netloc.substr(1, netloc.find(']') - 1);
+    }
+    else
+    {
+        host = netloc.substr(0, netloc.find(':'));
+    }
+    std::transform(host.begin(), host.end(), host.begin(), ::tolower);
 
-    // If not present in URL:
-    //  - host: None
-    //  - path/query: Empty Python String
-    host = result.attr("hostname").is_none() ? "" : result.attr("hostname").cast<std::string>();
+    auto rest           = endpoint.substr(netloc_end);
+    rest                = rest.substr(0, rest.find('#'));
+    const auto query_at = rest.find('?');
 
     // Encode URL target
-    target = urllib.attr("quote")(result.attr("path")).cast<std::string>();
+    target = url_quote(rest.substr(0, query_at), "/");
     target = target.empty() ? "/" : target;
 
-    py::str raw_query = result.attr("query");
-    py::dict query_pydict;
-    query_pydict = convert_url_query_to_dict(raw_query);
-
     // Encode URL query
-    query = py::len(query_pydict) == 0 ? "" : "?" + urllib.attr("urlencode")(query_pydict).cast<std::string>();
+    query = url_encode(convert_url_query_to_params(query_at == std::string::npos ? "" : rest.substr(query_at + 1)));
 }
 
-void parse_params(nlohmann::json& params, std::string& query)
+std::string param_to_string(const nlohmann::json& value)
 {
-    py::gil_scoped_acquire gil;
-    py::module_ urllib = py::module::import("urllib.parse");
+    // Matches the string representation of the equivalent python objects
+    if (value.is_string())
+    {
+        return value.get<std::string>();
+    }
 
-    py::dict query_pydict;
-    for (auto& param : params.items())
+    if (value.is_boolean())
     {
-        query_pydict[py::str(param.key())] = py::str(param.value());
+        return value.get<bool>() ? "True" : "False";
     }
-    query = py::len(query_pydict) == 0 ? "" : "?" + urllib.attr("urlencode")(query_pydict).cast<std::string>();
-}
 
-void get_response_from_endpoint(http::response<http::dynamic_body>& response,
-                                std::string& method,
-                                std::string& host,
-                                std::string& target,
-                                std::string& query,
-                                std::string& port,
-                                std::string& http_version,
-                                std::string& content_type,
-                                std::string& body,
-                                nlohmann::json& x_headers,
-                                int max_retry,
-                                int retry_interval_milliseconds)
-{
-    http::request<http::string_body> request;
+    if (value.is_null())
+    {
+        return "None";
+    }
 
-    construct_request(request, method, host, target, query, http_version, content_type, body, x_headers);
-    get_response_with_retry(request, port, response, max_retry, retry_interval_milliseconds);
+    return value.dump();
 }
 
-void create_dataframe_from_response(py::object& dataframe,
-                                    py::module_& mod_cudf,
-                                    http::response<http::dynamic_body>& response,
-                                    const std::string& strategy)
+void parse_params(nlohmann::json& params, std::string& query)
 {
-    std::string df_json_str = beast::buffers_to_string(response.body().data());
-
-    // When calling cudf.read_json() with engine='cudf', it expects an array object as input.
-    // The workaround here is to add square brackets if the original data is not represented as an array.
-    // Submitted an issue to cudf: https://github.com/rapidsai/cudf/issues/13527.
-    if (!df_json_str.empty() && !(df_json_str.front() == '[' && df_json_str.back() == ']'))
+    url_params_t url_params;
+    for (auto& param : params.items())
     {
-        df_json_str = "[" + df_json_str + "]";
+        set_url_param(url_params, param.key(), param_to_string(param.value()));
     }
 
-    {
-        py::gil_scoped_acquire gil;
-        auto current_df = mod_cudf.attr("DataFrame")();
-        current_df      = mod_cudf.attr("read_json")(py::str(df_json_str), py::str("cudf"));
-        if (dataframe.is_none())
-        {
-            dataframe = current_df;
-        }
-        else if (strategy == "aggregate")
-        {
-            py::list args;
-            args.attr("append")(dataframe);
-            args.attr("append")(current_df);
-            dataframe = mod_cudf.attr("concat")(args);
-        }
-    }  // release GIL
+    query = url_encode(url_params);
 }
 
-void create_dataframe_from_query(py::object& dataframe,
-                                 py::module_& mod_cudf,
-                                 nlohmann::json& query,
-                                 int max_retry,
-                                 int retry_interval_milliseconds,
-                                 std::string& strategy)
+void create_requests_from_query(std::vector<HttpClientRequest>& requests, nlohmann::json& query)
 {
     std::string method;
     std::string endpoint;
@@ -339,22 +262,16 @@ void create_dataframe_from_query(py::object& dataframe,
     std::string queries;
     parse_endpoint(endpoint, host, target, queries);
 
+    auto add_request = [&]() {
+        HttpClientRequest request{{}, host, port};
+        construct_request(
+            request.request, method, host, target, queries, http_version, content_type, body, x_headers);
+        requests.push_back(std::move(request));
+    };
+
     if (params.empty())
     {
-        http::response<http::dynamic_body> response;
-        get_response_from_endpoint(response,
-                                   method,
-                                   host,
-                                   target,
-                                   queries,
-                                   port,
-                                   http_version,
-                                   content_type,
-                                   body,
-                                   x_headers,
-                                   max_retry,
-                                   retry_interval_milliseconds);
-        create_dataframe_from_response(dataframe, mod_cudf, response, strategy);
+        add_request();
     }
     else
     {
@@ -362,22 +279,46 @@ void create_dataframe_from_query(py::object& dataframe,
         for (auto& param : params)
         {
             parse_params(param, queries);
-            http::response<http::dynamic_body> response;
-            get_response_from_endpoint(response,
-                                       method,
-                                       host,
-                                       target,
-                                       queries,
-                                       port,
-                                       http_version,
-                                       content_type,
-                                       body,
-                                       x_headers,
-                                       max_retry,
-                                       retry_interval_milliseconds);
-            create_dataframe_from_response(dataframe, mod_cudf, response, strategy);
+            add_request();
+        }
+    }
+}
+
+cudf::io::table_with_metadata create_table_from_response(std::string df_json_str)
+{
+    // The JSON reader expects an array of records when not reading JSON lines. The workaround here is to add square
+    // brackets if the original data is not represented as an array.
+    if (!(df_json_str.front() == '[' && df_json_str.back() == ']'))
+    {
+        df_json_str = "[" + df_json_str + "]";
+    }
+
+    auto options =
+        cudf::io::json_reader_options::builder(cudf::io::source_info{df_json_str.data(), df_json_str.size()})
+            .lines(false);
+
+    return cudf::io::read_json(options.build());
+}
+
+std::shared_ptr<MessageMeta> create_meta_from_responses(std::vector<http::response<http::string_body>> responses)
+{
+    std::vector<cudf::io::table_with_metadata> tables;
+    for (auto& response : responses)
+    {
+        if (response.body().empty())
+        {
+            continue;
         }
+
+        tables.emplace_back(create_table_from_response(std::move(response.body())));
+    }
+
+    if (tables.empty())
+    {
+        throw std::runtime_error("'REST Loader' received no data");
     }
+
+    return MessageMeta::create_from_cpp(CuDFTableUtil::concatenate_tables(std::move(tables)));
 }
 }  // namespace
 
@@ -388,66 +329,48 @@ std::shared_ptr<ControlMessage> RESTDataLoader::load(std::shared_ptr<ControlMess
 {
     VLOG(30) << "Called RESTDataLoader::load()";
 
-    py::module_ mod_cudf;
-    py::object dataframe;
+    auto conf = this->config();
 
+    int max_retry = conf.value("max_retry", 3);
+    if (max_retry < 0)
     {
-        py::gil_scoped_acquire gil;
-
-        dataframe          = py::none();
-        auto& cache_handle = mrc::pymrc::PythonObjectCache::get_handle();
-        mod_cudf           = cache_handle.get_module("cudf");
-    }  // release GIL
+        throw std::runtime_error("'REST Loader' receives invalid max_retry value: " + std::to_string(max_retry));
+    }
 
-    try
+    int retry_interval_milliseconds = conf.value("retry_interval_milliseconds", 1000);
+    if (retry_interval_milliseconds < 0)
     {
-        auto conf = this->config();
-
-        int max_retry = conf.value("max_retry", 3);
-        if (max_retry < 0)
-        {
-            throw std::runtime_error("'REST Loader' receives invalid max_retry value: " + std::to_string(max_retry));
-        }
-
-        int retry_interval_milliseconds = conf.value("retry_interval_milliseconds", 1000);
-        if (retry_interval_milliseconds < 0)
-        {
-            throw std::runtime_error("'REST Loader' receives invalid retry_interval_milliseconds value: " +
-                                     std::to_string(retry_interval_milliseconds));
-        }
+        throw std::runtime_error("'REST Loader' receives invalid retry_interval_milliseconds value: " +
+                                 std::to_string(retry_interval_milliseconds));
+    }
 
-        if (!task["queries"].is_array() or task.empty())
-        {
-            throw std::runtime_error("'REST Loader' control message specified no queries to load");
-        }
+    int max_concurrent_requests = conf.value("max_concurrent_requests", 8);
+    if (max_concurrent_requests <= 0)
+    {
+        throw std::runtime_error("'REST Loader' receives invalid max_concurrent_requests value: " +
+                                 std::to_string(max_concurrent_requests));
+    }
 
-        std::string strategy = task.value("strategy", "aggregate");
-        if (strategy != "aggregate")
-        {
-            throw std::runtime_error("Only 'aggregate' strategy is currently supported");
-        }
+    if (!task["queries"].is_array() or task.empty())
+    {
+        throw std::runtime_error("'REST Loader' control message specified no queries to load");
+    }
 
-        auto queries = task["queries"];
-        for (auto& query : queries)
-        {
-            create_dataframe_from_query(dataframe, mod_cudf, query, max_retry, retry_interval_milliseconds, strategy);
-        }
+    std::string strategy = task.value("strategy", "aggregate");
+    if (strategy != "aggregate")
+    {
+        throw std::runtime_error("Only 'aggregate' strategy is currently supported");
+    }
 
-        {
-            py::gil_scoped_acquire gil;
-            message->payload(MessageMeta::create_from_python(std::move(dataframe)));
-        }  // release GIL
-    } catch (...)
+    std::vector<HttpClientRequest> requests;
+    for (auto& query : task["queries"])
     {
-        py::gil_scoped_acquire gil;
-        auto _handle = dataframe.release();
-        _handle.dec_ref();
+        create_requests_from_query(requests, query);
+    }
 
-        _handle = mod_cudf.release();
-        _handle.dec_ref();
+    AsyncHttpClient client(max_concurrent_requests, max_retry, std::chrono::milliseconds(retry_interval_milliseconds));
 
-        throw;
-    }
+    message->payload(create_meta_from_responses(client.send_all(std::move(requests))));
 
     return message;
 }
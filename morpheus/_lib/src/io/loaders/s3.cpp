@@ -0,0 +1,504 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/io/loaders/s3.hpp"
+
+#include "morpheus/io/deserializers.hpp"  // for load_table_from_buffer
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/objects/file_types.hpp"         // for FileTypes, determine_file_type
+#include "morpheus/objects/pinned_host_buffer.hpp"  // for PinnedHostBuffer
+#include "morpheus/utilities/http_client.hpp"       // for AsyncHttpClient, HttpClientRequest
+#include "morpheus/utilities/string_util.hpp"
+#include "morpheus/utilities/table_util.hpp"  // for CuDFTableUtil
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/status.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <boost/beast/version.hpp>
+#include <cudf/io/types.hpp>  // for table_with_metadata
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>  // for min
+#include <array>
+#include <cctype>  // for isalnum
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>  // for getenv
+#include <ctime>    // for gmtime_r, strftime, time
+#include <iomanip>  // for setw, setfill
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace beast = boost::beast;
+namespace http  = beast::http;
+
+namespace {
+using namespace morpheus;
+
+constexpr std::size_t DefaultPartBytes = 8 * 1024 * 1024;
+
+struct S3Settings
+{
+    std::string host;
+    std::string port;
+    std::string region;
+    std::string access_key_id;
+    std::string secret_access_key;
+    std::string session_token;
+};
+
+struct S3Object
+{
+    std::string bucket;
+    std::string key;
+    FileTypes file_type;
+};
+
+// SHA-256 as specified by FIPS 180-4, only used to sign requests
+std::string sha256(const std::string& data)
+{
+    static constexpr std::array<std::uint32_t, 64> K = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    std::array<std::uint32_t, 8> hash = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    // Pads the message with a single bit, zeros and the length of the message in bits
+    std::string message             = data;
+    const std::uint64_t bit_length = static_cast<std::uint64_t>(data.size()) * 8;
+    message.push_back(static_cast<char>(0x80));
+    while (message.size() % 64 != 56)
+    {
+        message.push_back('\0');
+    }
+    for (int i = 7; i >= 0; --i)
+    {
+        message.push_back(static_cast<char>((bit_length >> (i * 8)) & 0xff));
+    }
+
+    auto rotr = [](std::uint32_t x, int n) {
+        return (x >> n) | (x << (32 - n));
+    };
+
+    for (std::size_t chunk = 0; chunk < message.size(); chunk += 64)
+    {
+        std::array<std::uint32_t, 64> w{};
+        for (int i = 0; i < 16; ++i)
+        {
+            const auto* bytes = reinterpret_cast<const unsigned char*>(message.data() + chunk + i * 4);
+            w[i]              = (static_cast<std::uint32_t>(bytes[0]) << 24) |
+                   (static_cast<std::uint32_t>(bytes[1]) << 16) | (static_cast<std::uint32_t>(bytes[2]) << 8) |
+                   static_cast<std::uint32_t>(bytes[3]);
+        }
+        for (int i = 16; i < 64; ++i)
+        {
+            auto s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            auto s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i]    = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        auto state = hash;
+        for (int i = 0; i < 64; ++i)
+        {
+            auto& [a, b, c, d, e, f, g, h] = state;
+
+            auto s1  = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            auto ch  = (e & f) ^ (~e & g);
+            auto t1  = h + s1 + ch + K[i] + w[i];
+            auto s0  = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            auto maj = (a & b) ^ (a & c) ^ (b & c);
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + s0 + maj;
+        }
+
+        for (std::size_t i = 0; i < hash.size(); ++i)
+        {
+            hash[i] += state[i];
+        }
+    }
+
+    std::string digest;
+    for (auto word : hash)
+    {
+        for (int shift = 24; shift >= 0; shift -= 8)
+        {
+            digest.push_back(static_cast<char>((word >> shift) & 0xff));
+        }
+    }
+
+    return digest;
+}
+
+std::string hmac_sha256(const std::string& key, const std::string& data)
+{
+    std::string block_key = key.size() > 64 ? sha256(key) : key;
+    block_key.resize(64, '\0');
+
+    std::string inner_pad(64, '\0');
+    std::string outer_pad(64, '\0');
+    for (std::size_t i = 0; i < 64; ++i)
+    {
+        inner_pad[i] = static_cast<char>(block_key[i] ^ 0x36);
+        outer_pad[i] = static_cast<char>(block_key[i] ^ 0x5c);
+    }
+
+    return sha256(outer_pad + sha256(inner_pad + data));
+}
+
+std::string to_hex(const std::string& bytes)
+{
+    std::ostringstream hex;
+    hex << std::hex << std::setfill('0');
+    for (unsigned char c : bytes)
+    {
+        hex << std::setw(2) << static_cast<int>(c);
+    }
+
+    return hex.str();
+}
+
+// Encodes an object key as required by S3, keeping the '/' separators
+std::string uri_encode(const std::string& value)
+{
+    std::ostringstream encoded;
+    encoded << std::hex << std::uppercase << std::setfill('0');
+    for (unsigned char c : value)
+    {
+        if (std::isalnum(c) != 0 || c == '-' || c == '_' || c == '.' || c == '~' || c == '/')
+        {
+            encoded << c;
+        }
+        else
+        {
+            encoded << '%' << std::setw(2) << static_cast<int>(c);
+        }
+    }
+
+    return encoded.str();
+}
+
+std::string get_setting(const nlohmann::json& config, const std::string& name, const char* env_var)
+{
+    if (config.contains(name))
+    {
+        return config[name].get<std::string>();
+    }
+
+    const char* value = std::getenv(env_var);
+    return value == nullptr ? "" : value;
+}
+
+S3Settings get_settings(const nlohmann::json& config)
+{
+    S3Settings settings;
+    settings.region            = get_setting(config, "region", "AWS_REGION");
+    settings.region            = settings.region.empty() ? "us-east-1" : settings.region;
+    settings.host              = config.value("endpoint", "s3." + settings.region + ".amazonaws.com");
+    settings.port              = config.value("port", "80");
+    settings.access_key_id     = get_setting(config, "access_key_id", "AWS_ACCESS_KEY_ID");
+    settings.secret_access_key = get_setting(config, "secret_access_key", "AWS_SECRET_ACCESS_KEY");
+    settings.session_token     = get_setting(config, "session_token", "AWS_SESSION_TOKEN");
+
+    return settings;
+}
+
+FileTypes parse_file_type(const std::string& file_type)
+{
+    if (file_type == "csv")
+    {
+        return FileTypes::CSV;
+    }
+    if (file_type == "json" || file_type == "jsonlines")
+    {
+        return FileTypes::JSON;
+    }
+    if (file_type == "parquet")
+    {
+        return FileTypes::PARQUET;
+    }
+
+    throw std::runtime_error("'S3 Loader' received file type not supported: " + file_type);
+}
+
+S3Object parse_object(const nlohmann::json& file)
+{
+    std::string uri = file.is_string() ? file.get<std::string>() : file.value("path", "");
+
+    const std::string scheme = "s3://";
+    if (uri.rfind(scheme, 0) != 0 || uri.find('/', scheme.size()) == std::string::npos)
+    {
+        throw std::runtime_error("'S3 Loader' expects files as s3://bucket/key URIs, received: " + uri);
+    }
+
+    const auto key_start = uri.find('/', scheme.size());
+
+    S3Object object;
+    object.bucket = uri.substr(scheme.size(), key_start - scheme.size());
+    object.key    = uri.substr(key_start + 1);
+
+    if (file.is_object() && file.contains("type"))
+    {
+        object.file_type = parse_file_type(file["type"].get<std::string>());
+    }
+    else
+    {
+        object.file_type = determine_file_type(object.key);  // throws if it is unable to determine the type
+    }
+
+    return object;
+}
+
+// Signs `request` with AWS Signature Version 4, the payload being left unsigned as allowed by S3
+void sign_request(const S3Settings& settings, http::request<http::string_body>& request, const std::string& host)
+{
+    std::time_t now = std::time(nullptr);
+    std::tm utc{};
+    gmtime_r(&now, &utc);
+
+    std::array<char, 17> amz_date{};
+    std::strftime(amz_date.data(), amz_date.size(), "%Y%m%dT%H%M%SZ", &utc);
+    const std::string timestamp(amz_date.data());
+    const std::string date = timestamp.substr(0, 8);
+
+    const std::string payload_hash = "UNSIGNED-PAYLOAD";
+    request.set("x-amz-content-sha256", payload_hash);
+    request.set("x-amz-date", timestamp);
+
+    std::string canonical_headers = "host:" + host + "\n" + "x-amz-content-sha256:" + payload_hash + "\n" +
+                                    "x-amz-date:" + timestamp + "\n";
+    std::string signed_headers = "host;x-amz-content-sha256;x-amz-date";
+
+    if (!settings.session_token.empty())
+    {
+        request.set("x-amz-security-token", settings.session_token);
+        canonical_headers += "x-amz-security-token:" + settings.session_token + "\n";
+        signed_headers += ";x-amz-security-token";
+    }
+
+    const std::string canonical_request = std::string(request.method_string()) + "\n" +
+                                          std::string(request.target()) + "\n" + "\n" + canonical_headers + "\n" +
+                                          signed_headers + "\n" + payload_hash;
+
+    const std::string scope          = date + "/" + settings.region + "/s3/aws4_request";
+    const std::string string_to_sign = "AWS4-HMAC-SHA256\n" + timestamp + "\n" + scope + "\n" +
+                                       to_hex(sha256(canonical_request));
+
+    auto signing_key = hmac_sha256("AWS4" + settings.secret_access_key, date);
+    signing_key      = hmac_sha256(signing_key, settings.region);
+    signing_key      = hmac_sha256(signing_key, "s3");
+    signing_key      = hmac_sha256(signing_key, "aws4_request");
+
+    request.set(http::field::authorization,
+                "AWS4-HMAC-SHA256 Credential=" + settings.access_key_id + "/" + scope +
+                    ", SignedHeaders=" + signed_headers +
+                    ", Signature=" + to_hex(hmac_sha256(signing_key, string_to_sign)));
+}
+
+HttpClientRequest make_ranged_get(const S3Settings& settings,
+                                  const S3Object& object,
+                                  std::size_t first_byte,
+                                  std::size_t last_byte)
+{
+    const std::string host = settings.port == "80" ? settings.host : settings.host + ":" + settings.port;
+
+    HttpClientRequest request{{}, settings.host, settings.port};
+    request.request.method(http::verb::get);
+    request.request.version(11);
+    request.request.target("/" + object.bucket + "/" + uri_encode(object.key));
+    request.request.set(http::field::host, host);
+    request.request.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+    request.request.set(http::field::range,
+                        "bytes=" + std::to_string(first_byte) + "-" + std::to_string(last_byte));
+
+    if (!settings.access_key_id.empty())
+    {
+        sign_request(settings, request.request, host);
+    }
+
+    return request;
+}
+
+void check_response(const http::response<http::string_body>& response, const S3Object& object)
+{
+    if (response.result() != http::status::ok && response.result() != http::status::partial_content)
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("'S3 Loader' failed to get s3://"
+                                                     << object.bucket << "/" << object.key << ", status "
+                                                     << response.result_int() << ": " << response.body()));
+    }
+}
+
+/**
+ * @brief Returns the size of the object from the response to the ranged GET of its first part
+ */
+std::size_t get_object_size(const http::response<http::string_body>& response, const S3Object& object)
+{
+    // The range of an empty object can not be satisfied
+    if (response.result() == http::status::range_not_satisfiable)
+    {
+        return 0;
+    }
+
+    check_response(response, object);
+
+    // The whole object is returned when the server does not support ranges
+    if (response.result() == http::status::ok)
+    {
+        return response.body().size();
+    }
+
+    const std::string content_range(response[http::field::content_range]);
+    const auto total_at = content_range.rfind('/');
+    if (total_at == std::string::npos || content_range.compare(total_at + 1, std::string::npos, "*") == 0)
+    {
+        throw std::runtime_error("'S3 Loader' received an invalid Content-Range: " + content_range);
+    }
+
+    return std::stoull(content_range.substr(total_at + 1));
+}
+}  // namespace
+
+namespace morpheus {
+S3DataLoader::S3DataLoader(nlohmann::json config) : Loader(config) {}
+
+std::shared_ptr<ControlMessage> S3DataLoader::load(std::shared_ptr<ControlMessage> message, nlohmann::json task)
+{
+    VLOG(30) << "Called S3DataLoader::load()";
+
+    if (!task.is_object() || !task["files"].is_array() || task["files"].empty())
+    {
+        throw std::runtime_error("'S3 Loader' control message specified no files to load");
+    }
+
+    std::string strategy = task.value("strategy", "aggregate");
+    if (strategy != "aggregate")
+    {
+        throw std::runtime_error("Only 'aggregate' strategy is currently supported");
+    }
+
+    auto conf = this->config().is_object() ? this->config() : nlohmann::json::object();
+
+    const auto settings                = get_settings(conf);
+    const std::size_t part_bytes       = conf.value("part_bytes", DefaultPartBytes);
+    const std::size_t max_requests     = conf.value("max_concurrent_requests", std::size_t{32});
+    const int max_retry                = conf.value("max_retry", 3);
+    const auto retry_interval          = std::chrono::milliseconds(conf.value("retry_interval_milliseconds", 1000));
+    const std::optional<bool> json_lines = task.contains("lines") ? std::optional<bool>(task["lines"].get<bool>())
+                                                                  : std::nullopt;
+
+    if (part_bytes == 0 || max_requests == 0)
+    {
+        throw std::runtime_error("'S3 Loader' part_bytes and max_concurrent_requests must be greater than 0");
+    }
+
+    std::vector<S3Object> objects;
+    for (const auto& file : task["files"])
+    {
+        objects.push_back(parse_object(file));
+    }
+
+    AsyncHttpClient client(max_requests, max_retry, retry_interval);
+
+    // Reused by each group of objects, pinned allocations being expensive
+    std::vector<PinnedHostBuffer> buffers(std::min(max_requests, objects.size()));
+    std::vector<cudf::io::table_with_metadata> tables;
+
+    for (std::size_t group_start = 0; group_start < objects.size(); group_start += buffers.size())
+    {
+        const auto group_size = std::min(buffers.size(), objects.size() - group_start);
+
+        // The first part of each object also gives the size of the object
+        std::vector<HttpClientRequest> requests;
+        for (std::size_t i = 0; i < group_size; ++i)
+        {
+            requests.push_back(make_ranged_get(settings, objects[group_start + i], 0, part_bytes - 1));
+        }
+
+        auto first_parts = client.send_all(std::move(requests));
+
+        requests.clear();
+        std::vector<std::size_t> part_owners;
+        for (std::size_t i = 0; i < group_size; ++i)
+        {
+            const auto& object = objects[group_start + i];
+            const auto size    = get_object_size(first_parts[i], object);
+
+            buffers[i].clear();
+            buffers[i].reserve(size);
+            if (size > 0)
+            {
+                buffers[i].append(first_parts[i].body().data(), first_parts[i].body().size());
+            }
+
+            for (std::size_t offset = buffers[i].size(); offset < size; offset += part_bytes)
+            {
+                requests.push_back(make_ranged_get(settings, object, offset, std::min(offset + part_bytes, size) - 1));
+                part_owners.push_back(i);
+            }
+        }
+
+        // Responses are in the order of the requests, which are in the order of the parts of each object
+        auto parts = client.send_all(std::move(requests));
+        for (std::size_t i = 0; i < parts.size(); ++i)
+        {
+            check_response(parts[i], objects[group_start + part_owners[i]]);
+            buffers[part_owners[i]].append(parts[i].body().data(), parts[i].body().size());
+        }
+
+        for (std::size_t i = 0; i < group_size; ++i)
+        {
+            if (!buffers[i].empty())
+            {
+                tables.emplace_back(load_table_from_buffer(
+                    buffers[i].data(), buffers[i].size(), objects[group_start + i].file_type, json_lines));
+            }
+        }
+    }
+
+    if (tables.empty())
+    {
+        throw std::runtime_error("'S3 Loader' received no data");
+    }
+
+    message->payload(MessageMeta::create_from_cpp(CuDFTableUtil::concatenate_tables(std::move(tables))));
+
+    return message;
+}
+}  // namespace morpheus
@@ -0,0 +1,268 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/io/payload_decoder.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/factory_registry.hpp"
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/table_util.hpp"   // for CuDFTableUtil
+
+#include <arrow/buffer.h>        // for Buffer
+#include <arrow/io/memory.h>     // for BufferReader
+#include <arrow/ipc/reader.h>    // for RecordBatchStreamReader
+#include <arrow/record_batch.h>  // for RecordBatch
+#include <arrow/table.h>         // for Table
+#include <cudf/interop.hpp>      // for from_arrow
+#include <cudf/io/avro.hpp>
+#include <cudf/io/json.hpp>
+#include <cudf/io/parquet.hpp>
+#include <cudf/table/table.hpp>
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t
+#include <memory>
+#include <mutex>  // for call_once
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>  // for move
+#include <vector>
+
+namespace morpheus {
+template class FactoryRegistry<PayloadDecoder>;
+
+namespace {
+// Producers which send C-strings include the terminator in the payload
+std::string_view strip_terminators(std::string_view payload)
+{
+    while (!payload.empty() && payload.back() == '\0')
+    {
+        payload.remove_suffix(1);
+    }
+
+    return payload;
+}
+
+/**
+ * @brief JSON lines, or with `lines` unset a JSON array of records per payload
+ */
+class JsonPayloadDecoder : public PayloadDecoder
+{
+  public:
+    explicit JsonPayloadDecoder(bool lines) : m_lines(lines) {}
+
+    cudf::io::table_with_metadata decode(const std::vector<std::string_view>& payloads,
+                                         rmm::cuda_stream_view stream) const override
+    {
+        if (!m_lines)
+        {
+            // Arrays can not be concatenated textually, each one is read on its own
+            std::vector<cudf::io::table_with_metadata> tables;
+            tables.reserve(payloads.size());
+            for (const auto& payload : payloads)
+            {
+                tables.emplace_back(read(strip_terminators(payload), stream));
+            }
+
+            return concatenate(std::move(tables));
+        }
+
+        std::size_t total_bytes = 0;
+        for (const auto& payload : payloads)
+        {
+            total_bytes += payload.size() + 1;
+        }
+
+        std::string buffer;
+        buffer.reserve(total_bytes);
+        for (const auto& payload : payloads)
+        {
+            buffer.append(strip_terminators(payload));
+            buffer.push_back('\n');
+        }
+
+        return read(buffer, stream);
+    }
+
+  private:
+    cudf::io::table_with_metadata read(std::string_view data, rmm::cuda_stream_view stream) const
+    {
+        auto options = cudf::io::json_reader_options::builder(cudf::io::source_info(data.data(), data.size()))
+                           .lines(m_lines);
+        return cudf::io::read_json(options.build(), stream);
+    }
+
+    static cudf::io::table_with_metadata concatenate(std::vector<cudf::io::table_with_metadata>&& tables)
+    {
+        if (tables.size() == 1)
+        {
+            return std::move(tables.front());
+        }
+
+        return CuDFTableUtil::concatenate_tables(std::move(tables));
+    }
+
+    bool m_lines;
+};
+
+/**
+ * @brief Arrow IPC streams, the columnar batches being copied to the device as they are without any parsing
+ */
+class ArrowPayloadDecoder : public PayloadDecoder
+{
+  public:
+    cudf::io::table_with_metadata decode(const std::vector<std::string_view>& payloads,
+                                         rmm::cuda_stream_view stream) const override
+    {
+        std::shared_ptr<arrow::Schema> schema;
+        arrow::RecordBatchVector batches;
+
+        for (const auto& payload : payloads)
+        {
+            auto buffer = std::make_shared<arrow::Buffer>(reinterpret_cast<const std::uint8_t*>(payload.data()),
+                                                          static_cast<int64_t>(payload.size()));
+            auto reader = arrow::ipc::RecordBatchStreamReader::Open(std::make_shared<arrow::io::BufferReader>(buffer))
+                              .ValueOrDie();
+
+            if (schema == nullptr)
+            {
+                schema = reader->schema();
+            }
+
+            for (auto& batch : reader->ToRecordBatches().ValueOrDie())
+            {
+                batches.emplace_back(std::move(batch));
+            }
+        }
+
+        if (schema == nullptr)
+        {
+            throw std::runtime_error("Unable to decode an empty list of Arrow IPC payloads");
+        }
+
+        // Fails when the schema of a batch differs from the one of the first payload
+        auto table = arrow::Table::FromRecordBatches(schema, batches).ValueOrDie();
+
+        cudf::io::table_metadata metadata;
+        for (const auto& field : schema->fields())
+        {
+            metadata.schema_info.emplace_back(field->name());
+        }
+
+        return {cudf::from_arrow(*table, stream), std::move(metadata)};
+    }
+};
+
+/**
+ * @brief Parquet files, read as the sources of a single read
+ */
+class ParquetPayloadDecoder : public PayloadDecoder
+{
+  public:
+    cudf::io::table_with_metadata decode(const std::vector<std::string_view>& payloads,
+                                         rmm::cuda_stream_view stream) const override
+    {
+        std::vector<cudf::io::host_buffer> buffers;
+        buffers.reserve(payloads.size());
+        for (const auto& payload : payloads)
+        {
+            buffers.emplace_back(payload.data(), payload.size());
+        }
+
+        auto options = cudf::io::parquet_reader_options::builder(cudf::io::source_info(buffers));
+        return cudf::io::read_parquet(options.build(), stream);
+    }
+};
+
+/**
+ * @brief Avro object container files, each embedding its own schema
+ */
+class AvroPayloadDecoder : public PayloadDecoder
+{
+  public:
+    cudf::io::table_with_metadata decode(const std::vector<std::string_view>& payloads,
+                                         rmm::cuda_stream_view stream) const override
+    {
+        std::vector<cudf::io::table_with_metadata> tables;
+        tables.reserve(payloads.size());
+        for (const auto& payload : payloads)
+        {
+            auto options = cudf::io::avro_reader_options::builder(
+                cudf::io::source_info(payload.data(), payload.size()));
+            tables.emplace_back(cudf::io::read_avro(options.build()));
+        }
+
+        if (tables.empty())
+        {
+            throw std::runtime_error("Unable to decode an empty list of Avro payloads");
+        }
+
+        if (tables.size() == 1)
+        {
+            return std::move(tables.front());
+        }
+
+        return CuDFTableUtil::concatenate_tables(std::move(tables));
+    }
+};
+
+void register_builtin_decoders()
+{
+    PayloadDecoderRegistry::register_factory_fn(
+        "json",
+        [](nlohmann::json config) {
+            return std::make_shared<JsonPayloadDecoder>(!config.is_object() || config.value("lines", true));
+        },
+        false);
+    PayloadDecoderRegistry::register_factory_fn(
+        "arrow",
+        [](nlohmann::json /*config*/) {
+            return std::make_shared<ArrowPayloadDecoder>();
+        },
+        false);
+    PayloadDecoderRegistry::register_factory_fn(
+        "parquet",
+        [](nlohmann::json /*config*/) {
+            return std::make_shared<ParquetPayloadDecoder>();
+        },
+        false);
+    PayloadDecoderRegistry::register_factory_fn(
+        "avro",
+        [](nlohmann::json /*config*/) {
+            return std::make_shared<AvroPayloadDecoder>();
+        },
+        false);
+}
+}  // namespace
+
+std::shared_ptr<PayloadDecoder> PayloadDecoder::create(const std::string& name, nlohmann::json config)
+{
+    static std::once_flag builtins_registered;
+    std::call_once(builtins_registered, register_builtin_decoders);
+
+    if (!PayloadDecoderRegistry::contains(name))
+    {
+        auto formats = PayloadDecoderRegistry::list();
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Unknown payload format '"
+                                                     << name << "', registered formats: "
+                                                     << StringUtil::array_to_str(formats.begin(), formats.end())));
+    }
+
+    return PayloadDecoderRegistry::create_object_from_factory(name, std::move(config));
+}
+
+}  // namespace morpheus
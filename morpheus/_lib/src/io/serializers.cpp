@@ -19,7 +19,10 @@
 
 #include "morpheus/objects/table_info_data.hpp"
 #include "morpheus/utilities/cudf_util.hpp"
+#include "morpheus/utilities/table_util.hpp"  // for CuDFTableUtil
 
+#include <cuda_runtime.h>  // for cudaMemcpyAsync
+#include <cudf/column/column.hpp>
 #include <cudf/io/csv.hpp>
 #include <cudf/io/data_sink.hpp>
 #include <cudf/io/json.hpp>
@@ -28,14 +31,22 @@
 #include <cudf/table/table_view.hpp>
 #include <cudf/types.hpp>
 #include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 #include <pybind11/stl.h>  // IWYU pragma: keep
+#include <rmm/cuda_stream_view.hpp>
 
-#include <cstddef>  // for size_t
+#include <cstddef>    // for size_t
+#include <exception>  // for exception
 #include <fstream>
+#include <future>  // for future, promise
+#include <memory>  // for make_unique
 #include <numeric>
-#include <sstream>  // IWYU pragma: keep
+#include <sstream>    // IWYU pragma: keep
+#include <stdexcept>  // for invalid_argument
+#include <string>
+#include <utility>  // for move
 #include <vector>
 // IWYU pragma: no_include <unordered_map>
 
@@ -86,8 +97,61 @@ class OStreamSink : public cudf::io::data_sink
     size_t m_bytest_written{0};
 };
 
+/**
+ * @brief Appends everything written to it to a string. Device buffers are copied straight into the string, skipping
+ * both the host buffer cudf would otherwise copy them to and the copy out of an `std::ostringstream`.
+ */
+class StringSink : public cudf::io::data_sink
+{
+  public:
+    StringSink(std::string& buffer) : m_buffer(buffer) {}
+
+    void host_write(void const* data, size_t size) override
+    {
+        m_buffer.append(static_cast<char const*>(data), size);
+    }
+
+    bool supports_device_write() const override
+    {
+        return true;
+    }
+
+    void device_write(void const* gpu_data, size_t size, rmm::cuda_stream_view stream) override
+    {
+        auto offset = m_buffer.size();
+        m_buffer.resize(offset + size);
+
+        MRC_CHECK_CUDA(cudaMemcpyAsync(m_buffer.data() + offset, gpu_data, size, cudaMemcpyDeviceToHost, stream));
+        stream.synchronize();
+    }
+
+    std::future<void> device_write_async(void const* gpu_data, size_t size, rmm::cuda_stream_view stream) override
+    {
+        device_write(gpu_data, size, stream);
+
+        std::promise<void> written;
+        written.set_value();
+        return written.get_future();
+    }
+
+    void flush() override {}
+
+    size_t bytes_written() override
+    {
+        return m_buffer.size();
+    }
+
+  private:
+    std::string& m_buffer;
+};
+
+std::unique_ptr<cudf::io::data_sink> create_file_sink(const std::string& filename)
+{
+    return cudf::io::data_sink::create(filename);
+}
+
 void table_to_csv(
-    const TableInfoData& tbl, std::ostream& out_stream, bool include_header, bool include_index_col, bool flush)
+    const TableInfoData& tbl, cudf::io::data_sink& sink, bool include_header, bool include_index_col, bool flush)
 {
     auto column_names         = tbl.column_names;
     cudf::size_type start_col = 1;
@@ -99,9 +163,11 @@ void table_to_csv(
 
     std::vector<cudf::size_type> col_idexes(column_names.size());
     std::iota(col_idexes.begin(), col_idexes.end(), start_col);
-    auto tbl_view = tbl.table_view.select(col_idexes);
 
-    OStreamSink sink(out_stream);
+    // Dictionary encoded columns are written as their values
+    std::vector<std::unique_ptr<cudf::column>> decoded;
+    auto tbl_view = CuDFTableUtil::decode_dictionaries(tbl.table_view.select(col_idexes), decoded);
+
     auto destination     = cudf::io::sink_info(&sink);
     auto options_builder = cudf::io::csv_writer_options_builder(destination, tbl_view)
                                .include_header(include_header)
@@ -121,6 +187,13 @@ void table_to_csv(
     }
 }
 
+void table_to_csv(
+    const TableInfoData& tbl, std::ostream& out_stream, bool include_header, bool include_index_col, bool flush)
+{
+    OStreamSink sink(out_stream);
+    table_to_csv(tbl, sink, include_header, include_index_col, flush);
+}
+
 void df_to_csv(const TableInfo& tbl, std::ostream& out_stream, bool include_header, bool include_index_col, bool flush)
 {
     table_to_csv(TableInfoData{tbl.get_view(), tbl.get_index_names(), tbl.get_column_names()},
@@ -132,15 +205,24 @@ void df_to_csv(const TableInfo& tbl, std::ostream& out_stream, bool include_head
 
 std::string df_to_csv(const TableInfo& tbl, bool include_header, bool include_index_col)
 {
-    // Create an ostringstream and use that with the overload accepting an ostream
-    std::ostringstream out_stream;
+    std::string buffer;
+    StringSink sink(buffer);
 
-    df_to_csv(tbl, out_stream, include_header, include_index_col);
+    df_to_csv(tbl, sink, include_header, include_index_col);
 
-    return out_stream.str();
+    return buffer;
 }
 
-void table_to_json(const TableInfoData& tbl, std::ostream& out_stream, bool include_index_col, bool flush)
+void df_to_csv(const TableInfo& tbl, cudf::io::data_sink& sink, bool include_header, bool include_index_col, bool flush)
+{
+    table_to_csv(TableInfoData{tbl.get_view(), tbl.get_index_names(), tbl.get_column_names()},
+                 sink,
+                 include_header,
+                 include_index_col,
+                 flush);
+}
+
+void table_to_json(const TableInfoData& tbl, cudf::io::data_sink& sink, bool include_index_col, bool flush)
 {
     if (!include_index_col)
     {
@@ -150,12 +232,14 @@ void table_to_json(const TableInfoData& tbl, std::ostream& out_stream, bool incl
     auto column_names = tbl.column_names;
     std::vector<cudf::size_type> col_idexes(column_names.size());
     std::iota(col_idexes.begin(), col_idexes.end(), 1);
-    auto tbl_view = tbl.table_view.select(col_idexes);
+
+    // Dictionary encoded columns are written as their values
+    std::vector<std::unique_ptr<cudf::column>> decoded;
+    auto tbl_view = CuDFTableUtil::decode_dictionaries(tbl.table_view.select(col_idexes), decoded);
 
     cudf::io::table_metadata tbl_meta{
         std::vector<cudf::io::column_name_info>{column_names.cbegin(), column_names.cend()}};
 
-    OStreamSink sink(out_stream);
     auto destination     = cudf::io::sink_info(&sink);
     auto options_builder = cudf::io::json_writer_options_builder(destination, tbl_view)
                                .metadata(tbl_meta)
@@ -171,6 +255,12 @@ void table_to_json(const TableInfoData& tbl, std::ostream& out_stream, bool incl
     }
 }
 
+void table_to_json(const TableInfoData& tbl, std::ostream& out_stream, bool include_index_col, bool flush)
+{
+    OStreamSink sink(out_stream);
+    table_to_json(tbl, sink, include_index_col, flush);
+}
+
 void df_to_json(const TableInfo& tbl, std::ostream& out_stream, bool include_index_col, bool flush)
 {
     table_to_json(TableInfoData{tbl.get_view(), tbl.get_index_names(), tbl.get_column_names()},
@@ -181,16 +271,24 @@ void df_to_json(const TableInfo& tbl, std::ostream& out_stream, bool include_ind
 
 std::string df_to_json(const TableInfo& tbl, bool include_index_col)
 {
-    // Create an ostringstream and use that with the overload accepting an ostream
-    std::ostringstream out_stream;
+    std::string buffer;
+    StringSink sink(buffer);
 
-    df_to_json(tbl, out_stream, include_index_col);
+    df_to_json(tbl, sink, include_index_col);
 
-    return out_stream.str();
+    return buffer;
+}
+
+void df_to_json(const TableInfo& tbl, cudf::io::data_sink& sink, bool include_index_col, bool flush)
+{
+    table_to_json(TableInfoData{tbl.get_view(), tbl.get_index_names(), tbl.get_column_names()},
+                  sink,
+                  include_index_col,
+                  flush);
 }
 
 void table_to_parquet(
-    const TableInfoData& tbl, std::ostream& out_stream, bool include_header, bool include_index_col, bool flush)
+    const TableInfoData& tbl, cudf::io::data_sink& sink, bool include_header, bool include_index_col, bool flush)
 {
     auto column_names         = tbl.column_names;
     cudf::size_type start_col = 1;
@@ -202,9 +300,11 @@ void table_to_parquet(
 
     std::vector<cudf::size_type> col_idexes(column_names.size());
     std::iota(col_idexes.begin(), col_idexes.end(), start_col);
-    auto tbl_view = tbl.table_view.select(col_idexes);
 
-    OStreamSink sink(out_stream);
+    // Dictionary encoded columns are written as their values
+    std::vector<std::unique_ptr<cudf::column>> decoded;
+    auto tbl_view = CuDFTableUtil::decode_dictionaries(tbl.table_view.select(col_idexes), decoded);
+
     auto destination     = cudf::io::sink_info(&sink);
     auto options_builder = cudf::io::parquet_writer_options_builder(destination, tbl_view);
 
@@ -216,6 +316,13 @@ void table_to_parquet(
     }
 }
 
+void table_to_parquet(
+    const TableInfoData& tbl, std::ostream& out_stream, bool include_header, bool include_index_col, bool flush)
+{
+    OStreamSink sink(out_stream);
+    table_to_parquet(tbl, sink, include_header, include_index_col, flush);
+}
+
 void df_to_parquet(
     const TableInfo& tbl, std::ostream& out_stream, bool include_header, bool include_index_col, bool flush)
 {
@@ -228,12 +335,119 @@ void df_to_parquet(
 
 std::string df_to_parquet(const TableInfo& tbl, bool include_header, bool include_index_col)
 {
-    // Create an ostringstream and use that with the overload accepting an ostream
-    std::ostringstream out_stream;
+    std::string buffer;
+    StringSink sink(buffer);
+
+    table_to_parquet(TableInfoData{tbl.get_view(), tbl.get_index_names(), tbl.get_column_names()},
+                     sink,
+                     include_header,
+                     include_index_col,
+                     false);
+
+    return buffer;
+}
+
+ChunkedParquetWriter::ChunkedParquetWriter(std::ostream& out_stream,
+                                           bool include_index_col,
+                                           const std::string& compression,
+                                           std::size_t row_group_size_rows) :
+  ChunkedParquetWriter(std::make_unique<OStreamSink>(out_stream), include_index_col, compression, row_group_size_rows)
+{}
+
+ChunkedParquetWriter::ChunkedParquetWriter(std::unique_ptr<cudf::io::data_sink> sink,
+                                           bool include_index_col,
+                                           const std::string& compression,
+                                           std::size_t row_group_size_rows) :
+  m_include_index_col(include_index_col),
+  m_row_group_size_rows(row_group_size_rows),
+  m_sink(std::move(sink))
+{
+    if (compression == "none")
+    {
+        m_compression = cudf::io::compression_type::NONE;
+    }
+    else if (compression == "snappy")
+    {
+        m_compression = cudf::io::compression_type::SNAPPY;
+    }
+    else if (compression == "zstd")
+    {
+        m_compression = cudf::io::compression_type::ZSTD;
+    }
+    else
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+            "Unsupported Parquet compression: '" << compression << "'. Must be one of 'none', 'snappy' or 'zstd'"));
+    }
+}
+
+ChunkedParquetWriter::~ChunkedParquetWriter()
+{
+    try
+    {
+        close();
+    } catch (const std::exception& e)
+    {
+        LOG(ERROR) << "Error closing Parquet writer: " << e.what();
+    }
+}
 
-    df_to_parquet(tbl, out_stream, include_header, include_index_col);
+void ChunkedParquetWriter::write(const TableInfo& tbl)
+{
+    auto column_names         = tbl.get_column_names();
+    cudf::size_type start_col = 1;
+    if (m_include_index_col)
+    {
+        start_col = 0;
 
-    return out_stream.str();
+        auto index_names = tbl.get_index_names();
+        column_names.insert(column_names.begin(), index_names.empty() ? ""s : index_names[0]);
+    }
+
+    std::vector<cudf::size_type> col_idexes(column_names.size());
+    std::iota(col_idexes.begin(), col_idexes.end(), start_col);
+
+    // Dictionary encoded columns are written as their values, Parquet encoding them again by itself
+    std::vector<std::unique_ptr<cudf::column>> decoded;
+    auto tbl_view = CuDFTableUtil::decode_dictionaries(tbl.get_view().select(col_idexes), decoded);
+
+    if (!m_writer)
+    {
+        // The schema of the file is fixed by the first table
+        cudf::io::table_input_metadata metadata(tbl_view);
+        for (std::size_t i = 0; i < column_names.size(); ++i)
+        {
+            metadata.column_metadata[i].set_name(column_names[i]);
+        }
+
+        auto options_builder = cudf::io::chunked_parquet_writer_options::builder(cudf::io::sink_info(m_sink.get()))
+                                   .compression(m_compression)
+                                   .metadata(std::move(metadata));
+
+        if (m_row_group_size_rows > 0)
+        {
+            options_builder.row_group_size_rows(static_cast<cudf::size_type>(m_row_group_size_rows));
+        }
+
+        m_writer = std::make_unique<cudf::io::parquet_chunked_writer>(options_builder.build());
+    }
+
+    m_writer->write(tbl_view);
+}
+
+void ChunkedParquetWriter::close()
+{
+    if (m_writer)
+    {
+        m_writer->close();
+        m_writer.reset();
+        m_sink->flush();
+    }
+}
+
+std::size_t ChunkedParquetWriter::bytes_written() const
+{
+    return m_sink->bytes_written();
 }
 
 template <typename T>
@@ -257,8 +471,18 @@ void SerializersProxy::write_df_to_file(pybind11::object df,
         file_type = determine_file_type(filename);  // throws if it is unable to determine the type
     }
 
+    // Writing through a file sink lets cudf write device buffers to the file without copying them to host memory
     std::ofstream out_file;
-    out_file.open(filename);
+    std::unique_ptr<cudf::io::data_sink> sink;
+    if (get_with_default(kwargs, "device_write", false))
+    {
+        sink = create_file_sink(filename);
+    }
+    else
+    {
+        out_file.open(filename);
+        sink = std::make_unique<OStreamSink>(out_file);
+    }
 
     auto tbl = CudfHelper::CudfHelper::table_info_data_from_table(df);
 
@@ -266,14 +490,14 @@ void SerializersProxy::write_df_to_file(pybind11::object df,
     {
     case FileTypes::JSON: {
         table_to_json(tbl,
-                      out_file,
+                      *sink,
                       get_with_default(kwargs, "include_index_col", true),
                       get_with_default(kwargs, "flush", false));
         break;
     }
     case FileTypes::CSV: {
         table_to_csv(tbl,
-                     out_file,
+                     *sink,
                      get_with_default(kwargs, "include_header", true),
                      get_with_default(kwargs, "include_index_col", true),
                      get_with_default(kwargs, "flush", false));
@@ -0,0 +1,195 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/io/source_capture.hpp"  // IWYU pragma: associated
+
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <arrow/buffer.h>                   // for Buffer
+#include <arrow/io/file.h>                  // for ReadableFile
+#include <arrow/io/memory.h>                // for BufferOutputStream
+#include <arrow/ipc/reader.h>               // for RecordBatchStreamReader
+#include <arrow/ipc/writer.h>               // for MakeStreamWriter
+#include <arrow/record_batch.h>             // for RecordBatch
+#include <arrow/table.h>                    // for Table
+#include <arrow/util/key_value_metadata.h>  // for key_value_metadata
+#include <cudf/interop.hpp>                 // for from_arrow, to_arrow
+#include <glog/logging.h>
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t
+#include <ostream>  // needed for glog
+#include <stdexcept>
+#include <string>
+#include <utility>  // for move
+#include <vector>
+
+namespace morpheus {
+namespace {
+
+// Buffers waiting to be written, beyond which `write` blocks
+constexpr std::size_t MaxQueueDepth = 64;
+
+template <typename T>
+T value_or_throw(arrow::Result<T>&& result, const char* what)
+{
+    if (!result.ok())
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Unable to " << what << ": " << result.status().ToString()));
+    }
+
+    return std::move(result).ValueUnsafe();
+}
+
+void check_status(const arrow::Status& status, const char* what)
+{
+    if (!status.ok())
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Unable to " << what << ": " << status.ToString()));
+    }
+}
+
+cudf::column_metadata to_column_metadata(const cudf::io::column_name_info& info)
+{
+    cudf::column_metadata metadata(info.name);
+    for (const auto& child : info.children)
+    {
+        metadata.children_meta.emplace_back(to_column_metadata(child));
+    }
+
+    return metadata;
+}
+
+}  // namespace
+
+// ************ SourceCaptureWriter ************************* //
+SourceCaptureWriter::SourceCaptureWriter(std::filesystem::path path) : m_writer(MaxQueueDepth)
+{
+    m_writer.open(std::move(path));
+}
+
+SourceCaptureWriter::~SourceCaptureWriter() = default;
+
+void SourceCaptureWriter::write(const cudf::table_view& table,
+                                const cudf::io::table_metadata& metadata,
+                                std::chrono::system_clock::time_point arrival_time,
+                                rmm::cuda_stream_view stream)
+{
+    std::vector<cudf::column_metadata> column_metadata;
+    column_metadata.reserve(metadata.schema_info.size());
+    for (const auto& info : metadata.schema_info)
+    {
+        column_metadata.emplace_back(to_column_metadata(info));
+    }
+
+    auto arrow_table = cudf::to_arrow(table, column_metadata, stream);
+    auto batch       = value_or_throw(arrow_table->CombineChunksToBatch(), "combine the columns of the batch");
+
+    const auto arrival_time_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(arrival_time.time_since_epoch()).count();
+    batch =
+        batch->ReplaceSchemaMetadata(arrow::key_value_metadata({ArrivalTimeKey}, {std::to_string(arrival_time_ns)}));
+
+    // Each batch is a stream of its own, holding its schema
+    auto sink   = value_or_throw(arrow::io::BufferOutputStream::Create(), "allocate the batch buffer");
+    auto writer = value_or_throw(arrow::ipc::MakeStreamWriter(sink, batch->schema()), "create the batch writer");
+    check_status(writer->WriteRecordBatch(*batch), "write the batch");
+    check_status(writer->Close(), "close the batch writer");
+
+    auto buffer = value_or_throw(sink->Finish(), "finish the batch buffer");
+
+    std::lock_guard lock(m_mutex);
+    m_writer.write(buffer->ToString());
+}
+
+void SourceCaptureWriter::close()
+{
+    std::lock_guard lock(m_mutex);
+    m_writer.close();
+}
+
+// ************ SourceCaptureReader ************************* //
+SourceCaptureReader::SourceCaptureReader(const std::filesystem::path& path) :
+  m_path(path),
+  m_file(value_or_throw(arrow::io::ReadableFile::Open(path.string()), "open the capture log"))
+{}
+
+SourceCaptureReader::~SourceCaptureReader()
+{
+    if (m_file != nullptr)
+    {
+        auto status = m_file->Close();
+        LOG_IF(WARNING, !status.ok()) << "Unable to close the capture log " << m_path << ": " << status.ToString();
+    }
+}
+
+std::optional<CapturedBatch> SourceCaptureReader::next(rmm::cuda_stream_view stream)
+{
+    const auto position = value_or_throw(m_file->Tell(), "read the capture log");
+    const auto size     = value_or_throw(m_file->GetSize(), "read the capture log");
+    if (position >= size)
+    {
+        return std::nullopt;
+    }
+
+    std::shared_ptr<arrow::Schema> schema;
+    arrow::RecordBatchVector batches;
+    try
+    {
+        auto reader = value_or_throw(arrow::ipc::RecordBatchStreamReader::Open(m_file), "read the batch schema");
+        schema      = reader->schema();
+        batches     = value_or_throw(reader->ToRecordBatches(), "read the batch");
+    } catch (const std::runtime_error& ex)
+    {
+        LOG(WARNING) << "Ignoring the truncated end of the capture log " << m_path << ", at byte " << position << ": "
+                     << ex.what();
+        check_status(m_file->Seek(size), "read the capture log");
+
+        return std::nullopt;
+    }
+
+    CapturedBatch captured;
+
+    const auto& schema_metadata = schema->metadata();
+    if (schema_metadata != nullptr)
+    {
+        auto arrival_time_ns = schema_metadata->Get(SourceCaptureWriter::ArrivalTimeKey);
+        if (arrival_time_ns.ok())
+        {
+            const std::chrono::nanoseconds since_epoch(std::stoll(*arrival_time_ns));
+            captured.arrival_time = std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(since_epoch));
+        }
+    }
+
+    auto table = value_or_throw(arrow::Table::FromRecordBatches(schema, batches), "assemble the batch");
+    for (const auto& field : schema->fields())
+    {
+        captured.table.metadata.schema_info.emplace_back(field->name());
+    }
+
+    captured.table.tbl = cudf::from_arrow(*table, stream);
+
+    return captured;
+}
+
+void SourceCaptureReader::rewind()
+{
+    check_status(m_file->Seek(0), "rewind the capture log");
+}
+
+}  // namespace morpheus
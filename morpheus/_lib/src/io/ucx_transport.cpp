@@ -0,0 +1,362 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/io/ucx_transport.hpp"
+
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <glog/logging.h>
+#include <netdb.h>       // for addrinfo, getaddrinfo, freeaddrinfo
+#include <sys/socket.h>  // for sockaddr_storage
+#include <ucp/api/ucp.h>
+
+#include <cstring>    // for memcpy
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for runtime_error
+#include <thread>     // for sleep_for
+#include <utility>    // for move
+
+namespace morpheus {
+namespace {
+
+// Sent by the connecting side and echoed back by the accepting side, once both endpoints are up
+constexpr uint64_t HandshakeMagic = 0x4d4f5250484555ULL;
+
+struct SocketAddress
+{
+    sockaddr_storage storage{};
+    socklen_t length{0};
+};
+
+SocketAddress resolve(const std::string& address, uint16_t port, bool passive)
+{
+    addrinfo hints{};
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags    = passive ? AI_PASSIVE : 0;
+
+    addrinfo* result = nullptr;
+    const auto error = ::getaddrinfo(address.empty() ? nullptr : address.c_str(),
+                                     std::to_string(port).c_str(),
+                                     &hints,
+                                     &result);
+    if (error != 0 || result == nullptr)
+    {
+        throw std::runtime_error(
+            MORPHEUS_CONCAT_STR("Unable to resolve '" << address << ":" << port << "': " << ::gai_strerror(error)));
+    }
+
+    SocketAddress resolved;
+    std::memcpy(&resolved.storage, result->ai_addr, result->ai_addrlen);
+    resolved.length = result->ai_addrlen;
+    ::freeaddrinfo(result);
+
+    return resolved;
+}
+
+void check_status(ucs_status_t status, const std::string& what)
+{
+    if (status != UCS_OK)
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR(what << ": " << ::ucs_status_string(status)));
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief UCX context, worker and endpoint of a connection. Callbacks are only ever invoked from
+ * `ucp_worker_progress`, on the thread using the connection.
+ */
+struct UcxConnection::Worker
+{
+    Worker()
+    {
+        ucp_config_t* config = nullptr;
+        check_status(::ucp_config_read(nullptr, nullptr, &config), "Unable to read the UCX configuration");
+
+        ucp_params_t params{};
+        params.field_mask = UCP_PARAM_FIELD_FEATURES;
+        params.features   = UCP_FEATURE_TAG;
+
+        const auto status = ::ucp_init(&params, config, &context);
+        ::ucp_config_release(config);
+        check_status(status, "Unable to initialize UCX");
+
+        ucp_worker_params_t worker_params{};
+        worker_params.field_mask  = UCP_WORKER_PARAM_FIELD_THREAD_MODE;
+        worker_params.thread_mode = UCS_THREAD_MODE_SINGLE;
+
+        check_status(::ucp_worker_create(context, &worker_params, &worker), "Unable to create a UCX worker");
+    }
+
+    ~Worker()
+    {
+        close_endpoint();
+
+        if (listener != nullptr)
+        {
+            ::ucp_listener_destroy(listener);
+        }
+
+        if (worker != nullptr)
+        {
+            ::ucp_worker_destroy(worker);
+        }
+
+        if (context != nullptr)
+        {
+            ::ucp_cleanup(context);
+        }
+    }
+
+    void create_endpoint(ucp_ep_params_t& params)
+    {
+        params.field_mask |= UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE | UCP_EP_PARAM_FIELD_ERR_HANDLER;
+        params.err_mode        = UCP_ERR_HANDLING_MODE_PEER;
+        params.err_handler.cb  = &Worker::on_endpoint_error;
+        params.err_handler.arg = this;
+
+        error = UCS_OK;
+        check_status(::ucp_ep_create(worker, &params, &endpoint), "Unable to create a UCX endpoint");
+    }
+
+    void close_endpoint()
+    {
+        if (endpoint == nullptr)
+        {
+            return;
+        }
+
+        // Pending sends are flushed to a healthy peer, a failed endpoint can only be closed forcefully
+        ucp_request_param_t params{};
+        params.op_attr_mask = UCP_OP_ATTR_FIELD_FLAGS;
+        params.flags        = error == UCS_OK ? 0 : UCP_EP_CLOSE_FLAG_FORCE;
+
+        auto* request = ::ucp_ep_close_nbx(endpoint, &params);
+        endpoint      = nullptr;
+
+        try
+        {
+            wait(request, nullptr);
+        } catch (const std::exception& e)
+        {
+            VLOG(10) << "Closing the UCX endpoint failed: " << e.what();
+        }
+    }
+
+    /**
+     * @brief Progresses the worker until `request` completes, cancelling it once `should_stop` returns true
+     *
+     * @return true : When the request completed, false when cancelled
+     */
+    bool wait(ucs_status_ptr_t request, const stop_fn_t& should_stop)
+    {
+        if (request == nullptr)
+        {
+            return true;
+        }
+
+        if (UCS_PTR_IS_ERR(request))
+        {
+            check_status(UCS_PTR_STATUS(request), "UCX request failed");
+        }
+
+        ucs_status_t status = UCS_INPROGRESS;
+        bool cancelled      = false;
+        while ((status = ::ucp_request_check_status(request)) == UCS_INPROGRESS)
+        {
+            if (::ucp_worker_progress(worker) != 0)
+            {
+                continue;
+            }
+
+            // Receives are posted on the worker, they do not fail on their own when the peer goes away
+            if (!cancelled && (error != UCS_OK || (should_stop && should_stop())))
+            {
+                ::ucp_request_cancel(worker, request);
+                cancelled = true;
+            }
+        }
+
+        ::ucp_request_free(request);
+
+        if (status == UCS_ERR_CANCELED && error == UCS_OK)
+        {
+            return false;
+        }
+
+        check_status(error != UCS_OK ? error : status, "UCX transfer failed");
+
+        return true;
+    }
+
+    static void on_endpoint_error(void* arg, ucp_ep_h /*endpoint*/, ucs_status_t status)
+    {
+        static_cast<Worker*>(arg)->error = status;
+    }
+
+    static void on_connection_request(ucp_conn_request_h conn_request, void* arg)
+    {
+        auto* self = static_cast<Worker*>(arg);
+        if (self->conn_request != nullptr)
+        {
+            // Only a single peer is served
+            ::ucp_listener_reject(self->listener, conn_request);
+            return;
+        }
+
+        self->conn_request = conn_request;
+    }
+
+    ucp_context_h context{nullptr};
+    ucp_worker_h worker{nullptr};
+    ucp_listener_h listener{nullptr};
+    ucp_conn_request_h conn_request{nullptr};
+    ucp_ep_h endpoint{nullptr};
+    ucs_status_t error{UCS_OK};
+};
+
+// Component public implementations
+// ************ UcxConnection ************************* //
+UcxConnection::UcxConnection(std::unique_ptr<Worker> worker) : m_worker(std::move(worker)) {}
+
+UcxConnection::~UcxConnection() = default;
+
+std::unique_ptr<UcxConnection> UcxConnection::accept(const std::string& bind_address,
+                                                     uint16_t port,
+                                                     const stop_fn_t& should_stop)
+{
+    auto worker  = std::make_unique<Worker>();
+    auto address = resolve(bind_address, port, true);
+
+    ucp_listener_params_t listener_params{};
+    listener_params.field_mask       = UCP_LISTENER_PARAM_FIELD_SOCK_ADDR | UCP_LISTENER_PARAM_FIELD_CONN_HANDLER;
+    listener_params.sockaddr.addr    = reinterpret_cast<const sockaddr*>(&address.storage);
+    listener_params.sockaddr.addrlen = address.length;
+    listener_params.conn_handler.cb  = &Worker::on_connection_request;
+    listener_params.conn_handler.arg = worker.get();
+
+    check_status(::ucp_listener_create(worker->worker, &listener_params, &worker->listener),
+                 MORPHEUS_CONCAT_STR("Unable to listen on '" << bind_address << ":" << port << "'"));
+
+    LOG(INFO) << "Waiting for a UCX peer on " << bind_address << ":" << port;
+
+    while (worker->conn_request == nullptr)
+    {
+        if (::ucp_worker_progress(worker->worker) == 0)
+        {
+            if (should_stop && should_stop())
+            {
+                return nullptr;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    ucp_ep_params_t ep_params{};
+    ep_params.field_mask   = UCP_EP_PARAM_FIELD_CONN_REQUEST;
+    ep_params.conn_request = worker->conn_request;
+    worker->create_endpoint(ep_params);
+
+    std::unique_ptr<UcxConnection> connection(new UcxConnection(std::move(worker)));
+
+    uint64_t magic = 0;
+    if (!connection->recv(&magic, sizeof(magic), should_stop))
+    {
+        return nullptr;
+    }
+
+    if (magic != HandshakeMagic)
+    {
+        throw std::runtime_error("Unexpected handshake from the UCX peer");
+    }
+
+    connection->send(&magic, sizeof(magic));
+
+    return connection;
+}
+
+std::unique_ptr<UcxConnection> UcxConnection::connect(const std::string& address,
+                                                      uint16_t port,
+                                                      std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    const auto resolved = resolve(address, port, false);
+
+    while (true)
+    {
+        std::unique_ptr<UcxConnection> connection(new UcxConnection(std::make_unique<Worker>()));
+
+        ucp_ep_params_t ep_params{};
+        ep_params.field_mask       = UCP_EP_PARAM_FIELD_FLAGS | UCP_EP_PARAM_FIELD_SOCK_ADDR;
+        ep_params.flags            = UCP_EP_PARAMS_FLAGS_CLIENT_SERVER;
+        ep_params.sockaddr.addr    = reinterpret_cast<const sockaddr*>(&resolved.storage);
+        ep_params.sockaddr.addrlen = resolved.length;
+        connection->m_worker->create_endpoint(ep_params);
+
+        try
+        {
+            uint64_t magic = HandshakeMagic;
+            connection->send(&magic, sizeof(magic));
+
+            magic = 0;
+            connection->recv(&magic, sizeof(magic));
+            if (magic == HandshakeMagic)
+            {
+                return connection;
+            }
+        } catch (const std::exception& e)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                throw std::runtime_error(MORPHEUS_CONCAT_STR("Unable to connect to the UCX peer '"
+                                                             << address << ":" << port << "': " << e.what()));
+            }
+
+            VLOG(10) << "UCX peer " << address << ":" << port << " is not reachable yet: " << e.what();
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+}
+
+void UcxConnection::send(const void* data, std::size_t size)
+{
+    ucp_request_param_t params{};
+    auto* request = ::ucp_tag_send_nbx(m_worker->endpoint, data, size, m_num_sent++, &params);
+
+    m_worker->wait(request, nullptr);
+}
+
+bool UcxConnection::recv(void* data, std::size_t size, const stop_fn_t& should_stop)
+{
+    ucp_request_param_t params{};
+    auto* request = ::ucp_tag_recv_nbx(m_worker->worker, data, size, m_num_received, ~ucp_tag_t{0}, &params);
+
+    if (!m_worker->wait(request, should_stop))
+    {
+        return false;
+    }
+
+    ++m_num_received;
+
+    return true;
+}
+
+}  // namespace morpheus
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/llm/async_semaphore.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace morpheus::llm {
+
+AsyncSemaphore::Permit::Permit(Permit&& other) noexcept :
+  m_semaphore(std::exchange(other.m_semaphore, nullptr))
+{}
+
+AsyncSemaphore::Permit& AsyncSemaphore::Permit::operator=(Permit&& other) noexcept
+{
+    if (this != &other)
+    {
+        this->release();
+        m_semaphore = std::exchange(other.m_semaphore, nullptr);
+    }
+
+    return *this;
+}
+
+AsyncSemaphore::Permit::~Permit()
+{
+    this->release();
+}
+
+void AsyncSemaphore::Permit::release()
+{
+    if (m_semaphore != nullptr)
+    {
+        std::exchange(m_semaphore, nullptr)->release();
+    }
+}
+
+bool AsyncSemaphore::Awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    std::lock_guard lock(m_semaphore.m_mutex);
+
+    if (m_semaphore.m_available > 0)
+    {
+        --m_semaphore.m_available;
+        return false;
+    }
+
+    m_semaphore.m_waiting.push_back(handle);
+    return true;
+}
+
+AsyncSemaphore::AsyncSemaphore(std::size_t count) : m_available(count)
+{
+    if (count == 0)
+    {
+        throw std::invalid_argument("AsyncSemaphore requires at least one permit");
+    }
+}
+
+std::size_t AsyncSemaphore::available() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_available;
+}
+
+void AsyncSemaphore::release()
+{
+    std::coroutine_handle<> waiting{nullptr};
+    {
+        std::lock_guard lock(m_mutex);
+
+        if (m_waiting.empty())
+        {
+            ++m_available;
+            return;
+        }
+
+        // The permit is handed to the first waiter directly, so it cannot be taken by a new acquirer
+        waiting = m_waiting.front();
+        m_waiting.pop_front();
+    }
+
+    waiting.resume();
+}
+
+}  // namespace morpheus::llm
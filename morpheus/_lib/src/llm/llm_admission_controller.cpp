@@ -0,0 +1,413 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/llm/llm_admission_controller.hpp"
+
+#include <mrc/coroutines/task.hpp>  // IWYU pragma: keep
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace morpheus::llm {
+
+namespace {
+std::optional<std::string> find_header(const LLMAdmissionController::headers_t& headers, const std::string& name)
+{
+    for (const auto& [key, value] : headers)
+    {
+        if (std::equal(key.begin(), key.end(), name.begin(), name.end(), [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == b;
+            }))
+        {
+            return value;
+        }
+    }
+
+    return std::nullopt;
+}
+
+// Parses a number of seconds, or a duration such as `1m30s` or `250ms` as returned by the OpenAI reset headers
+std::optional<double> parse_seconds(const std::string& value)
+{
+    const char* current = value.c_str();
+    const char* end     = current + value.size();
+
+    double seconds = 0;
+    bool parsed    = false;
+
+    while (current < end)
+    {
+        char* number_end = nullptr;
+        double number    = std::strtod(current, &number_end);
+
+        if (number_end == current)
+        {
+            return std::nullopt;
+        }
+
+        current = number_end;
+
+        std::string unit;
+        while (current < end && std::isalpha(static_cast<unsigned char>(*current)))
+        {
+            unit.push_back(*current++);
+        }
+
+        if (unit.empty() || unit == "s")
+        {
+            seconds += number;
+        }
+        else if (unit == "ms")
+        {
+            seconds += number / 1000.0;
+        }
+        else if (unit == "m")
+        {
+            seconds += number * 60.0;
+        }
+        else if (unit == "h")
+        {
+            seconds += number * 3600.0;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+
+        parsed = true;
+    }
+
+    return parsed ? std::optional<double>(seconds) : std::nullopt;
+}
+
+std::optional<double> header_seconds(const LLMAdmissionController::headers_t& headers, const std::string& name)
+{
+    auto value = find_header(headers, name);
+
+    return value.has_value() ? parse_seconds(*value) : std::nullopt;
+}
+}  // namespace
+
+/**
+ * @brief Suspends a call until it is admitted, resuming immediately when the budgets allow and nobody is waiting
+ */
+class LLMAdmissionController::Admission
+{
+  public:
+    Admission(LLMAdmissionController& controller, std::size_t tokens) : m_controller(controller), m_tokens(tokens) {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        std::lock_guard lock(m_controller.m_mutex);
+
+        auto now = clock_t::now();
+        m_controller.refill(now);
+
+        // Calls already waiting are admitted first
+        if (m_controller.m_waiting.empty() &&
+            m_controller.time_until_admissible(m_tokens, now) == clock_t::duration::zero())
+        {
+            m_controller.consume(m_tokens);
+            return false;
+        }
+
+        m_handle = handle;
+        m_controller.m_waiting.push_back(this);
+        m_controller.m_timer_cv.notify_one();
+
+        return true;
+    }
+
+    void await_resume() const
+    {
+        if (m_cancelled)
+        {
+            throw std::runtime_error("The LLMAdmissionController was destroyed while the call was waiting");
+        }
+    }
+
+  private:
+    friend class LLMAdmissionController;
+
+    LLMAdmissionController& m_controller;
+    std::size_t m_tokens;
+    std::coroutine_handle<> m_handle{nullptr};
+    bool m_cancelled{false};
+};
+
+LLMAdmissionController::LLMAdmissionController(double max_requests_per_second,
+                                               double max_tokens_per_minute,
+                                               double min_rate_fraction,
+                                               double increase_fraction) :
+  m_max_requests_per_second(max_requests_per_second),
+  m_max_tokens_per_minute(max_tokens_per_minute),
+  m_min_requests_per_second(max_requests_per_second * min_rate_fraction),
+  m_increase(max_requests_per_second * increase_fraction),
+  m_requests_per_second(max_requests_per_second),
+  m_request_budget(std::max(1.0, max_requests_per_second)),
+  m_token_budget(max_tokens_per_minute),
+  m_last_refill(clock_t::now())
+{
+    if (!(max_requests_per_second > 0))
+    {
+        throw std::invalid_argument("max_requests_per_second must be greater than 0");
+    }
+
+    if (max_tokens_per_minute < 0)
+    {
+        throw std::invalid_argument("max_tokens_per_minute must be greater than or equal to 0");
+    }
+
+    if (!(min_rate_fraction > 0 && min_rate_fraction <= 1) || !(increase_fraction > 0 && increase_fraction <= 1))
+    {
+        throw std::invalid_argument("min_rate_fraction and increase_fraction must be in (0, 1]");
+    }
+
+    m_timer_thread = std::thread(&LLMAdmissionController::run_timer, this);
+}
+
+LLMAdmissionController::~LLMAdmissionController()
+{
+    std::vector<std::coroutine_handle<>> cancelled;
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+
+        for (auto* admission : m_waiting)
+        {
+            admission->m_cancelled = true;
+            cancelled.push_back(admission->m_handle);
+        }
+
+        m_waiting.clear();
+    }
+
+    m_timer_cv.notify_one();
+    m_timer_thread.join();
+
+    for (auto& handle : cancelled)
+    {
+        handle.resume();
+    }
+}
+
+Task<double> LLMAdmissionController::acquire(std::size_t tokens)
+{
+    auto started_at = clock_t::now();
+
+    co_await Admission(*this, tokens);
+
+    co_return std::chrono::duration<double>(clock_t::now() - started_at).count();
+}
+
+void LLMAdmissionController::on_success(const headers_t& headers)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto now = clock_t::now();
+
+    // Additive increase, the budget accumulated so far is kept at the previous rate
+    this->refill(now);
+    m_requests_per_second = std::min(m_max_requests_per_second, m_requests_per_second + m_increase);
+
+    this->pause_from_headers(headers, false, now);
+
+    m_timer_cv.notify_one();
+}
+
+void LLMAdmissionController::on_rate_limited(const headers_t& headers)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto now = clock_t::now();
+    this->refill(now);
+
+    // Calls in flight fail together, only the first decrease of each second applies
+    if (now - m_last_decrease >= std::chrono::seconds(1))
+    {
+        m_requests_per_second = std::max(m_min_requests_per_second, m_requests_per_second / 2.0);
+        m_request_budget      = std::min(m_request_budget, std::max(1.0, m_requests_per_second));
+        m_last_decrease       = now;
+    }
+
+    this->pause_from_headers(headers, true, now);
+
+    m_timer_cv.notify_one();
+}
+
+double LLMAdmissionController::requests_per_second() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_requests_per_second;
+}
+
+std::size_t LLMAdmissionController::num_waiting() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_waiting.size();
+}
+
+void LLMAdmissionController::refill(clock_t::time_point now)
+{
+    double elapsed = std::chrono::duration<double>(now - m_last_refill).count();
+    m_last_refill  = now;
+
+    if (elapsed <= 0)
+    {
+        return;
+    }
+
+    // A second worth of requests can be sent at once, at least one
+    m_request_budget = std::min(std::max(1.0, m_requests_per_second),
+                                m_request_budget + elapsed * m_requests_per_second);
+
+    if (m_max_tokens_per_minute > 0)
+    {
+        m_token_budget = std::min(m_max_tokens_per_minute, m_token_budget + elapsed * m_max_tokens_per_minute / 60.0);
+    }
+}
+
+LLMAdmissionController::clock_t::duration LLMAdmissionController::time_until_admissible(std::size_t tokens,
+                                                                                         clock_t::time_point now) const
+{
+    double wait_seconds = 0;
+
+    if (m_paused_until > now)
+    {
+        wait_seconds = std::chrono::duration<double>(m_paused_until - now).count();
+    }
+
+    if (m_request_budget < 1.0)
+    {
+        wait_seconds = std::max(wait_seconds, (1.0 - m_request_budget) / m_requests_per_second);
+    }
+
+    if (m_max_tokens_per_minute > 0)
+    {
+        double needed = std::min(static_cast<double>(tokens), m_max_tokens_per_minute);
+
+        if (m_token_budget < needed)
+        {
+            wait_seconds = std::max(wait_seconds, (needed - m_token_budget) * 60.0 / m_max_tokens_per_minute);
+        }
+    }
+
+    return std::chrono::duration_cast<clock_t::duration>(std::chrono::duration<double>(wait_seconds));
+}
+
+void LLMAdmissionController::consume(std::size_t tokens)
+{
+    m_request_budget -= 1.0;
+
+    if (m_max_tokens_per_minute > 0)
+    {
+        m_token_budget -= std::min(static_cast<double>(tokens), m_max_tokens_per_minute);
+    }
+}
+
+void LLMAdmissionController::pause_from_headers(const headers_t& headers, bool rate_limited, clock_t::time_point now)
+{
+    std::optional<double> pause_seconds;
+
+    auto extend = [&](std::optional<double> seconds) {
+        if (seconds.has_value())
+        {
+            pause_seconds = std::max(pause_seconds.value_or(0.0), *seconds);
+        }
+    };
+
+    if (rate_limited)
+    {
+        auto retry_after_ms = header_seconds(headers, "retry-after-ms");
+        extend(retry_after_ms.has_value() ? std::optional<double>(*retry_after_ms / 1000.0) : std::nullopt);
+        extend(header_seconds(headers, "retry-after"));
+    }
+
+    // A spent budget of the service resets after the given duration
+    for (const auto* budget : {"requests", "tokens"})
+    {
+        auto remaining = header_seconds(headers, std::string("x-ratelimit-remaining-") + budget);
+
+        if (remaining.has_value() && *remaining <= 0)
+        {
+            extend(header_seconds(headers, std::string("x-ratelimit-reset-") + budget));
+        }
+    }
+
+    if (pause_seconds.has_value())
+    {
+        m_paused_until = std::max(
+            m_paused_until,
+            now + std::chrono::duration_cast<clock_t::duration>(std::chrono::duration<double>(*pause_seconds)));
+    }
+}
+
+void LLMAdmissionController::run_timer()
+{
+    std::unique_lock lock(m_mutex);
+
+    while (!m_stopping)
+    {
+        auto now = clock_t::now();
+        this->refill(now);
+
+        std::vector<std::coroutine_handle<>> admitted;
+
+        while (!m_waiting.empty() &&
+               this->time_until_admissible(m_waiting.front()->m_tokens, now) == clock_t::duration::zero())
+        {
+            this->consume(m_waiting.front()->m_tokens);
+            admitted.push_back(m_waiting.front()->m_handle);
+            m_waiting.pop_front();
+        }
+
+        if (!admitted.empty())
+        {
+            lock.unlock();
+
+            for (auto& handle : admitted)
+            {
+                handle.resume();
+            }
+
+            lock.lock();
+            continue;
+        }
+
+        if (m_waiting.empty())
+        {
+            m_timer_cv.wait(lock);
+        }
+        else
+        {
+            m_timer_cv.wait_for(lock, this->time_until_admissible(m_waiting.front()->m_tokens, now));
+        }
+    }
+}
+
+}  // namespace morpheus::llm
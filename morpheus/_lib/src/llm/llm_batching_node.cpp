@@ -0,0 +1,380 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/llm/llm_batching_node.hpp"
+
+#include "morpheus/llm/input_map.hpp"
+#include "morpheus/llm/llm_context.hpp"
+#include "morpheus/utilities/string_util.hpp"
+
+#include <mrc/coroutines/event.hpp>
+#include <mrc/coroutines/task.hpp>  // IWYU pragma: keep
+#include <nlohmann/json.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace morpheus::llm {
+
+struct LLMBatchingNode::Batch
+{
+    struct Entry
+    {
+        std::shared_ptr<LLMContext> context;
+        nlohmann::json inputs;
+        std::size_t num_rows;
+    };
+
+    std::vector<Entry> entries;
+    std::size_t num_rows{0};
+
+    // Guarded by the mutex of the node
+    bool closed{false};
+    std::coroutine_handle<> waiting{nullptr};
+
+    mrc::coroutines::Event completed{};
+    std::exception_ptr error{nullptr};
+};
+
+/**
+ * @brief Suspends the first context of a batch until the batch is closed, resuming immediately if it already is
+ */
+class LLMBatchingNode::BatchClosed
+{
+  public:
+    BatchClosed(LLMBatchingNode& node, Batch& batch) : m_node(node), m_batch(batch) {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        std::lock_guard lock(m_node.m_mutex);
+
+        if (m_batch.closed)
+        {
+            return false;
+        }
+
+        m_batch.waiting = handle;
+        return true;
+    }
+
+    void await_resume() const noexcept {}
+
+  private:
+    LLMBatchingNode& m_node;
+    Batch& m_batch;
+};
+
+LLMBatchingNode::LLMBatchingNode(std::shared_ptr<LLMNodeBase> node,
+                                 std::size_t max_batch_size,
+                                 std::chrono::milliseconds max_delay) :
+  m_node(std::move(node)),
+  m_max_batch_size(max_batch_size),
+  m_max_delay(max_delay)
+{
+    if (!m_node)
+    {
+        throw std::invalid_argument("LLMBatchingNode requires a node to wrap");
+    }
+
+    if (m_max_batch_size == 0)
+    {
+        throw std::invalid_argument("max_batch_size must be greater than 0");
+    }
+
+    m_timer_thread = std::thread([this]() {
+        this->run_timer();
+    });
+}
+
+LLMBatchingNode::~LLMBatchingNode()
+{
+    std::coroutine_handle<> waiting{nullptr};
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+
+        if (m_open_batch)
+        {
+            waiting = close_batch(*m_open_batch);
+        }
+    }
+
+    m_timer_cv.notify_all();
+    m_timer_thread.join();
+
+    if (waiting)
+    {
+        waiting.resume();
+    }
+}
+
+std::vector<std::string> LLMBatchingNode::get_input_names() const
+{
+    return m_node->get_input_names();
+}
+
+Task<std::shared_ptr<LLMContext>> LLMBatchingNode::execute(std::shared_ptr<LLMContext> context)
+{
+    auto inputs = context->get_inputs();
+
+    if (inputs.empty())
+    {
+        // Nothing to batch
+        co_return co_await m_node->execute(context);
+    }
+
+    std::size_t num_rows = 0;
+    bool is_first_input  = true;
+    for (const auto& [name, value] : inputs.items())
+    {
+        if (!value.is_array())
+        {
+            throw std::invalid_argument(
+                MORPHEUS_CONCAT_STR("LLMBatchingNode requires list inputs, input '" << name << "' is not a list"));
+        }
+
+        if (is_first_input)
+        {
+            num_rows       = value.size();
+            is_first_input = false;
+        }
+        else if (value.size() != num_rows)
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+                "LLMBatchingNode requires inputs of the same length, input '" << name << "' has " << value.size()
+                                                                              << " values instead of " << num_rows));
+        }
+    }
+
+    auto batch = std::make_shared<Batch>();
+    bool is_first_context = true;
+
+    if (num_rows < m_max_batch_size)
+    {
+        std::coroutine_handle<> full_batch_waiting{nullptr};
+        std::coroutine_handle<> batch_waiting{nullptr};
+        {
+            std::lock_guard lock(m_mutex);
+
+            // Close the open batch when the inputs do not fit, they start a new one
+            if (m_open_batch && m_open_batch->num_rows + num_rows > m_max_batch_size)
+            {
+                full_batch_waiting = close_batch(*m_open_batch);
+            }
+
+            if (m_open_batch)
+            {
+                batch            = m_open_batch;
+                is_first_context = false;
+            }
+            else
+            {
+                m_open_batch = batch;
+                m_deadlines.emplace(std::chrono::steady_clock::now() + m_max_delay, batch);
+                m_timer_cv.notify_one();
+            }
+
+            batch->entries.push_back({context, std::move(inputs), num_rows});
+            batch->num_rows += num_rows;
+
+            if (batch->num_rows >= m_max_batch_size)
+            {
+                batch_waiting = close_batch(*batch);
+            }
+        }
+
+        // The first context of each closed batch dispatches it
+        if (full_batch_waiting)
+        {
+            full_batch_waiting.resume();
+        }
+
+        if (batch_waiting)
+        {
+            batch_waiting.resume();
+        }
+
+        if (is_first_context)
+        {
+            co_await BatchClosed(*this, *batch);
+        }
+    }
+    else
+    {
+        // Too large to share a batch
+        batch->entries.push_back({context, std::move(inputs), num_rows});
+        batch->num_rows = num_rows;
+        batch->closed   = true;
+    }
+
+    if (is_first_context)
+    {
+        co_await this->dispatch(batch);
+    }
+    else
+    {
+        co_await batch->completed;
+    }
+
+    if (batch->error != nullptr)
+    {
+        std::rethrow_exception(batch->error);
+    }
+
+    co_return context;
+}
+
+Task<void> LLMBatchingNode::dispatch(std::shared_ptr<Batch> batch)
+{
+    try
+    {
+        if (batch->entries.size() == 1)
+        {
+            co_await m_node->execute(batch->entries.front().context);
+        }
+        else
+        {
+            const auto& first_context = batch->entries.front().context;
+
+            // Concatenate each input across the contexts of the batch
+            nlohmann::json combined_inputs = nlohmann::json::object();
+            input_mappings_t input_mappings;
+
+            for (const auto& name : m_node->get_input_names())
+            {
+                auto& combined = combined_inputs[name] = nlohmann::json::array();
+                for (auto& entry : batch->entries)
+                {
+                    for (auto& value : entry.inputs[name])
+                    {
+                        combined.push_back(std::move(value));
+                    }
+                }
+
+                input_mappings.emplace_back("/" + name, name);
+            }
+
+            // The wrapped node reads its inputs from the outputs of a root context of its own
+            auto root_context = std::make_shared<LLMContext>(first_context->task(), first_context->message());
+            root_context->set_output(std::move(combined_inputs));
+
+            auto batch_context = root_context->push("batch", std::move(input_mappings));
+
+            co_await m_node->execute(batch_context);
+
+            const auto& outputs = batch_context->view_outputs();
+
+            auto slice = [&batch](const nlohmann::json& values, std::size_t offset, std::size_t count) {
+                if (!values.is_array() || values.size() != batch->num_rows)
+                {
+                    throw std::runtime_error(MORPHEUS_CONCAT_STR(
+                        "LLMBatchingNode expects the outputs of the wrapped node to be lists of one value per input, "
+                        "got "
+                        << values.size() << " values for " << batch->num_rows << " inputs"));
+                }
+
+                return nlohmann::json(values.begin() + offset, values.begin() + offset + count);
+            };
+
+            std::size_t offset = 0;
+            for (auto& entry : batch->entries)
+            {
+                if (outputs.is_object())
+                {
+                    nlohmann::json entry_outputs = nlohmann::json::object();
+                    for (const auto& [key, values] : outputs.items())
+                    {
+                        entry_outputs[key] = slice(values, offset, entry.num_rows);
+                    }
+
+                    entry.context->set_output(std::move(entry_outputs));
+                }
+                else
+                {
+                    entry.context->set_output(slice(outputs, offset, entry.num_rows));
+                }
+
+                offset += entry.num_rows;
+            }
+        }
+    } catch (...)
+    {
+        batch->error = std::current_exception();
+    }
+
+    // Resumes the other contexts of the batch
+    batch->completed.set();
+}
+
+std::coroutine_handle<> LLMBatchingNode::close_batch(Batch& batch)
+{
+    batch.closed = true;
+
+    if (m_open_batch.get() == &batch)
+    {
+        m_open_batch.reset();
+    }
+
+    return std::exchange(batch.waiting, nullptr);
+}
+
+void LLMBatchingNode::run_timer()
+{
+    std::unique_lock lock(m_mutex);
+
+    while (!m_stopping)
+    {
+        if (m_deadlines.empty())
+        {
+            m_timer_cv.wait(lock);
+            continue;
+        }
+
+        auto next = m_deadlines.begin();
+        if (std::chrono::steady_clock::now() < next->first)
+        {
+            m_timer_cv.wait_until(lock, next->first);
+            continue;
+        }
+
+        auto batch = next->second.lock();
+        m_deadlines.erase(next);
+
+        if (batch && !batch->closed)
+        {
+            auto waiting = close_batch(*batch);
+
+            if (waiting)
+            {
+                // Dispatches the batch on this thread until the wrapped node suspends
+                lock.unlock();
+                waiting.resume();
+                lock.lock();
+            }
+        }
+    }
+}
+
+}  // namespace morpheus::llm
@@ -17,16 +17,85 @@
 
 #include "morpheus/llm/llm_context.hpp"
 
+#include "morpheus/llm/llm_output_stream.hpp"
 #include "morpheus/utilities/string_util.hpp"
 
-#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace morpheus::llm {
+namespace {
+// Whether the JSON pointer `path` is `prefix` or points below it
+bool is_under(const std::string& path, const std::string& prefix)
+{
+    return path.starts_with(prefix) && (path.size() == prefix.size() || path[prefix.size()] == '/');
+}
+
+std::string output_pointer(const std::string& output_name)
+{
+    return (nlohmann::json::json_pointer() / output_name).to_string();
+}
+}  // namespace
+
+ResolvedInputMappings::ResolvedInputMappings(input_mappings_t inputs) : inputs(std::move(inputs))
+{
+    pointers.reserve(this->inputs.size());
+
+    for (std::size_t i = 0; i < this->inputs.size(); ++i)
+    {
+        const auto& input = this->inputs[i];
+
+        if (!input.external_name.empty() && input.external_name[0] == '/')
+        {
+            pointers.emplace_back(nlohmann::json::json_pointer(input.external_name));
+        }
+        else
+        {
+            pointers.emplace_back(std::nullopt);
+        }
+
+        indices.emplace(input.internal_name, i);
+    }
+}
+
+std::size_t ResolvedInputMappings::index_of(const std::string& internal_name) const
+{
+    auto found = indices.find(internal_name);
+
+    if (found == indices.end())
+    {
+        std::stringstream error_msg;
+        error_msg << "Input '" << internal_name << "' not found in the input list.";
+
+        if (!inputs.empty())
+        {
+            error_msg << " Available inputs are:";
+            for (const auto& input : inputs)
+            {
+                error_msg << " '" << input.internal_name << "'";
+            }
+        }
+        else
+        {
+            error_msg << " Input list is empty.";
+        }
+
+        throw std::runtime_error(error_msg.str());
+    }
 
-LLMContext::LLMContext() : m_state(std::make_shared<LLMContextState>()) {}
+    return found->second;
+}
+
+LLMContext::LLMContext() :
+  m_inputs(std::make_shared<const ResolvedInputMappings>(input_mappings_t{})),
+  m_state(std::make_shared<LLMContextState>())
+{}
 
 LLMContext::LLMContext(LLMTask task, std::shared_ptr<ControlMessage> message) : LLMContext()
 {
@@ -35,6 +104,12 @@ LLMContext::LLMContext(LLMTask task, std::shared_ptr<ControlMessage> message) :
 }
 
 LLMContext::LLMContext(std::shared_ptr<LLMContext> parent, std::string name, input_mappings_t inputs) :
+  LLMContext(std::move(parent), std::move(name), std::make_shared<const ResolvedInputMappings>(std::move(inputs)))
+{}
+
+LLMContext::LLMContext(std::shared_ptr<LLMContext> parent,
+                       std::string name,
+                       std::shared_ptr<const ResolvedInputMappings> inputs) :
   m_parent(std::move(parent)),
   m_name(std::move(name)),
   m_inputs(std::move(inputs))
@@ -54,7 +129,7 @@ const std::string& LLMContext::name() const
 
 const input_mappings_t& LLMContext::input_map() const
 {
-    return m_inputs;
+    return m_inputs->inputs;
 }
 
 const LLMTask& LLMContext::task() const
@@ -79,6 +154,8 @@ std::shared_ptr<ControlMessage>& LLMContext::message() const
 
 nlohmann::json::const_reference LLMContext::all_outputs() const
 {
+    this->materialize_columns("");
+
     return m_outputs;
 }
 
@@ -99,100 +176,144 @@ std::shared_ptr<LLMContext> LLMContext::push(std::string name, input_mappings_t
     return std::make_shared<LLMContext>(this->shared_from_this(), std::move(name), std::move(inputs));
 }
 
+std::shared_ptr<LLMContext> LLMContext::push_resolved(std::string name,
+                                                      std::shared_ptr<const ResolvedInputMappings> inputs)
+{
+    return std::make_shared<LLMContext>(this->shared_from_this(), std::move(name), std::move(inputs));
+}
+
 void LLMContext::pop()
 {
+    // A column holding all of the outputs cannot be split by output name
+    if (!m_output_names.empty())
+    {
+        this->materialize_root_column();
+    }
+
     // Copy the outputs from the child context to the parent
     if (m_output_names.empty())
     {
         // Use them all by default
-        m_parent->set_output(m_name, std::move(m_outputs));
+        std::map<std::string, std::shared_ptr<LLMOutputColumn>> columns;
+        {
+            std::lock_guard lock(m_outputs_mutex);
+            columns = this->extract_columns("");
+        }
+
+        m_parent->set_output_with_columns(m_name, std::move(m_outputs), std::move(columns));
     }
     else if (m_output_names.size() == 1)
     {
         // Treat only a single output as the output
-        m_parent->set_output(m_name, std::move(m_outputs[m_output_names[0]]));
+        std::map<std::string, std::shared_ptr<LLMOutputColumn>> columns;
+        {
+            std::lock_guard lock(m_outputs_mutex);
+            columns = this->extract_columns(output_pointer(m_output_names[0]));
+        }
+
+        m_parent->set_output_with_columns(m_name, std::move(m_outputs[m_output_names[0]]), std::move(columns));
     }
     else
     {
         // Build a new json object with only the specified keys
         nlohmann::json new_outputs;
+        std::map<std::string, std::shared_ptr<LLMOutputColumn>> columns;
 
         for (const auto& output_name : m_output_names)
         {
+            // The outputs are copied, the columns being shared with the parent
+            auto pointer = output_pointer(output_name);
+            {
+                std::lock_guard lock(m_outputs_mutex);
+                for (const auto& [path, column] : m_columns)
+                {
+                    if (is_under(path, pointer))
+                    {
+                        columns.emplace(path, column);
+                    }
+                }
+            }
+
             new_outputs[output_name] = m_outputs[output_name];
         }
 
-        m_parent->set_output(m_name, std::move(new_outputs));
+        m_parent->set_output_with_columns(m_name, std::move(new_outputs), std::move(columns));
     }
 }
 
 nlohmann::json::const_reference LLMContext::get_input() const
 {
-    if (m_inputs.size() > 1)
+    if (m_inputs->inputs.size() > 1)
     {
         throw std::runtime_error(
             "LLMContext::get_input() called on a context with multiple inputs. Use get_input(input_name) instead.");
     }
 
-    return this->get_input(m_inputs[0].internal_name);
+    return this->get_mapped_input(0);
 }
 
 nlohmann::json::const_reference LLMContext::get_input(const std::string& node_name) const
 {
     if (node_name[0] == '/')
     {
-        nlohmann::json::json_pointer node_json_ptr(node_name);
-
-        if (!m_outputs.contains(node_json_ptr))
-        {
-            throw std::runtime_error(MORPHEUS_CONCAT_STR("Input '" << node_name << "' not found in the output map"));
-        }
-
         // Get the value from a sibling output
-        return m_outputs[node_json_ptr];
+        return this->get_output(nlohmann::json::json_pointer(node_name), node_name);
     }
-    else
+
+    // Must be on the parent, so find the mapping between this namespace and the parent
+    return this->get_mapped_input(m_inputs->index_of(node_name));
+}
+
+nlohmann::json::const_reference LLMContext::get_mapped_input(std::size_t index) const
+{
+    const auto& pointer = m_inputs->pointers[index];
+
+    if (pointer.has_value())
     {
-        // Must be on the parent, so find the mapping between this namespace and the parent
-        auto found = std::find_if(m_inputs.begin(), m_inputs.end(), [&node_name](const auto& map_iterator) {
-            return map_iterator.internal_name == node_name;
-        });
+        return m_parent->get_output(*pointer, m_inputs->inputs[index].external_name);
+    }
 
-        if (found == m_inputs.end())
-        {
-            std::stringstream error_msg;
-            error_msg << "Input '" << node_name << "' not found in the input list.";
+    return m_parent->get_input(m_inputs->inputs[index].external_name);
+}
 
-            if (!m_inputs.empty())
-            {
-                error_msg << " Available inputs are:";
-                for (const auto& input : m_inputs)
-                {
-                    error_msg << " '" << input.internal_name << "'";
-                }
-            }
-            else
-            {
-                error_msg << " Input list is empty.";
-            }
+nlohmann::json::const_reference LLMContext::get_output(const nlohmann::json::json_pointer& pointer,
+                                                       const std::string& path) const
+{
+    this->materialize_columns(path);
 
-            throw std::runtime_error(error_msg.str());
-        }
+    // Each sibling only writes its outputs once, before any node depending on it executes. Only the lookup needs to
+    // be guarded, the returned reference remaining valid when other siblings insert their outputs.
+    std::lock_guard lock(m_outputs_mutex);
+
+    if (!m_outputs.contains(pointer))
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Input '" << path << "' not found in the output map"));
+    }
+
+    return m_outputs[pointer];
+}
+
+std::shared_ptr<LLMOutputColumn> LLMContext::get_input_column(const std::string& node_name) const
+{
+    if (node_name[0] == '/')
+    {
+        std::lock_guard lock(m_outputs_mutex);
 
-        auto& input_name = found->external_name;
+        auto found = m_columns.find(node_name);
 
-        // Get the value from a parent output
-        return m_parent->get_input(input_name);
+        return found != m_columns.end() ? found->second : nullptr;
     }
+
+    return m_parent->get_input_column(m_inputs->inputs[m_inputs->index_of(node_name)].external_name);
 }
 
 nlohmann::json LLMContext::get_inputs() const
 {
     nlohmann::json inputs = nlohmann::json::object();
 
-    for (const auto& in_map : m_inputs)
+    for (std::size_t i = 0; i < m_inputs->inputs.size(); ++i)
     {
-        inputs[in_map.internal_name] = this->get_input(in_map.internal_name);
+        inputs[m_inputs->inputs[i].internal_name] = this->get_mapped_input(i);
     }
 
     return inputs;
@@ -200,14 +321,36 @@ nlohmann::json LLMContext::get_inputs() const
 
 void LLMContext::set_output(nlohmann::json outputs)
 {
-    m_outputs = std::move(outputs);
+    {
+        std::lock_guard lock(m_outputs_mutex);
+        m_outputs = std::move(outputs);
+        m_columns.clear();
+    }
 
     this->outputs_complete();
 }
 
 void LLMContext::set_output(const std::string& output_name, nlohmann::json output)
 {
-    m_outputs[output_name] = std::move(output);
+    this->set_output_with_columns(output_name, std::move(output), {});
+}
+
+void LLMContext::set_output_column(std::shared_ptr<LLMOutputColumn> outputs)
+{
+    {
+        std::lock_guard lock(m_outputs_mutex);
+        m_outputs = nullptr;
+        m_columns.clear();
+        m_columns.emplace("", std::move(outputs));
+    }
+
+    this->outputs_complete();
+}
+
+void LLMContext::set_output_column(const std::string& output_name, std::shared_ptr<LLMOutputColumn> output)
+{
+    // The null value holds the place of the column in the outputs
+    this->set_output_with_columns(output_name, nullptr, {{"", std::move(output)}});
 }
 
 void LLMContext::set_output_names(std::vector<std::string> output_names)
@@ -215,6 +358,63 @@ void LLMContext::set_output_names(std::vector<std::string> output_names)
     m_output_names = std::move(output_names);
 }
 
+void LLMContext::set_output_stream(std::shared_ptr<LLMOutputStream> output_stream)
+{
+    if (m_parent)
+    {
+        throw std::runtime_error("The output stream can only be set on the root context");
+    }
+
+    m_state->output_stream = std::move(output_stream);
+}
+
+std::shared_ptr<LLMOutputStream> LLMContext::output_stream() const
+{
+    if (m_parent)
+    {
+        return m_parent->output_stream();
+    }
+
+    return m_state->output_stream;
+}
+
+bool LLMContext::is_streaming() const
+{
+    auto output_stream = this->output_stream();
+
+    return output_stream && !output_stream->is_closed();
+}
+
+void LLMContext::stream_output(nlohmann::json chunk) const
+{
+    auto output_stream = this->output_stream();
+
+    if (output_stream)
+    {
+        output_stream->write(this->full_name(), std::move(chunk));
+    }
+}
+
+void LLMContext::set_trace(std::shared_ptr<LLMTrace> trace)
+{
+    if (m_parent)
+    {
+        throw std::runtime_error("The trace can only be set on the root context");
+    }
+
+    m_state->trace = std::move(trace);
+}
+
+std::shared_ptr<LLMTrace> LLMContext::trace() const
+{
+    if (m_parent)
+    {
+        return m_parent->trace();
+    }
+
+    return m_state->trace;
+}
+
 void LLMContext::outputs_complete()
 {
     // m_outputs_promise.set_value();
@@ -225,7 +425,108 @@ nlohmann::json::const_reference LLMContext::view_outputs() const
     // // Wait for the outputs to be available
     // m_outputs_future.wait();
 
+    this->materialize_columns("");
+
     return m_outputs;
 }
 
+void LLMContext::materialize_columns(const std::string& path) const
+{
+    std::vector<std::pair<std::string, std::shared_ptr<LLMOutputColumn>>> columns;
+    {
+        std::lock_guard lock(m_outputs_mutex);
+
+        for (const auto& [column_path, column] : m_columns)
+        {
+            if (is_under(path, column_path) || is_under(column_path, path))
+            {
+                columns.emplace_back(column_path, column);
+            }
+        }
+    }
+
+    if (columns.empty())
+    {
+        return;
+    }
+
+    // Convert without holding the mutex, columns backed by python objects need the GIL
+    std::vector<nlohmann::json> values;
+    values.reserve(columns.size());
+    for (const auto& [column_path, column] : columns)
+    {
+        values.emplace_back(column->to_json());
+    }
+
+    std::lock_guard lock(m_outputs_mutex);
+
+    for (std::size_t i = 0; i < columns.size(); ++i)
+    {
+        // Skip the columns converted or replaced in the meantime
+        auto found = m_columns.find(columns[i].first);
+        if (found != m_columns.end() && found->second == columns[i].second)
+        {
+            m_outputs[nlohmann::json::json_pointer(columns[i].first)] = std::move(values[i]);
+            m_columns.erase(found);
+        }
+    }
+}
+
+void LLMContext::materialize_root_column() const
+{
+    bool has_root_column = false;
+    {
+        std::lock_guard lock(m_outputs_mutex);
+        has_root_column = m_columns.contains("");
+    }
+
+    if (has_root_column)
+    {
+        // No other column can be held alongside a column holding all of the outputs
+        this->materialize_columns("");
+    }
+}
+
+std::map<std::string, std::shared_ptr<LLMOutputColumn>> LLMContext::extract_columns(const std::string& path)
+{
+    std::map<std::string, std::shared_ptr<LLMOutputColumn>> columns;
+
+    for (auto it = m_columns.begin(); it != m_columns.end();)
+    {
+        if (is_under(it->first, path))
+        {
+            columns.emplace(it->first.substr(path.size()), std::move(it->second));
+            it = m_columns.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return columns;
+}
+
+void LLMContext::set_output_with_columns(const std::string& output_name,
+                                         nlohmann::json output,
+                                         std::map<std::string, std::shared_ptr<LLMOutputColumn>> columns)
+{
+    // The outputs become an object holding the output
+    this->materialize_root_column();
+
+    auto pointer = output_pointer(output_name);
+
+    std::lock_guard lock(m_outputs_mutex);
+
+    // Drop the columns of the output being replaced
+    this->extract_columns(pointer);
+
+    m_outputs[output_name] = std::move(output);
+
+    for (auto& [path, column] : columns)
+    {
+        m_columns.emplace(pointer + path, std::move(column));
+    }
+}
+
 }  // namespace morpheus::llm
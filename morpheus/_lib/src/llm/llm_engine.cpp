@@ -25,8 +25,10 @@
 #include "morpheus/messages/control.hpp"
 
 #include <mrc/coroutines/task.hpp>  // IWYU pragma: keep
+#include <mrc/coroutines/when_all.hpp>
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <coroutine>
 #include <optional>
 #include <stdexcept>
@@ -49,6 +51,14 @@ void LLMEngine::add_task_handler(user_input_mappings_t inputs, std::shared_ptr<L
 }
 
 Task<std::vector<std::shared_ptr<ControlMessage>>> LLMEngine::run(std::shared_ptr<ControlMessage> input_message)
+{
+    return this->run(std::move(input_message), nullptr);
+}
+
+Task<std::vector<std::shared_ptr<ControlMessage>>> LLMEngine::run(std::shared_ptr<ControlMessage> input_message,
+                                                                  std::shared_ptr<AsyncSemaphore> concurrency_limit,
+                                                                  std::shared_ptr<LLMOutputStream> output_stream,
+                                                                  bool trace)
 {
     if (!input_message)
     {
@@ -60,7 +70,7 @@ Task<std::vector<std::shared_ptr<ControlMessage>>> LLMEngine::run(std::shared_pt
         throw std::runtime_error("LLMEngine::run() called with a message that does not have the 'llm_engine' task");
     }
 
-    std::vector<std::shared_ptr<ControlMessage>> output_messages;
+    std::vector<std::shared_ptr<LLMContext>> contexts;
 
     while (input_message->has_task("llm_engine"))
     {
@@ -70,20 +80,87 @@ Task<std::vector<std::shared_ptr<ControlMessage>>> LLMEngine::run(std::shared_pt
         LLMTask tmp_task(current_task["task_type"].get<std::string>(), current_task.at("task_dict"));
 
         // Set the name, task, control_message and inputs on the context
-        auto context = std::make_shared<LLMContext>(tmp_task, input_message);
+        auto& context = contexts.emplace_back(std::make_shared<LLMContext>(tmp_task, input_message));
+
+        context->set_output_stream(output_stream);
+
+        if (trace)
+        {
+            context->set_trace(std::make_shared<LLMTrace>());
+        }
+    }
+
+    if (contexts.size() == 1)
+    {
+        co_await this->execute_limited(contexts.front(), std::move(concurrency_limit));
+    }
+    else
+    {
+        // Each task has its own context, call the base node for all of them at once
+        std::vector<Task<void>> executions;
+        executions.reserve(contexts.size());
+
+        for (const auto& context : contexts)
+        {
+            executions.emplace_back(this->execute_limited(context, concurrency_limit));
+        }
+
+        auto results = co_await mrc::coroutines::when_all(std::move(executions));
 
-        // Call the base node
-        co_await this->execute(context);
+        for (auto& result : results)
+        {
+            // Rethrows the error of the first failed task
+            result.return_value();
+        }
+    }
+
+    std::vector<std::shared_ptr<ControlMessage>> output_messages;
 
+    for (const auto& context : contexts)
+    {
         // Pass the outputs into the task generators
         auto tasks = co_await this->handle_tasks(context);
 
+        if (trace)
+        {
+            auto spans = context->trace()->to_json();
+
+            for (const auto& task_message : tasks)
+            {
+                // Several tasks of a message may produce the same output message
+                auto trace_metadata = task_message->get_metadata("llm_trace");
+                if (!trace_metadata.is_array())
+                {
+                    trace_metadata = nlohmann::json::array();
+                }
+
+                trace_metadata.insert(trace_metadata.end(), spans.begin(), spans.end());
+                task_message->set_metadata("llm_trace", trace_metadata);
+            }
+        }
+
         output_messages.insert(output_messages.end(), tasks.begin(), tasks.end());
     }
 
     co_return output_messages;
 }
 
+Task<void> LLMEngine::execute_limited(std::shared_ptr<LLMContext> context,
+                                      std::shared_ptr<AsyncSemaphore> concurrency_limit)
+{
+    AsyncSemaphore::Permit permit;
+    if (concurrency_limit)
+    {
+        auto started_at = std::chrono::system_clock::now();
+
+        permit = co_await concurrency_limit->acquire();
+
+        m_queue_recorder.record(*context, started_at, std::chrono::system_clock::now());
+    }
+
+    co_await this->execute(context);
+}
+
 Task<std::vector<std::shared_ptr<ControlMessage>>> LLMEngine::handle_tasks(std::shared_ptr<LLMContext> context)
 {
     // Wait for the base node outputs (This will yield if not already available)
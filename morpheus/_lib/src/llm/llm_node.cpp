@@ -22,15 +22,61 @@
 #include "morpheus/llm/utils.hpp"
 #include "morpheus/utilities/string_util.hpp"
 
+#include <mrc/coroutines/event.hpp>
 #include <mrc/coroutines/task.hpp>  // IWYU pragma: keep
+#include <mrc/coroutines/when_all.hpp>
 
 #include <algorithm>
 #include <coroutine>
+#include <exception>
+#include <iterator>  // for distance
 #include <sstream>
 #include <stdexcept>
 #include <utility>
 
 namespace morpheus::llm {
+namespace {
+struct ChildExecutionState
+{
+    mrc::coroutines::Event completed{};
+    std::exception_ptr error{nullptr};
+    bool skipped{false};
+};
+
+Task<void> execute_child(std::shared_ptr<LLMNodeRunner> runner,
+                         const std::vector<std::size_t>& dependencies,
+                         std::shared_ptr<LLMContext> context,
+                         std::vector<ChildExecutionState>& states,
+                         std::size_t index)
+{
+    auto& state = states[index];
+
+    for (auto dependency : dependencies)
+    {
+        co_await states[dependency].completed;
+
+        if (states[dependency].error != nullptr || states[dependency].skipped)
+        {
+            // The inputs of this node will never be available
+            state.skipped = true;
+        }
+    }
+
+    if (!state.skipped)
+    {
+        try
+        {
+            co_await runner->execute(context);
+        } catch (...)
+        {
+            state.error = std::current_exception();
+        }
+    }
+
+    // Resumes the nodes depending on this one
+    state.completed.set();
+}
+}  // namespace
 
 LLMNode::LLMNode() = default;
 
@@ -55,6 +101,7 @@ std::shared_ptr<LLMNodeRunner> LLMNode::add_node(std::string name,
     auto final_inputs = process_input_names(inputs, input_names);
 
     // Check the final inputs to ensure they match existing nodes
+    std::vector<std::size_t> dependencies;
     for (const auto& inp : final_inputs)
     {
         // Find the first occurance of "/"
@@ -72,15 +119,25 @@ std::shared_ptr<LLMNodeRunner> LLMNode::add_node(std::string name,
         auto upstream_node_name =
             inp.external_name.substr(1, slash_pos != std::string::npos ? slash_pos - 1 : std::string::npos);
 
-        if (std::find_if(m_child_runners.begin(), m_child_runners.end(), [&upstream_node_name](const auto& runner) {
+        auto upstream_runner =
+            std::find_if(m_child_runners.begin(), m_child_runners.end(), [&upstream_node_name](const auto& runner) {
                 return runner->name() == upstream_node_name;
-            }) == m_child_runners.end())
+            });
+
+        if (upstream_runner == m_child_runners.end())
         {
             // Could not find a matching node for this input
             throw std::invalid_argument(MORPHEUS_CONCAT_STR(
                 "Could not find a node with the name '" << upstream_node_name << "' for the input {'"
                                                         << inp.external_name << "', '" << inp.internal_name << "'}"));
         }
+
+        // Nodes can only take inputs from nodes added before them, which keeps the graph acyclic
+        auto upstream_index = static_cast<std::size_t>(std::distance(m_child_runners.begin(), upstream_runner));
+        if (std::find(dependencies.begin(), dependencies.end(), upstream_index) == dependencies.end())
+        {
+            dependencies.push_back(upstream_index);
+        }
     }
 
     auto node_runner = std::make_shared<LLMNodeRunner>(std::move(name), std::move(final_inputs), std::move(node));
@@ -97,6 +154,7 @@ std::shared_ptr<LLMNodeRunner> LLMNode::add_node(std::string name,
     // Perform checks that the existing nodes meet the requirements
 
     m_child_runners.push_back(node_runner);
+    m_child_dependencies.push_back(std::move(dependencies));
 
     if (is_output)
     {
@@ -123,13 +181,25 @@ size_t LLMNode::node_count() const
 
 Task<std::shared_ptr<LLMContext>> LLMNode::execute(std::shared_ptr<LLMContext> context)
 {
-    for (auto& runner : m_child_runners)
+    // Every child is started in order, waiting for the siblings it depends on before executing. Children which do not
+    // suspend complete before the next one starts, preserving the sequential behavior for synchronous nodes.
+    std::vector<ChildExecutionState> states(m_child_runners.size());
+    std::vector<Task<void>> children;
+    children.reserve(m_child_runners.size());
+
+    for (std::size_t i = 0; i < m_child_runners.size(); ++i)
     {
-        // Run the child node
-        co_await runner->execute(context);
+        children.push_back(execute_child(m_child_runners[i], m_child_dependencies[i], context, states, i));
+    }
+
+    co_await mrc::coroutines::when_all(std::move(children));
 
-        // Wait for the child node outputs (This will yield if not already available)
-        // context->get_outputs();
+    for (const auto& state : states)
+    {
+        if (state.error != nullptr)
+        {
+            std::rethrow_exception(state.error);
+        }
     }
 
     // Before returning, set the output names to only propagate the specified outputs
@@ -26,6 +26,7 @@
 #include <mrc/coroutines/task.hpp>  // IWYU pragma: keep
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <coroutine>
 #include <set>
 #include <sstream>
@@ -116,6 +117,9 @@ LLMNodeRunner::LLMNodeRunner(std::string name, input_mappings_t inputs, std::sha
                                 << ". Missing inputs: "
                                 << StringUtil::array_to_str(missing_names.begin(), missing_names.end()) << "."));
     }
+
+    // Resolved once, every context pushed by this runner sharing them
+    m_resolved_inputs = std::make_shared<const ResolvedInputMappings>(m_inputs);
 }
 
 LLMNodeRunner::~LLMNodeRunner() = default;
@@ -123,7 +127,9 @@ LLMNodeRunner::~LLMNodeRunner() = default;
 Task<std::shared_ptr<LLMContext>> LLMNodeRunner::execute(std::shared_ptr<LLMContext> context)
 {
     // Create a new context
-    auto child_context = context->push(m_name, m_inputs);
+    auto child_context = context->push_resolved(m_name, m_resolved_inputs);
+
+    auto started_at = std::chrono::system_clock::now();
 
     // Also need error handling here
     auto returned_context = co_await m_node->execute(child_context);
@@ -131,6 +137,8 @@ Task<std::shared_ptr<LLMContext>> LLMNodeRunner::execute(std::shared_ptr<LLMCont
     // Call pop to apply the outputs to the parent context
     child_context->pop();
 
+    m_span_recorder.record(*child_context, started_at, std::chrono::system_clock::now());
+
     co_return returned_context;
 }
 
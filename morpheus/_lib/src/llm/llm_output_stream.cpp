@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/llm/llm_output_stream.hpp"
+
+#include <utility>
+
+namespace morpheus::llm {
+
+bool LLMOutputStream::Awaiter::await_ready() const
+{
+    std::lock_guard lock(m_stream.m_mutex);
+    return !m_stream.m_chunks.empty() || m_stream.m_closed;
+}
+
+bool LLMOutputStream::Awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    std::lock_guard lock(m_stream.m_mutex);
+
+    // A chunk may have been written since await_ready
+    if (!m_stream.m_chunks.empty() || m_stream.m_closed)
+    {
+        return false;
+    }
+
+    m_stream.m_reader = handle;
+    return true;
+}
+
+std::optional<LLMStreamChunk> LLMOutputStream::Awaiter::await_resume()
+{
+    std::lock_guard lock(m_stream.m_mutex);
+
+    if (m_stream.m_chunks.empty())
+    {
+        return std::nullopt;
+    }
+
+    auto chunk = std::move(m_stream.m_chunks.front());
+    m_stream.m_chunks.pop_front();
+
+    return chunk;
+}
+
+LLMOutputStream::LLMOutputStream(resume_fn_t resume_fn) : m_resume_fn(std::move(resume_fn)) {}
+
+void LLMOutputStream::write(std::string node_name, nlohmann::json chunk)
+{
+    std::unique_lock lock(m_mutex);
+
+    if (m_closed)
+    {
+        return;
+    }
+
+    m_chunks.push_back(LLMStreamChunk{std::move(node_name), std::move(chunk)});
+
+    this->resume_reader(lock);
+}
+
+void LLMOutputStream::close()
+{
+    std::unique_lock lock(m_mutex);
+
+    m_closed = true;
+
+    this->resume_reader(lock);
+}
+
+bool LLMOutputStream::is_closed() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_closed;
+}
+
+void LLMOutputStream::resume_reader(std::unique_lock<std::mutex>& lock)
+{
+    auto reader = std::exchange(m_reader, nullptr);
+
+    lock.unlock();
+
+    if (!reader)
+    {
+        return;
+    }
+
+    if (m_resume_fn)
+    {
+        m_resume_fn(reader);
+    }
+    else
+    {
+        reader.resume();
+    }
+}
+
+}  // namespace morpheus::llm
@@ -0,0 +1,234 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/llm/llm_prompt_template_node.hpp"
+
+#include "morpheus/llm/llm_context.hpp"
+#include "morpheus/utilities/string_util.hpp"
+
+#include <mrc/coroutines/task.hpp>  // IWYU pragma: keep
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <coroutine>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace morpheus::llm {
+
+namespace {
+void append_value(std::string& output, const nlohmann::json& value)
+{
+    switch (value.type())
+    {
+    case nlohmann::json::value_t::string:
+        output.append(value.get_ref<const std::string&>());
+        break;
+    case nlohmann::json::value_t::boolean:
+        output.append(value.get<bool>() ? "True" : "False");
+        break;
+    case nlohmann::json::value_t::null:
+        output.append("None");
+        break;
+    default:
+        output.append(value.dump());
+        break;
+    }
+}
+
+bool is_identifier(const std::string& name)
+{
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front())))
+    {
+        return false;
+    }
+
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    });
+}
+}  // namespace
+
+LLMPromptTemplateNode::LLMPromptTemplateNode(const std::string& template_str) :
+  m_segments(parse(template_str, m_input_names))
+{
+    for (const auto& segment : m_segments)
+    {
+        m_literal_size += segment.literal.size();
+    }
+}
+
+std::vector<LLMPromptTemplateNode::Segment> LLMPromptTemplateNode::parse(const std::string& template_str,
+                                                                         std::vector<std::string>& input_names)
+{
+    std::vector<Segment> segments;
+    std::string literal;
+
+    auto flush_literal = [&]() {
+        if (!literal.empty())
+        {
+            segments.push_back(Segment{std::move(literal), std::nullopt});
+            literal.clear();
+        }
+    };
+
+    for (std::size_t i = 0; i < template_str.size(); ++i)
+    {
+        char c = template_str[i];
+
+        if (c == '}')
+        {
+            if (i + 1 < template_str.size() && template_str[i + 1] == '}')
+            {
+                literal.push_back('}');
+                ++i;
+                continue;
+            }
+
+            throw std::invalid_argument("Single '}' encountered in the template");
+        }
+
+        if (c != '{')
+        {
+            literal.push_back(c);
+            continue;
+        }
+
+        if (i + 1 < template_str.size() && template_str[i + 1] == '{')
+        {
+            literal.push_back('{');
+            ++i;
+            continue;
+        }
+
+        auto end = template_str.find('}', i + 1);
+        if (end == std::string::npos)
+        {
+            throw std::invalid_argument("Single '{' encountered in the template");
+        }
+
+        auto field_name = template_str.substr(i + 1, end - i - 1);
+
+        if (field_name.empty())
+        {
+            throw std::invalid_argument("Unnamed fields in templates are not supported");
+        }
+
+        if (!is_identifier(field_name))
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+                "Unsupported field '{" << field_name
+                                       << "}' in the template, only named fields without a format spec or conversion "
+                                          "are supported"));
+        }
+
+        flush_literal();
+
+        auto found = std::find(input_names.begin(), input_names.end(), field_name);
+        if (found == input_names.end())
+        {
+            found = input_names.insert(input_names.end(), std::move(field_name));
+        }
+
+        segments.push_back(Segment{"", static_cast<std::size_t>(found - input_names.begin())});
+
+        i = end;
+    }
+
+    flush_literal();
+
+    return segments;
+}
+
+std::vector<std::string> LLMPromptTemplateNode::get_input_names() const
+{
+    return m_input_names;
+}
+
+Task<std::shared_ptr<LLMContext>> LLMPromptTemplateNode::execute(std::shared_ptr<LLMContext> context)
+{
+    auto inputs = context->get_inputs();
+
+    // Without any field, the number of rows is given by whichever inputs are mapped to the node
+    std::size_t num_rows = 0;
+    if (!inputs.empty())
+    {
+        const auto& first = m_input_names.empty() ? inputs.begin().value() : inputs.at(m_input_names.front());
+        num_rows          = first.is_array() ? first.size() : 0;
+    }
+
+    std::vector<const nlohmann::json*> values;
+    values.reserve(m_input_names.size());
+
+    for (const auto& name : m_input_names)
+    {
+        const auto& value = inputs.at(name);
+
+        if (!value.is_array() || value.size() != num_rows)
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+                "LLMPromptTemplateNode requires list inputs of the same length, input '" << name << "' is not"));
+        }
+
+        values.push_back(&value);
+    }
+
+    nlohmann::json outputs = nlohmann::json::array();
+    outputs.get_ref<nlohmann::json::array_t&>().reserve(num_rows);
+
+    for (std::size_t row = 0; row < num_rows; ++row)
+    {
+        std::string prompt;
+        prompt.reserve(m_literal_size);
+
+        for (const auto& segment : m_segments)
+        {
+            if (segment.input_index.has_value())
+            {
+                append_value(prompt, (*values[*segment.input_index])[row]);
+            }
+            else
+            {
+                prompt.append(segment.literal);
+            }
+        }
+
+        outputs.push_back(std::move(prompt));
+    }
+
+    context->set_output(std::move(outputs));
+
+    co_return context;
+}
+
+bool LLMPromptTemplateNode::is_supported(const std::string& template_str)
+{
+    try
+    {
+        std::vector<std::string> input_names;
+        parse(template_str, input_names);
+
+        return true;
+    } catch (const std::invalid_argument&)
+    {
+        return false;
+    }
+}
+
+}  // namespace morpheus::llm
@@ -22,6 +22,7 @@
 #include <glog/logging.h>
 #include <mrc/coroutines/task.hpp>  // IWYU pragma: keep
 
+#include <chrono>
 #include <coroutine>
 #include <ostream>
 #include <string>
@@ -52,6 +53,8 @@ LLMTaskHandlerRunner::LLMTaskHandlerRunner(input_mappings_t inputs, std::shared_
         CHECK_EQ(node_name.find("-"), std::string::npos) << "Invalid node name '" << node_name << "'";
         CHECK_EQ(input_name.find("-"), std::string::npos) << "Invalid input_name '" << input_name << "'";
     }
+
+    m_resolved_inputs = std::make_shared<const ResolvedInputMappings>(m_inputs);
 }
 
 LLMTaskHandlerRunner::~LLMTaskHandlerRunner() = default;
@@ -59,10 +62,16 @@ LLMTaskHandlerRunner::~LLMTaskHandlerRunner() = default;
 Task<LLMTaskHandler::return_t> LLMTaskHandlerRunner::try_handle(std::shared_ptr<LLMContext> context)
 {
     // Create a new context
-    auto child_context = context->push("TaskHandler", m_inputs);
+    auto child_context = context->push_resolved("TaskHandler", m_resolved_inputs);
+
+    auto started_at = std::chrono::system_clock::now();
 
     // Also need error handling here
-    co_return co_await m_handler->try_handle(child_context);
+    auto result = co_await m_handler->try_handle(child_context);
+
+    m_span_recorder.record(*child_context, started_at, std::chrono::system_clock::now());
+
+    co_return result;
 }
 
 }  // namespace morpheus::llm
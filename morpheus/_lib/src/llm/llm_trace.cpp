@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/llm/llm_trace.hpp"
+
+#include "morpheus/llm/llm_context.hpp"
+
+#include <cstdint>
+#include <utility>
+
+namespace morpheus::llm {
+
+nlohmann::json LLMSpan::to_json() const
+{
+    auto to_unix_nano = [](std::chrono::system_clock::time_point time_point) {
+        return static_cast<int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch()).count());
+    };
+
+    return {{"name", node_name},
+            {"kind", kind},
+            {"start_time_unix_nano", to_unix_nano(start)},
+            {"end_time_unix_nano", to_unix_nano(end)}};
+}
+
+void LLMTrace::add_span(LLMSpan span)
+{
+    std::lock_guard lock(m_mutex);
+    m_spans.push_back(std::move(span));
+}
+
+std::vector<LLMSpan> LLMTrace::spans() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_spans;
+}
+
+nlohmann::json LLMTrace::to_json() const
+{
+    nlohmann::json spans = nlohmann::json::array();
+
+    std::lock_guard lock(m_mutex);
+    for (const auto& span : m_spans)
+    {
+        spans.push_back(span.to_json());
+    }
+
+    return spans;
+}
+
+LLMSpanRecorder::LLMSpanRecorder(std::string kind) : m_kind(std::move(kind)) {}
+
+void LLMSpanRecorder::record(const LLMContext& context,
+                             std::chrono::system_clock::time_point start,
+                             std::chrono::system_clock::time_point end)
+{
+    auto node_name = context.full_name();
+
+    std::shared_ptr<Histogram> histogram;
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto& found = m_histograms[node_name];
+        if (!found)
+        {
+            found = MetricsRegistry::get_instance().get_histogram("morpheus_llm_span_seconds",
+                                                                  "Time spent by the LLM engine on each node",
+                                                                  {{"node", node_name}, {"kind", m_kind}});
+        }
+
+        histogram = found;
+    }
+
+    histogram->observe(std::chrono::duration<double>(end - start).count());
+
+    auto trace = context.trace();
+    if (trace)
+    {
+        trace->add_span(LLMSpan{std::move(node_name), m_kind, start, end});
+    }
+}
+
+}  // namespace morpheus::llm
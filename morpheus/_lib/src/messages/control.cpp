@@ -18,6 +18,7 @@
 #include "morpheus/messages/control.hpp"
 
 #include "morpheus/messages/meta.hpp"
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
 
 #include <glog/logging.h>
 #include <pybind11/chrono.h>  // IWYU pragma: keep
@@ -25,9 +26,11 @@
 #include <pybind11/pytypes.h>
 #include <pymrc/utils.hpp>
 
+#include <algorithm>  // for find_if
+#include <atomic>     // for atomic_thread_fence
+#include <deque>
 #include <optional>
 #include <ostream>
-#include <regex>
 #include <stdexcept>
 #include <utility>
 
@@ -41,24 +44,87 @@ const std::string ControlMessage::s_config_schema = R"()";
 std::map<std::string, ControlMessageType> ControlMessage::s_task_type_map{{"inference", ControlMessageType::INFERENCE},
                                                                           {"training", ControlMessageType::TRAINING}};
 
-ControlMessage::ControlMessage() : m_config({{"metadata", nlohmann::json::object()}}), m_tasks({}) {}
+namespace {
+template <typename T>
+T& make_unique_copy(std::shared_ptr<T>& value)
+{
+    if (value.use_count() > 1)
+    {
+        value = std::make_shared<T>(*value);
+    }
+    else
+    {
+        // Orders the writes after the reads made by any message which has since released this instance
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    return *value;
+}
+}  // namespace
 
-ControlMessage::ControlMessage(const nlohmann::json& _config) :
-  m_config({{"metadata", nlohmann::json::object()}}),
-  m_tasks({})
+ControlMessage::ControlMessage() :
+  m_tasks(std::make_shared<task_queues_t>()),
+  m_config(std::make_shared<nlohmann::json>(nlohmann::json{{"metadata", nlohmann::json::object()}}))
+{}
+
+ControlMessage::ControlMessage(const nlohmann::json& _config) : ControlMessage()
 {
     config(_config);
 }
 
-ControlMessage::ControlMessage(const ControlMessage& other)
+ControlMessage::ControlMessage(const ControlMessage& other) : m_tasks(other.m_tasks), m_config(other.m_config) {}
+
+std::shared_ptr<ControlMessage> ControlMessage::clone() const
+{
+    auto cloned          = std::make_shared<ControlMessage>(*this);
+    cloned->m_cm_type    = m_cm_type;
+    cloned->m_payload    = m_payload;
+    cloned->m_tensors    = m_tensors;
+    cloned->m_timestamps = m_timestamps;
+
+    return cloned;
+}
+
+ControlMessage::task_queues_t& ControlMessage::mutable_tasks()
+{
+    return make_unique_copy(m_tasks);
+}
+
+nlohmann::json& ControlMessage::mutable_config()
+{
+    return make_unique_copy(m_config);
+}
+
+const std::deque<nlohmann::json>* ControlMessage::find_tasks(const std::string& task_type) const
 {
-    m_config = other.m_config;
-    m_tasks  = other.m_tasks;
+    for (const auto& [type, tasks] : *m_tasks)
+    {
+        if (type == task_type)
+        {
+            return &tasks;
+        }
+    }
+
+    return nullptr;
 }
 
 const nlohmann::json& ControlMessage::config() const
 {
-    return m_config;
+    return *m_config;
+}
+
+nlohmann::json ControlMessage::to_config() const
+{
+    auto tasks = nlohmann::json::array();
+    for (const auto& [type, queue] : *m_tasks)
+    {
+        for (const auto& properties : queue)
+        {
+            tasks.push_back({{"type", type}, {"properties", properties}});
+        }
+    }
+
+    return {{"metadata", this->get_metadata()}, {"tasks", std::move(tasks)}};
 }
 
 void ControlMessage::add_task(const std::string& task_type, const nlohmann::json& task)
@@ -76,24 +142,46 @@ void ControlMessage::add_task(const std::string& task_type, const nlohmann::json
         throw std::runtime_error("Cannot add inference and training tasks to the same control message");
     }
 
-    m_tasks[task_type].push_back(task);
+    auto& task_queues = this->mutable_tasks();
+    for (auto& [type, tasks] : task_queues)
+    {
+        if (type == task_type)
+        {
+            tasks.push_back(task);
+            MORPHEUS_TRACE("control_message.add_task", static_cast<int64_t>(_task_type), tasks.size());
+            return;
+        }
+    }
+
+    task_queues.emplace_back(task_type, std::deque<nlohmann::json>{task});
+    MORPHEUS_TRACE("control_message.add_task", static_cast<int64_t>(_task_type), 1);
 }
 
 bool ControlMessage::has_task(const std::string& task_type) const
 {
-    return m_tasks.contains(task_type) && m_tasks.at(task_type).size() > 0;
+    const auto* tasks = this->find_tasks(task_type);
+    return tasks != nullptr && !tasks->empty();
 }
 
-const nlohmann::json& ControlMessage::get_tasks() const
+nlohmann::json ControlMessage::get_tasks() const
 {
-    return m_tasks;
+    auto tasks_json = nlohmann::json::object();
+    for (const auto& [type, tasks] : *m_tasks)
+    {
+        tasks_json[type] = nlohmann::json(tasks.begin(), tasks.end());
+    }
+
+    return tasks_json;
 }
 
 std::vector<std::string> ControlMessage::list_metadata() const
 {
+    const auto& metadata = this->get_metadata();
+
     std::vector<std::string> key_list{};
+    key_list.reserve(metadata.size());
 
-    for (auto it = m_config["metadata"].begin(); it != m_config["metadata"].end(); ++it)
+    for (auto it = metadata.begin(); it != metadata.end(); ++it)
     {
         key_list.push_back(it.key());
     }
@@ -103,36 +191,34 @@ std::vector<std::string> ControlMessage::list_metadata() const
 
 void ControlMessage::set_metadata(const std::string& key, const nlohmann::json& value)
 {
-    if (m_config["metadata"].contains(key))
+    auto& metadata = this->mutable_config()["metadata"];
+    if (metadata.contains(key))
     {
         VLOG(20) << "Overwriting metadata key " << key << " with value " << value;
     }
 
-    m_config["metadata"][key] = value;
+    metadata[key] = value;
 }
 
 bool ControlMessage::has_metadata(const std::string& key) const
 {
-    return m_config["metadata"].contains(key);
+    return this->find_metadata(key) != nullptr;
 }
 
-nlohmann::json ControlMessage::get_metadata() const
+const nlohmann::json& ControlMessage::get_metadata() const
 {
-    auto metadata = m_config["metadata"];
-
-    return metadata;
+    return m_config->at("metadata");
 }
 
 nlohmann::json ControlMessage::get_metadata(const std::string& key, bool fail_on_nonexist) const
 {
-    // Assuming m_metadata is a std::map<std::string, nlohmann::json> storing metadata
-    auto metadata = m_config["metadata"];
-    auto it       = metadata.find(key);
-    if (it != metadata.end())
+    const auto* value = this->find_metadata(key);
+    if (value != nullptr)
     {
-        return metadata.at(key);
+        return *value;
     }
-    else if (fail_on_nonexist)
+
+    if (fail_on_nonexist)
     {
         throw std::runtime_error("Metadata key does not exist: " + key);
     }
@@ -140,51 +226,64 @@ nlohmann::json ControlMessage::get_metadata(const std::string& key, bool fail_on
     return {};
 }
 
-nlohmann::json ControlMessage::remove_task(const std::string& task_type)
+const nlohmann::json* ControlMessage::find_metadata(const std::string& key) const
 {
-    auto& task_set = m_tasks.at(task_type);
-    auto iter_task = task_set.begin();
+    const auto& metadata = this->get_metadata();
 
-    if (iter_task != task_set.end())
+    auto it = metadata.find(key);
+    if (it == metadata.end())
     {
-        auto task = *iter_task;
-        task_set.erase(iter_task);
+        return nullptr;
+    }
+
+    return &(*it);
+}
 
-        return task;
+nlohmann::json ControlMessage::remove_task(const std::string& task_type)
+{
+    if (!this->has_task(task_type))
+    {
+        throw std::runtime_error("No tasks of type " + task_type + " found");
     }
 
-    throw std::runtime_error("No tasks of type " + task_type + " found");
+    auto& task_queues = this->mutable_tasks();
+    auto queue        = std::find_if(task_queues.begin(), task_queues.end(), [&task_type](const auto& entry) {
+        return entry.first == task_type;
+    });
+
+    auto task = std::move(queue->second.front());
+    queue->second.pop_front();
+
+    return task;
 }
 
 void ControlMessage::set_timestamp(const std::string& key, time_point_t timestamp_ns)
 {
-    // Insert or update the timestamp in the map
-    m_timestamps[key] = timestamp_ns;
+    // Insert or update the timestamp
+    m_timestamps.set(key, timestamp_ns);
 }
 
-std::map<std::string, time_point_t> ControlMessage::filter_timestamp(const std::string& regex_filter)
+void ControlMessage::set_timestamp(timestamp_key_t key, time_point_t timestamp_ns)
 {
-    std::map<std::string, time_point_t> matching_timestamps;
-    std::regex filter(regex_filter);
+    m_timestamps.set(key, timestamp_ns);
+}
 
-    for (const auto& [key, timestamp] : m_timestamps)
-    {
-        // Check if the key matches the regex
-        if (std::regex_search(key, filter))
-        {
-            matching_timestamps[key] = timestamp;
-        }
-    }
+const MessageTimestamps& ControlMessage::timestamps() const
+{
+    return m_timestamps;
+}
 
-    return matching_timestamps;
+std::map<std::string, time_point_t> ControlMessage::filter_timestamp(const std::string& regex_filter)
+{
+    return m_timestamps.filter(regex_filter);
 }
 
 std::optional<time_point_t> ControlMessage::get_timestamp(const std::string& key, bool fail_if_nonexist)
 {
-    auto it = m_timestamps.find(key);
-    if (it != m_timestamps.end())
+    auto timestamp = m_timestamps.get(key);
+    if (timestamp)
     {
-        return it->second;  // Return the found timestamp
+        return timestamp;  // Return the found timestamp
     }
     else if (fail_if_nonexist)
     {
@@ -303,17 +402,16 @@ py::object ControlMessageProxy::get_metadata(ControlMessage& self,
 {
     if (key.is_none())
     {
-        auto metadata = self.get_metadata();
-        return mrc::pymrc::cast_from_json(metadata);
+        return mrc::pymrc::cast_from_json(self.get_metadata());
     }
 
-    auto value = self.get_metadata(py::cast<std::string>(key), false);
-    if (value.empty())
+    const auto* value = self.find_metadata(py::cast<std::string>(key));
+    if (value == nullptr || value->empty())
     {
         return default_value;
     }
 
-    return mrc::pymrc::cast_from_json(value);
+    return mrc::pymrc::cast_from_json(*value);
 }
 
 void ControlMessageProxy::set_metadata(ControlMessage& self, const std::string& key, pybind11::object& value)
@@ -17,8 +17,9 @@
 
 #include "morpheus/messages/memory/inference_memory.hpp"
 
-#include "morpheus/objects/tensor_object.hpp"  // IWYU pragma: keep
-#include "morpheus/utilities/cupy_util.hpp"    // for CupyUtil::cupy_to_tensors, CupyUtil::py_tensor_map_t
+#include "morpheus/objects/tensor_object.hpp"     // IWYU pragma: keep
+#include "morpheus/utilities/cupy_util.hpp"       // for CupyUtil::cupy_to_tensors, CupyUtil::py_tensor_map_t
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>  // IWYU pragma: keep
@@ -42,11 +43,11 @@ std::shared_ptr<InferenceMemory> InferenceMemoryInterfaceProxy::init(TensorIndex
 {
     if (tensors.is_none())
     {
-        return std::make_shared<InferenceMemory>(count);
+        return make_pooled<InferenceMemory>(count);
     }
     else
     {
-        return std::make_shared<InferenceMemory>(
+        return make_pooled<InferenceMemory>(
             count, std::move(CupyUtil::cupy_to_tensors(tensors.cast<CupyUtil::py_tensor_map_t>())));
     }
 }
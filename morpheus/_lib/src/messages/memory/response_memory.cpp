@@ -18,6 +18,7 @@
 #include "morpheus/messages/memory/response_memory.hpp"
 
 #include "morpheus/utilities/cupy_util.hpp"
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>  // IWYU pragma: keep
@@ -41,11 +42,11 @@ std::shared_ptr<ResponseMemory> ResponseMemoryInterfaceProxy::init(TensorIndex c
 {
     if (tensors.is_none())
     {
-        return std::make_shared<ResponseMemory>(count);
+        return make_pooled<ResponseMemory>(count);
     }
     else
     {
-        return std::make_shared<ResponseMemory>(
+        return make_pooled<ResponseMemory>(
             count, std::move(CupyUtil::cupy_to_tensors(tensors.cast<CupyUtil::py_tensor_map_t>())));
     }
 }
@@ -17,16 +17,24 @@
 
 #include "morpheus/messages/memory/tensor_memory.hpp"  // IWYU pragma: associated
 
-#include "morpheus/objects/tensor_object.hpp"  // for TensorObject
-#include "morpheus/utilities/cupy_util.hpp"    // for CupyUtil
+#include "morpheus/objects/dev_mem_info.hpp"      // for DevMemInfo
+#include "morpheus/objects/tensor.hpp"            // for Tensor
+#include "morpheus/objects/tensor_object.hpp"     // for TensorObject
+#include "morpheus/utilities/cuda_util.hpp"       // for CudaUtil
+#include "morpheus/utilities/cupy_util.hpp"       // for CupyUtil
+#include "morpheus/utilities/matx_util.hpp"       // for MatxUtil
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
 #include "morpheus/utilities/stage_util.hpp"
 #include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
 
+#include <cuda_runtime.h>       // for cudaEventCreateWithFlags, cudaEventRecord, cudaStreamWaitEvent
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>  // for attribute_error, key_error
 #include <pybind11/stl.h>      // IWYU pragma: keep
 
 #include <map>
+#include <mutex>
 #include <sstream>    // needed by MORPHEUS_CONCAT_STR
 #include <stdexcept>  // for std::length_error
 #include <string>
@@ -37,12 +45,23 @@
 namespace morpheus {
 /****** Component public implementations *******************/
 /****** TensorMemory****************************************/
-TensorMemory::TensorMemory(TensorIndex count) : count(count) {}
-TensorMemory::TensorMemory(TensorIndex count, TensorMap&& tensors) : count(count), m_tensors(std::move(tensors))
+TensorMemory::TensorMemory(TensorIndex count) : count(count), m_device_id(CudaUtil::current_device()) {}
+TensorMemory::TensorMemory(TensorIndex count, TensorMap&& tensors) :
+  count(count),
+  m_tensors(std::move(tensors)),
+  m_device_id(CudaUtil::current_device())
 {
     check_tensors_length(this->m_tensors);
 }
 
+TensorMemory::~TensorMemory()
+{
+    if (m_event != nullptr)
+    {
+        cudaEventDestroy(m_event);
+    }
+}
+
 bool TensorMemory::has_tensor(const std::string& name) const
 {
     return this->m_tensors.find(name) != this->m_tensors.end();
@@ -51,44 +70,204 @@ bool TensorMemory::has_tensor(const std::string& name) const
 const TensorObject& TensorMemory::get_tensor(const std::string& name) const
 {
     verify_tensor_exists(name);
+    materialize_tensor(name);
     return m_tensors.at(name);
 }
 
 TensorObject& TensorMemory::get_tensor(const std::string& name)
 {
     verify_tensor_exists(name);
+    materialize_tensor(name);
     return m_tensors[name];
 }
 
 void TensorMemory::set_tensor(const std::string& name, TensorObject&& tensor)
 {
     check_tensor_length(tensor);
+
+    {
+        std::lock_guard lock(m_lazy_mutex);
+        m_lazy_tensors.erase(name);
+    }
+
     this->m_tensors[name].swap(std::move(tensor));
 }
 
+void TensorMemory::set_lazy_tensor(const std::string& name, tensor_factory_fn_t factory)
+{
+    std::lock_guard lock(m_lazy_mutex);
+
+    this->m_tensors[name].swap(TensorObject{});
+    m_lazy_tensors[name] = std::move(factory);
+    m_has_lazy_tensors.store(true, std::memory_order_release);
+}
+
+bool TensorMemory::is_lazy_tensor(const std::string& name) const
+{
+    if (!m_has_lazy_tensors.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    std::lock_guard lock(m_lazy_mutex);
+    return m_lazy_tensors.find(name) != m_lazy_tensors.end();
+}
+
+std::vector<std::string> TensorMemory::tensor_names() const
+{
+    std::vector<std::string> names;
+    names.reserve(m_tensors.size());
+    for (const auto& [name, tensor] : m_tensors)
+    {
+        names.push_back(name);
+    }
+
+    return names;
+}
+
 const TensorMap& TensorMemory::get_tensors() const
 {
+    materialize_tensors();
     return m_tensors;
 }
 
 void TensorMemory::set_tensors(TensorMap&& tensors)
 {
     check_tensors_length(tensors);
+
+    {
+        std::lock_guard lock(m_lazy_mutex);
+        m_lazy_tensors.clear();
+        m_has_lazy_tensors.store(false, std::memory_order_release);
+    }
+
     this->m_tensors = std::move(tensors);
 }
 
 TensorMap TensorMemory::copy_tensor_ranges(const std::vector<RangeType>& ranges, TensorIndex num_selected_rows) const
 {
+    materialize_tensors();
+
+    // The rows of every 2D tensor are gathered by a single kernel launch, rather than a launch and a synchronization
+    // per tensor
+    std::vector<std::string> names;
+    std::vector<DevMemInfo> inputs;
+
     TensorMap tensors;
-    for (const auto& p : this->m_tensors)
+    for (const auto& [name, tensor] : this->m_tensors)
+    {
+        if (tensor.rank() == 2)
+        {
+            names.push_back(name);
+            inputs.emplace_back(
+                tensor.data(), tensor.dtype(), tensor.get_memory(), tensor.get_shape(), tensor.get_stride());
+        }
+        else
+        {
+            tensors.insert(std::pair{name, tensor.copy_rows(ranges, num_selected_rows)});
+        }
+    }
+
+    auto buffers = MatxUtil::gather_rows(inputs, ranges, num_selected_rows);
+
+    for (std::size_t i = 0; i < names.size(); ++i)
     {
-        tensors.insert(std::pair{p.first, p.second.copy_rows(ranges, num_selected_rows)});
+        tensors.insert(std::pair{names[i],
+                                 Tensor::create(std::move(buffers[i]),
+                                                inputs[i].dtype(),
+                                                {num_selected_rows, inputs[i].shape(1)},
+                                                {},
+                                                0)});
     }
 
     return tensors;
 }
 
-void TensorMemory::check_tensor_length(const TensorObject& tensor)
+int TensorMemory::device_id() const
+{
+    return m_device_id;
+}
+
+void TensorMemory::record_event(rmm::cuda_stream_view stream)
+{
+    std::lock_guard lock(m_event_mutex);
+
+    if (m_event == nullptr)
+    {
+        MRC_CHECK_CUDA(cudaEventCreateWithFlags(&m_event, cudaEventDisableTiming));
+    }
+
+    MRC_CHECK_CUDA(cudaEventRecord(m_event, stream.value()));
+}
+
+void TensorMemory::wait_for_event(rmm::cuda_stream_view stream) const
+{
+    std::lock_guard lock(m_event_mutex);
+
+    if (m_event != nullptr)
+    {
+        MRC_CHECK_CUDA(cudaStreamWaitEvent(stream.value(), m_event, 0));
+    }
+}
+
+void TensorMemory::synchronize_event() const
+{
+    std::lock_guard lock(m_event_mutex);
+
+    if (m_event != nullptr)
+    {
+        MRC_CHECK_CUDA(cudaEventSynchronize(m_event));
+    }
+}
+
+void TensorMemory::materialize_tensor(const std::string& name) const
+{
+    if (!m_has_lazy_tensors.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    // Held while computing the tensor, other threads accessing it waiting for it rather than computing it again
+    std::lock_guard lock(m_lazy_mutex);
+
+    auto lazy_tensor = m_lazy_tensors.find(name);
+    if (lazy_tensor == m_lazy_tensors.end())
+    {
+        return;
+    }
+
+    auto tensor = lazy_tensor->second();
+    check_tensor_length(tensor);
+
+    m_tensors.at(name).swap(std::move(tensor));
+
+    m_lazy_tensors.erase(lazy_tensor);
+    m_has_lazy_tensors.store(!m_lazy_tensors.empty(), std::memory_order_release);
+}
+
+void TensorMemory::materialize_tensors() const
+{
+    if (!m_has_lazy_tensors.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    std::vector<std::string> names;
+    {
+        std::lock_guard lock(m_lazy_mutex);
+        for (const auto& [name, factory] : m_lazy_tensors)
+        {
+            names.push_back(name);
+        }
+    }
+
+    for (const auto& name : names)
+    {
+        materialize_tensor(name);
+    }
+}
+
+void TensorMemory::check_tensor_length(const TensorObject& tensor) const
 {
     if (tensor.shape(0) != this->count)
     {
@@ -119,11 +298,11 @@ std::shared_ptr<TensorMemory> TensorMemoryInterfaceProxy::init(TensorIndex count
 {
     if (tensors.is_none())
     {
-        return std::make_shared<TensorMemory>(count);
+        return make_pooled<TensorMemory>(count);
     }
     else
     {
-        return std::make_shared<TensorMemory>(
+        return make_pooled<TensorMemory>(
             count, std::move(CupyUtil::cupy_to_tensors(tensors.cast<CupyUtil::py_tensor_map_t>())));
     }
 }
@@ -148,6 +327,12 @@ bool TensorMemoryInterfaceProxy::has_tensor(TensorMemory& self, std::string name
 
 CupyUtil::py_tensor_map_t TensorMemoryInterfaceProxy::get_tensors(TensorMemory& self)
 {
+    // CuPy works on a stream of its own
+    {
+        pybind11::gil_scoped_release no_gil;
+        self.synchronize_event();
+    }
+
     return CupyUtil::tensors_to_cupy(self.get_tensors());
 }
 
@@ -161,6 +346,11 @@ pybind11::object TensorMemoryInterfaceProxy::get_tensor(TensorMemory& self, cons
     try
     {
         auto tensor = self.get_tensor(name);
+        {
+            pybind11::gil_scoped_release no_gil;
+            self.synchronize_event();
+        }
+
         return CupyUtil::tensor_to_cupy(tensor);
     } catch (const std::runtime_error& e)
     {
@@ -168,6 +358,45 @@ pybind11::object TensorMemoryInterfaceProxy::get_tensor(TensorMemory& self, cons
     }
 }
 
+TensorObject TensorMemoryInterfaceProxy::get_tensor_object(TensorMemory& self, const std::string& name)
+{
+    try
+    {
+        auto tensor = self.get_tensor(name);
+
+        // The consumer of the tensor may work on a stream of its own
+        pybind11::gil_scoped_release no_gil;
+        self.synchronize_event();
+
+        return tensor;
+    } catch (const std::runtime_error& e)
+    {
+        throw pybind11::key_error{e.what()};
+    }
+}
+
+ShapeType TensorMemoryInterfaceProxy::get_tensor_shape(TensorMemory& self, const std::string& name)
+{
+    try
+    {
+        return self.get_tensor(name).get_shape();
+    } catch (const std::runtime_error& e)
+    {
+        throw pybind11::key_error{e.what()};
+    }
+}
+
+std::string TensorMemoryInterfaceProxy::get_tensor_dtype(TensorMemory& self, const std::string& name)
+{
+    try
+    {
+        return self.get_tensor(name).get_numpy_typestr();
+    } catch (const std::runtime_error& e)
+    {
+        throw pybind11::key_error{e.what()};
+    }
+}
+
 pybind11::object TensorMemoryInterfaceProxy::get_tensor_property(TensorMemory& self, const std::string name)
 {
     try
@@ -18,33 +18,41 @@
 #include "morpheus/messages/meta.hpp"
 
 #include "morpheus/io/deserializers.hpp"
+#include "morpheus/objects/cpp_data_table.hpp"
 #include "morpheus/objects/dtype.hpp"  // for DType
 #include "morpheus/objects/mutable_table_ctx_mgr.hpp"
 #include "morpheus/objects/python_data_table.hpp"
 #include "morpheus/objects/table_info.hpp"
 #include "morpheus/objects/tensor_object.hpp"
+#include "morpheus/utilities/cuda_util.hpp"  // for CudaUtil
 #include "morpheus/utilities/cudf_util.hpp"
+#include "morpheus/utilities/matx_util.hpp"  // for MatxUtil, StridedColumnCopy
+#include "morpheus/utilities/nvtx_util.hpp"  // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
 
-#include <cuda_runtime.h>               // for cudaMemcpy, cudaMemcpy2D, cudaMemcpyKind
 #include <cudf/column/column_view.hpp>  // for column_view
 #include <cudf/io/types.hpp>
 #include <cudf/types.hpp>  // for type_id, data_type, size_type
 #include <glog/logging.h>
-#include <mrc/cuda/common.hpp>  // for __check_cuda_errors, MRC_CHECK_CUDA
+#include <pybind11/chrono.h>  // IWYU pragma: keep
 #include <pybind11/gil.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
-#include <pyerrors.h>  // for PyExc_DeprecationWarning
-#include <warnings.h>  // for PyErr_WarnEx
+#include <pyerrors.h>                // for PyExc_DeprecationWarning
+#include <rmm/cuda_stream_view.hpp>  // for cuda_stream_per_thread
+#include <warnings.h>                // for PyErr_WarnEx
 
 #include <cstddef>  // for size_t
 #include <cstdint>  // for uint8_t
+#include <functional>  // for function
+#include <map>
 #include <memory>
+#include <mutex>  // for once_flag, call_once
 #include <optional>
 #include <ostream>    // for operator<< needed by glog
 #include <stdexcept>  // for runtime_error
 #include <tuple>      // for make_tuple, tuple
 #include <utility>
+#include <vector>
 // We're already including pybind11.h and don't need to include cast.
 // For some reason IWYU also thinks we need array for the `isinsance` call.
 // IWYU pragma: no_include <pybind11/cast.h>
@@ -55,6 +63,16 @@ namespace morpheus {
 namespace py = pybind11;
 using namespace py::literals;
 
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "MessageMeta");
+}  // namespace
+
+struct MessageMetaAcknowledgement
+{
+    std::once_flag once;
+    std::function<void()> on_ack;
+};
+
 /****** Component public implementations *******************/
 /****** MessageMeta ****************************************/
 
@@ -88,6 +106,15 @@ void MessageMeta::set_data(const std::string& col_name, TensorObject tensor)
 }
 
 void MessageMeta::set_data(const std::vector<std::string>& column_names, const std::vector<TensorObject>& tensors)
+{
+    this->set_data(column_names, tensors, rmm::cuda_stream_per_thread);
+
+    rmm::cuda_stream_per_thread.synchronize();
+}
+
+void MessageMeta::set_data(const std::vector<std::string>& column_names,
+                           const std::vector<TensorObject>& tensors,
+                           rmm::cuda_stream_view stream)
 {
     CHECK_EQ(column_names.size(), tensors.size()) << "Column names and tensors must be the same size";
 
@@ -104,39 +131,7 @@ void MessageMeta::set_data(const std::vector<std::string>& column_names, const s
         throw std::runtime_error(err_msg.str());
     }
 
-    for (std::size_t i = 0; i < tensors.size(); ++i)
-    {
-        const auto& cv            = table_meta.get_column(i);
-        const auto table_type_id  = cv.type().id();
-        const auto tensor_type    = DType(tensors[i].dtype());
-        const auto tensor_type_id = tensor_type.cudf_type_id();
-        const auto row_stride     = tensors[i].stride(0);
-
-        CHECK(tensors[i].count() == cv.size() &&
-              (table_type_id == tensor_type_id ||
-               (table_type_id == cudf::type_id::BOOL8 && tensor_type_id == cudf::type_id::UINT8)));
-
-        const auto item_size = tensors[i].dtype().item_size();
-
-        // Dont use cv.data<>() here since that does not account for the size of each element
-        auto data_start = const_cast<uint8_t*>(cv.head<uint8_t>()) + cv.offset() * item_size;
-
-        if (row_stride == 1)
-        {
-            // column major just use cudaMemcpy
-            MRC_CHECK_CUDA(cudaMemcpy(data_start, tensors[i].data(), tensors[i].bytes(), cudaMemcpyDeviceToDevice));
-        }
-        else
-        {
-            MRC_CHECK_CUDA(cudaMemcpy2D(data_start,
-                                        item_size,
-                                        tensors[i].data(),
-                                        row_stride * item_size,
-                                        item_size,
-                                        cv.size(),
-                                        cudaMemcpyDeviceToDevice));
-        }
-    }
+    copy_tensors_to_columns(table_meta, tensors, stream);
 }
 
 MutableTableInfo MessageMeta::get_mutable_info() const
@@ -157,17 +152,99 @@ std::shared_ptr<MessageMeta> MessageMeta::create_from_python(py::object&& data_t
 }
 
 std::shared_ptr<MessageMeta> MessageMeta::create_from_cpp(cudf::io::table_with_metadata&& data_table,
-                                                          int index_col_count)
+                                                          int index_col_count,
+                                                          int64_t range_start)
 {
-    // Convert to py first
-    py::object py_dt = cpp_to_py(std::move(data_table), index_col_count);
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "create_from_cpp", data_table.tbl->num_rows());
 
-    auto data = std::make_unique<PyDataTable>(std::move(py_dt));
+    // Keep the table in C++. It will only be converted to python if a python stage accesses the DataFrame
+    auto data = std::make_unique<CppDataTable>(std::move(data_table), index_col_count, range_start);
 
     return std::shared_ptr<MessageMeta>(new MessageMeta(std::move(data)));
 }
 
-MessageMeta::MessageMeta(std::shared_ptr<IDataTable> data) : m_data(std::move(data)) {}
+void MessageMeta::copy_tensors_to_columns(const TableInfo& table_meta,
+                                          const std::vector<TensorObject>& tensors,
+                                          rmm::cuda_stream_view stream)
+{
+    std::vector<StridedColumnCopy> copies;
+    copies.reserve(tensors.size());
+
+    for (std::size_t i = 0; i < tensors.size(); ++i)
+    {
+        const auto& cv           = table_meta.get_column(i);
+        const auto table_type_id = cv.type().id();
+        const auto tensor_type   = tensors[i].dtype();
+
+        CHECK(tensors[i].count() == cv.size());
+
+        // Half precision tensors are kept until here, cudf has no half precision columns so they are widened
+        const bool is_half = tensor_type.type_id() == TypeId::FLOAT16 || tensor_type.type_id() == TypeId::BFLOAT16;
+        if (is_half)
+        {
+            CHECK(table_type_id == cudf::type_id::FLOAT32)
+                << "Half precision tensors can only be written to float32 columns";
+        }
+        else
+        {
+            const auto tensor_type_id = tensor_type.cudf_type_id();
+            CHECK(table_type_id == tensor_type_id ||
+                  (table_type_id == cudf::type_id::BOOL8 && tensor_type_id == cudf::type_id::UINT8));
+        }
+
+        const auto item_size = DType::from_cudf(table_type_id).item_size();
+
+        // Dont use cv.data<>() here since that does not account for the size of each element
+        auto data_start = const_cast<uint8_t*>(cv.head<uint8_t>()) + cv.offset() * item_size;
+
+        copies.push_back({data_start,
+                          tensors[i].data(),
+                          tensors[i].stride(0),
+                          cv.size(),
+                          item_size,
+                          is_half ? tensor_type.type_id() : TypeId::EMPTY});
+    }
+
+    // Order the copies after any earlier asynchronous writes to these columns
+    table_meta.wait_for_event(stream);
+    MatxUtil::copy_strided_columns(copies, stream);
+
+    table_meta.record_event(stream);
+}
+
+MessageMeta::MessageMeta(std::shared_ptr<IDataTable> data) :
+  m_data(std::move(data)),
+  m_device_id(CudaUtil::current_device())
+{}
+
+void MessageMeta::set_timestamp(const std::string& key, time_point_t timestamp)
+{
+    m_timestamps.set(key, timestamp);
+}
+
+void MessageMeta::set_timestamp(timestamp_key_t key, time_point_t timestamp)
+{
+    m_timestamps.set(key, timestamp);
+}
+
+const MessageTimestamps& MessageMeta::timestamps() const
+{
+    return m_timestamps;
+}
+
+void MessageMeta::acknowledge()
+{
+    if (m_acknowledgement)
+    {
+        std::call_once(m_acknowledgement->once, m_acknowledgement->on_ack);
+    }
+}
+
+void MessageMeta::set_acknowledgement(std::function<void()> on_ack)
+{
+    m_acknowledgement = std::make_shared<MessageMetaAcknowledgement>();
+    m_acknowledgement->on_ack = std::move(on_ack);
+}
 
 py::object MessageMeta::cpp_to_py(cudf::io::table_with_metadata&& table, int index_col_count)
 {
@@ -193,20 +270,35 @@ bool MessageMeta::has_sliceable_index() const
     return table.has_sliceable_index();
 }
 
+int MessageMeta::device_id() const
+{
+    return m_device_id;
+}
+
+std::size_t MessageMeta::spill()
+{
+    return m_data->spill();
+}
+
+bool MessageMeta::is_spilled() const
+{
+    return m_data->is_spilled();
+}
+
 std::optional<std::string> MessageMeta::ensure_sliceable_index()
 {
     auto table = this->get_mutable_info();
 
-    // Check to ensure we do (or still do) have a non-unique index. Presumably the caller already made a call to
-    // `has_sliceable_index` but there could have been a race condition between the first call to has_sliceable_index
-    // and the acquisition of the mutex. Re-check here to ensure some other thread didn't already fix the index
-    if (!table.has_sliceable_index())
+    // `MutableTableInfo::ensure_sliceable_index` checks whether we (still) have a non-unique index. Presumably the
+    // caller already made a call to `has_sliceable_index` but there could have been a race condition between the first
+    // call to has_sliceable_index and the acquisition of the mutex, some other thread may have already fixed the index
+    auto old_index_col_name = table.ensure_sliceable_index();
+    if (old_index_col_name.has_value())
     {
-        LOG(WARNING) << "Non unique index found in dataframe, generating new index.";
-        return table.ensure_sliceable_index();
+        LOG(WARNING) << "Non unique index found in dataframe, generated a new index.";
     }
 
-    return std::nullopt;
+    return old_index_col_name;
 }
 
 /********** MessageMetaInterfaceProxy **********/
@@ -462,6 +554,38 @@ std::optional<std::string> MessageMetaInterfaceProxy::ensure_sliceable_index(Mes
     return self.ensure_sliceable_index();
 }
 
+void MessageMetaInterfaceProxy::set_timestamp(MessageMeta& self, const std::string& key, py::object timestamp)
+{
+    self.set_timestamp(key, timestamp.cast<time_point_t>());
+}
+
+py::object MessageMetaInterfaceProxy::get_timestamp(MessageMeta& self, const std::string& key, bool fail_if_nonexist)
+{
+    auto timestamp = self.timestamps().get(key);
+    if (timestamp)
+    {
+        return py::cast(*timestamp);
+    }
+
+    if (fail_if_nonexist)
+    {
+        throw std::runtime_error("Timestamp for the specified key does not exist.");
+    }
+
+    return py::none();
+}
+
+py::dict MessageMetaInterfaceProxy::filter_timestamp(MessageMeta& self, const std::string& regex_filter)
+{
+    py::dict timestamps;
+    for (const auto& [key, timestamp] : self.timestamps().filter(regex_filter))
+    {
+        timestamps[py::str(key)] = timestamp;
+    }
+
+    return timestamps;
+}
+
 SlicedMessageMeta::SlicedMessageMeta(std::shared_ptr<MessageMeta> other,
                                      TensorIndex start,
                                      TensorIndex stop,
@@ -18,24 +18,33 @@
 #include "morpheus/messages/multi.hpp"
 
 #include "morpheus/messages/meta.hpp"
-#include "morpheus/objects/dtype.hpp"  // for TypeId, DType
 #include "morpheus/objects/table_info.hpp"
 #include "morpheus/objects/tensor_object.hpp"
 #include "morpheus/utilities/cudf_util.hpp"
-
-#include <cuda_runtime.h>               // for cudaMemcpy, cudaMemcpy2D, cudaMemcpyDeviceToDevice
-#include <cudf/column/column_view.hpp>  // for column_view
-#include <cudf/concatenate.hpp>
-#include <cudf/copying.hpp>
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
+
+#include <cuda_runtime.h>               // for cudaMemcpyAsync, cudaMemcpyHostToDevice
+#include <cudf/aggregation.hpp>  // for make_sum_aggregation
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>  // for make_column_from_scalar
+#include <cudf/column/column_view.hpp>       // for column_view
+#include <cudf/copying.hpp>                  // for gather, scatter, slice
 #include <cudf/io/types.hpp>
+#include <cudf/reduction.hpp>  // for scan
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/table/table.hpp>
 #include <cudf/table/table_view.hpp>
 #include <cudf/types.hpp>
+#include <cudf/utilities/default_stream.hpp>
 #include <glog/logging.h>       // for CHECK
 #include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
 #include <pybind11/cast.h>      // IWYU pragma: keep
 #include <pybind11/gil.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
+#include <rmm/cuda_stream_view.hpp>  // for cuda_stream_per_thread
+#include <rmm/device_buffer.hpp>
+#include <rmm/device_uvector.hpp>
 
 #include <algorithm>  // for transform
 #include <cstddef>    // for size_t
@@ -139,16 +148,6 @@ void MultiMessage::copy_ranges_impl(std::shared_ptr<MultiMessage> new_message,
 
 std::shared_ptr<MessageMeta> MultiMessage::copy_meta_ranges(const std::vector<RangeType>& ranges) const
 {
-    // copy ranges into a sequntial list of values
-    // https://github.com/rapidsai/cudf/issues/11223
-    std::vector<TensorIndex> cudf_ranges;
-    for (const auto& p : ranges)
-    {
-        // Append the message offset to the range here
-        cudf_ranges.push_back(p.first + this->mess_offset);
-        cudf_ranges.push_back(p.second + this->mess_offset);
-    }
-
     auto table_info   = this->meta->get_info();
     auto column_names = table_info.get_column_names();
     auto metadata     = cudf::io::table_metadata{};
@@ -161,19 +160,101 @@ std::shared_ptr<MessageMeta> MultiMessage::copy_meta_ranges(const std::vector<Ra
         metadata.schema_info.emplace_back(column_name);
     }
 
-    auto table_view                     = table_info.get_view();
-    auto sliced_views                   = cudf::slice(table_view, cudf_ranges);
-    cudf::io::table_with_metadata table = {cudf::concatenate(sliced_views), std::move(metadata)};
+    auto table_view = table_info.get_view();
+
+    std::unique_ptr<cudf::table> copied_table;
+    if (ranges.size() == 1)
+    {
+        // A single range is a plain copy of the slice
+        auto sliced_views = cudf::slice(table_view,
+                                        {static_cast<cudf::size_type>(ranges[0].first + this->mess_offset),
+                                         static_cast<cudf::size_type>(ranges[0].second + this->mess_offset)});
+        copied_table      = std::make_unique<cudf::table>(sliced_views[0]);
+    }
+    else
+    {
+        // Many small ranges make slicing and concatenating expensive, gather all of the rows at once instead
+        auto gather_map = ranges_to_gather_map(ranges, this->mess_offset);
+        copied_table    = cudf::gather(table_view, gather_map->view());
+    }
+
+    cudf::io::table_with_metadata table = {std::move(copied_table), std::move(metadata)};
 
     return MessageMeta::create_from_cpp(std::move(table), 1);
 }
 
+std::unique_ptr<cudf::column> MultiMessage::ranges_to_gather_map(const std::vector<RangeType>& ranges,
+                                                                 TensorIndex offset)
+{
+    // The row indices are a sequence incrementing by one within each range, so they are the inclusive sum of a column
+    // of ones with the jump from the last row of the previous range stored at the first row of each range. Only these
+    // jumps are computed on the host.
+    std::vector<cudf::size_type> jump_positions;
+    std::vector<cudf::size_type> jumps;
+    jump_positions.reserve(ranges.size());
+    jumps.reserve(ranges.size());
+
+    cudf::size_type num_rows = 0;
+    TensorIndex last_row     = -1;
+    for (const auto& [start, stop] : ranges)
+    {
+        if (stop <= start)
+        {
+            continue;
+        }
+
+        jump_positions.push_back(num_rows);
+        jumps.push_back(static_cast<cudf::size_type>(start + offset - last_row));
+        last_row = stop + offset - 1;
+        num_rows += static_cast<cudf::size_type>(stop - start);
+    }
+
+    auto stream = cudf::get_default_stream();
+
+    auto to_column = [stream](const std::vector<cudf::size_type>& values) {
+        rmm::device_uvector<cudf::size_type> buffer(values.size(), stream);
+        MRC_CHECK_CUDA(cudaMemcpyAsync(buffer.data(),
+                                       values.data(),
+                                       values.size() * sizeof(cudf::size_type),
+                                       cudaMemcpyHostToDevice,
+                                       stream.value()));
+        stream.synchronize();
+        return std::make_unique<cudf::column>(std::move(buffer), rmm::device_buffer{}, 0);
+    };
+
+    auto ones = cudf::make_column_from_scalar(cudf::numeric_scalar<cudf::size_type>(1), num_rows);
+    if (jumps.empty())
+    {
+        return ones;
+    }
+
+    auto jumps_col          = to_column(jumps);
+    auto jump_positions_col = to_column(jump_positions);
+
+    auto deltas = cudf::scatter(cudf::table_view({jumps_col->view()}),
+                                jump_positions_col->view(),
+                                cudf::table_view({ones->view()}));
+
+    return cudf::scan(deltas->get_column(0).view(),
+                      *cudf::make_sum_aggregation<cudf::scan_aggregation>(),
+                      cudf::scan_type::INCLUSIVE);
+}
+
 void MultiMessage::set_meta(const std::string& col_name, TensorObject tensor)
 {
     set_meta(std::vector<std::string>{col_name}, std::vector<TensorObject>{tensor});
 }
 
 void MultiMessage::set_meta(const std::vector<std::string>& column_names, const std::vector<TensorObject>& tensors)
+{
+    set_meta(column_names, tensors, rmm::cuda_stream_per_thread);
+
+    rmm::cuda_stream_per_thread.synchronize();
+}
+
+void MultiMessage::set_meta(const std::vector<std::string>& column_names,
+                            const std::vector<TensorObject>& tensors,
+                            rmm::cuda_stream_view stream)
 {
     TableInfo table_meta;
     try
@@ -188,39 +269,7 @@ void MultiMessage::set_meta(const std::vector<std::string>& column_names, const
         throw std::runtime_error(err_msg.str());
     }
 
-    for (std::size_t i = 0; i < tensors.size(); ++i)
-    {
-        const auto& cv            = table_meta.get_column(i);
-        const auto table_type_id  = cv.type().id();
-        const auto tensor_type    = DType(tensors[i].dtype());
-        const auto tensor_type_id = tensor_type.cudf_type_id();
-        const auto row_stride     = tensors[i].stride(0);
-
-        CHECK(tensors[i].count() == cv.size() &&
-              (table_type_id == tensor_type_id ||
-               (table_type_id == cudf::type_id::BOOL8 && tensor_type_id == cudf::type_id::UINT8)));
-
-        const auto item_size = tensors[i].dtype().item_size();
-
-        // Dont use cv.data<>() here since that does not account for the size of each element
-        auto data_start = const_cast<uint8_t*>(cv.head<uint8_t>()) + cv.offset() * item_size;
-
-        if (row_stride == 1)
-        {
-            // column major just use cudaMemcpy
-            MRC_CHECK_CUDA(cudaMemcpy(data_start, tensors[i].data(), tensors[i].bytes(), cudaMemcpyDeviceToDevice));
-        }
-        else
-        {
-            MRC_CHECK_CUDA(cudaMemcpy2D(data_start,
-                                        item_size,
-                                        tensors[i].data(),
-                                        row_stride * item_size,
-                                        item_size,
-                                        cv.size(),
-                                        cudaMemcpyDeviceToDevice));
-        }
-    }
+    MessageMeta::copy_tensors_to_columns(table_meta, tensors, stream);
 }
 
 std::vector<RangeType> MultiMessage::apply_offset_to_ranges(TensorIndex offset,
@@ -239,7 +288,7 @@ std::shared_ptr<MultiMessage> MultiMessageInterfaceProxy::init(std::shared_ptr<M
                                                                TensorIndex mess_offset,
                                                                TensorIndex mess_count)
 {
-    return std::make_shared<MultiMessage>(std::move(meta), mess_offset, mess_count);
+    return make_pooled<MultiMessage>(std::move(meta), mess_offset, mess_count);
 }
 
 std::shared_ptr<morpheus::MessageMeta> MultiMessageInterfaceProxy::meta(const MultiMessage& self)
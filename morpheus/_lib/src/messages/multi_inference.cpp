@@ -19,6 +19,7 @@
 
 #include "morpheus/messages/meta.hpp"
 #include "morpheus/messages/multi.hpp"
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
 
 #include <memory>
 #include <string>
@@ -61,7 +62,7 @@ std::shared_ptr<MultiInferenceMessage> MultiInferenceMessageInterfaceProxy::init
                                                                                  TensorIndex count,
                                                                                  std::string id_tensor_name)
 {
-    return std::make_shared<MultiInferenceMessage>(
+    return make_pooled<MultiInferenceMessage>(
         std::move(meta), mess_offset, mess_count, std::move(memory), offset, count, std::move(id_tensor_name));
 }
 
@@ -21,6 +21,7 @@
 #include "morpheus/messages/multi.hpp"
 #include "morpheus/objects/tensor_object.hpp"
 #include "morpheus/utilities/cupy_util.hpp"
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
 #include "morpheus/utilities/string_util.hpp"
 
 #include <memory>
@@ -82,14 +83,14 @@ std::shared_ptr<MultiResponseMessage> MultiResponseMessageInterfaceProxy::init(s
                                                                                std::string id_tensor_name,
                                                                                std::string probs_tensor_name)
 {
-    return std::make_shared<MultiResponseMessage>(std::move(meta),
-                                                  mess_offset,
-                                                  mess_count,
-                                                  std::move(memory),
-                                                  offset,
-                                                  count,
-                                                  std::move(id_tensor_name),
-                                                  std::move(probs_tensor_name));
+    return make_pooled<MultiResponseMessage>(std::move(meta),
+                                             mess_offset,
+                                             mess_count,
+                                             std::move(memory),
+                                             offset,
+                                             count,
+                                             std::move(id_tensor_name),
+                                             std::move(probs_tensor_name));
 }
 
 std::string MultiResponseMessageInterfaceProxy::probs_tensor_name_getter(MultiResponseMessage& self)
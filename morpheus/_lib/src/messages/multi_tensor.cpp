@@ -18,8 +18,9 @@
 #include "morpheus/messages/multi_tensor.hpp"
 
 #include "morpheus/objects/dtype.hpp"
-#include "morpheus/types.hpp"                // for TensorIndex, TensorMap
-#include "morpheus/utilities/cupy_util.hpp"  // for CupyUtil::tensor_to_cupy
+#include "morpheus/types.hpp"                     // for TensorIndex, TensorMap
+#include "morpheus/utilities/cupy_util.hpp"       // for CupyUtil::tensor_to_cupy
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
 #include "morpheus/utilities/string_util.hpp"
 
 #include <glog/logging.h>        // IWYU pragma: keep
@@ -238,7 +239,7 @@ std::shared_ptr<TensorMemory> MultiTensorMessage::copy_input_ranges(const std::v
 {
     auto offset_ranges = apply_offset_to_ranges(offset, ranges);
     auto tensors       = memory->copy_tensor_ranges(offset_ranges, num_selected_rows);
-    return std::make_shared<TensorMemory>(num_selected_rows, std::move(tensors));
+    return make_pooled<TensorMemory>(num_selected_rows, std::move(tensors));
 }
 
 /****** MultiTensorMessageInterfaceProxy *************************/
@@ -250,7 +251,7 @@ std::shared_ptr<MultiTensorMessage> MultiTensorMessageInterfaceProxy::init(std::
                                                                            TensorIndex count,
                                                                            std::string id_tensor_name)
 {
-    return std::make_shared<MultiTensorMessage>(
+    return make_pooled<MultiTensorMessage>(
         std::move(meta), mess_offset, mess_count, std::move(memory), offset, count, std::move(id_tensor_name));
 }
 
@@ -284,6 +285,7 @@ pybind11::object MultiTensorMessageInterfaceProxy::get_tensor(MultiTensorMessage
     try
     {
         auto tensor = self.get_tensor(name);
+        self.memory->synchronize_event();
         return CupyUtil::tensor_to_cupy(tensor);
     } catch (const std::runtime_error& e)
     {
@@ -293,6 +295,7 @@ pybind11::object MultiTensorMessageInterfaceProxy::get_tensor(MultiTensorMessage
 
 pybind11::object MultiTensorMessageInterfaceProxy::get_id_tensor(MultiTensorMessage& self)
 {
+    self.memory->synchronize_event();
     return CupyUtil::tensor_to_cupy(self.get_id_tensor());
 }
 
@@ -17,12 +17,15 @@
 
 #include "morpheus/modules/data_loader_module.hpp"
 
+#include "morpheus/io/data_load_scheduler.hpp"
 #include "morpheus/io/data_loader_registry.hpp"
 #include "morpheus/messages/control.hpp"
 
 #include <glog/logging.h>
 #include <mrc/modules/segment_modules.hpp>
 #include <mrc/node/rx_node.hpp>
+#include <mrc/node/rx_sink.hpp>
+#include <mrc/node/rx_source.hpp>
 #include <mrc/segment/builder.hpp>
 #include <mrc/segment/object.hpp>
 #include <mrc/utils/type_utils.hpp>
@@ -30,6 +33,9 @@
 #include <rxcpp/rx.hpp>
 // IWYU pragma: no_include "rxcpp/sources/rx-iterate.hpp"
 
+#include <cstddef>  // for size_t
+#include <exception>
+#include <map>
 #include <memory>
 #include <ostream>
 #include <stdexcept>
@@ -93,10 +99,22 @@ DataLoaderModule::DataLoaderModule(std::string module_name, nlohmann::json _conf
     {
         LOG(WARNING) << "No loaders specified in config: " << config().dump(2);
     }
+
+    m_max_concurrent_loads = config().value("max_concurrent_loads", std::size_t{1});
+    if (m_max_concurrent_loads == 0)
+    {
+        throw std::runtime_error("max_concurrent_loads must be greater than 0");
+    }
 }
 
 void DataLoaderModule::initialize(mrc::segment::IBuilder& builder)
 {
+    if (m_max_concurrent_loads > 1)
+    {
+        initialize_concurrent(builder);
+        return;
+    }
+
     auto loader_node = builder.make_node<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>(
         "input", rxcpp::operators::map([this](std::shared_ptr<ControlMessage> control_message) {
             return m_data_loader.load(control_message);
@@ -106,6 +124,59 @@ void DataLoaderModule::initialize(mrc::segment::IBuilder& builder)
     register_output_port("output", loader_node);
 }
 
+void DataLoaderModule::initialize_concurrent(mrc::segment::IBuilder& builder)
+{
+    auto loader_limits = config().value("loader_limits", json::object()).get<std::map<std::string, std::size_t>>();
+
+    m_scheduler = std::make_unique<DataLoadScheduler>(
+        [this](std::shared_ptr<ControlMessage> control_message) {
+            return m_data_loader.load(std::move(control_message));
+        },
+        m_max_concurrent_loads,
+        config().value("max_queued_loads", 2 * m_max_concurrent_loads),
+        std::move(loader_limits),
+        config().value("preserve_order", true),
+        config().value("ordering_key", std::string()));
+
+    // The input queues the messages, the loaded ones being emitted by the output as soon as they are ready, even while
+    // no further message arrives
+    auto input_node = builder.make_sink<std::shared_ptr<ControlMessage>>(
+        "input",
+        [this](std::shared_ptr<ControlMessage> control_message) {
+            if (!m_scheduler->submit(std::move(control_message)))
+            {
+                LOG(WARNING) << "Dropping a control message received after the loads were cancelled";
+            }
+        },
+        [this](std::exception_ptr error_ptr) {
+            m_scheduler->close();
+        },
+        [this]() {
+            m_scheduler->close();
+        });
+
+    auto output_node = builder.make_source<std::shared_ptr<ControlMessage>>(
+        "output", [this](rxcpp::subscriber<std::shared_ptr<ControlMessage>>& subscriber) {
+            try
+            {
+                while (auto control_message = m_scheduler->pop())
+                {
+                    subscriber.on_next(std::move(*control_message));
+                }
+            } catch (...)
+            {
+                m_scheduler->cancel();
+                subscriber.on_error(std::current_exception());
+                return;
+            }
+
+            subscriber.on_completed();
+        });
+
+    register_input_port("input", input_node);
+    register_output_port("output", output_node);
+}
+
 std::string DataLoaderModule::module_type_name() const
 {
     return std::string(::mrc::type_name<type_t>());
@@ -0,0 +1,394 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/modules/payload_batcher_module.hpp"
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/objects/table_info.hpp"
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_view.hpp>
+#include <cudf/copying.hpp>  // for gather, slice
+#include <cudf/datetime.hpp>  // for floor_datetimes, extract_year, extract_month
+#include <cudf/filling.hpp>   // for sequence
+#include <cudf/groupby.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/strings/convert/convert_datetime.hpp>  // for to_timestamps
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/utilities/traits.hpp>  // for is_timestamp
+#include <glog/logging.h>
+#include <mrc/modules/segment_modules.hpp>
+#include <mrc/node/rx_node.hpp>
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+#include <mrc/utils/type_utils.hpp>
+#include <nlohmann/json.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <algorithm>
+#include <cstddef>  // for size_t
+#include <exception>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mrc::modules;
+using nlohmann::json;
+
+namespace {
+using namespace morpheus;
+
+// Parsing pattern of string timestamps when none is configured, matching the output of `str(pandas.Timestamp)`
+const std::string DefaultTimestampPattern = "%Y-%m-%d %H:%M:%S";  // NOLINT
+
+// Values set to `None` in python are received as nulls
+std::string get_string(const json& config, const std::string& key, std::string default_value)
+{
+    auto found = config.find(key);
+    if (found == config.end() || found->is_null())
+    {
+        return default_value;
+    }
+
+    return found->get<std::string>();
+}
+
+// Periods of a fixed duration, named as in pandas, timestamps being floored to the start of their period
+std::optional<cudf::datetime::rounding_frequency> fixed_period_frequency(const std::string& period)
+{
+    using cudf::datetime::rounding_frequency;
+    static const std::map<std::string, rounding_frequency> frequencies{{"D", rounding_frequency::DAY},
+                                                                       {"H", rounding_frequency::HOUR},
+                                                                       {"h", rounding_frequency::HOUR},
+                                                                       {"T", rounding_frequency::MINUTE},
+                                                                       {"min", rounding_frequency::MINUTE},
+                                                                       {"S", rounding_frequency::SECOND},
+                                                                       {"s", rounding_frequency::SECOND},
+                                                                       {"L", rounding_frequency::MILLISECOND},
+                                                                       {"ms", rounding_frequency::MILLISECOND},
+                                                                       {"U", rounding_frequency::MICROSECOND},
+                                                                       {"us", rounding_frequency::MICROSECOND},
+                                                                       {"N", rounding_frequency::NANOSECOND},
+                                                                       {"ns", rounding_frequency::NANOSECOND}};
+
+    auto found = frequencies.find(period);
+    if (found == frequencies.end())
+    {
+        return std::nullopt;
+    }
+
+    return found->second;
+}
+
+// Calendar periods are identified by their year, and month for monthly ones
+bool is_calendar_period(const std::string& period)
+{
+    return period == "Y" || period == "A" || period == "M";
+}
+
+// Returns the key columns identifying the period holding each of `timestamps`
+std::vector<std::unique_ptr<cudf::column>> make_period_keys(const cudf::column_view& timestamps,
+                                                            const std::string& period)
+{
+    std::vector<std::unique_ptr<cudf::column>> keys;
+    if (auto frequency = fixed_period_frequency(period); frequency.has_value())
+    {
+        keys.push_back(cudf::datetime::floor_datetimes(timestamps, *frequency));
+        return keys;
+    }
+
+    keys.push_back(cudf::datetime::extract_year(timestamps));
+    if (period == "M")
+    {
+        keys.push_back(cudf::datetime::extract_month(timestamps));
+    }
+
+    return keys;
+}
+
+// Returns the position of column `name` in the view of `info`, which starts with the index columns
+cudf::size_type find_column(const TableInfo& info, const std::vector<std::string>& column_names, const std::string& name)
+{
+    auto found = std::find(column_names.begin(), column_names.end(), name);
+    if (found == column_names.end())
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Column '" << name << "' not found in the payload"));
+    }
+
+    return info.num_indices() + static_cast<cudf::size_type>(std::distance(column_names.begin(), found));
+}
+
+// Splits the rows [start, stop) into ranges of at most `limit` rows
+void append_ranges(cudf::size_type start,
+                   cudf::size_type stop,
+                   cudf::size_type limit,
+                   std::vector<std::pair<cudf::size_type, cudf::size_type>>& ranges)
+{
+    for (auto range_start = start; range_start < stop; range_start += limit)
+    {
+        ranges.emplace_back(range_start, std::min(range_start + limit, stop));
+    }
+}
+
+// Failures are flagged the same way as the python modules and the data loader
+bool is_failed(const ControlMessage& message)
+{
+    const auto* failed = message.find_metadata("cm_failed");
+    if (failed == nullptr)
+    {
+        return false;
+    }
+
+    return (failed->is_boolean() && failed->get<bool>()) || (failed->is_string() && failed->get<std::string>() == "true");
+}
+}  // namespace
+
+namespace morpheus {
+
+const std::string PayloadBatcherModule::s_config_schema = R"()";
+
+PayloadBatcherModule::~PayloadBatcherModule()
+{
+    VLOG(30) << "PayloadBatcherModule::~PayloadBatcherModule(): " << name() << std::endl;
+}
+
+PayloadBatcherModule::PayloadBatcherModule(std::string module_name) : SegmentModule(module_name) {}
+
+PayloadBatcherModule::PayloadBatcherModule(std::string module_name, nlohmann::json _config) :
+  SegmentModule(std::move(module_name), std::move(_config))
+{
+    m_max_batch_size         = config().value("max_batch_size", cudf::size_type{256});
+    m_raise_on_failure       = config().value("raise_on_failure", false);
+    m_disable_max_batch_size = config().value("disable_max_batch_size", false);
+    m_timestamp_column_name  = get_string(config(), "timestamp_column_name", "");
+    m_timestamp_pattern      = get_string(config(), "timestamp_pattern", "");
+    m_period                 = get_string(config(), "period", "D");
+
+    auto group_by_columns = config().find("group_by_columns");
+    if (group_by_columns != config().end() && !group_by_columns->is_null())
+    {
+        m_group_by_columns = group_by_columns->get<std::vector<std::string>>();
+    }
+
+    if (m_disable_max_batch_size && m_group_by_columns.empty() && m_timestamp_column_name.empty())
+    {
+        throw std::invalid_argument(
+            "When disable_max_batch_size is True and group_by_columns must not be empty or None.");
+    }
+
+    if (!m_disable_max_batch_size && m_max_batch_size <= 0)
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("max_batch_size must be greater than 0, got "
+                                                        << m_max_batch_size));
+    }
+
+    if (!m_timestamp_column_name.empty())
+    {
+        if (!fixed_period_frequency(m_period).has_value() && !is_calendar_period(m_period))
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unsupported period: '" << m_period << "'"));
+        }
+
+        if (m_timestamp_pattern.empty())
+        {
+            LOG(WARNING) << "Timestamp column name is provided, but the timestamp pattern is not specified, string "
+                         << "timestamps will be parsed with the pattern '" << DefaultTimestampPattern << "'";
+        }
+    }
+}
+
+void PayloadBatcherModule::initialize(mrc::segment::IBuilder& builder)
+{
+    auto batcher_node = builder.make_node<std::shared_ptr<ControlMessage>, std::shared_ptr<ControlMessage>>(
+        "internal_node",
+        rxcpp::operators::concat_map([this](std::shared_ptr<ControlMessage> control_message) {
+            return rxcpp::observable<>::iterate(this->batch(control_message));
+        }));
+
+    register_input_port("input", batcher_node);
+    register_output_port("output", batcher_node);
+}
+
+std::string PayloadBatcherModule::module_type_name() const
+{
+    return std::string(::mrc::type_name<type_t>());
+}
+
+std::vector<std::shared_ptr<ControlMessage>> PayloadBatcherModule::batch(
+    const std::shared_ptr<ControlMessage>& message) const
+{
+    if (is_failed(*message))
+    {
+        return {message};
+    }
+
+    try
+    {
+        return this->batch_payload(message);
+    } catch (const std::exception& e)
+    {
+        if (m_raise_on_failure)
+        {
+            throw;
+        }
+
+        message->set_metadata("cm_failed", true);
+        message->set_metadata("cm_failed_reason", e.what());
+    }
+
+    return {message};
+}
+
+std::vector<std::shared_ptr<ControlMessage>> PayloadBatcherModule::batch_payload(
+    const std::shared_ptr<ControlMessage>& message) const
+{
+    auto payload = message->payload();
+    if (!payload)
+    {
+        throw std::runtime_error("Payload cannot be None");
+    }
+
+    const auto info         = payload->get_info();
+    const auto num_rows     = info.num_rows();
+    const auto column_names = info.get_column_names();
+    const auto& view        = info.get_view();
+
+    const bool group_rows = !m_group_by_columns.empty() || !m_timestamp_column_name.empty();
+    if (!group_rows && num_rows <= m_max_batch_size)
+    {
+        return {message};
+    }
+
+    // The index is reset on each batch, only the columns are kept
+    const cudf::table_view data_view{std::vector<cudf::column_view>(view.begin() + info.num_indices(), view.end())};
+
+    std::vector<std::pair<cudf::size_type, cudf::size_type>> ranges;
+
+    // When grouping, rows of the i-th range are the rows of the i-th range of `gather_map`
+    std::unique_ptr<cudf::table> gather_map;
+
+    if (!group_rows)
+    {
+        append_ranges(0, num_rows, m_max_batch_size, ranges);
+    }
+    else
+    {
+        std::vector<cudf::column_view> keys;
+        std::vector<std::unique_ptr<cudf::column>> period_keys;
+
+        auto add_period_keys = [&]() {
+            auto timestamps = view.column(find_column(info, column_names, m_timestamp_column_name));
+
+            std::unique_ptr<cudf::column> parsed_timestamps;
+            if (timestamps.type().id() == cudf::type_id::STRING)
+            {
+                parsed_timestamps = cudf::strings::to_timestamps(
+                    cudf::strings_column_view{timestamps},
+                    cudf::data_type{cudf::type_id::TIMESTAMP_NANOSECONDS},
+                    m_timestamp_pattern.empty() ? DefaultTimestampPattern : m_timestamp_pattern);
+                timestamps = parsed_timestamps->view();
+            }
+            else if (!cudf::is_timestamp(timestamps.type()))
+            {
+                throw std::runtime_error(MORPHEUS_CONCAT_STR(
+                    "Timestamp column '" << m_timestamp_column_name << "' must hold strings or timestamps"));
+            }
+
+            for (auto& key : make_period_keys(timestamps, m_period))
+            {
+                keys.push_back(key->view());
+                period_keys.push_back(std::move(key));
+            }
+        };
+
+        // The period of the timestamp column takes its place among the group by columns, or is grouped by last
+        bool has_period_keys = false;
+        for (const auto& column_name : m_group_by_columns)
+        {
+            if (column_name == m_timestamp_column_name)
+            {
+                add_period_keys();
+                has_period_keys = true;
+            }
+            else
+            {
+                keys.push_back(view.column(find_column(info, column_names, column_name)));
+            }
+        }
+
+        if (!m_timestamp_column_name.empty() && !has_period_keys)
+        {
+            add_period_keys();
+        }
+
+        // Groups the row ids rather than the rows themselves, such that each batch is gathered straight from the
+        // payload into its own table
+        auto row_ids = cudf::sequence(num_rows, cudf::numeric_scalar<cudf::size_type>(0));
+        cudf::groupby::groupby grouper(cudf::table_view{keys});
+        auto groups = grouper.get_groups(cudf::table_view{{row_ids->view()}});
+
+        const auto limit = m_disable_max_batch_size ? num_rows : m_max_batch_size;
+        for (std::size_t i = 0; i + 1 < groups.offsets.size(); ++i)
+        {
+            append_ranges(groups.offsets[i], groups.offsets[i + 1], limit, ranges);
+        }
+
+        gather_map = std::move(groups.values);
+    }
+
+    VLOG(20) << "Number of batches created: " << ranges.size();
+
+    std::vector<std::shared_ptr<ControlMessage>> batches;
+    batches.reserve(ranges.size());
+
+    for (const auto& [start, stop] : ranges)
+    {
+        std::unique_ptr<cudf::table> table;
+        if (gather_map)
+        {
+            table = cudf::gather(data_view, cudf::slice(gather_map->get_column(0).view(), {start, stop})[0]);
+        }
+        else
+        {
+            table = std::make_unique<cudf::table>(cudf::slice(data_view, {start, stop})[0]);
+        }
+
+        cudf::io::table_with_metadata table_with_meta{std::move(table)};
+        for (const auto& column_name : column_names)
+        {
+            table_with_meta.metadata.schema_info.emplace_back(column_name);
+        }
+
+        auto batch = message->clone();
+        batch->payload(MessageMeta::create_from_cpp(std::move(table_with_meta), 0));
+        batches.push_back(std::move(batch));
+    }
+
+    return batches;
+}
+}  // namespace morpheus
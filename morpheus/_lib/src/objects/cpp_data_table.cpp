@@ -0,0 +1,449 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/objects/cpp_data_table.hpp"
+
+#include "morpheus/objects/pinned_host_buffer.hpp"
+#include "morpheus/utilities/cudf_util.hpp"
+#include "morpheus/utilities/metrics.hpp"
+#include "morpheus/utilities/table_util.hpp"  // for CuDFTableUtil
+
+#include <cuda_runtime.h>  // for cudaMemcpyAsync
+#include <cudf/column/column_view.hpp>
+#include <cudf/filling.hpp>  // for sequence
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>
+#include <cudf/utilities/default_stream.hpp>
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <pybind11/gil.h>
+#include <pybind11/pybind11.h>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <algorithm>  // for find
+#include <cstddef>    // for size_t
+#include <cstdint>
+#include <iterator>  // for distance
+#include <memory>
+#include <numeric>  // for iota
+#include <ostream>  // needed for glog
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+
+namespace {
+
+/**
+ * @brief A column of a spilled table, its buffers being stored one after the other in the host buffer of the table
+ */
+struct SpilledColumn
+{
+    cudf::data_type type;
+    cudf::size_type size{0};
+    cudf::size_type null_count{0};
+    std::size_t data_offset{0};
+    std::size_t data_size{0};
+    std::size_t null_mask_offset{0};
+    std::size_t null_mask_size{0};
+    std::vector<SpilledColumn> children;
+};
+
+// Releases the buffers of `column` and its children into `buffers`, placing them after `offset` bytes of the host
+// buffer
+SpilledColumn release_column(cudf::column& column,
+                             std::vector<std::unique_ptr<rmm::device_buffer>>& buffers,
+                             std::size_t& offset)
+{
+    SpilledColumn spilled{column.type(), column.size(), column.null_count()};
+
+    auto contents = column.release();
+
+    spilled.data_offset = offset;
+    spilled.data_size   = contents.data->size();
+    offset += spilled.data_size;
+    buffers.push_back(std::move(contents.data));
+
+    spilled.null_mask_offset = offset;
+    spilled.null_mask_size   = contents.null_mask->size();
+    offset += spilled.null_mask_size;
+    buffers.push_back(std::move(contents.null_mask));
+
+    for (auto& child : contents.children)
+    {
+        spilled.children.push_back(release_column(*child, buffers, offset));
+    }
+
+    return spilled;
+}
+
+std::unique_ptr<cudf::column> restore_column(const SpilledColumn& spilled,
+                                             const char* host_data,
+                                             rmm::cuda_stream_view stream)
+{
+    rmm::device_buffer data(host_data + spilled.data_offset, spilled.data_size, stream);
+    rmm::device_buffer null_mask(host_data + spilled.null_mask_offset, spilled.null_mask_size, stream);
+
+    std::vector<std::unique_ptr<cudf::column>> children;
+    for (const auto& child : spilled.children)
+    {
+        children.push_back(restore_column(child, host_data, stream));
+    }
+
+    return std::make_unique<cudf::column>(
+        spilled.type, spilled.size, std::move(data), std::move(null_mask), spilled.null_count, std::move(children));
+}
+
+std::shared_ptr<Gauge> spilled_bytes_gauge()
+{
+    static auto gauge = MetricsRegistry::get_instance().get_gauge(
+        "morpheus_spilled_bytes", "Bytes of C++ tables currently spilled to host memory", {});
+    return gauge;
+}
+
+std::shared_ptr<Counter> spilled_bytes_counter()
+{
+    static auto counter = MetricsRegistry::get_instance().get_counter(
+        "morpheus_spilled_bytes_total", "Bytes of C++ tables spilled to host memory", {});
+    return counter;
+}
+
+}  // namespace
+
+/****** Component public implementations *******************/
+/****** CppDataTable***************************************/
+struct CppDataTable::SpilledTable
+{
+    PinnedHostBuffer host_buffer;
+    std::size_t num_bytes{0};
+    std::vector<SpilledColumn> columns;
+};
+
+CppDataTable::CppDataTable(cudf::io::table_with_metadata&& table, int index_col_count, int64_t range_start) :
+  m_index_col_count(index_col_count),
+  m_range_start(range_start),
+  m_num_rows(table.tbl->num_rows()),
+  m_table(std::make_unique<cudf::io::table_with_metadata>(std::move(table)))
+{
+    const auto& schema_info = m_table->metadata.schema_info;
+    auto table_view         = m_table->tbl->view();
+
+    CHECK_GE(index_col_count, 0) << "index_col_count must be >= 0";
+    CHECK_LE(index_col_count, table_view.num_columns()) << "index_col_count must be <= the number of columns";
+    CHECK_EQ(schema_info.size(), table_view.num_columns()) << "Table metadata does not match the number of columns";
+
+    if (index_col_count == 0)
+    {
+        // Matches the unnamed RangeIndex that python will create for this table
+        cudf::numeric_scalar<int64_t> start(range_start);
+        m_range_index = cudf::sequence(table_view.num_rows(), start);
+    }
+
+    m_table_data = this->make_table_data();
+}
+
+TableInfoData CppDataTable::make_table_data() const
+{
+    const auto& schema_info = m_table->metadata.schema_info;
+    auto table_view         = m_table->tbl->view();
+
+    std::vector<std::string> index_names;
+    std::vector<std::string> column_names;
+    std::vector<cudf::column_view> columns;
+
+    if (m_range_index)
+    {
+        index_names.emplace_back("");
+        columns.push_back(m_range_index->view());
+    }
+
+    for (cudf::size_type i = 0; i < table_view.num_columns(); ++i)
+    {
+        if (i < m_index_col_count)
+        {
+            index_names.push_back(schema_info[i].name);
+        }
+        else
+        {
+            column_names.push_back(schema_info[i].name);
+        }
+
+        columns.push_back(table_view.column(i));
+    }
+
+    return {cudf::table_view(columns), std::move(index_names), std::move(column_names)};
+}
+
+CppDataTable::~CppDataTable()
+{
+    if (m_spilled)
+    {
+        spilled_bytes_gauge()->decrement(static_cast<double>(m_spilled->num_bytes));
+    }
+
+    if (m_py_table)
+    {
+        pybind11::gil_scoped_acquire gil;
+
+        // Clear out the python object
+        m_py_table = pybind11::object();
+    }
+}
+
+cudf::size_type CppDataTable::count() const
+{
+    if (!m_has_py_object)
+    {
+        return m_num_rows;
+    }
+
+    pybind11::gil_scoped_acquire gil;
+
+    return m_py_table.attr("shape").attr("__getitem__")(0).cast<cudf::size_type>();
+}
+
+const pybind11::object& CppDataTable::get_py_object() const
+{
+    // The GIL serializes the conversion so only a single thread will ever move the table into python
+    pybind11::gil_scoped_acquire gil;
+
+    if (!m_py_table)
+    {
+        // Held for the conversion, such that the table cannot be spilled before `m_has_py_object` is set
+        std::lock_guard spill_lock(m_spill_mutex);
+        this->restore();
+
+        DVLOG(20) << "Converting C++ table to python. Num Rows: " << m_table_data.table_view.num_rows();
+
+        m_py_table = CudfHelper::table_from_table_with_metadata(std::move(*m_table), m_index_col_count);
+        m_table.reset();
+
+        if (m_range_index && m_range_start != 0)
+        {
+            // Python always starts the range index at zero
+            m_py_table.attr("index") = m_py_table.attr("index") + m_range_start;
+        }
+
+        m_has_py_object = true;
+    }
+
+    return m_py_table;
+}
+
+bool CppDataTable::is_py_object_created() const
+{
+    return m_has_py_object;
+}
+
+bool CppDataTable::has_sliceable_index() const
+{
+    if (!m_has_py_object)
+    {
+        if (m_range_index)
+        {
+            return true;
+        }
+
+        // The index columns come first in the view of the C++ table
+        auto table_data = this->get_table_data();
+        std::vector<cudf::size_type> index_columns(m_index_col_count);
+        std::iota(index_columns.begin(), index_columns.end(), 0);
+
+        return CuDFTableUtil::is_sliceable_index(table_data.table_view.select(index_columns));
+    }
+
+    return IDataTable::has_sliceable_index();
+}
+
+TableInfoData CppDataTable::replace_columns(const std::vector<std::string>& column_names,
+                                            std::vector<std::unique_ptr<cudf::column>>&& columns) const
+{
+    if (m_has_py_object)
+    {
+        return IDataTable::replace_columns(column_names, std::move(columns));
+    }
+
+    CHECK_EQ(column_names.size(), columns.size()) << "Each replaced column must have a name";
+
+    // Only the exclusive lock is held, no `TableInfo` can still be viewing the replaced columns
+    auto table_columns = m_table->tbl->release();
+
+    for (std::size_t i = 0; i < column_names.size(); ++i)
+    {
+        const auto& existing_names = m_table_data.column_names;
+        auto found                 = std::find(existing_names.begin(), existing_names.end(), column_names[i]);
+
+        CHECK(found != existing_names.end()) << "Column '" << column_names[i] << "' not found in the table";
+        CHECK_EQ(columns[i]->size(), m_table_data.table_view.num_rows())
+            << "Column '" << column_names[i] << "' does not match the number of rows of the table";
+
+        table_columns[m_index_col_count + std::distance(existing_names.begin(), found)] = std::move(columns[i]);
+    }
+
+    m_table->tbl = std::make_unique<cudf::table>(std::move(table_columns));
+    m_table_data = this->make_table_data();
+
+    return m_table_data;
+}
+
+TableInfoData CppDataTable::reset_index(const std::string& column_prefix) const
+{
+    // A `MultiIndex` is reset through python, which names the new columns after its levels
+    if (m_has_py_object || m_index_col_count != 1)
+    {
+        return IDataTable::reset_index(column_prefix);
+    }
+
+    {
+        // Only the exclusive lock is held, no `TableInfo` can still be viewing the table
+        std::lock_guard spill_lock(m_spill_mutex);
+        this->restore();
+    }
+
+    auto& index_name = m_table->metadata.schema_info[0].name;
+    index_name       = column_prefix + index_name;
+
+    m_index_col_count = 0;
+    m_range_start     = 0;
+
+    cudf::numeric_scalar<int64_t> start(0);
+    m_range_index = cudf::sequence(m_num_rows, start);
+    m_table_data  = this->make_table_data();
+
+    return m_table_data;
+}
+
+bool CppDataTable::is_spilled() const
+{
+    return m_is_spilled;
+}
+
+std::size_t CppDataTable::spill_to_host() const
+{
+    std::lock_guard lock(m_spill_mutex);
+
+    if (m_has_py_object || m_spilled)
+    {
+        return 0;
+    }
+
+    auto spilled = std::make_unique<SpilledTable>();
+    std::vector<std::unique_ptr<rmm::device_buffer>> buffers;
+
+    auto columns = m_table->tbl->release();
+    for (auto& column : columns)
+    {
+        spilled->columns.push_back(release_column(*column, buffers, spilled->num_bytes));
+    }
+
+    // Reserved up front, the buffer must not move while the copies are in flight
+    spilled->host_buffer.reserve(spilled->num_bytes);
+
+    auto stream        = cudf::get_default_stream();
+    std::size_t offset = 0;
+    for (const auto& buffer : buffers)
+    {
+        if (buffer->size() > 0)
+        {
+            MRC_CHECK_CUDA(cudaMemcpyAsync(spilled->host_buffer.data() + offset,
+                                           buffer->data(),
+                                           buffer->size(),
+                                           cudaMemcpyDeviceToHost,
+                                           stream.value()));
+        }
+
+        offset += buffer->size();
+    }
+
+    // The device buffers may be freed on other streams than the one copying them
+    stream.synchronize();
+    buffers.clear();
+
+    m_table->tbl.reset();
+    m_range_index.reset();
+    m_table_data = {};
+
+    const auto num_bytes = spilled->num_bytes;
+    m_spilled            = std::move(spilled);
+    m_is_spilled         = true;
+
+    spilled_bytes_gauge()->increment(static_cast<double>(num_bytes));
+    spilled_bytes_counter()->increment(static_cast<double>(num_bytes));
+
+    DVLOG(20) << "Spilled C++ table to host. Num Rows: " << m_num_rows << ", Num Bytes: " << num_bytes;
+
+    return num_bytes;
+}
+
+void CppDataTable::restore() const
+{
+    if (!m_spilled)
+    {
+        return;
+    }
+
+    auto stream = cudf::get_default_stream();
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    for (const auto& column : m_spilled->columns)
+    {
+        columns.push_back(restore_column(column, m_spilled->host_buffer.data(), stream));
+    }
+
+    if (m_index_col_count == 0)
+    {
+        cudf::numeric_scalar<int64_t> start(m_range_start);
+        m_range_index = cudf::sequence(m_num_rows, start);
+    }
+
+    // The host buffer must outlive the copies
+    stream.synchronize();
+
+    m_table->tbl = std::make_unique<cudf::table>(std::move(columns));
+    m_table_data = this->make_table_data();
+
+    spilled_bytes_gauge()->decrement(static_cast<double>(m_spilled->num_bytes));
+
+    m_spilled.reset();
+    m_is_spilled = false;
+}
+
+TableInfoData CppDataTable::get_table_data() const
+{
+    // Any changes to the structure of the table can only be made through python (via `MutableTableInfo`), so until
+    // the conversion has happened, the C++ view is authoritative
+    if (!m_has_py_object)
+    {
+        if (m_is_spilled)
+        {
+            // Concurrent readers wait for the first one to restore the table
+            std::lock_guard lock(m_spill_mutex);
+            this->restore();
+        }
+
+        return m_table_data;
+    }
+
+    pybind11::gil_scoped_acquire gil;
+
+    return CudfHelper::table_info_data_from_table(m_py_table);
+}
+}  // namespace morpheus
@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/objects/cuda_graph_cache.hpp"
+
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+
+#include <algorithm>    // for min_element
+#include <memory>       // for unique_ptr
+#include <type_traits>  // for remove_pointer_t
+#include <utility>      // for move
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** CudaGraphCache**************************************/
+CudaGraphCache::CudaGraphCache(std::size_t max_entries) : m_max_entries(max_entries) {}
+
+CudaGraphCache::~CudaGraphCache()
+{
+    for (auto& [key, entry] : m_entries)
+    {
+        cudaGraphExecDestroy(entry.exec);
+    }
+}
+
+void CudaGraphCache::launch(const std::string& key, rmm::cuda_stream_view stream, const enqueue_fn_t& enqueue)
+{
+    using graph_ptr_t = std::unique_ptr<std::remove_pointer_t<cudaGraph_t>, decltype(&cudaGraphDestroy)>;
+
+    MRC_CHECK_CUDA(cudaStreamBeginCapture(stream.value(), cudaStreamCaptureModeThreadLocal));
+
+    cudaGraph_t captured = nullptr;
+    try
+    {
+        enqueue(stream);
+    } catch (...)
+    {
+        // Leave the stream usable, the partially captured graph is discarded
+        cudaStreamEndCapture(stream.value(), &captured);
+        graph_ptr_t discarded{captured, &cudaGraphDestroy};
+        throw;
+    }
+
+    MRC_CHECK_CUDA(cudaStreamEndCapture(stream.value(), &captured));
+    graph_ptr_t graph{captured, &cudaGraphDestroy};
+
+    auto exec = take(key);
+    if (exec != nullptr)
+    {
+        // Updating fails when the topology differs from the graph the exec was instantiated from
+        cudaGraphExecUpdateResultInfo result_info;
+        if (cudaGraphExecUpdate(exec, graph.get(), &result_info) != cudaSuccess)
+        {
+            // Clear the error, it is not sticky
+            cudaGetLastError();
+            cudaGraphExecDestroy(exec);
+            exec = nullptr;
+        }
+    }
+
+    if (exec == nullptr)
+    {
+        MRC_CHECK_CUDA(cudaGraphInstantiate(&exec, graph.get(), 0));
+
+        std::lock_guard lock(m_mutex);
+        ++m_num_instantiations;
+    }
+
+    MRC_CHECK_CUDA(cudaGraphLaunch(exec, stream.value()));
+
+    put(key, exec);
+}
+
+std::size_t CudaGraphCache::size() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_entries.size();
+}
+
+std::size_t CudaGraphCache::num_instantiations() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_num_instantiations;
+}
+
+cudaGraphExec_t CudaGraphCache::take(const std::string& key)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto found = m_entries.find(key);
+    if (found == m_entries.end())
+    {
+        return nullptr;
+    }
+
+    // Taken out of the cache while in use, so concurrent launches never update the same exec
+    auto exec = found->second.exec;
+    m_entries.erase(found);
+
+    return exec;
+}
+
+void CudaGraphCache::put(const std::string& key, cudaGraphExec_t exec)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto [pos, inserted] = m_entries.try_emplace(key, Entry{exec, ++m_use_counter});
+    if (!inserted)
+    {
+        // A concurrent launch with the same key returned its exec first. Graph launches are stream ordered, destroying
+        // an exec which has been launched is safe.
+        cudaGraphExecDestroy(exec);
+        pos->second.last_used = m_use_counter;
+        return;
+    }
+
+    if (m_entries.size() > m_max_entries)
+    {
+        auto oldest = std::min_element(m_entries.begin(), m_entries.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second.last_used < rhs.second.last_used;
+        });
+
+        cudaGraphExecDestroy(oldest->second.exec);
+        m_entries.erase(oldest);
+    }
+}
+
+}  // namespace morpheus
@@ -19,17 +19,36 @@
 
 #include "morpheus/objects/table_info.hpp"
 #include "morpheus/objects/table_info_data.hpp"
+#include "morpheus/utilities/cudf_util.hpp"
 
+#include <cudf/io/types.hpp>  // for table_with_metadata, column_name_info
+#include <cudf/table/table.hpp>
+#include <cudf/utilities/default_stream.hpp>
 #include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
 #include <pybind11/gil.h>
+#include <pybind11/pybind11.h>  // IWYU pragma: keep
+#include <pybind11/pytypes.h>
 
+#include <cstddef>  // for size_t
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <shared_mutex>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace morpheus {
 
+IDataTable::~IDataTable()
+{
+    for (auto& [column_name, event] : m_column_events)
+    {
+        cudaEventDestroy(event);
+    }
+}
+
 TableInfo IDataTable::get_info() const
 {
     CHECK_EQ(PyGILState_Check(), 0)
@@ -38,6 +57,8 @@ TableInfo IDataTable::get_info() const
     // Get a shared lock while we get the table info (prevents mutation)
     std::shared_lock lock(m_mutex);
 
+    this->wait_for_event(cudf::get_default_stream());
+
     // Get the table info data
     auto table_info_data = this->get_table_data();
 
@@ -53,6 +74,10 @@ MutableTableInfo IDataTable::get_mutable_info() const
     // Get a unique lock while we get the table info (prevents mutation)
     std::unique_lock lock(m_mutex);
 
+    this->wait_for_event(cudf::get_default_stream());
+
+    this->on_mutable_access(false);
+
     // Get the table info data
     auto table_info_data = this->get_table_data();
 
@@ -60,4 +85,142 @@ MutableTableInfo IDataTable::get_mutable_info() const
     return {this->shared_from_this(), std::move(lock), std::move(table_info_data)};
 }
 
+bool IDataTable::has_sliceable_index() const
+{
+    pybind11::gil_scoped_acquire gil;
+    auto df    = this->get_py_object();
+    auto index = df.attr("index");
+
+    auto is_unique               = index.attr("is_unique").cast<bool>();
+    auto is_monotonic_increasing = index.attr("is_monotonic_increasing").cast<bool>();
+    auto is_monotonic_decreasing = index.attr("is_monotonic_decreasing").cast<bool>();
+
+    // Must be either increasing or decreasing with unique values to slice
+    return is_unique && (is_monotonic_increasing || is_monotonic_decreasing);
+}
+
+void IDataTable::on_mutable_access(bool released) const {}
+
+TableInfoData IDataTable::replace_columns(const std::vector<std::string>& column_names,
+                                          std::vector<std::unique_ptr<cudf::column>>&& columns) const
+{
+    CHECK_EQ(column_names.size(), columns.size()) << "Each replaced column must have a name";
+
+    cudf::io::table_with_metadata table;
+    table.tbl = std::make_unique<cudf::table>(std::move(columns));
+    for (const auto& column_name : column_names)
+    {
+        table.metadata.schema_info.emplace_back(column_name);
+    }
+
+    pybind11::gil_scoped_acquire gil;
+    auto df = this->get_py_object();
+
+    // Share the index of the DataFrame so the assignment does not realign the rows
+    auto replacements          = CudfHelper::table_from_table_with_metadata(std::move(table), 0);
+    replacements.attr("index") = df.attr("index");
+
+    for (const auto& column_name : column_names)
+    {
+        df[pybind11::str(column_name)] = replacements[pybind11::str(column_name)];
+    }
+
+    return CudfHelper::table_info_data_from_table(df);
+}
+
+TableInfoData IDataTable::reset_index(const std::string& column_prefix) const
+{
+    using namespace pybind11::literals;
+
+    pybind11::gil_scoped_acquire gil;
+    auto df       = this->get_py_object();
+    auto df_index = df.attr("index");
+
+    auto column_name = column_prefix;
+    auto index_name  = df_index.attr("name");
+    if (!index_name.is_none())
+    {
+        column_name += index_name.cast<std::string>();
+    }
+
+    df_index.attr("name") = pybind11::str(column_name);
+    df.attr("reset_index")("inplace"_a = true);
+
+    return CudfHelper::table_info_data_from_table(df);
+}
+
+void IDataTable::record_event(const std::vector<std::string>& column_names, rmm::cuda_stream_view stream) const
+{
+    std::lock_guard lock(m_event_mutex);
+
+    for (const auto& column_name : column_names)
+    {
+        auto& event = m_column_events[column_name];
+        if (event == nullptr)
+        {
+            MRC_CHECK_CUDA(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+        }
+
+        MRC_CHECK_CUDA(cudaEventRecord(event, stream.value()));
+    }
+}
+
+void IDataTable::wait_for_event(const std::vector<std::string>& column_names, rmm::cuda_stream_view stream) const
+{
+    std::lock_guard lock(m_event_mutex);
+
+    for (const auto& column_name : column_names)
+    {
+        auto found = m_column_events.find(column_name);
+        if (found != m_column_events.end())
+        {
+            MRC_CHECK_CUDA(cudaStreamWaitEvent(stream.value(), found->second, 0));
+        }
+    }
+}
+
+void IDataTable::wait_for_event(rmm::cuda_stream_view stream) const
+{
+    std::lock_guard lock(m_event_mutex);
+
+    for (const auto& [column_name, event] : m_column_events)
+    {
+        MRC_CHECK_CUDA(cudaStreamWaitEvent(stream.value(), event, 0));
+    }
+}
+
+void IDataTable::synchronize_event() const
+{
+    std::lock_guard lock(m_event_mutex);
+
+    for (const auto& [column_name, event] : m_column_events)
+    {
+        MRC_CHECK_CUDA(cudaEventSynchronize(event));
+    }
+}
+
+std::size_t IDataTable::spill() const
+{
+    // Never waits on the viewers of the table, the caller is trying to free memory rather than to access the data
+    std::unique_lock lock(m_mutex, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        return 0;
+    }
+
+    this->synchronize_event();
+
+    return this->spill_to_host();
+}
+
+bool IDataTable::is_spilled() const
+{
+    return false;
+}
+
+std::size_t IDataTable::spill_to_host() const
+{
+    return 0;
+}
+
 }  // namespace morpheus
@@ -0,0 +1,529 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/objects/dense_model_store.hpp"
+
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <cuda_runtime.h>  // for cudaMemcpyAsync, cudaMemcpyDeviceToDevice, cudaMemcpyHostToDevice
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <rmm/device_uvector.hpp>
+
+#include <algorithm>  // for max
+#include <exception>
+#include <numeric>    // for iota
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <utility>    // for move
+
+namespace morpheus {
+
+// Component-private classes.
+// ************ DenseModelStore__Architecture ****************//
+struct DenseModelStore::Architecture
+{
+    struct Layer
+    {
+        TensorIndex input_size;
+        TensorIndex output_size;
+        DenseActivation activation;
+
+        // One slot of `input_size` by `output_size` transposed weights, and `output_size` biases per model
+        std::unique_ptr<rmm::device_buffer> weights;
+        std::unique_ptr<rmm::device_buffer> biases;
+    };
+
+    std::vector<Layer> layers;
+    int32_t capacity{0};
+    std::vector<int32_t> free_slots;
+
+    TensorIndex input_size() const
+    {
+        return layers.front().input_size;
+    }
+
+    TensorIndex output_size() const
+    {
+        return layers.back().output_size;
+    }
+
+    // Returns a free slot, doubling the capacity of the layers when all of them are taken
+    int32_t acquire_slot(rmm::cuda_stream_view stream)
+    {
+        if (free_slots.empty())
+        {
+            const auto new_capacity = std::max(2 * capacity, 8);
+
+            for (auto& layer : layers)
+            {
+                const auto weight_bytes = layer.input_size * layer.output_size * sizeof(float);
+                const auto bias_bytes   = layer.output_size * sizeof(float);
+
+                auto weights = std::make_unique<rmm::device_buffer>(new_capacity * weight_bytes, stream);
+                auto biases  = std::make_unique<rmm::device_buffer>(new_capacity * bias_bytes, stream);
+
+                if (capacity > 0)
+                {
+                    MRC_CHECK_CUDA(cudaMemcpyAsync(weights->data(),
+                                                   layer.weights->data(),
+                                                   capacity * weight_bytes,
+                                                   cudaMemcpyDeviceToDevice,
+                                                   stream.value()));
+                    MRC_CHECK_CUDA(cudaMemcpyAsync(biases->data(),
+                                                   layer.biases->data(),
+                                                   capacity * bias_bytes,
+                                                   cudaMemcpyDeviceToDevice,
+                                                   stream.value()));
+                }
+
+                layer.weights = std::move(weights);
+                layer.biases  = std::move(biases);
+            }
+
+            for (int32_t slot = new_capacity - 1; slot >= capacity; --slot)
+            {
+                free_slots.push_back(slot);
+            }
+
+            capacity = new_capacity;
+        }
+
+        const auto slot = free_slots.back();
+        free_slots.pop_back();
+
+        return slot;
+    }
+};
+
+// ************ DenseModelStore__Model ***********************//
+struct DenseModelStore::Model
+{
+    std::string name;
+
+    // Only set while the model is resident
+    Architecture* architecture{nullptr};
+    int32_t slot{-1};
+    std::list<int32_t>::iterator lru_position;
+
+    // Only kept when there is no loader to reload the model once evicted
+    std::vector<DenseLayer> host_layers;
+};
+
+namespace {
+// Returns the key of the architecture of `layers`, validating them
+std::string architecture_key(const std::vector<DenseLayer>& layers)
+{
+    if (layers.empty())
+    {
+        throw std::invalid_argument("A model requires at least one layer");
+    }
+
+    std::string key;
+
+    for (std::size_t i = 0; i < layers.size(); ++i)
+    {
+        const auto& layer = layers[i];
+
+        if (layer.input_size <= 0 || layer.output_size <= 0)
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("Layer " << i << " must have a positive size"));
+        }
+
+        if (i > 0 && layer.input_size != layers[i - 1].output_size)
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("The input size of layer "
+                                                            << i << " does not match the output size of layer "
+                                                            << i - 1));
+        }
+
+        if (layer.weights.size() != static_cast<std::size_t>(layer.input_size * layer.output_size) ||
+            layer.biases.size() != static_cast<std::size_t>(layer.output_size))
+        {
+            throw std::invalid_argument(
+                MORPHEUS_CONCAT_STR("The weights and biases of layer " << i << " do not match its size"));
+        }
+
+        key += MORPHEUS_CONCAT_STR(layer.input_size << "x" << layer.output_size << ":"
+                                                    << static_cast<int32_t>(layer.activation) << ";");
+    }
+
+    return key;
+}
+}  // namespace
+
+// Component public implementations
+// ************ DenseModelStore ******************************//
+DenseModelStore::DenseModelStore(std::size_t max_models, loader_fn_t loader, std::string fallback_model_name) :
+  m_max_models(max_models),
+  m_loader(std::move(loader)),
+  m_fallback_model_name(std::move(fallback_model_name))
+{
+    auto& registry = MetricsRegistry::get_instance();
+
+    m_resident_gauge = registry.get_gauge("morpheus_dense_model_store_resident_models",
+                                          "Number of models resident on the device in the dense model store");
+    m_loads          = registry.get_counter("morpheus_dense_model_store_loads_total",
+                                   "Number of models copied to the device by the dense model store");
+}
+
+DenseModelStore::~DenseModelStore() = default;
+
+int32_t DenseModelStore::model_index(const std::string& model_name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto [found, inserted] = m_model_indices.try_emplace(model_name, static_cast<int32_t>(m_models.size()));
+    if (inserted)
+    {
+        m_models.emplace_back().name = model_name;
+    }
+
+    return found->second;
+}
+
+void DenseModelStore::set_model(const std::string& model_name, std::vector<DenseLayer> layers)
+{
+    // Validates the layers before taking the lock
+    architecture_key(layers);
+
+    const auto index = this->model_index(model_name);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    this->upload(index, layers, rmm::cuda_stream_per_thread);
+    m_resident_gauge->set(static_cast<double>(m_lru.size()));
+
+    if (!m_loader)
+    {
+        m_models[index].host_layers = std::move(layers);
+    }
+}
+
+bool DenseModelStore::make_resident(int32_t index, rmm::cuda_stream_view stream)
+{
+    auto& model = m_models[index];
+
+    if (model.slot >= 0)
+    {
+        m_lru.splice(m_lru.begin(), m_lru, model.lru_position);
+        return true;
+    }
+
+    if (!model.host_layers.empty())
+    {
+        this->upload(index, model.host_layers, stream);
+        m_loads->increment();
+        return true;
+    }
+
+    if (!m_loader)
+    {
+        return false;
+    }
+
+    std::vector<DenseLayer> layers;
+
+    try
+    {
+        layers = m_loader(model.name);
+    } catch (const std::exception& e)
+    {
+        LOG(WARNING) << "Error loading model '" << model.name << "': " << e.what();
+        return false;
+    }
+
+    if (layers.empty())
+    {
+        return false;
+    }
+
+    this->upload(index, layers, stream);
+    m_loads->increment();
+
+    return true;
+}
+
+void DenseModelStore::upload(int32_t index, const std::vector<DenseLayer>& layers, rmm::cuda_stream_view stream)
+{
+    const auto key = architecture_key(layers);
+    auto& model    = m_models[index];
+
+    auto& architecture = m_architectures[key];
+    if (architecture == nullptr)
+    {
+        architecture = std::make_unique<Architecture>();
+        for (const auto& layer : layers)
+        {
+            architecture->layers.push_back({layer.input_size, layer.output_size, layer.activation, nullptr, nullptr});
+        }
+    }
+
+    // A replaced model may have changed architecture
+    if (model.slot >= 0 && model.architecture != architecture.get())
+    {
+        this->evict(index);
+    }
+
+    if (model.slot < 0)
+    {
+        model.architecture = architecture.get();
+        model.slot         = architecture->acquire_slot(stream);
+
+        m_lru.push_front(index);
+        model.lru_position = m_lru.begin();
+    }
+    else
+    {
+        m_lru.splice(m_lru.begin(), m_lru, model.lru_position);
+    }
+
+    // The weights are stored transposed, such that the outputs of a row read consecutive weights
+    std::vector<std::vector<float>> transposed(layers.size());
+
+    for (std::size_t i = 0; i < layers.size(); ++i)
+    {
+        const auto& layer        = layers[i];
+        const auto& arch_layer   = architecture->layers[i];
+        const auto num_weights   = static_cast<std::size_t>(layer.input_size * layer.output_size);
+        const auto weight_offset = model.slot * num_weights * sizeof(float);
+        const auto bias_offset   = model.slot * layer.output_size * sizeof(float);
+
+        transposed[i].resize(num_weights);
+        for (TensorIndex out = 0; out < layer.output_size; ++out)
+        {
+            for (TensorIndex in = 0; in < layer.input_size; ++in)
+            {
+                transposed[i][in * layer.output_size + out] = layer.weights[out * layer.input_size + in];
+            }
+        }
+
+        MRC_CHECK_CUDA(cudaMemcpyAsync(static_cast<uint8_t*>(arch_layer.weights->data()) + weight_offset,
+                                       transposed[i].data(),
+                                       num_weights * sizeof(float),
+                                       cudaMemcpyHostToDevice,
+                                       stream.value()));
+        MRC_CHECK_CUDA(cudaMemcpyAsync(static_cast<uint8_t*>(arch_layer.biases->data()) + bias_offset,
+                                       layer.biases.data(),
+                                       layer.biases.size() * sizeof(float),
+                                       cudaMemcpyHostToDevice,
+                                       stream.value()));
+    }
+
+    // The host copies must outlive the transfers
+    stream.synchronize();
+}
+
+void DenseModelStore::evict(int32_t index)
+{
+    auto& model = m_models[index];
+
+    model.architecture->free_slots.push_back(model.slot);
+    m_lru.erase(model.lru_position);
+
+    model.architecture = nullptr;
+    model.slot         = -1;
+}
+
+std::shared_ptr<rmm::device_buffer> DenseModelStore::infer(const float* input,
+                                                           TensorIndex input_size,
+                                                           const std::vector<int32_t>& model_indices,
+                                                           rmm::cuda_stream_view stream,
+                                                           TensorIndex& output_size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto num_rows = static_cast<TensorIndex>(model_indices.size());
+
+    // Resolves each distinct model of the batch once, to itself or to the fallback model
+    std::unordered_map<int32_t, int32_t> resolved;
+    int32_t fallback_index = -1;
+
+    for (const auto index : model_indices)
+    {
+        if (resolved.contains(index))
+        {
+            continue;
+        }
+
+        if (index < 0 || index >= static_cast<int32_t>(m_models.size()))
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unknown model index " << index));
+        }
+
+        if (this->make_resident(index, stream))
+        {
+            resolved[index] = index;
+            continue;
+        }
+
+        if (m_fallback_model_name.empty())
+        {
+            throw std::runtime_error(MORPHEUS_CONCAT_STR("Could not find model '" << m_models[index].name << "'"));
+        }
+
+        if (fallback_index < 0)
+        {
+            auto found = m_model_indices.find(m_fallback_model_name);
+            if (found != m_model_indices.end() && this->make_resident(found->second, stream))
+            {
+                fallback_index = found->second;
+            }
+            else
+            {
+                throw std::runtime_error(MORPHEUS_CONCAT_STR("Could not find model '"
+                                                             << m_models[index].name << "' nor the fallback model '"
+                                                             << m_fallback_model_name << "'"));
+            }
+        }
+
+        DVLOG(10) << "Using the fallback model for '" << m_models[index].name << "'";
+        resolved[index] = fallback_index;
+    }
+
+    // Groups the rows by architecture, in order of first appearance
+    std::vector<Architecture*> architectures;
+    std::vector<std::vector<TensorIndex>> architecture_rows;
+    std::vector<std::vector<int32_t>> architecture_slots;
+
+    for (TensorIndex row = 0; row < num_rows; ++row)
+    {
+        const auto& model = m_models[resolved[model_indices[row]]];
+
+        auto found = std::find(architectures.begin(), architectures.end(), model.architecture);
+        if (found == architectures.end())
+        {
+            if (model.architecture->input_size() != input_size ||
+                (!architectures.empty() && model.architecture->output_size() != architectures.front()->output_size()))
+            {
+                throw std::invalid_argument("The models of a batch must share the same input and output sizes");
+            }
+
+            architectures.push_back(model.architecture);
+            architecture_rows.emplace_back();
+            architecture_slots.emplace_back();
+            found = architectures.end() - 1;
+        }
+
+        const auto position = found - architectures.begin();
+        architecture_rows[position].push_back(row);
+        architecture_slots[position].push_back(model.slot);
+    }
+
+    output_size = architectures.empty() ? 0 : architectures.front()->output_size();
+
+    auto output = std::make_shared<rmm::device_buffer>(num_rows * output_size * sizeof(float), stream);
+
+    for (std::size_t i = 0; i < architectures.size(); ++i)
+    {
+        const auto& architecture = *architectures[i];
+        const auto& rows         = architecture_rows[i];
+        const auto group_rows    = static_cast<TensorIndex>(rows.size());
+
+        // The rows of other architectures are skipped by gathering the rows of this one first
+        const bool is_whole_batch = architectures.size() == 1;
+
+        rmm::device_uvector<int32_t> slots(group_rows, stream);
+        MRC_CHECK_CUDA(cudaMemcpyAsync(slots.data(),
+                                       architecture_slots[i].data(),
+                                       group_rows * sizeof(int32_t),
+                                       cudaMemcpyHostToDevice,
+                                       stream.value()));
+
+        std::vector<TensorIndex> group_positions(group_rows);
+        std::iota(group_positions.begin(), group_positions.end(), 0);
+
+        rmm::device_buffer layer_input;
+        const float* layer_input_ptr = input;
+
+        if (!is_whole_batch)
+        {
+            layer_input = rmm::device_buffer(group_rows * input_size * sizeof(float), stream);
+            MatxUtil::copy_rows(
+                input, layer_input.data(), input_size * sizeof(float), rows, group_positions, stream);
+            layer_input_ptr = static_cast<const float*>(layer_input.data());
+        }
+
+        for (std::size_t l = 0; l < architecture.layers.size(); ++l)
+        {
+            const auto& layer        = architecture.layers[l];
+            const bool is_last_layer = l + 1 == architecture.layers.size();
+
+            rmm::device_buffer layer_output;
+            float* layer_output_ptr = nullptr;
+
+            if (is_last_layer && is_whole_batch)
+            {
+                layer_output_ptr = static_cast<float*>(output->data());
+            }
+            else
+            {
+                layer_output     = rmm::device_buffer(group_rows * layer.output_size * sizeof(float), stream);
+                layer_output_ptr = static_cast<float*>(layer_output.data());
+            }
+
+            MatxUtil::grouped_dense(layer_input_ptr,
+                                    group_rows,
+                                    layer.input_size,
+                                    layer.output_size,
+                                    static_cast<const float*>(layer.weights->data()),
+                                    static_cast<const float*>(layer.biases->data()),
+                                    slots.data(),
+                                    layer.activation,
+                                    layer_output_ptr,
+                                    stream);
+
+            if (is_last_layer && !is_whole_batch)
+            {
+                MatxUtil::copy_rows(
+                    layer_output_ptr, output->data(), output_size * sizeof(float), group_positions, rows, stream);
+            }
+
+            // The output of this layer is the input of the next, released once the next one has been enqueued
+            layer_input     = std::move(layer_output);
+            layer_input_ptr = layer_output_ptr;
+        }
+    }
+
+    stream.synchronize();
+
+    // Every model of the batch may be evicted now that it has completed
+    while (m_lru.size() > m_max_models)
+    {
+        this->evict(m_lru.back());
+    }
+
+    m_resident_gauge->set(static_cast<double>(m_lru.size()));
+
+    return output;
+}
+
+std::size_t DenseModelStore::num_resident() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lru.size();
+}
+
+bool DenseModelStore::is_resident(const std::string& model_name) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto found = m_model_indices.find(model_name);
+    return found != m_model_indices.end() && m_models[found->second].slot >= 0;
+}
+}  // namespace morpheus
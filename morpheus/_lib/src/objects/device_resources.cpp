@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/objects/device_resources.hpp"
+
+#include "morpheus/utilities/cuda_util.hpp"  // for CudaUtil
+
+#include <cuda_runtime.h>  // for cudaMemGetInfo, cudaStreamCreateWithFlags
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <rmm/mr/device/arena_memory_resource.hpp>
+#include <rmm/mr/device/cuda_async_memory_resource.hpp>
+#include <rmm/mr/device/cuda_memory_resource.hpp>
+#include <rmm/mr/device/device_memory_resource.hpp>
+#include <rmm/mr/device/limiting_resource_adaptor.hpp>
+#include <rmm/mr/device/logging_resource_adaptor.hpp>
+#include <rmm/mr/device/per_device_resource.hpp>  // for set_current_device_resource
+#include <rmm/mr/device/pool_memory_resource.hpp>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for logic_error
+#include <string>     // for to_string
+#include <utility>    // for move
+#include <vector>
+
+namespace morpheus {
+namespace {
+
+using upstream_t = rmm::mr::device_memory_resource;
+
+std::mutex& install_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Layers of the stack of each device, bottom first. Never destroyed, buffers allocated from them may still be released
+// during interpreter shutdown
+std::map<int, std::vector<std::unique_ptr<upstream_t>>>& installed_stacks()
+{
+    static auto* stacks = new std::map<int, std::vector<std::unique_ptr<upstream_t>>>();
+    return *stacks;
+}
+
+std::atomic<bool>& use_dedicated_streams()
+{
+    static std::atomic<bool> dedicated{false};
+    return dedicated;
+}
+
+// Half of the free memory of the current device, aligned down to the 256 bytes rmm aligns its allocations to
+std::size_t half_of_free_memory()
+{
+    std::size_t free_bytes  = 0;
+    std::size_t total_bytes = 0;
+    MRC_CHECK_CUDA(cudaMemGetInfo(&free_bytes, &total_bytes));
+
+    return (free_bytes / 2) & ~std::size_t{255};
+}
+
+/**
+ * @brief Non-blocking streams of a thread, one per device, destroyed when the thread exits
+ */
+class ThreadStreams
+{
+  public:
+    ThreadStreams()                                = default;
+    ThreadStreams(const ThreadStreams&)            = delete;
+    ThreadStreams& operator=(const ThreadStreams&) = delete;
+
+    ~ThreadStreams()
+    {
+        for (auto& [device_id, stream] : m_streams)
+        {
+            // Pending work still completes, the resources of the stream are released once it has
+            cudaStreamDestroy(stream);
+        }
+    }
+
+    rmm::cuda_stream_view get(int device_id)
+    {
+        auto& stream = m_streams[device_id];
+        if (stream == nullptr)
+        {
+            MRC_CHECK_CUDA(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+        }
+
+        return stream;
+    }
+
+  private:
+    std::map<int, cudaStream_t> m_streams;
+};
+
+}  // namespace
+
+// Component public implementations
+// ************ DeviceResources ************************* //
+void DeviceResources::install(const MemoryConfig& config)
+{
+    std::lock_guard lock(install_mutex());
+
+    const auto device_id = CudaUtil::current_device();
+    auto& stacks         = installed_stacks();
+
+    if (stacks.contains(device_id))
+    {
+        throw std::logic_error("Device resources are already installed on device " + std::to_string(device_id));
+    }
+
+    std::vector<std::unique_ptr<upstream_t>> layers;
+
+    const auto initial_pool_size = config.initial_pool_size > 0 ? config.initial_pool_size : half_of_free_memory();
+
+    switch (config.resource_type)
+    {
+    case DeviceResourceType::CUDA:
+        layers.push_back(std::make_unique<rmm::mr::cuda_memory_resource>());
+        break;
+    case DeviceResourceType::POOL: {
+        const auto maximum_pool_size = config.maximum_pool_size > 0 ? std::optional(config.maximum_pool_size)
+                                                                    : std::optional<std::size_t>();
+
+        layers.push_back(std::make_unique<rmm::mr::cuda_memory_resource>());
+        layers.push_back(std::make_unique<rmm::mr::pool_memory_resource<upstream_t>>(
+            layers.back().get(), initial_pool_size, maximum_pool_size));
+        break;
+    }
+    case DeviceResourceType::ASYNC:
+        layers.push_back(std::make_unique<rmm::mr::cuda_async_memory_resource>(initial_pool_size));
+        break;
+    }
+
+    if (config.use_arena)
+    {
+        const auto arena_size = config.arena_size > 0 ? std::optional(config.arena_size) : std::optional<std::size_t>();
+        layers.push_back(std::make_unique<rmm::mr::arena_memory_resource<upstream_t>>(layers.back().get(), arena_size));
+    }
+
+    if (config.limit > 0)
+    {
+        layers.push_back(
+            std::make_unique<rmm::mr::limiting_resource_adaptor<upstream_t>>(layers.back().get(), config.limit));
+    }
+
+    if (!config.log_file.empty())
+    {
+        layers.push_back(
+            std::make_unique<rmm::mr::logging_resource_adaptor<upstream_t>>(layers.back().get(), config.log_file));
+    }
+
+    rmm::mr::set_current_device_resource(layers.back().get());
+    stacks.emplace(device_id, std::move(layers));
+
+    use_dedicated_streams().store(config.dedicated_streams);
+
+    LOG(INFO) << "Installed the device resources of device " << device_id << " with " << stacks[device_id].size()
+              << " layers" << (config.dedicated_streams ? " and dedicated streams" : "");
+}
+
+bool DeviceResources::is_installed()
+{
+    std::lock_guard lock(install_mutex());
+
+    return installed_stacks().contains(CudaUtil::current_device());
+}
+
+rmm::cuda_stream_view DeviceResources::stream()
+{
+    if (!use_dedicated_streams().load(std::memory_order_relaxed))
+    {
+        return rmm::cuda_stream_per_thread;
+    }
+
+    thread_local ThreadStreams streams;
+
+    return streams.get(CudaUtil::current_device());
+}
+
+}  // namespace morpheus
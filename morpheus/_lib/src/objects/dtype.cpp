@@ -46,7 +46,7 @@ const std::map<char, std::map<size_t, morpheus::TypeId>> StrToTypeId = {
          {8, morpheus::TypeId::UINT64},
      }},
 
-    {'f', {{4, morpheus::TypeId::FLOAT32}, {8, morpheus::TypeId::FLOAT64}}},
+    {'f', {{2, morpheus::TypeId::FLOAT16}, {4, morpheus::TypeId::FLOAT32}, {8, morpheus::TypeId::FLOAT64}}},
 
     {'O', {{1, morpheus::TypeId::STRING}}}};
 }  // namespace
@@ -76,6 +76,8 @@ size_t DType::item_size() const
         return 1;
     case TypeId::INT16:
     case TypeId::UINT16:
+    case TypeId::FLOAT16:
+    case TypeId::BFLOAT16:
         return 2;
     case TypeId::INT32:
     case TypeId::UINT32:
@@ -100,6 +102,12 @@ std::string DType::name() const
 
 std::string DType::type_str() const
 {
+    // numpy has no bfloat16, use the name registered by the ml_dtypes package
+    if (m_type_id == TypeId::BFLOAT16)
+    {
+        return "bfloat16";
+    }
+
     if (m_type_id != TypeId::BOOL8 && m_type_id != TypeId::STRING)
     {
         return MORPHEUS_CONCAT_STR("<" << this->type_char() << this->item_size());
@@ -139,6 +147,10 @@ cudf::type_id DType::cudf_type_id() const
         return cudf::type_id::BOOL8;
     case TypeId::STRING:
         return cudf::type_id::STRING;
+    case TypeId::FLOAT16:
+    case TypeId::BFLOAT16:
+        throw std::runtime_error(
+            MORPHEUS_CONCAT_STR("Type " << this->name() << " has no cudf representation, cast it to float32"));
     case TypeId::EMPTY:
     case TypeId::NUM_TYPE_IDS:
     default:
@@ -168,6 +180,10 @@ std::string DType::triton_str() const
         return "UINT32";
     case TypeId::UINT64:
         return "UINT64";
+    case TypeId::FLOAT16:
+        return "FP16";
+    case TypeId::BFLOAT16:
+        return "BF16";
     case TypeId::FLOAT32:
         return "FP32";
     case TypeId::FLOAT64:
@@ -222,6 +238,11 @@ DType DType::from_numpy(const std::string& numpy_str)
 {
     CHECK(!numpy_str.empty()) << "Cannot create DataType from empty string";
 
+    if (numpy_str == "bfloat16")
+    {
+        return {TypeId::BFLOAT16};
+    }
+
     char type_char    = numpy_str[0];
     size_t size_start = 1;
 
@@ -285,6 +306,14 @@ DType DType::from_triton(const std::string& type_str)
     {
         return {TypeId::UINT64};
     }
+    else if (type_str == "FP16")
+    {
+        return {TypeId::FLOAT16};
+    }
+    else if (type_str == "BF16")
+    {
+        return {TypeId::BFLOAT16};
+    }
     else if (type_str == "FP32")
     {
         return {TypeId::FLOAT32};
@@ -319,6 +348,8 @@ char DType::type_char() const
         return 'u';
     case TypeId::BOOL8:
         return '?';
+    case TypeId::FLOAT16:
+    case TypeId::BFLOAT16:
     case TypeId::FLOAT32:
     case TypeId::FLOAT64:
         return 'f';
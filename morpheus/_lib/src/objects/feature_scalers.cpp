@@ -0,0 +1,430 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/objects/feature_scalers.hpp"
+
+#include "morpheus/objects/dtype.hpp"          // for DType
+#include "morpheus/objects/tensor.hpp"         // for Tensor
+#include "morpheus/utilities/matx_util.hpp"    // for MatxUtil, ScaledFeature, FeatureScaling
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <cuda_runtime.h>  // for cudaMemcpyAsync, cudaGetDevice
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>  // for make_numeric_column, make_strings_column
+#include <cudf/search.hpp>                   // for lower_bound, contains
+#include <cudf/table/table_view.hpp>
+#include <cudf/transform.hpp>  // for bools_to_mask
+#include <cudf/types.hpp>
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
+#include <mrc/cuda/common.hpp>                // for MRC_CHECK_CUDA
+#include <mrc/cuda/sync.hpp>                  // for enqueue_stream_sync_event
+#include <nlohmann/json.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <algorithm>  // for sort
+#include <cstdint>
+#include <fstream>
+#include <numeric>    // for iota
+#include <stdexcept>  // for invalid_argument
+#include <tuple>      // for tie
+#include <utility>    // for move, pair
+
+namespace morpheus {
+namespace {
+
+int current_device_id()
+{
+    int device_id = 0;
+    MRC_CHECK_CUDA(cudaGetDevice(&device_id));
+    return device_id;
+}
+
+// Orders `waiting` after the work enqueued on `signalling` so far, without blocking the host
+void stream_wait(rmm::cuda_stream_view waiting, rmm::cuda_stream_view signalling)
+{
+    if (waiting.value() == signalling.value())
+    {
+        return;
+    }
+
+    cudaEvent_t event;
+    MRC_CHECK_CUDA(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    MRC_CHECK_CUDA(cudaEventRecord(event, signalling.value()));
+    MRC_CHECK_CUDA(cudaStreamWaitEvent(waiting.value(), event, 0));
+    MRC_CHECK_CUDA(cudaEventDestroy(event));
+}
+
+// Copies `strings` to a strings column on the device, enqueued on `stream`
+std::unique_ptr<cudf::column> make_strings_column(const std::vector<std::string>& strings, rmm::cuda_stream_view stream)
+{
+    std::vector<cudf::size_type> offsets{0};
+    offsets.reserve(strings.size() + 1);
+
+    std::string chars;
+    for (const auto& str : strings)
+    {
+        chars.append(str);
+        offsets.push_back(static_cast<cudf::size_type>(chars.size()));
+    }
+
+    auto offsets_column = cudf::make_numeric_column(
+        cudf::data_type{cudf::type_id::INT32}, offsets.size(), cudf::mask_state::UNALLOCATED, stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(offsets_column->mutable_view().data<cudf::size_type>(),
+                                   offsets.data(),
+                                   offsets.size() * sizeof(cudf::size_type),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    auto chars_column = cudf::make_numeric_column(
+        cudf::data_type{cudf::type_id::INT8}, chars.size(), cudf::mask_state::UNALLOCATED, stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(chars_column->mutable_view().data<int8_t>(),
+                                   chars.data(),
+                                   chars.size(),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    auto column = cudf::make_strings_column(static_cast<cudf::size_type>(strings.size()),
+                                            std::move(offsets_column),
+                                            std::move(chars_column),
+                                            0,
+                                            rmm::device_buffer{});
+
+    // The host strings are only guaranteed to stay alive until we return
+    stream.synchronize();
+
+    return column;
+}
+
+// Returns the shift and scale of a standard or min-max scaler. Constant features are shifted without being scaled
+std::pair<float, float> parse_params(const nlohmann::json& params, FeatureScaling scaling)
+{
+    if (scaling == FeatureScaling::STANDARD)
+    {
+        const auto mean = params.at("mean").get<float>();
+        const auto std  = params.at("std").get<float>();
+
+        return {mean, std > 0.0f ? 1.0f / std : 1.0f};
+    }
+
+    const auto min = params.at("min").get<float>();
+    const auto max = params.at("max").get<float>();
+
+    return {min, max > min ? 1.0f / (max - min) : 1.0f};
+}
+
+}  // namespace
+
+// Component-private classes.
+// ************ FeatureScalers__Feature **********************//
+struct FeatureScalers::Feature
+{
+    FeatureScaling scaling{FeatureScaling::NONE};
+    TensorIndex first_input{0};
+    TensorIndex num_inputs{1};
+
+    // Vocabulary of a one-hot feature sorted for the search on the device, and the input of each of its entries
+    std::vector<std::string> sorted_vocabulary;
+    std::vector<int32_t> slots;
+};
+
+// ************ FeatureScalers__DeviceCopy *******************//
+struct FeatureScalers::DeviceCopy
+{
+    std::unique_ptr<rmm::device_buffer> params;
+
+    // One entry per feature, null for the features which are not one-hot
+    std::vector<std::unique_ptr<cudf::column>> vocabularies;
+    std::vector<std::unique_ptr<rmm::device_buffer>> slots;
+};
+
+// Component public implementations
+// ************ FeatureScalers *******************************//
+FeatureScalers::FeatureScalers(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open())
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to open feature scalers file: " << filename));
+    }
+
+    try
+    {
+        auto config = nlohmann::json::parse(file);
+
+        std::unordered_map<std::string, std::size_t> feature_indices;
+
+        for (const auto& entry : config.at("features"))
+        {
+            auto column = entry.at("column").get<std::string>();
+            auto scaler = entry.value("scaler", std::string("none"));
+
+            Feature feature;
+            feature.first_input = m_num_inputs;
+
+            std::pair<float, float> params{0.0f, 1.0f};
+
+            if (scaler == "standard" || scaler == "minmax")
+            {
+                feature.scaling = scaler == "standard" ? FeatureScaling::STANDARD : FeatureScaling::MINMAX;
+                params          = parse_params(entry, feature.scaling);
+            }
+            else if (scaler == "onehot")
+            {
+                auto vocabulary = entry.at("vocabulary").get<std::vector<std::string>>();
+                if (vocabulary.empty())
+                {
+                    throw std::invalid_argument(
+                        MORPHEUS_CONCAT_STR("Empty vocabulary of feature '" << column << "' in " << filename));
+                }
+
+                std::vector<int32_t> order(vocabulary.size());
+                std::iota(order.begin(), order.end(), 0);
+                std::sort(order.begin(), order.end(), [&vocabulary](int32_t lhs, int32_t rhs) {
+                    return vocabulary[lhs] < vocabulary[rhs];
+                });
+
+                for (auto slot : order)
+                {
+                    if (!feature.sorted_vocabulary.empty() && feature.sorted_vocabulary.back() == vocabulary[slot])
+                    {
+                        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Duplicate entry '" << vocabulary[slot]
+                                                                                            << "' in the vocabulary of "
+                                                                                            << "feature '" << column
+                                                                                            << "' in " << filename));
+                    }
+
+                    feature.sorted_vocabulary.push_back(std::move(vocabulary[slot]));
+                    feature.slots.push_back(slot);
+                }
+
+                feature.scaling    = FeatureScaling::ONEHOT;
+                feature.num_inputs = static_cast<TensorIndex>(feature.slots.size());
+            }
+            else if (scaler != "none")
+            {
+                throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unknown scaler '" << scaler << "' of feature '"
+                                                                                    << column << "' in " << filename));
+            }
+
+            if (!feature_indices.emplace(column, m_features.size()).second)
+            {
+                throw std::invalid_argument(
+                    MORPHEUS_CONCAT_STR("Duplicate feature '" << column << "' in " << filename));
+            }
+
+            m_num_inputs += feature.num_inputs;
+            m_params.push_back(params.first);
+            m_params.push_back(params.second);
+            m_feature_columns.push_back(std::move(column));
+            m_features.push_back(std::move(feature));
+        }
+
+        if (m_features.empty())
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("No features in " << filename));
+        }
+
+        // Each user starts from a copy of the global parameters
+        const std::vector<float> global_params(m_params);
+
+        for (const auto& [user_id, overrides] : config.value("users", nlohmann::json::object()).items())
+        {
+            const auto first_param = m_params.size();
+            m_params.insert(m_params.end(), global_params.begin(), global_params.end());
+
+            for (const auto& [column, params] : overrides.items())
+            {
+                auto found = feature_indices.find(column);
+                if (found == feature_indices.end())
+                {
+                    throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unknown feature '" << column << "' of user '"
+                                                                                        << user_id << "' in "
+                                                                                        << filename));
+                }
+
+                const auto scaling = m_features[found->second].scaling;
+                if (scaling != FeatureScaling::STANDARD && scaling != FeatureScaling::MINMAX)
+                {
+                    throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+                        "Only the standard and min-max scalers may be overridden per user, feature '"
+                        << column << "' of user '" << user_id << "' in " << filename));
+                }
+
+                std::tie(m_params[first_param + found->second * 2], m_params[first_param + found->second * 2 + 1]) =
+                    parse_params(params, scaling);
+            }
+
+            m_user_params[user_id] = first_param;
+        }
+    } catch (const nlohmann::json::exception& e)
+    {
+        throw std::invalid_argument(
+            MORPHEUS_CONCAT_STR("Invalid feature scalers file " << filename << ". Error: " << e.what()));
+    }
+}
+
+FeatureScalers::~FeatureScalers() = default;
+
+const std::vector<std::string>& FeatureScalers::feature_columns() const
+{
+    return m_feature_columns;
+}
+
+TensorIndex FeatureScalers::num_inputs() const
+{
+    return m_num_inputs;
+}
+
+bool FeatureScalers::has_user(const std::string& user_id) const
+{
+    return m_user_params.find(user_id) != m_user_params.end();
+}
+
+const FeatureScalers::DeviceCopy& FeatureScalers::device_copy(rmm::cuda_stream_view stream) const
+{
+    std::lock_guard lock(m_mutex);
+
+    auto& copy = m_device_copies[current_device_id()];
+
+    if (!copy)
+    {
+        auto created    = std::make_unique<DeviceCopy>();
+        created->params =
+            std::make_unique<rmm::device_buffer>(m_params.data(), m_params.size() * sizeof(float), stream);
+
+        for (const auto& feature : m_features)
+        {
+            if (feature.scaling == FeatureScaling::ONEHOT)
+            {
+                created->vocabularies.push_back(make_strings_column(feature.sorted_vocabulary, stream));
+                created->slots.push_back(std::make_unique<rmm::device_buffer>(
+                    feature.slots.data(), feature.slots.size() * sizeof(int32_t), stream));
+            }
+            else
+            {
+                created->vocabularies.emplace_back();
+                created->slots.emplace_back();
+            }
+        }
+
+        // The host copies may be read until the stream completes
+        stream.synchronize();
+
+        copy = std::move(created);
+    }
+
+    return *copy;
+}
+
+std::pair<TensorObject, TensorObject> FeatureScalers::transform(const TableInfoBase& features,
+                                                                const std::string& user_id,
+                                                                TensorIndex seq_id_offset,
+                                                                rmm::cuda_stream_view stream,
+                                                                rmm::mr::device_memory_resource* mr) const
+{
+    if (static_cast<std::size_t>(features.num_columns()) != m_features.size())
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Expected " << m_features.size() << " feature columns, got "
+                                                                    << features.num_columns()));
+    }
+
+    const auto& copy    = this->device_copy(stream);
+    const auto num_rows = features.num_rows();
+
+    std::size_t first_param = 0;
+    if (auto found = m_user_params.find(user_id); found != m_user_params.end())
+    {
+        first_param = found->second;
+    }
+
+    // The values of a one-hot feature are replaced by their position in the sorted vocabulary, null unless found in it
+    std::vector<std::unique_ptr<cudf::column>> positions;
+    std::vector<std::unique_ptr<rmm::device_buffer>> found_masks;
+
+    std::vector<ScaledFeature> scaled;
+    scaled.reserve(m_features.size());
+
+    for (std::size_t i = 0; i < m_features.size(); ++i)
+    {
+        const auto& feature = m_features[i];
+        auto column         = features.get_column(static_cast<cudf::size_type>(i));
+
+        ScaledFeature scaled_feature{{}, feature.scaling, feature.first_input, feature.num_inputs, nullptr};
+
+        if (feature.scaling == FeatureScaling::ONEHOT)
+        {
+            if (column.type().id() != cudf::type_id::STRING)
+            {
+                throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+                    "The one-hot feature '" << m_feature_columns[i] << "' must be a string column"));
+            }
+
+            const auto& vocabulary = copy.vocabularies[i]->view();
+
+            auto position = cudf::lower_bound(cudf::table_view({vocabulary}),
+                                              cudf::table_view({column}),
+                                              {cudf::order::ASCENDING},
+                                              {cudf::null_order::BEFORE});
+            auto found    = cudf::contains(vocabulary, column);
+            auto mask     = cudf::bools_to_mask(found->view()).first;
+
+            scaled_feature.column = {
+                position->view().head(), static_cast<const uint32_t*>(mask->data()), 0, TypeId::INT32};
+            scaled_feature.slots  = static_cast<const int32_t*>(copy.slots[i]->data());
+
+            positions.push_back(std::move(position));
+            found_masks.push_back(std::move(mask));
+        }
+        else
+        {
+            scaled_feature.column = {column.head(),
+                                     column.has_nulls() ? column.null_mask() : nullptr,
+                                     column.offset(),
+                                     DType::from_cudf(column.type().id()).type_id()};
+        }
+
+        scaled.push_back(scaled_feature);
+    }
+
+    // The vocabulary searches run on the default stream of cudf
+    if (!positions.empty())
+    {
+        stream_wait(stream, cudf::get_default_stream());
+    }
+
+    auto seq_id_dtype = DType::create<TensorIndex>();
+    auto inputs       = std::make_shared<rmm::device_buffer>(
+        static_cast<std::size_t>(num_rows) * m_num_inputs * sizeof(float), stream, mr);
+    auto seq_ids = std::make_shared<rmm::device_buffer>(num_rows * 3 * seq_id_dtype.item_size(), stream, mr);
+
+    MatxUtil::scale_feature_matrix(scaled,
+                                   static_cast<const float*>(copy.params->data()) + first_param,
+                                   num_rows,
+                                   m_num_inputs,
+                                   static_cast<float*>(inputs->data()),
+                                   static_cast<TensorIndex*>(seq_ids->data()),
+                                   seq_id_offset,
+                                   stream);
+
+    // The columns of the table and the vocabulary positions are only guaranteed to stay alive until we return
+    mrc::enqueue_stream_sync_event(stream).get();
+
+    return {Tensor::create(std::move(inputs), DType::create<float>(), {num_rows, m_num_inputs}, {}, 0),
+            Tensor::create(std::move(seq_ids), seq_id_dtype, {num_rows, 3}, {}, 0)};
+}
+
+}  // namespace morpheus
@@ -17,77 +17,231 @@
 
 #include "morpheus/objects/fiber_queue.hpp"
 
+#include "morpheus/messages/meta.hpp"  // IWYU pragma: keep
+
 #include <boost/fiber/channel_op_status.hpp>
 #include <glog/logging.h>  // for LOG, FATAL
 #include <pybind11/gil.h>  // for gil_scoped_release
 #include <pybind11/pybind11.h>
 
 #include <chrono>
-#include <functional>  // for ref, reference_wrapper
 #include <memory>
 #include <ostream>    // needed by GLOG
 #include <ratio>      // for ratio needed for std::chrono::duration
 #include <stdexcept>  // for invalid_argument, runtime_error
 #include <utility>
+#include <vector>
 
-namespace morpheus {
-/****** Component public implementations *******************/
-/****** FiberQueue****************************************/
-FiberQueue::FiberQueue(size_t max_size) : m_queue(max_size) {}
+namespace {
+using clock_type_t = std::chrono::steady_clock;
+
+clock_type_t::time_point get_deadline(float timeout)
+{
+    return clock_type_t::now() +
+           std::chrono::duration_cast<clock_type_t::duration>(std::chrono::duration<float>(timeout));
+}
 
-boost::fibers::channel_op_status FiberQueue::put(pybind11::object&& item, bool block, float timeout)
+// Python exception classes are looked up once, while holding the GIL, and intentionally leaked to avoid releasing them
+// after the interpreter has been finalized. At worst, two threads both look up a class when the import releases the GIL.
+PyObject* get_exception_class(PyObject*& cache, const char* module_name, const char* class_name)
 {
-    if (!block)
+    if (cache == nullptr)
     {
-        return m_queue.try_push(std::move(item));
+        cache = pybind11::module_::import(module_name).attr(class_name).release().ptr();
     }
-    else if (timeout > 0.0)
+
+    return cache;
+}
+
+[[noreturn]] void raise_queue_error(boost::fibers::channel_op_status status, bool is_put)
+{
+    static PyObject* full_class   = nullptr;
+    static PyObject* empty_class  = nullptr;
+    static PyObject* closed_class = nullptr;
+
+    switch (status)
     {
-        return m_queue.push_wait_for(
-            std::move(item), std::chrono::duration_cast<std::chrono::seconds>(std::chrono::duration<float>(timeout)));
+    case boost::fibers::channel_op_status::empty:
+    case boost::fibers::channel_op_status::full:
+    case boost::fibers::channel_op_status::timeout: {
+        // Raise queue.Full or queue.Empty
+        PyErr_SetNone(is_put ? get_exception_class(full_class, "queue", "Full")
+                             : get_exception_class(empty_class, "queue", "Empty"));
+        throw pybind11::error_already_set();
     }
-    else
-    {
-        // Blocking no timeout
-        return m_queue.push(std::move(item));
+    case boost::fibers::channel_op_status::closed: {
+        PyErr_SetNone(get_exception_class(closed_class, "morpheus.utils.producer_consumer_queue", "Closed"));
+        throw pybind11::error_already_set();
+    }
+    default:
+        throw std::runtime_error("Unknown channel status");
     }
 }
+}  // namespace
 
-boost::fibers::channel_op_status FiberQueue::get(pybind11::object& item, bool block, float timeout)
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** FiberQueue****************************************/
+template <typename ItemT>
+BasicFiberQueue<ItemT>::BasicFiberQueue(size_t max_size, bool lock_free)
 {
-    if (!block)
+    if (lock_free)
     {
-        return m_queue.try_pop(std::ref(item));
+        m_ring = std::make_unique<MpmcRingBuffer<item_t>>(max_size);
     }
-    else if (timeout > 0.0)
+    else
     {
-        return m_queue.pop_wait_for(
-            std::ref(item), std::chrono::duration_cast<std::chrono::seconds>(std::chrono::duration<float>(timeout)));
+        m_channel = std::make_unique<boost::fibers::buffered_channel<item_t>>(max_size);
     }
-    else
+}
+
+template <typename ItemT>
+boost::fibers::channel_op_status BasicFiberQueue<ItemT>::put(item_t&& item, bool block, float timeout)
+{
+    return visit_queue([&](auto& queue) {
+        if (!block)
+        {
+            return queue.try_push(std::move(item));
+        }
+        else if (timeout > 0.0)
+        {
+            return queue.push_wait_until(std::move(item), get_deadline(timeout));
+        }
+        else
+        {
+            // Blocking no timeout
+            return queue.push(std::move(item));
+        }
+    });
+}
+
+template <typename ItemT>
+boost::fibers::channel_op_status BasicFiberQueue<ItemT>::get(item_t& item, bool block, float timeout)
+{
+    return visit_queue([&](auto& queue) {
+        if (!block)
+        {
+            return queue.try_pop(item);
+        }
+        else if (timeout > 0.0)
+        {
+            return queue.pop_wait_until(item, get_deadline(timeout));
+        }
+        else
+        {
+            // Blocking no timeout
+            return queue.pop(item);
+        }
+    });
+}
+
+template <typename ItemT>
+boost::fibers::channel_op_status BasicFiberQueue<ItemT>::put_many(std::vector<item_t>& items,
+                                                                  std::size_t& num_put,
+                                                                  bool block,
+                                                                  float timeout)
+{
+    const auto deadline = get_deadline(timeout);
+
+    return visit_queue([&](auto& queue) {
+        // Items are only moved from once they have been added to the queue
+        for (num_put = 0; num_put < items.size(); ++num_put)
+        {
+            auto& item = items[num_put];
+
+            boost::fibers::channel_op_status status;
+            if (!block)
+            {
+                status = queue.try_push(std::move(item));
+            }
+            else if (timeout > 0.0)
+            {
+                status = queue.push_wait_until(std::move(item), deadline);
+            }
+            else
+            {
+                status = queue.push(std::move(item));
+            }
+
+            if (status != boost::fibers::channel_op_status::success)
+            {
+                return status;
+            }
+        }
+
+        return boost::fibers::channel_op_status::success;
+    });
+}
+
+template <typename ItemT>
+boost::fibers::channel_op_status BasicFiberQueue<ItemT>::get_many(std::vector<item_t>& items,
+                                                                  std::size_t max_items,
+                                                                  bool block,
+                                                                  float timeout)
+{
+    if (max_items == 0)
+    {
+        return boost::fibers::channel_op_status::success;
+    }
+
+    const auto deadline = get_deadline(timeout);
+
+    item_t item;
+    auto status = this->get(item, block, timeout);
+    if (status != boost::fibers::channel_op_status::success)
     {
-        // Blocking no timeout
-        return m_queue.pop(std::ref(item));
+        return status;
     }
+
+    items.push_back(std::move(item));
+
+    // Any failure after the first item, such as the queue being closed, is reported by the next call
+    const bool wait_for_items = block && timeout > 0.0;
+    visit_queue([&](auto& queue) {
+        for (std::size_t num_items = 1; num_items < max_items; ++num_items)
+        {
+            item_t next_item;
+            status = wait_for_items ? queue.pop_wait_until(next_item, deadline) : queue.try_pop(next_item);
+
+            if (status != boost::fibers::channel_op_status::success)
+            {
+                break;
+            }
+
+            items.push_back(std::move(next_item));
+        }
+    });
+
+    return boost::fibers::channel_op_status::success;
 }
 
-void FiberQueue::close()
+template <typename ItemT>
+void BasicFiberQueue<ItemT>::close()
 {
-    m_queue.close();
+    visit_queue([](auto& queue) {
+        queue.close();
+    });
 }
 
-bool FiberQueue::is_closed()
+template <typename ItemT>
+bool BasicFiberQueue<ItemT>::is_closed()
 {
-    return m_queue.is_closed();
+    return visit_queue([](auto& queue) {
+        return queue.is_closed();
+    });
 }
 
-void FiberQueue::join()
+template <typename ItemT>
+void BasicFiberQueue<ItemT>::join()
 {
     // TODO(MDD): Not sure how to join a buffered channel
 }
 
+template class BasicFiberQueue<pybind11::object>;
+template class BasicFiberQueue<std::shared_ptr<MessageMeta>>;
+
 /****** FiberQueueInterfaceProxy *************************/
-std::shared_ptr<morpheus::FiberQueue> FiberQueueInterfaceProxy::init(std::size_t max_size)
+std::shared_ptr<morpheus::FiberQueue> FiberQueueInterfaceProxy::init(std::size_t max_size, bool lock_free)
 {
     if (max_size < 2 || ((max_size & (max_size - 1)) != 0))
     {
@@ -95,7 +249,7 @@ std::shared_ptr<morpheus::FiberQueue> FiberQueueInterfaceProxy::init(std::size_t
     }
 
     // Create a new shared_ptr
-    return std::make_shared<morpheus::FiberQueue>(max_size);
+    return std::make_shared<morpheus::FiberQueue>(max_size, lock_free);
 }
 
 void FiberQueueInterfaceProxy::put(morpheus::FiberQueue& self, pybind11::object item, bool block, float timeout)
@@ -109,30 +263,14 @@ void FiberQueueInterfaceProxy::put(morpheus::FiberQueue& self, pybind11::object
         status = self.put(std::move(item), block, timeout);
     }
 
-    switch (status)
+    if (status == boost::fibers::channel_op_status::empty)
     {
-    case boost::fibers::channel_op_status::success:
-        return;
-    case boost::fibers::channel_op_status::empty: {
         LOG(FATAL) << "FiberQueue::put should never return empty.";
     }
-    case boost::fibers::channel_op_status::full:
-    case boost::fibers::channel_op_status::timeout: {
-        // Raise queue.Full
-        pybind11::object exc_class = pybind11::module_::import("queue").attr("Full");
-
-        PyErr_SetNone(exc_class.ptr());
-
-        throw pybind11::error_already_set();
-    }
-    case boost::fibers::channel_op_status::closed: {
-        // Raise queue.Full
-        pybind11::object exc_class = pybind11::module_::import("morpheus.utils.producer_consumer_queue").attr("Closed");
-
-        PyErr_SetNone(exc_class.ptr());
 
-        throw pybind11::error_already_set();
-    }
+    if (status != boost::fibers::channel_op_status::success)
+    {
+        raise_queue_error(status, true);
     }
 }
 
@@ -149,38 +287,67 @@ pybind11::object FiberQueueInterfaceProxy::get(morpheus::FiberQueue& self, bool
         status = self.get(std::ref(item), block, timeout);
     }
 
-    switch (status)
+    if (status != boost::fibers::channel_op_status::success)
     {
-    case boost::fibers::channel_op_status::success:
-        return item;
-    case boost::fibers::channel_op_status::empty: {
-        // Raise queue.Empty
-        pybind11::object exc_class = pybind11::module_::import("queue").attr("Empty");
+        raise_queue_error(status, false);
+    }
 
-        PyErr_SetNone(exc_class.ptr());
+    return item;
+}
 
-        throw pybind11::error_already_set();
+void FiberQueueInterfaceProxy::put_many(morpheus::FiberQueue& self, pybind11::list items, bool block, float timeout)
+{
+    std::vector<pybind11::object> queue_items;
+    queue_items.reserve(items.size());
+    for (const auto& item : items)
+    {
+        queue_items.push_back(pybind11::reinterpret_borrow<pybind11::object>(item));
     }
-    case boost::fibers::channel_op_status::full:
-    case boost::fibers::channel_op_status::timeout: {
-        // Raise queue.Full
-        pybind11::object exc_class = pybind11::module_::import("queue").attr("Empty");
 
-        PyErr_SetNone(exc_class.ptr());
+    boost::fibers::channel_op_status status;
+    std::size_t num_put{0};
 
-        throw pybind11::error_already_set();
+    // Release the GIL once for all of the items
+    {
+        pybind11::gil_scoped_release nogil;
+
+        status = self.put_many(queue_items, num_put, block, timeout);
     }
-    case boost::fibers::channel_op_status::closed: {
-        // Raise queue.Full
-        pybind11::object exc_class = pybind11::module_::import("morpheus.utils.producer_consumer_queue").attr("Closed");
 
-        PyErr_SetNone(exc_class.ptr());
+    if (status != boost::fibers::channel_op_status::success)
+    {
+        raise_queue_error(status, true);
+    }
+}
+
+pybind11::list FiberQueueInterfaceProxy::get_many(morpheus::FiberQueue& self,
+                                                  std::size_t max_items,
+                                                  bool block,
+                                                  float timeout)
+{
+    boost::fibers::channel_op_status status;
+
+    std::vector<pybind11::object> queue_items;
 
-        throw pybind11::error_already_set();
+    // Release the GIL once for all of the items
+    {
+        pybind11::gil_scoped_release nogil;
+
+        status = self.get_many(queue_items, max_items, block, timeout);
     }
-    default:
-        throw std::runtime_error("Unknown channel status");
+
+    if (status != boost::fibers::channel_op_status::success)
+    {
+        raise_queue_error(status, false);
     }
+
+    pybind11::list items(queue_items.size());
+    for (std::size_t i = 0; i < queue_items.size(); ++i)
+    {
+        items[i] = std::move(queue_items[i]);
+    }
+
+    return items;
 }
 
 void FiberQueueInterfaceProxy::close(morpheus::FiberQueue& self)
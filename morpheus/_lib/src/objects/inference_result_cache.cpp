@@ -0,0 +1,365 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/objects/inference_result_cache.hpp"
+
+#include "morpheus/objects/dev_mem_info.hpp"
+#include "morpheus/objects/device_resources.hpp"  // for DeviceResources
+#include "morpheus/objects/tensor.hpp"            // for Tensor::create
+#include "morpheus/objects/tensor_object.hpp"     // for TensorObject
+#include "morpheus/utilities/matx_util.hpp"
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_uvector.hpp>
+
+#include <numeric>  // for iota
+#include <stdexcept>
+#include <utility>  // for move
+
+namespace morpheus {
+
+namespace {
+
+bool is_row_major(const TensorObject& tensor)
+{
+    return tensor.rank() == 2 && (tensor.shape(1) == 1 || tensor.stride(1) == 1) &&
+           (tensor.shape(0) <= 1 || tensor.stride(0) == tensor.shape(1));
+}
+
+std::vector<TensorIndex> make_row_sequence(std::size_t num_rows)
+{
+    std::vector<TensorIndex> rows(num_rows);
+    std::iota(rows.begin(), rows.end(), 0);
+    return rows;
+}
+
+}  // namespace
+
+InferenceResultCache::InferenceResultCache(std::size_t capacity, const std::string& model_name) :
+  m_capacity(capacity),
+  m_slot_hashes(capacity),
+  m_slot_referenced(capacity, false)
+{
+    if (m_capacity == 0)
+    {
+        throw std::invalid_argument("InferenceResultCache capacity must be greater than 0");
+    }
+
+    m_index.reserve(m_capacity);
+
+    MRC_CHECK_CUDA(cudaEventCreateWithFlags(&m_last_use, cudaEventDisableTiming));
+
+    const metric_labels_t labels{{"model", model_name}};
+    auto& registry = MetricsRegistry::get_instance();
+
+    m_hits_metric = registry.get_counter(
+        "morpheus_inference_cache_hits_total", "Rows whose outputs were found in the inference cache", labels);
+    m_misses_metric = registry.get_counter(
+        "morpheus_inference_cache_misses_total", "Rows whose outputs were missing from the inference cache", labels);
+    m_size_metric = registry.get_gauge("morpheus_inference_cache_rows", "Rows held by the inference cache", labels);
+}
+
+InferenceResultCache::~InferenceResultCache()
+{
+    // The cached rows are freed on the stream of this thread, which must not overlap the last work on them
+    acquire_stream();
+    cudaEventDestroy(m_last_use);
+}
+
+InferenceResultCache::Lookup InferenceResultCache::lookup(const TensorMap& inputs)
+{
+    CHECK(!inputs.empty()) << "InferenceResultCache requires at least one input";
+
+    const auto stream = DeviceResources::stream();
+
+    Lookup lookup;
+    lookup.num_rows = inputs.begin()->second.shape(0);
+
+    // Inputs are hashed in the order of their names, which is the same for every message
+    rmm::device_uvector<uint64_t> hashes(lookup.num_rows, stream);
+    MRC_CHECK_CUDA(cudaMemsetAsync(hashes.data(), 0, hashes.size() * sizeof(uint64_t), stream.value()));
+
+    for (const auto& [name, tensor] : inputs)
+    {
+        CHECK_EQ(tensor.rank(), 2) << "Input '" << name << "' is not 2D";
+        CHECK_EQ(tensor.shape(0), lookup.num_rows) << "Input tensors are different sizes";
+
+        MatxUtil::hash_rows(
+            DevMemInfo{tensor.data(), tensor.dtype(), tensor.get_memory(), tensor.get_shape(), tensor.get_stride()},
+            hashes.data(),
+            stream);
+    }
+
+    lookup.hashes.resize(hashes.size());
+    MRC_CHECK_CUDA(cudaMemcpyAsync(lookup.hashes.data(),
+                                   hashes.data(),
+                                   hashes.size() * sizeof(uint64_t),
+                                   cudaMemcpyDeviceToHost,
+                                   stream.value()));
+    stream.synchronize();
+
+    std::lock_guard lock(m_mutex);
+
+    std::vector<TensorIndex> hit_slots;
+    for (TensorIndex row = 0; row < lookup.num_rows; ++row)
+    {
+        auto pos = m_index.find(lookup.hashes[row]);
+        if (pos == m_index.end())
+        {
+            lookup.miss_rows.push_back(row);
+            continue;
+        }
+
+        m_slot_referenced[pos->second] = true;
+        lookup.hit_rows.push_back(row);
+        hit_slots.push_back(static_cast<TensorIndex>(pos->second));
+    }
+
+    m_num_lookups += lookup.num_rows;
+    m_num_hits += lookup.hit_rows.size();
+    m_hits_metric->increment(static_cast<double>(lookup.hit_rows.size()));
+    m_misses_metric->increment(static_cast<double>(lookup.miss_rows.size()));
+
+    if (lookup.hit_rows.empty())
+    {
+        return lookup;
+    }
+
+    // The hits are copied out while the lock is held, a later insert may reuse their slots
+    const auto num_hits   = static_cast<TensorIndex>(lookup.hit_rows.size());
+    const auto hit_rows_d = make_row_sequence(lookup.hit_rows.size());
+
+    acquire_stream();
+
+    for (const auto& output : m_outputs)
+    {
+        const auto row_bytes = output.num_columns * output.dtype.item_size();
+        auto buffer          = m_buffer_pool->get_buffer(num_hits * row_bytes);
+
+        MatxUtil::copy_rows(output.rows->data(), buffer->data(), row_bytes, hit_slots, hit_rows_d, stream);
+
+        lookup.hit_outputs[output.name].swap(Tensor::create(
+            std::move(buffer), output.dtype, {num_hits, output.num_columns}, {output.num_columns, 1}, 0));
+    }
+
+    release_stream();
+
+    return lookup;
+}
+
+void InferenceResultCache::insert(const Lookup& lookup, const TensorMap& miss_outputs)
+{
+    const auto num_misses = static_cast<TensorIndex>(lookup.miss_rows.size());
+    if (num_misses == 0 || miss_outputs.empty())
+    {
+        return;
+    }
+
+    for (const auto& [name, tensor] : miss_outputs)
+    {
+        if (!is_row_major(tensor) || tensor.shape(0) != num_misses)
+        {
+            VLOG(1) << "Not caching the outputs of " << num_misses << " rows, output '" << name
+                    << "' is not a row major tensor of one row per input row";
+            return;
+        }
+    }
+
+    std::lock_guard lock(m_mutex);
+
+    if (!matches_layout(miss_outputs))
+    {
+        if (!m_outputs.empty())
+        {
+            LOG(WARNING) << "The outputs of the model no longer match those of the inference cache, clearing the cache";
+        }
+
+        reset_layout(miss_outputs);
+    }
+
+    // A row repeated within a message, or inserted by another message since the lookup, is only cached once. At most
+    // `m_capacity` rows are inserted so that a row inserted here is never evicted by this same insert.
+    std::vector<TensorIndex> output_rows;
+    std::vector<TensorIndex> slots;
+
+    for (TensorIndex i = 0; i < num_misses && slots.size() < m_capacity; ++i)
+    {
+        const auto hash = lookup.hashes[lookup.miss_rows[i]];
+        if (m_index.contains(hash))
+        {
+            continue;
+        }
+
+        const auto slot         = next_slot();
+        m_index[hash]           = slot;
+        m_slot_hashes[slot]     = hash;
+        m_slot_referenced[slot] = true;
+
+        output_rows.push_back(i);
+        slots.push_back(static_cast<TensorIndex>(slot));
+    }
+
+    acquire_stream();
+
+    for (auto& output : m_outputs)
+    {
+        const auto& tensor   = miss_outputs.at(output.name);
+        const auto row_bytes = output.num_columns * output.dtype.item_size();
+
+        MatxUtil::copy_rows(
+            tensor.data(), output.rows->data(), row_bytes, output_rows, slots, DeviceResources::stream());
+    }
+
+    release_stream();
+
+    m_size_metric->set(static_cast<double>(m_index.size()));
+}
+
+TensorMap InferenceResultCache::merge(Lookup&& lookup, TensorMap&& miss_outputs)
+{
+    if (lookup.hit_rows.empty())
+    {
+        return std::move(miss_outputs);
+    }
+
+    if (lookup.miss_rows.empty())
+    {
+        return std::move(lookup.hit_outputs);
+    }
+
+    const auto stream = DeviceResources::stream();
+
+    const auto hit_rows  = make_row_sequence(lookup.hit_rows.size());
+    const auto miss_rows = make_row_sequence(lookup.miss_rows.size());
+
+    TensorMap outputs;
+    for (auto& [name, hit_output] : lookup.hit_outputs)
+    {
+        auto pos = miss_outputs.find(name);
+        if (pos == miss_outputs.end() || !is_row_major(pos->second) ||
+            pos->second.shape(0) != static_cast<TensorIndex>(lookup.miss_rows.size()) ||
+            pos->second.shape(1) != hit_output.shape(1) || !(pos->second.dtype() == hit_output.dtype()))
+        {
+            throw std::runtime_error(MORPHEUS_CONCAT_STR("Unable to merge cached output '"
+                                                         << name << "', the outputs of the model do not match those "
+                                                         << "of the inference cache"));
+        }
+
+        const auto num_columns = hit_output.shape(1);
+        const auto row_bytes   = num_columns * hit_output.dtype_size();
+        auto buffer            = m_buffer_pool->get_buffer(lookup.num_rows * row_bytes);
+
+        MatxUtil::copy_rows(hit_output.data(), buffer->data(), row_bytes, hit_rows, lookup.hit_rows, stream);
+        MatxUtil::copy_rows(pos->second.data(), buffer->data(), row_bytes, miss_rows, lookup.miss_rows, stream);
+
+        outputs[name].swap(Tensor::create(
+            std::move(buffer), hit_output.dtype(), {lookup.num_rows, num_columns}, {num_columns, 1}, 0));
+    }
+
+    return outputs;
+}
+
+std::size_t InferenceResultCache::size() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_index.size();
+}
+
+double InferenceResultCache::hit_rate() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_num_lookups == 0 ? 0.0 : static_cast<double>(m_num_hits) / static_cast<double>(m_num_lookups);
+}
+
+void InferenceResultCache::acquire_stream()
+{
+    MRC_CHECK_CUDA(cudaStreamWaitEvent(DeviceResources::stream().value(), m_last_use, 0));
+}
+
+void InferenceResultCache::release_stream()
+{
+    MRC_CHECK_CUDA(cudaEventRecord(m_last_use, DeviceResources::stream().value()));
+}
+
+bool InferenceResultCache::matches_layout(const TensorMap& outputs) const
+{
+    if (outputs.size() != m_outputs.size())
+    {
+        return false;
+    }
+
+    for (const auto& output : m_outputs)
+    {
+        auto pos = outputs.find(output.name);
+        if (pos == outputs.end() || !(pos->second.dtype() == output.dtype) ||
+            pos->second.shape(1) != output.num_columns)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void InferenceResultCache::reset_layout(const TensorMap& outputs)
+{
+    // Earlier work on the previous rows must complete before they are freed on this thread's stream
+    acquire_stream();
+
+    m_outputs.clear();
+    m_index.clear();
+    m_num_slots_used = 0;
+    m_clock_hand     = 0;
+    std::fill(m_slot_referenced.begin(), m_slot_referenced.end(), false);
+
+    for (const auto& [name, tensor] : outputs)
+    {
+        const auto row_bytes = tensor.shape(1) * tensor.dtype_size();
+        m_outputs.emplace_back(CachedOutput{
+            name,
+            tensor.dtype(),
+            tensor.shape(1),
+            std::make_unique<rmm::device_buffer>(m_capacity * row_bytes, DeviceResources::stream())});
+    }
+}
+
+std::size_t InferenceResultCache::next_slot()
+{
+    if (m_num_slots_used < m_capacity)
+    {
+        return m_num_slots_used++;
+    }
+
+    // Rows which were hit since the hand last passed them are given a second chance
+    while (m_slot_referenced[m_clock_hand])
+    {
+        m_slot_referenced[m_clock_hand] = false;
+        m_clock_hand                    = (m_clock_hand + 1) % m_capacity;
+    }
+
+    const auto slot = m_clock_hand;
+    m_clock_hand    = (m_clock_hand + 1) % m_capacity;
+
+    m_index.erase(m_slot_hashes[slot]);
+
+    return slot;
+}
+
+}  // namespace morpheus
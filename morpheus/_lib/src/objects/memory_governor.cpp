@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/objects/memory_governor.hpp"
+
+#include "morpheus/utilities/cuda_util.hpp"  // for CudaUtil
+
+#include <cuda_runtime.h>                         // for cudaMemGetInfo
+#include <glog/logging.h>                         // for LOG
+#include <mrc/cuda/common.hpp>                    // for MRC_CHECK_CUDA
+#include <rmm/mr/device/per_device_resource.hpp>  // for get_current_device_resource, set_current_device_resource
+
+#include <stdexcept>  // for invalid_argument
+#include <string>     // for to_string
+
+namespace morpheus {
+namespace {
+std::mutex& install_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Never destroyed, buffers allocated through the governor may still be released during interpreter shutdown
+std::atomic<MemoryGovernor*>& installed_governor()
+{
+    static std::atomic<MemoryGovernor*> governor{nullptr};
+    return governor;
+}
+}  // namespace
+
+// Component public implementations
+// ************ MemoryGovernor ************************* //
+MemoryGovernor* MemoryGovernor::install(std::size_t high_watermark, std::size_t low_watermark)
+{
+    std::lock_guard lock(install_mutex());
+
+    auto* governor = installed_governor().load();
+    if (governor != nullptr)
+    {
+        governor->set_watermarks(high_watermark, low_watermark);
+        return governor;
+    }
+
+    const auto device_id = CudaUtil::current_device();
+
+    governor = new MemoryGovernor(rmm::mr::get_current_device_resource(), device_id, high_watermark, low_watermark);
+    rmm::mr::set_current_device_resource(governor);
+    installed_governor().store(governor);
+
+    LOG(INFO) << "Installed the GPU memory governor on device " << device_id << " with a high watermark of "
+              << high_watermark << " bytes and a low watermark of " << low_watermark << " bytes";
+
+    return governor;
+}
+
+MemoryGovernor* MemoryGovernor::get()
+{
+    return installed_governor().load(std::memory_order_acquire);
+}
+
+MemoryGovernor::MemoryGovernor(rmm::mr::device_memory_resource* upstream,
+                               int device_id,
+                               std::size_t high_watermark,
+                               std::size_t low_watermark) :
+  m_upstream(upstream)
+{
+    this->set_watermarks(high_watermark, low_watermark);
+
+    auto& registry = MetricsRegistry::get_instance();
+    metric_labels_t labels{{"device", std::to_string(device_id)}};
+
+    m_live_bytes_gauge = registry.get_gauge(
+        "morpheus_gpu_memory_live_bytes", "Device memory allocated through the memory governor still in use", labels);
+    m_throttled_gauge = registry.get_gauge(
+        "morpheus_gpu_memory_throttled", "Whether the sources are throttled by the memory governor", labels);
+    m_throttle_events = registry.get_counter("morpheus_gpu_memory_throttle_events_total",
+                                             "Number of times the live device memory rose above the high watermark",
+                                             labels);
+}
+
+rmm::mr::device_memory_resource* MemoryGovernor::get_upstream() const noexcept
+{
+    return m_upstream;
+}
+
+void MemoryGovernor::set_watermarks(std::size_t high_watermark, std::size_t low_watermark)
+{
+    if (high_watermark == 0)
+    {
+        throw std::invalid_argument("The high watermark of the memory governor must be greater than 0");
+    }
+
+    if (low_watermark > high_watermark)
+    {
+        throw std::invalid_argument("The low watermark of the memory governor must not be above the high watermark");
+    }
+
+    m_high_watermark.store(high_watermark, std::memory_order_relaxed);
+    m_low_watermark.store(low_watermark, std::memory_order_relaxed);
+
+    this->update_state(this->live_bytes());
+}
+
+std::size_t MemoryGovernor::high_watermark() const
+{
+    return m_high_watermark.load(std::memory_order_relaxed);
+}
+
+std::size_t MemoryGovernor::low_watermark() const
+{
+    return m_low_watermark.load(std::memory_order_relaxed);
+}
+
+int64_t MemoryGovernor::live_bytes() const
+{
+    return m_live_bytes.load(std::memory_order_relaxed);
+}
+
+bool MemoryGovernor::is_throttled() const
+{
+    return m_throttled.load(std::memory_order_acquire);
+}
+
+bool MemoryGovernor::wait_for_release(std::chrono::milliseconds timeout)
+{
+    std::unique_lock lock(m_mutex);
+    return m_released.wait_for(lock, timeout, [this]() {
+        return !this->is_throttled();
+    });
+}
+
+void* MemoryGovernor::do_allocate(std::size_t bytes, rmm::cuda_stream_view stream)
+{
+    // Allocate first, a failed allocation is not counted
+    void* ptr = m_upstream->allocate(bytes, stream);
+
+    const auto live = m_live_bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) +
+                      static_cast<int64_t>(bytes);
+
+    m_live_bytes_gauge->increment(static_cast<double>(bytes));
+    this->update_state(live);
+
+    return ptr;
+}
+
+void MemoryGovernor::do_deallocate(void* ptr, std::size_t bytes, rmm::cuda_stream_view stream)
+{
+    m_upstream->deallocate(ptr, bytes, stream);
+
+    const auto live = m_live_bytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed) -
+                      static_cast<int64_t>(bytes);
+
+    m_live_bytes_gauge->decrement(static_cast<double>(bytes));
+    this->update_state(live);
+}
+
+bool MemoryGovernor::do_is_equal(const rmm::mr::device_memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void MemoryGovernor::update_state(int64_t live_bytes)
+{
+    // Only the thread flipping the state updates the metrics and wakes up the waiters
+    if (live_bytes > static_cast<int64_t>(this->high_watermark()))
+    {
+        bool expected = false;
+        if (m_throttled.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+        {
+            m_throttled_gauge->set(1);
+            m_throttle_events->increment();
+        }
+    }
+    else if (live_bytes <= static_cast<int64_t>(this->low_watermark()))
+    {
+        bool expected = true;
+        if (m_throttled.compare_exchange_strong(expected, false, std::memory_order_acq_rel))
+        {
+            m_throttled_gauge->set(0);
+
+            // Taking the lock orders the release with a waiter about to wait, which would otherwise miss it
+            {
+                std::lock_guard lock(m_mutex);
+            }
+            m_released.notify_all();
+        }
+    }
+}
+
+// ************ MemoryGovernorInterfaceProxy ************* //
+MemoryGovernor* MemoryGovernorInterfaceProxy::install(double high_watermark, double low_watermark)
+{
+    if (high_watermark <= 0 || high_watermark > 1 || low_watermark < 0 || low_watermark > high_watermark)
+    {
+        throw std::invalid_argument(
+            "The watermarks of the memory governor must be fractions of the device memory, with 0 <= low <= high <= 1");
+    }
+
+    std::size_t free_bytes  = 0;
+    std::size_t total_bytes = 0;
+    MRC_CHECK_CUDA(cudaMemGetInfo(&free_bytes, &total_bytes));
+
+    return MemoryGovernor::install(static_cast<std::size_t>(high_watermark * total_bytes),
+                                   static_cast<std::size_t>(low_watermark * total_bytes));
+}
+
+}  // namespace morpheus
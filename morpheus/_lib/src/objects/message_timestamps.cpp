@@ -0,0 +1,297 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/objects/message_timestamps.hpp"
+
+#include <algorithm>  // for min_element, find_if
+#include <deque>
+#include <regex>
+#include <shared_mutex>
+#include <stdexcept>  // for out_of_range
+#include <string_view>
+
+namespace morpheus {
+namespace {
+constexpr std::string_view EntrySuffix = "::entry";
+constexpr std::string_view ExitSuffix  = "::exit";
+
+struct KeyTable
+{
+    std::shared_mutex mutex;
+    std::unordered_map<std::string, timestamp_key_t> ids;
+
+    // Names are never removed, so references to them stay valid
+    std::deque<std::string> names;
+};
+
+KeyTable& key_table()
+{
+    static KeyTable table;
+    return table;
+}
+
+const std::regex& cached_regex(const std::string& regex_filter)
+{
+    // Bounded, callers filter with a few constant expressions
+    constexpr std::size_t MaxCachedRegexes = 64;
+    thread_local std::unordered_map<std::string, std::regex> cache;
+
+    auto found = cache.find(regex_filter);
+    if (found != cache.end())
+    {
+        return found->second;
+    }
+
+    if (cache.size() >= MaxCachedRegexes)
+    {
+        cache.clear();
+    }
+
+    return cache.emplace(regex_filter, std::regex(regex_filter)).first->second;
+}
+
+double seconds_between(time_point_t start, time_point_t end)
+{
+    return std::chrono::duration<double>(end - start).count();
+}
+}  // namespace
+
+// Component public implementations
+// ************ TimestampKeys **************************** //
+timestamp_key_t TimestampKeys::intern(const std::string& name)
+{
+    auto& table = key_table();
+    {
+        std::shared_lock lock(table.mutex);
+        auto found = table.ids.find(name);
+        if (found != table.ids.end())
+        {
+            return found->second;
+        }
+    }
+
+    std::unique_lock lock(table.mutex);
+    auto [it, inserted] = table.ids.emplace(name, static_cast<timestamp_key_t>(table.names.size()));
+    if (inserted)
+    {
+        table.names.push_back(name);
+    }
+
+    return it->second;
+}
+
+std::optional<timestamp_key_t> TimestampKeys::find(const std::string& name)
+{
+    auto& table = key_table();
+    std::shared_lock lock(table.mutex);
+
+    auto found = table.ids.find(name);
+    if (found == table.ids.end())
+    {
+        return std::nullopt;
+    }
+
+    return found->second;
+}
+
+const std::string& TimestampKeys::name(timestamp_key_t key)
+{
+    auto& table = key_table();
+    std::shared_lock lock(table.mutex);
+
+    return table.names.at(key);
+}
+
+std::string TimestampKeys::entry_key(const std::string& stage_name)
+{
+    return stage_name + std::string(EntrySuffix);
+}
+
+std::string TimestampKeys::exit_key(const std::string& stage_name)
+{
+    return stage_name + std::string(ExitSuffix);
+}
+
+// ************ MessageTimestamps ************************ //
+MessageTimestamps::MessageTimestamps(const MessageTimestamps& other) : m_entries(other.entries()) {}
+
+MessageTimestamps& MessageTimestamps::operator=(const MessageTimestamps& other)
+{
+    if (this != &other)
+    {
+        auto entries = other.entries();
+
+        std::lock_guard lock(m_mutex);
+        m_entries = std::move(entries);
+    }
+
+    return *this;
+}
+
+void MessageTimestamps::set(timestamp_key_t key, time_point_t timestamp)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto found = std::find_if(m_entries.begin(), m_entries.end(), [key](const auto& entry) {
+        return entry.first == key;
+    });
+
+    if (found != m_entries.end())
+    {
+        found->second = timestamp;
+    }
+    else
+    {
+        m_entries.emplace_back(key, timestamp);
+    }
+}
+
+void MessageTimestamps::set(const std::string& key, time_point_t timestamp)
+{
+    this->set(TimestampKeys::intern(key), timestamp);
+}
+
+std::optional<time_point_t> MessageTimestamps::get(timestamp_key_t key) const
+{
+    std::lock_guard lock(m_mutex);
+
+    for (const auto& [entry_key, timestamp] : m_entries)
+    {
+        if (entry_key == key)
+        {
+            return timestamp;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<time_point_t> MessageTimestamps::get(const std::string& key) const
+{
+    // Looking up a key which was never interned cannot match, and should not grow the table
+    auto key_id = TimestampKeys::find(key);
+    return key_id ? this->get(*key_id) : std::nullopt;
+}
+
+std::map<std::string, time_point_t> MessageTimestamps::filter(const std::string& regex_filter) const
+{
+    const auto& filter = cached_regex(regex_filter);
+
+    std::map<std::string, time_point_t> matching_timestamps;
+    for (const auto& [key, timestamp] : this->entries())
+    {
+        const auto& name = TimestampKeys::name(key);
+        if (std::regex_search(name, filter))
+        {
+            matching_timestamps[name] = timestamp;
+        }
+    }
+
+    return matching_timestamps;
+}
+
+std::vector<std::pair<timestamp_key_t, time_point_t>> MessageTimestamps::entries() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_entries;
+}
+
+// ************ TimestampTraceExporter ******************* //
+TimestampTraceExporter::TimestampTraceExporter(std::string sink_name) : m_sink_name(std::move(sink_name))
+{
+    m_message_latency = MetricsRegistry::get_instance().get_histogram(
+        "morpheus_message_latency_seconds",
+        "Time from the earliest timestamp of a sampled message until it reached the sink",
+        {{"sink", m_sink_name}});
+}
+
+void TimestampTraceExporter::record(const std::vector<std::pair<timestamp_key_t, time_point_t>>& entries,
+                                    time_point_t now)
+{
+    if (entries.empty())
+    {
+        return;
+    }
+
+    auto earliest = std::min_element(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second < rhs.second;
+    });
+
+    m_message_latency->observe(seconds_between(earliest->second, now));
+
+    std::lock_guard lock(m_mutex);
+
+    for (const auto& [key, exit_time] : entries)
+    {
+        const auto& latency = this->stage_latency(key);
+        if (!latency.entry_key)
+        {
+            continue;
+        }
+
+        for (const auto& [entry_key, entry_time] : entries)
+        {
+            if (entry_key == *latency.entry_key)
+            {
+                latency.histogram->observe(seconds_between(entry_time, exit_time));
+                break;
+            }
+        }
+    }
+}
+
+const TimestampTraceExporter::StageLatency& TimestampTraceExporter::stage_latency(timestamp_key_t exit_key)
+{
+    auto found = m_stage_latencies.find(exit_key);
+    if (found != m_stage_latencies.end())
+    {
+        return found->second;
+    }
+
+    StageLatency latency;
+
+    const auto& name = TimestampKeys::name(exit_key);
+    if (name.size() > ExitSuffix.size() && name.ends_with(ExitSuffix))
+    {
+        auto stage_name   = name.substr(0, name.size() - ExitSuffix.size());
+        latency.entry_key = TimestampKeys::intern(TimestampKeys::entry_key(stage_name));
+        latency.histogram = MetricsRegistry::get_instance().get_histogram(
+            "morpheus_stage_latency_seconds",
+            "Time between a sampled message entering and exiting a stage",
+            {{"stage", stage_name}});
+    }
+
+    return m_stage_latencies.emplace(exit_key, std::move(latency)).first->second;
+}
+
+// ************ TimestampTraceExporterInterfaceProxy ***** //
+void TimestampTraceExporterInterfaceProxy::record(TimestampTraceExporter& self,
+                                                  const std::map<std::string, time_point_t>& timestamps)
+{
+    std::vector<std::pair<timestamp_key_t, time_point_t>> entries;
+    entries.reserve(timestamps.size());
+
+    for (const auto& [key, timestamp] : timestamps)
+    {
+        entries.emplace_back(TimestampKeys::intern(key), timestamp);
+    }
+
+    self.record(entries);
+}
+
+}  // namespace morpheus
@@ -0,0 +1,224 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/objects/pinned_host_buffer.hpp"
+
+#include "morpheus/utilities/topology.hpp"  // for TopologyUtil
+
+#include <cuda_runtime.h>  // for cudaMallocHost, cudaFreeHost, cudaHostRegister, cudaHostUnregister
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <sys/mman.h>           // for mmap, munmap
+#include <unistd.h>             // for sysconf
+
+#include <algorithm>  // for max
+#include <cstring>    // for memcpy
+#include <ostream>    // needed for glog
+#include <utility>    // for exchange
+
+namespace morpheus {
+namespace {
+// Maps `bytes` of memory bound to `numa_node`, then pins it. Returns nullptr if the memory can not be bound, such as
+// on hosts without NUMA support
+char* allocate_on_numa_node(std::size_t bytes, int numa_node)
+{
+    void* data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    if (!TopologyUtil::bind_memory(data, bytes, numa_node))
+    {
+        LOG_FIRST_N(WARNING, 1) << "Unable to bind pinned host memory to NUMA node " << numa_node
+                                << ", it is allocated on the node of the allocating thread instead";
+        ::munmap(data, bytes);
+        return nullptr;
+    }
+
+    // Registering the memory faults its pages in, on the bound node
+    auto result = cudaHostRegister(data, bytes, cudaHostRegisterDefault);
+    if (result != cudaSuccess)
+    {
+        ::munmap(data, bytes);
+        MRC_CHECK_CUDA(result);
+    }
+
+    return static_cast<char*>(data);
+}
+}  // namespace
+
+/****** Component public implementations *******************/
+/****** PinnedHostBuffer************************************/
+PinnedHostBuffer::PinnedHostBuffer(std::size_t initial_capacity, int numa_node) : m_numa_node(numa_node)
+{
+    this->reserve(initial_capacity);
+}
+
+PinnedHostBuffer::~PinnedHostBuffer()
+{
+    this->release();
+}
+
+PinnedHostBuffer::PinnedHostBuffer(PinnedHostBuffer&& other) noexcept :
+  m_data(std::exchange(other.m_data, nullptr)),
+  m_size(std::exchange(other.m_size, 0)),
+  m_capacity(std::exchange(other.m_capacity, 0)),
+  m_numa_node(other.m_numa_node),
+  m_is_registered(std::exchange(other.m_is_registered, false))
+{}
+
+PinnedHostBuffer& PinnedHostBuffer::operator=(PinnedHostBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        this->release();
+
+        m_data     = std::exchange(other.m_data, nullptr);
+        m_size     = std::exchange(other.m_size, 0);
+        m_capacity      = std::exchange(other.m_capacity, 0);
+        m_numa_node     = other.m_numa_node;
+        m_is_registered = std::exchange(other.m_is_registered, false);
+    }
+
+    return *this;
+}
+
+char* PinnedHostBuffer::data()
+{
+    return m_data;
+}
+
+const char* PinnedHostBuffer::data() const
+{
+    return m_data;
+}
+
+std::size_t PinnedHostBuffer::size() const
+{
+    return m_size;
+}
+
+std::size_t PinnedHostBuffer::capacity() const
+{
+    return m_capacity;
+}
+
+int PinnedHostBuffer::numa_node() const
+{
+    return m_numa_node;
+}
+
+bool PinnedHostBuffer::empty() const
+{
+    return m_size == 0;
+}
+
+void PinnedHostBuffer::clear()
+{
+    m_size = 0;
+}
+
+void PinnedHostBuffer::reserve(std::size_t new_capacity)
+{
+    if (new_capacity <= m_capacity)
+    {
+        return;
+    }
+
+    // Grow geometrically to amortize the cost of pinning new pages
+    new_capacity = std::max(new_capacity, m_capacity * 2);
+
+    char* new_data     = nullptr;
+    bool is_registered = false;
+
+    if (m_numa_node >= 0)
+    {
+        // Memory is bound to a node a page at a time
+        const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        new_capacity         = (new_capacity + page_size - 1) / page_size * page_size;
+
+        new_data      = allocate_on_numa_node(new_capacity, m_numa_node);
+        is_registered = new_data != nullptr;
+    }
+
+    if (new_data == nullptr)
+    {
+        MRC_CHECK_CUDA(cudaMallocHost(reinterpret_cast<void**>(&new_data), new_capacity));
+    }
+
+    if (m_size > 0)
+    {
+        std::memcpy(new_data, m_data, m_size);
+    }
+
+    this->release();
+
+    m_data          = new_data;
+    m_capacity      = new_capacity;
+    m_is_registered = is_registered;
+}
+
+void PinnedHostBuffer::append(const char* data, std::size_t num_bytes)
+{
+    this->reserve(m_size + num_bytes);
+
+    std::memcpy(m_data + m_size, data, num_bytes);
+    m_size += num_bytes;
+}
+
+void PinnedHostBuffer::push_back(char c)
+{
+    this->reserve(m_size + 1);
+
+    m_data[m_size++] = c;
+}
+
+void PinnedHostBuffer::resize(std::size_t new_size)
+{
+    this->reserve(new_size);
+
+    m_size = new_size;
+}
+
+void PinnedHostBuffer::release()
+{
+    if (m_data != nullptr && m_is_registered)
+    {
+        auto result = cudaHostUnregister(m_data);
+
+        // Dont throw from a destructor
+        LOG_IF(ERROR, result != cudaSuccess) << "Error releasing pinned host memory: " << cudaGetErrorString(result);
+
+        ::munmap(m_data, m_capacity);
+        m_data = nullptr;
+    }
+    else if (m_data != nullptr)
+    {
+        auto result = cudaFreeHost(m_data);
+
+        // Dont throw from a destructor
+        LOG_IF(ERROR, result != cudaSuccess) << "Error releasing pinned host memory: " << cudaGetErrorString(result);
+
+        m_data = nullptr;
+    }
+
+    m_capacity      = 0;
+    m_is_registered = false;
+}
+
+}  // namespace morpheus
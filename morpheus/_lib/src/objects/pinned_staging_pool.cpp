@@ -0,0 +1,210 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/objects/pinned_staging_pool.hpp"
+
+#include "morpheus/utilities/cuda_util.hpp"  // for CudaUtil
+#include "morpheus/utilities/topology.hpp"   // for TopologyUtil
+
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+
+#include <algorithm>  // for min_element
+#include <map>
+#include <ostream>  // needed for glog
+#include <utility>  // for move
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** PinnedStagingBuffer*********************************/
+PinnedStagingBuffer::PinnedStagingBuffer(int numa_node) : m_buffer(0, numa_node)
+{
+    MRC_CHECK_CUDA(cudaEventCreateWithFlags(&m_event, cudaEventDisableTiming));
+}
+
+PinnedStagingBuffer::~PinnedStagingBuffer()
+{
+    cudaEventDestroy(m_event);
+}
+
+char* PinnedStagingBuffer::data()
+{
+    return m_buffer.data();
+}
+
+const char* PinnedStagingBuffer::data() const
+{
+    return m_buffer.data();
+}
+
+std::size_t PinnedStagingBuffer::size() const
+{
+    return m_size;
+}
+
+void PinnedStagingBuffer::record(rmm::cuda_stream_view stream)
+{
+    MRC_CHECK_CUDA(cudaEventRecord(m_event, stream.value()));
+    m_is_recorded = true;
+}
+
+void PinnedStagingBuffer::synchronize()
+{
+    if (m_is_recorded)
+    {
+        MRC_CHECK_CUDA(cudaEventSynchronize(m_event));
+        m_is_recorded = false;
+    }
+}
+
+void PinnedStagingBuffer::reset(std::size_t size)
+{
+    m_buffer.reserve(size);
+    m_size = size;
+}
+
+/****** PinnedStagingPool***********************************/
+std::shared_ptr<PinnedStagingPool> PinnedStagingPool::create(std::size_t max_idle_buffers, int numa_node)
+{
+    return std::shared_ptr<PinnedStagingPool>(new PinnedStagingPool(max_idle_buffers, numa_node));
+}
+
+PinnedStagingPool& PinnedStagingPool::get_instance()
+{
+    // Intentionally leaked, pinned memory cannot be freed once the CUDA runtime has been torn down at exit
+    static auto* instance = new std::shared_ptr<PinnedStagingPool>(create());
+    return **instance;
+}
+
+PinnedStagingPool& PinnedStagingPool::get_local_instance()
+{
+    static std::mutex mutex;
+    static std::map<int, PinnedStagingPool*> device_pools;
+    static std::map<int, std::shared_ptr<PinnedStagingPool>*> numa_pools;
+
+    const auto device_id = CudaUtil::current_device();
+
+    std::lock_guard lock(mutex);
+
+    auto found = device_pools.find(device_id);
+    if (found != device_pools.end())
+    {
+        return *found->second;
+    }
+
+    const auto locality = TopologyUtil::gpu_locality(device_id);
+
+    PinnedStagingPool* pool = &get_instance();
+    if (locality.numa_node >= 0)
+    {
+        auto& numa_pool = numa_pools[locality.numa_node];
+        if (numa_pool == nullptr)
+        {
+            // Intentionally leaked, like the pool of `get_instance`
+            numa_pool = new std::shared_ptr<PinnedStagingPool>(create(DefaultMaxIdleBuffers, locality.numa_node));
+        }
+
+        pool = numa_pool->get();
+    }
+
+    LOG(INFO) << "Pinned staging buffers of GPU " << device_id << " (" << locality.to_string() << ") are allocated on "
+              << (locality.numa_node >= 0 ? "its NUMA node" : "the NUMA node of the allocating thread");
+
+    device_pools.emplace(device_id, pool);
+
+    return *pool;
+}
+
+PinnedStagingPool::PinnedStagingPool(std::size_t max_idle_buffers, int numa_node) :
+  m_max_idle_buffers(max_idle_buffers),
+  m_numa_node(numa_node)
+{}
+
+std::shared_ptr<PinnedStagingBuffer> PinnedStagingPool::acquire(std::size_t bytes)
+{
+    std::unique_ptr<PinnedStagingBuffer> buffer;
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        if (!m_idle_buffers.empty())
+        {
+            // Prefer the smallest buffer which fits, otherwise take the largest to minimize the growth needed
+            auto compare = [bytes](const auto& lhs, const auto& rhs) {
+                const auto lhs_fits = lhs->m_buffer.capacity() >= bytes;
+                const auto rhs_fits = rhs->m_buffer.capacity() >= bytes;
+                if (lhs_fits != rhs_fits)
+                {
+                    return lhs_fits;
+                }
+
+                return lhs_fits ? lhs->m_buffer.capacity() < rhs->m_buffer.capacity()
+                                : lhs->m_buffer.capacity() > rhs->m_buffer.capacity();
+            };
+
+            auto found = std::min_element(m_idle_buffers.begin(), m_idle_buffers.end(), compare);
+            buffer     = std::move(*found);
+            m_idle_buffers.erase(found);
+        }
+    }
+
+    if (!buffer)
+    {
+        buffer = std::make_unique<PinnedStagingBuffer>(m_numa_node);
+    }
+
+    buffer->reset(bytes);
+
+    // The deleter only holds a weak reference, buffers outliving the pool are simply freed
+    std::weak_ptr<PinnedStagingPool> weak_pool = this->shared_from_this();
+
+    return {buffer.release(), [weak_pool](PinnedStagingBuffer* ptr) {
+                std::unique_ptr<PinnedStagingBuffer> returned(ptr);
+
+                // Never reuse, or free, a buffer while a copy may still be using it
+                returned->synchronize();
+
+                if (auto pool = weak_pool.lock())
+                {
+                    pool->release(std::move(returned));
+                }
+            }};
+}
+
+std::size_t PinnedStagingPool::num_idle_buffers() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_idle_buffers.size();
+}
+
+int PinnedStagingPool::numa_node() const
+{
+    return m_numa_node;
+}
+
+void PinnedStagingPool::release(std::unique_ptr<PinnedStagingBuffer>&& buffer)
+{
+    std::lock_guard lock(m_mutex);
+
+    if (m_idle_buffers.size() < m_max_idle_buffers)
+    {
+        m_idle_buffers.emplace_back(std::move(buffer));
+    }
+}
+
+}  // namespace morpheus
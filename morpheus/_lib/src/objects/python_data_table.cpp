@@ -23,6 +23,8 @@
 #include <pybind11/gil.h>
 #include <pybind11/pybind11.h>
 
+#include <cstddef>  // for size_t
+#include <mutex>
 #include <utility>
 
 namespace morpheus {
@@ -43,9 +45,15 @@ PyDataTable::~PyDataTable()
 
 cudf::size_type PyDataTable::count() const
 {
-    pybind11::gil_scoped_acquire gil;
+    {
+        std::lock_guard lock(m_cache_mutex);
+        if (m_table_data)
+        {
+            return m_table_data->table_view.num_rows();
+        }
+    }
 
-    return m_py_table.attr("shape").attr("__getitem__")(0).cast<cudf::size_type>();
+    return this->get_table_data().table_view.num_rows();
 }
 
 const pybind11::object& PyDataTable::get_py_object() const
@@ -53,11 +61,40 @@ const pybind11::object& PyDataTable::get_py_object() const
     return m_py_table;
 }
 
+void PyDataTable::on_mutable_access(bool released) const
+{
+    std::lock_guard lock(m_cache_mutex);
+
+    m_table_data.reset();
+    m_is_mutable = !released;
+    ++m_cache_generation;
+}
+
 TableInfoData PyDataTable::get_table_data() const
 {
-    pybind11::gil_scoped_acquire gil;
+    std::size_t generation;
+    {
+        std::lock_guard lock(m_cache_mutex);
+        if (m_table_data)
+        {
+            return *m_table_data;
+        }
 
-    auto info = CudfHelper::table_info_data_from_table(m_py_table);
+        generation = m_cache_generation;
+    }
+
+    TableInfoData info;
+    {
+        pybind11::gil_scoped_acquire gil;
+        info = CudfHelper::table_info_data_from_table(m_py_table);
+    }
+
+    // The structure of the table may change while a `MutableTableInfo` is alive, only cache the data outside of one
+    std::lock_guard lock(m_cache_mutex);
+    if (!m_is_mutable && generation == m_cache_generation)
+    {
+        m_table_data = info;
+    }
 
     return info;
 }
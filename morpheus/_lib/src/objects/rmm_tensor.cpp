@@ -21,12 +21,10 @@
 #include "morpheus/objects/dtype.hpp"
 #include "morpheus/objects/tensor_object.hpp"
 #include "morpheus/utilities/matx_util.hpp"
-#include "morpheus/utilities/tensor_util.hpp"  // for get_elem_count & get_element_stride
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
+#include "morpheus/utilities/tensor_util.hpp"     // for get_elem_count
 
-#include <cuda_runtime.h>            // for cudaMemcpy, cudaMemcpy2D, cudaMemcpyDeviceToDevice
 #include <glog/logging.h>            // for DCHECK_LT, COMPACT_GOOGLE_LOG_FATAL, DCHECK, DCHECK_EQ, LogMessageFatal
-#include <mrc/cuda/common.hpp>       // for MRC_CHECK_CUDA
-#include <rmm/cuda_stream_view.hpp>  // for cuda_stream_per_thread
 #include <rmm/device_buffer.hpp>
 
 #include <algorithm>  // for copy, transform
@@ -46,7 +44,7 @@ RMMTensor::RMMTensor(std::shared_ptr<rmm::device_buffer> device_buffer,
                      DType dtype,
                      ShapeType shape,
                      ShapeType stride) :
-  m_mem_descriptor(std::make_shared<MemoryDescriptor>(device_buffer->stream(), device_buffer->memory_resource())),
+  m_mem_descriptor(make_pooled<MemoryDescriptor>(device_buffer->stream(), device_buffer->memory_resource())),
   m_md(std::move(device_buffer)),
   m_offset(offset),
   m_dtype(std::move(dtype)),
@@ -148,12 +146,12 @@ std::shared_ptr<ITensor> RMMTensor::slice(const ShapeType& min_dims, const Shape
 
     // Stride remains the same
 
-    return std::make_shared<RMMTensor>(m_md, offset, m_dtype, shape, m_stride);
+    return make_pooled<RMMTensor>(m_md, offset, m_dtype, shape, m_stride);
 }
 
 std::shared_ptr<ITensor> RMMTensor::reshape(const ShapeType& dims) const
 {
-    return std::make_shared<RMMTensor>(m_md, 0, m_dtype, dims, m_stride);
+    return make_pooled<RMMTensor>(m_md, 0, m_dtype, dims, m_stride);
 }
 
 std::shared_ptr<ITensor> RMMTensor::deep_copy() const
@@ -162,17 +160,23 @@ std::shared_ptr<ITensor> RMMTensor::deep_copy() const
     std::shared_ptr<rmm::device_buffer> copied_buffer =
         std::make_shared<rmm::device_buffer>(*m_md, m_md->stream(), m_md->memory_resource());
 
-    return std::make_shared<RMMTensor>(copied_buffer, m_offset, m_dtype, m_shape, m_stride);
+    return make_pooled<RMMTensor>(copied_buffer, m_offset, m_dtype, m_shape, m_stride);
 }
 
 std::shared_ptr<ITensor> RMMTensor::as_type(DType new_dtype) const
 {
+    if (new_dtype == m_dtype)
+    {
+        // Nothing to convert, return a view sharing the buffer
+        return make_pooled<RMMTensor>(m_md, m_offset, m_dtype, m_shape, m_stride);
+    }
+
     // Now do the conversion
     auto new_data_buffer =
         MatxUtil::cast(DevMemInfo{m_md, m_dtype, m_shape, m_stride, this->offset_bytes()}, new_dtype.type_id());
 
     // Return the new type
-    return std::make_shared<RMMTensor>(new_data_buffer, 0, new_dtype, m_shape, m_stride);
+    return make_pooled<RMMTensor>(new_data_buffer, 0, new_dtype, m_shape, m_stride);
 }
 
 TensorSize RMMTensor::offset_bytes() const
@@ -182,46 +186,10 @@ TensorSize RMMTensor::offset_bytes() const
 
 std::shared_ptr<ITensor> RMMTensor::copy_rows(const std::vector<RangeType>& selected_rows, TensorIndex num_rows) const
 {
-    const auto tensor_type = dtype();
-    const auto item_size   = tensor_type.item_size();
-    const auto num_columns = shape(1);
-    const auto stride      = TensorUtils::get_element_stride(m_stride);
-    const auto row_stride  = stride[0];
-
-    auto output_buffer =
-        std::make_shared<rmm::device_buffer>(num_rows * num_columns * item_size, rmm::cuda_stream_per_thread);
-
-    auto output_offset = static_cast<uint8_t*>(output_buffer->data());
-
-    for (const auto& rows : selected_rows)
-    {
-        const auto& sliced_input_tensor  = slice({rows.first, 0}, {rows.second, num_columns});
-        const TensorIndex num_input_rows = rows.second - rows.first;
-        DCHECK_EQ(num_input_rows, sliced_input_tensor->shape(0));
-
-        const auto slice_size = sliced_input_tensor->bytes();
-
-        if (row_stride == 1)
-        {
-            // column major just use cudaMemcpy
-            MRC_CHECK_CUDA(
-                cudaMemcpy(output_offset, sliced_input_tensor->data(), slice_size, cudaMemcpyDeviceToDevice));
-        }
-        else
-        {
-            MRC_CHECK_CUDA(cudaMemcpy2D(output_offset,
-                                        item_size,
-                                        sliced_input_tensor->data(),
-                                        row_stride * item_size,
-                                        item_size,
-                                        num_input_rows,
-                                        cudaMemcpyDeviceToDevice));
-        }
-
-        output_offset += slice_size;
-    }
+    auto output_buffer = MatxUtil::gather_rows(
+        DevMemInfo{m_md, m_dtype, m_shape, m_stride, this->offset_bytes()}, selected_rows, num_rows);
 
-    ShapeType output_shape{num_rows, num_columns};
-    return std::make_shared<RMMTensor>(output_buffer, 0, tensor_type, output_shape);
+    ShapeType output_shape{num_rows, shape(1)};
+    return make_pooled<RMMTensor>(output_buffer, 0, m_dtype, output_shape);
 }
 }  // namespace morpheus
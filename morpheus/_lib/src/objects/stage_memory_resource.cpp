@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/objects/stage_memory_resource.hpp"
+
+#include "morpheus/utilities/cuda_util.hpp"  // for CudaUtil
+
+#include <rmm/mr/device/per_device_resource.hpp>  // for get_current_device_resource
+
+#include <map>
+#include <memory>  // for unique_ptr, make_unique
+#include <shared_mutex>
+#include <string>   // for to_string
+#include <utility>  // for move, pair
+
+namespace morpheus {
+
+// Component public implementations
+// ************ StageMemoryResource ************************* //
+StageMemoryResource* StageMemoryResource::get(const std::string& stage_name)
+{
+    using key_t = std::pair<std::string, int>;
+
+    // Never destroyed, buffers allocated by a stage may still be released during interpreter shutdown
+    static auto* resources = new std::map<key_t, std::unique_ptr<StageMemoryResource>>();
+    static std::shared_mutex mutex;
+
+    key_t key{stage_name, CudaUtil::current_device()};
+    {
+        std::shared_lock lock(mutex);
+        auto found = resources->find(key);
+        if (found != resources->end())
+        {
+            return found->second.get();
+        }
+    }
+
+    std::unique_lock lock(mutex);
+    auto& resource = (*resources)[key];
+    if (resource == nullptr)
+    {
+        resource = std::make_unique<StageMemoryResource>(stage_name, key.second, rmm::mr::get_current_device_resource());
+    }
+
+    return resource.get();
+}
+
+StageMemoryResource::StageMemoryResource(std::string stage_name,
+                                         int device_id,
+                                         rmm::mr::device_memory_resource* upstream) :
+  m_upstream(upstream)
+{
+    auto& registry = MetricsRegistry::get_instance();
+    metric_labels_t labels{{"stage", std::move(stage_name)}, {"device", std::to_string(device_id)}};
+
+    m_current_bytes_gauge = registry.get_gauge(
+        "morpheus_stage_gpu_memory_bytes", "Device memory allocated by the stage which is still in use", labels);
+    m_peak_bytes_gauge = registry.get_gauge(
+        "morpheus_stage_gpu_memory_peak_bytes", "Peak device memory allocated by the stage and in use at once", labels);
+    m_allocations_total = registry.get_counter(
+        "morpheus_stage_gpu_allocations_total", "Number of device memory allocations made by the stage", labels);
+}
+
+rmm::mr::device_memory_resource* StageMemoryResource::get_upstream() const noexcept
+{
+    return m_upstream;
+}
+
+int64_t StageMemoryResource::current_bytes() const
+{
+    return m_current_bytes.load(std::memory_order_relaxed);
+}
+
+int64_t StageMemoryResource::peak_bytes() const
+{
+    return m_peak_bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t StageMemoryResource::allocation_count() const
+{
+    return m_allocation_count.load(std::memory_order_relaxed);
+}
+
+void* StageMemoryResource::do_allocate(std::size_t bytes, rmm::cuda_stream_view stream)
+{
+    // Allocate first, a failed allocation is not counted
+    void* ptr = m_upstream->allocate(bytes, stream);
+
+    const auto current = m_current_bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) +
+                         static_cast<int64_t>(bytes);
+
+    auto peak = m_peak_bytes.load(std::memory_order_relaxed);
+    while (current > peak && !m_peak_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+
+    m_allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    m_current_bytes_gauge->increment(static_cast<double>(bytes));
+    m_peak_bytes_gauge->set(static_cast<double>(m_peak_bytes.load(std::memory_order_relaxed)));
+    m_allocations_total->increment();
+
+    return ptr;
+}
+
+void StageMemoryResource::do_deallocate(void* ptr, std::size_t bytes, rmm::cuda_stream_view stream)
+{
+    m_upstream->deallocate(ptr, bytes, stream);
+
+    m_current_bytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    m_current_bytes_gauge->decrement(static_cast<double>(bytes));
+}
+
+bool StageMemoryResource::do_is_equal(const rmm::mr::device_memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+}  // namespace morpheus
@@ -42,7 +42,6 @@
 namespace morpheus {
 
 namespace py = pybind11;
-using namespace py::literals;
 
 /**
  * @brief Helper function for calculating the slice of a `TableInfoData` object
@@ -190,16 +189,17 @@ const TableInfoData& TableInfoBase::get_data() const
 
 bool TableInfoBase::has_sliceable_index() const
 {
-    py::gil_scoped_acquire gil;
-    auto df    = m_parent->get_py_object();
-    auto index = df.attr("index");
+    return m_parent->has_sliceable_index();
+}
 
-    auto is_unique               = index.attr("is_unique").cast<bool>();
-    auto is_monotonic_increasing = index.attr("is_monotonic_increasing").cast<bool>();
-    auto is_monotonic_decreasing = index.attr("is_monotonic_decreasing").cast<bool>();
+void TableInfoBase::record_event(rmm::cuda_stream_view stream) const
+{
+    m_parent->record_event(m_data.column_names, stream);
+}
 
-    // Must be either increasing or decreasing with unique values to slice
-    return is_unique && (is_monotonic_increasing || is_monotonic_decreasing);
+void TableInfoBase::wait_for_event(rmm::cuda_stream_view stream) const
+{
+    m_parent->wait_for_event(m_data.column_names, stream);
 }
 
 TableInfo::TableInfo(std::shared_ptr<const IDataTable> parent,
@@ -230,6 +230,13 @@ MutableTableInfo::~MutableTableInfo()
     {
         LOG(ERROR) << "Checked out python object was not returned before MutableTableInfo went out of scope";
     }
+
+    // Only the instance holding the lock releases the table, slices take the lock over from the instance they are made
+    // from. The lock is still held here, so no `TableInfo` can be made before the parent has dropped any cached data
+    if (m_lock.owns_lock())
+    {
+        this->get_parent()->on_mutable_access(true);
+    }
 }
 
 MutableTableInfo MutableTableInfo::get_slice(cudf::size_type start,
@@ -281,6 +288,12 @@ void MutableTableInfo::insert_missing_columns(const std::vector<std::tuple<std::
     }
 }
 
+void MutableTableInfo::replace_columns(const std::vector<std::string>& column_names,
+                                       std::vector<std::unique_ptr<cudf::column>>&& columns)
+{
+    this->get_data() = this->get_parent()->replace_columns(column_names, std::move(columns));
+}
+
 std::unique_ptr<pybind11::object> MutableTableInfo::checkout_obj()
 {
     // Get a copy increasing the ref count
@@ -301,47 +314,16 @@ void MutableTableInfo::return_obj(std::unique_ptr<pybind11::object>&& obj)
 
 std::optional<std::string> MutableTableInfo::ensure_sliceable_index()
 {
-    std::optional<std::string> old_index_col_name{"_index_"};
-    auto ptr_df = this->checkout_obj();
+    // Check to see if we actually need the change
+    if (this->has_sliceable_index())
     {
-        py::gil_scoped_acquire gil;
-        auto& py_df   = *ptr_df;
-        auto df_index = py_df.attr("index");
-
-        // Check to see if we actually need the change
-        if (df_index.attr("is_unique").cast<bool>() && (df_index.attr("is_monotonic_increasing").cast<bool>() ||
-                                                        df_index.attr("is_monotonic_decreasing").cast<bool>()))
-        {
-            // Set the outputname to nullopt
-            old_index_col_name = std::nullopt;
-        }
-        else
-        {
-            auto index_name = df_index.attr("name");
-
-            if (!index_name.is_none())
-            {
-                old_index_col_name = *old_index_col_name + index_name.cast<std::string>();
-            }
-
-            df_index.attr("name") = py::str(*old_index_col_name);
-
-            py_df.attr("reset_index")("inplace"_a = true);
-        }
+        return std::nullopt;
     }
 
-    this->return_obj(std::move(ptr_df));
-
-    // If we made a change, update the index and column list
-    if (old_index_col_name.has_value())
-    {
-        auto& tbl_data = this->get_data();
-        tbl_data.column_names.insert(tbl_data.column_names.begin(), *old_index_col_name);
-        tbl_data.index_names.clear();
-        tbl_data.index_names.emplace_back("");
-    }
+    this->get_data() = this->get_parent()->reset_index("_index_");
 
-    return old_index_col_name;
+    // The old index is the first column after the reset
+    return this->get_data().column_names.front();
 }
 
 }  // namespace morpheus
@@ -21,7 +21,8 @@
 #include "morpheus/objects/memory_descriptor.hpp"  // for MemoryDescriptor
 #include "morpheus/objects/rmm_tensor.hpp"
 #include "morpheus/objects/tensor_object.hpp"
-#include "morpheus/utilities/tensor_util.hpp"  // for TensorUtils::get_element_stride
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
+#include "morpheus/utilities/tensor_util.hpp"     // for TensorUtils::get_element_stride
 
 #include <cuda_runtime.h>       // for cudaMemcpy, cudaMemcpyDeviceToHost
 #include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
@@ -75,13 +76,13 @@ auto Tensor::get_stream() const
 TensorObject Tensor::create(
     std::shared_ptr<rmm::device_buffer> buffer, DType dtype, ShapeType shape, ShapeType strides, TensorSize offset)
 {
-    auto md = std::make_shared<MemoryDescriptor>(buffer->stream(), buffer->memory_resource());
+    auto md = make_pooled<MemoryDescriptor>(buffer->stream(), buffer->memory_resource());
 
     if (!strides.empty())
     {
         strides = TensorUtils::get_element_stride<TensorIndex>(strides);
     }
-    auto tensor = std::make_shared<RMMTensor>(buffer, offset, dtype, shape, strides);
+    auto tensor = make_pooled<RMMTensor>(buffer, offset, dtype, shape, strides);
 
     return {md, tensor};
 }
@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/objects/tensor_buffer_pool.hpp"
+
+#include <cuda_runtime.h>                          // for cudaEventCreateWithFlags, cudaEventRecord, cudaStreamWaitEvent
+#include <mrc/cuda/common.hpp>                     // for MRC_CHECK_CUDA
+#include <rmm/cuda_stream_view.hpp>                // for cuda_stream_per_thread
+#include <rmm/mr/device/per_device_resource.hpp>  // for get_current_device_resource
+
+#include <utility>  // for move, exchange
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** TensorBufferPool************************************/
+TensorBufferPool::IdleBuffer::IdleBuffer(std::unique_ptr<rmm::device_buffer>&& buffer, cudaEvent_t release_event) :
+  buffer(std::move(buffer)),
+  release_event(release_event)
+{}
+
+TensorBufferPool::IdleBuffer::IdleBuffer(IdleBuffer&& other) noexcept :
+  buffer(std::move(other.buffer)),
+  release_event(std::exchange(other.release_event, nullptr))
+{}
+
+TensorBufferPool::IdleBuffer::~IdleBuffer()
+{
+    if (release_event != nullptr)
+    {
+        cudaEventDestroy(release_event);
+    }
+}
+
+std::shared_ptr<TensorBufferPool> TensorBufferPool::create(std::shared_ptr<MemoryDescriptor> mem_descriptor,
+                                                           std::size_t max_cached_bytes)
+{
+    return std::shared_ptr<TensorBufferPool>(new TensorBufferPool(std::move(mem_descriptor), max_cached_bytes));
+}
+
+std::shared_ptr<TensorBufferPool> TensorBufferPool::create(std::size_t max_cached_bytes)
+{
+    return create(std::make_shared<MemoryDescriptor>(rmm::cuda_stream_per_thread,
+                                                     rmm::mr::get_current_device_resource()),
+                  max_cached_bytes);
+}
+
+TensorBufferPool::TensorBufferPool(std::shared_ptr<MemoryDescriptor> mem_descriptor, std::size_t max_cached_bytes) :
+  m_mem_descriptor(std::move(mem_descriptor)),
+  m_max_cached_bytes(max_cached_bytes)
+{}
+
+TensorBufferPool::~TensorBufferPool()
+{
+    for (auto event : m_spare_events)
+    {
+        cudaEventDestroy(event);
+    }
+}
+
+std::shared_ptr<rmm::device_buffer> TensorBufferPool::get_buffer(std::size_t bytes)
+{
+    std::unique_ptr<rmm::device_buffer> buffer;
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto found = m_idle_buffers.find(bytes);
+        if (found != m_idle_buffers.end())
+        {
+            // Order our stream after the work enqueued by the previous owner of the buffer
+            MRC_CHECK_CUDA(cudaStreamWaitEvent(m_mem_descriptor->cuda_stream.value(), found->second.release_event, 0));
+
+            buffer = std::move(found->second.buffer);
+            m_spare_events.push_back(std::exchange(found->second.release_event, nullptr));
+            m_idle_buffers.erase(found);
+            m_cached_bytes -= bytes;
+        }
+        else
+        {
+            ++m_num_allocations;
+        }
+    }
+
+    if (!buffer)
+    {
+        buffer = std::make_unique<rmm::device_buffer>(
+            bytes, m_mem_descriptor->cuda_stream, m_mem_descriptor->memory_resource);
+    }
+
+    // The deleter only holds a weak reference, buffers outliving the pool are simply freed
+    std::weak_ptr<TensorBufferPool> weak_pool = this->shared_from_this();
+
+    return {buffer.release(), [weak_pool](rmm::device_buffer* ptr) {
+                std::unique_ptr<rmm::device_buffer> returned(ptr);
+
+                if (auto pool = weak_pool.lock())
+                {
+                    pool->return_buffer(std::move(returned));
+                }
+            }};
+}
+
+void TensorBufferPool::return_buffer(std::unique_ptr<rmm::device_buffer>&& buffer)
+{
+    const auto bytes = buffer->size();
+
+    std::lock_guard lock(m_mutex);
+
+    if (m_cached_bytes + bytes > m_max_cached_bytes)
+    {
+        // Over the limit, the buffer is freed
+        return;
+    }
+
+    cudaEvent_t release_event;
+    if (!m_spare_events.empty())
+    {
+        release_event = m_spare_events.back();
+        m_spare_events.pop_back();
+    }
+    else
+    {
+        MRC_CHECK_CUDA(cudaEventCreateWithFlags(&release_event, cudaEventDisableTiming));
+    }
+
+    IdleBuffer idle_buffer{std::move(buffer), release_event};
+
+    // Recorded on the stream as seen by the releasing thread
+    MRC_CHECK_CUDA(cudaEventRecord(release_event, m_mem_descriptor->cuda_stream.value()));
+
+    m_idle_buffers.emplace(bytes, std::move(idle_buffer));
+    m_cached_bytes += bytes;
+}
+
+void TensorBufferPool::clear()
+{
+    std::multimap<std::size_t, IdleBuffer> idle_buffers;
+
+    {
+        std::lock_guard lock(m_mutex);
+        idle_buffers.swap(m_idle_buffers);
+        m_cached_bytes = 0;
+    }
+}
+
+std::size_t TensorBufferPool::cached_bytes() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_cached_bytes;
+}
+
+std::size_t TensorBufferPool::num_allocations() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_num_allocations;
+}
+
+}  // namespace morpheus
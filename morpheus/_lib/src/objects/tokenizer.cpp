@@ -0,0 +1,661 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/objects/tokenizer.hpp"
+
+#include "morpheus/types.hpp"                       // for TensorIndex
+#include "morpheus/utilities/matx_util.hpp"         // for MatxUtil
+#include "morpheus/utilities/string_util.hpp"       // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/warm_start_cache.hpp"  // for WarmStartCache
+
+#include <cuda_runtime.h>                         // for cudaGetDevice, cudaMemcpyAsync
+#include <cudf/column/column.hpp>                 // for column
+#include <cudf/column/column_factories.hpp>       // for make_column_from_scalar, make_numeric_column, make_strings_c...
+#include <cudf/copying.hpp>                       // for gather
+#include <cudf/filling.hpp>                       // for sequence
+#include <cudf/join.hpp>                          // for inner_join
+#include <cudf/lists/lists_column_view.hpp>       // for lists_column_view
+#include <cudf/reshape.hpp>                       // for interleave_columns
+#include <cudf/scalar/scalar.hpp>                 // for numeric_scalar, string_scalar
+#include <cudf/stream_compaction.hpp>             // for distinct_indices, duplicate_keep_option
+#include <cudf/strings/replace.hpp>               // for replace
+#include <cudf/table/table.hpp>                   // for table
+#include <cudf/table/table_view.hpp>              // for table_view
+#include <cudf/types.hpp>                         // for data_type, type_id, size_type, size_of, null_equality
+#include <cudf/utilities/default_stream.hpp>      // for get_default_stream
+#include <cudf/utilities/traits.hpp>              // for is_numeric
+#include <glog/logging.h>                         // for LOG
+#include <mrc/cuda/common.hpp>                    // for MRC_CHECK_CUDA
+#include <nlohmann/json.hpp>                      // for json
+#include <nvtext/normalize.hpp>                   // for normalize_spaces
+#include <rmm/cuda_stream_view.hpp>               // for cuda_stream_default
+#include <rmm/device_buffer.hpp>                  // for device_buffer
+#include <rmm/mr/device/per_device_resource.hpp>  // for get_current_device_resource
+
+#include <algorithm>  // for min, max
+#include <cstddef>    // for size_t
+#include <cstdint>    // for int64_t, uint32_t
+#include <cstring>    // for memcpy, memcmp
+#include <exception>  // for exception
+#include <fstream>    // for ifstream
+#include <map>        // for map
+#include <memory>     // for shared_ptr, unique_ptr, weak_ptr
+#include <mutex>      // for mutex, lock_guard
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <string>     // for string, getline
+#include <utility>    // for move, pair
+#include <vector>     // for vector
+
+namespace {
+
+int current_device_id()
+{
+    int device_id = 0;
+    MRC_CHECK_CUDA(cudaGetDevice(&device_id));
+    return device_id;
+}
+
+// Identifies the layout of the vocabularies held by the warm start cache
+constexpr char VocabCacheMagic[8] = {'M', 'V', 'O', 'C', 'A', 'B', '0', '1'};
+
+// Calls `fn` with each device table of `vocab`, in the order they are cached
+template <typename VocabT, typename FnT>
+void for_each_vocab_table(VocabT& vocab, FnT&& fn)
+{
+    fn(vocab.table);
+    fn(vocab.bin_coefficients);
+    fn(vocab.bin_offsets);
+    fn(vocab.cp_metadata);
+    fn(vocab.aux_cp_table);
+}
+
+// Serializes `vocab` in the layout of its device tables, such that loading it back takes a single copy per table
+std::string serialize_vocabulary(const nvtext::hashed_vocabulary& vocab)
+{
+    std::string contents(VocabCacheMagic, sizeof(VocabCacheMagic));
+    auto append = [&contents](const void* data, std::size_t bytes) {
+        contents.append(static_cast<const char*>(data), bytes);
+    };
+
+    append(&vocab.first_token_id, sizeof(vocab.first_token_id));
+    append(&vocab.separator_token_id, sizeof(vocab.separator_token_id));
+    append(&vocab.unknown_token_id, sizeof(vocab.unknown_token_id));
+    append(&vocab.outer_hash_a, sizeof(vocab.outer_hash_a));
+    append(&vocab.outer_hash_b, sizeof(vocab.outer_hash_b));
+    append(&vocab.num_bins, sizeof(vocab.num_bins));
+
+    for_each_vocab_table(vocab, [&append](const std::unique_ptr<cudf::column>& column) {
+        const auto type_id = static_cast<int32_t>(column->type().id());
+        const auto size    = static_cast<int64_t>(column->size());
+        std::vector<char> data(size * cudf::size_of(column->type()));
+
+        MRC_CHECK_CUDA(cudaMemcpy(data.data(), column->view().head(), data.size(), cudaMemcpyDeviceToHost));
+
+        append(&type_id, sizeof(type_id));
+        append(&size, sizeof(size));
+        append(data.data(), data.size());
+    });
+
+    return contents;
+}
+
+// Loads a vocabulary serialized by `serialize_vocabulary` onto the current device
+std::shared_ptr<const nvtext::hashed_vocabulary> deserialize_vocabulary(const std::string& contents)
+{
+    const auto stream  = cudf::get_default_stream();
+    std::size_t offset = 0;
+
+    auto consume = [&contents, &offset](std::size_t bytes) {
+        if (offset + bytes > contents.size())
+        {
+            throw std::runtime_error("The cached vocabulary is truncated");
+        }
+
+        const auto* data = contents.data() + offset;
+        offset += bytes;
+        return data;
+    };
+    auto read = [&consume](auto& value) {
+        std::memcpy(&value, consume(sizeof(value)), sizeof(value));
+    };
+
+    if (std::memcmp(consume(sizeof(VocabCacheMagic)), VocabCacheMagic, sizeof(VocabCacheMagic)) != 0)
+    {
+        throw std::runtime_error("The cached vocabulary has an unknown layout");
+    }
+
+    auto vocab = std::make_shared<nvtext::hashed_vocabulary>();
+    read(vocab->first_token_id);
+    read(vocab->separator_token_id);
+    read(vocab->unknown_token_id);
+    read(vocab->outer_hash_a);
+    read(vocab->outer_hash_b);
+    read(vocab->num_bins);
+
+    for_each_vocab_table(*vocab, [&](std::unique_ptr<cudf::column>& column) {
+        int32_t type_id = 0;
+        int64_t size    = 0;
+        read(type_id);
+        read(size);
+
+        const auto type = cudf::data_type{static_cast<cudf::type_id>(type_id)};
+        if (!cudf::is_numeric(type) || size < 0)
+        {
+            throw std::runtime_error("The cached vocabulary holds an invalid table");
+        }
+
+        const auto bytes = static_cast<std::size_t>(size) * cudf::size_of(type);
+        const auto* data = consume(bytes);
+
+        column = cudf::make_numeric_column(type, size, cudf::mask_state::UNALLOCATED, stream);
+        MRC_CHECK_CUDA(
+            cudaMemcpyAsync(column->mutable_view().head(), data, bytes, cudaMemcpyHostToDevice, stream.value()));
+    });
+
+    // `contents` must outlive the copies
+    stream.synchronize();
+
+    return vocab;
+}
+
+// Loads the vocabulary of `vocab_hash_file` from the warm start cache when it holds it, sparing the parsing of the
+// file. Otherwise the file is parsed and the result cached for the next process.
+std::shared_ptr<const nvtext::hashed_vocabulary> load_vocabulary(const std::string& vocab_hash_file)
+{
+    if (auto cached = morpheus::WarmStartCache::read("vocab", vocab_hash_file); cached.has_value())
+    {
+        try
+        {
+            return deserialize_vocabulary(*cached);
+        } catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Ignoring the cached vocabulary of '" << vocab_hash_file << "': " << e.what();
+        }
+    }
+
+    std::shared_ptr<const nvtext::hashed_vocabulary> vocab = nvtext::load_vocabulary_file(vocab_hash_file);
+
+    // The tables are uploaded on the default stream, while the pipeline threads tokenize on streams of their own
+    cudf::get_default_stream().synchronize();
+
+    if (!morpheus::WarmStartCache::get_directory().empty())
+    {
+        morpheus::WarmStartCache::write("vocab", vocab_hash_file, serialize_vocabulary(*vocab));
+    }
+
+    return vocab;
+}
+
+// Loads the vocabulary of `vocab_hash_file` onto the current device. Vocabularies are shared by every tokenizer using
+// the same file on the same device, and freed once the last of those tokenizers is destroyed.
+std::shared_ptr<const nvtext::hashed_vocabulary> get_vocabulary(const std::string& vocab_hash_file)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<std::string, int>, std::weak_ptr<const nvtext::hashed_vocabulary>> vocabularies;
+
+    std::lock_guard lock(mutex);
+
+    auto& cached = vocabularies[{vocab_hash_file, current_device_id()}];
+    auto vocab   = cached.lock();
+
+    if (vocab == nullptr)
+    {
+        vocab  = load_vocabulary(vocab_hash_file);
+        cached = vocab;
+    }
+
+    return vocab;
+}
+
+// Copies `strings` to a strings column on the device
+std::unique_ptr<cudf::column> make_strings_column(const std::vector<std::string>& strings)
+{
+    const auto stream = cudf::get_default_stream();
+
+    std::vector<cudf::size_type> offsets{0};
+    offsets.reserve(strings.size() + 1);
+
+    std::string chars;
+    for (const auto& str : strings)
+    {
+        chars.append(str);
+        offsets.push_back(static_cast<cudf::size_type>(chars.size()));
+    }
+
+    auto offsets_column = cudf::make_numeric_column(
+        cudf::data_type{cudf::type_id::INT32}, offsets.size(), cudf::mask_state::UNALLOCATED, stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(offsets_column->mutable_view().data<cudf::size_type>(),
+                                   offsets.data(),
+                                   offsets.size() * sizeof(cudf::size_type),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    auto chars_column = cudf::make_numeric_column(
+        cudf::data_type{cudf::type_id::INT8}, chars.size(), cudf::mask_state::UNALLOCATED, stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(chars_column->mutable_view().data<int8_t>(),
+                                   chars.data(),
+                                   chars.size(),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    auto column = cudf::make_strings_column(static_cast<cudf::size_type>(strings.size()),
+                                            std::move(offsets_column),
+                                            std::move(chars_column),
+                                            0,
+                                            rmm::device_buffer{});
+
+    stream.synchronize();
+
+    return column;
+}
+
+std::ifstream open_file(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open())
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to open tokenizer file: " << filename));
+    }
+
+    return file;
+}
+
+}  // namespace
+
+namespace morpheus {
+// Component public implementations
+// ************ WordPieceTokenizer ************************* //
+WordPieceTokenizer::WordPieceTokenizer(std::string vocab_hash_file, bool do_lower_case) :
+  m_vocab_hash_file(std::move(vocab_hash_file)),
+  m_do_lower_case(do_lower_case)
+{
+    // Loading the vocabulary up front reports a missing or invalid file when the pipeline is built
+    vocabulary();
+
+    // Tokenizing a single string loads the kernels of the tokenizer, which are otherwise loaded by the first message
+    auto warm_up = make_strings_column({"warm up"});
+    tokenize(cudf::strings_column_view{warm_up->view()}, 8, true, 8);
+}
+
+std::shared_ptr<const nvtext::hashed_vocabulary> WordPieceTokenizer::vocabulary()
+{
+    // The cache of `get_vocabulary` only holds weak references, holding each device's copy here keeps threads running
+    // on a device other than the one the tokenizer was built on from loading it again for every batch
+    const auto device_id = current_device_id();
+
+    std::lock_guard lock(m_vocab_mutex);
+
+    auto& vocab = m_vocabs[device_id];
+    if (vocab == nullptr)
+    {
+        vocab = get_vocabulary(m_vocab_hash_file);
+    }
+
+    return vocab;
+}
+
+nvtext::tokenizer_result WordPieceTokenizer::tokenize(const cudf::strings_column_view& input,
+                                                      uint32_t sequence_length,
+                                                      bool truncation,
+                                                      int stride)
+{
+    auto vocab = vocabulary();
+
+    // remove leading and trailing whitespace
+    auto normalized_col      = nvtext::normalize_spaces(input);
+    auto normalized_col_view = cudf::strings_column_view{normalized_col->view()};
+
+    // Perform the tokenizer
+    nvtext::tokenizer_result token_results;
+
+    if (normalized_col_view.chars_size(rmm::cuda_stream_default) > 0)
+    {
+        token_results = nvtext::subword_tokenize(normalized_col_view,
+                                                 *vocab,
+                                                 sequence_length,
+                                                 stride,
+                                                 m_do_lower_case,
+                                                 truncation,
+                                                 rmm::mr::get_current_device_resource());
+    }
+    else
+    {
+        // workaround for a situation where the input strings contain either no characters or only
+        // whitespace
+        auto zero     = cudf::numeric_scalar<uint32_t>(0, true, rmm::cuda_stream_default);
+        auto ids      = cudf::make_column_from_scalar(zero, sequence_length * normalized_col_view.size());
+        auto mask     = cudf::make_column_from_scalar(zero, sequence_length * normalized_col_view.size());
+        auto metadata = [&]() {
+            auto iota   = cudf::sequence(normalized_col_view.size(), zero);
+            auto zeroes = cudf::make_column_from_scalar(zero, normalized_col_view.size());
+            return cudf::interleave_columns(
+                cudf::table_view{std::vector<cudf::column_view>{iota->view(), zeroes->view(), zeroes->view()}});
+        }();
+
+        token_results = nvtext::tokenizer_result{static_cast<uint32_t>(normalized_col_view.size()),
+                                                 sequence_length,
+                                                 std::move(ids),
+                                                 std::move(mask),
+                                                 std::move(metadata)};
+    }
+    return token_results;
+}
+
+// ************ BytePairTokenizer ************************** //
+BytePairTokenizer::BytePairTokenizer(const std::string& merges_file,
+                                     const std::string& vocab_file,
+                                     const std::string& unknown_token,
+                                     std::string word_prefix) :
+  m_word_prefix(std::move(word_prefix))
+{
+    std::vector<std::string> merge_pairs;
+    {
+        auto file = open_file(merges_file);
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+
+            if (line.empty() || (merge_pairs.empty() && line.rfind("#version", 0) == 0))
+            {
+                continue;
+            }
+
+            merge_pairs.emplace_back(std::move(line));
+        }
+    }
+
+    // The id of each token is its index in the vocabulary column
+    std::vector<std::string> tokens;
+    {
+        auto file  = open_file(vocab_file);
+        auto vocab = nlohmann::json::parse(file);
+
+        for (const auto& [token, id] : vocab.items())
+        {
+            const auto index = id.get<int64_t>();
+            if (index < 0)
+            {
+                throw std::invalid_argument(
+                    MORPHEUS_CONCAT_STR("Invalid id " << index << " of token '" << token << "' in " << vocab_file));
+            }
+
+            if (static_cast<std::size_t>(index) >= tokens.size())
+            {
+                tokens.resize(index + 1);
+            }
+
+            tokens[index] = token;
+        }
+
+        if (vocab.contains(unknown_token))
+        {
+            m_unknown_id = vocab[unknown_token].get<int32_t>();
+        }
+    }
+
+    m_merge_pairs = nvtext::load_merge_pairs(cudf::strings_column_view{make_strings_column(merge_pairs)->view()});
+    m_vocab       = nvtext::load_vocabulary(cudf::strings_column_view{make_strings_column(tokens)->view()});
+
+    cudf::get_default_stream().synchronize();
+}
+
+nvtext::tokenizer_result BytePairTokenizer::tokenize(const cudf::strings_column_view& input,
+                                                     uint32_t sequence_length,
+                                                     bool truncation,
+                                                     int stride)
+{
+    const auto length = static_cast<TensorIndex>(sequence_length);
+
+    if (!truncation && (stride <= 0 || stride > length))
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+            "The stride must be between 1 and the sequence length of " << length << ", got " << stride));
+    }
+
+    const auto stream = cudf::get_default_stream();
+
+    // Mark the start of each word following a space, the encoding treats spaces as the boundaries between words
+    auto normalized = nvtext::normalize_spaces(input);
+    auto prefixed   = cudf::strings::replace(cudf::strings_column_view{normalized->view()},
+                                           cudf::string_scalar(" "),
+                                           cudf::string_scalar(" " + m_word_prefix));
+
+    auto encoded = nvtext::byte_pair_encoding(
+        cudf::strings_column_view{prefixed->view()}, *m_merge_pairs, cudf::string_scalar(" "));
+
+    auto token_lists = nvtext::tokenize_with_vocabulary(
+        cudf::strings_column_view{encoded->view()}, *m_vocab, cudf::string_scalar(" "), m_unknown_id);
+
+    const auto num_strings = input.size();
+    auto lists             = cudf::lists_column_view{token_lists->view()};
+
+    std::vector<cudf::size_type> offsets(num_strings + 1, 0);
+    if (num_strings > 0)
+    {
+        MRC_CHECK_CUDA(cudaMemcpyAsync(offsets.data(),
+                                       lists.offsets_begin(),
+                                       offsets.size() * sizeof(cudf::size_type),
+                                       cudaMemcpyDeviceToHost,
+                                       stream.value()));
+        stream.synchronize();
+    }
+
+    // Lay out the rows of each string on the host, only the tokens themselves stay on the device
+    std::vector<TensorIndex> row_starts;
+    std::vector<TensorIndex> row_lengths;
+    std::vector<uint32_t> metadata;
+
+    for (cudf::size_type string_idx = 0; string_idx < num_strings; ++string_idx)
+    {
+        const TensorIndex num_tokens = offsets[string_idx + 1] - offsets[string_idx];
+
+        for (TensorIndex start = 0;; start += stride)
+        {
+            const auto row_length = std::min(length, num_tokens - start);
+
+            row_starts.push_back(offsets[string_idx] + start);
+            row_lengths.push_back(row_length);
+
+            metadata.push_back(static_cast<uint32_t>(string_idx));
+            metadata.push_back(static_cast<uint32_t>(start == 0 ? 0 : length - stride));
+            metadata.push_back(static_cast<uint32_t>(std::max<TensorIndex>(row_length - 1, 0)));
+
+            if (truncation || start + length >= num_tokens)
+            {
+                break;
+            }
+        }
+    }
+
+    const auto num_rows = static_cast<TensorIndex>(row_starts.size());
+
+    auto make_column = [&stream](std::size_t size) {
+        return cudf::make_numeric_column(
+            cudf::data_type{cudf::type_id::UINT32}, size, cudf::mask_state::UNALLOCATED, stream);
+    };
+
+    auto token_ids       = make_column(num_rows * length);
+    auto attention_mask  = make_column(num_rows * length);
+    auto metadata_column = make_column(metadata.size());
+
+    MatxUtil::pack_token_rows(lists.child().data<int32_t>(),
+                              row_starts,
+                              row_lengths,
+                              length,
+                              token_ids->mutable_view().data<uint32_t>(),
+                              attention_mask->mutable_view().data<uint32_t>(),
+                              stream);
+
+    if (!metadata.empty())
+    {
+        MRC_CHECK_CUDA(cudaMemcpyAsync(metadata_column->mutable_view().data<uint32_t>(),
+                                       metadata.data(),
+                                       metadata.size() * sizeof(uint32_t),
+                                       cudaMemcpyHostToDevice,
+                                       stream.value()));
+    }
+
+    return nvtext::tokenizer_result{static_cast<uint32_t>(num_rows),
+                                    sequence_length,
+                                    std::move(token_ids),
+                                    std::move(attention_mask),
+                                    std::move(metadata_column)};
+}
+
+DeduplicatingTokenizer::DeduplicatingTokenizer(std::shared_ptr<ITokenizer> tokenizer) :
+  m_tokenizer(std::move(tokenizer))
+{
+    if (m_tokenizer == nullptr)
+    {
+        throw std::invalid_argument("DeduplicatingTokenizer requires a tokenizer");
+    }
+}
+
+nvtext::tokenizer_result DeduplicatingTokenizer::tokenize(const cudf::strings_column_view& input,
+                                                          uint32_t sequence_length,
+                                                          bool truncation,
+                                                          int stride)
+{
+    const auto num_strings = input.size();
+    const auto strings     = cudf::table_view{{input.parent()}};
+
+    auto distinct = cudf::distinct_indices(
+        strings, cudf::duplicate_keep_option::KEEP_FIRST, cudf::null_equality::EQUAL, cudf::nan_equality::ALL_EQUAL);
+
+    if (distinct->size() == num_strings)
+    {
+        return m_tokenizer->tokenize(input, sequence_length, truncation, stride);
+    }
+
+    auto unique_strings = cudf::gather(strings, distinct->view());
+    auto unique_results = m_tokenizer->tokenize(
+        cudf::strings_column_view{unique_strings->get_column(0).view()}, sequence_length, truncation, stride);
+
+    // As the distinct strings are unique, each string is paired with exactly one of them
+    auto [string_indices, unique_indices] =
+        cudf::inner_join(strings, unique_strings->view(), cudf::null_equality::EQUAL);
+
+    const auto stream = cudf::get_default_stream();
+
+    std::vector<cudf::size_type> joined_strings(string_indices->size());
+    std::vector<cudf::size_type> joined_uniques(unique_indices->size());
+    std::vector<uint32_t> unique_metadata(unique_results.tensor_metadata->size());
+
+    MRC_CHECK_CUDA(cudaMemcpyAsync(joined_strings.data(),
+                                   string_indices->data(),
+                                   joined_strings.size() * sizeof(cudf::size_type),
+                                   cudaMemcpyDeviceToHost,
+                                   stream.value()));
+    MRC_CHECK_CUDA(cudaMemcpyAsync(joined_uniques.data(),
+                                   unique_indices->data(),
+                                   joined_uniques.size() * sizeof(cudf::size_type),
+                                   cudaMemcpyDeviceToHost,
+                                   stream.value()));
+    MRC_CHECK_CUDA(cudaMemcpyAsync(unique_metadata.data(),
+                                   unique_results.tensor_metadata->view().data<uint32_t>(),
+                                   unique_metadata.size() * sizeof(uint32_t),
+                                   cudaMemcpyDeviceToHost,
+                                   stream.value()));
+    stream.synchronize();
+
+    std::vector<cudf::size_type> string_to_unique(num_strings, 0);
+    for (std::size_t i = 0; i < joined_strings.size(); ++i)
+    {
+        string_to_unique[joined_strings[i]] = joined_uniques[i];
+    }
+
+    // The rows of each distinct string are consecutive and in the order of the strings
+    const auto num_unique_rows = static_cast<TensorIndex>(unique_results.nrows_tensor);
+    std::vector<TensorIndex> first_rows(unique_strings->num_rows() + 1, 0);
+    for (TensorIndex row = 0; row < num_unique_rows; ++row)
+    {
+        ++first_rows[unique_metadata[row * 3] + 1];
+    }
+
+    for (std::size_t i = 1; i < first_rows.size(); ++i)
+    {
+        first_rows[i] += first_rows[i - 1];
+    }
+
+    // Lay out the rows of every string on the host, copying the rows of its distinct string on the device
+    std::vector<TensorIndex> input_rows;
+    std::vector<TensorIndex> output_rows;
+    std::vector<uint32_t> metadata;
+
+    for (cudf::size_type string_idx = 0; string_idx < num_strings; ++string_idx)
+    {
+        const auto unique_idx = string_to_unique[string_idx];
+
+        for (auto row = first_rows[unique_idx]; row < first_rows[unique_idx + 1]; ++row)
+        {
+            input_rows.push_back(row);
+            output_rows.push_back(static_cast<TensorIndex>(output_rows.size()));
+
+            metadata.push_back(static_cast<uint32_t>(string_idx));
+            metadata.push_back(unique_metadata[row * 3 + 1]);
+            metadata.push_back(unique_metadata[row * 3 + 2]);
+        }
+    }
+
+    const auto num_rows   = static_cast<TensorIndex>(input_rows.size());
+    const auto length     = static_cast<TensorIndex>(unique_results.sequence_length);
+    const auto token_type = unique_results.tensor_token_ids->type();
+    const auto row_bytes  = length * cudf::size_of(token_type);
+
+    auto make_column = [&stream](cudf::data_type type, std::size_t size) {
+        return cudf::make_numeric_column(type, size, cudf::mask_state::UNALLOCATED, stream);
+    };
+
+    auto token_ids       = make_column(token_type, num_rows * length);
+    auto attention_mask  = make_column(unique_results.tensor_attention_mask->type(), num_rows * length);
+    auto metadata_column = make_column(cudf::data_type{cudf::type_id::UINT32}, metadata.size());
+
+    MatxUtil::copy_rows(unique_results.tensor_token_ids->view().head(),
+                        token_ids->mutable_view().head(),
+                        row_bytes,
+                        input_rows,
+                        output_rows,
+                        stream);
+    MatxUtil::copy_rows(unique_results.tensor_attention_mask->view().head(),
+                        attention_mask->mutable_view().head(),
+                        row_bytes,
+                        input_rows,
+                        output_rows,
+                        stream);
+
+    MRC_CHECK_CUDA(cudaMemcpyAsync(metadata_column->mutable_view().data<uint32_t>(),
+                                   metadata.data(),
+                                   metadata.size() * sizeof(uint32_t),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    // The host vectors and the rows of the distinct strings are released on return
+    stream.synchronize();
+
+    return nvtext::tokenizer_result{static_cast<uint32_t>(num_rows),
+                                    unique_results.sequence_length,
+                                    std::move(token_ids),
+                                    std::move(attention_mask),
+                                    std::move(metadata_column)};
+}
+}  // namespace morpheus
@@ -0,0 +1,589 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/objects/user_history_store.hpp"
+
+#include "morpheus/objects/table_info.hpp"  // for TableInfo
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>  // for make_column_from_scalar
+#include <cudf/concatenate.hpp>
+#include <cudf/copying.hpp>    // for get_element, slice
+#include <cudf/io/types.hpp>   // for table_with_metadata
+#include <cudf/reduction.hpp>  // for minmax
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/search.hpp>   // for lower_bound
+#include <cudf/sorting.hpp>  // for stable_sort_by_key
+#include <cudf/table/table.hpp>
+#include <cudf/unary.hpp>             // for cast
+#include <cudf/utilities/traits.hpp>  // for is_timestamp
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>  // for find, max, min
+#include <iterator>   // for distance
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move
+
+namespace morpheus {
+namespace {
+
+// Views the timestamps of `column` as int64 nanoseconds, `owner` holding the converted column when a cast is needed
+cudf::column_view to_nanoseconds(const cudf::column_view& column, std::unique_ptr<cudf::column>& owner)
+{
+    if (!cudf::is_timestamp(column.type()))
+    {
+        throw std::invalid_argument("The timestamp column of the rolling window must hold timestamps");
+    }
+
+    if (column.has_nulls())
+    {
+        throw std::invalid_argument("The timestamp column of the rolling window must not hold nulls");
+    }
+
+    auto view = column;
+    if (column.type().id() != cudf::type_id::TIMESTAMP_NANOSECONDS)
+    {
+        owner = cudf::cast(column, cudf::data_type{cudf::type_id::TIMESTAMP_NANOSECONDS});
+        view  = owner->view();
+    }
+
+    return cudf::bit_cast(view, cudf::data_type{cudf::type_id::INT64});
+}
+
+int64_t scalar_value(const cudf::scalar& scalar)
+{
+    return static_cast<const cudf::numeric_scalar<int64_t>&>(scalar).value();
+}
+
+}  // namespace
+
+// Component public implementations
+// ************ UserHistoryStore ************************* //
+UserHistoryStore::UserHistoryStore(std::string timestamp_column,
+                                   int64_t max_history_rows,
+                                   std::chrono::nanoseconds max_history_duration,
+                                   std::size_t max_device_bytes) :
+  m_timestamp_column(std::move(timestamp_column)),
+  m_max_history_rows(max_history_rows),
+  m_max_history_duration(max_history_duration),
+  m_max_device_bytes(max_device_bytes)
+{
+    if (m_max_history_rows < 0 || m_max_history_duration.count() < 0)
+    {
+        throw std::invalid_argument("The maximum history of the rolling window must not be negative");
+    }
+}
+
+UserHistoryStore::~UserHistoryStore() = default;
+
+HistoryAppendStatus UserHistoryStore::append(const std::string& user_id, const MessageMeta& rows)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto info               = rows.get_info();
+    const auto column_names = info.get_column_names();
+
+    if (m_column_names.empty())
+    {
+        auto found = std::find(column_names.begin(), column_names.end(), m_timestamp_column);
+        if (found == column_names.end())
+        {
+            throw std::invalid_argument("Rows appended to the rolling window lack the timestamp column '" +
+                                        m_timestamp_column + "'");
+        }
+
+        m_column_names    = column_names;
+        m_timestamp_index = std::distance(column_names.begin(), found);
+    }
+
+    // Batches may order their columns differently, or hold extra ones, select those of the history
+    std::vector<cudf::column_view> columns;
+    columns.reserve(m_column_names.size());
+    for (const auto& name : m_column_names)
+    {
+        auto found = std::find(column_names.begin(), column_names.end(), name);
+        if (found == column_names.end())
+        {
+            throw std::invalid_argument("Rows appended to the rolling window lack the column '" + name + "'");
+        }
+
+        columns.push_back(info.get_column(std::distance(column_names.begin(), found)));
+    }
+
+    const cudf::table_view batch(columns);
+    if (batch.num_rows() == 0)
+    {
+        return HistoryAppendStatus::NOTHING_NEW;
+    }
+
+    std::unique_ptr<cudf::column> converted;
+    auto timestamps = to_nanoseconds(batch.column(m_timestamp_index), converted);
+
+    auto [min_scalar, max_scalar] = cudf::minmax(timestamps);
+    const auto batch_min          = scalar_value(*min_scalar);
+    const auto batch_max          = scalar_value(*max_scalar);
+
+    auto [found, inserted] = m_users.try_emplace(user_id);
+    auto& history          = found->second;
+    if (inserted)
+    {
+        history.lru = m_lru.insert(m_lru.end(), user_id);
+    }
+
+    if (history.count > 0)
+    {
+        if (batch_max <= history.max_timestamp)
+        {
+            return batch_min < history.min_timestamp ? HistoryAppendStatus::PRECEDES_HISTORY
+                                                     : HistoryAppendStatus::NOTHING_NEW;
+        }
+
+        if (batch_min <= history.max_timestamp)
+        {
+            return HistoryAppendStatus::OVERLAPS_HISTORY;
+        }
+    }
+
+    auto chunk          = make_chunk(batch, timestamps);
+    chunk.min_timestamp = batch_min;
+    chunk.max_timestamp = batch_max;
+
+    if (history.count == 0)
+    {
+        history.min_timestamp = batch_min;
+    }
+
+    if (history.pending_count == 0)
+    {
+        history.pending_min_timestamp = batch_min;
+    }
+
+    history.max_timestamp = batch_max;
+    history.count += chunk.num_rows;
+    history.pending_count += chunk.num_rows;
+
+    m_device_bytes += chunk.num_bytes;
+    history.chunks.push_back(std::move(chunk));
+
+    m_lru.splice(m_lru.end(), m_lru, history.lru);
+
+    // Releases the lock over the appended rows before spilling
+    info = TableInfo();
+
+    if (m_max_device_bytes > 0 && m_device_bytes > m_max_device_bytes)
+    {
+        spill_idle(user_id);
+    }
+
+    return HistoryAppendStatus::APPENDED;
+}
+
+std::shared_ptr<MessageMeta> UserHistoryStore::window(const std::string& user_id)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto found = m_users.find(user_id);
+    if (found == m_users.end() || found->second.count == 0)
+    {
+        return nullptr;
+    }
+
+    auto& history = found->second;
+
+    // Spilled chunks are copied back to the device by the first access to their rows
+    for (auto& chunk : history.chunks)
+    {
+        if (chunk.is_spilled)
+        {
+            chunk.is_spilled = false;
+            m_device_bytes += chunk.num_bytes;
+        }
+    }
+
+    trim(history);
+
+    if (history.chunks.size() > 1 || history.chunks.front().begin > 0)
+    {
+        compact(history);
+    }
+
+    history.pending_count = 0;
+
+    return history.chunks.front().meta;
+}
+
+void UserHistoryStore::flush(const std::string& user_id)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto found = m_users.find(user_id);
+    if (found == m_users.end())
+    {
+        return;
+    }
+
+    for (const auto& chunk : found->second.chunks)
+    {
+        if (!chunk.is_spilled)
+        {
+            m_device_bytes -= chunk.num_bytes;
+        }
+    }
+
+    m_lru.erase(found->second.lru);
+    m_users.erase(found);
+}
+
+int64_t UserHistoryStore::count(const std::string& user_id) const
+{
+    std::lock_guard lock(m_mutex);
+
+    auto found = m_users.find(user_id);
+    return found == m_users.end() ? 0 : found->second.count;
+}
+
+int64_t UserHistoryStore::pending_count(const std::string& user_id) const
+{
+    std::lock_guard lock(m_mutex);
+
+    auto found = m_users.find(user_id);
+    return found == m_users.end() ? 0 : found->second.pending_count;
+}
+
+std::size_t UserHistoryStore::num_users() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_users.size();
+}
+
+std::size_t UserHistoryStore::device_bytes() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_device_bytes;
+}
+
+StateSnapshot UserHistoryStore::snapshot()
+{
+    std::lock_guard lock(m_mutex);
+
+    StateSnapshot snapshot;
+    if (m_column_names.empty() || m_users.empty())
+    {
+        return snapshot;
+    }
+
+    // Holds the views, and the locks over the chunks, until the rows have been copied
+    std::vector<TableInfo> infos;
+    std::vector<cudf::table_view> views;
+    auto users = nlohmann::json::array();
+
+    for (const auto& user_id : m_lru)
+    {
+        auto& history = m_users.at(user_id);
+        for (auto& chunk : history.chunks)
+        {
+            if (chunk.is_spilled)
+            {
+                chunk.is_spilled = false;
+                m_device_bytes += chunk.num_bytes;
+            }
+
+            auto info = chunk.meta->get_info();
+
+            std::vector<cudf::size_type> column_indices(m_column_names.size());
+            for (std::size_t i = 0; i < column_indices.size(); ++i)
+            {
+                column_indices[i] = static_cast<cudf::size_type>(info.num_indices() + i);
+            }
+
+            auto view = info.get_view().select(column_indices);
+            views.push_back(cudf::slice(view, {chunk.begin, chunk.begin + chunk.num_rows})[0]);
+            infos.push_back(std::move(info));
+        }
+
+        users.push_back({{"user_id", user_id}, {"count", history.count}, {"pending_count", history.pending_count}});
+    }
+
+    snapshot.table = cudf::concatenate(views);
+    infos.clear();
+
+    snapshot.column_names = m_column_names;
+    snapshot.metadata     = {{"timestamp_column", m_timestamp_column}, {"users", std::move(users)}};
+
+    if (m_max_device_bytes > 0 && m_device_bytes > m_max_device_bytes)
+    {
+        spill_idle("");
+    }
+
+    return snapshot;
+}
+
+void UserHistoryStore::restore(StateSnapshot snapshot)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto found = std::find(snapshot.column_names.begin(), snapshot.column_names.end(), m_timestamp_column);
+    if (found == snapshot.column_names.end())
+    {
+        throw std::invalid_argument("The rolling window history was saved without the timestamp column '" +
+                                    m_timestamp_column + "'");
+    }
+
+    m_users.clear();
+    m_lru.clear();
+    m_device_bytes    = 0;
+    m_column_names    = snapshot.column_names;
+    m_timestamp_index = std::distance(snapshot.column_names.begin(), found);
+
+    const auto rows       = snapshot.table->view();
+    cudf::size_type begin = 0;
+    for (const auto& entry : snapshot.metadata["users"])
+    {
+        const auto user_id  = entry["user_id"].get<std::string>();
+        const auto num_rows = entry["count"].get<cudf::size_type>();
+
+        auto user_rows = cudf::slice(rows, {begin, begin + num_rows})[0];
+        begin += num_rows;
+
+        std::unique_ptr<cudf::column> converted;
+        auto timestamps = to_nanoseconds(user_rows.column(m_timestamp_index), converted);
+
+        auto chunk          = make_chunk(user_rows, timestamps);
+        chunk.min_timestamp = timestamp_at(chunk, 0);
+        chunk.max_timestamp = timestamp_at(chunk, num_rows - 1);
+
+        auto& history         = m_users[user_id];
+        history.count         = num_rows;
+        history.pending_count = entry["pending_count"].get<int64_t>();
+        history.min_timestamp = chunk.min_timestamp;
+        history.max_timestamp = chunk.max_timestamp;
+        if (history.pending_count > 0)
+        {
+            history.pending_min_timestamp =
+                timestamp_at(chunk, static_cast<cudf::size_type>(num_rows - history.pending_count));
+        }
+
+        history.lru = m_lru.insert(m_lru.end(), user_id);
+
+        m_device_bytes += chunk.num_bytes;
+        history.chunks.push_back(std::move(chunk));
+    }
+
+    if (m_max_device_bytes > 0 && m_device_bytes > m_max_device_bytes)
+    {
+        spill_idle("");
+    }
+}
+
+UserHistoryStore::Chunk UserHistoryStore::make_chunk(const cudf::table_view& rows,
+                                                     const cudf::column_view& timestamps) const
+{
+    auto sorted = cudf::stable_sort_by_key(rows, cudf::table_view({timestamps}));
+
+    Chunk chunk;
+    chunk.num_rows = sorted->num_rows();
+    for (cudf::size_type i = 0; i < sorted->num_columns(); ++i)
+    {
+        chunk.num_bytes += sorted->get_column(i).alloc_size();
+    }
+
+    cudf::io::table_with_metadata table{std::move(sorted)};
+    for (const auto& name : m_column_names)
+    {
+        table.metadata.schema_info.emplace_back(name);
+    }
+
+    chunk.meta = MessageMeta::create_from_cpp(std::move(table));
+
+    return chunk;
+}
+
+void UserHistoryStore::trim(UserHistory& history)
+{
+    int64_t num_dropped = 0;
+
+    if (m_max_history_rows > 0)
+    {
+        // Rows appended since the last window are always kept, such that every row is part of a window
+        const auto num_kept = std::max(m_max_history_rows, history.pending_count);
+        num_dropped         = std::max<int64_t>(history.count - num_kept, 0);
+    }
+
+    if (m_max_history_duration.count() > 0)
+    {
+        auto earliest = history.max_timestamp - m_max_history_duration.count();
+        if (history.pending_count > 0)
+        {
+            earliest = std::min(earliest, history.pending_min_timestamp);
+        }
+
+        int64_t num_older = 0;
+        for (const auto& chunk : history.chunks)
+        {
+            if (chunk.max_timestamp < earliest)
+            {
+                num_older += chunk.num_rows;
+                continue;
+            }
+
+            if (chunk.min_timestamp < earliest)
+            {
+                // The rows of a chunk are sorted, search for the first one within the window
+                auto info = chunk.meta->get_info();
+                std::unique_ptr<cudf::column> converted;
+                auto timestamps = to_nanoseconds(info.get_column(m_timestamp_index), converted);
+                timestamps      = cudf::slice(timestamps, {chunk.begin, chunk.begin + chunk.num_rows})[0];
+
+                auto needle = cudf::make_column_from_scalar(cudf::numeric_scalar<int64_t>(earliest), 1);
+                auto bounds = cudf::lower_bound(cudf::table_view({timestamps}),
+                                                cudf::table_view({needle->view()}),
+                                                {cudf::order::ASCENDING},
+                                                {cudf::null_order::BEFORE});
+
+                auto bound = cudf::get_element(bounds->view(), 0);
+                num_older += static_cast<const cudf::numeric_scalar<cudf::size_type>&>(*bound).value();
+            }
+
+            break;
+        }
+
+        num_dropped = std::max(num_dropped, num_older);
+    }
+
+    if (num_dropped == 0)
+    {
+        return;
+    }
+
+    history.count -= num_dropped;
+    while (num_dropped > 0)
+    {
+        auto& front = history.chunks.front();
+        if (front.num_rows <= num_dropped)
+        {
+            num_dropped -= front.num_rows;
+            m_device_bytes -= front.num_bytes;
+            history.chunks.pop_front();
+            continue;
+        }
+
+        front.begin += static_cast<cudf::size_type>(num_dropped);
+        front.num_rows -= static_cast<cudf::size_type>(num_dropped);
+        front.min_timestamp = timestamp_at(front, front.begin);
+        num_dropped         = 0;
+    }
+
+    history.min_timestamp = history.chunks.front().min_timestamp;
+}
+
+void UserHistoryStore::compact(UserHistory& history)
+{
+    // Holds the views, and the locks over the chunks, until the rows have been copied
+    std::vector<TableInfo> infos;
+    std::vector<cudf::table_view> views;
+    infos.reserve(history.chunks.size());
+    views.reserve(history.chunks.size());
+
+    for (const auto& chunk : history.chunks)
+    {
+        auto info = chunk.meta->get_info();
+
+        // Consumers of a window may have added columns to the chunk, only keep those of the history
+        std::vector<cudf::size_type> column_indices(m_column_names.size());
+        for (std::size_t i = 0; i < column_indices.size(); ++i)
+        {
+            column_indices[i] = static_cast<cudf::size_type>(info.num_indices() + i);
+        }
+
+        auto view = info.get_view().select(column_indices);
+        views.push_back(cudf::slice(view, {chunk.begin, chunk.begin + chunk.num_rows})[0]);
+        infos.push_back(std::move(info));
+    }
+
+    auto concatenated = cudf::concatenate(views);
+    infos.clear();
+
+    Chunk chunk;
+    chunk.num_rows      = concatenated->num_rows();
+    chunk.min_timestamp = history.min_timestamp;
+    chunk.max_timestamp = history.max_timestamp;
+    for (cudf::size_type i = 0; i < concatenated->num_columns(); ++i)
+    {
+        chunk.num_bytes += concatenated->get_column(i).alloc_size();
+    }
+
+    cudf::io::table_with_metadata table{std::move(concatenated)};
+    for (const auto& name : m_column_names)
+    {
+        table.metadata.schema_info.emplace_back(name);
+    }
+
+    chunk.meta = MessageMeta::create_from_cpp(std::move(table));
+
+    for (const auto& old_chunk : history.chunks)
+    {
+        m_device_bytes -= old_chunk.num_bytes;
+    }
+
+    m_device_bytes += chunk.num_bytes;
+
+    history.chunks.clear();
+    history.chunks.push_back(std::move(chunk));
+}
+
+int64_t UserHistoryStore::timestamp_at(const Chunk& chunk, cudf::size_type row) const
+{
+    auto info = chunk.meta->get_info();
+
+    std::unique_ptr<cudf::column> converted;
+    auto timestamps = to_nanoseconds(info.get_column(m_timestamp_index), converted);
+
+    return scalar_value(*cudf::get_element(timestamps, row));
+}
+
+void UserHistoryStore::spill_idle(const std::string& user_id)
+{
+    for (const auto& idle_user : m_lru)
+    {
+        if (m_device_bytes <= m_max_device_bytes)
+        {
+            break;
+        }
+
+        if (idle_user == user_id)
+        {
+            continue;
+        }
+
+        for (auto& chunk : m_users.at(idle_user).chunks)
+        {
+            // Chunks converted to python, or in use by a window being read, are not spilled
+            if (!chunk.is_spilled && chunk.meta->spill() > 0)
+            {
+                chunk.is_spilled = true;
+                m_device_bytes -= chunk.num_bytes;
+            }
+        }
+    }
+
+    VLOG(10) << "Rolling window history holds " << m_device_bytes << " bytes on the device after spilling";
+}
+
+}  // namespace morpheus
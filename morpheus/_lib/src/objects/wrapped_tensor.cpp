@@ -20,8 +20,11 @@
 #include "morpheus/objects/tensor_object.hpp"  // for TensorObject
 #include "morpheus/utilities/cupy_util.hpp"
 
+#include <cuda_runtime.h>       // for cudaGetDevice
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
+#include <rmm/cuda_stream_view.hpp>
 
 #include <cstdint>  // for uintptr_t
 #include <utility>
@@ -69,6 +72,27 @@ pybind11::dict TensorObjectInterfaceProxy::cuda_array_interface(TensorObject& se
     return array_interface;
 }
 
+pybind11::capsule TensorObjectInterfaceProxy::dlpack(TensorObject& self, std::optional<intptr_t> stream)
+{
+    // A stream of -1 tells us the consumer does not want any synchronization
+    if (stream.has_value() && *stream != -1)
+    {
+        pybind11::gil_scoped_release no_gil;
+        rmm::cuda_stream_view(reinterpret_cast<cudaStream_t>(self.stream())).synchronize();
+    }
+
+    return CupyUtil::tensor_to_dlpack(self);
+}
+
+pybind11::tuple TensorObjectInterfaceProxy::dlpack_device(TensorObject& self)
+{
+    int device_id = 0;
+    MRC_CHECK_CUDA(cudaGetDevice(&device_id));
+
+    // 2 is the value of kDLCUDA
+    return pybind11::make_tuple(2, device_id);
+}
+
 pybind11::object TensorObjectInterfaceProxy::to_cupy(TensorObject& self)
 {
     return CupyUtil::tensor_to_cupy(self);
@@ -25,6 +25,7 @@
 #include <cstddef>
 #include <memory>
 #include <optional>
+#include <string>
 #include <utility>  // for move
 // IWYU thinks we need __alloc_traits<>::value_type for vector assignments
 // IWYU pragma: no_include <ext/alloc_traits.h>
@@ -35,8 +36,11 @@ namespace morpheus {
 // ************ AddClassificationStage **************************** //
 template <typename InputT, typename OutputT>
 AddClassificationsStage<InputT, OutputT>::AddClassificationsStage(std::map<std::size_t, std::string> idx2label,
-                                                                  float threshold) :
-  AddScoresStageBase<InputT, OutputT>(std::move(idx2label), threshold)
+                                                                  float threshold,
+                                                                  std::size_t top_k,
+                                                                  const std::string& top_k_prefix,
+                                                                  const std::string& packed_column) :
+  AddScoresStageBase<InputT, OutputT>(std::move(idx2label), threshold, top_k, top_k_prefix, packed_column)
 {}
 
 template class AddClassificationsStage<MultiResponseMessage, MultiResponseMessage>;
@@ -47,18 +51,26 @@ std::shared_ptr<mrc::segment::Object<AddClassificationsStageMM>> AddClassificati
     mrc::segment::Builder& builder,
     const std::string& name,
     std::map<std::size_t, std::string> idx2label,
-    float threshold)
+    float threshold,
+    std::size_t top_k,
+    const std::string& top_k_prefix,
+    const std::string& packed_column)
 {
-    return builder.construct_object<AddClassificationsStageMM>(name, idx2label, threshold);
+    return builder.construct_object<AddClassificationsStageMM>(
+        name, idx2label, threshold, top_k, top_k_prefix, packed_column);
 }
 
 std::shared_ptr<mrc::segment::Object<AddClassificationsStageCM>> AddClassificationStageInterfaceProxy::init_cm(
     mrc::segment::Builder& builder,
     const std::string& name,
     std::map<std::size_t, std::string> idx2label,
-    float threshold)
+    float threshold,
+    std::size_t top_k,
+    const std::string& top_k_prefix,
+    const std::string& packed_column)
 {
-    return builder.construct_object<AddClassificationsStageCM>(name, idx2label, threshold);
+    return builder.construct_object<AddClassificationsStageCM>(
+        name, idx2label, threshold, top_k, top_k_prefix, packed_column);
 }
 
 }  // namespace morpheus
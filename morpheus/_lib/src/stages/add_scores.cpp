@@ -27,6 +27,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <string>
 #include <utility>  // for move
 // IWYU thinks we need __alloc_traits<>::value_type for vector assignments
 // IWYU pragma: no_include <ext/alloc_traits.h>
@@ -36,8 +37,10 @@ namespace morpheus {
 // Component public implementations
 // ************ AddScoresStage **************************** //
 template <typename InputT, typename OutputT>
-AddScoresStage<InputT, OutputT>::AddScoresStage(std::map<std::size_t, std::string> idx2label) :
-  AddScoresStageBase<InputT, OutputT>(std::move(idx2label), std::nullopt)
+AddScoresStage<InputT, OutputT>::AddScoresStage(std::map<std::size_t, std::string> idx2label,
+                                                std::size_t top_k,
+                                                const std::string& top_k_prefix) :
+  AddScoresStageBase<InputT, OutputT>(std::move(idx2label), std::nullopt, top_k, top_k_prefix)
 {}
 
 template class AddScoresStage<MultiResponseMessage, MultiResponseMessage>;
@@ -45,15 +48,23 @@ template class AddScoresStage<ControlMessage, ControlMessage>;
 
 // ************ AddScoresStageInterfaceProxy ************* //
 std::shared_ptr<mrc::segment::Object<AddScoresStageMM>> AddScoresStageInterfaceProxy::init_multi(
-    mrc::segment::Builder& builder, const std::string& name, std::map<std::size_t, std::string> idx2label)
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::map<std::size_t, std::string> idx2label,
+    std::size_t top_k,
+    const std::string& top_k_prefix)
 {
-    return builder.construct_object<AddScoresStageMM>(name, std::move(idx2label));
+    return builder.construct_object<AddScoresStageMM>(name, std::move(idx2label), top_k, top_k_prefix);
 }
 
 std::shared_ptr<mrc::segment::Object<AddScoresStageCM>> AddScoresStageInterfaceProxy::init_cm(
-    mrc::segment::Builder& builder, const std::string& name, std::map<std::size_t, std::string> idx2label)
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::map<std::size_t, std::string> idx2label,
+    std::size_t top_k,
+    const std::string& top_k_prefix)
 {
-    return builder.construct_object<AddScoresStageCM>(name, std::move(idx2label));
+    return builder.construct_object<AddScoresStageCM>(name, std::move(idx2label), top_k, top_k_prefix);
 }
 
 }  // namespace morpheus
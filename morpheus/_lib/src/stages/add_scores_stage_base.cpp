@@ -19,23 +19,31 @@
 
 #include "morpheus/messages/memory/tensor_memory.hpp"  // for TensorMemory
 #include "morpheus/messages/meta.hpp"
-#include "morpheus/messages/multi_response.hpp"  // for MultiResponseMessage
-#include "morpheus/objects/dtype.hpp"            // for DType
-#include "morpheus/objects/tensor.hpp"           // for Tensor
-#include "morpheus/objects/tensor_object.hpp"    // for TensorObject
-#include "morpheus/types.hpp"                    // for TensorIndex
-#include "morpheus/utilities/matx_util.hpp"      // for MatxUtil
-#include "morpheus/utilities/string_util.hpp"    // for StringUtil
-#include "morpheus/utilities/tensor_util.hpp"    // for TensorUtils
-
-#include <glog/logging.h>  // for CHECK, COMPACT_GOOGLE_LOG_FATAL, LogMessageFatal, COMP...
-#include <rxcpp/rx.hpp>    // for observable_member, trace_activity, decay_t, operator|
-
-#include <cstddef>      // for size_t
-#include <iterator>     // for reverse_iterator
-#include <memory>       // for shared_ptr, allocator, __shared_ptr_access
-#include <ostream>      // for basic_ostream, operator<<, basic_ostream::operator<<
-#include <stdexcept>    // for runtime_error
+#include "morpheus/messages/multi_response.hpp"        // for MultiResponseMessage
+#include "morpheus/objects/device_resources.hpp"       // for DeviceResources
+#include "morpheus/objects/dtype.hpp"                  // for DType
+#include "morpheus/objects/stage_memory_resource.hpp"  // for StageMemoryResource
+#include "morpheus/objects/tensor.hpp"                 // for Tensor
+#include "morpheus/objects/tensor_object.hpp"          // for TensorObject
+#include "morpheus/types.hpp"                          // for TensorIndex
+#include "morpheus/utilities/cuda_util.hpp"            // for CudaDeviceGuard, CudaUtil
+#include "morpheus/utilities/matx_util.hpp"            // for MatxUtil
+#include "morpheus/utilities/nvtx_util.hpp"            // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+#include "morpheus/utilities/string_util.hpp"          // for StringUtil
+#include "morpheus/utilities/tensor_util.hpp"          // for TensorUtils
+
+#include <glog/logging.h>            // for CHECK, COMPACT_GOOGLE_LOG_FATAL, LogMessageFatal, COMP...
+#include <rmm/cuda_stream_view.hpp>  // for cuda_stream_view
+#include <rmm/device_buffer.hpp>     // for device_buffer
+#include <rxcpp/rx.hpp>              // for observable_member, trace_activity, decay_t, operator|
+
+#include <cstddef>    // for size_t
+#include <cstdint>    // for int32_t, uint64_t
+#include <iterator>   // for reverse_iterator
+#include <memory>     // for shared_ptr, allocator, __shared_ptr_access
+#include <ostream>    // for basic_ostream, operator<<, basic_ostream::operator<<
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <string>
 #include <type_traits>  // for is_same_v
 #include <typeinfo>     // for type_info
 #include <utility>      // for move, pair
@@ -45,17 +53,67 @@
 // IWYU pragma: no_include <operators/rx-map.hpp>
 
 namespace morpheus {
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "AddScoresStageBase");
+
+// Attributes the device memory allocated by the stage, such as the top-k tensors, to it
+StageMemoryResource* memory_resource()
+{
+    return StageMemoryResource::get("AddScoresStageBase");
+}
+}  // namespace
 
 // Component public implementations
 // ************ AddClassificationStage **************************** //
 template <typename InputT, typename OutputT>
 AddScoresStageBase<InputT, OutputT>::AddScoresStageBase(std::map<std::size_t, std::string> idx2label,
-                                                        std::optional<float> threshold) :
+                                                        std::optional<float> threshold,
+                                                        std::size_t top_k,
+                                                        const std::string& top_k_prefix,
+                                                        const std::string& packed_column) :
   base_t(),
   m_idx2label(std::move(idx2label)),
   m_threshold(threshold),
+  m_top_k(top_k),
+  m_packed_column(packed_column),
   m_min_col_count(m_idx2label.rbegin()->first)  // Ordered map's largest key will be the last entry
 {
+    for (const auto& [column_num, column_name] : m_idx2label)
+    {
+        m_label_columns.push_back(static_cast<TensorIndex>(column_num));
+    }
+
+    if (!m_packed_column.empty())
+    {
+        if (!m_threshold.has_value() || m_top_k > 0)
+        {
+            throw std::invalid_argument("packed_column requires a threshold and cannot be combined with top_k");
+        }
+
+        if (m_idx2label.size() > static_cast<std::size_t>(MatxUtil::MaxPackedLabels))
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("packed_column supports at most "
+                                                            << MatxUtil::MaxPackedLabels
+                                                            << " labels, labels: " << m_idx2label.size()));
+        }
+    }
+
+    if (m_top_k > 0)
+    {
+        if (m_top_k > m_idx2label.size() || m_top_k > static_cast<std::size_t>(MatxUtil::MaxTopK))
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("top_k must be at most the number of labels ("
+                                                            << m_idx2label.size() << ") and at most "
+                                                            << MatxUtil::MaxTopK << ", top_k: " << m_top_k));
+        }
+
+        for (std::size_t rank = 0; rank < m_top_k; ++rank)
+        {
+            m_top_k_columns.push_back(MORPHEUS_CONCAT_STR(top_k_prefix << "top_" << rank << "_id"));
+            m_top_k_columns.push_back(MORPHEUS_CONCAT_STR(top_k_prefix << "top_" << rank << "_score"));
+        }
+    }
+
     this->pipe(rxcpp::operators::map([this](sink_type_t x) {
         return this->on_data(std::move(x));
     }));
@@ -64,12 +122,17 @@ AddScoresStageBase<InputT, OutputT>::AddScoresStageBase(std::map<std::size_t, st
 template <typename InputT, typename OutputT>
 AddScoresStageBase<InputT, OutputT>::source_type_t AddScoresStageBase<InputT, OutputT>::on_data(sink_type_t x)
 {
+    // All of the work happens on the device holding the message's outputs
     if constexpr (std::is_same_v<sink_type_t, std::shared_ptr<MultiResponseMessage>>)
     {
+        MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", x->mess_count);
+        CudaDeviceGuard device_guard(x->memory->device_id());
         this->on_multi_response_message(x);
     }
     else if constexpr (std::is_same_v<sink_type_t, std::shared_ptr<ControlMessage>>)
     {
+        MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", x->tensors()->count);
+        CudaDeviceGuard device_guard(x->tensors()->device_id());
         this->on_control_message(x);
     }
     // sink_type_t not supported
@@ -82,12 +145,11 @@ AddScoresStageBase<InputT, OutputT>::source_type_t AddScoresStageBase<InputT, Ou
     return x;
 }
 
-template <>
-void AddScoresStageBase<MultiResponseMessage, MultiResponseMessage>::on_multi_response_message(
-    std::shared_ptr<MultiResponseMessage> x)
+template <typename InputT, typename OutputT>
+void AddScoresStageBase<InputT, OutputT>::compute_outputs(TensorObject probs,
+                                                          std::vector<std::string>& columns,
+                                                          std::vector<TensorObject>& tensors)
 {
-    auto probs = x->get_probs_tensor();
-
     const auto& shape = probs.get_shape();
 
     // Depending on the input the stride is given in bytes or elements, convert to elements
@@ -98,8 +160,57 @@ void AddScoresStageBase<MultiResponseMessage, MultiResponseMessage>::on_multi_re
            "indexes: "
         << StringUtil::map_to_str(m_idx2label.begin(), m_idx2label.end()) << ", Model output columns: " << shape[1];
 
-    const auto num_rows    = shape[0];
-    const auto num_columns = shape[1];
+    const auto num_rows = shape[0];
+
+    if (m_top_k > 0)
+    {
+        const auto k      = static_cast<TensorIndex>(m_top_k);
+        const auto stream = DeviceResources::stream();
+
+        // Column major, such that each rank is a contiguous column
+        auto ids    = std::make_shared<rmm::device_buffer>(num_rows * k * sizeof(int32_t), stream, memory_resource());
+        auto scores = std::make_shared<rmm::device_buffer>(num_rows * k * sizeof(float), stream, memory_resource());
+
+        MatxUtil::top_k({probs.data(), probs.dtype(), probs.get_memory(), probs.get_shape(), stride},
+                        m_label_columns,
+                        k,
+                        m_threshold,
+                        static_cast<int32_t*>(ids->data()),
+                        static_cast<float*>(scores->data()),
+                        stream);
+
+        auto ids_tensor    = Tensor::create(ids, DType::create<int32_t>(), {num_rows, k}, {1, num_rows});
+        auto scores_tensor = Tensor::create(scores, DType::create<float>(), {num_rows, k}, {1, num_rows});
+
+        for (TensorIndex rank = 0; rank < k; ++rank)
+        {
+            columns.push_back(m_top_k_columns[2 * rank]);
+            tensors.emplace_back(ids_tensor.slice({0, rank}, {num_rows, rank + 1}));
+
+            columns.push_back(m_top_k_columns[2 * rank + 1]);
+            tensors.emplace_back(scores_tensor.slice({0, rank}, {num_rows, rank + 1}));
+        }
+
+        return;
+    }
+
+    if (!m_packed_column.empty())
+    {
+        const auto stream = DeviceResources::stream();
+
+        auto packed = std::make_shared<rmm::device_buffer>(num_rows * sizeof(uint64_t), stream, memory_resource());
+
+        MatxUtil::pack_labels({probs.data(), probs.dtype(), probs.get_memory(), probs.get_shape(), stride},
+                              m_label_columns,
+                              *m_threshold,
+                              static_cast<uint64_t*>(packed->data()),
+                              stream);
+
+        columns.push_back(m_packed_column);
+        tensors.emplace_back(Tensor::create(packed, DType::create<uint64_t>(), {num_rows, 1}, {1, num_rows}));
+
+        return;
+    }
 
     TensorObject output_tensor;
 
@@ -108,7 +219,8 @@ void AddScoresStageBase<MultiResponseMessage, MultiResponseMessage>::on_multi_re
         auto thresh_bool_buffer = MatxUtil::threshold(
             {probs.data(), probs.dtype(), probs.get_memory(), probs.get_shape(), probs.get_stride()},
             *m_threshold,
-            false);
+            false,
+            CudaUtil::current_device() == m_device_id ? m_buffer_pool : nullptr);
 
         output_tensor.swap(Tensor::create(thresh_bool_buffer, DType::create<bool>(), shape, stride));
     }
@@ -117,70 +229,38 @@ void AddScoresStageBase<MultiResponseMessage, MultiResponseMessage>::on_multi_re
         output_tensor.swap(std::move(probs));
     }
 
-    std::vector<std::string> columns;
-    std::vector<TensorObject> tensors;
-
-    std::size_t i = 0;
     for (const auto& [column_num, column_name] : m_idx2label)
     {
         columns.push_back(column_name);
         tensors.emplace_back(output_tensor.slice({0, static_cast<TensorIndex>(column_num)},
                                                  {num_rows, static_cast<TensorIndex>(column_num + 1)}));
-
-        ++i;
     }
-
-    x->set_meta(columns, tensors);
 }
 
 template <>
-void AddScoresStageBase<ControlMessage, ControlMessage>::on_control_message(std::shared_ptr<ControlMessage> x)
+void AddScoresStageBase<MultiResponseMessage, MultiResponseMessage>::on_multi_response_message(
+    std::shared_ptr<MultiResponseMessage> x)
 {
-    // The default of probs_tensor_name is "probs"
-    auto probs        = x->tensors()->get_tensor("probs");
-    const auto& shape = probs.get_shape();
-
-    // Depending on the input the stride is given in bytes or elements, convert to elements
-    auto stride = TensorUtils::get_element_stride(probs.get_stride());
-
-    CHECK(shape.size() == 2 && shape[1] > m_min_col_count)
-        << "Model output did not contain enough columns to fufill the requested labels. Label "
-           "indexes: "
-        << StringUtil::map_to_str(m_idx2label.begin(), m_idx2label.end()) << ", Model output columns: " << shape[1];
-
-    const auto num_rows    = shape[0];
-    const auto num_columns = shape[1];
-
-    TensorObject output_tensor;
+    std::vector<std::string> columns;
+    std::vector<TensorObject> tensors;
 
-    if (m_threshold.has_value())
-    {
-        auto thresh_bool_buffer = MatxUtil::threshold(
-            {probs.data(), probs.dtype(), probs.get_memory(), probs.get_shape(), probs.get_stride()},
-            *m_threshold,
-            false);
+    this->compute_outputs(x->get_probs_tensor(), columns, tensors);
 
-        output_tensor.swap(Tensor::create(thresh_bool_buffer, DType::create<bool>(), shape, stride));
-    }
-    else
-    {
-        output_tensor.swap(std::move(probs));
-    }
+    // The copies are only synchronized by the consumers of the table, see `MessageMeta::set_data`
+    x->set_meta(columns, tensors, DeviceResources::stream());
+}
 
+template <>
+void AddScoresStageBase<ControlMessage, ControlMessage>::on_control_message(std::shared_ptr<ControlMessage> x)
+{
     std::vector<std::string> columns;
     std::vector<TensorObject> tensors;
 
-    std::size_t i = 0;
-    for (const auto& [column_num, column_name] : m_idx2label)
-    {
-        columns.push_back(column_name);
-        tensors.emplace_back(output_tensor.slice({0, static_cast<TensorIndex>(column_num)},
-                                                 {num_rows, static_cast<TensorIndex>(column_num + 1)}));
-
-        ++i;
-    }
+    // The default of probs_tensor_name is "probs"
+    this->compute_outputs(x->tensors()->get_tensor("probs"), columns, tensors);
 
-    x->payload()->set_data(columns, tensors);
+    // The copies are only synchronized by the consumers of the table, see `MessageMeta::set_data`
+    x->payload()->set_data(columns, tensors, DeviceResources::stream());
 }
 
 template class AddScoresStageBase<MultiResponseMessage, MultiResponseMessage>;
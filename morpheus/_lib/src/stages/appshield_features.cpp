@@ -0,0 +1,898 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/appshield_features.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/table_info.hpp"
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cudf/aggregation.hpp>
+#include <cudf/binaryop.hpp>  // for binary_operation, binary_operator
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>  // for make_column_from_scalar, make_empty_column
+#include <cudf/column/column_view.hpp>
+#include <cudf/copying.hpp>  // for copy_if_else, gather
+#include <cudf/filling.hpp>  // for sequence
+#include <cudf/groupby.hpp>
+#include <cudf/io/types.hpp>                 // for table_with_metadata
+#include <cudf/join.hpp>                     // for left_join
+#include <cudf/lists/lists_column_view.hpp>  // for lists_column_view
+#include <cudf/replace.hpp>                  // for replace_nulls
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/scalar/scalar_factories.hpp>           // for make_default_constructed_scalar
+#include <cudf/search.hpp>                            // for contains
+#include <cudf/sorting.hpp>                           // for sort_by_key
+#include <cudf/strings/attributes.hpp>                // for count_characters
+#include <cudf/strings/case.hpp>                      // for to_lower, to_upper
+#include <cudf/strings/combine.hpp>                   // for concatenate
+#include <cudf/strings/convert/convert_floats.hpp>    // for to_floats
+#include <cudf/strings/convert/convert_integers.hpp>  // for from_integers, hex_to_integers
+#include <cudf/strings/extract.hpp>
+#include <cudf/strings/find.hpp>  // for contains, find
+#include <cudf/strings/regex/regex_program.hpp>
+#include <cudf/strings/replace.hpp>
+#include <cudf/strings/split/split.hpp>  // for split, split_record
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>
+#include <cudf/unary.hpp>             // for cast, is_valid, unary_operation
+#include <cudf/utilities/span.hpp>    // for device_span
+#include <cudf/utilities/traits.hpp>  // for is_integral
+#include <glog/logging.h>
+
+#include <algorithm>  // for find
+#include <cstddef>    // for size_t
+#include <cstdint>    // for int32_t, int64_t
+#include <exception>
+#include <iterator>  // for distance
+#include <map>
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move, pair
+
+namespace morpheus {
+namespace {
+using column_ptr = std::unique_ptr<cudf::column>;
+
+// Commit charge of the regions whose whole address range is committed, excluded from the commit charge statistics
+constexpr int64_t FullMemoryAddress = 2147483647;
+
+// Nulls are replaced by this string when counting unique values, as pandas counts missing values as a value
+constexpr const char* MissingValue = "\x1f";
+
+// Handle types whose count and ratio are features, as `HANDLES_TYPES` of the example
+const std::vector<std::pair<std::string, std::string>> CountedHandleTypes{
+    {"Directory", "directory"},
+    {"TpWorkerFactory", "tpworkerfactory"},
+    {"WaitCompletionPacket", "waitcompletionpacket"},
+    {"Section", "section"},
+    {"File", "file"},
+    {"Mutant", "mutant"},
+    {"Event", "event"},
+    {"Semaphore", "semaphore"},
+    {"Key", "key"},
+    {"IoCompletion", "iocompletion"},
+    {"ALPC Port", "alpc port"},
+    {"Thread", "thread"}};
+
+// Handle types of which only the ratio is a feature, as `HANDLES_TYPES_2` of the example
+const std::vector<std::pair<std::string, std::string>> RatioHandleTypes{{"IoCompletionReserve", "iocompletionreserve"},
+                                                                        {"Desktop", "desktop"},
+                                                                        {"EtwRegistration", "etwregistration"},
+                                                                        {"WindowStation", "windowstation"}};
+
+// Memory protections of the vadinfo rows, along with the prefix of their features. Volatility pads the values.
+const std::vector<std::pair<std::string, std::string>> Protections{
+    {"PAGE_EXECUTE_READWRITE ", "page_execute_readwrite"},
+    {"PAGE_NOACCESS ", "page_no_access"},
+    {"PAGE_EXECUTE_WRITECOPY ", "page_execute_writecopy"},
+    {"PAGE_READONLY ", "page_readonly"},
+    {"PAGE_READWRITE ", "page_readwrite"}};
+
+const std::vector<std::string> WaitReasons{"9", "31", "13"};
+
+const std::string FileExtensionsExpression{".COM;.EXE;.BAT;.CMD;.VBS;.VBE;.JS;.JSE;.WSF;.WSH;.MSC;.CPL"};
+
+/**
+ * @brief Columns of the snapshots read by the features, owning the columns converted or derived from them.
+ */
+class SnapshotColumns
+{
+  public:
+    SnapshotColumns(const TableInfo& info) : m_info(info), m_names(info.get_column_names()) {}
+
+    // The column `name` as strings. Columns of a plugin missing from the batch may have been read as numbers, integers
+    // are converted and other types, which only hold nulls, become null strings.
+    cudf::column_view strings(const std::string& name)
+    {
+        auto column = this->get(name);
+
+        if (column.type().id() == cudf::type_id::STRING)
+        {
+            return column;
+        }
+
+        if (cudf::is_integral(column.type()))
+        {
+            return this->own(cudf::strings::from_integers(column));
+        }
+
+        return this->own(cudf::make_column_from_scalar(cudf::string_scalar("", false), column.size()));
+    }
+
+    // The column `name` as int64, strings being parsed as floats first as the python stage does
+    cudf::column_view integers(const std::string& name)
+    {
+        auto column = this->get(name);
+
+        if (column.type().id() == cudf::type_id::STRING)
+        {
+            column = this->own(
+                cudf::strings::to_floats(cudf::strings_column_view{column}, cudf::data_type{cudf::type_id::FLOAT64}));
+        }
+
+        return this->own(cudf::cast(column, cudf::data_type{cudf::type_id::INT64}));
+    }
+
+    cudf::column_view own(column_ptr column)
+    {
+        m_owned.push_back(std::move(column));
+        return m_owned.back()->view();
+    }
+
+  private:
+    cudf::column_view get(const std::string& name) const
+    {
+        auto found = std::find(m_names.begin(), m_names.end(), name);
+        if (found == m_names.end())
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to find the AppShield column '" << name << "'"));
+        }
+
+        return m_info.get_column(std::distance(m_names.begin(), found));
+    }
+
+    const TableInfo& m_info;
+    std::vector<std::string> m_names;
+    std::vector<column_ptr> m_owned;
+};
+
+// Copies `values` to a strings column, by splitting them once joined as a single string
+column_ptr make_strings_column(const std::vector<std::string>& values)
+{
+    if (values.empty())
+    {
+        return cudf::make_empty_column(cudf::type_id::STRING);
+    }
+
+    std::string joined;
+    for (const auto& value : values)
+    {
+        joined.append(joined.empty() ? "" : "\n").append(value);
+    }
+
+    auto row   = cudf::make_column_from_scalar(cudf::string_scalar(joined), 1);
+    auto lists = cudf::strings::split_record(cudf::strings_column_view{row->view()}, cudf::string_scalar("\n"));
+
+    return std::make_unique<cudf::column>(cudf::lists_column_view{lists->view()}.child());
+}
+
+// Replaces the nulls of a boolean column by false
+column_ptr nulls_false(column_ptr mask)
+{
+    if (!mask->has_nulls())
+    {
+        return mask;
+    }
+
+    return cudf::replace_nulls(mask->view(), cudf::numeric_scalar<bool>(false));
+}
+
+column_ptr compare(const cudf::column_view& strings, const std::string& value, cudf::binary_operator op)
+{
+    return nulls_false(
+        cudf::binary_operation(strings, cudf::string_scalar(value), op, cudf::data_type{cudf::type_id::BOOL8}));
+}
+
+column_ptr compare(const cudf::column_view& values, int64_t value, cudf::binary_operator op)
+{
+    return nulls_false(cudf::binary_operation(
+        values, cudf::numeric_scalar<int64_t>(value), op, cudf::data_type{cudf::type_id::BOOL8}));
+}
+
+column_ptr equals(const cudf::column_view& strings, const std::string& value)
+{
+    return compare(strings, value, cudf::binary_operator::EQUAL);
+}
+
+column_ptr contains(const cudf::column_view& strings, const std::string& value)
+{
+    return nulls_false(cudf::strings::contains(cudf::strings_column_view{strings}, cudf::string_scalar(value)));
+}
+
+column_ptr logical_and(const cudf::column_view& lhs, const cudf::column_view& rhs)
+{
+    return cudf::binary_operation(lhs, rhs, cudf::binary_operator::LOGICAL_AND, cudf::data_type{cudf::type_id::BOOL8});
+}
+
+column_ptr logical_and(const cudf::column_view& a, const cudf::column_view& b, const cudf::column_view& c)
+{
+    return logical_and(logical_and(a, b)->view(), c);
+}
+
+// `values` where `mask` is set, and null elsewhere
+column_ptr where(const cudf::column_view& values, const cudf::column_view& mask)
+{
+    auto null_value = cudf::make_default_constructed_scalar(values.type());
+    null_value->set_valid_async(false);
+
+    return cudf::copy_if_else(values, *null_value, mask);
+}
+
+// The strings matched by the single capture group of `pattern`, null where there is no match
+column_ptr extract(const cudf::column_view& strings, const std::string& pattern)
+{
+    auto program   = cudf::strings::regex_program::create(pattern);
+    auto extracted = cudf::strings::extract(cudf::strings_column_view{strings}, *program);
+
+    return std::move(extracted->release()[0]);
+}
+
+// Rows of `table` at the indices of `gather_map`, null where the index is null
+std::unique_ptr<cudf::table> gather_or_null(const cudf::table_view& table, const cudf::column_view& gather_map)
+{
+    // The indices under the nulls are undefined, replace them by an index out of bounds
+    auto indices = cudf::replace_nulls(gather_map, cudf::numeric_scalar<cudf::size_type>(table.num_rows()));
+
+    return cudf::gather(table, indices->view(), cudf::out_of_bounds_policy::NULLIFY);
+}
+
+/**
+ * @brief Whether each of `paths` has a double extension, and the length of the extension, the way the python feature
+ * extractor finds them: paths with at least two dots, one of whose dot separated words other than the last is one of
+ * `extensions`. The length is the number of characters following the first such word and its dot.
+ */
+std::pair<column_ptr, column_ptr> double_extensions(const cudf::column_view& paths,
+                                                    const cudf::column_view& extensions)
+{
+    const auto num_rows   = paths.size();
+    const auto int32_type = cudf::data_type{cudf::type_id::INT32};
+
+    auto words  = cudf::strings::split(cudf::strings_column_view{paths}, cudf::string_scalar("."));
+    auto found  = cudf::make_column_from_scalar(cudf::numeric_scalar<bool>(false), num_rows);
+    auto length = cudf::make_column_from_scalar(cudf::numeric_scalar<int32_t>(0), num_rows);
+
+    if (words->num_columns() > 2)
+    {
+        auto path_length  = cudf::strings::count_characters(cudf::strings_column_view{paths});
+        auto has_two_dots = cudf::is_valid(words->get_column(2).view());
+
+        // Number of characters of the words up to the current one, each followed by its dot
+        auto prefix_length = cudf::make_column_from_scalar(cudf::numeric_scalar<int32_t>(0), num_rows);
+
+        // The last word of a path is never the first extension of a double extension
+        for (cudf::size_type i = 0; i + 1 < words->num_columns(); ++i)
+        {
+            const auto word = words->get_column(i).view();
+
+            auto word_length = cudf::strings::count_characters(cudf::strings_column_view{word});
+            prefix_length    = cudf::binary_operation(
+                prefix_length->view(), word_length->view(), cudf::binary_operator::ADD, int32_type);
+            prefix_length = cudf::binary_operation(
+                prefix_length->view(), cudf::numeric_scalar<int32_t>(1), cudf::binary_operator::ADD, int32_type);
+
+            auto is_extension = nulls_false(cudf::contains(extensions, word));
+            auto not_last     = cudf::is_valid(words->get_column(i + 1).view());
+            auto not_found    = cudf::unary_operation(found->view(), cudf::unary_operator::NOT);
+
+            auto is_candidate = logical_and(is_extension->view(), not_last->view(), has_two_dots->view());
+            auto is_first     = logical_and(is_candidate->view(), not_found->view());
+
+            auto remaining = cudf::binary_operation(
+                path_length->view(), prefix_length->view(), cudf::binary_operator::SUB, int32_type);
+
+            length = cudf::copy_if_else(remaining->view(), length->view(), is_first->view());
+            found  = cudf::binary_operation(found->view(),
+                                           is_first->view(),
+                                           cudf::binary_operator::LOGICAL_OR,
+                                           cudf::data_type{cudf::type_id::BOOL8});
+        }
+    }
+
+    return {cudf::cast(found->view(), int32_type), std::move(length)};
+}
+
+/**
+ * @brief Aggregations of the rows of each process, all of them computed by a single groupby. Each aggregation is
+ * identified by the index returned when adding it.
+ */
+class ProcessAggregations
+{
+  public:
+    // Number of rows matching `mask`
+    std::size_t count(const cudf::column_view& mask)
+    {
+        return this->add(cudf::cast(mask, cudf::data_type{cudf::type_id::INT32}),
+                         cudf::make_sum_aggregation<cudf::groupby_aggregation>());
+    }
+
+    // Number of unique `values` among the rows matching `mask`, nulls counting as one value
+    std::size_t nunique(const cudf::column_view& values, const cudf::column_view& mask)
+    {
+        auto filled = cudf::replace_nulls(values, cudf::string_scalar(MissingValue));
+
+        return this->add(filled->view(), mask, cudf::make_nunique_aggregation<cudf::groupby_aggregation>());
+    }
+
+    // Aggregation of `values` among the rows matching `mask`, null for the processes without such rows
+    std::size_t add(const cudf::column_view& values,
+                    const cudf::column_view& mask,
+                    std::unique_ptr<cudf::groupby_aggregation> aggregation)
+    {
+        return this->add(where(values, mask), std::move(aggregation));
+    }
+
+    std::size_t add(column_ptr values, std::unique_ptr<cudf::groupby_aggregation> aggregation)
+    {
+        m_values.push_back(std::move(values));
+        m_aggregations.push_back(std::move(aggregation));
+
+        return m_values.size() - 1;
+    }
+
+    // Runs the groupby, returning the keys of the processes
+    std::unique_ptr<cudf::table> run(const cudf::table_view& keys)
+    {
+        std::vector<cudf::groupby::aggregation_request> requests(m_values.size());
+        for (std::size_t i = 0; i < m_values.size(); ++i)
+        {
+            requests[i].values = m_values[i]->view();
+            requests[i].aggregations.push_back(std::move(m_aggregations[i]));
+        }
+
+        cudf::groupby::groupby grouper(keys, cudf::null_policy::EXCLUDE);
+        auto [group_keys, results] = grouper.aggregate(requests);
+
+        for (auto& result : results)
+        {
+            m_results.push_back(std::move(result.results[0]));
+        }
+
+        m_values.clear();
+        m_aggregations.clear();
+
+        return std::move(group_keys);
+    }
+
+    // Result of the aggregation `id` once `run`
+    cudf::column_view result(std::size_t id) const
+    {
+        return m_results[id]->view();
+    }
+
+    // Result of the aggregation `id` as float64, zero for the processes without a value
+    column_ptr feature(std::size_t id) const
+    {
+        auto values = cudf::cast(this->result(id), cudf::data_type{cudf::type_id::FLOAT64});
+        return cudf::replace_nulls(values->view(), cudf::numeric_scalar<double>(0));
+    }
+
+  private:
+    std::vector<column_ptr> m_values;
+    std::vector<std::unique_ptr<cudf::groupby_aggregation>> m_aggregations;
+    std::vector<column_ptr> m_results;
+};
+
+/**
+ * @brief Float64 features of the processes by name, computed from the results of their aggregations.
+ */
+class Features
+{
+  public:
+    Features(const ProcessAggregations& aggregations) : m_aggregations(aggregations) {}
+
+    void set(const std::string& name, std::size_t id)
+    {
+        this->set(name, m_aggregations.feature(id));
+    }
+
+    void set(const std::string& name, column_ptr values)
+    {
+        m_features[name] = std::move(values);
+    }
+
+    // `numerator / denominator`, zero when the denominator is. The python stage only divides when the numerator is not
+    // zero, the numerators being counts of a subset of the rows counted by the denominator.
+    void set_ratio(const std::string& name, std::size_t numerator, std::size_t denominator)
+    {
+        this->set_divided(name, numerator, denominator, cudf::binary_operator::NULL_MAX);
+    }
+
+    // `numerator / (denominator + 1)`
+    void set_smoothed_ratio(const std::string& name, std::size_t numerator, std::size_t denominator)
+    {
+        this->set_divided(name, numerator, denominator, cudf::binary_operator::ADD);
+    }
+
+    // Result of the aggregation `id` for the processes where the result `condition` exceeds `threshold`, zero elsewhere
+    void set_if(const std::string& name, std::size_t id, std::size_t condition, int64_t threshold)
+    {
+        auto is_set = compare(m_aggregations.result(condition), threshold, cudf::binary_operator::GREATER);
+        auto zeros  = cudf::make_column_from_scalar(cudf::numeric_scalar<double>(0), is_set->size());
+
+        this->set(name, cudf::copy_if_else(m_aggregations.feature(id)->view(), zeros->view(), is_set->view()));
+    }
+
+    // Releases the features `names` in order, the features which were not computed being zero
+    std::vector<column_ptr> release(const std::vector<std::string>& names, cudf::size_type num_rows)
+    {
+        std::vector<column_ptr> columns;
+        columns.reserve(names.size());
+
+        for (const auto& name : names)
+        {
+            auto found = m_features.find(name);
+            if (found != m_features.end() && found->second != nullptr)
+            {
+                columns.push_back(std::move(found->second));
+            }
+            else
+            {
+                columns.push_back(cudf::make_column_from_scalar(cudf::numeric_scalar<double>(0), num_rows));
+            }
+        }
+
+        return columns;
+    }
+
+  private:
+    // Divides by the denominator combined with one by `op`
+    void set_divided(const std::string& name,
+                     std::size_t numerator,
+                     std::size_t denominator,
+                     cudf::binary_operator op)
+    {
+        const auto float64_type = cudf::data_type{cudf::type_id::FLOAT64};
+
+        auto divisor = cudf::binary_operation(
+            m_aggregations.feature(denominator)->view(), cudf::numeric_scalar<double>(1), op, float64_type);
+
+        this->set(name,
+                  cudf::binary_operation(m_aggregations.feature(numerator)->view(),
+                                         divisor->view(),
+                                         cudf::binary_operator::TRUE_DIV,
+                                         float64_type));
+    }
+
+    const ProcessAggregations& m_aggregations;
+    std::map<std::string, column_ptr> m_features;
+};
+}  // namespace
+
+std::shared_ptr<MessageMeta> create_appshield_features(const std::shared_ptr<MessageMeta>& meta,
+                                                       const std::vector<std::string>& feature_columns,
+                                                       const std::vector<std::string>& file_extns)
+{
+    auto info           = meta->get_info();
+    const auto num_rows = info.num_rows();
+
+    auto sum = []() {
+        return cudf::make_sum_aggregation<cudf::groupby_aggregation>();
+    };
+    auto min = []() {
+        return cudf::make_min_aggregation<cudf::groupby_aggregation>();
+    };
+    auto max = []() {
+        return cudf::make_max_aggregation<cudf::groupby_aggregation>();
+    };
+    auto mean = []() {
+        return cudf::make_mean_aggregation<cudf::groupby_aggregation>();
+    };
+    auto nunique = []() {
+        return cudf::make_nunique_aggregation<cudf::groupby_aggregation>(cudf::null_policy::EXCLUDE);
+    };
+
+    SnapshotColumns columns(info);
+
+    const auto plugin = columns.strings("plugin");
+    auto is_envars    = equals(plugin, "envars");
+    auto is_thread    = equals(plugin, "threadlist");
+    auto is_vad       = equals(plugin, "vadinfo");
+    auto is_handle    = equals(plugin, "handles");
+    auto is_ldr       = equals(plugin, "ldrmodules");
+
+    // Rows are grouped by source, snapshot and process
+    const auto source      = columns.strings("source");
+    const auto snapshot_id = columns.integers("snapshot_id");
+    const auto pid_process = columns.own(cudf::strings::concatenate(
+        cudf::table_view{{columns.strings("PID"), columns.strings("Process")}}, cudf::string_scalar("_")));
+
+    const auto name        = columns.own(cudf::strings::to_lower(cudf::strings_column_view{columns.strings("Name")}));
+    const auto commit      = columns.integers("CommitCharge");
+    const auto tag         = columns.strings("Tag");
+    const auto protection  = columns.strings("Protection");
+    const auto handle_type = columns.strings("Type");
+    const auto row_indices = columns.own(cudf::sequence(num_rows, cudf::numeric_scalar<cudf::size_type>(0)));
+    auto extensions        = make_strings_column(file_extns);
+
+    auto is_partial_commit = compare(commit, FullMemoryAddress, cudf::binary_operator::LESS);
+    auto is_vad_tag        = logical_and(is_vad->view(), equals(tag, "Vad ")->view());
+    auto is_vads_tag       = logical_and(is_vad->view(), equals(tag, "VadS")->view());
+
+    ProcessAggregations aggregations;
+
+    // Envars
+    auto pathext = logical_and(is_envars->view(),
+                               contains(columns.strings("Variable"), "PATHEXT")->view(),
+                               contains(columns.strings("Value"), FileExtensionsExpression)->view());
+    const auto envars_count = aggregations.count(pathext->view());
+
+    // Threadlist
+    const auto state       = columns.strings("State");
+    const auto wait_reason = columns.strings("WaitReason");
+
+    auto is_state_2                = logical_and(is_thread->view(), equals(state, "2")->view());
+    const auto thread_count        = aggregations.count(is_thread->view());
+    const auto thread_state_2      = aggregations.count(is_state_2->view());
+    const auto thread_state_unique = aggregations.nunique(state, is_thread->view());
+    const auto thread_wait_unique  = aggregations.nunique(wait_reason, is_thread->view());
+
+    std::vector<std::size_t> thread_wait_reasons;
+    for (const auto& reason : WaitReasons)
+    {
+        thread_wait_reasons.push_back(
+            aggregations.count(logical_and(is_thread->view(), equals(wait_reason, reason)->view())->view()));
+    }
+
+    // Vadinfo, the commit charge statistics excluding the regions whose whole address range is committed
+    const auto vad_size      = aggregations.count(is_vad->view());
+    const auto vadinfo_size  = aggregations.count(is_vad_tag->view());
+    const auto vadsinfo_size = aggregations.count(is_vads_tag->view());
+    const auto private_memory =
+        aggregations.count(logical_and(is_vad->view(), equals(columns.strings("PrivateMemory"), "1")->view())->view());
+
+    auto vad_commit    = logical_and(is_vad->view(), is_partial_commit->view());
+    const auto cc_mean = aggregations.add(commit, vad_commit->view(), mean());
+    const auto cc_max  = aggregations.add(commit, vad_commit->view(), max());
+    const auto cc_sum  = aggregations.add(commit, vad_commit->view(), sum());
+    const auto cc_len  = aggregations.count(vad_commit->view());
+
+    auto vad_tag_commit    = logical_and(is_vad_tag->view(), is_partial_commit->view());
+    const auto cc_vad_mean = aggregations.add(commit, vad_tag_commit->view(), mean());
+    const auto cc_vad_max  = aggregations.add(commit, vad_tag_commit->view(), max());
+    const auto cc_vad_sum  = aggregations.add(commit, vad_tag_commit->view(), sum());
+
+    auto vads_tag_commit   = logical_and(is_vads_tag->view(), is_partial_commit->view());
+    const auto cc_vads_min = aggregations.add(commit, vads_tag_commit->view(), min());
+    auto is_full_commit     = compare(commit, FullMemoryAddress, cudf::binary_operator::EQUAL);
+    const auto cc_vads_full = aggregations.count(logical_and(is_vads_tag->view(), is_full_commit->view())->view());
+
+    auto noaccess_vad_commit = logical_and(vad_tag_commit->view(), equals(protection, "PAGE_NOACCESS ")->view());
+    const auto cc_noaccess_vad_min  = aggregations.add(commit, noaccess_vad_commit->view(), min());
+    const auto cc_noaccess_vad_mean = aggregations.add(commit, noaccess_vad_commit->view(), mean());
+
+    // Aggregations of the vadinfo rows of each memory protection
+    struct ProtectionAggregations
+    {
+        std::size_t size;
+        std::size_t vad_size;
+        std::size_t vads_size;
+        std::size_t cc_mean;
+        std::size_t cc_min;
+        std::size_t cc_max;
+        std::size_t cc_sum;
+        std::size_t cc_std;
+    };
+
+    std::map<std::string, ProtectionAggregations> protections;
+    for (const auto& [value, prefix] : Protections)
+    {
+        auto is_protection = logical_and(is_vad->view(), equals(protection, value)->view());
+        auto cc            = logical_and(is_protection->view(), is_partial_commit->view());
+
+        protections[prefix] = ProtectionAggregations{
+            aggregations.count(is_protection->view()),
+            aggregations.count(logical_and(is_protection->view(), is_vad_tag->view())->view()),
+            aggregations.count(logical_and(is_protection->view(), is_vads_tag->view())->view()),
+            aggregations.add(commit, cc->view(), mean()),
+            aggregations.add(commit, cc->view(), min()),
+            aggregations.add(commit, cc->view(), max()),
+            aggregations.add(commit, cc->view(), sum()),
+            aggregations.add(commit, cc->view(), cudf::make_std_aggregation<cudf::groupby_aggregation>(0))};
+    }
+
+    const auto vad_file        = columns.strings("File");
+    const auto vad_path_unique = aggregations.nunique(vad_file, is_vad->view());
+
+    auto is_vad_file   = compare(vad_file, "N/A", cudf::binary_operator::NOT_EQUAL);
+    auto vad_files     = logical_and(is_vad->view(), is_vad_file->view());
+    auto vad_lowered   = cudf::strings::to_lower(cudf::strings_column_view{vad_file});
+    auto vad_extension = extract(vad_lowered->view(), R"((\.[^.]*)$)");
+    const auto vad_extension_unique = aggregations.add(vad_extension->view(), vad_files->view(), nunique());
+
+    // Handles, the file paths being the lower case names of the file handles
+    const auto handle_count       = aggregations.count(is_handle->view());
+    const auto handle_name_unique = aggregations.nunique(name, is_handle->view());
+    const auto handle_type_unique = aggregations.nunique(handle_type, is_handle->view());
+
+    std::vector<std::pair<std::string, std::size_t>> handle_type_counts;
+    for (const auto& [value, id] : CountedHandleTypes)
+    {
+        handle_type_counts.emplace_back(
+            id, aggregations.count(logical_and(is_handle->view(), equals(handle_type, value)->view())->view()));
+    }
+
+    std::vector<std::pair<std::string, std::size_t>> handle_type_ratios;
+    for (const auto& [value, id] : RatioHandleTypes)
+    {
+        handle_type_ratios.emplace_back(
+            id, aggregations.count(logical_and(is_handle->view(), equals(handle_type, value)->view())->view()));
+    }
+
+    auto is_file_path = logical_and(is_handle->view(),
+                                    equals(handle_type, "File")->view(),
+                                    compare(name, "", cudf::binary_operator::NOT_EQUAL)->view());
+    auto file_paths   = where(name, is_file_path->view());
+
+    auto [has_double_extension, double_extension_length] = double_extensions(file_paths->view(), extensions->view());
+    const auto double_extension_count = aggregations.add(std::move(has_double_extension), sum());
+    const auto double_extension_max   = aggregations.add(std::move(double_extension_length), max());
+
+    auto file_extension   = extract(file_paths->view(), R"(\.([^.]*)$)");
+    auto is_doc_extension = nulls_false(cudf::contains(extensions->view(), file_extension->view()));
+    const auto doc_files  = aggregations.count(is_doc_extension->view());
+    const auto file_extension_unique = aggregations.add(std::move(file_extension), nunique());
+
+    // Paths of at least four backslash separated parts, the fifth part holding the remainder of the path
+    auto parts = cudf::strings::split(cudf::strings_column_view{file_paths->view()}, cudf::string_scalar("\\"), 4);
+    auto is_split_path = parts->num_columns() > 3
+                             ? cudf::is_valid(parts->get_column(3).view())
+                             : cudf::make_column_from_scalar(cudf::numeric_scalar<bool>(false), num_rows);
+    const auto split_path_count = aggregations.count(is_split_path->view());
+
+    auto directory              = extract(file_paths->view(), R"(^(.*)\\.*)");
+    const auto directory_unique = aggregations.nunique(directory->view(), is_file_path->view());
+
+    auto is_users_path   = cudf::make_column_from_scalar(cudf::numeric_scalar<bool>(false), num_rows);
+    auto is_windows_path = cudf::make_column_from_scalar(cudf::numeric_scalar<bool>(false), num_rows);
+    if (parts->num_columns() > 4)
+    {
+        auto is_disk_path = logical_and(cudf::is_valid(parts->get_column(4).view())->view(),
+                                        equals(parts->get_column(1).view(), "device")->view(),
+                                        contains(parts->get_column(2).view(), "harddisk")->view());
+
+        is_users_path   = logical_and(is_disk_path->view(), contains(parts->get_column(3).view(), "users")->view());
+        is_windows_path = logical_and(is_disk_path->view(), contains(parts->get_column(3).view(), "windows")->view());
+    }
+
+    const auto users_count   = aggregations.count(is_users_path->view());
+    const auto windows_count = aggregations.count(is_windows_path->view());
+
+    // Ldrmodules, the first module whose lower case name contains the name of its process
+    auto process_name      = cudf::strings::to_lower(cudf::strings_column_view{columns.strings("Process")});
+    auto position          = cudf::strings::find(cudf::strings_column_view{name},
+                                        cudf::strings_column_view{process_name->view()});
+    auto is_process_module = logical_and(is_ldr->view(),
+                                         compare(position->view(), 0, cudf::binary_operator::GREATER_EQUAL)->view());
+
+    const auto ldr_count  = aggregations.count(is_ldr->view());
+    const auto ldr_module = aggregations.add(row_indices, is_process_module->view(), min());
+
+    auto process_keys     = aggregations.run(cudf::table_view{{source, snapshot_id, pid_process}});
+    const auto num_groups = process_keys->num_rows();
+
+    Features features(aggregations);
+
+    features.set("envirs_pathext",
+                 cudf::cast(compare(aggregations.result(envars_count), 0, cudf::binary_operator::GREATER)->view(),
+                            cudf::data_type{cudf::type_id::FLOAT64}));
+
+    features.set("threadlist_df_count", thread_count);
+    features.set("threadlist_df_state_2", thread_state_2);
+    features.set("threadlist_df_state_unique", thread_state_unique);
+    features.set("threadlist_df_wait_reason_unique", thread_wait_unique);
+    for (std::size_t i = 0; i < WaitReasons.size(); ++i)
+    {
+        features.set("threadlist_df_wait_reason_" + WaitReasons[i], thread_wait_reasons[i]);
+    }
+
+    features.set("vad_count", vadinfo_size);
+    features.set("vads_count", vadsinfo_size);
+    features.set("count_private_memory", private_memory);
+    features.set_ratio("ratio_private_memory", private_memory, vad_size);
+    features.set_ratio("vad_ratio", vadinfo_size, vad_size);
+
+    features.set("get_commit_charge_mean", cc_mean);
+    features.set("get_commit_charge_max", cc_max);
+    features.set("get_commit_charge_sum", cc_sum);
+    features.set("get_commit_charge_len", cc_len);
+    features.set("get_commit_charge_mean_vad", cc_vad_mean);
+    features.set("get_commit_charge_max_vad", cc_vad_max);
+    features.set("get_commit_charge_sum_vad", cc_vad_sum);
+    features.set("get_commit_charge_min_vads", cc_vads_min);
+    features.set("count_entire_commit_charge_vads", cc_vads_full);
+    features.set("get_commit_charge_min_vad_page_noaccess", cc_noaccess_vad_min);
+    features.set("get_commit_charge_mean_vad_page_noaccess", cc_noaccess_vad_mean);
+
+    // Every statistic of each protection, those the model was not trained on are dropped by `release`
+    for (const auto& [prefix, protection_ids] : protections)
+    {
+        features.set("get_commit_charge_mean_" + prefix, protection_ids.cc_mean);
+        features.set("get_commit_charge_min_" + prefix, protection_ids.cc_min);
+        features.set("get_commit_charge_max_" + prefix, protection_ids.cc_max);
+        features.set("get_commit_charge_sum_" + prefix, protection_ids.cc_sum);
+        features.set("get_commit_charge_std_" + prefix, protection_ids.cc_std);
+        features.set(prefix + "_count", protection_ids.size);
+        features.set(prefix + "_vads_count", protection_ids.vads_size);
+        features.set(prefix + "_vad_count", protection_ids.vad_size);
+        features.set_ratio(prefix + "_ratio", protection_ids.size, vad_size);
+        features.set_ratio(prefix + "_vads_ratio", protection_ids.vads_size, vadsinfo_size);
+        features.set_ratio(prefix + "_vad_ratio", protection_ids.vad_size, vadinfo_size);
+    }
+
+    features.set_smoothed_ratio(
+        "vads_page_execute_writecopy_ratio", vadsinfo_size, protections["page_execute_writecopy"].size);
+    features.set("vadinfo_df_path_unique", vad_path_unique);
+    features.set("get_count_unique_extensions", vad_extension_unique);
+
+    features.set("handles_df_count", handle_count);
+    features.set("handles_df_name_unique", handle_name_unique);
+    features.set_smoothed_ratio("handles_df_name_unique_ratio", handle_name_unique, handle_count);
+    features.set("handles_df_type_unique", handle_type_unique);
+    features.set_smoothed_ratio("handles_df_type_unique_ratio", handle_type_unique, handle_count);
+
+    for (const auto& [id, count] : handle_type_counts)
+    {
+        features.set("handles_df_" + id + "_count", count);
+        features.set_smoothed_ratio("handles_df_" + id + "_ratio", count, handle_count);
+    }
+
+    for (const auto& [id, count] : handle_type_ratios)
+    {
+        features.set_smoothed_ratio("handles_df_" + id + "_ratio", count, handle_count);
+    }
+
+    features.set("count_double_extension_count_handles", double_extension_count);
+    features.set("double_extension_len_handles", double_extension_max);
+    features.set("check_doc_file_handle_count", doc_files);
+    features.set("count_extension_handles_uniques", file_extension_unique);
+
+    // As in the python stage, the paths of the users and windows directories are only counted past three split paths
+    features.set_if("count_directories_handles_uniques", directory_unique, split_path_count, 0);
+    features.set_if("file_users_exists", users_count, split_path_count, 3);
+    features.set_if("file_windows_count", windows_count, split_path_count, 3);
+
+    // Size of the module named after the process, in hexadecimal
+    auto process_module = gather_or_null(cudf::table_view{{columns.strings("Size"), columns.strings("Path")}},
+                                         aggregations.result(ldr_module));
+
+    auto upper_size  = cudf::strings::to_upper(cudf::strings_column_view{process_module->get_column(0).view()});
+    auto hex_size    = cudf::strings::replace(
+        cudf::strings_column_view{upper_size->view()}, cudf::string_scalar("0X"), cudf::string_scalar(""));
+    auto module_size = cudf::strings::hex_to_integers(cudf::strings_column_view{hex_size->view()},
+                                                      cudf::data_type{cudf::type_id::INT64});
+    auto module_size_float = cudf::cast(module_size->view(), cudf::data_type{cudf::type_id::FLOAT64});
+    features.set("ldrmodules_df_size_int",
+                 cudf::replace_nulls(module_size_float->view(), cudf::numeric_scalar<double>(0)));
+
+    auto feature_values = features.release(feature_columns, num_groups);
+
+    // Timestamp of each process, that of the first ldrmodules row of its snapshot
+    auto ldr_rows = where(row_indices, is_ldr->view());
+
+    std::vector<cudf::groupby::aggregation_request> snapshot_requests(1);
+    snapshot_requests[0].values = ldr_rows->view();
+    snapshot_requests[0].aggregations.push_back(min());
+
+    cudf::groupby::groupby snapshot_grouper(cudf::table_view{{source, snapshot_id}}, cudf::null_policy::EXCLUDE);
+    auto [snapshot_keys, snapshot_results] = snapshot_grouper.aggregate(snapshot_requests);
+
+    auto key_columns           = process_keys->release();
+    auto [left_map, right_map] = cudf::left_join(
+        cudf::table_view{{key_columns[0]->view(), key_columns[1]->view()}}, snapshot_keys->view());
+
+    // Every snapshot of a process has a row, the joined rows being those of the processes in another order
+    auto snapshot_ldr_rows = cudf::gather(cudf::table_view{{snapshot_results[0].results[0]->view()}},
+                                          cudf::column_view{cudf::device_span<const cudf::size_type>{*right_map}},
+                                          cudf::out_of_bounds_policy::NULLIFY);
+    auto timestamps = gather_or_null(cudf::table_view{{columns.strings("timestamp")}},
+                                     snapshot_ldr_rows->get_column(0).view());
+
+    auto source_pid_process = cudf::strings::concatenate(
+        cudf::table_view{{key_columns[0]->view(), key_columns[2]->view()}}, cudf::string_scalar("_"));
+
+    std::vector<cudf::column_view> process_views;
+    for (const auto& column : feature_values)
+    {
+        process_views.push_back(column->view());
+    }
+
+    process_views.push_back(key_columns[2]->view());
+    process_views.push_back(key_columns[1]->view());
+    process_views.push_back(source_pid_process->view());
+    process_views.push_back(key_columns[0]->view());
+
+    auto processes = cudf::gather(cudf::table_view{process_views},
+                                  cudf::column_view{cudf::device_span<const cudf::size_type>{*left_map}});
+
+    // Sorted by source, pid_process and snapshot_id, the trailing source column only being a sort key
+    const auto num_features = feature_columns.size();
+    const auto joined       = processes->view();
+
+    std::vector<cudf::column_view> output_views(joined.begin(), joined.begin() + num_features + 2);
+    output_views.push_back(timestamps->get_column(0).view());
+    output_views.push_back(joined.column(num_features + 2));
+
+    auto sorted = cudf::sort_by_key(
+        cudf::table_view{output_views},
+        cudf::table_view{
+            {joined.column(num_features + 3), joined.column(num_features), joined.column(num_features + 1)}});
+
+    std::vector<std::string> column_names(feature_columns);
+    column_names.insert(column_names.end(), {"pid_process", "snapshot_id", "timestamp", "source_pid_process"});
+
+    cudf::io::table_metadata metadata;
+    for (auto& column_name : column_names)
+    {
+        metadata.schema_info.emplace_back(std::move(column_name));
+    }
+
+    return MessageMeta::create_from_cpp(cudf::io::table_with_metadata{std::move(sorted), std::move(metadata)}, 0);
+}
+
+// ************ AppShieldFeaturesStage **************************** //
+AppShieldFeaturesStage::AppShieldFeaturesStage(std::vector<std::string> feature_columns,
+                                               std::vector<std::string> file_extns) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_feature_columns(std::move(feature_columns)),
+  m_file_extns(std::move(file_extns))
+{}
+
+AppShieldFeaturesStage::subscribe_fn_t AppShieldFeaturesStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                auto features = create_appshield_features(x, m_feature_columns, m_file_extns);
+
+                MORPHEUS_TRACE("appshield_features.create", x->count(), features->count());
+                DVLOG(10) << "AppShield features complete. Input: " << x->count()
+                          << " rows. Output: " << features->count() << " processes";
+
+                output.on_next(std::move(features));
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&output]() {
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ AppShieldFeaturesStageInterfaceProxy **************** //
+std::shared_ptr<mrc::segment::Object<AppShieldFeaturesStage>> AppShieldFeaturesStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::vector<std::string> feature_columns,
+    std::vector<std::string> file_extns)
+{
+    return builder.construct_object<AppShieldFeaturesStage>(name, std::move(feature_columns), std::move(file_extns));
+}
+}  // namespace morpheus
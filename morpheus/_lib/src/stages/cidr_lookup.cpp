@@ -0,0 +1,477 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/cidr_lookup.hpp"  // IWYU pragma: associated
+
+#include "morpheus/io/deserializers.hpp"        // for load_table_from_file
+#include "morpheus/utilities/matx_util.hpp"     // for MatxUtil
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/table_util.hpp"    // for CuDFTableUtil
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <arpa/inet.h>     // for inet_pton
+#include <cuda_runtime.h>  // for cudaMemcpy, cudaMemcpyHostToDevice
+#include <cudf/column/column.hpp>
+#include <cudf/copying.hpp>    // for gather
+#include <cudf/io/types.hpp>   // for table_with_metadata
+#include <cudf/null_mask.hpp>  // for copy_bitmask
+#include <cudf/strings/convert/convert_ipv4.hpp>
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/transform.hpp>  // for bools_to_mask
+#include <cudf/unary.hpp>      // for cast, bit_cast
+#include <cudf/utilities/default_stream.hpp>
+#include <cudf/utilities/span.hpp>    // for device_span
+#include <cudf/utilities/traits.hpp>  // for is_integral
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <rmm/device_buffer.hpp>
+
+#include <algorithm>  // for find, stable_sort
+#include <exception>
+#include <iterator>   // for distance
+#include <limits>     // for numeric_limits
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <utility>    // for move, pair
+
+namespace morpheus {
+namespace {
+
+using address_t = unsigned __int128;
+
+// Parses an IPv4 or IPv6 network in CIDR notation into its first and last addresses, IPv4 networks being mapped into
+// ::ffff:0:0/96, a bare address holding only itself
+std::pair<address_t, address_t> parse_network(const std::string& network)
+{
+    const auto separator = network.find('/');
+    const auto address   = network.substr(0, separator);
+
+    uint8_t bytes[16]{};
+    int max_length;
+    if (inet_pton(AF_INET, address.c_str(), bytes + 12) == 1)
+    {
+        bytes[10]  = 0xFF;
+        bytes[11]  = 0xFF;
+        max_length = 32;
+    }
+    else if (inet_pton(AF_INET6, address.c_str(), bytes) == 1)
+    {
+        max_length = 128;
+    }
+    else
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Invalid network '" << network << "'"));
+    }
+
+    int length = max_length;
+    if (separator != std::string::npos)
+    {
+        const auto length_str = network.substr(separator + 1);
+        std::size_t parsed    = 0;
+        try
+        {
+            length = std::stoi(length_str, &parsed);
+        } catch (const std::exception&)
+        {
+            parsed = 0;
+        }
+
+        if (parsed == 0 || parsed != length_str.size() || length < 0 || length > max_length)
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("Invalid prefix length of network '" << network << "'"));
+        }
+    }
+
+    address_t first = 0;
+    for (const auto byte : bytes)
+    {
+        first = (first << 8) | byte;
+    }
+
+    // Host bits of the prefix, counted from the end of the address such that IPv4 networks keep their mapped prefix
+    const int host_bits = max_length - length;
+    const address_t host_mask =
+        host_bits == 0 ? 0 : (host_bits == 128 ? ~address_t{0} : (address_t{1} << host_bits) - 1);
+
+    first &= ~host_mask;
+
+    return {first, first | host_mask};
+}
+
+struct Network
+{
+    address_t first;
+    address_t last;
+    int32_t row;
+};
+
+/**
+ * @brief Flattens the networks into disjoint ranges, each mapped to the row of the most specific network holding it.
+ * Networks are either nested or disjoint, such that sorting them by first address, then outer ones first, lets a
+ * stack hold the networks holding the current address, the innermost on top.
+ */
+std::vector<Network> flatten_networks(std::vector<Network> networks)
+{
+    std::stable_sort(networks.begin(), networks.end(), [](const Network& lhs, const Network& rhs) {
+        return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.last > rhs.last);
+    });
+
+    std::vector<Network> ranges;
+    std::vector<Network> stack;
+
+    // First address not yet covered by a range, unset once the last address was covered
+    address_t cursor = 0;
+    bool has_cursor  = true;
+
+    auto emit = [&](address_t last, int32_t row) {
+        if (has_cursor && cursor <= last)
+        {
+            ranges.push_back({cursor, last, row});
+            has_cursor = last != std::numeric_limits<address_t>::max();
+            cursor     = last + 1;
+        }
+    };
+
+    for (const auto& network : networks)
+    {
+        // Networks ending before this one are done with
+        while (!stack.empty() && stack.back().last < network.first)
+        {
+            emit(stack.back().last, stack.back().row);
+            stack.pop_back();
+        }
+
+        if (!stack.empty() && network.first > 0)
+        {
+            emit(network.first - 1, stack.back().row);
+        }
+
+        cursor     = network.first;
+        has_cursor = true;
+        stack.push_back(network);
+    }
+
+    while (!stack.empty())
+    {
+        emit(stack.back().last, stack.back().row);
+        stack.pop_back();
+    }
+
+    return ranges;
+}
+
+// Copies the (low, high) words of `addresses` to the device
+rmm::device_uvector<uint64_t> copy_addresses_to_device(const std::vector<address_t>& addresses)
+{
+    std::vector<uint64_t> words;
+    words.reserve(addresses.size() * 2);
+    for (const auto address : addresses)
+    {
+        words.push_back(static_cast<uint64_t>(address));
+        words.push_back(static_cast<uint64_t>(address >> 64));
+    }
+
+    rmm::device_uvector<uint64_t> device_words(words.size(), cudf::get_default_stream());
+    MRC_CHECK_CUDA(
+        cudaMemcpy(device_words.data(), words.data(), words.size() * sizeof(uint64_t), cudaMemcpyHostToDevice));
+
+    return device_words;
+}
+
+cudf::size_type find_column(const std::vector<std::string>& names, const std::string& name, const std::string& where)
+{
+    auto found = std::find(names.begin(), names.end(), name);
+    if (found == names.end())
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to find the column '" << name << "' in " << where));
+    }
+
+    return static_cast<cudf::size_type>(std::distance(names.begin(), found));
+}
+
+}  // namespace
+
+// ************ NetworkTable ************* //
+NetworkTable::NetworkTable(const std::string& filename,
+                           FileTypes file_type,
+                           const std::string& network_column,
+                           std::vector<std::string> label_columns) :
+  m_label_columns(std::move(label_columns)),
+  m_range_firsts(0, cudf::get_default_stream()),
+  m_range_lasts(0, cudf::get_default_stream()),
+  m_range_rows(0, cudf::get_default_stream())
+{
+    auto loaded = load_table_from_file(filename, file_type);
+
+    std::vector<std::string> names;
+    for (const auto& info : loaded.metadata.schema_info)
+    {
+        names.push_back(info.name);
+    }
+
+    const auto network_index = find_column(names, network_column, filename);
+    const auto networks      = loaded.tbl->get_column(network_index).view();
+    if (networks.type().id() != cudf::type_id::STRING || networks.has_nulls())
+    {
+        throw std::invalid_argument(
+            MORPHEUS_CONCAT_STR("The column '" << network_column << "' must hold networks in CIDR notation"));
+    }
+
+    if (m_label_columns.empty())
+    {
+        for (const auto& name : names)
+        {
+            if (name != network_column)
+            {
+                m_label_columns.push_back(name);
+            }
+        }
+    }
+
+    std::vector<cudf::size_type> label_indices;
+    for (const auto& label_column : m_label_columns)
+    {
+        label_indices.push_back(find_column(names, label_column, filename));
+    }
+
+    m_labels = std::make_unique<cudf::table>(loaded.tbl->view().select(label_indices));
+
+    std::vector<Network> parsed;
+    const auto values = CuDFTableUtil::copy_strings_to_host(networks);
+    for (std::size_t row = 0; row < values.size(); ++row)
+    {
+        auto [first, last] = parse_network(values[row]);
+        parsed.push_back({first, last, static_cast<int32_t>(row)});
+    }
+
+    m_num_networks = static_cast<cudf::size_type>(parsed.size());
+
+    const auto ranges = flatten_networks(std::move(parsed));
+
+    std::vector<address_t> firsts;
+    std::vector<address_t> lasts;
+    std::vector<int32_t> rows;
+    for (const auto& range : ranges)
+    {
+        firsts.push_back(range.first);
+        lasts.push_back(range.last);
+        rows.push_back(range.row);
+    }
+
+    m_range_firsts = copy_addresses_to_device(firsts);
+    m_range_lasts  = copy_addresses_to_device(lasts);
+    m_range_rows   = rmm::device_uvector<int32_t>(rows.size(), cudf::get_default_stream());
+    MRC_CHECK_CUDA(cudaMemcpy(m_range_rows.data(), rows.data(), rows.size() * sizeof(int32_t), cudaMemcpyHostToDevice));
+
+    DVLOG(10) << "Loaded " << m_num_networks << " networks from '" << filename << "' into " << ranges.size()
+              << " ranges";
+}
+
+std::unique_ptr<cudf::table> NetworkTable::lookup(const cudf::column_view& addresses) const
+{
+    const auto stream = cudf::get_default_stream();
+
+    // Owners of the converted addresses and of their validity
+    std::unique_ptr<cudf::column> converted;
+    rmm::device_buffer null_mask;
+
+    const uint64_t* words = nullptr;
+    bool ipv4             = true;
+    if (addresses.type().id() == cudf::type_id::STRING)
+    {
+        // Rows which are not IPv4 addresses, including IPv6 ones, are left unresolved
+        const cudf::strings_column_view strings{addresses};
+        auto is_ipv4 = cudf::strings::is_ipv4(strings);
+        null_mask    = std::move(*cudf::bools_to_mask(is_ipv4->view()).first);
+
+        converted = cudf::strings::ipv4_to_integers(strings);
+        words     = reinterpret_cast<const uint64_t*>(converted->view().data<int64_t>());
+    }
+    else if (addresses.type().id() == cudf::type_id::DECIMAL128)
+    {
+        words = reinterpret_cast<const uint64_t*>(addresses.data<__int128_t>());
+        ipv4  = false;
+    }
+    else if (cudf::is_integral(addresses.type()) && addresses.type().id() != cudf::type_id::BOOL8)
+    {
+        // Signed 32-bit addresses are reinterpreted rather than sign extended
+        auto view = addresses;
+        if (view.type().id() == cudf::type_id::INT32)
+        {
+            view = cudf::bit_cast(view, cudf::data_type{cudf::type_id::UINT32});
+        }
+
+        converted = cudf::cast(view, cudf::data_type{cudf::type_id::UINT64});
+        words     = converted->view().data<uint64_t>();
+    }
+    else
+    {
+        throw std::invalid_argument("Addresses must be IPv4 strings, integer IPv4 addresses or 128-bit addresses");
+    }
+
+    if (addresses.type().id() != cudf::type_id::STRING && addresses.nullable())
+    {
+        null_mask = cudf::copy_bitmask(addresses);
+    }
+
+    const auto num_addresses = addresses.size();
+    rmm::device_uvector<int32_t> rows(num_addresses, stream);
+    MatxUtil::lookup_address_ranges(words,
+                                    ipv4,
+                                    null_mask.is_empty() ? nullptr : static_cast<const uint32_t*>(null_mask.data()),
+                                    num_addresses,
+                                    m_range_firsts.data(),
+                                    m_range_lasts.data(),
+                                    m_range_rows.data(),
+                                    static_cast<TensorIndex>(m_range_rows.size()),
+                                    m_labels->num_rows(),
+                                    rows.data(),
+                                    stream);
+
+    // Unresolved addresses are out of bounds, gathered as nulls
+    cudf::column_view gather_map{cudf::device_span<const int32_t>{rows}};
+
+    return cudf::gather(m_labels->view(), gather_map, cudf::out_of_bounds_policy::NULLIFY);
+}
+
+const std::vector<std::string>& NetworkTable::label_columns() const
+{
+    return m_label_columns;
+}
+
+cudf::size_type NetworkTable::num_networks() const
+{
+    return m_num_networks;
+}
+
+std::size_t NetworkTable::num_ranges() const
+{
+    return m_range_rows.size();
+}
+
+// ************ CidrLookupStage ************* //
+CidrLookupStage::CidrLookupStage(const std::string& filename,
+                                 FileTypes file_type,
+                                 const std::string& network_column,
+                                 std::vector<std::string> label_columns,
+                                 std::vector<std::string> address_columns) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_table(filename, file_type, network_column, std::move(label_columns)),
+  m_address_columns(std::move(address_columns))
+{
+    if (m_address_columns.empty())
+    {
+        throw std::invalid_argument("The CIDR lookup requires at least one address column");
+    }
+}
+
+std::shared_ptr<MessageMeta> CidrLookupStage::label(const std::shared_ptr<MessageMeta>& meta) const
+{
+    auto info               = meta->get_info();
+    const auto column_names = info.get_column_names();
+
+    std::vector<std::string> appended_names;
+    std::vector<std::unique_ptr<cudf::column>> appended;
+    for (const auto& address_column : m_address_columns)
+    {
+        auto labels = m_table.lookup(info.get_column(find_column(column_names, address_column, "the payload")));
+        for (auto& column : labels->release())
+        {
+            appended.push_back(std::move(column));
+        }
+
+        for (const auto& label_column : m_table.label_columns())
+        {
+            appended_names.push_back(address_column + "_" + label_column);
+        }
+    }
+
+    // The index and the columns of the payload, less those replaced by the labels, followed by the labels
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    cudf::io::table_with_metadata labelled;
+    const auto view = info.get_view();
+    for (cudf::size_type i = 0; i < info.num_indices(); ++i)
+    {
+        columns.push_back(std::make_unique<cudf::column>(view.column(i)));
+    }
+    for (const auto& name : info.get_index_names())
+    {
+        labelled.metadata.schema_info.emplace_back(name);
+    }
+
+    for (cudf::size_type i = 0; i < info.num_columns(); ++i)
+    {
+        if (std::find(appended_names.begin(), appended_names.end(), column_names[i]) == appended_names.end())
+        {
+            columns.push_back(std::make_unique<cudf::column>(info.get_column(i)));
+            labelled.metadata.schema_info.emplace_back(column_names[i]);
+        }
+    }
+
+    for (std::size_t i = 0; i < appended.size(); ++i)
+    {
+        columns.push_back(std::move(appended[i]));
+        labelled.metadata.schema_info.emplace_back(appended_names[i]);
+    }
+
+    labelled.tbl = std::make_unique<cudf::table>(std::move(columns));
+
+    return MessageMeta::create_from_cpp(std::move(labelled), info.num_indices());
+}
+
+CidrLookupStage::subscribe_fn_t CidrLookupStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                auto payload = x->payload();
+                if (payload == nullptr)
+                {
+                    throw std::runtime_error("CIDR lookup requires a control message with a payload");
+                }
+
+                auto labelled = label(payload);
+                MORPHEUS_TRACE("cidr_lookup.label", payload->count(), labelled->count());
+                x->payload(labelled);
+
+                output.on_next(std::move(x));
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&output]() {
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ CidrLookupStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<CidrLookupStage>> CidrLookupStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    const std::string& filename,
+    FileTypes file_type,
+    const std::string& network_column,
+    std::vector<std::string> label_columns,
+    std::vector<std::string> address_columns)
+{
+    return builder.construct_object<CidrLookupStage>(
+        name, filename, file_type, network_column, std::move(label_columns), std::move(address_columns));
+}
+
+}  // namespace morpheus
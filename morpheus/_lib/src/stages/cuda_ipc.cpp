@@ -0,0 +1,308 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/cuda_ipc.hpp"  // IWYU pragma: associated
+
+#include "morpheus/messages/memory/tensor_memory.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/objects/dtype.hpp"
+#include "morpheus/objects/tensor.hpp"  // for Tensor::create
+#include "morpheus/objects/tensor_object.hpp"
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cuda_runtime.h>             // for cudaMemcpyAsync
+#include <cudf/contiguous_split.hpp>  // for pack, unpack
+#include <cudf/io/types.hpp>          // for table_with_metadata
+#include <cudf/table/table.hpp>
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <nlohmann/json.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstdint>  // for uint8_t
+#include <exception>
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move, pair
+#include <vector>
+
+namespace morpheus {
+// Component public implementations
+// ************ CudaIpcSinkStage ************************* //
+CudaIpcSinkStage::CudaIpcSinkStage(std::string ring_name,
+                                   std::size_t num_slots,
+                                   std::size_t max_header_bytes,
+                                   std::chrono::milliseconds close_timeout) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_ring_name(std::move(ring_name)),
+  m_num_slots(num_slots),
+  m_max_header_bytes(max_header_bytes),
+  m_close_timeout(close_timeout)
+{
+    if (m_num_slots == 0)
+    {
+        throw std::invalid_argument("num_slots must be greater than 0");
+    }
+}
+
+CudaIpcRing& CudaIpcSinkStage::ring()
+{
+    if (m_ring == nullptr)
+    {
+        m_ring = CudaIpcRing::create(m_ring_name, m_num_slots, m_max_header_bytes);
+    }
+
+    return *m_ring;
+}
+
+void CudaIpcSinkStage::push(std::shared_ptr<ControlMessage> message, const CudaIpcRing::stop_fn_t& should_stop)
+{
+    auto& ring   = this->ring();
+    auto header  = nlohmann::json{{"config", message->to_config()}};
+    auto payload = message->payload();
+    auto tensors = message->tensors();
+
+    // Holds the packed columns and the tensors until the consumer releases the message
+    auto packed = std::make_shared<cudf::packed_columns>();
+
+    std::vector<CudaIpcBuffer> buffers;
+    if (payload != nullptr)
+    {
+        auto info = payload->get_info();
+        *packed   = cudf::pack(info.get_view());
+
+        header["payload"] = {{"index_names", info.get_index_names()},
+                             {"column_names", info.get_column_names()},
+                             {"metadata", nlohmann::json::binary(std::move(*packed->metadata))}};
+        buffers.push_back({packed->gpu_data->data(), packed->gpu_data->size()});
+    }
+
+    if (tensors != nullptr)
+    {
+        // The tensors may still be written by a stream of an upstream stage
+        tensors->synchronize_event();
+
+        auto tensor_headers = nlohmann::json::array();
+        for (const auto& name : tensors->tensor_names())
+        {
+            const auto& tensor = tensors->get_tensor(name);
+            if (!tensor.is_compact())
+            {
+                throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+                    "Unable to export the tensor '" << name << "', only compact tensors are exported"));
+            }
+
+            tensor_headers.push_back({{"name", name},
+                                      {"dtype", tensor.dtype().type_str()},
+                                      {"shape", tensor.get_shape()},
+                                      {"strides", tensor.get_stride()}});
+            buffers.push_back({tensor.data(), tensor.bytes()});
+        }
+
+        header["tensors"] = {{"count", tensors->count}, {"tensors", std::move(tensor_headers)}};
+    }
+
+    // The consumer reads the buffers on its own streams
+    cudf::get_default_stream().synchronize();
+
+    const auto header_bytes = nlohmann::json::to_msgpack(header);
+    const auto num_buffers  = buffers.size();
+
+    auto owner = std::make_shared<std::pair<std::shared_ptr<cudf::packed_columns>, std::shared_ptr<ControlMessage>>>(
+        std::move(packed), std::move(message));
+
+    if (ring.push(header_bytes, buffers, std::move(owner), should_stop))
+    {
+        MORPHEUS_TRACE("cuda_ipc_sink.push", header_bytes.size(), num_buffers);
+    }
+}
+
+CudaIpcSinkStage::subscribe_fn_t CudaIpcSinkStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        CudaIpcRing::stop_fn_t should_stop = [&output]() {
+            return !output.is_subscribed();
+        };
+
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output, should_stop](sink_type_t x) {
+                try
+                {
+                    this->push(x, should_stop);
+                } catch (...)
+                {
+                    output.on_error(std::current_exception());
+                    return;
+                }
+
+                output.on_next(std::move(x));
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [this, &output]() {
+                try
+                {
+                    this->ring().close(m_close_timeout);
+                    m_ring.reset();
+                } catch (...)
+                {
+                    output.on_error(std::current_exception());
+                    return;
+                }
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ CudaIpcSourceStage ************************* //
+CudaIpcSourceStage::CudaIpcSourceStage(std::string ring_name, std::chrono::milliseconds open_timeout) :
+  PythonSource(build()),
+  m_ring_name(std::move(ring_name)),
+  m_open_timeout(open_timeout)
+{}
+
+std::shared_ptr<ControlMessage> CudaIpcSourceStage::import_message(const CudaIpcMessage& exported)
+{
+    const auto header = nlohmann::json::from_msgpack(exported.header);
+
+    auto message      = std::make_shared<ControlMessage>(header.at("config"));
+    auto stream       = cudf::get_default_stream();
+    std::size_t index = 0;
+
+    if (header.contains("payload"))
+    {
+        const auto& payload_header = header["payload"];
+        const auto& metadata       = payload_header.at("metadata").get_binary();
+        const auto& gpu_data       = exported.buffers.at(index++);
+
+        // The columns of the view point into the mapped buffer, the table owns a copy of them
+        cudf::io::table_with_metadata table;
+        table.tbl = std::make_unique<cudf::table>(
+            cudf::unpack(metadata.data(), static_cast<const uint8_t*>(gpu_data.data)), stream);
+
+        const auto index_names = payload_header.at("index_names").get<std::vector<std::string>>();
+        for (const auto& name : index_names)
+        {
+            table.metadata.schema_info.emplace_back(name);
+        }
+
+        for (const auto& name : payload_header.at("column_names").get<std::vector<std::string>>())
+        {
+            table.metadata.schema_info.emplace_back(name);
+        }
+
+        message->payload(MessageMeta::create_from_cpp(std::move(table), static_cast<int>(index_names.size())));
+    }
+
+    if (header.contains("tensors"))
+    {
+        const auto& tensors_header = header["tensors"];
+
+        TensorMap tensors;
+        for (const auto& tensor_header : tensors_header.at("tensors"))
+        {
+            const auto& exported_buffer = exported.buffers.at(index++);
+
+            auto buffer = std::make_shared<rmm::device_buffer>(exported_buffer.size, stream);
+            if (exported_buffer.size > 0)
+            {
+                MRC_CHECK_CUDA(cudaMemcpyAsync(buffer->data(),
+                                               exported_buffer.data,
+                                               exported_buffer.size,
+                                               cudaMemcpyDeviceToDevice,
+                                               stream.value()));
+            }
+
+            tensors[tensor_header.at("name").get<std::string>()] =
+                Tensor::create(std::move(buffer),
+                               DType::from_numpy(tensor_header.at("dtype").get<std::string>()),
+                               tensor_header.at("shape").get<ShapeType>(),
+                               tensor_header.at("strides").get<ShapeType>());
+        }
+
+        message->tensors(
+            std::make_shared<TensorMemory>(tensors_header.at("count").get<TensorIndex>(), std::move(tensors)));
+    }
+
+    // The copies complete before the message is released to the producer
+    stream.synchronize();
+
+    return message;
+}
+
+CudaIpcSourceStage::subscriber_fn_t CudaIpcSourceStage::build()
+{
+    return [this](rxcpp::subscriber<source_type_t> output) {
+        CudaIpcRing::stop_fn_t should_stop = [&output]() {
+            return !output.is_subscribed();
+        };
+
+        try
+        {
+            auto ring = CudaIpcRing::open(m_ring_name, m_open_timeout, should_stop);
+            while (ring != nullptr && output.is_subscribed())
+            {
+                auto exported = ring->pop(should_stop);
+                if (!exported.has_value())
+                {
+                    break;
+                }
+
+                auto message = import_message(*exported);
+                MORPHEUS_TRACE("cuda_ipc_source.pop", exported->header.size(), exported->buffers.size());
+
+                // Releases the message to the producer
+                exported.reset();
+
+                output.on_next(std::move(message));
+            }
+        } catch (...)
+        {
+            output.on_error(std::current_exception());
+            return;
+        }
+
+        output.on_completed();
+    };
+}
+
+// ************ CudaIpcSinkStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<CudaIpcSinkStage>> CudaIpcSinkStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string ring_name,
+    std::size_t num_slots,
+    std::size_t max_header_bytes,
+    int64_t close_timeout_ms)
+{
+    return builder.construct_object<CudaIpcSinkStage>(
+        name, std::move(ring_name), num_slots, max_header_bytes, std::chrono::milliseconds(close_timeout_ms));
+}
+
+// ************ CudaIpcSourceStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<CudaIpcSourceStage>> CudaIpcSourceStageInterfaceProxy::init(
+    mrc::segment::Builder& builder, const std::string& name, std::string ring_name, int64_t open_timeout_ms)
+{
+    return builder.construct_object<CudaIpcSourceStage>(
+        name, std::move(ring_name), std::chrono::milliseconds(open_timeout_ms));
+}
+
+}  // namespace morpheus
@@ -0,0 +1,319 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/deduplicate.hpp"  // IWYU pragma: associated
+
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/stages/filter_rows.hpp"      // for filter_rows
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cudf/binaryop.hpp>                 // for binary_operation
+#include <cudf/column/column_factories.hpp>  // for make_column_from_scalar, make_empty_column
+#include <cudf/concatenate.hpp>              // for concatenate
+#include <cudf/copying.hpp>                  // for scatter, slice
+#include <cudf/hashing.hpp>                  // for murmurhash3_x64_128
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/search.hpp>             // for contains
+#include <cudf/stream_compaction.hpp>  // for apply_boolean_mask, distinct_indices
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>
+#include <cudf/unary.hpp>  // for unary_operation
+#include <glog/logging.h>
+
+#include <algorithm>  // for find, max
+#include <cstdint>    // for int64_t
+#include <exception>
+#include <functional>  // for reference_wrapper
+#include <iterator>    // for distance
+#include <stdexcept>
+#include <string>
+#include <utility>  // for move
+#include <vector>
+
+namespace morpheus {
+
+// ************ DeduplicationWindow ************************************* //
+DeduplicationWindow::DeduplicationWindow(std::vector<std::string> key_columns,
+                                         std::chrono::milliseconds window,
+                                         std::size_t num_buckets,
+                                         std::size_t max_keys) :
+  m_key_columns(std::move(key_columns)),
+  m_window(window),
+  m_max_keys(max_keys)
+{
+    if (m_key_columns.empty())
+    {
+        throw std::invalid_argument("At least one key column is required to deduplicate rows");
+    }
+
+    if (m_window.count() <= 0 || num_buckets == 0 || m_max_keys == 0)
+    {
+        throw std::invalid_argument("The window, number of buckets and maximum number of keys must be greater than 0");
+    }
+
+    m_bucket_duration = std::max(m_window / static_cast<int64_t>(num_buckets), std::chrono::milliseconds(1));
+}
+
+void DeduplicationWindow::roll_over(clock_t::time_point now)
+{
+    // A bucket is dropped once the end of its duration is older than the window
+    while (!m_buckets.empty() && m_buckets.front().start + m_bucket_duration + m_window <= now)
+    {
+        m_num_keys -= m_buckets.front().hashes->size();
+        m_buckets.pop_front();
+    }
+
+    if (m_buckets.empty() || m_buckets.back().start + m_bucket_duration <= now)
+    {
+        m_buckets.push_back({now, cudf::make_empty_column(cudf::type_id::UINT64)});
+    }
+}
+
+std::unique_ptr<cudf::column> DeduplicationWindow::insert(const TableInfo& table, clock_t::time_point now)
+{
+    const auto column_names = table.get_column_names();
+
+    std::vector<cudf::column_view> keys;
+    for (const auto& key_column : m_key_columns)
+    {
+        auto found = std::find(column_names.begin(), column_names.end(), key_column);
+        if (found == column_names.end())
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to find the key column '" << key_column << "'"));
+        }
+
+        keys.push_back(table.get_column(std::distance(column_names.begin(), found)));
+    }
+
+    roll_over(now);
+
+    // The first half of the 128-bit hash is enough to tell keys apart
+    auto hashes            = std::move(cudf::hashing::murmurhash3_x64_128(cudf::table_view{keys})->release()[0]);
+    const auto num_rows    = hashes->size();
+    const auto hashes_view = hashes->view();
+
+    // Only the first row of each key within the table is kept
+    auto first_rows = cudf::distinct_indices(cudf::table_view{{hashes_view}}, cudf::duplicate_keep_option::KEEP_FIRST);
+    auto none_kept  = cudf::make_column_from_scalar(cudf::numeric_scalar<bool>(false), num_rows);
+
+    const cudf::numeric_scalar<bool> is_kept(true);
+    const std::vector<std::reference_wrapper<const cudf::scalar>> kept_value{is_kept};
+    auto keep = std::move(
+        cudf::scatter(kept_value, first_rows->view(), cudf::table_view{{none_kept->view()}})->release()[0]);
+
+    for (const auto& bucket : m_buckets)
+    {
+        if (bucket.hashes->size() == 0)
+        {
+            continue;
+        }
+
+        auto seen   = cudf::contains(bucket.hashes->view(), hashes_view);
+        auto unseen = cudf::unary_operation(seen->view(), cudf::unary_operator::NOT);
+        keep        = cudf::binary_operation(keep->view(),
+                                             unseen->view(),
+                                             cudf::binary_operator::LOGICAL_AND,
+                                             cudf::data_type{cudf::type_id::BOOL8});
+    }
+
+    auto added = std::move(cudf::apply_boolean_mask(cudf::table_view{{hashes_view}}, keep->view())->release()[0]);
+    m_num_keys += added->size();
+
+    auto& newest = m_buckets.back();
+    if (newest.hashes->size() == 0)
+    {
+        newest.hashes = std::move(added);
+    }
+    else if (added->size() > 0)
+    {
+        newest.hashes = cudf::concatenate(std::vector<cudf::column_view>{newest.hashes->view(), added->view()});
+    }
+
+    // Keys are forgotten early rather than letting the window grow past its bound
+    while (m_num_keys > m_max_keys && !m_buckets.empty())
+    {
+        VLOG(1) << "Deduplication window holds " << m_num_keys << " keys, more than " << m_max_keys
+                << ", dropping the oldest bucket early";
+
+        m_num_keys -= m_buckets.front().hashes->size();
+        m_buckets.pop_front();
+    }
+
+    return keep;
+}
+
+std::size_t DeduplicationWindow::size() const
+{
+    return m_num_keys;
+}
+
+StateSnapshot DeduplicationWindow::snapshot()
+{
+    const auto now = clock_t::now();
+
+    std::vector<cudf::column_view> hashes;
+    auto buckets = nlohmann::json::array();
+    for (const auto& bucket : m_buckets)
+    {
+        hashes.push_back(bucket.hashes->view());
+        buckets.push_back(
+            {{"age_ms", std::chrono::duration_cast<std::chrono::milliseconds>(now - bucket.start).count()},
+             {"num_keys", bucket.hashes->size()}});
+    }
+
+    StateSnapshot snapshot;
+    snapshot.column_names = {"hash"};
+    snapshot.metadata     = {{"key_columns", m_key_columns},
+                             {"buckets", std::move(buckets)},
+                             {"saved_at_ms",
+                              std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  std::chrono::system_clock::now().time_since_epoch())
+                                  .count()}};
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    columns.push_back(hashes.empty() ? cudf::make_empty_column(cudf::type_id::UINT64) : cudf::concatenate(hashes));
+    snapshot.table = std::make_unique<cudf::table>(std::move(columns));
+
+    return snapshot;
+}
+
+void DeduplicationWindow::restore(StateSnapshot snapshot)
+{
+    if (snapshot.metadata["key_columns"].get<std::vector<std::string>>() != m_key_columns)
+    {
+        throw std::invalid_argument("The deduplication window was saved with other key columns");
+    }
+
+    // Keys keep aging while the pipeline is down
+    const std::chrono::system_clock::time_point saved_at{
+        std::chrono::milliseconds(snapshot.metadata["saved_at_ms"].get<int64_t>())};
+    const auto downtime = std::max(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - saved_at),
+        std::chrono::milliseconds(0));
+    const auto now = clock_t::now();
+
+    auto hashes = snapshot.table->view().column(0);
+
+    m_buckets.clear();
+    m_num_keys = 0;
+
+    cudf::size_type begin = 0;
+    for (const auto& entry : snapshot.metadata["buckets"])
+    {
+        const auto num_keys = entry["num_keys"].get<cudf::size_type>();
+        const auto age      = std::chrono::milliseconds(entry["age_ms"].get<int64_t>()) + downtime;
+
+        auto slice = cudf::slice(hashes, {begin, begin + num_keys})[0];
+        m_buckets.push_back({now - age, std::make_unique<cudf::column>(slice)});
+
+        begin += num_keys;
+        m_num_keys += num_keys;
+    }
+
+    // Buckets which expired while the pipeline was down are dropped on the next insert
+}
+
+// Component public implementations
+// ************ DeduplicateStage ******************************* //
+DeduplicateStage::DeduplicateStage(std::vector<std::string> key_columns,
+                                   std::chrono::milliseconds window,
+                                   std::size_t num_buckets,
+                                   std::size_t max_keys,
+                                   const std::string& metrics_name,
+                                   std::chrono::milliseconds checkpoint_interval) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_window(std::move(key_columns), window, num_buckets, max_keys),
+  m_checkpoint(metrics_name, checkpoint_interval)
+{
+    m_checkpoint.restore(m_window);
+
+    const metric_labels_t labels{{"stage", metrics_name}};
+    auto& registry = MetricsRegistry::get_instance();
+
+    m_unique_rows = registry.get_counter(
+        "morpheus_deduplicate_unique_rows_total", "Rows whose keys were not seen within the window", labels);
+    m_duplicate_rows = registry.get_counter(
+        "morpheus_deduplicate_duplicate_rows_total", "Rows dropped as their keys were seen within the window", labels);
+    m_num_keys = registry.get_gauge("morpheus_deduplicate_keys", "Keys held by the deduplication window", labels);
+}
+
+DeduplicateStage::subscribe_fn_t DeduplicateStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                auto payload        = x->payload();
+                const auto num_rows = payload->count();
+
+                auto keep     = m_window.insert(payload->get_info());
+                auto filtered = filter_rows(payload, keep->view());
+
+                const auto num_unique = filtered == nullptr ? 0 : filtered->count();
+
+                m_unique_rows->increment(static_cast<double>(num_unique));
+                m_duplicate_rows->increment(static_cast<double>(num_rows - num_unique));
+                m_num_keys->set(static_cast<double>(m_window.size()));
+
+                MORPHEUS_TRACE("deduplicate.filter", num_rows, num_unique);
+
+                m_checkpoint.maybe_save(m_window);
+
+                if (filtered == nullptr)
+                {
+                    DVLOG(10) << "Deduplicate dropped every row of a message. Rows: " << num_rows;
+                    return;
+                }
+
+                x->payload(filtered);
+                x->set_metadata("duplicate_rows", num_rows - num_unique);
+
+                output.on_next(std::move(x));
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [this, &output]() {
+                m_checkpoint.save(m_window);
+                m_checkpoint.wait();
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ DeduplicateStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<DeduplicateStage>> DeduplicateStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::vector<std::string> key_columns,
+    std::size_t window_ms,
+    std::size_t num_buckets,
+    std::size_t max_keys,
+    std::size_t checkpoint_interval_ms)
+{
+    return builder.construct_object<DeduplicateStage>(name,
+                                                      std::move(key_columns),
+                                                      std::chrono::milliseconds(window_ms),
+                                                      num_buckets,
+                                                      max_keys,
+                                                      name,
+                                                      std::chrono::milliseconds(checkpoint_interval_ms));
+}
+
+}  // namespace morpheus
@@ -18,10 +18,17 @@
 #include "morpheus/stages/deserialize.hpp"
 
 #include "morpheus/messages/control.hpp"
+#include "morpheus/objects/table_info.hpp"  // for TableInfo
 #include "morpheus/types.hpp"
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
 
+#include <cudf/concatenate.hpp>  // for concatenate
+#include <cudf/io/types.hpp>     // for table_with_metadata
+#include <cudf/table/table_view.hpp>
 #include <pybind11/pybind11.h>
 #include <pymrc/utils.hpp>  // for cast_from_pyobject
+
+#include <chrono>  // for milliseconds
 // IWYU pragma: no_include "rxcpp/sources/rx-iterate.hpp"
 
 namespace morpheus {
@@ -33,7 +40,7 @@ void make_output_message(std::shared_ptr<MessageMeta>& incoming_message,
                          std::shared_ptr<MultiMessage>& windowed_message)
 {
     DCHECK_EQ(task, nullptr) << "Task is not supported for MultiMessage";
-    auto sliced_msg = std::make_shared<MultiMessage>(incoming_message, start, stop - start);
+    auto sliced_msg = make_pooled<MultiMessage>(incoming_message, start, stop - start);
     windowed_message.swap(sliced_msg);
 }
 
@@ -43,8 +50,8 @@ void make_output_message(std::shared_ptr<MessageMeta>& incoming_message,
                          cm_task_t* task,
                          std::shared_ptr<ControlMessage>& windowed_message)
 {
-    auto slidced_meta = std::make_shared<SlicedMessageMeta>(incoming_message, start, stop);
-    auto message      = std::make_shared<ControlMessage>();
+    auto slidced_meta = make_pooled<SlicedMessageMeta>(incoming_message, start, stop);
+    auto message      = make_pooled<ControlMessage>();
     message->payload(slidced_meta);
     if (task)
     {
@@ -54,10 +61,69 @@ void make_output_message(std::shared_ptr<MessageMeta>& incoming_message,
     windowed_message.swap(message);
 }
 
+std::shared_ptr<MessageMeta> coalesce_message_metas(const std::vector<std::shared_ptr<MessageMeta>>& metas)
+{
+    CHECK(!metas.empty()) << "At least one MessageMeta is required";
+
+    // Holds the views, and the locks over the underlying tables, until the rows have been copied
+    std::vector<TableInfo> infos;
+    std::vector<cudf::table_view> views;
+    infos.reserve(metas.size());
+    views.reserve(metas.size());
+
+    for (const auto& meta : metas)
+    {
+        auto info = meta->get_info();
+
+        CHECK(infos.empty() || info.get_column_names() == infos.front().get_column_names())
+            << "Only messages with the same columns can be coalesced";
+
+        // Unnamed indexes are dropped, named ones are kept as columns
+        std::vector<cudf::size_type> column_indices;
+        const auto index_names = info.get_index_names();
+        for (cudf::size_type i = 0; i < info.get_view().num_columns(); ++i)
+        {
+            if (i >= info.num_indices() || !index_names[i].empty())
+            {
+                column_indices.push_back(i);
+            }
+        }
+
+        views.push_back(info.get_view().select(column_indices));
+        infos.push_back(std::move(info));
+    }
+
+    cudf::io::table_with_metadata coalesced{cudf::concatenate(views)};
+
+    const auto& first = infos.front();
+    for (const auto& name : first.get_index_names())
+    {
+        if (!name.empty())
+        {
+            coalesced.metadata.schema_info.emplace_back(name);
+        }
+    }
+    for (const auto& name : first.get_column_names())
+    {
+        coalesced.metadata.schema_info.emplace_back(name);
+    }
+
+    // Releases the locks before handing out the new message
+    infos.clear();
+
+    return MessageMeta::create_from_cpp(std::move(coalesced));
+}
+
 std::shared_ptr<mrc::segment::Object<DeserializeStage<MultiMessage>>> DeserializeStageInterfaceProxy::init_multi(
-    mrc::segment::Builder& builder, const std::string& name, TensorIndex batch_size, bool ensure_sliceable_index)
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    TensorIndex batch_size,
+    bool ensure_sliceable_index,
+    bool coalesce,
+    int64_t max_linger_ms)
 {
-    return builder.construct_object<DeserializeStage<MultiMessage>>(name, batch_size, ensure_sliceable_index, nullptr);
+    return builder.construct_object<DeserializeStage<MultiMessage>>(
+        name, batch_size, ensure_sliceable_index, nullptr, coalesce, std::chrono::milliseconds(max_linger_ms));
 }
 
 std::shared_ptr<mrc::segment::Object<DeserializeStage<ControlMessage>>> DeserializeStageInterfaceProxy::init_cm(
@@ -66,7 +132,9 @@ std::shared_ptr<mrc::segment::Object<DeserializeStage<ControlMessage>>> Deserial
     TensorIndex batch_size,
     bool ensure_sliceable_index,
     const pybind11::object& task_type,
-    const pybind11::object& task_payload)
+    const pybind11::object& task_payload,
+    bool coalesce,
+    int64_t max_linger_ms)
 {
     std::unique_ptr<cm_task_t> task{nullptr};
 
@@ -77,7 +145,7 @@ std::shared_ptr<mrc::segment::Object<DeserializeStage<ControlMessage>>> Deserial
     }
 
     auto stage = builder.construct_object<DeserializeStage<ControlMessage>>(
-        name, batch_size, ensure_sliceable_index, std::move(task));
+        name, batch_size, ensure_sliceable_index, std::move(task), coalesce, std::chrono::milliseconds(max_linger_ms));
 
     return stage;
 }
@@ -0,0 +1,420 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/enrich.hpp"  // IWYU pragma: associated
+
+#include "morpheus/io/deserializers.hpp"        // for load_table_from_file
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>  // for make_column_from_scalar
+#include <cudf/copying.hpp>                  // for gather, scatter
+#include <cudf/io/types.hpp>                 // for table_with_metadata
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/stream_compaction.hpp>  // for distinct_indices
+#include <cudf/table/table_view.hpp>
+#include <cudf/utilities/span.hpp>  // for device_span
+#include <glog/logging.h>
+#include <rmm/device_uvector.hpp>
+
+#include <algorithm>  // for find
+#include <exception>
+#include <iterator>   // for distance
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <system_error>
+
+namespace morpheus {
+namespace {
+
+// Index of `name` among `names`
+cudf::size_type find_name(const std::vector<std::string>& names, const std::string& name, const std::string& where)
+{
+    auto found = std::find(names.begin(), names.end(), name);
+    if (found == names.end())
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to find the column '" << name << "' in " << where));
+    }
+
+    return static_cast<cudf::size_type>(std::distance(names.begin(), found));
+}
+
+}  // namespace
+
+// ************ ReferenceTable ************* //
+bool ReferenceTable::FileState::operator==(const FileState& other) const
+{
+    return size == other.size && write_time == other.write_time;
+}
+
+ReferenceTable::ReferenceTable(std::string filename,
+                               FileTypes file_type,
+                               std::vector<std::string> key_columns,
+                               std::vector<std::string> value_columns,
+                               std::chrono::milliseconds reload_interval) :
+  m_filename(std::move(filename)),
+  m_file_type(file_type),
+  m_key_columns(std::move(key_columns)),
+  m_value_columns(std::move(value_columns)),
+  m_reload_interval(reload_interval)
+{
+    if (m_key_columns.empty())
+    {
+        throw std::invalid_argument("The reference table requires at least one key column");
+    }
+
+    // The first version must load, later ones only replacing it when they do
+    m_current      = load(stat_file());
+    m_num_versions = 1;
+
+    if (m_reload_interval.count() > 0)
+    {
+        m_reload_thread = std::thread(&ReferenceTable::reload_loop, this);
+    }
+}
+
+ReferenceTable::~ReferenceTable()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_stop_cv.notify_all();
+
+    if (m_reload_thread.joinable())
+    {
+        m_reload_thread.join();
+    }
+}
+
+std::pair<std::unique_ptr<cudf::table>, cudf::size_type> ReferenceTable::lookup(const cudf::table_view& keys) const
+{
+    // Holding the version keeps its tables and hash table alive should a reload replace it meanwhile
+    auto version = current();
+
+    if (keys.num_columns() != version->keys->num_columns())
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Expected " << version->keys->num_columns()
+                                                                    << " key columns, got " << keys.num_columns()));
+    }
+
+    // Keys being unique in the reference table, each row is matched at most once
+    auto [row_indices, table_indices] = version->join->inner_join(keys);
+    const auto num_matched            = static_cast<cudf::size_type>(row_indices->size());
+
+    // Rows not matched keep an index out of bounds, gathered as nulls
+    auto gather_map = cudf::make_column_from_scalar(
+        cudf::numeric_scalar<cudf::size_type>(version->values->num_rows()), keys.num_rows());
+    if (num_matched > 0)
+    {
+        cudf::column_view table_indices_view{cudf::device_span<const cudf::size_type>{*table_indices}};
+        cudf::column_view row_indices_view{cudf::device_span<const cudf::size_type>{*row_indices}};
+
+        auto scattered = cudf::scatter(
+            cudf::table_view{{table_indices_view}}, row_indices_view, cudf::table_view{{gather_map->view()}});
+        gather_map = std::move(scattered->release()[0]);
+    }
+
+    auto values = cudf::gather(version->values->view(), gather_map->view(), cudf::out_of_bounds_policy::NULLIFY);
+
+    return {std::move(values), num_matched};
+}
+
+const std::vector<std::string>& ReferenceTable::value_columns() const
+{
+    return m_value_columns;
+}
+
+bool ReferenceTable::reload()
+{
+    const auto file_state = stat_file();
+    if (current()->file_state == file_state)
+    {
+        return false;
+    }
+
+    auto version = load(file_state);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_current = std::move(version);
+    ++m_num_versions;
+
+    return true;
+}
+
+std::size_t ReferenceTable::num_versions() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_num_versions;
+}
+
+cudf::size_type ReferenceTable::num_rows() const
+{
+    return current()->values->num_rows();
+}
+
+ReferenceTable::FileState ReferenceTable::stat_file() const
+{
+    std::error_code ec;
+    FileState state;
+    state.size = std::filesystem::file_size(m_filename, ec);
+    if (!ec)
+    {
+        state.write_time = std::filesystem::last_write_time(m_filename, ec);
+    }
+
+    if (ec)
+    {
+        throw std::runtime_error(
+            MORPHEUS_CONCAT_STR("Unable to read the reference table '" << m_filename << "': " << ec.message()));
+    }
+
+    return state;
+}
+
+std::shared_ptr<const ReferenceTable::Version> ReferenceTable::load(FileState file_state)
+{
+    auto loaded = load_table_from_file(m_filename, m_file_type, std::nullopt, {}, m_reload_stream.view());
+
+    std::vector<std::string> names;
+    for (const auto& info : loaded.metadata.schema_info)
+    {
+        names.push_back(info.name);
+    }
+
+    std::vector<cudf::size_type> key_indices;
+    for (const auto& key_column : m_key_columns)
+    {
+        key_indices.push_back(find_name(names, key_column, m_filename));
+    }
+
+    // Every other column of the first version, later versions being expected to keep them
+    std::vector<cudf::size_type> value_indices;
+    if (m_value_columns.empty())
+    {
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            if (std::find(m_key_columns.begin(), m_key_columns.end(), names[i]) == m_key_columns.end())
+            {
+                m_value_columns.push_back(names[i]);
+            }
+        }
+    }
+
+    for (const auto& value_column : m_value_columns)
+    {
+        value_indices.push_back(find_name(names, value_column, m_filename));
+    }
+
+    auto table = std::move(loaded.tbl);
+
+    // Repeated keys keep their last row, as a later entry of a feed supersedes the earlier ones
+    auto distinct = cudf::distinct_indices(table->view().select(key_indices),
+                                           cudf::duplicate_keep_option::KEEP_LAST,
+                                           cudf::null_equality::EQUAL,
+                                           cudf::nan_equality::ALL_EQUAL,
+                                           m_reload_stream.view());
+    if (distinct->size() < table->num_rows())
+    {
+        LOG(WARNING) << "The reference table '" << m_filename << "' holds "
+                     << table->num_rows() - distinct->size() << " rows with repeated keys, keeping the last of each";
+        table = cudf::gather(table->view(),
+                             distinct->view(),
+                             cudf::out_of_bounds_policy::DONT_CHECK,
+                             m_reload_stream.view());
+    }
+
+    auto version        = std::make_shared<Version>();
+    version->file_state = file_state;
+    version->keys       = std::make_unique<cudf::table>(table->view().select(key_indices), m_reload_stream.view());
+    version->values     = std::make_unique<cudf::table>(table->view().select(value_indices), m_reload_stream.view());
+
+    // Null keys never match, the hash table being built once for every batch probing this version
+    version->join =
+        std::make_unique<cudf::hash_join>(version->keys->view(), cudf::null_equality::UNEQUAL, m_reload_stream.view());
+
+    // The version must be complete before batches on other streams may probe it
+    m_reload_stream.synchronize();
+
+    return version;
+}
+
+std::shared_ptr<const ReferenceTable::Version> ReferenceTable::current() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_current;
+}
+
+void ReferenceTable::reload_loop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop_cv.wait_for(lock, m_reload_interval, [this] {
+        return m_stopping;
+    }))
+    {
+        lock.unlock();
+        try
+        {
+            if (reload())
+            {
+                LOG(INFO) << "Reloaded the reference table '" << m_filename << "' with " << num_rows() << " rows";
+            }
+        } catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Failed to reload the reference table '" << m_filename << "', keeping the current version: "
+                       << e.what();
+        }
+        lock.lock();
+    }
+}
+
+// ************ EnrichStage ************* //
+EnrichStage::EnrichStage(std::string filename,
+                         FileTypes file_type,
+                         std::vector<std::string> key_columns,
+                         std::vector<std::string> value_columns,
+                         std::vector<std::string> event_key_columns,
+                         std::string prefix,
+                         std::chrono::milliseconds reload_interval,
+                         const std::string& metrics_name) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_event_key_columns(event_key_columns.empty() ? key_columns : std::move(event_key_columns)),
+  m_prefix(std::move(prefix)),
+  m_table(std::move(filename), file_type, std::move(key_columns), std::move(value_columns), reload_interval)
+{
+    const metric_labels_t labels{{"stage", metrics_name}};
+    auto& registry = MetricsRegistry::get_instance();
+
+    m_matched_rows =
+        registry.get_counter("morpheus_enrich_matched_rows_total", "Rows matched in the reference table", labels);
+    m_unmatched_rows =
+        registry.get_counter("morpheus_enrich_unmatched_rows_total", "Rows not matched in the reference table", labels);
+    m_versions =
+        registry.get_gauge("morpheus_enrich_reference_versions", "Versions of the reference table loaded", labels);
+}
+
+std::shared_ptr<MessageMeta> EnrichStage::enrich(const std::shared_ptr<MessageMeta>& meta)
+{
+    auto info               = meta->get_info();
+    const auto column_names = info.get_column_names();
+
+    std::vector<cudf::column_view> keys;
+    for (const auto& key_column : m_event_key_columns)
+    {
+        keys.push_back(info.get_column(find_name(column_names, key_column, "the payload")));
+    }
+
+    auto [values, num_matched] = m_table.lookup(cudf::table_view{keys});
+
+    m_matched_rows->increment(static_cast<double>(num_matched));
+    m_unmatched_rows->increment(static_cast<double>(info.num_rows() - num_matched));
+
+    std::vector<std::string> appended_names;
+    for (const auto& value_column : m_table.value_columns())
+    {
+        appended_names.push_back(m_prefix + value_column);
+    }
+
+    // The index and the columns of the payload, less those replaced by the appended ones, followed by the appended ones
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    cudf::io::table_with_metadata enriched;
+    const auto view = info.get_view();
+    for (cudf::size_type i = 0; i < info.num_indices(); ++i)
+    {
+        columns.push_back(std::make_unique<cudf::column>(view.column(i)));
+    }
+    for (const auto& name : info.get_index_names())
+    {
+        enriched.metadata.schema_info.emplace_back(name);
+    }
+
+    for (cudf::size_type i = 0; i < info.num_columns(); ++i)
+    {
+        if (std::find(appended_names.begin(), appended_names.end(), column_names[i]) == appended_names.end())
+        {
+            columns.push_back(std::make_unique<cudf::column>(info.get_column(i)));
+            enriched.metadata.schema_info.emplace_back(column_names[i]);
+        }
+    }
+
+    for (auto& column : values->release())
+    {
+        columns.push_back(std::move(column));
+    }
+    for (const auto& name : appended_names)
+    {
+        enriched.metadata.schema_info.emplace_back(name);
+    }
+
+    enriched.tbl = std::make_unique<cudf::table>(std::move(columns));
+
+    return MessageMeta::create_from_cpp(std::move(enriched), info.num_indices());
+}
+
+EnrichStage::subscribe_fn_t EnrichStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                auto payload = x->payload();
+                if (payload == nullptr)
+                {
+                    throw std::runtime_error("Enrich requires a control message with a payload");
+                }
+
+                auto enriched = enrich(payload);
+                MORPHEUS_TRACE("enrich.lookup", payload->count(), enriched->count());
+                x->payload(enriched);
+
+                m_versions->set(static_cast<double>(m_table.num_versions()));
+                output.on_next(std::move(x));
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&output]() {
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ EnrichStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<EnrichStage>> EnrichStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string filename,
+    FileTypes file_type,
+    std::vector<std::string> key_columns,
+    std::vector<std::string> value_columns,
+    std::vector<std::string> event_key_columns,
+    std::string prefix,
+    std::size_t reload_interval_ms)
+{
+    return builder.construct_object<EnrichStage>(name,
+                                                 std::move(filename),
+                                                 file_type,
+                                                 std::move(key_columns),
+                                                 std::move(value_columns),
+                                                 std::move(event_key_columns),
+                                                 std::move(prefix),
+                                                 std::chrono::milliseconds(reload_interval_ms),
+                                                 name);
+}
+
+}  // namespace morpheus
@@ -22,18 +22,21 @@
 
 #include "morpheus/io/deserializers.hpp"
 #include "morpheus/objects/file_types.hpp"
-#include "morpheus/objects/table_info.hpp"
-#include "morpheus/utilities/cudf_util.hpp"
+#include "morpheus/utilities/nvtx_util.hpp"  // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
 
+#include <cudf/binaryop.hpp>  // for binary_operation
+#include <cudf/io/types.hpp>  // for table_with_metadata
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/table/table.hpp>
 #include <cudf/types.hpp>
 #include <glog/logging.h>
 #include <mrc/segment/builder.hpp>
-#include <pybind11/cast.h>  // IWYU pragma: keep
-#include <pybind11/gil.h>
+#include <pybind11/cast.h>      // IWYU pragma: keep
 #include <pybind11/pybind11.h>  // for str_attr_accessor
-#include <pybind11/pytypes.h>   // for pybind11::int_
 
+#include <cstdint>  // for int64_t
 #include <filesystem>
+#include <future>  // for async, future
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -42,70 +45,136 @@
 // IWYU pragma: no_include <ext/alloc_traits.h>
 
 namespace morpheus {
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "FileSourceStage");
+
+// Adds `offset` to the index, the first column of `table`, leaving the other columns as they are
+std::unique_ptr<cudf::table> shift_index(cudf::table& table, int64_t offset)
+{
+    auto columns = table.release();
+
+    cudf::numeric_scalar<int64_t> offset_scalar(offset);
+    columns[0] =
+        cudf::binary_operation(columns[0]->view(), offset_scalar, cudf::binary_operator::ADD, columns[0]->type());
+
+    return std::make_unique<cudf::table>(std::move(columns));
+}
+}  // namespace
+
 // Component public implementations
 // ************ FileSourceStage ************* //
-FileSourceStage::FileSourceStage(std::string filename, int repeat, std::optional<bool> json_lines) :
+FileSourceStage::FileSourceStage(std::string filename,
+                                 int repeat,
+                                 std::optional<bool> json_lines,
+                                 std::size_t chunk_bytes,
+                                 TableSchema schema,
+                                 ColumnProjection projection) :
   PythonSource(build()),
   m_filename(std::move(filename)),
   m_repeat(repeat),
-  m_json_lines(json_lines)
+  m_json_lines(json_lines),
+  m_chunk_bytes(chunk_bytes),
+  m_schema(std::move(schema)),
+  m_projection(std::move(projection))
 {}
 
-FileSourceStage::subscriber_fn_t FileSourceStage::build()
+void FileSourceStage::emit_chunks(rxcpp::subscriber<source_type_t>& output)
 {
-    return [this](rxcpp::subscriber<source_type_t> output) {
-        auto data_table     = load_table_from_file(m_filename, FileTypes::Auto, m_json_lines);
-        int index_col_count = prepare_df_index(data_table);
+    // Continues the range index of each chunk, and of each repeat, from the previous one
+    int64_t next_index = 0;
 
-        // Next, create the message metadata. This gets reused for repeats
-        // When index_col_count is 0 this will cause a new range index to be created
-        auto meta = MessageMeta::create_from_cpp(std::move(data_table), index_col_count);
+    for (int repeat_idx = 0; repeat_idx < m_repeat && output.is_subscribed(); ++repeat_idx)
+    {
+        ChunkedTableReader reader(m_filename, FileTypes::Auto, m_chunk_bytes, m_json_lines, m_schema);
+
+        auto read_next = [&reader]() {
+            return reader.next();
+        };
 
-        // next_meta stores a copy of the upcoming meta
-        std::shared_ptr<MessageMeta> next_meta = nullptr;
+        // Reads the next chunk while the current one is emitted, the reader is only ever used by one thread at a time
+        auto pending = std::async(std::launch::async, read_next);
 
-        for (cudf::size_type repeat_idx = 0; repeat_idx < m_repeat; ++repeat_idx)
+        while (output.is_subscribed())
         {
-            if (!output.is_subscribed())
+            auto data_table = pending.get();
+            if (!data_table)
             {
-                // Grab the GIL before disposing, just in case
-                pybind11::gil_scoped_acquire gil;
-
-                // Reset meta to allow the DCHECK after the loop to pass
-                meta.reset();
-
                 break;
             }
 
-            // Clone the meta object before pushing while we still have access to it
-            if (repeat_idx + 1 < m_repeat)
+            pending = std::async(std::launch::async, read_next);
+
+            auto num_rows = data_table->tbl->num_rows();
+
+            std::shared_ptr<MessageMeta> meta;
             {
-                // Use the copy function, copy_to_py_object will acquire it's own gil
-                auto df = CudfHelper::table_from_table_info(meta->get_info());
+                MORPHEUS_NVTX_RANGE(NvtxDomain, "create_meta", num_rows);
+
+                apply_column_projection(*data_table, m_projection);
+                int index_col_count = prepare_df_index(*data_table);
+                meta = MessageMeta::create_from_cpp(std::move(*data_table), index_col_count, next_index);
+            }
+
+            output.on_next(std::move(meta));
+
+            next_index += num_rows;
+        }
 
-                // GIL must come after get_info
-                pybind11::gil_scoped_acquire gil;
+        if (pending.valid())
+        {
+            // The reader must outlive any read still in flight
+            pending.wait();
+        }
+    }
+}
 
-                pybind11::int_ df_len = pybind11::len(df);
+FileSourceStage::subscriber_fn_t FileSourceStage::build()
+{
+    return [this](rxcpp::subscriber<source_type_t> output) {
+        if (m_chunk_bytes > 0)
+        {
+            this->emit_chunks(output);
+            output.on_completed();
+            return;
+        }
 
-                pybind11::object index = df.attr("index");
+        auto data_table = load_table_from_file(m_filename, FileTypes::Auto, m_json_lines, m_schema);
+        apply_column_projection(data_table, m_projection);
 
-                df.attr("index") = index + df_len;
+        int index_col_count = prepare_df_index(data_table);
+        const auto num_rows = static_cast<int64_t>(data_table.tbl->num_rows());
 
-                next_meta = MessageMeta::create_from_python(std::move(df));
+        for (int repeat_idx = 0; repeat_idx < m_repeat; ++repeat_idx)
+        {
+            if (!output.is_subscribed())
+            {
+                break;
             }
 
-            DCHECK(meta) << "Cannot push null meta";
+            // Every repeat but the last gets its own copy of the columns, since downstream stages may modify them. The
+            // copy is made on the device, without going through python
+            cudf::io::table_with_metadata repeat_table;
+            if (repeat_idx + 1 < m_repeat)
+            {
+                repeat_table.tbl      = std::make_unique<cudf::table>(data_table.tbl->view());
+                repeat_table.metadata = data_table.metadata;
+            }
+            else
+            {
+                repeat_table = std::move(data_table);
+            }
 
-            output.on_next(std::move(meta));
+            // Shifts the index to allow for unique indices without reading more data. When index_col_count is 0 a new
+            // range index starting at `index_offset` will be created
+            const auto index_offset = repeat_idx * num_rows;
+            if (index_col_count > 0 && index_offset > 0)
+            {
+                repeat_table.tbl = shift_index(*repeat_table.tbl, index_offset);
+            }
 
-            // Move next_meta into meta
-            std::swap(meta, next_meta);
+            output.on_next(MessageMeta::create_from_cpp(std::move(repeat_table), index_col_count, index_offset));
         }
 
-        DCHECK(!meta) << "meta was not properly pushed";
-        DCHECK(!next_meta) << "next_meta was not properly pushed";
-
         output.on_completed();
     };
 }
@@ -116,7 +185,10 @@ std::shared_ptr<mrc::segment::Object<FileSourceStage>> FileSourceStageInterfaceP
     const std::string& name,
     std::string filename,
     int repeat,
-    pybind11::dict parser_kwargs)
+    pybind11::dict parser_kwargs,
+    std::size_t chunk_bytes,
+    std::vector<std::pair<std::string, std::string>> schema,
+    const std::vector<std::string>& projection)
 {
     std::optional<bool> json_lines = std::nullopt;
 
@@ -125,7 +197,13 @@ std::shared_ptr<mrc::segment::Object<FileSourceStage>> FileSourceStageInterfaceP
         json_lines = parser_kwargs["lines"].cast<bool>();
     }
 
-    auto stage = builder.construct_object<FileSourceStage>(name, filename, repeat, json_lines);
+    auto stage = builder.construct_object<FileSourceStage>(name,
+                                                           filename,
+                                                           repeat,
+                                                           json_lines,
+                                                           chunk_bytes,
+                                                           TableSchema::from_type_names(schema),
+                                                           ColumnProjection(projection));
 
     return stage;
 }
@@ -135,8 +213,12 @@ std::shared_ptr<mrc::segment::Object<FileSourceStage>> FileSourceStageInterfaceP
     const std::string& name,
     std::filesystem::path filename,
     int repeat,
-    pybind11::dict parser_kwargs)
+    pybind11::dict parser_kwargs,
+    std::size_t chunk_bytes,
+    std::vector<std::pair<std::string, std::string>> schema,
+    const std::vector<std::string>& projection)
 {
-    return init(builder, name, filename.string(), repeat, std::move(parser_kwargs));
+    return init(
+        builder, name, filename.string(), repeat, std::move(parser_kwargs), chunk_bytes, std::move(schema), projection);
 }
 }  // namespace morpheus
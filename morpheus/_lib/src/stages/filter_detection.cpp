@@ -21,24 +21,28 @@
 #include "mrc/segment/object.hpp"
 #include "pymrc/node.hpp"
 
+#include "morpheus/messages/control.hpp"                // for ControlMessage
+#include "morpheus/messages/memory/tensor_memory.hpp"  // for TensorMemory
+#include "morpheus/messages/meta.hpp"                  // for SlicedMessageMeta
 #include "morpheus/messages/multi_tensor.hpp"
-#include "morpheus/objects/dev_mem_info.hpp"  // for DevMemInfo
-#include "morpheus/objects/dtype.hpp"         // for DataType
+#include "morpheus/objects/dev_mem_info.hpp"      // for DevMemInfo
+#include "morpheus/objects/device_resources.hpp"  // for DeviceResources
+#include "morpheus/objects/dtype.hpp"             // for DataType
 #include "morpheus/objects/memory_descriptor.hpp"
+#include "morpheus/objects/stage_memory_resource.hpp"  // for StageMemoryResource
 #include "morpheus/objects/table_info.hpp"
+#include "morpheus/objects/tensor.hpp"
 #include "morpheus/objects/tensor_object.hpp"  // for TensorIndex, TensorObject
 #include "morpheus/types.hpp"                  // for RangeType
 #include "morpheus/utilities/matx_util.hpp"
+#include "morpheus/utilities/nvtx_util.hpp"    // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
 #include "morpheus/utilities/tensor_util.hpp"  // for TensorUtils::get_element_stride
 
-#include <cuda_runtime.h>  // for cudaMemcpy, cudaMemcpyDeviceToDevice, cudaMemcpyDeviceToHost
 #include <cudf/column/column_view.hpp>
 #include <cudf/types.hpp>
-#include <glog/logging.h>       // for CHECK, CHECK_NE
-#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <glog/logging.h>  // for CHECK, CHECK_NE
 #include <rmm/cuda_stream_view.hpp>
 #include <rmm/device_buffer.hpp>  // for device_buffer
-#include <rmm/mr/device/per_device_resource.hpp>
 
 #include <cstddef>
 #include <cstdint>  // for uint8_t
@@ -47,44 +51,75 @@
 #include <memory>
 #include <ostream>  // needed for glog
 #include <string>
-#include <utility>  // for pair
+#include <type_traits>  // for is_same_v
+#include <utility>      // for pair
 #include <vector>
 // IWYU thinks we need ext/new_allocator.h for size_t for some reason
 // IWYU pragma: no_include <ext/new_allocator.h>
 
 namespace morpheus {
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "FilterDetectionsStage");
+
+// Attributes the device memory allocated by the stage, such as the masks, to it
+StageMemoryResource* memory_resource()
+{
+    return StageMemoryResource::get("FilterDetectionsStage");
+}
+}  // namespace
 
 // Component public implementations
 // ************ FilterDetectionStage **************************** //
-FilterDetectionsStage::FilterDetectionsStage(float threshold,
-                                             bool copy,
-                                             FilterSource filter_source,
-                                             std::string field_name) :
-  PythonNode(base_t::op_factory_from_sub_fn(build_operator())),
+template <typename MessageT>
+FilterDetectionsStage<MessageT>::FilterDetectionsStage(
+    float threshold, bool copy, FilterSource filter_source, std::string field_name, std::string mask_column) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
   m_threshold(threshold),
   m_copy(copy),
   m_filter_source(filter_source),
-  m_field_name(std::move(field_name))
+  m_field_name(std::move(field_name)),
+  m_mask_column(std::move(mask_column))
 {
     CHECK(m_filter_source != FilterSource::Auto);  // The python stage should determine this
 }
 
-DevMemInfo FilterDetectionsStage::get_tensor_filter_source(const std::shared_ptr<morpheus::MultiMessage>& x)
+template <typename MessageT>
+DevMemInfo FilterDetectionsStage<MessageT>::get_tensor_filter_source(const sink_type_t& x)
 {
-    // The pipeline build will check to ensure that our input is a MultiResponseMessage
-    const auto& filter_source = std::static_pointer_cast<morpheus::MultiTensorMessage>(x)->get_tensor(m_field_name);
+    TensorObject filter_source;
+    if constexpr (std::is_same_v<MessageT, MultiMessage>)
+    {
+        // The pipeline build will check to ensure that our input is a MultiResponseMessage
+        filter_source.swap(std::static_pointer_cast<MultiTensorMessage>(x)->get_tensor(m_field_name));
+    }
+    else
+    {
+        CHECK(x->tensors()) << "ControlMessage does not contain any tensors to filter on";
+        filter_source.swap(TensorObject{x->tensors()->get_tensor(m_field_name)});
+    }
+
     CHECK(filter_source.rank() > 0 && filter_source.rank() <= 2)
         << "C++ impl of the FilterDetectionsStage currently only supports one and two dimensional "
            "arrays";
 
     // Depending on the input the stride is given in bytes or elements, convert to elements
     auto stride = morpheus::TensorUtils::get_element_stride(filter_source.get_stride());
-    return {filter_source.data(), filter_source.dtype(), filter_source.get_memory(), filter_source.get_shape(), stride};
+    auto md = std::make_shared<MemoryDescriptor>(filter_source.get_memory()->cuda_stream, memory_resource());
+    return {filter_source.data(), filter_source.dtype(), std::move(md), filter_source.get_shape(), stride};
 }
 
-DevMemInfo FilterDetectionsStage::get_column_filter_source(const std::shared_ptr<morpheus::MultiMessage>& x)
+template <typename MessageT>
+DevMemInfo FilterDetectionsStage<MessageT>::get_column_filter_source(const sink_type_t& x)
 {
-    auto table_info = x->get_meta(m_field_name);
+    TableInfo table_info;
+    if constexpr (std::is_same_v<MessageT, MultiMessage>)
+    {
+        table_info = x->get_meta(m_field_name);
+    }
+    else
+    {
+        table_info = x->payload()->get_info(m_field_name);
+    }
 
     // since we only asked for one column, we know its the first
     const auto& col = table_info.get_column(0);
@@ -96,26 +131,99 @@ DevMemInfo FilterDetectionsStage::get_column_filter_source(const std::shared_ptr
     return {
         data,
         std::move(dtype),
-        std::make_shared<MemoryDescriptor>(rmm::cuda_stream_per_thread, rmm::mr::get_current_device_resource()),
+        std::make_shared<MemoryDescriptor>(DeviceResources::stream(), memory_resource()),
         {num_rows, 1},
         {1, 0},
     };
 }
 
-FilterDetectionsStage::subscribe_fn_t FilterDetectionsStage::build_operator()
+template <typename MessageT>
+void FilterDetectionsStage<MessageT>::set_mask(const sink_type_t& x,
+                                               const std::shared_ptr<rmm::device_buffer>& mask,
+                                               TensorIndex num_rows)
+{
+    // The mask is written on the stream it was computed on, consumers are ordered after it by the table's event
+    auto mask_tensor = Tensor::create(mask, DType(TypeId::BOOL8), {num_rows, 1}, {}, 0);
+
+    if constexpr (std::is_same_v<MessageT, MultiMessage>)
+    {
+        x->set_meta({m_mask_column}, {mask_tensor}, mask->stream());
+    }
+    else
+    {
+        x->payload()->set_data({m_mask_column}, {mask_tensor}, mask->stream());
+    }
+}
+
+template <typename MessageT>
+typename FilterDetectionsStage<MessageT>::source_type_t FilterDetectionsStage<MessageT>::slice(const sink_type_t& x,
+                                                                                                TensorIndex start,
+                                                                                                TensorIndex stop) const
+{
+    if constexpr (std::is_same_v<MessageT, MultiMessage>)
+    {
+        return x->get_slice(start, stop);
+    }
+    else
+    {
+        // A ControlMessage has no offset of its own, the payload and each of the tensors are sliced instead
+        auto sliced = std::make_shared<ControlMessage>(*x);
+        sliced->payload(std::make_shared<SlicedMessageMeta>(x->payload(), start, stop));
+
+        if (auto tensors = x->tensors(); tensors)
+        {
+            auto sliced_tensors = std::make_shared<TensorMemory>(stop - start);
+            for (const auto& [name, tensor] : tensors->get_tensors())
+            {
+                sliced_tensors->set_tensor(name, tensor.slice({start, 0}, {stop, -1}));
+            }
+
+            sliced->tensors(sliced_tensors);
+        }
+
+        return sliced;
+    }
+}
+
+template <typename MessageT>
+typename FilterDetectionsStage<MessageT>::source_type_t FilterDetectionsStage<MessageT>::copy_ranges(
+    const sink_type_t& x, const std::vector<RangeType>& ranges, TensorIndex num_selected_rows) const
+{
+    if constexpr (std::is_same_v<MessageT, MultiMessage>)
+    {
+        return x->copy_ranges(ranges, num_selected_rows);
+    }
+    else
+    {
+        // The payload is copied by a MultiMessage spanning all of its rows
+        auto copied = std::make_shared<ControlMessage>(*x);
+        copied->payload(std::make_shared<MultiMessage>(x->payload())->copy_ranges(ranges, num_selected_rows)->meta);
+
+        if (auto tensors = x->tensors(); tensors)
+        {
+            copied->tensors(std::make_shared<TensorMemory>(num_selected_rows,
+                                                           tensors->copy_tensor_ranges(ranges, num_selected_rows)));
+        }
+
+        return copied;
+    }
+}
+
+template <typename MessageT>
+typename FilterDetectionsStage<MessageT>::subscribe_fn_t FilterDetectionsStage<MessageT>::build_operator()
 {
     return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
-        std::function<DevMemInfo(const std::shared_ptr<morpheus::MultiMessage>& x)> get_filter_source;
+        std::function<DevMemInfo(const sink_type_t& x)> get_filter_source;
 
         if (m_filter_source == FilterSource::TENSOR)
         {
-            get_filter_source = [this](auto x) {
+            get_filter_source = [this](const sink_type_t& x) {
                 return get_tensor_filter_source(x);
             };
         }
         else
         {
-            get_filter_source = [this](auto x) {
+            get_filter_source = [this](const sink_type_t& x) {
                 return get_column_filter_source(x);
             };
         }
@@ -127,60 +235,37 @@ FilterDetectionsStage::subscribe_fn_t FilterDetectionsStage::build_operator()
                 const auto num_rows    = tmp_buffer.shape(0);
                 const auto num_columns = tmp_buffer.shape(1);
 
+                MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", num_rows);
+
                 bool by_row = (num_columns > 1);
 
                 // Now call the threshold function
-                auto thresh_bool_buffer = MatxUtil::threshold(tmp_buffer, m_threshold, by_row);
+                auto thresh_bool_buffer = MatxUtil::threshold(tmp_buffer, m_threshold, by_row, m_buffer_pool);
 
-                std::vector<uint8_t> host_bool_values(num_rows);
+                // In mask mode the message is passed on whole, nothing is copied back to the host
+                if (!m_mask_column.empty())
+                {
+                    set_mask(x, thresh_bool_buffer, num_rows);
+                    output.on_next(std::move(x));
+                    return;
+                }
 
-                // Copy bools back to host
-                MRC_CHECK_CUDA(cudaMemcpy(host_bool_values.data(),
-                                          thresh_bool_buffer->data(),
-                                          thresh_bool_buffer->size(),
-                                          cudaMemcpyDeviceToHost));
+                // Only the ranges of rows above the threshold are copied back to the host
+                auto selected_ranges = MatxUtil::selected_ranges(
+                    static_cast<const bool*>(thresh_bool_buffer->data()), num_rows, thresh_bool_buffer->stream());
 
                 // Only used when m_copy is true
-                std::vector<RangeType> selected_ranges;
                 std::size_t num_selected_rows = 0;
 
-                // We are slicing by rows, using num_rows as our marker for undefined
-                std::size_t slice_start = num_rows;
-                for (std::size_t row = 0; row < num_rows; ++row)
-                {
-                    bool above_threshold = host_bool_values[row];
-
-                    if (above_threshold && slice_start == num_rows)
-                    {
-                        slice_start = row;
-                    }
-                    else if (!above_threshold && slice_start != num_rows)
-                    {
-                        if (m_copy)
-                        {
-                            selected_ranges.emplace_back(std::pair{slice_start, row});
-                            num_selected_rows += (row - slice_start);
-                        }
-                        else
-                        {
-                            output.on_next(x->get_slice(slice_start, row));
-                        }
-
-                        slice_start = num_rows;
-                    }
-                }
-
-                if (slice_start != num_rows)
+                for (const auto& [slice_start, slice_stop] : selected_ranges)
                 {
-                    // Last row was above the threshold
                     if (m_copy)
                     {
-                        selected_ranges.emplace_back(std::pair{slice_start, num_rows});
-                        num_selected_rows += (num_rows - slice_start);
+                        num_selected_rows += (slice_stop - slice_start);
                     }
                     else
                     {
-                        output.on_next(x->get_slice(slice_start, num_rows));
+                        output.on_next(slice(x, slice_start, slice_stop));
                     }
                 }
 
@@ -189,7 +274,7 @@ FilterDetectionsStage::subscribe_fn_t FilterDetectionsStage::build_operator()
                 if (num_selected_rows > 0)
                 {
                     DCHECK(m_copy);
-                    output.on_next(x->copy_ranges(selected_ranges, num_selected_rows));
+                    output.on_next(copy_ranges(x, selected_ranges, num_selected_rows));
                 }
             },
             [&](std::exception_ptr error_ptr) {
@@ -201,16 +286,36 @@ FilterDetectionsStage::subscribe_fn_t FilterDetectionsStage::build_operator()
     };
 }
 
+template class FilterDetectionsStage<MultiMessage>;
+template class FilterDetectionsStage<ControlMessage>;
+
 // ************ FilterDetectionStageInterfaceProxy ************* //
-std::shared_ptr<mrc::segment::Object<FilterDetectionsStage>> FilterDetectionStageInterfaceProxy::init(
+std::shared_ptr<mrc::segment::Object<FilterDetectionsStageMM>> FilterDetectionStageInterfaceProxy::init_multi(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    float threshold,
+    bool copy,
+    FilterSource filter_source,
+    std::string field_name,
+    std::string mask_column)
+{
+    auto stage = builder.construct_object<FilterDetectionsStageMM>(
+        name, threshold, copy, filter_source, field_name, mask_column);
+
+    return stage;
+}
+
+std::shared_ptr<mrc::segment::Object<FilterDetectionsStageCM>> FilterDetectionStageInterfaceProxy::init_cm(
     mrc::segment::Builder& builder,
     const std::string& name,
     float threshold,
     bool copy,
     FilterSource filter_source,
-    std::string field_name)
+    std::string field_name,
+    std::string mask_column)
 {
-    auto stage = builder.construct_object<FilterDetectionsStage>(name, threshold, copy, filter_source, field_name);
+    auto stage = builder.construct_object<FilterDetectionsStageCM>(
+        name, threshold, copy, filter_source, field_name, mask_column);
 
     return stage;
 }
@@ -0,0 +1,424 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/filter_rows.hpp"  // IWYU pragma: associated
+
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cudf/aggregation.hpp>  // for make_sum_aggregation
+#include <cudf/binaryop.hpp>     // for binary_operation
+#include <cudf/copying.hpp>      // for gather
+#include <cudf/dictionary/dictionary_column_view.hpp>
+#include <cudf/io/types.hpp>     // for table_with_metadata
+#include <cudf/null_mask.hpp>    // for copy_bitmask
+#include <cudf/reduction.hpp>    // for reduce
+#include <cudf/replace.hpp>      // for replace_nulls
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/stream_compaction.hpp>             // for apply_boolean_mask
+#include <cudf/strings/contains.hpp>              // for contains_re
+#include <cudf/strings/convert/convert_ipv4.hpp>  // for ipv4_to_integers, is_ipv4
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>
+#include <cudf/unary.hpp>             // for unary_operation
+#include <cudf/utilities/traits.hpp>  // for is_numeric
+#include <glog/logging.h>
+
+#include <algorithm>  // for find
+#include <cstdint>    // for uint32_t
+#include <cstdio>     // for sscanf
+#include <exception>
+#include <iterator>  // for distance
+#include <set>
+#include <sstream>  // for istringstream
+#include <stdexcept>
+#include <string>
+#include <utility>  // for move
+
+namespace morpheus {
+namespace {
+const std::set<std::string> ComparisonOps{"==", "!=", "<", "<=", ">", ">="};
+
+cudf::binary_operator to_binary_operator(const std::string& op)
+{
+    if (op == "==")
+    {
+        return cudf::binary_operator::EQUAL;
+    }
+    if (op == "!=")
+    {
+        return cudf::binary_operator::NOT_EQUAL;
+    }
+    if (op == "<")
+    {
+        return cudf::binary_operator::LESS;
+    }
+    if (op == "<=")
+    {
+        return cudf::binary_operator::LESS_EQUAL;
+    }
+    if (op == ">")
+    {
+        return cudf::binary_operator::GREATER;
+    }
+
+    return cudf::binary_operator::GREATER_EQUAL;
+}
+
+std::string trim(const std::string& value)
+{
+    const auto first = value.find_first_not_of(" \t");
+    if (first == std::string::npos)
+    {
+        return {};
+    }
+
+    return value.substr(first, value.find_last_not_of(" \t") - first + 1);
+}
+
+// Parses a CIDR block such as `10.0.0.0/8`, a single address being a /32 block
+std::pair<int64_t, int64_t> parse_cidr(const std::string& block)
+{
+    const auto slash   = block.find('/');
+    const auto address = block.substr(0, slash);
+
+    unsigned int octets[4]{};
+    char trailing = 0;
+    int prefix    = 32;
+    bool valid    = std::sscanf(address.c_str(),
+                             "%3u.%3u.%3u.%3u%c",
+                             &octets[0],
+                             &octets[1],
+                             &octets[2],
+                             &octets[3],
+                             &trailing) == 4;
+
+    if (valid && slash != std::string::npos)
+    {
+        valid = std::sscanf(block.c_str() + slash + 1, "%2d%c", &prefix, &trailing) == 1;
+    }
+
+    uint32_t ip = 0;
+    for (auto octet : octets)
+    {
+        valid = valid && octet <= 255;
+        ip    = (ip << 8) | octet;
+    }
+
+    if (!valid || prefix < 0 || prefix > 32)
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Invalid CIDR block '" << block << "'"));
+    }
+
+    const uint32_t netmask = prefix == 0 ? 0u : ~uint32_t{0} << (32 - prefix);
+
+    return {static_cast<int64_t>(ip & netmask), static_cast<int64_t>(netmask)};
+}
+
+std::unique_ptr<cudf::column> combine(std::unique_ptr<cudf::column>&& lhs,
+                                      const cudf::column_view& rhs,
+                                      cudf::binary_operator op)
+{
+    if (lhs == nullptr)
+    {
+        return std::make_unique<cudf::column>(rhs);
+    }
+
+    return cudf::binary_operation(lhs->view(), rhs, op, cudf::data_type{cudf::type_id::BOOL8});
+}
+}  // namespace
+
+// ************ RowFilter ************************************* //
+RowFilter::RowFilter(std::vector<RowPredicate> predicates, bool match_all, bool exclude) :
+  m_match_all(match_all),
+  m_exclude(exclude)
+{
+    if (predicates.empty())
+    {
+        throw std::invalid_argument("At least one predicate is required to filter rows");
+    }
+
+    for (auto& predicate : predicates)
+    {
+        CompiledPredicate compiled;
+
+        if (predicate.op == "matches")
+        {
+            compiled.program = cudf::strings::regex_program::create(predicate.value);
+        }
+        else if (predicate.op == "in_cidr")
+        {
+            std::istringstream blocks{predicate.value};
+            std::string block;
+            while (std::getline(blocks, block, ','))
+            {
+                if (!trim(block).empty())
+                {
+                    compiled.networks.push_back(parse_cidr(trim(block)));
+                }
+            }
+
+            if (compiled.networks.empty())
+            {
+                throw std::invalid_argument(
+                    MORPHEUS_CONCAT_STR("No CIDR block given for the column '" << predicate.column << "'"));
+            }
+        }
+        else if (ComparisonOps.contains(predicate.op))
+        {
+            // Compared as a string for string columns, the type of the column is only known when evaluating
+            try
+            {
+                std::size_t parsed = 0;
+                compiled.number    = std::stod(predicate.value, &parsed);
+                compiled.is_number = parsed == predicate.value.size();
+            } catch (const std::exception&)
+            {
+                compiled.is_number = false;
+            }
+        }
+        else
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unknown operator '" << predicate.op << "' for the column '"
+                                                                                 << predicate.column << "'"));
+        }
+
+        compiled.predicate = std::move(predicate);
+        m_predicates.push_back(std::move(compiled));
+    }
+}
+
+std::unique_ptr<cudf::column> RowFilter::evaluate(const CompiledPredicate& compiled, const TableInfo& table) const
+{
+    const auto& predicate   = compiled.predicate;
+    const auto column_names = table.get_column_names();
+    auto found              = std::find(column_names.begin(), column_names.end(), predicate.column);
+    if (found == column_names.end())
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to find the column '" << predicate.column << "'"));
+    }
+
+    const auto& column = table.get_column(std::distance(column_names.begin(), found));
+
+    std::unique_ptr<cudf::column> result;
+
+    if (column.type().id() == cudf::type_id::DICTIONARY32)
+    {
+        // Only the distinct values are evaluated, the result of each row being gathered through its index
+        cudf::dictionary_column_view dictionary{column};
+        auto key_results = evaluate_values(compiled, dictionary.keys());
+
+        result = std::move(cudf::gather(cudf::table_view{{key_results->view()}},
+                                        dictionary.get_indices_annotated(),
+                                        cudf::out_of_bounds_policy::NULLIFY)
+                               ->release()[0]);
+
+        if (column.has_nulls())
+        {
+            result->set_null_mask(cudf::copy_bitmask(column), column.null_count());
+        }
+    }
+    else
+    {
+        result = evaluate_values(compiled, column);
+    }
+
+    if (result->has_nulls())
+    {
+        result = cudf::replace_nulls(result->view(), cudf::numeric_scalar<bool>(false));
+    }
+
+    return result;
+}
+
+std::unique_ptr<cudf::column> RowFilter::evaluate_values(const CompiledPredicate& compiled,
+                                                         const cudf::column_view& column) const
+{
+    const auto& predicate = compiled.predicate;
+    const bool is_string  = column.type().id() == cudf::type_id::STRING;
+
+    if (!is_string && (predicate.op == "matches" || predicate.op == "in_cidr"))
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("The '" << predicate.op << "' operator requires '"
+                                                                << predicate.column << "' to be a string column"));
+    }
+
+    std::unique_ptr<cudf::column> result;
+
+    if (predicate.op == "matches")
+    {
+        result = cudf::strings::contains_re(cudf::strings_column_view{column}, *compiled.program);
+    }
+    else if (predicate.op == "in_cidr")
+    {
+        cudf::strings_column_view strings{column};
+        auto addresses = cudf::strings::ipv4_to_integers(strings);
+
+        std::unique_ptr<cudf::column> in_any;
+        for (const auto& [network, netmask] : compiled.networks)
+        {
+            auto masked = cudf::binary_operation(addresses->view(),
+                                                 cudf::numeric_scalar<int64_t>(netmask),
+                                                 cudf::binary_operator::BITWISE_AND,
+                                                 cudf::data_type{cudf::type_id::INT64});
+            auto in_block = cudf::binary_operation(masked->view(),
+                                                   cudf::numeric_scalar<int64_t>(network),
+                                                   cudf::binary_operator::EQUAL,
+                                                   cudf::data_type{cudf::type_id::BOOL8});
+
+            in_any = combine(std::move(in_any), in_block->view(), cudf::binary_operator::LOGICAL_OR);
+        }
+
+        // The integers of strings which are not IPv4 addresses are undefined
+        result = combine(cudf::strings::is_ipv4(strings), in_any->view(), cudf::binary_operator::LOGICAL_AND);
+    }
+    else
+    {
+        const auto op     = to_binary_operator(predicate.op);
+        const auto output = cudf::data_type{cudf::type_id::BOOL8};
+
+        if (is_string)
+        {
+            result = cudf::binary_operation(column, cudf::string_scalar(predicate.value), op, output);
+        }
+        else if (compiled.is_number && cudf::is_numeric(column.type()))
+        {
+            result = cudf::binary_operation(column, cudf::numeric_scalar<double>(compiled.number), op, output);
+        }
+        else
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to compare the column '"
+                                                            << predicate.column << "' with '" << predicate.value
+                                                            << "', expected a string or numeric column and value"));
+        }
+    }
+
+    return result;
+}
+
+std::unique_ptr<cudf::column> RowFilter::keep_mask(const TableInfo& table) const
+{
+    const auto op = m_match_all ? cudf::binary_operator::LOGICAL_AND : cudf::binary_operator::LOGICAL_OR;
+
+    std::unique_ptr<cudf::column> matches;
+    for (const auto& compiled : m_predicates)
+    {
+        auto result = evaluate(compiled, table);
+        matches     = matches == nullptr ? std::move(result) : combine(std::move(matches), result->view(), op);
+    }
+
+    if (m_exclude)
+    {
+        matches = cudf::unary_operation(matches->view(), cudf::unary_operator::NOT);
+    }
+
+    return matches;
+}
+
+std::shared_ptr<MessageMeta> filter_rows(const std::shared_ptr<MessageMeta>& meta, const cudf::column_view& keep_mask)
+{
+    auto info = meta->get_info();
+
+    auto num_kept = cudf::reduce(keep_mask,
+                                 *cudf::make_sum_aggregation<cudf::reduce_aggregation>(),
+                                 cudf::data_type{cudf::type_id::INT64});
+    const auto kept_rows = static_cast<cudf::numeric_scalar<int64_t>*>(num_kept.get())->value();
+
+    if (kept_rows == info.num_rows())
+    {
+        return meta;
+    }
+
+    if (kept_rows == 0)
+    {
+        return nullptr;
+    }
+
+    // Wraps the compacted table without going through python, keeping the index columns as the index
+    cudf::io::table_with_metadata kept{cudf::apply_boolean_mask(info.get_view(), keep_mask)};
+    for (const auto& name : info.get_index_names())
+    {
+        kept.metadata.schema_info.emplace_back(name);
+    }
+    for (const auto& name : info.get_column_names())
+    {
+        kept.metadata.schema_info.emplace_back(name);
+    }
+
+    return MessageMeta::create_from_cpp(std::move(kept), info.num_indices());
+}
+
+std::shared_ptr<MessageMeta> filter_rows(const std::shared_ptr<MessageMeta>& meta, const RowFilter& filter)
+{
+    return filter_rows(meta, filter.keep_mask(meta->get_info())->view());
+}
+
+// Component public implementations
+// ************ FilterRowsStage ******************************* //
+FilterRowsStage::FilterRowsStage(std::vector<RowPredicate> predicates, bool match_all, bool exclude) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_filter(std::move(predicates), match_all, exclude)
+{}
+
+FilterRowsStage::subscribe_fn_t FilterRowsStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                const auto num_rows = x->count();
+                auto filtered       = filter_rows(x, m_filter);
+
+                MORPHEUS_TRACE("filter_rows.filter", num_rows, filtered == nullptr ? 0 : filtered->count());
+
+                if (filtered == nullptr)
+                {
+                    DVLOG(10) << "Filter rows dropped every row of a message. Rows: " << num_rows;
+                    return;
+                }
+
+                DVLOG(10) << "Filter rows complete. Rows: " << num_rows << ", kept: " << filtered->count();
+                output.on_next(std::move(filtered));
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&output]() {
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ FilterRowsStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<FilterRowsStage>> FilterRowsStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    const std::vector<std::tuple<std::string, std::string, std::string>>& predicates,
+    bool match_all,
+    bool exclude)
+{
+    std::vector<RowPredicate> row_predicates;
+    row_predicates.reserve(predicates.size());
+    for (const auto& [column, op, value] : predicates)
+    {
+        row_predicates.push_back({column, op, value});
+    }
+
+    return builder.construct_object<FilterRowsStage>(name, std::move(row_predicates), match_all, exclude);
+}
+
+}  // namespace morpheus
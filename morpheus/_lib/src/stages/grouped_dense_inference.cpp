@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/stages/grouped_dense_inference.hpp"
+
+#include "morpheus/objects/dtype.hpp"   // for DType, TypeId
+#include "morpheus/objects/tensor.hpp"  // for Tensor
+
+#include <rmm/cuda_stream_view.hpp>  // for cuda_stream_per_thread
+
+#include <chrono>     // for milliseconds
+#include <cstdint>    // for int32_t
+#include <memory>     // for make_unique
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move
+#include <vector>
+
+namespace morpheus {
+
+// Component public implementations
+// ************ GroupedDenseInferenceClientSession ***********//
+GroupedDenseInferenceClientSession::GroupedDenseInferenceClientSession(std::shared_ptr<DenseModelStore> store) :
+  m_store(std::move(store))
+{}
+
+std::vector<TensorModelMapping> GroupedDenseInferenceClientSession::get_input_mappings(
+    std::vector<TensorModelMapping> input_map_overrides)
+{
+    auto mappings = std::vector<TensorModelMapping>{{"input__0", "input__0"}, {"model_index", "model_index"}};
+
+    for (auto override : input_map_overrides)
+    {
+        mappings.emplace_back(override);
+    }
+
+    return mappings;
+}
+
+std::vector<TensorModelMapping> GroupedDenseInferenceClientSession::get_output_mappings(
+    std::vector<TensorModelMapping> output_map_overrides)
+{
+    auto mappings = std::vector<TensorModelMapping>();
+
+    bool is_overridden = false;
+    for (auto override : output_map_overrides)
+    {
+        is_overridden |= override.model_field_name == "output__0";
+        mappings.emplace_back(override);
+    }
+
+    if (!is_overridden)
+    {
+        mappings.emplace_back(TensorModelMapping{"output__0", "output__0"});
+    }
+
+    return mappings;
+}
+
+mrc::coroutines::Task<TensorMap> GroupedDenseInferenceClientSession::infer(
+    TensorMap&& inputs, std::shared_ptr<mrc::coroutines::Scheduler> on)
+{
+    auto features = inputs.find("input__0");
+    auto indices  = inputs.find("model_index");
+
+    if (features == inputs.end() || indices == inputs.end())
+    {
+        throw std::invalid_argument("Grouped dense inference requires an input__0 and a model_index tensor");
+    }
+
+    const auto& input = features->second;
+
+    if (input.rank() != 2 || input.dtype().type_id() != TypeId::FLOAT32 || input.stride(1) != 1 ||
+        input.stride(0) != input.shape(1))
+    {
+        throw std::invalid_argument("The input__0 tensor must be a row major 2D float32 tensor");
+    }
+
+    auto model_index_tensor = indices->second.as_type(DType::create<int32_t>());
+
+    if (!model_index_tensor.is_compact() || static_cast<TensorIndex>(model_index_tensor.count()) != input.shape(0))
+    {
+        throw std::invalid_argument("The model_index tensor must hold one compact value per row of input__0");
+    }
+
+    auto model_indices = model_index_tensor.get_host_data<int32_t>();
+
+    TensorIndex output_size = 0;
+    auto output             = m_store->infer(static_cast<const float*>(input.data()),
+                                 input.shape(1),
+                                 model_indices,
+                                 rmm::cuda_stream_per_thread,
+                                 output_size);
+
+    TensorMap outputs;
+    outputs["output__0"].swap(
+        Tensor::create(std::move(output), DType::create<float>(), {input.shape(0), output_size}, {output_size, 1}, 0));
+
+    co_return outputs;
+}
+
+// ************ GroupedDenseInferenceClient ******************//
+GroupedDenseInferenceClient::GroupedDenseInferenceClient(std::shared_ptr<DenseModelStore> store) :
+  m_store(std::move(store))
+{}
+
+std::unique_ptr<IInferenceClientSession> GroupedDenseInferenceClient::create_session()
+{
+    return std::make_unique<GroupedDenseInferenceClientSession>(m_store);
+}
+
+// ************ GroupedDenseInferenceStageInterfaceProxy *****//
+std::shared_ptr<mrc::segment::Object<InferenceClientStage>> GroupedDenseInferenceStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::shared_ptr<DenseModelStore> model_store,
+    bool needs_logits,
+    std::map<std::string, std::string> input_mapping,
+    std::map<std::string, std::string> output_mapping,
+    TensorIndex max_batch_rows,
+    int64_t max_batch_delay_ms,
+    std::size_t num_sessions)
+{
+    if (model_store == nullptr)
+    {
+        throw std::invalid_argument("model_store must not be None");
+    }
+
+    std::vector<TensorModelMapping> input_mappings_{};
+    std::vector<TensorModelMapping> output_mappings_{};
+
+    for (auto& mapping : input_mapping)
+    {
+        input_mappings_.emplace_back(TensorModelMapping{mapping.first, mapping.second});
+    }
+
+    for (auto& mapping : output_mapping)
+    {
+        output_mappings_.emplace_back(TensorModelMapping{mapping.first, mapping.second});
+    }
+
+    return builder.construct_object<InferenceClientStage>(
+        name,
+        std::make_unique<GroupedDenseInferenceClient>(std::move(model_store)),
+        "grouped_dense",
+        needs_logits,
+        input_mappings_,
+        output_mappings_,
+        false,
+        max_batch_rows,
+        std::chrono::milliseconds(max_batch_delay_ms),
+        num_sessions);
+}
+}  // namespace morpheus
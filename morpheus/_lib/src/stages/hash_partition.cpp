@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/hash_partition.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/table_info.hpp"     // for TableInfo
+#include "morpheus/utilities/cuda_util.hpp"    // for CudaDeviceGuard
+#include "morpheus/utilities/nvtx_util.hpp"    // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <cudf/copying.hpp>       // for split
+#include <cudf/io/types.hpp>      // for table_with_metadata
+#include <cudf/partitioning.hpp>  // for hash_partition
+#include <cudf/table/table.hpp>   // for table
+#include <cudf/types.hpp>         // for size_type
+#include <glog/logging.h>
+
+#include <algorithm>    // for find
+#include <exception>    // for exception_ptr
+#include <iterator>     // for distance
+#include <stdexcept>    // for invalid_argument
+#include <type_traits>  // for is_same_v
+#include <utility>      // for move
+
+namespace morpheus {
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "HashPartitionStage");
+}  // namespace
+
+std::vector<std::shared_ptr<MessageMeta>> hash_partition(const std::shared_ptr<MessageMeta>& meta,
+                                                         const std::vector<std::string>& key_columns,
+                                                         std::size_t num_partitions)
+{
+    if (num_partitions == 1)
+    {
+        return {meta};
+    }
+
+    auto info               = meta->get_info();
+    const auto column_names = info.get_column_names();
+
+    std::vector<cudf::size_type> key_indices;
+    key_indices.reserve(key_columns.size());
+    for (const auto& key_column : key_columns)
+    {
+        auto found = std::find(column_names.begin(), column_names.end(), key_column);
+        if (found == column_names.end())
+        {
+            throw std::invalid_argument(
+                MORPHEUS_CONCAT_STR("Key column '" << key_column << "' not found in the message"));
+        }
+
+        key_indices.push_back(info.num_indices() + std::distance(column_names.begin(), found));
+    }
+
+    // Groups the rows of each partition together, the i-th partition holding the rows [offsets[i], offsets[i + 1])
+    auto [partitioned, offsets] =
+        cudf::hash_partition(info.get_view(), key_indices, static_cast<int>(num_partitions));
+
+    const std::vector<cudf::size_type> split_points(offsets.begin() + 1, offsets.end());
+    auto partition_views = cudf::split(partitioned->view(), split_points);
+
+    std::vector<std::shared_ptr<MessageMeta>> partitions;
+    partitions.reserve(num_partitions);
+    for (const auto& partition_view : partition_views)
+    {
+        if (partition_view.num_rows() == 0)
+        {
+            partitions.emplace_back(nullptr);
+            continue;
+        }
+
+        // Copies the rows of each partition into a table of its own, such that the stages downstream of different
+        // partitions never contend on the same table. Wrapped without going through python, keeping the index columns
+        // as the index
+        cudf::io::table_with_metadata partition{std::make_unique<cudf::table>(partition_view)};
+        for (const auto& name : info.get_index_names())
+        {
+            partition.metadata.schema_info.emplace_back(name);
+        }
+        for (const auto& name : column_names)
+        {
+            partition.metadata.schema_info.emplace_back(name);
+        }
+
+        partitions.push_back(MessageMeta::create_from_cpp(std::move(partition), info.num_indices()));
+    }
+
+    return partitions;
+}
+
+// Component public implementations
+// ************ HashPartitionStage ************************** //
+template <typename MessageT>
+HashPartitionStage<MessageT>::HashPartitionStage(std::vector<std::string> key_columns, std::size_t num_partitions) :
+  base_t(rxcpp::operators::map([this](sink_type_t x) {
+      return this->on_data(std::move(x));
+  })),
+  m_key_columns(std::move(key_columns)),
+  m_num_partitions(num_partitions)
+{
+    if (m_key_columns.empty())
+    {
+        throw std::invalid_argument("HashPartitionStage requires at least one key column");
+    }
+
+    if (m_num_partitions == 0)
+    {
+        throw std::invalid_argument("HashPartitionStage requires at least one partition");
+    }
+}
+
+template <typename MessageT>
+HashPartitionStage<MessageT>::source_type_t HashPartitionStage<MessageT>::on_data(sink_type_t x)
+{
+    auto output = std::make_shared<MessagePartitions<MessageT>>();
+
+    if constexpr (std::is_same_v<MessageT, MessageMeta>)
+    {
+        MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", x->count());
+        CudaDeviceGuard device_guard(x->device_id());
+        output->partitions = hash_partition(x, m_key_columns, m_num_partitions);
+    }
+    else
+    {
+        auto payload = x->payload();
+
+        MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", payload->count());
+        CudaDeviceGuard device_guard(payload->device_id());
+
+        for (auto& partition_meta : hash_partition(payload, m_key_columns, m_num_partitions))
+        {
+            if (partition_meta == nullptr)
+            {
+                output->partitions.emplace_back(nullptr);
+                continue;
+            }
+
+            // Copies the config and metadata of the message, but not its payload or tensors
+            auto partition = std::make_shared<ControlMessage>(*x);
+            partition->payload(std::move(partition_meta));
+            output->partitions.push_back(std::move(partition));
+        }
+    }
+
+    return output;
+}
+
+template class HashPartitionStage<MessageMeta>;
+template class HashPartitionStage<ControlMessage>;
+
+// ************ PartitionSelectStage ************************ //
+template <typename MessageT>
+PartitionSelectStage<MessageT>::PartitionSelectStage(std::size_t partition) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_partition(partition)
+{}
+
+template <typename MessageT>
+PartitionSelectStage<MessageT>::subscribe_fn_t PartitionSelectStage<MessageT>::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                if (m_partition >= x->partitions.size())
+                {
+                    throw std::invalid_argument(MORPHEUS_CONCAT_STR("Partition " << m_partition
+                                                                                 << " out of range of the "
+                                                                                 << x->partitions.size()
+                                                                                 << " partitions of a message"));
+                }
+
+                const auto& partition = x->partitions[m_partition];
+                if (partition == nullptr)
+                {
+                    DVLOG(10) << "Partition " << m_partition << " of a message is empty";
+                    return;
+                }
+
+                output.on_next(partition);
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&output]() {
+                output.on_completed();
+            }));
+    };
+}
+
+template class PartitionSelectStage<MessageMeta>;
+template class PartitionSelectStage<ControlMessage>;
+
+// ************ HashPartitionStageInterfaceProxy ************ //
+std::shared_ptr<mrc::segment::Object<HashPartitionStageMeta>> HashPartitionStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::vector<std::string> key_columns,
+    std::size_t num_partitions)
+{
+    return builder.construct_object<HashPartitionStageMeta>(name, std::move(key_columns), num_partitions);
+}
+
+std::shared_ptr<mrc::segment::Object<HashPartitionStageCM>> HashPartitionStageInterfaceProxy::init_cm(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::vector<std::string> key_columns,
+    std::size_t num_partitions)
+{
+    return builder.construct_object<HashPartitionStageCM>(name, std::move(key_columns), num_partitions);
+}
+
+// ************ PartitionSelectStageInterfaceProxy ********** //
+std::shared_ptr<mrc::segment::Object<PartitionSelectStageMeta>> PartitionSelectStageInterfaceProxy::init(
+    mrc::segment::Builder& builder, const std::string& name, std::size_t partition)
+{
+    return builder.construct_object<PartitionSelectStageMeta>(name, partition);
+}
+
+std::shared_ptr<mrc::segment::Object<PartitionSelectStageCM>> PartitionSelectStageInterfaceProxy::init_cm(
+    mrc::segment::Builder& builder, const std::string& name, std::size_t partition)
+{
+    return builder.construct_object<PartitionSelectStageCM>(name, partition);
+}
+}  // namespace morpheus
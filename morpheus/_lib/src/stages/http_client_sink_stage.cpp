@@ -0,0 +1,494 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/http_client_sink_stage.hpp"  // IWYU pragma: associated
+
+#include "mrc/segment/builder.hpp"
+#include "mrc/segment/object.hpp"
+#include "pymrc/node.hpp"
+
+#include "morpheus/io/serializers.hpp"
+#include "morpheus/objects/table_info.hpp"
+#include "morpheus/utilities/nvtx_util.hpp"  // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+#include "morpheus/utilities/string_util.hpp"
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>  // for resolver, socket
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/read.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/write.hpp>
+#include <boost/beast/version.hpp>
+#include <boost/fiber/buffered_channel.hpp>
+#include <boost/fiber/channel_op_status.hpp>
+#include <glog/logging.h>
+
+#include <algorithm>  // for find, max
+#include <bit>        // for bit_ceil
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <thread>
+#include <utility>
+
+namespace morpheus {
+
+namespace beast = boost::beast;
+namespace http  = beast::http;
+namespace net   = boost::asio;
+
+// Component-private classes.
+// ************ HttpClientSinkStage__ErrorState **********************//
+/**
+ * @brief Records the first request which failed after exhausting its retries
+ */
+class HttpClientSinkStage__ErrorState  // NOLINT
+{
+  public:
+    void set_error(std::string error)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_error.has_value())
+        {
+            m_error = std::move(error);
+        }
+    }
+
+    /**
+     * @brief Returns the first error since the last call, if any
+     */
+    std::optional<std::string> take_error()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return std::exchange(m_error, std::nullopt);
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::optional<std::string> m_error;
+};
+
+// ************ HttpClientSinkStage__Connection **********************//
+/**
+ * @brief A persistent connection to the server, owned by a single worker thread. The connection is re-established
+ * lazily after the server closes it or an error occurs.
+ */
+class HttpClientSinkStage__Connection  // NOLINT
+{
+  public:
+    HttpClientSinkStage__Connection(const std::string& host,
+                                    const std::string& port,
+                                    std::chrono::seconds request_timeout) :
+      m_host{host},
+      m_port{port},
+      m_request_timeout{request_timeout},
+      m_resolver{m_io_context},
+      m_stream{m_io_context}
+    {}
+
+    ~HttpClientSinkStage__Connection()
+    {
+        this->close();
+    }
+
+    /**
+     * @brief Sends `request` and returns the response. Throws on any network error.
+     */
+    http::response<http::string_body> send(const http::request<http::string_body>& request)
+    {
+        if (!m_connected)
+        {
+            if (m_endpoints.empty())
+            {
+                m_endpoints = m_resolver.resolve(m_host, m_port);
+            }
+
+            m_stream.expires_after(m_request_timeout);
+            m_stream.connect(m_endpoints);
+            m_connected = true;
+        }
+
+        try
+        {
+            http::response<http::string_body> response;
+
+            m_stream.expires_after(m_request_timeout);
+            http::write(m_stream, request);
+            http::read(m_stream, m_buffer, response);
+
+            if (response.need_eof())
+            {
+                this->close();
+            }
+
+            return response;
+        } catch (...)
+        {
+            this->close();
+            throw;
+        }
+    }
+
+    void close()
+    {
+        if (m_connected)
+        {
+            beast::error_code ec;
+            m_stream.socket().shutdown(net::ip::tcp::socket::shutdown_both, ec);
+            m_stream.close();
+            m_buffer.clear();
+            m_connected = false;
+        }
+    }
+
+  private:
+    std::string m_host;
+    std::string m_port;
+    std::chrono::seconds m_request_timeout;
+
+    net::io_context m_io_context;
+    net::ip::tcp::resolver m_resolver;
+    net::ip::tcp::resolver::results_type m_endpoints;
+    beast::tcp_stream m_stream;
+    beast::flat_buffer m_buffer;
+    bool m_connected{false};
+};
+
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "HttpClientSinkStage");
+
+/**
+ * @brief Appends the `num_rows` JSON lines starting at `first` of `json_lines` to `payload`, when `lines` is false the
+ * rows are written as a JSON array. Returns the position following the last row.
+ */
+std::size_t make_payload(const std::string& json_lines,
+                         std::size_t first,
+                         std::size_t num_rows,
+                         bool lines,
+                         std::string& payload)
+{
+    std::size_t last = first;
+    for (std::size_t i = 0; i < num_rows && last < json_lines.size(); ++i)
+    {
+        last = json_lines.find('\n', last);
+        last = (last == std::string::npos) ? json_lines.size() : last + 1;
+    }
+
+    if (lines)
+    {
+        payload.assign(json_lines, first, last - first);
+        return last;
+    }
+
+    payload.clear();
+    payload.reserve(last - first + 2);
+    payload += '[';
+
+    for (auto pos = first; pos < last; ++pos)
+    {
+        char c = json_lines[pos];
+        if (c == '\n')
+        {
+            // Replace each row terminator with a separator, omitting the last one
+            if (pos + 1 < last)
+            {
+                payload += ',';
+            }
+        }
+        else
+        {
+            payload += c;
+        }
+    }
+
+    payload += ']';
+
+    return last;
+}
+}  // namespace
+
+// Component public implementations
+// ************ HttpClientSinkStage **************************** //
+HttpClientSinkStage::HttpClientSinkStage(std::string host,
+                                         unsigned short port,
+                                         std::string target,
+                                         std::string method,
+                                         std::map<std::string, std::string> headers,
+                                         std::chrono::milliseconds error_sleep_time,
+                                         bool respect_retry_after_header,
+                                         std::chrono::seconds request_timeout,
+                                         std::vector<unsigned> accept_status_codes,
+                                         std::size_t max_retries,
+                                         std::size_t max_rows_per_payload,
+                                         bool lines,
+                                         std::size_t max_connections) :
+  PythonNode(base_t::op_factory_from_sub_fn(build_operator())),
+  m_host(std::move(host)),
+  m_port(std::to_string(port)),
+  m_target(std::move(target)),
+  m_method(http::string_to_verb(method)),
+  m_headers(std::move(headers)),
+  m_error_sleep_time(error_sleep_time),
+  m_respect_retry_after_header(respect_retry_after_header),
+  m_request_timeout(request_timeout),
+  m_accept_status_codes(std::move(accept_status_codes)),
+  m_max_retries(max_retries),
+  m_max_rows_per_payload(max_rows_per_payload),
+  m_lines(lines),
+  m_max_connections(max_connections)
+{
+    if (m_method != http::verb::post && m_method != http::verb::put && m_method != http::verb::patch)
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unsupported method: " << method));
+    }
+
+    if (m_max_rows_per_payload == 0)
+    {
+        throw std::invalid_argument("max_rows_per_payload must be greater than 0");
+    }
+
+    if (m_max_connections == 0)
+    {
+        throw std::invalid_argument("max_connections must be greater than 0");
+    }
+
+    if (m_target.empty() || m_target.front() != '/')
+    {
+        m_target.insert(0, 1, '/');
+    }
+
+    if (m_headers.find("Content-Type") == m_headers.end())
+    {
+        m_headers["Content-Type"] = m_lines ? "text/plain" : "application/json";
+    }
+}
+
+HttpClientSinkStage::subscribe_fn_t HttpClientSinkStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        HttpClientSinkStage__ErrorState error_state;
+
+        // Capacity must be a power of two, allow each worker to have one payload queued behind the one in flight
+        std::size_t queue_size = std::bit_ceil(std::max<std::size_t>(2, m_max_connections));
+        boost::fibers::buffered_channel<std::string> payloads{queue_size};
+
+        auto send_with_retry = [this](HttpClientSinkStage__Connection& connection, std::string body) {
+            http::request<http::string_body> request{m_method, m_target, 11};
+            request.set(http::field::host, m_host);
+            request.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+
+            for (const auto& [key, value] : m_headers)
+            {
+                request.set(key, value);
+            }
+
+            request.keep_alive(true);
+            request.body() = std::move(body);
+            request.prepare_payload();
+
+            for (std::size_t attempt = 1;; ++attempt)
+            {
+                std::optional<std::chrono::milliseconds> retry_after;
+                std::string error_msg;
+
+                try
+                {
+                    auto response = connection.send(request);
+                    auto status   = response.result_int();
+
+                    if (std::find(m_accept_status_codes.begin(), m_accept_status_codes.end(), status) !=
+                        m_accept_status_codes.end())
+                    {
+                        return;
+                    }
+
+                    if (auto header = response.find(http::field::retry_after);
+                        m_respect_retry_after_header && header != response.end())
+                    {
+                        try
+                        {
+                            retry_after = std::chrono::seconds(std::stoul(std::string(header->value())));
+                        } catch (const std::exception&)
+                        {
+                            // HTTP-date values are not supported, fall back to the exponential backoff
+                        }
+                    }
+
+                    error_msg =
+                        MORPHEUS_CONCAT_STR("Received unexpected status code " << status << ": " << response.body());
+                } catch (const std::exception& e)
+                {
+                    error_msg = e.what();
+                }
+
+                if (attempt >= m_max_retries)
+                {
+                    throw std::runtime_error(
+                        MORPHEUS_CONCAT_STR("Failed after " << attempt << " attempts: " << error_msg));
+                }
+
+                auto backoff    = m_error_sleep_time * (1 << std::min<std::size_t>(attempt - 1, 16));
+                auto sleep_time = retry_after.value_or(backoff);
+
+                LOG(ERROR) << "Error occurred performing " << m_method << " request to " << m_host << ":" << m_port
+                           << m_target << ": " << error_msg << ". Retrying in " << sleep_time.count() << "ms";
+
+                std::this_thread::sleep_for(sleep_time);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(m_max_connections);
+
+        for (std::size_t i = 0; i < m_max_connections; ++i)
+        {
+            workers.emplace_back([this, &payloads, &error_state, &send_with_retry]() {
+                HttpClientSinkStage__Connection connection{m_host, m_port, m_request_timeout};
+                std::string body;
+
+                while (payloads.pop(body) == boost::fibers::channel_op_status::success)
+                {
+                    try
+                    {
+                        send_with_retry(connection, std::move(body));
+                    } catch (const std::exception& e)
+                    {
+                        LOG(ERROR) << "Error occurred in HttpClientSinkStage: " << e.what();
+                        error_state.set_error(e.what());
+                    }
+                }
+            });
+        }
+
+        auto shutdown = [&]() {
+            // Closing the channel allows the workers to drain the remaining payloads before exiting
+            payloads.close();
+
+            for (auto& worker : workers)
+            {
+                worker.join();
+            }
+
+            workers.clear();
+        };
+
+        auto make_request_error = [this](const std::string& error) {
+            return std::make_exception_ptr(std::runtime_error(MORPHEUS_CONCAT_STR(
+                "Error occurred in HttpClientSinkStage while writing to " << m_host << ":" << m_port << m_target
+                                                                          << ". Error: " << error)));
+        };
+
+        auto subscription = input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [&](sink_type_t msg) {
+                if (auto error = error_state.take_error(); error.has_value())
+                {
+                    output.on_error(make_request_error(*error));
+                    return;
+                }
+
+                auto info     = msg->get_info();
+                auto num_rows = static_cast<std::size_t>(info.num_rows());
+
+                MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", num_rows);
+
+                if (num_rows > 0)
+                {
+                    // Serialize every row on the GPU once, and split the result into payloads on the host
+                    auto json_lines = df_to_json(info);
+
+                    std::size_t pos = 0;
+                    for (std::size_t row = 0; row < num_rows; row += m_max_rows_per_payload)
+                    {
+                        std::string payload;
+                        pos = make_payload(json_lines, pos, m_max_rows_per_payload, m_lines, payload);
+
+                        // Blocks while all of the workers are busy, applying backpressure upstream
+                        if (payloads.push(std::move(payload)) != boost::fibers::channel_op_status::success)
+                        {
+                            output.on_error(make_request_error("payload queue closed"));
+                            return;
+                        }
+                    }
+                }
+
+                output.on_next(std::move(msg));
+            },
+            [&](std::exception_ptr error_ptr) {
+                shutdown();
+                output.on_error(error_ptr);
+            },
+            [&]() {
+                shutdown();
+
+                if (auto error = error_state.take_error(); error.has_value())
+                {
+                    output.on_error(make_request_error(*error));
+                    return;
+                }
+
+                output.on_completed();
+            }));
+
+        return subscription;
+    };
+}
+
+// ************ HttpClientSinkStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<HttpClientSinkStage>> HttpClientSinkStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string host,
+    unsigned short port,
+    std::string target,
+    std::string method,
+    std::map<std::string, std::string> headers,
+    float error_sleep_time,
+    bool respect_retry_after_header,
+    int64_t request_timeout,
+    std::vector<unsigned> accept_status_codes,
+    std::size_t max_retries,
+    std::size_t max_rows_per_payload,
+    bool lines,
+    std::size_t max_connections)
+{
+    auto stage = builder.construct_object<HttpClientSinkStage>(
+        name,
+        std::move(host),
+        port,
+        std::move(target),
+        std::move(method),
+        std::move(headers),
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::duration<float>(error_sleep_time)),
+        respect_retry_after_header,
+        std::chrono::seconds(request_timeout),
+        std::move(accept_status_codes),
+        max_retries,
+        max_rows_per_payload,
+        lines,
+        max_connections);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -17,17 +17,27 @@
 
 #include "morpheus/stages/http_server_source_stage.hpp"
 
+#include "morpheus/io/deserializers.hpp"          // for apply_column_projection, read_json_lines_recovering
+#include "morpheus/objects/memory_governor.hpp"  // for MemoryGovernor
+#include "morpheus/utilities/nvtx_util.hpp"      // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+
 #include <boost/beast/http/status.hpp>        // for int_to_status, status
 #include <boost/fiber/channel_op_status.hpp>  // for channel_op_status
 #include <cudf/io/json.hpp>                   // for json_reader_options & read_json
+#include <cudf/types.hpp>                     // for size_type
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
 #include <glog/logging.h>                     // for CHECK & LOG
+#include <rmm/cuda_stream.hpp>                // for cuda_stream
+#include <rmm/cuda_stream_view.hpp>           // for cuda_stream_view
 
+#include <algorithm>  // for count
 #include <exception>  // for std::exception
 #include <sstream>    // needed by GLOG
-#include <stdexcept>  // for std::runtime_error
-#include <thread>     // for std::this_thread::sleep_for
+#include <stdexcept>  // for std::runtime_error, std::invalid_argument
 #include <tuple>      // for make_tuple
-#include <utility>    // for std::move
+#include <string_view>
+#include <utility>  // for std::move
+#include <vector>
 // IWYU thinks we need more boost headers than we need as int_to_status is defined in status.hpp
 // IWYU pragma: no_include <boost/beast/http.hpp>
 
@@ -36,6 +46,73 @@ namespace morpheus {
 class SourceStageStopAfter : public std::exception
 {};
 
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "HttpServerSourceStage");
+
+/**
+ * @brief Builds the response returned to the client after attempting to push the payload to a queue
+ */
+parse_status_t make_queue_response(boost::fibers::channel_op_status queue_status, unsigned accept_status)
+{
+    if (queue_status == boost::fibers::channel_op_status::success)
+    {
+        return std::make_tuple(accept_status, "text/plain", std::string(), nullptr);
+    }
+
+    std::string error_msg = "HTTP payload queue is ";
+    switch (queue_status)
+    {
+    case boost::fibers::channel_op_status::full:
+    case boost::fibers::channel_op_status::timeout: {
+        error_msg += "full";
+        break;
+    }
+
+    case boost::fibers::channel_op_status::closed: {
+        error_msg += "closed";
+        break;
+    }
+    default: {
+        error_msg += "in an unknown state";
+        break;
+    }
+    }
+
+    return std::make_tuple(503u, "text/plain", std::move(error_msg), nullptr);
+}
+
+cudf::io::table_with_metadata parse_json(const char* data,
+                                         std::size_t size,
+                                         bool lines,
+                                         const ColumnProjection& projection,
+                                         rmm::cuda_stream_view stream = cudf::get_default_stream())
+{
+    cudf::io::table_with_metadata table;
+
+    if (lines)
+    {
+        // Only the malformed lines of a payload are dropped, rather than rejecting it along with its valid lines
+        cudf::size_type num_malformed = 0;
+        table = read_json_lines_recovering(data, size, {}, false, num_malformed, stream);
+
+        if (num_malformed > 0)
+        {
+            LOG(ERROR) << "Failed to parse " << num_malformed << " of " << (table.tbl->num_rows() + num_malformed)
+                       << " lines of HTTP payloads as json, dropping them";
+        }
+    }
+    else
+    {
+        cudf::io::source_info source{data, size};
+        auto options = cudf::io::json_reader_options::builder(source).lines(false);
+        table        = cudf::io::read_json(options.build(), stream);
+    }
+
+    apply_column_projection(table, projection);
+    return table;
+}
+}  // namespace
+
 // Component public implementations
 // ************ HttpServerSourceStage ************* //
 HttpServerSourceStage::HttpServerSourceStage(std::string bind_address,
@@ -50,24 +127,93 @@ HttpServerSourceStage::HttpServerSourceStage(std::string bind_address,
                                              std::size_t max_payload_size,
                                              std::chrono::seconds request_timeout,
                                              bool lines,
-                                             std::size_t stop_after) :
+                                             std::size_t stop_after,
+                                             bool coalesce_payloads,
+                                             std::size_t max_batch_bytes,
+                                             std::size_t max_batch_rows,
+                                             std::chrono::milliseconds max_batch_delay,
+                                             std::size_t stream_chunk_size,
+                                             std::size_t num_parse_workers,
+                                             ColumnProjection projection,
+                                             const std::string& payload_format,
+                                             const std::string& capture_path) :
   PythonSource(build()),
-  m_sleep_time{sleep_time},
+  m_sleep_time{std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<float>(sleep_time))},
   m_queue_timeout{queue_timeout},
-  m_queue{max_queue_size},
+  m_queue{coalesce_payloads ? 2 : max_queue_size},
   m_stop_after{stop_after},
-  m_records_emitted{0}
+  m_records_emitted{0},
+  m_lines{lines},
+  m_coalesce_payloads{coalesce_payloads},
+  m_max_batch_bytes{max_batch_bytes},
+  m_max_batch_rows{max_batch_rows},
+  m_max_batch_delay{max_batch_delay},
+  m_num_parse_workers{num_parse_workers},
+  m_payload_queue{coalesce_payloads || num_parse_workers > 0 ? max_queue_size : 2},
+  m_projection{std::move(projection)},
+  m_decoder{payload_format == "json" ? nullptr : PayloadDecoder::create(payload_format)},
+  m_capture{capture_path.empty() ? nullptr : std::make_shared<SourceCaptureWriter>(capture_path)}
 {
     CHECK(boost::beast::http::int_to_status(accept_status) != boost::beast::http::status::unknown)
         << "Invalid HTTP status code: " << accept_status;
 
-    payload_parse_fn_t parser = [this, accept_status, lines](const std::string& payload) {
+    if (coalesce_payloads && !lines)
+    {
+        throw std::invalid_argument("Coalescing payloads requires the payloads to be in the JSON lines format");
+    }
+
+    if (stream_chunk_size > 0 && !lines)
+    {
+        throw std::invalid_argument("Streaming payloads requires the payloads to be in the JSON lines format");
+    }
+
+    if (m_decoder != nullptr && (coalesce_payloads || stream_chunk_size > 0))
+    {
+        // Binary payloads can not be split or joined at line boundaries
+        throw std::invalid_argument("Coalescing and streaming payloads are only supported for JSON payloads");
+    }
+
+    if (coalesce_payloads && num_parse_workers > 0)
+    {
+        // Coalesced payloads are already parsed by the source rather than the server threads
+        throw std::invalid_argument("num_parse_workers can not be used when coalescing payloads");
+    }
+
+    payload_parse_fn_t parser = [this, accept_status](const std::string& payload) -> parse_status_t {
+        // Reject payloads before they are parsed onto the device while the device memory is above the high watermark,
+        // letting clients retry once the pipeline has caught up
+        if (auto* governor = MemoryGovernor::get(); governor != nullptr && governor->is_throttled())
+        {
+            return std::make_tuple(503u, "text/plain", std::string("GPU memory is above the high watermark"), nullptr);
+        }
+
+        if (m_coalesce_payloads || m_num_parse_workers > 0)
+        {
+            // Parsing is deferred until the payloads have been coalesced or picked up by a parse worker, keeping the
+            // server threads free for I/O, at which point it is too late to reject a malformed payload
+            try
+            {
+                ++m_pending_payloads;
+                auto queue_status = m_payload_queue.push_wait_for(std::string(payload), m_queue_timeout);
+
+                if (queue_status != boost::fibers::channel_op_status::success)
+                {
+                    --m_pending_payloads;
+                }
+
+                return make_queue_response(queue_status, accept_status);
+            } catch (const std::exception& e)
+            {
+                std::string error_msg = "Error occurred while pushing payload to queue";
+                LOG(ERROR) << error_msg << ": " << e.what();
+                return std::make_tuple(500u, "text/plain", error_msg, nullptr);
+            }
+        }
+
         std::unique_ptr<cudf::io::table_with_metadata> table{nullptr};
         try
         {
-            cudf::io::source_info source{payload.c_str(), payload.size()};
-            auto options = cudf::io::json_reader_options::builder(source).lines(lines);
-            table        = std::make_unique<cudf::io::table_with_metadata>(cudf::io::read_json(options.build()));
+            table = std::make_unique<cudf::io::table_with_metadata>(parse_payload(payload));
         } catch (const std::exception& e)
         {
             std::string error_msg = "Error occurred converting HTTP payload to Dataframe";
@@ -79,33 +225,7 @@ HttpServerSourceStage::HttpServerSourceStage(std::string bind_address,
         {
             // NOLINTNEXTLINE(clang-diagnostic-unused-value)
             DCHECK_NOTNULL(table);
-            auto queue_status = m_queue.push_wait_for(std::move(table), m_queue_timeout);
-
-            if (queue_status == boost::fibers::channel_op_status::success)
-            {
-                return std::make_tuple(accept_status, "text/plain", std::string(), nullptr);
-            }
-
-            std::string error_msg = "HTTP payload queue is ";
-            switch (queue_status)
-            {
-            case boost::fibers::channel_op_status::full:
-            case boost::fibers::channel_op_status::timeout: {
-                error_msg += "full";
-                break;
-            }
-
-            case boost::fibers::channel_op_status::closed: {
-                error_msg += "closed";
-                break;
-            }
-            default: {
-                error_msg += "in an unknown state";
-                break;
-            }
-            }
-
-            return std::make_tuple(503u, "text/plain", std::move(error_msg), nullptr);
+            return make_queue_response(m_queue.push_wait_for(std::move(table), m_queue_timeout), accept_status);
         } catch (const std::exception& e)
         {
             std::string error_msg = "Error occurred while pushing payload to queue";
@@ -120,7 +240,8 @@ HttpServerSourceStage::HttpServerSourceStage(std::string bind_address,
                                             std::move(method),
                                             num_server_threads,
                                             max_payload_size,
-                                            request_timeout);
+                                            request_timeout,
+                                            stream_chunk_size);
 }
 
 HttpServerSourceStage::subscriber_fn_t HttpServerSourceStage::build()
@@ -128,8 +249,21 @@ HttpServerSourceStage::subscriber_fn_t HttpServerSourceStage::build()
     return [this](rxcpp::subscriber<source_type_t> subscriber) -> void {
         try
         {
+            for (std::size_t i = 0; i < m_num_parse_workers; ++i)
+            {
+                m_parse_workers.emplace_back(&HttpServerSourceStage::parse_worker, this);
+            }
+
             m_server->start();
-            this->source_generator(subscriber);
+
+            if (m_coalesce_payloads)
+            {
+                this->coalescing_source_generator(subscriber);
+            }
+            else
+            {
+                this->source_generator(subscriber);
+            }
         } catch (const SourceStageStopAfter& e)
         {
             DLOG(INFO) << "Completed after emitting " << m_records_emitted << " records";
@@ -153,51 +287,215 @@ void HttpServerSourceStage::source_generator(rxcpp::subscriber<HttpServerSourceS
     while (subscriber.is_subscribed() && server_running && !queue_closed)
     {
         table_t table_ptr{nullptr};
-        auto queue_status = m_queue.try_pop(table_ptr);
+
+        // Block until a request arrives, waking up periodically to check if the server is still running
+        auto queue_status = m_queue.pop_wait_for(table_ptr, m_sleep_time);
         if (queue_status == boost::fibers::channel_op_status::success)
         {
             // NOLINTNEXTLINE(clang-diagnostic-unused-value)
             DCHECK_NOTNULL(table_ptr);
-            try
+            this->emit_table(std::move(*table_ptr), subscriber);
+        }
+        else if (queue_status == boost::fibers::channel_op_status::timeout ||
+                 queue_status == boost::fibers::channel_op_status::empty)
+        {
+            // if the queue is empty, maybe it's because our server is not running, payloads which were accepted but not
+            // yet parsed still need to be emitted
+            server_running = m_server->is_running() || m_pending_payloads > 0;
+        }
+        else if (queue_status == boost::fibers::channel_op_status::closed)
+        {
+            queue_closed = true;
+        }
+        else
+        {
+            std::string error_msg{"Unknown queue status: " + std::to_string(static_cast<int>(queue_status))};
+            LOG(ERROR) << error_msg;
+            throw std::runtime_error(error_msg);
+        }
+    }
+}
+
+void HttpServerSourceStage::coalescing_source_generator(
+    rxcpp::subscriber<HttpServerSourceStage::source_type_t> subscriber)
+{
+    bool server_running = true;
+    bool queue_closed   = false;
+
+    std::string batch;
+    std::vector<std::size_t> payload_offsets;
+
+    while (subscriber.is_subscribed() && server_running && !queue_closed)
+    {
+        std::string payload;
+
+        // Block until the first payload of the batch arrives
+        auto queue_status = m_payload_queue.pop_wait_for(payload, m_sleep_time);
+
+        if (queue_status == boost::fibers::channel_op_status::timeout ||
+            queue_status == boost::fibers::channel_op_status::empty)
+        {
+            server_running = m_server->is_running();
+            continue;
+        }
+
+        if (queue_status == boost::fibers::channel_op_status::closed)
+        {
+            queue_closed = true;
+            continue;
+        }
+
+        batch.clear();
+        payload_offsets.clear();
+        std::size_t num_rows = 0;
+
+        auto append_payload = [&](const std::string& payload) {
+            payload_offsets.push_back(batch.size());
+            batch += payload;
+
+            // Ensure each payload is terminated so that the last record is not merged with the next payload
+            if (!batch.empty() && batch.back() != '\n')
             {
-                auto message     = MessageMeta::create_from_cpp(std::move(*table_ptr), 0);
-                auto num_records = message->count();
-                subscriber.on_next(std::move(message));
-                m_records_emitted += num_records;
-            } catch (const std::exception& e)
+                batch += '\n';
+            }
+
+            num_rows += std::count(batch.begin() + payload_offsets.back(), batch.end(), '\n');
+        };
+
+        append_payload(payload);
+
+        auto batch_end = std::chrono::steady_clock::now() + m_max_batch_delay;
+
+        while (batch.size() < m_max_batch_bytes && (m_max_batch_rows == 0 || num_rows < m_max_batch_rows))
+        {
+            auto now = std::chrono::steady_clock::now();
+
+            if (now >= batch_end)
             {
-                LOG(ERROR) << "Error occurred converting HTTP payload to Dataframe: " << e.what();
+                break;
             }
 
-            if (m_stop_after > 0 && m_records_emitted >= m_stop_after)
+            queue_status = m_payload_queue.pop_wait_for(payload, batch_end - now);
+
+            if (queue_status != boost::fibers::channel_op_status::success)
             {
-                throw SourceStageStopAfter();
+                // The queue being closed is picked up by the outer loop once the batch has been emitted
+                break;
             }
+
+            append_payload(payload);
         }
-        else if (queue_status == boost::fibers::channel_op_status::empty)
+
+        try
         {
-            // if the queue is empty, maybe it's because our server is not running
-            server_running = m_server->is_running();
+            this->emit_table(parse_json(batch.data(), batch.size(), m_lines, m_projection), subscriber);
+        } catch (const SourceStageStopAfter&)
+        {
+            throw;
+        } catch (const std::exception& e)
+        {
+            // The client has already been told the payloads were accepted, rather than dropping the entire batch,
+            // parse each payload separately to isolate the malformed ones
+            LOG(ERROR) << "Error occurred converting " << payload_offsets.size()
+                       << " coalesced HTTP payloads to a Dataframe, parsing individually: " << e.what();
+
+            payload_offsets.push_back(batch.size());
 
-            if (server_running)
+            for (std::size_t i = 0; i + 1 < payload_offsets.size(); ++i)
             {
-                // Sleep when there are no messages
-                std::this_thread::sleep_for(m_sleep_time);
+                try
+                {
+                    auto table = parse_json(batch.data() + payload_offsets[i],
+                                            payload_offsets[i + 1] - payload_offsets[i],
+                                            m_lines,
+                                            m_projection);
+                    this->emit_table(std::move(table), subscriber);
+                } catch (const SourceStageStopAfter&)
+                {
+                    throw;
+                } catch (const std::exception& e)
+                {
+                    LOG(ERROR) << "Error occurred converting HTTP payload to Dataframe, dropping payload: "
+                               << e.what();
+                }
             }
         }
-        else if (queue_status == boost::fibers::channel_op_status::closed)
+    }
+}
+
+cudf::io::table_with_metadata HttpServerSourceStage::parse_payload(std::string_view payload,
+                                                                  rmm::cuda_stream_view stream) const
+{
+    if (m_decoder == nullptr)
+    {
+        return parse_json(payload.data(), payload.size(), m_lines, m_projection, stream);
+    }
+
+    auto table = m_decoder->decode({payload}, stream);
+    apply_column_projection(table, m_projection);
+    return table;
+}
+
+void HttpServerSourceStage::parse_worker()
+{
+    // Each worker parses on its own stream, allowing parses to overlap on the GPU without blocking the server threads
+    rmm::cuda_stream stream;
+    std::string payload;
+
+    while (m_payload_queue.pop(payload) == boost::fibers::channel_op_status::success)
+    {
+        auto queue_status = boost::fibers::channel_op_status::success;
+
+        try
         {
-            queue_closed = true;
+            auto table = std::make_unique<cudf::io::table_with_metadata>(parse_payload(payload, stream.view()));
+
+            // Downstream stages use the default stream
+            stream.synchronize();
+
+            queue_status = m_queue.push(std::move(table));
+        } catch (const std::exception& e)
+        {
+            // The client has already been told the payload was accepted
+            LOG(ERROR) << "Error occurred converting HTTP payload to Dataframe, dropping payload: " << e.what();
         }
-        else
+
+        --m_pending_payloads;
+
+        if (queue_status == boost::fibers::channel_op_status::closed)
         {
-            std::string error_msg{"Unknown queue status: " + std::to_string(static_cast<int>(queue_status))};
-            LOG(ERROR) << error_msg;
-            throw std::runtime_error(error_msg);
+            break;
         }
     }
 }
 
+void HttpServerSourceStage::emit_table(cudf::io::table_with_metadata&& table,
+                                       rxcpp::subscriber<HttpServerSourceStage::source_type_t>& subscriber)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "emit_table", table.tbl->num_rows());
+
+    try
+    {
+        if (m_capture != nullptr)
+        {
+            m_capture->write(table.tbl->view(), table.metadata);
+        }
+
+        auto message     = MessageMeta::create_from_cpp(std::move(table), 0);
+        auto num_records = message->count();
+        subscriber.on_next(std::move(message));
+        m_records_emitted += num_records;
+    } catch (const std::exception& e)
+    {
+        LOG(ERROR) << "Error occurred converting HTTP payload to Dataframe: " << e.what();
+    }
+
+    if (m_stop_after > 0 && m_records_emitted >= m_stop_after)
+    {
+        throw SourceStageStopAfter();
+    }
+}
+
 void HttpServerSourceStage::close()
 {
     if (m_server)
@@ -206,6 +504,15 @@ void HttpServerSourceStage::close()
         m_server.reset();
     }
     m_queue.close();
+    m_payload_queue.close();
+
+    // The queues are closed first, ensuring that none of the workers are left blocked on a full queue
+    for (auto& worker : m_parse_workers)
+    {
+        worker.join();
+    }
+
+    m_parse_workers.clear();
 }
 
 HttpServerSourceStage::~HttpServerSourceStage()
@@ -229,7 +536,16 @@ std::shared_ptr<mrc::segment::Object<HttpServerSourceStage>> HttpServerSourceSta
     std::size_t max_payload_size,
     int64_t request_timeout,
     bool lines,
-    std::size_t stop_after)
+    std::size_t stop_after,
+    bool coalesce_payloads,
+    std::size_t max_batch_bytes,
+    std::size_t max_batch_rows,
+    int64_t max_batch_delay_ms,
+    std::size_t stream_chunk_size,
+    std::size_t num_parse_workers,
+    const std::vector<std::string>& projection,
+    const std::string& payload_format,
+    const std::string& capture_path)
 {
     return builder.construct_object<HttpServerSourceStage>(
 
@@ -246,6 +562,15 @@ std::shared_ptr<mrc::segment::Object<HttpServerSourceStage>> HttpServerSourceSta
         max_payload_size,
         std::chrono::seconds(request_timeout),
         lines,
-        stop_after);
+        stop_after,
+        coalesce_payloads,
+        max_batch_bytes,
+        max_batch_rows,
+        std::chrono::milliseconds(max_batch_delay_ms),
+        stream_chunk_size,
+        num_parse_workers,
+        ColumnProjection(projection),
+        payload_format,
+        capture_path);
 }
 }  // namespace morpheus
@@ -19,108 +19,369 @@
 
 #include "morpheus/messages/memory/response_memory.hpp"
 #include "morpheus/messages/memory/tensor_memory.hpp"
+#include "morpheus/objects/cuda_graph_cache.hpp"
 #include "morpheus/objects/dev_mem_info.hpp"
+#include "morpheus/objects/device_resources.hpp"
 #include "morpheus/objects/dtype.hpp"
+#include "morpheus/objects/stage_memory_resource.hpp"
 #include "morpheus/objects/tensor.hpp"
 #include "morpheus/objects/tensor_object.hpp"
+#include "morpheus/stages/multi_endpoint_triton_client.hpp"
 #include "morpheus/stages/triton_inference.hpp"
+#include "morpheus/utilities/cuda_util.hpp"  // for CudaDeviceGuard
 #include "morpheus/utilities/matx_util.hpp"
+#include "morpheus/utilities/nvtx_util.hpp"       // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_ASYNC_RANGE
+#include "morpheus/utilities/pool_allocator.hpp"  // for make_pooled
+#include "morpheus/utilities/string_util.hpp"
 
 #include <boost/fiber/policy.hpp>
 #include <cuda_runtime.h>
 #include <glog/logging.h>
-#include <mrc/cuda/common.hpp>
+#include <mrc/coroutines/event.hpp>
+#include <mrc/coroutines/when_all.hpp>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <mrc/cuda/sync.hpp>    // for enqueue_stream_sync_event
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
 
 #include <chrono>
 #include <compare>
 #include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <map>
 #include <mutex>
+#include <optional>
 #include <ostream>
 #include <ratio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace {
 
-static morpheus::ShapeType get_seq_ids(const morpheus::InferenceClientStage::sink_type_t& message)
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "InferenceClientStage");
+
+// Attributes the device memory allocated by the stage, such as the merged inputs, to it
+morpheus::StageMemoryResource* memory_resource()
+{
+    return morpheus::StageMemoryResource::get("InferenceClientStage");
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start)
 {
-    // Take a copy of the sequence Ids allowing us to map rows in the response to rows in the dataframe
-    // The output tensors we store in `reponse_memory` will all be of the same length as the the
-    // dataframe. seq_ids has three columns, but we are only interested in the first column.
-    auto seq_ids         = message->get_input("seq_ids");
-    const auto item_size = seq_ids.dtype().item_size();
-
-    morpheus::ShapeType host_seq_ids(message->count);
-    MRC_CHECK_CUDA(cudaMemcpy2D(host_seq_ids.data(),
-                                item_size,
-                                seq_ids.data(),
-                                seq_ids.stride(0) * item_size,
-                                item_size,
-                                host_seq_ids.size(),
-                                cudaMemcpyDeviceToHost));
-
-    return host_seq_ids;
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 }
 
-static void reduce_outputs(const morpheus::InferenceClientStage::sink_type_t& x, morpheus::TensorMap& output_tensors)
+// Builds the key of the post-processing graph, identifying the shapes and types of every kernel it launches
+static std::string make_graph_key(const morpheus::TensorMap& output_tensors)
 {
-    // When our tensor lengths are longer than our dataframe we will need to use the seq_ids array to
-    // lookup how the values should map back into the dataframe.
-    auto host_seq_ids = get_seq_ids(x);
+    std::ostringstream key;
+
+    for (const auto& [name, tensor] : output_tensors)
+    {
+        key << ':' << name << ':' << tensor.dtype().type_str();
+        for (const auto& dim : tensor.get_shape())
+        {
+            key << ',' << dim;
+        }
+
+        for (const auto& dim : tensor.get_stride())
+        {
+            key << ',' << dim;
+        }
+    }
+
+    return key.str();
+}
+
+// Builds the key of the open batch a message joins, only messages on the same device whose inputs share types and row
+// shapes, such as those tokenized to the same sequence length, can be merged into a single request
+static std::string make_batch_key(const morpheus::TensorMap& inputs, int device_id)
+{
+    std::ostringstream key;
+    key << device_id;
+
+    for (const auto& [name, tensor] : inputs)
+    {
+        key << ':' << name << ':' << tensor.dtype().type_str();
+
+        const auto shape = tensor.get_shape();
+        for (std::size_t dim = 1; dim < shape.size(); ++dim)
+        {
+            key << ',' << shape[dim];
+        }
+    }
+
+    return key.str();
+}
+
+// Orders the logits of all of the output tensors into a single graph launch followed by a single synchronization,
+// rather than one kernel and synchronization per output tensor
+static void launch_post_process_graph(morpheus::TensorMap& output_tensors,
+                                      const std::shared_ptr<morpheus::TensorBufferPool>& pool,
+                                      morpheus::CudaGraphCache& graph_cache)
+{
+    const auto stream = morpheus::DeviceResources::stream();
+
+    // Everything which allocates, and the stream waits of reused pool buffers, happens before the capture
+    std::vector<morpheus::DevMemInfo> inputs;
+    std::vector<morpheus::PostInferenceOutput> outputs;
+    inputs.reserve(output_tensors.size());
+    outputs.reserve(output_tensors.size());
 
     for (auto& mapping : output_tensors)
     {
         auto& output_tensor = mapping.second;
 
-        morpheus::ShapeType shape  = output_tensor.get_shape();
-        morpheus::ShapeType stride = output_tensor.get_stride();
+        const auto& input = inputs.emplace_back(output_tensor.data(),
+                                                output_tensor.dtype(),
+                                                output_tensor.get_memory(),
+                                                output_tensor.get_shape(),
+                                                output_tensor.get_stride());
+
+        outputs.emplace_back(
+            morpheus::MatxUtil::allocate_post_inference_output(input, input.shape(0), std::nullopt, false, pool));
+    }
 
-        morpheus::ShapeType reduced_shape{shape};
-        reduced_shape[0] = x->mess_count;
+    graph_cache.launch(make_graph_key(output_tensors), stream, [&](rmm::cuda_stream_view capture_stream) {
+        for (std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            morpheus::MatxUtil::enqueue_reduce_logits_threshold(
+                inputs[i], nullptr, outputs[i], true, std::nullopt, false, capture_stream);
+        }
+    });
+
+    mrc::enqueue_stream_sync_event(stream).get();
 
-        auto reduced_buffer = morpheus::MatxUtil::reduce_max(
-            morpheus::DevMemInfo{
-                output_tensor.data(), output_tensor.dtype(), output_tensor.get_memory(), shape, stride},
-            host_seq_ids,
-            0,
-            reduced_shape);
+    std::size_t i = 0;
+    for (auto& mapping : output_tensors)
+    {
+        auto& output_tensor = mapping.second;
+        auto& output        = outputs[i++];
 
-        output_tensor.swap(
-            morpheus::Tensor::create(std::move(reduced_buffer), output_tensor.dtype(), reduced_shape, stride, 0));
+        output_tensor.swap(morpheus::Tensor::create(
+            std::move(output.probs), output_tensor.dtype(), output.shape, output.stride, 0));
     }
 }
 
-static void apply_logits(morpheus::TensorMap& output_tensors)
+// Applies the sigmoid to the outputs whose rows match those of the message
+static void apply_logits(morpheus::TensorMap& output_tensors,
+                         const std::shared_ptr<morpheus::TensorBufferPool>& pool,
+                         morpheus::CudaGraphCache* graph_cache)
 {
+    if (graph_cache != nullptr)
+    {
+        launch_post_process_graph(output_tensors, pool, *graph_cache);
+        return;
+    }
+
     for (auto& mapping : output_tensors)
     {
         auto& output_tensor = mapping.second;
 
-        auto shape  = output_tensor.get_shape();
-        auto stride = output_tensor.get_stride();
+        morpheus::ShapeType shape  = output_tensor.get_shape();
+        morpheus::ShapeType stride = output_tensor.get_stride();
+
+        morpheus::DevMemInfo input{
+            output_tensor.data(), output_tensor.dtype(), output_tensor.get_memory(), shape, stride};
 
-        auto output_buffer = morpheus::MatxUtil::logits(morpheus::DevMemInfo{
-            output_tensor.data(), output_tensor.dtype(), output_tensor.get_memory(), shape, stride});
+        auto output = morpheus::MatxUtil::reduce_logits_threshold(
+            input, morpheus::ShapeType{}, 0, shape[0], true, std::nullopt, false, pool);
 
-        // For logits the input and output shapes will be the same
-        output_tensor.swap(morpheus::Tensor::create(std::move(output_buffer), output_tensor.dtype(), shape, stride, 0));
+        output_tensor.swap(morpheus::Tensor::create(
+            std::move(output.probs), output_tensor.dtype(), output.shape, output.stride, 0));
     }
 }
 
+// Returns a function reducing the rows of `output_tensor`, one per row of the model's inputs, to the `num_output_rows`
+// rows of the message with the `seq_ids` of the inputs, applying the sigmoid in the same pass when `needs_logits` is
+// set. Called when the output is first accessed, outputs which are never read are never reduced.
+static morpheus::TensorMemory::tensor_factory_fn_t make_reduce_outputs_fn(
+    morpheus::TensorObject output_tensor,
+    morpheus::TensorObject seq_ids,
+    morpheus::TensorIndex num_output_rows,
+    bool needs_logits,
+    std::shared_ptr<morpheus::TensorBufferPool> pool,
+    int device_id)
+{
+    return [output_tensor = std::move(output_tensor),
+            seq_ids       = std::move(seq_ids),
+            num_output_rows,
+            needs_logits,
+            pool = std::move(pool),
+            device_id]() {
+        // The output may be accessed from any thread
+        morpheus::CudaDeviceGuard device_guard(device_id);
+
+        morpheus::DevMemInfo input{output_tensor.data(),
+                                   output_tensor.dtype(),
+                                   output_tensor.get_memory(),
+                                   output_tensor.get_shape(),
+                                   output_tensor.get_stride()};
+        morpheus::DevMemInfo seq_ids_info{
+            seq_ids.data(), seq_ids.dtype(), seq_ids.get_memory(), seq_ids.get_shape(), seq_ids.get_stride()};
+
+        // Reduces the rows and applies the sigmoid in a single pass
+        auto output = morpheus::MatxUtil::reduce_logits_threshold(
+            input, seq_ids_info, num_output_rows, needs_logits, std::nullopt, false, pool);
+
+        return morpheus::Tensor::create(std::move(output.probs), output_tensor.dtype(), output.shape, output.stride, 0);
+    };
+}
+
+// Copies the rows of each of `tensors` one after another into a single row major tensor of `num_rows` rows, allocated
+// from `pool` unless it is null
+static morpheus::TensorObject concat_rows(const std::string& name,
+                                          const std::vector<morpheus::TensorObject>& tensors,
+                                          morpheus::TensorIndex num_rows,
+                                          const std::shared_ptr<morpheus::TensorBufferPool>& pool)
+{
+    const auto& first = tensors.front();
+    auto shape        = first.get_shape();
+
+    if (shape.size() != 2)
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to merge input '" << name << "' of rank "
+                                                                                  << shape.size() << ", expected 2"));
+    }
+
+    const auto item_size = first.dtype_size();
+    const auto row_bytes = shape[1] * item_size;
+    const auto stream    = morpheus::DeviceResources::stream();
+
+    shape[0]    = num_rows;
+    auto buffer = pool != nullptr
+                      ? pool->get_buffer(num_rows * row_bytes)
+                      : std::make_shared<rmm::device_buffer>(num_rows * row_bytes, stream, memory_resource());
+    auto* dst   = static_cast<uint8_t*>(buffer->data());
+
+    // Sliced column major tensors are made row major first, keeping the rows of each tensor a single 2D copy
+    std::vector<morpheus::TensorObject> row_major;
+    for (const auto& tensor : tensors)
+    {
+        if (!(tensor.dtype() == first.dtype()) || tensor.rank() != 2 || tensor.shape(1) != first.shape(1))
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+                "Unable to merge input '" << name << "' of messages with differing types or shapes"));
+        }
+
+        const auto* source = &tensor;
+        if (tensor.stride(1) != 1 && tensor.shape(1) > 1)
+        {
+            source = &row_major.emplace_back(tensor.copy_rows({{0, tensor.shape(0)}}, tensor.shape(0)));
+        }
+
+        MRC_CHECK_CUDA(cudaMemcpy2DAsync(dst,
+                                         row_bytes,
+                                         source->data(),
+                                         source->stride(0) * item_size,
+                                         row_bytes,
+                                         source->shape(0),
+                                         cudaMemcpyDeviceToDevice,
+                                         stream.value()));
+
+        dst += source->shape(0) * row_bytes;
+    }
+
+    mrc::enqueue_stream_sync_event(stream).get();
+
+    return morpheus::Tensor::create(std::move(buffer), first.dtype(), shape, {}, 0);
+}
+
 }  // namespace
 
 namespace morpheus {
 
+// Messages merged into a single request, each message's rows of the inputs and outputs start at its row offset
+struct InferenceClientStage::PendingBatch
+{
+    std::shared_ptr<IInferenceClientSession> session;
+    std::string key;  // Key of `m_open_batches` while the batch is open
+    int device_id;    // Device of the inputs of every message of the batch
+    std::vector<TensorMap> inputs;
+    std::vector<TensorIndex> row_offsets{0};
+    std::chrono::steady_clock::time_point sent_at;
+
+    std::vector<TensorMap> outputs;
+    std::exception_ptr error;
+    mrc::coroutines::Event completed{};
+};
+
 InferenceClientStage::InferenceClientStage(std::unique_ptr<IInferenceClient>&& client,
                                            std::string model_name,
                                            bool needs_logits,
                                            std::vector<TensorModelMapping> input_mapping,
-                                           std::vector<TensorModelMapping> output_mapping) :
+                                           std::vector<TensorModelMapping> output_mapping,
+                                           bool use_cuda_graphs,
+                                           TensorIndex max_batch_rows,
+                                           std::chrono::milliseconds max_batch_delay,
+                                           std::size_t num_sessions,
+                                           std::size_t cache_capacity,
+                                           bool warm_up) :
   m_model_name(std::move(model_name)),
   m_client(std::move(client)),
   m_needs_logits(needs_logits),
   m_input_mapping(std::move(input_mapping)),
-  m_output_mapping(std::move(output_mapping))
-{}
+  m_output_mapping(std::move(output_mapping)),
+  m_sessions(num_sessions),
+  m_max_batch_rows(max_batch_rows),
+  m_max_batch_delay(max_batch_delay)
+{
+    if (num_sessions == 0)
+    {
+        throw std::invalid_argument("num_sessions must be greater than 0");
+    }
+
+    if (m_max_batch_rows < 0)
+    {
+        throw std::invalid_argument("max_batch_rows must be greater than or equal to 0");
+    }
+
+    if (use_cuda_graphs)
+    {
+        m_graph_cache = std::make_unique<CudaGraphCache>();
+    }
+
+    if (cache_capacity > 0)
+    {
+        m_result_cache = std::make_unique<InferenceResultCache>(cache_capacity, m_model_name);
+    }
+
+    auto& registry = MetricsRegistry::get_instance();
+
+    auto get_phase_histogram = [&](const std::string& phase) {
+        return registry.get_histogram("morpheus_inference_phase_seconds",
+                                      "Duration of each phase of the messages inferred by InferenceClientStage",
+                                      {{"model", m_model_name}, {"phase", phase}});
+    };
+
+    m_queue_seconds        = get_phase_histogram("queue");
+    m_infer_seconds        = get_phase_histogram("infer");
+    m_post_process_seconds = get_phase_histogram("post_process");
+
+    m_retries = registry.get_counter(
+        "morpheus_inference_retries_total", "Messages retried after a failed inference", {{"model", m_model_name}});
+
+    if (warm_up)
+    {
+        for (auto& slot : m_sessions)
+        {
+            try
+            {
+                slot.session = m_client->create_session();
+            } catch (const std::exception& e)
+            {
+                LOG(WARNING) << "Could not warm up the sessions of model '" << m_model_name
+                             << "', they will be created by the first messages: " << e.what();
+                break;
+            }
+        }
+    }
+}
 
 struct ExponentialBackoff
 {
@@ -149,18 +410,287 @@ struct ExponentialBackoff
     }
 };
 
+mrc::coroutines::Task<TensorMap> InferenceClientStage::infer_batched(std::shared_ptr<IInferenceClientSession> session,
+                                                                     TensorMap&& inputs,
+                                                                     TensorIndex num_rows,
+                                                                     int device_id,
+                                                                     std::shared_ptr<mrc::coroutines::Scheduler> on)
+{
+    const auto joined_at = std::chrono::steady_clock::now();
+
+    std::shared_ptr<PendingBatch> batch;
+    std::shared_ptr<PendingBatch> overflowed_batch;
+    std::size_t index;
+    bool is_first = false;
+    bool is_full  = false;
+
+    {
+        auto lock = std::unique_lock(m_batch_mutex);
+
+        auto key         = make_batch_key(inputs, device_id);
+        auto& open_batch = m_open_batches[key];
+
+        // A batch which would overflow is sent as it is. Messages holding any session of the pool may join a batch,
+        // which is sent with the session of its first message.
+        if (open_batch != nullptr && open_batch->row_offsets.back() + num_rows > m_max_batch_rows)
+        {
+            overflowed_batch = std::move(open_batch);
+            open_batch.reset();
+        }
+
+        if (open_batch == nullptr)
+        {
+            open_batch            = std::make_shared<PendingBatch>();
+            open_batch->session   = session;
+            open_batch->key       = std::move(key);
+            open_batch->device_id = device_id;
+            is_first              = true;
+        }
+
+        batch = open_batch;
+        index = batch->inputs.size();
+        batch->inputs.emplace_back(std::move(inputs));
+        batch->row_offsets.push_back(batch->row_offsets.back() + num_rows);
+
+        if (batch->row_offsets.back() >= m_max_batch_rows)
+        {
+            m_open_batches.erase(batch->key);
+            is_full = true;
+        }
+    }
+
+    if (overflowed_batch != nullptr)
+    {
+        co_await send_batch(std::move(overflowed_batch), on);
+    }
+
+    if (is_first && !is_full)
+    {
+        co_await on->yield_for(m_max_batch_delay);
+
+        auto lock = std::unique_lock(m_batch_mutex);
+
+        // Otherwise the batch was filled, or overflowed, and was sent by another message
+        auto open_batch = m_open_batches.find(batch->key);
+        if (open_batch != m_open_batches.end() && open_batch->second == batch)
+        {
+            m_open_batches.erase(open_batch);
+            is_full = true;
+        }
+    }
+
+    if (is_full)
+    {
+        co_await send_batch(batch, on);
+    }
+
+    co_await batch->completed;
+
+    // The batch completes on the thread of the message which sent it
+    co_await on->yield();
+
+    m_queue_seconds->observe(std::chrono::duration<double>(batch->sent_at - joined_at).count());
+
+    if (batch->error)
+    {
+        std::rethrow_exception(batch->error);
+    }
+
+    co_return std::move(batch->outputs[index]);
+}
+
+mrc::coroutines::Task<> InferenceClientStage::send_batch(std::shared_ptr<PendingBatch> batch,
+                                                        std::shared_ptr<mrc::coroutines::Scheduler> on)
+{
+    batch->sent_at = std::chrono::steady_clock::now();
+
+    try
+    {
+        const auto num_messages = batch->inputs.size();
+        const auto num_rows     = batch->row_offsets.back();
+
+        if (num_messages == 1)
+        {
+            batch->outputs.emplace_back(co_await batch->session->infer(std::move(batch->inputs.front()), on));
+        }
+        else
+        {
+            TensorMap inputs;
+            {
+                // Sends may be resumed on any thread. The guard cannot be held across the suspension below, and the
+                // pool only serves the device the stage was constructed on
+                CudaDeviceGuard device_guard(batch->device_id);
+                auto pool = batch->device_id == m_device_id ? m_buffer_pool : nullptr;
+
+                for (const auto& [name, tensor] : batch->inputs.front())
+                {
+                    std::vector<TensorObject> tensors;
+                    tensors.reserve(num_messages);
+
+                    for (auto& message_inputs : batch->inputs)
+                    {
+                        auto pos = message_inputs.find(name);
+                        if (pos == message_inputs.end())
+                        {
+                            throw std::invalid_argument(
+                                MORPHEUS_CONCAT_STR("Unable to merge messages, input '" << name << "' is missing"));
+                        }
+
+                        tensors.emplace_back(std::move(pos->second));
+                    }
+
+                    inputs[name].swap(concat_rows(name, tensors, num_rows, pool));
+                }
+            }
+
+            batch->inputs.clear();
+
+            auto outputs = co_await batch->session->infer(std::move(inputs), on);
+
+            batch->outputs.resize(num_messages);
+            for (const auto& [name, tensor] : outputs)
+            {
+                if (tensor.rank() == 0 || tensor.shape(0) != num_rows)
+                {
+                    throw std::runtime_error(MORPHEUS_CONCAT_STR("Unable to split output '"
+                                                                 << name << "' of a merged request, expected "
+                                                                 << num_rows << " rows"));
+                }
+
+                // Each message holds a view of its rows, sharing the memory of the merged output
+                for (std::size_t i = 0; i < num_messages; ++i)
+                {
+                    ShapeType min_dims(tensor.rank(), 0);
+                    ShapeType max_dims(tensor.rank(), -1);
+                    min_dims[0] = batch->row_offsets[i];
+                    max_dims[0] = batch->row_offsets[i + 1];
+
+                    batch->outputs[i][name].swap(tensor.slice(min_dims, max_dims));
+                }
+            }
+        }
+    } catch (...)
+    {
+        batch->error = std::current_exception();
+    }
+
+    batch->completed.set();
+}
+
+mrc::coroutines::Task<TensorMap> InferenceClientStage::infer_cached(std::shared_ptr<IInferenceClientSession> session,
+                                                                    TensorMap&& inputs,
+                                                                    TensorIndex num_rows,
+                                                                    std::shared_ptr<mrc::coroutines::Scheduler> on)
+{
+    auto lookup = m_result_cache->lookup(inputs);
+
+    const auto num_misses = static_cast<TensorIndex>(lookup.miss_rows.size());
+    if (num_misses == 0)
+    {
+        co_return std::move(lookup.hit_outputs);
+    }
+
+    if (num_misses < num_rows)
+    {
+        // Consecutive rows which missed are gathered as a single range
+        std::vector<RangeType> ranges;
+        for (auto row : lookup.miss_rows)
+        {
+            if (!ranges.empty() && ranges.back().second == row)
+            {
+                ranges.back().second++;
+            }
+            else
+            {
+                ranges.emplace_back(row, row + 1);
+            }
+        }
+
+        for (auto& [name, tensor] : inputs)
+        {
+            tensor.swap(tensor.copy_rows(ranges, num_misses));
+        }
+    }
+
+    TensorMap miss_outputs;
+    if (m_max_batch_rows > 0)
+    {
+        miss_outputs = co_await infer_batched(std::move(session), std::move(inputs), num_misses, m_device_id, on);
+    }
+    else
+    {
+        miss_outputs = co_await session->infer(std::move(inputs), on);
+    }
+
+    m_result_cache->insert(lookup, miss_outputs);
+
+    co_return m_result_cache->merge(std::move(lookup), std::move(miss_outputs));
+}
+
+std::shared_ptr<IInferenceClientSession> InferenceClientStage::acquire_session(std::size_t& slot_index)
+{
+    auto lock = std::unique_lock(m_session_mutex);
+
+    slot_index = 0;
+    for (std::size_t i = 1; i < m_sessions.size(); ++i)
+    {
+        if (m_sessions[i].num_in_flight < m_sessions[slot_index].num_in_flight)
+        {
+            slot_index = i;
+        }
+    }
+
+    auto& slot = m_sessions[slot_index];
+    if (slot.session == nullptr)
+    {
+        slot.session = m_client->create_session();
+    }
+
+    slot.num_in_flight++;
+
+    return slot.session;
+}
+
+void InferenceClientStage::release_session(std::size_t slot_index,
+                                           const std::shared_ptr<IInferenceClientSession>& session,
+                                           bool failed)
+{
+    auto lock  = std::unique_lock(m_session_mutex);
+    auto& slot = m_sessions[slot_index];
+
+    slot.num_in_flight--;
+
+    if (failed && slot.session == session)
+    {
+        slot.session.reset();
+    }
+}
+
 mrc::coroutines::AsyncGenerator<std::shared_ptr<MultiResponseMessage>> InferenceClientStage::on_data(
     std::shared_ptr<MultiInferenceMessage>&& x, std::shared_ptr<mrc::coroutines::Scheduler> on)
 {
+    // The coroutine may be resumed on another thread than the one it started on
+    MORPHEUS_NVTX_ASYNC_RANGE(NvtxDomain, "on_data", x->mess_count);
+
     int32_t retry_count = 0;
 
     using namespace std::chrono_literals;
 
     auto backoff = ExponentialBackoff(on, 100ms, 4000ms);
 
+    // The caches and pools of the stage only serve the device it was constructed on, messages on any other device
+    // bypass them
+    const auto device_id       = x->memory->device_id();
+    const bool on_stage_device = device_id == m_device_id;
+
+    // The inputs may still be written asynchronously by the pre-processing stage, which hands them off with an event
+    // rather than waiting for them itself
+    x->memory->synchronize_event();
+
     while (true)
     {
-        auto message_session = m_session;
+        std::shared_ptr<IInferenceClientSession> message_session;
+        std::size_t slot_index = 0;
 
         try
         {
@@ -172,21 +702,9 @@ mrc::coroutines::AsyncGenerator<std::shared_ptr<MultiResponseMessage>> Inference
             // TensorMap output_tensors;
             // buffer_map_t output_buffers;
 
-            if (message_session == nullptr)
-            {
-                auto lock = std::unique_lock(m_session_mutex);
-
-                if (m_session == nullptr)
-                {
-                    m_session = m_client->create_session();
-                }
-
-                message_session = m_session;
-            }
-
-            // We want to prevent entering this section of code if the session is being reset, but we also want this
-            // section of code to be entered simultanously by multiple coroutines. To accomplish this, we use a shared
-            // lock instead of a unique lock.
+            // Sessions are shared by the coroutines of every pipeline thread, spreading the messages in flight across
+            // the pool avoids contending for a single connection
+            message_session = acquire_session(slot_index);
 
             TensorMap model_input_tensors;
 
@@ -198,20 +716,40 @@ mrc::coroutines::AsyncGenerator<std::shared_ptr<MultiResponseMessage>> Inference
                 }
             }
 
-            auto model_output_tensors = co_await message_session->infer(std::move(model_input_tensors));
+            const auto infer_started_at = std::chrono::steady_clock::now();
 
-            co_await on->yield();
-
-            if (x->mess_count != x->count)
+            TensorMap model_output_tensors;
+            if (m_result_cache != nullptr && on_stage_device)
+            {
+                model_output_tensors = co_await infer_cached(
+                    message_session, std::move(model_input_tensors), x->count, on);
+            }
+            else if (m_max_batch_rows > 0)
+            {
+                model_output_tensors = co_await infer_batched(
+                    message_session, std::move(model_input_tensors), x->count, device_id, on);
+            }
+            else
             {
-                reduce_outputs(x, model_output_tensors);
+                model_output_tensors = co_await message_session->infer(std::move(model_input_tensors), on);
             }
 
-            // If we need to do logits, do that here
-            if (m_needs_logits)
+            m_infer_seconds->observe(seconds_since(infer_started_at));
+
+            // When the inputs have more rows than the message, the outputs are reduced to one row per row of the
+            // message using the seq_ids, along with the logits, only once they are accessed downstream
+            const bool needs_reduce = x->mess_count != x->count;
+
+            const auto post_process_started_at = std::chrono::steady_clock::now();
+            if (!needs_reduce && m_needs_logits)
             {
-                apply_logits(model_output_tensors);
+                // Coroutines may resume on any thread, the device is set again after the inference
+                CudaDeviceGuard device_guard(device_id);
+                apply_logits(model_output_tensors,
+                             on_stage_device ? m_buffer_pool : nullptr,
+                             on_stage_device ? m_graph_cache.get() : nullptr);
             }
+            m_post_process_seconds->observe(seconds_since(post_process_started_at));
 
             TensorMap output_tensor_map;
 
@@ -221,30 +759,50 @@ mrc::coroutines::AsyncGenerator<std::shared_ptr<MultiResponseMessage>> Inference
 
                 if (pos != model_output_tensors.end())
                 {
-                    output_tensor_map[mapping.tensor_field_name].swap(
-                        std::move(model_output_tensors[mapping.model_field_name]));
+                    output_tensor_map[mapping.tensor_field_name].swap(std::move(pos->second));
 
                     model_output_tensors.erase(pos);
                 }
             }
 
             // Final output of all mini-batches
-            auto response_mem = std::make_shared<ResponseMemory>(x->mess_count, std::move(output_tensor_map));
+            std::shared_ptr<ResponseMemory> response_mem;
+            if (needs_reduce)
+            {
+                response_mem = make_pooled<ResponseMemory>(x->mess_count);
+
+                // The seq_ids stay on the device, the reduction finds the rows of each output row itself
+                for (auto& [name, output_tensor] : output_tensor_map)
+                {
+                    response_mem->set_lazy_tensor(name,
+                                                  make_reduce_outputs_fn(std::move(output_tensor),
+                                                                         x->get_input("seq_ids"),
+                                                                         x->mess_count,
+                                                                         m_needs_logits,
+                                                                         on_stage_device ? m_buffer_pool : nullptr,
+                                                                         device_id));
+                }
+            }
+            else
+            {
+                response_mem = make_pooled<ResponseMemory>(x->mess_count, std::move(output_tensor_map));
+            }
 
-            auto response = std::make_shared<MultiResponseMessage>(
+            auto response = make_pooled<MultiResponseMessage>(
                 x->meta, x->mess_offset, x->mess_count, std::move(response_mem), 0, response_mem->count);
 
+            release_session(slot_index, message_session, false);
+            message_session.reset();
+
             co_yield std::move(response);
 
             co_return;
 
         } catch (...)
         {
-            auto lock = std::unique_lock(m_session_mutex);
-
-            if (m_session == message_session)
+            if (message_session != nullptr)
             {
-                m_session.reset();
+                release_session(slot_index, message_session, true);
             }
 
             if (m_retry_max >= 0 and ++retry_count > m_retry_max)
@@ -252,6 +810,8 @@ mrc::coroutines::AsyncGenerator<std::shared_ptr<MultiResponseMessage>> Inference
                 throw;
             }
 
+            m_retries->increment();
+
             LOG(WARNING) << "Exception while processing message for InferenceClientStage, attempting retry.";
         }
 
@@ -259,6 +819,165 @@ mrc::coroutines::AsyncGenerator<std::shared_ptr<MultiResponseMessage>> Inference
     }
 }
 
+// ************ FanOutInferenceClientStage ************************* //
+FanOutInferenceClientStage::FanOutInferenceClientStage(std::vector<std::unique_ptr<InferenceClientStage>>&& models) :
+  m_models(std::move(models))
+{
+    if (m_models.empty())
+    {
+        throw std::invalid_argument("At least one model is required to fan out inference");
+    }
+}
+
+mrc::coroutines::Task<std::shared_ptr<MultiResponseMessage>> FanOutInferenceClientStage::infer_model(
+    InferenceClientStage& model,
+    std::shared_ptr<MultiInferenceMessage> data,
+    std::shared_ptr<mrc::coroutines::Scheduler> on)
+{
+    std::shared_ptr<MultiResponseMessage> response;
+
+    auto responses = model.on_data(std::move(data), on);
+
+    for (auto iter = co_await responses.begin(); iter != responses.end(); co_await ++iter)
+    {
+        response = std::move(*iter);
+    }
+
+    co_return response;
+}
+
+mrc::coroutines::AsyncGenerator<std::shared_ptr<MultiResponseMessage>> FanOutInferenceClientStage::on_data(
+    std::shared_ptr<MultiInferenceMessage>&& x, std::shared_ptr<mrc::coroutines::Scheduler> on)
+{
+    // Every model reads the same input tensors, which are only swapped into the requests and never written
+    std::vector<mrc::coroutines::Task<std::shared_ptr<MultiResponseMessage>>> models;
+    for (auto& model : m_models)
+    {
+        models.emplace_back(infer_model(*model, x, on));
+    }
+
+    auto responses = co_await mrc::coroutines::when_all(std::move(models));
+
+    auto merged = make_pooled<ResponseMemory>(x->mess_count);
+    for (auto& completed_model : responses)
+    {
+        auto response = completed_model.return_value();
+        auto memory   = response->memory;
+
+        for (const auto& name : memory->tensor_names())
+        {
+            if (merged->has_tensor(name))
+            {
+                throw std::runtime_error(MORPHEUS_CONCAT_STR(
+                    "The output '" << name << "' is returned by more than one model, map it to distinct names"));
+            }
+
+            // Outputs left to be reduced by a model are only reduced once they are accessed downstream
+            if (memory->is_lazy_tensor(name))
+            {
+                merged->set_lazy_tensor(name, [memory, name]() {
+                    return memory->get_tensor(name);
+                });
+            }
+            else
+            {
+                merged->set_tensor(name, TensorObject(memory->get_tensor(name)));
+            }
+        }
+    }
+
+    const auto num_rows = merged->count;
+    co_yield make_pooled<MultiResponseMessage>(x->meta, x->mess_offset, x->mess_count, std::move(merged), 0, num_rows);
+}
+
+namespace {
+std::unique_ptr<TritonInferenceClient> make_triton_inference_client(const std::string& server_url,
+                                                                    const std::string& model_name,
+                                                                    bool use_shared_memory,
+                                                                    std::size_t max_concurrent_batches,
+                                                                    bool hedge_requests,
+                                                                    TritonRaggedBatching ragged_batching)
+{
+    // CUDA shared memory is exchanged with Triton over gRPC, avoiding any copies through host memory. Requests are
+    // only sent asynchronously over gRPC when more than one mini-batch may be in flight, the HTTP client always sends
+    // them synchronously as its AsyncInfer gives different results.
+    const bool use_async_infer = max_concurrent_batches > 1;
+
+    // Several servers may be given as a comma separated list of URLs
+    std::vector<std::string> server_urls;
+    std::stringstream server_url_stream(server_url);
+    for (std::string url; std::getline(server_url_stream, url, ',');)
+    {
+        url.erase(0, url.find_first_not_of(' '));
+        url.erase(url.find_last_not_of(' ') + 1);
+
+        if (!url.empty())
+        {
+            server_urls.emplace_back(std::move(url));
+        }
+    }
+
+    if (server_urls.empty())
+    {
+        throw std::invalid_argument("server_url must contain at least one URL");
+    }
+
+    const bool use_multiple_endpoints = server_urls.size() > 1 || hedge_requests;
+    if (use_multiple_endpoints && use_shared_memory)
+    {
+        throw std::invalid_argument("CUDA shared memory cannot be used with multiple servers or hedged requests");
+    }
+
+    // Each session of the stage connects with a client of its own
+    auto create_client = [server_urls,
+                          use_shared_memory,
+                          use_async_infer,
+                          use_multiple_endpoints,
+                          hedge_requests]() -> std::unique_ptr<ITritonClient> {
+        if (use_multiple_endpoints)
+        {
+            // Hedged duplicates are sent while the original request is still in flight, which requires the endpoints
+            // to send requests asynchronously. They are connected over gRPC, the HTTP client being synchronous.
+            std::vector<std::unique_ptr<ITritonClient>> endpoints;
+            for (const auto& url : server_urls)
+            {
+                if (hedge_requests)
+                {
+                    endpoints.emplace_back(std::make_unique<GrpcTritonClient>(url, false, true));
+                }
+                else
+                {
+                    endpoints.emplace_back(std::make_unique<HttpTritonClient>(url));
+                }
+            }
+
+            return std::make_unique<MultiEndpointTritonClient>(std::move(endpoints), hedge_requests);
+        }
+
+        if (use_shared_memory)
+        {
+            return std::make_unique<GrpcTritonClient>(server_urls.front(), true, use_async_infer);
+        }
+
+        return std::make_unique<HttpTritonClient>(server_urls.front());
+    };
+
+    return std::make_unique<TritonInferenceClient>(
+        std::move(create_client), model_name, max_concurrent_batches, std::move(ragged_batching));
+}
+
+std::vector<TensorModelMapping> to_tensor_model_mappings(const std::map<std::string, std::string>& mappings)
+{
+    std::vector<TensorModelMapping> tensor_model_mappings;
+    for (const auto& mapping : mappings)
+    {
+        tensor_model_mappings.emplace_back(TensorModelMapping{mapping.first, mapping.second});
+    }
+
+    return tensor_model_mappings;
+}
+}  // namespace
+
 // ************ InferenceClientStageInterfaceProxy********* //
 std::shared_ptr<mrc::segment::Object<InferenceClientStage>> InferenceClientStageInterfaceProxy::init(
     mrc::segment::Builder& builder,
@@ -267,27 +986,88 @@ std::shared_ptr<mrc::segment::Object<InferenceClientStage>> InferenceClientStage
     std::string model_name,
     bool needs_logits,
     std::map<std::string, std::string> input_mappings,
-    std::map<std::string, std::string> output_mappings)
+    std::map<std::string, std::string> output_mappings,
+    bool use_cuda_graphs,
+    bool use_shared_memory,
+    std::size_t max_concurrent_batches,
+    TensorIndex max_batch_rows,
+    int64_t max_batch_delay_ms,
+    std::size_t num_connections,
+    bool hedge_requests,
+    std::size_t cache_size,
+    bool warm_up,
+    std::string ragged_offsets_input,
+    std::vector<std::string> ragged_token_outputs)
 {
-    std::vector<TensorModelMapping> input_mappings_{};
-    std::vector<TensorModelMapping> output_mappings_{};
+    auto triton_inference_client = make_triton_inference_client(
+        server_url,
+        model_name,
+        use_shared_memory,
+        max_concurrent_batches,
+        hedge_requests,
+        TritonRaggedBatching{std::move(ragged_offsets_input), std::move(ragged_token_outputs)});
+    auto stage = builder.construct_object<InferenceClientStage>(name,
+        std::move(triton_inference_client),
+        model_name,
+        needs_logits,
+        to_tensor_model_mappings(input_mappings),
+        to_tensor_model_mappings(output_mappings),
+        use_cuda_graphs,
+        max_batch_rows,
+        std::chrono::milliseconds(max_batch_delay_ms),
+        num_connections,
+        cache_size,
+        warm_up);
 
-    for (auto& mapping : input_mappings)
-    {
-        input_mappings_.emplace_back(TensorModelMapping{mapping.first, mapping.second});
-    }
+    return stage;
+}
+
+// ************ FanOutInferenceClientStageInterfaceProxy********* //
+std::shared_ptr<mrc::segment::Object<FanOutInferenceClientStage>> FanOutInferenceClientStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string server_url,
+    std::map<std::string, std::map<std::string, std::string>> model_output_mappings,
+    bool needs_logits,
+    std::map<std::string, std::string> input_mapping,
+    bool use_cuda_graphs,
+    bool use_shared_memory,
+    std::size_t max_concurrent_batches,
+    TensorIndex max_batch_rows,
+    int64_t max_batch_delay_ms,
+    std::size_t num_connections,
+    bool hedge_requests,
+    std::size_t cache_size,
+    bool warm_up,
+    std::string ragged_offsets_input,
+    std::vector<std::string> ragged_token_outputs)
+{
+    const auto input_mappings = to_tensor_model_mappings(input_mapping);
 
-    for (auto& mapping : output_mappings)
+    // Sessions are bound to a single model, each model keeps a pool of connections of its own
+    std::vector<std::unique_ptr<InferenceClientStage>> models;
+    for (const auto& [model_name, output_mapping] : model_output_mappings)
     {
-        output_mappings_.emplace_back(TensorModelMapping{mapping.first, mapping.second});
+        models.emplace_back(std::make_unique<InferenceClientStage>(
+            make_triton_inference_client(server_url,
+                                         model_name,
+                                         use_shared_memory,
+                                         max_concurrent_batches,
+                                         hedge_requests,
+                                         TritonRaggedBatching{ragged_offsets_input, ragged_token_outputs}),
+            model_name,
+            needs_logits,
+            input_mappings,
+            to_tensor_model_mappings(output_mapping),
+            use_cuda_graphs,
+            max_batch_rows,
+            std::chrono::milliseconds(max_batch_delay_ms),
+            num_connections,
+            cache_size,
+            warm_up));
     }
 
-    auto triton_client           = std::make_unique<HttpTritonClient>(server_url);
-    auto triton_inference_client = std::make_unique<TritonInferenceClient>(std::move(triton_client), model_name);
-    auto stage                   = builder.construct_object<InferenceClientStage>(
-        name, std::move(triton_inference_client), model_name, needs_logits, input_mappings_, output_mappings_);
-
-    return stage;
+    return builder.construct_object<FanOutInferenceClientStage>(name, std::move(models));
 }
 
 }  // namespace morpheus
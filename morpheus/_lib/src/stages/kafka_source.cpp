@@ -21,12 +21,22 @@
 #include "pymrc/utilities/function_wrappers.hpp"  // for PyFuncWrapper
 
 #include "morpheus/messages/meta.hpp"
+#include "morpheus/objects/memory_governor.hpp"       // for MemoryGovernor
+#include "morpheus/utilities/cuda_util.hpp"           // for CudaDeviceGuard
+#include "morpheus/utilities/kafka_transactions.hpp"  // for KafkaTransactionCoordinator
+#include "morpheus/utilities/nvtx_util.hpp"           // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
 #include "morpheus/utilities/stage_util.hpp"
+#include "morpheus/utilities/state_checkpoint.hpp"  // for StateCheckpoint
 #include "morpheus/utilities/string_util.hpp"
+#include "morpheus/utilities/topology.hpp"      // for DeviceLocality, TopologyUtil
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE, TraceBuffer
 
+#include <boost/fiber/buffered_channel.hpp>
+#include <boost/fiber/channel_op_status.hpp>
 #include <boost/fiber/operations.hpp>  // for sleep_for, yield
 #include <boost/fiber/recursive_mutex.hpp>
-#include <cudf/io/json.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>
 #include <glog/logging.h>
 #include <librdkafka/rdkafkacpp.h>
 #include <mrc/runnable/context.hpp>
@@ -38,6 +48,7 @@
 #include <pymrc/node.hpp>
 
 #include <algorithm>  // for find, min, transform
+#include <atomic>
 #include <chrono>
 #include <compare>
 #include <cstdint>
@@ -45,17 +56,18 @@
 #include <functional>
 #include <iterator>  // for back_insert_iterator, back_inserter
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <sstream>
 #include <stdexcept>
+#include <string_view>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 // IWYU thinks we need atomic for vector.emplace_back of a unique_ptr
 // and __alloc_traits<>::value_type for vector assignments
-// IWYU pragma: no_include <atomic>
 // IWYU pragma: no_include <ext/alloc_traits.h>
 
 #if !defined(DOXYGEN_SHOULD_SKIP_THIS)
@@ -76,6 +88,9 @@
 #endif  // DOXYGEN_SHOULD_SKIP_THIS
 
 namespace morpheus {
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "KafkaSourceStage");
+}  // namespace
 
 KafkaOAuthCallback::KafkaOAuthCallback(const std::function<std::map<std::string, std::string>()>& oauth_callback) :
   m_oauth_callback(oauth_callback)
@@ -99,13 +114,789 @@ void KafkaOAuthCallback::oauthbearer_token_refresh_cb(RdKafka::Handle* handle, c
     }
 }
 
+// ************ KafkaBatchController ******************************//
+KafkaBatchController::KafkaBatchController(TensorIndex max_batch_size,
+                                           uint32_t max_batch_timeout_ms,
+                                           uint32_t latency_target_ms,
+                                           TensorIndex min_batch_size) :
+  m_min_batch_size(std::max<TensorIndex>(1, std::min(min_batch_size, max_batch_size))),
+  m_max_batch_size(max_batch_size),
+  m_max_batch_timeout_ms(max_batch_timeout_ms),
+  m_latency_target_ms(latency_target_ms),
+  m_batch_size(max_batch_size),
+  m_batch_timeout_ms(latency_target_ms > 0 ? std::min(max_batch_timeout_ms, latency_target_ms) : max_batch_timeout_ms)
+{
+    m_processing_times.reserve(WindowSize);
+}
+
+TensorIndex KafkaBatchController::batch_size() const
+{
+    return m_batch_size;
+}
+
+uint32_t KafkaBatchController::batch_timeout_ms() const
+{
+    return m_batch_timeout_ms;
+}
+
+void KafkaBatchController::update(TensorIndex num_messages, std::chrono::microseconds processing_time, int64_t lag)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_processing_times.size() < WindowSize)
+    {
+        m_processing_times.push_back(processing_time);
+    }
+    else
+    {
+        m_processing_times[m_next_processing_idx] = processing_time;
+        m_next_processing_idx                     = (m_next_processing_idx + 1) % WindowSize;
+    }
+
+    // Estimate the p99 processing time from the recent batches
+    auto sorted_times = m_processing_times;
+    auto p99_idx      = (sorted_times.size() * 99) / 100;
+    std::nth_element(sorted_times.begin(), sorted_times.begin() + p99_idx, sorted_times.end());
+    auto p99_ms = std::chrono::duration_cast<std::chrono::milliseconds>(sorted_times[p99_idx]).count();
+
+    TensorIndex batch_size = m_batch_size;
+
+    if (num_messages >= batch_size || (lag >= 0 && lag >= batch_size))
+    {
+        // There is a backlog, grow towards the max to reduce the per-batch overhead
+        batch_size = std::min(m_max_batch_size, batch_size * 2);
+    }
+    else if (num_messages < batch_size / 2)
+    {
+        // Traffic is light. Shrink, but not below what we just received so we dont immediately need to grow again
+        batch_size = std::max({m_min_batch_size, num_messages, batch_size / 2});
+    }
+
+    // Leave enough of the latency budget to process the batch. Always wait at least 1 ms to avoid spinning
+    auto timeout_ms = static_cast<int64_t>(m_latency_target_ms) - p99_ms;
+    timeout_ms      = std::max<int64_t>(1, std::min<int64_t>(timeout_ms, m_max_batch_timeout_ms));
+
+    m_batch_size       = batch_size;
+    m_batch_timeout_ms = static_cast<uint32_t>(timeout_ms);
+}
+
 // Component-private classes.
 // ************ KafkaSourceStage__UnsubscribedException**************//
 class KafkaSourceStageUnsubscribedException : public std::exception
 {};
 
-class KafkaSourceStageStopAfter : public std::exception
-{};
+class KafkaSourceStageStopAfter : public std::exception
+{};
+
+// ************ KafkaOffsetTracker **********************//
+std::function<void()> KafkaOffsetTracker::track(std::vector<KafkaOffsetRange> ranges)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (const auto& range : ranges)
+        {
+            auto& state = m_partitions[std::make_pair(range.topic, range.partition)];
+            state.in_flight.emplace(range.first_offset, InFlightRange{range.next_offset, false});
+        }
+    }
+
+    return [tracker = weak_from_this(), ranges = std::move(ranges)]() {
+        if (auto locked = tracker.lock())
+        {
+            locked->ack(ranges);
+        }
+    };
+}
+
+std::vector<std::unique_ptr<RdKafka::TopicPartition>> KafkaOffsetTracker::take_commits(
+    const std::vector<RdKafka::TopicPartition*>* partitions)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    std::vector<std::unique_ptr<RdKafka::TopicPartition>> offsets;
+
+    auto take = [&offsets](const std::pair<std::string, int32_t>& key, PartitionState& state) {
+        if (state.dirty)
+        {
+            offsets.emplace_back(RdKafka::TopicPartition::create(key.first, key.second, state.watermark));
+            state.dirty = false;
+        }
+    };
+
+    if (partitions == nullptr)
+    {
+        for (auto& [key, state] : m_partitions)
+        {
+            take(key, state);
+        }
+    }
+    else
+    {
+        for (auto* toppar : *partitions)
+        {
+            auto found = m_partitions.find(std::make_pair(toppar->topic(), toppar->partition()));
+
+            if (found != m_partitions.end())
+            {
+                take(found->first, found->second);
+            }
+        }
+    }
+
+    return offsets;
+}
+
+void KafkaOffsetTracker::remove(const std::vector<RdKafka::TopicPartition*>& partitions)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (auto* toppar : partitions)
+    {
+        m_partitions.erase(std::make_pair(toppar->topic(), toppar->partition()));
+    }
+}
+
+void KafkaOffsetTracker::clear()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_partitions.clear();
+}
+
+void KafkaOffsetTracker::ack(const std::vector<KafkaOffsetRange>& ranges)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (const auto& range : ranges)
+    {
+        auto found_partition = m_partitions.find(std::make_pair(range.topic, range.partition));
+
+        if (found_partition == m_partitions.end())
+        {
+            continue;
+        }
+
+        auto& state      = found_partition->second;
+        auto found_range = state.in_flight.find(range.first_offset);
+
+        if (found_range == state.in_flight.end())
+        {
+            continue;
+        }
+
+        found_range->second.acknowledged = true;
+
+        // Advance the watermark over the acknowledged prefix
+        while (!state.in_flight.empty() && state.in_flight.begin()->second.acknowledged)
+        {
+            state.watermark = state.in_flight.begin()->second.next_offset;
+            state.dirty     = true;
+            state.in_flight.erase(state.in_flight.begin());
+        }
+    }
+}
+
+/**
+ * @brief Returns the range of offsets covered by `messages` for each partition
+ */
+std::vector<KafkaOffsetRange> get_offset_ranges(
+    const std::vector<std::unique_ptr<RdKafka::Message>>& messages)
+{
+    std::map<std::pair<std::string, int32_t>, std::pair<int64_t, int64_t>> bounds;
+
+    for (const auto& msg : messages)
+    {
+        auto key = std::make_pair(msg->topic_name(), msg->partition());
+        auto [found, inserted] = bounds.try_emplace(std::move(key), msg->offset(), msg->offset() + 1);
+
+        if (!inserted)
+        {
+            found->second.first  = std::min(found->second.first, msg->offset());
+            found->second.second = std::max(found->second.second, msg->offset() + 1);
+        }
+    }
+
+    std::vector<KafkaOffsetRange> ranges;
+    ranges.reserve(bounds.size());
+
+    for (const auto& [key, bound] : bounds)
+    {
+        ranges.emplace_back(KafkaOffsetRange{key.first, key.second, bound.first, bound.second});
+    }
+
+    return ranges;
+}
+
+/**
+ * @brief Returns the total number of messages which are available on the broker but have not been consumed for all of
+ * the partitions assigned to `consumer`. Uses the locally cached watermarks so no request to the broker is made.
+ * Returns -1 if the lag could not be determined. When set, `on_partition` is called with the lag of each partition.
+ */
+int64_t get_consumer_lag(
+    RdKafka::KafkaConsumer* consumer,
+    const std::function<void(const std::string&, int32_t, int64_t)>& on_partition = nullptr)
+{
+    std::vector<RdKafka::TopicPartition*> partitions;
+
+    if (consumer->assignment(partitions) != RdKafka::ERR_NO_ERROR || partitions.empty())
+    {
+        RdKafka::TopicPartition::destroy(partitions);
+        return -1;
+    }
+
+    int64_t total_lag = 0;
+
+    if (consumer->position(partitions) == RdKafka::ERR_NO_ERROR)
+    {
+        for (auto* toppar : partitions)
+        {
+            int64_t low  = 0;
+            int64_t high = 0;
+
+            if (toppar->offset() >= 0 &&
+                consumer->get_watermark_offsets(toppar->topic(), toppar->partition(), &low, &high) ==
+                    RdKafka::ERR_NO_ERROR &&
+                high >= 0)
+            {
+                auto lag = std::max<int64_t>(0, high - toppar->offset());
+                total_lag += lag;
+
+                if (on_partition)
+                {
+                    on_partition(toppar->topic(), toppar->partition(), lag);
+                }
+            }
+        }
+    }
+    else
+    {
+        total_lag = -1;
+    }
+
+    RdKafka::TopicPartition::destroy(partitions);
+
+    return total_lag;
+}
+
+/**
+ * @brief Records the offsets committed for `offsets`, or the position of every partition assigned to `consumer` when
+ * null, with the state checkpoints of the process. Does nothing while checkpoints are disabled.
+ */
+void record_checkpoint_offsets(RdKafka::KafkaConsumer* consumer, const std::vector<RdKafka::TopicPartition*>* offsets)
+{
+    if (StateCheckpoint::get_directory().empty())
+    {
+        return;
+    }
+
+    std::vector<RdKafka::TopicPartition*> positions;
+    if (offsets == nullptr)
+    {
+        if (consumer->assignment(positions) != RdKafka::ERR_NO_ERROR ||
+            consumer->position(positions) != RdKafka::ERR_NO_ERROR)
+        {
+            RdKafka::TopicPartition::destroy(positions);
+            return;
+        }
+
+        offsets = &positions;
+    }
+
+    for (const auto* toppar : *offsets)
+    {
+        if (toppar->offset() >= 0)
+        {
+            StateCheckpoint::record_committed_offset(toppar->topic(), toppar->partition(), toppar->offset());
+        }
+    }
+
+    RdKafka::TopicPartition::destroy(positions);
+}
+
+/**
+ * @brief Resumes the newly assigned `partitions` from the offsets recorded by the restored state checkpoints, if any,
+ * replaying the messages whose effect on the state of the stages was lost by the restart
+ */
+void seek_to_checkpoints(std::vector<RdKafka::TopicPartition*>& partitions)
+{
+    for (auto* toppar : partitions)
+    {
+        if (auto offset = StateCheckpoint::take_replay_offset(toppar->topic(), toppar->partition()); offset.has_value())
+        {
+            LOG(INFO) << "Resuming " << toppar->topic() << "[" << toppar->partition() << "] from offset " << *offset
+                      << " recorded by a state checkpoint";
+            toppar->set_offset(*offset);
+        }
+    }
+}
+
+// ************ KafkaSourceStage__MemoryBackpressure ****************************//
+/**
+ * @brief Pauses the partitions assigned to a consumer while the `MemoryGovernor` is throttled, resuming them once it is
+ * released. Paused partitions are not fetched from, while the consumer keeps serving rebalances. Partitions assigned
+ * by a rebalance while paused are paused by the next call.
+ */
+class KafkaSourceStage__MemoryBackpressure  // NOLINT
+{
+  public:
+    /**
+     * @brief Called once per iteration of the consume loop. While throttled, pauses the assignment and waits up to
+     * `max_wait` for the governor to be released. Returns true when the partitions are paused.
+     */
+    bool update(RdKafka::KafkaConsumer* consumer, std::chrono::milliseconds max_wait = std::chrono::milliseconds(100))
+    {
+        auto* governor = MemoryGovernor::get();
+        if (governor == nullptr || (!m_paused && !governor->is_throttled()))
+        {
+            return false;
+        }
+
+        if (governor->is_throttled())
+        {
+            if (!m_paused)
+            {
+                LOG(WARNING) << "Pausing the Kafka partitions, GPU memory is above the high watermark of "
+                             << governor->high_watermark() << " bytes";
+            }
+
+            // Pausing is idempotent, also pauses the partitions assigned since the last call
+            this->set_paused(consumer, true);
+
+            if (!governor->wait_for_release(max_wait))
+            {
+                return true;
+            }
+        }
+
+        LOG(INFO) << "Resuming the Kafka partitions, GPU memory is below the low watermark of "
+                  << governor->low_watermark() << " bytes";
+        this->set_paused(consumer, false);
+
+        return false;
+    }
+
+  private:
+    void set_paused(RdKafka::KafkaConsumer* consumer, bool paused)
+    {
+        std::vector<RdKafka::TopicPartition*> partitions;
+
+        if (consumer->assignment(partitions) == RdKafka::ERR_NO_ERROR && !partitions.empty())
+        {
+            auto err = paused ? consumer->pause(partitions) : consumer->resume(partitions);
+            if (err != RdKafka::ERR_NO_ERROR)
+            {
+                LOG(ERROR) << "Error " << (paused ? "pausing" : "resuming")
+                           << " the Kafka partitions: " << RdKafka::err2str(err);
+            }
+        }
+
+        RdKafka::TopicPartition::destroy(partitions);
+        m_paused = paused;
+    }
+
+    bool m_paused{false};
+};
+
+// ************ KafkaSourceStage__Metrics ****************************//
+/**
+ * @brief Metrics reported by a runnable of the source. The series are registered with the process-wide
+ * `MetricsRegistry` and shared by every runnable subscribed to the same topics. Safe to update from the partition
+ * worker threads.
+ */
+class KafkaSourceStage__Metrics  // NOLINT
+{
+  public:
+    explicit KafkaSourceStage__Metrics(const std::vector<std::string>& topics) :
+      m_stage_labels{{"topics", StringUtil::join(topics.begin(), topics.end(), ",")}}
+    {
+        auto& registry = MetricsRegistry::get_instance();
+
+        m_batches = registry.get_counter(
+            "morpheus_kafka_source_batches_total", "Number of batches consumed from Kafka", m_stage_labels);
+        m_batch_fill_ratio = registry.get_gauge("morpheus_kafka_source_batch_fill_ratio",
+                                                "Size of the last batch relative to the maximum batch size",
+                                                m_stage_labels);
+        m_consume_seconds  = registry.get_counter("morpheus_kafka_source_consume_seconds_total",
+                                                 "Time spent consuming messages from Kafka, including batching",
+                                                 m_stage_labels);
+    }
+
+    /**
+     * @brief Records the number of records and bytes in `messages` for each partition along with the fill ratio of
+     * the batch
+     */
+    void record_batch(const std::vector<std::unique_ptr<RdKafka::Message>>& messages, TensorIndex max_batch_size)
+    {
+        if (messages.empty())
+        {
+            return;
+        }
+
+        m_batches->increment();
+        m_batch_fill_ratio->set(static_cast<double>(messages.size()) / std::max<TensorIndex>(1, max_batch_size));
+
+        // Batches are usually made up of a single partition, avoid a lookup per message
+        PartitionMetrics* current = nullptr;
+        double records            = 0;
+        double bytes              = 0;
+
+        for (const auto& msg : messages)
+        {
+            auto* partition_metrics = &this->get_partition(msg->topic_name(), msg->partition());
+
+            if (partition_metrics != current)
+            {
+                if (current != nullptr)
+                {
+                    current->records->increment(records);
+                    current->bytes->increment(bytes);
+                }
+
+                current = partition_metrics;
+                records = 0;
+                bytes   = 0;
+            }
+
+            records += 1;
+            bytes += msg->len();
+        }
+
+        current->records->increment(records);
+        current->bytes->increment(bytes);
+    }
+
+    void record_consume_time(std::chrono::steady_clock::duration duration)
+    {
+        m_consume_seconds->increment(std::chrono::duration<double>(duration).count());
+    }
+
+    /**
+     * @brief Whether enough time has passed since the last call to `update_lag`
+     */
+    bool lag_update_due() const
+    {
+        return std::chrono::steady_clock::now() - m_last_lag_update >= LagUpdateInterval;
+    }
+
+    /**
+     * @brief Updates the lag of each partition assigned to `consumer`, returning the total lag
+     */
+    int64_t update_lag(RdKafka::KafkaConsumer* consumer)
+    {
+        m_last_lag_update = std::chrono::steady_clock::now();
+
+        return get_consumer_lag(consumer, [this](const std::string& topic, int32_t partition, int64_t lag) {
+            this->get_partition(topic, partition).lag->set(static_cast<double>(lag));
+        });
+    }
+
+  private:
+    static constexpr std::chrono::seconds LagUpdateInterval{1};
+
+    struct PartitionMetrics
+    {
+        std::shared_ptr<Counter> records;
+        std::shared_ptr<Counter> bytes;
+        std::shared_ptr<Gauge> lag;
+    };
+
+    PartitionMetrics& get_partition(const std::string& topic, int32_t partition)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        auto key   = std::make_pair(topic, partition);
+        auto found = m_partitions.find(key);
+
+        if (found == m_partitions.end())
+        {
+            auto& registry = MetricsRegistry::get_instance();
+            metric_labels_t labels{{"topic", topic}, {"partition", std::to_string(partition)}};
+
+            PartitionMetrics partition_metrics{
+                registry.get_counter(
+                    "morpheus_kafka_source_records_total", "Number of records consumed from Kafka", labels),
+                registry.get_counter(
+                    "morpheus_kafka_source_bytes_total", "Number of payload bytes consumed from Kafka", labels),
+                registry.get_gauge("morpheus_kafka_source_consumer_lag",
+                                   "Number of messages available on the broker which have not been consumed",
+                                   labels)};
+
+            found = m_partitions.emplace(std::move(key), std::move(partition_metrics)).first;
+        }
+
+        return found->second;
+    }
+
+    metric_labels_t m_stage_labels;
+
+    std::shared_ptr<Counter> m_batches;
+    std::shared_ptr<Gauge> m_batch_fill_ratio;
+    std::shared_ptr<Counter> m_consume_seconds;
+
+    std::chrono::steady_clock::time_point m_last_lag_update{};
+
+    std::mutex m_mutex;
+    std::map<std::pair<std::string, int32_t>, PartitionMetrics> m_partitions;
+};
+
+// ************ KafkaSourceStage__PartitionWorkers *******************//
+/**
+ * @brief A parsed batch of messages from a single partition along with the range of offsets it covers
+ */
+struct KafkaSourceStage__PartitionBatch  // NOLINT
+{
+    std::string topic;
+    int32_t partition{-1};
+    int64_t first_offset{-1};
+    int64_t next_offset{-1};
+    std::shared_ptr<MessageMeta> meta;
+};
+
+/**
+ * @brief Drains each assigned partition from its own librdkafka partition queue on a dedicated thread. Each thread
+ * batches and parses the messages for its partition and pushes the resulting `MessageMeta` into a channel which is
+ * consumed by the source runnable.
+ */
+class KafkaSourceStage__PartitionWorkers  // NOLINT
+{
+  public:
+    using process_fn_t = std::function<std::shared_ptr<MessageMeta>(std::vector<std::unique_ptr<RdKafka::Message>>&&,
+                                                                    PinnedHostBuffer&)>;
+
+    KafkaSourceStage__PartitionWorkers(std::function<uint32_t()> batch_timeout_fn,
+                                       std::function<TensorIndex()> max_batch_size_fn,
+                                       process_fn_t process_fn,
+                                       KafkaBatchController* batch_controller = nullptr,
+                                       KafkaSourceStage__Metrics* metrics     = nullptr,
+                                       DeviceLocality locality                = {}) :
+      m_batch_timeout_fn(std::move(batch_timeout_fn)),
+      m_max_batch_size_fn(std::move(max_batch_size_fn)),
+      m_process_fn(std::move(process_fn)),
+      m_batch_controller(batch_controller),
+      m_metrics(metrics),
+      m_locality(std::move(locality))
+    {}
+
+    ~KafkaSourceStage__PartitionWorkers()
+    {
+        this->stop_all();
+    }
+
+    /**
+     * @brief Detaches the partition queues from the consumer queue and starts a worker for each. Must be called after
+     * the partitions have been assigned.
+     */
+    void start(RdKafka::KafkaConsumer* consumer, const std::vector<RdKafka::TopicPartition*>& partitions)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (auto* toppar : partitions)
+        {
+            auto key = std::make_pair(toppar->topic(), toppar->partition());
+
+            if (m_workers.contains(key))
+            {
+                continue;
+            }
+
+            auto queue = std::unique_ptr<RdKafka::Queue>(consumer->get_partition_queue(toppar));
+
+            if (!queue)
+            {
+                LOG(ERROR) << "Unable to get the partition queue for " << key.first << "[" << key.second
+                           << "]. Messages will be consumed from the consumer queue";
+                continue;
+            }
+
+            // Stop forwarding to the consumer queue so this partition is only served by its worker
+            CHECK_KAFKA(queue->forward(nullptr), RdKafka::ERR_NO_ERROR, "Error disabling partition queue forwarding");
+
+            auto worker   = std::make_unique<Worker>();
+            worker->queue = std::move(queue);
+            worker->thread = std::thread(
+                &KafkaSourceStage__PartitionWorkers::worker_loop, this, worker.get(), key.first, key.second);
+
+            m_workers.emplace(std::move(key), std::move(worker));
+        }
+    }
+
+    /**
+     * @brief Stops the workers for the specified partitions. Any batch which has not been pushed to the channel is
+     * dropped and will be redelivered since its offset was never committed.
+     */
+    void stop(const std::vector<RdKafka::TopicPartition*>& partitions)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (auto* toppar : partitions)
+        {
+            auto found = m_workers.find(std::make_pair(toppar->topic(), toppar->partition()));
+
+            if (found != m_workers.end())
+            {
+                stop_worker(*found->second);
+                m_workers.erase(found);
+            }
+        }
+    }
+
+    void stop_all()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (auto& [key, worker] : m_workers)
+        {
+            stop_worker(*worker);
+        }
+
+        m_workers.clear();
+    }
+
+    bool is_assigned(const std::string& topic, int32_t partition)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        return m_workers.contains(std::make_pair(topic, partition));
+    }
+
+    boost::fibers::channel_op_status pop(KafkaSourceStage__PartitionBatch& batch, std::chrono::milliseconds timeout)
+    {
+        return m_channel.pop_wait_for(batch, timeout);
+    }
+
+  private:
+    struct Worker
+    {
+        std::unique_ptr<RdKafka::Queue> queue;
+        std::atomic<bool> stop_requested{false};
+        std::thread thread;
+    };
+
+    static void stop_worker(Worker& worker)
+    {
+        worker.stop_requested = true;
+
+        if (worker.thread.joinable())
+        {
+            worker.thread.join();
+        }
+    }
+
+    void worker_loop(Worker* worker, std::string topic, int32_t partition)
+    {
+        if (TopologyUtil::bind_current_thread(m_locality))
+        {
+            VLOG(1) << "Partition worker of " << topic << "[" << partition << "] bound to "
+                    << TopologyUtil::describe_current_thread();
+        }
+
+        PinnedHostBuffer buffer(0, m_locality.numa_node);
+
+        while (!worker->stop_requested)
+        {
+            auto batch_timeout = std::chrono::milliseconds(m_batch_timeout_fn());
+
+            std::vector<std::unique_ptr<RdKafka::Message>> messages;
+
+            auto now           = std::chrono::high_resolution_clock::now();
+            auto batch_end     = now + batch_timeout;
+            bool hit_eof       = false;
+            auto consume_start = std::chrono::steady_clock::now();
+
+            do
+            {
+                auto remaining_ms = std::chrono::duration_cast<std::chrono::milliseconds>(batch_end - now).count();
+
+                std::unique_ptr<RdKafka::Message> msg{worker->queue->consume(std::min(10L, remaining_ms))};
+
+                switch (msg->err())
+                {
+                case RdKafka::ERR__TIMED_OUT:
+                    break;
+                case RdKafka::ERR_NO_ERROR:
+                    messages.emplace_back(std::move(msg));
+                    break;
+                case RdKafka::ERR__PARTITION_EOF:
+                    MORPHEUS_TRACE("kafka.partition_eof", partition);
+                    hit_eof = true;
+                    break;
+                default:
+                    /* Errors */
+                    MORPHEUS_TRACE("kafka.consume_error", msg->err(), partition);
+                    LOG(ERROR) << "Consume failed for " << topic << "[" << partition << "]: " << msg->errstr();
+                    TraceBuffer::on_error();
+                }
+
+                now = std::chrono::high_resolution_clock::now();
+            } while (!worker->stop_requested && !hit_eof && messages.size() < m_max_batch_size_fn() &&
+                     now < batch_end);
+
+            if (m_metrics != nullptr)
+            {
+                m_metrics->record_consume_time(std::chrono::steady_clock::now() - consume_start);
+                m_metrics->record_batch(messages, m_max_batch_size_fn());
+            }
+
+            MORPHEUS_TRACE("kafka.consume_batch", messages.size(), partition);
+
+            if (messages.empty())
+            {
+                if (hit_eof)
+                {
+                    // Hit the end, sleep for 100 ms
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+
+                continue;
+            }
+
+            KafkaSourceStage__PartitionBatch batch{
+                topic, partition, messages.front()->offset(), messages.back()->offset() + 1, nullptr};
+
+            try
+            {
+                auto num_messages = messages.size();
+                auto start_time   = std::chrono::steady_clock::now();
+
+                batch.meta = m_process_fn(std::move(messages), buffer);
+
+                if (m_batch_controller != nullptr)
+                {
+                    m_batch_controller->update(num_messages,
+                                               std::chrono::duration_cast<std::chrono::microseconds>(
+                                                   std::chrono::steady_clock::now() - start_time));
+                }
+            } catch (std::exception& ex)
+            {
+                LOG(ERROR) << "Exception in process_batch for " << topic << "[" << partition << "]. Msg: " << ex.what();
+                continue;
+            }
+
+            // Use a timeout so a revoke can stop this worker while the source is not draining the channel
+            while (!worker->stop_requested)
+            {
+                auto status = m_channel.push_wait_for(batch, std::chrono::milliseconds(10));
+
+                if (status != boost::fibers::channel_op_status::timeout)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    std::function<uint32_t()> m_batch_timeout_fn;
+    std::function<TensorIndex()> m_max_batch_size_fn;
+    process_fn_t m_process_fn;
+    KafkaBatchController* m_batch_controller{nullptr};
+    KafkaSourceStage__Metrics* m_metrics{nullptr};
+    DeviceLocality m_locality;
+
+    std::mutex m_mutex;
+    std::map<std::pair<std::string, int32_t>, std::unique_ptr<Worker>> m_workers;
+    boost::fibers::buffered_channel<KafkaSourceStage__PartitionBatch> m_channel{64};
+};
 
 // ************ KafkaSourceStage__Rebalancer *************************//
 class KafkaSourceStage__Rebalancer : public RdKafka::RebalanceCb  // NOLINT
@@ -114,7 +905,10 @@ class KafkaSourceStage__Rebalancer : public RdKafka::RebalanceCb  // NOLINT
     KafkaSourceStage__Rebalancer(std::function<uint32_t()> batch_timeout_fn,
                                  std::function<TensorIndex()> max_batch_size_fn,
                                  std::function<std::string(std::string)> display_str_fn,
-                                 std::function<bool(std::vector<std::unique_ptr<RdKafka::Message>>&)> process_fn);
+                                 std::function<bool(std::vector<std::unique_ptr<RdKafka::Message>>&)> process_fn,
+                                 KafkaSourceStage__PartitionWorkers* partition_workers = nullptr,
+                                 KafkaOffsetTracker* offset_tracker       = nullptr,
+                                 KafkaTransactionCoordinator* transactions             = nullptr);
 
     void rebalance_cb(RdKafka::KafkaConsumer* consumer,
                       RdKafka::ErrorCode err,
@@ -153,19 +947,24 @@ class KafkaSourceStage__Rebalancer : public RdKafka::RebalanceCb  // NOLINT
                 messages.emplace_back(std::move(msg));
                 break;
             case RdKafka::ERR__PARTITION_EOF:
+                MORPHEUS_TRACE("kafka.partition_eof", msg->partition());
                 VLOG_EVERY_N(10, 10) << "Hit EOF for partition";
                 // Hit the end, sleep for 100 ms
                 boost::this_fiber::sleep_for(std::chrono::milliseconds(100));
                 break;
             default:
                 /* Errors */
+                MORPHEUS_TRACE("kafka.consume_error", msg->err(), msg->partition());
                 LOG(ERROR) << "Consume failed: " << msg->errstr();
+                TraceBuffer::on_error();
             }
 
             // Update now
             now = std::chrono::high_resolution_clock::now();
         } while (messages.size() < m_max_batch_size_fn() && now < batch_end);
 
+        MORPHEUS_TRACE("kafka.consume_batch", messages.size(), -1);
+
         return std::move(messages);
     }
 
@@ -182,6 +981,15 @@ class KafkaSourceStage__Rebalancer : public RdKafka::RebalanceCb  // NOLINT
     std::function<std::string(std::string)> m_display_str_fn;
     std::function<bool(std::vector<std::unique_ptr<RdKafka::Message>>&)> m_process_fn;
 
+    // Optional, only set when each partition is consumed from its own queue
+    KafkaSourceStage__PartitionWorkers* m_partition_workers{nullptr};
+
+    // Optional, only set when offsets are committed after downstream acknowledgement
+    KafkaOffsetTracker* m_offset_tracker{nullptr};
+
+    // Optional, only set when the acknowledged offsets are committed by the transactions of a Kafka sink
+    KafkaTransactionCoordinator* m_transactions{nullptr};
+
     boost::fibers::recursive_mutex m_mutex;
     mrc::SharedFuture<bool> m_partition_future;
 };
@@ -190,11 +998,17 @@ KafkaSourceStage__Rebalancer::KafkaSourceStage__Rebalancer(
     std::function<uint32_t()> batch_timeout_fn,
     std::function<TensorIndex()> max_batch_size_fn,
     std::function<std::string(std::string)> display_str_fn,
-    std::function<bool(std::vector<std::unique_ptr<RdKafka::Message>>&)> process_fn) :
+    std::function<bool(std::vector<std::unique_ptr<RdKafka::Message>>&)> process_fn,
+    KafkaSourceStage__PartitionWorkers* partition_workers,
+    KafkaOffsetTracker* offset_tracker,
+    KafkaTransactionCoordinator* transactions) :
   m_batch_timeout_fn(std::move(batch_timeout_fn)),
   m_max_batch_size_fn(std::move(max_batch_size_fn)),
   m_display_str_fn(std::move(display_str_fn)),
-  m_process_fn(std::move(process_fn))
+  m_process_fn(std::move(process_fn)),
+  m_partition_workers(partition_workers),
+  m_offset_tracker(offset_tracker),
+  m_transactions(transactions)
 {}
 
 void KafkaSourceStage__Rebalancer::rebalance_cb(RdKafka::KafkaConsumer* consumer,
@@ -215,12 +1029,15 @@ void KafkaSourceStage__Rebalancer::rebalance_cb(RdKafka::KafkaConsumer* consumer
 
     if (err == RdKafka::ERR__ASSIGN_PARTITIONS)
     {
+        MORPHEUS_TRACE("kafka.rebalance_assign", partitions.size(), old_partition_ids.size());
         VLOG(10) << m_display_str_fn(MORPHEUS_CONCAT_STR(
             "Rebalance: Assign Partitions. Current Partitions: << "
             << StringUtil::array_to_str(old_partition_ids.begin(), old_partition_ids.end())
             << ". Assigning: " << StringUtil::array_to_str(new_partition_ids.begin(), new_partition_ids.end())));
 
         // application may load offets from arbitrary external storage here and update \p partitions
+        seek_to_checkpoints(partitions);
+
         if (consumer->rebalance_protocol() == "COOPERATIVE")
         {
             CHECK_KAFKA(std::unique_ptr<RdKafka::Error>(consumer->incremental_assign(partitions))->code(),
@@ -231,15 +1048,69 @@ void KafkaSourceStage__Rebalancer::rebalance_cb(RdKafka::KafkaConsumer* consumer
         {
             CHECK_KAFKA(consumer->assign(partitions), RdKafka::ERR_NO_ERROR, "Error during assign");
         }
+
+        if (m_partition_workers != nullptr)
+        {
+            m_partition_workers->start(consumer, partitions);
+        }
     }
     else if (err == RdKafka::ERR__REVOKE_PARTITIONS)
     {
+        MORPHEUS_TRACE("kafka.rebalance_revoke", partitions.size(), old_partition_ids.size());
         VLOG(10) << m_display_str_fn(MORPHEUS_CONCAT_STR(
             "Rebalance: Revoke Partitions. Current Partitions: << "
             << StringUtil::array_to_str(old_partition_ids.begin(), old_partition_ids.end())
             << ". Revoking: " << StringUtil::array_to_str(new_partition_ids.begin(), new_partition_ids.end())));
 
+        // Stop consuming from the revoked partitions before they are unassigned
+        if (m_partition_workers != nullptr)
+        {
+            m_partition_workers->stop(partitions);
+        }
+
         // Application may commit offsets manually here if auto.commit.enable=false
+        if (m_transactions != nullptr)
+        {
+            // Commit the open transaction along with whatever has been acknowledged so far, before the new owner of
+            // the partitions resumes from the committed offsets
+            try
+            {
+                m_transactions->commit();
+            } catch (std::exception& ex)
+            {
+                LOG(ERROR) << "Exception committing the Kafka transaction for revoked partitions. Msg: " << ex.what();
+            }
+
+            m_offset_tracker->remove(partitions);
+        }
+        else if (m_offset_tracker != nullptr)
+        {
+            // Commit whatever has been acknowledged so far, anything still in flight will be redelivered to the new
+            // owner of the partition
+            auto offsets = m_offset_tracker->take_commits(&partitions);
+
+            if (!offsets.empty())
+            {
+                auto offset_ptrs = foreach_map(offsets, [](const auto& x) {
+                    return x.get();
+                });
+
+                auto commit_err = consumer->commitSync(offset_ptrs);
+
+                if (commit_err != RdKafka::ERR_NO_ERROR)
+                {
+                    LOG(ERROR) << "Error committing acknowledged offsets for revoked partitions: "
+                               << RdKafka::err2str(commit_err);
+                }
+                else
+                {
+                    record_checkpoint_offsets(consumer, &offset_ptrs);
+                }
+            }
+
+            m_offset_tracker->remove(partitions);
+        }
+
         if (consumer->rebalance_protocol() == "COOPERATIVE")
         {
             CHECK_KAFKA(std::unique_ptr<RdKafka::Error>(consumer->incremental_unassign(partitions))->code(),
@@ -253,7 +1124,20 @@ void KafkaSourceStage__Rebalancer::rebalance_cb(RdKafka::KafkaConsumer* consumer
     }
     else
     {
+        MORPHEUS_TRACE("kafka.rebalance_error", err);
         LOG(ERROR) << "Rebalancing error: " << RdKafka::err2str(err) << std::endl;
+        TraceBuffer::on_error();
+
+        if (m_partition_workers != nullptr)
+        {
+            m_partition_workers->stop_all();
+        }
+
+        if (m_offset_tracker != nullptr)
+        {
+            m_offset_tracker->clear();
+        }
+
         CHECK_KAFKA(consumer->unassign(), RdKafka::ERR_NO_ERROR, "Error during unassign");
     }
 }
@@ -294,7 +1178,17 @@ KafkaSourceStage::KafkaSourceStage(TensorIndex max_batch_size,
                                    bool disable_pre_filtering,
                                    std::size_t stop_after,
                                    bool async_commits,
-                                   std::unique_ptr<KafkaOAuthCallback> oauth_callback) :
+                                   std::unique_ptr<KafkaOAuthCallback> oauth_callback,
+                                   bool gpu_pre_filtering,
+                                   bool parallel_partitions,
+                                   uint32_t latency_target_ms,
+                                   bool commit_on_ack,
+                                   std::vector<int> device_ids,
+                                   TableSchema schema,
+                                   ColumnProjection projection,
+                                   const std::string& payload_format,
+                                   std::string placement,
+                                   const std::string& capture_path) :
   PythonSource(build()),
   m_max_batch_size(max_batch_size),
   m_topics(std::vector<std::string>{std::move(topic)}),
@@ -304,8 +1198,20 @@ KafkaSourceStage::KafkaSourceStage(TensorIndex max_batch_size,
   m_disable_pre_filtering(disable_pre_filtering),
   m_stop_after{stop_after},
   m_async_commits(async_commits),
+  m_gpu_pre_filtering(gpu_pre_filtering),
+  m_parallel_partitions(parallel_partitions),
+  m_latency_target_ms(latency_target_ms),
+  m_commit_on_ack(commit_on_ack),
+  m_devices(std::move(device_ids)),
+  m_schema(std::move(schema)),
+  m_projection(std::move(projection)),
+  m_decoder(payload_format == "json" ? nullptr : PayloadDecoder::create(payload_format)),
+  m_placement(std::move(placement)),
+  m_capture(capture_path.empty() ? nullptr : std::make_shared<SourceCaptureWriter>(capture_path)),
   m_oauth_callback(std::move(oauth_callback))
-{}
+{
+    this->register_metrics();
+}
 
 KafkaSourceStage::KafkaSourceStage(TensorIndex max_batch_size,
                                    std::vector<std::string> topics,
@@ -315,7 +1221,17 @@ KafkaSourceStage::KafkaSourceStage(TensorIndex max_batch_size,
                                    bool disable_pre_filtering,
                                    std::size_t stop_after,
                                    bool async_commits,
-                                   std::unique_ptr<KafkaOAuthCallback> oauth_callback) :
+                                   std::unique_ptr<KafkaOAuthCallback> oauth_callback,
+                                   bool gpu_pre_filtering,
+                                   bool parallel_partitions,
+                                   uint32_t latency_target_ms,
+                                   bool commit_on_ack,
+                                   std::vector<int> device_ids,
+                                   TableSchema schema,
+                                   ColumnProjection projection,
+                                   const std::string& payload_format,
+                                   std::string placement,
+                                   const std::string& capture_path) :
   PythonSource(build()),
   m_max_batch_size(max_batch_size),
   m_topics(std::move(topics)),
@@ -325,26 +1241,96 @@ KafkaSourceStage::KafkaSourceStage(TensorIndex max_batch_size,
   m_disable_pre_filtering(disable_pre_filtering),
   m_stop_after{stop_after},
   m_async_commits(async_commits),
+  m_gpu_pre_filtering(gpu_pre_filtering),
+  m_parallel_partitions(parallel_partitions),
+  m_latency_target_ms(latency_target_ms),
+  m_commit_on_ack(commit_on_ack),
+  m_devices(std::move(device_ids)),
+  m_schema(std::move(schema)),
+  m_projection(std::move(projection)),
+  m_decoder(payload_format == "json" ? nullptr : PayloadDecoder::create(payload_format)),
+  m_placement(std::move(placement)),
+  m_capture(capture_path.empty() ? nullptr : std::make_shared<SourceCaptureWriter>(capture_path)),
   m_oauth_callback(std::move(oauth_callback))
-{}
+{
+    this->register_metrics();
+}
 
 KafkaSourceStage::subscriber_fn_t KafkaSourceStage::build()
 {
     return [this](rxcpp::subscriber<source_type_t> sub) -> void {
         std::size_t records_emitted = 0;
+
+        // Where the partition workers are bound and the batch buffers allocated, reported once at startup
+        const auto locality = TopologyUtil::resolve_placement(m_placement);
+        if (!m_placement.empty())
+        {
+            LOG(INFO) << "KafkaSourceStage placement '" << m_placement << "': " << locality.to_string()
+                      << ". Source thread: " << TopologyUtil::describe_current_thread();
+        }
+
+        // Reused for every batch processed by this runnable
+        PinnedHostBuffer batch_buffer(0, locality.numa_node);
+
+        KafkaSourceStage__Metrics metrics(m_topics);
+
+        // Only pauses the partitions when a memory governor is installed
+        KafkaSourceStage__MemoryBackpressure memory_backpressure;
+
+        // Only used when adaptive batching is enabled
+        KafkaBatchController batch_controller(m_max_batch_size, m_batch_timeout_ms, m_latency_target_ms);
+        const bool adaptive_batching = m_latency_target_ms > 0;
+
+        // Only used when offsets are committed after downstream acknowledgement. Whether commits are required is not
+        // known until the consumer has been created, until then nothing is emitted
+        auto offset_tracker = std::make_shared<KafkaOffsetTracker>();
+        bool commit_on_ack  = false;
+
+        // Only set when a transactional Kafka sink commits the offsets of this consumer group, which requires the
+        // offsets to be tracked
+        auto group_id = m_config.find("group.id");
+        std::shared_ptr<KafkaTransactionCoordinator> transactions;
+
+        if (group_id != m_config.end())
+        {
+            transactions = KafkaTransactionCoordinator::find(group_id->second);
+        }
+
+        auto batch_timeout_fn = [this, &batch_controller, adaptive_batching]() {
+            return adaptive_batching ? batch_controller.batch_timeout_ms() : this->batch_timeout_ms();
+        };
+
+        auto max_batch_size_fn = [this, &batch_controller, adaptive_batching]() {
+            return adaptive_batching ? batch_controller.batch_size() : this->max_batch_size();
+        };
+
+        // Only started when each partition should be consumed in parallel
+        KafkaSourceStage__PartitionWorkers partition_workers(
+            batch_timeout_fn,
+            max_batch_size_fn,
+            [this](std::vector<std::unique_ptr<RdKafka::Message>>&& message_batch, PinnedHostBuffer& buffer) {
+                return this->process_batch(std::move(message_batch), buffer);
+            },
+            adaptive_batching ? &batch_controller : nullptr,
+            &metrics,
+            locality);
+
         // Build rebalancer
         KafkaSourceStage__Rebalancer rebalancer(
-            [this]() {
-                return this->batch_timeout_ms();
-            },
-            [this]() {
-                return this->max_batch_size();
-            },
+            batch_timeout_fn,
+            max_batch_size_fn,
             [this](const std::string str_to_display) {
                 auto& ctx = mrc::runnable::Context::get_runtime_context();
                 return MORPHEUS_CONCAT_STR(ctx.info() << " " << str_to_display);
             },
-            [sub, &records_emitted, this](std::vector<std::unique_ptr<RdKafka::Message>>& message_batch) {
+            [sub,
+             &records_emitted,
+             &batch_buffer,
+             &offset_tracker,
+             &commit_on_ack,
+             &metrics,
+             &max_batch_size_fn,
+             this](std::vector<std::unique_ptr<RdKafka::Message>>& message_batch) {
                 // If we are unsubscribed, throw an error to break the loops
                 if (!sub.is_subscribed())
                 {
@@ -362,9 +1348,19 @@ KafkaSourceStage::subscriber_fn_t KafkaSourceStage::build()
 
                 std::shared_ptr<morpheus::MessageMeta> batch;
 
+                metrics.record_batch(message_batch, max_batch_size_fn());
+
+                // Determine the offset ranges before the batch is consumed by process_batch
+                std::vector<KafkaOffsetRange> ranges;
+
+                if (commit_on_ack)
+                {
+                    ranges = get_offset_ranges(message_batch);
+                }
+
                 try
                 {
-                    batch = std::move(this->process_batch(std::move(message_batch)));
+                    batch = std::move(this->process_batch(std::move(message_batch), batch_buffer));
                 } catch (std::exception& ex)
                 {
                     LOG(ERROR) << "Exception in process_batch. Msg: " << ex.what();
@@ -372,39 +1368,218 @@ KafkaSourceStage::subscriber_fn_t KafkaSourceStage::build()
                     return false;
                 }
 
+                if (commit_on_ack)
+                {
+                    batch->set_acknowledgement(offset_tracker->track(std::move(ranges)));
+                }
+
                 auto num_records = batch->count();
                 sub.on_next(std::move(batch));
                 records_emitted += num_records;
-                return m_requires_commit;
-            });
+
+                // Acknowledged offsets are committed separately
+                return m_requires_commit && !commit_on_ack;
+            },
+            m_parallel_partitions ? &partition_workers : nullptr,
+            m_commit_on_ack || transactions != nullptr ? offset_tracker.get() : nullptr,
+            transactions.get());
+
+        auto commit = [this](RdKafka::KafkaConsumer* consumer, std::vector<RdKafka::TopicPartition*>* offsets) {
+            if (m_async_commits)
+            {
+                CHECK_KAFKA(offsets == nullptr ? consumer->commitAsync() : consumer->commitAsync(*offsets),
+                            RdKafka::ERR_NO_ERROR,
+                            "Error during commitAsync");
+            }
+            else
+            {
+                CHECK_KAFKA(offsets == nullptr ? consumer->commitSync() : consumer->commitSync(*offsets),
+                            RdKafka::ERR_NO_ERROR,
+                            "Error during commit");
+            }
+
+            record_checkpoint_offsets(consumer, offsets);
+        };
+
+        // Commits the offsets which have been acknowledged since the last call, unless committed by the transactions
+        auto commit_acknowledged = [&offset_tracker, &commit, &transactions](RdKafka::KafkaConsumer* consumer) {
+            if (transactions != nullptr)
+            {
+                return;
+            }
+
+            auto offsets = offset_tracker->take_commits();
+
+            if (!offsets.empty())
+            {
+                auto offset_ptrs = foreach_map(offsets, [](const auto& x) {
+                    return x.get();
+                });
+
+                commit(consumer, &offset_ptrs);
+            }
+        };
 
         auto& context = mrc::runnable::Context::get_runtime_context();
 
         // Build consumer
         auto consumer = this->create_consumer(rebalancer);
 
+        if (transactions != nullptr && !m_requires_commit)
+        {
+            LOG(WARNING) << "KafkaSourceStage: Offsets are not committed by the Kafka sink transactions when they are "
+                            "not committed manually";
+            transactions.reset();
+            rebalancer.m_transactions = nullptr;
+        }
+
+        commit_on_ack = (m_commit_on_ack || transactions != nullptr) && m_requires_commit;
+
+        if (transactions != nullptr)
+        {
+            transactions->attach_consumer(consumer.get(), [tracker = std::weak_ptr(offset_tracker)]() {
+                auto locked = tracker.lock();
+                return locked ? locked->take_commits() : KafkaTransactionCoordinator::offsets_t{};
+            });
+        }
+
+        if (m_commit_on_ack && !m_requires_commit)
+        {
+            LOG(WARNING) << "KafkaSourceStage: 'commit_on_ack' has no effect when offsets are not committed manually";
+        }
+
         // Wait for all to connect
         context.barrier();
 
         try
         {
-            while (sub.is_subscribed())
+            if (m_parallel_partitions)
             {
-                std::vector<std::unique_ptr<RdKafka::Message>> message_batch =
-                    rebalancer.partition_progress_step(consumer.get());
+                while (sub.is_subscribed())
+                {
+                    memory_backpressure.update(consumer.get());
+
+                    // Serves the rebalance callbacks. Also picks up any messages which were fetched onto the consumer
+                    // queue before the partition queues were detached
+                    std::vector<std::unique_ptr<RdKafka::Message>> stray_messages;
+                    std::unique_ptr<RdKafka::Message> msg{consumer->consume(0)};
+
+                    if (msg->err() == RdKafka::ERR_NO_ERROR)
+                    {
+                        stray_messages.emplace_back(std::move(msg));
+                    }
+
+                    if (!stray_messages.empty())
+                    {
+                        std::unique_ptr<RdKafka::TopicPartition> offset{
+                            RdKafka::TopicPartition::create(stray_messages.back()->topic_name(),
+                                                            stray_messages.back()->partition(),
+                                                            stray_messages.back()->offset() + 1)};
+                        std::vector<RdKafka::TopicPartition*> offsets{offset.get()};
+
+                        if (rebalancer.process_messages(stray_messages))
+                        {
+                            commit(consumer.get(), &offsets);
+                        }
+                    }
+
+                    if (commit_on_ack)
+                    {
+                        commit_acknowledged(consumer.get());
+                    }
+
+                    if (metrics.lag_update_due())
+                    {
+                        metrics.update_lag(consumer.get());
+                    }
+
+                    KafkaSourceStage__PartitionBatch partition_batch;
+
+                    if (partition_workers.pop(partition_batch, std::chrono::milliseconds(10)) !=
+                        boost::fibers::channel_op_status::success)
+                    {
+                        continue;
+                    }
+
+                    // If we are unsubscribed, throw an error to break the loops
+                    if (!sub.is_subscribed())
+                    {
+                        throw KafkaSourceStageUnsubscribedException();
+                    }
+
+                    if (commit_on_ack)
+                    {
+                        partition_batch.meta->set_acknowledgement(
+                            offset_tracker->track({KafkaOffsetRange{partition_batch.topic,
+                                                                    partition_batch.partition,
+                                                                    partition_batch.first_offset,
+                                                                    partition_batch.next_offset}}));
+                    }
+
+                    auto num_records = partition_batch.meta->count();
+                    sub.on_next(std::move(partition_batch.meta));
+                    records_emitted += num_records;
+
+                    // Only commit the offsets for this partition, other partitions may have batches still in flight.
+                    // Skip revoked partitions, their new owner will resume from the last committed offset
+                    if (!commit_on_ack && m_requires_commit &&
+                        partition_workers.is_assigned(partition_batch.topic, partition_batch.partition))
+                    {
+                        std::unique_ptr<RdKafka::TopicPartition> offset{RdKafka::TopicPartition::create(
+                            partition_batch.topic, partition_batch.partition, partition_batch.next_offset)};
+                        std::vector<RdKafka::TopicPartition*> offsets{offset.get()};
 
-                // Process the messages. Returns true if we need to commit
-                auto should_commit = rebalancer.process_messages(message_batch);
+                        commit(consumer.get(), &offsets);
+                    }
 
-                if (should_commit)
+                    if (m_stop_after > 0 && records_emitted >= m_stop_after)
+                    {
+                        throw KafkaSourceStageStopAfter();
+                    }
+                }
+            }
+            else
+            {
+                while (sub.is_subscribed())
                 {
-                    if (m_async_commits)
+                    memory_backpressure.update(consumer.get());
+
+                    auto consume_start = std::chrono::steady_clock::now();
+
+                    std::vector<std::unique_ptr<RdKafka::Message>> message_batch =
+                        rebalancer.partition_progress_step(consumer.get());
+
+                    metrics.record_consume_time(std::chrono::steady_clock::now() - consume_start);
+
+                    auto num_messages = message_batch.size();
+                    auto start_time   = std::chrono::steady_clock::now();
+
+                    // Process the messages. Returns true if we need to commit
+                    auto should_commit = rebalancer.process_messages(message_batch);
+
+                    auto processing_time = std::chrono::steady_clock::now() - start_time;
+
+                    // The lag is needed for every batch when adapting the batch size
+                    int64_t lag = -1;
+
+                    if ((adaptive_batching && num_messages > 0) || metrics.lag_update_due())
+                    {
+                        lag = metrics.update_lag(consumer.get());
+                    }
+
+                    if (adaptive_batching && num_messages > 0)
+                    {
+                        batch_controller.update(
+                            num_messages, std::chrono::duration_cast<std::chrono::microseconds>(processing_time), lag);
+                    }
+
+                    if (should_commit)
                     {
-                        CHECK_KAFKA(consumer->commitAsync(), RdKafka::ERR_NO_ERROR, "Error during commitAsync");
+                        commit(consumer.get(), nullptr);
                     }
-                    else
+                    else if (commit_on_ack)
                     {
-                        CHECK_KAFKA(consumer->commitSync(), RdKafka::ERR_NO_ERROR, "Error during commit");
+                        commit_acknowledged(consumer.get());
                     }
                 }
             }
@@ -417,6 +1592,43 @@ KafkaSourceStage::subscriber_fn_t KafkaSourceStage::build()
             LOG(ERROR) << "Exception in rebalance_loop. Msg: " << ex.what();
         }
 
+        // Stop the partition workers before the consumer is closed
+        partition_workers.stop_all();
+
+        if (transactions != nullptr)
+        {
+            // Anything which has not been acknowledged by now will be redelivered
+            try
+            {
+                transactions->commit();
+            } catch (std::exception& ex)
+            {
+                LOG(ERROR) << "Exception committing the Kafka transaction. Msg: " << ex.what();
+            }
+
+            transactions->detach_consumer();
+        }
+        else if (commit_on_ack)
+        {
+            // Anything which has not been acknowledged by now will be redelivered
+            try
+            {
+                auto offsets = offset_tracker->take_commits();
+
+                if (!offsets.empty())
+                {
+                    auto offset_ptrs = foreach_map(offsets, [](const auto& x) {
+                        return x.get();
+                    });
+
+                    CHECK_KAFKA(consumer->commitSync(offset_ptrs), RdKafka::ERR_NO_ERROR, "Error during commit");
+                }
+            } catch (std::exception& ex)
+            {
+                LOG(ERROR) << "Exception committing acknowledged offsets. Msg: " << ex.what();
+            }
+        }
+
         consumer->unsubscribe();
         consumer->close();
         consumer.reset();
@@ -427,6 +1639,18 @@ KafkaSourceStage::subscriber_fn_t KafkaSourceStage::build()
     };
 }
 
+void KafkaSourceStage::register_metrics()
+{
+    auto& registry = MetricsRegistry::get_instance();
+    metric_labels_t labels{{"topics", StringUtil::join(m_topics.begin(), m_topics.end(), ",")}};
+
+    m_load_table_seconds  = registry.get_counter(
+        "morpheus_kafka_source_load_table_seconds_total", "Time spent parsing batches into cuDF tables", labels);
+    m_create_meta_seconds = registry.get_counter("morpheus_kafka_source_create_meta_seconds_total",
+                                                 "Time spent creating a MessageMeta from the parsed tables",
+                                                 labels);
+}
+
 TensorIndex KafkaSourceStage::max_batch_size()
 {
     return m_max_batch_size;
@@ -613,50 +1837,132 @@ std::unique_ptr<RdKafka::KafkaConsumer> KafkaSourceStage::create_consumer(RdKafk
     return std::move(consumer);
 }
 
-cudf::io::table_with_metadata KafkaSourceStage::load_table(const std::string& buffer)
+cudf::io::table_with_metadata KafkaSourceStage::load_table(const PinnedHostBuffer& buffer)
 {
-    auto options =
-        cudf::io::json_reader_options::builder(cudf::io::source_info(buffer.c_str(), buffer.size())).lines(true);
+    // When filtering on the GPU, malformed lines are expected and read as rows of nulls right away. Otherwise a batch
+    // is only parsed again when a malformed line, missed or not filtered on the host, fails the first parse, such that
+    // only the malformed messages are dropped rather than the entire batch
+    const bool filter_on_gpu = !m_disable_pre_filtering && m_gpu_pre_filtering;
+
+    cudf::size_type num_malformed = 0;
+    auto table = read_json_lines_recovering(buffer.data(), buffer.size(), m_schema, filter_on_gpu, num_malformed);
+
+    if (num_malformed > 0)
+    {
+        LOG(ERROR) << "Failed to parse " << num_malformed << " of " << (table.tbl->num_rows() + num_malformed)
+                   << " kafka messages as json";
+    }
+
+    // Drops the fields not in the schema, and those no downstream stage reads, after filtering such that a row is only
+    // dropped when all of its fields are null
+    apply_table_schema(table, m_schema);
+    apply_column_projection(table, m_projection);
 
-    return cudf::io::read_json(options.build());
+    return table;
 }
 
 template <bool EnableFilter>
-std::string concat_message_batch(std::vector<std::unique_ptr<RdKafka::Message>> const& message_batch)
+void concat_message_batch(std::vector<std::unique_ptr<RdKafka::Message>> const& message_batch,
+                          PinnedHostBuffer& buffer)
 {
-    std::ostringstream buffer;
+    buffer.clear();
+
+    // Reserve enough for every payload plus the line delimiter so we only grow the buffer once per batch
+    std::size_t total_bytes = 0;
+    for (const auto& msg : message_batch)
+    {
+        total_bytes += msg->len() + 1;
+    }
+
+    buffer.reserve(total_bytes);
 
-    for (auto& msg : message_batch)
+    for (const auto& msg : message_batch)
     {
-        auto s = static_cast<char*>(msg->payload());
+        const auto* payload = static_cast<const char*>(msg->payload());
+
+        // Payloads are not guaranteed to be NUL-terminated, always use the reported length
+        auto payload_len = msg->len();
+
+        // Producers which send C-strings will include the terminator in the payload, exclude it from the line
+        while (payload_len > 0 && payload[payload_len - 1] == '\0')
+        {
+            --payload_len;
+        }
 
         if constexpr (EnableFilter)
         {
-            if (!nlohmann::json::accept(s))
+            if (!nlohmann::json::accept(payload, payload + payload_len))
             {
-                LOG(ERROR) << "Failed to parse kafka message as json: " << s;
+                LOG(ERROR) << "Failed to parse kafka message as json: " << std::string_view(payload, payload_len);
                 continue;
             }
         }
 
-        buffer << s << "\n";
+        buffer.append(payload, payload_len);
+        buffer.push_back('\n');
+    }
+}
+
+cudf::io::table_with_metadata KafkaSourceStage::decode_table(
+    const std::vector<std::unique_ptr<RdKafka::Message>>& message_batch)
+{
+    // The decoder reads the payloads in place, they are owned by the messages until the batch is released
+    std::vector<std::string_view> payloads;
+    payloads.reserve(message_batch.size());
+    for (const auto& msg : message_batch)
+    {
+        payloads.emplace_back(static_cast<const char*>(msg->payload()), msg->len());
     }
 
-    return buffer.str();
+    auto table = m_decoder->decode(payloads);
+
+    apply_table_schema(table, m_schema);
+    apply_column_projection(table, m_projection);
+
+    return table;
 }
 
 std::shared_ptr<morpheus::MessageMeta> KafkaSourceStage::process_batch(
-    std::vector<std::unique_ptr<RdKafka::Message>>&& message_batch)
+    std::vector<std::unique_ptr<RdKafka::Message>>&& message_batch, PinnedHostBuffer& buffer)
 {
-    // concat the kafka json messages
-    auto json_lines = !this->m_disable_pre_filtering ? concat_message_batch<true>(message_batch)
-                                                     : concat_message_batch<false>(message_batch);
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "process_batch", message_batch.size());
+
+    // concat the kafka json messages. When filtering on the GPU, the validation occurs in `load_table`. Payloads in
+    // other formats are decoded in place
+    if (m_decoder == nullptr)
+    {
+        if (!this->m_disable_pre_filtering && !this->m_gpu_pre_filtering)
+        {
+            concat_message_batch<true>(message_batch, buffer);
+        }
+        else
+        {
+            concat_message_batch<false>(message_batch, buffer);
+        }
+    }
+
+    // Parse the payloads on the next device, the meta records it for the downstream stages
+    CudaDeviceGuard device_guard(m_devices.next());
 
-    // parse the json
-    auto data_table = this->load_table(json_lines);
+    auto arrival_time = std::chrono::system_clock::now();
+    auto start_time   = std::chrono::steady_clock::now();
+    auto data_table   = m_decoder != nullptr ? this->decode_table(message_batch) : this->load_table(buffer);
+    auto load_time    = std::chrono::steady_clock::now();
+
+    if (m_capture != nullptr)
+    {
+        m_capture->write(data_table.tbl->view(), data_table.metadata, arrival_time);
+    }
 
     // Next, create the message metadata. This gets reused for repeats
-    return MessageMeta::create_from_cpp(std::move(data_table), 0);
+    auto meta = MessageMeta::create_from_cpp(std::move(data_table), 0);
+
+    auto create_time = std::chrono::steady_clock::now();
+
+    m_load_table_seconds->increment(std::chrono::duration<double>(load_time - start_time).count());
+    m_create_meta_seconds->increment(std::chrono::duration<double>(create_time - load_time).count());
+
+    return meta;
 }
 
 // ************ KafkaStageInterfaceProxy ************ //
@@ -671,7 +1977,17 @@ std::shared_ptr<mrc::segment::Object<KafkaSourceStage>> KafkaSourceStageInterfac
     bool disable_pre_filtering,
     std::size_t stop_after,
     bool async_commits,
-    std::optional<pybind11::function> oauth_callback)
+    std::optional<pybind11::function> oauth_callback,
+    bool gpu_pre_filtering,
+    bool parallel_partitions,
+    uint32_t latency_target_ms,
+    bool commit_on_ack,
+    std::vector<int> device_ids,
+    std::vector<std::pair<std::string, std::string>> schema,
+    const std::vector<std::string>& projection,
+    const std::string& payload_format,
+    const std::string& placement,
+    const std::string& capture_path)
 {
     auto oauth_callback_cpp = KafkaSourceStageInterfaceProxy::make_kafka_oauth_callback(std::move(oauth_callback));
 
@@ -684,7 +2000,17 @@ std::shared_ptr<mrc::segment::Object<KafkaSourceStage>> KafkaSourceStageInterfac
                                                             disable_pre_filtering,
                                                             stop_after,
                                                             async_commits,
-                                                            std::move(oauth_callback_cpp));
+                                                            std::move(oauth_callback_cpp),
+                                                            gpu_pre_filtering,
+                                                            parallel_partitions,
+                                                            latency_target_ms,
+                                                            commit_on_ack,
+                                                            std::move(device_ids),
+                                                            TableSchema::from_type_names(schema),
+                                                            ColumnProjection(projection),
+                                                            payload_format,
+                                                            placement,
+                                                            capture_path);
 
     return stage;
 }
@@ -700,7 +2026,17 @@ std::shared_ptr<mrc::segment::Object<KafkaSourceStage>> KafkaSourceStageInterfac
     bool disable_pre_filtering,
     std::size_t stop_after,
     bool async_commits,
-    std::optional<pybind11::function> oauth_callback)
+    std::optional<pybind11::function> oauth_callback,
+    bool gpu_pre_filtering,
+    bool parallel_partitions,
+    uint32_t latency_target_ms,
+    bool commit_on_ack,
+    std::vector<int> device_ids,
+    std::vector<std::pair<std::string, std::string>> schema,
+    const std::vector<std::string>& projection,
+    const std::string& payload_format,
+    const std::string& placement,
+    const std::string& capture_path)
 {
     auto oauth_callback_cpp = KafkaSourceStageInterfaceProxy::make_kafka_oauth_callback(std::move(oauth_callback));
 
@@ -713,7 +2049,17 @@ std::shared_ptr<mrc::segment::Object<KafkaSourceStage>> KafkaSourceStageInterfac
                                                             disable_pre_filtering,
                                                             stop_after,
                                                             async_commits,
-                                                            std::move(oauth_callback_cpp));
+                                                            std::move(oauth_callback_cpp),
+                                                            gpu_pre_filtering,
+                                                            parallel_partitions,
+                                                            latency_target_ms,
+                                                            commit_on_ack,
+                                                            std::move(device_ids),
+                                                            TableSchema::from_type_names(schema),
+                                                            ColumnProjection(projection),
+                                                            payload_format,
+                                                            placement,
+                                                            capture_path);
 
     return stage;
 }
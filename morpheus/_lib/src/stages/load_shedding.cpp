@@ -0,0 +1,309 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/load_shedding.hpp"  // IWYU pragma: associated
+
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/stages/filter_rows.hpp"      // for filter_rows
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cudf/binaryop.hpp>                 // for binary_operation
+#include <cudf/column/column_factories.hpp>  // for make_column_from_scalar
+#include <cudf/filling.hpp>                  // for sequence
+#include <cudf/hashing.hpp>                  // for murmurhash3_x86_32
+#include <cudf/replace.hpp>                  // for replace_nulls
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>
+#include <cudf/unary.hpp>             // for unary_operation
+#include <cudf/utilities/traits.hpp>  // for is_integral
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>  // for clamp, find
+#include <cmath>      // for ldexp
+#include <exception>
+#include <iterator>  // for distance
+#include <stdexcept>
+#include <string>   // for stoll
+#include <utility>  // for move
+#include <vector>
+
+namespace morpheus {
+
+// ************ LoadSheddingSampler ************************************* //
+LoadSheddingSampler::LoadSheddingSampler(std::string priority_column,
+                                         std::map<std::string, double> min_rates,
+                                         const std::string& pressure_metric,
+                                         const metric_labels_t& pressure_labels,
+                                         bool from_histogram,
+                                         double low_watermark,
+                                         double high_watermark,
+                                         uint32_t seed) :
+  m_priority_column(std::move(priority_column)),
+  m_min_rates(std::move(min_rates)),
+  m_low_watermark(low_watermark),
+  m_high_watermark(high_watermark),
+  m_seed(seed)
+{
+    if (m_min_rates.empty())
+    {
+        throw std::invalid_argument("At least one low priority class is required to shed load");
+    }
+
+    for (const auto& [priority, rate] : m_min_rates)
+    {
+        if (rate < 0.0 || rate > 1.0)
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("The minimum sampling rate of the class '"
+                                                            << priority << "' must be between 0 and 1, got " << rate));
+        }
+    }
+
+    if (m_high_watermark <= m_low_watermark)
+    {
+        throw std::invalid_argument("The high watermark must be greater than the low watermark");
+    }
+
+    // The metric is created if its owner has not registered it yet, and shared once it does
+    auto& registry = MetricsRegistry::get_instance();
+    if (from_histogram)
+    {
+        m_histogram = registry.get_histogram(pressure_metric, "Read by a load shedding stage", pressure_labels);
+        m_last_sum   = m_histogram->sum();
+        m_last_count = m_histogram->count();
+    }
+    else
+    {
+        m_gauge = registry.get_gauge(pressure_metric, "Read by a load shedding stage", pressure_labels);
+    }
+}
+
+double LoadSheddingSampler::read_pressure()
+{
+    double value = 0;
+    if (m_gauge != nullptr)
+    {
+        value = m_gauge->value();
+    }
+    else
+    {
+        const auto sum   = m_histogram->sum();
+        const auto count = m_histogram->count();
+
+        // Without new observations the pressure is left as it was
+        if (count == m_last_count)
+        {
+            return m_last_pressure;
+        }
+
+        value        = (sum - m_last_sum) / static_cast<double>(count - m_last_count);
+        m_last_sum   = sum;
+        m_last_count = count;
+    }
+
+    m_last_pressure = std::clamp((value - m_low_watermark) / (m_high_watermark - m_low_watermark), 0.0, 1.0);
+
+    return m_last_pressure;
+}
+
+std::map<std::string, double> LoadSheddingSampler::sampling_rates(double pressure) const
+{
+    std::map<std::string, double> rates;
+    for (const auto& [priority, min_rate] : m_min_rates)
+    {
+        rates[priority] = 1.0 - pressure * (1.0 - min_rate);
+    }
+
+    return rates;
+}
+
+std::unique_ptr<cudf::column> LoadSheddingSampler::keep_mask(const TableInfo& table,
+                                                             const std::map<std::string, double>& rates)
+{
+    const auto column_names = table.get_column_names();
+    auto found              = std::find(column_names.begin(), column_names.end(), m_priority_column);
+    if (found == column_names.end())
+    {
+        throw std::invalid_argument(
+            MORPHEUS_CONCAT_STR("Unable to find the priority column '" << m_priority_column << "'"));
+    }
+
+    const auto priorities = table.get_column(std::distance(column_names.begin(), found));
+    const bool is_string  = priorities.type().id() == cudf::type_id::STRING;
+    if (!is_string && !cudf::is_integral(priorities.type()))
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+            "The priority column '" << m_priority_column << "' must be a string or an integer column"));
+    }
+
+    const auto num_rows = table.num_rows();
+    const auto bool8    = cudf::data_type{cudf::type_id::BOOL8};
+
+    // Uniformly distributed 32-bit draws, one per row
+    auto row_numbers = cudf::sequence(num_rows,
+                                      cudf::numeric_scalar<int64_t>(static_cast<int64_t>(m_rows_sampled)),
+                                      cudf::numeric_scalar<int64_t>(1));
+    auto draws       = cudf::hashing::murmurhash3_x86_32(cudf::table_view{{row_numbers->view()}}, m_seed);
+    m_rows_sampled += num_rows;
+
+    std::unique_ptr<cudf::column> dropped;
+    for (const auto& [priority, rate] : rates)
+    {
+        if (rate >= 1.0)
+        {
+            continue;
+        }
+
+        std::unique_ptr<cudf::column> in_class;
+        if (is_string)
+        {
+            in_class = cudf::binary_operation(
+                priorities, cudf::string_scalar(priority), cudf::binary_operator::EQUAL, bool8);
+        }
+        else
+        {
+            int64_t priority_value = 0;
+            try
+            {
+                priority_value = std::stoll(priority);
+            } catch (const std::exception&)
+            {
+                throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+                    "The class '" << priority << "' of the integer priority column is not an integer"));
+            }
+
+            in_class = cudf::binary_operation(
+                priorities, cudf::numeric_scalar<int64_t>(priority_value), cudf::binary_operator::EQUAL, bool8);
+        }
+
+        // A row is sampled out when its draw falls outside of the first `rate` fraction of the 32-bit range
+        const auto threshold = static_cast<int64_t>(std::ldexp(rate, 32));
+        auto sampled_out     = cudf::binary_operation(
+            draws->view(), cudf::numeric_scalar<int64_t>(threshold), cudf::binary_operator::GREATER_EQUAL, bool8);
+        auto dropped_in_class = cudf::binary_operation(
+            in_class->view(), sampled_out->view(), cudf::binary_operator::LOGICAL_AND, bool8);
+
+        dropped = dropped == nullptr ? std::move(dropped_in_class)
+                                     : cudf::binary_operation(dropped->view(),
+                                                              dropped_in_class->view(),
+                                                              cudf::binary_operator::LOGICAL_OR,
+                                                              bool8);
+    }
+
+    if (dropped == nullptr)
+    {
+        return cudf::make_column_from_scalar(cudf::numeric_scalar<bool>(true), num_rows);
+    }
+
+    // Rows with a null priority always pass through
+    if (dropped->has_nulls())
+    {
+        dropped = cudf::replace_nulls(dropped->view(), cudf::numeric_scalar<bool>(false));
+    }
+
+    return cudf::unary_operation(dropped->view(), cudf::unary_operator::NOT);
+}
+
+// Component public implementations
+// ************ LoadSheddingStage ******************************* //
+LoadSheddingStage::LoadSheddingStage(LoadSheddingSampler sampler, const std::string& metrics_name) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_sampler(std::move(sampler))
+{
+    const metric_labels_t labels{{"stage", metrics_name}};
+    auto& registry = MetricsRegistry::get_instance();
+
+    m_pressure = registry.get_gauge(
+        "morpheus_load_shedding_pressure", "Pressure read by the load shedding stage, between 0 and 1", labels);
+    m_dropped_rows = registry.get_counter(
+        "morpheus_load_shedding_dropped_rows_total", "Rows sampled out by the load shedding stage", labels);
+}
+
+LoadSheddingStage::subscribe_fn_t LoadSheddingStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                const auto pressure = m_sampler.read_pressure();
+                const auto rates    = m_sampler.sampling_rates(pressure);
+                m_pressure->set(pressure);
+
+                auto payload        = x->payload();
+                const auto num_rows = payload->count();
+
+                // Without pressure every row is kept, and the payload left untouched
+                std::shared_ptr<MessageMeta> sampled = payload;
+                if (pressure > 0)
+                {
+                    auto keep = m_sampler.keep_mask(payload->get_info(), rates);
+                    sampled   = filter_rows(payload, keep->view());
+                }
+
+                const auto num_kept = sampled == nullptr ? 0 : sampled->count();
+                m_dropped_rows->increment(static_cast<double>(num_rows - num_kept));
+
+                MORPHEUS_TRACE("load_shedding.sample", num_rows, num_kept);
+
+                if (sampled == nullptr)
+                {
+                    DVLOG(10) << "Load shedding dropped every row of a message. Rows: " << num_rows;
+                    return;
+                }
+
+                x->payload(sampled);
+                x->set_metadata("sampling_rates", nlohmann::json(rates));
+
+                output.on_next(std::move(x));
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&output]() {
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ LoadSheddingStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<LoadSheddingStage>> LoadSheddingStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string priority_column,
+    std::map<std::string, double> min_rates,
+    const std::string& pressure_metric,
+    const metric_labels_t& pressure_labels,
+    bool from_histogram,
+    double low_watermark,
+    double high_watermark,
+    uint32_t seed)
+{
+    LoadSheddingSampler sampler(std::move(priority_column),
+                                std::move(min_rates),
+                                pressure_metric,
+                                pressure_labels,
+                                from_histogram,
+                                low_watermark,
+                                high_watermark,
+                                seed);
+
+    return builder.construct_object<LoadSheddingStage>(name, std::move(sampler), name);
+}
+
+}  // namespace morpheus
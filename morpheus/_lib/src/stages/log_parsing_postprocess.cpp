@@ -0,0 +1,412 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/log_parsing_postprocess.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/dtype.hpp"           // for DType
+#include "morpheus/objects/tensor_object.hpp"   // for TensorObject
+#include "morpheus/types.hpp"                   // for TensorIndex
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cudf/aggregation.hpp>
+#include <cudf/binaryop.hpp>                 // for binary_operation, binary_operator
+#include <cudf/column/column_factories.hpp>  // for make_column_from_scalar, make_empty_column
+#include <cudf/copying.hpp>                  // for copy_if_else, gather, scatter
+#include <cudf/filling.hpp>                  // for sequence
+#include <cudf/groupby.hpp>
+#include <cudf/io/types.hpp>                 // for table_with_metadata
+#include <cudf/lists/lists_column_view.hpp>  // for lists_column_view
+#include <cudf/replace.hpp>                  // for replace_nulls
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/search.hpp>             // for lower_bound
+#include <cudf/sorting.hpp>            // for stable_sort_by_key
+#include <cudf/stream_compaction.hpp>  // for apply_boolean_mask, unique
+#include <cudf/strings/combine.hpp>    // for concatenate, join_list_elements
+#include <cudf/strings/find.hpp>       // for starts_with
+#include <cudf/strings/regex/regex_program.hpp>
+#include <cudf/strings/replace_re.hpp>   // for replace_re
+#include <cudf/strings/split/split.hpp>  // for split_record
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>
+#include <cudf/unary.hpp>  // for is_valid
+#include <glog/logging.h>
+
+#include <cstddef>  // for size_t
+#include <exception>
+#include <fstream>    // for ifstream
+#include <ostream>    // needed for glog
+#include <sstream>    // for istringstream
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move, pair
+#include <vector>
+
+namespace morpheus {
+namespace {
+using column_ptr = std::unique_ptr<cudf::column>;
+
+// Spacing removed around the punctuation of the decoded entities, in order, as the python stage does
+const std::vector<std::pair<std::string, std::string>> CleanupReplacements{{R"(\s+##)", ""},
+                                                                           {R"(\s+\.+\s)", "."},
+                                                                           {R"(\s+:+\s)", ":"},
+                                                                           {R"(\s+\|+\s)", "|"},
+                                                                           {R"(\s+\++\s)", "+"},
+                                                                           {R"(\s+-+\s)", "-"},
+                                                                           {R"(\s+<)", "<"},
+                                                                           {R"(<+\s)", "<"},
+                                                                           {R"(\s+>)", ">"},
+                                                                           {R"(>+\s)", ">"},
+                                                                           {R"(\s+=+\s)", "="},
+                                                                           {R"(\s+#+\s)", "#"},
+                                                                           {R"(\[+\s)", "["},
+                                                                           {R"(\s\])", "]"},
+                                                                           {R"(\(+\s)", "("},
+                                                                           {R"(\s\))", ")"},
+                                                                           {R"(\s")", "\""},
+                                                                           {R"("+\s)", "\""},
+                                                                           {R"(\\+\s)", "\""},
+                                                                           {R"(\s+_+\s)", "_"},
+                                                                           {R"(\s+/)", "/"},
+                                                                           {R"(/+\s)", "/"},
+                                                                           {R"(\s+\?+\s)", "?"},
+                                                                           {R"(\s+;+\s)", "; "}};
+
+const auto Int32Type = cudf::data_type{cudf::type_id::INT32};
+
+/**
+ * @brief The 2D row major tensor `name` of `message` as int32, viewed as a single column holding its rows one after
+ * the other, rows being `pitch` elements apart.
+ */
+struct FlatTensor
+{
+    TensorObject tensor;
+    cudf::column_view values;
+    TensorIndex rows;
+    TensorIndex cols;
+    TensorIndex pitch;
+};
+
+FlatTensor flatten_tensor(const MultiResponseMessage& message, const std::string& name)
+{
+    auto tensor = message.get_tensor(name);
+    if (tensor.rank() != 2 || tensor.stride(1) != 1)
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Tensor '" << name << "' must be a 2D row major tensor"));
+    }
+
+    tensor = tensor.as_type(DType::create<int32_t>());
+
+    const auto rows  = tensor.shape(0);
+    const auto cols  = tensor.shape(1);
+    const auto pitch = tensor.stride(0);
+    const auto size  = rows == 0 ? 0 : (rows - 1) * pitch + cols;
+
+    cudf::column_view values{Int32Type, static_cast<cudf::size_type>(size), tensor.data(), nullptr, 0};
+
+    return {std::move(tensor), values, rows, cols, pitch};
+}
+
+// `op` applied to `lhs` and the scalar `rhs`
+column_ptr apply(const cudf::column_view& lhs, int32_t rhs, cudf::binary_operator op, cudf::data_type type = Int32Type)
+{
+    return cudf::binary_operation(lhs, cudf::numeric_scalar<int32_t>(rhs), op, type);
+}
+
+column_ptr apply(const cudf::column_view& lhs,
+                 const cudf::column_view& rhs,
+                 cudf::binary_operator op,
+                 cudf::data_type type = Int32Type)
+{
+    return cudf::binary_operation(lhs, rhs, op, type);
+}
+
+// Column `col` of the flattened tensor, one value per row
+column_ptr tensor_column(const FlatTensor& tensor, TensorIndex col)
+{
+    auto indices = cudf::sequence(static_cast<cudf::size_type>(tensor.rows),
+                                  cudf::numeric_scalar<int32_t>(static_cast<int32_t>(col)),
+                                  cudf::numeric_scalar<int32_t>(static_cast<int32_t>(tensor.pitch)));
+
+    return std::move(cudf::gather(cudf::table_view{{tensor.values}}, indices->view())->release()[0]);
+}
+
+// Strings column of `values`, by splitting them once joined as a single string
+column_ptr make_strings_column(const std::vector<std::string>& values)
+{
+    if (values.empty())
+    {
+        return cudf::make_empty_column(cudf::type_id::STRING);
+    }
+
+    std::string joined = values.front();
+    for (std::size_t i = 1; i < values.size(); ++i)
+    {
+        joined.append("\n").append(values[i]);
+    }
+
+    auto row   = cudf::make_column_from_scalar(cudf::string_scalar(joined), 1);
+    auto lists = cudf::strings::split_record(cudf::strings_column_view{row->view()}, cudf::string_scalar("\n"));
+
+    return std::make_unique<cudf::column>(cudf::lists_column_view{lists->view()}.child());
+}
+
+// A strings column of `num_rows` nulls
+column_ptr make_null_strings(cudf::size_type num_rows)
+{
+    return cudf::make_column_from_scalar(cudf::string_scalar("", false), num_rows);
+}
+}  // namespace
+
+std::unique_ptr<cudf::column> load_log_parsing_vocab(const std::string& vocab_path)
+{
+    std::ifstream file(vocab_path);
+    if (!file.is_open())
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to open vocabulary file: " << vocab_path));
+    }
+
+    std::vector<std::string> tokens;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream words(line);
+        std::string token;
+        words >> token;
+
+        // WordPiece tokens never hold a line break, which the device copy relies on
+        tokens.push_back(std::move(token));
+    }
+
+    return make_strings_column(tokens);
+}
+
+std::shared_ptr<MessageMeta> decode_log_entities(const MultiResponseMessage& message,
+                                                 const cudf::column_view& vocab,
+                                                 const std::map<int32_t, std::string>& id2label)
+{
+    const auto labels    = flatten_tensor(message, "labels");
+    const auto input_ids = flatten_tensor(message, "input_ids");
+    const auto seq_ids   = flatten_tensor(message, "seq_ids");
+
+    if (labels.rows != input_ids.rows || labels.cols != input_ids.cols || labels.pitch != input_ids.pitch ||
+        seq_ids.rows != labels.rows || seq_ids.cols < 3)
+    {
+        throw std::invalid_argument("The labels, input_ids and seq_ids tensors must have matching shapes");
+    }
+
+    // Every element of the rows, of which only the tokens within the range of their row are kept
+    const auto num_elements = static_cast<cudf::size_type>(labels.rows * labels.cols);
+
+    auto elements = cudf::sequence(num_elements, cudf::numeric_scalar<int32_t>(0));
+    auto rows     = apply(elements->view(), static_cast<int32_t>(labels.cols), cudf::binary_operator::DIV);
+    auto cols     = apply(elements->view(), static_cast<int32_t>(labels.cols), cudf::binary_operator::MOD);
+
+    auto row_seq_ids = cudf::gather(
+        cudf::table_view{
+            {tensor_column(seq_ids, 0)->view(), tensor_column(seq_ids, 1)->view(), tensor_column(seq_ids, 2)->view()}},
+        rows->view());
+
+    auto after_start = apply(cols->view(),
+                             row_seq_ids->get_column(1).view(),
+                             cudf::binary_operator::GREATER_EQUAL,
+                             cudf::data_type{cudf::type_id::BOOL8});
+    auto before_stop = apply(cols->view(),
+                             row_seq_ids->get_column(2).view(),
+                             cudf::binary_operator::LESS,
+                             cudf::data_type{cudf::type_id::BOOL8});
+    auto is_token    = apply(after_start->view(),
+                          before_stop->view(),
+                          cudf::binary_operator::LOGICAL_AND,
+                          cudf::data_type{cudf::type_id::BOOL8});
+
+    auto offsets = apply(apply(rows->view(), static_cast<int32_t>(labels.pitch), cudf::binary_operator::MUL)->view(),
+                         cols->view(),
+                         cudf::binary_operator::ADD);
+
+    auto tokens = cudf::apply_boolean_mask(
+        cudf::table_view{{row_seq_ids->get_column(0).view(), offsets->view()}}, is_token->view());
+
+    // The tokens of each log in order, as the rows of a log follow each other
+    auto by_log = cudf::stable_sort_by_key(tokens->view(), cudf::table_view{{tokens->get_column(0).view()}});
+
+    const auto docs        = by_log->get_column(0).view();
+    const auto positions   = by_log->get_column(1).view();
+    auto token_labels      = cudf::gather(cudf::table_view{{labels.values}}, positions);
+    auto token_ids         = cudf::gather(cudf::table_view{{input_ids.values}}, positions);
+    auto text              = cudf::gather(cudf::table_view{{vocab}},
+                             token_ids->get_column(0).view(),
+                             cudf::out_of_bounds_policy::NULLIFY);
+    const auto label_view  = token_labels->get_column(0).view();
+    const auto text_view   = text->get_column(0).view();
+
+    // WordPiece continuations take the label of the last token of the log which is not a continuation
+    auto is_continuation = apply(
+        cudf::strings::starts_with(cudf::strings_column_view{text_view}, cudf::string_scalar("##"))->view(),
+        cudf::strings::starts_with(cudf::strings_column_view{text_view}, cudf::string_scalar("."))->view(),
+        cudf::binary_operator::NULL_LOGICAL_OR,
+        cudf::data_type{cudf::type_id::BOOL8});
+
+    const std::vector<cudf::replace_policy> fill_policies{cudf::replace_policy::PRECEDING};
+
+    auto null_label  = cudf::numeric_scalar<int32_t>(0, false);
+    auto word_labels = cudf::copy_if_else(null_label, label_view, is_continuation->view());
+    auto filled      = cudf::groupby::groupby(cudf::table_view{{docs}}, cudf::null_policy::EXCLUDE, cudf::sorted::YES)
+                      .replace_nulls(cudf::table_view{{word_labels->view()}}, fill_policies);
+
+    // Logs starting with a continuation keep its own label
+    auto entity_labels = cudf::replace_nulls(filled.second->get_column(0).view(), label_view);
+
+    // The tokens of each log and label joined in order
+    auto by_entity = cudf::stable_sort_by_key(cudf::table_view{{docs, entity_labels->view(), text_view}},
+                                              cudf::table_view{{docs, entity_labels->view()}});
+
+    std::vector<cudf::groupby::aggregation_request> requests(1);
+    requests[0].values = by_entity->get_column(2).view();
+    requests[0].aggregations.push_back(cudf::make_collect_list_aggregation<cudf::groupby_aggregation>());
+
+    auto entity_grouper = cudf::groupby::groupby(
+        cudf::table_view{{by_entity->get_column(0).view(), by_entity->get_column(1).view()}},
+        cudf::null_policy::EXCLUDE,
+        cudf::sorted::YES);
+    auto [entity_keys, entity_results] = entity_grouper.aggregate(requests);
+
+    auto entities = cudf::strings::join_list_elements(cudf::lists_column_view{entity_results[0].results[0]->view()},
+                                                      cudf::string_scalar(" "));
+
+    // Row of the log of each entity
+    auto unique_docs = cudf::unique(cudf::table_view{{docs}}, {0}, cudf::duplicate_keep_option::KEEP_FIRST);
+    const auto num_docs = unique_docs->num_rows();
+
+    auto entity_rows = cudf::lower_bound(unique_docs->view(),
+                                         cudf::table_view{{entity_keys->get_column(0).view()}},
+                                         {cudf::order::ASCENDING},
+                                         {cudf::null_order::AFTER});
+
+    // The entities of a label, as one row per log
+    auto label_entities = [&](int32_t label) {
+        auto is_label = apply(entity_keys->get_column(1).view(),
+                              label,
+                              cudf::binary_operator::EQUAL,
+                              cudf::data_type{cudf::type_id::BOOL8});
+        auto found    = cudf::apply_boolean_mask(cudf::table_view{{entities->view(), entity_rows->view()}},
+                                              is_label->view());
+        auto target   = make_null_strings(num_docs);
+
+        auto scattered = cudf::scatter(cudf::table_view{{found->get_column(0).view()}},
+                                       found->get_column(1).view(),
+                                       cudf::table_view{{target->view()}});
+
+        return std::move(scattered->release()[0]);
+    };
+
+    std::map<std::string, int32_t> label_ids;
+    for (const auto& [id, label] : id2label)
+    {
+        label_ids.emplace(label, id);
+    }
+
+    std::vector<column_ptr> columns;
+    cudf::io::table_metadata metadata;
+
+    for (const auto& [id, label] : id2label)
+    {
+        if (label.rfind("B-", 0) != 0)
+        {
+            continue;
+        }
+
+        const auto name = label.substr(2);
+        auto column     = label_entities(id);
+
+        // Like the python stage, only the labels found in the batch get a column
+        if (column->null_count() == num_docs)
+        {
+            continue;
+        }
+
+        auto inside        = label_ids.find("I-" + name);
+        auto inside_column = inside != label_ids.end() ? label_entities(inside->second) : column_ptr{};
+        if (inside_column != nullptr && inside_column->null_count() < num_docs)
+        {
+            // The inside tokens follow the beginning tokens, the logs without beginning tokens having no entity
+            auto joined = cudf::strings::concatenate(cudf::table_view{{column->view(), inside_column->view()}},
+                                                     cudf::string_scalar(" "),
+                                                     cudf::string_scalar(""),
+                                                     cudf::strings::separator_on_nulls::YES);
+
+            auto null_string = cudf::string_scalar("", false);
+            auto is_valid    = cudf::is_valid(column->view());
+            column           = cudf::copy_if_else(joined->view(), null_string, is_valid->view());
+        }
+
+        for (const auto& [pattern, replacement] : CleanupReplacements)
+        {
+            auto program = cudf::strings::regex_program::create(pattern);
+            column       = cudf::strings::replace_re(
+                cudf::strings_column_view{column->view()}, *program, cudf::string_scalar(replacement));
+        }
+
+        columns.push_back(std::move(column));
+        metadata.schema_info.emplace_back(name);
+    }
+
+    return MessageMeta::create_from_cpp(
+        cudf::io::table_with_metadata{std::make_unique<cudf::table>(std::move(columns)), std::move(metadata)}, 0);
+}
+
+// ************ LogParsingPostprocessStage **************************** //
+LogParsingPostprocessStage::LogParsingPostprocessStage(const std::string& vocab_path,
+                                                       std::map<int32_t, std::string> id2label) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_vocab(load_log_parsing_vocab(vocab_path)),
+  m_id2label(std::move(id2label))
+{}
+
+LogParsingPostprocessStage::subscribe_fn_t LogParsingPostprocessStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                auto entities = decode_log_entities(*x, m_vocab->view(), m_id2label);
+
+                MORPHEUS_TRACE("log_parsing_postprocess.decode", x->count, entities->count());
+                DVLOG(10) << "Log parsing postprocess complete. Input: " << x->count
+                          << " rows. Output: " << entities->count() << " logs";
+
+                output.on_next(std::move(entities));
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&output]() {
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ LogParsingPostprocessStageInterfaceProxy **************** //
+std::shared_ptr<mrc::segment::Object<LogParsingPostprocessStage>> LogParsingPostprocessStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    const std::string& vocab_path,
+    std::map<int32_t, std::string> id2label)
+{
+    return builder.construct_object<LogParsingPostprocessStage>(name, vocab_path, std::move(id2label));
+}
+}  // namespace morpheus
@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/monitor.hpp"  // IWYU pragma: associated
+
+#include "morpheus/types.hpp"                // for TensorIndex
+#include "morpheus/utilities/nvtx_util.hpp"  // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+
+#include <glog/logging.h>
+
+#include <exception>
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move
+
+namespace morpheus {
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "MonitorStage");
+
+TensorIndex get_row_count(const std::shared_ptr<MessageMeta>& message)
+{
+    return message->count();
+}
+
+TensorIndex get_row_count(const std::shared_ptr<MultiMessage>& message)
+{
+    return message->mess_count;
+}
+
+TensorIndex get_row_count(const std::shared_ptr<ControlMessage>& message)
+{
+    auto payload = message->payload();
+    return payload ? payload->count() : 0;
+}
+
+double get_rate(uint64_t count, std::chrono::steady_clock::duration elapsed)
+{
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? static_cast<double>(count) / seconds : 0.0;
+}
+}  // namespace
+
+// Component public implementations
+// ************ MonitorStage **************************** //
+template <typename MessageT>
+MonitorStage<MessageT>::MonitorStage(std::string description, std::size_t report_interval_ms, bool log_progress) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_description(std::move(description)),
+  m_report_interval(report_interval_ms),
+  m_log_progress(log_progress)
+{
+    if (report_interval_ms == 0)
+    {
+        throw std::invalid_argument("report_interval_ms must be greater than 0");
+    }
+
+    auto& registry = MetricsRegistry::get_instance();
+    metric_labels_t labels{{"description", m_description}};
+
+    m_messages_total = registry.get_counter(
+        "morpheus_monitor_messages_total", "Number of messages which went through the monitor", labels);
+    m_rows_total =
+        registry.get_counter("morpheus_monitor_rows_total", "Number of rows which went through the monitor", labels);
+    m_messages_per_second = registry.get_gauge(
+        "morpheus_monitor_messages_per_second", "Messages per second over the last reporting interval", labels);
+    m_rows_per_second = registry.get_gauge(
+        "morpheus_monitor_rows_per_second", "Rows per second over the last reporting interval", labels);
+}
+
+template <typename MessageT>
+MonitorStage<MessageT>::~MonitorStage()
+{
+    stop_reporter();
+}
+
+template <typename MessageT>
+typename MonitorStage<MessageT>::subscribe_fn_t MonitorStage<MessageT>::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        start_reporter();
+
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                const auto row_count = get_row_count(x);
+                MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", row_count);
+
+                m_message_count.increment();
+                m_row_count.increment(row_count);
+
+                output.on_next(std::move(x));
+            },
+            [this, &output](std::exception_ptr error_ptr) {
+                stop_reporter();
+                output.on_error(error_ptr);
+            },
+            [this, &output]() {
+                stop_reporter();
+                output.on_completed();
+            }));
+    };
+}
+
+template <typename MessageT>
+void MonitorStage<MessageT>::start_reporter()
+{
+    std::lock_guard<std::mutex> lock(m_reporter_mutex);
+    if (m_reporter.joinable())
+    {
+        return;
+    }
+
+    m_start_time       = std::chrono::steady_clock::now();
+    m_last_report_time = m_start_time;
+    m_stop_reporter    = false;
+
+    m_reporter = std::thread([this]() {
+        std::unique_lock<std::mutex> lock(m_reporter_mutex);
+        while (!m_reporter_cv.wait_for(lock, m_report_interval, [this]() {
+            return m_stop_reporter;
+        }))
+        {
+            lock.unlock();
+            report(false);
+            lock.lock();
+        }
+    });
+}
+
+template <typename MessageT>
+void MonitorStage<MessageT>::stop_reporter()
+{
+    std::thread reporter;
+    {
+        std::lock_guard<std::mutex> lock(m_reporter_mutex);
+        if (!m_reporter.joinable())
+        {
+            return;
+        }
+
+        m_stop_reporter = true;
+        reporter        = std::move(m_reporter);
+    }
+
+    m_reporter_cv.notify_all();
+    reporter.join();
+
+    report(true);
+}
+
+template <typename MessageT>
+void MonitorStage<MessageT>::report(bool is_final)
+{
+    const auto now      = std::chrono::steady_clock::now();
+    const auto messages = m_message_count.load();
+    const auto rows     = m_row_count.load();
+
+    const auto new_messages = messages - m_reported_messages;
+    const auto new_rows     = rows - m_reported_rows;
+
+    m_messages_total->increment(static_cast<double>(new_messages));
+    m_rows_total->increment(static_cast<double>(new_rows));
+    m_messages_per_second->set(get_rate(new_messages, now - m_last_report_time));
+    m_rows_per_second->set(get_rate(new_rows, now - m_last_report_time));
+
+    if (m_log_progress)
+    {
+        if (is_final)
+        {
+            LOG(INFO) << m_description << "[Complete]: " << messages << " messages, " << rows << " rows in "
+                      << std::chrono::duration<double>(now - m_start_time).count()
+                      << "s, Rate: " << get_rate(rows, now - m_start_time) << " rows/s";
+        }
+        else
+        {
+            LOG(INFO) << m_description << ": " << messages << " messages, " << rows
+                      << " rows, Rate: " << get_rate(new_rows, now - m_last_report_time) << " rows/s";
+        }
+    }
+
+    m_reported_messages = messages;
+    m_reported_rows     = rows;
+    m_last_report_time  = now;
+}
+
+template class MonitorStage<MessageMeta>;
+template class MonitorStage<MultiMessage>;
+template class MonitorStage<ControlMessage>;
+
+// ************ MonitorStageInterfaceProxy ************* //
+template <typename MessageT>
+std::shared_ptr<mrc::segment::Object<MonitorStage<MessageT>>> MonitorStageInterfaceProxy<MessageT>::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string description,
+    std::size_t report_interval_ms,
+    bool log_progress)
+{
+    return builder.construct_object<MonitorStage<MessageT>>(
+        name, std::move(description), report_interval_ms, log_progress);
+}
+
+template struct MonitorStageInterfaceProxy<MessageMeta>;
+template struct MonitorStageInterfaceProxy<MultiMessage>;
+template struct MonitorStageInterfaceProxy<ControlMessage>;
+}  // namespace morpheus
@@ -0,0 +1,561 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/stages/multi_endpoint_triton_client.hpp"
+
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>  // for max, nth_element
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Weight of the latest request in the moving averages of each endpoint
+constexpr double EwmaAlpha = 0.1;
+
+}  // namespace
+
+namespace morpheus {
+
+// A request along with everything needed to send it again, shared by each of its attempts
+struct MultiEndpointTritonClient::Request
+{
+    Request(triton::client::InferenceServerHttpClient::OnCompleteFn callback,
+            const triton::client::InferOptions& options,
+            const std::vector<TritonInferInput>& inputs,
+            const std::vector<TritonInferRequestedOutput>& outputs,
+            std::size_t num_endpoints) :
+      callback(std::move(callback)),
+      options(options),
+      inputs(inputs),
+      outputs(outputs),
+      tried(num_endpoints, false)
+    {}
+
+    triton::client::InferenceServerHttpClient::OnCompleteFn callback;
+    triton::client::InferOptions options;
+
+    // Copies hold the staging buffers of the inputs until every attempt has completed
+    std::vector<TritonInferInput> inputs;
+    std::vector<TritonInferRequestedOutput> outputs;
+
+    std::mutex mutex;
+    std::vector<bool> tried;
+    std::size_t num_in_flight{0};
+    bool completed{false};
+    bool hedged{false};
+};
+
+MultiEndpointTritonClient::MultiEndpointTritonClient(std::vector<std::unique_ptr<ITritonClient>>&& endpoints,
+                                                     bool hedge_requests,
+                                                     std::size_t failure_threshold,
+                                                     std::chrono::milliseconds ejection_time) :
+  m_hedge_requests(hedge_requests),
+  m_failure_threshold(std::max<std::size_t>(failure_threshold, 1)),
+  m_ejection_time(ejection_time)
+{
+    if (endpoints.empty())
+    {
+        throw std::invalid_argument("MultiEndpointTritonClient requires at least one endpoint");
+    }
+
+    m_endpoints.resize(endpoints.size());
+    for (std::size_t i = 0; i < endpoints.size(); ++i)
+    {
+        m_endpoints[i].client = std::move(endpoints[i]);
+    }
+
+    if (m_hedge_requests && m_endpoints.size() > 1)
+    {
+        m_hedge_thread = std::thread(&MultiEndpointTritonClient::hedge_loop, this);
+    }
+}
+
+MultiEndpointTritonClient::~MultiEndpointTritonClient()
+{
+    {
+        std::lock_guard lock(m_hedge_mutex);
+        m_stopping = true;
+    }
+
+    m_hedge_cv.notify_all();
+
+    if (m_hedge_thread.joinable())
+    {
+        m_hedge_thread.join();
+    }
+
+    // Responses of hedged requests which lost the race may still arrive while the clients are being destroyed, they
+    // are dropped rather than failed over
+    for (auto& endpoint : m_endpoints)
+    {
+        endpoint.client.reset();
+    }
+}
+
+triton::client::Error MultiEndpointTritonClient::is_server_live(bool* live)
+{
+    triton::client::Error status("No endpoint is live");
+    for (auto& endpoint : m_endpoints)
+    {
+        status = endpoint.client->is_server_live(live);
+        if (status.IsOk() && *live)
+        {
+            break;
+        }
+    }
+
+    return status;
+}
+
+triton::client::Error MultiEndpointTritonClient::is_server_ready(bool* ready)
+{
+    triton::client::Error status("No endpoint is ready");
+    for (auto& endpoint : m_endpoints)
+    {
+        status = endpoint.client->is_server_ready(ready);
+        if (status.IsOk() && *ready)
+        {
+            break;
+        }
+    }
+
+    return status;
+}
+
+triton::client::Error MultiEndpointTritonClient::is_model_ready(bool* ready, std::string& model_name)
+{
+    triton::client::Error status("No endpoint has the model ready");
+    for (auto& endpoint : m_endpoints)
+    {
+        status = endpoint.client->is_model_ready(ready, model_name);
+        if (status.IsOk() && *ready)
+        {
+            break;
+        }
+    }
+
+    return status;
+}
+
+triton::client::Error MultiEndpointTritonClient::model_metadata(std::string* model_metadata, std::string& model_name)
+{
+    std::vector<bool> tried(m_endpoints.size(), false);
+    triton::client::Error status("No endpoint returned the model metadata");
+
+    while (auto index = select_endpoint(tried, true))
+    {
+        tried[*index] = true;
+        status        = m_endpoints[*index].client->model_metadata(model_metadata, model_name);
+        if (status.IsOk())
+        {
+            break;
+        }
+    }
+
+    return status;
+}
+
+triton::client::Error MultiEndpointTritonClient::model_config(std::string* model_config, std::string& model_name)
+{
+    std::vector<bool> tried(m_endpoints.size(), false);
+    triton::client::Error status("No endpoint returned the model config");
+
+    while (auto index = select_endpoint(tried, true))
+    {
+        tried[*index] = true;
+        status        = m_endpoints[*index].client->model_config(model_config, model_name);
+        if (status.IsOk())
+        {
+            break;
+        }
+    }
+
+    return status;
+}
+
+triton::client::Error MultiEndpointTritonClient::model_inference_statistics(std::string* statistics,
+                                                                         std::string& model_name)
+{
+    triton::client::Error status("No endpoint returned the inference statistics");
+    auto model_stats = nlohmann::json::array();
+
+    for (auto& endpoint : m_endpoints)
+    {
+        std::string endpoint_statistics;
+        auto endpoint_status = endpoint.client->model_inference_statistics(&endpoint_statistics, model_name);
+        if (!endpoint_status.IsOk())
+        {
+            continue;
+        }
+
+        for (auto& model : nlohmann::json::parse(endpoint_statistics).value("model_stats", nlohmann::json::array()))
+        {
+            model_stats.push_back(std::move(model));
+        }
+
+        status = triton::client::Error::Success;
+    }
+
+    if (status.IsOk())
+    {
+        *statistics = nlohmann::json{{"model_stats", std::move(model_stats)}}.dump();
+    }
+
+    return status;
+}
+
+triton::client::Error MultiEndpointTritonClient::async_infer(
+    triton::client::InferenceServerHttpClient::OnCompleteFn callback,
+    const triton::client::InferOptions& options,
+    const std::vector<TritonInferInput>& inputs,
+    const std::vector<TritonInferRequestedOutput>& outputs)
+{
+    auto request = std::make_shared<Request>(std::move(callback), options, inputs, outputs, m_endpoints.size());
+
+    triton::client::Error status("No endpoint accepted the request");
+    fail_over(request, status);
+
+    return status;
+}
+
+std::size_t MultiEndpointTritonClient::num_ejected_endpoints() const
+{
+    std::lock_guard lock(m_mutex);
+
+    const auto now = std::chrono::steady_clock::now();
+    return std::count_if(m_endpoints.begin(), m_endpoints.end(), [now](const Endpoint& endpoint) {
+        return endpoint.ejected_until > now;
+    });
+}
+
+std::size_t MultiEndpointTritonClient::num_hedged_requests() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_num_hedged_requests;
+}
+
+std::optional<std::size_t> MultiEndpointTritonClient::select_endpoint(const std::vector<bool>& tried,
+                                                                      bool allow_ejected)
+{
+    std::lock_guard lock(m_mutex);
+
+    const auto now = std::chrono::steady_clock::now();
+
+    std::optional<std::size_t> best;
+    double best_score = 0;
+
+    std::optional<std::size_t> earliest_ejected;
+
+    for (std::size_t i = 0; i < m_endpoints.size(); ++i)
+    {
+        if (tried[i])
+        {
+            continue;
+        }
+
+        const auto& endpoint = m_endpoints[i];
+        if (endpoint.ejected_until > now)
+        {
+            if (!earliest_ejected || endpoint.ejected_until < m_endpoints[*earliest_ejected].ejected_until)
+            {
+                earliest_ejected = i;
+            }
+
+            continue;
+        }
+
+        // Expected time to complete a request queued behind those in flight, inflated by the chance of failing. An
+        // endpoint without any samples yet scores zero and is tried first.
+        const double score = endpoint.latency_ms * static_cast<double>(endpoint.in_flight + 1) /
+                             std::max(1.0 - endpoint.error_rate, 0.05);
+
+        if (!best || score < best_score)
+        {
+            best       = i;
+            best_score = score;
+        }
+    }
+
+    if (!best && allow_ejected)
+    {
+        return earliest_ejected;
+    }
+
+    return best;
+}
+
+triton::client::Error MultiEndpointTritonClient::send(const std::shared_ptr<Request>& request, std::size_t index)
+{
+    {
+        std::lock_guard lock(request->mutex);
+        request->num_in_flight++;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_endpoints[index].in_flight++;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    auto status = m_endpoints[index].client->async_infer(
+        [this, request, index, start](triton::client::InferResult* result) {
+            complete(request, index, start, result);
+        },
+        request->options,
+        request->inputs,
+        request->outputs);
+
+    if (!status.IsOk())
+    {
+        record_result(index, std::chrono::steady_clock::now() - start, true);
+
+        std::lock_guard lock(request->mutex);
+        request->num_in_flight--;
+    }
+
+    return status;
+}
+
+bool MultiEndpointTritonClient::fail_over(const std::shared_ptr<Request>& request, triton::client::Error& status)
+{
+    while (true)
+    {
+        std::optional<std::size_t> index;
+        {
+            std::lock_guard lock(request->mutex);
+
+            index = select_endpoint(request->tried, true);
+            if (!index)
+            {
+                return false;
+            }
+
+            request->tried[*index] = true;
+        }
+
+        status = send(request, *index);
+        if (status.IsOk())
+        {
+            if (m_hedge_thread.joinable())
+            {
+                if (auto delay = hedge_delay(*index))
+                {
+                    {
+                        std::lock_guard lock(m_hedge_mutex);
+                        m_pending_hedges.emplace(std::chrono::steady_clock::now() + *delay, request);
+                    }
+
+                    m_hedge_cv.notify_one();
+                }
+            }
+
+            return true;
+        }
+
+        LOG(WARNING) << "Failed to send request to Triton endpoint " << *index << ", failing over. Error: "
+                     << status.Message();
+    }
+}
+
+void MultiEndpointTritonClient::complete(const std::shared_ptr<Request>& request,
+                                         std::size_t index,
+                                         std::chrono::steady_clock::time_point start,
+                                         triton::client::InferResult* result)
+{
+    std::unique_ptr<triton::client::InferResult> owned_result(result);
+
+    const bool failed = owned_result == nullptr || !owned_result->RequestStatus().IsOk();
+    record_result(index, std::chrono::steady_clock::now() - start, failed);
+
+    if (m_stopping)
+    {
+        return;
+    }
+
+    bool deliver = false;
+    {
+        std::lock_guard lock(request->mutex);
+        request->num_in_flight--;
+
+        if (request->completed)
+        {
+            // Another attempt has already delivered its response
+            return;
+        }
+
+        if (!failed)
+        {
+            request->completed = true;
+            deliver            = true;
+        }
+        else if (request->num_in_flight > 0)
+        {
+            // The response of the other attempt is delivered instead
+            return;
+        }
+    }
+
+    if (!deliver)
+    {
+        // Every attempt so far has failed, give the request to the next best endpoint before giving up on it
+        triton::client::Error status;
+        if (fail_over(request, status))
+        {
+            return;
+        }
+
+        std::lock_guard lock(request->mutex);
+        if (request->completed || request->num_in_flight > 0)
+        {
+            return;
+        }
+
+        request->completed = true;
+    }
+
+    request->callback(owned_result.release());
+}
+
+void MultiEndpointTritonClient::record_result(std::size_t index,
+                                              std::chrono::steady_clock::duration latency,
+                                              bool failed)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto& endpoint = m_endpoints[index];
+    endpoint.in_flight--;
+    endpoint.error_rate += EwmaAlpha * ((failed ? 1.0 : 0.0) - endpoint.error_rate);
+
+    if (failed)
+    {
+        if (++endpoint.consecutive_failures >= m_failure_threshold)
+        {
+            if (endpoint.ejected_until <= std::chrono::steady_clock::now())
+            {
+                LOG(WARNING) << "Ejecting Triton endpoint " << index << " for " << m_ejection_time.count()
+                             << "ms after " << endpoint.consecutive_failures << " consecutive failures";
+            }
+
+            endpoint.ejected_until = std::chrono::steady_clock::now() + m_ejection_time;
+        }
+
+        return;
+    }
+
+    const double latency_ms = std::chrono::duration<double, std::milli>(latency).count();
+
+    if (endpoint.num_samples == 0)
+    {
+        endpoint.latency_ms = latency_ms;
+    }
+    else
+    {
+        endpoint.latency_ms += EwmaAlpha * (latency_ms - endpoint.latency_ms);
+    }
+
+    endpoint.recent_latency_ms[endpoint.num_samples % LatencyWindow] = latency_ms;
+    endpoint.num_samples++;
+    endpoint.consecutive_failures = 0;
+}
+
+std::optional<std::chrono::steady_clock::duration> MultiEndpointTritonClient::hedge_delay(std::size_t index)
+{
+    std::lock_guard lock(m_mutex);
+
+    const auto& endpoint = m_endpoints[index];
+    if (endpoint.num_samples < MinHedgeSamples)
+    {
+        return std::nullopt;
+    }
+
+    const auto count = std::min(endpoint.num_samples, LatencyWindow);
+    std::array<double, LatencyWindow> latencies = endpoint.recent_latency_ms;
+
+    auto p95 = latencies.begin() + (count * 95) / 100;
+    std::nth_element(latencies.begin(), p95, latencies.begin() + count);
+
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(*p95));
+}
+
+void MultiEndpointTritonClient::hedge(const std::shared_ptr<Request>& request)
+{
+    std::optional<std::size_t> index;
+    {
+        std::lock_guard lock(request->mutex);
+        if (request->completed || request->hedged)
+        {
+            return;
+        }
+
+        // Duplicates are never sent to an ejected endpoint
+        index = select_endpoint(request->tried, false);
+        if (!index)
+        {
+            return;
+        }
+
+        request->tried[*index] = true;
+        request->hedged        = true;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_num_hedged_requests++;
+    }
+
+    send(request, *index);
+}
+
+void MultiEndpointTritonClient::hedge_loop()
+{
+    std::unique_lock lock(m_hedge_mutex);
+
+    while (!m_stopping)
+    {
+        if (m_pending_hedges.empty())
+        {
+            m_hedge_cv.wait(lock);
+            continue;
+        }
+
+        auto next = m_pending_hedges.begin();
+        if (next->first > std::chrono::steady_clock::now())
+        {
+            m_hedge_cv.wait_until(lock, next->first);
+            continue;
+        }
+
+        // Requests which have completed and been released are skipped
+        auto request = next->second.lock();
+        m_pending_hedges.erase(next);
+
+        if (request != nullptr)
+        {
+            lock.unlock();
+            hedge(request);
+            lock.lock();
+        }
+    }
+}
+
+}  // namespace morpheus
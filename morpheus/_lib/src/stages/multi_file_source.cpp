@@ -0,0 +1,415 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/multi_file_source.hpp"
+
+#include "mrc/segment/object.hpp"
+#include "pymrc/node.hpp"
+
+#include "morpheus/io/batch_file_reader.hpp"        // for BatchFileReader
+#include "morpheus/io/deserializers.hpp"            // for load_table_from_buffer, prepare_df_index
+#include "morpheus/objects/file_types.hpp"          // for FileTypes, determine_file_type
+#include "morpheus/objects/pinned_host_buffer.hpp"  // for PinnedHostBuffer
+#include "morpheus/stages/deserialize.hpp"          // for coalesce_message_metas
+#include "morpheus/utilities/nvtx_util.hpp"         // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+#include "morpheus/utilities/string_util.hpp"
+
+#include <cudf/io/types.hpp>  // for table_with_metadata
+#include <glob.h>             // for glob, globfree
+#include <glog/logging.h>
+#include <mrc/segment/builder.hpp>
+#include <pybind11/cast.h>  // IWYU pragma: keep
+#include <pybind11/pybind11.h>
+#include <rmm/cuda_stream.hpp>  // for cuda_stream
+
+#include <algorithm>           // for clamp, min
+#include <condition_variable>  // for condition_variable
+#include <deque>
+#include <exception>  // for exception_ptr, current_exception, rethrow_exception
+#include <memory>
+#include <mutex>  // for mutex, unique_lock
+#include <optional>
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace morpheus {
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "MultiFileSourceStage");
+
+// Larger files are read by `cudf::io`, which may read them straight to the device
+const std::size_t MaxBatchedFileSize = 16 * 1024 * 1024;
+
+/**
+ * @brief Whether the compression of `filename` is inferred by `cudf::io` from its extension, which a host buffer lacks
+ */
+bool is_compressed(const std::string& filename)
+{
+    for (const std::string_view extension : {".gz", ".bz2", ".zip", ".xz", ".zst", ".snappy"})
+    {
+        if (filename.size() >= extension.size() &&
+            filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+}  // namespace
+
+// Component public implementations
+// ************ MultiFileSourceStage ************* //
+MultiFileSourceStage::MultiFileSourceStage(std::vector<std::string> filenames,
+                                           std::size_t num_readers,
+                                           bool preserve_order,
+                                           std::optional<bool> json_lines,
+                                           TensorIndex batch_rows,
+                                           std::size_t files_per_read) :
+  PythonSource(build()),
+  m_filenames(std::move(filenames)),
+  m_num_readers(num_readers),
+  m_preserve_order(preserve_order),
+  m_json_lines(json_lines),
+  m_batch_rows(batch_rows),
+  m_files_per_read(files_per_read)
+{
+    if (m_num_readers == 0)
+    {
+        throw std::invalid_argument("num_readers must be at least one");
+    }
+
+    if (m_files_per_read == 0)
+    {
+        throw std::invalid_argument("files_per_read must be at least one");
+    }
+}
+
+std::vector<std::string> MultiFileSourceStage::expand_globs(const std::vector<std::string>& filenames)
+{
+    std::vector<std::string> expanded;
+
+    for (const auto& pattern : filenames)
+    {
+        if (pattern.find_first_of("*?[") == std::string::npos)
+        {
+            expanded.push_back(pattern);
+            continue;
+        }
+
+        glob_t matches{};
+        const int result = ::glob(pattern.c_str(), 0, nullptr, &matches);
+
+        if (result == 0)
+        {
+            // Matches are sorted by glob
+            expanded.insert(expanded.end(), matches.gl_pathv, matches.gl_pathv + matches.gl_pathc);
+        }
+
+        ::globfree(&matches);
+
+        if (result == GLOB_NOMATCH)
+        {
+            throw std::runtime_error(MORPHEUS_CONCAT_STR("No files match the pattern '" << pattern << "'"));
+        }
+
+        if (result != 0)
+        {
+            throw std::runtime_error(MORPHEUS_CONCAT_STR("Failed to expand the pattern '" << pattern << "'"));
+        }
+    }
+
+    return expanded;
+}
+
+void MultiFileSourceStage::emit(std::shared_ptr<MessageMeta> meta, rxcpp::subscriber<source_type_t>& output)
+{
+    const auto num_rows = meta->count();
+
+    if (m_batch_rows <= 0 || num_rows >= m_batch_rows)
+    {
+        // Keeps the messages in order
+        this->flush(output);
+        output.on_next(std::move(meta));
+        return;
+    }
+
+    auto column_names = meta->get_column_names();
+    if (m_pending_rows + num_rows > m_batch_rows || column_names != m_pending_columns)
+    {
+        this->flush(output);
+    }
+
+    if (m_pending.empty())
+    {
+        m_pending_columns = std::move(column_names);
+    }
+
+    m_pending.push_back(std::move(meta));
+    m_pending_rows += num_rows;
+
+    if (m_pending_rows >= m_batch_rows)
+    {
+        this->flush(output);
+    }
+}
+
+void MultiFileSourceStage::flush(rxcpp::subscriber<source_type_t>& output)
+{
+    if (m_pending.empty())
+    {
+        return;
+    }
+
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "flush", m_pending_rows);
+
+    auto meta = m_pending.size() == 1 ? m_pending.front() : coalesce_message_metas(m_pending);
+
+    m_pending.clear();
+    m_pending_rows = 0;
+
+    output.on_next(std::move(meta));
+}
+
+MultiFileSourceStage::subscriber_fn_t MultiFileSourceStage::build()
+{
+    return [this](rxcpp::subscriber<source_type_t> output) {
+        const auto filenames = expand_globs(m_filenames);
+        const auto num_files = filenames.size();
+
+        // Bounds the memory held by files read ahead of the messages being emitted
+        const auto max_read_ahead = 2 * m_num_readers * m_files_per_read;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<std::optional<cudf::io::table_with_metadata>> tables(num_files);
+        std::deque<std::size_t> read_order;  // Indices of the files read, in the order they were read
+        std::exception_ptr error;
+        std::size_t next_file   = 0;
+        std::size_t num_emitted = 0;
+        bool stop               = false;
+
+        auto read_files = [&]() {
+            // Each reader parses on its own stream, allowing reads to overlap on the GPU
+            rmm::cuda_stream stream;
+            BatchFileReader file_reader;
+            PinnedHostBuffer buffer;
+
+            while (true)
+            {
+                std::size_t first_idx;
+                std::size_t end_idx;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&]() {
+                        return stop || next_file >= num_files || next_file < num_emitted + max_read_ahead;
+                    });
+
+                    if (stop || next_file >= num_files)
+                    {
+                        return;
+                    }
+
+                    // Spread the remaining files over the readers rather than leaving the last batches to a few
+                    const auto batch_size =
+                        std::clamp<std::size_t>((num_files - next_file) / m_num_readers, 1, m_files_per_read);
+
+                    first_idx = next_file;
+                    end_idx   = std::min({num_files, first_idx + batch_size, num_emitted + max_read_ahead});
+                    next_file = end_idx;
+                }
+
+                MORPHEUS_NVTX_RANGE(NvtxDomain, "read_files", end_idx - first_idx);
+
+                std::vector<std::size_t> batched_files;
+                std::vector<std::string> batched_filenames;
+
+                for (auto file_idx = first_idx; file_idx < end_idx; ++file_idx)
+                {
+                    if (!is_compressed(filenames[file_idx]))
+                    {
+                        batched_files.push_back(file_idx);
+                        batched_filenames.push_back(filenames[file_idx]);
+                    }
+                }
+
+                std::vector<std::optional<std::string_view>> contents(end_idx - first_idx);
+                std::exception_ptr read_error;
+                std::size_t error_idx = first_idx;
+
+                try
+                {
+                    auto batched_contents = file_reader.read(batched_filenames, buffer, MaxBatchedFileSize);
+
+                    for (std::size_t i = 0; i < batched_files.size(); ++i)
+                    {
+                        contents[batched_files[i] - first_idx] = batched_contents[i];
+                    }
+                } catch (...)
+                {
+                    read_error = std::current_exception();
+                }
+
+                for (auto file_idx = first_idx; file_idx < end_idx && !read_error; ++file_idx)
+                {
+                    std::optional<cudf::io::table_with_metadata> table;
+                    const auto& file_contents = contents[file_idx - first_idx];
+
+                    try
+                    {
+                        if (file_contents.has_value())
+                        {
+                            table = load_table_from_buffer(file_contents->data(),
+                                                           file_contents->size(),
+                                                           determine_file_type(filenames[file_idx]),
+                                                           m_json_lines,
+                                                           {},
+                                                           stream.view());
+                        }
+                        else
+                        {
+                            table = load_table_from_file(
+                                filenames[file_idx], FileTypes::Auto, m_json_lines, {}, stream.view());
+                        }
+
+                        // Downstream stages use the default stream, the buffer is only reused once synchronized
+                        stream.synchronize();
+                    } catch (...)
+                    {
+                        read_error = std::current_exception();
+                        error_idx  = file_idx;
+                        break;
+                    }
+
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        tables[file_idx] = std::move(table);
+                        read_order.push_back(file_idx);
+                    }
+                    cv.notify_all();
+                }
+
+                if (read_error)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        LOG(ERROR) << "Failed to read file '" << filenames[error_idx] << "'";
+                        error = error ? error : read_error;
+                    }
+                    cv.notify_all();
+                }
+            }
+        };
+
+        std::vector<std::thread> readers;
+        for (std::size_t i = 0; i < std::min(m_num_readers, num_files); ++i)
+        {
+            readers.emplace_back(read_files);
+        }
+
+        auto stop_readers = [&]() {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                stop = true;
+            }
+            cv.notify_all();
+
+            for (auto& reader : readers)
+            {
+                reader.join();
+            }
+        };
+
+        try
+        {
+            while (num_emitted < num_files && output.is_subscribed())
+            {
+                cudf::io::table_with_metadata table;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&]() {
+                        return error || (m_preserve_order ? tables[num_emitted].has_value() : !read_order.empty());
+                    });
+
+                    if (error)
+                    {
+                        break;
+                    }
+
+                    std::size_t file_idx = num_emitted;
+                    if (!m_preserve_order)
+                    {
+                        file_idx = read_order.front();
+                    }
+                    read_order.pop_front();
+
+                    table = std::move(*tables[file_idx]);
+                    tables[file_idx].reset();
+                    ++num_emitted;
+                }
+                cv.notify_all();
+
+                int index_col_count = prepare_df_index(table);
+                this->emit(MessageMeta::create_from_cpp(std::move(table), index_col_count), output);
+            }
+
+            if (!error)
+            {
+                this->flush(output);
+            }
+        } catch (...)
+        {
+            stop_readers();
+            throw;
+        }
+
+        stop_readers();
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+
+        output.on_completed();
+    };
+}
+
+// ************ MultiFileSourceStageInterfaceProxy ************ //
+std::shared_ptr<mrc::segment::Object<MultiFileSourceStage>> MultiFileSourceStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::vector<std::string> filenames,
+    std::size_t num_readers,
+    bool preserve_order,
+    pybind11::dict parser_kwargs,
+    TensorIndex batch_rows,
+    std::size_t files_per_read)
+{
+    std::optional<bool> json_lines = std::nullopt;
+
+    if (parser_kwargs.contains("lines"))
+    {
+        json_lines = parser_kwargs["lines"].cast<bool>();
+    }
+
+    auto stage = builder.construct_object<MultiFileSourceStage>(
+        name, std::move(filenames), num_readers, preserve_order, json_lines, batch_rows, files_per_read);
+
+    return stage;
+}
+}  // namespace morpheus
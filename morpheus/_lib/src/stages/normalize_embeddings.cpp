@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/normalize_embeddings.hpp"  // IWYU pragma: associated
+
+#include "morpheus/messages/memory/response_memory.hpp"  // for ResponseMemory
+#include "morpheus/objects/dev_mem_info.hpp"             // for DevMemInfo
+#include "morpheus/objects/tensor.hpp"                   // for Tensor
+#include "morpheus/types.hpp"                            // for TensorMap, TensorIndex
+#include "morpheus/utilities/matx_util.hpp"              // for MatxUtil
+#include "morpheus/utilities/string_util.hpp"            // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/trace_buffer.hpp"           // for MORPHEUS_TRACE
+
+#include <glog/logging.h>
+#include <mrc/cuda/sync.hpp>         // for enqueue_stream_sync_event
+#include <rmm/cuda_stream_view.hpp>  // for cuda_stream_per_thread
+
+#include <exception>
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move
+
+namespace morpheus {
+
+std::shared_ptr<MultiResponseMessage> normalize_embeddings(const MultiResponseMessage& message,
+                                                           const std::string& tensor_name,
+                                                           TypeId output_type,
+                                                           bool normalize)
+{
+    auto embeddings = message.get_tensor(tensor_name);
+
+    if (embeddings.rank() != 2)
+    {
+        throw std::invalid_argument(
+            MORPHEUS_CONCAT_STR("The '" << tensor_name << "' tensor must be 2D, got a rank of " << embeddings.rank()));
+    }
+
+    const auto num_rows = embeddings.shape(0);
+    const auto num_cols = embeddings.shape(1);
+
+    auto stream = rmm::cuda_stream_per_thread;
+    DevMemInfo input{embeddings.data(),
+                     embeddings.dtype(),
+                     embeddings.get_memory(),
+                     embeddings.get_shape(),
+                     embeddings.get_stride()};
+    auto output = MatxUtil::normalize_rows(input, output_type, normalize, stream);
+
+    // The other tensors keep referencing the rows of the incoming memory
+    TensorMap tensors;
+    for (const auto& [name, tensor] : message.memory->get_tensors())
+    {
+        if (name != tensor_name)
+        {
+            tensors[name].swap(message.get_tensor(name));
+        }
+    }
+
+    tensors[tensor_name].swap(
+        Tensor::create(std::move(output), DType(output_type), {num_rows, num_cols}, {num_cols, 1}, 0));
+
+    mrc::enqueue_stream_sync_event(stream).get();
+
+    return std::make_shared<MultiResponseMessage>(message.meta,
+                                                  message.mess_offset,
+                                                  message.mess_count,
+                                                  std::make_shared<ResponseMemory>(message.count, std::move(tensors)),
+                                                  0,
+                                                  message.count,
+                                                  message.id_tensor_name,
+                                                  message.probs_tensor_name);
+}
+
+// Component public implementations
+// ************ NormalizeEmbeddingsStage ********************** //
+NormalizeEmbeddingsStage::NormalizeEmbeddingsStage(std::string tensor_name, TypeId output_type, bool normalize) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_tensor_name(std::move(tensor_name)),
+  m_output_type(output_type),
+  m_normalize(normalize)
+{}
+
+NormalizeEmbeddingsStage::subscribe_fn_t NormalizeEmbeddingsStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                std::shared_ptr<MultiResponseMessage> normalized;
+
+                try
+                {
+                    normalized = normalize_embeddings(*x, m_tensor_name, m_output_type, m_normalize);
+                } catch (...)
+                {
+                    output.on_error(std::current_exception());
+                    return;
+                }
+
+                MORPHEUS_TRACE("normalize_embeddings.normalize", x->count);
+                DVLOG(10) << "Normalize embeddings complete. Rows: " << x->count;
+
+                output.on_next(std::move(normalized));
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&output]() {
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ NormalizeEmbeddingsStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<NormalizeEmbeddingsStage>> NormalizeEmbeddingsStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string tensor_name,
+    TypeId output_type,
+    bool normalize)
+{
+    return builder.construct_object<NormalizeEmbeddingsStage>(name, std::move(tensor_name), output_type, normalize);
+}
+
+}  // namespace morpheus
@@ -0,0 +1,386 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/nvml_source.hpp"  // IWYU pragma: associated
+
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cudf/column/column.hpp>
+#include <cudf/null_mask.hpp>  // for num_bitmask_words
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>
+#include <cudf/utilities/bit.hpp>             // for set_bit_unsafe
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
+#include <glog/logging.h>
+#include <rmm/device_buffer.hpp>
+
+#include <algorithm>  // for min, max
+#include <exception>
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <thread>     // for sleep_for
+#include <utility>    // for move
+
+namespace morpheus {
+namespace {
+
+constexpr double BytesPerMiB = 1024.0 * 1024.0;
+
+void check_nvml(nvmlReturn_t result, const std::string& what)
+{
+    if (result != NVML_SUCCESS)
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR(what << ": " << ::nvmlErrorString(result)));
+    }
+}
+
+// The value of a query, or nullopt when the GPU does not report it, as `nvidia-smi` reporting N/A
+std::optional<double> reported(nvmlReturn_t result, double value)
+{
+    if (result == NVML_ERROR_NOT_SUPPORTED || result == NVML_ERROR_NO_PERMISSION)
+    {
+        return std::nullopt;
+    }
+
+    check_nvml(result, "Unable to query a GPU");
+
+    return value;
+}
+
+template <typename QueryT>
+std::optional<double> query_uint(QueryT&& query, double scale = 1.0)
+{
+    unsigned int value = 0;
+    auto result        = query(&value);
+
+    return reported(result, value * scale);
+}
+
+template <typename T>
+std::unique_ptr<cudf::column> make_column(const std::vector<T>& values, rmm::cuda_stream_view stream)
+{
+    rmm::device_buffer data(values.data(), values.size() * sizeof(T), stream);
+
+    return std::make_unique<cudf::column>(cudf::data_type{cudf::type_to_id<T>()},
+                                          static_cast<cudf::size_type>(values.size()),
+                                          std::move(data),
+                                          rmm::device_buffer{},
+                                          0);
+}
+
+std::unique_ptr<cudf::column> make_column(const std::vector<std::optional<double>>& values,
+                                          rmm::cuda_stream_view stream)
+{
+    const auto num_rows = static_cast<cudf::size_type>(values.size());
+
+    std::vector<double> data(values.size(), 0.0);
+    std::vector<cudf::bitmask_type> null_mask(cudf::num_bitmask_words(num_rows), 0);
+    cudf::size_type null_count = 0;
+    for (cudf::size_type i = 0; i < num_rows; ++i)
+    {
+        if (values[i].has_value())
+        {
+            data[i] = *values[i];
+            cudf::set_bit_unsafe(null_mask.data(), i);
+        }
+        else
+        {
+            ++null_count;
+        }
+    }
+
+    rmm::device_buffer device_data(data.data(), data.size() * sizeof(double), stream);
+    rmm::device_buffer device_mask{};
+    if (null_count > 0)
+    {
+        device_mask = rmm::device_buffer(null_mask.data(), null_mask.size() * sizeof(cudf::bitmask_type), stream);
+    }
+
+    return std::make_unique<cudf::column>(cudf::data_type{cudf::type_id::FLOAT64},
+                                          num_rows,
+                                          std::move(device_data),
+                                          std::move(device_mask),
+                                          null_count);
+}
+
+}  // namespace
+
+// Component public implementations
+// ************ NvmlSampler ************************* //
+NvmlSampler::NvmlSampler() : m_features(feature_columns().size())
+{
+    check_nvml(::nvmlInit_v2(), "Unable to initialize NVML");
+
+    try
+    {
+        unsigned int num_devices = 0;
+        check_nvml(::nvmlDeviceGetCount_v2(&num_devices), "Unable to count the GPUs");
+
+        for (unsigned int i = 0; i < num_devices; ++i)
+        {
+            nvmlDevice_t device{};
+            check_nvml(::nvmlDeviceGetHandleByIndex_v2(i, &device),
+                       MORPHEUS_CONCAT_STR("Unable to open the GPU " << i));
+
+            unsigned int minor_number = i;
+            if (::nvmlDeviceGetMinorNumber(device, &minor_number) != NVML_SUCCESS)
+            {
+                minor_number = i;
+            }
+
+            m_devices.push_back(device);
+            m_minor_numbers.push_back(static_cast<int32_t>(minor_number));
+        }
+    } catch (...)
+    {
+        ::nvmlShutdown();
+        throw;
+    }
+}
+
+NvmlSampler::~NvmlSampler()
+{
+    ::nvmlShutdown();
+}
+
+const std::vector<std::string>& NvmlSampler::feature_columns()
+{
+    static const std::vector<std::string> columns{
+        "nvidia_smi_log.gpu.fb_memory_usage.used",
+        "nvidia_smi_log.gpu.fb_memory_usage.free",
+        "nvidia_smi_log.gpu.utilization.gpu_util",
+        "nvidia_smi_log.gpu.utilization.memory_util",
+        "nvidia_smi_log.gpu.temperature.gpu_temp",
+        "nvidia_smi_log.gpu.temperature.gpu_temp_max_threshold",
+        "nvidia_smi_log.gpu.temperature.gpu_temp_slow_threshold",
+        "nvidia_smi_log.gpu.power_readings.power_draw",
+        "nvidia_smi_log.gpu.clocks.graphics_clock",
+        "nvidia_smi_log.gpu.clocks.sm_clock",
+        "nvidia_smi_log.gpu.clocks.mem_clock",
+        "nvidia_smi_log.gpu.applications_clocks.graphics_clock",
+        "nvidia_smi_log.gpu.applications_clocks.mem_clock",
+        "nvidia_smi_log.gpu.default_applications_clocks.graphics_clock",
+        "nvidia_smi_log.gpu.default_applications_clocks.mem_clock",
+        "nvidia_smi_log.gpu.max_clocks.graphics_clock",
+        "nvidia_smi_log.gpu.max_clocks.sm_clock",
+        "nvidia_smi_log.gpu.max_clocks.mem_clock"};
+
+    return columns;
+}
+
+std::size_t NvmlSampler::num_devices() const
+{
+    return m_devices.size();
+}
+
+std::size_t NvmlSampler::num_rows() const
+{
+    return m_timestamps.size();
+}
+
+void NvmlSampler::sample()
+{
+    const auto timestamp = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    for (std::size_t i = 0; i < m_devices.size(); ++i)
+    {
+        auto* device = m_devices[i];
+
+        nvmlMemory_t memory{};
+        auto memory_result = ::nvmlDeviceGetMemoryInfo(device, &memory);
+
+        nvmlUtilization_t utilization{};
+        auto utilization_result = ::nvmlDeviceGetUtilizationRates(device, &utilization);
+
+        auto clock = [device](nvmlClockType_t type) {
+            return query_uint([device, type](unsigned int* value) {
+                return ::nvmlDeviceGetClockInfo(device, type, value);
+            });
+        };
+        auto applications_clock = [device](nvmlClockType_t type) {
+            return query_uint([device, type](unsigned int* value) {
+                return ::nvmlDeviceGetApplicationsClock(device, type, value);
+            });
+        };
+        auto default_applications_clock = [device](nvmlClockType_t type) {
+            return query_uint([device, type](unsigned int* value) {
+                return ::nvmlDeviceGetDefaultApplicationsClock(device, type, value);
+            });
+        };
+        auto max_clock = [device](nvmlClockType_t type) {
+            return query_uint([device, type](unsigned int* value) {
+                return ::nvmlDeviceGetMaxClockInfo(device, type, value);
+            });
+        };
+        auto temperature_threshold = [device](nvmlTemperatureThresholds_t type) {
+            return query_uint([device, type](unsigned int* value) {
+                return ::nvmlDeviceGetTemperatureThreshold(device, type, value);
+            });
+        };
+
+        // In the order of `feature_columns`
+        const std::vector<std::optional<double>> features{
+            reported(memory_result, memory.used / BytesPerMiB),
+            reported(memory_result, memory.free / BytesPerMiB),
+            reported(utilization_result, utilization.gpu),
+            reported(utilization_result, utilization.memory),
+            query_uint([device](unsigned int* value) {
+                return ::nvmlDeviceGetTemperature(device, NVML_TEMPERATURE_GPU, value);
+            }),
+            temperature_threshold(NVML_TEMPERATURE_THRESHOLD_SHUTDOWN),
+            temperature_threshold(NVML_TEMPERATURE_THRESHOLD_SLOWDOWN),
+            query_uint(
+                [device](unsigned int* value) {
+                    return ::nvmlDeviceGetPowerUsage(device, value);
+                },
+                1e-3),  // mW to W
+            clock(NVML_CLOCK_GRAPHICS),
+            clock(NVML_CLOCK_SM),
+            clock(NVML_CLOCK_MEM),
+            applications_clock(NVML_CLOCK_GRAPHICS),
+            applications_clock(NVML_CLOCK_MEM),
+            default_applications_clock(NVML_CLOCK_GRAPHICS),
+            default_applications_clock(NVML_CLOCK_MEM),
+            max_clock(NVML_CLOCK_GRAPHICS),
+            max_clock(NVML_CLOCK_SM),
+            max_clock(NVML_CLOCK_MEM)};
+
+        for (std::size_t feature = 0; feature < features.size(); ++feature)
+        {
+            m_features[feature].push_back(features[feature]);
+        }
+
+        m_timestamps.push_back(timestamp);
+        m_row_minor_numbers.push_back(m_minor_numbers[i]);
+    }
+}
+
+cudf::io::table_with_metadata NvmlSampler::flush()
+{
+    auto stream = cudf::get_default_stream();
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    cudf::io::table_with_metadata table;
+
+    columns.push_back(make_column(m_timestamps, stream));
+    table.metadata.schema_info.emplace_back("timestamp");
+
+    columns.push_back(make_column(m_row_minor_numbers, stream));
+    table.metadata.schema_info.emplace_back("nvidia_smi_log.gpu.minor_number");
+
+    for (std::size_t feature = 0; feature < m_features.size(); ++feature)
+    {
+        columns.push_back(make_column(m_features[feature], stream));
+        table.metadata.schema_info.emplace_back(feature_columns()[feature]);
+        m_features[feature].clear();
+    }
+
+    // The host vectors are copied asynchronously
+    stream.synchronize();
+
+    m_timestamps.clear();
+    m_row_minor_numbers.clear();
+
+    table.tbl = std::make_unique<cudf::table>(std::move(columns));
+
+    return table;
+}
+
+// ************ NvmlSourceStage ************************* //
+NvmlSourceStage::NvmlSourceStage(std::chrono::milliseconds interval,
+                                 std::size_t polls_per_message,
+                                 std::size_t max_polls) :
+  PythonSource(build()),
+  m_interval(interval),
+  m_polls_per_message(polls_per_message),
+  m_max_polls(max_polls)
+{
+    if (m_polls_per_message == 0)
+    {
+        throw std::invalid_argument("At least one poll per message is required");
+    }
+}
+
+NvmlSourceStage::subscriber_fn_t NvmlSourceStage::build()
+{
+    return [this](rxcpp::subscriber<source_type_t> output) {
+        using clock_t = std::chrono::steady_clock;
+
+        try
+        {
+            NvmlSampler sampler;
+            LOG(INFO) << "Polling the telemetry of " << sampler.num_devices() << " GPUs every " << m_interval.count()
+                      << "ms";
+
+            int64_t num_rows_emitted = 0;
+            auto emit                = [&]() {
+                const auto num_rows = sampler.num_rows();
+                MORPHEUS_TRACE("nvml_source.emit", num_rows);
+
+                output.on_next(MessageMeta::create_from_cpp(sampler.flush(), 0, num_rows_emitted));
+                num_rows_emitted += num_rows;
+            };
+
+            auto next_poll = clock_t::now();
+            for (std::size_t poll = 0; (m_max_polls == 0 || poll < m_max_polls) && output.is_subscribed(); ++poll)
+            {
+                // Sleeps in short steps, to notice the pipeline stopping
+                for (auto now = clock_t::now(); now < next_poll && output.is_subscribed(); now = clock_t::now())
+                {
+                    std::this_thread::sleep_for(
+                        std::min<clock_t::duration>(next_poll - now, std::chrono::milliseconds(100)));
+                }
+
+                sampler.sample();
+
+                // A slow poll delays the next one rather than being followed by a burst
+                next_poll = std::max(next_poll + m_interval, clock_t::now());
+
+                if (sampler.num_rows() >= m_polls_per_message * sampler.num_devices())
+                {
+                    emit();
+                }
+            }
+
+            if (sampler.num_rows() > 0 && output.is_subscribed())
+            {
+                emit();
+            }
+        } catch (...)
+        {
+            output.on_error(std::current_exception());
+            return;
+        }
+
+        output.on_completed();
+    };
+}
+
+// ************ NvmlSourceStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<NvmlSourceStage>> NvmlSourceStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    int64_t interval_ms,
+    std::size_t polls_per_message,
+    std::size_t max_polls)
+{
+    return builder.construct_object<NvmlSourceStage>(
+        name, std::chrono::milliseconds(interval_ms), polls_per_message, max_polls);
+}
+
+}  // namespace morpheus
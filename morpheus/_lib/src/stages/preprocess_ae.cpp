@@ -0,0 +1,205 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/preprocess_ae.hpp"
+
+#include "mrc/segment/object.hpp"  // for Object
+
+#include "morpheus/messages/control.hpp"                  // for ControlMessage
+#include "morpheus/messages/memory/inference_memory.hpp"  // for InferenceMemory
+#include "morpheus/messages/memory/tensor_memory.hpp"     // for TensorMemory
+#include "morpheus/messages/meta.hpp"                     // for MessageMeta
+#include "morpheus/messages/multi.hpp"                    // for MultiMessage
+#include "morpheus/messages/multi_inference.hpp"          // for MultiInferenceMessage
+#include "morpheus/objects/device_resources.hpp"          // for DeviceResources
+#include "morpheus/objects/dtype.hpp"                     // for DType
+#include "morpheus/objects/stage_memory_resource.hpp"     // for StageMemoryResource
+#include "morpheus/objects/table_info.hpp"                // for TableInfo
+#include "morpheus/objects/tensor.hpp"                    // for Tensor
+#include "morpheus/types.hpp"                             // for TensorIndex, TensorMap
+#include "morpheus/utilities/cuda_util.hpp"               // for CudaDeviceGuard
+#include "morpheus/utilities/nvtx_util.hpp"               // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+
+#include <cudf/column/column.hpp>             // for column
+#include <cudf/column/column_factories.hpp>   // for make_column_from_scalar
+#include <cudf/scalar/scalar.hpp>             // for numeric_scalar
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
+#include <glog/logging.h>                     // for COMPACT_GOOGLE_LOG_ERROR, LOG, LogMessage
+#include <mrc/segment/builder.hpp>            // for Builder
+#include <nlohmann/json.hpp>                  // for json
+#include <rmm/device_buffer.hpp>              // for device_buffer
+
+#include <cstdint>      // for int32_t
+#include <memory>       // for shared_ptr, make_shared
+#include <stdexcept>    // for runtime_error, invalid_argument
+#include <string>       // for string
+#include <type_traits>  // for is_same_v
+#include <typeinfo>     // for type_info
+#include <utility>      // for move
+#include <vector>       // for vector
+
+namespace morpheus {
+namespace {
+
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "PreprocessAEStage");
+
+// Attributes the device memory allocated by the stage to it
+StageMemoryResource* memory_resource()
+{
+    return StageMemoryResource::get("PreprocessAEStage");
+}
+
+// Builds the int32 `model_index` tensor of `num_rows` rows of the same model on the device
+TensorObject build_model_index(int32_t model_index, TensorIndex num_rows)
+{
+    const auto stream = cudf::get_default_stream();
+
+    auto column =
+        cudf::make_column_from_scalar(cudf::numeric_scalar<int32_t>(model_index), num_rows, stream, memory_resource());
+    auto contents = column->release();
+
+    // The tensor may be read from any stream by the next stages
+    stream.synchronize();
+
+    return Tensor::create(std::shared_ptr<rmm::device_buffer>(std::move(contents.data)),
+                          DType::create<int32_t>(),
+                          {num_rows, 1},
+                          {},
+                          0);
+}
+}  // namespace
+
+// Component public implementations
+// ************ PreprocessAEStage ************************** //
+template <typename InputT, typename OutputT>
+PreprocessAEStage<InputT, OutputT>::PreprocessAEStage(std::shared_ptr<FeatureScalers> scalers,
+                                                      std::shared_ptr<DenseModelStore> model_store,
+                                                      std::string user_id_key) :
+  base_t(rxcpp::operators::map([this](sink_type_t x) {
+      return this->on_data(std::move(x));
+  })),
+  m_scalers(std::move(scalers)),
+  m_model_store(std::move(model_store)),
+  m_user_id_key(std::move(user_id_key))
+{
+    if (!m_scalers)
+    {
+        throw std::invalid_argument("PreprocessAEStage requires feature scalers");
+    }
+}
+
+template <typename InputT, typename OutputT>
+PreprocessAEStage<InputT, OutputT>::source_type_t PreprocessAEStage<InputT, OutputT>::on_data(sink_type_t x)
+{
+    // All of the work happens on the device holding the message's data
+    if constexpr (std::is_same_v<sink_type_t, std::shared_ptr<MultiMessage>>)
+    {
+        MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", x->mess_count);
+        CudaDeviceGuard device_guard(x->meta->device_id());
+        return on_multi_message(x);
+    }
+    else if constexpr (std::is_same_v<sink_type_t, std::shared_ptr<ControlMessage>>)
+    {
+        MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", x->payload()->count());
+        CudaDeviceGuard device_guard(x->payload()->device_id());
+        return on_control_message(x);
+    }
+    // sink_type_t not supported
+    else
+    {
+        std::string error_msg{"PreprocessAEStage receives unsupported input type: " + std::string(typeid(x).name())};
+        LOG(ERROR) << error_msg;
+        throw std::runtime_error(error_msg);
+    }
+}
+
+template <>
+std::shared_ptr<MultiInferenceMessage> PreprocessAEStage<MultiMessage, MultiInferenceMessage>::on_multi_message(
+    std::shared_ptr<MultiMessage> x)
+{
+    auto df_meta = x->get_meta(m_scalers->feature_columns());
+
+    auto [input, seq_ids] =
+        m_scalers->transform(df_meta, "", x->mess_offset, DeviceResources::stream(), memory_resource());
+
+    // Build the results
+    TensorMap tensors;
+    tensors["input"].swap(std::move(input));
+    tensors["seq_ids"].swap(std::move(seq_ids));
+
+    auto memory = std::make_shared<InferenceMemory>(x->mess_count, std::move(tensors));
+
+    return std::make_shared<MultiInferenceMessage>(
+        x->meta, x->mess_offset, x->mess_count, std::move(memory), 0, memory->count);
+}
+
+template <>
+std::shared_ptr<ControlMessage> PreprocessAEStage<ControlMessage, ControlMessage>::on_control_message(
+    std::shared_ptr<ControlMessage> x)
+{
+    auto df_meta  = x->payload()->get_info(m_scalers->feature_columns());
+    auto num_rows = df_meta.num_rows();
+
+    std::string user_id;
+    if (const auto* metadata = x->find_metadata(m_user_id_key); metadata != nullptr && metadata->is_string())
+    {
+        user_id = metadata->get<std::string>();
+    }
+
+    auto [input, seq_ids] = m_scalers->transform(df_meta, user_id, 0, DeviceResources::stream(), memory_resource());
+
+    // Build the results
+    auto memory = std::make_shared<TensorMemory>(num_rows);
+    memory->set_tensor("input", std::move(input));
+    memory->set_tensor("seq_ids", std::move(seq_ids));
+
+    if (m_model_store)
+    {
+        memory->set_tensor("model_index", build_model_index(m_model_store->model_index(user_id), num_rows));
+    }
+
+    auto next = x;
+    next->tensors(memory);
+
+    return next;
+}
+
+template class PreprocessAEStage<MultiMessage, MultiInferenceMessage>;
+template class PreprocessAEStage<ControlMessage, ControlMessage>;
+
+// ************ PreprocessAEStageInterfaceProxy ************ //
+std::shared_ptr<mrc::segment::Object<PreprocessAEStageMM>> PreprocessAEStageInterfaceProxy::init_multi(
+    mrc::segment::Builder& builder, const std::string& name, std::shared_ptr<FeatureScalers> scalers)
+{
+    auto stage = builder.construct_object<PreprocessAEStageMM>(name, std::move(scalers));
+
+    return stage;
+}
+
+std::shared_ptr<mrc::segment::Object<PreprocessAEStageCM>> PreprocessAEStageInterfaceProxy::init_cm(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::shared_ptr<FeatureScalers> scalers,
+    std::shared_ptr<DenseModelStore> model_store,
+    std::string user_id_key)
+{
+    auto stage = builder.construct_object<PreprocessAEStageCM>(
+        name, std::move(scalers), std::move(model_store), std::move(user_id_key));
+
+    return stage;
+}
+}  // namespace morpheus
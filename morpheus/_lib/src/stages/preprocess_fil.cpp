@@ -25,37 +25,98 @@
 #include "morpheus/messages/meta.hpp"                         // for MessageMeta
 #include "morpheus/messages/multi.hpp"                        // for MultiMessage
 #include "morpheus/messages/multi_inference.hpp"              // for MultiInferenceMessage
-#include "morpheus/objects/dev_mem_info.hpp"                  // for DevMemInfo
-#include "morpheus/objects/dtype.hpp"                         // for DType, TypeId
-#include "morpheus/objects/table_info.hpp"                    // for TableInfo, MutableTableInfo
+#include "morpheus/objects/device_resources.hpp"              // for DeviceResources
+#include "morpheus/objects/dtype.hpp"                         // for DType
+#include "morpheus/objects/stage_memory_resource.hpp"         // for StageMemoryResource
+#include "morpheus/objects/table_info.hpp"                    // for TableInfo, TableInfoBase, MutableTableInfo
 #include "morpheus/objects/tensor.hpp"                        // for Tensor
 #include "morpheus/objects/tensor_object.hpp"                 // for TensorObject
 #include "morpheus/types.hpp"                                 // for TensorIndex
-#include "morpheus/utilities/matx_util.hpp"                   // for MatxUtil
-
-#include <cuda_runtime.h>               // for cudaMemcpy, cudaMemcpyKind
-#include <cudf/column/column.hpp>       // for column
-#include <cudf/column/column_view.hpp>  // for column_view
-#include <cudf/types.hpp>               // for type_id, data_type
-#include <cudf/unary.hpp>               // for cast
-#include <glog/logging.h>               // for COMPACT_GOOGLE_LOG_ERROR, LOG, LogMessage
-#include <mrc/cuda/common.hpp>          // for __check_cuda_errors, MRC_CHECK_CUDA
-#include <mrc/segment/builder.hpp>      // for Builder
-#include <pybind11/gil.h>               // for gil_scoped_acquire
-#include <pybind11/pybind11.h>          // for object_api::operator(), operator""_a, arg
-#include <pybind11/pytypes.h>           // for object, str, object_api, generic_item, literals
-#include <rmm/cuda_stream_view.hpp>     // for cuda_stream_per_thread
-#include <rmm/device_buffer.hpp>        // for device_buffer
+#include "morpheus/utilities/cuda_util.hpp"                   // for CudaDeviceGuard
+#include "morpheus/utilities/matx_util.hpp"                   // for MatxUtil, FeatureColumn
+#include "morpheus/utilities/nvtx_util.hpp"                   // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+
+#include <cudf/column/column.hpp>                   // for column
+#include <cudf/column/column_view.hpp>              // for column_view
+#include <cudf/strings/convert/convert_floats.hpp>  // for to_floats
+#include <cudf/strings/extract.hpp>                 // for extract
+#include <cudf/strings/regex/regex_program.hpp>     // for regex_program
+#include <cudf/strings/strings_column_view.hpp>     // for strings_column_view
+#include <cudf/table/table.hpp>                     // for table
+#include <cudf/types.hpp>                           // for type_id, data_type
+#include <glog/logging.h>                           // for COMPACT_GOOGLE_LOG_ERROR, LOG, LogMessage
+#include <mrc/cuda/sync.hpp>                        // for enqueue_stream_sync_event
+#include <mrc/segment/builder.hpp>                  // for Builder
+#include <rmm/cuda_stream_view.hpp>                 // for cuda_stream_view
+#include <rmm/device_buffer.hpp>                    // for device_buffer
 
 #include <algorithm>    // for find
 #include <cstddef>      // for size_t
+#include <limits>       // for numeric_limits
 #include <memory>       // for shared_ptr, __shared_ptr_access, allocator, mak...
 #include <stdexcept>    // for runtime_error
+#include <string>       // for string
 #include <type_traits>  // for is_same_v
 #include <typeinfo>     // for type_info
-#include <utility>      // for move
+#include <utility>      // for move, pair
+#include <vector>       // for vector
 
 namespace morpheus {
+namespace {
+
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "PreprocessFILStage");
+
+// Attributes the device memory allocated by the stage to it
+StageMemoryResource* memory_resource()
+{
+    return StageMemoryResource::get("PreprocessFILStage");
+}
+
+/**
+ * @brief Builds the row major float32 `input__0` of the FIL model, one row per row of `df_meta` and one column per
+ * feature, along with its `seq_ids`, with a single kernel launch. Nulls are filled with NaN, which FIL treats as a
+ * missing value.
+ */
+std::pair<TensorObject, TensorObject> build_fil_tensors(const TableInfo& df_meta, TensorIndex seq_id_offset)
+{
+    const auto num_rows     = df_meta.num_rows();
+    const auto num_features = static_cast<TensorIndex>(df_meta.num_columns());
+    auto stream             = DeviceResources::stream();
+
+    std::vector<FeatureColumn> columns;
+    columns.reserve(num_features);
+    for (TensorIndex i = 0; i < num_features; ++i)
+    {
+        auto curr_col = df_meta.get_column(i);
+        columns.push_back({curr_col.head(),
+                           curr_col.has_nulls() ? curr_col.null_mask() : nullptr,
+                           curr_col.offset(),
+                           DType::from_cudf(curr_col.type().id()).type_id()});
+    }
+
+    auto seq_id_dtype = DType::create<TensorIndex>();
+    auto features = std::make_shared<rmm::device_buffer>(
+        static_cast<std::size_t>(num_rows) * num_features * sizeof(float), stream, memory_resource());
+    auto seq_ids = std::make_shared<rmm::device_buffer>(
+        num_rows * 3 * seq_id_dtype.item_size(), stream, memory_resource());
+
+    MatxUtil::pack_feature_matrix(columns,
+                                  num_rows,
+                                  std::numeric_limits<float>::quiet_NaN(),
+                                  static_cast<float*>(features->data()),
+                                  static_cast<TensorIndex*>(seq_ids->data()),
+                                  seq_id_offset,
+                                  stream);
+
+    // The table's columns are only guaranteed to stay alive until `df_meta` is released
+    mrc::enqueue_stream_sync_event(stream).get();
+
+    auto input__0 = Tensor::create(std::move(features), DType::create<float>(), {num_rows, num_features}, {}, 0);
+
+    return {std::move(input__0), Tensor::create(std::move(seq_ids), seq_id_dtype, {num_rows, 3}, {}, 0)};
+}
+}  // namespace
+
 // Component public implementations
 // ************ PreprocessFILStage ************************* //
 template <typename InputT, typename OutputT>
@@ -67,10 +128,10 @@ PreprocessFILStage<InputT, OutputT>::PreprocessFILStage(const std::vector<std::s
 {}
 
 template <typename InputT, typename OutputT>
-void PreprocessFILStage<InputT, OutputT>::transform_bad_columns(std::vector<std::string>& fea_cols,
-                                                                morpheus::MutableTableInfo& mutable_info)
+std::vector<std::string> PreprocessFILStage<InputT, OutputT>::get_bad_columns(
+    const std::vector<std::string>& fea_cols, const morpheus::TableInfoBase& table_info) const
 {
-    auto df_meta_col_names = mutable_info.get_column_names();
+    auto df_meta_col_names = table_info.get_column_names();
     std::vector<std::string> bad_cols;
     // Only check the feature columns. Leave the rest unchanged
     for (auto& fea_col : fea_cols)
@@ -85,37 +146,42 @@ void PreprocessFILStage<InputT, OutputT>::transform_bad_columns(std::vector<std:
             continue;
         }
 
-        if (mutable_info.get_column(col_idx).type().id() == cudf::type_id::STRING)
+        if (table_info.get_column(col_idx).type().id() == cudf::type_id::STRING)
         {
             bad_cols.push_back(fea_col);
         }
     }
 
+    return bad_cols;
+}
+
+template <typename InputT, typename OutputT>
+void PreprocessFILStage<InputT, OutputT>::transform_bad_columns(std::vector<std::string>& fea_cols,
+                                                                morpheus::MutableTableInfo& mutable_info)
+{
+    auto bad_cols = get_bad_columns(fea_cols, mutable_info);
+
     // Exit early if there is nothing to do
     if (!bad_cols.empty())
     {
-        // Need to ensure all string columns have been converted to numbers. This requires running a
-        // regex which is too difficult to do from C++ at this time. So grab the GIL, make the
-        // conversions, and release. This is horribly inefficient, but so is the JSON lines format for
-        // this workflow
-        using namespace pybind11::literals;
-        pybind11::gil_scoped_acquire gil;
-
-        // pybind11::object df = x->meta->get_py_table();
-        auto pdf = mutable_info.checkout_obj();
-        auto& df = *pdf;
+        // Need to ensure all string columns have been converted to numbers. The first run of digits in each string
+        // is parsed as a float, strings without any digits become null
+        static const auto digits = cudf::strings::regex_program::create(R"((\d+))");
 
-        std::string regex = R"((\d+))";
+        auto column_names = mutable_info.get_column_names();
+        std::vector<std::unique_ptr<cudf::column>> converted;
 
-        for (auto c : bad_cols)
+        for (const auto& c : bad_cols)
         {
-            df[pybind11::str(c)] = df[pybind11::str(c)]
-                                       .attr("str")
-                                       .attr("extract")(pybind11::str(regex), "expand"_a = true)
-                                       .attr("astype")(pybind11::str("float32"));
+            auto col_idx   = std::find(column_names.begin(), column_names.end(), c) - column_names.begin();
+            auto extracted = cudf::strings::extract(cudf::strings_column_view{mutable_info.get_column(col_idx)},
+                                                    *digits);
+            converted.push_back(cudf::strings::to_floats(cudf::strings_column_view{extracted->get_column(0).view()},
+                                                         cudf::data_type{cudf::type_id::FLOAT32}));
         }
 
-        mutable_info.return_obj(std::move(pdf));
+        // Tables which have not been handed over to python are updated without the GIL
+        mutable_info.replace_columns(bad_cols, std::move(converted));
     }
 }
 
@@ -124,6 +190,9 @@ TableInfo PreprocessFILStage<InputT, OutputT>::fix_bad_columns(sink_type_t x)
 {
     if constexpr (std::is_same_v<sink_type_t, std::shared_ptr<MultiMessage>>)
     {
+        // Only take the exclusive lock, blocking every other reader and writer of the dataframe, when there are
+        // columns to convert. The columns are checked again under the exclusive lock.
+        if (!get_bad_columns(this->m_fea_cols, x->meta->get_info()).empty())
         {
             // Get the mutable info for the entire meta object so we only do this once per dataframe
             auto mutable_info = x->meta->get_mutable_info();
@@ -135,6 +204,8 @@ TableInfo PreprocessFILStage<InputT, OutputT>::fix_bad_columns(sink_type_t x)
     }
     else if constexpr (std::is_same_v<sink_type_t, std::shared_ptr<ControlMessage>>)
     {
+        // Only take the exclusive lock when there are columns to convert, see above
+        if (!get_bad_columns(this->m_fea_cols, x->payload()->get_info()).empty())
         {
             // Get the mutable info for the entire meta object so we only do this once per dataframe
             auto mutable_info = x->payload()->get_mutable_info();
@@ -156,12 +227,17 @@ TableInfo PreprocessFILStage<InputT, OutputT>::fix_bad_columns(sink_type_t x)
 template <typename InputT, typename OutputT>
 PreprocessFILStage<InputT, OutputT>::source_type_t PreprocessFILStage<InputT, OutputT>::on_data(sink_type_t x)
 {
+    // All of the work happens on the device holding the message's data
     if constexpr (std::is_same_v<sink_type_t, std::shared_ptr<MultiMessage>>)
     {
+        MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", x->mess_count);
+        CudaDeviceGuard device_guard(x->meta->device_id());
         return on_multi_message(x);
     }
     else if constexpr (std::is_same_v<sink_type_t, std::shared_ptr<ControlMessage>>)
     {
+        MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", x->payload()->count());
+        CudaDeviceGuard device_guard(x->payload()->device_id());
         return on_control_message(x);
     }
     // sink_type_t not supported
@@ -177,52 +253,9 @@ template <>
 std::shared_ptr<MultiInferenceMessage> PreprocessFILStage<MultiMessage, MultiInferenceMessage>::on_multi_message(
     std::shared_ptr<MultiMessage> x)
 {
-    auto packed_data = std::make_shared<rmm::device_buffer>(m_fea_cols.size() * x->mess_count * sizeof(float),
-                                                            rmm::cuda_stream_per_thread);
-    auto df_meta     = this->fix_bad_columns(x);
-    for (size_t i = 0; i < df_meta.num_columns(); ++i)
-    {
-        auto curr_col = df_meta.get_column(i);
-
-        auto curr_ptr = static_cast<float*>(packed_data->data()) + i * df_meta.num_rows();
-
-        // Check if we are something other than float
-        if (curr_col.type().id() != cudf::type_id::FLOAT32)
-        {
-            auto float_data = cudf::cast(curr_col, cudf::data_type(cudf::type_id::FLOAT32))->release();
-
-            // Do the copy here before it goes out of scope
-            MRC_CHECK_CUDA(cudaMemcpy(
-                curr_ptr, float_data.data->data(), df_meta.num_rows() * sizeof(float), cudaMemcpyDeviceToDevice));
-        }
-        else
-        {
-            MRC_CHECK_CUDA(cudaMemcpy(curr_ptr,
-                                      curr_col.template data<float>(),
-                                      df_meta.num_rows() * sizeof(float),
-                                      cudaMemcpyDeviceToDevice));
-        }
-    }
-
-    // Need to convert from row major to column major
-    // Easiest way to do this is to transpose the data from [fea_len, row_count] to [row_count, fea_len]
-    auto transposed_data = MatxUtil::transpose(DevMemInfo{packed_data,
-                                                          TypeId::FLOAT32,
-                                                          {static_cast<TensorIndex>(m_fea_cols.size()), x->mess_count},
-                                                          {x->mess_count, 1}});
-
-    // Create the tensor which will be row-major and size [row_count, fea_len]
-    auto input__0 = Tensor::create(
-        transposed_data, DType::create<float>(), {x->mess_count, static_cast<TensorIndex>(m_fea_cols.size())}, {}, 0);
+    auto df_meta = this->fix_bad_columns(x);
 
-    auto seq_id_dtype = DType::create<TensorIndex>();
-    auto seq_ids      = Tensor::create(
-        MatxUtil::create_seq_ids(
-            x->mess_count, m_fea_cols.size(), seq_id_dtype.type_id(), input__0.get_memory(), x->mess_offset),
-        seq_id_dtype,
-        {x->mess_count, 3},
-        {},
-        0);
+    auto [input__0, seq_ids] = build_fil_tensors(df_meta, x->mess_offset);
 
     // Build the results
     auto memory = std::make_shared<InferenceMemoryFIL>(x->mess_count, std::move(input__0), std::move(seq_ids));
@@ -237,50 +270,10 @@ template <>
 std::shared_ptr<ControlMessage> PreprocessFILStage<ControlMessage, ControlMessage>::on_control_message(
     std::shared_ptr<ControlMessage> x)
 {
-    auto num_rows = x->payload()->get_info().num_rows();
-    auto packed_data =
-        std::make_shared<rmm::device_buffer>(m_fea_cols.size() * num_rows * sizeof(float), rmm::cuda_stream_per_thread);
-    auto df_meta = this->fix_bad_columns(x);
-    for (size_t i = 0; i < df_meta.num_columns(); ++i)
-    {
-        auto curr_col = df_meta.get_column(i);
-
-        auto curr_ptr = static_cast<float*>(packed_data->data()) + i * df_meta.num_rows();
-
-        // Check if we are something other than float
-        if (curr_col.type().id() != cudf::type_id::FLOAT32)
-        {
-            auto float_data = cudf::cast(curr_col, cudf::data_type(cudf::type_id::FLOAT32))->release();
-
-            // Do the copy here before it goes out of scope
-            MRC_CHECK_CUDA(cudaMemcpy(
-                curr_ptr, float_data.data->data(), df_meta.num_rows() * sizeof(float), cudaMemcpyDeviceToDevice));
-        }
-        else
-        {
-            MRC_CHECK_CUDA(cudaMemcpy(curr_ptr,
-                                      curr_col.template data<float>(),
-                                      df_meta.num_rows() * sizeof(float),
-                                      cudaMemcpyDeviceToDevice));
-        }
-    }
+    auto df_meta  = this->fix_bad_columns(x);
+    auto num_rows = df_meta.num_rows();
 
-    // Need to convert from row major to column major
-    // Easiest way to do this is to transpose the data from [fea_len, row_count] to [row_count, fea_len]
-    auto transposed_data = MatxUtil::transpose(DevMemInfo{
-        packed_data, TypeId::FLOAT32, {static_cast<TensorIndex>(m_fea_cols.size()), num_rows}, {num_rows, 1}});
-
-    // Create the tensor which will be row-major and size [row_count, fea_len]
-    auto input__0 = Tensor::create(
-        transposed_data, DType::create<float>(), {num_rows, static_cast<TensorIndex>(m_fea_cols.size())}, {}, 0);
-
-    auto seq_id_dtype = DType::create<TensorIndex>();
-    auto seq_ids      = Tensor::create(
-        MatxUtil::create_seq_ids(num_rows, m_fea_cols.size(), seq_id_dtype.type_id(), input__0.get_memory(), 0),
-        seq_id_dtype,
-        {num_rows, 3},
-        {},
-        0);
+    auto [input__0, seq_ids] = build_fil_tensors(df_meta, 0);
 
     // Build the results
     auto memory = std::make_shared<TensorMemory>(num_rows);
@@ -23,41 +23,230 @@
 #include "morpheus/messages/memory/inference_memory.hpp"  // for InferenceMemory
 #include "morpheus/messages/memory/tensor_memory.hpp"     // for TensorMemory
 #include "morpheus/messages/meta.hpp"
-#include "morpheus/messages/multi.hpp"            // for MultiMessage
-#include "morpheus/messages/multi_inference.hpp"  // for MultiInferenceMessage
-#include "morpheus/objects/dev_mem_info.hpp"      // for DevMemInfo
-#include "morpheus/objects/dtype.hpp"             // for DType
-#include "morpheus/objects/table_info.hpp"        // for TableInfo
-#include "morpheus/objects/tensor.hpp"            // for Tensor
-#include "morpheus/types.hpp"                     // for TensorIndex
-#include "morpheus/utilities/matx_util.hpp"       // for MatxUtil
-
-#include <cudf/column/column.hpp>                 // for column
-#include <cudf/column/column_factories.hpp>       // for make_column_from_scalar
-#include <cudf/column/column_view.hpp>            // for column_view
-#include <cudf/filling.hpp>                       // for sequence
-#include <cudf/reshape.hpp>                       // for interleave_columns
-#include <cudf/scalar/scalar.hpp>                 // for numeric_scalar
-#include <cudf/strings/strings_column_view.hpp>   // for strings_column_view
-#include <cudf/table/table_view.hpp>              // for table_view
-#include <cudf/types.hpp>                         // for type_id, data_type
-#include <cudf/unary.hpp>                         // for cast
-#include <glog/logging.h>                         // for COMPACT_GOOGLE_LOG_ERROR, LOG, LogMessage
-#include <mrc/segment/builder.hpp>                // for Builder
-#include <nvtext/normalize.hpp>                   // for normalize_spaces
-#include <nvtext/subword_tokenize.hpp>            // for tokenizer_result, load_vocabulary_file, subword_tok...
-#include <rmm/cuda_stream_view.hpp>               // for cuda_stream_default
-#include <rmm/device_buffer.hpp>                  // for device_buffer
-#include <rmm/mr/device/per_device_resource.hpp>  // for get_current_device_resource
-
+#include "morpheus/messages/multi.hpp"                 // for MultiMessage
+#include "morpheus/messages/multi_inference.hpp"       // for MultiInferenceMessage
+#include "morpheus/objects/dev_mem_info.hpp"           // for DevMemInfo
+#include "morpheus/objects/dtype.hpp"                  // for DType
+#include "morpheus/objects/memory_descriptor.hpp"      // for MemoryDescriptor
+#include "morpheus/objects/stage_memory_resource.hpp"  // for StageMemoryResource
+#include "morpheus/objects/table_info.hpp"             // for TableInfo
+#include "morpheus/objects/tensor.hpp"                 // for Tensor
+#include "morpheus/objects/tokenizer.hpp"              // for ITokenizer, WordPieceTokenizer
+#include "morpheus/types.hpp"                          // for TensorIndex
+#include "morpheus/utilities/cuda_util.hpp"            // for CudaDeviceGuard
+#include "morpheus/utilities/matx_util.hpp"            // for MatxUtil
+#include "morpheus/utilities/nvtx_util.hpp"            // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+#include "morpheus/utilities/pool_allocator.hpp"       // for make_pooled
+#include "morpheus/utilities/string_util.hpp"          // for MORPHEUS_CONCAT_STR
+
+#include <cuda_runtime.h>                        // for cudaMemcpy2DAsync, cudaEventRecord, cudaStreamWaitEvent
+#include <cudf/column/column.hpp>                // for column
+#include <cudf/column/column_view.hpp>           // for column_view
+#include <cudf/strings/strings_column_view.hpp>  // for strings_column_view
+#include <cudf/types.hpp>                        // for type_id, data_type, size_of
+#include <cudf/utilities/default_stream.hpp>     // for get_default_stream
+#include <glog/logging.h>                        // for COMPACT_GOOGLE_LOG_ERROR, LOG, LogMessage
+#include <mrc/cuda/common.hpp>                   // for MRC_CHECK_CUDA
+#include <mrc/segment/builder.hpp>               // for Builder
+#include <nvtext/subword_tokenize.hpp>           // for tokenizer_result
+#include <rmm/cuda_stream_view.hpp>              // for cuda_stream_view
+#include <rmm/device_buffer.hpp>                 // for device_buffer
+
+#include <algorithm>    // for sort, unique
 #include <cstdint>      // for uint32_t, int32_t
 #include <memory>       // for shared_ptr, unique_ptr, __shared_ptr_access, make_s...
-#include <stdexcept>    // for runtime_error
+#include <stdexcept>    // for runtime_error, invalid_argument
 #include <type_traits>  // for is_same_v
 #include <typeinfo>     // for type_info
 #include <utility>      // for move
 #include <vector>       // for vector
 
+namespace {
+
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "PreprocessNLPStage");
+
+// Attributes the device memory allocated by the stage to it
+morpheus::StageMemoryResource* memory_resource()
+{
+    return morpheus::StageMemoryResource::get("PreprocessNLPStage");
+}
+
+// Orders `waiting` after the work enqueued on `signalling` so far, without blocking the host
+void stream_wait(rmm::cuda_stream_view waiting, rmm::cuda_stream_view signalling)
+{
+    if (waiting.value() == signalling.value())
+    {
+        return;
+    }
+
+    cudaEvent_t event;
+    MRC_CHECK_CUDA(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    MRC_CHECK_CUDA(cudaEventRecord(event, signalling.value()));
+    MRC_CHECK_CUDA(cudaStreamWaitEvent(waiting.value(), event, 0));
+    MRC_CHECK_CUDA(cudaEventDestroy(event));
+}
+
+// Returns the smallest of `buckets` holding the longest sequence of `attention_mask`, a column of rows of
+// `sequence_length`, or `sequence_length` when none do. Returns `sequence_length` without looking at the mask when
+// `buckets` is empty.
+morpheus::TensorIndex select_sequence_length(const cudf::column& attention_mask,
+                                             morpheus::TensorIndex sequence_length,
+                                             const std::vector<morpheus::TensorIndex>& buckets,
+                                             rmm::cuda_stream_view stream)
+{
+    if (buckets.empty())
+    {
+        return sequence_length;
+    }
+
+    const morpheus::TensorIndex num_rows = attention_mask.size() / sequence_length;
+
+    auto md      = std::make_shared<morpheus::MemoryDescriptor>(stream, memory_resource());
+    auto longest = morpheus::MatxUtil::max_row_length(
+        morpheus::DevMemInfo{const_cast<void*>(attention_mask.view().head()),
+                             morpheus::DType::from_cudf(attention_mask.type().id()),
+                             std::move(md),
+                             {num_rows, sequence_length},
+                             {sequence_length, 1}},
+        stream);
+
+    for (const auto bucket : buckets)
+    {
+        if (bucket >= longest)
+        {
+            return bucket;
+        }
+    }
+
+    return sequence_length;
+}
+
+// Adopts the buffer of a tokenizer output column as a tensor of rows of `num_columns`, keeping only the first
+// `num_kept_columns` of each row. The column is only copied when its columns are trimmed, and only cast when its type
+// differs from `dtype`. The copy and cast are enqueued on `stream`, the columns they read are moved to `retired` to be
+// released once `stream` is done with them.
+morpheus::TensorObject column_to_tensor(std::unique_ptr<cudf::column>&& column,
+                                        const morpheus::DType& dtype,
+                                        morpheus::TensorIndex num_columns,
+                                        morpheus::TensorIndex num_kept_columns,
+                                        rmm::cuda_stream_view stream,
+                                        std::vector<std::unique_ptr<cudf::column>>& retired)
+{
+    const morpheus::TensorIndex num_rows = column->size() / num_columns;
+
+    if (num_kept_columns < num_columns)
+    {
+        const auto item_size = cudf::size_of(column->type());
+
+        rmm::device_buffer trimmed(num_rows * num_kept_columns * item_size, stream, memory_resource());
+        if (num_rows > 0)
+        {
+            MRC_CHECK_CUDA(cudaMemcpy2DAsync(trimmed.data(),
+                                             num_kept_columns * item_size,
+                                             column->view().head(),
+                                             num_columns * item_size,
+                                             num_kept_columns * item_size,
+                                             num_rows,
+                                             cudaMemcpyDeviceToDevice,
+                                             stream.value()));
+        }
+
+        auto type = column->type();
+        retired.push_back(std::move(column));
+        column = std::make_unique<cudf::column>(
+            type, num_rows * num_kept_columns, std::move(trimmed), rmm::device_buffer{}, 0);
+    }
+
+    std::shared_ptr<rmm::device_buffer> data;
+    if (column->type().id() != dtype.cudf_type_id())
+    {
+        auto md = std::make_shared<morpheus::MemoryDescriptor>(stream, memory_resource());
+        morpheus::DevMemInfo input{const_cast<void*>(column->view().head()),
+                                   morpheus::DType::from_cudf(column->type().id()),
+                                   std::move(md),
+                                   {num_rows, num_kept_columns},
+                                   {num_kept_columns, 1}};
+
+        data = morpheus::MatxUtil::enqueue_cast(input, dtype.type_id(), stream);
+        retired.push_back(std::move(column));
+    }
+    else
+    {
+        data = std::move(column->release().data);
+    }
+
+    return morpheus::Tensor::create(std::move(data), dtype, {num_rows, num_kept_columns}, {}, 0);
+}
+
+// Moves the outputs of the tokenizer into the `input_ids`, `input_mask` and `seq_ids` tensors of `memory`. The work
+// enqueued by the tokenizer on the cudf default stream is handed off to `stream` with an event, and the tensors are
+// finished on `stream` without blocking the host, save for the length of the longest sequence when `buckets` are
+// given. The event recorded on `memory` marks the tensors being ready.
+void set_token_tensors(morpheus::TensorMemory& memory,
+                       nvtext::tokenizer_result&& token_results,
+                       const morpheus::DType& token_dtype,
+                       const std::vector<morpheus::TensorIndex>& buckets,
+                       morpheus::TensorIndex seq_id_offset,
+                       rmm::cuda_stream_view stream)
+{
+    using namespace morpheus;
+
+    const auto default_stream = cudf::get_default_stream();
+    stream_wait(stream, default_stream);
+
+    std::vector<std::unique_ptr<cudf::column>> retired;
+
+    const auto sequence_length = static_cast<TensorIndex>(token_results.sequence_length);
+    const auto kept_length =
+        select_sequence_length(*token_results.tensor_attention_mask, sequence_length, buckets, stream);
+
+    memory.set_tensor("input_ids",
+                      column_to_tensor(std::move(token_results.tensor_token_ids),
+                                       token_dtype,
+                                       sequence_length,
+                                       kept_length,
+                                       stream,
+                                       retired));
+    memory.set_tensor("input_mask",
+                      column_to_tensor(std::move(token_results.tensor_attention_mask),
+                                       token_dtype,
+                                       sequence_length,
+                                       kept_length,
+                                       stream,
+                                       retired));
+
+    auto tensor_index_dtype = DType::create<TensorIndex>();
+    TensorIndex length      = token_results.tensor_metadata->size() / 3;
+
+    auto md = std::make_shared<MemoryDescriptor>(stream, memory_resource());
+    std::shared_ptr<rmm::device_buffer> seq_ids_data = MatxUtil::enqueue_cast(
+        DevMemInfo{const_cast<void*>(token_results.tensor_metadata->view().head()),
+                   DType::from_cudf(token_results.tensor_metadata->type().id()),
+                   std::move(md),
+                   {length, 3},
+                   {3, 1}},
+        tensor_index_dtype.type_id(),
+        stream);
+    retired.push_back(std::move(token_results.tensor_metadata));
+
+    if (seq_id_offset > 0)
+    {
+        // Add an offset to the seq_ids so the message IDs line up
+        MatxUtil::enqueue_offset_seq_ids(
+            DevMemInfo{seq_ids_data, tensor_index_dtype.type_id(), {length, 3}, {1, 3}}, seq_id_offset, stream);
+    }
+
+    memory.set_tensor("seq_ids", Tensor::create(seq_ids_data, tensor_index_dtype, {length, 3}, {}, 0));
+
+    // The tokenizer's columns were allocated on the default stream, which must not reuse them before `stream` is done
+    stream_wait(default_stream, stream);
+    retired.clear();
+
+    memory.record_event(stream);
+}
+
+}  // namespace
+
 namespace morpheus {
 // Component public implementations
 // ************ PreprocessNLPStage ************************* //
@@ -68,17 +257,62 @@ PreprocessNLPStage<InputT, OutputT>::PreprocessNLPStage(std::string vocab_hash_f
                                                         bool do_lower_case,
                                                         bool add_special_token,
                                                         int stride,
-                                                        std::string column) :
+                                                        std::string column,
+                                                        bool uint32_tokens,
+                                                        std::vector<TensorIndex> sequence_length_buckets) :
+  PreprocessNLPStage(std::make_shared<WordPieceTokenizer>(std::move(vocab_hash_file), do_lower_case),
+                     sequence_length,
+                     truncation,
+                     add_special_token,
+                     stride,
+                     std::move(column),
+                     uint32_tokens,
+                     std::move(sequence_length_buckets))
+{}
+
+template <typename InputT, typename OutputT>
+PreprocessNLPStage<InputT, OutputT>::PreprocessNLPStage(std::shared_ptr<ITokenizer> tokenizer,
+                                                        uint32_t sequence_length,
+                                                        bool truncation,
+                                                        bool add_special_token,
+                                                        int stride,
+                                                        std::string column,
+                                                        bool uint32_tokens,
+                                                        std::vector<TensorIndex> sequence_length_buckets) :
   base_t(rxcpp::operators::map([this](sink_type_t x) {
       return this->on_data(std::move(x));
   })),
-  m_vocab_hash_file(std::move(vocab_hash_file)),
+  m_tokenizer(std::move(tokenizer)),
   m_sequence_length(sequence_length),
   m_truncation(truncation),
-  m_do_lower_case(do_lower_case),
   m_add_special_token(add_special_token),
-  m_column(std::move(column))
+  m_column(std::move(column)),
+  m_uint32_tokens(uint32_tokens)
 {
+    if (m_tokenizer == nullptr)
+    {
+        throw std::invalid_argument("PreprocessNLPStage requires a tokenizer");
+    }
+
+    for (const auto bucket : sequence_length_buckets)
+    {
+        if (bucket <= 0)
+        {
+            throw std::invalid_argument(
+                MORPHEUS_CONCAT_STR("Sequence length buckets must be positive, got " << bucket));
+        }
+
+        // Sequences longer than every bucket keep the full sequence length
+        if (bucket < static_cast<TensorIndex>(m_sequence_length))
+        {
+            m_sequence_length_buckets.push_back(bucket);
+        }
+    }
+
+    std::sort(m_sequence_length_buckets.begin(), m_sequence_length_buckets.end());
+    m_sequence_length_buckets.erase(std::unique(m_sequence_length_buckets.begin(), m_sequence_length_buckets.end()),
+                                    m_sequence_length_buckets.end());
+
     // Auto calc stride to be 75% of sequence length
     if (stride < 0)
     {
@@ -92,13 +326,18 @@ PreprocessNLPStage<InputT, OutputT>::PreprocessNLPStage(std::string vocab_hash_f
 template <typename InputT, typename OutputT>
 PreprocessNLPStage<InputT, OutputT>::source_type_t PreprocessNLPStage<InputT, OutputT>::on_data(sink_type_t x)
 {
+    // All of the work happens on the device holding the message's data
     if constexpr (std::is_same_v<sink_type_t, std::shared_ptr<MultiMessage>>)
     {
-        return this->on_multi_message(x);
+        MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", x->mess_count);
+        CudaDeviceGuard device_guard(x->meta->device_id());
+        return this->on_multi_message(x, this->next_stream());
     }
     else if constexpr (std::is_same_v<sink_type_t, std::shared_ptr<ControlMessage>>)
     {
-        return this->on_control_message(x);
+        MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", x->payload()->count());
+        CudaDeviceGuard device_guard(x->payload()->device_id());
+        return this->on_control_message(x, this->next_stream());
     }
     // sink_type_t not supported
     else
@@ -109,9 +348,20 @@ PreprocessNLPStage<InputT, OutputT>::source_type_t PreprocessNLPStage<InputT, Ou
     }
 }
 
+template <typename InputT, typename OutputT>
+rmm::cuda_stream_view PreprocessNLPStage<InputT, OutputT>::next_stream() const
+{
+    if (CudaUtil::current_device() == m_device_id)
+    {
+        return m_streams.get_stream();
+    }
+
+    return cudf::get_default_stream();
+}
+
 template <>
 std::shared_ptr<MultiInferenceMessage> PreprocessNLPStage<MultiMessage, MultiInferenceMessage>::on_multi_message(
-    std::shared_ptr<MultiMessage> x)
+    std::shared_ptr<MultiMessage> x, rmm::cuda_stream_view stream)
 {
     // Convert to string view
     auto meta = x->get_meta(this->m_column);
@@ -119,56 +369,17 @@ std::shared_ptr<MultiInferenceMessage> PreprocessNLPStage<MultiMessage, MultiInf
     auto col        = meta.get_column(0);
     auto string_col = cudf::strings_column_view{col};
 
-    auto token_results = subword_tokenize(this->m_vocab_hash_file,
-                                          this->m_sequence_length,
-                                          this->m_do_lower_case,
-                                          this->m_truncation,
-                                          string_col,
-                                          this->m_stride,
-                                          rmm::mr::get_current_device_resource());
+    auto token_results =
+        m_tokenizer->tokenize(string_col, this->m_sequence_length, this->m_truncation, this->m_stride);
 
     // Build the results
-    auto memory = std::make_shared<InferenceMemory>(token_results.nrows_tensor);
-
-    TensorIndex length = token_results.tensor_token_ids->size() / token_results.sequence_length;
-    auto input_ids_released =
-        cudf::cast(token_results.tensor_token_ids->view(), cudf::data_type(cudf::type_id::INT32))->release();
-
-    memory->set_tensor("input_ids",
-                       Tensor::create(std::move(input_ids_released.data),
-                                      DType::create<int32_t>(),
-                                      {length, static_cast<TensorIndex>(token_results.sequence_length)},
-                                      {},
-                                      0));
-
-    length = token_results.tensor_attention_mask->size() / token_results.sequence_length;
-    auto input_mask_released =
-        cudf::cast(token_results.tensor_attention_mask->view(), cudf::data_type(cudf::type_id::INT32))->release();
-    memory->set_tensor("input_mask",
-                       Tensor::create(std::move(input_mask_released.data),
-                                      DType::create<int32_t>(),
-                                      {length, static_cast<TensorIndex>(token_results.sequence_length)},
-                                      {},
-                                      0));
-
-    auto tensor_index_dtype = DType::create<TensorIndex>();
-    length                  = token_results.tensor_metadata->size() / 3;
-    auto seq_ids_released =
-        cudf::cast(token_results.tensor_metadata->view(), cudf::data_type(tensor_index_dtype.cudf_type_id()))
-            ->release();
-
-    std::shared_ptr<rmm::device_buffer> seq_ids_data = std::move(seq_ids_released.data);
-
-    if (x->mess_offset > 0)
-    {
-        // Add an offset to the seq_ids so the message IDs line up
-        MatxUtil::offset_seq_ids(DevMemInfo{seq_ids_data, tensor_index_dtype.type_id(), {length, 3}, {1, 3}},
-                                 x->mess_offset);
-    }
+    auto memory = make_pooled<InferenceMemory>(token_results.nrows_tensor);
 
-    memory->set_tensor("seq_ids", Tensor::create(seq_ids_data, tensor_index_dtype, {length, 3}, {}, 0));
+    const auto token_dtype = this->m_uint32_tokens ? DType::create<uint32_t>() : DType::create<int32_t>();
+    set_token_tensors(
+        *memory, std::move(token_results), token_dtype, this->m_sequence_length_buckets, x->mess_offset, stream);
 
-    auto next = std::make_shared<MultiInferenceMessage>(
+    auto next = make_pooled<MultiInferenceMessage>(
         x->meta, x->mess_offset, x->mess_count, std::move(memory), 0, memory->count);
 
     return std::move(next);
@@ -176,7 +387,7 @@ std::shared_ptr<MultiInferenceMessage> PreprocessNLPStage<MultiMessage, MultiInf
 
 template <>
 std::shared_ptr<ControlMessage> PreprocessNLPStage<ControlMessage, ControlMessage>::on_control_message(
-    std::shared_ptr<ControlMessage> x)
+    std::shared_ptr<ControlMessage> x, rmm::cuda_stream_view stream)
 {
     // Convert to string view
     auto meta = x->payload()->get_info(this->m_column);
@@ -184,46 +395,14 @@ std::shared_ptr<ControlMessage> PreprocessNLPStage<ControlMessage, ControlMessag
     auto col        = meta.get_column(0);
     auto string_col = cudf::strings_column_view{col};
 
-    auto token_results = subword_tokenize(this->m_vocab_hash_file,
-                                          this->m_sequence_length,
-                                          this->m_do_lower_case,
-                                          this->m_truncation,
-                                          string_col,
-                                          this->m_stride,
-                                          rmm::mr::get_current_device_resource());
+    auto token_results =
+        m_tokenizer->tokenize(string_col, this->m_sequence_length, this->m_truncation, this->m_stride);
 
     // Build the results
-    auto memory = std::make_shared<TensorMemory>(token_results.nrows_tensor);
-
-    TensorIndex length = token_results.tensor_token_ids->size() / token_results.sequence_length;
-    auto input_ids_released =
-        cudf::cast(token_results.tensor_token_ids->view(), cudf::data_type(cudf::type_id::INT32))->release();
-    memory->set_tensor("input_ids",
-                       Tensor::create(std::move(input_ids_released.data),
-                                      DType::create<int32_t>(),
-                                      {length, static_cast<TensorIndex>(token_results.sequence_length)},
-                                      {},
-                                      0));
-
-    length = token_results.tensor_attention_mask->size() / token_results.sequence_length;
-    auto input_mask_released =
-        cudf::cast(token_results.tensor_attention_mask->view(), cudf::data_type(cudf::type_id::INT32))->release();
-    memory->set_tensor("input_mask",
-                       Tensor::create(std::move(input_mask_released.data),
-                                      DType::create<int32_t>(),
-                                      {length, static_cast<TensorIndex>(token_results.sequence_length)},
-                                      {},
-                                      0));
+    auto memory = make_pooled<TensorMemory>(token_results.nrows_tensor);
 
-    auto tensor_index_dtype = DType::create<TensorIndex>();
-    length                  = token_results.tensor_metadata->size() / 3;
-    auto seq_ids_released =
-        cudf::cast(token_results.tensor_metadata->view(), cudf::data_type(tensor_index_dtype.cudf_type_id()))
-            ->release();
-
-    std::shared_ptr<rmm::device_buffer> seq_ids_data = std::move(seq_ids_released.data);
-
-    memory->set_tensor("seq_ids", Tensor::create(seq_ids_data, tensor_index_dtype, {length, 3}, {}, 0));
+    const auto token_dtype = this->m_uint32_tokens ? DType::create<uint32_t>() : DType::create<int32_t>();
+    set_token_tensors(*memory, std::move(token_results), token_dtype, this->m_sequence_length_buckets, 0, stream);
 
     auto next = x;
     next->tensors(memory);
@@ -231,59 +410,6 @@ std::shared_ptr<ControlMessage> PreprocessNLPStage<ControlMessage, ControlMessag
     return std::move(next);
 }
 
-template <typename InputT, typename OutputT>
-nvtext::tokenizer_result PreprocessNLPStage<InputT, OutputT>::subword_tokenize(
-    const std::string& vocab_hash_file,
-    uint32_t sequence_length,
-    bool do_lower_case,
-    bool truncation,
-    cudf::strings_column_view const& string_col,
-    int stride,
-    rmm::mr::device_memory_resource* mr)
-{
-    // Create the hashed vocab
-    thread_local std::unique_ptr<nvtext::hashed_vocabulary> vocab = nvtext::load_vocabulary_file(vocab_hash_file);
-
-    // remove leading and trailing whitespace
-    auto normalized_col      = nvtext::normalize_spaces(string_col);
-    auto normalized_col_view = cudf::strings_column_view{normalized_col->view()};
-
-    // Perform the tokenizer
-    nvtext::tokenizer_result token_results;
-
-    if (normalized_col_view.chars_size(rmm::cuda_stream_default) > 0)
-    {
-        token_results = nvtext::subword_tokenize(normalized_col_view,
-                                                 *vocab,
-                                                 sequence_length,
-                                                 stride,
-                                                 do_lower_case,
-                                                 truncation,
-                                                 rmm::mr::get_current_device_resource());
-    }
-    else
-    {
-        // workaround for a situation where the input strings contain either no characters or only
-        // whitespace
-        auto zero     = cudf::numeric_scalar<uint32_t>(0, true, rmm::cuda_stream_default);
-        auto ids      = cudf::make_column_from_scalar(zero, sequence_length * normalized_col_view.size());
-        auto mask     = cudf::make_column_from_scalar(zero, sequence_length * normalized_col_view.size());
-        auto metadata = [&]() {
-            auto iota   = cudf::sequence(normalized_col_view.size(), zero);
-            auto zeroes = cudf::make_column_from_scalar(zero, normalized_col_view.size());
-            return cudf::interleave_columns(
-                cudf::table_view{std::vector<cudf::column_view>{iota->view(), zeroes->view(), zeroes->view()}});
-        }();
-
-        token_results = nvtext::tokenizer_result{static_cast<uint32_t>(normalized_col_view.size()),
-                                                 sequence_length,
-                                                 std::move(ids),
-                                                 std::move(mask),
-                                                 std::move(metadata)};
-    }
-    return token_results;
-}
-
 template class PreprocessNLPStage<MultiMessage, MultiInferenceMessage>;
 template class PreprocessNLPStage<ControlMessage, ControlMessage>;
 
@@ -297,10 +423,35 @@ std::shared_ptr<mrc::segment::Object<PreprocessNLPStageMM>> PreprocessNLPStageIn
     bool do_lower_case,
     bool add_special_token,
     int stride,
-    std::string column)
+    std::string column,
+    bool uint32_tokens,
+    std::vector<TensorIndex> sequence_length_buckets,
+    std::shared_ptr<ITokenizer> tokenizer)
 {
+    if (tokenizer != nullptr)
+    {
+        return builder.construct_object<PreprocessNLPStageMM>(name,
+                                                              std::move(tokenizer),
+                                                              sequence_length,
+                                                              truncation,
+                                                              add_special_token,
+                                                              stride,
+                                                              column,
+                                                              uint32_tokens,
+                                                              std::move(sequence_length_buckets));
+    }
+
     auto stage = builder.construct_object<PreprocessNLPStageMM>(
-        name, vocab_hash_file, sequence_length, truncation, do_lower_case, add_special_token, stride, column);
+        name,
+        vocab_hash_file,
+        sequence_length,
+        truncation,
+        do_lower_case,
+        add_special_token,
+        stride,
+        column,
+        uint32_tokens,
+        std::move(sequence_length_buckets));
 
     return stage;
 }
@@ -314,10 +465,35 @@ std::shared_ptr<mrc::segment::Object<PreprocessNLPStageCM>> PreprocessNLPStageIn
     bool do_lower_case,
     bool add_special_token,
     int stride,
-    std::string column)
+    std::string column,
+    bool uint32_tokens,
+    std::vector<TensorIndex> sequence_length_buckets,
+    std::shared_ptr<ITokenizer> tokenizer)
 {
+    if (tokenizer != nullptr)
+    {
+        return builder.construct_object<PreprocessNLPStageCM>(name,
+                                                              std::move(tokenizer),
+                                                              sequence_length,
+                                                              truncation,
+                                                              add_special_token,
+                                                              stride,
+                                                              column,
+                                                              uint32_tokens,
+                                                              std::move(sequence_length_buckets));
+    }
+
     auto stage = builder.construct_object<PreprocessNLPStageCM>(
-        name, vocab_hash_file, sequence_length, truncation, do_lower_case, add_special_token, stride, column);
+        name,
+        vocab_hash_file,
+        sequence_length,
+        truncation,
+        do_lower_case,
+        add_special_token,
+        stride,
+        column,
+        uint32_tokens,
+        std::move(sequence_length_buckets));
 
     return stage;
 }
@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/replay_source.hpp"  // IWYU pragma: associated
+
+#include "morpheus/io/source_capture.hpp"
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <glog/logging.h>
+
+#include <algorithm>  // for min
+#include <chrono>
+#include <cstdint>  // for int64_t
+#include <exception>
+#include <optional>
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument
+#include <thread>     // for sleep_for
+#include <utility>    // for move
+
+namespace morpheus {
+
+// Component public implementations
+// ************ ReplaySourceStage ************************* //
+ReplaySourceStage::ReplaySourceStage(std::filesystem::path filename, double speed, std::size_t repeat) :
+  PythonSource(build()),
+  m_filename(std::move(filename)),
+  m_speed(speed),
+  m_repeat(repeat)
+{
+    if (m_speed < 0)
+    {
+        throw std::invalid_argument("speed must be zero or positive");
+    }
+
+    if (m_repeat == 0)
+    {
+        throw std::invalid_argument("repeat must be greater than 0");
+    }
+}
+
+ReplaySourceStage::subscriber_fn_t ReplaySourceStage::build()
+{
+    return [this](rxcpp::subscriber<source_type_t> output) {
+        using clock_t = std::chrono::steady_clock;
+
+        std::size_t num_batches  = 0;
+        int64_t num_rows_emitted = 0;
+        const auto start_time    = clock_t::now();
+
+        try
+        {
+            SourceCaptureReader reader(m_filename);
+
+            for (std::size_t pass = 0; pass < m_repeat && output.is_subscribed(); ++pass)
+            {
+                reader.rewind();
+
+                // Emission times are relative to the first batch of each pass
+                std::optional<std::chrono::system_clock::time_point> first_arrival;
+                const auto pass_start = clock_t::now();
+
+                for (auto batch = reader.next(); batch.has_value() && output.is_subscribed(); batch = reader.next())
+                {
+                    if (!first_arrival.has_value())
+                    {
+                        first_arrival = batch->arrival_time;
+                    }
+
+                    if (m_speed > 0)
+                    {
+                        const auto offset = std::chrono::duration_cast<clock_t::duration>(
+                            (batch->arrival_time - *first_arrival) / m_speed);
+                        const auto emit_time = pass_start + std::max(offset, clock_t::duration::zero());
+
+                        // Sleeps in short steps, to notice the pipeline stopping
+                        for (auto now = clock_t::now(); now < emit_time && output.is_subscribed(); now = clock_t::now())
+                        {
+                            std::this_thread::sleep_for(
+                                std::min<clock_t::duration>(emit_time - now, std::chrono::milliseconds(100)));
+                        }
+                    }
+
+                    const auto num_rows = batch->table.tbl->num_rows();
+                    MORPHEUS_TRACE("replay_source.emit", num_rows);
+
+                    output.on_next(MessageMeta::create_from_cpp(std::move(batch->table), 0, num_rows_emitted));
+
+                    num_rows_emitted += num_rows;
+                    ++num_batches;
+                }
+            }
+        } catch (...)
+        {
+            output.on_error(std::current_exception());
+            return;
+        }
+
+        const auto elapsed = std::chrono::duration<double>(clock_t::now() - start_time).count();
+        LOG(INFO) << "Replayed " << num_batches << " batches, " << num_rows_emitted << " rows, from " << m_filename
+                  << " in " << elapsed << "s (" << (elapsed > 0 ? num_rows_emitted / elapsed : 0.0) << " rows/s)";
+
+        output.on_completed();
+    };
+}
+
+// ************ ReplaySourceStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<ReplaySourceStage>> ReplaySourceStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::filesystem::path filename,
+    double speed,
+    std::size_t repeat)
+{
+    return builder.construct_object<ReplaySourceStage>(name, std::move(filename), speed, repeat);
+}
+
+}  // namespace morpheus
@@ -0,0 +1,175 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/stages/rolling_window.hpp"  // IWYU pragma: associated
+
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <glog/logging.h>
+
+#include <chrono>  // for milliseconds, nanoseconds
+#include <exception>
+#include <ostream>  // needed for glog
+#include <utility>  // for move
+
+namespace morpheus {
+
+// Component public implementations
+// ************ RollingWindowStage **************************** //
+RollingWindowStage::RollingWindowStage(std::string timestamp_column,
+                                       int64_t min_history,
+                                       int64_t min_increment,
+                                       int64_t max_history_rows,
+                                       int64_t max_history_ns,
+                                       std::size_t max_device_bytes,
+                                       std::string checkpoint_name,
+                                       std::chrono::milliseconds checkpoint_interval) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_min_history(min_history),
+  m_min_increment(min_increment),
+  m_store(std::move(timestamp_column), max_history_rows, std::chrono::nanoseconds(max_history_ns), max_device_bytes),
+  m_checkpoint(std::move(checkpoint_name), checkpoint_interval)
+{
+    m_checkpoint.restore(m_store);
+
+    auto& registry = MetricsRegistry::get_instance();
+
+    m_users_gauge =
+        registry.get_gauge("morpheus_rolling_window_users", "Number of users with a rolling window history");
+    m_device_bytes_gauge = registry.get_gauge("morpheus_rolling_window_device_bytes",
+                                              "Number of bytes held on the device by the rolling window histories");
+}
+
+RollingWindowStage::subscribe_fn_t RollingWindowStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                auto result = this->on_data(std::move(x));
+                if (result != nullptr)
+                {
+                    output.on_next(std::move(result));
+                }
+
+                m_checkpoint.maybe_save(m_store);
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [this, &output]() {
+                m_checkpoint.save(m_store);
+                m_checkpoint.wait();
+
+                output.on_completed();
+            }));
+    };
+}
+
+std::shared_ptr<ControlMessage> RollingWindowStage::on_data(std::shared_ptr<ControlMessage> message)
+{
+    const auto data_type = message->get_metadata_value<std::string>("data_type", "streaming");
+
+    // Explicit training or inference tasks already hold their rows
+    if (data_type == "payload")
+    {
+        return message;
+    }
+
+    if (data_type != "streaming")
+    {
+        LOG(ERROR) << "Unknown data type '" << data_type << "' in rolling window, discarding control message";
+        return nullptr;
+    }
+
+    const auto user_id = message->get_metadata_value<std::string>("user_id", "");
+    auto payload       = message->payload();
+
+    if (user_id.empty() || payload == nullptr)
+    {
+        LOG(ERROR) << "Rolling window requires a payload and a user_id, discarding control message";
+        return nullptr;
+    }
+
+    std::shared_ptr<MessageMeta> window;
+
+    try
+    {
+        switch (m_store.append(user_id, *payload))
+        {
+        case HistoryAppendStatus::PRECEDES_HISTORY:
+            LOG(WARNING) << "Incoming data for " << user_id << " preceded existing history, discarding control message";
+            return nullptr;
+        case HistoryAppendStatus::OVERLAPS_HISTORY:
+            LOG(ERROR) << "Overlapping rolling history detected for " << user_id
+                       << ". Rolling history can only be used with non-overlapping batches, discarding control message";
+            return nullptr;
+        case HistoryAppendStatus::APPENDED:
+        case HistoryAppendStatus::NOTHING_NEW:
+            break;
+        }
+
+        m_users_gauge->set(static_cast<double>(m_store.num_users()));
+        m_device_bytes_gauge->set(static_cast<double>(m_store.device_bytes()));
+
+        if (m_store.count(user_id) < m_min_history || m_store.pending_count(user_id) < m_min_increment)
+        {
+            return nullptr;
+        }
+
+        window = m_store.window(user_id);
+    } catch (const std::exception& e)
+    {
+        LOG(ERROR) << "Error processing control message in rolling window: " << e.what()
+                   << ". Discarding control message.";
+        return nullptr;
+    }
+
+    MORPHEUS_TRACE("rolling_window.window", payload->count(), window->count());
+    DVLOG(10) << "Rolling window complete for " << user_id << ". Input: " << payload->count()
+              << " rows. Output: " << window->count() << " rows";
+
+    message->payload(window);
+    message->set_metadata("data_type", "payload");
+
+    return message;
+}
+
+// ************ RollingWindowStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<RollingWindowStage>> RollingWindowStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string timestamp_column,
+    int64_t min_history,
+    int64_t min_increment,
+    int64_t max_history_rows,
+    int64_t max_history_ns,
+    std::size_t max_device_bytes,
+    std::size_t checkpoint_interval_ms)
+{
+    return builder.construct_object<RollingWindowStage>(name,
+                                                        std::move(timestamp_column),
+                                                        min_history,
+                                                        min_increment,
+                                                        max_history_rows,
+                                                        max_history_ns,
+                                                        max_device_bytes,
+                                                        name,
+                                                        std::chrono::milliseconds(checkpoint_interval_ms));
+}
+}  // namespace morpheus
@@ -22,22 +22,44 @@
 
 #include "morpheus/messages/meta.hpp"
 #include "morpheus/objects/table_info.hpp"  // for TableInfo
+#include "morpheus/types.hpp"                // for TensorIndex
+#include "morpheus/utilities/nvtx_util.hpp"  // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
 
+#include <cstddef>  // for size_t
 #include <exception>
+#include <functional>  // for hash
 #include <memory>
 #include <string>
 #include <type_traits>  // for is_same_v
 #include <utility>      // for move
+#include <vector>
 
 // IWYU thinks basic_stringbuf & map are needed for the regex constructor
 // IWYU pragma: no_include <map>
 // IWYU pragma: no_include <sstream>
 
 namespace morpheus {
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "SerializeStage");
+
+[[maybe_unused]] TensorIndex get_row_count(const std::shared_ptr<MultiMessage>& message)
+{
+    return message->mess_count;
+}
+
+[[maybe_unused]] TensorIndex get_row_count(const std::shared_ptr<ControlMessage>& message)
+{
+    auto payload = message->payload();
+    return payload ? payload->count() : 0;
+}
+}  // namespace
 
 constexpr std::regex_constants::syntax_option_type RegexOptions =
     std::regex_constants::ECMAScript | std::regex_constants::icase;
 
+// Bounds the plans kept for a stream of messages whose schemas keep changing
+constexpr std::size_t MaxColumnPlans = 64;
+
 template <typename InputT>
 SerializeStage<InputT>::SerializeStage(const std::vector<std::string>& include,
                                        const std::vector<std::string>& exclude,
@@ -91,6 +113,41 @@ bool SerializeStage<InputT>::exclude_column(const std::string& column) const
     return match_column(m_exclude, column);
 }
 
+template <typename InputT>
+const std::vector<std::string>& SerializeStage<InputT>::resolve_columns(const std::vector<std::string>& column_names)
+{
+    std::size_t key = column_names.size();
+    for (const auto& c : column_names)
+    {
+        key ^= std::hash<std::string>{}(c) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    }
+
+    auto found = m_column_plans.find(key);
+    if (found != m_column_plans.end() && found->second.input_columns == column_names)
+    {
+        return found->second.columns;
+    }
+
+    if (m_column_plans.size() >= MaxColumnPlans)
+    {
+        m_column_plans.clear();
+    }
+
+    ColumnPlan plan{column_names, {}};
+    for (const auto& c : column_names)
+    {
+        if (include_column(c) && !exclude_column(c))
+        {
+            plan.columns.push_back(c);
+        }
+    }
+
+    auto& cached = m_column_plans[key];
+    cached       = std::move(plan);
+
+    return cached.columns;
+}
+
 template <typename InputT>
 std::shared_ptr<SlicedMessageMeta> SerializeStage<InputT>::get_meta(sink_type_t& msg)
 {
@@ -99,8 +156,6 @@ std::shared_ptr<SlicedMessageMeta> SerializeStage<InputT>::get_meta(sink_type_t&
     // The Python impl appears to have the same behavior.
     if (!m_fixed_columns || m_column_names.empty())
     {
-        m_column_names.clear();
-
         std::vector<std::string> column_names;
 
         if constexpr (std::is_same_v<InputT, MultiMessage>)
@@ -112,13 +167,7 @@ std::shared_ptr<SlicedMessageMeta> SerializeStage<InputT>::get_meta(sink_type_t&
             column_names = msg->payload()->get_info().get_column_names();
         }
 
-        for (const auto& c : column_names)
-        {
-            if (include_column(c) && !exclude_column(c))
-            {
-                m_column_names.push_back(c);
-            }
-        }
+        m_column_names = resolve_columns(column_names);
     }
 
     if constexpr (std::is_same_v<InputT, MultiMessage>)
@@ -138,7 +187,11 @@ SerializeStage<InputT>::subscribe_fn_t SerializeStage<InputT>::build_operator()
     return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
         return input.subscribe(rxcpp::make_observer<sink_type_t>(
             [this, &output](sink_type_t msg) {
-                auto next_meta = this->get_meta(msg);
+                std::shared_ptr<SlicedMessageMeta> next_meta;
+                {
+                    MORPHEUS_NVTX_RANGE(NvtxDomain, "get_meta", get_row_count(msg));
+                    next_meta = this->get_meta(msg);
+                }
 
                 output.on_next(std::move(next_meta));
             },
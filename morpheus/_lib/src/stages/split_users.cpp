@@ -0,0 +1,273 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/stages/split_users.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/table_info.hpp"
+#include "morpheus/stages/deserialize.hpp"      // for coalesce_message_metas
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/table_util.hpp"    // for CuDFTableUtil
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cuda_runtime.h>                    // for cudaMemcpy, cudaMemcpyHostToDevice
+#include <cudf/column/column_factories.hpp>  // for make_numeric_column
+#include <cudf/copying.hpp>                  // for gather
+#include <cudf/dictionary/dictionary_column_view.hpp>
+#include <cudf/dictionary/encode.hpp>  // for decode
+#include <cudf/groupby.hpp>
+#include <cudf/io/types.hpp>  // for table_with_metadata
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+
+#include <algorithm>  // for find, stable_sort
+#include <exception>
+#include <iterator>   // for distance
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move
+
+namespace morpheus {
+
+std::vector<std::pair<std::string, std::shared_ptr<MessageMeta>>> split_by_user(
+    const std::shared_ptr<MessageMeta>& meta, const std::string& userid_column)
+{
+    std::vector<std::pair<std::string, std::shared_ptr<MessageMeta>>> splits;
+
+    auto info               = meta->get_info();
+    const auto column_names = info.get_column_names();
+    auto found              = std::find(column_names.begin(), column_names.end(), userid_column);
+
+    if (found == column_names.end())
+    {
+        throw std::invalid_argument(
+            MORPHEUS_CONCAT_STR("Unable to find the user id column '" << userid_column << "'"));
+    }
+
+    const cudf::size_type user_col_idx = info.num_indices() + std::distance(column_names.begin(), found);
+    const auto view                    = info.get_view();
+
+    const auto user_type = view.column(user_col_idx).type().id();
+    const bool is_dictionary =
+        user_type == cudf::type_id::DICTIONARY32 &&
+        cudf::dictionary_column_view{view.column(user_col_idx)}.keys_type().id() == cudf::type_id::STRING;
+
+    if (user_type != cudf::type_id::STRING && !is_dictionary)
+    {
+        throw std::invalid_argument(
+            MORPHEUS_CONCAT_STR("The user id column '" << userid_column << "' must be a string column"));
+    }
+
+    if (view.num_rows() == 0)
+    {
+        return splits;
+    }
+
+    // Sorts the rows by user id once, the rows of the i-th user being [offsets[i], offsets[i + 1]) of the grouped
+    // values. Rows with a null user id are sorted past the last offset
+    cudf::groupby::groupby grouper(cudf::table_view{{view.column(user_col_idx)}}, cudf::null_policy::EXCLUDE);
+    auto groups = grouper.get_groups(view);
+
+    const auto num_users = static_cast<cudf::size_type>(groups.offsets.size()) - 1;
+
+    if (num_users <= 0)
+    {
+        return splits;
+    }
+
+    // Only the first key of each user is copied to the host
+    auto first_rows = cudf::make_numeric_column(cudf::data_type{cudf::type_to_id<cudf::size_type>()}, num_users);
+    MRC_CHECK_CUDA(cudaMemcpy(first_rows->mutable_view().data<cudf::size_type>(),
+                              groups.offsets.data(),
+                              num_users * sizeof(cudf::size_type),
+                              cudaMemcpyHostToDevice));
+
+    // Dictionary encoded user ids are grouped by index, only the first key of each user being decoded
+    auto first_keys = std::move(cudf::gather(groups.keys->view(), first_rows->view())->release()[0]);
+    if (is_dictionary)
+    {
+        first_keys = cudf::dictionary::decode(cudf::dictionary_column_view{first_keys->view()});
+    }
+
+    auto user_ids = CuDFTableUtil::copy_strings_to_host(first_keys->view());
+
+    // Wraps the grouped table without going through python, keeping the index columns as the index
+    cudf::io::table_with_metadata grouped{std::move(groups.values)};
+    for (const auto& name : info.get_index_names())
+    {
+        grouped.metadata.schema_info.emplace_back(name);
+    }
+    for (const auto& name : column_names)
+    {
+        grouped.metadata.schema_info.emplace_back(name);
+    }
+
+    auto grouped_meta = MessageMeta::create_from_cpp(std::move(grouped), info.num_indices());
+
+    splits.reserve(num_users);
+    for (cudf::size_type i = 0; i < num_users; ++i)
+    {
+        auto user_meta = std::make_shared<SlicedMessageMeta>(grouped_meta, groups.offsets[i], groups.offsets[i + 1]);
+        splits.emplace_back(std::move(user_ids[i]), std::move(user_meta));
+    }
+
+    return splits;
+}
+
+// Component public implementations
+// ************ SplitUsersStage ******************************* //
+SplitUsersStage::SplitUsersStage(std::string userid_column,
+                                 std::string fallback_username,
+                                 bool include_generic,
+                                 bool include_individual,
+                                 const std::vector<std::string>& skip_users,
+                                 const std::vector<std::string>& only_users) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_userid_column(std::move(userid_column)),
+  m_fallback_username(std::move(fallback_username)),
+  m_include_generic(include_generic),
+  m_include_individual(include_individual),
+  m_skip_users(skip_users.begin(), skip_users.end()),
+  m_only_users(only_users.begin(), only_users.end())
+{}
+
+SplitUsersStage::subscribe_fn_t SplitUsersStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                for (auto& message : this->on_data(x))
+                {
+                    output.on_next(std::move(message));
+                }
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&output]() {
+                output.on_completed();
+            }));
+    };
+}
+
+bool SplitUsersStage::is_kept(const std::string& user_id) const
+{
+    return !m_skip_users.contains(user_id) && (m_only_users.empty() || m_only_users.contains(user_id));
+}
+
+std::vector<std::shared_ptr<ControlMessage>> SplitUsersStage::on_data(const std::shared_ptr<ControlMessage>& message)
+{
+    std::vector<std::shared_ptr<ControlMessage>> output_messages;
+
+    auto payload = message->payload();
+    if (payload == nullptr)
+    {
+        LOG(ERROR) << "No payload to extract users from, discarding control message";
+        return output_messages;
+    }
+
+    const bool is_filtered = !m_skip_users.empty() || !m_only_users.empty();
+
+    std::vector<std::pair<std::string, std::shared_ptr<MessageMeta>>> splits;
+
+    try
+    {
+        // The generic message is the payload itself, unless some users are filtered out
+        if (m_include_individual || (m_include_generic && is_filtered))
+        {
+            splits = split_by_user(payload, m_userid_column);
+            std::erase_if(splits, [this](const auto& split) {
+                return !this->is_kept(split.first);
+            });
+        }
+
+        std::vector<std::pair<std::string, std::shared_ptr<MessageMeta>>> user_metas;
+
+        if (m_include_generic && !m_skip_users.contains(m_fallback_username))
+        {
+            if (!is_filtered)
+            {
+                user_metas.emplace_back(m_fallback_username, payload);
+            }
+            else if (!splits.empty())
+            {
+                std::vector<std::shared_ptr<MessageMeta>> metas;
+                metas.reserve(splits.size());
+                for (const auto& [user_id, meta] : splits)
+                {
+                    metas.push_back(meta);
+                }
+
+                user_metas.emplace_back(m_fallback_username, coalesce_message_metas(metas));
+            }
+        }
+
+        if (m_include_individual)
+        {
+            user_metas.insert(user_metas.end(), splits.begin(), splits.end());
+        }
+
+        // The individual users are already sorted, only the generic message may need to move
+        std::stable_sort(user_metas.begin(), user_metas.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+
+        output_messages.reserve(user_metas.size());
+        for (auto& [user_id, meta] : user_metas)
+        {
+            auto user_message = std::make_shared<ControlMessage>(*message);
+            user_message->set_metadata("user_id", user_id);
+            user_message->payload(std::move(meta));
+
+            output_messages.push_back(std::move(user_message));
+        }
+    } catch (const std::exception& e)
+    {
+        LOG(ERROR) << "Error extracting users from message, discarding control message: " << e.what();
+        output_messages.clear();
+        return output_messages;
+    }
+
+    MORPHEUS_TRACE("split_users.split", payload->count(), output_messages.size());
+    DVLOG(10) << "Batch split users complete. Input: " << payload->count()
+              << " rows. Output: " << output_messages.size() << " users";
+
+    return output_messages;
+}
+
+// ************ SplitUsersStageInterfaceProxy **************** //
+std::shared_ptr<mrc::segment::Object<SplitUsersStage>> SplitUsersStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string userid_column,
+    std::string fallback_username,
+    bool include_generic,
+    bool include_individual,
+    const std::vector<std::string>& skip_users,
+    const std::vector<std::string>& only_users)
+{
+    return builder.construct_object<SplitUsersStage>(name,
+                                                     std::move(userid_column),
+                                                     std::move(fallback_username),
+                                                     include_generic,
+                                                     include_individual,
+                                                     skip_users,
+                                                     only_users);
+}
+}  // namespace morpheus
@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/stages/timestamp.hpp"  // IWYU pragma: associated
+
+#include <chrono>  // for system_clock
+#include <exception>
+#include <utility>  // for move
+
+namespace morpheus {
+namespace {
+void stamp(MessageMeta& message, timestamp_key_t key, time_point_t now)
+{
+    message.set_timestamp(key, now);
+}
+
+void stamp(MultiMessage& message, timestamp_key_t key, time_point_t now)
+{
+    message.meta->set_timestamp(key, now);
+}
+
+void stamp(ControlMessage& message, timestamp_key_t key, time_point_t now)
+{
+    message.set_timestamp(key, now);
+}
+
+const MessageTimestamps& get_timestamps(const MessageMeta& message)
+{
+    return message.timestamps();
+}
+
+const MessageTimestamps& get_timestamps(const MultiMessage& message)
+{
+    return message.meta->timestamps();
+}
+
+const MessageTimestamps& get_timestamps(const ControlMessage& message)
+{
+    return message.timestamps();
+}
+}  // namespace
+
+// Component public implementations
+// ************ TimestampStage **************************** //
+template <typename MessageT>
+TimestampStage<MessageT>::TimestampStage(std::string stage_name, bool is_exit, std::size_t sample_interval) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_key(TimestampKeys::intern(is_exit ? TimestampKeys::exit_key(stage_name) : TimestampKeys::entry_key(stage_name))),
+  m_sample_interval(sample_interval)
+{
+    if (m_sample_interval > 0)
+    {
+        m_exporter = std::make_unique<TimestampTraceExporter>(std::move(stage_name));
+    }
+}
+
+template <typename MessageT>
+typename TimestampStage<MessageT>::subscribe_fn_t TimestampStage<MessageT>::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                const auto now = std::chrono::system_clock::now();
+                stamp(*x, m_key, now);
+
+                if (m_exporter != nullptr &&
+                    m_message_count.fetch_add(1, std::memory_order_relaxed) % m_sample_interval == 0)
+                {
+                    m_exporter->record(get_timestamps(*x).entries(), now);
+                }
+
+                output.on_next(std::move(x));
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&output]() {
+                output.on_completed();
+            }));
+    };
+}
+
+template class TimestampStage<MessageMeta>;
+template class TimestampStage<MultiMessage>;
+template class TimestampStage<ControlMessage>;
+
+// ************ TimestampStageInterfaceProxy ************* //
+template <typename MessageT>
+std::shared_ptr<mrc::segment::Object<TimestampStage<MessageT>>> TimestampStageInterfaceProxy<MessageT>::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string stage_name,
+    bool is_exit,
+    std::size_t sample_interval)
+{
+    return builder.construct_object<TimestampStage<MessageT>>(name, std::move(stage_name), is_exit, sample_interval);
+}
+
+template struct TimestampStageInterfaceProxy<MessageMeta>;
+template struct TimestampStageInterfaceProxy<MultiMessage>;
+template struct TimestampStageInterfaceProxy<ControlMessage>;
+}  // namespace morpheus
@@ -17,28 +17,44 @@
 
 #include "morpheus/stages/triton_inference.hpp"
 
-#include "morpheus/objects/dtype.hpp"          // for DType
+#include "morpheus/objects/dev_mem_info.hpp"      // for DevMemInfo
+#include "morpheus/objects/device_resources.hpp"  // for DeviceResources
+#include "morpheus/objects/dtype.hpp"             // for DType
+#include "morpheus/objects/memory_descriptor.hpp"
+#include "morpheus/objects/pinned_staging_pool.hpp"
 #include "morpheus/objects/tensor.hpp"         // for Tensor::create
 #include "morpheus/objects/tensor_object.hpp"  // for TensorObject
 #include "morpheus/objects/triton_in_out.hpp"  // for TritonInOut
 #include "morpheus/types.hpp"                  // for TensorIndex, TensorMap
+#include "morpheus/utilities/matx_util.hpp"    // for MatxUtil
 #include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
 #include "morpheus/utilities/tensor_util.hpp"  // for get_elem_count
 
-#include <cuda_runtime.h>  // for cudaMemcpy, cudaMemcpy2D, cudaMemcpyDeviceToHost, cudaMemcpyHostToDevice
+#include <cuda_runtime.h>  // for cudaMemcpyAsync, cudaHostGetDevicePointer, cudaMemcpyHostToDevice
 #include <glog/logging.h>
+#include <grpc_client.h>
 #include <http_client.h>
+#include <mrc/coroutines/scheduler.hpp>
+#include <mrc/coroutines/when_all.hpp>
 #include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
 #include <nlohmann/json.hpp>
-#include <rmm/cuda_stream_view.hpp>  // for cuda_stream_per_thread
-#include <rmm/device_buffer.hpp>     // for device_buffer
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>  // for device_buffer
+#include <rmm/device_uvector.hpp>
+#include <rmm/mr/device/cuda_memory_resource.hpp>
 
-#include <algorithm>  // for min
+#include <unistd.h>  // for getpid
+
+#include <algorithm>  // for find, max, min, transform
+#include <chrono>
 #include <coroutine>
 #include <cstddef>
+#include <cstring>  // for memcpy
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <stdexcept>  // for runtime_error, out_of_range
 #include <string>
@@ -79,9 +95,91 @@ void InferenceClientStage__check_triton_errors(triton::client::Error status,
 using namespace morpheus;
 using buffer_map_t = std::map<std::string, std::shared_ptr<rmm::device_buffer>>;
 
-static bool is_default_grpc_port(std::string& server_url)
+// Alignment of each input within a shared memory region
+constexpr std::size_t SharedMemoryAlignment = 256;
+
+// Registered output buffers beyond which idle registrations are removed from Triton
+constexpr std::size_t MaxOutputRegistrations = 32;
+
+// Allocates each buffer with its own `cudaMalloc`, IPC handles refer to the start of an allocation
+static cuda::mr::async_resource_ref<cuda::mr::device_accessible> ipc_memory_resource()
 {
-    // Check if we are the default gRPC port of 8001 and try 8000 for http client instead
+    static rmm::mr::cuda_memory_resource resource;
+    return &resource;
+}
+
+// Queries and parses the metadata and config of a model
+static std::shared_ptr<const TritonModelInfo> load_model_info(ITritonClient& client, const std::string& model_name)
+{
+    auto model_info = std::make_shared<TritonModelInfo>();
+
+    std::string model_metadata_json;
+    CHECK_TRITON(client.model_metadata(&model_metadata_json, model_name));
+
+    auto model_metadata = nlohmann::json::parse(model_metadata_json);
+
+    std::string model_config_json;
+    CHECK_TRITON(client.model_config(&model_config_json, model_name));
+    auto model_config = nlohmann::json::parse(model_config_json);
+
+    if (model_config.contains("max_batch_size"))
+    {
+        model_info->max_batch_size = model_config.at("max_batch_size").get<TensorIndex>();
+    }
+
+    for (auto const& input : model_metadata.at("inputs"))
+    {
+        auto shape = input.at("shape").get<ShapeType>();
+
+        auto dtype = DType::from_triton(input.at("datatype").get<std::string>());
+
+        size_t bytes = dtype.item_size();
+
+        for (auto& y : shape)
+        {
+            if (y == -1)
+            {
+                y = model_info->max_batch_size;
+            }
+
+            bytes *= y;
+        }
+
+        model_info->inputs.push_back(TritonInOut{input.at("name").get<std::string>(),
+                                                 bytes,
+                                                 DType::from_triton(input.at("datatype").get<std::string>()),
+                                                 shape,
+                                                 "",
+                                                 0});
+    }
+
+    for (auto const& output : model_metadata.at("outputs"))
+    {
+        auto shape = output.at("shape").get<ShapeType>();
+
+        auto dtype = DType::from_triton(output.at("datatype").get<std::string>());
+
+        size_t bytes = dtype.item_size();
+
+        for (auto& y : shape)
+        {
+            if (y == -1)
+            {
+                y = model_info->max_batch_size;
+            }
+
+            bytes *= y;
+        }
+
+        model_info->outputs.push_back(TritonInOut{output.at("name").get<std::string>(), bytes, dtype, shape, "", 0});
+    }
+
+    return model_info;
+}
+
+static bool replace_default_port(std::string& server_url, const std::string& port, const std::string& new_port)
+{
+    // Check if we are the default port of the other protocol and try the default port of this one instead
     size_t colon_loc = server_url.find_last_of(':');
 
     if (colon_loc == -1)
@@ -89,18 +187,162 @@ static bool is_default_grpc_port(std::string& server_url)
         return false;
     }
 
-    // Check if the port matches 8001
-    if (server_url.size() < colon_loc + 1 || server_url.substr(colon_loc + 1) != "8001")
+    // Check if the port matches
+    if (server_url.size() < colon_loc + 1 || server_url.substr(colon_loc + 1) != port)
     {
         return false;
     }
 
-    // It matches, change to 8000
-    server_url = server_url.substr(0, colon_loc) + ":8000";
+    // It matches, change to the new port
+    server_url = server_url.substr(0, colon_loc) + ":" + new_port;
 
     return true;
 }
 
+static bool is_default_grpc_port(std::string& server_url)
+{
+    return replace_default_port(server_url, "8001", "8000");
+}
+
+static bool is_default_http_port(std::string& server_url)
+{
+    return replace_default_port(server_url, "8000", "8001");
+}
+
+// Creates the Triton inputs, reading from the shared memory region when one is set, the returned pointers are owned
+// by `owned_inputs`
+std::vector<triton::client::InferInput*> make_infer_inputs(
+    const std::vector<TritonInferInput>& inputs, std::vector<std::unique_ptr<triton::client::InferInput>>& owned_inputs)
+{
+    std::vector<triton::client::InferInput*> inference_input_ptrs;
+
+    for (auto& input : inputs)
+    {
+        triton::client::InferInput* inference_input_ptr;
+        CHECK_TRITON(triton::client::InferInput::Create(&inference_input_ptr, input.name, input.shape, input.type));
+        owned_inputs.emplace_back(inference_input_ptr);
+
+        if (!input.shared_memory_region.empty())
+        {
+            CHECK_TRITON(inference_input_ptr->SetSharedMemory(
+                input.shared_memory_region, input.shared_memory_bytes, input.shared_memory_offset));
+        }
+        else
+        {
+            inference_input_ptr->AppendRaw(reinterpret_cast<const uint8_t*>(input.data->data()), input.data->size());
+        }
+
+        inference_input_ptrs.emplace_back(inference_input_ptr);
+    }
+
+    return inference_input_ptrs;
+}
+
+// Creates the Triton requested outputs, written to the shared memory region when one is set, the returned pointers
+// are owned by `owned_outputs`
+std::vector<const triton::client::InferRequestedOutput*> make_infer_outputs(
+    const std::vector<TritonInferRequestedOutput>& outputs,
+    std::vector<std::unique_ptr<const triton::client::InferRequestedOutput>>& owned_outputs)
+{
+    std::vector<const triton::client::InferRequestedOutput*> inference_output_ptrs;
+
+    for (auto& output : outputs)
+    {
+        triton::client::InferRequestedOutput* inference_output_ptr;
+        CHECK_TRITON(triton::client::InferRequestedOutput::Create(&inference_output_ptr, output.name));
+        owned_outputs.emplace_back(inference_output_ptr);
+
+        if (!output.shared_memory_region.empty())
+        {
+            CHECK_TRITON(inference_output_ptr->SetSharedMemory(
+                output.shared_memory_region, output.shared_memory_bytes, output.shared_memory_offset));
+        }
+
+        inference_output_ptrs.emplace_back(inference_output_ptr);
+    }
+
+    return inference_output_ptrs;
+}
+
+// Sends a request with either the HTTP or the gRPC client, which share the same inference API
+template <typename ClientT>
+triton::client::Error infer_with_client(ClientT& client,
+                                        bool use_async_infer,
+                                        triton::client::InferenceServerHttpClient::OnCompleteFn callback,
+                                        const triton::client::InferOptions& options,
+                                        const std::vector<TritonInferInput>& inputs,
+                                        const std::vector<TritonInferRequestedOutput>& outputs)
+{
+    using inputs_t  = std::vector<std::unique_ptr<triton::client::InferInput>>;
+    using outputs_t = std::vector<std::unique_ptr<const triton::client::InferRequestedOutput>>;
+
+    auto inference_inputs  = std::make_shared<inputs_t>();
+    auto inference_outputs = std::make_shared<outputs_t>();
+
+    auto inference_input_ptrs  = make_infer_inputs(inputs, *inference_inputs);
+    auto inference_output_ptrs = make_infer_outputs(outputs, *inference_outputs);
+
+    if (use_async_infer)
+    {
+        // The inputs and outputs are kept alive until the request completes, the data they point to is owned by the
+        // awaiting batch
+        return client.AsyncInfer(
+            [callback, inference_inputs, inference_outputs](triton::client::InferResult* result) {
+                callback(result);
+            },
+            options,
+            inference_input_ptrs,
+            inference_output_ptrs);
+    }
+
+    triton::client::InferResult* result = nullptr;
+
+    auto status = client.Infer(&result, options, inference_input_ptrs, inference_output_ptrs);
+
+    // As with asynchronous requests, the callback is only called for requests which were sent
+    if (status.IsOk())
+    {
+        callback(result);
+    }
+
+    return status;
+}
+
+// Converts tensor metadata of the gRPC protocol to the JSON returned by the HTTP protocol
+nlohmann::json tensor_metadata_to_json(
+    const google::protobuf::RepeatedPtrField<inference::ModelMetadataResponse_TensorMetadata>& tensors)
+{
+    auto result = nlohmann::json::array();
+
+    for (const auto& tensor : tensors)
+    {
+        result.push_back({{"name", tensor.name()},
+                          {"datatype", tensor.datatype()},
+                          {"shape", std::vector<int64_t>(tensor.shape().begin(), tensor.shape().end())}});
+    }
+
+    return result;
+}
+
+// Converts a duration of the gRPC inference statistics to the JSON returned by the HTTP protocol
+nlohmann::json statistic_duration_to_json(const inference::StatisticDuration& duration)
+{
+    return {{"count", duration.count()}, {"ns", duration.ns()}};
+}
+
+double seconds_between(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point stop)
+{
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+bool is_token_output_of(const TritonRaggedBatching& ragged_batching, const std::string& output_name)
+{
+    return std::find(ragged_batching.token_outputs.begin(), ragged_batching.token_outputs.end(), output_name) !=
+           ragged_batching.token_outputs.end();
+}
+
+// Awaits an asynchronous inference. The awaiting coroutine is resumed on `m_on`, the completion callback runs on the
+// client's thread and would otherwise serialize the handling of every response behind it.
 struct TritonInferOperation
 {
     bool await_ready() const noexcept
@@ -113,7 +355,8 @@ struct TritonInferOperation
         CHECK_TRITON(m_client.async_infer(
             [this, handle](triton::client::InferResult* result) {
                 m_result.reset(result);
-                handle();
+                m_completed_at = std::chrono::steady_clock::now();
+                m_on->resume(handle);
             },
             m_options,
             m_inputs,
@@ -129,6 +372,8 @@ struct TritonInferOperation
     triton::client::InferOptions const& m_options;
     std::vector<TritonInferInput> const& m_inputs;
     std::vector<TritonInferRequestedOutput> const& m_outputs;
+    std::shared_ptr<mrc::coroutines::Scheduler> m_on;
+    std::chrono::steady_clock::time_point& m_completed_at;  // Time the client completed the request
     std::unique_ptr<triton::client::InferResult> m_result;
 };
 
@@ -136,6 +381,29 @@ struct TritonInferOperation
 
 namespace morpheus {
 
+bool ITritonClient::uses_cuda_shared_memory() const
+{
+    return false;
+}
+
+triton::client::Error ITritonClient::register_cuda_shared_memory(const std::string& name,
+                                                                 const cudaIpcMemHandle_t& handle,
+                                                                 std::size_t device_id,
+                                                                 std::size_t byte_size)
+{
+    return triton::client::Error("CUDA shared memory is not supported by this client");
+}
+
+triton::client::Error ITritonClient::unregister_cuda_shared_memory(const std::string& name)
+{
+    return triton::client::Error("CUDA shared memory is not supported by this client");
+}
+
+triton::client::Error ITritonClient::model_inference_statistics(std::string* statistics, std::string& model_name)
+{
+    return triton::client::Error("Inference statistics are not supported by this client");
+}
+
 HttpTritonClient::HttpTritonClient(std::string server_url)
 {
     std::unique_ptr<triton::client::InferenceServerHttpClient> client;
@@ -208,62 +476,171 @@ triton::client::Error HttpTritonClient::model_metadata(std::string* model_metada
     return m_client->ModelMetadata(model_metadata, model_name);
 }
 
+triton::client::Error HttpTritonClient::model_inference_statistics(std::string* statistics, std::string& model_name)
+{
+    return m_client->ModelInferenceStatistics(statistics, model_name);
+}
+
 triton::client::Error HttpTritonClient::async_infer(triton::client::InferenceServerHttpClient::OnCompleteFn callback,
                                                     const triton::client::InferOptions& options,
                                                     const std::vector<TritonInferInput>& inputs,
                                                     const std::vector<TritonInferRequestedOutput>& outputs)
 {
-    std::vector<std::unique_ptr<triton::client::InferInput>> inference_inputs;
-    std::vector<triton::client::InferInput*> inference_input_ptrs;
+    // TODO(cwharris): either fix tests or make this ENV-flagged, as AsyncInfer gives different results.
+    return infer_with_client(*m_client, false, std::move(callback), options, inputs, outputs);
+}
 
-    for (auto& input : inputs)
+GrpcTritonClient::GrpcTritonClient(std::string server_url, bool use_cuda_shared_memory, bool use_async_infer) :
+  m_use_cuda_shared_memory(use_cuda_shared_memory),
+  m_use_async_infer(use_async_infer)
+{
+    std::unique_ptr<triton::client::InferenceServerGrpcClient> client;
+
+    CHECK_TRITON(triton::client::InferenceServerGrpcClient::Create(&client, server_url, false));
+
+    bool is_server_live;
+
+    auto status = client->IsServerLive(&is_server_live);
+
+    if (not status.IsOk())
     {
-        triton::client::InferInput* inference_input_ptr;
-        triton::client::InferInput::Create(&inference_input_ptr, input.name, input.shape, input.type);
+        std::string new_server_url = server_url;
+        if (is_default_http_port(new_server_url))
+        {
+            LOG(WARNING) << "Failed to connect to Triton at '" << server_url
+                         << "'. Default HTTP port of (8000) was detected but the gRPC client is in use. Retrying with "
+                            "default gRPC port (8001)";
 
-        inference_input_ptr->AppendRaw(input.data);
+            std::unique_ptr<triton::client::InferenceServerGrpcClient> unique_client;
 
-        inference_input_ptrs.emplace_back(inference_input_ptr);
-        inference_inputs.emplace_back(inference_input_ptr);
+            CHECK_TRITON(triton::client::InferenceServerGrpcClient::Create(&unique_client, new_server_url, false));
+
+            client = std::move(unique_client);
+
+            status = client->IsServerLive(&is_server_live);
+        }
+
+        if (not status.IsOk())
+            throw std::runtime_error(
+                MORPHEUS_CONCAT_STR("Unable to connect to Triton at '"
+                                    << server_url << "'. Check the URL and port and ensure the server is running."));
     }
 
-    std::vector<std::unique_ptr<const triton::client::InferRequestedOutput>> inference_outputs;
-    std::vector<const triton::client::InferRequestedOutput*> inference_output_ptrs;
+    m_client = std::move(client);
+}
 
-    for (auto& output : outputs)
+triton::client::Error GrpcTritonClient::is_server_live(bool* live)
+{
+    return m_client->IsServerLive(live);
+}
+
+triton::client::Error GrpcTritonClient::is_server_ready(bool* ready)
+{
+    return m_client->IsServerReady(ready);
+}
+
+triton::client::Error GrpcTritonClient::is_model_ready(bool* ready, std::string& model_name)
+{
+    return m_client->IsModelReady(ready, model_name);
+}
+
+triton::client::Error GrpcTritonClient::model_config(std::string* model_config, std::string& model_name)
+{
+    inference::ModelConfigResponse response;
+
+    auto status = m_client->ModelConfig(&response, model_name);
+    if (status.IsOk())
     {
-        triton::client::InferRequestedOutput* inference_output_ptr;
-        triton::client::InferRequestedOutput::Create(&inference_output_ptr, output.name);
-        inference_output_ptrs.emplace_back(inference_output_ptr);
-        inference_outputs.emplace_back(inference_output_ptr);
+        // The session only reads the max batch size of the config
+        *model_config = nlohmann::json{{"max_batch_size", response.config().max_batch_size()}}.dump();
     }
 
-    triton::client::InferResult* result;
+    return status;
+}
 
-    auto status = m_client->Infer(&result, options, inference_input_ptrs, inference_output_ptrs);
+triton::client::Error GrpcTritonClient::model_metadata(std::string* model_metadata, std::string& model_name)
+{
+    inference::ModelMetadataResponse response;
 
-    callback(result);
+    auto status = m_client->ModelMetadata(&response, model_name);
+    if (status.IsOk())
+    {
+        // Converted by hand, the protobuf JSON mapping encodes the 64 bit dimensions of the shapes as strings
+        *model_metadata = nlohmann::json{{"name", response.name()},
+                                         {"platform", response.platform()},
+                                         {"inputs", tensor_metadata_to_json(response.inputs())},
+                                         {"outputs", tensor_metadata_to_json(response.outputs())}}
+                              .dump();
+    }
 
     return status;
+}
 
-    // TODO(cwharris): either fix tests or make this ENV-flagged, as AsyncInfer gives different results.
+triton::client::Error GrpcTritonClient::model_inference_statistics(std::string* statistics, std::string& model_name)
+{
+    inference::ModelStatisticsResponse response;
+
+    auto status = m_client->ModelInferenceStatistics(&response, model_name);
+    if (status.IsOk())
+    {
+        // Only the durations read by the session are converted
+        auto model_stats = nlohmann::json::array();
+        for (const auto& model : response.model_stats())
+        {
+            const auto& stats = model.inference_stats();
+            model_stats.push_back({{"name", model.name()},
+                                   {"version", model.version()},
+                                   {"inference_stats",
+                                    {{"success", statistic_duration_to_json(stats.success())},
+                                     {"fail", statistic_duration_to_json(stats.fail())},
+                                     {"queue", statistic_duration_to_json(stats.queue())},
+                                     {"compute_input", statistic_duration_to_json(stats.compute_input())},
+                                     {"compute_infer", statistic_duration_to_json(stats.compute_infer())},
+                                     {"compute_output", statistic_duration_to_json(stats.compute_output())}}}});
+        }
 
-    // return m_client->AsyncInfer(
-    //     [callback](triton::client::InferResult* result) {
-    //         callback(result);
-    //     },
-    //     options,
-    //     inference_input_ptrs,
-    //     inference_output_ptrs);
+        *statistics = nlohmann::json{{"model_stats", std::move(model_stats)}}.dump();
+    }
+
+    return status;
+}
+
+triton::client::Error GrpcTritonClient::async_infer(triton::client::InferenceServerHttpClient::OnCompleteFn callback,
+                                                    const triton::client::InferOptions& options,
+                                                    const std::vector<TritonInferInput>& inputs,
+                                                    const std::vector<TritonInferRequestedOutput>& outputs)
+{
+    return infer_with_client(*m_client, m_use_async_infer, std::move(callback), options, inputs, outputs);
+}
+
+bool GrpcTritonClient::uses_cuda_shared_memory() const
+{
+    return m_use_cuda_shared_memory;
+}
+
+triton::client::Error GrpcTritonClient::register_cuda_shared_memory(const std::string& name,
+                                                                    const cudaIpcMemHandle_t& handle,
+                                                                    std::size_t device_id,
+                                                                    std::size_t byte_size)
+{
+    return m_client->RegisterCudaSharedMemory(name, handle, device_id, byte_size);
+}
+
+triton::client::Error GrpcTritonClient::unregister_cuda_shared_memory(const std::string& name)
+{
+    return m_client->UnregisterCudaSharedMemory(name);
 }
 
 TritonInferenceClientSession::TritonInferenceClientSession(std::shared_ptr<ITritonClient> client,
-                                                           std::string model_name) :
+                                                           std::string model_name,
+                                                           std::size_t max_concurrent_batches,
+                                                           std::shared_ptr<const TritonModelInfo> model_info,
+                                                           TritonRaggedBatching ragged_batching) :
   m_client(std::move(client)),
-  m_model_name(std::move(model_name))
+  m_model_name(std::move(model_name)),
+  m_max_concurrent_batches(std::max<std::size_t>(max_concurrent_batches, 1)),
+  m_ragged_batching(std::move(ragged_batching))
 {
-    // Now load the input/outputs for the model
-
     bool is_server_live = false;
     CHECK_TRITON(m_client->is_server_live(&is_server_live));
     if (not is_server_live)
@@ -285,66 +662,304 @@ TritonInferenceClientSession::TritonInferenceClientSession(std::shared_ptr<ITrit
         throw std::runtime_error("Model is not ready");
     }
 
-    std::string model_metadata_json;
-    CHECK_TRITON(m_client->model_metadata(&model_metadata_json, this->m_model_name));
+    // Now load the input/outputs for the model, unless a previous session already has
+    if (model_info == nullptr)
+    {
+        model_info = load_model_info(*m_client, m_model_name);
+    }
 
-    auto model_metadata = nlohmann::json::parse(model_metadata_json);
+    m_model_info     = std::move(model_info);
+    m_max_batch_size = m_model_info->max_batch_size;
+    m_model_inputs   = m_model_info->inputs;
+    m_model_outputs  = m_model_info->outputs;
 
-    std::string model_config_json;
-    CHECK_TRITON(m_client->model_config(&model_config_json, this->m_model_name));
-    auto model_config = nlohmann::json::parse(model_config_json);
+    if (!m_ragged_batching.offsets_input.empty())
+    {
+        auto offsets_input = std::find_if(m_model_inputs.begin(), m_model_inputs.end(), [this](const auto& input) {
+            return input.name == m_ragged_batching.offsets_input;
+        });
 
-    if (model_config.contains("max_batch_size"))
+        if (offsets_input == m_model_inputs.end())
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("The offsets input '" << m_ragged_batching.offsets_input
+                                                                                  << "' is not an input of the model '"
+                                                                                  << m_model_name << "'"));
+        }
+
+        if (offsets_input->datatype.type_id() != TypeId::INT32 && offsets_input->datatype.type_id() != TypeId::INT64)
+        {
+            throw std::invalid_argument("The offsets input of a ragged batch must be an INT32 or an INT64 input");
+        }
+
+        if (m_client->uses_cuda_shared_memory())
+        {
+            throw std::invalid_argument("Ragged batches cannot be sent with CUDA shared memory");
+        }
+    }
+
+    if (m_client->uses_cuda_shared_memory())
     {
-        m_max_batch_size = model_config.at("max_batch_size").get<TensorIndex>();
+        m_output_pool = TensorBufferPool::create(
+            std::make_shared<MemoryDescriptor>(rmm::cuda_stream_per_thread, ipc_memory_resource()));
     }
 
-    for (auto const& input : model_metadata.at("inputs"))
+    auto& registry = MetricsRegistry::get_instance();
+
+    auto get_phase_histogram = [&](const std::string& phase) {
+        return registry.get_histogram("morpheus_triton_inference_phase_seconds",
+                                      "Duration of each phase of the mini-batches sent to Triton",
+                                      {{"model", m_model_name}, {"phase", phase}});
+    };
+
+    m_stage_inputs_seconds = get_phase_histogram("stage_inputs");
+    m_request_seconds      = get_phase_histogram("request");
+    m_resume_seconds       = get_phase_histogram("resume");
+    m_copy_outputs_seconds = get_phase_histogram("copy_outputs");
+
+    for (const std::string phase : {"queue", "compute_input", "compute_infer", "compute_output"})
     {
-        auto shape = input.at("shape").get<ShapeType>();
+        m_server_seconds[phase] = registry.get_gauge("morpheus_triton_server_phase_seconds",
+                                                     "Cumulative time spent by Triton in each phase of the inferences "
+                                                     "of the model, as reported by its statistics",
+                                                     {{"model", m_model_name}, {"phase", phase}});
+    }
 
-        auto dtype = DType::from_triton(input.at("datatype").get<std::string>());
+    m_server_inferences = registry.get_gauge("morpheus_triton_server_inferences",
+                                             "Cumulative number of successful inferences of the model, as reported "
+                                             "by the statistics of Triton",
+                                             {{"model", m_model_name}});
+}
 
-        size_t bytes = dtype.item_size();
+void TritonInferenceClientSession::update_server_statistics()
+{
+    std::unique_lock lock(m_statistics_mutex, std::try_to_lock);
 
-        for (auto& y : shape)
+    const auto now = std::chrono::steady_clock::now();
+    if (!lock.owns_lock() || now < m_next_statistics_update)
+    {
+        return;
+    }
+
+    m_next_statistics_update = now + StatisticsUpdateInterval;
+
+    std::string statistics_json;
+    auto status = m_client->model_inference_statistics(&statistics_json, m_model_name);
+    if (!status.IsOk())
+    {
+        VLOG(1) << "Unable to get the statistics of model '" << m_model_name << "': " << status.Message();
+        return;
+    }
+
+    // Each version of the model, and each server behind the client, reports its own totals
+    std::map<std::string, double> server_ns;
+    double num_inferences = 0;
+
+    for (const auto& model : nlohmann::json::parse(statistics_json).value("model_stats", nlohmann::json::array()))
+    {
+        const auto& stats = model.at("inference_stats");
+        for (const auto& [phase, gauge] : m_server_seconds)
         {
-            if (y == -1)
-            {
-                y = m_max_batch_size;
-            }
+            server_ns[phase] += stats.at(phase).at("ns").get<double>();
+        }
 
-            bytes *= y;
+        num_inferences += stats.at("success").at("count").get<double>();
+    }
+
+    for (const auto& [phase, gauge] : m_server_seconds)
+    {
+        gauge->set(server_ns[phase] / 1e9);
+    }
+
+    m_server_inferences->set(num_inferences);
+}
+
+TritonInferenceClientSession::~TritonInferenceClientSession()
+{
+    // Inferences hold a reference to the session, all of the regions are idle
+    for (auto& region : m_idle_regions)
+    {
+        auto status = m_client->unregister_cuda_shared_memory(region->name);
+        if (!status.IsOk())
+        {
+            LOG(WARNING) << "Failed to unregister CUDA shared memory region '" << region->name
+                         << "' from Triton. Error: " << status.Message();
         }
+    }
 
-        m_model_inputs.push_back(TritonInOut{input.at("name").get<std::string>(),
-                                             bytes,
-                                             DType::from_triton(input.at("datatype").get<std::string>()),
-                                             shape,
-                                             "",
-                                             0});
+    for (const auto& [data, registration] : m_output_registrations)
+    {
+        unregister_output(registration.name);
     }
+}
 
-    for (auto const& output : model_metadata.at("outputs"))
+std::shared_ptr<const TritonModelInfo> TritonInferenceClientSession::get_model_info() const
+{
+    return m_model_info;
+}
+
+void TritonInferenceClientSession::unregister_output(const std::string& name)
+{
+    auto status = m_client->unregister_cuda_shared_memory(name);
+    if (!status.IsOk())
     {
-        auto shape = output.at("shape").get<ShapeType>();
+        LOG(WARNING) << "Failed to unregister CUDA shared memory region '" << name
+                     << "' from Triton. Error: " << status.Message();
+    }
+}
 
-        auto dtype = DType::from_triton(output.at("datatype").get<std::string>());
+TritonInferenceClientSession::SharedMemoryRegion::SharedMemoryRegion(std::string name, std::size_t bytes) :
+  name(std::move(name)),
+  bytes(bytes)
+{
+    // Allocated directly rather than from the RMM resource, IPC handles refer to the start of an allocation
+    MRC_CHECK_CUDA(cudaMalloc(&data, bytes));
+    MRC_CHECK_CUDA(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+}
 
-        size_t bytes = dtype.item_size();
+TritonInferenceClientSession::SharedMemoryRegion::~SharedMemoryRegion()
+{
+    cudaEventDestroy(event);
+    cudaFree(data);
+}
 
-        for (auto& y : shape)
+std::shared_ptr<TritonInferenceClientSession::SharedMemoryRegion> TritonInferenceClientSession::
+    acquire_shared_memory_region()
+{
+    std::unique_ptr<SharedMemoryRegion> region;
+    std::size_t region_index = 0;
+
+    {
+        std::lock_guard lock(m_region_mutex);
+
+        if (!m_idle_regions.empty())
         {
-            if (y == -1)
+            region = std::move(m_idle_regions.back());
+            m_idle_regions.pop_back();
+        }
+        else
+        {
+            region_index = m_num_regions++;
+        }
+    }
+
+    if (!region)
+    {
+        // Every input of a full batch, each aligned within the region. The outputs are written to the registered
+        // output buffers. The name is unique across processes sharing the server.
+        std::map<std::string, std::size_t> offsets;
+        std::size_t bytes = 0;
+        for (const auto& model_input : m_model_inputs)
+        {
+            offsets[model_input.name] = bytes;
+            bytes += (model_input.bytes + SharedMemoryAlignment - 1) / SharedMemoryAlignment * SharedMemoryAlignment;
+        }
+
+        region = std::make_unique<SharedMemoryRegion>(
+            MORPHEUS_CONCAT_STR("morpheus_" << m_model_name << "_" << getpid() << "_" << this << "_" << region_index),
+            std::max<std::size_t>(bytes, SharedMemoryAlignment));
+        region->offsets = std::move(offsets);
+
+        int device_id;
+        cudaIpcMemHandle_t handle;
+        MRC_CHECK_CUDA(cudaGetDevice(&device_id));
+        MRC_CHECK_CUDA(cudaIpcGetMemHandle(&handle, region->data));
+
+        CHECK_TRITON(m_client->register_cuda_shared_memory(region->name, handle, device_id, region->bytes));
+    }
+
+    return {region.release(), [this](SharedMemoryRegion* ptr) {
+                release_shared_memory_region(std::unique_ptr<SharedMemoryRegion>(ptr));
+            }};
+}
+
+void TritonInferenceClientSession::release_shared_memory_region(std::unique_ptr<SharedMemoryRegion>&& region)
+{
+    // Never reuse a region while a copy from it may still be in flight
+    cudaEventSynchronize(region->event);
+
+    std::lock_guard lock(m_region_mutex);
+    m_idle_regions.emplace_back(std::move(region));
+}
+
+std::shared_ptr<TritonInferenceClientSession::OutputRegistration> TritonInferenceClientSession::
+    acquire_output_registration(const rmm::device_buffer& buffer)
+{
+    const auto* data = static_cast<const uint8_t*>(buffer.data());
+
+    cudaIpcMemHandle_t handle;
+    MRC_CHECK_CUDA(cudaIpcGetMemHandle(&handle, const_cast<uint8_t*>(data)));
+
+    std::vector<std::string> stale_names;
+    std::size_t registration_index = 0;
+    OutputRegistration* registration{nullptr};
+
+    {
+        std::lock_guard lock(m_region_mutex);
+
+        auto pos = m_output_registrations.find(data);
+        if (pos != m_output_registrations.end())
+        {
+            if (std::memcmp(&pos->second.handle, &handle, sizeof(handle)) == 0)
+            {
+                registration = &pos->second;
+                registration->num_users++;
+            }
+            else
             {
-                y = m_max_batch_size;
+                // The registered buffer was freed by the pool and its address reused by a new allocation
+                stale_names.emplace_back(std::move(pos->second.name));
+                m_output_registrations.erase(pos);
             }
+        }
 
-            bytes *= y;
+        if (registration == nullptr)
+        {
+            for (auto it = m_output_registrations.begin();
+                 it != m_output_registrations.end() && m_output_registrations.size() >= MaxOutputRegistrations;)
+            {
+                if (it->second.num_users == 0)
+                {
+                    stale_names.emplace_back(std::move(it->second.name));
+                    it = m_output_registrations.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            registration_index = m_num_output_registrations++;
         }
+    }
+
+    for (const auto& name : stale_names)
+    {
+        unregister_output(name);
+    }
+
+    if (registration == nullptr)
+    {
+        auto name = MORPHEUS_CONCAT_STR("morpheus_" << m_model_name << "_" << getpid() << "_" << this << "_output_"
+                                                    << registration_index);
 
-        m_model_outputs.push_back(TritonInOut{output.at("name").get<std::string>(), bytes, dtype, shape, "", 0});
+        int device_id;
+        MRC_CHECK_CUDA(cudaGetDevice(&device_id));
+        CHECK_TRITON(m_client->register_cuda_shared_memory(name, handle, device_id, buffer.size()));
+
+        std::lock_guard lock(m_region_mutex);
+        registration = &m_output_registrations.insert_or_assign(data, OutputRegistration{name, data, handle, 1})
+                            .first->second;
     }
+
+    return {registration, [this](OutputRegistration* ptr) {
+                release_output_registration(ptr);
+            }};
+}
+
+void TritonInferenceClientSession::release_output_registration(OutputRegistration* registration)
+{
+    std::lock_guard lock(m_region_mutex);
+    registration->num_users--;
 }
 
 std::vector<TensorModelMapping> TritonInferenceClientSession::get_input_mappings(
@@ -392,112 +1007,479 @@ std::vector<TensorModelMapping> TritonInferenceClientSession::get_output_mapping
     return mappings;
 }
 
-mrc::coroutines::Task<TensorMap> TritonInferenceClientSession::infer(TensorMap&& inputs)
+mrc::coroutines::Task<std::vector<std::shared_ptr<PinnedStagingBuffer>>> TritonInferenceClientSession::infer_batch(
+    TensorMap& inputs,
+    TensorMap& outputs,
+    const std::map<std::string, std::shared_ptr<OutputRegistration>>& output_registrations,
+    const std::vector<TensorIndex>& row_lengths,
+    TensorIndex start,
+    TensorIndex stop,
+    std::shared_ptr<mrc::coroutines::Scheduler> on)
 {
-    CHECK_EQ(inputs.size(), m_model_inputs.size()) << "Input tensor count does not match model input count";
+    const auto started_at = std::chrono::steady_clock::now();
 
-    auto element_count = inputs.begin()->second.shape(0);
+    // Staging buffers of the batch's outputs, which are still being copied to the device when the batch completes
+    std::vector<std::shared_ptr<PinnedStagingBuffer>> output_staging;
 
-    for (auto& input : inputs)
+    // With shared memory the inputs are copied between device buffers, never through host memory, and Triton writes
+    // the outputs directly into their rows of the full outputs. Each batch in flight needs its own input region.
+    std::shared_ptr<SharedMemoryRegion> region;
+    if (m_client->uses_cuda_shared_memory())
     {
-        CHECK_EQ(element_count, input.second.shape(0)) << "Input tensors are different sizes";
+        region = acquire_shared_memory_region();
     }
 
-    TensorMap model_output_tensors;
-
-    // create full inference output
-    for (auto& model_output : m_model_outputs)
+    // Ragged batches hold the tokens of each sequence without their padding, the offsets of the sequences are kept on
+    // the device to pack the inputs and unpack the outputs holding a row per token
+    const bool is_ragged = !row_lengths.empty();
+    std::vector<TensorIndex> offsets{0};
+    std::optional<rmm::device_uvector<TensorIndex>> offsets_d;
+    if (is_ragged)
     {
-        ShapeType full_output_shape    = model_output.shape;
-        full_output_shape[0]           = element_count;
-        auto full_output_element_count = TensorUtils::get_elem_count(full_output_shape);
+        for (TensorIndex row = start; row < stop; ++row)
+        {
+            offsets.push_back(offsets.back() + row_lengths[row]);
+        }
 
-        auto full_output_buffer = std::make_shared<rmm::device_buffer>(
-            full_output_element_count * model_output.datatype.item_size(), rmm::cuda_stream_per_thread);
+        offsets_d.emplace(offsets.size(), DeviceResources::stream());
+        MRC_CHECK_CUDA(cudaMemcpyAsync(offsets_d->data(),
+                                       offsets.data(),
+                                       offsets.size() * sizeof(TensorIndex),
+                                       cudaMemcpyHostToDevice,
+                                       DeviceResources::stream()));
+    }
 
-        ShapeType stride{full_output_shape[1], 1};
+    const auto num_tokens = offsets.back();
 
-        model_output_tensors[model_output.name].swap(
-            Tensor::create(std::move(full_output_buffer), model_output.datatype, full_output_shape, stride, 0));
-    }
+    // create batch inputs
 
-    // process all batches
+    std::vector<TritonInferInput> inference_inputs;
+    std::vector<TensorObject> inference_input_slices;
 
-    for (TensorIndex start = 0; start < element_count; start += m_max_batch_size)
+    for (auto model_input : m_model_inputs)
     {
-        TensorIndex stop = std::min(start + m_max_batch_size, static_cast<TensorIndex>(element_count));
+        if (is_ragged && model_input.name == m_ragged_batching.offsets_input)
+        {
+            auto staging =
+                PinnedStagingPool::get_local_instance().acquire(offsets.size() * model_input.datatype.item_size());
+
+            if (model_input.datatype.type_id() == TypeId::INT32)
+            {
+                std::transform(offsets.begin(),
+                               offsets.end(),
+                               reinterpret_cast<int32_t*>(staging->data()),
+                               [](TensorIndex offset) {
+                                   return static_cast<int32_t>(offset);
+                               });
+            }
+            else
+            {
+                std::transform(offsets.begin(),
+                               offsets.end(),
+                               reinterpret_cast<int64_t*>(staging->data()),
+                               [](TensorIndex offset) {
+                                   return static_cast<int64_t>(offset);
+                               });
+            }
+
+            inference_inputs.emplace_back(TritonInferInput{model_input.name,
+                                                           {static_cast<int64_t>(offsets.size())},
+                                                           model_input.datatype.triton_str(),
+                                                           std::move(staging)});
+            continue;
+        }
+
+        auto inference_input_slice = inputs.at(model_input.name).slice({start, 0}, {stop, -1});
+        std::vector<int64_t> input_shape{inference_input_slice.shape(0), inference_input_slice.shape(1)};
+
+        if (is_ragged)
+        {
+            if (!inference_input_slice.is_compact())
+            {
+                inference_input_slice.swap(inference_input_slice.deep_copy());
+            }
+
+            auto packed = std::make_shared<rmm::device_buffer>(num_tokens * inference_input_slice.dtype_size(),
+                                                               DeviceResources::stream());
+            MatxUtil::pack_ragged_rows(DevMemInfo{inference_input_slice.data(),
+                                                  inference_input_slice.dtype(),
+                                                  inference_input_slice.get_memory(),
+                                                  inference_input_slice.get_shape(),
+                                                  inference_input_slice.get_stride()},
+                                       offsets_d->data(),
+                                       1,
+                                       packed->data(),
+                                       DeviceResources::stream());
+
+            inference_input_slice.swap(
+                Tensor::create(std::move(packed), inference_input_slice.dtype(), {num_tokens, 1}, {}));
+            input_shape = {num_tokens};
+        }
+
+        const auto input_bytes = inference_input_slice.count() * model_input.datatype.item_size();
 
-        // create batch inputs
+        std::shared_ptr<PinnedStagingBuffer> staging;
+        void* destination = nullptr;
+
+        if (region)
+        {
+            destination = region->data + region->offsets.at(model_input.name);
+        }
+        else
+        {
+            staging = PinnedStagingPool::get_local_instance().acquire(input_bytes);
 
-        std::vector<TritonInferInput> inference_inputs;
+            // Pinned memory is mapped in the device address space, letting a kernel write to it directly
+            MRC_CHECK_CUDA(cudaHostGetDevicePointer(&destination, staging->data(), 0));
+        }
 
-        for (auto model_input : m_model_inputs)
+        // Inputs of the model's type in row major order are copied as is, the others are converted and staged by a
+        // single kernel, without an intermediate device buffer
+        if (inference_input_slice.dtype() == model_input.datatype && inference_input_slice.is_compact())
+        {
+            MRC_CHECK_CUDA(cudaMemcpyAsync(destination,
+                                           inference_input_slice.data(),
+                                           input_bytes,
+                                           cudaMemcpyDefault,
+                                           DeviceResources::stream()));
+        }
+        else
         {
-            auto inference_input_slice =
-                inputs[model_input.name].slice({start, 0}, {stop, -1}).as_type(model_input.datatype);
+            MatxUtil::enqueue_cast_into(DevMemInfo{inference_input_slice.data(),
+                                                   inference_input_slice.dtype(),
+                                                   inference_input_slice.get_memory(),
+                                                   inference_input_slice.get_shape(),
+                                                   inference_input_slice.get_stride()},
+                                        model_input.datatype.type_id(),
+                                        destination,
+                                        DeviceResources::stream());
+        }
 
+        if (region)
+        {
             inference_inputs.emplace_back(
                 TritonInferInput{model_input.name,
-                                 {inference_input_slice.shape(0), inference_input_slice.shape(1)},
+                                 input_shape,
                                  model_input.datatype.triton_str(),
-                                 inference_input_slice.get_host_data()});
+                                 nullptr,
+                                 region->name,
+                                 region->offsets.at(model_input.name),
+                                 input_bytes});
+
+            inference_input_slices.emplace_back(std::move(inference_input_slice));
+            continue;
         }
 
-        // create batch outputs
+        inference_inputs.emplace_back(
+            TritonInferInput{model_input.name, input_shape, model_input.datatype.triton_str(), std::move(staging)});
+
+        // Keep the slice alive until the copy has completed
+        inference_input_slices.emplace_back(std::move(inference_input_slice));
+    }
+
+    // Wait once for all of the inputs of the batch, Triton reads the shared memory region on its own stream. This also
+    // waits for the previous owner of a reused full output buffer, which Triton writes to on its own stream.
+    if (region)
+    {
+        MRC_CHECK_CUDA(cudaEventRecord(region->event, DeviceResources::stream()));
+        MRC_CHECK_CUDA(cudaEventSynchronize(region->event));
+    }
+    else if (!inference_inputs.empty())
+    {
+        inference_inputs.back().data->record(DeviceResources::stream());
+        inference_inputs.back().data->synchronize();
+    }
+
+    inference_input_slices.clear();
 
-        std::vector<TritonInferRequestedOutput> outputs;
+    // create batch outputs
+
+    std::vector<TritonInferRequestedOutput> requested_outputs;
+
+    for (auto model_output : m_model_outputs)
+    {
+        if (region)
+        {
+            const auto& registration = output_registrations.at(model_output.name);
+            auto output_slice        = outputs.at(model_output.name).slice({start, 0}, {stop, -1});
+            auto output_offset       = static_cast<const uint8_t*>(output_slice.data()) - registration->data;
 
-        for (auto model_output : m_model_outputs)
+            requested_outputs.emplace_back(TritonInferRequestedOutput{
+                model_output.name, registration->name, static_cast<std::size_t>(output_offset), output_slice.bytes()});
+        }
+        else
         {
-            outputs.emplace_back(TritonInferRequestedOutput{model_output.name});
+            requested_outputs.emplace_back(TritonInferRequestedOutput{model_output.name});
         }
+    }
+
+    // infer batch results
+
+    auto options = triton::client::InferOptions(m_model_name);
 
-        // infer batch results
+    const auto sent_at = std::chrono::steady_clock::now();
+    m_stage_inputs_seconds->observe(seconds_between(started_at, sent_at));
 
-        auto options = triton::client::InferOptions(m_model_name);
+    std::chrono::steady_clock::time_point completed_at;
+    auto results = co_await TritonInferOperation(
+        *m_client, options, inference_inputs, requested_outputs, std::move(on), completed_at);
 
-        auto results = co_await TritonInferOperation(*m_client, options, inference_inputs, outputs);
+    const auto resumed_at = std::chrono::steady_clock::now();
+    m_request_seconds->observe(seconds_between(sent_at, completed_at));
+    m_resume_seconds->observe(seconds_between(completed_at, resumed_at));
+
+    // verify batch results and copy to full output tensors
+
+    bool has_token_outputs = false;
+
+    for (auto model_output : m_model_outputs)
+    {
+        auto output_tensor = outputs.at(model_output.name).slice({start, 0}, {stop, -1});
 
-        // verify batch results and copy to full output tensors
+        const bool is_token_output = is_ragged && is_token_output_of(m_ragged_batching, model_output.name);
 
-        for (auto model_output : m_model_outputs)
+        std::vector<int64_t> output_shape;
+
+        CHECK_TRITON(results->Shape(model_output.name, &output_shape));
+
+        // Make sure we have at least 2 dims
+        while (output_shape.size() < 2)
         {
-            auto output_tensor = model_output_tensors[model_output.name].slice({start, 0}, {stop, -1});
+            output_shape.push_back(1);
+        }
+
+        DCHECK_EQ(is_token_output ? num_tokens : stop - start, output_shape[0]);
+        DCHECK_NOTNULL(output_tensor.data());  // NOLINT
 
-            std::vector<int64_t> output_shape;
+        if (region)
+        {
+            // Triton has written the output to its rows of the full output before responding
+            continue;
+        }
 
-            CHECK_TRITON(results->Shape(model_output.name, &output_shape));
+        const uint8_t* output_ptr = nullptr;
+        size_t output_ptr_size    = 0;
+        CHECK_TRITON(results->RawData(model_output.name, &output_ptr, &output_ptr_size));
 
-            // Make sure we have at least 2 dims
-            while (output_shape.size() < 2)
-            {
-                output_shape.push_back(1);
-            }
+        DCHECK_NOTNULL(output_ptr);  // NOLINT
 
-            const uint8_t* output_ptr = nullptr;
-            size_t output_ptr_size    = 0;
-            CHECK_TRITON(results->RawData(model_output.name, &output_ptr, &output_ptr_size));
+        // Triton's response buffer is pageable, stage it to allow the copy to the device to be asynchronous
+        auto staging = PinnedStagingPool::get_local_instance().acquire(output_ptr_size);
+        std::memcpy(staging->data(), output_ptr, output_ptr_size);
 
-            DCHECK_EQ(stop - start, output_shape[0]);
+        if (is_token_output)
+        {
+            // The tokens of each sequence are padded back into the row of the sequence
+            rmm::device_buffer packed(output_ptr_size, DeviceResources::stream());
+            MRC_CHECK_CUDA(cudaMemcpyAsync(
+                packed.data(), staging->data(), output_ptr_size, cudaMemcpyHostToDevice, DeviceResources::stream()));
+
+            MatxUtil::unpack_ragged_rows(packed.data(),
+                                         offsets_d->data(),
+                                         output_shape[1],
+                                         DevMemInfo{output_tensor.data(),
+                                                    output_tensor.dtype(),
+                                                    output_tensor.get_memory(),
+                                                    output_tensor.get_shape(),
+                                                    output_tensor.get_stride()},
+                                         DeviceResources::stream());
+            has_token_outputs = true;
+        }
+        else
+        {
             DCHECK_EQ(output_tensor.bytes(), output_ptr_size);
-            DCHECK_NOTNULL(output_ptr);            // NOLINT
-            DCHECK_NOTNULL(output_tensor.data());  // NOLINT
 
-            MRC_CHECK_CUDA(cudaMemcpy(output_tensor.data(), output_ptr, output_ptr_size, cudaMemcpyHostToDevice));
+            MRC_CHECK_CUDA(cudaMemcpyAsync(output_tensor.data(),
+                                           staging->data(),
+                                           output_ptr_size,
+                                           cudaMemcpyHostToDevice,
+                                           DeviceResources::stream()));
+        }
+
+        staging->record(DeviceResources::stream());
+
+        output_staging.emplace_back(std::move(staging));
+    }
+
+    // The offsets were uploaded on the stream of the thread which sent the batch, which may not be this one
+    if (has_token_outputs)
+    {
+        DeviceResources::stream().synchronize();
+    }
+
+    m_copy_outputs_seconds->observe(seconds_between(resumed_at, std::chrono::steady_clock::now()));
+
+    co_return output_staging;
+}
+
+std::vector<TensorIndex> TritonInferenceClientSession::ragged_row_lengths(const TensorMap& inputs, TensorIndex num_rows)
+{
+    auto stream = DeviceResources::stream();
+
+    rmm::device_uvector<TensorIndex> lengths_d(num_rows, stream);
+    MRC_CHECK_CUDA(cudaMemsetAsync(lengths_d.data(), 0, num_rows * sizeof(TensorIndex), stream.value()));
+
+    for (const auto& [name, input] : inputs)
+    {
+        MatxUtil::enqueue_row_lengths(
+            DevMemInfo{input.data(), input.dtype(), input.get_memory(), input.get_shape(), input.get_stride()},
+            lengths_d.data(),
+            stream);
+    }
+
+    std::vector<TensorIndex> lengths(num_rows);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(
+        lengths.data(), lengths_d.data(), num_rows * sizeof(TensorIndex), cudaMemcpyDeviceToHost, stream.value()));
+    stream.synchronize();
+
+    // Rows without any token are sent as a single padding token, so that every row has its outputs
+    for (auto& length : lengths)
+    {
+        length = std::max<TensorIndex>(length, 1);
+    }
+
+    return lengths;
+}
+
+mrc::coroutines::Task<TensorMap> TritonInferenceClientSession::infer(TensorMap&& inputs,
+                                                                    std::shared_ptr<mrc::coroutines::Scheduler> on)
+{
+    // The offsets of a ragged batch are an input of the model computed by the session
+    const bool is_ragged = !m_ragged_batching.offsets_input.empty();
+    CHECK_EQ(inputs.size(), m_model_inputs.size() - (is_ragged ? 1 : 0))
+        << "Input tensor count does not match model input count";
+
+    auto element_count = inputs.begin()->second.shape(0);
+
+    TensorIndex sequence_length = 0;
+    for (auto& input : inputs)
+    {
+        CHECK_EQ(element_count, input.second.shape(0)) << "Input tensors are different sizes";
+        sequence_length = std::max(sequence_length, input.second.shape(1));
+    }
+
+    std::vector<TensorIndex> row_lengths;
+    if (is_ragged)
+    {
+        row_lengths = ragged_row_lengths(inputs, element_count);
+    }
+
+    TensorMap model_output_tensors;
+    std::map<std::string, std::shared_ptr<OutputRegistration>> output_registrations;
+
+    // create full inference output
+    for (auto& model_output : m_model_outputs)
+    {
+        ShapeType full_output_shape = model_output.shape;
+        full_output_shape[0]        = element_count;
+
+        // Outputs of a row per token are padded back to a row per sequence
+        if (is_ragged && is_token_output_of(m_ragged_batching, model_output.name))
+        {
+            full_output_shape[1] *= sequence_length;
+        }
+
+        auto full_output_element_count = TensorUtils::get_elem_count(full_output_shape);
+
+        auto full_output_buffer =
+            m_output_pool->get_buffer(full_output_element_count * model_output.datatype.item_size());
+
+        ShapeType stride{full_output_shape[1], 1};
+
+        if (m_client->uses_cuda_shared_memory())
+        {
+            output_registrations[model_output.name] = acquire_output_registration(*full_output_buffer);
         }
+
+        model_output_tensors[model_output.name].swap(
+            Tensor::create(std::move(full_output_buffer), model_output.datatype, full_output_shape, stride, 0));
     }
 
+    // process all batches
+
+    // Mini-batches are sent in windows of up to `m_max_concurrent_batches` requests in flight at once, each batch
+    // copying its results into its own rows of the full outputs. Staging buffers of the previous window's outputs are
+    // released once the next window has been sent, allowing the copies to the device to overlap with the requests.
+    std::vector<std::shared_ptr<PinnedStagingBuffer>> output_staging;
+    std::vector<mrc::coroutines::Task<std::vector<std::shared_ptr<PinnedStagingBuffer>>>> batches;
+
+    // Models without a batch dimension, as is often the case of those accepting ragged batches, infer whole messages
+    const TensorIndex batch_size = m_max_batch_size > 0 ? m_max_batch_size : element_count;
+
+    for (TensorIndex start = 0; start < element_count; start += batch_size)
+    {
+        TensorIndex stop = std::min(start + batch_size, static_cast<TensorIndex>(element_count));
+
+        batches.emplace_back(
+            infer_batch(inputs, model_output_tensors, output_registrations, row_lengths, start, stop, on));
+
+        if (batches.size() < m_max_concurrent_batches && stop < element_count)
+        {
+            continue;
+        }
+
+        auto completed_batches = co_await mrc::coroutines::when_all(std::move(batches));
+        batches.clear();
+
+        output_staging.clear();
+
+        for (auto& completed_batch : completed_batches)
+        {
+            for (auto& staging : completed_batch.return_value())
+            {
+                output_staging.emplace_back(std::move(staging));
+            }
+        }
+    }
+
+    // Releasing the staging buffers waits for the last copies to the device
+    output_staging.clear();
+
+    update_server_statistics();
+
     co_return model_output_tensors;
 };
 
-TritonInferenceClient::TritonInferenceClient(std::unique_ptr<ITritonClient>&& client, std::string model_name) :
+TritonInferenceClient::TritonInferenceClient(std::unique_ptr<ITritonClient>&& client,
+                                             std::string model_name,
+                                             std::size_t max_concurrent_batches,
+                                             TritonRaggedBatching ragged_batching) :
   m_client(std::move(client)),
-  m_model_name(std::move(model_name))
+  m_model_name(std::move(model_name)),
+  m_max_concurrent_batches(max_concurrent_batches),
+  m_ragged_batching(std::move(ragged_batching))
+{}
+
+TritonInferenceClient::TritonInferenceClient(client_factory_t client_factory,
+                                             std::string model_name,
+                                             std::size_t max_concurrent_batches,
+                                             TritonRaggedBatching ragged_batching) :
+  m_client_factory(std::move(client_factory)),
+  m_model_name(std::move(model_name)),
+  m_max_concurrent_batches(max_concurrent_batches),
+  m_ragged_batching(std::move(ragged_batching))
 {}
 
 std::unique_ptr<IInferenceClientSession> TritonInferenceClient::create_session()
 {
-    return std::make_unique<TritonInferenceClientSession>(m_client, m_model_name);
+    std::shared_ptr<const TritonModelInfo> model_info;
+    {
+        std::lock_guard lock(m_model_info_mutex);
+        model_info = m_model_info;
+    }
+
+    std::shared_ptr<ITritonClient> client = m_client_factory ? m_client_factory() : m_client;
+
+    auto session = std::make_unique<TritonInferenceClientSession>(
+        std::move(client), m_model_name, m_max_concurrent_batches, std::move(model_info), m_ragged_batching);
+
+    std::lock_guard lock(m_model_info_mutex);
+    if (m_model_info == nullptr)
+    {
+        m_model_info = session->get_model_info();
+    }
+
+    return session;
 }
 
 }  // namespace morpheus
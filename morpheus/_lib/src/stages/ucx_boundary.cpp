@@ -0,0 +1,311 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/ucx_boundary.hpp"  // IWYU pragma: associated
+
+#include "morpheus/messages/memory/tensor_memory.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/objects/dtype.hpp"
+#include "morpheus/objects/tensor.hpp"  // for Tensor::create
+#include "morpheus/objects/tensor_object.hpp"
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cudf/contiguous_split.hpp>  // for pack, unpack
+#include <cudf/io/types.hpp>          // for table_with_metadata
+#include <cudf/table/table.hpp>
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstdint>  // for uint8_t, uint64_t
+#include <exception>
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <utility>    // for move
+#include <vector>
+
+namespace morpheus {
+// Component public implementations
+// ************ UcxEgressStage ************************* //
+UcxEgressStage::UcxEgressStage(std::string address, uint16_t port, std::chrono::milliseconds connect_timeout) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_address(std::move(address)),
+  m_port(port),
+  m_connect_timeout(connect_timeout)
+{}
+
+UcxConnection& UcxEgressStage::connection()
+{
+    if (m_connection == nullptr)
+    {
+        m_connection = UcxConnection::connect(m_address, m_port, m_connect_timeout);
+    }
+
+    return *m_connection;
+}
+
+void UcxEgressStage::send(ControlMessage& message)
+{
+    auto& conn   = this->connection();
+    auto header  = nlohmann::json{{"config", message.to_config()}};
+    auto payload = message.payload();
+    auto tensors = message.tensors();
+
+    cudf::packed_columns packed;
+    if (payload != nullptr)
+    {
+        auto info = payload->get_info();
+        packed    = cudf::pack(info.get_view());
+
+        header["payload"] = {{"index_names", info.get_index_names()},
+                             {"column_names", info.get_column_names()},
+                             {"metadata", nlohmann::json::binary(std::move(*packed.metadata))},
+                             {"num_bytes", packed.gpu_data->size()}};
+    }
+
+    std::vector<const TensorObject*> tensor_objects;
+    if (tensors != nullptr)
+    {
+        // The tensors may still be written by a stream of an upstream stage
+        tensors->synchronize_event();
+
+        auto tensor_headers = nlohmann::json::array();
+        for (const auto& name : tensors->tensor_names())
+        {
+            const auto& tensor = tensors->get_tensor(name);
+            if (!tensor.is_compact())
+            {
+                throw std::invalid_argument(
+                    MORPHEUS_CONCAT_STR("Unable to send the tensor '" << name << "', only compact tensors are sent"));
+            }
+
+            tensor_headers.push_back({{"name", name},
+                                      {"dtype", tensor.dtype().type_str()},
+                                      {"shape", tensor.get_shape()},
+                                      {"strides", tensor.get_stride()},
+                                      {"num_bytes", tensor.bytes()}});
+            tensor_objects.push_back(&tensor);
+        }
+
+        header["tensors"] = {{"count", tensors->count}, {"tensors", std::move(tensor_headers)}};
+    }
+
+    // UCX copies the buffers on its own streams
+    cudf::get_default_stream().synchronize();
+
+    const auto header_bytes    = nlohmann::json::to_msgpack(header);
+    const uint64_t header_size = header_bytes.size();
+    conn.send(&header_size, sizeof(header_size));
+    conn.send(header_bytes.data(), header_bytes.size());
+
+    std::size_t num_bytes = 0;
+    if (payload != nullptr && packed.gpu_data->size() > 0)
+    {
+        conn.send(packed.gpu_data->data(), packed.gpu_data->size());
+        num_bytes += packed.gpu_data->size();
+    }
+
+    for (const auto* tensor : tensor_objects)
+    {
+        if (tensor->bytes() > 0)
+        {
+            conn.send(tensor->data(), tensor->bytes());
+            num_bytes += tensor->bytes();
+        }
+    }
+
+    MORPHEUS_TRACE("ucx_egress.send", header_bytes.size(), num_bytes);
+}
+
+UcxEgressStage::subscribe_fn_t UcxEgressStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                try
+                {
+                    this->send(*x);
+                } catch (...)
+                {
+                    output.on_error(std::current_exception());
+                    return;
+                }
+
+                output.on_next(std::move(x));
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [this, &output]() {
+                try
+                {
+                    // An empty header ends the stream of the ingress
+                    const uint64_t header_size = 0;
+                    this->connection().send(&header_size, sizeof(header_size));
+                    m_connection.reset();
+                } catch (...)
+                {
+                    output.on_error(std::current_exception());
+                    return;
+                }
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ UcxIngressStage ************************* //
+UcxIngressStage::UcxIngressStage(std::string bind_address, uint16_t port) :
+  PythonSource(build()),
+  m_bind_address(std::move(bind_address)),
+  m_port(port)
+{}
+
+std::shared_ptr<ControlMessage> UcxIngressStage::receive(UcxConnection& connection,
+                                                         const UcxConnection::stop_fn_t& should_stop)
+{
+    uint64_t header_size = 0;
+    if (!connection.recv(&header_size, sizeof(header_size), should_stop) || header_size == 0)
+    {
+        return nullptr;
+    }
+
+    std::vector<uint8_t> header_bytes(header_size);
+    connection.recv(header_bytes.data(), header_bytes.size());
+    const auto header = nlohmann::json::from_msgpack(header_bytes);
+
+    auto message = std::make_shared<ControlMessage>(header.at("config"));
+    auto stream  = cudf::get_default_stream();
+
+    if (header.contains("payload"))
+    {
+        const auto& payload_header = header["payload"];
+        const auto num_bytes       = payload_header.at("num_bytes").get<std::size_t>();
+        const auto& metadata       = payload_header.at("metadata").get_binary();
+
+        rmm::device_buffer gpu_data(num_bytes, stream);
+        stream.synchronize();
+        if (num_bytes > 0)
+        {
+            connection.recv(gpu_data.data(), num_bytes);
+        }
+
+        // The columns of the view point into the received buffer, the table owns a copy of them
+        cudf::io::table_with_metadata table;
+        table.tbl = std::make_unique<cudf::table>(
+            cudf::unpack(metadata.data(), static_cast<const uint8_t*>(gpu_data.data())), stream);
+
+        const auto index_names = payload_header.at("index_names").get<std::vector<std::string>>();
+        for (const auto& name : index_names)
+        {
+            table.metadata.schema_info.emplace_back(name);
+        }
+
+        for (const auto& name : payload_header.at("column_names").get<std::vector<std::string>>())
+        {
+            table.metadata.schema_info.emplace_back(name);
+        }
+
+        message->payload(MessageMeta::create_from_cpp(std::move(table), static_cast<int>(index_names.size())));
+    }
+
+    if (header.contains("tensors"))
+    {
+        const auto& tensors_header = header["tensors"];
+
+        TensorMap tensors;
+        for (const auto& tensor_header : tensors_header.at("tensors"))
+        {
+            const auto num_bytes = tensor_header.at("num_bytes").get<std::size_t>();
+
+            auto buffer = std::make_shared<rmm::device_buffer>(num_bytes, stream);
+            stream.synchronize();
+            if (num_bytes > 0)
+            {
+                connection.recv(buffer->data(), num_bytes);
+            }
+
+            tensors[tensor_header.at("name").get<std::string>()] =
+                Tensor::create(std::move(buffer),
+                               DType::from_numpy(tensor_header.at("dtype").get<std::string>()),
+                               tensor_header.at("shape").get<ShapeType>(),
+                               tensor_header.at("strides").get<ShapeType>());
+        }
+
+        message->tensors(
+            std::make_shared<TensorMemory>(tensors_header.at("count").get<TensorIndex>(), std::move(tensors)));
+    }
+
+    stream.synchronize();
+
+    MORPHEUS_TRACE("ucx_ingress.receive", header_size);
+
+    return message;
+}
+
+UcxIngressStage::subscriber_fn_t UcxIngressStage::build()
+{
+    return [this](rxcpp::subscriber<source_type_t> output) {
+        UcxConnection::stop_fn_t should_stop = [&output]() {
+            return !output.is_subscribed();
+        };
+
+        try
+        {
+            auto connection = UcxConnection::accept(m_bind_address, m_port, should_stop);
+            while (connection != nullptr && output.is_subscribed())
+            {
+                auto message = this->receive(*connection, should_stop);
+                if (message == nullptr)
+                {
+                    break;
+                }
+
+                output.on_next(std::move(message));
+            }
+        } catch (...)
+        {
+            output.on_error(std::current_exception());
+            return;
+        }
+
+        output.on_completed();
+    };
+}
+
+// ************ UcxEgressStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<UcxEgressStage>> UcxEgressStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string address,
+    uint16_t port,
+    int64_t connect_timeout_ms)
+{
+    return builder.construct_object<UcxEgressStage>(
+        name, std::move(address), port, std::chrono::milliseconds(connect_timeout_ms));
+}
+
+// ************ UcxIngressStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<UcxIngressStage>> UcxIngressStageInterfaceProxy::init(
+    mrc::segment::Builder& builder, const std::string& name, std::string bind_address, uint16_t port)
+{
+    return builder.construct_object<UcxIngressStage>(name, std::move(bind_address), port);
+}
+
+}  // namespace morpheus
@@ -0,0 +1,512 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/window_aggregate.hpp"  // IWYU pragma: associated
+
+#include "morpheus/utilities/string_util.hpp"   // for MORPHEUS_CONCAT_STR
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cudf/binaryop.hpp>  // for binary_operation
+#include <cudf/column/column.hpp>
+#include <cudf/concatenate.hpp>  // for concatenate
+#include <cudf/groupby.hpp>
+#include <cudf/io/types.hpp>   // for table_with_metadata
+#include <cudf/reduction.hpp>  // for minmax
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/sorting.hpp>            // for sort_by_key
+#include <cudf/stream_compaction.hpp>  // for apply_boolean_mask
+#include <cudf/table/table_view.hpp>
+#include <cudf/unary.hpp>             // for cast, unary_operation
+#include <cudf/utilities/traits.hpp>  // for is_timestamp
+#include <glog/logging.h>
+
+#include <algorithm>  // for find, max
+#include <exception>
+#include <iterator>   // for distance
+#include <numeric>    // for iota
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument, logic_error, runtime_error
+#include <utility>    // for move
+
+namespace morpheus {
+namespace {
+
+const cudf::data_type Int64Type{cudf::type_id::INT64};
+
+// Views the timestamps of `column` as int64 nanoseconds, `owner` holding the converted column when a cast is needed
+cudf::column_view to_nanoseconds(const cudf::column_view& column, std::unique_ptr<cudf::column>& owner)
+{
+    if (!cudf::is_timestamp(column.type()))
+    {
+        throw std::invalid_argument("The timestamp column of the window aggregate must hold timestamps");
+    }
+
+    if (column.has_nulls())
+    {
+        throw std::invalid_argument("The timestamp column of the window aggregate must not hold nulls");
+    }
+
+    auto view = column;
+    if (column.type().id() != cudf::type_id::TIMESTAMP_NANOSECONDS)
+    {
+        owner = cudf::cast(column, cudf::data_type{cudf::type_id::TIMESTAMP_NANOSECONDS});
+        view  = owner->view();
+    }
+
+    return cudf::bit_cast(view, Int64Type);
+}
+
+std::unique_ptr<cudf::groupby_aggregation> make_aggregation(cudf::aggregation::Kind kind)
+{
+    switch (kind)
+    {
+    case cudf::aggregation::SUM:
+        return cudf::make_sum_aggregation<cudf::groupby_aggregation>();
+    case cudf::aggregation::MIN:
+        return cudf::make_min_aggregation<cudf::groupby_aggregation>();
+    case cudf::aggregation::MAX:
+        return cudf::make_max_aggregation<cudf::groupby_aggregation>();
+    case cudf::aggregation::COUNT_VALID:
+        return cudf::make_count_aggregation<cudf::groupby_aggregation>();
+    default:
+        throw std::logic_error("Unexpected partial aggregation");
+    }
+}
+
+std::unique_ptr<cudf::column> compare(const cudf::column_view& column, int64_t value, cudf::binary_operator op)
+{
+    return cudf::binary_operation(
+        column, cudf::numeric_scalar<int64_t>(value), op, cudf::data_type{cudf::type_id::BOOL8});
+}
+
+}  // namespace
+
+// ************ WindowAggregator ************************************* //
+WindowAggregator::WindowAggregator(std::vector<std::string> key_columns,
+                                   std::string timestamp_column,
+                                   const std::map<std::string, std::vector<std::string>>& aggregations,
+                                   std::chrono::nanoseconds window,
+                                   std::chrono::nanoseconds slide,
+                                   std::chrono::nanoseconds allowed_lateness) :
+  m_key_columns(std::move(key_columns)),
+  m_timestamp_column(std::move(timestamp_column)),
+  m_window(window.count()),
+  m_slide(slide.count()),
+  m_allowed_lateness(allowed_lateness.count())
+{
+    if (m_key_columns.empty())
+    {
+        throw std::invalid_argument("At least one key column is required to aggregate windows");
+    }
+
+    if (m_window <= 0 || m_slide <= 0 || m_window % m_slide != 0)
+    {
+        throw std::invalid_argument("The window and slide must be positive, and the slide must divide the window");
+    }
+
+    if (m_allowed_lateness < 0)
+    {
+        throw std::invalid_argument("The allowed lateness must not be negative");
+    }
+
+    for (const auto& [column, names] : aggregations)
+    {
+        for (const auto& name : names)
+        {
+            Output output{column + "_" + name, name, 0, 0};
+            if (name == "count")
+            {
+                output.partial = add_partial(column, cudf::aggregation::COUNT_VALID);
+            }
+            else if (name == "sum" || name == "mean")
+            {
+                output.partial = add_partial(column, cudf::aggregation::SUM);
+                if (name == "mean")
+                {
+                    output.count_partial = add_partial(column, cudf::aggregation::COUNT_VALID);
+                }
+            }
+            else if (name == "min")
+            {
+                output.partial = add_partial(column, cudf::aggregation::MIN);
+            }
+            else if (name == "max")
+            {
+                output.partial = add_partial(column, cudf::aggregation::MAX);
+            }
+            else
+            {
+                throw std::invalid_argument(
+                    MORPHEUS_CONCAT_STR("Unsupported aggregation '" << name << "' of the column '" << column << "'"));
+            }
+
+            m_outputs.push_back(std::move(output));
+        }
+    }
+}
+
+std::size_t WindowAggregator::add_partial(const std::string& column, cudf::aggregation::Kind kind)
+{
+    auto found = std::find_if(m_partials.begin(), m_partials.end(), [&](const Partial& partial) {
+        return partial.column == column && partial.kind == kind;
+    });
+
+    if (found != m_partials.end())
+    {
+        return std::distance(m_partials.begin(), found);
+    }
+
+    m_partials.push_back({column, kind});
+    return m_partials.size() - 1;
+}
+
+std::unique_ptr<cudf::table> WindowAggregator::aggregate(const cudf::table_view& table, bool merge) const
+{
+    // The key columns along with the window start
+    std::vector<cudf::size_type> key_indices(m_key_columns.size() + 1);
+    std::iota(key_indices.begin(), key_indices.end(), 0);
+    const auto start_index = static_cast<cudf::size_type>(m_key_columns.size());
+
+    cudf::groupby::groupby grouper(table.select(key_indices));
+
+    // Batches count their rows, merges sum the counts of both sides, the values following either one
+    const auto values_index = merge ? start_index + 2 : start_index + 1;
+
+    std::vector<cudf::groupby::aggregation_request> requests(m_partials.size() + 1);
+    requests[0].values = table.column(merge ? start_index + 1 : start_index);
+    requests[0].aggregations.push_back(merge ? cudf::make_sum_aggregation<cudf::groupby_aggregation>()
+                                             : cudf::make_count_aggregation<cudf::groupby_aggregation>(
+                                                   cudf::null_policy::INCLUDE));
+
+    for (std::size_t i = 0; i < m_partials.size(); ++i)
+    {
+        auto kind = m_partials[i].kind;
+        if (merge && kind == cudf::aggregation::COUNT_VALID)
+        {
+            kind = cudf::aggregation::SUM;
+        }
+
+        requests[i + 1].values = table.column(values_index + static_cast<cudf::size_type>(i));
+        requests[i + 1].aggregations.push_back(make_aggregation(kind));
+    }
+
+    auto [keys, results] = grouper.aggregate(requests);
+
+    auto columns = keys->release();
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        auto result = std::move(results[i].results[0]);
+
+        // Counts are held as int64, such that the state keeps the same types once merged
+        if (result->type() != Int64Type && (i == 0 || m_partials[i - 1].kind == cudf::aggregation::COUNT_VALID))
+        {
+            result = cudf::cast(result->view(), Int64Type);
+        }
+
+        columns.push_back(std::move(result));
+    }
+
+    return std::make_unique<cudf::table>(std::move(columns));
+}
+
+cudf::size_type WindowAggregator::update(const TableInfo& table)
+{
+    const auto num_rows = table.num_rows();
+    if (num_rows == 0)
+    {
+        return 0;
+    }
+
+    const auto column_names = table.get_column_names();
+    auto find_column        = [&](const std::string& name) {
+        auto found = std::find(column_names.begin(), column_names.end(), name);
+        if (found == column_names.end())
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to find the column '" << name << "'"));
+        }
+
+        return table.get_column(std::distance(column_names.begin(), found));
+    };
+
+    std::unique_ptr<cudf::column> owner;
+    auto timestamps = to_nanoseconds(find_column(m_timestamp_column), owner);
+
+    std::vector<cudf::column_view> keys;
+    for (const auto& key_column : m_key_columns)
+    {
+        keys.push_back(find_column(key_column));
+    }
+
+    std::vector<cudf::column_view> values;
+    for (const auto& partial : m_partials)
+    {
+        values.push_back(find_column(partial.column));
+    }
+
+    // Start of the newest window holding each row
+    auto offsets = cudf::binary_operation(
+        timestamps, cudf::numeric_scalar<int64_t>(m_slide), cudf::binary_operator::PYMOD, Int64Type);
+    auto newest_starts = cudf::binary_operation(timestamps, offsets->view(), cudf::binary_operator::SUB, Int64Type);
+
+    // Each row is repeated for every window holding it
+    std::vector<std::unique_ptr<cudf::table>> window_rows;
+    cudf::size_type num_late = 0;
+    for (int64_t i = 0; i < m_window / m_slide; ++i)
+    {
+        auto starts = cudf::binary_operation(
+            newest_starts->view(), cudf::numeric_scalar<int64_t>(i * m_slide), cudf::binary_operator::SUB, Int64Type);
+
+        std::vector<cudf::column_view> columns(keys);
+        columns.push_back(starts->view());
+        columns.insert(columns.end(), values.begin(), values.end());
+        const cudf::table_view rows{columns};
+
+        if (!m_watermark.has_value())
+        {
+            window_rows.push_back(std::make_unique<cudf::table>(rows));
+            continue;
+        }
+
+        // Closed windows do not take rows anymore, rows whose newest window is closed are late
+        auto is_open = compare(starts->view(), *m_watermark - m_window, cudf::binary_operator::GREATER);
+        window_rows.push_back(cudf::apply_boolean_mask(rows, is_open->view()));
+
+        if (i == 0)
+        {
+            num_late = num_rows - window_rows.back()->num_rows();
+        }
+    }
+
+    std::vector<cudf::table_view> views;
+    for (const auto& rows : window_rows)
+    {
+        views.push_back(rows->view());
+    }
+
+    auto partials = aggregate(views.size() == 1 ? views[0] : cudf::concatenate(views)->view(), false);
+
+    if (m_state == nullptr || m_state->num_rows() == 0)
+    {
+        m_state = std::move(partials);
+    }
+    else
+    {
+        m_state = aggregate(cudf::concatenate(std::vector<cudf::table_view>{m_state->view(), partials->view()})->view(),
+                            true);
+    }
+
+    auto max_timestamp   = cudf::minmax(timestamps).second;
+    const auto watermark = static_cast<const cudf::numeric_scalar<int64_t>&>(*max_timestamp).value() -
+                           m_allowed_lateness;
+    m_watermark = m_watermark.has_value() ? std::max(*m_watermark, watermark) : watermark;
+
+    return num_late;
+}
+
+std::shared_ptr<MessageMeta> WindowAggregator::take_closed(bool flush)
+{
+    if (m_state == nullptr || m_state->num_rows() == 0 || !m_watermark.has_value())
+    {
+        return nullptr;
+    }
+
+    const auto start_index = static_cast<cudf::size_type>(m_key_columns.size());
+
+    std::unique_ptr<cudf::table> closed;
+    if (flush)
+    {
+        closed = std::move(m_state);
+    }
+    else
+    {
+        auto is_closed =
+            compare(m_state->view().column(start_index), *m_watermark - m_window, cudf::binary_operator::LESS_EQUAL);
+
+        closed = cudf::apply_boolean_mask(m_state->view(), is_closed->view());
+        if (closed->num_rows() == 0)
+        {
+            return nullptr;
+        }
+
+        auto is_open = cudf::unary_operation(is_closed->view(), cudf::unary_operator::NOT);
+        m_state      = cudf::apply_boolean_mask(m_state->view(), is_open->view());
+    }
+
+    // Ordered by window, then by key
+    std::vector<cudf::size_type> order{start_index};
+    for (cudf::size_type i = 0; i < start_index; ++i)
+    {
+        order.push_back(i);
+    }
+
+    auto columns = cudf::sort_by_key(closed->view(), closed->view().select(order))->release();
+
+    cudf::io::table_with_metadata table;
+    std::vector<std::unique_ptr<cudf::column>> output;
+    auto add_column = [&](std::string name, std::unique_ptr<cudf::column> column) {
+        table.metadata.schema_info.emplace_back(std::move(name));
+        output.push_back(std::move(column));
+    };
+
+    for (cudf::size_type i = 0; i < start_index; ++i)
+    {
+        add_column(m_key_columns[i], std::move(columns[i]));
+    }
+
+    const cudf::data_type timestamp_type{cudf::type_id::TIMESTAMP_NANOSECONDS};
+    auto starts = columns[start_index]->view();
+    auto ends =
+        cudf::binary_operation(starts, cudf::numeric_scalar<int64_t>(m_window), cudf::binary_operator::ADD, Int64Type);
+
+    add_column("window_start", std::make_unique<cudf::column>(cudf::bit_cast(starts, timestamp_type)));
+    add_column("window_end", std::make_unique<cudf::column>(cudf::bit_cast(ends->view(), timestamp_type)));
+    add_column("count", std::move(columns[start_index + 1]));
+
+    // Partial aggregates may be shared by several outputs, they are copied
+    auto partial_view = [&](std::size_t partial) {
+        return columns[start_index + 2 + partial]->view();
+    };
+
+    for (const auto& spec : m_outputs)
+    {
+        if (spec.aggregation == "mean")
+        {
+            add_column(spec.name,
+                       cudf::binary_operation(partial_view(spec.partial),
+                                              partial_view(spec.count_partial),
+                                              cudf::binary_operator::TRUE_DIV,
+                                              cudf::data_type{cudf::type_id::FLOAT64}));
+        }
+        else
+        {
+            add_column(spec.name, std::make_unique<cudf::column>(partial_view(spec.partial)));
+        }
+    }
+
+    table.tbl = std::make_unique<cudf::table>(std::move(output));
+
+    return MessageMeta::create_from_cpp(std::move(table), 0);
+}
+
+cudf::size_type WindowAggregator::num_open() const
+{
+    return m_state == nullptr ? 0 : m_state->num_rows();
+}
+
+std::optional<int64_t> WindowAggregator::watermark() const
+{
+    return m_watermark;
+}
+
+// Component public implementations
+// ************ WindowAggregateStage ******************************* //
+WindowAggregateStage::WindowAggregateStage(std::vector<std::string> key_columns,
+                                           std::string timestamp_column,
+                                           const std::map<std::string, std::vector<std::string>>& aggregations,
+                                           std::chrono::nanoseconds window,
+                                           std::chrono::nanoseconds slide,
+                                           std::chrono::nanoseconds allowed_lateness,
+                                           const std::string& metrics_name) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_aggregator(std::move(key_columns), std::move(timestamp_column), aggregations, window, slide, allowed_lateness)
+{
+    const metric_labels_t labels{{"stage", metrics_name}};
+    auto& registry = MetricsRegistry::get_instance();
+
+    m_late_rows = registry.get_counter(
+        "morpheus_window_aggregate_late_rows_total", "Rows dropped as all of their windows were closed", labels);
+    m_open_windows =
+        registry.get_gauge("morpheus_window_aggregate_open_windows", "Aggregates of open (key, window) pairs", labels);
+}
+
+WindowAggregateStage::subscribe_fn_t WindowAggregateStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [this, &output](sink_type_t x) {
+                auto payload = x->payload();
+                if (payload == nullptr)
+                {
+                    throw std::runtime_error("Window aggregate requires a control message with a payload");
+                }
+
+                const auto num_late = m_aggregator.update(payload->get_info());
+                if (num_late > 0)
+                {
+                    DVLOG(10) << "Window aggregate dropped " << num_late << " late rows";
+                    m_late_rows->increment(static_cast<double>(num_late));
+                }
+
+                auto closed = m_aggregator.take_closed();
+                m_open_windows->set(static_cast<double>(m_aggregator.num_open()));
+                MORPHEUS_TRACE("window_aggregate.update", payload->count(), closed == nullptr ? 0 : closed->count());
+
+                if (closed != nullptr)
+                {
+                    output.on_next(std::move(closed));
+                }
+            },
+            [&output](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [this, &output]() {
+                std::shared_ptr<MessageMeta> remaining;
+                try
+                {
+                    remaining = m_aggregator.take_closed(true);
+                } catch (...)
+                {
+                    output.on_error(std::current_exception());
+                    return;
+                }
+
+                m_open_windows->set(0);
+                if (remaining != nullptr)
+                {
+                    output.on_next(std::move(remaining));
+                }
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ WindowAggregateStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<WindowAggregateStage>> WindowAggregateStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::vector<std::string> key_columns,
+    std::string timestamp_column,
+    const std::map<std::string, std::vector<std::string>>& aggregations,
+    int64_t window_ns,
+    int64_t slide_ns,
+    int64_t allowed_lateness_ns)
+{
+    // Windows tumble unless a slide is given
+    const auto slide = std::chrono::nanoseconds(slide_ns == 0 ? window_ns : slide_ns);
+
+    return builder.construct_object<WindowAggregateStage>(name,
+                                                          std::move(key_columns),
+                                                          std::move(timestamp_column),
+                                                          aggregations,
+                                                          std::chrono::nanoseconds(window_ns),
+                                                          slide,
+                                                          std::chrono::nanoseconds(allowed_lateness_ns),
+                                                          name);
+}
+
+}  // namespace morpheus
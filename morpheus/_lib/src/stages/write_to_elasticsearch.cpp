@@ -0,0 +1,417 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/write_to_elasticsearch.hpp"  // IWYU pragma: associated
+
+#include "mrc/segment/builder.hpp"
+#include "mrc/segment/object.hpp"
+#include "pymrc/node.hpp"
+
+#include "morpheus/io/serializers.hpp"
+#include "morpheus/objects/table_info.hpp"
+#include "morpheus/utilities/http_client.hpp"  // for AsyncHttpClient, HttpClientRequest
+#include "morpheus/utilities/nvtx_util.hpp"    // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+#include "morpheus/utilities/string_util.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/status.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <boost/beast/version.hpp>
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>  // for min
+#include <exception>
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <thread>
+#include <utility>
+
+namespace morpheus {
+
+namespace http = boost::beast::http;
+
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "WriteToElasticsearchStage");
+
+// Item level rejections which are transient, the bulk thread pool queue being full or a shard being unavailable
+bool is_retryable(unsigned status)
+{
+    return status == static_cast<unsigned>(http::status::too_many_requests) ||
+           status == static_cast<unsigned>(http::status::service_unavailable);
+}
+}  // namespace
+
+// ************ ElasticsearchBulkRequest **************************** //
+std::size_t ElasticsearchBulkRequest::num_items() const
+{
+    return offsets.empty() ? 0 : offsets.size() - 1;
+}
+
+ElasticsearchBulkRequest ElasticsearchBulkRequest::subset(const std::vector<std::size_t>& items) const
+{
+    ElasticsearchBulkRequest request;
+    request.offsets.reserve(items.size() + 1);
+
+    for (auto item : items)
+    {
+        request.offsets.push_back(request.body.size());
+        request.body.append(body, offsets[item], offsets[item + 1] - offsets[item]);
+    }
+
+    request.offsets.push_back(request.body.size());
+
+    return request;
+}
+
+std::vector<ElasticsearchBulkRequest> make_bulk_requests(const std::string& json_lines,
+                                                         const std::string& action_line,
+                                                         std::size_t max_bytes,
+                                                         std::size_t max_docs)
+{
+    std::vector<ElasticsearchBulkRequest> requests;
+    ElasticsearchBulkRequest current;
+
+    auto finish_current = [&]() {
+        if (!current.offsets.empty())
+        {
+            current.offsets.push_back(current.body.size());
+            requests.push_back(std::move(current));
+            current = {};
+        }
+    };
+
+    std::size_t pos = 0;
+    while (pos < json_lines.size())
+    {
+        auto end = json_lines.find('\n', pos);
+        end      = (end == std::string::npos) ? json_lines.size() : end;
+
+        auto doc_size  = end - pos;
+        auto item_size = action_line.size() + 1 + doc_size + 1;
+
+        if (doc_size > 0)
+        {
+            bool is_full = current.offsets.size() >= max_docs ||
+                           (!current.offsets.empty() && current.body.size() + item_size > max_bytes);
+            if (is_full)
+            {
+                finish_current();
+            }
+
+            current.offsets.push_back(current.body.size());
+            current.body.append(action_line);
+            current.body += '\n';
+            current.body.append(json_lines, pos, doc_size);
+            current.body += '\n';
+        }
+
+        pos = end + 1;
+    }
+
+    finish_current();
+
+    return requests;
+}
+
+ElasticsearchBulkResult parse_bulk_response(const std::string& response_body, std::size_t num_items)
+{
+    auto response = nlohmann::json::parse(response_body);
+
+    ElasticsearchBulkResult result;
+    if (!response.value("errors", false))
+    {
+        return result;
+    }
+
+    const auto& items = response.at("items");
+    if (!items.is_array() || items.size() != num_items)
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Expected " << num_items << " items in the bulk response, got "
+                                                                 << (items.is_array() ? items.size() : 0)));
+    }
+
+    for (std::size_t i = 0; i < num_items; ++i)
+    {
+        // Each item is an object with a single key, the action performed
+        const auto& item = items[i].begin().value();
+        auto status      = item.at("status").get<unsigned>();
+
+        if (status < 300)
+        {
+            continue;
+        }
+
+        if (is_retryable(status))
+        {
+            result.retry_items.push_back(i);
+            continue;
+        }
+
+        if (result.num_failed++ == 0)
+        {
+            result.first_error = item.contains("error") ? item["error"].dump() : std::to_string(status);
+        }
+    }
+
+    return result;
+}
+
+// Component public implementations
+// ************ WriteToElasticsearchStage **************************** //
+WriteToElasticsearchStage::WriteToElasticsearchStage(std::string host,
+                                                     unsigned short port,
+                                                     std::string index,
+                                                     std::map<std::string, std::string> headers,
+                                                     std::size_t max_bulk_bytes,
+                                                     std::size_t max_bulk_docs,
+                                                     std::size_t max_concurrent_requests,
+                                                     std::size_t max_retries,
+                                                     std::chrono::milliseconds retry_interval,
+                                                     bool raise_on_exception) :
+  PythonNode(base_t::op_factory_from_sub_fn(build_operator())),
+  m_host(std::move(host)),
+  m_port(std::to_string(port)),
+  m_target("/" + index + "/_bulk"),
+  m_headers(std::move(headers)),
+  m_max_bulk_bytes(max_bulk_bytes),
+  m_max_bulk_docs(max_bulk_docs),
+  m_max_concurrent_requests(max_concurrent_requests),
+  m_max_retries(max_retries),
+  m_retry_interval(retry_interval),
+  m_raise_on_exception(raise_on_exception)
+{
+    if (index.empty() || index.find_first_of("/\\*?\"<>| ,#") != std::string::npos)
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Invalid index name: '" << index << "'"));
+    }
+
+    if (m_max_bulk_bytes == 0 || m_max_bulk_docs == 0)
+    {
+        throw std::invalid_argument("max_bulk_bytes and max_bulk_docs must be greater than 0");
+    }
+
+    if (m_max_retries == 0)
+    {
+        throw std::invalid_argument("max_retries must be greater than 0");
+    }
+
+    m_headers["Content-Type"] = "application/x-ndjson";
+}
+
+WriteToElasticsearchStage::subscribe_fn_t WriteToElasticsearchStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        // The index is part of the target, the action line is the same for every document
+        const std::string action_line = R"({"index":{}})";
+
+        // 503 and 504 responses to a whole request are retried by the client itself
+        AsyncHttpClient client(m_max_concurrent_requests, static_cast<int>(m_max_retries), m_retry_interval);
+
+        auto make_request = [this](std::string body) {
+            HttpClientRequest request{{}, m_host, m_port};
+            request.request.method(http::verb::post);
+            request.request.version(11);
+            request.request.target(m_target);
+            request.request.set(http::field::host, m_host);
+            request.request.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+
+            for (const auto& [key, value] : m_headers)
+            {
+                request.request.set(key, value);
+            }
+
+            request.request.keep_alive(true);
+            request.request.body() = std::move(body);
+            request.request.prepare_payload();
+
+            return request;
+        };
+
+        // Sends `pending`, retrying whatever was rejected as transient, and returns the number of documents which
+        // could not be written along with the first error
+        auto write_bulk = [&](std::vector<ElasticsearchBulkRequest> pending) {
+            std::size_t num_failed = 0;
+            std::string first_error;
+
+            auto record_failure = [&](std::size_t count, std::string error) {
+                if (num_failed == 0)
+                {
+                    first_error = std::move(error);
+                }
+
+                num_failed += count;
+            };
+
+            for (std::size_t attempt = 1; !pending.empty(); ++attempt)
+            {
+                std::vector<HttpClientRequest> requests;
+                requests.reserve(pending.size());
+                for (const auto& bulk : pending)
+                {
+                    requests.push_back(make_request(bulk.body));
+                }
+
+                auto responses = client.send_all(std::move(requests));
+
+                std::vector<ElasticsearchBulkRequest> retry;
+                for (std::size_t i = 0; i < pending.size(); ++i)
+                {
+                    auto& bulk  = pending[i];
+                    auto status = responses[i].result_int();
+
+                    if (status == static_cast<unsigned>(http::status::too_many_requests))
+                    {
+                        retry.push_back(std::move(bulk));
+                    }
+                    else if (status != static_cast<unsigned>(http::status::ok))
+                    {
+                        record_failure(bulk.num_items(),
+                                       MORPHEUS_CONCAT_STR("Received status code " << status << ": "
+                                                                                   << responses[i].body()));
+                    }
+                    else
+                    {
+                        auto result = parse_bulk_response(responses[i].body(), bulk.num_items());
+                        if (result.num_failed > 0)
+                        {
+                            record_failure(result.num_failed, std::move(result.first_error));
+                        }
+
+                        if (!result.retry_items.empty())
+                        {
+                            retry.push_back(bulk.subset(result.retry_items));
+                        }
+                    }
+                }
+
+                if (!retry.empty() && attempt >= m_max_retries)
+                {
+                    for (const auto& bulk : retry)
+                    {
+                        record_failure(bulk.num_items(),
+                                       MORPHEUS_CONCAT_STR("Still rejected after " << attempt << " attempts"));
+                    }
+
+                    break;
+                }
+
+                if (!retry.empty())
+                {
+                    auto sleep_time = m_retry_interval * (1 << std::min<std::size_t>(attempt - 1, 16));
+                    LOG(WARNING) << "Elasticsearch rejected " << retry.size() << " bulk requests to " << m_host << ":"
+                                 << m_port << m_target << " as too busy. Retrying in " << sleep_time.count() << "ms";
+
+                    std::this_thread::sleep_for(sleep_time);
+                }
+
+                pending = std::move(retry);
+            }
+
+            return std::make_pair(num_failed, std::move(first_error));
+        };
+
+        auto make_write_error = [this](const std::string& error) {
+            return std::make_exception_ptr(std::runtime_error(MORPHEUS_CONCAT_STR(
+                "Error occurred in WriteToElasticsearchStage while writing to " << m_host << ":" << m_port << m_target
+                                                                                << ". Error: " << error)));
+        };
+
+        return input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [&](sink_type_t msg) {
+                auto info     = msg->get_info();
+                auto num_rows = static_cast<std::size_t>(info.num_rows());
+
+                MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", num_rows);
+
+                if (num_rows > 0)
+                {
+                    std::string error;
+
+                    try
+                    {
+                        // Serialize every row on the GPU once, and interleave the action lines while splitting the
+                        // result into bulk requests on the host
+                        auto json_lines                = df_to_json(info, false);
+                        auto [num_failed, first_error] = write_bulk(
+                            make_bulk_requests(json_lines, action_line, m_max_bulk_bytes, m_max_bulk_docs));
+
+                        if (num_failed > 0)
+                        {
+                            error = MORPHEUS_CONCAT_STR("Failed to write " << num_failed << " of " << num_rows
+                                                                           << " documents: " << first_error);
+                        }
+                    } catch (const std::exception& e)
+                    {
+                        error = e.what();
+                    }
+
+                    if (!error.empty())
+                    {
+                        LOG(ERROR) << "Error writing to Elasticsearch: " << error;
+
+                        if (m_raise_on_exception)
+                        {
+                            output.on_error(make_write_error(error));
+                            return;
+                        }
+                    }
+                }
+
+                output.on_next(std::move(msg));
+            },
+            [&](std::exception_ptr error_ptr) {
+                output.on_error(error_ptr);
+            },
+            [&]() {
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ WriteToElasticsearchStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<WriteToElasticsearchStage>> WriteToElasticsearchStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string host,
+    unsigned short port,
+    std::string index,
+    std::map<std::string, std::string> headers,
+    std::size_t max_bulk_bytes,
+    std::size_t max_bulk_docs,
+    std::size_t max_concurrent_requests,
+    std::size_t max_retries,
+    float retry_interval,
+    bool raise_on_exception)
+{
+    auto stage = builder.construct_object<WriteToElasticsearchStage>(
+        name,
+        std::move(host),
+        port,
+        std::move(index),
+        std::move(headers),
+        max_bulk_bytes,
+        max_bulk_docs,
+        max_concurrent_requests,
+        max_retries,
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::duration<float>(retry_interval)),
+        raise_on_exception);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -21,49 +21,85 @@
 #include "mrc/segment/object.hpp"
 #include "pymrc/node.hpp"
 
+#include "morpheus/io/async_file_writer.hpp"
 #include "morpheus/io/serializers.hpp"
+#include "morpheus/utilities/nvtx_util.hpp"  // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
 #include "morpheus/utilities/string_util.hpp"
 
+#include <cudf/io/types.hpp>         // for table_with_metadata
+#include <cudf/partitioning.hpp>  // for hash_partition
+
+#include <algorithm>  // for find
+#include <chrono>     // for seconds, steady_clock
 #include <exception>
+#include <filesystem>  // for path
+#include <iterator>    // for distance
 #include <memory>
+#include <mutex>  // for lock_guard, unique_lock, try_to_lock
 #include <sstream>
 #include <stdexcept>  // for invalid_argument, runtime_error
 #include <string>
-#include <utility>  // for forward, move, addressof
+#include <type_traits>  // for is_same_v
+#include <utility>      // for move
 
 namespace morpheus {
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "WriteToFileStage");
+}  // namespace
 
 // Component public implementations
 // ************ WriteToFileStage **************************** //
-WriteToFileStage::WriteToFileStage(
-    const std::string& filename, std::ios::openmode mode, FileTypes file_type, bool include_index_col, bool flush) :
-  PythonNode(base_t::op_factory_from_sub_fn(build_operator())),
-  m_is_first(true),
+template <typename InputT>
+WriteToFileStage<InputT>::WriteToFileStage(const std::string& filename,
+                                           std::ios::openmode mode,
+                                           FileTypes file_type,
+                                           bool include_index_col,
+                                           bool flush,
+                                           const std::string& compression,
+                                           std::size_t row_group_size_rows,
+                                           std::size_t max_file_bytes,
+                                           std::chrono::seconds max_file_age,
+                                           std::size_t max_queued_writes,
+                                           bool device_write,
+                                           std::size_t num_shards,
+                                           const std::string& shard_column) :
+  base_t(base_t::op_factory_from_sub_fn(build_operator())),
+  m_filename(filename),
+  m_mode(mode),
   m_include_index_col(include_index_col),
-  m_flush(flush)
+  m_flush(flush),
+  m_compression(compression),
+  m_max_file_bytes(max_file_bytes),
+  m_max_file_age(max_file_age),
+  m_row_group_size_rows(row_group_size_rows),
+  m_max_queued_writes(max_queued_writes),
+  m_device_write(device_write),
+  m_shard_column(shard_column)
 {
     if (file_type == FileTypes::Auto)
     {
         file_type = determine_file_type(filename);
     }
 
+    m_file_type = file_type;
+
     switch (file_type)
     {
     case FileTypes::JSON: {
-        m_write_func = [this](auto&& PH1) {
-            write_json(std::forward<decltype(PH1)>(PH1));
+        m_write_func = [this](Shard& shard, const TableInfo& tbl) {
+            write_json(shard, tbl);
         };
         break;
     }
     case FileTypes::CSV: {
-        m_write_func = [this](auto&& PH1) {
-            write_csv(std::forward<decltype(PH1)>(PH1));
+        m_write_func = [this](Shard& shard, const TableInfo& tbl) {
+            write_csv(shard, tbl);
         };
         break;
     }
     case FileTypes::PARQUET: {
-        m_write_func = [this](auto&& PH1) {
-            write_parquet(std::forward<decltype(PH1)>(PH1));
+        m_write_func = [this](Shard& shard, const TableInfo& tbl) {
+            write_parquet(shard, tbl);
         };
         break;
     }
@@ -73,67 +109,386 @@ WriteToFileStage::WriteToFileStage(
             MORPHEUS_CONCAT_STR("Unknown extension for file: '" << filename << "'. File type: " << file_type));
     }
 
-    // Enable throwing exceptions in case something fails.
-    m_fstream.exceptions(std::fstream::failbit | std::fstream::badbit);
+    if (num_shards == 0)
+    {
+        throw std::invalid_argument("num_shards must be at least one");
+    }
+
+    if (file_type == FileTypes::PARQUET)
+    {
+        if (m_compression.empty())
+        {
+            m_compression = "snappy";
+        }
+    }
+    else
+    {
+        m_gzip = m_compression == "gzip";
+        if (!m_gzip && !m_compression.empty() && m_compression != "none")
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+                "Unsupported compression for CSV and JSON files: '" << m_compression << "'. Must be 'none' or 'gzip'"));
+        }
+
+        if (m_gzip)
+        {
+            m_filename += ".gz";
+        }
+
+        if (m_device_write && (m_gzip || max_queued_writes > 0))
+        {
+            throw std::invalid_argument(
+                "device_write is not supported along with gzip compression or max_queued_writes");
+        }
+    }
+
+    if (m_device_write && (mode & std::ios::app))
+    {
+        // File sinks always truncate the file
+        throw std::invalid_argument("device_write is not supported when appending to files");
+    }
+
+    for (std::size_t i = 0; i < num_shards; ++i)
+    {
+        auto shard = std::make_unique<Shard>();
+
+        // A single shard keeps writing to `filename` itself
+        shard->filename = num_shards > 1 ? insert_suffix(m_filename, MORPHEUS_CONCAT_STR("shard-" << i)) : m_filename;
+
+        if (m_file_type != FileTypes::PARQUET && (m_gzip || m_max_queued_writes > 0))
+        {
+            shard->file_writer = std::make_unique<AsyncFileWriter>(m_max_queued_writes, m_gzip, m_flush);
+        }
+
+        // Enable throwing exceptions in case something fails.
+        shard->fstream.exceptions(std::fstream::failbit | std::fstream::badbit);
+
+        open_file(*shard);
+
+        m_shards.push_back(std::move(shard));
+    }
+}
+
+template <typename InputT>
+void WriteToFileStage<InputT>::write(const TableInfo& tbl)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "write", tbl.num_rows());
+
+    const auto num_shards = m_shards.size();
+
+    if (num_shards == 1)
+    {
+        auto& shard = *m_shards.front();
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        write_shard(shard, tbl);
+        return;
+    }
+
+    if (m_shard_column.empty())
+    {
+        // Prefer a shard no other thread is writing to, starting from the next one in turn to spread the messages
+        const auto start = m_next_shard.fetch_add(1) % num_shards;
+        for (std::size_t i = 0; i < num_shards; ++i)
+        {
+            auto& shard = *m_shards[(start + i) % num_shards];
+            std::unique_lock<std::mutex> lock(shard.mutex, std::try_to_lock);
+            if (lock.owns_lock())
+            {
+                write_shard(shard, tbl);
+                return;
+            }
+        }
+
+        // Every shard is busy, wait for our turn on the first one
+        auto& shard = *m_shards[start];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        write_shard(shard, tbl);
+        return;
+    }
+
+    const auto column_names = tbl.get_column_names();
+    auto found              = std::find(column_names.begin(), column_names.end(), m_shard_column);
+    if (found == column_names.end())
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Shard column '" << m_shard_column << "' not found in the message"));
+    }
+
+    const cudf::size_type shard_col_idx = tbl.num_indices() + std::distance(column_names.begin(), found);
+
+    // Groups the rows of each shard together, the i-th shard holding the rows [offsets[i], offsets[i + 1])
+    auto [partitioned, offsets] = cudf::hash_partition(tbl.get_view(), {shard_col_idx}, static_cast<int>(num_shards));
+    offsets.push_back(tbl.num_rows());
+
+    // Wraps the partitioned table without going through python, keeping the index columns as the index
+    cudf::io::table_with_metadata partitioned_with_meta{std::move(partitioned)};
+    for (const auto& name : tbl.get_index_names())
+    {
+        partitioned_with_meta.metadata.schema_info.emplace_back(name);
+    }
+    for (const auto& name : column_names)
+    {
+        partitioned_with_meta.metadata.schema_info.emplace_back(name);
+    }
+
+    auto partitioned_meta = MessageMeta::create_from_cpp(std::move(partitioned_with_meta), tbl.num_indices());
+    auto partitioned_info = partitioned_meta->get_info();
+
+    for (std::size_t i = 0; i < num_shards; ++i)
+    {
+        if (offsets[i] == offsets[i + 1])
+        {
+            continue;
+        }
+
+        auto& shard = *m_shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        write_shard(shard, partitioned_info.get_slice(offsets[i], offsets[i + 1]));
+    }
+}
+
+template <typename InputT>
+void WriteToFileStage<InputT>::write_shard(Shard& shard, const TableInfo& tbl)
+{
+    rotate_if_needed(shard);
+    m_write_func(shard, tbl);
+    shard.is_first = false;
+}
+
+template <typename InputT>
+void WriteToFileStage<InputT>::write_json(Shard& shard, const TableInfo& tbl)
+{
+    if (shard.file_writer)
+    {
+        shard.file_writer->write(df_to_json(tbl, m_include_index_col));
+    }
+    else if (shard.sink)
+    {
+        df_to_json(tbl, *shard.sink, m_include_index_col, m_flush);
+    }
+    else
+    {
+        // Call df_to_json passing our fstream
+        df_to_json(tbl, shard.fstream, m_include_index_col, m_flush);
+    }
+}
+
+template <typename InputT>
+void WriteToFileStage<InputT>::write_csv(Shard& shard, const TableInfo& tbl)
+{
+    if (shard.file_writer)
+    {
+        shard.file_writer->write(df_to_csv(tbl, shard.is_first, m_include_index_col));
+    }
+    else if (shard.sink)
+    {
+        df_to_csv(tbl, *shard.sink, shard.is_first, m_include_index_col, m_flush);
+    }
+    else
+    {
+        // Call df_to_csv passing our fstream
+        df_to_csv(tbl, shard.fstream, shard.is_first, m_include_index_col, m_flush);
+    }
+}
+
+template <typename InputT>
+void WriteToFileStage<InputT>::write_parquet(Shard& shard, const TableInfo& tbl)
+{
+    shard.parquet_writer->write(tbl);
+
+    if (m_flush && shard.fstream.is_open())
+    {
+        shard.fstream.flush();
+    }
+}
+
+template <typename InputT>
+void WriteToFileStage<InputT>::rotate_if_needed(Shard& shard)
+{
+    // Every file holds at least one message
+    if (shard.is_first)
+    {
+        return;
+    }
+
+    const bool is_full = m_max_file_bytes > 0 && file_bytes(shard) >= m_max_file_bytes;
+    const bool is_old =
+        m_max_file_age.count() > 0 && (std::chrono::steady_clock::now() - shard.file_opened) >= m_max_file_age;
+
+    if (is_full || is_old)
+    {
+        close_file(shard);
+        ++shard.file_index;
+        open_file(shard);
 
-    m_fstream.open(filename, mode);
+        // Each CSV file starts with its own header
+        shard.is_first = true;
+    }
 }
 
-void WriteToFileStage::write_json(WriteToFileStage::sink_type_t& msg)
+template <typename InputT>
+std::size_t WriteToFileStage<InputT>::file_bytes(Shard& shard)
 {
-    // Call df_to_json passing our fstream
-    df_to_json(msg->get_info(), m_fstream, m_include_index_col, m_flush);
+    if (shard.parquet_writer)
+    {
+        return shard.parquet_writer->bytes_written();
+    }
+
+    if (shard.file_writer)
+    {
+        return shard.file_writer->bytes_queued();
+    }
+
+    if (shard.sink)
+    {
+        return shard.sink->bytes_written();
+    }
+
+    return static_cast<std::size_t>(shard.fstream.tellp());
 }
 
-void WriteToFileStage::write_csv(WriteToFileStage::sink_type_t& msg)
+template <typename InputT>
+std::filesystem::path WriteToFileStage<InputT>::insert_suffix(const std::filesystem::path& path,
+                                                              const std::string& suffix) const
 {
-    // Call df_to_csv passing our fstream
-    df_to_csv(msg->get_info(), m_fstream, m_is_first, m_include_index_col, m_flush);
+    // Keeps the compression suffix last, such that `out.csv.gz` is followed by `out.1.csv.gz`
+    auto stem      = path.stem();
+    auto extension = path.extension().string();
+    if (m_gzip && extension == ".gz")
+    {
+        extension = stem.extension().string() + extension;
+        stem      = stem.stem();
+    }
+
+    auto result = path;
+    result.replace_filename(MORPHEUS_CONCAT_STR(stem.string() << "." << suffix << extension));
+
+    return result;
+}
+
+template <typename InputT>
+void WriteToFileStage<InputT>::open_file(Shard& shard)
+{
+    auto path = shard.filename;
+    if (shard.file_index > 0)
+    {
+        path = insert_suffix(path, std::to_string(shard.file_index));
+    }
+
+    shard.file_opened = std::chrono::steady_clock::now();
+
+    if (shard.file_writer)
+    {
+        shard.file_writer->open(path, m_mode);
+        return;
+    }
+
+    if (m_file_type == FileTypes::PARQUET)
+    {
+        if (m_device_write)
+        {
+            shard.parquet_writer = std::make_unique<ChunkedParquetWriter>(
+                create_file_sink(path.string()), m_include_index_col, m_compression, m_row_group_size_rows);
+        }
+        else
+        {
+            shard.fstream.open(path, m_mode | std::ios::binary);
+            shard.parquet_writer = std::make_unique<ChunkedParquetWriter>(
+                shard.fstream, m_include_index_col, m_compression, m_row_group_size_rows);
+        }
+    }
+    else if (m_device_write)
+    {
+        shard.sink = create_file_sink(path.string());
+    }
+    else
+    {
+        shard.fstream.open(path, m_mode);
+    }
 }
 
-void WriteToFileStage::write_parquet(WriteToFileStage::sink_type_t& msg)
+template <typename InputT>
+void WriteToFileStage<InputT>::close_file(Shard& shard)
 {
-    // Call df_to_csv passing our fstream
-    df_to_parquet(msg->get_info(), m_fstream, m_is_first, m_include_index_col, m_flush);
+    if (shard.parquet_writer)
+    {
+        // Writes the footer of the file
+        shard.parquet_writer->close();
+        shard.parquet_writer.reset();
+    }
+
+    if (shard.sink)
+    {
+        shard.sink->flush();
+        shard.sink.reset();
+    }
+
+    if (shard.fstream.is_open())
+    {
+        shard.fstream.close();
+    }
 }
 
-void WriteToFileStage::close()
+template <typename InputT>
+void WriteToFileStage<InputT>::close()
 {
-    if (m_fstream.is_open())
+    for (auto& shard : m_shards)
     {
-        m_fstream.close();
+        std::lock_guard<std::mutex> lock(shard->mutex);
+
+        close_file(*shard);
+
+        if (shard->file_writer)
+        {
+            // Waits for the queued buffers to be written
+            shard->file_writer->close();
+        }
     }
 }
 
-WriteToFileStage::subscribe_fn_t WriteToFileStage::build_operator()
+template <typename InputT>
+typename WriteToFileStage<InputT>::subscribe_fn_t WriteToFileStage<InputT>::build_operator()
 {
     return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        ++m_active_subscriptions;
+
         return input.subscribe(rxcpp::make_observer<sink_type_t>(
             [this, &output](sink_type_t msg) {
-                this->m_write_func(msg);
-                m_is_first = false;
+                if constexpr (std::is_same_v<InputT, ControlMessage>)
+                {
+                    this->write(msg->payload()->get_info());
+                    msg->payload()->acknowledge();
+                }
+                else
+                {
+                    this->write(msg->get_info());
+                    msg->acknowledge();
+                }
+
                 output.on_next(std::move(msg));
             },
             [&](std::exception_ptr error_ptr) {
-                this->close();
+                if (--m_active_subscriptions == 0)
+                {
+                    this->close();
+                }
                 output.on_error(error_ptr);
             },
             [&]() {
-                this->close();
+                if (--m_active_subscriptions == 0)
+                {
+                    this->close();
+                }
                 output.on_completed();
             }));
     };
 }
 
+template class WriteToFileStage<MessageMeta>;
+template class WriteToFileStage<ControlMessage>;
+
 // ************ WriteToFileStageInterfaceProxy ************* //
-std::shared_ptr<mrc::segment::Object<WriteToFileStage>> WriteToFileStageInterfaceProxy::init(
-    mrc::segment::Builder& builder,
-    const std::string& name,
-    const std::string& filename,
-    const std::string& mode,
-    FileTypes file_type,
-    bool include_index_col,
-    bool flush)
+namespace {
+std::ios::openmode parse_mode(const std::string& mode)
 {
     std::ios::openmode fsmode = std::ios::out;
 
@@ -169,8 +524,76 @@ std::shared_ptr<mrc::segment::Object<WriteToFileStage>> WriteToFileStageInterfac
         throw std::runtime_error(std::string("Unsupported file mode. Must choose either 'w' or 'a'. Mode: ") + mode);
     }
 
-    auto stage =
-        builder.construct_object<WriteToFileStage>(name, filename, fsmode, file_type, include_index_col, flush);
+    return fsmode;
+}
+}  // namespace
+
+std::shared_ptr<mrc::segment::Object<WriteToFileStageMeta>> WriteToFileStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    const std::string& filename,
+    const std::string& mode,
+    FileTypes file_type,
+    bool include_index_col,
+    bool flush,
+    const std::string& compression,
+    std::size_t row_group_size_rows,
+    std::size_t max_file_bytes,
+    int64_t max_file_age_secs,
+    std::size_t max_queued_writes,
+    bool device_write,
+    std::size_t num_shards,
+    const std::string& shard_column)
+{
+    auto stage = builder.construct_object<WriteToFileStageMeta>(name,
+                                                                filename,
+                                                                parse_mode(mode),
+                                                                file_type,
+                                                                include_index_col,
+                                                                flush,
+                                                                compression,
+                                                                row_group_size_rows,
+                                                                max_file_bytes,
+                                                                std::chrono::seconds(max_file_age_secs),
+                                                                max_queued_writes,
+                                                                device_write,
+                                                                num_shards,
+                                                                shard_column);
+
+    return stage;
+}
+
+std::shared_ptr<mrc::segment::Object<WriteToFileStageCM>> WriteToFileStageInterfaceProxy::init_cm(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    const std::string& filename,
+    const std::string& mode,
+    FileTypes file_type,
+    bool include_index_col,
+    bool flush,
+    const std::string& compression,
+    std::size_t row_group_size_rows,
+    std::size_t max_file_bytes,
+    int64_t max_file_age_secs,
+    std::size_t max_queued_writes,
+    bool device_write,
+    std::size_t num_shards,
+    const std::string& shard_column)
+{
+    auto stage = builder.construct_object<WriteToFileStageCM>(name,
+                                                              filename,
+                                                              parse_mode(mode),
+                                                              file_type,
+                                                              include_index_col,
+                                                              flush,
+                                                              compression,
+                                                              row_group_size_rows,
+                                                              max_file_bytes,
+                                                              std::chrono::seconds(max_file_age_secs),
+                                                              max_queued_writes,
+                                                              device_write,
+                                                              num_shards,
+                                                              shard_column);
 
     return stage;
 }
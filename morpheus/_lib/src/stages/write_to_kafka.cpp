@@ -0,0 +1,516 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/stages/write_to_kafka.hpp"  // IWYU pragma: associated
+
+#include "mrc/segment/builder.hpp"
+#include "mrc/segment/object.hpp"
+#include "pymrc/node.hpp"
+
+#include "morpheus/io/serializers.hpp"
+#include "morpheus/objects/table_info.hpp"
+#include "morpheus/utilities/nvtx_util.hpp"  // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
+#include "morpheus/utilities/string_util.hpp"
+
+#include <boost/fiber/mutex.hpp>
+#include <boost/fiber/operations.hpp>  // for sleep_for
+#include <cuda_runtime.h>              // for cudaMemcpy, cudaMemcpyDeviceToHost
+#include <cudf/column/column_view.hpp>
+#include <cudf/null_mask.hpp>  // for copy_bitmask
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/types.hpp>
+#include <cudf/utilities/bit.hpp>  // for bit_is_set
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <rmm/cuda_stream_view.hpp>
+
+#include <algorithm>  // for find, count
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+namespace {
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "WriteToKafkaStage");
+
+// Timeout of each request made to the transaction coordinator of the broker
+const std::chrono::milliseconds TransactionRequestTimeout{30000};
+}  // namespace
+
+// Component-private classes.
+// ************ WriteToKafkaStage__Payload ***************************//
+/**
+ * @brief Owns the serialized rows of a single `MessageMeta`. The rows are produced directly out of `data` so the
+ * payload is kept alive until a delivery report has been received for each of them.
+ */
+struct WriteToKafkaStage__Payload  // NOLINT
+{
+    std::string data;
+    std::atomic<std::size_t> outstanding{0};
+
+    // Acknowledged once every row has been delivered, unset when the message is acknowledged by a transaction instead
+    std::shared_ptr<MessageMeta> meta;
+    std::atomic<bool> failed{false};
+
+    /**
+     * @brief Releases `count` rows, deleting the payload once all of them have been released. The message is only
+     * acknowledged when none of its rows failed to be delivered.
+     */
+    static void release(WriteToKafkaStage__Payload* payload, std::size_t count = 1)
+    {
+        if (payload != nullptr && payload->outstanding.fetch_sub(count) == count)
+        {
+            if (payload->meta != nullptr && !payload->failed)
+            {
+                payload->meta->acknowledge();
+            }
+
+            delete payload;
+        }
+    }
+};
+
+// ************ WriteToKafkaStage__DeliveryReport ********************//
+class WriteToKafkaStage__DeliveryReport : public RdKafka::DeliveryReportCb  // NOLINT
+{
+  public:
+    void dr_cb(RdKafka::Message& message) override
+    {
+        if (message.err() != RdKafka::ERR_NO_ERROR)
+        {
+            LOG(ERROR) << "Error occurred in WriteToKafkaStage while writing to topic '" << message.topic_name()
+                       << "'. Error: " << message.errstr();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_error.has_value())
+            {
+                m_error = message.errstr();
+            }
+
+            if (auto* payload = static_cast<WriteToKafkaStage__Payload*>(message.msg_opaque()); payload != nullptr)
+            {
+                payload->failed = true;
+            }
+        }
+
+        WriteToKafkaStage__Payload::release(static_cast<WriteToKafkaStage__Payload*>(message.msg_opaque()));
+    }
+
+    /**
+     * @brief Returns the first delivery error since the last call, if any
+     */
+    std::optional<std::string> take_error()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return std::exchange(m_error, std::nullopt);
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::optional<std::string> m_error;
+};
+
+/**
+ * @brief Copies the string column `key_column` to host. Rows with a null key are reported via `valid`.
+ */
+void copy_keys_to_host(const TableInfo& info,
+                       const std::string& key_column,
+                       std::vector<char>& chars,
+                       std::vector<cudf::size_type>& offsets,
+                       std::vector<bool>& valid)
+{
+    auto column_names = info.get_column_names();
+    auto found        = std::find(column_names.begin(), column_names.end(), key_column);
+
+    if (found == column_names.end())
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Unable to find the key column '" << key_column << "'"));
+    }
+
+    const auto& column = info.get_column(static_cast<cudf::size_type>(found - column_names.begin()));
+
+    if (column.type().id() != cudf::type_id::STRING)
+    {
+        throw std::invalid_argument(
+            MORPHEUS_CONCAT_STR("The key column '" << key_column << "' must be a string column"));
+    }
+
+    cudf::strings_column_view strings{column};
+    auto num_rows = strings.size();
+
+    offsets.resize(num_rows + 1);
+    valid.assign(num_rows, true);
+    chars.clear();
+
+    if (num_rows == 0)
+    {
+        return;
+    }
+
+    MRC_CHECK_CUDA(cudaMemcpy(offsets.data(),
+                              strings.offsets().data<cudf::size_type>() + strings.offset(),
+                              offsets.size() * sizeof(cudf::size_type),
+                              cudaMemcpyDeviceToHost));
+
+    chars.resize(offsets.back() - offsets.front());
+
+    if (!chars.empty())
+    {
+        MRC_CHECK_CUDA(cudaMemcpy(chars.data(),
+                                  strings.chars_begin(rmm::cuda_stream_default) + offsets.front(),
+                                  chars.size(),
+                                  cudaMemcpyDeviceToHost));
+    }
+
+    if (column.has_nulls())
+    {
+        auto mask = cudf::copy_bitmask(column);
+        std::vector<cudf::bitmask_type> host_mask(mask.size() / sizeof(cudf::bitmask_type));
+
+        MRC_CHECK_CUDA(cudaMemcpy(host_mask.data(), mask.data(), mask.size(), cudaMemcpyDeviceToHost));
+
+        for (cudf::size_type i = 0; i < num_rows; ++i)
+        {
+            valid[i] = cudf::bit_is_set(host_mask.data(), i);
+        }
+    }
+}
+
+// Component public implementations
+// ************ WriteToKafkaStage **************************** //
+WriteToKafkaStage::WriteToKafkaStage(std::string topic,
+                                     std::map<std::string, std::string> config,
+                                     std::optional<std::string> key_column,
+                                     uint32_t poll_interval_ms,
+                                     std::optional<std::string> consumer_group_id,
+                                     uint32_t transaction_interval_ms) :
+  PythonNode(base_t::op_factory_from_sub_fn(build_operator())),
+  m_topic(std::move(topic)),
+  m_config(std::move(config)),
+  m_key_column(std::move(key_column)),
+  m_poll_interval_ms(poll_interval_ms),
+  m_transaction_interval_ms(transaction_interval_ms)
+{
+    if (consumer_group_id.has_value())
+    {
+        if (m_config.find("transactional.id") == m_config.end())
+        {
+            throw std::invalid_argument("WriteToKafkaStage requires 'transactional.id' to be set in the producer "
+                                        "configuration when committing the offsets of a consumer group");
+        }
+
+        // Claimed before the pipeline starts, so the source finds the coordinator when it creates its consumer
+        m_transactions = KafkaTransactionCoordinator::claim(*consumer_group_id);
+    }
+}
+
+std::unique_ptr<RdKafka::Conf> WriteToKafkaStage::build_kafka_conf(const std::map<std::string, std::string>& config_in)
+{
+    // Copy the config
+    std::map<std::string, std::string> config_out(config_in);
+
+    // Favor throughput, rows are batched by librdkafka for up to `linger.ms` before being sent
+    std::map<std::string, std::string> defaults{{"linger.ms", "5"},
+                                                {"batch.num.messages", "10000"},
+                                                {"compression.type", "lz4"}};
+
+    // Set some defaults if they dont exist
+    config_out.merge(defaults);
+
+    // Make the kafka_conf and set all properties
+    auto kafka_conf = std::unique_ptr<RdKafka::Conf>(RdKafka::Conf::create(RdKafka::Conf::CONF_GLOBAL));
+
+    for (auto const& key_value : config_out)
+    {
+        std::string error_string;
+        if (RdKafka::Conf::ConfResult::CONF_OK != kafka_conf->set(key_value.first, key_value.second, error_string))
+        {
+            LOG(ERROR) << "Error occurred while setting Kafka configuration. Error: " << error_string;
+        }
+    }
+
+    return std::move(kafka_conf);
+}
+
+WriteToKafkaStage::subscribe_fn_t WriteToKafkaStage::build_operator()
+{
+    return [this](rxcpp::observable<sink_type_t> input, rxcpp::subscriber<source_type_t> output) {
+        WriteToKafkaStage__DeliveryReport delivery_report;
+
+        auto kafka_conf = this->build_kafka_conf(m_config);
+        std::string errstr;
+
+        if (RdKafka::Conf::ConfResult::CONF_OK != kafka_conf->set("dr_cb", &delivery_report, errstr))
+        {
+            LOG(FATAL) << "Error occurred while setting Kafka delivery report callback. Error: " << errstr;
+        }
+
+        auto producer = std::unique_ptr<RdKafka::Producer>(RdKafka::Producer::create(kafka_conf.get(), errstr));
+
+        if (!producer)
+        {
+            LOG(FATAL) << "Error occurred creating Kafka producer. Error: " << errstr;
+        }
+
+        if (m_transactions != nullptr)
+        {
+            m_transactions->attach_producer(producer.get(), TransactionRequestTimeout);
+        }
+
+        // Serve the delivery reports in the background so producing is never blocked on them. Also commits the open
+        // transaction periodically, skipping a round while rows are being produced
+        std::atomic<bool> stop_polling{false};
+        std::thread poller([&producer, &stop_polling, this]() {
+            auto last_commit = std::chrono::steady_clock::now();
+            bool committing  = m_transactions != nullptr;
+
+            while (!stop_polling)
+            {
+                producer->poll(static_cast<int>(m_poll_interval_ms));
+
+                auto now = std::chrono::steady_clock::now();
+
+                if (committing && now - last_commit >= std::chrono::milliseconds(m_transaction_interval_ms))
+                {
+                    try
+                    {
+                        if (m_transactions->try_commit())
+                        {
+                            last_commit = now;
+                        }
+                    } catch (std::exception&)
+                    {
+                        // Already logged, the failure is raised by the next message
+                        committing = false;
+                    }
+                }
+            }
+        });
+
+        auto shutdown = [&]() {
+            // Wait for all outstanding rows to be delivered before stopping the poller
+            while (producer->outq_len() > 0)
+            {
+                producer->flush(static_cast<int>(m_poll_interval_ms));
+            }
+
+            stop_polling = true;
+            poller.join();
+
+            if (m_transactions != nullptr)
+            {
+                m_transactions->detach_producer();
+            }
+        };
+
+        auto make_delivery_error = [this](const std::string& error) {
+            return std::make_exception_ptr(std::runtime_error(MORPHEUS_CONCAT_STR(
+                "Error occurred in WriteToKafkaStage while writing to topic '" << m_topic << "'. Error: " << error)));
+        };
+
+        // Reused for every message to avoid reallocating the key buffers
+        std::vector<char> key_chars;
+        std::vector<cudf::size_type> key_offsets;
+        std::vector<bool> key_valid;
+
+        auto subscription = input.subscribe(rxcpp::make_observer<sink_type_t>(
+            [&](sink_type_t msg) {
+                if (auto error = delivery_report.take_error(); error.has_value())
+                {
+                    output.on_error(make_delivery_error(*error));
+                    return;
+                }
+
+                auto info     = msg->get_info();
+                auto num_rows = info.num_rows();
+
+                MORPHEUS_NVTX_RANGE(NvtxDomain, "on_data", num_rows);
+
+                if (num_rows == 0)
+                {
+                    msg->acknowledge();
+                    output.on_next(std::move(msg));
+                    return;
+                }
+
+                // Held until the message has been acknowledged, so its offsets are committed by the same transaction
+                // as its rows
+                std::unique_lock<boost::fibers::mutex> transaction_lock;
+
+                if (m_transactions != nullptr)
+                {
+                    try
+                    {
+                        transaction_lock = m_transactions->begin();
+                    } catch (std::exception&)
+                    {
+                        output.on_error(std::current_exception());
+                        return;
+                    }
+                }
+
+                if (m_key_column.has_value())
+                {
+                    copy_keys_to_host(info, *m_key_column, key_chars, key_offsets, key_valid);
+                }
+
+                // Serialize every row on the GPU, one JSON object per line
+                auto* payload = new WriteToKafkaStage__Payload{};
+                payload->data        = df_to_json(info);
+                payload->outstanding = num_rows;
+
+                if (m_transactions == nullptr)
+                {
+                    payload->meta = msg;
+                }
+
+                bool produce_failed = false;
+
+                CHECK_EQ(std::count(payload->data.begin(), payload->data.end(), '\n'), num_rows)
+                    << "Serialized JSON does not contain one line per row";
+
+                std::size_t row_start = 0;
+
+                for (cudf::size_type row = 0; row < num_rows; ++row)
+                {
+                    auto row_end = payload->data.find('\n', row_start);
+
+                    const char* key_ptr = nullptr;
+                    std::size_t key_len = 0;
+
+                    if (m_key_column.has_value() && key_valid[row])
+                    {
+                        key_ptr = key_chars.data() + (key_offsets[row] - key_offsets.front());
+                        key_len = key_offsets[row + 1] - key_offsets[row];
+                    }
+
+                    while (true)
+                    {
+                        // Neither RK_MSG_COPY nor RK_MSG_FREE, the row is sent straight out of the payload which is
+                        // released by the delivery report
+                        auto err = producer->produce(m_topic,
+                                                     RdKafka::Topic::PARTITION_UA,
+                                                     0,
+                                                     payload->data.data() + row_start,
+                                                     row_end - row_start,
+                                                     key_ptr,
+                                                     key_len,
+                                                     0,
+                                                     payload);
+
+                        if (err == RdKafka::ERR__QUEUE_FULL)
+                        {
+                            // Wait for the poller to drain some of the delivery reports
+                            boost::this_fiber::sleep_for(std::chrono::milliseconds(10));
+                            continue;
+                        }
+
+                        if (err != RdKafka::ERR_NO_ERROR)
+                        {
+                            LOG(ERROR) << "Error occurred in WriteToKafkaStage while producing to topic '" << m_topic
+                                       << "'. Error: " << RdKafka::err2str(err);
+
+                            // No delivery report will be received for this row
+                            produce_failed  = true;
+                            payload->failed = true;
+                            WriteToKafkaStage__Payload::release(payload);
+                        }
+
+                        break;
+                    }
+
+                    row_start = row_end + 1;
+                }
+
+                // A delivery failure aborts the transaction, so its offsets can be handed over as soon as the rows
+                // have been produced
+                if (m_transactions != nullptr && !produce_failed)
+                {
+                    msg->acknowledge();
+                }
+
+                output.on_next(std::move(msg));
+            },
+            [&](std::exception_ptr error_ptr) {
+                shutdown();
+                output.on_error(error_ptr);
+            },
+            [&]() {
+                std::exception_ptr transaction_error;
+
+                if (m_transactions != nullptr)
+                {
+                    try
+                    {
+                        m_transactions->commit();
+                    } catch (std::exception&)
+                    {
+                        transaction_error = std::current_exception();
+                    }
+                }
+
+                shutdown();
+
+                if (transaction_error)
+                {
+                    output.on_error(transaction_error);
+                    return;
+                }
+
+                if (auto error = delivery_report.take_error(); error.has_value())
+                {
+                    output.on_error(make_delivery_error(*error));
+                    return;
+                }
+
+                output.on_completed();
+            }));
+
+        return subscription;
+    };
+}
+
+// ************ WriteToKafkaStageInterfaceProxy ************* //
+std::shared_ptr<mrc::segment::Object<WriteToKafkaStage>> WriteToKafkaStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    std::string topic,
+    std::map<std::string, std::string> config,
+    std::optional<std::string> key_column,
+    uint32_t poll_interval_ms,
+    std::optional<std::string> consumer_group_id,
+    float transaction_interval)
+{
+    auto stage = builder.construct_object<WriteToKafkaStage>(name,
+                                                             std::move(topic),
+                                                             std::move(config),
+                                                             std::move(key_column),
+                                                             poll_interval_ms,
+                                                             std::move(consumer_group_id),
+                                                             static_cast<uint32_t>(transaction_interval * 1000));
+
+    return stage;
+}
+}  // namespace morpheus
@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/utilities/cuda_util.hpp"
+
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <cuda_runtime.h>       // for cudaGetDevice, cudaSetDevice, cudaGetDeviceCount
+#include <glog/logging.h>       // for LOG
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** CudaUtil ******************************************/
+int CudaUtil::current_device()
+{
+    int device_id;
+    MRC_CHECK_CUDA(cudaGetDevice(&device_id));
+    return device_id;
+}
+
+int CudaUtil::device_count()
+{
+    int count;
+    MRC_CHECK_CUDA(cudaGetDeviceCount(&count));
+    return count;
+}
+
+/****** CudaDeviceGuard ***********************************/
+CudaDeviceGuard::CudaDeviceGuard(int device_id) :
+  m_previous_device(CudaUtil::current_device()),
+  m_device(device_id)
+{
+    if (m_device != m_previous_device)
+    {
+        MRC_CHECK_CUDA(cudaSetDevice(m_device));
+    }
+}
+
+CudaDeviceGuard::~CudaDeviceGuard()
+{
+    // Destructors cannot throw, failures are only logged
+    if (m_device != m_previous_device && cudaSetDevice(m_previous_device) != cudaSuccess)
+    {
+        LOG(ERROR) << "Failed to restore device " << m_previous_device;
+    }
+}
+
+/****** DeviceRoundRobin **********************************/
+DeviceRoundRobin::DeviceRoundRobin(std::vector<int> device_ids) : m_device_ids(std::move(device_ids))
+{
+    const auto count = m_device_ids.empty() ? 0 : CudaUtil::device_count();
+
+    for (auto device_id : m_device_ids)
+    {
+        if (device_id < 0 || device_id >= count)
+        {
+            throw std::invalid_argument(
+                MORPHEUS_CONCAT_STR("Device " << device_id << " is not one of the " << count << " visible devices"));
+        }
+    }
+}
+
+int DeviceRoundRobin::next()
+{
+    if (m_device_ids.empty())
+    {
+        return CudaUtil::current_device();
+    }
+
+    return m_device_ids[m_next.fetch_add(1, std::memory_order_relaxed) % m_device_ids.size()];
+}
+}  // namespace morpheus
@@ -20,10 +20,13 @@
 #include "morpheus/objects/dtype.hpp"   // for DType
 #include "morpheus/objects/tensor.hpp"  // for Tensor
 #include "morpheus/types.hpp"           // for TensorIndex
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
 #include "morpheus/utilities/tensor_util.hpp"
 
 #include <cuda_runtime.h>
+#include <dlpack/dlpack.h>
 #include <glog/logging.h>         // for COMPACT_GOOGLE_LOG_FATAL, DCHECK, LogMessageFatal
+#include <mrc/cuda/common.hpp>    // for MRC_CHECK_CUDA
 #include <pybind11/functional.h>  // IWYU pragma: keep
 #include <pybind11/gil.h>         // IWYU pragma: keep
 #include <pybind11/pybind11.h>
@@ -36,63 +39,185 @@
 #include <memory>   // for make_shared
 #include <optional>
 #include <ostream>
-#include <string>   // for string
-#include <utility>  // for move
-#include <vector>   // for vector
+#include <stdexcept>  // for invalid_argument
+#include <string>     // for string
+#include <utility>    // for move
+#include <vector>     // for vector
 
-namespace morpheus {
+namespace {
+using namespace morpheus;
 
-namespace py = pybind11;
+// Keeps the exported tensor alive along with the shape and strides the DLPack tensor points to
+struct DLPackExportContext
+{
+    TensorObject tensor;
+    std::vector<int64_t> shape;
+    std::vector<int64_t> strides;
+    DLManagedTensor managed_tensor{};
+};
 
-pybind11::module_ CupyUtil::get_cp()
+DLDataType to_dlpack_dtype(const DType& dtype)
 {
-    DCHECK(PyGILState_Check() != 0);
-    return pybind11::cast<pybind11::module_>(pybind11::module_::import("cupy"));
+    DLDataType dl_dtype{};
+    dl_dtype.bits  = static_cast<uint8_t>(dtype.item_size() * 8);
+    dl_dtype.lanes = 1;
+
+    switch (dtype.type_id())
+    {
+    case TypeId::INT8:
+    case TypeId::INT16:
+    case TypeId::INT32:
+    case TypeId::INT64:
+        dl_dtype.code = kDLInt;
+        break;
+    case TypeId::UINT8:
+    case TypeId::UINT16:
+    case TypeId::UINT32:
+    case TypeId::UINT64:
+        dl_dtype.code = kDLUInt;
+        break;
+    case TypeId::FLOAT16:
+    case TypeId::FLOAT32:
+    case TypeId::FLOAT64:
+        dl_dtype.code = kDLFloat;
+        break;
+    case TypeId::BFLOAT16:
+        dl_dtype.code = kDLBfloat;
+        break;
+    case TypeId::BOOL8:
+        dl_dtype.code = kDLBool;
+        break;
+    default:
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Tensors of type " << dtype.name()
+                                                                           << " can not be exported through DLPack"));
+    }
+
+    return dl_dtype;
 }
 
-bool CupyUtil::is_cupy_array(pybind11::object test_obj)
+DType from_dlpack_dtype(const DLDataType& dl_dtype)
 {
-    return py::isinstance(test_obj, CupyUtil::get_cp().attr("ndarray"));
+    if (dl_dtype.lanes != 1)
+    {
+        throw std::invalid_argument("DLPack tensors with vector types are not supported");
+    }
+
+    if (dl_dtype.code == kDLBfloat && dl_dtype.bits == 16)
+    {
+        return {TypeId::BFLOAT16};
+    }
+
+    if (dl_dtype.code == kDLBool && dl_dtype.bits == 8)
+    {
+        return {TypeId::BOOL8};
+    }
+
+    char type_char = 0;
+    switch (dl_dtype.code)
+    {
+    case kDLInt:
+        type_char = 'i';
+        break;
+    case kDLUInt:
+        type_char = 'u';
+        break;
+    case kDLFloat:
+        type_char = 'f';
+        break;
+    default:
+        throw std::invalid_argument(
+            MORPHEUS_CONCAT_STR("DLPack tensors of type code " << static_cast<int>(dl_dtype.code) << " are not supported"));
+    }
+
+    return DType::from_numpy(MORPHEUS_CONCAT_STR(type_char << (dl_dtype.bits / 8)));
 }
 
-pybind11::object CupyUtil::tensor_to_cupy(const TensorObject& tensor)
+// Only called by the capsule when it is destroyed without having been consumed
+void delete_unconsumed_capsule(PyObject* capsule)
 {
-    // These steps follow the cupy._convert_object_with_cuda_array_interface function shown here:
-    // https://github.com/cupy/cupy/blob/a5b24f91d4d77fa03e6a4dd2ac954ff9a04e21f4/cupy/core/core.pyx#L2478-L2514
-    auto cp      = CupyUtil::get_cp();
-    auto cuda    = cp.attr("cuda");
-    auto ndarray = cp.attr("ndarray");
+    if (PyCapsule_IsValid(capsule, "dltensor") != 0)
+    {
+        auto* managed_tensor = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(capsule, "dltensor"));
+        managed_tensor->deleter(managed_tensor);
+    }
+}
+
+using managed_tensor_ptr_t = std::unique_ptr<DLManagedTensor, void (*)(DLManagedTensor*)>;
+
+// Takes ownership of the tensor of a DLPack capsule, requires the GIL
+managed_tensor_ptr_t consume_dlpack_capsule(const pybind11::capsule& dlpack_capsule)
+{
+    if (PyCapsule_IsValid(dlpack_capsule.ptr(), "dltensor") == 0)
+    {
+        throw std::invalid_argument("Expected an unconsumed DLPack capsule");
+    }
+
+    auto* managed_tensor = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(dlpack_capsule.ptr(), "dltensor"));
+
+    // Marks the capsule as consumed, we are responsible for calling the deleter from now on
+    PyCapsule_SetName(dlpack_capsule.ptr(), "used_dltensor");
 
-    auto py_tensor = pybind11::cast(tensor);
+    return {managed_tensor, [](DLManagedTensor* self) {
+                if (self->deleter != nullptr)
+                {
+                    self->deleter(self);
+                }
+            }};
+}
+
+// Copies a DLPack tensor into a new tensor, does not require the GIL
+TensorObject copy_dlpack_tensor(const DLTensor& dl_tensor)
+{
+    if (dl_tensor.device.device_type != kDLCUDA && dl_tensor.device.device_type != kDLCUDAManaged)
+    {
+        throw std::invalid_argument("Only DLPack tensors in CUDA device memory are supported");
+    }
 
-    auto ptr    = (uintptr_t)tensor.data();
-    auto nbytes = tensor.bytes();
-    auto owner  = py_tensor;
-    int dev_id  = -1;
+    auto dtype = from_dlpack_dtype(dl_tensor.dtype);
 
-    pybind11::list shape_list;
-    pybind11::list stride_list;
+    ShapeType shape(dl_tensor.shape, dl_tensor.shape + dl_tensor.ndim);
 
-    for (auto& idx : tensor.get_shape())
+    // The copy spans from the first to the last element, strides being kept as is
+    ShapeType strides;
+    TensorIndex num_elements = 1;
+    if (dl_tensor.strides != nullptr)
+    {
+        TensorIndex last_element = 0;
+        for (int32_t i = 0; i < dl_tensor.ndim; ++i)
+        {
+            if (dl_tensor.strides[i] < 0)
+            {
+                throw std::invalid_argument("DLPack tensors with negative strides are not supported");
+            }
+
+            strides.push_back(static_cast<TensorIndex>(dl_tensor.strides[i] * dtype.item_size()));
+            last_element += static_cast<TensorIndex>((dl_tensor.shape[i] - 1) * dl_tensor.strides[i]);
+        }
+
+        num_elements = last_element + 1;
+    }
+    else
     {
-        shape_list.append(idx);
+        num_elements = TensorUtils::get_elem_count(shape);
     }
 
-    for (auto& idx : tensor.get_stride())
+    if (TensorUtils::get_elem_count(shape) == 0)
     {
-        stride_list.append(idx * tensor.dtype_size());
+        num_elements = 0;
     }
 
-    pybind11::object mem    = cuda.attr("UnownedMemory")(ptr, nbytes, owner, dev_id);
-    pybind11::object dtype  = cp.attr("dtype")(tensor.get_numpy_typestr());
-    pybind11::object memptr = cuda.attr("MemoryPointer")(mem, 0);
+    const auto* data = static_cast<const uint8_t*>(dl_tensor.data) + dl_tensor.byte_offset;
 
-    // TODO(MDD): Sync on stream
-    return ndarray(
-        pybind11::cast<pybind11::tuple>(shape_list), dtype, memptr, pybind11::cast<pybind11::tuple>(stride_list));
+    return Tensor::create(
+        std::make_shared<rmm::device_buffer>(data, num_elements * dtype.item_size(), rmm::cuda_stream_per_thread),
+        dtype,
+        shape,
+        strides,
+        0);
 }
 
-TensorObject CupyUtil::cupy_to_tensor(pybind11::object cupy_array)
+// The __cuda_array_interface__ path, for arrays not implementing __dlpack__
+TensorObject cuda_array_interface_to_tensor(const pybind11::object& cupy_array)
 {
     // Convert inputs from cupy to Tensor
     pybind11::dict arr_interface = cupy_array.attr("__cuda_array_interface__");
@@ -145,13 +270,133 @@ TensorObject CupyUtil::cupy_to_tensor(pybind11::object cupy_array)
 
     return tensor;
 }
+}  // namespace
+
+namespace morpheus {
+
+namespace py = pybind11;
+
+pybind11::module_ CupyUtil::get_cp()
+{
+    DCHECK(PyGILState_Check() != 0);
+
+    // Intentionally leaked to avoid releasing it after the interpreter has been finalized. At worst, two threads both
+    // import the module when the import releases the GIL.
+    static PyObject* cp_module = nullptr;
+    if (cp_module == nullptr)
+    {
+        cp_module = pybind11::module_::import("cupy").release().ptr();
+    }
+
+    return pybind11::reinterpret_borrow<pybind11::module_>(cp_module);
+}
+
+bool CupyUtil::is_cupy_array(pybind11::object test_obj)
+{
+    return py::isinstance(test_obj, CupyUtil::get_cp().attr("ndarray"));
+}
+
+pybind11::capsule CupyUtil::tensor_to_dlpack(const TensorObject& tensor)
+{
+    auto context    = std::make_unique<DLPackExportContext>();
+    context->tensor = tensor;
+
+    for (auto idx : tensor.get_shape())
+    {
+        context->shape.push_back(idx);
+    }
+
+    // DLPack strides are in elements, as are the strides of tensors
+    for (auto idx : tensor.get_stride())
+    {
+        context->strides.push_back(idx);
+    }
+
+    int device_id = 0;
+    MRC_CHECK_CUDA(cudaGetDevice(&device_id));
+
+    auto& dl_tensor   = context->managed_tensor.dl_tensor;
+    dl_tensor.data    = tensor.data();
+    dl_tensor.device  = {kDLCUDA, device_id};
+    dl_tensor.ndim    = static_cast<int32_t>(context->shape.size());
+    dl_tensor.dtype   = to_dlpack_dtype(tensor.dtype());
+    dl_tensor.shape   = context->shape.data();
+    dl_tensor.strides = context->strides.empty() ? nullptr : context->strides.data();
+
+    context->managed_tensor.manager_ctx = context.get();
+    context->managed_tensor.deleter     = [](DLManagedTensor* self) {
+        delete static_cast<DLPackExportContext*>(self->manager_ctx);
+    };
+
+    PyObject* capsule = PyCapsule_New(&context->managed_tensor, "dltensor", delete_unconsumed_capsule);
+    if (capsule == nullptr)
+    {
+        throw pybind11::error_already_set();
+    }
+
+    // Owned by the capsule from now on
+    context.release();
+
+    return pybind11::reinterpret_steal<pybind11::capsule>(capsule);
+}
+
+TensorObject CupyUtil::dlpack_to_tensor(pybind11::capsule dlpack_capsule)
+{
+    auto managed_tensor = consume_dlpack_capsule(dlpack_capsule);
+    return copy_dlpack_tensor(managed_tensor->dl_tensor);
+}
+
+pybind11::object CupyUtil::tensor_to_cupy(const TensorObject& tensor)
+{
+    // Intentionally leaked, see `get_cp`
+    static PyObject* from_dlpack = nullptr;
+    if (from_dlpack == nullptr)
+    {
+        from_dlpack = CupyUtil::get_cp().attr("from_dlpack").release().ptr();
+    }
+
+    // The python tensor implements `__dlpack__`, handing over the capsule holding a reference to the tensor
+    return pybind11::reinterpret_borrow<pybind11::object>(from_dlpack)(pybind11::cast(tensor));
+}
+
+TensorObject CupyUtil::cupy_to_tensor(pybind11::object cupy_array)
+{
+    if (!pybind11::hasattr(cupy_array, "__dlpack__"))
+    {
+        return cuda_array_interface_to_tensor(cupy_array);
+    }
+
+    // Stream 2 is the per thread default stream, which the producer orders its pending work with before handing over
+    // the capsule
+    return dlpack_to_tensor(cupy_array.attr("__dlpack__")(py::arg("stream") = 2));
+}
 
 TensorMap CupyUtil::cupy_to_tensors(const py_tensor_map_t& cupy_tensors)
 {
     tensor_map_t tensors;
+
+    // Capsules are consumed while holding the GIL, and the tensors they hold copied at once without it. Destroyed
+    // after the GIL has been re-acquired, the producers of the capsules possibly needing it.
+    std::vector<std::pair<std::string, managed_tensor_ptr_t>> managed_tensors;
     for (const auto& tensor : cupy_tensors)
     {
-        tensors[tensor.first].swap(std::move(cupy_to_tensor(tensor.second)));
+        if (pybind11::hasattr(tensor.second, "__dlpack__"))
+        {
+            managed_tensors.emplace_back(
+                tensor.first, consume_dlpack_capsule(tensor.second.attr("__dlpack__")(py::arg("stream") = 2)));
+        }
+        else
+        {
+            tensors[tensor.first].swap(cuda_array_interface_to_tensor(tensor.second));
+        }
+    }
+
+    {
+        pybind11::gil_scoped_release no_gil;
+        for (const auto& [name, managed_tensor] : managed_tensors)
+        {
+            tensors[name].swap(copy_dlpack_tensor(managed_tensor->dl_tensor));
+        }
     }
 
     return tensors;
@@ -0,0 +1,301 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/utilities/http_client.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http/status.hpp>
+#include <glog/logging.h>
+
+#include <algorithm>  // for min
+#include <cctype>     // for isalnum
+#include <iomanip>    // for setw, setfill
+#include <sstream>    // for ostringstream
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <utility>    // for move
+
+namespace beast = boost::beast;
+namespace http  = beast::http;
+namespace net   = boost::asio;
+using tcp       = net::ip::tcp;
+
+namespace morpheus {
+// Sends one request at a time
+struct AsyncHttpClient::Lane
+{
+    explicit Lane(net::io_context& io_context) : resolver(io_context), timer(io_context) {}
+
+    std::size_t request_idx{0};
+    int attempt{0};
+    std::chrono::milliseconds retry_interval{0};
+    bool reused_connection{false};
+    std::unique_ptr<beast::tcp_stream> stream;
+    beast::flat_buffer buffer;
+    http::response<http::string_body> response;
+    tcp::resolver resolver;
+    net::steady_timer timer;
+};
+
+namespace {
+std::string host_key(const HttpClientRequest& request)
+{
+    return request.host + ":" + request.port;
+}
+}  // namespace
+
+AsyncHttpClient::AsyncHttpClient(std::size_t max_concurrent_requests,
+                                 int max_retry,
+                                 std::chrono::milliseconds retry_interval) :
+  m_max_concurrent_requests(max_concurrent_requests),
+  m_max_retry(max_retry),
+  m_retry_interval(retry_interval)
+{
+    if (m_max_concurrent_requests == 0)
+    {
+        throw std::invalid_argument("max_concurrent_requests must be at least one");
+    }
+}
+
+AsyncHttpClient::~AsyncHttpClient() = default;
+
+std::vector<http::response<http::string_body>> AsyncHttpClient::send_all(std::vector<HttpClientRequest> requests)
+{
+    m_requests = std::move(requests);
+    m_responses.assign(m_requests.size(), http::response<http::string_body>{});
+    m_next_request = 0;
+    m_error        = nullptr;
+
+    m_lanes.clear();
+    m_io_context.restart();
+
+    for (std::size_t i = 0; i < std::min(m_max_concurrent_requests, m_requests.size()); ++i)
+    {
+        m_lanes.push_back(std::make_unique<Lane>(m_io_context));
+        this->start_next(*m_lanes.back());
+    }
+
+    m_io_context.run();
+
+    if (m_error)
+    {
+        // Connections left in an unknown state are not reused
+        m_idle_connections.clear();
+        std::rethrow_exception(m_error);
+    }
+
+    return std::move(m_responses);
+}
+
+void AsyncHttpClient::start_next(Lane& lane)
+{
+    if (m_error || m_next_request >= m_requests.size())
+    {
+        return;
+    }
+
+    lane.request_idx    = m_next_request++;
+    lane.attempt        = 0;
+    lane.retry_interval = m_retry_interval;
+    this->send(lane);
+}
+
+void AsyncHttpClient::send(Lane& lane)
+{
+    const auto key = host_key(m_requests[lane.request_idx]);
+
+    auto& idle_connections = m_idle_connections[key];
+    if (!idle_connections.empty())
+    {
+        lane.stream = std::move(idle_connections.back());
+        idle_connections.pop_back();
+        lane.reused_connection = true;
+        this->write(lane);
+        return;
+    }
+
+    lane.reused_connection = false;
+    lane.stream            = std::make_unique<beast::tcp_stream>(m_io_context);
+
+    auto cached = m_dns_cache.find(key);
+    if (cached != m_dns_cache.end())
+    {
+        this->connect(lane, cached->second);
+        return;
+    }
+
+    lane.resolver.async_resolve(m_requests[lane.request_idx].host,
+                                m_requests[lane.request_idx].port,
+                                [this, &lane, key](beast::error_code ec, tcp::resolver::results_type results) {
+                                    if (ec)
+                                    {
+                                        return this->fail(std::make_exception_ptr(beast::system_error{ec}));
+                                    }
+
+                                    m_dns_cache[key] = results;
+                                    this->connect(lane, results);
+                                });
+}
+
+void AsyncHttpClient::connect(Lane& lane, const tcp::resolver::results_type& endpoints)
+{
+    lane.stream->async_connect(endpoints, [this, &lane](beast::error_code ec, const tcp::endpoint& /*endpoint*/) {
+        if (ec)
+        {
+            return this->fail(std::make_exception_ptr(beast::system_error{ec}));
+        }
+
+        this->write(lane);
+    });
+}
+
+void AsyncHttpClient::write(Lane& lane)
+{
+    http::async_write(
+        *lane.stream, m_requests[lane.request_idx].request, [this, &lane](beast::error_code ec, std::size_t /*bytes*/) {
+            if (ec)
+            {
+                return this->on_network_error(lane, ec);
+            }
+
+            lane.buffer.clear();
+            lane.response = {};
+            http::async_read(
+                *lane.stream, lane.buffer, lane.response, [this, &lane](beast::error_code ec, std::size_t) {
+                    if (ec)
+                    {
+                        return this->on_network_error(lane, ec);
+                    }
+
+                    this->on_response(lane);
+                });
+        });
+}
+
+void AsyncHttpClient::on_network_error(Lane& lane, beast::error_code ec)
+{
+    this->close(lane);
+
+    // The server may have closed the connection while it was idle, the request is sent again on a new one
+    if (lane.reused_connection)
+    {
+        return this->send(lane);
+    }
+
+    this->fail(std::make_exception_ptr(beast::system_error{ec}));
+}
+
+void AsyncHttpClient::on_response(Lane& lane)
+{
+    if (lane.response.need_eof())
+    {
+        this->close(lane);
+    }
+    else
+    {
+        m_idle_connections[host_key(m_requests[lane.request_idx])].push_back(std::move(lane.stream));
+    }
+
+    unsigned status = lane.response.result_int();
+    // Retry only if status is 503 Service Unavailable / 504 Gateway Timeout
+    if (status == (unsigned)http::status::service_unavailable || status == (unsigned)http::status::gateway_timeout)
+    {
+        if (++lane.attempt >= m_max_retry)
+        {
+            return this->fail(std::make_exception_ptr(std::runtime_error(
+                "Reached max_retry count for request to " + m_requests[lane.request_idx].host)));
+        }
+
+        lane.timer.expires_after(lane.retry_interval);
+        lane.retry_interval *= 2;
+        lane.timer.async_wait([this, &lane](beast::error_code ec) {
+            if (ec)
+            {
+                return this->fail(std::make_exception_ptr(beast::system_error{ec}));
+            }
+
+            if (!m_error)
+            {
+                this->send(lane);
+            }
+        });
+        return;
+    }
+
+    m_responses[lane.request_idx] = std::move(lane.response);
+    this->start_next(lane);
+}
+
+void AsyncHttpClient::close(Lane& lane)
+{
+    if (lane.stream)
+    {
+        beast::error_code ec;
+        lane.stream->socket().shutdown(tcp::socket::shutdown_both, ec);
+        lane.stream->close();
+        lane.stream.reset();
+    }
+}
+
+void AsyncHttpClient::fail(std::exception_ptr error)
+{
+    // Requests in flight are allowed to complete, no new request is sent
+    if (!m_error)
+    {
+        m_error = std::move(error);
+    }
+}
+
+std::string url_quote(const std::string& value, const std::string& safe, bool plus_spaces)
+{
+    std::ostringstream encoded;
+    encoded << std::hex << std::uppercase << std::setfill('0');
+
+    for (unsigned char c : value)
+    {
+        if (std::isalnum(c) != 0 || c == '_' || c == '.' || c == '-' || c == '~' || safe.find(c) != std::string::npos)
+        {
+            encoded << c;
+        }
+        else if (c == ' ' && plus_spaces)
+        {
+            encoded << '+';
+        }
+        else
+        {
+            encoded << '%' << std::setw(2) << static_cast<int>(c);
+        }
+    }
+
+    return encoded.str();
+}
+
+std::string url_encode(const std::vector<std::pair<std::string, std::string>>& params)
+{
+    std::string query;
+    for (const auto& [key, value] : params)
+    {
+        query += query.empty() ? "?" : "&";
+        query += url_quote(key, "", true) + "=" + url_quote(value, "", true);
+    }
+
+    return query;
+}
+}  // namespace morpheus
@@ -21,6 +21,9 @@
 
 #include "pymrc/utilities/function_wrappers.hpp"  // for PyFuncWrapper
 
+#include "morpheus/utilities/metrics.hpp"       // for MetricsRegistry
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE, TraceBuffer
+
 #include <boost/asio.hpp>  // for dispatch, make_address
 #include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/basic_socket_acceptor.hpp>  // for basic_socket_acceptor<>::executor_type
@@ -34,10 +37,12 @@
 #include <boost/beast/core/error.hpp>         // for error_code
 #include <boost/beast/core/flat_buffer.hpp>   // for flat_buffer
 #include <boost/beast/core/rate_policy.hpp>
-#include <boost/beast/core/tcp_stream.hpp>  // for tcp_stream
-#include <boost/beast/http.hpp>             // for read_async, request, response, verb, write_async
-#include <boost/beast/http/error.hpp>       // for error, error::end_of_stream
-#include <boost/beast/http/field.hpp>       // for field, field::content_type
+#include <boost/beast/core/string.hpp>       // for iequals
+#include <boost/beast/core/tcp_stream.hpp>   // for tcp_stream
+#include <boost/beast/http.hpp>              // for read_async, request, response, verb, write_async
+#include <boost/beast/http/buffer_body.hpp>  // for buffer_body
+#include <boost/beast/http/error.hpp>        // for error, error::end_of_stream, error::body_limit
+#include <boost/beast/http/field.hpp>        // for field, field::content_type, field::content_encoding
 #include <boost/beast/http/fields.hpp>
 #include <boost/beast/http/message.hpp>      // for message, response, request
 #include <boost/beast/http/parser.hpp>       // for request_parser, parser
@@ -49,12 +54,18 @@
 #include <pybind11/gil.h>
 #include <pybind11/pybind11.h>  // IWYU pragma: keep
 #include <pybind11/pytypes.h>
+#include <zlib.h>  // for inflate, z_stream
 
+#include <cstdint>      // for uint64_t
 #include <exception>    // for exception
+#include <functional>   // for function
+#include <limits>       // for numeric_limits
+#include <optional>     // for optional
 #include <ostream>      // needed for glog
 #include <stdexcept>    // for runtime_error, length_error
 #include <type_traits>  // indirectly used by pybind11 casting
 #include <utility>      // for move
+#include <vector>       // for vector
 
 // loosely based on the following examples:
 // https://www.boost.org/doc/libs/1_74_0/libs/beast/example/http/server/async/http_server_async.cpp
@@ -69,6 +80,150 @@ namespace net   = boost::asio;   // from <boost/asio.hpp>
 using tcp = boost::asio::ip::tcp;  // NOLINT(readability-identifier-naming)
 using namespace std::literals::chrono_literals;
 
+// Size of the intermediate buffer used to read bodies which can't be read directly into the payload
+constexpr std::size_t ReadChunkSize{64 * 1024};
+
+/**
+ * @brief Incrementally decodes a `Content-Encoding: gzip` or `deflate` request body as it is read from the socket,
+ * avoiding the need to buffer the compressed body. The decompressed size is bounded by `max_size` to guard against
+ * decompression bombs.
+ */
+class BodyDecoder
+{
+  public:
+    enum class Encoding
+    {
+        Identity,
+        Gzip,
+        Deflate
+    };
+
+    /**
+     * @brief Returns the encoding matching the value of a Content-Encoding header, or `std::nullopt` if unsupported
+     */
+    static std::optional<Encoding> parse_encoding(beast::string_view content_encoding)
+    {
+        if (content_encoding.empty() || beast::iequals(content_encoding, "identity"))
+        {
+            return Encoding::Identity;
+        }
+
+        if (beast::iequals(content_encoding, "gzip") || beast::iequals(content_encoding, "x-gzip"))
+        {
+            return Encoding::Gzip;
+        }
+
+        if (beast::iequals(content_encoding, "deflate"))
+        {
+            return Encoding::Deflate;
+        }
+
+        return std::nullopt;
+    }
+
+    BodyDecoder(Encoding encoding, std::size_t max_size) : m_max_size{max_size}
+    {
+        DCHECK(encoding != Encoding::Identity) << "BodyDecoder is not needed for uncompressed bodies";
+
+        // 15 is the maximum window size, adding 16 expects a gzip rather than a zlib header
+        int window_bits = encoding == Encoding::Gzip ? 15 + 16 : 15;
+        if (inflateInit2(&m_stream, window_bits) != Z_OK)
+        {
+            throw std::runtime_error("Failed to initialize zlib");
+        }
+    }
+
+    ~BodyDecoder()
+    {
+        inflateEnd(&m_stream);
+    }
+
+    BodyDecoder(const BodyDecoder&)            = delete;
+    BodyDecoder& operator=(const BodyDecoder&) = delete;
+
+    /**
+     * @brief Decompresses `size` bytes of `data` appending the result to `out`. If set, `on_output` is called each time
+     * output is produced, allowing `out` to be drained before the limit is reached, returning false stops decompressing.
+     *
+     * @return false if stopped by `on_output`
+     * @throws std::length_error if the decompressed body exceeds `max_size`
+     * @throws std::runtime_error if the body is not valid
+     */
+    bool write(const char* data,
+               std::size_t size,
+               std::string& out,
+               const std::function<bool()>& on_output = nullptr)
+    {
+        m_stream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        m_stream.avail_in = static_cast<uInt>(size);
+
+        while (m_stream.avail_in > 0)
+        {
+            if (m_stream_end)
+            {
+                // Multiple gzip members may be concatenated, each is decompressed in turn
+                if (inflateReset(&m_stream) != Z_OK)
+                {
+                    throw std::runtime_error("Failed to reset zlib stream");
+                }
+                m_stream_end = false;
+            }
+
+            auto offset = out.size();
+            out.resize(offset + ReadChunkSize);
+
+            m_stream.next_out  = reinterpret_cast<Bytef*>(out.data() + offset);
+            m_stream.avail_out = static_cast<uInt>(ReadChunkSize);
+
+            auto result = inflate(&m_stream, Z_NO_FLUSH);
+            out.resize(out.size() - m_stream.avail_out);
+
+            if (result == Z_STREAM_END)
+            {
+                m_stream_end = true;
+            }
+            else if (result != Z_OK && result != Z_BUF_ERROR)
+            {
+                throw std::runtime_error(std::string("Invalid compressed body: ") +
+                                         (m_stream.msg != nullptr ? m_stream.msg : "unknown error"));
+            }
+            else if (result == Z_BUF_ERROR && m_stream.avail_out != 0)
+            {
+                // No progress was possible, more input is needed
+                break;
+            }
+
+            if (on_output && !on_output())
+            {
+                return false;
+            }
+
+            if (out.size() > m_max_size)
+            {
+                throw std::length_error("Decompressed body exceeds the maximum payload size");
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Verifies that the complete compressed stream was received
+     */
+    void finish() const
+    {
+        if (!m_stream_end)
+        {
+            throw std::runtime_error("Invalid compressed body: truncated stream");
+        }
+    }
+
+  private:
+    std::size_t m_max_size;
+    z_stream m_stream{};
+    bool m_stream_end{false};
+};
+
 class Session : public std::enable_shared_from_this<Session>
 {
   public:
@@ -77,14 +232,16 @@ class Session : public std::enable_shared_from_this<Session>
             const std::string& url_endpoint,
             http::verb method,
             std::size_t max_payload_size,
-            std::chrono::seconds timeout) :
+            std::chrono::seconds timeout,
+            std::size_t stream_chunk_size) :
       m_stream{std::move(socket)},
       m_payload_parse_fn{std::move(payload_parse_fn)},
       m_url_endpoint{url_endpoint},
       m_method{method},
       m_max_payload_size{max_payload_size},
       m_timeout{timeout},
-      m_on_complete_cb{nullptr}
+      m_stream_chunk_size{stream_chunk_size},
+      m_read_buffer(ReadChunkSize)
     {}
 
     ~Session() = default;
@@ -97,46 +254,261 @@ class Session : public std::enable_shared_from_this<Session>
   private:
     void do_read()
     {
-        m_parser = std::make_unique<http::request_parser<http::string_body>>();
-        m_parser->body_limit(m_max_payload_size);
+        // Any bytes of a pipelined request which were read along with the previous request remain in `m_buffer`, since
+        // responses must be sent in order the next request isn't read until the previous response has been written.
+        m_parser = std::make_unique<http::request_parser<http::buffer_body>>();
+
+        if (m_stream_chunk_size > 0)
+        {
+            // When streaming, only the portion of the body which is buffered at any one time is limited. Avoiding
+            // `boost::none` since older versions of Beast compare the body length against an empty limit.
+            m_parser->body_limit(std::numeric_limits<std::uint64_t>::max());
+        }
+        else
+        {
+            m_parser->body_limit(m_max_payload_size);
+        }
+
+        m_decoder.reset();
+        m_body.clear();
+        m_body_offset = 0;
+        m_num_chunks  = 0;
         m_stream.expires_after(m_timeout);
 
-        http::async_read(
-            m_stream, m_buffer, *m_parser, beast::bind_front_handler(&Session::on_read, shared_from_this()));
+        http::async_read_header(
+            m_stream, m_buffer, *m_parser, beast::bind_front_handler(&Session::on_read_header, shared_from_this()));
     }
 
-    void on_read(beast::error_code ec, std::size_t bytes_transferred)
+    void on_read_header(beast::error_code ec, std::size_t bytes_transferred)
     {
         if (ec == http::error::end_of_stream)
         {
             return do_close();
         }
 
+        // Raised when the Content-Length header exceeds the limit
+        if (ec == http::error::body_limit)
+        {
+            return send_error(http::status::payload_too_large, "Payload exceeds the maximum payload size");
+        }
+
+        if (ec)
+        {
+            LOG(ERROR) << "Error reading request: " << ec.message();
+            return;
+        }
+
+        const auto& request       = m_parser->get();
+        const auto encoding_field = request[http::field::content_encoding];
+        auto encoding             = BodyDecoder::parse_encoding(encoding_field);
+
+        if (!encoding.has_value())
+        {
+            // The body hasn't been read, so the connection can't be re-used
+            return send_error(http::status::unsupported_media_type,
+                              "Unsupported Content-Encoding: " + std::string(encoding_field));
+        }
+
+        // Chunks are handed to the parse function as they arrive, so unknown requests need to be rejected up front
+        if (m_stream_chunk_size > 0 && !(request.target() == m_url_endpoint && request.method() == m_method))
+        {
+            return send_error(http::status::not_found, "not found");
+        }
+
+        if (*encoding != BodyDecoder::Encoding::Identity)
+        {
+            m_decoder = std::make_unique<BodyDecoder>(*encoding, m_max_payload_size);
+        }
+        else if (auto content_length = m_parser->content_length();
+                 content_length.has_value() && m_stream_chunk_size == 0)
+        {
+            // The size of the body is known up front, read directly into the payload avoiding an extra copy
+            m_body.resize(*content_length);
+        }
+
+        if (m_parser->is_done())
+        {
+            return handle_request();
+        }
+
+        do_read_body();
+    }
+
+    bool reading_into_body() const
+    {
+        return !m_decoder && m_stream_chunk_size == 0 && m_parser->content_length().has_value();
+    }
+
+    void do_read_body()
+    {
+        auto& body = m_parser->get().body();
+
+        if (reading_into_body())
+        {
+            body.data = m_body.data() + m_body_offset;
+            body.size = m_body.size() - m_body_offset;
+        }
+        else
+        {
+            body.data = m_read_buffer.data();
+            body.size = m_read_buffer.size();
+        }
+
+        http::async_read(
+            m_stream, m_buffer, *m_parser, beast::bind_front_handler(&Session::on_read_body, shared_from_this()));
+    }
+
+    void on_read_body(beast::error_code ec, std::size_t bytes_transferred)
+    {
+        // Indicates that the body buffer is full, which is expected
+        if (ec == http::error::need_buffer)
+        {
+            ec = {};
+        }
+
+        if (ec == http::error::body_limit)
+        {
+            return send_error(http::status::payload_too_large, "Payload exceeds the maximum payload size");
+        }
+
         if (ec)
         {
             LOG(ERROR) << "Error reading request: " << ec.message();
             return;
         }
 
-        // Release ownership of the parsed message and move it into the
-        // handle_request method
-        handle_request(m_parser->release());
+        auto& body = m_parser->get().body();
+
+        try
+        {
+            if (reading_into_body())
+            {
+                m_body_offset = m_body.size() - body.size;
+            }
+            else
+            {
+                auto num_bytes = m_read_buffer.size() - body.size;
+                if (m_decoder && m_stream_chunk_size > 0)
+                {
+                    // Highly compressed input can expand beyond the limit within a single read
+                    if (!m_decoder->write(m_read_buffer.data(), num_bytes, m_body, [this]() {
+                            return flush_chunks(false);
+                        }))
+                    {
+                        return;
+                    }
+                }
+                else if (m_decoder)
+                {
+                    m_decoder->write(m_read_buffer.data(), num_bytes, m_body);
+                }
+                else
+                {
+                    if (m_body.size() + num_bytes > m_max_payload_size)
+                    {
+                        throw std::length_error("Payload exceeds the maximum payload size");
+                    }
+
+                    m_body.append(m_read_buffer.data(), num_bytes);
+                }
+            }
+
+            bool is_done = m_parser->is_done();
+
+            if (is_done && m_decoder)
+            {
+                m_decoder->finish();
+            }
+
+            if (m_stream_chunk_size > 0 && !flush_chunks(is_done))
+            {
+                // A chunk was rejected and the response has already been sent
+                return;
+            }
+
+            if (is_done)
+            {
+                return handle_request();
+            }
+        } catch (const std::length_error& e)
+        {
+            return send_error(http::status::payload_too_large, e.what());
+        } catch (const std::exception& e)
+        {
+            return send_error(http::status::bad_request, e.what());
+        }
+
+        do_read_body();
     }
 
-    void handle_request(http::request<http::string_body>&& request)
+    /**
+     * @brief Hands complete lines of the buffered body to the parse function in chunks of up to `m_stream_chunk_size`
+     * bytes, a single line longer than the chunk size is sent on its own. When `is_final` is true, everything which
+     * remains is sent. Returns false if the parse function rejected a chunk, in which case the response has been sent.
+     */
+    bool flush_chunks(bool is_final)
     {
+        while (!m_body.empty() && (is_final || m_body.size() >= m_stream_chunk_size))
+        {
+            std::size_t chunk_size = m_body.size();
+
+            if (!is_final || chunk_size > m_stream_chunk_size)
+            {
+                auto line_end = m_body.rfind('\n', m_stream_chunk_size - 1);
+                if (line_end == std::string::npos)
+                {
+                    line_end = m_body.find('\n', m_stream_chunk_size);
+                }
+
+                if (line_end != std::string::npos)
+                {
+                    chunk_size = line_end + 1;
+                }
+                else if (!is_final)
+                {
+                    // Wait for the rest of the line
+                    break;
+                }
+            }
+
+            auto parse_status = (*m_payload_parse_fn)(m_body.substr(0, chunk_size));
+            m_body.erase(0, chunk_size);
+            ++m_num_chunks;
+
+            auto status = std::get<0>(parse_status);
+            m_response  = std::make_unique<http::response<http::string_body>>();
+            this->set_response(std::move(parse_status));
+
+            if (status < 200 || status > 299)
+            {
+                LOG(ERROR) << "Chunk " << m_num_chunks << " of streamed request rejected with status " << status;
+
+                // The remainder of the body hasn't been read, so the connection can't be re-used
+                do_write(false);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void handle_request()
+    {
+        const auto& request = m_parser->get();
         DLOG(INFO) << "Received request: " << request.method() << " : " << request.target();
+        MORPHEUS_TRACE("http.request", static_cast<int64_t>(request.method()), m_body.size());
+
+        if (m_stream_chunk_size > 0 && m_num_chunks > 0)
+        {
+            // The response of the last chunk has already been set
+            return do_write(request.keep_alive());
+        }
+
         m_response = std::make_unique<http::response<http::string_body>>();
 
         if (request.target() == m_url_endpoint && (request.method() == m_method))
         {
-            std::string body{request.body()};
-            auto parse_status = (*m_payload_parse_fn)(body);
-
-            m_response->result(std::get<0>(parse_status));
-            m_response->set(http::field::content_type, std::get<1>(parse_status));
-            m_response->body() = std::get<2>(parse_status);
-            m_on_complete_cb   = std::get<3>(parse_status);
+            this->set_response((*m_payload_parse_fn)(m_body));
         }
         else
         {
@@ -145,10 +517,44 @@ class Session : public std::enable_shared_from_this<Session>
             m_response->body() = "not found";
         }
 
+        do_write(request.keep_alive());
+    }
+
+    void set_response(morpheus::parse_status_t&& parse_status)
+    {
+        m_response->result(std::get<0>(parse_status));
+        m_response->set(http::field::content_type, std::get<1>(parse_status));
+        m_response->body() = std::move(std::get<2>(parse_status));
+
+        if (std::get<3>(parse_status))
+        {
+            m_on_complete_cbs.emplace_back(std::move(std::get<3>(parse_status)));
+        }
+    }
+
+    /**
+     * @brief Responds to a request which was rejected before the body was fully read, closing the connection
+     */
+    void send_error(http::status status, std::string error_msg)
+    {
+        MORPHEUS_TRACE("http.reject", static_cast<int64_t>(status));
+        LOG(ERROR) << "Rejecting request: " << error_msg;
+        TraceBuffer::on_error();
+        m_response = std::make_unique<http::response<http::string_body>>();
+        m_response->result(status);
+        m_response->set(http::field::content_type, "text/plain");
+        m_response->body() = std::move(error_msg);
+
+        do_write(false);
+    }
+
+    void do_write(bool keep_alive)
+    {
         try
         {
             DLOG(INFO) << "Response: " << m_response->result_int();
-            m_response->keep_alive(request.keep_alive());
+            MORPHEUS_TRACE("http.response", m_response->result_int(), m_response->body().size());
+            m_response->keep_alive(keep_alive);
             m_response->prepare_payload();
 
             http::async_write(
@@ -168,11 +574,12 @@ class Session : public std::enable_shared_from_this<Session>
             LOG(ERROR) << "Error writing response: " << ec.message();
         }
 
-        if (m_on_complete_cb)
+        // When streaming, each chunk may have registered a callback
+        for (auto& on_complete_cb : m_on_complete_cbs)
         {
             try
             {
-                m_on_complete_cb(ec);
+                on_complete_cb(ec);
             } catch (const std::exception& e)
             {
                 LOG(ERROR) << "Caught exception while calling on_complete callback: " << e.what();
@@ -180,10 +587,10 @@ class Session : public std::enable_shared_from_this<Session>
             {
                 LOG(ERROR) << "Caught unknown exception while calling on_complete callback";
             }
-
-            m_on_complete_cb = nullptr;
         }
 
+        m_on_complete_cbs.clear();
+
         m_parser.reset(nullptr);
         m_response.reset(nullptr);
 
@@ -208,11 +615,17 @@ class Session : public std::enable_shared_from_this<Session>
     http::verb m_method;
     std::size_t m_max_payload_size;
     std::chrono::seconds m_timeout;
-
-    // The response, and parser are all reset for each incoming request
-    std::unique_ptr<http::request_parser<http::string_body>> m_parser;
+    std::size_t m_stream_chunk_size;
+    std::vector<char> m_read_buffer;
+
+    // The response, parser, decoder and body are all reset for each incoming request
+    std::unique_ptr<http::request_parser<http::buffer_body>> m_parser;
+    std::unique_ptr<BodyDecoder> m_decoder;
+    std::string m_body;
+    std::size_t m_body_offset{0};
+    std::size_t m_num_chunks{0};
     std::unique_ptr<http::response<http::string_body>> m_response;
-    morpheus::on_complete_cb_fn_t m_on_complete_cb;
+    std::vector<morpheus::on_complete_cb_fn_t> m_on_complete_cbs;
 };
 
 }  // namespace
@@ -226,7 +639,8 @@ HttpServer::HttpServer(payload_parse_fn_t payload_parse_fn,
                        std::string method,
                        unsigned short num_threads,
                        std::size_t max_payload_size,
-                       std::chrono::seconds request_timeout) :
+                       std::chrono::seconds request_timeout,
+                       std::size_t stream_chunk_size) :
   m_payload_parse_fn(std::make_shared<payload_parse_fn_t>(std::move(payload_parse_fn))),
   m_bind_address(std::move(bind_address)),
   m_port(port),
@@ -235,6 +649,7 @@ HttpServer::HttpServer(payload_parse_fn_t payload_parse_fn,
   m_num_threads(num_threads),
   m_request_timeout(request_timeout),
   m_max_payload_size(max_payload_size),
+  m_stream_chunk_size(stream_chunk_size),
   m_io_context{m_num_threads},
   m_listener{nullptr},
   m_is_running{false}
@@ -253,6 +668,11 @@ HttpServer::HttpServer(payload_parse_fn_t payload_parse_fn,
     {
         m_endpoint.insert(0, 1, '/');
     }
+
+    if (m_stream_chunk_size > m_max_payload_size)
+    {
+        throw std::runtime_error("stream_chunk_size must not exceed max_payload_size");
+    }
 }
 
 void HttpServer::start_listener(std::binary_semaphore& listener_semaphore, std::binary_semaphore& started_semaphore)
@@ -272,7 +692,8 @@ void HttpServer::start_listener(std::binary_semaphore& listener_semaphore, std::
                                             m_endpoint,
                                             m_method,
                                             m_max_payload_size,
-                                            m_request_timeout);
+                                            m_request_timeout,
+                                            m_stream_chunk_size);
     m_listener->run();
 
     for (auto i = 1; i < m_num_threads; ++i)
@@ -355,6 +776,39 @@ HttpServer::~HttpServer()
     }
 }
 
+MetricsServer::MetricsServer(std::string bind_address,
+                             unsigned short port,
+                             std::string endpoint,
+                             unsigned short num_threads) :
+  m_server(
+      [](const std::string& /* body */) -> parse_status_t {
+          return std::make_tuple(200u,
+                                 "text/plain; version=0.0.4; charset=utf-8",
+                                 MetricsRegistry::get_instance().serialize(),
+                                 nullptr);
+      },
+      std::move(bind_address),
+      port,
+      std::move(endpoint),
+      "GET",
+      num_threads)
+{}
+
+void MetricsServer::start()
+{
+    m_server.start();
+}
+
+void MetricsServer::stop()
+{
+    m_server.stop();
+}
+
+bool MetricsServer::is_running() const
+{
+    return m_server.is_running();
+}
+
 /****** HttpServerInterfaceProxy *************************/
 using mrc::pymrc::PyFuncWrapper;
 namespace py = pybind11;
@@ -366,7 +820,8 @@ std::shared_ptr<HttpServer> HttpServerInterfaceProxy::init(py::function py_parse
                                                            std::string method,
                                                            unsigned short num_threads,
                                                            std::size_t max_payload_size,
-                                                           int64_t request_timeout)
+                                                           int64_t request_timeout,
+                                                           std::size_t stream_chunk_size)
 {
     auto wrapped_parse_fn               = PyFuncWrapper(std::move(py_parse_fn));
     payload_parse_fn_t payload_parse_fn = [wrapped_parse_fn = std::move(wrapped_parse_fn)](const std::string& payload) {
@@ -406,7 +861,8 @@ std::shared_ptr<HttpServer> HttpServerInterfaceProxy::init(py::function py_parse
                                         std::move(method),
                                         num_threads,
                                         max_payload_size,
-                                        std::chrono::seconds(request_timeout));
+                                        std::chrono::seconds(request_timeout),
+                                        stream_chunk_size);
 }
 
 void HttpServerInterfaceProxy::start(HttpServer& self)
@@ -442,6 +898,41 @@ void HttpServerInterfaceProxy::exit(HttpServer& self,
     self.stop();
 }
 
+/****** MetricsServerInterfaceProxy *************************/
+void MetricsServerInterfaceProxy::start(MetricsServer& self)
+{
+    pybind11::gil_scoped_release release;
+    self.start();
+}
+
+void MetricsServerInterfaceProxy::stop(MetricsServer& self)
+{
+    pybind11::gil_scoped_release release;
+    self.stop();
+}
+
+bool MetricsServerInterfaceProxy::is_running(const MetricsServer& self)
+{
+    pybind11::gil_scoped_release release;
+    return self.is_running();
+}
+
+MetricsServer& MetricsServerInterfaceProxy::enter(MetricsServer& self)
+{
+    pybind11::gil_scoped_release release;
+    self.start();
+    return self;
+}
+
+void MetricsServerInterfaceProxy::exit(MetricsServer& self,
+                                       const pybind11::object& type,
+                                       const pybind11::object& value,
+                                       const pybind11::object& traceback)
+{
+    pybind11::gil_scoped_release release;
+    self.stop();
+}
+
 Listener::Listener(net::io_context& io_context,
                    std::shared_ptr<morpheus::payload_parse_fn_t> payload_parse_fn,
                    const std::string& bind_address,
@@ -449,7 +940,8 @@ Listener::Listener(net::io_context& io_context,
                    const std::string& endpoint,
                    http::verb method,
                    std::size_t max_payload_size,
-                   std::chrono::seconds request_timeout) :
+                   std::chrono::seconds request_timeout,
+                   std::size_t stream_chunk_size) :
   m_io_context{io_context},
   m_tcp_endpoint{net::ip::make_address(bind_address), port},
   m_acceptor{std::make_unique<tcp::acceptor>(net::make_strand(m_io_context))},
@@ -458,6 +950,7 @@ Listener::Listener(net::io_context& io_context,
   m_method{method},
   m_max_payload_size{max_payload_size},
   m_request_timeout{request_timeout},
+  m_stream_chunk_size{stream_chunk_size},
   m_is_running{false}
 {
     m_acceptor->open(m_tcp_endpoint.protocol());
@@ -500,8 +993,17 @@ void Listener::on_accept(beast::error_code ec, tcp::socket socket)
     }
     else
     {
-        std::make_shared<Session>(
-            std::move(socket), m_payload_parse_fn, m_url_endpoint, m_method, m_max_payload_size, m_request_timeout)
+        // Responses to pipelined requests on persistent connections are small, don't hold them back waiting to coalesce
+        beast::error_code option_ec;
+        socket.set_option(tcp::no_delay(true), option_ec);
+
+        std::make_shared<Session>(std::move(socket),
+                                  m_payload_parse_fn,
+                                  m_url_endpoint,
+                                  m_method,
+                                  m_max_payload_size,
+                                  m_request_timeout,
+                                  m_stream_chunk_size)
             ->run();
     }
 
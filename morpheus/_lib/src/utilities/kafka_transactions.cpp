@@ -0,0 +1,254 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/utilities/kafka_transactions.hpp"
+
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <glog/logging.h>
+
+#include <map>
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <utility>    // for move
+
+namespace morpheus {
+namespace {
+
+struct TransactionRegistry
+{
+    std::mutex mutex;
+    std::map<std::string, std::weak_ptr<KafkaTransactionCoordinator>> coordinators;
+};
+
+TransactionRegistry& registry()
+{
+    static TransactionRegistry registry;
+    return registry;
+}
+
+// Takes ownership of an error returned by the transactional API
+std::unique_ptr<RdKafka::Error> check_error(RdKafka::Error* error)
+{
+    return std::unique_ptr<RdKafka::Error>(error);
+}
+
+}  // namespace
+
+// Component public implementations
+// ************ KafkaTransactionCoordinator ************************* //
+std::shared_ptr<KafkaTransactionCoordinator> KafkaTransactionCoordinator::claim(const std::string& group_id)
+{
+    std::lock_guard lock(registry().mutex);
+
+    auto& entry = registry().coordinators[group_id];
+
+    if (!entry.expired())
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR(
+            "The offsets of consumer group '" << group_id << "' are already committed by another Kafka sink"));
+    }
+
+    auto coordinator = std::make_shared<KafkaTransactionCoordinator>(group_id);
+    entry            = coordinator;
+
+    return coordinator;
+}
+
+std::shared_ptr<KafkaTransactionCoordinator> KafkaTransactionCoordinator::find(const std::string& group_id)
+{
+    std::lock_guard lock(registry().mutex);
+
+    auto found = registry().coordinators.find(group_id);
+
+    return found == registry().coordinators.end() ? nullptr : found->second.lock();
+}
+
+KafkaTransactionCoordinator::KafkaTransactionCoordinator(std::string group_id) : m_group_id(std::move(group_id)) {}
+
+void KafkaTransactionCoordinator::attach_consumer(RdKafka::KafkaConsumer* consumer, take_offsets_fn_t take_offsets)
+{
+    std::unique_lock lock(m_mutex);
+
+    m_consumer     = consumer;
+    m_take_offsets = std::move(take_offsets);
+}
+
+void KafkaTransactionCoordinator::detach_consumer()
+{
+    std::unique_lock lock(m_mutex);
+
+    m_consumer     = nullptr;
+    m_take_offsets = nullptr;
+}
+
+void KafkaTransactionCoordinator::attach_producer(RdKafka::Producer* producer, std::chrono::milliseconds timeout)
+{
+    std::unique_lock lock(m_mutex);
+
+    m_timeout_ms = static_cast<int>(timeout.count());
+
+    if (auto error = check_error(producer->init_transactions(m_timeout_ms)))
+    {
+        throw std::runtime_error(
+            MORPHEUS_CONCAT_STR("Error occurred initializing the Kafka transactions. Error: " << error->str()));
+    }
+
+    m_producer       = producer;
+    m_in_transaction = false;
+}
+
+void KafkaTransactionCoordinator::detach_producer()
+{
+    std::unique_lock lock(m_mutex);
+
+    // Anything left uncommitted is aborted by the broker once the producer is closed
+    m_producer       = nullptr;
+    m_in_transaction = false;
+}
+
+std::unique_lock<boost::fibers::mutex> KafkaTransactionCoordinator::begin()
+{
+    std::unique_lock lock(m_mutex);
+
+    check_failed();
+
+    if (!m_in_transaction && m_producer != nullptr)
+    {
+        if (auto error = check_error(m_producer->begin_transaction()))
+        {
+            m_failure = error->str();
+            check_failed();
+        }
+
+        m_in_transaction = true;
+    }
+
+    return lock;
+}
+
+void KafkaTransactionCoordinator::commit()
+{
+    std::unique_lock lock(m_mutex);
+
+    commit_locked();
+}
+
+bool KafkaTransactionCoordinator::try_commit()
+{
+    std::unique_lock lock(m_mutex, std::try_to_lock);
+
+    if (!lock.owns_lock())
+    {
+        return false;
+    }
+
+    commit_locked();
+
+    return true;
+}
+
+void KafkaTransactionCoordinator::commit_locked()
+{
+    check_failed();
+
+    // Offsets are left with the source until there is a producer to commit them with
+    if (m_producer == nullptr)
+    {
+        return;
+    }
+
+    offsets_t offsets;
+
+    if (m_take_offsets)
+    {
+        offsets = m_take_offsets();
+    }
+
+    if (offsets.empty() && !m_in_transaction)
+    {
+        return;
+    }
+
+    auto fail = [this](std::unique_ptr<RdKafka::Error> error) {
+        LOG(ERROR) << "Error occurred committing the Kafka transaction for consumer group '" << m_group_id
+                   << "'. Error: " << error->str();
+
+        if (!error->is_fatal())
+        {
+            if (auto abort_error = check_error(m_producer->abort_transaction(m_timeout_ms)))
+            {
+                LOG(ERROR) << "Error occurred aborting the Kafka transaction. Error: " << abort_error->str();
+            }
+        }
+
+        m_in_transaction = false;
+        m_failure        = error->str();
+        check_failed();
+    };
+
+    if (!m_in_transaction)
+    {
+        if (auto error = check_error(m_producer->begin_transaction()))
+        {
+            fail(std::move(error));
+        }
+
+        m_in_transaction = true;
+    }
+
+    if (!offsets.empty())
+    {
+        std::vector<RdKafka::TopicPartition*> offset_ptrs;
+        offset_ptrs.reserve(offsets.size());
+
+        for (const auto& offset : offsets)
+        {
+            offset_ptrs.push_back(offset.get());
+        }
+
+        // The group metadata carries the generation of the consumer, fencing out a transaction committed on behalf of
+        // a consumer whose partitions have since been reassigned
+        std::unique_ptr<RdKafka::ConsumerGroupMetadata> group_metadata(m_consumer->groupMetadata());
+
+        if (auto error =
+                check_error(m_producer->send_offsets_to_transaction(offset_ptrs, group_metadata.get(), m_timeout_ms)))
+        {
+            fail(std::move(error));
+        }
+    }
+
+    // Flushes the rows of the transaction first, fails if any of them could not be delivered
+    if (auto error = check_error(m_producer->commit_transaction(m_timeout_ms)))
+    {
+        fail(std::move(error));
+    }
+
+    m_in_transaction = false;
+}
+
+void KafkaTransactionCoordinator::check_failed() const
+{
+    if (m_failure.has_value())
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("A Kafka transaction for consumer group '"
+                                                     << m_group_id << "' failed, the pipeline must be restarted from "
+                                                     << "the last committed offsets. Error: " << *m_failure));
+    }
+}
+
+}  // namespace morpheus
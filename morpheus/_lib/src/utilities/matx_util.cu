@@ -17,21 +17,246 @@
 
 #include "morpheus/types.hpp"  // For TensorIndex, TensorSize
 #include "morpheus/utilities/matx_util.hpp"
+#include "morpheus/utilities/nvtx_util.hpp"  // for MORPHEUS_NVTX_DOMAIN, MORPHEUS_NVTX_RANGE
 
-#include <boost/numeric/conversion/cast.hpp>  // for numeric_cast
+#include <boost/numeric/conversion/cast.hpp>         // for numeric_cast
+#include <cub/device/device_select.cuh>              // for DeviceSelect
+#include <cub/iterator/counting_input_iterator.cuh>  // for CountingInputIterator
+#include <cudf/utilities/bit.hpp>                    // for bit_is_set
 #include <cudf/utilities/traits.hpp>
-#include <cudf/utilities/type_dispatcher.hpp>
+#include <glog/logging.h>  // for DCHECK_EQ
 #include <matx.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
 #include <mrc/cuda/sync.hpp>
+#include <rmm/device_uvector.hpp>
 
+#include <algorithm>  // for min
 #include <array>
 #include <cstddef>  // for size_t
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>    // for invalid_argument
+#include <type_traits>  // for is_same_v
+#include <utility>      // for forward
+#include <vector>
 
 namespace {
 using namespace morpheus;
+
+MORPHEUS_NVTX_DOMAIN(NvtxDomain, "MatxUtil");
+
 using tensorShape_1d = std::array<matx::index_t, 1>;
 using tensorShape_2d = std::array<matx::index_t, 2>;
 
+// cudf has no half precision types, these are dispatched to the MatX half types which wrap `__half` and
+// `__nv_bfloat16`, everything else is dispatched by cudf
+template <typename T>
+constexpr bool is_half_v = std::is_same_v<T, matx::matxFp16> || std::is_same_v<T, matx::matxBf16>;
+
+template <typename T>
+constexpr bool is_floating_point_v = cudf::is_floating_point<T>() || is_half_v<T>;
+
+template <typename T>
+constexpr bool is_numeric_v = cudf::is_numeric<T>() || is_half_v<T>;
+
+// The half precision types are only converted to and from the other floating point types
+template <typename InputT, typename OutputT>
+constexpr bool is_convertible_v = is_numeric_v<InputT> && is_numeric_v<OutputT> &&
+                                  ((!is_half_v<InputT> && !is_half_v<OutputT>) ||
+                                   (is_floating_point_v<InputT> && is_floating_point_v<OutputT>));
+
+// Element types a functor is instantiated for. Functors list the types they support with a `types_t` member, or
+// `input_types_t` and `output_types_t` when dispatched on two types, only those being compiled. Dispatching any other
+// type throws without instantiating the functor, keeping unsupported kernels out of the library and its fatbinary.
+template <typename... TypesT>
+struct TypeList
+{};
+
+using IntegralTypes = TypeList<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, bool>;
+
+using FloatingPointTypes = TypeList<matx::matxFp16, matx::matxBf16, float, double>;
+
+using NumericTypes = TypeList<int8_t,
+                              int16_t,
+                              int32_t,
+                              int64_t,
+                              uint8_t,
+                              uint16_t,
+                              uint32_t,
+                              uint64_t,
+                              bool,
+                              matx::matxFp16,
+                              matx::matxBf16,
+                              float,
+                              double>;
+
+// Each pair of cast types instantiates a kernel, builds with `MORPHEUS_REDUCED_MATX_DISPATCH` only support casting
+// between the types of the tensors of the stages: token ids, seq_ids, masks, features and model outputs
+#ifdef MORPHEUS_REDUCED_MATX_DISPATCH
+using CastTypes = TypeList<int32_t, int64_t, uint32_t, bool, matx::matxFp16, float, double>;
+#else
+using CastTypes = NumericTypes;
+#endif
+
+template <typename T>
+constexpr TypeId type_id_of()
+{
+    if constexpr (std::is_same_v<T, int8_t>)
+    {
+        return TypeId::INT8;
+    }
+    else if constexpr (std::is_same_v<T, int16_t>)
+    {
+        return TypeId::INT16;
+    }
+    else if constexpr (std::is_same_v<T, int32_t>)
+    {
+        return TypeId::INT32;
+    }
+    else if constexpr (std::is_same_v<T, int64_t>)
+    {
+        return TypeId::INT64;
+    }
+    else if constexpr (std::is_same_v<T, uint8_t>)
+    {
+        return TypeId::UINT8;
+    }
+    else if constexpr (std::is_same_v<T, uint16_t>)
+    {
+        return TypeId::UINT16;
+    }
+    else if constexpr (std::is_same_v<T, uint32_t>)
+    {
+        return TypeId::UINT32;
+    }
+    else if constexpr (std::is_same_v<T, uint64_t>)
+    {
+        return TypeId::UINT64;
+    }
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+        return TypeId::BOOL8;
+    }
+    else if constexpr (std::is_same_v<T, matx::matxFp16>)
+    {
+        return TypeId::FLOAT16;
+    }
+    else if constexpr (std::is_same_v<T, matx::matxBf16>)
+    {
+        return TypeId::BFLOAT16;
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+        return TypeId::FLOAT32;
+    }
+    else
+    {
+        static_assert(std::is_same_v<T, double>, "Unsupported element type");
+        return TypeId::FLOAT64;
+    }
+}
+
+template <typename FunctorT, typename = void>
+struct MatxUtil__FunctorTypes
+{
+    using type = NumericTypes;
+};
+
+template <typename FunctorT>
+struct MatxUtil__FunctorTypes<FunctorT, std::void_t<typename FunctorT::types_t>>
+{
+    using type = typename FunctorT::types_t;
+};
+
+template <typename TypesT>
+struct MatxUtil__Dispatcher;
+
+template <typename... TypesT>
+struct MatxUtil__Dispatcher<TypeList<TypesT...>>
+{
+    template <typename FunctorT, typename... ArgsT>
+    static void dispatch(const DType& dtype, FunctorT& functor, ArgsT&&... args)
+    {
+        // Only the matching type calls the functor, forwarding the arguments once
+        const bool dispatched = ((dtype.type_id() == type_id_of<TypesT>()
+                                      ? (functor.template operator()<TypesT>(std::forward<ArgsT>(args)...), true)
+                                      : false) ||
+                                 ...);
+
+        if (!dispatched)
+        {
+            throw std::invalid_argument("Unsupported type: " + dtype.name());
+        }
+    }
+};
+
+/**
+ * @brief Calls `functor.operator()<T>(args...)` with `T` the element type of `dtype`, which must be one of the
+ * `types_t` of the functor, all of the numeric types by default
+ */
+template <typename FunctorT, typename... ArgsT>
+void dispatch_type(const DType& dtype, FunctorT&& functor, ArgsT&&... args)
+{
+    using types_t = typename MatxUtil__FunctorTypes<std::decay_t<FunctorT>>::type;
+    MatxUtil__Dispatcher<types_t>::dispatch(dtype, functor, std::forward<ArgsT>(args)...);
+}
+
+template <typename FunctorT, typename = void>
+struct MatxUtil__FunctorInputOutputTypes
+{
+    using input_types_t  = NumericTypes;
+    using output_types_t = NumericTypes;
+};
+
+template <typename FunctorT>
+struct MatxUtil__FunctorInputOutputTypes<
+    FunctorT,
+    std::void_t<typename FunctorT::input_types_t, typename FunctorT::output_types_t>>
+{
+    using input_types_t  = typename FunctorT::input_types_t;
+    using output_types_t = typename FunctorT::output_types_t;
+};
+
+template <typename InputT, typename FunctorT>
+struct MatxUtil__BoundInputType
+{
+    using types_t = typename MatxUtil__FunctorInputOutputTypes<FunctorT>::output_types_t;
+
+    FunctorT& functor;
+
+    template <typename OutputT, typename... ArgsT>
+    void operator()(ArgsT&&... args)
+    {
+        functor.template operator()<InputT, OutputT>(std::forward<ArgsT>(args)...);
+    }
+};
+
+template <typename FunctorT>
+struct MatxUtil__DispatchOutputType
+{
+    using types_t = typename MatxUtil__FunctorInputOutputTypes<FunctorT>::input_types_t;
+
+    const DType& output_dtype;
+    FunctorT& functor;
+
+    template <typename InputT, typename... ArgsT>
+    void operator()(ArgsT&&... args)
+    {
+        dispatch_type(output_dtype, MatxUtil__BoundInputType<InputT, FunctorT>{functor}, std::forward<ArgsT>(args)...);
+    }
+};
+
+/**
+ * @brief Calls `functor.operator()<InputT, OutputT>(args...)`, the two type equivalent of `dispatch_type`
+ */
+template <typename FunctorT, typename... ArgsT>
+void double_dispatch_type(const DType& input_dtype, const DType& output_dtype, FunctorT functor, ArgsT&&... args)
+{
+    dispatch_type(
+        input_dtype, MatxUtil__DispatchOutputType<FunctorT>{output_dtype, functor}, std::forward<ArgsT>(args)...);
+}
+
 // Since we are building MatX in 32bit mode, we can only support up to 2^31 in any on dimension, for count type values
 // that consider multiple dimensions we use TensorSize, while other operations such as MatxUtil__MatxCast which only
 // opperate on a single dimension use TensorIndex.
@@ -43,6 +268,9 @@ using tensorShape_2d = std::array<matx::index_t, 2>;
  */
 struct MatxUtil__MatxCast
 {
+    using input_types_t  = CastTypes;
+    using output_types_t = CastTypes;
+
     TensorIndex element_count;
     rmm::cuda_stream_view stream;
 
@@ -51,7 +279,7 @@ struct MatxUtil__MatxCast
      */
     template <typename InputT,
               typename OutputT,
-              std::enable_if_t<!cudf::is_numeric<InputT>() || !cudf::is_numeric<OutputT>()>* = nullptr>
+              std::enable_if_t<!is_convertible_v<InputT, OutputT>>* = nullptr>
     void operator()(void* input_data, void* output_data)
     {
         throw std::invalid_argument("Unsupported conversion");
@@ -62,7 +290,7 @@ struct MatxUtil__MatxCast
      */
     template <typename InputT,
               typename OutputT,
-              std::enable_if_t<cudf::is_numeric<InputT>() && cudf::is_numeric<OutputT>()>* = nullptr>
+              std::enable_if_t<is_convertible_v<InputT, OutputT>>* = nullptr>
     void operator()(void* input_data, void* output_data)
     {
         tensorShape_1d shape({element_count});
@@ -74,12 +302,83 @@ struct MatxUtil__MatxCast
     }
 };
 
+// ************ MatxUtil__CastInto**************//
+// The half precision types are converted through float, which they only convert to and from
+template <typename InputT, typename OutputT>
+__device__ OutputT convert_element(InputT value)
+{
+    if constexpr (is_half_v<InputT> || is_half_v<OutputT>)
+    {
+        return static_cast<OutputT>(static_cast<float>(value));
+    }
+    else
+    {
+        return static_cast<OutputT>(value);
+    }
+}
+
+template <typename InputT, typename OutputT>
+__global__ void cast_into_kernel(const InputT* input,
+                                 OutputT* output,
+                                 TensorSize num_elements,
+                                 TensorIndex num_columns,
+                                 TensorIndex row_stride,
+                                 TensorIndex col_stride)
+{
+    for (TensorSize i = blockIdx.x * static_cast<TensorSize>(blockDim.x) + threadIdx.x; i < num_elements;
+         i += static_cast<TensorSize>(blockDim.x) * gridDim.x)
+    {
+        const auto row = static_cast<TensorIndex>(i / num_columns);
+        const auto col = static_cast<TensorIndex>(i % num_columns);
+
+        output[i] = convert_element<InputT, OutputT>(input[row * row_stride + col * col_stride]);
+    }
+}
+
+struct MatxUtil__CastInto
+{
+    using input_types_t  = CastTypes;
+    using output_types_t = CastTypes;
+
+    const DevMemInfo& input;
+    rmm::cuda_stream_view stream;
+
+    template <typename InputT,
+              typename OutputT,
+              std::enable_if_t<!is_convertible_v<InputT, OutputT>>* = nullptr>
+    void operator()(void* output)
+    {
+        throw std::invalid_argument("Unsupported conversion");
+    }
+
+    template <typename InputT,
+              typename OutputT,
+              std::enable_if_t<is_convertible_v<InputT, OutputT>>* = nullptr>
+    void operator()(void* output)
+    {
+        constexpr unsigned int threads_per_block = 256;
+        const auto num_elements = static_cast<TensorSize>(input.shape(0)) * input.shape(1);
+        const auto num_blocks   = static_cast<unsigned int>(
+            std::min<TensorSize>((num_elements + threads_per_block - 1) / threads_per_block, 65535));
+
+        cast_into_kernel<InputT, OutputT>
+            <<<num_blocks, threads_per_block, 0, stream.value()>>>(static_cast<const InputT*>(input.data()),
+                                                                   static_cast<OutputT*>(output),
+                                                                   num_elements,
+                                                                   input.shape(1),
+                                                                   input.stride(0),
+                                                                   input.stride(1));
+    }
+};
+
 // ************ MatxUtil__MatxCreateSegIds**************//
 /**
  * TODO(Documentation)
  */
 struct MatxUtil__MatxCreateSegIds
 {
+    using types_t = IntegralTypes;
+
     TensorIndex start_idx;
     TensorIndex element_count;
     TensorIndex fea_len;
@@ -121,6 +420,8 @@ struct MatxUtil__MatxCreateSegIds
  */
 struct MatxUtil__MatxOffsetSegIds
 {
+    using types_t = IntegralTypes;
+
     TensorIndex offset;
     TensorIndex element_count;
     rmm::cuda_stream_view stream;
@@ -157,13 +458,15 @@ struct MatxUtil__MatxOffsetSegIds
  */
 struct MatxUtil__MatxLogits
 {
+    using types_t = FloatingPointTypes;
+
     TensorIndex element_count;
     rmm::cuda_stream_view stream;
 
     /**
      * TODO(Documentation)
      */
-    template <typename InputT, std::enable_if_t<!cudf::is_floating_point<InputT>()>* = nullptr>
+    template <typename InputT, std::enable_if_t<!is_floating_point_v<InputT>>* = nullptr>
     void operator()(void* input_data, void* output_data)
     {
         throw std::invalid_argument("Unsupported conversion");
@@ -172,7 +475,7 @@ struct MatxUtil__MatxLogits
     /**
      * TODO(Documentation)
      */
-    template <typename InputT, std::enable_if_t<cudf::is_floating_point<InputT>()>* = nullptr>
+    template <typename InputT, std::enable_if_t<is_floating_point_v<InputT>>* = nullptr>
     void operator()(void* input_data, void* output_data)
     {
         tensorShape_1d shape({element_count});
@@ -198,7 +501,7 @@ struct MatxUtil__MatxTranspose
     /**
      * TODO(Documentation)
      */
-    template <typename InputT, std::enable_if_t<!cudf::is_numeric<InputT>()>* = nullptr>
+    template <typename InputT, std::enable_if_t<!is_numeric_v<InputT>>* = nullptr>
     void operator()(void* input_data, void* output_data)
     {
         throw std::invalid_argument("Unsupported conversion");
@@ -207,7 +510,7 @@ struct MatxUtil__MatxTranspose
     /**
      * TODO(Documentation)
      */
-    template <typename InputT, std::enable_if_t<cudf::is_numeric<InputT>()>* = nullptr>
+    template <typename InputT, std::enable_if_t<is_numeric_v<InputT>>* = nullptr>
     void operator()(void* input_data, void* output_data)
     {
         tensorShape_2d input_shape({rows, cols});
@@ -226,6 +529,8 @@ struct MatxUtil__MatxTranspose
  */
 struct MatxUtil__MatxThreshold
 {
+    using types_t = FloatingPointTypes;
+
     TensorIndex rows;
     TensorIndex cols;
     bool by_row;
@@ -234,7 +539,7 @@ struct MatxUtil__MatxThreshold
     /**
      * TODO(Documentation)
      */
-    template <typename InputT, std::enable_if_t<!cudf::is_floating_point<InputT>()>* = nullptr>
+    template <typename InputT, std::enable_if_t<!is_floating_point_v<InputT>>* = nullptr>
     void operator()(void* input_data, void* output_data, double threshold, const ShapeType& stride)
     {
         throw std::invalid_argument("Unsupported conversion");
@@ -243,7 +548,7 @@ struct MatxUtil__MatxThreshold
     /**
      * TODO(Documentation)
      */
-    template <typename InputT, std::enable_if_t<cudf::is_floating_point<InputT>()>* = nullptr>
+    template <typename InputT, std::enable_if_t<is_floating_point_v<InputT>>* = nullptr>
     void operator()(void* input_data, void* output_data, double threshold, const ShapeType& stride)
     {
         if (by_row)
@@ -299,6 +604,8 @@ struct MatxUtil__MatxThreshold
 
 struct MatxUtil__MatxReduceMax
 {
+    using types_t = FloatingPointTypes;
+
     matx::index_t num_input_rows;
     matx::index_t num_output_rows;
     matx::index_t num_cols;
@@ -307,13 +614,13 @@ struct MatxUtil__MatxReduceMax
     TensorIndex seq_id_offset;
     rmm::cuda_stream_view stream;
 
-    template <typename InputT, std::enable_if_t<!cudf::is_floating_point<InputT>()>* = nullptr>
+    template <typename InputT, std::enable_if_t<!is_floating_point_v<InputT>>* = nullptr>
     void operator()(void* input_data, void* output_data)
     {
         throw std::invalid_argument("Unsupported conversion");
     }
 
-    template <typename InputT, std::enable_if_t<cudf::is_floating_point<InputT>()>* = nullptr>
+    template <typename InputT, std::enable_if_t<is_floating_point_v<InputT>>* = nullptr>
     void operator()(void* input_data, void* output_data)
     {
         auto input_ptr = static_cast<InputT*>(input_data);
@@ -365,132 +672,2413 @@ struct MatxUtil__MatxReduceMax
         (output_slice = matx::rmax(input_slice.Permute({1, 0}))).run(stream.value());
     }
 };
-}  // namespace
 
-namespace morpheus {
-// Component public implementations
-// ************ MatxUtil************************* //
-std::shared_ptr<rmm::device_buffer> MatxUtil::cast(const DevMemInfo& input, TypeId output_type)
+/**
+ * @brief Takes the output buffer from `pool` when one is given, otherwise allocates it on the stream of `input`
+ */
+std::shared_ptr<rmm::device_buffer> make_output_buffer(const DevMemInfo& input,
+                                                       TensorSize bytes,
+                                                       const std::shared_ptr<TensorBufferPool>& pool)
 {
-    auto output_dtype = DType(output_type);
+    if (pool)
+    {
+        return pool->get_buffer(bytes);
+    }
 
-    // Create the output
-    auto output = input.make_new_buffer(output_dtype.item_size() * input.count());
+    return input.make_new_buffer(bytes);
+}
 
-    cudf::double_type_dispatcher(cudf::data_type{input.dtype().cudf_type_id()},
-                                 cudf::data_type{output_dtype.cudf_type_id()},
-                                 MatxUtil__MatxCast{boost::numeric_cast<TensorIndex>(input.count()), output->stream()},
-                                 input.data(),
-                                 output->data());
+// ************ MatxUtil__GatherRows**************//
+// Returns the input row of `output_row`, `range_offsets` holding the first output row of each range followed by the
+// first input row of each range
+__device__ TensorIndex gathered_input_row(const TensorIndex* range_offsets,
+                                          TensorIndex num_ranges,
+                                          TensorIndex output_row)
+{
+    const TensorIndex* output_starts = range_offsets;
+    const TensorIndex* input_starts  = range_offsets + num_ranges;
 
-    mrc::enqueue_stream_sync_event(output->stream()).get();
+    // Find the last range starting at or before the output row
+    TensorIndex lo = 0;
+    TensorIndex hi = num_ranges - 1;
+    while (lo < hi)
+    {
+        auto mid = (lo + hi + 1) / 2;
+        if (output_starts[mid] <= output_row)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
 
-    return output;
+    return input_starts[lo] + (output_row - output_starts[lo]);
 }
 
-std::shared_ptr<rmm::device_buffer> MatxUtil::create_seq_ids(TensorIndex row_count,
-                                                             TensorIndex fea_len,
-                                                             TypeId output_type,
-                                                             std::shared_ptr<MemoryDescriptor> md,
-                                                             TensorIndex start_idx)
+// Copies the rows selected by a table of ranges into a row major output, each thread copies one element to avoid a
+// separate copy per range. `range_offsets` holds the first output row of each range followed by the first input row
+// of each range.
+template <typename T>
+__global__ void gather_rows_kernel(const T* input,
+                                   T* output,
+                                   const TensorIndex* range_offsets,
+                                   TensorIndex num_ranges,
+                                   TensorIndex num_columns,
+                                   TensorIndex row_stride,
+                                   TensorIndex col_stride,
+                                   TensorSize num_elements)
 {
-    auto output_dtype = DType(output_type);
+    for (TensorSize idx = blockIdx.x * static_cast<TensorSize>(blockDim.x) + threadIdx.x; idx < num_elements;
+         idx += static_cast<TensorSize>(blockDim.x) * gridDim.x)
+    {
+        auto output_row = static_cast<TensorIndex>(idx / num_columns);
+        auto column     = static_cast<TensorIndex>(idx % num_columns);
 
-    // Now create the output
-    auto output = std::make_shared<rmm::device_buffer>(
-        output_dtype.item_size() * row_count * 3, md->cuda_stream, md->memory_resource);
+        auto input_row = gathered_input_row(range_offsets, num_ranges, output_row);
+        output[idx]    = input[input_row * row_stride + column * col_stride];
+    }
+}
+
+// The rows of a single tensor gathered by `gather_tensor_rows_kernel`
+struct GatherTensorRows
+{
+    const void* input;
+    void* output;
+    TensorIndex num_columns;
+    TensorIndex row_stride;
+    TensorIndex col_stride;
+    std::size_t item_size;
+};
 
-    cudf::type_dispatcher(cudf::data_type{output_dtype.cudf_type_id()},
-                          MatxUtil__MatxCreateSegIds{start_idx, row_count, fea_len, output->stream()},
-                          output->data());
+template <typename T>
+__device__ void gather_tensor_rows(const GatherTensorRows& tensor,
+                                   const TensorIndex* range_offsets,
+                                   TensorIndex num_ranges,
+                                   TensorIndex num_rows)
+{
+    const auto* input       = static_cast<const T*>(tensor.input);
+    auto* output            = static_cast<T*>(tensor.output);
+    const auto num_elements = static_cast<TensorSize>(num_rows) * tensor.num_columns;
 
-    return output;
+    for (TensorSize idx = blockIdx.x * static_cast<TensorSize>(blockDim.x) + threadIdx.x; idx < num_elements;
+         idx += static_cast<TensorSize>(blockDim.x) * gridDim.x)
+    {
+        auto output_row = static_cast<TensorIndex>(idx / tensor.num_columns);
+        auto column     = static_cast<TensorIndex>(idx % tensor.num_columns);
+
+        auto input_row = gathered_input_row(range_offsets, num_ranges, output_row);
+        output[idx]    = input[input_row * tensor.row_stride + column * tensor.col_stride];
+    }
 }
 
-void MatxUtil::offset_seq_ids(const DevMemInfo& input, TensorIndex offset)
+// Gathers the same rows of several tensors, each row of the grid gathering the rows of one tensor
+__global__ void gather_tensor_rows_kernel(const GatherTensorRows* tensors,
+                                          const TensorIndex* range_offsets,
+                                          TensorIndex num_ranges,
+                                          TensorIndex num_rows)
 {
-    cudf::type_dispatcher(cudf::data_type{input.dtype().cudf_type_id()},
-                          MatxUtil__MatxOffsetSegIds{offset, input.shape(0), rmm::cuda_stream_per_thread},
-                          input.data());
+    const auto& tensor = tensors[blockIdx.y];
 
-    mrc::enqueue_stream_sync_event(rmm::cuda_stream_per_thread).get();
+    switch (tensor.item_size)
+    {
+    case 1:
+        gather_tensor_rows<uint8_t>(tensor, range_offsets, num_ranges, num_rows);
+        break;
+    case 2:
+        gather_tensor_rows<uint16_t>(tensor, range_offsets, num_ranges, num_rows);
+        break;
+    case 4:
+        gather_tensor_rows<uint32_t>(tensor, range_offsets, num_ranges, num_rows);
+        break;
+    case 8:
+        gather_tensor_rows<uint64_t>(tensor, range_offsets, num_ranges, num_rows);
+        break;
+    }
 }
 
-std::shared_ptr<rmm::device_buffer> MatxUtil::logits(const DevMemInfo& input)
+// Returns the output row of each non empty range followed by the input row of each of them, the table read by
+// `gathered_input_row`
+std::vector<TensorIndex> make_range_offsets(const std::vector<RangeType>& ranges, TensorIndex num_rows)
 {
-    // Create the output
-    auto output = input.make_new_buffer(input.bytes());
+    std::vector<TensorIndex> range_offsets;
+    range_offsets.reserve(ranges.size() * 2);
 
-    cudf::type_dispatcher(cudf::data_type{input.dtype().cudf_type_id()},
-                          MatxUtil__MatxLogits{boost::numeric_cast<TensorIndex>(input.count()), output->stream()},
-                          input.data(),
-                          output->data());
+    TensorIndex output_row = 0;
+    for (const auto& [start, stop] : ranges)
+    {
+        if (stop > start)
+        {
+            range_offsets.push_back(output_row);
+            output_row += stop - start;
+        }
+    }
 
-    return output;
+    for (const auto& [start, stop] : ranges)
+    {
+        if (stop > start)
+        {
+            range_offsets.push_back(start);
+        }
+    }
+
+    DCHECK_EQ(output_row, num_rows) << "Number of rows in the ranges must match num_rows";
+
+    return range_offsets;
 }
 
-std::shared_ptr<rmm::device_buffer> MatxUtil::transpose(const DevMemInfo& input)
+template <typename T>
+void launch_gather_rows(const DevMemInfo& input,
+                        void* output,
+                        const TensorIndex* range_offsets,
+                        TensorIndex num_ranges,
+                        TensorSize num_elements,
+                        rmm::cuda_stream_view stream)
 {
-    // Now create the output
-    auto output = input.make_new_buffer(input.bytes());
+    constexpr int threads_per_block = 256;
+    auto num_blocks = static_cast<int>(std::min<TensorSize>((num_elements + threads_per_block - 1) / threads_per_block,
+                                                            std::numeric_limits<int>::max()));
+
+    gather_rows_kernel<T><<<num_blocks, threads_per_block, 0, stream.value()>>>(static_cast<const T*>(input.data()),
+                                                                               static_cast<T*>(output),
+                                                                               range_offsets,
+                                                                               num_ranges,
+                                                                               input.shape(1),
+                                                                               input.stride(0),
+                                                                               input.stride(1),
+                                                                               num_elements);
+}
+
+// ************ MatxUtil__ReduceLogitsThreshold**************//
+// The MatX half types wrap the CUDA ones, the kernel operates on the CUDA types directly
+template <typename T>
+struct MatxUtil__DeviceType
+{
+    using type = T;
+};
+
+template <>
+struct MatxUtil__DeviceType<matx::matxFp16>
+{
+    using type = __half;
+};
 
-    cudf::type_dispatcher(cudf::data_type{input.dtype().cudf_type_id()},
-                          MatxUtil__MatxTranspose{output->stream(), input.shape(0), input.shape(1)},
-                          input.data(),
-                          output->data());
+template <>
+struct MatxUtil__DeviceType<matx::matxBf16>
+{
+    using type = __nv_bfloat16;
+};
 
-    return output;
+/**
+ * @brief Parameters of `reduce_logits_threshold_kernel`, strides are in elements. `row_offsets` holds the first input
+ * row of each output row followed by the number of input rows, or is null when the rows are not reduced.
+ */
+struct ReduceLogitsThresholdParams
+{
+    TensorIndex num_output_rows;
+    TensorIndex num_cols;
+    TensorIndex input_stride[2];
+    TensorIndex output_stride[2];
+    const TensorIndex* row_offsets;
+    bool apply_logits;
+    bool has_threshold;
+    bool by_row;
+    double threshold;
+};
+
+// Each thread produces one output element: the max over its input rows, then the sigmoid, then the mask
+template <typename T>
+__global__ void reduce_logits_threshold_kernel(const T* input, T* probs, bool* mask, ReduceLogitsThresholdParams params)
+{
+    // Accumulate in float for the 16 and 32 bit types
+    using AccT = std::conditional_t<std::is_same_v<T, double>, double, float>;
+
+    const auto num_elements = static_cast<TensorSize>(params.num_output_rows) * params.num_cols;
+    const auto step         = static_cast<TensorSize>(blockDim.x) * gridDim.x;
+
+    for (auto idx = static_cast<TensorSize>(blockIdx.x) * blockDim.x + threadIdx.x; idx < num_elements; idx += step)
+    {
+        const auto row = static_cast<TensorIndex>(idx / params.num_cols);
+        const auto col = static_cast<TensorIndex>(idx % params.num_cols);
+
+        TensorIndex first_row = row;
+        TensorIndex last_row  = row + 1;
+        if (params.row_offsets != nullptr)
+        {
+            first_row = params.row_offsets[row];
+            last_row  = params.row_offsets[row + 1];
+        }
+
+        const T* column = input + col * params.input_stride[1];
+        auto value      = static_cast<AccT>(column[first_row * params.input_stride[0]]);
+        for (auto input_row = first_row + 1; input_row < last_row; ++input_row)
+        {
+            value = max(value, static_cast<AccT>(column[input_row * params.input_stride[0]]));
+        }
+
+        if (params.apply_logits)
+        {
+            value = AccT(1) / (AccT(1) + exp(-value));
+        }
+
+        const auto output_idx = row * params.output_stride[0] + col * params.output_stride[1];
+        probs[output_idx]     = static_cast<T>(value);
+
+        if (params.has_threshold)
+        {
+            const bool above_threshold = value > static_cast<AccT>(params.threshold);
+            if (params.by_row)
+            {
+                // The mask is cleared before the launch, any thread of the row may set it
+                if (above_threshold)
+                {
+                    mask[row] = true;
+                }
+            }
+            else
+            {
+                mask[output_idx] = above_threshold;
+            }
+        }
+    }
 }
 
-std::shared_ptr<rmm::device_buffer> MatxUtil::threshold(const DevMemInfo& input, double thresh_val, bool by_row)
+struct MatxUtil__ReduceLogitsThreshold
 {
-    const auto rows        = input.shape(0);
-    const auto cols        = input.shape(1);
-    TensorSize output_size = sizeof(bool) * rows;
-    if (!by_row)
+    using types_t = FloatingPointTypes;
+
+    ReduceLogitsThresholdParams params;
+    rmm::cuda_stream_view stream;
+
+    template <typename InputT, std::enable_if_t<!is_floating_point_v<InputT>>* = nullptr>
+    void operator()(const void* input_data, void* probs_data, bool* mask_data)
     {
-        output_size *= cols;
+        throw std::invalid_argument("Unsupported conversion");
     }
 
-    // Now create the output array of bools
-    auto output = input.make_new_buffer(output_size);
+    template <typename InputT, std::enable_if_t<is_floating_point_v<InputT>>* = nullptr>
+    void operator()(const void* input_data, void* probs_data, bool* mask_data)
+    {
+        using DeviceT = typename MatxUtil__DeviceType<InputT>::type;
 
-    cudf::type_dispatcher(cudf::data_type{input.dtype().cudf_type_id()},
-                          MatxUtil__MatxThreshold{rows, cols, by_row, output->stream()},
-                          input.data(),
-                          output->data(),
-                          thresh_val,
-                          input.stride());
+        constexpr unsigned int threads_per_block = 256;
+        const auto num_elements = static_cast<TensorSize>(params.num_output_rows) * params.num_cols;
+        const auto num_blocks =
+            static_cast<unsigned int>(std::min<TensorSize>((num_elements + threads_per_block - 1) / threads_per_block,
+                                                           std::numeric_limits<int32_t>::max()));
 
-    mrc::enqueue_stream_sync_event(output->stream()).get();
+        reduce_logits_threshold_kernel<DeviceT><<<num_blocks, threads_per_block, 0, stream.value()>>>(
+            static_cast<const DeviceT*>(input_data), static_cast<DeviceT*>(probs_data), mask_data, params);
+    }
+};
 
-    return output;
+// Marks the first input row of each output row, seq_ids are sorted so each output row is a contiguous range of input
+// rows. The ids are relative to the first row, which is the first output row.
+template <typename T>
+__global__ void seq_id_offsets_kernel(
+    const T* seq_ids, TensorIndex stride, TensorIndex num_input_rows, TensorIndex num_output_rows, TensorIndex* offsets)
+{
+    const auto first_id = seq_ids[0];
+    const auto step     = static_cast<TensorIndex>(blockDim.x * gridDim.x);
+
+    for (auto row = static_cast<TensorIndex>(blockIdx.x * blockDim.x + threadIdx.x); row < num_input_rows; row += step)
+    {
+        const auto output_row = static_cast<TensorIndex>(seq_ids[row * stride] - first_id);
+        if (row == 0)
+        {
+            offsets[num_output_rows] = num_input_rows;
+        }
+
+        if ((row == 0 || seq_ids[(row - 1) * stride] != seq_ids[row * stride]) && output_row >= 0 &&
+            output_row < num_output_rows)
+        {
+            offsets[output_row] = row;
+        }
+    }
 }
 
-std::shared_ptr<rmm::device_buffer> MatxUtil::reduce_max(const DevMemInfo& input,
-                                                         const ShapeType& seq_ids,
-                                                         TensorIndex seq_id_offset,
-                                                         const ShapeType& output_shape)
+struct MatxUtil__SeqIdOffsets
 {
-    const auto& dtype   = input.dtype();
-    auto cudf_type      = cudf::data_type{dtype.cudf_type_id()};
-    auto num_input_rows = input.shape(0);
-    auto num_input_cols = input.shape(1);
-
-    TensorSize output_element_count = output_shape[0] * output_shape[1];
-    TensorSize output_buff_size     = dtype.item_size() * output_element_count;
+    using types_t = IntegralTypes;
 
-    DCHECK(output_element_count <= input.count()) << "Output buffer size should be less than or equal to the input";
-    DCHECK(num_input_cols == output_shape[1]) << "Number of input and output columns must match";
+    TensorIndex stride;
+    TensorIndex num_input_rows;
+    TensorIndex num_output_rows;
+    rmm::cuda_stream_view stream;
 
-    auto output = input.make_new_buffer(output_buff_size);
+    template <typename SeqIdT, std::enable_if_t<!std::is_integral_v<SeqIdT>>* = nullptr>
+    void operator()(const void* seq_ids, TensorIndex* offsets)
+    {
+        throw std::invalid_argument("seq_ids must be an integer type");
+    }
 
-    MatxUtil__MatxReduceMax matx_reduce_max{
-        num_input_rows, output_shape[0], num_input_cols, input.stride(), seq_ids, seq_id_offset, output->stream()};
+    template <typename SeqIdT, std::enable_if_t<std::is_integral_v<SeqIdT>>* = nullptr>
+    void operator()(const void* seq_ids, TensorIndex* offsets)
+    {
+        constexpr unsigned int threads_per_block = 256;
+        const auto num_blocks = static_cast<unsigned int>((num_input_rows + threads_per_block - 1) / threads_per_block);
 
-    cudf::type_dispatcher(cudf_type, matx_reduce_max, input.data(), output->data());
+        seq_id_offsets_kernel<SeqIdT><<<num_blocks, threads_per_block, 0, stream.value()>>>(
+            static_cast<const SeqIdT*>(seq_ids), stride, num_input_rows, num_output_rows, offsets);
+    }
+};
+
+/**
+ * @brief Allocates the outputs of `reduce_logits_threshold`, using the same output layout as reduce_max
+ */
+PostInferenceOutput make_post_inference_output(const DevMemInfo& input,
+                                               TensorIndex num_output_rows,
+                                               const std::optional<double>& thresh_val,
+                                               bool by_row,
+                                               const std::shared_ptr<TensorBufferPool>& pool)
+{
+    const auto num_cols      = input.shape(1);
+    const auto& input_stride = input.stride();
+
+    ShapeType output_stride{input_stride[0], input_stride[1]};
+    if (output_stride[0] == 1)
+    {
+        output_stride[1] = num_output_rows;
+    }
+
+    const auto num_elements = static_cast<TensorSize>(num_output_rows) * num_cols;
+
+    PostInferenceOutput output{make_output_buffer(input, num_elements * input.dtype().item_size(), pool),
+                               {num_output_rows, num_cols},
+                               output_stride,
+                               nullptr};
+
+    if (thresh_val.has_value())
+    {
+        output.mask = make_output_buffer(input, by_row ? num_output_rows : num_elements, pool);
+    }
+
+    return output;
+}
+
+/**
+ * @brief Launches the fused kernel into the buffers of `output` on `stream`, `row_offsets` is a device pointer or null
+ * when the rows are not reduced
+ */
+void launch_reduce_logits_threshold(const DevMemInfo& input,
+                                    PostInferenceOutput& output,
+                                    const TensorIndex* row_offsets,
+                                    bool apply_logits,
+                                    const std::optional<double>& thresh_val,
+                                    bool by_row,
+                                    rmm::cuda_stream_view stream)
+{
+    const auto& input_stride = input.stride();
+
+    if (output.mask && by_row)
+    {
+        MRC_CHECK_CUDA(cudaMemsetAsync(output.mask->data(), 0, output.mask->size(), stream.value()));
+    }
+
+    ReduceLogitsThresholdParams params{output.shape[0],
+                                       output.shape[1],
+                                       {input_stride[0], input_stride[1]},
+                                       {output.stride[0], output.stride[1]},
+                                       row_offsets,
+                                       apply_logits,
+                                       thresh_val.has_value(),
+                                       by_row,
+                                       thresh_val.value_or(0)};
+
+    dispatch_type(input.dtype(),
+                  MatxUtil__ReduceLogitsThreshold{params, stream},
+                  input.data(),
+                  output.probs->data(),
+                  output.mask ? static_cast<bool*>(output.mask->data()) : nullptr);
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+// ************ MatxUtil__CopyStridedColumns**************//
+template <typename T>
+__device__ void copy_strided_column(const StridedColumnCopy& copy, TensorIndex first_row, TensorIndex row_step)
+{
+    const T* source = static_cast<const T*>(copy.source);
+    T* destination  = static_cast<T*>(copy.destination);
+
+    for (TensorIndex row = first_row; row < copy.num_rows; row += row_step)
+    {
+        destination[row] = source[row * copy.source_stride];
+    }
+}
+
+template <typename T>
+__device__ void widen_strided_column(const StridedColumnCopy& copy, TensorIndex first_row, TensorIndex row_step)
+{
+    const T* source    = static_cast<const T*>(copy.source);
+    float* destination = static_cast<float*>(copy.destination);
+
+    for (TensorIndex row = first_row; row < copy.num_rows; row += row_step)
+    {
+        destination[row] = static_cast<float>(source[row * copy.source_stride]);
+    }
+}
+
+// Each column is copied by one row of blocks in the grid, the x dimension strides over the rows of the column
+__global__ void copy_strided_columns_kernel(const StridedColumnCopy* copies)
+{
+    const auto& copy     = copies[blockIdx.y];
+    const auto first_row = static_cast<TensorIndex>(blockIdx.x * blockDim.x + threadIdx.x);
+    const auto row_step  = static_cast<TensorIndex>(blockDim.x * gridDim.x);
+
+    if (copy.source_type == TypeId::FLOAT16)
+    {
+        widen_strided_column<__half>(copy, first_row, row_step);
+        return;
+    }
+
+    if (copy.source_type == TypeId::BFLOAT16)
+    {
+        widen_strided_column<__nv_bfloat16>(copy, first_row, row_step);
+        return;
+    }
+
+    switch (copy.item_size)
+    {
+    case 1:
+        copy_strided_column<uint8_t>(copy, first_row, row_step);
+        break;
+    case 2:
+        copy_strided_column<uint16_t>(copy, first_row, row_step);
+        break;
+    case 4:
+        copy_strided_column<uint32_t>(copy, first_row, row_step);
+        break;
+    case 8:
+        copy_strided_column<uint64_t>(copy, first_row, row_step);
+        break;
+    }
+}
+
+// ************ MatxUtil__HashRows**************//
+// Combines `value` into `hash`, followed by the finalizer of MurmurHash3 so that every bit of the value affects every
+// bit of the hash
+__device__ uint64_t mix_hash(uint64_t hash, uint64_t value)
+{
+    hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Each thread hashes one row, values are hashed by their bits so that any type of the same size can share the kernel
+template <typename T>
+__global__ void hash_rows_kernel(const T* input,
+                                 uint64_t* hashes,
+                                 TensorIndex num_rows,
+                                 TensorIndex num_columns,
+                                 TensorIndex row_stride,
+                                 TensorIndex col_stride)
+{
+    for (TensorIndex row = blockIdx.x * static_cast<TensorIndex>(blockDim.x) + threadIdx.x; row < num_rows;
+         row += static_cast<TensorIndex>(blockDim.x) * gridDim.x)
+    {
+        uint64_t hash = mix_hash(hashes[row], static_cast<uint64_t>(num_columns));
+
+        for (TensorIndex column = 0; column < num_columns; ++column)
+        {
+            hash = mix_hash(hash, static_cast<uint64_t>(input[row * row_stride + column * col_stride]));
+        }
+
+        hashes[row] = hash;
+    }
+}
+
+template <typename T>
+void launch_hash_rows(const DevMemInfo& input, uint64_t* hashes, rmm::cuda_stream_view stream)
+{
+    constexpr int threads_per_block = 256;
+    const auto num_rows             = input.shape(0);
+    auto num_blocks                 = static_cast<int>(
+        std::min<TensorIndex>((num_rows + threads_per_block - 1) / threads_per_block, 65535));
+
+    hash_rows_kernel<T><<<num_blocks, threads_per_block, 0, stream.value()>>>(static_cast<const T*>(input.data()),
+                                                                             hashes,
+                                                                             num_rows,
+                                                                             input.shape(1),
+                                                                             input.stride(0),
+                                                                             input.stride(1));
+}
+
+// ************ MatxUtil__TopK**************//
+// Each thread keeps the best `k` values of one row sorted in decreasing order, inserting each larger value in place.
+// Values equal to the smallest kept value are skipped, such that ties are broken by the order of `columns`.
+template <typename T>
+__global__ void top_k_kernel(const T* input,
+                             const TensorIndex* columns,
+                             TensorIndex num_columns,
+                             TensorIndex num_rows,
+                             TensorIndex row_stride,
+                             TensorIndex col_stride,
+                             TensorIndex k,
+                             bool has_threshold,
+                             float threshold,
+                             int32_t* ids,
+                             float* scores)
+{
+    for (TensorIndex row = blockIdx.x * static_cast<TensorIndex>(blockDim.x) + threadIdx.x; row < num_rows;
+         row += static_cast<TensorIndex>(blockDim.x) * gridDim.x)
+    {
+        float best_scores[MatxUtil::MaxTopK];
+        int32_t best_ids[MatxUtil::MaxTopK];
+        TensorIndex count = 0;
+
+        for (TensorIndex i = 0; i < num_columns; ++i)
+        {
+            const auto column = columns[i];
+            const auto value  = static_cast<float>(input[row * row_stride + column * col_stride]);
+
+            if (count == k && value <= best_scores[k - 1])
+            {
+                continue;
+            }
+
+            auto pos = count < k ? count++ : k - 1;
+            for (; pos > 0 && best_scores[pos - 1] < value; --pos)
+            {
+                best_scores[pos] = best_scores[pos - 1];
+                best_ids[pos]    = best_ids[pos - 1];
+            }
+
+            best_scores[pos] = value;
+            best_ids[pos]    = static_cast<int32_t>(column);
+        }
+
+        for (TensorIndex rank = 0; rank < k; ++rank)
+        {
+            const bool is_selected      = !has_threshold || best_scores[rank] > threshold;
+            ids[rank * num_rows + row]    = is_selected ? best_ids[rank] : -1;
+            scores[rank * num_rows + row] = best_scores[rank];
+        }
+    }
+}
+
+struct MatxUtil__TopK
+{
+    const DevMemInfo& input;
+    const TensorIndex* columns;
+    TensorIndex num_columns;
+    TensorIndex k;
+    std::optional<double> thresh_val;
+    rmm::cuda_stream_view stream;
+
+    template <typename InputT, std::enable_if_t<!is_numeric_v<InputT>>* = nullptr>
+    void operator()(int32_t* ids, float* scores)
+    {
+        throw std::invalid_argument("Unsupported input type for top_k");
+    }
+
+    template <typename InputT, std::enable_if_t<is_numeric_v<InputT>>* = nullptr>
+    void operator()(int32_t* ids, float* scores)
+    {
+        using DeviceT = typename MatxUtil__DeviceType<InputT>::type;
+
+        constexpr int threads_per_block = 128;
+        const auto num_rows             = input.shape(0);
+        auto num_blocks                 = static_cast<int>(
+            std::min<TensorIndex>((num_rows + threads_per_block - 1) / threads_per_block, 65535));
+
+        top_k_kernel<DeviceT><<<num_blocks, threads_per_block, 0, stream.value()>>>(
+            static_cast<const DeviceT*>(input.data()),
+            columns,
+            num_columns,
+            num_rows,
+            input.stride(0),
+            input.stride(1),
+            k,
+            thresh_val.has_value(),
+            static_cast<float>(thresh_val.value_or(0)),
+            ids,
+            scores);
+    }
+};
+
+// ************ MatxUtil__PackLabels**************//
+// Each thread packs one row
+template <typename T>
+__global__ void pack_labels_kernel(const T* input,
+                                   const TensorIndex* columns,
+                                   TensorIndex num_columns,
+                                   TensorIndex num_rows,
+                                   TensorIndex row_stride,
+                                   TensorIndex col_stride,
+                                   float threshold,
+                                   uint64_t* output)
+{
+    for (TensorIndex row = blockIdx.x * static_cast<TensorIndex>(blockDim.x) + threadIdx.x; row < num_rows;
+         row += static_cast<TensorIndex>(blockDim.x) * gridDim.x)
+    {
+        uint64_t packed = 0;
+        for (TensorIndex i = 0; i < num_columns; ++i)
+        {
+            if (static_cast<float>(input[row * row_stride + columns[i] * col_stride]) > threshold)
+            {
+                packed |= uint64_t{1} << i;
+            }
+        }
+
+        output[row] = packed;
+    }
+}
+
+struct MatxUtil__PackLabels
+{
+    const DevMemInfo& input;
+    const TensorIndex* columns;
+    TensorIndex num_columns;
+    double thresh_val;
+    rmm::cuda_stream_view stream;
+
+    template <typename InputT, std::enable_if_t<!is_numeric_v<InputT>>* = nullptr>
+    void operator()(uint64_t* output)
+    {
+        throw std::invalid_argument("Unsupported input type for pack_labels");
+    }
+
+    template <typename InputT, std::enable_if_t<is_numeric_v<InputT>>* = nullptr>
+    void operator()(uint64_t* output)
+    {
+        using DeviceT = typename MatxUtil__DeviceType<InputT>::type;
+
+        constexpr int threads_per_block = 128;
+        const auto num_rows             = input.shape(0);
+        auto num_blocks                 = static_cast<int>(
+            std::min<TensorIndex>((num_rows + threads_per_block - 1) / threads_per_block, 65535));
+
+        pack_labels_kernel<DeviceT><<<num_blocks, threads_per_block, 0, stream.value()>>>(
+            static_cast<const DeviceT*>(input.data()),
+            columns,
+            num_columns,
+            num_rows,
+            input.stride(0),
+            input.stride(1),
+            static_cast<float>(thresh_val),
+            output);
+    }
+};
+
+// ************ MatxUtil__CopyRows**************//
+// Each thread copies one word, `row_indices` holds the input row of each copy followed by the output row of each copy
+template <typename WordT>
+__global__ void copy_rows_kernel(const WordT* input,
+                                 WordT* output,
+                                 const TensorIndex* row_indices,
+                                 TensorIndex num_rows,
+                                 TensorIndex row_words,
+                                 TensorSize num_words)
+{
+    const TensorIndex* input_rows  = row_indices;
+    const TensorIndex* output_rows = row_indices + num_rows;
+
+    for (TensorSize idx = blockIdx.x * static_cast<TensorSize>(blockDim.x) + threadIdx.x; idx < num_words;
+         idx += static_cast<TensorSize>(blockDim.x) * gridDim.x)
+    {
+        auto row  = static_cast<TensorIndex>(idx / row_words);
+        auto word = static_cast<TensorIndex>(idx % row_words);
+
+        output[output_rows[row] * row_words + word] = input[input_rows[row] * row_words + word];
+    }
+}
+
+template <typename WordT>
+void launch_copy_rows(const void* input,
+                      void* output,
+                      std::size_t row_bytes,
+                      const TensorIndex* row_indices,
+                      TensorIndex num_rows,
+                      rmm::cuda_stream_view stream)
+{
+    constexpr int threads_per_block = 256;
+    const auto row_words            = static_cast<TensorIndex>(row_bytes / sizeof(WordT));
+    const auto num_words            = static_cast<TensorSize>(num_rows) * row_words;
+    auto num_blocks = static_cast<int>(std::min<TensorSize>((num_words + threads_per_block - 1) / threads_per_block,
+                                                            std::numeric_limits<int>::max()));
+
+    copy_rows_kernel<WordT><<<num_blocks, threads_per_block, 0, stream.value()>>>(static_cast<const WordT*>(input),
+                                                                                 static_cast<WordT*>(output),
+                                                                                 row_indices,
+                                                                                 num_rows,
+                                                                                 row_words,
+                                                                                 num_words);
+}
+// ************ MatxUtil__MaxRowLength**************//
+// Each thread scans one row back to front for its last non-zero value, values are compared by their bits so that any
+// type of the same size can share the kernel
+template <typename T>
+__global__ void max_row_length_kernel(const T* input,
+                                      TensorIndex* max_length,
+                                      TensorIndex num_rows,
+                                      TensorIndex num_columns,
+                                      TensorIndex row_stride,
+                                      TensorIndex col_stride)
+{
+    for (TensorIndex row = blockIdx.x * static_cast<TensorIndex>(blockDim.x) + threadIdx.x; row < num_rows;
+         row += static_cast<TensorIndex>(blockDim.x) * gridDim.x)
+    {
+        TensorIndex length = num_columns;
+        while (length > 0 && input[row * row_stride + (length - 1) * col_stride] == 0)
+        {
+            --length;
+        }
+
+        if (length > 0)
+        {
+            atomicMax(max_length, length);
+        }
+    }
+}
+
+template <typename T>
+void launch_max_row_length(const DevMemInfo& input, TensorIndex* max_length, rmm::cuda_stream_view stream)
+{
+    constexpr int threads_per_block = 256;
+    const auto num_rows             = input.shape(0);
+    auto num_blocks                 = static_cast<int>(
+        std::min<TensorIndex>((num_rows + threads_per_block - 1) / threads_per_block, 65535));
+
+    max_row_length_kernel<T><<<num_blocks, threads_per_block, 0, stream.value()>>>(static_cast<const T*>(input.data()),
+                                                                                  max_length,
+                                                                                  num_rows,
+                                                                                  input.shape(1),
+                                                                                  input.stride(0),
+                                                                                  input.stride(1));
+}
+// ************ MatxUtil__RowLengths**************//
+template <typename T>
+__global__ void row_lengths_kernel(const T* input,
+                                   TensorIndex* lengths,
+                                   TensorIndex num_rows,
+                                   TensorIndex num_columns,
+                                   TensorIndex row_stride,
+                                   TensorIndex col_stride)
+{
+    for (TensorIndex row = blockIdx.x * static_cast<TensorIndex>(blockDim.x) + threadIdx.x; row < num_rows;
+         row += static_cast<TensorIndex>(blockDim.x) * gridDim.x)
+    {
+        TensorIndex length = num_columns;
+        while (length > 0 && input[row * row_stride + (length - 1) * col_stride] == 0)
+        {
+            --length;
+        }
+
+        lengths[row] = max(lengths[row], length);
+    }
+}
+
+template <typename T>
+void launch_row_lengths(const DevMemInfo& input, TensorIndex* lengths, rmm::cuda_stream_view stream)
+{
+    constexpr int threads_per_block = 256;
+    const auto num_rows             = input.shape(0);
+    auto num_blocks                 = static_cast<int>(
+        std::min<TensorIndex>((num_rows + threads_per_block - 1) / threads_per_block, 65535));
+
+    row_lengths_kernel<T><<<num_blocks, threads_per_block, 0, stream.value()>>>(static_cast<const T*>(input.data()),
+                                                                               lengths,
+                                                                               num_rows,
+                                                                               input.shape(1),
+                                                                               input.stride(0),
+                                                                               input.stride(1));
+}
+
+// ************ MatxUtil__CopyRaggedRows**************//
+// Each thread handles one value of the padded rows, copying it from or to its packed position when it belongs to a
+// token of the row, and zeroing it otherwise when unpacking. Values are copied by their bits.
+template <typename T>
+__global__ void copy_ragged_rows_kernel(T* padded,
+                                        T* packed,
+                                        const TensorIndex* offsets,
+                                        TensorIndex num_rows,
+                                        TensorIndex row_width,
+                                        TensorIndex token_width,
+                                        bool unpack)
+{
+    const auto num_values = static_cast<TensorSize>(num_rows) * row_width;
+
+    for (TensorSize idx = blockIdx.x * static_cast<TensorSize>(blockDim.x) + threadIdx.x; idx < num_values;
+         idx += static_cast<TensorSize>(blockDim.x) * gridDim.x)
+    {
+        auto row    = static_cast<TensorIndex>(idx / row_width);
+        auto column = static_cast<TensorIndex>(idx % row_width);
+
+        const bool is_token = column / token_width < offsets[row + 1] - offsets[row];
+        if (is_token)
+        {
+            const auto packed_idx = static_cast<TensorSize>(offsets[row]) * token_width + column;
+            if (unpack)
+            {
+                padded[idx] = packed[packed_idx];
+            }
+            else
+            {
+                packed[packed_idx] = padded[idx];
+            }
+        }
+        else if (unpack)
+        {
+            padded[idx] = 0;
+        }
+    }
+}
+
+template <typename T>
+void launch_copy_ragged_rows_kernel(const DevMemInfo& padded,
+                                    void* packed,
+                                    const TensorIndex* offsets,
+                                    TensorIndex token_width,
+                                    bool unpack,
+                                    rmm::cuda_stream_view stream)
+{
+    constexpr int threads_per_block = 256;
+    const auto num_rows             = padded.shape(0);
+    const auto row_width            = padded.shape(1);
+    const auto num_values           = static_cast<TensorSize>(num_rows) * row_width;
+    auto num_blocks = static_cast<int>(std::min<TensorSize>((num_values + threads_per_block - 1) / threads_per_block,
+                                                            std::numeric_limits<int>::max()));
+
+    copy_ragged_rows_kernel<T><<<num_blocks, threads_per_block, 0, stream.value()>>>(
+        static_cast<T*>(padded.data()), static_cast<T*>(packed), offsets, num_rows, row_width, token_width, unpack);
+}
+
+void launch_copy_ragged_rows(const DevMemInfo& padded,
+                             void* packed,
+                             const TensorIndex* offsets,
+                             TensorIndex token_width,
+                             bool unpack,
+                             rmm::cuda_stream_view stream)
+{
+    if (padded.stride(1) != 1 || padded.stride(0) != padded.shape(1))
+    {
+        throw std::invalid_argument("Ragged rows can only be copied from and to row major tensors");
+    }
+
+    if (padded.shape(0) == 0 || padded.shape(1) == 0)
+    {
+        return;
+    }
+
+    switch (padded.dtype().item_size())
+    {
+    case 1:
+        launch_copy_ragged_rows_kernel<uint8_t>(padded, packed, offsets, token_width, unpack, stream);
+        break;
+    case 2:
+        launch_copy_ragged_rows_kernel<uint16_t>(padded, packed, offsets, token_width, unpack, stream);
+        break;
+    case 4:
+        launch_copy_ragged_rows_kernel<uint32_t>(padded, packed, offsets, token_width, unpack, stream);
+        break;
+    case 8:
+        launch_copy_ragged_rows_kernel<uint64_t>(padded, packed, offsets, token_width, unpack, stream);
+        break;
+    default:
+        throw std::invalid_argument("Unsupported item size for ragged rows");
+    }
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+// ************ MatxUtil__PackTokenRows**************//
+// Each thread writes one token of the output, `row_indices` holds the start of each row followed by its length
+__global__ void pack_token_rows_kernel(const int32_t* tokens,
+                                       const TensorIndex* row_indices,
+                                       TensorIndex num_rows,
+                                       TensorIndex sequence_length,
+                                       uint32_t* token_ids,
+                                       uint32_t* attention_mask)
+{
+    const TensorIndex* row_starts  = row_indices;
+    const TensorIndex* row_lengths = row_indices + num_rows;
+    const auto num_tokens          = static_cast<TensorSize>(num_rows) * sequence_length;
+
+    for (TensorSize idx = blockIdx.x * static_cast<TensorSize>(blockDim.x) + threadIdx.x; idx < num_tokens;
+         idx += static_cast<TensorSize>(blockDim.x) * gridDim.x)
+    {
+        auto row    = static_cast<TensorIndex>(idx / sequence_length);
+        auto column = static_cast<TensorIndex>(idx % sequence_length);
+
+        const bool is_token = column < row_lengths[row];
+
+        token_ids[idx]      = is_token ? static_cast<uint32_t>(tokens[row_starts[row] + column]) : 0;
+        attention_mask[idx] = is_token ? 1 : 0;
+    }
+}
+
+// ************ MatxUtil__PackFeatureMatrix**************//
+template <typename T>
+__device__ float read_feature(const FeatureColumn& column, TensorIndex row)
+{
+    return static_cast<float>(static_cast<const T*>(column.data)[column.offset + row]);
+}
+
+// Reads the value of `row` of a numeric column as a float, the row must be valid
+__device__ float read_numeric_feature(const FeatureColumn& column, TensorIndex row)
+{
+    switch (column.type)
+    {
+    case TypeId::INT8:
+        return read_feature<int8_t>(column, row);
+    case TypeId::INT16:
+        return read_feature<int16_t>(column, row);
+    case TypeId::INT32:
+        return read_feature<int32_t>(column, row);
+    case TypeId::INT64:
+        return read_feature<int64_t>(column, row);
+    case TypeId::UINT8:
+    case TypeId::BOOL8:
+        return read_feature<uint8_t>(column, row);
+    case TypeId::UINT16:
+        return read_feature<uint16_t>(column, row);
+    case TypeId::UINT32:
+        return read_feature<uint32_t>(column, row);
+    case TypeId::UINT64:
+        return read_feature<uint64_t>(column, row);
+    case TypeId::FLOAT64:
+        return read_feature<double>(column, row);
+    default:
+        return read_feature<float>(column, row);
+    }
+}
+
+// Whether a column type can be read by `read_numeric_feature`
+bool is_numeric_feature(TypeId type)
+{
+    switch (type)
+    {
+    case TypeId::INT8:
+    case TypeId::INT16:
+    case TypeId::INT32:
+    case TypeId::INT64:
+    case TypeId::UINT8:
+    case TypeId::UINT16:
+    case TypeId::UINT32:
+    case TypeId::UINT64:
+    case TypeId::FLOAT32:
+    case TypeId::FLOAT64:
+    case TypeId::BOOL8:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Each thread writes one feature of the row major output, threads of the first column also write the row's seq ids
+__global__ void pack_feature_matrix_kernel(const FeatureColumn* columns,
+                                           TensorIndex num_columns,
+                                           TensorIndex num_rows,
+                                           float fill_value,
+                                           float* features,
+                                           TensorIndex* seq_ids,
+                                           TensorIndex seq_id_offset)
+{
+    const auto num_features = static_cast<TensorSize>(num_rows) * num_columns;
+
+    for (TensorSize idx = blockIdx.x * static_cast<TensorSize>(blockDim.x) + threadIdx.x; idx < num_features;
+         idx += static_cast<TensorSize>(blockDim.x) * gridDim.x)
+    {
+        auto row    = static_cast<TensorIndex>(idx / num_columns);
+        auto col    = static_cast<TensorIndex>(idx % num_columns);
+        auto column = columns[col];
+
+        if (col == 0)
+        {
+            seq_ids[row * 3]     = row + seq_id_offset;
+            seq_ids[row * 3 + 1] = 0;
+            seq_ids[row * 3 + 2] = num_columns - 1;
+        }
+
+        if (column.null_mask != nullptr && !cudf::bit_is_set(column.null_mask, column.offset + row))
+        {
+            features[idx] = fill_value;
+            continue;
+        }
+
+        features[idx] = read_numeric_feature(column, row);
+    }
+}
+
+// ************ MatxUtil__ScaleFeatureMatrix**************//
+// Each thread writes one output of the row major matrix, finding the feature it belongs to by a binary search over the
+// first output of each feature. Threads of the first output also write the row's seq ids
+__global__ void scale_feature_matrix_kernel(const ScaledFeature* features,
+                                            TensorIndex num_features,
+                                            const float* params,
+                                            TensorIndex num_rows,
+                                            TensorIndex num_outputs,
+                                            float* output,
+                                            TensorIndex* seq_ids,
+                                            TensorIndex seq_id_offset)
+{
+    const auto num_values = static_cast<TensorSize>(num_rows) * num_outputs;
+
+    for (TensorSize idx = blockIdx.x * static_cast<TensorSize>(blockDim.x) + threadIdx.x; idx < num_values;
+         idx += static_cast<TensorSize>(blockDim.x) * gridDim.x)
+    {
+        auto row = static_cast<TensorIndex>(idx / num_outputs);
+        auto col = static_cast<TensorIndex>(idx % num_outputs);
+
+        if (col == 0)
+        {
+            seq_ids[row * 3]     = row + seq_id_offset;
+            seq_ids[row * 3 + 1] = 0;
+            seq_ids[row * 3 + 2] = num_outputs - 1;
+        }
+
+        TensorIndex first = 0;
+        TensorIndex last  = num_features - 1;
+        while (first < last)
+        {
+            auto middle = (first + last + 1) / 2;
+            if (features[middle].first_output <= col)
+            {
+                first = middle;
+            }
+            else
+            {
+                last = middle - 1;
+            }
+        }
+
+        const auto& feature = features[first];
+        const auto& column  = feature.column;
+
+        // Nulls are written as zero, the mean of a standardized feature
+        if (column.null_mask != nullptr && !cudf::bit_is_set(column.null_mask, column.offset + row))
+        {
+            output[idx] = 0.0f;
+            continue;
+        }
+
+        switch (feature.scaling)
+        {
+        case FeatureScaling::ONEHOT: {
+            auto position = static_cast<const int32_t*>(column.data)[column.offset + row];
+            output[idx]   = feature.slots[position] == col - feature.first_output ? 1.0f : 0.0f;
+            break;
+        }
+        case FeatureScaling::STANDARD:
+        case FeatureScaling::MINMAX:
+            output[idx] = (read_numeric_feature(column, row) - params[first * 2]) * params[first * 2 + 1];
+            break;
+        case FeatureScaling::NONE:
+            output[idx] = read_numeric_feature(column, row);
+            break;
+        }
+    }
+}
+// Selects the rows starting a range of true values of `mask`
+struct IsRangeStart
+{
+    const bool* mask;
+
+    __device__ bool operator()(TensorIndex row) const
+    {
+        return mask[row] && (row == 0 || !mask[row - 1]);
+    }
+};
+
+// Selects the rows one past the end of a range of true values of `mask`, out of the rows 1 to `num_rows`
+struct IsRangeEnd
+{
+    const bool* mask;
+    TensorIndex num_rows;
+
+    __device__ bool operator()(TensorIndex row) const
+    {
+        return mask[row - 1] && (row == num_rows || !mask[row]);
+    }
+};
+
+// Writes the rows `first_row` to `first_row + num_rows - 1` matching `predicate` to `selected`, in increasing order,
+// and their number to `num_selected`
+template <typename PredicateT>
+void select_rows(TensorIndex first_row,
+                 TensorIndex num_rows,
+                 PredicateT predicate,
+                 TensorIndex* selected,
+                 TensorIndex* num_selected,
+                 rmm::cuda_stream_view stream)
+{
+    cub::CountingInputIterator<TensorIndex> rows(first_row);
+
+    std::size_t temp_bytes = 0;
+    MRC_CHECK_CUDA(cub::DeviceSelect::If(
+        nullptr, temp_bytes, rows, selected, num_selected, num_rows, predicate, stream.value()));
+
+    rmm::device_buffer temp(temp_bytes, stream);
+    MRC_CHECK_CUDA(cub::DeviceSelect::If(
+        temp.data(), temp_bytes, rows, selected, num_selected, num_rows, predicate, stream.value()));
+}
+
+// ************ MatxUtil__GroupedDense**************//
+// Each thread computes one output of one row. Consecutive threads compute consecutive outputs of the same row, reading
+// consecutive weights of its slot thanks to the transposed layout, while the values of the row are broadcast
+__global__ void grouped_dense_kernel(const float* input,
+                                     TensorIndex num_rows,
+                                     TensorIndex input_size,
+                                     TensorIndex output_size,
+                                     const float* weights,
+                                     const float* biases,
+                                     const int32_t* slots,
+                                     DenseActivation activation,
+                                     float* output)
+{
+    const auto num_outputs = static_cast<TensorSize>(num_rows) * output_size;
+
+    for (TensorSize idx = blockIdx.x * static_cast<TensorSize>(blockDim.x) + threadIdx.x; idx < num_outputs;
+         idx += static_cast<TensorSize>(blockDim.x) * gridDim.x)
+    {
+        const auto row  = static_cast<TensorIndex>(idx / output_size);
+        const auto col  = static_cast<TensorIndex>(idx % output_size);
+        const auto slot = static_cast<TensorSize>(slots[row]);
+
+        const float* row_input    = input + static_cast<TensorSize>(row) * input_size;
+        const float* slot_weights = weights + slot * input_size * output_size + col;
+
+        float value = biases[slot * output_size + col];
+        for (TensorIndex i = 0; i < input_size; ++i)
+        {
+            value += row_input[i] * slot_weights[static_cast<TensorSize>(i) * output_size];
+        }
+
+        switch (activation)
+        {
+        case DenseActivation::RELU:
+            value = fmaxf(value, 0.0f);
+            break;
+        case DenseActivation::SIGMOID:
+            value = 1.0f / (1.0f + expf(-value));
+            break;
+        case DenseActivation::TANH:
+            value = tanhf(value);
+            break;
+        case DenseActivation::LEAKY_RELU:
+            value = value < 0.0f ? 0.01f * value : value;
+            break;
+        case DenseActivation::NONE:
+            break;
+        }
+
+        output[idx] = value;
+    }
+}
+
+// ************ MatxUtil__NormalizeRows**************//
+// Each warp normalizes one row, its lanes summing the squares of every 32nd value before reducing them with shuffles
+template <typename InputT, typename OutputT>
+__global__ void normalize_rows_kernel(const InputT* input,
+                                      OutputT* output,
+                                      TensorIndex num_rows,
+                                      TensorIndex num_columns,
+                                      TensorIndex row_stride,
+                                      TensorIndex col_stride,
+                                      bool normalize)
+{
+    constexpr int warp_size = 32;
+    const auto lane         = static_cast<TensorIndex>(threadIdx.x % warp_size);
+    const auto warps        = static_cast<TensorIndex>(blockDim.x / warp_size) * gridDim.x;
+
+    for (TensorIndex row = (blockIdx.x * static_cast<TensorIndex>(blockDim.x) + threadIdx.x) / warp_size;
+         row < num_rows;
+         row += warps)
+    {
+        const InputT* row_input = input + row * row_stride;
+        float scale             = 1.0f;
+
+        if (normalize)
+        {
+            float sum = 0.0f;
+            for (TensorIndex col = lane; col < num_columns; col += warp_size)
+            {
+                const auto value = static_cast<float>(row_input[col * col_stride]);
+                sum += value * value;
+            }
+
+            for (int offset = warp_size / 2; offset > 0; offset /= 2)
+            {
+                sum += __shfl_xor_sync(0xFFFFFFFF, sum, offset);
+            }
+
+            // Rows of zeros are left as is
+            scale = sum > 0.0f ? rsqrtf(sum) : 1.0f;
+        }
+
+        OutputT* row_output = output + row * num_columns;
+        for (TensorIndex col = lane; col < num_columns; col += warp_size)
+        {
+            row_output[col] = static_cast<OutputT>(static_cast<float>(row_input[col * col_stride]) * scale);
+        }
+    }
+}
+
+struct MatxUtil__NormalizeRows
+{
+    const DevMemInfo& input;
+    TypeId output_type;
+    bool normalize;
+    rmm::cuda_stream_view stream;
+
+    template <typename InputT, std::enable_if_t<!is_numeric_v<InputT>>* = nullptr>
+    void operator()(void* output)
+    {
+        throw std::invalid_argument("Unsupported input type for normalize_rows");
+    }
+
+    template <typename InputT, std::enable_if_t<is_numeric_v<InputT>>* = nullptr>
+    void operator()(void* output)
+    {
+        using DeviceT = typename MatxUtil__DeviceType<InputT>::type;
+
+        switch (output_type)
+        {
+        case TypeId::FLOAT16:
+            launch<DeviceT>(static_cast<__half*>(output));
+            break;
+        case TypeId::FLOAT32:
+            launch<DeviceT>(static_cast<float*>(output));
+            break;
+        case TypeId::FLOAT64:
+            launch<DeviceT>(static_cast<double*>(output));
+            break;
+        default:
+            throw std::invalid_argument("normalize_rows only outputs float16, float32 or float64");
+        }
+    }
+
+    template <typename InputT, typename OutputT>
+    void launch(OutputT* output)
+    {
+        constexpr int threads_per_block = 256;
+        constexpr int rows_per_block    = threads_per_block / 32;
+        const auto num_rows             = input.shape(0);
+        auto num_blocks                 = static_cast<int>(
+            std::min<TensorIndex>((num_rows + rows_per_block - 1) / rows_per_block, 65535));
+
+        normalize_rows_kernel<InputT, OutputT>
+            <<<num_blocks, threads_per_block, 0, stream.value()>>>(static_cast<const InputT*>(input.data()),
+                                                                   output,
+                                                                   num_rows,
+                                                                   input.shape(1),
+                                                                   input.stride(0),
+                                                                   input.stride(1),
+                                                                   normalize);
+    }
+};
+
+// ************ MatxUtil__LookupAddressRanges**************//
+// Compares two 128-bit addresses by their (low, high) words
+__device__ bool address_less(uint64_t low, uint64_t high, uint64_t other_low, uint64_t other_high)
+{
+    return high < other_high || (high == other_high && low < other_low);
+}
+
+// Each thread resolves one address, searching for the last range starting at or before it
+__global__ void lookup_address_ranges_kernel(const uint64_t* addresses,
+                                             bool ipv4,
+                                             const uint32_t* null_mask,
+                                             TensorIndex num_addresses,
+                                             const uint64_t* range_firsts,
+                                             const uint64_t* range_lasts,
+                                             const int32_t* range_rows,
+                                             TensorIndex num_ranges,
+                                             int32_t not_found,
+                                             int32_t* rows)
+{
+    for (TensorIndex idx = blockIdx.x * static_cast<TensorIndex>(blockDim.x) + threadIdx.x; idx < num_addresses;
+         idx += static_cast<TensorIndex>(blockDim.x) * gridDim.x)
+    {
+        if (null_mask != nullptr && !cudf::bit_is_set(null_mask, idx))
+        {
+            rows[idx] = not_found;
+            continue;
+        }
+
+        const uint64_t low  = ipv4 ? (0x0000FFFF00000000ull | (addresses[idx] & 0xFFFFFFFFull)) : addresses[idx * 2];
+        const uint64_t high = ipv4 ? 0 : addresses[idx * 2 + 1];
+
+        // Number of ranges starting at or before the address
+        TensorIndex first = 0;
+        TensorIndex count = num_ranges;
+        while (count > 0)
+        {
+            const auto step = count / 2;
+            const auto* range_first = range_firsts + (first + step) * 2;
+            if (!address_less(low, high, range_first[0], range_first[1]))
+            {
+                first += step + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+
+        // The ranges being disjoint, only that range may hold the address
+        const auto range = first - 1;
+        const bool found = range >= 0 && !address_less(range_lasts[range * 2], range_lasts[range * 2 + 1], low, high);
+        rows[idx]        = found ? range_rows[range] : not_found;
+    }
+}
+
+}  // namespace
+
+namespace morpheus {
+// Component public implementations
+// ************ MatxUtil************************* //
+std::shared_ptr<rmm::device_buffer> MatxUtil::cast(const DevMemInfo& input, TypeId output_type)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "cast", input.shape(0));
+
+    auto output_dtype = DType(output_type);
+
+    // Create the output
+    auto output = input.make_new_buffer(output_dtype.item_size() * input.count());
+
+    double_dispatch_type(input.dtype(),
+                         output_dtype,
+                         MatxUtil__MatxCast{boost::numeric_cast<TensorIndex>(input.count()), output->stream()},
+                         input.data(),
+                         output->data());
+
+    mrc::enqueue_stream_sync_event(output->stream()).get();
+
+    return output;
+}
+
+std::shared_ptr<rmm::device_buffer> MatxUtil::enqueue_cast(const DevMemInfo& input,
+                                                          TypeId output_type,
+                                                          rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "enqueue_cast", input.shape(0));
+
+    auto output_dtype = DType(output_type);
+
+    auto output = std::make_shared<rmm::device_buffer>(
+        output_dtype.item_size() * input.count(), stream, input.memory()->memory_resource);
+
+    double_dispatch_type(input.dtype(),
+                         output_dtype,
+                         MatxUtil__MatxCast{boost::numeric_cast<TensorIndex>(input.count()), stream},
+                         input.data(),
+                         output->data());
+
+    return output;
+}
+
+void MatxUtil::enqueue_cast_into(const DevMemInfo& input,
+                                 TypeId output_type,
+                                 void* output,
+                                 rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "enqueue_cast_into", input.shape(0));
+
+    if (input.shape().size() != 2)
+    {
+        throw std::invalid_argument("enqueue_cast_into only supports 2D inputs");
+    }
+
+    if (input.shape(0) == 0 || input.shape(1) == 0)
+    {
+        return;
+    }
+
+    double_dispatch_type(input.dtype(), DType(output_type), MatxUtil__CastInto{input, stream}, output);
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+std::shared_ptr<rmm::device_buffer> MatxUtil::create_seq_ids(TensorIndex row_count,
+                                                             TensorIndex fea_len,
+                                                             TypeId output_type,
+                                                             std::shared_ptr<MemoryDescriptor> md,
+                                                             TensorIndex start_idx)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "create_seq_ids", row_count);
+
+    auto output_dtype = DType(output_type);
+
+    // Now create the output
+    auto output = std::make_shared<rmm::device_buffer>(
+        output_dtype.item_size() * row_count * 3, md->cuda_stream, md->memory_resource);
+
+    dispatch_type(output_dtype,
+                  MatxUtil__MatxCreateSegIds{start_idx, row_count, fea_len, output->stream()},
+                  output->data());
+
+    return output;
+}
+
+void MatxUtil::offset_seq_ids(const DevMemInfo& input, TensorIndex offset)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "offset_seq_ids", input.shape(0));
+
+    dispatch_type(input.dtype(),
+                  MatxUtil__MatxOffsetSegIds{offset, input.shape(0), rmm::cuda_stream_per_thread},
+                  input.data());
+
+    mrc::enqueue_stream_sync_event(rmm::cuda_stream_per_thread).get();
+}
+
+void MatxUtil::enqueue_offset_seq_ids(const DevMemInfo& input, TensorIndex offset, rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "enqueue_offset_seq_ids", input.shape(0));
+
+    dispatch_type(input.dtype(), MatxUtil__MatxOffsetSegIds{offset, input.shape(0), stream}, input.data());
+}
+
+std::shared_ptr<rmm::device_buffer> MatxUtil::logits(const DevMemInfo& input,
+                                                     const std::shared_ptr<TensorBufferPool>& pool)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "logits", input.shape(0));
+
+    // Create the output
+    auto output = make_output_buffer(input, input.bytes(), pool);
+
+    dispatch_type(input.dtype(),
+                  MatxUtil__MatxLogits{boost::numeric_cast<TensorIndex>(input.count()), output->stream()},
+                  input.data(),
+                  output->data());
+
+    return output;
+}
+
+std::shared_ptr<rmm::device_buffer> MatxUtil::transpose(const DevMemInfo& input)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "transpose", input.shape(0));
+
+    // Now create the output
+    auto output = input.make_new_buffer(input.bytes());
+
+    dispatch_type(input.dtype(),
+                  MatxUtil__MatxTranspose{output->stream(), input.shape(0), input.shape(1)},
+                  input.data(),
+                  output->data());
+
+    return output;
+}
+
+std::shared_ptr<rmm::device_buffer> MatxUtil::threshold(const DevMemInfo& input,
+                                                        double thresh_val,
+                                                        bool by_row,
+                                                        const std::shared_ptr<TensorBufferPool>& pool)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "threshold", input.shape(0));
+
+    const auto rows        = input.shape(0);
+    const auto cols        = input.shape(1);
+    TensorSize output_size = sizeof(bool) * rows;
+    if (!by_row)
+    {
+        output_size *= cols;
+    }
+
+    // Now create the output array of bools
+    auto output = make_output_buffer(input, output_size, pool);
+
+    dispatch_type(input.dtype(),
+                  MatxUtil__MatxThreshold{rows, cols, by_row, output->stream()},
+                  input.data(),
+                  output->data(),
+                  thresh_val,
+                  input.stride());
+
+    mrc::enqueue_stream_sync_event(output->stream()).get();
+
+    return output;
+}
+
+std::shared_ptr<rmm::device_buffer> MatxUtil::reduce_max(const DevMemInfo& input,
+                                                         const ShapeType& seq_ids,
+                                                         TensorIndex seq_id_offset,
+                                                         const ShapeType& output_shape,
+                                                         const std::shared_ptr<TensorBufferPool>& pool)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "reduce_max", input.shape(0));
+
+    const auto& dtype   = input.dtype();
+    auto num_input_rows = input.shape(0);
+    auto num_input_cols = input.shape(1);
+
+    TensorSize output_element_count = output_shape[0] * output_shape[1];
+    TensorSize output_buff_size     = dtype.item_size() * output_element_count;
+
+    DCHECK(output_element_count <= input.count()) << "Output buffer size should be less than or equal to the input";
+    DCHECK(num_input_cols == output_shape[1]) << "Number of input and output columns must match";
+
+    auto output = make_output_buffer(input, output_buff_size, pool);
+
+    MatxUtil__MatxReduceMax matx_reduce_max{
+        num_input_rows, output_shape[0], num_input_cols, input.stride(), seq_ids, seq_id_offset, output->stream()};
+
+    dispatch_type(dtype, matx_reduce_max, input.data(), output->data());
+
+    mrc::enqueue_stream_sync_event(output->stream()).get();
+    return output;
+}
+
+PostInferenceOutput MatxUtil::reduce_logits_threshold(const DevMemInfo& input,
+                                                     const ShapeType& seq_ids,
+                                                     TensorIndex seq_id_offset,
+                                                     TensorIndex num_output_rows,
+                                                     bool apply_logits,
+                                                     std::optional<double> thresh_val,
+                                                     bool by_row,
+                                                     const std::shared_ptr<TensorBufferPool>& pool)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "reduce_logits_threshold", input.shape(0));
+
+    const auto num_input_rows = input.shape(0);
+
+    DCHECK(!seq_ids.empty() || num_output_rows == num_input_rows)
+        << "Number of output rows must match the input when the rows are not reduced";
+
+    auto output       = make_post_inference_output(input, num_output_rows, thresh_val, by_row, pool);
+    const auto stream = output.probs->stream();
+
+    if (output.probs->size() == 0)
+    {
+        return output;
+    }
+
+    // First input row of each output row, seq_ids are sorted so each output row is a contiguous range of input rows
+    std::optional<rmm::device_uvector<TensorIndex>> row_offsets_d;
+    if (!seq_ids.empty())
+    {
+        std::vector<TensorIndex> row_offsets(num_output_rows + 1, num_input_rows);
+        const auto output_offset = seq_ids[seq_id_offset];
+        for (auto i = num_input_rows - 1; i >= 0; --i)
+        {
+            auto output_row = seq_ids[i + seq_id_offset] - output_offset;
+            DCHECK(output_row >= 0 && output_row < num_output_rows);
+            row_offsets[output_row] = i;
+        }
+
+        row_offsets_d.emplace(row_offsets.size(), stream);
+        MRC_CHECK_CUDA(cudaMemcpyAsync(row_offsets_d->data(),
+                                       row_offsets.data(),
+                                       row_offsets.size() * sizeof(TensorIndex),
+                                       cudaMemcpyHostToDevice,
+                                       stream.value()));
+    }
+
+    launch_reduce_logits_threshold(input,
+                                   output,
+                                   row_offsets_d.has_value() ? row_offsets_d->data() : nullptr,
+                                   apply_logits,
+                                   thresh_val,
+                                   by_row,
+                                   stream);
+
+    mrc::enqueue_stream_sync_event(stream).get();
+
+    return output;
+}
+
+PostInferenceOutput MatxUtil::reduce_logits_threshold(const DevMemInfo& input,
+                                                     const DevMemInfo& seq_ids,
+                                                     TensorIndex num_output_rows,
+                                                     bool apply_logits,
+                                                     std::optional<double> thresh_val,
+                                                     bool by_row,
+                                                     const std::shared_ptr<TensorBufferPool>& pool)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "reduce_logits_threshold", input.shape(0));
+
+    DCHECK_EQ(seq_ids.shape(0), input.shape(0)) << "seq_ids must have one row per input row";
+
+    auto output       = make_post_inference_output(input, num_output_rows, thresh_val, by_row, pool);
+    const auto stream = output.probs->stream();
+
+    if (output.probs->size() == 0)
+    {
+        return output;
+    }
+
+    rmm::device_uvector<TensorIndex> row_offsets_d(num_output_rows + 1, stream);
+
+    enqueue_seq_id_offsets(seq_ids, num_output_rows, row_offsets_d.data(), stream);
+    launch_reduce_logits_threshold(input, output, row_offsets_d.data(), apply_logits, thresh_val, by_row, stream);
+
+    mrc::enqueue_stream_sync_event(stream).get();
+
+    return output;
+}
+
+PostInferenceOutput MatxUtil::allocate_post_inference_output(const DevMemInfo& input,
+                                                             TensorIndex num_output_rows,
+                                                             std::optional<double> thresh_val,
+                                                             bool by_row,
+                                                             const std::shared_ptr<TensorBufferPool>& pool)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "allocate_post_inference_output", num_output_rows);
+
+    return make_post_inference_output(input, num_output_rows, thresh_val, by_row, pool);
+}
+
+void MatxUtil::enqueue_seq_id_offsets(const DevMemInfo& seq_ids,
+                                      TensorIndex num_output_rows,
+                                      TensorIndex* row_offsets,
+                                      rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "enqueue_seq_id_offsets", seq_ids.shape(0));
+
+    const auto num_input_rows = seq_ids.shape(0);
+    if (num_input_rows == 0)
+    {
+        return;
+    }
+
+    // The segment offsets are found on the device, avoiding a copy of the seq_ids to the host. Only the first column
+    // of seq_ids, holding the output row, is read.
+    dispatch_type(seq_ids.dtype(),
+                  MatxUtil__SeqIdOffsets{seq_ids.stride(0), num_input_rows, num_output_rows, stream},
+                  seq_ids.data(),
+                  row_offsets);
+}
+
+void MatxUtil::enqueue_reduce_logits_threshold(const DevMemInfo& input,
+                                               const TensorIndex* row_offsets,
+                                               PostInferenceOutput& output,
+                                               bool apply_logits,
+                                               std::optional<double> thresh_val,
+                                               bool by_row,
+                                               rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "enqueue_reduce_logits_threshold", input.shape(0));
+
+    DCHECK(row_offsets != nullptr || output.shape[0] == input.shape(0))
+        << "Number of output rows must match the input when the rows are not reduced";
+
+    if (output.probs->size() == 0)
+    {
+        return;
+    }
+
+    launch_reduce_logits_threshold(input, output, row_offsets, apply_logits, thresh_val, by_row, stream);
+}
+
+std::shared_ptr<rmm::device_buffer> MatxUtil::gather_rows(const DevMemInfo& input,
+                                                          const std::vector<RangeType>& ranges,
+                                                          TensorIndex num_rows)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "gather_rows", num_rows);
+
+    const auto item_size   = input.dtype().item_size();
+    const auto num_columns = input.shape(1);
+
+    auto output = input.make_new_buffer(num_rows * num_columns * item_size);
+
+    // Output row of each range followed by the input row of each range, uploaded in a single copy
+    const auto range_offsets = make_range_offsets(ranges, num_rows);
+
+    const auto num_ranges   = static_cast<TensorIndex>(range_offsets.size() / 2);
+    const auto num_elements = static_cast<TensorSize>(num_rows) * num_columns;
+
+    if (num_ranges == 0 || num_elements == 0)
+    {
+        return output;
+    }
+
+    rmm::device_uvector<TensorIndex> range_offsets_d(range_offsets.size(), output->stream());
+    MRC_CHECK_CUDA(cudaMemcpyAsync(range_offsets_d.data(),
+                                   range_offsets.data(),
+                                   range_offsets.size() * sizeof(TensorIndex),
+                                   cudaMemcpyHostToDevice,
+                                   output->stream().value()));
+
+    // Elements are copied as raw bytes, only their size matters
+    switch (item_size)
+    {
+    case 1:
+        launch_gather_rows<uint8_t>(
+            input, output->data(), range_offsets_d.data(), num_ranges, num_elements, output->stream());
+        break;
+    case 2:
+        launch_gather_rows<uint16_t>(
+            input, output->data(), range_offsets_d.data(), num_ranges, num_elements, output->stream());
+        break;
+    case 4:
+        launch_gather_rows<uint32_t>(
+            input, output->data(), range_offsets_d.data(), num_ranges, num_elements, output->stream());
+        break;
+    case 8:
+        launch_gather_rows<uint64_t>(
+            input, output->data(), range_offsets_d.data(), num_ranges, num_elements, output->stream());
+        break;
+    default:
+        throw std::invalid_argument("Unsupported item size for gather_rows");
+    }
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+
+    mrc::enqueue_stream_sync_event(output->stream()).get();
+
+    return output;
+}
+
+std::vector<std::shared_ptr<rmm::device_buffer>> MatxUtil::gather_rows(const std::vector<DevMemInfo>& inputs,
+                                                                       const std::vector<RangeType>& ranges,
+                                                                       TensorIndex num_rows)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "gather_rows", num_rows);
+
+    if (inputs.size() > 65535)
+    {
+        throw std::invalid_argument("gather_rows supports at most 65535 tensors per call");
+    }
+
+    std::vector<std::shared_ptr<rmm::device_buffer>> outputs;
+    std::vector<GatherTensorRows> tensors;
+    outputs.reserve(inputs.size());
+    tensors.reserve(inputs.size());
+
+    TensorIndex max_columns = 0;
+    for (const auto& input : inputs)
+    {
+        const auto item_size = input.dtype().item_size();
+        if (item_size != 1 && item_size != 2 && item_size != 4 && item_size != 8)
+        {
+            throw std::invalid_argument("Unsupported item size for gather_rows");
+        }
+
+        const auto num_columns = input.shape(1);
+        auto& output           = outputs.emplace_back(input.make_new_buffer(num_rows * num_columns * item_size));
+
+        tensors.push_back(
+            GatherTensorRows{input.data(), output->data(), num_columns, input.stride(0), input.stride(1), item_size});
+        max_columns = std::max(max_columns, num_columns);
+    }
+
+    const auto range_offsets = make_range_offsets(ranges, num_rows);
+    const auto num_ranges    = static_cast<TensorIndex>(range_offsets.size() / 2);
+
+    if (outputs.empty() || num_ranges == 0 || max_columns == 0)
+    {
+        return outputs;
+    }
+
+    // The kernel runs on the stream of the first output, the outputs allocated on other streams must be ready first
+    const auto stream = outputs.front()->stream();
+    for (const auto& output : outputs)
+    {
+        if (output->stream() != stream)
+        {
+            output->stream().synchronize();
+        }
+    }
+
+    rmm::device_uvector<TensorIndex> range_offsets_d(range_offsets.size(), stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(range_offsets_d.data(),
+                                   range_offsets.data(),
+                                   range_offsets.size() * sizeof(TensorIndex),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    rmm::device_uvector<GatherTensorRows> tensors_d(tensors.size(), stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(tensors_d.data(),
+                                   tensors.data(),
+                                   tensors.size() * sizeof(GatherTensorRows),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    constexpr unsigned int threads_per_block = 256;
+    // Cap the blocks per tensor, remaining elements are covered by the grid-stride loop
+    const auto max_elements      = static_cast<TensorSize>(num_rows) * max_columns;
+    const auto blocks_per_tensor = static_cast<unsigned int>(
+        std::min<TensorSize>((max_elements + threads_per_block - 1) / threads_per_block, 1024));
+
+    dim3 grid(blocks_per_tensor, static_cast<unsigned int>(tensors.size()));
+    gather_tensor_rows_kernel<<<grid, threads_per_block, 0, stream.value()>>>(
+        tensors_d.data(), range_offsets_d.data(), num_ranges, num_rows);
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+
+    mrc::enqueue_stream_sync_event(stream).get();
+
+    return outputs;
+}
+
+void MatxUtil::copy_strided_columns(const std::vector<StridedColumnCopy>& copies, rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "copy_strided_columns", (copies.empty() ? 0 : copies.front().num_rows));
+
+    TensorIndex max_rows = 0;
+    for (const auto& copy : copies)
+    {
+        if (copy.item_size != 1 && copy.item_size != 2 && copy.item_size != 4 && copy.item_size != 8)
+        {
+            throw std::invalid_argument("Unsupported item size for copy_strided_columns");
+        }
+
+        if ((copy.source_type == TypeId::FLOAT16 || copy.source_type == TypeId::BFLOAT16) &&
+            copy.item_size != sizeof(float))
+        {
+            throw std::invalid_argument("Half precision columns can only be widened to float32");
+        }
+
+        max_rows = std::max(max_rows, copy.num_rows);
+    }
+
+    if (copies.size() > 65535)
+    {
+        throw std::invalid_argument("copy_strided_columns supports at most 65535 columns per call");
+    }
+
+    if (copies.empty() || max_rows == 0)
+    {
+        return;
+    }
+
+    rmm::device_uvector<StridedColumnCopy> copies_d(copies.size(), stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(copies_d.data(),
+                                   copies.data(),
+                                   copies.size() * sizeof(StridedColumnCopy),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    constexpr unsigned int threads_per_block = 256;
+    // Cap the blocks per column, remaining rows are covered by the grid-stride loop
+    const auto blocks_per_column =
+        static_cast<unsigned int>(std::min<TensorIndex>((max_rows + threads_per_block - 1) / threads_per_block, 1024));
+
+    dim3 grid(blocks_per_column, static_cast<unsigned int>(copies.size()));
+    copy_strided_columns_kernel<<<grid, threads_per_block, 0, stream.value()>>>(copies_d.data());
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+void MatxUtil::hash_rows(const DevMemInfo& input, uint64_t* hashes, rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "hash_rows", input.shape(0));
+
+    if (input.shape(0) == 0)
+    {
+        return;
+    }
+
+    switch (input.dtype().item_size())
+    {
+    case 1:
+        launch_hash_rows<uint8_t>(input, hashes, stream);
+        break;
+    case 2:
+        launch_hash_rows<uint16_t>(input, hashes, stream);
+        break;
+    case 4:
+        launch_hash_rows<uint32_t>(input, hashes, stream);
+        break;
+    case 8:
+        launch_hash_rows<uint64_t>(input, hashes, stream);
+        break;
+    default:
+        throw std::invalid_argument("Unsupported item size for hash_rows");
+    }
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+void MatxUtil::copy_rows(const void* input,
+                         void* output,
+                         std::size_t row_bytes,
+                         const std::vector<TensorIndex>& input_rows,
+                         const std::vector<TensorIndex>& output_rows,
+                         rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "copy_rows", input_rows.size());
+
+    if (input_rows.size() != output_rows.size())
+    {
+        throw std::invalid_argument("copy_rows requires the same number of input and output rows");
+    }
+
+    const auto num_rows = static_cast<TensorIndex>(input_rows.size());
+    if (num_rows == 0 || row_bytes == 0)
+    {
+        return;
+    }
+
+    // Input rows followed by output rows, uploaded in a single copy
+    std::vector<TensorIndex> row_indices;
+    row_indices.reserve(input_rows.size() * 2);
+    row_indices.insert(row_indices.end(), input_rows.begin(), input_rows.end());
+    row_indices.insert(row_indices.end(), output_rows.begin(), output_rows.end());
+
+    rmm::device_uvector<TensorIndex> row_indices_d(row_indices.size(), stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(row_indices_d.data(),
+                                   row_indices.data(),
+                                   row_indices.size() * sizeof(TensorIndex),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    // Copy the widest words allowed by the alignment of both buffers and the length of the rows
+    const auto alignment = reinterpret_cast<std::uintptr_t>(input) | reinterpret_cast<std::uintptr_t>(output) |
+                           static_cast<std::uintptr_t>(row_bytes);
+
+    if (alignment % sizeof(uint64_t) == 0)
+    {
+        launch_copy_rows<uint64_t>(input, output, row_bytes, row_indices_d.data(), num_rows, stream);
+    }
+    else if (alignment % sizeof(uint32_t) == 0)
+    {
+        launch_copy_rows<uint32_t>(input, output, row_bytes, row_indices_d.data(), num_rows, stream);
+    }
+    else
+    {
+        launch_copy_rows<uint8_t>(input, output, row_bytes, row_indices_d.data(), num_rows, stream);
+    }
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+TensorIndex MatxUtil::max_row_length(const DevMemInfo& input, rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "max_row_length", input.shape(0));
+
+    if (input.shape(0) == 0 || input.shape(1) == 0)
+    {
+        return 0;
+    }
+
+    rmm::device_uvector<TensorIndex> max_length_d(1, stream);
+    MRC_CHECK_CUDA(cudaMemsetAsync(max_length_d.data(), 0, sizeof(TensorIndex), stream.value()));
+
+    switch (input.dtype().item_size())
+    {
+    case 1:
+        launch_max_row_length<uint8_t>(input, max_length_d.data(), stream);
+        break;
+    case 2:
+        launch_max_row_length<uint16_t>(input, max_length_d.data(), stream);
+        break;
+    case 4:
+        launch_max_row_length<uint32_t>(input, max_length_d.data(), stream);
+        break;
+    case 8:
+        launch_max_row_length<uint64_t>(input, max_length_d.data(), stream);
+        break;
+    default:
+        throw std::invalid_argument("Unsupported item size for max_row_length");
+    }
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+
+    TensorIndex max_length = 0;
+    MRC_CHECK_CUDA(
+        cudaMemcpyAsync(&max_length, max_length_d.data(), sizeof(TensorIndex), cudaMemcpyDeviceToHost, stream.value()));
+    mrc::enqueue_stream_sync_event(stream).get();
+
+    return max_length;
+}
+void MatxUtil::enqueue_row_lengths(const DevMemInfo& input, TensorIndex* lengths, rmm::cuda_stream_view stream)
+{
+    if (input.shape(0) == 0)
+    {
+        return;
+    }
+
+    switch (input.dtype().item_size())
+    {
+    case 1:
+        launch_row_lengths<uint8_t>(input, lengths, stream);
+        break;
+    case 2:
+        launch_row_lengths<uint16_t>(input, lengths, stream);
+        break;
+    case 4:
+        launch_row_lengths<uint32_t>(input, lengths, stream);
+        break;
+    case 8:
+        launch_row_lengths<uint64_t>(input, lengths, stream);
+        break;
+    default:
+        throw std::invalid_argument("Unsupported item size for row_lengths");
+    }
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+void MatxUtil::pack_ragged_rows(const DevMemInfo& padded,
+                                const TensorIndex* offsets,
+                                TensorIndex token_width,
+                                void* packed,
+                                rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "pack_ragged_rows", padded.shape(0));
+
+    launch_copy_ragged_rows(padded, packed, offsets, token_width, false, stream);
+}
+
+void MatxUtil::unpack_ragged_rows(const void* packed,
+                                  const TensorIndex* offsets,
+                                  TensorIndex token_width,
+                                  const DevMemInfo& padded,
+                                  rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "unpack_ragged_rows", padded.shape(0));
+
+    // The packed values are only read when unpacking
+    launch_copy_ragged_rows(padded, const_cast<void*>(packed), offsets, token_width, true, stream);
+}
+
+void MatxUtil::pack_token_rows(const int32_t* tokens,
+                               const std::vector<TensorIndex>& row_starts,
+                               const std::vector<TensorIndex>& row_lengths,
+                               TensorIndex sequence_length,
+                               uint32_t* token_ids,
+                               uint32_t* attention_mask,
+                               rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "pack_token_rows", row_starts.size());
+
+    if (row_starts.size() != row_lengths.size())
+    {
+        throw std::invalid_argument("pack_token_rows requires a length for the start of each row");
+    }
+
+    const auto num_rows = static_cast<TensorIndex>(row_starts.size());
+    if (num_rows == 0 || sequence_length == 0)
+    {
+        return;
+    }
+
+    // Row starts followed by row lengths, uploaded in a single copy
+    std::vector<TensorIndex> row_indices;
+    row_indices.reserve(row_starts.size() * 2);
+    row_indices.insert(row_indices.end(), row_starts.begin(), row_starts.end());
+    row_indices.insert(row_indices.end(), row_lengths.begin(), row_lengths.end());
+
+    rmm::device_uvector<TensorIndex> row_indices_d(row_indices.size(), stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(row_indices_d.data(),
+                                   row_indices.data(),
+                                   row_indices.size() * sizeof(TensorIndex),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    constexpr int threads_per_block = 256;
+    const auto num_tokens           = static_cast<TensorSize>(num_rows) * sequence_length;
+    auto num_blocks = static_cast<int>(std::min<TensorSize>((num_tokens + threads_per_block - 1) / threads_per_block,
+                                                            std::numeric_limits<int>::max()));
+
+    pack_token_rows_kernel<<<num_blocks, threads_per_block, 0, stream.value()>>>(
+        tokens, row_indices_d.data(), num_rows, sequence_length, token_ids, attention_mask);
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+void MatxUtil::pack_feature_matrix(const std::vector<FeatureColumn>& columns,
+                                   TensorIndex num_rows,
+                                   float fill_value,
+                                   float* features,
+                                   TensorIndex* seq_ids,
+                                   TensorIndex seq_id_offset,
+                                   rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "pack_feature_matrix", num_rows);
+
+    for (const auto& column : columns)
+    {
+        if (!is_numeric_feature(column.type))
+        {
+            throw std::invalid_argument("Unsupported column type for pack_feature_matrix");
+        }
+    }
+
+    if (columns.empty() || num_rows == 0)
+    {
+        return;
+    }
+
+    rmm::device_uvector<FeatureColumn> columns_d(columns.size(), stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(columns_d.data(),
+                                   columns.data(),
+                                   columns.size() * sizeof(FeatureColumn),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    constexpr int threads_per_block = 256;
+    const auto num_columns          = static_cast<TensorIndex>(columns.size());
+    const auto num_features         = static_cast<TensorSize>(num_rows) * num_columns;
+    auto num_blocks = static_cast<int>(std::min<TensorSize>((num_features + threads_per_block - 1) / threads_per_block,
+                                                            std::numeric_limits<int>::max()));
+
+    pack_feature_matrix_kernel<<<num_blocks, threads_per_block, 0, stream.value()>>>(
+        columns_d.data(), num_columns, num_rows, fill_value, features, seq_ids, seq_id_offset);
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+void MatxUtil::scale_feature_matrix(const std::vector<ScaledFeature>& features,
+                                    const float* params,
+                                    TensorIndex num_rows,
+                                    TensorIndex num_outputs,
+                                    float* output,
+                                    TensorIndex* seq_ids,
+                                    TensorIndex seq_id_offset,
+                                    rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "scale_feature_matrix", num_rows);
+
+    TensorIndex next_output = 0;
+    for (const auto& feature : features)
+    {
+        if (feature.first_output != next_output || feature.num_outputs < 1)
+        {
+            throw std::invalid_argument("The features of scale_feature_matrix must cover each output once, in order");
+        }
+
+        if (feature.scaling == FeatureScaling::ONEHOT ? feature.column.type != TypeId::INT32 || feature.slots == nullptr
+                                                      : !is_numeric_feature(feature.column.type))
+        {
+            throw std::invalid_argument("Unsupported column type for scale_feature_matrix");
+        }
+
+        next_output += feature.num_outputs;
+    }
+
+    if (next_output != num_outputs)
+    {
+        throw std::invalid_argument("The features of scale_feature_matrix must cover each output once, in order");
+    }
+
+    if (features.empty() || num_rows == 0)
+    {
+        return;
+    }
+
+    rmm::device_uvector<ScaledFeature> features_d(features.size(), stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(features_d.data(),
+                                   features.data(),
+                                   features.size() * sizeof(ScaledFeature),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    constexpr int threads_per_block = 256;
+    const auto num_values           = static_cast<TensorSize>(num_rows) * num_outputs;
+    auto num_blocks = static_cast<int>(std::min<TensorSize>((num_values + threads_per_block - 1) / threads_per_block,
+                                                            std::numeric_limits<int>::max()));
+
+    scale_feature_matrix_kernel<<<num_blocks, threads_per_block, 0, stream.value()>>>(
+        features_d.data(),
+        static_cast<TensorIndex>(features.size()),
+        params,
+        num_rows,
+        num_outputs,
+        output,
+        seq_ids,
+        seq_id_offset);
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+void MatxUtil::grouped_dense(const float* input,
+                             TensorIndex num_rows,
+                             TensorIndex input_size,
+                             TensorIndex output_size,
+                             const float* weights,
+                             const float* biases,
+                             const int32_t* slots,
+                             DenseActivation activation,
+                             float* output,
+                             rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "grouped_dense", num_rows);
+
+    if (num_rows == 0 || output_size == 0)
+    {
+        return;
+    }
+
+    constexpr int threads_per_block = 256;
+    const auto num_outputs          = static_cast<TensorSize>(num_rows) * output_size;
+    auto num_blocks = static_cast<int>(std::min<TensorSize>((num_outputs + threads_per_block - 1) / threads_per_block,
+                                                            std::numeric_limits<int>::max()));
+
+    grouped_dense_kernel<<<num_blocks, threads_per_block, 0, stream.value()>>>(
+        input, num_rows, input_size, output_size, weights, biases, slots, activation, output);
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+std::shared_ptr<rmm::device_buffer> MatxUtil::normalize_rows(const DevMemInfo& input,
+                                                             TypeId output_type,
+                                                             bool normalize,
+                                                             rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "normalize_rows", input.shape(0));
+
+    auto output = std::make_shared<rmm::device_buffer>(
+        DType(output_type).item_size() * input.shape(0) * input.shape(1), stream, input.memory()->memory_resource);
+
+    if (input.shape(0) == 0 || input.shape(1) == 0)
+    {
+        return output;
+    }
+
+    dispatch_type(input.dtype(), MatxUtil__NormalizeRows{input, output_type, normalize, stream}, output->data());
+
+    MRC_CHECK_CUDA(cudaGetLastError());
 
-    mrc::enqueue_stream_sync_event(output->stream()).get();
     return output;
 }
+
+std::vector<RangeType> MatxUtil::selected_ranges(const bool* mask, TensorIndex num_rows, rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "selected_ranges", num_rows);
+
+    if (num_rows == 0)
+    {
+        return {};
+    }
+
+    // Ranges are separated by at least one row, so at most every other row starts one
+    const TensorIndex max_ranges = (num_rows + 1) / 2;
+
+    rmm::device_uvector<TensorIndex> starts(max_ranges, stream);
+    rmm::device_uvector<TensorIndex> ends(max_ranges, stream);
+    rmm::device_uvector<TensorIndex> num_selected(2, stream);
+
+    select_rows(0, num_rows, IsRangeStart{mask}, starts.data(), num_selected.data(), stream);
+    select_rows(1, num_rows, IsRangeEnd{mask, num_rows}, ends.data(), num_selected.data() + 1, stream);
+
+    // Every range has both a start and an end
+    TensorIndex num_ranges = 0;
+    MRC_CHECK_CUDA(
+        cudaMemcpyAsync(&num_ranges, num_selected.data(), sizeof(TensorIndex), cudaMemcpyDeviceToHost, stream.value()));
+    stream.synchronize();
+
+    std::vector<TensorIndex> host_starts(num_ranges);
+    std::vector<TensorIndex> host_ends(num_ranges);
+    if (num_ranges > 0)
+    {
+        MRC_CHECK_CUDA(cudaMemcpyAsync(host_starts.data(),
+                                       starts.data(),
+                                       num_ranges * sizeof(TensorIndex),
+                                       cudaMemcpyDeviceToHost,
+                                       stream.value()));
+        MRC_CHECK_CUDA(cudaMemcpyAsync(
+            host_ends.data(), ends.data(), num_ranges * sizeof(TensorIndex), cudaMemcpyDeviceToHost, stream.value()));
+        stream.synchronize();
+    }
+
+    std::vector<RangeType> ranges;
+    ranges.reserve(num_ranges);
+    for (TensorIndex i = 0; i < num_ranges; ++i)
+    {
+        ranges.emplace_back(host_starts[i], host_ends[i]);
+    }
+
+    return ranges;
+}
+
+void MatxUtil::top_k(const DevMemInfo& input,
+                     const std::vector<TensorIndex>& columns,
+                     TensorIndex k,
+                     std::optional<double> thresh_val,
+                     int32_t* ids,
+                     float* scores,
+                     rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "top_k", input.shape(0));
+
+    if (k <= 0 || k > MaxTopK || k > static_cast<TensorIndex>(columns.size()))
+    {
+        throw std::invalid_argument("top_k requires a positive k of at most MaxTopK and at most the number of columns");
+    }
+
+    if (input.shape(0) == 0)
+    {
+        return;
+    }
+
+    rmm::device_uvector<TensorIndex> columns_d(columns.size(), stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(columns_d.data(),
+                                   columns.data(),
+                                   columns.size() * sizeof(TensorIndex),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    const auto num_columns = static_cast<TensorIndex>(columns.size());
+    dispatch_type(
+        input.dtype(), MatxUtil__TopK{input, columns_d.data(), num_columns, k, thresh_val, stream}, ids, scores);
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+void MatxUtil::pack_labels(const DevMemInfo& input,
+                           const std::vector<TensorIndex>& columns,
+                           double thresh_val,
+                           uint64_t* output,
+                           rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "pack_labels", input.shape(0));
+
+    if (columns.size() > static_cast<std::size_t>(MaxPackedLabels))
+    {
+        throw std::invalid_argument("pack_labels requires at most MaxPackedLabels columns");
+    }
+
+    if (input.shape(0) == 0)
+    {
+        return;
+    }
+
+    rmm::device_uvector<TensorIndex> columns_d(columns.size(), stream);
+    MRC_CHECK_CUDA(cudaMemcpyAsync(columns_d.data(),
+                                   columns.data(),
+                                   columns.size() * sizeof(TensorIndex),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    const auto num_columns = static_cast<TensorIndex>(columns.size());
+    dispatch_type(
+        input.dtype(), MatxUtil__PackLabels{input, columns_d.data(), num_columns, thresh_val, stream}, output);
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
+
+void MatxUtil::lookup_address_ranges(const uint64_t* addresses,
+                                     bool ipv4,
+                                     const uint32_t* null_mask,
+                                     TensorIndex num_addresses,
+                                     const uint64_t* range_firsts,
+                                     const uint64_t* range_lasts,
+                                     const int32_t* range_rows,
+                                     TensorIndex num_ranges,
+                                     int32_t not_found,
+                                     int32_t* rows,
+                                     rmm::cuda_stream_view stream)
+{
+    MORPHEUS_NVTX_RANGE(NvtxDomain, "lookup_address_ranges", num_addresses);
+
+    if (num_addresses == 0)
+    {
+        return;
+    }
+
+    constexpr int threads_per_block = 256;
+    auto num_blocks                 = static_cast<int>(
+        std::min<TensorIndex>((num_addresses + threads_per_block - 1) / threads_per_block, 65535));
+
+    lookup_address_ranges_kernel<<<num_blocks, threads_per_block, 0, stream.value()>>>(addresses,
+                                                                                      ipv4,
+                                                                                      null_mask,
+                                                                                      num_addresses,
+                                                                                      range_firsts,
+                                                                                      range_lasts,
+                                                                                      range_rows,
+                                                                                      num_ranges,
+                                                                                      not_found,
+                                                                                      rows);
+
+    MRC_CHECK_CUDA(cudaGetLastError());
+}
 }  // namespace morpheus
@@ -0,0 +1,420 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/utilities/metrics.hpp"
+
+#include "morpheus/utilities/string_util.hpp"
+
+#include <algorithm>  // for adjacent_find, lower_bound
+#include <array>
+#include <charconv>    // for to_chars
+#include <functional>  // for greater_equal
+#include <sstream>
+#include <stdexcept>  // for invalid_argument
+#include <type_traits>
+#include <utility>
+
+namespace morpheus {
+
+namespace {
+std::string escape_label_value(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+
+    for (auto c : value)
+    {
+        switch (c)
+        {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+void write_value(std::ostream& out_stream, double value)
+{
+    // Shortest representation which round trips, avoids large counters being written in scientific notation
+    std::array<char, 32> buffer{};
+    auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+
+    out_stream.write(buffer.data(), result.ptr - buffer.data());
+}
+
+// Writes `name`, followed by `labels` and the optional `le` label of a histogram bucket
+void write_series(std::ostream& out_stream,
+                  const std::string& name,
+                  const metric_labels_t& labels,
+                  const std::string& le = {})
+{
+    out_stream << name;
+
+    if (labels.empty() && le.empty())
+    {
+        return;
+    }
+
+    out_stream << "{";
+
+    bool first = true;
+    for (const auto& [key, value] : labels)
+    {
+        out_stream << (first ? "" : ",") << key << "=\"" << escape_label_value(value) << "\"";
+        first = false;
+    }
+
+    if (!le.empty())
+    {
+        out_stream << (first ? "" : ",") << "le=\"" << le << "\"";
+    }
+
+    out_stream << "}";
+}
+}  // namespace
+
+std::size_t metric_shard()
+{
+    static std::atomic<std::size_t> next_shard{0};
+    thread_local const std::size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % MetricShards;
+
+    return shard;
+}
+
+// ************ Counter ****************************//
+void Counter::increment(double value)
+{
+    m_shards[metric_shard()].value.fetch_add(value, std::memory_order_relaxed);
+}
+
+double Counter::value() const
+{
+    double value = 0.0;
+    for (const auto& shard : m_shards)
+    {
+        value += shard.value.load(std::memory_order_relaxed);
+    }
+
+    return value;
+}
+
+// ************ Gauge ****************************//
+void Gauge::set(double value)
+{
+    m_value.store(value, std::memory_order_relaxed);
+}
+
+void Gauge::increment(double value)
+{
+    m_value.fetch_add(value, std::memory_order_relaxed);
+}
+
+void Gauge::decrement(double value)
+{
+    m_value.fetch_sub(value, std::memory_order_relaxed);
+}
+
+double Gauge::value() const
+{
+    return m_value.load(std::memory_order_relaxed);
+}
+
+// ************ Histogram ****************************//
+Histogram::Histogram(std::vector<double> upper_bounds) :
+  m_upper_bounds(std::move(upper_bounds)),
+  m_lines_per_shard((m_upper_bounds.size() + BucketLine::Size) / BucketLine::Size),
+  m_bucket_lines(std::make_unique<BucketLine[]>(m_lines_per_shard * MetricShards))
+{
+    if (std::adjacent_find(m_upper_bounds.begin(), m_upper_bounds.end(), std::greater_equal<>()) !=
+        m_upper_bounds.end())
+    {
+        throw std::invalid_argument("Histogram bucket upper bounds must be increasing");
+    }
+}
+
+std::vector<double> Histogram::exponential_buckets(double start, double factor, std::size_t count)
+{
+    std::vector<double> upper_bounds;
+    upper_bounds.reserve(count);
+
+    for (double bound = start; upper_bounds.size() < count; bound *= factor)
+    {
+        upper_bounds.push_back(bound);
+    }
+
+    return upper_bounds;
+}
+
+std::vector<double> Histogram::duration_buckets()
+{
+    return exponential_buckets(1e-5, 2.0, 24);
+}
+
+void Histogram::observe(double value)
+{
+    // Bounds are inclusive, a value equal to a bound is counted by that bucket
+    auto bucket = std::lower_bound(m_upper_bounds.begin(), m_upper_bounds.end(), value) - m_upper_bounds.begin();
+
+    const auto shard = metric_shard();
+
+    bucket_count(shard, bucket).fetch_add(1, std::memory_order_relaxed);
+    m_shards[shard].sum.fetch_add(value, std::memory_order_relaxed);
+    m_shards[shard].count.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::atomic<uint64_t>& Histogram::bucket_count(std::size_t shard, std::size_t bucket) const
+{
+    auto& line = m_bucket_lines[shard * m_lines_per_shard + bucket / BucketLine::Size];
+
+    return line.counts[bucket % BucketLine::Size];
+}
+
+const std::vector<double>& Histogram::upper_bounds() const
+{
+    return m_upper_bounds;
+}
+
+std::vector<uint64_t> Histogram::bucket_counts() const
+{
+    std::vector<uint64_t> counts(m_upper_bounds.size() + 1);
+
+    for (std::size_t shard = 0; shard < MetricShards; ++shard)
+    {
+        for (std::size_t i = 0; i < counts.size(); ++i)
+        {
+            counts[i] += bucket_count(shard, i).load(std::memory_order_relaxed);
+        }
+    }
+
+    return counts;
+}
+
+double Histogram::sum() const
+{
+    double sum = 0.0;
+    for (const auto& shard : m_shards)
+    {
+        sum += shard.sum.load(std::memory_order_relaxed);
+    }
+
+    return sum;
+}
+
+uint64_t Histogram::count() const
+{
+    uint64_t count = 0;
+    for (const auto& shard : m_shards)
+    {
+        count += shard.count.load(std::memory_order_relaxed);
+    }
+
+    return count;
+}
+
+// ************ MetricsRegistry ****************************//
+MetricsRegistry& MetricsRegistry::get_instance()
+{
+    static MetricsRegistry instance;
+
+    return instance;
+}
+
+MetricsRegistry::MetricFamily& MetricsRegistry::get_family(const std::string& name,
+                                                           const std::string& help,
+                                                           MetricType type)
+{
+    auto [found, inserted] = m_families.try_emplace(name, MetricFamily{type, help, {}});
+
+    if (!inserted && found->second.type != type)
+    {
+        throw std::invalid_argument(
+            MORPHEUS_CONCAT_STR("Metric '" << name << "' has already been registered with a different type"));
+    }
+
+    return found->second;
+}
+
+std::shared_ptr<Counter> MetricsRegistry::get_counter(const std::string& name,
+                                                      const std::string& help,
+                                                      const metric_labels_t& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& family = this->get_family(name, help, MetricType::Counter);
+    auto found   = family.series.find(labels);
+
+    if (found == family.series.end())
+    {
+        found = family.series.emplace(labels, std::make_shared<Counter>()).first;
+    }
+
+    return std::get<std::shared_ptr<Counter>>(found->second);
+}
+
+std::shared_ptr<Gauge> MetricsRegistry::get_gauge(const std::string& name,
+                                                  const std::string& help,
+                                                  const metric_labels_t& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& family = this->get_family(name, help, MetricType::Gauge);
+    auto found   = family.series.find(labels);
+
+    if (found == family.series.end())
+    {
+        found = family.series.emplace(labels, std::make_shared<Gauge>()).first;
+    }
+
+    return std::get<std::shared_ptr<Gauge>>(found->second);
+}
+
+std::shared_ptr<Histogram> MetricsRegistry::get_histogram(const std::string& name,
+                                                          const std::string& help,
+                                                          const metric_labels_t& labels,
+                                                          const std::vector<double>& upper_bounds)
+{
+    if (labels.contains("le"))
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Histogram '" << name << "' cannot have an `le` label"));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& family = this->get_family(name, help, MetricType::Histogram);
+    auto found   = family.series.find(labels);
+
+    if (found == family.series.end())
+    {
+        found = family.series.emplace(labels, std::make_shared<Histogram>(upper_bounds)).first;
+    }
+
+    return std::get<std::shared_ptr<Histogram>>(found->second);
+}
+
+void MetricsRegistry::remove(const std::string& name, const metric_labels_t& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto found = m_families.find(name);
+
+    if (found != m_families.end())
+    {
+        found->second.series.erase(labels);
+
+        if (found->second.series.empty())
+        {
+            m_families.erase(found);
+        }
+    }
+}
+
+void MetricsRegistry::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_families.clear();
+}
+
+std::string MetricsRegistry::serialize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::ostringstream out_stream;
+
+    for (const auto& [name, family] : m_families)
+    {
+        const char* type = "histogram";
+        if (family.type == MetricType::Counter)
+        {
+            type = "counter";
+        }
+        else if (family.type == MetricType::Gauge)
+        {
+            type = "gauge";
+        }
+
+        out_stream << "# HELP " << name << " " << family.help << "\n";
+        out_stream << "# TYPE " << name << " " << type << "\n";
+
+        for (const auto& [labels, metric] : family.series)
+        {
+            if (const auto* histogram = std::get_if<std::shared_ptr<Histogram>>(&metric))
+            {
+                // Prometheus buckets are cumulative, each counting every value up to its bound
+                const auto& upper_bounds = (*histogram)->upper_bounds();
+                const auto counts        = (*histogram)->bucket_counts();
+
+                uint64_t cumulative = 0;
+                for (std::size_t i = 0; i < counts.size(); ++i)
+                {
+                    cumulative += counts[i];
+
+                    std::ostringstream le;
+                    if (i < upper_bounds.size())
+                    {
+                        write_value(le, upper_bounds[i]);
+                    }
+                    else
+                    {
+                        le << "+Inf";
+                    }
+
+                    write_series(out_stream, name + "_bucket", labels, le.str());
+                    out_stream << " " << cumulative << "\n";
+                }
+
+                write_series(out_stream, name + "_sum", labels);
+                out_stream << " ";
+                write_value(out_stream, (*histogram)->sum());
+                out_stream << "\n";
+
+                write_series(out_stream, name + "_count", labels);
+                out_stream << " " << cumulative << "\n";
+
+                continue;
+            }
+
+            write_series(out_stream, name, labels);
+            out_stream << " ";
+
+            std::visit(
+                [&out_stream](const auto& x) {
+                    if constexpr (!std::is_same_v<std::decay_t<decltype(x)>, std::shared_ptr<Histogram>>)
+                    {
+                        write_value(out_stream, x->value());
+                    }
+                },
+                metric);
+
+            out_stream << "\n";
+        }
+    }
+
+    return out_stream.str();
+}
+
+}  // namespace morpheus
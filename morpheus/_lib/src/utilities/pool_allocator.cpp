@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/utilities/pool_allocator.hpp"
+
+#include <array>
+
+namespace morpheus::detail {
+namespace {
+
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+struct ThreadBlockCache
+{
+    struct SizeClass
+    {
+        FreeBlock* head{nullptr};
+        std::size_t num_blocks{0};
+    };
+
+    ~ThreadBlockCache();
+
+    std::array<SizeClass, BlockCache::NumSizeClasses> size_classes;
+};
+
+// Set once the cache of the thread is destroyed, blocks freed by later thread_local destructors going to the heap.
+// Trivially destructible, it stays readable for the whole life of the thread.
+thread_local bool thread_cache_destroyed = false;
+
+ThreadBlockCache::~ThreadBlockCache()
+{
+    thread_cache_destroyed = true;
+
+    for (auto& size_class : size_classes)
+    {
+        while (size_class.head != nullptr)
+        {
+            auto* block     = size_class.head;
+            size_class.head = block->next;
+            ::operator delete(block);
+        }
+    }
+}
+
+ThreadBlockCache* thread_cache()
+{
+    if (thread_cache_destroyed)
+    {
+        return nullptr;
+    }
+
+    thread_local ThreadBlockCache cache;
+    return &cache;
+}
+
+// Index of the size class of `bytes`, each class holding blocks of a multiple of the granularity
+std::size_t size_class_of(std::size_t bytes)
+{
+    return (bytes + BlockCache::Granularity - 1) / BlockCache::Granularity - 1;
+}
+
+}  // namespace
+
+void* BlockCache::allocate(std::size_t bytes)
+{
+    const auto index = size_class_of(bytes);
+
+    if (auto* cache = thread_cache(); cache != nullptr)
+    {
+        auto& size_class = cache->size_classes[index];
+        if (size_class.head != nullptr)
+        {
+            auto* block     = size_class.head;
+            size_class.head = block->next;
+            size_class.num_blocks--;
+
+            return block;
+        }
+    }
+
+    // Every block of a class has the same size, such that a block freed for any size of the class fits any other
+    return ::operator new((index + 1) * Granularity);
+}
+
+void BlockCache::deallocate(void* block, std::size_t bytes) noexcept
+{
+    if (auto* cache = thread_cache(); cache != nullptr)
+    {
+        auto& size_class = cache->size_classes[size_class_of(bytes)];
+        if (size_class.num_blocks < MaxCachedBlocks)
+        {
+            size_class.head = new (block) FreeBlock{size_class.head};
+            size_class.num_blocks++;
+
+            return;
+        }
+    }
+
+    ::operator delete(block);
+}
+
+}  // namespace morpheus::detail
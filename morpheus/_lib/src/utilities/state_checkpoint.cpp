@@ -0,0 +1,294 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/utilities/state_checkpoint.hpp"
+
+#include "morpheus/utilities/cuda_util.hpp"     // for CudaDeviceGuard
+#include "morpheus/utilities/trace_buffer.hpp"  // for MORPHEUS_TRACE
+
+#include <cuda_runtime.h>  // for cudaGetDevice
+#include <cudf/io/parquet.hpp>
+#include <cudf/io/types.hpp>  // for sink_info, source_info, table_input_metadata
+#include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <unistd.h>             // for getpid
+
+#include <algorithm>  // for min
+#include <atomic>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <ostream>       // needed for glog
+#include <system_error>  // for error_code
+#include <utility>       // for move, pair
+
+namespace morpheus {
+namespace {
+
+const std::string StateMetadataKey{"morpheus.checkpoint.state"};
+const std::string OffsetsMetadataKey{"morpheus.checkpoint.kafka_offsets"};
+
+using partition_offsets_t = std::map<std::pair<std::string, int32_t>, int64_t>;
+
+struct CheckpointRegistry
+{
+    std::mutex mutex;
+    std::string directory;
+    partition_offsets_t committed_offsets;
+    partition_offsets_t replay_offsets;
+};
+
+CheckpointRegistry& registry()
+{
+    static CheckpointRegistry registry;
+    return registry;
+}
+
+nlohmann::json offsets_to_json(const partition_offsets_t& offsets)
+{
+    auto json = nlohmann::json::array();
+    for (const auto& [key, offset] : offsets)
+    {
+        json.push_back({{"topic", key.first}, {"partition", key.second}, {"offset", offset}});
+    }
+
+    return json;
+}
+
+}  // namespace
+
+// Component public implementations
+// ************ StateCheckpoint ************************* //
+void StateCheckpoint::set_directory(std::string directory)
+{
+    std::lock_guard lock(registry().mutex);
+    registry().directory = std::move(directory);
+}
+
+std::string StateCheckpoint::get_directory()
+{
+    std::lock_guard lock(registry().mutex);
+    return registry().directory;
+}
+
+void StateCheckpoint::record_committed_offset(const std::string& topic, int32_t partition, int64_t offset)
+{
+    std::lock_guard lock(registry().mutex);
+    registry().committed_offsets[std::make_pair(topic, partition)] = offset;
+}
+
+std::optional<int64_t> StateCheckpoint::take_replay_offset(const std::string& topic, int32_t partition)
+{
+    std::lock_guard lock(registry().mutex);
+
+    auto found = registry().replay_offsets.find(std::make_pair(topic, partition));
+    if (found == registry().replay_offsets.end())
+    {
+        return std::nullopt;
+    }
+
+    auto offset = found->second;
+    registry().replay_offsets.erase(found);
+
+    return offset;
+}
+
+StateCheckpoint::StateCheckpoint(std::string name, std::chrono::milliseconds interval) :
+  m_name(std::move(name)),
+  m_interval(interval),
+  m_last_save(clock_t::now())
+{}
+
+StateCheckpoint::~StateCheckpoint()
+{
+    wait();
+}
+
+std::optional<std::filesystem::path> StateCheckpoint::checkpoint_path() const
+{
+    const auto directory = get_directory();
+    if (m_interval.count() <= 0 || directory.empty())
+    {
+        return std::nullopt;
+    }
+
+    return std::filesystem::path(directory) / (m_name + ".parquet");
+}
+
+bool StateCheckpoint::restore(Checkpointable& state)
+{
+    auto path = checkpoint_path();
+
+    std::error_code ec;
+    if (!path.has_value() || !std::filesystem::exists(*path, ec))
+    {
+        return false;
+    }
+
+    try
+    {
+        auto options = cudf::io::parquet_reader_options::builder(cudf::io::source_info{path->string()}).build();
+        auto result  = cudf::io::read_parquet(options);
+
+        StateSnapshot snapshot;
+        snapshot.table = std::move(result.tbl);
+        for (const auto& column : result.metadata.schema_info)
+        {
+            snapshot.column_names.push_back(column.name);
+        }
+
+        const auto& user_data = result.metadata.per_file_user_data.at(0);
+        snapshot.metadata     = nlohmann::json::parse(user_data.at(StateMetadataKey));
+        auto offsets          = nlohmann::json::parse(user_data.at(OffsetsMetadataKey));
+
+        const auto num_rows = snapshot.table->num_rows();
+        state.restore(std::move(snapshot));
+
+        // Only registered once the state has been restored, the partitions otherwise resume from their commits
+        {
+            std::lock_guard lock(registry().mutex);
+            for (const auto& entry : offsets)
+            {
+                const auto offset = entry["offset"].get<int64_t>();
+
+                auto key = std::make_pair(entry["topic"].get<std::string>(), entry["partition"].get<int32_t>());
+
+                auto [found, inserted] = registry().replay_offsets.try_emplace(std::move(key), offset);
+                if (!inserted)
+                {
+                    found->second = std::min(found->second, offset);
+                }
+            }
+        }
+
+        LOG(INFO) << "Restored the state of '" << m_name << "' from " << *path << ", " << num_rows << " rows and "
+                  << offsets.size() << " Kafka partition offsets";
+        MORPHEUS_TRACE("checkpoint.restore", num_rows, offsets.size());
+
+        return true;
+    } catch (const std::exception& e)
+    {
+        LOG(WARNING) << "Could not restore the state of '" << m_name << "' from " << *path << ": " << e.what();
+        return false;
+    }
+}
+
+bool StateCheckpoint::maybe_save(Checkpointable& state, clock_t::time_point now)
+{
+    if (!checkpoint_path().has_value() || now - m_last_save < m_interval)
+    {
+        return false;
+    }
+
+    // The previous checkpoint is still being written, try again on the next call
+    if (m_pending.valid() && m_pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        VLOG(10) << "Skipping a checkpoint of '" << m_name << "', the previous one is still being written";
+        return false;
+    }
+
+    save(state);
+    m_last_save = now;
+
+    return true;
+}
+
+void StateCheckpoint::save(Checkpointable& state)
+{
+    auto path = checkpoint_path();
+    if (!path.has_value())
+    {
+        return;
+    }
+
+    wait();
+
+    // Offsets committed from now on may cover messages not yet part of the snapshot, read them first
+    nlohmann::json offsets;
+    {
+        std::lock_guard lock(registry().mutex);
+        offsets = offsets_to_json(registry().committed_offsets);
+    }
+
+    auto snapshot = state.snapshot();
+    if (snapshot.table == nullptr || snapshot.table->num_columns() == 0)
+    {
+        return;
+    }
+
+    int device_id = 0;
+    MRC_CHECK_CUDA(cudaGetDevice(&device_id));
+
+    m_pending = std::async(std::launch::async,
+                           [snapshot = std::move(snapshot),
+                            offsets  = std::move(offsets),
+                            path     = std::move(*path),
+                            device_id]() mutable {
+                               CudaDeviceGuard guard(device_id);
+                               write(std::move(snapshot), offsets, path);
+                           });
+}
+
+void StateCheckpoint::wait()
+{
+    if (m_pending.valid())
+    {
+        m_pending.get();
+    }
+}
+
+void StateCheckpoint::write(StateSnapshot snapshot,
+                            const nlohmann::json& kafka_offsets,
+                            const std::filesystem::path& path)
+{
+    // Unique to the writer, the checkpoint only appearing once complete
+    static std::atomic<uint64_t> num_writes{0};
+    auto temp_path = path;
+    temp_path += "." + std::to_string(::getpid()) + "." + std::to_string(num_writes++) + ".tmp";
+
+    std::error_code ec;
+    try
+    {
+        std::filesystem::create_directories(path.parent_path());
+
+        auto view = snapshot.table->view();
+        cudf::io::table_input_metadata metadata(view);
+        for (std::size_t i = 0; i < snapshot.column_names.size(); ++i)
+        {
+            metadata.column_metadata[i].set_name(snapshot.column_names[i]);
+        }
+
+        std::map<std::string, std::string> user_data{
+            {StateMetadataKey, snapshot.metadata.dump()}, {OffsetsMetadataKey, kafka_offsets.dump()}};
+
+        auto options = cudf::io::parquet_writer_options::builder(cudf::io::sink_info{temp_path.string()}, view)
+                           .metadata(std::move(metadata))
+                           .key_value_metadata({std::move(user_data)})
+                           .build();
+        cudf::io::write_parquet(options);
+
+        std::filesystem::rename(temp_path, path);
+
+        MORPHEUS_TRACE("checkpoint.write", view.num_rows(), view.num_columns());
+    } catch (const std::exception& e)
+    {
+        LOG(WARNING) << "Could not write the checkpoint " << path << ": " << e.what();
+        std::filesystem::remove(temp_path, ec);
+    }
+}
+
+}  // namespace morpheus
@@ -17,14 +17,28 @@
 
 #include "morpheus/utilities/table_util.hpp"
 
+#include <cuda_runtime.h>  // for cudaMemcpy, cudaMemcpyDeviceToHost
+#include <cudf/concatenate.hpp>
+#include <cudf/dictionary/dictionary_column_view.hpp>
+#include <cudf/dictionary/encode.hpp>  // for decode
 #include <cudf/io/csv.hpp>
 #include <cudf/io/json.hpp>
+#include <cudf/sorting.hpp>            // for is_sorted
+#include <cudf/stream_compaction.hpp>  // for unique_count
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>  // for order, null_order
 #include <glog/logging.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
 #include <pybind11/pybind11.h>
+#include <rmm/cuda_stream_view.hpp>
 
+#include <algorithm>  // for equal, any_of
 #include <filesystem>
 #include <ostream>    // needed for logging
 #include <stdexcept>  // for runtime_error
+#include <utility>    // for move
+#include <vector>
 
 namespace fs = std::filesystem;
 namespace py = pybind11;
@@ -52,3 +66,110 @@ cudf::io::table_with_metadata morpheus::CuDFTableUtil::load_table(const std::str
         throw std::runtime_error("Unknown extension");
     }
 }
+
+cudf::io::table_with_metadata morpheus::CuDFTableUtil::concatenate_tables(
+    std::vector<cudf::io::table_with_metadata>&& tables)
+{
+    if (tables.empty())
+    {
+        throw std::runtime_error("No tables to concatenate");
+    }
+
+    if (tables.size() == 1)
+    {
+        return std::move(tables.front());
+    }
+
+    const auto& schema = tables.front().metadata.schema_info;
+
+    std::vector<cudf::table_view> views;
+    views.reserve(tables.size());
+    for (const auto& table : tables)
+    {
+        const auto& other = table.metadata.schema_info;
+        if (!std::equal(schema.begin(), schema.end(), other.begin(), other.end(), [](const auto& a, const auto& b) {
+                return a.name == b.name;
+            }))
+        {
+            throw std::runtime_error("Unable to concatenate tables with different columns");
+        }
+
+        views.push_back(table.tbl->view());
+    }
+
+    return {cudf::concatenate(views), std::move(tables.front().metadata)};
+}
+
+bool morpheus::CuDFTableUtil::is_sliceable_index(const cudf::table_view& index)
+{
+    if (index.num_rows() <= 1)
+    {
+        return true;
+    }
+
+    if (std::any_of(index.begin(), index.end(), [](const cudf::column_view& column) {
+            return column.has_nulls();
+        }))
+    {
+        return false;
+    }
+
+    const auto num_columns = static_cast<std::size_t>(index.num_columns());
+    const std::vector<cudf::null_order> null_precedence(num_columns, cudf::null_order::BEFORE);
+
+    if (!cudf::is_sorted(index, std::vector<cudf::order>(num_columns, cudf::order::ASCENDING), null_precedence) &&
+        !cudf::is_sorted(index, std::vector<cudf::order>(num_columns, cudf::order::DESCENDING), null_precedence))
+    {
+        return false;
+    }
+
+    // Equal rows of a sorted index are consecutive, counting the groups of consecutive equal rows is enough
+    return cudf::unique_count(index, cudf::null_equality::EQUAL) == index.num_rows();
+}
+
+cudf::table_view morpheus::CuDFTableUtil::decode_dictionaries(const cudf::table_view& table,
+                                                              std::vector<std::unique_ptr<cudf::column>>& decoded)
+{
+    std::vector<cudf::column_view> columns(table.begin(), table.end());
+    for (auto& column : columns)
+    {
+        if (column.type().id() == cudf::type_id::DICTIONARY32)
+        {
+            decoded.push_back(cudf::dictionary::decode(cudf::dictionary_column_view{column}));
+            column = decoded.back()->view();
+        }
+    }
+
+    return cudf::table_view{columns};
+}
+
+std::vector<std::string> morpheus::CuDFTableUtil::copy_strings_to_host(const cudf::column_view& column)
+{
+    cudf::strings_column_view strings{column};
+    std::vector<cudf::size_type> offsets(strings.size() + 1);
+
+    MRC_CHECK_CUDA(cudaMemcpy(offsets.data(),
+                              strings.offsets().data<cudf::size_type>() + strings.offset(),
+                              offsets.size() * sizeof(cudf::size_type),
+                              cudaMemcpyDeviceToHost));
+
+    std::string chars(offsets.back() - offsets.front(), '\0');
+
+    if (!chars.empty())
+    {
+        MRC_CHECK_CUDA(cudaMemcpy(chars.data(),
+                                  strings.chars_begin(rmm::cuda_stream_default) + offsets.front(),
+                                  chars.size(),
+                                  cudaMemcpyDeviceToHost));
+    }
+
+    std::vector<std::string> values;
+    values.reserve(strings.size());
+
+    for (cudf::size_type i = 0; i < strings.size(); ++i)
+    {
+        values.emplace_back(chars, offsets[i] - offsets.front(), offsets[i + 1] - offsets[i]);
+    }
+
+    return values;
+}
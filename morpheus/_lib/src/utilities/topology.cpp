@@ -0,0 +1,299 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/utilities/topology.hpp"
+
+#include "morpheus/utilities/cuda_util.hpp"    // for CudaUtil
+#include "morpheus/utilities/string_util.hpp"  // for MORPHEUS_CONCAT_STR
+
+#include <cuda_runtime.h>  // for cudaDeviceGetPCIBusId
+#include <glog/logging.h>
+#include <pthread.h>      // for pthread_setaffinity_np, pthread_getaffinity_np, pthread_self
+#include <sched.h>        // for cpu_set_t, CPU_SET, CPU_ZERO, CPU_ISSET
+#include <sys/syscall.h>  // for SYS_mbind, SYS_getcpu
+#include <unistd.h>       // for syscall
+
+#include <algorithm>  // for transform
+#include <cctype>     // for tolower, isdigit
+#include <climits>    // for CHAR_BIT
+#include <fstream>    // for ifstream
+#include <sstream>    // for istringstream
+#include <stdexcept>  // for invalid_argument
+
+namespace morpheus {
+namespace {
+// From the kernel's uapi/linux/mempolicy.h, avoiding a dependency on libnuma
+constexpr int MpolBind      = 2;
+constexpr unsigned MpolMove = 1u << 1;
+
+std::string read_sysfs(const std::string& path)
+{
+    std::ifstream in_stream{path};
+    std::string value;
+    std::getline(in_stream, value);
+
+    return value;
+}
+
+// Lower cases the address and adds the default PCI domain, matching the names of the devices in sysfs
+std::string normalize_pci_address(std::string pci_address)
+{
+    std::transform(pci_address.begin(), pci_address.end(), pci_address.begin(), [](unsigned char c) {
+        return std::tolower(c);
+    });
+
+    if (std::count(pci_address.begin(), pci_address.end(), ':') == 1)
+    {
+        pci_address = "0000:" + pci_address;
+    }
+
+    return pci_address;
+}
+
+// Formats CPUs as a sysfs CPU list, such as `0-3,8`
+std::string format_cpu_list(const std::vector<int>& cpus)
+{
+    std::ostringstream out_stream;
+
+    for (std::size_t i = 0; i < cpus.size();)
+    {
+        auto last = i;
+        while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1)
+        {
+            ++last;
+        }
+
+        out_stream << (i > 0 ? "," : "") << cpus[i];
+        if (last > i)
+        {
+            out_stream << "-" << cpus[last];
+        }
+
+        i = last + 1;
+    }
+
+    return out_stream.str();
+}
+
+int parse_index(const std::string& value, const std::string& placement)
+{
+    if (value.empty() || !std::all_of(value.begin(), value.end(), [](unsigned char c) {
+            return std::isdigit(c);
+        }))
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Invalid placement '" << placement << "'"));
+    }
+
+    return std::stoi(value);
+}
+}  // namespace
+
+// Component public implementations
+// ************ DeviceLocality ****************************** //
+bool DeviceLocality::empty() const
+{
+    return numa_node < 0 && cpus.empty();
+}
+
+std::string DeviceLocality::to_string() const
+{
+    if (this->empty())
+    {
+        return "unknown locality";
+    }
+
+    return MORPHEUS_CONCAT_STR((pci_address.empty() ? "" : pci_address + ", ")
+                               << "NUMA node " << numa_node << ", CPUs " << format_cpu_list(cpus));
+}
+
+// ************ TopologyUtil ******************************** //
+DeviceLocality TopologyUtil::gpu_locality(int device_id)
+{
+    char pci_address[32]{};
+    if (cudaDeviceGetPCIBusId(pci_address, sizeof(pci_address), device_id) != cudaSuccess)
+    {
+        LOG(WARNING) << "Unable to find the PCI address of GPU " << device_id;
+        return {};
+    }
+
+    return pci_locality(pci_address);
+}
+
+DeviceLocality TopologyUtil::pci_locality(const std::string& pci_address)
+{
+    DeviceLocality locality;
+    locality.pci_address = normalize_pci_address(pci_address);
+
+    const auto device_path = "/sys/bus/pci/devices/" + locality.pci_address;
+
+    auto numa_node = read_sysfs(device_path + "/numa_node");
+    if (!numa_node.empty())
+    {
+        locality.numa_node = std::stoi(numa_node);
+    }
+
+    locality.cpus = parse_cpu_list(read_sysfs(device_path + "/local_cpulist"));
+
+    return locality;
+}
+
+DeviceLocality TopologyUtil::numa_locality(int numa_node)
+{
+    DeviceLocality locality;
+    locality.cpus = parse_cpu_list(read_sysfs(MORPHEUS_CONCAT_STR("/sys/devices/system/node/node" << numa_node
+                                                                                                  << "/cpulist")));
+
+    if (!locality.cpus.empty())
+    {
+        locality.numa_node = numa_node;
+    }
+
+    return locality;
+}
+
+DeviceLocality TopologyUtil::resolve_placement(const std::string& placement)
+{
+    if (placement.empty())
+    {
+        return {};
+    }
+
+    if (placement == "gpu")
+    {
+        return gpu_locality(CudaUtil::current_device());
+    }
+
+    if (placement.starts_with("gpu:"))
+    {
+        return gpu_locality(parse_index(placement.substr(4), placement));
+    }
+
+    if (placement.starts_with("numa:"))
+    {
+        return numa_locality(parse_index(placement.substr(5), placement));
+    }
+
+    if (placement.find(':') == std::string::npos)
+    {
+        throw std::invalid_argument(MORPHEUS_CONCAT_STR("Invalid placement '" << placement << "'"));
+    }
+
+    return pci_locality(placement);
+}
+
+std::vector<int> TopologyUtil::parse_cpu_list(const std::string& cpu_list)
+{
+    std::vector<int> cpus;
+
+    std::istringstream ranges{cpu_list};
+    std::string range;
+    while (std::getline(ranges, range, ','))
+    {
+        if (range.empty())
+        {
+            continue;
+        }
+
+        try
+        {
+            const auto dash  = range.find('-');
+            const auto first = std::stoi(range.substr(0, dash));
+            const auto last  = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+
+            for (auto cpu = first; cpu <= last; ++cpu)
+            {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::logic_error&)
+        {
+            throw std::invalid_argument(MORPHEUS_CONCAT_STR("Invalid CPU list '" << cpu_list << "'"));
+        }
+    }
+
+    return cpus;
+}
+
+bool TopologyUtil::bind_current_thread(const DeviceLocality& locality)
+{
+    if (locality.cpus.empty())
+    {
+        return false;
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto cpu : locality.cpus)
+    {
+        CPU_SET(cpu, &cpu_set);
+    }
+
+    auto result = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (result != 0)
+    {
+        LOG(WARNING) << "Unable to bind a thread to " << locality.to_string() << ", error " << result;
+        return false;
+    }
+
+    return true;
+}
+
+bool TopologyUtil::bind_memory(void* data, std::size_t bytes, int numa_node)
+{
+    if (numa_node < 0)
+    {
+        return false;
+    }
+
+    constexpr std::size_t BitsPerMask = sizeof(unsigned long) * CHAR_BIT;
+
+    std::vector<unsigned long> node_mask(numa_node / BitsPerMask + 1, 0);
+    node_mask[numa_node / BitsPerMask] |= 1ul << (numa_node % BitsPerMask);
+
+    // The kernel reads one bit less than `maxnode`
+    const auto max_node = node_mask.size() * BitsPerMask + 1;
+
+    return ::syscall(SYS_mbind, data, bytes, MpolBind, node_mask.data(), max_node, MpolMove) == 0;
+}
+
+std::string TopologyUtil::describe_current_thread()
+{
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    std::vector<int> cpus;
+
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &cpu_set))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+
+    unsigned cpu  = 0;
+    unsigned node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+    {
+        return MORPHEUS_CONCAT_STR("CPUs " << format_cpu_list(cpus));
+    }
+
+    return MORPHEUS_CONCAT_STR("CPUs " << format_cpu_list(cpus) << ", running on CPU " << cpu << " of NUMA node "
+                                       << node);
+}
+}  // namespace morpheus
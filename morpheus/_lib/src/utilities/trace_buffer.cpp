@@ -0,0 +1,374 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/utilities/trace_buffer.hpp"
+
+#include <glog/logging.h>
+#include <semaphore.h>  // for sem_init, sem_post, sem_wait
+
+#include <algorithm>  // for sort
+#include <atomic>
+#include <cerrno>  // for EINTR
+#include <chrono>
+#include <csignal>  // for sigaction
+#include <cstring>  // for strerror
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>    // needed for glog
+#include <stdexcept>  // for runtime_error
+#include <thread>
+#include <utility>  // for move
+
+namespace morpheus {
+namespace {
+
+// Identifies dump files and their layout, see `morpheus.utils.trace_decoder`
+constexpr char DumpMagic[8] = {'M', 'T', 'R', 'A', 'C', 'E', '0', '1'};
+
+/**
+ * @brief Ring buffer of a single writing thread. Each slot is guarded by a sequence number, odd while the slot is being
+ * written and `2 * index + 2` once the record of `index` is complete, such that readers skip torn records.
+ */
+class ThreadBuffer
+{
+  public:
+    explicit ThreadBuffer(uint32_t thread) : m_thread(thread), m_slots(TraceBuffer::RecordsPerThread) {}
+
+    void record(trace_event_t event, const std::array<int64_t, 4>& args)
+    {
+        const auto timestamp =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+
+        // Only this thread writes the head
+        const auto index = m_head.load(std::memory_order_relaxed);
+        auto& slot       = m_slots[index & (TraceBuffer::RecordsPerThread - 1)];
+
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.timestamp_ns.store(timestamp.count(), std::memory_order_relaxed);
+        slot.event.store(event, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < args.size(); ++i)
+        {
+            slot.args[i].store(args[i], std::memory_order_relaxed);
+        }
+
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        m_head.store(index + 1, std::memory_order_release);
+    }
+
+    void read(std::vector<TraceRecord>& records) const
+    {
+        const auto head  = m_head.load(std::memory_order_acquire);
+        const auto first = head > TraceBuffer::RecordsPerThread ? head - TraceBuffer::RecordsPerThread : 0;
+
+        for (auto index = first; index < head; ++index)
+        {
+            const auto& slot = m_slots[index & (TraceBuffer::RecordsPerThread - 1)];
+
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * index + 2)
+            {
+                continue;
+            }
+
+            TraceRecord record{};
+            record.timestamp_ns = slot.timestamp_ns.load(std::memory_order_relaxed);
+            record.event        = slot.event.load(std::memory_order_relaxed);
+            record.thread       = m_thread;
+            for (std::size_t i = 0; i < record.args.size(); ++i)
+            {
+                record.args[i] = slot.args[i].load(std::memory_order_relaxed);
+            }
+
+            // Overwritten while it was read
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+            {
+                continue;
+            }
+
+            records.push_back(record);
+        }
+    }
+
+  private:
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> timestamp_ns{0};
+        std::atomic<trace_event_t> event{0};
+        std::array<std::atomic<int64_t>, 4> args{};
+    };
+
+    const uint32_t m_thread;
+    std::atomic<uint64_t> m_head{0};
+    std::vector<Slot> m_slots;
+};
+
+std::atomic<bool> s_enabled{false};
+
+struct Registry
+{
+    std::mutex mutex;
+
+    // Buffers outlive their threads, keeping the last events of threads which have exited
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+    std::map<std::string, trace_event_t> event_ids;
+    std::vector<std::string> event_names;
+
+    std::string error_path;
+    std::chrono::seconds error_interval{0};
+    std::chrono::steady_clock::time_point last_error_dump;
+
+    std::string signal_path;
+};
+
+// Never destroyed, threads may still record during shutdown
+Registry& registry()
+{
+    static auto* instance = new Registry();
+    return *instance;
+}
+
+ThreadBuffer& thread_buffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer = []() {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+
+        auto created = std::make_shared<ThreadBuffer>(static_cast<uint32_t>(reg.buffers.size()));
+        reg.buffers.push_back(created);
+
+        return created;
+    }();
+
+    return *buffer;
+}
+
+// Posted from the signal handler, sem_post being async-signal-safe
+sem_t s_signal_semaphore;
+
+void signal_handler(int /*signal*/)
+{
+    sem_post(&s_signal_semaphore);
+}
+
+void signal_dump_loop()
+{
+    while (true)
+    {
+        if (sem_wait(&s_signal_semaphore) != 0)
+        {
+            // Interrupted by a signal
+            continue;
+        }
+
+        std::string path;
+        {
+            auto& reg = registry();
+            std::lock_guard lock(reg.mutex);
+            path = reg.signal_path;
+        }
+
+        try
+        {
+            TraceBuffer::dump(path);
+            LOG(INFO) << "Dumped the trace buffers to " << path;
+        } catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Failed to dump the trace buffers on signal: " << e.what();
+        }
+    }
+}
+
+}  // namespace
+
+// Component public implementations
+// ************ TraceBuffer ************************* //
+bool TraceBuffer::is_enabled()
+{
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void TraceBuffer::set_enabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+trace_event_t TraceBuffer::register_event(const std::string& name)
+{
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    auto [found, inserted] = reg.event_ids.emplace(name, static_cast<trace_event_t>(reg.event_names.size()));
+    if (inserted)
+    {
+        reg.event_names.push_back(name);
+    }
+
+    return found->second;
+}
+
+void TraceBuffer::record(trace_event_t event, int64_t arg0, int64_t arg1, int64_t arg2, int64_t arg3)
+{
+    thread_buffer().record(event, {arg0, arg1, arg2, arg3});
+}
+
+std::vector<TraceRecord> TraceBuffer::snapshot()
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        buffers = reg.buffers;
+    }
+
+    std::vector<TraceRecord> records;
+    for (const auto& buffer : buffers)
+    {
+        buffer->read(records);
+    }
+
+    std::sort(records.begin(), records.end(), [](const TraceRecord& lhs, const TraceRecord& rhs) {
+        return lhs.timestamp_ns < rhs.timestamp_ns;
+    });
+
+    return records;
+}
+
+std::vector<std::string> TraceBuffer::event_names()
+{
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    return reg.event_names;
+}
+
+void TraceBuffer::dump(const std::string& path)
+{
+    // Names are read after the records, such that every recorded event has a name
+    auto records     = TraceBuffer::snapshot();
+    const auto names = TraceBuffer::event_names();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("Could not open '" + path + "' for writing: " + std::strerror(errno));
+    }
+
+    auto write = [&file](const auto& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    file.write(DumpMagic, sizeof(DumpMagic));
+
+    write(static_cast<uint32_t>(names.size()));
+    for (const auto& name : names)
+    {
+        write(static_cast<uint32_t>(name.size()));
+        file.write(name.data(), static_cast<std::streamsize>(name.size()));
+    }
+
+    write(static_cast<uint64_t>(records.size()));
+    for (const auto& record : records)
+    {
+        write(record.timestamp_ns);
+        write(record.event);
+        write(record.thread);
+        for (const auto arg : record.args)
+        {
+            write(arg);
+        }
+    }
+
+    if (!file.flush())
+    {
+        throw std::runtime_error("Could not write the trace buffers to '" + path + "'");
+    }
+}
+
+void TraceBuffer::dump_on_signal(int signal, const std::string& path)
+{
+    static std::once_flag started;
+
+    auto& reg = registry();
+    {
+        std::lock_guard lock(reg.mutex);
+        reg.signal_path = path;
+    }
+
+    std::call_once(started, []() {
+        sem_init(&s_signal_semaphore, 0, 0);
+        std::thread(signal_dump_loop).detach();
+    });
+
+    struct sigaction action
+    {};
+    action.sa_handler = signal_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+
+    if (sigaction(signal, &action, nullptr) != 0)
+    {
+        throw std::runtime_error("Could not install the handler of signal " + std::to_string(signal) + ": " +
+                                 std::strerror(errno));
+    }
+}
+
+void TraceBuffer::dump_on_error(const std::string& path, int min_interval_seconds)
+{
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    reg.error_path     = path;
+    reg.error_interval = std::chrono::seconds(min_interval_seconds);
+}
+
+void TraceBuffer::on_error()
+{
+    std::string path;
+    {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+
+        const auto now = std::chrono::steady_clock::now();
+        if (reg.error_path.empty() ||
+            (reg.last_error_dump.time_since_epoch().count() != 0 && now - reg.last_error_dump < reg.error_interval))
+        {
+            return;
+        }
+
+        reg.last_error_dump = now;
+        path                = reg.error_path;
+    }
+
+    try
+    {
+        TraceBuffer::dump(path);
+        LOG(WARNING) << "Dumped the trace buffers to " << path << " after an error";
+    } catch (const std::exception& e)
+    {
+        LOG(ERROR) << "Failed to dump the trace buffers: " << e.what();
+    }
+}
+
+}  // namespace morpheus
@@ -0,0 +1,166 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "morpheus/utilities/warm_start_cache.hpp"
+
+#include <glog/logging.h>
+#include <unistd.h>  // for getpid
+
+#include <atomic>
+#include <cstdint>  // for uint64_t
+#include <fstream>
+#include <iomanip>   // for setw, setfill
+#include <iterator>  // for istreambuf_iterator
+#include <mutex>
+#include <ostream>  // needed for glog
+#include <sstream>
+#include <system_error>  // for error_code
+#include <utility>       // for move
+
+namespace morpheus {
+namespace {
+
+std::mutex& directory_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::string& directory_value()
+{
+    static std::string directory;
+    return directory;
+}
+
+// FNV-1a, stable across processes and builds unlike std::hash
+uint64_t hash_key(const std::string& key)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : key)
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+}  // namespace
+
+// Component public implementations
+// ************ WarmStartCache ************************* //
+void WarmStartCache::set_directory(std::string directory)
+{
+    std::lock_guard lock(directory_mutex());
+    directory_value() = std::move(directory);
+}
+
+std::string WarmStartCache::get_directory()
+{
+    std::lock_guard lock(directory_mutex());
+    return directory_value();
+}
+
+std::optional<std::filesystem::path> WarmStartCache::entry_path(const std::string& kind, const std::string& source_file)
+{
+    const auto directory = get_directory();
+    if (directory.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::error_code ec;
+    const auto source     = std::filesystem::canonical(source_file, ec);
+    const auto size       = ec ? 0 : std::filesystem::file_size(source, ec);
+    const auto write_time = ec ? std::filesystem::file_time_type{} : std::filesystem::last_write_time(source, ec);
+    if (ec)
+    {
+        LOG(WARNING) << "Could not stat '" << source_file << "' for the warm start cache: " << ec.message();
+        return std::nullopt;
+    }
+
+    std::stringstream key;
+    key << kind << '\n' << source.string() << '\n' << size << '\n' << write_time.time_since_epoch().count();
+
+    std::stringstream name;
+    name << kind << '-' << std::hex << std::setw(16) << std::setfill('0') << hash_key(key.str()) << ".bin";
+
+    return std::filesystem::path(directory) / name.str();
+}
+
+std::optional<std::string> WarmStartCache::read(const std::string& kind, const std::string& source_file)
+{
+    auto path = entry_path(kind, source_file);
+    if (!path.has_value())
+    {
+        return std::nullopt;
+    }
+
+    std::ifstream file(*path, std::ios::binary);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+
+    std::string contents{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    if (file.bad())
+    {
+        LOG(WARNING) << "Could not read the warm start cache entry " << *path;
+        return std::nullopt;
+    }
+
+    return contents;
+}
+
+void WarmStartCache::write(const std::string& kind, const std::string& source_file, const std::string& contents)
+{
+    auto path = entry_path(kind, source_file);
+    if (!path.has_value())
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(path->parent_path(), ec);
+
+    // Unique to the writer, the entry only appearing once complete
+    static std::atomic<uint64_t> num_writes{0};
+    auto temp_path = *path;
+    temp_path += "." + std::to_string(::getpid()) + "." + std::to_string(num_writes++) + ".tmp";
+
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+
+        if (ec || !file.flush())
+        {
+            LOG(WARNING) << "Could not write the warm start cache entry " << *path;
+            std::filesystem::remove(temp_path, ec);
+            return;
+        }
+    }
+
+    std::filesystem::rename(temp_path, *path, ec);
+    if (ec)
+    {
+        LOG(WARNING) << "Could not write the warm start cache entry " << *path << ": " << ec.message();
+        std::filesystem::remove(temp_path, ec);
+    }
+}
+
+}  // namespace morpheus
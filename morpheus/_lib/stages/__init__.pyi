@@ -18,64 +18,169 @@ __all__ = [
     "AddClassificationsMultiResponseMessageStage",
     "AddScoresControlMessageStage",
     "AddScoresMultiResponseMessageStage",
+    "AppShieldFeaturesStage",
+    "CidrLookupStage",
+    "CudaIpcSinkStage",
+    "CudaIpcSourceStage",
+    "DeduplicateStage",
     "DeserializeControlMessageStage",
     "DeserializeMultiMessageStage",
+    "EnrichStage",
+    "FanOutInferenceClientStage",
     "FileSourceStage",
-    "FilterDetectionsStage",
+    "FilterDetectionsControlMessageStage",
+    "FilterDetectionsMultiMessageStage",
+    "FilterRowsStage",
     "FilterSource",
+    "HashPartitionControlMessageStage",
+    "HashPartitionMessageMetaStage",
+    "HttpClientSinkStage",
     "HttpServerSourceStage",
     "InferenceClientStage",
     "KafkaSourceStage",
+    "LoadSheddingStage",
+    "LogParsingPostprocessStage",
+    "MonitorControlMessageStage",
+    "MonitorMessageMetaStage",
+    "MonitorMultiMessageStage",
+    "MultiFileSourceStage",
+    "NormalizeEmbeddingsStage",
+    "NvmlSourceStage",
+    "PartitionSelectControlMessageStage",
+    "PartitionSelectMessageMetaStage",
     "PreallocateMessageMetaStage",
     "PreallocateMultiMessageStage",
+    "PreprocessAEControlMessageStage",
+    "PreprocessAEMultiMessageStage",
     "PreprocessFILControlMessageStage",
     "PreprocessFILMultiMessageStage",
     "PreprocessNLPControlMessageStage",
     "PreprocessNLPMultiMessageStage",
+    "ReplaySourceStage",
+    "RollingWindowStage",
     "SerializeControlMessageStage",
     "SerializeMultiMessageStage",
-    "WriteToFileStage"
+    "SplitUsersStage",
+    "TimestampControlMessageStage",
+    "TimestampMessageMetaStage",
+    "TimestampMultiMessageStage",
+    "UcxEgressStage",
+    "UcxIngressStage",
+    "WindowAggregateStage",
+    "WriteToElasticsearchStage",
+    "WriteToFileControlMessageStage",
+    "WriteToFileStage",
+    "WriteToKafkaStage"
 ]
 
 
 class AddClassificationsControlMessageStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, idx2label: typing.Dict[int, str], threshold: float) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, idx2label: typing.Dict[int, str], threshold: float, top_k: int = 0, top_k_prefix: str = '', packed_column: str = '') -> None: ...
     pass
 class AddClassificationsMultiResponseMessageStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, idx2label: typing.Dict[int, str], threshold: float) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, idx2label: typing.Dict[int, str], threshold: float, top_k: int = 0, top_k_prefix: str = '', packed_column: str = '') -> None: ...
     pass
 class AddScoresControlMessageStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, idx2label: typing.Dict[int, str]) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, idx2label: typing.Dict[int, str], top_k: int = 0, top_k_prefix: str = '') -> None: ...
     pass
 class AddScoresMultiResponseMessageStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, idx2label: typing.Dict[int, str]) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, idx2label: typing.Dict[int, str], top_k: int = 0, top_k_prefix: str = '') -> None: ...
+    pass
+class AppShieldFeaturesStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, feature_columns: typing.List[str], file_extns: typing.List[str]) -> None: ...
+    pass
+class CidrLookupStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, filename: str, file_type: morpheus._lib.common.FileTypes, network_column: str, label_columns: typing.List[str], address_columns: typing.List[str]) -> None: ...
+    pass
+class CudaIpcSinkStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, ring_name: str, num_slots: int = 64, max_header_bytes: int = 65536, close_timeout_ms: int = 60000) -> None: ...
+    pass
+class CudaIpcSourceStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, ring_name: str, open_timeout_ms: int = 60000) -> None: ...
+    pass
+class DeduplicateStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, key_columns: typing.List[str], window_ms: int = 300000, num_buckets: int = 10, max_keys: int = 10000000, checkpoint_interval_ms: int = 0) -> None: ...
     pass
 class DeserializeControlMessageStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, batch_size: int, ensure_sliceable_index: bool = True, task_type: object = None, task_payload: object = None) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, batch_size: int, ensure_sliceable_index: bool = True, task_type: object = None, task_payload: object = None, coalesce: bool = False, max_linger_ms: int = 0) -> None: ...
     pass
 class DeserializeMultiMessageStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, batch_size: int, ensure_sliceable_index: bool = True) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, batch_size: int, ensure_sliceable_index: bool = True, coalesce: bool = False, max_linger_ms: int = 0) -> None: ...
+    pass
+class EnrichStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, filename: str, file_type: morpheus._lib.common.FileTypes, key_columns: typing.List[str], value_columns: typing.List[str] = [], event_key_columns: typing.List[str] = [], prefix: str = '', reload_interval_ms: int = 0) -> None: ...
+    pass
+class FanOutInferenceClientStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, server_url: str, model_output_mappings: typing.Dict[str, typing.Dict[str, str]], needs_logits: bool, input_mapping: typing.Dict[str, str] = {}, use_cuda_graphs: bool = False, use_shared_memory: bool = False, max_concurrent_batches: int = 1, max_batch_rows: int = 0, max_batch_delay_ms: int = 1, num_connections: int = 1, hedge_requests: bool = False, cache_size: int = 0, warm_up: bool = False, ragged_offsets_input: str = '', ragged_token_outputs: typing.List[str] = []) -> None: ...
     pass
 class FileSourceStage(mrc.core.segment.SegmentObject):
     @typing.overload
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, filename: os.PathLike, repeat: int, parser_kwargs: dict) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, filename: os.PathLike, repeat: int, parser_kwargs: dict, chunk_bytes: int = 0, schema: typing.List[typing.Tuple[str, str]] = [], projection: typing.List[str] = []) -> None: ...
     @typing.overload
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, filename: str, repeat: int, parser_kwargs: dict) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, filename: str, repeat: int, parser_kwargs: dict, chunk_bytes: int = 0, schema: typing.List[typing.Tuple[str, str]] = [], projection: typing.List[str] = []) -> None: ...
+    pass
+class FilterDetectionsControlMessageStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, threshold: float, copy: bool, filter_source: morpheus._lib.common.FilterSource, field_name: str = 'probs', mask_column: str = '') -> None: ...
+    pass
+class FilterDetectionsMultiMessageStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, threshold: float, copy: bool, filter_source: morpheus._lib.common.FilterSource, field_name: str = 'probs', mask_column: str = '') -> None: ...
+    pass
+class FilterRowsStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, predicates: typing.List[typing.Tuple[str, str, str]], match_all: bool = True, exclude: bool = False) -> None: ...
     pass
-class FilterDetectionsStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, threshold: float, copy: bool, filter_source: morpheus._lib.common.FilterSource, field_name: str = 'probs') -> None: ...
+class HashPartitionControlMessageStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, key_columns: typing.List[str], num_partitions: int) -> None: ...
+    pass
+class HashPartitionMessageMetaStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, key_columns: typing.List[str], num_partitions: int) -> None: ...
+    pass
+class HttpClientSinkStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, host: str, port: int, target: str, method: str = 'POST', headers: typing.Dict[str, str] = {}, error_sleep_time: float = 0.10000000149011612, respect_retry_after_header: bool = True, request_timeout: int = 30, accept_status_codes: typing.List[int] = [200, 201, 202], max_retries: int = 10, max_rows_per_payload: int = 10000, lines: bool = False, max_connections: int = 8) -> None: ...
     pass
 class HttpServerSourceStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, bind_address: str = '127.0.0.1', port: int = 8080, endpoint: str = '/message', method: str = 'POST', accept_status: int = 201, sleep_time: float = 0.10000000149011612, queue_timeout: int = 5, max_queue_size: int = 1024, num_server_threads: int = 1, max_payload_size: int = 10485760, request_timeout: int = 30, lines: bool = False, stop_after: int = 0) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, bind_address: str = '127.0.0.1', port: int = 8080, endpoint: str = '/message', method: str = 'POST', accept_status: int = 201, sleep_time: float = 0.10000000149011612, queue_timeout: int = 5, max_queue_size: int = 1024, num_server_threads: int = 1, max_payload_size: int = 10485760, request_timeout: int = 30, lines: bool = False, stop_after: int = 0, coalesce_payloads: bool = False, max_batch_bytes: int = 8388608, max_batch_rows: int = 0, max_batch_delay_ms: int = 10, stream_chunk_size: int = 0, num_parse_workers: int = 0, projection: typing.List[str] = [], payload_format: str = 'json', capture_path: str = '') -> None: ...
     pass
 class InferenceClientStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, server_url: str, model_name: str, needs_logits: bool, input_mapping: typing.Dict[str, str] = {}, output_mapping: typing.Dict[str, str] = {}) -> None: ...
+    @typing.overload
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, model_store: morpheus._lib.common.DenseModelStore, needs_logits: bool, input_mapping: typing.Dict[str, str] = {}, output_mapping: typing.Dict[str, str] = {}, max_batch_rows: int = 0, max_batch_delay_ms: int = 1, num_sessions: int = 1) -> None: ...
+    @typing.overload
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, server_url: str, model_name: str, needs_logits: bool, input_mapping: typing.Dict[str, str] = {}, output_mapping: typing.Dict[str, str] = {}, use_cuda_graphs: bool = False, use_shared_memory: bool = False, max_concurrent_batches: int = 1, max_batch_rows: int = 0, max_batch_delay_ms: int = 1, num_connections: int = 1, hedge_requests: bool = False, cache_size: int = 0, warm_up: bool = False, ragged_offsets_input: str = '', ragged_token_outputs: typing.List[str] = []) -> None: ...
     pass
 class KafkaSourceStage(mrc.core.segment.SegmentObject):
     @typing.overload
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, max_batch_size: int, topic: str, batch_timeout_ms: int, config: typing.Dict[str, str], disable_commits: bool = False, disable_pre_filtering: bool = False, stop_after: int = 0, async_commits: bool = True, oauth_callback: typing.Optional[function] = None) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, max_batch_size: int, topic: str, batch_timeout_ms: int, config: typing.Dict[str, str], disable_commits: bool = False, disable_pre_filtering: bool = False, stop_after: int = 0, async_commits: bool = True, oauth_callback: typing.Optional[function] = None, gpu_pre_filtering: bool = False, parallel_partitions: bool = False, latency_target_ms: int = 0, commit_on_ack: bool = False, device_ids: typing.List[int] = [], schema: typing.List[typing.Tuple[str, str]] = [], projection: typing.List[str] = [], payload_format: str = 'json', placement: str = '', capture_path: str = '') -> None: ...
     @typing.overload
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, max_batch_size: int, topics: typing.List[str], batch_timeout_ms: int, config: typing.Dict[str, str], disable_commits: bool = False, disable_pre_filtering: bool = False, stop_after: int = 0, async_commits: bool = True, oauth_callback: typing.Optional[function] = None) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, max_batch_size: int, topics: typing.List[str], batch_timeout_ms: int, config: typing.Dict[str, str], disable_commits: bool = False, disable_pre_filtering: bool = False, stop_after: int = 0, async_commits: bool = True, oauth_callback: typing.Optional[function] = None, gpu_pre_filtering: bool = False, parallel_partitions: bool = False, latency_target_ms: int = 0, commit_on_ack: bool = False, device_ids: typing.List[int] = [], schema: typing.List[typing.Tuple[str, str]] = [], projection: typing.List[str] = [], payload_format: str = 'json', placement: str = '', capture_path: str = '') -> None: ...
+    pass
+class LoadSheddingStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, priority_column: str, min_rates: typing.Dict[str, float], pressure_metric: str, pressure_labels: typing.Dict[str, str] = {}, from_histogram: bool = False, low_watermark: float = 0.0, high_watermark: float = 1.0, seed: int = 0) -> None: ...
+    pass
+class LogParsingPostprocessStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, vocab_path: str, id2label: typing.Dict[int, str]) -> None: ...
+    pass
+class MonitorControlMessageStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, description: str, report_interval_ms: int = 1000, log_progress: bool = True) -> None: ...
+    pass
+class MonitorMessageMetaStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, description: str, report_interval_ms: int = 1000, log_progress: bool = True) -> None: ...
+    pass
+class MonitorMultiMessageStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, description: str, report_interval_ms: int = 1000, log_progress: bool = True) -> None: ...
+    pass
+class MultiFileSourceStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, filenames: typing.List[str], num_readers: int = 4, preserve_order: bool = True, parser_kwargs: dict = {}, batch_rows: int = 0, files_per_read: int = 16) -> None: ...
+    pass
+class NormalizeEmbeddingsStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, tensor_name: str = 'probs', output_type: morpheus._lib.common.TypeId = morpheus._lib.common.TypeId.FLOAT16, normalize: bool = True) -> None: ...
+    pass
+class NvmlSourceStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, interval_ms: int = 1000, polls_per_message: int = 1, max_polls: int = 0) -> None: ...
+    pass
+class PartitionSelectControlMessageStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, partition: int) -> None: ...
+    pass
+class PartitionSelectMessageMetaStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, partition: int) -> None: ...
     pass
 class PreallocateMessageMetaStage(mrc.core.segment.SegmentObject):
     def __init__(self, builder: mrc.core.segment.Builder, name: str, needed_columns: typing.List[typing.Tuple[str, morpheus._lib.common.TypeId]]) -> None: ...
@@ -83,6 +188,12 @@ class PreallocateMessageMetaStage(mrc.core.segment.SegmentObject):
 class PreallocateMultiMessageStage(mrc.core.segment.SegmentObject):
     def __init__(self, builder: mrc.core.segment.Builder, name: str, needed_columns: typing.List[typing.Tuple[str, morpheus._lib.common.TypeId]]) -> None: ...
     pass
+class PreprocessAEControlMessageStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, scalers: morpheus._lib.common.FeatureScalers, model_store: typing.Optional[morpheus._lib.common.DenseModelStore] = None, user_id_key: str = 'user_id') -> None: ...
+    pass
+class PreprocessAEMultiMessageStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, scalers: morpheus._lib.common.FeatureScalers) -> None: ...
+    pass
 class PreprocessFILControlMessageStage(mrc.core.segment.SegmentObject):
     def __init__(self, builder: mrc.core.segment.Builder, name: str, features: typing.List[str]) -> None: ...
     pass
@@ -90,10 +201,16 @@ class PreprocessFILMultiMessageStage(mrc.core.segment.SegmentObject):
     def __init__(self, builder: mrc.core.segment.Builder, name: str, features: typing.List[str]) -> None: ...
     pass
 class PreprocessNLPControlMessageStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, vocab_hash_file: str, sequence_length: int, truncation: bool, do_lower_case: bool, add_special_token: bool, stride: int, column: str) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, vocab_hash_file: str, sequence_length: int, truncation: bool, do_lower_case: bool, add_special_token: bool, stride: int, column: str, uint32_tokens: bool = False, sequence_length_buckets: typing.List[int] = [], tokenizer: typing.Optional[morpheus._lib.common.Tokenizer] = None) -> None: ...
     pass
 class PreprocessNLPMultiMessageStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, vocab_hash_file: str, sequence_length: int, truncation: bool, do_lower_case: bool, add_special_token: bool, stride: int, column: str) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, vocab_hash_file: str, sequence_length: int, truncation: bool, do_lower_case: bool, add_special_token: bool, stride: int, column: str, uint32_tokens: bool = False, sequence_length_buckets: typing.List[int] = [], tokenizer: typing.Optional[morpheus._lib.common.Tokenizer] = None) -> None: ...
+    pass
+class ReplaySourceStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, filename: os.PathLike, speed: float = 1.0, repeat: int = 1) -> None: ...
+    pass
+class RollingWindowStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, timestamp_column: str, min_history: int, min_increment: int, max_history_rows: int = 0, max_history_ns: int = 0, max_device_bytes: int = 0, checkpoint_interval_ms: int = 0) -> None: ...
     pass
 class SerializeControlMessageStage(mrc.core.segment.SegmentObject):
     def __init__(self, builder: mrc.core.segment.Builder, name: str, include: typing.List[str], exclude: typing.List[str], fixed_columns: bool = True) -> None: ...
@@ -101,7 +218,37 @@ class SerializeControlMessageStage(mrc.core.segment.SegmentObject):
 class SerializeMultiMessageStage(mrc.core.segment.SegmentObject):
     def __init__(self, builder: mrc.core.segment.Builder, name: str, include: typing.List[str], exclude: typing.List[str], fixed_columns: bool = True) -> None: ...
     pass
+class SplitUsersStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, userid_column: str, fallback_username: str, include_generic: bool, include_individual: bool, skip_users: typing.List[str] = [], only_users: typing.List[str] = []) -> None: ...
+    pass
+class TimestampControlMessageStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, stage_name: str, is_exit: bool, sample_interval: int = 0) -> None: ...
+    pass
+class TimestampMessageMetaStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, stage_name: str, is_exit: bool, sample_interval: int = 0) -> None: ...
+    pass
+class TimestampMultiMessageStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, stage_name: str, is_exit: bool, sample_interval: int = 0) -> None: ...
+    pass
+class UcxEgressStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, address: str, port: int, connect_timeout_ms: int = 60000) -> None: ...
+    pass
+class UcxIngressStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, bind_address: str, port: int) -> None: ...
+    pass
+class WindowAggregateStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, key_columns: typing.List[str], timestamp_column: str, aggregations: typing.Dict[str, typing.List[str]], window_ns: int, slide_ns: int = 0, allowed_lateness_ns: int = 0) -> None: ...
+    pass
+class WriteToElasticsearchStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, host: str, port: int, index: str, headers: typing.Dict[str, str] = {}, max_bulk_bytes: int = 5242880, max_bulk_docs: int = 5000, max_concurrent_requests: int = 8, max_retries: int = 5, retry_interval: float = 0.5, raise_on_exception: bool = False) -> None: ...
+    pass
+class WriteToFileControlMessageStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, filename: str, mode: str = 'w', file_type: morpheus._lib.common.FileTypes = FileTypes.Auto, include_index_col: bool = True, flush: bool = False, compression: str = '', row_group_size_rows: int = 0, max_file_bytes: int = 0, max_file_age_secs: int = 0, max_queued_writes: int = 0, device_write: bool = False, num_shards: int = 1, shard_column: str = '') -> None: ...
+    pass
 class WriteToFileStage(mrc.core.segment.SegmentObject):
-    def __init__(self, builder: mrc.core.segment.Builder, name: str, filename: str, mode: str = 'w', file_type: morpheus._lib.common.FileTypes = FileTypes.Auto, include_index_col: bool = True, flush: bool = False) -> None: ...
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, filename: str, mode: str = 'w', file_type: morpheus._lib.common.FileTypes = FileTypes.Auto, include_index_col: bool = True, flush: bool = False, compression: str = '', row_group_size_rows: int = 0, max_file_bytes: int = 0, max_file_age_secs: int = 0, max_queued_writes: int = 0, device_write: bool = False, num_shards: int = 1, shard_column: str = '') -> None: ...
+    pass
+class WriteToKafkaStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, topic: str, config: typing.Dict[str, str], key_column: typing.Optional[str] = None, poll_interval_ms: int = 100, consumer_group_id: typing.Optional[str] = None, transaction_interval: float = 1.0) -> None: ...
     pass
 __version__ = '24.3.0'
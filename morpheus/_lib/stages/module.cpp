@@ -21,17 +21,42 @@
 #include "morpheus/objects/file_types.hpp"
 #include "morpheus/stages/add_classification.hpp"
 #include "morpheus/stages/add_scores.hpp"
+#include "morpheus/stages/appshield_features.hpp"
+#include "morpheus/stages/cidr_lookup.hpp"
+#include "morpheus/stages/cuda_ipc.hpp"
+#include "morpheus/stages/deduplicate.hpp"
 #include "morpheus/stages/deserialize.hpp"
+#include "morpheus/stages/enrich.hpp"
 #include "morpheus/stages/file_source.hpp"
 #include "morpheus/stages/filter_detection.hpp"
+#include "morpheus/stages/filter_rows.hpp"
+#include "morpheus/stages/grouped_dense_inference.hpp"
+#include "morpheus/stages/hash_partition.hpp"
+#include "morpheus/stages/http_client_sink_stage.hpp"
 #include "morpheus/stages/http_server_source_stage.hpp"
 #include "morpheus/stages/inference_client_stage.hpp"
 #include "morpheus/stages/kafka_source.hpp"
+#include "morpheus/stages/load_shedding.hpp"
+#include "morpheus/stages/log_parsing_postprocess.hpp"
+#include "morpheus/stages/monitor.hpp"
+#include "morpheus/stages/multi_file_source.hpp"
+#include "morpheus/stages/normalize_embeddings.hpp"
+#include "morpheus/stages/nvml_source.hpp"
 #include "morpheus/stages/preallocate.hpp"
+#include "morpheus/stages/preprocess_ae.hpp"
 #include "morpheus/stages/preprocess_fil.hpp"
 #include "morpheus/stages/preprocess_nlp.hpp"
+#include "morpheus/stages/replay_source.hpp"
+#include "morpheus/stages/rolling_window.hpp"
 #include "morpheus/stages/serialize.hpp"
+#include "morpheus/stages/split_users.hpp"
+#include "morpheus/stages/timestamp.hpp"
+#include "morpheus/stages/ucx_boundary.hpp"
+#include "morpheus/stages/window_aggregate.hpp"
+#include "morpheus/stages/write_to_elasticsearch.hpp"
 #include "morpheus/stages/write_to_file.hpp"
+#include "morpheus/stages/write_to_kafka.hpp"
+#include "morpheus/types.hpp"
 #include "morpheus/utilities/cudf_util.hpp"
 #include "morpheus/utilities/http_server.hpp"
 #include "morpheus/version.hpp"
@@ -42,14 +67,17 @@
 #include <pybind11/attr.h>            // for multiple_inheritance
 #include <pybind11/pybind11.h>        // for arg, init, class_, module_, str_attr_accessor, PYBIND11_MODULE, pybind11
 #include <pybind11/pytypes.h>         // for dict, sequence
+#include <pybind11/stl.h>             // IWYU pragma: keep
 #include <pybind11/stl/filesystem.h>  // IWYU pragma: keep
 #include <pymrc/utils.hpp>            // for pymrc::import
 #include <rxcpp/rx.hpp>
 
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace morpheus {
 namespace py = pybind11;
@@ -80,7 +108,10 @@ PYBIND11_MODULE(stages, _module)
              py::arg("builder"),
              py::arg("name"),
              py::arg("idx2label"),
-             py::arg("threshold"));
+             py::arg("threshold"),
+             py::arg("top_k")         = 0,
+             py::arg("top_k_prefix")  = "",
+             py::arg("packed_column") = "");
 
     py::class_<mrc::segment::Object<AddClassificationsStageCM>,
                mrc::segment::ObjectProperties,
@@ -90,7 +121,10 @@ PYBIND11_MODULE(stages, _module)
              py::arg("builder"),
              py::arg("name"),
              py::arg("idx2label"),
-             py::arg("threshold"));
+             py::arg("threshold"),
+             py::arg("top_k")         = 0,
+             py::arg("top_k_prefix")  = "",
+             py::arg("packed_column") = "");
 
     py::class_<mrc::segment::Object<AddScoresStageMM>,
                mrc::segment::ObjectProperties,
@@ -99,7 +133,9 @@ PYBIND11_MODULE(stages, _module)
         .def(py::init<>(&AddScoresStageInterfaceProxy::init_multi),
              py::arg("builder"),
              py::arg("name"),
-             py::arg("idx2label"));
+             py::arg("idx2label"),
+             py::arg("top_k")        = 0,
+             py::arg("top_k_prefix") = "");
 
     py::class_<mrc::segment::Object<AddScoresStageCM>,
                mrc::segment::ObjectProperties,
@@ -108,7 +144,67 @@ PYBIND11_MODULE(stages, _module)
         .def(py::init<>(&AddScoresStageInterfaceProxy::init_cm),
              py::arg("builder"),
              py::arg("name"),
-             py::arg("idx2label"));
+             py::arg("idx2label"),
+             py::arg("top_k")        = 0,
+             py::arg("top_k_prefix") = "");
+
+    py::class_<mrc::segment::Object<AppShieldFeaturesStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<AppShieldFeaturesStage>>>(
+        _module, "AppShieldFeaturesStage", py::multiple_inheritance())
+        .def(py::init<>(&AppShieldFeaturesStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("feature_columns"),
+             py::arg("file_extns"));
+
+    py::class_<mrc::segment::Object<CidrLookupStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<CidrLookupStage>>>(
+        _module, "CidrLookupStage", py::multiple_inheritance())
+        .def(py::init<>(&CidrLookupStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("filename"),
+             py::arg("file_type"),
+             py::arg("network_column"),
+             py::arg("label_columns"),
+             py::arg("address_columns"));
+
+    py::class_<mrc::segment::Object<CudaIpcSinkStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<CudaIpcSinkStage>>>(
+        _module, "CudaIpcSinkStage", py::multiple_inheritance())
+        .def(py::init<>(&CudaIpcSinkStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("ring_name"),
+             py::arg("num_slots")        = 64,
+             py::arg("max_header_bytes") = 65536,
+             py::arg("close_timeout_ms") = 60000);
+
+    py::class_<mrc::segment::Object<CudaIpcSourceStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<CudaIpcSourceStage>>>(
+        _module, "CudaIpcSourceStage", py::multiple_inheritance())
+        .def(py::init<>(&CudaIpcSourceStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("ring_name"),
+             py::arg("open_timeout_ms") = 60000);
+
+    py::class_<mrc::segment::Object<DeduplicateStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<DeduplicateStage>>>(
+        _module, "DeduplicateStage", py::multiple_inheritance())
+        .def(py::init<>(&DeduplicateStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("key_columns"),
+             py::arg("window_ms")              = 300000,
+             py::arg("num_buckets")            = 10,
+             py::arg("max_keys")               = 10000000,
+             py::arg("checkpoint_interval_ms") = 0);
 
     py::class_<mrc::segment::Object<DeserializeStage<MultiMessage>>,
                mrc::segment::ObjectProperties,
@@ -118,7 +214,9 @@ PYBIND11_MODULE(stages, _module)
              py::arg("builder"),
              py::arg("name"),
              py::arg("batch_size"),
-             py::arg("ensure_sliceable_index") = true);
+             py::arg("ensure_sliceable_index") = true,
+             py::arg("coalesce")               = false,
+             py::arg("max_linger_ms")          = 0);
 
     py::class_<mrc::segment::Object<DeserializeStage<ControlMessage>>,
                mrc::segment::ObjectProperties,
@@ -130,39 +228,143 @@ PYBIND11_MODULE(stages, _module)
              py::arg("batch_size"),
              py::arg("ensure_sliceable_index") = true,
              py::arg("task_type")              = py::none(),
-             py::arg("task_payload")           = py::none());
+             py::arg("task_payload")           = py::none(),
+             py::arg("coalesce")               = false,
+             py::arg("max_linger_ms")          = 0);
+
+    py::class_<mrc::segment::Object<EnrichStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<EnrichStage>>>(
+        _module, "EnrichStage", py::multiple_inheritance())
+        .def(py::init<>(&EnrichStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("filename"),
+             py::arg("file_type"),
+             py::arg("key_columns"),
+             py::arg("value_columns")      = std::vector<std::string>{},
+             py::arg("event_key_columns")  = std::vector<std::string>{},
+             py::arg("prefix")             = "",
+             py::arg("reload_interval_ms") = 0);
+
+    py::class_<mrc::segment::Object<FanOutInferenceClientStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<FanOutInferenceClientStage>>>(
+        _module, "FanOutInferenceClientStage", py::multiple_inheritance())
+        .def(py::init<>(&FanOutInferenceClientStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("server_url"),
+             py::arg("model_output_mappings"),
+             py::arg("needs_logits"),
+             py::arg("input_mapping")          = py::dict(),
+             py::arg("use_cuda_graphs")        = false,
+             py::arg("use_shared_memory")      = false,
+             py::arg("max_concurrent_batches") = 1,
+             py::arg("max_batch_rows")         = 0,
+             py::arg("max_batch_delay_ms")     = 1,
+             py::arg("num_connections")        = 1,
+             py::arg("hedge_requests")         = false,
+             py::arg("cache_size")             = 0,
+             py::arg("warm_up")                = false,
+             py::arg("ragged_offsets_input")   = "",
+             py::arg("ragged_token_outputs")   = std::vector<std::string>());
 
     py::class_<mrc::segment::Object<FileSourceStage>,
                mrc::segment::ObjectProperties,
                std::shared_ptr<mrc::segment::Object<FileSourceStage>>>(
         _module, "FileSourceStage", py::multiple_inheritance())
-        .def(py::init(py::overload_cast<mrc::segment::Builder&, const std::string&, std::string, int, py::dict>(
+        .def(py::init(py::overload_cast<mrc::segment::Builder&,
+                                        const std::string&,
+                                        std::string,
+                                        int,
+                                        py::dict,
+                                        std::size_t,
+                                        std::vector<std::pair<std::string, std::string>>,
+                                        const std::vector<std::string>&>(
                  &FileSourceStageInterfaceProxy::init)),
              py::arg("builder"),
              py::arg("name"),
              py::arg("filename"),
              py::arg("repeat"),
-             py::arg("parser_kwargs"))
-        .def(py::init(
-                 py::overload_cast<mrc::segment::Builder&, const std::string&, std::filesystem::path, int, py::dict>(
-                     &FileSourceStageInterfaceProxy::init)),
+             py::arg("parser_kwargs"),
+             py::arg("chunk_bytes") = 0,
+             py::arg("schema")      = std::vector<std::pair<std::string, std::string>>(),
+             py::arg("projection")  = std::vector<std::string>())
+        .def(py::init(py::overload_cast<mrc::segment::Builder&,
+                                        const std::string&,
+                                        std::filesystem::path,
+                                        int,
+                                        py::dict,
+                                        std::size_t,
+                                        std::vector<std::pair<std::string, std::string>>,
+                                        const std::vector<std::string>&>(
+                 &FileSourceStageInterfaceProxy::init)),
              py::arg("builder"),
              py::arg("name"),
              py::arg("filename"),
              py::arg("repeat"),
-             py::arg("parser_kwargs"));
+             py::arg("parser_kwargs"),
+             py::arg("chunk_bytes") = 0,
+             py::arg("schema")      = std::vector<std::pair<std::string, std::string>>(),
+             py::arg("projection")  = std::vector<std::string>());
+
+    py::class_<mrc::segment::Object<FilterDetectionsStageMM>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<FilterDetectionsStageMM>>>(
+        _module, "FilterDetectionsMultiMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&FilterDetectionStageInterfaceProxy::init_multi),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("threshold"),
+             py::arg("copy"),
+             py::arg("filter_source"),
+             py::arg("field_name")  = "probs",
+             py::arg("mask_column") = "");
 
-    py::class_<mrc::segment::Object<FilterDetectionsStage>,
+    py::class_<mrc::segment::Object<FilterDetectionsStageCM>,
                mrc::segment::ObjectProperties,
-               std::shared_ptr<mrc::segment::Object<FilterDetectionsStage>>>(
-        _module, "FilterDetectionsStage", py::multiple_inheritance())
-        .def(py::init<>(&FilterDetectionStageInterfaceProxy::init),
+               std::shared_ptr<mrc::segment::Object<FilterDetectionsStageCM>>>(
+        _module, "FilterDetectionsControlMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&FilterDetectionStageInterfaceProxy::init_cm),
              py::arg("builder"),
              py::arg("name"),
              py::arg("threshold"),
              py::arg("copy"),
              py::arg("filter_source"),
-             py::arg("field_name") = "probs");
+             py::arg("field_name")  = "probs",
+             py::arg("mask_column") = "");
+
+    py::class_<mrc::segment::Object<FilterRowsStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<FilterRowsStage>>>(
+        _module, "FilterRowsStage", py::multiple_inheritance())
+        .def(py::init<>(&FilterRowsStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("predicates"),
+             py::arg("match_all") = true,
+             py::arg("exclude")   = false);
+
+    py::class_<mrc::segment::Object<HashPartitionStageMeta>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<HashPartitionStageMeta>>>(
+        _module, "HashPartitionMessageMetaStage", py::multiple_inheritance())
+        .def(py::init<>(&HashPartitionStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("key_columns"),
+             py::arg("num_partitions"));
+
+    py::class_<mrc::segment::Object<HashPartitionStageCM>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<HashPartitionStageCM>>>(
+        _module, "HashPartitionControlMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&HashPartitionStageInterfaceProxy::init_cm),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("key_columns"),
+             py::arg("num_partitions"));
 
     py::class_<mrc::segment::Object<InferenceClientStage>,
                mrc::segment::ObjectProperties,
@@ -174,8 +376,29 @@ PYBIND11_MODULE(stages, _module)
              py::arg("server_url"),
              py::arg("model_name"),
              py::arg("needs_logits"),
-             py::arg("input_mapping")  = py::dict(),
-             py::arg("output_mapping") = py::dict());
+             py::arg("input_mapping")          = py::dict(),
+             py::arg("output_mapping")         = py::dict(),
+             py::arg("use_cuda_graphs")        = false,
+             py::arg("use_shared_memory")      = false,
+             py::arg("max_concurrent_batches") = 1,
+             py::arg("max_batch_rows")         = 0,
+             py::arg("max_batch_delay_ms")     = 1,
+             py::arg("num_connections")        = 1,
+             py::arg("hedge_requests")         = false,
+             py::arg("cache_size")             = 0,
+             py::arg("warm_up")                = false,
+             py::arg("ragged_offsets_input")   = "",
+             py::arg("ragged_token_outputs")   = std::vector<std::string>())
+        .def(py::init<>(&GroupedDenseInferenceStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("model_store"),
+             py::arg("needs_logits"),
+             py::arg("input_mapping")      = py::dict(),
+             py::arg("output_mapping")     = py::dict(),
+             py::arg("max_batch_rows")     = 0,
+             py::arg("max_batch_delay_ms") = 1,
+             py::arg("num_sessions")       = 1);
 
     py::class_<mrc::segment::Object<KafkaSourceStage>,
                mrc::segment::ObjectProperties,
@@ -192,7 +415,17 @@ PYBIND11_MODULE(stages, _module)
              py::arg("disable_pre_filtering") = false,
              py::arg("stop_after")            = 0,
              py::arg("async_commits")         = true,
-             py::arg("oauth_callback")        = py::none())
+             py::arg("oauth_callback")        = py::none(),
+             py::arg("gpu_pre_filtering")     = false,
+             py::arg("parallel_partitions")   = false,
+             py::arg("latency_target_ms")     = 0,
+             py::arg("commit_on_ack")         = false,
+             py::arg("device_ids")            = std::vector<int>{},
+             py::arg("schema")                = std::vector<std::pair<std::string, std::string>>(),
+             py::arg("projection")            = std::vector<std::string>(),
+             py::arg("payload_format")        = "json",
+             py::arg("placement")             = "",
+             py::arg("capture_path")          = "")
         .def(py::init<>(&KafkaSourceStageInterfaceProxy::init_with_multiple_topics),
              py::arg("builder"),
              py::arg("name"),
@@ -204,7 +437,163 @@ PYBIND11_MODULE(stages, _module)
              py::arg("disable_pre_filtering") = false,
              py::arg("stop_after")            = 0,
              py::arg("async_commits")         = true,
-             py::arg("oauth_callback")        = py::none());
+             py::arg("oauth_callback")        = py::none(),
+             py::arg("gpu_pre_filtering")     = false,
+             py::arg("parallel_partitions")   = false,
+             py::arg("latency_target_ms")     = 0,
+             py::arg("commit_on_ack")         = false,
+             py::arg("device_ids")            = std::vector<int>{},
+             py::arg("schema")                = std::vector<std::pair<std::string, std::string>>(),
+             py::arg("projection")            = std::vector<std::string>(),
+             py::arg("payload_format")        = "json",
+             py::arg("placement")             = "",
+             py::arg("capture_path")          = "");
+
+    py::class_<mrc::segment::Object<LoadSheddingStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<LoadSheddingStage>>>(
+        _module, "LoadSheddingStage", py::multiple_inheritance())
+        .def(py::init<>(&LoadSheddingStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("priority_column"),
+             py::arg("min_rates"),
+             py::arg("pressure_metric"),
+             py::arg("pressure_labels") = std::map<std::string, std::string>{},
+             py::arg("from_histogram")  = false,
+             py::arg("low_watermark")   = 0.0,
+             py::arg("high_watermark")  = 1.0,
+             py::arg("seed")            = 0);
+
+    py::class_<mrc::segment::Object<LogParsingPostprocessStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<LogParsingPostprocessStage>>>(
+        _module, "LogParsingPostprocessStage", py::multiple_inheritance())
+        .def(py::init<>(&LogParsingPostprocessStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("vocab_path"),
+             py::arg("id2label"));
+
+    py::class_<mrc::segment::Object<MonitorStage<MessageMeta>>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<MonitorStage<MessageMeta>>>>(
+        _module, "MonitorMessageMetaStage", py::multiple_inheritance())
+        .def(py::init<>(&MonitorStageInterfaceProxy<MessageMeta>::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("description"),
+             py::arg("report_interval_ms") = 1000,
+             py::arg("log_progress")       = true);
+
+    py::class_<mrc::segment::Object<MonitorStage<MultiMessage>>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<MonitorStage<MultiMessage>>>>(
+        _module, "MonitorMultiMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&MonitorStageInterfaceProxy<MultiMessage>::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("description"),
+             py::arg("report_interval_ms") = 1000,
+             py::arg("log_progress")       = true);
+
+    py::class_<mrc::segment::Object<MonitorStage<ControlMessage>>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<MonitorStage<ControlMessage>>>>(
+        _module, "MonitorControlMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&MonitorStageInterfaceProxy<ControlMessage>::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("description"),
+             py::arg("report_interval_ms") = 1000,
+             py::arg("log_progress")       = true);
+
+    py::class_<mrc::segment::Object<TimestampStage<MessageMeta>>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<TimestampStage<MessageMeta>>>>(
+        _module, "TimestampMessageMetaStage", py::multiple_inheritance())
+        .def(py::init<>(&TimestampStageInterfaceProxy<MessageMeta>::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("stage_name"),
+             py::arg("is_exit"),
+             py::arg("sample_interval") = 0);
+
+    py::class_<mrc::segment::Object<TimestampStage<MultiMessage>>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<TimestampStage<MultiMessage>>>>(
+        _module, "TimestampMultiMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&TimestampStageInterfaceProxy<MultiMessage>::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("stage_name"),
+             py::arg("is_exit"),
+             py::arg("sample_interval") = 0);
+
+    py::class_<mrc::segment::Object<TimestampStage<ControlMessage>>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<TimestampStage<ControlMessage>>>>(
+        _module, "TimestampControlMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&TimestampStageInterfaceProxy<ControlMessage>::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("stage_name"),
+             py::arg("is_exit"),
+             py::arg("sample_interval") = 0);
+
+    py::class_<mrc::segment::Object<MultiFileSourceStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<MultiFileSourceStage>>>(
+        _module, "MultiFileSourceStage", py::multiple_inheritance())
+        .def(py::init<>(&MultiFileSourceStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("filenames"),
+             py::arg("num_readers")    = 4,
+             py::arg("preserve_order") = true,
+             py::arg("parser_kwargs")  = py::dict(),
+             py::arg("batch_rows")     = 0,
+             py::arg("files_per_read") = 16);
+
+    py::class_<mrc::segment::Object<NormalizeEmbeddingsStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<NormalizeEmbeddingsStage>>>(
+        _module, "NormalizeEmbeddingsStage", py::multiple_inheritance())
+        .def(py::init<>(&NormalizeEmbeddingsStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("tensor_name") = "probs",
+             py::arg("output_type") = TypeId::FLOAT16,
+             py::arg("normalize")   = true);
+
+    py::class_<mrc::segment::Object<NvmlSourceStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<NvmlSourceStage>>>(
+        _module, "NvmlSourceStage", py::multiple_inheritance())
+        .def(py::init<>(&NvmlSourceStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("interval_ms")       = 1000,
+             py::arg("polls_per_message") = 1,
+             py::arg("max_polls")         = 0);
+
+    py::class_<mrc::segment::Object<PartitionSelectStageMeta>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<PartitionSelectStageMeta>>>(
+        _module, "PartitionSelectMessageMetaStage", py::multiple_inheritance())
+        .def(py::init<>(&PartitionSelectStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("partition"));
+
+    py::class_<mrc::segment::Object<PartitionSelectStageCM>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<PartitionSelectStageCM>>>(
+        _module, "PartitionSelectControlMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&PartitionSelectStageInterfaceProxy::init_cm),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("partition"));
 
     py::class_<mrc::segment::Object<PreallocateStage<MessageMeta>>,
                mrc::segment::ObjectProperties,
@@ -224,6 +613,26 @@ PYBIND11_MODULE(stages, _module)
              py::arg("name"),
              py::arg("needed_columns"));
 
+    py::class_<mrc::segment::Object<PreprocessAEStageMM>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<PreprocessAEStageMM>>>(
+        _module, "PreprocessAEMultiMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&PreprocessAEStageInterfaceProxy::init_multi),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("scalers"));
+
+    py::class_<mrc::segment::Object<PreprocessAEStageCM>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<PreprocessAEStageCM>>>(
+        _module, "PreprocessAEControlMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&PreprocessAEStageInterfaceProxy::init_cm),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("scalers"),
+             py::arg("model_store") = nullptr,
+             py::arg("user_id_key") = "user_id");
+
     py::class_<mrc::segment::Object<PreprocessFILStageMM>,
                mrc::segment::ObjectProperties,
                std::shared_ptr<mrc::segment::Object<PreprocessFILStageMM>>>(
@@ -255,7 +664,10 @@ PYBIND11_MODULE(stages, _module)
              py::arg("do_lower_case"),
              py::arg("add_special_token"),
              py::arg("stride"),
-             py::arg("column"));
+             py::arg("column"),
+             py::arg("uint32_tokens")           = false,
+             py::arg("sequence_length_buckets") = std::vector<TensorIndex>{},
+             py::arg("tokenizer")               = py::none());
 
     py::class_<mrc::segment::Object<PreprocessNLPStageCM>,
                mrc::segment::ObjectProperties,
@@ -270,7 +682,31 @@ PYBIND11_MODULE(stages, _module)
              py::arg("do_lower_case"),
              py::arg("add_special_token"),
              py::arg("stride"),
-             py::arg("column"));
+             py::arg("column"),
+             py::arg("uint32_tokens")           = false,
+             py::arg("sequence_length_buckets") = std::vector<TensorIndex>{},
+             py::arg("tokenizer")               = py::none());
+
+    py::class_<mrc::segment::Object<HttpClientSinkStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<HttpClientSinkStage>>>(
+        _module, "HttpClientSinkStage", py::multiple_inheritance())
+        .def(py::init<>(&HttpClientSinkStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("host"),
+             py::arg("port"),
+             py::arg("target"),
+             py::arg("method")                     = "POST",
+             py::arg("headers")                    = std::map<std::string, std::string>{},
+             py::arg("error_sleep_time")           = 0.1f,
+             py::arg("respect_retry_after_header") = true,
+             py::arg("request_timeout")            = 30,
+             py::arg("accept_status_codes")        = std::vector<unsigned>{200, 201, 202},
+             py::arg("max_retries")                = 10,
+             py::arg("max_rows_per_payload")       = 10000,
+             py::arg("lines")                      = false,
+             py::arg("max_connections")            = 8);
 
     py::class_<mrc::segment::Object<HttpServerSourceStage>,
                mrc::segment::ObjectProperties,
@@ -291,7 +727,42 @@ PYBIND11_MODULE(stages, _module)
              py::arg("max_payload_size")   = DefaultMaxPayloadSize,
              py::arg("request_timeout")    = 30,
              py::arg("lines")              = false,
-             py::arg("stop_after")         = 0);
+             py::arg("stop_after")         = 0,
+             py::arg("coalesce_payloads")  = false,
+             py::arg("max_batch_bytes")    = DefaultMaxBatchBytes,
+             py::arg("max_batch_rows")     = 0,
+             py::arg("max_batch_delay_ms") = 10,
+             py::arg("stream_chunk_size")  = 0,
+             py::arg("num_parse_workers")  = 0,
+             py::arg("projection")         = std::vector<std::string>(),
+             py::arg("payload_format")     = "json",
+             py::arg("capture_path")       = "");
+
+    py::class_<mrc::segment::Object<ReplaySourceStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<ReplaySourceStage>>>(
+        _module, "ReplaySourceStage", py::multiple_inheritance())
+        .def(py::init<>(&ReplaySourceStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("filename"),
+             py::arg("speed")  = 1.0,
+             py::arg("repeat") = 1);
+
+    py::class_<mrc::segment::Object<RollingWindowStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<RollingWindowStage>>>(
+        _module, "RollingWindowStage", py::multiple_inheritance())
+        .def(py::init<>(&RollingWindowStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("timestamp_column"),
+             py::arg("min_history"),
+             py::arg("min_increment"),
+             py::arg("max_history_rows")       = 0,
+             py::arg("max_history_ns")         = 0,
+             py::arg("max_device_bytes")       = 0,
+             py::arg("checkpoint_interval_ms") = 0);
 
     py::class_<mrc::segment::Object<SerializeStageMM>,
                mrc::segment::ObjectProperties,
@@ -315,18 +786,128 @@ PYBIND11_MODULE(stages, _module)
              py::arg("exclude"),
              py::arg("fixed_columns") = true);
 
-    py::class_<mrc::segment::Object<WriteToFileStage>,
+    py::class_<mrc::segment::Object<SplitUsersStage>,
                mrc::segment::ObjectProperties,
-               std::shared_ptr<mrc::segment::Object<WriteToFileStage>>>(
+               std::shared_ptr<mrc::segment::Object<SplitUsersStage>>>(
+        _module, "SplitUsersStage", py::multiple_inheritance())
+        .def(py::init<>(&SplitUsersStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("userid_column"),
+             py::arg("fallback_username"),
+             py::arg("include_generic"),
+             py::arg("include_individual"),
+             py::arg("skip_users") = std::vector<std::string>{},
+             py::arg("only_users") = std::vector<std::string>{});
+
+    py::class_<mrc::segment::Object<UcxEgressStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<UcxEgressStage>>>(
+        _module, "UcxEgressStage", py::multiple_inheritance())
+        .def(py::init<>(&UcxEgressStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("address"),
+             py::arg("port"),
+             py::arg("connect_timeout_ms") = 60000);
+
+    py::class_<mrc::segment::Object<UcxIngressStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<UcxIngressStage>>>(
+        _module, "UcxIngressStage", py::multiple_inheritance())
+        .def(py::init<>(&UcxIngressStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("bind_address"),
+             py::arg("port"));
+
+    py::class_<mrc::segment::Object<WindowAggregateStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<WindowAggregateStage>>>(
+        _module, "WindowAggregateStage", py::multiple_inheritance())
+        .def(py::init<>(&WindowAggregateStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("key_columns"),
+             py::arg("timestamp_column"),
+             py::arg("aggregations"),
+             py::arg("window_ns"),
+             py::arg("slide_ns")            = 0,
+             py::arg("allowed_lateness_ns") = 0);
+
+    py::class_<mrc::segment::Object<WriteToElasticsearchStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<WriteToElasticsearchStage>>>(
+        _module, "WriteToElasticsearchStage", py::multiple_inheritance())
+        .def(py::init<>(&WriteToElasticsearchStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("host"),
+             py::arg("port"),
+             py::arg("index"),
+             py::arg("headers")                 = std::map<std::string, std::string>{},
+             py::arg("max_bulk_bytes")          = 5 << 20,
+             py::arg("max_bulk_docs")           = 5000,
+             py::arg("max_concurrent_requests") = 8,
+             py::arg("max_retries")             = 5,
+             py::arg("retry_interval")          = 0.5f,
+             py::arg("raise_on_exception")      = false);
+
+    py::class_<mrc::segment::Object<WriteToFileStageMeta>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<WriteToFileStageMeta>>>(
         _module, "WriteToFileStage", py::multiple_inheritance())
         .def(py::init<>(&WriteToFileStageInterfaceProxy::init),
              py::arg("builder"),
              py::arg("name"),
              py::arg("filename"),
-             py::arg("mode")              = "w",
-             py::arg("file_type")         = FileTypes::Auto,
-             py::arg("include_index_col") = true,
-             py::arg("flush")             = false);
+             py::arg("mode")                = "w",
+             py::arg("file_type")           = FileTypes::Auto,
+             py::arg("include_index_col")   = true,
+             py::arg("flush")               = false,
+             py::arg("compression")         = "",
+             py::arg("row_group_size_rows") = 0,
+             py::arg("max_file_bytes")      = 0,
+             py::arg("max_file_age_secs")   = 0,
+             py::arg("max_queued_writes")   = 0,
+             py::arg("device_write")        = false,
+             py::arg("num_shards")          = 1,
+             py::arg("shard_column")        = "");
+
+    py::class_<mrc::segment::Object<WriteToFileStageCM>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<WriteToFileStageCM>>>(
+        _module, "WriteToFileControlMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&WriteToFileStageInterfaceProxy::init_cm),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("filename"),
+             py::arg("mode")                = "w",
+             py::arg("file_type")           = FileTypes::Auto,
+             py::arg("include_index_col")   = true,
+             py::arg("flush")               = false,
+             py::arg("compression")         = "",
+             py::arg("row_group_size_rows") = 0,
+             py::arg("max_file_bytes")      = 0,
+             py::arg("max_file_age_secs")   = 0,
+             py::arg("max_queued_writes")   = 0,
+             py::arg("device_write")        = false,
+             py::arg("num_shards")          = 1,
+             py::arg("shard_column")        = "");
+
+    py::class_<mrc::segment::Object<WriteToKafkaStage>,
+               mrc::segment::ObjectProperties,
+               std::shared_ptr<mrc::segment::Object<WriteToKafkaStage>>>(
+        _module, "WriteToKafkaStage", py::multiple_inheritance())
+        .def(py::init<>(&WriteToKafkaStageInterfaceProxy::init),
+             py::arg("builder"),
+             py::arg("name"),
+             py::arg("topic"),
+             py::arg("config"),
+             py::arg("key_column")           = py::none(),
+             py::arg("poll_interval_ms")     = 100,
+             py::arg("consumer_group_id")    = py::none(),
+             py::arg("transaction_interval") = 1.0);
 
     _module.attr("__version__") =
         MRC_CONCAT_STR(morpheus_VERSION_MAJOR << "." << morpheus_VERSION_MINOR << "." << morpheus_VERSION_PATCH);
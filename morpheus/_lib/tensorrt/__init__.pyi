@@ -0,0 +1,14 @@
+from __future__ import annotations
+import morpheus._lib.tensorrt
+import typing
+import morpheus._lib.messages
+import mrc.core.segment
+
+__all__ = [
+    "TensorRTInferenceStage"
+]
+
+
+class TensorRTInferenceStage(mrc.core.segment.SegmentObject):
+    def __init__(self, builder: mrc.core.segment.Builder, name: str, engine_file: str, needs_logits: bool, input_mapping: typing.Dict[str, str] = {}, output_mapping: typing.Dict[str, str] = {}, use_cuda_graphs: bool = False, max_batch_rows: int = 0, max_batch_delay_ms: int = 1, num_sessions: int = 1) -> None: ...
+    pass
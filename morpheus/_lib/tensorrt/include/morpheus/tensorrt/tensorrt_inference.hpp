@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "morpheus/objects/tensor_buffer_pool.hpp"
+#include "morpheus/objects/triton_in_out.hpp"
+#include "morpheus/stages/inference_client_stage.hpp"
+#include "morpheus/types.hpp"
+
+#include <mrc/coroutines/scheduler.hpp>
+#include <mrc/coroutines/task.hpp>
+#include <mrc/segment/builder.hpp>
+#include <mrc/segment/object.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nvinfer1 {
+class IExecutionContext;
+}  // namespace nvinfer1
+
+namespace morpheus {
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief A deserialized TensorRT engine along with the runtime which owns it, shared by all of the sessions of a
+ * `TensorRTInferenceClient`.
+ */
+struct TensorRTEngine;
+
+/**
+ * @brief Runs inference in process on a TensorRT engine, avoiding the serialization, network and scheduling overhead
+ * of a request to Triton. Inputs are read from, and outputs written to, device memory of the `TensorMap` directly, with
+ * the engine enqueued on the same per-thread stream as the rest of the stage, so no copies or synchronization are
+ * needed.
+ *
+ * Each session has an execution context of its own and is not thread-safe.
+ */
+class TensorRTInferenceClientSession : public IInferenceClientSession
+{
+  public:
+    TensorRTInferenceClientSession(std::shared_ptr<const TensorRTEngine> engine);
+    ~TensorRTInferenceClientSession() override;
+
+    /**
+      @brief Gets the inference input mappings for TensorRT
+    */
+    std::vector<TensorModelMapping> get_input_mappings(std::vector<TensorModelMapping> input_map_overrides) override;
+
+    /**
+      @brief Gets the inference output mappings for TensorRT
+    */
+    std::vector<TensorModelMapping> get_output_mappings(std::vector<TensorModelMapping> output_map_overrides) override;
+
+    /**
+      @brief Enqueues inference on the engine, splitting the inputs into batches of the engine's maximum batch size
+    */
+    mrc::coroutines::Task<TensorMap> infer(TensorMap&& inputs, std::shared_ptr<mrc::coroutines::Scheduler> on) override;
+
+  private:
+    std::shared_ptr<const TensorRTEngine> m_engine;
+    std::unique_ptr<nvinfer1::IExecutionContext> m_context;
+    std::shared_ptr<TensorBufferPool> m_output_pool{TensorBufferPool::create()};
+};
+
+/**
+ * @brief Loads a serialized TensorRT engine, such as those written by `morpheus tools onnx-to-trt` or `trtexec`, which
+ * is shared by all of the sessions it creates. The engine must have a dynamic batch dimension.
+ */
+class TensorRTInferenceClient : public IInferenceClient
+{
+  public:
+    /**
+     * @brief Construct a new TensorRT Inference Client
+     *
+     * @param engine_file : Path of the serialized engine
+     */
+    TensorRTInferenceClient(const std::string& engine_file);
+
+    /**
+      @brief Creates a session with an execution context of its own
+    */
+    std::unique_ptr<IInferenceClientSession> create_session() override;
+
+  private:
+    std::shared_ptr<const TensorRTEngine> m_engine;
+};
+
+/****** TensorRTInferenceStage******************************/
+
+/**
+ * @brief `InferenceClientStage` running inference in process on a TensorRT engine with the `TensorRTInferenceClient`,
+ * rather than sending requests to Triton.
+ */
+class TensorRTInferenceStage : public InferenceClientStage
+{
+  public:
+    /**
+     * @brief Construct a new TensorRT Inference Stage object
+     *
+     * @param engine_file : Path of the serialized TensorRT engine
+     * @param needs_logits : Determines if logits are required.
+     * @param input_mapping : Maps pipeline input names to the names of the engine's inputs.
+     * @param output_mapping : Maps the names of the engine's outputs to pipeline output names.
+     * @param use_cuda_graphs : Launch the post-processing of all output tensors as a single CUDA graph.
+     * @param max_batch_rows : Maximum number of rows of a batch merging the inputs of several messages, or zero to
+     * infer each message separately.
+     * @param max_batch_delay : Maximum time a message waits for others to be merged with.
+     * @param num_sessions : Number of sessions, each with an execution context of its own.
+     */
+    TensorRTInferenceStage(const std::string& engine_file,
+                           bool needs_logits,
+                           std::vector<TensorModelMapping> input_mapping,
+                           std::vector<TensorModelMapping> output_mapping,
+                           bool use_cuda_graphs                      = false,
+                           TensorIndex max_batch_rows                = 0,
+                           std::chrono::milliseconds max_batch_delay = std::chrono::milliseconds(1),
+                           std::size_t num_sessions                  = 1);
+};
+
+/****** TensorRTInferenceStageInterfaceProxy****************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct TensorRTInferenceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a TensorRTInferenceStage, and return the result
+     */
+    static std::shared_ptr<mrc::segment::Object<TensorRTInferenceStage>> init(
+        mrc::segment::Builder& builder,
+        const std::string& name,
+        const std::string& engine_file,
+        bool needs_logits,
+        std::map<std::string, std::string> input_mapping,
+        std::map<std::string, std::string> output_mapping,
+        bool use_cuda_graphs,
+        TensorIndex max_batch_rows,
+        int64_t max_batch_delay_ms,
+        std::size_t num_sessions);
+};
+
+#pragma GCC visibility pop
+
+}  // namespace morpheus
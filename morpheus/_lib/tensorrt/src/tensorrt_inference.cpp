@@ -0,0 +1,428 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "morpheus/tensorrt/tensorrt_inference.hpp"
+
+#include "morpheus/objects/dtype.hpp"
+#include "morpheus/objects/tensor.hpp"
+#include "morpheus/objects/tensor_object.hpp"
+#include "morpheus/utilities/string_util.hpp"
+#include "morpheus/utilities/tensor_util.hpp"
+
+#include <NvInfer.h>
+#include <NvInferVersion.h>
+#include <glog/logging.h>
+#include <rmm/cuda_stream_view.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace morpheus {
+
+namespace {
+
+class TensorRTLogger : public nvinfer1::ILogger
+{
+  public:
+    void log(Severity severity, const char* msg) noexcept override
+    {
+        switch (severity)
+        {
+        case Severity::kINTERNAL_ERROR:
+        case Severity::kERROR:
+            LOG(ERROR) << "TensorRT: " << msg;
+            break;
+        case Severity::kWARNING:
+            LOG(WARNING) << "TensorRT: " << msg;
+            break;
+        case Severity::kINFO:
+            VLOG(1) << "TensorRT: " << msg;
+            break;
+        default:
+            VLOG(2) << "TensorRT: " << msg;
+            break;
+        }
+    }
+};
+
+DType dtype_from_tensorrt(nvinfer1::DataType data_type, const std::string& tensor_name)
+{
+    switch (data_type)
+    {
+    case nvinfer1::DataType::kFLOAT:
+        return DType(TypeId::FLOAT32);
+    case nvinfer1::DataType::kHALF:
+        return DType(TypeId::FLOAT16);
+    case nvinfer1::DataType::kINT8:
+        return DType(TypeId::INT8);
+    case nvinfer1::DataType::kINT32:
+        return DType(TypeId::INT32);
+    case nvinfer1::DataType::kBOOL:
+        return DType(TypeId::BOOL8);
+    case nvinfer1::DataType::kUINT8:
+        return DType(TypeId::UINT8);
+#if NV_TENSORRT_MAJOR >= 9
+    case nvinfer1::DataType::kBF16:
+        return DType(TypeId::BFLOAT16);
+#endif
+#if NV_TENSORRT_MAJOR >= 10
+    case nvinfer1::DataType::kINT64:
+        return DType(TypeId::INT64);
+#endif
+    default:
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Tensor '" << tensor_name << "' of the TensorRT engine has type "
+                                                                << static_cast<int>(data_type)
+                                                                << " which is not supported"));
+    }
+}
+
+std::vector<char> read_engine_file(const std::string& engine_file)
+{
+    std::ifstream file(engine_file, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Unable to open TensorRT engine '" << engine_file << "'"));
+    }
+
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+}  // namespace
+
+struct TensorRTEngine
+{
+    TensorRTLogger logger;
+
+    // The runtime must outlive the engines it deserialized
+    std::unique_ptr<nvinfer1::IRuntime> runtime;
+    std::unique_ptr<nvinfer1::ICudaEngine> engine;
+
+    // Optimization profile allowing the largest batches, used by every execution context
+    int32_t profile_index{0};
+    TensorIndex max_batch_size{0};
+
+    std::vector<TritonInOut> inputs;
+    std::vector<TritonInOut> outputs;
+};
+
+/****** Component public implementations *******************/
+/****** TensorRTInferenceClientSession**********************/
+
+TensorRTInferenceClientSession::TensorRTInferenceClientSession(std::shared_ptr<const TensorRTEngine> engine) :
+  m_engine(std::move(engine))
+{
+    m_context.reset(m_engine->engine->createExecutionContext());
+    if (m_context == nullptr)
+    {
+        throw std::runtime_error("Unable to create a TensorRT execution context");
+    }
+
+    if (!m_context->setOptimizationProfileAsync(m_engine->profile_index, rmm::cuda_stream_per_thread))
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("Unable to select optimization profile "
+                                                     << m_engine->profile_index << " of the TensorRT engine"));
+    }
+}
+
+TensorRTInferenceClientSession::~TensorRTInferenceClientSession() = default;
+
+std::vector<TensorModelMapping> TensorRTInferenceClientSession::get_input_mappings(
+    std::vector<TensorModelMapping> input_map_overrides)
+{
+    auto mappings = std::vector<TensorModelMapping>();
+
+    for (const auto& map : m_engine->inputs)
+    {
+        mappings.emplace_back(TensorModelMapping(map.name, map.name));
+    }
+
+    for (auto override : input_map_overrides)
+    {
+        mappings.emplace_back(override);
+    }
+
+    return mappings;
+}
+
+std::vector<TensorModelMapping> TensorRTInferenceClientSession::get_output_mappings(
+    std::vector<TensorModelMapping> output_map_overrides)
+{
+    auto mappings = std::vector<TensorModelMapping>();
+
+    for (const auto& map : m_engine->outputs)
+    {
+        mappings.emplace_back(TensorModelMapping(map.name, map.name));
+    }
+
+    for (auto override : output_map_overrides)
+    {
+        auto pos = std::find_if(mappings.begin(), mappings.end(), [override](TensorModelMapping m) {
+            return m.model_field_name == override.model_field_name;
+        });
+
+        if (pos != mappings.end())
+        {
+            mappings.erase(pos);
+        }
+
+        mappings.emplace_back(override);
+    }
+
+    return mappings;
+}
+
+mrc::coroutines::Task<TensorMap> TensorRTInferenceClientSession::infer(TensorMap&& inputs,
+                                                                      std::shared_ptr<mrc::coroutines::Scheduler> on)
+{
+    CHECK_EQ(inputs.size(), m_engine->inputs.size()) << "Input tensor count does not match model input count";
+
+    auto element_count = inputs.begin()->second.shape(0);
+
+    for (auto& input : inputs)
+    {
+        CHECK_EQ(element_count, input.second.shape(0)) << "Input tensors are different sizes";
+    }
+
+    TensorMap model_output_tensors;
+
+    // Inputs converted to the engine's types are kept until all of the batches have been enqueued, their memory is
+    // then released in stream order after the engine has read it
+    std::vector<TensorObject> input_slices;
+
+    for (TensorIndex start = 0; start < element_count; start += m_engine->max_batch_size)
+    {
+        TensorIndex stop = std::min(start + m_engine->max_batch_size, static_cast<TensorIndex>(element_count));
+
+        for (const auto& model_input : m_engine->inputs)
+        {
+            auto input_slice =
+                inputs.at(model_input.name).slice({start, 0}, {stop, -1}).as_type(model_input.datatype);
+
+            CHECK(input_slice.is_compact()) << "Input '" << model_input.name << "' is not contiguous";
+
+            nvinfer1::Dims dims{};
+            dims.nbDims = static_cast<int32_t>(model_input.shape.size());
+            for (int32_t i = 0; i < dims.nbDims; i++)
+            {
+                dims.d[i] = input_slice.shape(i);
+            }
+
+            if (!m_context->setInputShape(model_input.name.c_str(), dims) ||
+                !m_context->setTensorAddress(model_input.name.c_str(), input_slice.data()))
+            {
+                throw std::runtime_error(
+                    MORPHEUS_CONCAT_STR("Unable to bind input '" << model_input.name << "' of the TensorRT engine"));
+            }
+
+            input_slices.emplace_back(std::move(input_slice));
+        }
+
+        for (const auto& model_output : m_engine->outputs)
+        {
+            // The full outputs are created once the shapes of the first batch are known, as the columns of an output
+            // may depend on those of the inputs
+            if (start == 0)
+            {
+                auto dims = m_context->getTensorShape(model_output.name.c_str());
+
+                ShapeType full_output_shape{element_count, dims.nbDims > 1 ? dims.d[1] : 1};
+                auto full_output_element_count = TensorUtils::get_elem_count(full_output_shape);
+
+                auto full_output_buffer =
+                    m_output_pool->get_buffer(full_output_element_count * model_output.datatype.item_size());
+
+                ShapeType stride{full_output_shape[1], 1};
+
+                model_output_tensors[model_output.name].swap(
+                    Tensor::create(std::move(full_output_buffer), model_output.datatype, full_output_shape, stride, 0));
+            }
+
+            auto output_slice = model_output_tensors.at(model_output.name).slice({start, 0}, {stop, -1});
+
+            if (!m_context->setTensorAddress(model_output.name.c_str(), output_slice.data()))
+            {
+                throw std::runtime_error(
+                    MORPHEUS_CONCAT_STR("Unable to bind output '" << model_output.name << "' of the TensorRT engine"));
+            }
+        }
+
+        if (!m_context->enqueueV3(rmm::cuda_stream_per_thread))
+        {
+            throw std::runtime_error("Unable to enqueue inference on the TensorRT engine");
+        }
+    }
+
+    co_return model_output_tensors;
+}
+
+/****** TensorRTInferenceClient*****************************/
+
+TensorRTInferenceClient::TensorRTInferenceClient(const std::string& engine_file)
+{
+    auto engine = std::make_shared<TensorRTEngine>();
+
+    engine->runtime.reset(nvinfer1::createInferRuntime(engine->logger));
+    if (engine->runtime == nullptr)
+    {
+        throw std::runtime_error("Unable to create the TensorRT runtime");
+    }
+
+    auto serialized_engine = read_engine_file(engine_file);
+    engine->engine.reset(engine->runtime->deserializeCudaEngine(serialized_engine.data(), serialized_engine.size()));
+    if (engine->engine == nullptr)
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR(
+            "Unable to deserialize TensorRT engine '" << engine_file << "', it may have been built with a different "
+                                                      << "version of TensorRT or for a different GPU"));
+    }
+
+    for (int32_t i = 0; i < engine->engine->getNbIOTensors(); i++)
+    {
+        std::string name = engine->engine->getIOTensorName(i);
+        auto dims        = engine->engine->getTensorShape(name.c_str());
+
+        if (dims.nbDims < 1 || dims.nbDims > 2)
+        {
+            throw std::runtime_error(MORPHEUS_CONCAT_STR("Tensor '" << name << "' of TensorRT engine '" << engine_file
+                                                                    << "' has " << dims.nbDims
+                                                                    << " dimensions, only 1 or 2 are supported"));
+        }
+
+        ShapeType shape(dims.d, dims.d + dims.nbDims);
+        auto dtype = dtype_from_tensorrt(engine->engine->getTensorDataType(name.c_str()), name);
+
+        if (engine->engine->getTensorIOMode(name.c_str()) == nvinfer1::TensorIOMode::kINPUT)
+        {
+            if (shape[0] != -1)
+            {
+                throw std::runtime_error(MORPHEUS_CONCAT_STR(
+                    "Input '" << name << "' of TensorRT engine '" << engine_file
+                              << "' has a fixed batch size, the engine must be built with a dynamic batch dimension"));
+            }
+
+            engine->inputs.emplace_back(TritonInOut{name, 0, dtype, shape, "", 0});
+        }
+        else
+        {
+            engine->outputs.emplace_back(TritonInOut{name, 0, dtype, shape, "", 0});
+        }
+    }
+
+    if (engine->inputs.empty())
+    {
+        throw std::runtime_error(MORPHEUS_CONCAT_STR("TensorRT engine '" << engine_file << "' has no inputs"));
+    }
+
+    // Use the profile allowing the largest batches, the maximum batch size being the smallest of those of the inputs
+    for (int32_t profile = 0; profile < engine->engine->getNbOptimizationProfiles(); profile++)
+    {
+        TensorIndex max_batch_size = -1;
+        for (const auto& input : engine->inputs)
+        {
+            auto max_dims = engine->engine->getProfileShape(
+                input.name.c_str(), profile, nvinfer1::OptProfileSelector::kMAX);
+
+            if (max_batch_size < 0 || max_dims.d[0] < max_batch_size)
+            {
+                max_batch_size = max_dims.d[0];
+            }
+        }
+
+        if (max_batch_size > engine->max_batch_size)
+        {
+            engine->max_batch_size = max_batch_size;
+            engine->profile_index  = profile;
+        }
+    }
+
+    if (engine->max_batch_size < 1)
+    {
+        throw std::runtime_error(
+            MORPHEUS_CONCAT_STR("TensorRT engine '" << engine_file << "' has no optimization profile for its inputs"));
+    }
+
+    m_engine = std::move(engine);
+}
+
+std::unique_ptr<IInferenceClientSession> TensorRTInferenceClient::create_session()
+{
+    return std::make_unique<TensorRTInferenceClientSession>(m_engine);
+}
+
+/****** TensorRTInferenceStage******************************/
+
+TensorRTInferenceStage::TensorRTInferenceStage(const std::string& engine_file,
+                                               bool needs_logits,
+                                               std::vector<TensorModelMapping> input_mapping,
+                                               std::vector<TensorModelMapping> output_mapping,
+                                               bool use_cuda_graphs,
+                                               TensorIndex max_batch_rows,
+                                               std::chrono::milliseconds max_batch_delay,
+                                               std::size_t num_sessions) :
+  InferenceClientStage(std::make_unique<TensorRTInferenceClient>(engine_file),
+                       engine_file,
+                       needs_logits,
+                       std::move(input_mapping),
+                       std::move(output_mapping),
+                       use_cuda_graphs,
+                       max_batch_rows,
+                       max_batch_delay,
+                       num_sessions)
+{}
+
+/****** TensorRTInferenceStageInterfaceProxy****************/
+
+std::shared_ptr<mrc::segment::Object<TensorRTInferenceStage>> TensorRTInferenceStageInterfaceProxy::init(
+    mrc::segment::Builder& builder,
+    const std::string& name,
+    const std::string& engine_file,
+    bool needs_logits,
+    std::map<std::string, std::string> input_mapping,
+    std::map<std::string, std::string> output_mapping,
+    bool use_cuda_graphs,
+    TensorIndex max_batch_rows,
+    int64_t max_batch_delay_ms,
+    std::size_t num_sessions)
+{
+    std::vector<TensorModelMapping> input_mapping_{};
+    std::vector<TensorModelMapping> output_mapping_{};
+
+    for (auto& mapping : input_mapping)
+    {
+        input_mapping_.emplace_back(TensorModelMapping{mapping.first, mapping.second});
+    }
+
+    for (auto& mapping : output_mapping)
+    {
+        output_mapping_.emplace_back(TensorModelMapping{mapping.first, mapping.second});
+    }
+
+    return builder.construct_object<TensorRTInferenceStage>(name,
+                                                            engine_file,
+                                                            needs_logits,
+                                                            std::move(input_mapping_),
+                                                            std::move(output_mapping_),
+                                                            use_cuda_graphs,
+                                                            max_batch_rows,
+                                                            std::chrono::milliseconds(max_batch_delay_ms),
+                                                            num_sessions);
+}
+
+}  // namespace morpheus
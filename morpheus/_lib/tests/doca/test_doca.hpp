@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "../test_utils/common.hpp"  // IWYU pragma: associated
+
+#include <cuda_runtime.h>  // for cudaMemcpy
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>  // for make_fixed_width_column, make_strings_column
+#include <cudf/column/column_view.hpp>
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/types.hpp>  // for data_type, type_id, size_type
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
+#include <mrc/cuda/common.hpp>                // for MRC_CHECK_CUDA
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int8_t
+#include <memory>   // for unique_ptr
+#include <string>   // for string
+#include <vector>   // for vector
+
+namespace morpheus::test {
+
+/**
+ * @brief Copies `values` to a new column of `type`, whose elements must be the size of `T`
+ */
+template <typename T>
+std::unique_ptr<cudf::column> make_column(cudf::data_type type, const std::vector<T>& values)
+{
+    auto column = cudf::make_fixed_width_column(type, static_cast<cudf::size_type>(values.size()));
+    MRC_CHECK_CUDA(cudaMemcpy(
+        column->mutable_view().head(), values.data(), values.size() * sizeof(T), cudaMemcpyHostToDevice));
+
+    return column;
+}
+
+/**
+ * @brief Copies `strings` to a new strings column, such as the payloads of the packets
+ */
+inline std::unique_ptr<cudf::column> make_strings_column(const std::vector<std::string>& strings)
+{
+    std::vector<cudf::size_type> offsets{0};
+    std::vector<int8_t> chars;
+    for (const auto& str : strings)
+    {
+        chars.insert(chars.end(), str.begin(), str.end());
+        offsets.push_back(static_cast<cudf::size_type>(chars.size()));
+    }
+
+    return cudf::make_strings_column(static_cast<cudf::size_type>(strings.size()),
+                                     make_column(cudf::data_type{cudf::type_id::INT32}, offsets),
+                                     make_column(cudf::data_type{cudf::type_id::INT8}, chars),
+                                     0,
+                                     rmm::device_buffer{});
+}
+
+/**
+ * @brief Copies the rows of a strings column to the host
+ */
+inline std::vector<std::string> get_strings(const cudf::column_view& column)
+{
+    auto stream  = cudf::get_default_stream();
+    auto strings = cudf::strings_column_view(column);
+
+    std::vector<cudf::size_type> offsets(strings.size() + 1);
+    MRC_CHECK_CUDA(cudaMemcpy(offsets.data(),
+                              strings.offsets().data<cudf::size_type>() + strings.offset(),
+                              offsets.size() * sizeof(cudf::size_type),
+                              cudaMemcpyDeviceToHost));
+
+    std::string chars(offsets.back() - offsets.front(), '\0');
+    MRC_CHECK_CUDA(cudaMemcpy(
+        chars.data(), strings.chars_begin(stream) + offsets.front(), chars.size(), cudaMemcpyDeviceToHost));
+
+    std::vector<std::string> rows;
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+    {
+        rows.push_back(chars.substr(offsets[i] - offsets.front(), offsets[i + 1] - offsets[i]));
+    }
+
+    return rows;
+}
+
+}  // namespace morpheus::test
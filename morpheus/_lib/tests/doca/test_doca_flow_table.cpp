@@ -0,0 +1,248 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"        // IWYU pragma: associated
+#include "../test_utils/tensor_utils.hpp"  // for convert_to_host
+#include "test_doca.hpp"                   // for make_column, make_strings_column
+
+#include "morpheus/doca/doca_flow_table.hpp"
+
+#include <cudf/column/column.hpp>
+#include <cudf/fixed_point/fixed_point.hpp>  // for scale_type
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>  // for data_type, type_id
+#include <gtest/gtest.h>
+#include <rmm/cuda_stream_view.hpp>
+
+#include <algorithm>  // for count, find, sort
+#include <chrono>     // for milliseconds
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint16_t, uint32_t, int32_t, int64_t
+#include <iterator>   // for distance
+#include <memory>     // for unique_ptr
+#include <string>     // for string
+#include <utility>    // for move
+#include <vector>     // for vector
+
+using namespace morpheus;
+using namespace std::chrono_literals;
+
+namespace {
+const int32_t TCP = 6;
+const int32_t SYN = 0x02;
+const int32_t ACK = 0x10;
+
+// The flows of the tests differ by source port only
+struct Packet
+{
+    uint16_t src_port;
+    uint32_t timestamp;
+    std::string data;
+    int32_t tcp_flags{ACK};
+};
+
+// Holds the columns of a batch of packets, as emitted by `DocaSourceStage` with `numeric_addresses`
+class PacketBatch
+{
+  public:
+    PacketBatch(const std::vector<Packet>& packets)
+    {
+        const cudf::data_type address_type{cudf::type_id::DECIMAL128, numeric::scale_type{0}};
+
+        std::vector<__int128_t> src_ips(packets.size(), 0x0A000001);
+        std::vector<__int128_t> dst_ips(packets.size(), 0x0A000002);
+        std::vector<uint16_t> src_ports;
+        std::vector<uint16_t> dst_ports(packets.size(), 443);
+        std::vector<int32_t> next_protos(packets.size(), TCP);
+        std::vector<int32_t> tcp_flags;
+        std::vector<uint32_t> timestamps;
+        std::vector<std::string> data;
+
+        for (const auto& packet : packets)
+        {
+            src_ports.push_back(packet.src_port);
+            tcp_flags.push_back(packet.tcp_flags);
+            timestamps.push_back(packet.timestamp);
+            data.push_back(packet.data);
+        }
+
+        m_columns.emplace_back(test::make_column(address_type, src_ips));
+        m_columns.emplace_back(test::make_column(address_type, dst_ips));
+        m_columns.emplace_back(test::make_column(cudf::data_type{cudf::type_id::UINT16}, src_ports));
+        m_columns.emplace_back(test::make_column(cudf::data_type{cudf::type_id::UINT16}, dst_ports));
+        m_columns.emplace_back(test::make_column(cudf::data_type{cudf::type_id::INT32}, next_protos));
+        m_columns.emplace_back(test::make_column(cudf::data_type{cudf::type_id::INT32}, tcp_flags));
+        m_columns.emplace_back(test::make_column(cudf::data_type{cudf::type_id::UINT32}, timestamps));
+        m_columns.emplace_back(test::make_strings_column(data));
+    }
+
+    doca::FlowPacketColumns columns() const
+    {
+        return doca::FlowPacketColumns{m_columns[0]->view(),
+                                       m_columns[1]->view(),
+                                       m_columns[2]->view(),
+                                       m_columns[3]->view(),
+                                       m_columns[4]->view(),
+                                       m_columns[5]->view(),
+                                       m_columns[6]->view(),
+                                       m_columns[7]->view()};
+    }
+
+  private:
+    std::vector<std::unique_ptr<cudf::column>> m_columns;
+};
+
+std::unique_ptr<cudf::table> update(doca::FlowTable& table, const std::vector<Packet>& packets)
+{
+    PacketBatch batch(packets);
+    return table.update(batch.columns(), rmm::cuda_stream_default);
+}
+
+// Single packet flows with source ports `first_port` onwards
+std::vector<Packet> make_flows(uint16_t first_port, std::size_t count, uint32_t timestamp)
+{
+    std::vector<Packet> packets;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        packets.push_back({static_cast<uint16_t>(first_port + i), timestamp, "x"});
+    }
+
+    return packets;
+}
+
+template <typename T>
+std::vector<T> get_column(const cudf::table& records, const std::string& name)
+{
+    const auto& names = doca::FlowTable::column_names();
+    auto index        = std::distance(names.begin(), std::find(names.begin(), names.end(), name));
+
+    return test::convert_to_host<T>(records.get_column(index).view());
+}
+
+std::vector<uint16_t> sorted_ports(const cudf::table& records)
+{
+    auto ports = get_column<uint16_t>(records, "src_port");
+    std::sort(ports.begin(), ports.end());
+
+    return ports;
+}
+}  // namespace
+
+TEST_CLASS(DocaFlowTable);
+
+TEST_F(TestDocaFlowTable, MergesFlowsAcrossBatches)
+{
+    doca::FlowTable table(256, 1000ms, 10000ms, rmm::cuda_stream_default);
+
+    EXPECT_EQ(update(table, {{1000, 10, "abc"}, {1000, 0, "ab", SYN}}), nullptr);
+    EXPECT_EQ(update(table, {{1000, 30, "a"}}), nullptr);
+
+    auto records = table.flush(rmm::cuda_stream_default);
+    ASSERT_NE(records, nullptr);
+    ASSERT_EQ(records->num_rows(), 1);
+    EXPECT_EQ(records->num_columns(), static_cast<cudf::size_type>(doca::FlowTable::column_names().size()));
+
+    EXPECT_EQ(get_column<int64_t>(*records, "packet_count"), (std::vector<int64_t>{3}));
+    EXPECT_EQ(get_column<int64_t>(*records, "byte_count"), (std::vector<int64_t>{6}));
+    EXPECT_EQ(get_column<uint32_t>(*records, "first_timestamp"), (std::vector<uint32_t>{0}));
+    EXPECT_EQ(get_column<uint32_t>(*records, "last_timestamp"), (std::vector<uint32_t>{30}));
+    EXPECT_EQ(get_column<uint32_t>(*records, "duration_ms"), (std::vector<uint32_t>{30}));
+    EXPECT_EQ(get_column<int32_t>(*records, "syn_count"), (std::vector<int32_t>{1}));
+    EXPECT_EQ(get_column<int32_t>(*records, "ack_count"), (std::vector<int32_t>{2}));
+
+    // One gap within the first batch, the other between the two batches
+    EXPECT_EQ(get_column<uint32_t>(*records, "iat_min_ms"), (std::vector<uint32_t>{10}));
+    EXPECT_EQ(get_column<uint32_t>(*records, "iat_max_ms"), (std::vector<uint32_t>{20}));
+    EXPECT_EQ(get_column<double>(*records, "iat_mean_ms"), (std::vector<double>{15.0}));
+
+    EXPECT_EQ(table.flush(rmm::cuda_stream_default), nullptr);
+}
+
+TEST_F(TestDocaFlowTable, ExpiresIdleFlows)
+{
+    doca::FlowTable table(256, 100ms, 10000ms, rmm::cuda_stream_default);
+
+    EXPECT_EQ(update(table, {{1, 0, "a"}, {2, 0, "a"}}), nullptr);
+
+    auto expired = update(table, {{2, 150, "a"}});
+    ASSERT_NE(expired, nullptr);
+    EXPECT_EQ(sorted_ports(*expired), (std::vector<uint16_t>{1}));
+    EXPECT_EQ(get_column<int64_t>(*expired, "packet_count"), (std::vector<int64_t>{1}));
+
+    auto flushed = table.flush(rmm::cuda_stream_default);
+    ASSERT_NE(flushed, nullptr);
+    EXPECT_EQ(sorted_ports(*flushed), (std::vector<uint16_t>{2}));
+    EXPECT_EQ(get_column<int64_t>(*flushed, "packet_count"), (std::vector<int64_t>{2}));
+}
+
+TEST_F(TestDocaFlowTable, ExpiresActiveFlows)
+{
+    doca::FlowTable table(256, 1000ms, 100ms, rmm::cuda_stream_default);
+
+    EXPECT_EQ(update(table, {{1, 0, "a"}, {2, 60, "a"}}), nullptr);
+
+    // The first flow has been active for 120ms, the second one is neither idle nor active for long enough
+    auto expired = update(table, {{1, 120, "a"}});
+    ASSERT_NE(expired, nullptr);
+    EXPECT_EQ(sorted_ports(*expired), (std::vector<uint16_t>{1}));
+    EXPECT_EQ(get_column<int64_t>(*expired, "packet_count"), (std::vector<int64_t>{2}));
+    EXPECT_EQ(get_column<uint32_t>(*expired, "duration_ms"), (std::vector<uint32_t>{120}));
+
+    auto flushed = table.flush(rmm::cuda_stream_default);
+    ASSERT_NE(flushed, nullptr);
+    EXPECT_EQ(sorted_ports(*flushed), (std::vector<uint16_t>{2}));
+}
+
+TEST_F(TestDocaFlowTable, RebuildsPastThreeQuarterLoad)
+{
+    doca::FlowTable table(256, 100ms, 10000ms, rmm::cuda_stream_default);
+
+    EXPECT_EQ(update(table, make_flows(0, 200, 0)), nullptr);
+
+    // Expires every flow but the first, leaving 199 tombstones which take the table past three quarters of its slots
+    auto expired = update(table, {{0, 100, "a"}});
+    ASSERT_NE(expired, nullptr);
+    EXPECT_EQ(expired->num_rows(), 199);
+
+    // Without rebuilding, only the 56 slots never used would be free and most of these flows would be dropped
+    EXPECT_EQ(update(table, make_flows(1000, 200, 101)), nullptr);
+    EXPECT_EQ(table.num_dropped_packets(), 0);
+
+    auto flushed = table.flush(rmm::cuda_stream_default);
+    ASSERT_NE(flushed, nullptr);
+    EXPECT_EQ(flushed->num_rows(), 201);
+}
+
+TEST_F(TestDocaFlowTable, CountsDroppedPackets)
+{
+    // The capacity is rounded up to the 256 threads of a block
+    doca::FlowTable table(100, 1000ms, 10000ms, rmm::cuda_stream_default);
+
+    EXPECT_EQ(update(table, make_flows(0, 300, 0)), nullptr);
+    EXPECT_EQ(table.num_dropped_packets(), 44);
+
+    // Packets of flows already in the table are still merged, while those of new flows keep being dropped
+    EXPECT_EQ(update(table, make_flows(0, 300, 10)), nullptr);
+    EXPECT_EQ(table.num_dropped_packets(), 88);
+
+    auto flushed = table.flush(rmm::cuda_stream_default);
+    ASSERT_NE(flushed, nullptr);
+    EXPECT_EQ(flushed->num_rows(), 256);
+
+    auto packet_counts = get_column<int64_t>(*flushed, "packet_count");
+    EXPECT_EQ(std::count(packet_counts.begin(), packet_counts.end(), 2), 256);
+}
@@ -0,0 +1,279 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"        // IWYU pragma: associated
+#include "../test_utils/tensor_utils.hpp"  // for convert_to_host
+#include "test_doca.hpp"                   // for make_column, make_strings_column, get_strings
+
+#include "morpheus/doca/doca_stream_table.hpp"
+
+#include <cuda_runtime.h>  // for cudaMemcpy
+#include <cudf/column/column.hpp>
+#include <cudf/fixed_point/fixed_point.hpp>  // for scale_type
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>  // for data_type, type_id
+#include <gtest/gtest.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <rmm/cuda_stream_view.hpp>
+
+#include <algorithm>  // for find
+#include <chrono>     // for milliseconds
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t, uint16_t, uint32_t, int32_t, int64_t
+#include <iterator>   // for distance
+#include <memory>     // for unique_ptr
+#include <string>     // for string
+#include <vector>     // for vector
+
+using namespace morpheus;
+using namespace std::chrono_literals;
+
+namespace {
+const int32_t TCP = 6;
+const int32_t FIN = 0x01;
+const int32_t SYN = 0x02;
+const int32_t ACK = 0x10;
+
+// The streams of the tests differ by source port only
+struct Segment
+{
+    uint16_t src_port;
+    uint32_t seq;
+    uint32_t timestamp;
+    std::string data;
+    int32_t tcp_flags{ACK};
+};
+
+// Holds the columns of a batch of segments, as emitted by `DocaSourceStage` with `numeric_addresses`
+class SegmentBatch
+{
+  public:
+    SegmentBatch(const std::vector<Segment>& segments)
+    {
+        const cudf::data_type address_type{cudf::type_id::DECIMAL128, numeric::scale_type{0}};
+
+        std::vector<__int128_t> src_ips(segments.size(), 0x0A000001);
+        std::vector<__int128_t> dst_ips(segments.size(), 0x0A000002);
+        std::vector<uint16_t> src_ports;
+        std::vector<uint16_t> dst_ports(segments.size(), 80);
+        std::vector<int32_t> next_protos(segments.size(), TCP);
+        std::vector<int32_t> tcp_flags;
+        std::vector<uint32_t> tcp_seqs;
+        std::vector<uint32_t> timestamps;
+        std::vector<std::string> data;
+
+        for (const auto& segment : segments)
+        {
+            src_ports.push_back(segment.src_port);
+            tcp_flags.push_back(segment.tcp_flags);
+            tcp_seqs.push_back(segment.seq);
+            timestamps.push_back(segment.timestamp);
+            data.push_back(segment.data);
+        }
+
+        m_columns.emplace_back(test::make_column(address_type, src_ips));
+        m_columns.emplace_back(test::make_column(address_type, dst_ips));
+        m_columns.emplace_back(test::make_column(cudf::data_type{cudf::type_id::UINT16}, src_ports));
+        m_columns.emplace_back(test::make_column(cudf::data_type{cudf::type_id::UINT16}, dst_ports));
+        m_columns.emplace_back(test::make_column(cudf::data_type{cudf::type_id::INT32}, next_protos));
+        m_columns.emplace_back(test::make_column(cudf::data_type{cudf::type_id::INT32}, tcp_flags));
+        m_columns.emplace_back(test::make_column(cudf::data_type{cudf::type_id::UINT32}, tcp_seqs));
+        m_columns.emplace_back(test::make_column(cudf::data_type{cudf::type_id::UINT32}, timestamps));
+        m_columns.emplace_back(test::make_strings_column(data));
+    }
+
+    doca::StreamPacketColumns columns() const
+    {
+        return doca::StreamPacketColumns{m_columns[0]->view(),
+                                         m_columns[1]->view(),
+                                         m_columns[2]->view(),
+                                         m_columns[3]->view(),
+                                         m_columns[4]->view(),
+                                         m_columns[5]->view(),
+                                         m_columns[6]->view(),
+                                         m_columns[7]->view(),
+                                         m_columns[8]->view()};
+    }
+
+  private:
+    std::vector<std::unique_ptr<cudf::column>> m_columns;
+};
+
+std::unique_ptr<cudf::table> update(doca::StreamTable& table, const std::vector<Segment>& segments)
+{
+    SegmentBatch batch(segments);
+    return table.update(batch.columns(), rmm::cuda_stream_default);
+}
+
+cudf::column_view get_column(const cudf::table& chunks, const std::string& name)
+{
+    const auto& names = doca::StreamTable::column_names();
+    auto index        = std::distance(names.begin(), std::find(names.begin(), names.end(), name));
+
+    return chunks.get_column(index).view();
+}
+
+// Boolean columns are read as bytes, `std::vector<bool>` having no storage to copy to
+std::vector<uint8_t> get_flags(const cudf::table& chunks, const std::string& name)
+{
+    auto column = get_column(chunks, name);
+
+    std::vector<uint8_t> flags(column.size());
+    MRC_CHECK_CUDA(cudaMemcpy(flags.data(), column.data<uint8_t>(), flags.size(), cudaMemcpyDeviceToHost));
+
+    return flags;
+}
+
+// The chunks of a batch are in no particular order, tests holding several streams find them by source port
+cudf::size_type find_chunk(const cudf::table& chunks, uint16_t src_port)
+{
+    auto ports = test::convert_to_host<uint16_t>(get_column(chunks, "src_port"));
+    auto found = std::find(ports.begin(), ports.end(), src_port);
+    EXPECT_NE(found, ports.end()) << "No chunk for port " << src_port;
+
+    return static_cast<cudf::size_type>(std::distance(ports.begin(), found));
+}
+
+doca::StreamTable make_table(std::chrono::milliseconds gap_timeout = 100ms, std::size_t max_buffered_bytes = 1 << 20)
+{
+    return doca::StreamTable(256, max_buffered_bytes, 10000ms, gap_timeout, rmm::cuda_stream_default);
+}
+}  // namespace
+
+TEST_CLASS(DocaStreamTable);
+
+TEST_F(TestDocaStreamTable, OrdersSegments)
+{
+    auto table = make_table();
+
+    // The segments of a batch are reassembled in sequence order, whatever the order they were received in
+    auto chunks = update(table, {{1, 106, 0, "gh"}, {1, 100, 0, "abc"}, {1, 99, 0, "", SYN}, {1, 103, 0, "def"}});
+    ASSERT_NE(chunks, nullptr);
+    ASSERT_EQ(chunks->num_rows(), 1);
+    EXPECT_EQ(test::get_strings(get_column(*chunks, "data")), (std::vector<std::string>{"abcdefgh"}));
+    EXPECT_EQ(test::convert_to_host<int64_t>(get_column(*chunks, "stream_offset")), (std::vector<int64_t>{0}));
+    EXPECT_EQ(get_flags(*chunks, "gap"), (std::vector<uint8_t>{0}));
+    EXPECT_EQ(get_flags(*chunks, "fin"), (std::vector<uint8_t>{0}));
+
+    auto last = update(table, {{1, 108, 10, "ij", FIN | ACK}});
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ(test::get_strings(get_column(*last, "data")), (std::vector<std::string>{"ij"}));
+    EXPECT_EQ(test::convert_to_host<int64_t>(get_column(*last, "stream_offset")), (std::vector<int64_t>{8}));
+    EXPECT_EQ(test::convert_to_host<uint32_t>(get_column(*last, "timestamp")), (std::vector<uint32_t>{10}));
+    EXPECT_EQ(get_flags(*last, "fin"), (std::vector<uint8_t>{1}));
+
+    // Pure ACKs carry nothing to reassemble
+    EXPECT_EQ(update(table, {{1, 110, 20, "", ACK}}), nullptr);
+    EXPECT_EQ(table.flush(rmm::cuda_stream_default), nullptr);
+}
+
+TEST_F(TestDocaStreamTable, TrimsRetransmitsAndOverlaps)
+{
+    auto table = make_table();
+
+    // A stream already established when the capture started begins at its first segment
+    auto first = update(table, {{1, 1000, 0, "abcd"}});
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(test::get_strings(get_column(*first, "data")), (std::vector<std::string>{"abcd"}));
+
+    // A retransmission of reassembled bytes alone does not advance the stream
+    EXPECT_EQ(update(table, {{1, 1000, 10, "abcd"}}), nullptr);
+
+    // Only the new bytes of a segment overlapping the reassembled ones, or another segment of the batch, are appended
+    auto chunks = update(table, {{1, 1002, 20, "cdef"}, {1, 1000, 20, "abcd"}, {1, 1005, 20, "fg"}});
+    ASSERT_NE(chunks, nullptr);
+    ASSERT_EQ(chunks->num_rows(), 1);
+    EXPECT_EQ(test::get_strings(get_column(*chunks, "data")), (std::vector<std::string>{"efg"}));
+    EXPECT_EQ(test::convert_to_host<int64_t>(get_column(*chunks, "stream_offset")), (std::vector<int64_t>{4}));
+    EXPECT_EQ(get_flags(*chunks, "gap"), (std::vector<uint8_t>{0}));
+    EXPECT_EQ(table.num_skipped_gaps(), 0);
+}
+
+TEST_F(TestDocaStreamTable, HoldsSegmentsUntilGapFills)
+{
+    auto table = make_table();
+
+    auto first = update(table, {{1, 1000, 0, "ab"}, {1, 1004, 0, "ef"}});
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(test::get_strings(get_column(*first, "data")), (std::vector<std::string>{"ab"}));
+
+    // The held segment is appended once the missing bytes arrive
+    auto filled = update(table, {{1, 1002, 10, "cd"}});
+    ASSERT_NE(filled, nullptr);
+    EXPECT_EQ(test::get_strings(get_column(*filled, "data")), (std::vector<std::string>{"cdef"}));
+    EXPECT_EQ(test::convert_to_host<int64_t>(get_column(*filled, "stream_offset")), (std::vector<int64_t>{2}));
+    EXPECT_EQ(get_flags(*filled, "gap"), (std::vector<uint8_t>{0}));
+
+    EXPECT_EQ(table.num_skipped_gaps(), 0);
+    EXPECT_EQ(table.flush(rmm::cuda_stream_default), nullptr);
+}
+
+TEST_F(TestDocaStreamTable, SkipsGapsOnTimeout)
+{
+    auto table = make_table(100ms);
+
+    EXPECT_NE(update(table, {{1, 1000, 0, "ab"}, {1, 1004, 0, "ef"}}), nullptr);
+
+    // Packets of another stream move the time past the gap timeout of the held segment
+    auto chunks = update(table, {{2, 5000, 150, "x"}});
+    ASSERT_NE(chunks, nullptr);
+    ASSERT_EQ(chunks->num_rows(), 2);
+
+    auto data = test::get_strings(get_column(*chunks, "data"));
+    auto gaps = get_flags(*chunks, "gap");
+
+    auto skipped = find_chunk(*chunks, 1);
+    EXPECT_EQ(data[skipped], "ef");
+    EXPECT_EQ(gaps[skipped], 1);
+
+    auto other = find_chunk(*chunks, 2);
+    EXPECT_EQ(data[other], "x");
+    EXPECT_EQ(gaps[other], 0);
+
+    EXPECT_EQ(table.num_skipped_gaps(), 1);
+
+    // The skipped bytes arriving late are trimmed as a retransmission
+    EXPECT_EQ(update(table, {{1, 1002, 160, "cd"}}), nullptr);
+}
+
+TEST_F(TestDocaStreamTable, SkipsGapsPastMaxBufferedBytes)
+{
+    auto table = make_table(100ms, 4);
+
+    // Holding the second segment would exceed the bytes held across batches
+    auto chunks = update(table, {{1, 1000, 0, "ab"}, {1, 1004, 0, "efghij"}});
+    ASSERT_NE(chunks, nullptr);
+    EXPECT_EQ(test::get_strings(get_column(*chunks, "data")), (std::vector<std::string>{"abefghij"}));
+    EXPECT_EQ(get_flags(*chunks, "gap"), (std::vector<uint8_t>{1}));
+    EXPECT_EQ(table.num_skipped_gaps(), 1);
+
+    EXPECT_EQ(table.flush(rmm::cuda_stream_default), nullptr);
+}
+
+TEST_F(TestDocaStreamTable, FlushSkipsGaps)
+{
+    auto table = make_table();
+
+    EXPECT_NE(update(table, {{1, 1000, 0, "ab"}, {1, 1004, 0, "ef"}, {1, 1008, 0, "ij"}}), nullptr);
+
+    auto flushed = table.flush(rmm::cuda_stream_default);
+    ASSERT_NE(flushed, nullptr);
+    EXPECT_EQ(test::get_strings(get_column(*flushed, "data")), (std::vector<std::string>{"efij"}));
+    EXPECT_EQ(get_flags(*flushed, "gap"), (std::vector<uint8_t>{1}));
+
+    EXPECT_EQ(table.flush(rmm::cuda_stream_default), nullptr);
+}
@@ -0,0 +1,252 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // for TEST_CLASS
+
+#include "morpheus/doca/packet_filter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>    // for uint16_t, uint64_t
+#include <limits>     // for numeric_limits
+#include <stdexcept>  // for invalid_argument
+#include <string>     // for string
+#include <vector>     // for vector
+
+using namespace morpheus;
+
+namespace {
+const uint64_t ALL_BITS = ~uint64_t{0};
+
+/**
+ * @brief Builds the (low, high) words of the `src_ip6` and `dst_ip6` columns for an IPv4 address, as the receive
+ * kernel does
+ */
+std::vector<uint64_t> ip4_words(uint32_t address)
+{
+    return {0x0000FFFF00000000ull | address, 0};
+}
+
+/**
+ * @brief Evaluates `prefix` against the (low, high) words of an address, as the receive kernel does
+ */
+bool matches(const doca::ip_prefix& prefix, const std::vector<uint64_t>& words)
+{
+    return (words[0] & prefix.mask[0]) == prefix.address[0] && (words[1] & prefix.mask[1]) == prefix.address[1];
+}
+
+doca::packet_filter make_filter(const std::vector<std::string>& src_ports,
+                                const std::vector<std::string>& dst_ports,
+                                const std::vector<std::string>& src_networks = {},
+                                const std::vector<std::string>& dst_networks = {})
+{
+    return doca::make_packet_filter(src_ports, dst_ports, src_networks, dst_networks, 0, -1, 0, 0, true);
+}
+}  // namespace
+
+TEST_CLASS(PacketFilter);
+
+TEST_F(TestPacketFilter, PortRanges)
+{
+    auto single = doca::parse_port_range("443");
+    EXPECT_EQ(single.first, 443);
+    EXPECT_EQ(single.last, 443);
+
+    auto range = doca::parse_port_range("8000-8100");
+    EXPECT_EQ(range.first, 8000);
+    EXPECT_EQ(range.last, 8100);
+
+    auto full = doca::parse_port_range("0-65535");
+    EXPECT_EQ(full.first, 0);
+    EXPECT_EQ(full.last, 65535);
+
+    auto same = doca::parse_port_range("80-80");
+    EXPECT_EQ(same.first, 80);
+    EXPECT_EQ(same.last, 80);
+}
+
+TEST_F(TestPacketFilter, InvalidPortRanges)
+{
+    // Reversed
+    EXPECT_THROW(doca::parse_port_range("8100-8000"), std::invalid_argument);
+
+    // Out of range
+    EXPECT_THROW(doca::parse_port_range("65536"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("80-70000"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("99999999999999999999999"), std::invalid_argument);
+
+    // Empty
+    EXPECT_THROW(doca::parse_port_range(""), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("-"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("80-"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("-80"), std::invalid_argument);
+
+    // Not a decimal number
+    EXPECT_THROW(doca::parse_port_range("http"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("0x50"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("80-90-100"), std::invalid_argument);
+}
+
+TEST_F(TestPacketFilter, PortsMustBeDigitsOnly)
+{
+    // Accepted by std::stoul, "-1" wrapping around to a valid value
+    EXPECT_THROW(doca::parse_port_range(" 80"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("+80"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("-1"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("80 "), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("80- 90"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_port_range("80-+90"), std::invalid_argument);
+}
+
+TEST_F(TestPacketFilter, Ipv4Prefix)
+{
+    auto prefix = doca::parse_ip_prefix("10.0.0.0/8");
+
+    // Mapped into ::ffff:0:0/96, the high word and the mapping bits of the low word are always matched
+    EXPECT_EQ(prefix.address[0], 0x0000FFFF0A000000ull);
+    EXPECT_EQ(prefix.address[1], 0);
+    EXPECT_EQ(prefix.mask[0], 0xFFFFFFFFFF000000ull);
+    EXPECT_EQ(prefix.mask[1], ALL_BITS);
+
+    EXPECT_TRUE(matches(prefix, ip4_words(0x0A010203)));   // 10.1.2.3
+    EXPECT_FALSE(matches(prefix, ip4_words(0x0B000001)));  // 11.0.0.1
+
+    // Host bits of the network are cleared
+    auto host_bits = doca::parse_ip_prefix("10.1.2.3/16");
+    EXPECT_EQ(host_bits.address[0], 0x0000FFFF0A010000ull);
+    EXPECT_TRUE(matches(host_bits, ip4_words(0x0A01FFFF)));
+    EXPECT_FALSE(matches(host_bits, ip4_words(0x0A020000)));
+
+    // A bare address matches only itself
+    auto address = doca::parse_ip_prefix("192.168.1.1");
+    EXPECT_EQ(address.mask[0], ALL_BITS);
+    EXPECT_EQ(address.mask[1], ALL_BITS);
+    EXPECT_TRUE(matches(address, ip4_words(0xC0A80101)));
+    EXPECT_FALSE(matches(address, ip4_words(0xC0A80102)));
+
+    // Every IPv4 address, but no IPv6 address
+    auto any = doca::parse_ip_prefix("0.0.0.0/0");
+    EXPECT_TRUE(matches(any, ip4_words(0x01020304)));
+    EXPECT_FALSE(matches(any, {1, 0xFD00000000000000ull}));
+}
+
+TEST_F(TestPacketFilter, Ipv6Prefix)
+{
+    auto prefix = doca::parse_ip_prefix("fd00::/8");
+    EXPECT_EQ(prefix.address[0], 0);
+    EXPECT_EQ(prefix.address[1], 0xFD00000000000000ull);
+    EXPECT_EQ(prefix.mask[0], 0);
+    EXPECT_EQ(prefix.mask[1], 0xFF00000000000000ull);
+
+    EXPECT_TRUE(matches(prefix, {1, 0xFD12000000000000ull}));
+    EXPECT_FALSE(matches(prefix, {1, 0xFE00000000000000ull}));
+
+    // Spans both words
+    auto wide = doca::parse_ip_prefix("2001:db8:0:0:ff00::/72");
+    EXPECT_EQ(wide.address[1], 0x20010DB800000000ull);
+    EXPECT_EQ(wide.address[0], 0xFF00000000000000ull);
+    EXPECT_EQ(wide.mask[1], ALL_BITS);
+    EXPECT_EQ(wide.mask[0], 0xFF00000000000000ull);
+
+    auto address = doca::parse_ip_prefix("2001:db8::1");
+    EXPECT_EQ(address.address[0], 1);
+    EXPECT_EQ(address.address[1], 0x20010DB800000000ull);
+    EXPECT_EQ(address.mask[0], ALL_BITS);
+    EXPECT_EQ(address.mask[1], ALL_BITS);
+
+    // Written out as IPv4-mapped IPv6, matched alike to the IPv4 address
+    auto mapped = doca::parse_ip_prefix("::ffff:10.0.0.0/104");
+    EXPECT_EQ(mapped.address[0], 0x0000FFFF0A000000ull);
+    EXPECT_EQ(mapped.mask[0], 0xFFFFFFFFFF000000ull);
+    EXPECT_TRUE(matches(mapped, ip4_words(0x0A010203)));
+
+    auto any = doca::parse_ip_prefix("::/0");
+    EXPECT_EQ(any.mask[0], 0);
+    EXPECT_EQ(any.mask[1], 0);
+}
+
+TEST_F(TestPacketFilter, InvalidPrefixes)
+{
+    EXPECT_THROW(doca::parse_ip_prefix("10.0.0.0/33"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_ip_prefix("fd00::/129"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_ip_prefix("10.0.0.0/"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_ip_prefix("10.0.0.0/+8"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_ip_prefix("10.0.0.0/ 8"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_ip_prefix("10.0.0.0/-1"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_ip_prefix("10.0.0.0/8x"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_ip_prefix("10.0.0/8"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_ip_prefix("fd00::g/8"), std::invalid_argument);
+    EXPECT_THROW(doca::parse_ip_prefix(""), std::invalid_argument);
+}
+
+TEST_F(TestPacketFilter, MakePacketFilter)
+{
+    auto filter = make_filter({"1024-65535"}, {"80", "443"}, {"10.0.0.0/8"}, {"fd00::/8", "192.168.0.0/16"});
+    EXPECT_EQ(filter.num_src_port_ranges, 1);
+    EXPECT_EQ(filter.num_dst_port_ranges, 2);
+    EXPECT_EQ(filter.dst_ports[1].first, 443);
+    EXPECT_EQ(filter.num_src_prefixes, 1);
+    EXPECT_EQ(filter.num_dst_prefixes, 2);
+    EXPECT_EQ(filter.dst_prefixes[1].address[0], 0x0000FFFFC0A80000ull);
+
+    // A negative maximum leaves the payload size unbounded
+    EXPECT_EQ(filter.min_payload_size, 0);
+    EXPECT_EQ(filter.max_payload_size, std::numeric_limits<int32_t>::max());
+
+    auto bounded = doca::make_packet_filter({}, {}, {}, {}, 10, 100, 0x12, 0x02, true);
+    EXPECT_EQ(bounded.min_payload_size, 10);
+    EXPECT_EQ(bounded.max_payload_size, 100);
+    EXPECT_EQ(bounded.tcp_flags_mask, 0x12);
+    EXPECT_EQ(bounded.tcp_flags_value, 0x02);
+}
+
+TEST_F(TestPacketFilter, InvalidPacketFilter)
+{
+    EXPECT_THROW(make_filter({"+80"}, {}), std::invalid_argument);
+    EXPECT_THROW(make_filter({}, {}, {}, {"10.0.0.0/40"}), std::invalid_argument);
+    EXPECT_THROW(make_filter(std::vector<std::string>(doca::MAX_FILTER_PORT_RANGES + 1, "80"), {}),
+                 std::invalid_argument);
+    EXPECT_THROW(make_filter({}, {}, std::vector<std::string>(doca::MAX_FILTER_IP_PREFIXES + 1, "10.0.0.0/8")),
+                 std::invalid_argument);
+
+    EXPECT_THROW(doca::make_packet_filter({}, {}, {}, {}, -1, -1, 0, 0, true), std::invalid_argument);
+    EXPECT_THROW(doca::make_packet_filter({}, {}, {}, {}, 100, 10, 0, 0, true), std::invalid_argument);
+    EXPECT_THROW(doca::make_packet_filter({}, {}, {}, {}, 0, -1, 0x02, 0x12, true), std::invalid_argument);
+    EXPECT_THROW(doca::make_packet_filter({}, {}, {}, {}, 0, -1, 0x02, 0x02, false), std::invalid_argument);
+}
+
+TEST_F(TestPacketFilter, OffloadableDstPorts)
+{
+    EXPECT_EQ(doca::offloadable_dst_ports(make_filter({}, {"80", "443", "8000-8002"})),
+              (std::vector<uint16_t>{80, 443, 8000, 8001, 8002}));
+
+    // Unrestricted destination ports are not offloaded
+    EXPECT_TRUE(doca::offloadable_dst_ports(make_filter({"80"}, {})).empty());
+}
+
+TEST_F(TestPacketFilter, OffloadCutoff)
+{
+    // Exactly MAX_OFFLOADED_PORTS ports, across one or several ranges
+    EXPECT_EQ(doca::offloadable_dst_ports(make_filter({}, {"1000-1063"})).size(), doca::MAX_OFFLOADED_PORTS);
+    EXPECT_EQ(doca::offloadable_dst_ports(make_filter({}, {"1000-1031", "2000-2031"})).size(),
+              doca::MAX_OFFLOADED_PORTS);
+
+    // One port more is only matched by the receive kernel
+    EXPECT_TRUE(doca::offloadable_dst_ports(make_filter({}, {"1000-1064"})).empty());
+    EXPECT_TRUE(doca::offloadable_dst_ports(make_filter({}, {"1000-1063", "2000"})).empty());
+    EXPECT_TRUE(doca::offloadable_dst_ports(make_filter({}, {"0-65535"})).empty());
+}
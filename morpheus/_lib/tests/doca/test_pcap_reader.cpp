@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // for get_morpheus_root
+
+#include "morpheus/doca/pcap_reader.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t, uint32_t, uint64_t
+#include <stdexcept>  // for runtime_error
+#include <string>     // for string
+#include <vector>     // for vector
+
+using namespace morpheus;
+
+namespace {
+// The fixtures hold a 60 byte frame of the bytes 0 to 59, and a frame of 0xAA bytes snapped to 14 of its 100 bytes
+struct Frame
+{
+    uint32_t captured_length;
+    uint32_t original_length;
+    uint64_t timestamp_ns;
+    uint8_t first_byte;
+};
+
+const uint32_t FULL    = 60;
+const uint32_t SNAPPED = 14;
+
+std::string fixture(const std::string& name)
+{
+    return (test::get_morpheus_root() / "tests/tests_data/pcap" / name).string();
+}
+
+std::vector<Frame> read_all(doca::PcapReader& reader)
+{
+    std::vector<Frame> frames;
+
+    doca::PcapPacket packet{};
+    while (reader.next(packet))
+    {
+        frames.push_back({packet.captured_length, packet.original_length, packet.timestamp_ns, packet.data[0]});
+
+        // Frames point into the capture, they are never truncated below their captured length
+        if (packet.captured_length == FULL)
+        {
+            EXPECT_EQ(packet.data[FULL - 1], FULL - 1);
+        }
+    }
+
+    return frames;
+}
+
+void expect_frames(const std::vector<Frame>& actual, const std::vector<Frame>& expected)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+
+    for (std::size_t i = 0; i < actual.size(); ++i)
+    {
+        EXPECT_EQ(actual[i].captured_length, expected[i].captured_length) << "frame " << i;
+        EXPECT_EQ(actual[i].original_length, expected[i].original_length) << "frame " << i;
+        EXPECT_EQ(actual[i].timestamp_ns, expected[i].timestamp_ns) << "frame " << i;
+        EXPECT_EQ(actual[i].first_byte, expected[i].first_byte) << "frame " << i;
+    }
+}
+}  // namespace
+
+TEST_CLASS(PcapReader);
+
+TEST_F(TestPcapReader, MicrosecondsLittleEndian)
+{
+    doca::PcapReader reader(fixture("ethernet_us_le.pcap"));
+
+    expect_frames(read_all(reader), {{FULL, 60, 1500000000, 0}, {SNAPPED, 100, 3000250000, 0xAA}});
+}
+
+TEST_F(TestPcapReader, NanosecondsBigEndian)
+{
+    doca::PcapReader reader(fixture("ethernet_ns_be.pcap"));
+
+    expect_frames(read_all(reader), {{FULL, 60, 2000000123, 0}, {SNAPPED, 100, 4999999999, 0xAA}});
+}
+
+TEST_F(TestPcapReader, Rewind)
+{
+    doca::PcapReader reader(fixture("ethernet_us_le.pcap"));
+
+    auto first = read_all(reader);
+    reader.rewind();
+
+    expect_frames(read_all(reader), first);
+}
+
+TEST_F(TestPcapReader, PcapngInterfaces)
+{
+    doca::PcapReader reader(fixture("ethernet_le.pcapng"));
+
+    // Enhanced packet blocks of interfaces in microseconds, nanoseconds and 1/1024 seconds. The simple packet block
+    // carries no timestamp and takes the one of the preceding packet.
+    expect_frames(read_all(reader),
+                  {{FULL, 60, 1500000000, 0},
+                   {SNAPPED, 100, 2000000123, 0xAA},
+                   {FULL, 60, 2000000123, 0},
+                   {FULL, 60, 3000000000, 0}});
+
+    // Interfaces are declared again by the capture after a rewind
+    reader.rewind();
+    EXPECT_EQ(read_all(reader).size(), 4u);
+}
+
+TEST_F(TestPcapReader, PcapngBigEndian)
+{
+    doca::PcapReader reader(fixture("ethernet_be.pcapng"));
+
+    expect_frames(read_all(reader), {{FULL, 60, 5000000007, 0}});
+}
+
+TEST_F(TestPcapReader, TruncatedCapture)
+{
+    // The packets preceding the truncated one are read, the capture then ends
+    doca::PcapReader pcap(fixture("truncated.pcap"));
+    expect_frames(read_all(pcap), {{FULL, 60, 1500000000, 0}});
+
+    doca::PcapPacket packet{};
+    EXPECT_FALSE(pcap.next(packet));
+
+    doca::PcapReader pcapng(fixture("truncated.pcapng"));
+    EXPECT_EQ(read_all(pcapng).size(), 3u);
+}
+
+TEST_F(TestPcapReader, NonEthernetCapture)
+{
+    // The link type of pcap is in the file header, that of pcapng in the interface of each packet
+    EXPECT_THROW(doca::PcapReader(fixture("raw_ip.pcap")), std::runtime_error);
+
+    doca::PcapReader reader(fixture("raw_ip.pcapng"));
+    doca::PcapPacket packet{};
+    EXPECT_THROW(reader.next(packet), std::runtime_error);
+}
+
+TEST_F(TestPcapReader, InvalidCapture)
+{
+    EXPECT_THROW(doca::PcapReader(fixture("missing.pcap")), std::runtime_error);
+    EXPECT_THROW(doca::PcapReader(fixture("../simple.json")), std::runtime_error);
+}
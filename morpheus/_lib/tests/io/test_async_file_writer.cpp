@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/io/async_file_writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>   // for istreambuf_iterator
+#include <stdexcept>  // for logic_error
+#include <string>
+
+using namespace morpheus;
+
+namespace {
+std::string read_file(const std::filesystem::path& file_path)
+{
+    std::ifstream in_stream{file_path, std::ios::binary};
+    return {std::istreambuf_iterator<char>(in_stream), std::istreambuf_iterator<char>()};
+}
+}  // namespace
+
+TEST_CLASS(AsyncFileWriter);
+
+TEST_F(TestAsyncFileWriter, WritesInOrder)
+{
+    for (std::size_t max_queue_depth : {0, 1, 4})
+    {
+        auto path = std::filesystem::temp_directory_path() / "morpheus_test_async_file_writer.csv";
+
+        AsyncFileWriter writer(max_queue_depth);
+        writer.open(path);
+
+        std::string expected;
+        for (int i = 0; i < 100; ++i)
+        {
+            auto line = std::to_string(i) + "\n";
+            expected += line;
+            writer.write(line);
+        }
+
+        EXPECT_EQ(writer.bytes_queued(), expected.size());
+        writer.close();
+
+        EXPECT_EQ(read_file(path), expected);
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_F(TestAsyncFileWriter, OpenStartsNewFile)
+{
+    auto first  = std::filesystem::temp_directory_path() / "morpheus_test_async_file_writer.csv";
+    auto second = std::filesystem::temp_directory_path() / "morpheus_test_async_file_writer.1.csv";
+
+    AsyncFileWriter writer(2);
+    writer.open(first);
+    writer.write("a,b\n");
+
+    writer.open(second);
+    EXPECT_EQ(writer.bytes_queued(), 0U);
+    writer.write("c,d\n");
+    writer.close();
+
+    EXPECT_EQ(read_file(first), "a,b\n");
+    EXPECT_EQ(read_file(second), "c,d\n");
+
+    std::filesystem::remove(first);
+    std::filesystem::remove(second);
+}
+
+TEST_F(TestAsyncFileWriter, Gzip)
+{
+    auto path = std::filesystem::temp_directory_path() / "morpheus_test_async_file_writer.json.gz";
+
+    AsyncFileWriter writer(2, true);
+    writer.open(path);
+    writer.write(std::string(16 * 1024, 'a'));
+    writer.close();
+
+    // Highly repetitive input should compress well below its size
+    auto contents = read_file(path);
+    ASSERT_GT(contents.size(), 2U);
+    EXPECT_LT(contents.size(), 1024U);
+    EXPECT_EQ(static_cast<unsigned char>(contents[0]), 0x1f);
+    EXPECT_EQ(static_cast<unsigned char>(contents[1]), 0x8b);
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(TestAsyncFileWriter, WriteBeforeOpen)
+{
+    AsyncFileWriter writer(1);
+    EXPECT_THROW(writer.write("a"), std::logic_error);
+}
@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/io/batch_file_reader.hpp"
+#include "morpheus/objects/pinned_host_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>  // for runtime_error
+#include <string>
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+std::vector<std::string> write_files(std::size_t num_files)
+{
+    std::vector<std::string> filenames;
+
+    for (std::size_t i = 0; i < num_files; ++i)
+    {
+        auto path = std::filesystem::temp_directory_path() /
+                    ("morpheus_test_batch_file_reader." + std::to_string(i) + ".jsonlines");
+
+        // Sizes vary from empty to several pages
+        std::ofstream out_stream{path, std::ios::binary};
+        out_stream << std::string((i * 997) % 20000, static_cast<char>('a' + i % 26));
+
+        filenames.push_back(path.string());
+    }
+
+    return filenames;
+}
+
+void remove_files(const std::vector<std::string>& filenames)
+{
+    for (const auto& filename : filenames)
+    {
+        std::filesystem::remove(filename);
+    }
+}
+}  // namespace
+
+TEST_CLASS(BatchFileReader);
+
+TEST_F(TestBatchFileReader, ReadsEveryFile)
+{
+    // A queue depth smaller than the number of files keeps submitting as reads complete
+    for (unsigned queue_depth : {1, 8, 64})
+    {
+        auto filenames = write_files(100);
+
+        BatchFileReader reader(queue_depth);
+        PinnedHostBuffer buffer;
+        auto contents = reader.read(filenames, buffer, 20000);
+
+        ASSERT_EQ(contents.size(), filenames.size());
+
+        for (std::size_t i = 0; i < filenames.size(); ++i)
+        {
+            ASSERT_TRUE(contents[i].has_value());
+            EXPECT_EQ(std::string(*contents[i]), std::string((i * 997) % 20000, static_cast<char>('a' + i % 26)));
+        }
+
+        remove_files(filenames);
+    }
+}
+
+TEST_F(TestBatchFileReader, SkipsLargeFiles)
+{
+    auto filenames = write_files(20);
+
+    BatchFileReader reader;
+    PinnedHostBuffer buffer;
+    auto contents = reader.read(filenames, buffer, 10000);
+
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+    {
+        EXPECT_EQ(contents[i].has_value(), (i * 997) % 20000 <= 10000);
+    }
+
+    remove_files(filenames);
+}
+
+TEST_F(TestBatchFileReader, MissingFile)
+{
+    BatchFileReader reader;
+    PinnedHostBuffer buffer;
+
+    EXPECT_THROW(reader.read({"/does/not/exist.jsonlines"}, buffer, 1024), std::runtime_error);
+}
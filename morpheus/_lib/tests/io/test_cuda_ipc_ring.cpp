@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/io/cuda_ipc_ring.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>  // for uint8_t
+#include <future>   // for async
+#include <memory>
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <vector>
+
+using namespace morpheus;
+using namespace std::chrono_literals;
+
+namespace {
+// The buffers of a process cannot be mapped by the same process, the messages only hold a header
+std::vector<uint8_t> make_header(uint8_t value)
+{
+    return {value, static_cast<uint8_t>(value + 1)};
+}
+}  // namespace
+
+TEST_CLASS(CudaIpcRing);
+
+TEST_F(TestCudaIpcRing, PopsInOrder)
+{
+    auto producer = CudaIpcRing::create("morpheus-test-cuda-ipc-order", 4);
+    auto consumer = CudaIpcRing::open("morpheus-test-cuda-ipc-order", 1s);
+
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(producer->push(make_header(i), {}, nullptr));
+    }
+
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        auto message = consumer->pop();
+        ASSERT_TRUE(message.has_value());
+        EXPECT_EQ(message->header, make_header(i));
+        EXPECT_TRUE(message->buffers.empty());
+    }
+}
+
+TEST_F(TestCudaIpcRing, CloseEndsTheStream)
+{
+    auto producer = CudaIpcRing::create("morpheus-test-cuda-ipc-close", 4);
+    auto consumer = CudaIpcRing::open("morpheus-test-cuda-ipc-close", 1s);
+
+    EXPECT_TRUE(producer->push(make_header(7), {}, nullptr));
+
+    // Messages pushed before closing are still popped
+    auto closed = std::async(std::launch::async, [&producer]() {
+        return producer->close(5s);
+    });
+
+    auto message = consumer->pop();
+    ASSERT_TRUE(message.has_value());
+    EXPECT_EQ(message->header, make_header(7));
+    message.reset();
+
+    EXPECT_TRUE(closed.get());
+    EXPECT_FALSE(consumer->pop().has_value());
+}
+
+TEST_F(TestCudaIpcRing, PushWaitsForARelease)
+{
+    auto producer = CudaIpcRing::create("morpheus-test-cuda-ipc-release", 1);
+    auto consumer = CudaIpcRing::open("morpheus-test-cuda-ipc-release", 1s);
+
+    // The owner is held until the consumer releases the message
+    auto owner = std::make_shared<int>(0);
+    EXPECT_TRUE(producer->push(make_header(1), {}, owner));
+    EXPECT_EQ(owner.use_count(), 2);
+
+    auto first = consumer->pop();
+    ASSERT_TRUE(first.has_value());
+
+    auto pushed = std::async(std::launch::async, [&producer]() {
+        return producer->push(make_header(2), {}, nullptr);
+    });
+
+    EXPECT_EQ(pushed.wait_for(50ms), std::future_status::timeout);
+
+    first.reset();
+    EXPECT_TRUE(pushed.get());
+    EXPECT_EQ(owner.use_count(), 1);
+
+    auto second = consumer->pop();
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->header, make_header(2));
+}
+
+TEST_F(TestCudaIpcRing, StopCancels)
+{
+    auto producer = CudaIpcRing::create("morpheus-test-cuda-ipc-stop", 1);
+    auto consumer = CudaIpcRing::open("morpheus-test-cuda-ipc-stop", 1s);
+
+    auto should_stop = []() {
+        return true;
+    };
+
+    EXPECT_FALSE(consumer->pop(should_stop).has_value());
+
+    EXPECT_TRUE(producer->push(make_header(1), {}, nullptr));
+    EXPECT_FALSE(producer->push(make_header(2), {}, nullptr, should_stop));
+
+    EXPECT_EQ(CudaIpcRing::open("morpheus-test-cuda-ipc-missing", 10s, should_stop), nullptr);
+}
+
+TEST_F(TestCudaIpcRing, Errors)
+{
+    EXPECT_THROW(CudaIpcRing::create("morpheus-test-cuda-ipc-errors", 0), std::invalid_argument);
+    EXPECT_THROW(CudaIpcRing::open("morpheus-test-cuda-ipc-missing", 10ms), std::runtime_error);
+
+    auto producer = CudaIpcRing::create("morpheus-test-cuda-ipc-errors", 1, 4);
+    EXPECT_THROW(producer->push(std::vector<uint8_t>(5), {}, nullptr), std::invalid_argument);
+    EXPECT_THROW(producer->push({}, std::vector<CudaIpcBuffer>(CudaIpcRing::MaxBuffers + 1), nullptr),
+                 std::invalid_argument);
+}
@@ -18,7 +18,9 @@
 #include "../test_utils/common.hpp"  // IWYU pragma: associated
 #include "test_io.hpp"
 
+#include "morpheus/io/data_load_scheduler.hpp"
 #include "morpheus/io/data_loader.hpp"
+#include "morpheus/io/data_loader_cache.hpp"
 #include "morpheus/io/loaders/file.hpp"
 #include "morpheus/io/loaders/payload.hpp"
 #include "morpheus/messages/control.hpp"
@@ -28,11 +30,16 @@
 #include <pybind11/embed.h>
 #include <unistd.h>
 
+#include <algorithm>  // for max
+#include <atomic>
+#include <chrono>  // for milliseconds
 #include <cstdlib>
 #include <fstream>
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>  // for sleep_for
 #include <vector>
 
 namespace py = pybind11;
@@ -160,3 +167,162 @@ TEST_F(TestDataLoader, FileLoaderTest)
     auto mm2 = data_loader.load(msg);
     unlink(temp_file);
 }
+
+/**
+ * @brief Check that loading the same unchanged file twice is served from the cache, and that entries are evicted.
+ */
+TEST_F(TestDataLoader, FileLoaderCacheTest)
+{
+    auto data_loader = DataLoader(nlohmann::json{{"cache_device_bytes", 1024 * 1024}});
+    data_loader.add_loader("file", std::make_unique<FileDataLoader>());
+
+    auto string_df = create_mock_csv_file({"col1", "col2", "col3"}, {"int32", "float32", "string"}, 5);
+
+    char temp_file[] = "/tmp/morpheus_test_XXXXXXXX";  // NOLINT
+    int fd           = mkstemp(temp_file);
+    if (fd == -1)
+    {
+        GTEST_SKIP() << "Failed to create temporary file, skipping test";
+    }
+
+    std::fstream data_file(temp_file, std::ios::out | std::ios::binary | std::ios::trunc);
+    data_file << string_df;
+    data_file.close();
+
+    nlohmann::json message_config;
+    message_config["tasks"] = {{{"type", "load"},
+                                {"properties",
+                                 {
+                                     {"loader_id", "file"},
+                                     {"strategy", "aggregate"},
+                                     {"files",
+                                      {
+                                          {{"path", std::string(temp_file)}, {"type", "csv"}},
+                                      }},
+                                 }}}};
+
+    auto loaded = data_loader.load(std::make_shared<ControlMessage>(message_config));
+    EXPECT_EQ(loaded->payload()->count(), 5);
+
+    // The same task is served from the cache, with its own copy of the table
+    auto reloaded = data_loader.load(std::make_shared<ControlMessage>(message_config));
+    EXPECT_NE(reloaded->payload(), loaded->payload());
+    EXPECT_EQ(reloaded->payload()->count(), 5);
+
+    // The key depends on the state of the file, it is computed before removing it
+    auto cache_key = DataLoaderCache::make_key(message_config["tasks"][0]["properties"]);
+    ASSERT_TRUE(cache_key.has_value());
+    unlink(temp_file);
+
+    DataLoaderCache cache(1024 * 1024);
+    cache.put(*cache_key, loaded->payload());
+    EXPECT_GT(cache.device_bytes(), 0);
+
+    auto cached = cache.get(*cache_key);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_NE(cached, loaded->payload());
+    EXPECT_EQ(cached->count(), loaded->payload()->count());
+    EXPECT_EQ(cached->get_column_names(), loaded->payload()->get_column_names());
+
+    // Without host memory to spill to, a cache too small for both entries evicts the least recently used one
+    DataLoaderCache small_cache(cache.device_bytes());
+    small_cache.put("first", loaded->payload());
+    small_cache.put("second", loaded->payload());
+    EXPECT_EQ(small_cache.get("first"), nullptr);
+    EXPECT_NE(small_cache.get("second"), nullptr);
+    EXPECT_EQ(small_cache.host_bytes(), 0);
+}
+
+/**
+ * @brief Check that loads run concurrently while messages are popped in the order of their ordering key, and that a
+ * loader limit is never exceeded.
+ */
+TEST_F(TestDataLoader, DataLoadSchedulerTest)
+{
+    auto make_message = [](const std::string& loader_id, int index, const std::string& user) {
+        nlohmann::json message_config;
+        message_config["tasks"]    = {{{"type", "load"}, {"properties", {{"loader_id", loader_id}}}}};
+        message_config["metadata"] = {{"index", index}, {"user", user}};
+        return std::make_shared<ControlMessage>(message_config);
+    };
+
+    std::atomic<int> active_rest{0};
+    std::atomic<int> max_active_rest{0};
+
+    // Earlier messages take longer to load, such that they end last
+    auto load_fn = [&](std::shared_ptr<ControlMessage> message) {
+        bool is_rest = message->get_tasks()["load"][0]["loader_id"] == "rest";
+        if (is_rest)
+        {
+            max_active_rest = std::max(max_active_rest.load(), ++active_rest);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10 * (8 - message->get_metadata("index").get<int>())));
+
+        if (is_rest)
+        {
+            --active_rest;
+        }
+
+        return message;
+    };
+
+    DataLoadScheduler ordered_scheduler(load_fn, 4, 8, {{"rest", 1}});
+    for (int i = 0; i < 8; ++i)
+    {
+        EXPECT_TRUE(ordered_scheduler.submit(make_message(i % 2 == 0 ? "rest" : "file", i, "")));
+    }
+
+    ordered_scheduler.close();
+    EXPECT_FALSE(ordered_scheduler.submit(make_message("file", 0, "")));
+
+    std::vector<int> popped;
+    while (auto message = ordered_scheduler.pop())
+    {
+        popped.push_back((*message)->get_metadata("index").get<int>());
+    }
+
+    EXPECT_EQ(popped, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+    EXPECT_EQ(max_active_rest, 1);
+
+    // Ordered by user only, the messages of each user keep their order
+    DataLoadScheduler keyed_scheduler(load_fn, 4, 8, {}, true, "user");
+    for (int i = 0; i < 8; ++i)
+    {
+        EXPECT_TRUE(keyed_scheduler.submit(make_message("file", i, i < 4 ? "a" : "b")));
+    }
+
+    keyed_scheduler.close();
+
+    std::map<std::string, std::vector<int>> popped_by_user;
+    while (auto message = keyed_scheduler.pop())
+    {
+        popped_by_user[(*message)->get_metadata("user").get<std::string>()].push_back(
+            (*message)->get_metadata("index").get<int>());
+    }
+
+    EXPECT_EQ(popped_by_user["a"], std::vector<int>({0, 1, 2, 3}));
+    EXPECT_EQ(popped_by_user["b"], std::vector<int>({4, 5, 6, 7}));
+}
+
+/**
+ * @brief Check that the failure of a load is rethrown when popping its message.
+ */
+TEST_F(TestDataLoader, DataLoadSchedulerFailureTest)
+{
+    DataLoadScheduler scheduler(
+        [](std::shared_ptr<ControlMessage> message) -> std::shared_ptr<ControlMessage> {
+            throw std::runtime_error("load failed");
+        },
+        2,
+        2);
+
+    EXPECT_TRUE(scheduler.submit(std::make_shared<ControlMessage>()));
+    scheduler.close();
+
+    EXPECT_THROW(scheduler.pop(), std::runtime_error);
+    EXPECT_FALSE(scheduler.pop().has_value());
+
+    EXPECT_THROW(DataLoadScheduler(nullptr, 0, 1), std::invalid_argument);
+    EXPECT_THROW(DataLoadScheduler(nullptr, 1, 1, {{"rest", 0}}), std::invalid_argument);
+}
@@ -24,5 +24,6 @@ namespace morpheus::test {
 using TestLoader             = TestWithPythonInterpreter;  // NOLINT
 using TestDataLoader         = TestWithPythonInterpreter;  // NOLINT
 using TestDataLoaderRegistry = TestWithPythonInterpreter;  // NOLINT
+using TestPayloadDecoder     = TestWithPythonInterpreter;  // NOLINT
 
 }  // namespace morpheus::test
@@ -15,37 +15,214 @@
  * limitations under the License.
  */
 
-#include "../test_utils/common.hpp"  // IWYU pragma: associated
+#include "../test_utils/common.hpp"        // IWYU pragma: associated
+#include "../test_utils/tensor_utils.hpp"  // for convert_to_host
 #include "test_io.hpp"
 
 #include "morpheus/io/loaders/file.hpp"
 #include "morpheus/io/loaders/grpc.hpp"
 #include "morpheus/io/loaders/payload.hpp"
 #include "morpheus/io/loaders/rest.hpp"
+#include "morpheus/io/loaders/s3.hpp"
 #include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/utilities/http_client.hpp"  // for url_encode, url_quote
 
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/system/error_code.hpp>
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/grpcpp.h>
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
 #include <pybind11/embed.h>
 #include <unistd.h>
 
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <exception>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace py = pybind11;
 using namespace morpheus;
 using namespace morpheus::test;
 
+namespace {
+// Launched with the mocks of `tests/mock_rest_server` by the python tests, or by hand
+const unsigned short MOCK_REST_SERVER_PORT = 8080;
+
+bool is_mock_rest_server_running()
+{
+    boost::asio::io_context io_context;
+    boost::asio::ip::tcp::socket socket(io_context);
+    boost::system::error_code ec;
+    socket.connect({boost::asio::ip::make_address("127.0.0.1"), MOCK_REST_SERVER_PORT}, ec);
+
+    return !ec;
+}
+
+nlohmann::json make_unavailable_task(const std::string& key, int failures)
+{
+    return {{"loader_id", "rest"},
+            {"strategy", "aggregate"},
+            {"queries",
+             {{{"endpoint", "127.0.0.1/api/v1/unavailable"},
+               {"port", std::to_string(MOCK_REST_SERVER_PORT)},
+               {"params", {{{"key", key}, {"failures", failures}}}}}}}};
+}
+
+std::string to_string(const grpc::ByteBuffer& buffer)
+{
+    std::vector<grpc::Slice> slices;
+    buffer.Dump(&slices);
+
+    std::string message;
+    for (const auto& slice : slices)
+    {
+        message.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+    }
+
+    return message;
+}
+
+/**
+ * @brief Server answering every call, whatever its method, with a stream of `responses`
+ */
+class MockStreamingServer
+{
+  public:
+    MockStreamingServer(std::vector<std::string> responses) : m_responses(std::move(responses))
+    {
+        grpc::ServerBuilder builder;
+        builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &m_port);
+        builder.RegisterAsyncGenericService(&m_service);
+        m_queue  = builder.AddCompletionQueue();
+        m_server = builder.BuildAndStart();
+        m_thread = std::thread([this]() {
+            this->serve();
+        });
+    }
+
+    ~MockStreamingServer()
+    {
+        m_server->Shutdown();
+        m_thread.join();
+        m_queue->Shutdown();
+
+        void* tag;
+        bool ok;
+        while (m_queue->Next(&tag, &ok)) {}
+    }
+
+    std::string endpoint() const
+    {
+        return "127.0.0.1:" + std::to_string(m_port);
+    }
+
+    // The method and request of the last call
+    std::pair<std::string, std::string> last_call()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return {m_method, m_request};
+    }
+
+  private:
+    void serve()
+    {
+        while (true)
+        {
+            grpc::GenericServerContext context;
+            grpc::GenericServerAsyncReaderWriter stream(&context);
+            m_service.RequestCall(&context, &stream, m_queue.get(), m_queue.get(), this);
+            if (!this->wait())
+            {
+                return;
+            }
+
+            grpc::ByteBuffer request;
+            stream.Read(&request, this);
+            if (this->wait())
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_method  = context.method();
+                m_request = to_string(request);
+            }
+
+            for (const auto& response : m_responses)
+            {
+                grpc::Slice slice(response);
+                grpc::ByteBuffer buffer(&slice, 1);
+                stream.Write(buffer, this);
+                if (!this->wait())
+                {
+                    break;
+                }
+            }
+
+            stream.Finish(grpc::Status::OK, this);
+            this->wait();
+        }
+    }
+
+    bool wait()
+    {
+        void* tag;
+        bool ok = false;
+
+        return m_queue->Next(&tag, &ok) && ok;
+    }
+
+    std::vector<std::string> m_responses;
+    int m_port{0};
+    grpc::AsyncGenericService m_service;
+    std::unique_ptr<grpc::ServerCompletionQueue> m_queue;
+    std::unique_ptr<grpc::Server> m_server;
+    std::thread m_thread;
+
+    std::mutex m_mutex;
+    std::string m_method;
+    std::string m_request;
+};
+
+std::string encode_varint(std::uint64_t value)
+{
+    std::string encoded;
+    for (; value >= 0x80; value >>= 7)
+    {
+        encoded.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    }
+    encoded.push_back(static_cast<char>(value));
+
+    return encoded;
+}
+
+std::string encode_length_delimited(std::uint64_t field_number, const std::string& value)
+{
+    return encode_varint((field_number << 3) | 2) + encode_varint(value.size()) + value;
+}
+
+nlohmann::json make_grpc_task(const MockStreamingServer& server)
+{
+    return {{"loader_id", "grpc"}, {"endpoint", server.endpoint()}, {"method", "/test.Records/Stream"}};
+}
+}  // namespace
+
 TEST_F(TestLoader, LoaderInitializationTest)
 {
     auto file    = FileDataLoader();
     auto grpc    = GRPCDataLoader();
     auto payload = PayloadDataLoader();
     auto rest    = RESTDataLoader();
+    auto s3      = S3DataLoader();
 }
 
 TEST_F(TestLoader, LoaderFileTest)
@@ -81,6 +258,43 @@ TEST_F(TestLoader, LoaderFileTest)
     unlink(temp_file);
 }
 
+TEST_F(TestLoader, LoaderFileAggregateTest)
+{
+    auto string_df = create_mock_csv_file({"col1", "col2", "col3"}, {"int32", "float32", "string"}, 5);
+
+    std::vector<std::string> temp_files;
+    nlohmann::json files = nlohmann::json::array();
+    for (int i = 0; i < 2; ++i)
+    {
+        char temp_file[] = "/tmp/morpheus_test_XXXXXXXX";  // NOLINT
+        int fd           = mkstemp(temp_file);
+        if (fd == -1)
+        {
+            GTEST_SKIP() << "Failed to create temporary file, skipping test";
+        }
+
+        std::fstream data_file(temp_file, std::ios::out | std::ios::binary | std::ios::trunc);
+        data_file << string_df;
+        data_file.close();
+
+        temp_files.emplace_back(temp_file);
+        files.push_back({{"path", temp_files.back()}, {"type", "csv"}});
+    }
+
+    nlohmann::json task_properties = {{"loader_id", "file"}, {"strategy", "aggregate"}, {"files", files}};
+
+    auto msg    = std::make_shared<ControlMessage>();
+    auto loader = FileDataLoader();
+
+    auto loaded = loader.load(msg, task_properties);
+    EXPECT_EQ(loaded->payload()->count(), 10);
+
+    for (const auto& temp_file : temp_files)
+    {
+        unlink(temp_file.c_str());
+    }
+}
+
 TEST_F(TestLoader, LoaderGRPCTest)
 {
     auto msg    = std::make_shared<ControlMessage>();
@@ -90,6 +304,83 @@ TEST_F(TestLoader, LoaderGRPCTest)
     EXPECT_THROW(loader.load(msg, task), std::runtime_error);
 }
 
+TEST_F(TestLoader, LoaderGRPCDecodesRequest)
+{
+    MockStreamingServer server({R"({"id": 1})"});
+    auto loader = GRPCDataLoader();
+
+    // The request is sent as the bytes it encodes, its padding being dropped
+    auto task              = make_grpc_task(server);
+    task["request_base64"] = "CgNhYmMQAQ==";
+
+    auto loaded = loader.load(std::make_shared<ControlMessage>(), task);
+    EXPECT_EQ(loaded->payload()->count(), 1);
+    EXPECT_EQ(server.last_call().first, "/test.Records/Stream");
+    EXPECT_EQ(server.last_call().second, "\x0a\x03"
+                                         "abc\x10\x01");
+
+    // Calls are made with an empty request by default
+    task.erase("request_base64");
+    loader.load(std::make_shared<ControlMessage>(), task);
+    EXPECT_EQ(server.last_call().second, "");
+
+    // Characters outside of the base64 alphabet are rejected before calling the server
+    task["request_base64"] = "Cg*h";
+    EXPECT_THROW(loader.load(std::make_shared<ControlMessage>(), task), std::runtime_error);
+}
+
+TEST_F(TestLoader, LoaderGRPCExtractsPayloadField)
+{
+    // The records are in field 2, after and among fields of every other wire type. The second record is long enough
+    // for its length to take two bytes.
+    const std::string long_text(200, 'x');
+    const std::string first = encode_varint((1 << 3) | 0) + encode_varint(150) +
+                              encode_length_delimited(2, R"({"id": 1, "text": "a"})") +
+                              encode_varint((3 << 3) | 5) + std::string(4, '\x01') +
+                              encode_varint((4 << 3) | 1) + std::string(8, '\x02') +
+                              encode_length_delimited(5, R"({"id": 100, "text": "ignored"})");
+    const std::string second = encode_length_delimited(2, R"({"id": 2, "text": ")" + long_text + "\"}\n" +
+                                                              R"({"id": 3, "text": "c"})");
+
+    MockStreamingServer server({first, second});
+    auto loader = GRPCDataLoader();
+
+    auto task             = make_grpc_task(server);
+    task["payload_field"] = 2;
+
+    auto loaded = loader.load(std::make_shared<ControlMessage>(), task);
+    ASSERT_EQ(loaded->payload()->count(), 3);
+    EXPECT_EQ(loaded->payload()->get_info().get_column_names(), (std::vector<std::string>{"id", "text"}));
+    EXPECT_EQ(convert_to_host<int64_t>(loaded->payload()->get_info().get_column(0)),
+              (std::vector<int64_t>{1, 2, 3}));
+
+    // A length running past the end of the message is rejected
+    MockStreamingServer truncated({encode_varint((2 << 3) | 2) + encode_varint(100) + "{}"});
+    task["endpoint"] = truncated.endpoint();
+    EXPECT_THROW(loader.load(std::make_shared<ControlMessage>(), task), std::runtime_error);
+}
+
+TEST_F(TestLoader, LoaderGRPCBatchesRecords)
+{
+    // Records of different columns can only be loaded when parsed within the same batch
+    MockStreamingServer server({R"({"a": 1})", R"({"b": 2})"});
+    auto task = make_grpc_task(server);
+
+    auto loaded = GRPCDataLoader().load(std::make_shared<ControlMessage>(), task);
+    EXPECT_EQ(loaded->payload()->count(), 2);
+    EXPECT_EQ(loaded->payload()->get_info().get_column_names(), (std::vector<std::string>{"a", "b"}));
+
+    // With one message per batch, each one is parsed on its own
+    auto batched = GRPCDataLoader(nlohmann::json{{"batch_bytes", 1}});
+    EXPECT_THROW(batched.load(std::make_shared<ControlMessage>(), task), std::runtime_error);
+
+    // Batches are concatenated in the order of the stream
+    MockStreamingServer same_columns({R"({"a": 1})", R"({"a": 2})", R"({"a": 3})"});
+    loaded = batched.load(std::make_shared<ControlMessage>(), make_grpc_task(same_columns));
+    EXPECT_EQ(convert_to_host<int64_t>(loaded->payload()->get_info().get_column(0)),
+              (std::vector<int64_t>{1, 2, 3}));
+}
+
 TEST_F(TestLoader, LoaderPayloadTest)
 {
     auto msg    = std::make_shared<ControlMessage>();
@@ -107,3 +398,66 @@ TEST_F(TestLoader, LoaderRESTTest)
 
     EXPECT_THROW(loader.load(msg, task), std::exception);
 }
+
+TEST_F(TestLoader, LoaderRESTUrlQuote)
+{
+    EXPECT_EQ(url_quote("AZaz09_.-~", ""), "AZaz09_.-~");
+
+    // Spaces are only encoded as '+' in queries, where a '+' must then be encoded itself
+    EXPECT_EQ(url_quote("a b", ""), "a%20b");
+    EXPECT_EQ(url_quote("a b", "", true), "a+b");
+    EXPECT_EQ(url_quote("a+b", "", true), "a%2Bb");
+
+    // Slashes are kept in paths only
+    EXPECT_EQ(url_quote("/api/v 1/", "/"), "/api/v%201/");
+    EXPECT_EQ(url_quote("/api/", "", true), "%2Fapi%2F");
+
+    // Each byte of a non-ASCII character is encoded in uppercase hex
+    EXPECT_EQ(url_quote("caf\xc3\xa9", ""), "caf%C3%A9");
+    EXPECT_EQ(url_quote("\x7f", ""), "%7F");
+}
+
+TEST_F(TestLoader, LoaderRESTUrlEncode)
+{
+    EXPECT_EQ(url_encode({}), "");
+    EXPECT_EQ(url_encode({{"q", ""}}), "?q=");
+    EXPECT_EQ(url_encode({{"a b", "c+d"}, {"path", "/x/y"}, {"name", "\xc3\xa9t\xc3\xa9"}}),
+              "?a+b=c%2Bd&path=%2Fx%2Fy&name=%C3%A9t%C3%A9");
+}
+
+TEST_F(TestLoader, LoaderRESTRetriesUnavailable)
+{
+    if (!is_mock_rest_server_running())
+    {
+        GTEST_SKIP() << "The mock REST server is not running, skipping test";
+    }
+
+    // Requests are counted by key by the mock server, which keeps its counters until it is restarted
+    const auto key = "retry_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+
+    auto loader = RESTDataLoader(nlohmann::json{{"max_retry", 3}, {"retry_interval_milliseconds", 10}});
+
+    // Answered on the third attempt, after two 503 responses
+    auto loaded = loader.load(std::make_shared<ControlMessage>(), make_unavailable_task(key + "_ok", 2));
+    ASSERT_EQ(loaded->payload()->count(), 1);
+    EXPECT_EQ(convert_to_host<int64_t>(loaded->payload()->get_info().get_column(0)), (std::vector<int64_t>{3}));
+
+    // Still unavailable after `max_retry` attempts
+    EXPECT_THROW(loader.load(std::make_shared<ControlMessage>(), make_unavailable_task(key + "_failed", 3)),
+                 std::runtime_error);
+}
+
+TEST_F(TestLoader, LoaderS3Test)
+{
+    auto msg    = std::make_shared<ControlMessage>();
+    auto loader = S3DataLoader();
+
+    EXPECT_THROW(loader.load(msg, nlohmann::json()), std::runtime_error);
+
+    // Objects must be given as s3://bucket/key URIs
+    auto task = nlohmann::json::parse(R"({"files": ["/tmp/data.csv"]})");
+    EXPECT_THROW(loader.load(msg, task), std::runtime_error);
+
+    task = nlohmann::json::parse(R"({"files": ["s3://bucket"]})");
+    EXPECT_THROW(loader.load(msg, task), std::runtime_error);
+}
@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // IWYU pragma: associated
+#include "test_io.hpp"
+
+#include "morpheus/io/payload_decoder.hpp"
+
+#include <arrow/api.h>
+#include <arrow/io/memory.h>   // for BufferOutputStream
+#include <arrow/ipc/writer.h>  // for MakeStreamWriter
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>  // for type_id
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>  // for move
+#include <vector>
+
+using namespace morpheus;
+using namespace morpheus::test;
+
+namespace {
+std::string make_arrow_stream(const std::vector<int64_t>& values)
+{
+    arrow::Int64Builder builder;
+    EXPECT_TRUE(builder.AppendValues(values).ok());
+    auto column = builder.Finish().ValueOrDie();
+
+    auto schema = arrow::schema({arrow::field("v", arrow::int64())});
+    auto batch  = arrow::RecordBatch::Make(schema, static_cast<int64_t>(values.size()), {column});
+
+    auto sink   = arrow::io::BufferOutputStream::Create().ValueOrDie();
+    auto writer = arrow::ipc::MakeStreamWriter(sink, schema).ValueOrDie();
+    EXPECT_TRUE(writer->WriteRecordBatch(*batch).ok());
+    EXPECT_TRUE(writer->Close().ok());
+
+    return sink->Finish().ValueOrDie()->ToString();
+}
+}  // namespace
+
+TEST_F(TestPayloadDecoder, DecodeJsonLines)
+{
+    // Payloads sent as C-strings include their terminator
+    std::string first{"{\"v\": 1}\n{\"v\": 2}"};
+    std::string second{"{\"v\": 3}\0", 9};
+
+    auto decoder = PayloadDecoder::create("json");
+    auto table   = decoder->decode({first, second});
+
+    EXPECT_EQ(table.tbl->num_rows(), 3);
+    ASSERT_EQ(table.metadata.schema_info.size(), 1);
+    EXPECT_EQ(table.metadata.schema_info[0].name, "v");
+}
+
+TEST_F(TestPayloadDecoder, DecodeArrowStreams)
+{
+    auto first  = make_arrow_stream({1, 2, 3});
+    auto second = make_arrow_stream({4, 5});
+
+    auto decoder = PayloadDecoder::create("arrow");
+    auto table   = decoder->decode({first, second});
+
+    EXPECT_EQ(table.tbl->num_rows(), 5);
+    EXPECT_EQ(table.tbl->num_columns(), 1);
+    EXPECT_EQ(table.tbl->get_column(0).type().id(), cudf::type_id::INT64);
+    EXPECT_EQ(table.metadata.schema_info[0].name, "v");
+}
+
+TEST_F(TestPayloadDecoder, CreateRegisteredDecoder)
+{
+    EXPECT_THROW(PayloadDecoder::create("not_a_format"), std::runtime_error);
+
+    // Formats are resolved through the registry, so a decoder registered under a new name can be created
+    PayloadDecoderRegistry::register_factory_fn("CreateRegisteredDecoder", [](nlohmann::json config) {
+        return PayloadDecoder::create("json", std::move(config));
+    });
+
+    auto decoder = PayloadDecoder::create("CreateRegisteredDecoder", {{"lines", false}});
+    auto table   = decoder->decode({"[{\"v\": 1}, {\"v\": 2}]"});
+    EXPECT_EQ(table.tbl->num_rows(), 2);
+
+    PayloadDecoderRegistry::unregister_factory_fn("CreateRegisteredDecoder");
+}
@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"        // IWYU pragma: associated
+#include "../test_utils/tensor_utils.hpp"  // for assert_eq_device_to_device
+
+#include "morpheus/io/deserializers.hpp"  // for load_table_from_file
+#include "morpheus/io/source_capture.hpp"
+
+#include <cudf/table/table.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(SourceCapture);
+
+TEST_F(TestSourceCapture, RoundTrip)
+{
+    auto path  = std::filesystem::temp_directory_path() / "morpheus_test_source_capture.arrows";
+    auto table = load_table_from_file(test::get_morpheus_root() / "tests/tests_data/filter_probs.csv");
+
+    // The columns differ between batches
+    cudf::io::table_metadata first_metadata;
+    first_metadata.schema_info = {table.metadata.schema_info.front()};
+
+    const auto first_arrival  = std::chrono::system_clock::now();
+    const auto second_arrival = first_arrival + std::chrono::milliseconds(250);
+    {
+        SourceCaptureWriter writer(path);
+        writer.write(table.tbl->view().select({0}), first_metadata, first_arrival);
+        writer.write(table.tbl->view(), table.metadata, second_arrival);
+        writer.close();
+    }
+
+    SourceCaptureReader reader(path);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        auto first = reader.next();
+        ASSERT_TRUE(first.has_value());
+        EXPECT_EQ(first->table.tbl->num_columns(), 1);
+        EXPECT_EQ(first->table.metadata.schema_info.front().name, table.metadata.schema_info.front().name);
+        EXPECT_EQ(first->arrival_time, first_arrival);
+        test::assert_eq_device_to_device<double>(first->table.tbl->get_column(0).view(),
+                                                 table.tbl->get_column(0).view());
+
+        auto second = reader.next();
+        ASSERT_TRUE(second.has_value());
+        EXPECT_EQ(second->table.tbl->num_columns(), table.tbl->num_columns());
+        EXPECT_EQ(second->table.tbl->num_rows(), table.tbl->num_rows());
+        EXPECT_EQ(second->arrival_time - first->arrival_time, std::chrono::milliseconds(250));
+
+        EXPECT_FALSE(reader.next().has_value());
+        reader.rewind();
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(TestSourceCapture, TruncatedLog)
+{
+    auto path  = std::filesystem::temp_directory_path() / "morpheus_test_source_capture_truncated.arrows";
+    auto table = load_table_from_file(test::get_morpheus_root() / "tests/tests_data/filter_probs.csv");
+    {
+        SourceCaptureWriter writer(path);
+        writer.write(table.tbl->view(), table.metadata);
+        writer.write(table.tbl->view(), table.metadata);
+    }
+
+    // A source killed while writing leaves part of its last batch
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 16);
+
+    SourceCaptureReader reader(path);
+    EXPECT_TRUE(reader.next().has_value());
+    EXPECT_FALSE(reader.next().has_value());
+
+    std::filesystem::remove(path);
+}
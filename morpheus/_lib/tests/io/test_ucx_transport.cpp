@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/io/ucx_transport.hpp"
+
+#include <cuda_runtime.h>  // for cudaMemcpy
+#include <gtest/gtest.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <rmm/device_buffer.hpp>
+
+#include <chrono>
+#include <cstdint>  // for uint16_t, int32_t
+#include <future>   // for async
+#include <memory>
+#include <numeric>  // for iota
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+constexpr uint16_t Port = 13417;
+}  // namespace
+
+TEST_CLASS(UcxTransport);
+
+TEST_F(TestUcxTransport, SendsInOrder)
+{
+    auto receiver = std::async(std::launch::async, []() {
+        auto connection = UcxConnection::accept("127.0.0.1", Port);
+
+        std::vector<int32_t> received;
+        for (int i = 0; i < 3; ++i)
+        {
+            std::vector<int32_t> buffer(i + 1);
+            EXPECT_TRUE(connection->recv(buffer.data(), buffer.size() * sizeof(int32_t)));
+            received.insert(received.end(), buffer.begin(), buffer.end());
+        }
+
+        // Device memory is received straight into the buffer
+        rmm::device_buffer device_data(4 * sizeof(int32_t), rmm::cuda_stream_default);
+        EXPECT_TRUE(connection->recv(device_data.data(), device_data.size()));
+
+        std::vector<int32_t> host_data(4);
+        MRC_CHECK_CUDA(cudaMemcpy(host_data.data(), device_data.data(), device_data.size(), cudaMemcpyDeviceToHost));
+        received.insert(received.end(), host_data.begin(), host_data.end());
+
+        return received;
+    });
+
+    auto connection = UcxConnection::connect("127.0.0.1", Port, std::chrono::seconds(10));
+
+    std::vector<int32_t> expected;
+    for (int i = 0; i < 3; ++i)
+    {
+        std::vector<int32_t> buffer(i + 1);
+        std::iota(buffer.begin(), buffer.end(), static_cast<int32_t>(expected.size()));
+        connection->send(buffer.data(), buffer.size() * sizeof(int32_t));
+        expected.insert(expected.end(), buffer.begin(), buffer.end());
+    }
+
+    std::vector<int32_t> host_data{6, 7, 8, 9};
+    rmm::device_buffer device_data(host_data.data(), host_data.size() * sizeof(int32_t), rmm::cuda_stream_default);
+    rmm::cuda_stream_default.synchronize();
+    connection->send(device_data.data(), device_data.size());
+    expected.insert(expected.end(), host_data.begin(), host_data.end());
+
+    EXPECT_EQ(receiver.get(), expected);
+}
+
+TEST_F(TestUcxTransport, StopsAccepting)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+
+    auto connection = UcxConnection::accept("127.0.0.1", Port + 1, [deadline]() {
+        return std::chrono::steady_clock::now() >= deadline;
+    });
+
+    EXPECT_EQ(connection, nullptr);
+}
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/llm/llm_admission_controller.hpp"
+
+#include <gtest/gtest.h>
+#include <mrc/coroutines/sync_wait.hpp>
+
+#include <stdexcept>
+
+using namespace morpheus;
+using namespace morpheus::test;
+using namespace mrc;
+
+TEST_CLASS(LLMAdmissionController);
+
+TEST_F(TestLLMAdmissionController, InvalidArguments)
+{
+    EXPECT_THROW(llm::LLMAdmissionController(0), std::invalid_argument);
+    EXPECT_THROW(llm::LLMAdmissionController(1, -1), std::invalid_argument);
+    EXPECT_THROW(llm::LLMAdmissionController(1, 0, 0), std::invalid_argument);
+    EXPECT_THROW(llm::LLMAdmissionController(1, 0, 0.1, 1.5), std::invalid_argument);
+}
+
+TEST_F(TestLLMAdmissionController, RequestBudget)
+{
+    llm::LLMAdmissionController controller(4);
+
+    // A second worth of requests is admitted at once
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_LT(coroutines::sync_wait(controller.acquire()), 0.05);
+    }
+
+    EXPECT_GT(coroutines::sync_wait(controller.acquire()), 0.2);
+    EXPECT_EQ(controller.num_waiting(), 0);
+}
+
+TEST_F(TestLLMAdmissionController, TokenBudget)
+{
+    // 10 tokens per second
+    llm::LLMAdmissionController controller(1000, 600);
+
+    // Calls larger than the budget are admitted with the whole budget
+    EXPECT_LT(coroutines::sync_wait(controller.acquire(1000)), 0.05);
+
+    EXPECT_GT(coroutines::sync_wait(controller.acquire(3)), 0.2);
+}
+
+TEST_F(TestLLMAdmissionController, AdaptiveRate)
+{
+    llm::LLMAdmissionController controller(10, 0, 0.2, 0.1);
+    EXPECT_DOUBLE_EQ(controller.requests_per_second(), 10);
+
+    controller.on_rate_limited();
+    EXPECT_DOUBLE_EQ(controller.requests_per_second(), 5);
+
+    // Calls failing together only decrease the rate once
+    controller.on_rate_limited();
+    EXPECT_DOUBLE_EQ(controller.requests_per_second(), 5);
+
+    controller.on_success();
+    EXPECT_DOUBLE_EQ(controller.requests_per_second(), 6);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        controller.on_success();
+    }
+
+    EXPECT_DOUBLE_EQ(controller.requests_per_second(), 10);
+}
+
+TEST_F(TestLLMAdmissionController, PauseFromHeaders)
+{
+    llm::LLMAdmissionController controller(100);
+
+    controller.on_rate_limited({{"Retry-After", "0.3"}});
+    EXPECT_GT(coroutines::sync_wait(controller.acquire()), 0.25);
+
+    // A spent budget pauses admissions until it resets
+    controller.on_success({{"x-ratelimit-remaining-requests", "0"}, {"x-ratelimit-reset-requests", "300ms"}});
+    EXPECT_GT(coroutines::sync_wait(controller.acquire()), 0.25);
+
+    controller.on_success({{"x-ratelimit-remaining-requests", "10"}, {"x-ratelimit-reset-requests", "1m0s"}});
+    EXPECT_LT(coroutines::sync_wait(controller.acquire()), 0.05);
+}
@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "../test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/llm/input_map.hpp"
+#include "morpheus/llm/llm_batching_node.hpp"
+#include "morpheus/llm/llm_context.hpp"
+#include "morpheus/llm/llm_lambda_node.hpp"
+#include "morpheus/llm/llm_task.hpp"
+#include "morpheus/types.hpp"
+
+#include <gtest/gtest.h>
+#include <mrc/coroutines/sync_wait.hpp>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <coroutine>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace morpheus;
+using namespace morpheus::test;
+using namespace mrc;
+
+TEST_CLASS(LLMBatchingNode);
+
+namespace {
+// Returns a context whose `arg0` input is `prompts`
+std::shared_ptr<llm::LLMContext> make_context(std::vector<std::string> prompts)
+{
+    auto root = std::make_shared<llm::LLMContext>(llm::LLMTask{}, nullptr);
+    root->set_output("prompts", std::move(prompts));
+
+    return root->push("generate", {{"/prompts", "arg0"}});
+}
+}  // namespace
+
+TEST_F(TestLLMBatchingNode, InvalidArguments)
+{
+    EXPECT_THROW(llm::LLMBatchingNode(nullptr), std::invalid_argument);
+
+    auto node = llm::make_lambda_node([](std::vector<std::string> prompts) -> Task<std::vector<std::string>> {
+        co_return prompts;
+    });
+
+    EXPECT_THROW(llm::LLMBatchingNode(node, 0), std::invalid_argument);
+}
+
+TEST_F(TestLLMBatchingNode, BatchesConcurrentContexts)
+{
+    std::vector<std::size_t> batch_sizes;
+
+    auto generate = llm::make_lambda_node(
+        [&batch_sizes](std::vector<std::string> prompts) -> Task<std::vector<std::string>> {
+            batch_sizes.push_back(prompts.size());
+
+            for (auto& prompt : prompts)
+            {
+                prompt += "!";
+            }
+
+            co_return prompts;
+        });
+
+    // The delay is long enough for the batch to only be dispatched once full
+    llm::LLMBatchingNode node(generate, 6, std::chrono::minutes(1));
+
+    ASSERT_EQ(node.get_input_names(), std::vector<std::string>{"arg0"});
+
+    std::vector<std::shared_ptr<llm::LLMContext>> contexts{
+        make_context({"a", "b"}), make_context({"c", "d"}), make_context({"e", "f"})};
+
+    std::vector<Task<std::shared_ptr<llm::LLMContext>>> tasks;
+    for (const auto& context : contexts)
+    {
+        tasks.push_back(node.execute(context));
+    }
+
+    tasks[0].resume();
+    tasks[1].resume();
+
+    EXPECT_FALSE(tasks[0].is_ready());
+    EXPECT_FALSE(tasks[1].is_ready());
+    EXPECT_TRUE(batch_sizes.empty());
+
+    // Filling the batch dispatches it, resuming every context
+    tasks[2].resume();
+
+    for (const auto& task : tasks)
+    {
+        EXPECT_TRUE(task.is_ready());
+    }
+
+    EXPECT_EQ(batch_sizes, std::vector<std::size_t>{6});
+    EXPECT_EQ(contexts[0]->view_outputs(), nlohmann::json({"a!", "b!"}));
+    EXPECT_EQ(contexts[1]->view_outputs(), nlohmann::json({"c!", "d!"}));
+    EXPECT_EQ(contexts[2]->view_outputs(), nlohmann::json({"e!", "f!"}));
+}
+
+TEST_F(TestLLMBatchingNode, DispatchesAfterDelay)
+{
+    auto generate = llm::make_lambda_node([](std::vector<std::string> prompts) -> Task<std::vector<std::string>> {
+        co_return prompts;
+    });
+
+    llm::LLMBatchingNode node(generate, 32, std::chrono::milliseconds(5));
+
+    auto context = make_context({"a", "b", "c"});
+    coroutines::sync_wait(node.execute(context));
+
+    EXPECT_EQ(context->view_outputs(), nlohmann::json({"a", "b", "c"}));
+}
+
+TEST_F(TestLLMBatchingNode, MismatchedOutputs)
+{
+    auto generate = llm::make_lambda_node([](std::vector<std::string> /*prompts*/) -> Task<std::vector<std::string>> {
+        co_return std::vector<std::string>{"single"};
+    });
+
+    llm::LLMBatchingNode node(generate, 4, std::chrono::minutes(1));
+
+    auto first  = node.execute(make_context({"a", "b"}));
+    auto second = node.execute(make_context({"c", "d"}));
+
+    first.resume();
+    second.resume();
+
+    // Every context of the batch fails
+    ASSERT_TRUE(first.is_ready());
+    ASSERT_TRUE(second.is_ready());
+    EXPECT_THROW(first.promise().result(), std::runtime_error);
+    EXPECT_THROW(second.promise().result(), std::runtime_error);
+}
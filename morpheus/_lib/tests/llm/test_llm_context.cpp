@@ -20,20 +20,45 @@
 #include "morpheus/llm/fwd.hpp"
 #include "morpheus/llm/input_map.hpp"
 #include "morpheus/llm/llm_context.hpp"
+#include "morpheus/llm/llm_output_column.hpp"
+#include "morpheus/llm/llm_output_stream.hpp"
 #include "morpheus/llm/llm_task.hpp"
 #include "morpheus/messages/control.hpp"
 
 #include <gtest/gtest.h>
 #include <mrc/channel/forward.hpp>
+#include <mrc/coroutines/sync_wait.hpp>
 #include <nlohmann/json.hpp>
 
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace morpheus;
 using namespace morpheus::test;
 using namespace mrc;
 
+namespace {
+class TestColumn : public llm::LLMOutputColumn
+{
+  public:
+    TestColumn(std::vector<std::string> values) : m_values(std::move(values)) {}
+
+    nlohmann::json to_json() const override
+    {
+        ++num_conversions;
+        return m_values;
+    }
+
+    mutable int num_conversions{0};
+
+  private:
+    std::vector<std::string> m_values;
+};
+}  // namespace
+
 TEST_CLASS(LLMContext);
 
 TEST_F(TestLLMContext, Initialization)
@@ -337,3 +362,116 @@ TEST_F(TestLLMContext, MultipleInputMappingsBothInvalid)
     ASSERT_THROW(child_ctx.get_input("input2"), std::runtime_error);
     ASSERT_THROW(child_ctx.get_inputs(), std::runtime_error);
 }
+
+TEST_F(TestLLMContext, OutputColumnPassedThrough)
+{
+    auto parent_ctx = std::make_shared<llm::LLMContext>(llm::LLMTask{}, nullptr);
+    auto producer   = parent_ctx->push("producer", {});
+
+    auto column = std::make_shared<TestColumn>(std::vector<std::string>{"a", "b"});
+    producer->set_output_column("prompts", column);
+    producer->set_output("count", 2);
+    producer->pop();
+
+    // Readers of the column receive it as is
+    llm::LLMContext consumer{parent_ctx, "consumer", {{"/producer/prompts", "prompts"}}};
+    ASSERT_EQ(consumer.get_input_column("prompts"), column);
+    ASSERT_EQ(column->num_conversions, 0);
+
+    // Reading a sibling output does not convert the column
+    llm::LLMContext counter{parent_ctx, "counter", {{"/producer/count", "count"}}};
+    ASSERT_EQ(counter.get_input(), 2);
+    ASSERT_EQ(column->num_conversions, 0);
+
+    // Viewing the outputs converts the column
+    ASSERT_EQ(parent_ctx->view_outputs()["producer"]["prompts"], nlohmann::json::array({"a", "b"}));
+    ASSERT_EQ(column->num_conversions, 1);
+}
+
+TEST_F(TestLLMContext, OutputColumnConvertedOnce)
+{
+    auto parent_ctx = std::make_shared<llm::LLMContext>(llm::LLMTask{}, nullptr);
+    auto producer   = parent_ctx->push("producer", {});
+
+    auto column = std::make_shared<TestColumn>(std::vector<std::string>{"a", "b"});
+    producer->set_output_column(column);
+    producer->pop();
+
+    llm::LLMContext consumer{parent_ctx, "consumer", {{"/producer/1", "second"}, {"/producer", "all"}}};
+    ASSERT_EQ(consumer.get_input("second"), "b");
+    ASSERT_EQ(consumer.get_input("all"), nlohmann::json::array({"a", "b"}));
+    ASSERT_EQ(consumer.get_input_column("all"), nullptr);
+    ASSERT_EQ(column->num_conversions, 1);
+}
+
+TEST_F(TestLLMContext, OutputColumnPopSelectOutputs)
+{
+    auto parent_ctx = std::make_shared<llm::LLMContext>(llm::LLMTask{}, nullptr);
+    auto child_ctx  = parent_ctx->push("child", {});
+
+    auto column = std::make_shared<TestColumn>(std::vector<std::string>{"a"});
+    child_ctx->set_output_column("key1", column);
+    child_ctx->set_output("key2", "val2");
+
+    child_ctx->set_output_names({"key1"});
+    child_ctx->pop();
+
+    llm::LLMContext consumer{parent_ctx, "consumer", {{"/child", "input1"}}};
+    ASSERT_EQ(consumer.get_input_column("input1"), column);
+
+    // Replacing an output drops its column
+    parent_ctx->set_output("child", "replaced");
+    ASSERT_EQ(consumer.get_input_column("input1"), nullptr);
+    ASSERT_EQ(consumer.get_input(), "replaced");
+}
+
+TEST_F(TestLLMContext, PushResolvedInputs)
+{
+    auto parent_ctx = std::make_shared<llm::LLMContext>(llm::LLMTask{}, nullptr);
+    parent_ctx->set_output({{"parent_out1", {{"nested", "val1"}}}, {"parent_out2", "val2"}});
+
+    auto resolved = std::make_shared<const llm::ResolvedInputMappings>(
+        llm::input_mappings_t{{"/parent_out1/nested", "input1"}, {"/parent_out2", "input2"}});
+    ASSERT_EQ(resolved->index_of("input2"), 1);
+    ASSERT_THROW(resolved->index_of("input3"), std::runtime_error);
+
+    // Contexts share the resolved mappings
+    auto child_ctx_1 = parent_ctx->push_resolved("child1", resolved);
+    auto child_ctx_2 = parent_ctx->push_resolved("child2", resolved);
+    ASSERT_EQ(&child_ctx_1->input_map(), &child_ctx_2->input_map());
+
+    ASSERT_EQ(child_ctx_1->get_input("input1"), "val1");
+    ASSERT_EQ(child_ctx_2->get_inputs(), nlohmann::json({{"input1", "val1"}, {"input2", "val2"}}));
+
+    // Inputs of a grandchild mapped to the inputs of its parent
+    auto grandchild_ctx = child_ctx_1->push("grandchild", {{"input2", "input"}});
+    ASSERT_EQ(grandchild_ctx->get_input(), "val2");
+}
+
+TEST_F(TestLLMContext, StreamOutput)
+{
+    auto parent_ctx = std::make_shared<llm::LLMContext>(llm::LLMTask{}, nullptr);
+    auto child_ctx  = parent_ctx->push("child", {});
+
+    // Without a stream the chunks are dropped
+    ASSERT_FALSE(child_ctx->is_streaming());
+    child_ctx->stream_output("dropped");
+
+    auto output_stream = std::make_shared<llm::LLMOutputStream>();
+    parent_ctx->set_output_stream(output_stream);
+    ASSERT_THROW(child_ctx->set_output_stream(output_stream), std::runtime_error);
+
+    ASSERT_TRUE(child_ctx->is_streaming());
+    ASSERT_EQ(child_ctx->output_stream(), output_stream);
+
+    child_ctx->stream_output({{"index", 0}, {"text", "token"}});
+    output_stream->close();
+    ASSERT_FALSE(child_ctx->is_streaming());
+
+    auto chunk = mrc::coroutines::sync_wait(output_stream->read());
+    ASSERT_TRUE(chunk.has_value());
+    ASSERT_EQ(chunk->node_name, "/child");
+    ASSERT_EQ(chunk->chunk, nlohmann::json({{"index", 0}, {"text", "token"}}));
+
+    ASSERT_FALSE(mrc::coroutines::sync_wait(output_stream->read()).has_value());
+}
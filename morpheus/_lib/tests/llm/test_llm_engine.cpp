@@ -17,28 +17,73 @@
 
 #include "../test_utils/common.hpp"  // IWYU pragma: associated
 
+#include "morpheus/llm/async_semaphore.hpp"
 #include "morpheus/llm/fwd.hpp"
 #include "morpheus/llm/llm_context.hpp"
 #include "morpheus/llm/llm_engine.hpp"
 #include "morpheus/llm/llm_lambda_node.hpp"
+#include "morpheus/llm/llm_node_base.hpp"
+#include "morpheus/llm/llm_output_stream.hpp"
 #include "morpheus/llm/llm_task.hpp"
+#include "morpheus/llm/llm_task_handler.hpp"
+#include "morpheus/messages/control.hpp"
 #include "morpheus/types.hpp"
+#include "morpheus/utilities/metrics.hpp"
 
 #include <gtest/gtest.h>
 #include <mrc/channel/forward.hpp>
 #include <mrc/coroutines/event.hpp>
 #include <mrc/coroutines/sync_wait.hpp>
 #include <mrc/coroutines/task.hpp>
+#include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <coroutine>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 using namespace morpheus;
 using namespace morpheus::test;
 using namespace mrc;
 
+namespace {
+class PassThruTaskHandler : public llm::LLMTaskHandler
+{
+  public:
+    std::vector<std::string> get_input_names() const override
+    {
+        return {};
+    }
+
+    Task<return_t> try_handle(std::shared_ptr<llm::LLMContext> context) override
+    {
+        co_return std::vector<std::shared_ptr<ControlMessage>>{context->message()};
+    }
+};
+
+class StreamingNode : public llm::LLMNodeBase
+{
+  public:
+    std::vector<std::string> get_input_names() const override
+    {
+        return {};
+    }
+
+    Task<std::shared_ptr<llm::LLMContext>> execute(std::shared_ptr<llm::LLMContext> context) override
+    {
+        context->stream_output("Hello");
+        context->stream_output(" world");
+        context->set_output("Hello world");
+
+        co_return context;
+    }
+};
+}  // namespace
+
 TEST_CLASS(LLMEngine);
 
 TEST_F(TestLLMEngine, AsyncTest)
@@ -91,3 +136,149 @@ TEST_F(TestLLMEngine, AsyncTest)
     EXPECT_EQ(out_context->view_outputs()["start"], 123);
     EXPECT_EQ(out_context->view_outputs()["test"], 124);
 }
+
+TEST_F(TestLLMEngine, ConcurrencyLimit)
+{
+    coroutines::Event e{};
+
+    std::atomic<int> in_flight{0};
+    std::atomic<int> max_in_flight{0};
+    std::atomic<int> executed{0};
+
+    llm::LLMEngine engine;
+
+    auto wait_fn = [&]() -> coroutines::Task<int> {
+        auto current = ++in_flight;
+        max_in_flight = std::max(max_in_flight.load(), current);
+
+        co_await e;
+
+        --in_flight;
+        co_return ++executed;
+    };
+
+    engine.add_node("wait", {}, llm::make_lambda_node(wait_fn));
+    engine.add_task_handler({}, std::make_shared<PassThruTaskHandler>());
+
+    auto message = std::make_shared<ControlMessage>();
+    for (int i = 0; i < 3; ++i)
+    {
+        message->add_task("llm_engine", {{"task_type", "template"}, {"task_dict", nlohmann::json::object()}});
+    }
+
+    auto concurrency_limit = std::make_shared<llm::AsyncSemaphore>(2);
+
+    auto return_val = engine.run(message, concurrency_limit);
+
+    // Start the coroutine, the third task waits for a permit
+    return_val.resume();
+
+    EXPECT_FALSE(return_val.is_ready());
+    EXPECT_EQ(in_flight, 2);
+    EXPECT_EQ(concurrency_limit->available(), 0);
+
+    // Release the event
+    e.set();
+
+    auto output_messages = mrc::coroutines::sync_wait(return_val);
+
+    EXPECT_EQ(executed, 3);
+    EXPECT_EQ(max_in_flight, 2);
+    EXPECT_EQ(concurrency_limit->available(), 2);
+
+    // One output per task, in the order of the tasks
+    ASSERT_EQ(output_messages.size(), 3);
+    for (const auto& output_message : output_messages)
+    {
+        EXPECT_EQ(output_message, message);
+    }
+}
+
+TEST_F(TestLLMEngine, StreamOutput)
+{
+    llm::LLMEngine engine;
+
+    engine.add_node("stream", {}, std::make_shared<StreamingNode>());
+    engine.add_task_handler({}, std::make_shared<PassThruTaskHandler>());
+
+    auto message = std::make_shared<ControlMessage>();
+    message->add_task("llm_engine", {{"task_type", "template"}, {"task_dict", nlohmann::json::object()}});
+
+    auto output_stream = std::make_shared<llm::LLMOutputStream>();
+
+    auto output_messages = mrc::coroutines::sync_wait(engine.run(message, nullptr, output_stream));
+    ASSERT_EQ(output_messages.size(), 1);
+
+    output_stream->close();
+
+    // Chunks written before the stream was closed are still read
+    auto read_all = [&]() -> coroutines::Task<std::vector<llm::LLMStreamChunk>> {
+        std::vector<llm::LLMStreamChunk> chunks;
+
+        while (auto chunk = co_await output_stream->read())
+        {
+            chunks.push_back(std::move(*chunk));
+        }
+
+        co_return chunks;
+    };
+
+    auto chunks = mrc::coroutines::sync_wait(read_all());
+
+    ASSERT_EQ(chunks.size(), 2);
+    EXPECT_EQ(chunks[0].node_name, "/stream");
+    EXPECT_EQ(chunks[0].chunk, "Hello");
+    EXPECT_EQ(chunks[1].node_name, "/stream");
+    EXPECT_EQ(chunks[1].chunk, " world");
+
+    // Chunks written once closed are dropped
+    output_stream->write("/stream", "dropped");
+    EXPECT_FALSE(mrc::coroutines::sync_wait(output_stream->read()).has_value());
+}
+
+TEST_F(TestLLMEngine, Trace)
+{
+    llm::LLMEngine engine;
+
+    engine.add_node("traced", {}, llm::make_lambda_node([]() -> coroutines::Task<int> {
+                        co_return 1;
+                    }));
+    engine.add_task_handler({}, std::make_shared<PassThruTaskHandler>());
+
+    auto node_seconds = MetricsRegistry::get_instance().get_histogram(
+        "morpheus_llm_span_seconds", "", {{"node", "/traced"}, {"kind", "node"}});
+    auto node_count = node_seconds->count();
+
+    auto message = std::make_shared<ControlMessage>();
+    message->add_task("llm_engine", {{"task_type", "template"}, {"task_dict", nlohmann::json::object()}});
+
+    auto output_messages = mrc::coroutines::sync_wait(
+        engine.run(message, std::make_shared<llm::AsyncSemaphore>(1), nullptr, true));
+    ASSERT_EQ(output_messages.size(), 1);
+
+    // Spans are added as they end
+    auto spans = output_messages[0]->get_metadata("llm_trace", true);
+    ASSERT_EQ(spans.size(), 3);
+
+    EXPECT_EQ(spans[0]["name"], "");
+    EXPECT_EQ(spans[0]["kind"], "queue");
+    EXPECT_EQ(spans[1]["name"], "/traced");
+    EXPECT_EQ(spans[1]["kind"], "node");
+    EXPECT_EQ(spans[2]["name"], "/TaskHandler");
+    EXPECT_EQ(spans[2]["kind"], "task_handler");
+
+    for (const auto& span : spans)
+    {
+        EXPECT_LE(span["start_time_unix_nano"].get<int64_t>(), span["end_time_unix_nano"].get<int64_t>());
+    }
+
+    EXPECT_EQ(node_seconds->count(), node_count + 1);
+
+    // Without tracing only the histograms are recorded
+    auto untraced_message = std::make_shared<ControlMessage>();
+    untraced_message->add_task("llm_engine", {{"task_type", "template"}, {"task_dict", nlohmann::json::object()}});
+
+    output_messages = mrc::coroutines::sync_wait(engine.run(untraced_message));
+    EXPECT_FALSE(output_messages[0]->has_metadata("llm_trace"));
+    EXPECT_EQ(node_seconds->count(), node_count + 2);
+}
@@ -27,8 +27,10 @@
 
 #include <gtest/gtest.h>
 #include <mrc/channel/forward.hpp>
+#include <mrc/coroutines/event.hpp>
 #include <mrc/coroutines/sync_wait.hpp>
 
+#include <atomic>
 #include <coroutine>
 #include <memory>
 #include <stdexcept>
@@ -164,3 +166,69 @@ TEST_F(TestLLMNode, AddChildNode)
 
     ASSERT_EQ(out_context->view_outputs()["Root3"], 3);
 }
+
+TEST_F(TestLLMNode, IndependentNodesRunConcurrently)
+{
+    coroutines::Event e{};
+    std::atomic<int> started{0};
+
+    auto make_waiting_node = [&](int value) {
+        return llm::make_lambda_node([&e, &started, value]() -> Task<int> {
+            started++;
+            co_await e;
+            co_return value;
+        });
+    };
+
+    llm::LLMNode node;
+
+    node.add_node("Node1", {}, make_waiting_node(1));
+    node.add_node("Node2", {}, make_waiting_node(2));
+    node.add_node("Node3", {{"/Node1"}}, make_single_input_node(), true);
+    node.add_node("Node4", {{"/Node2"}}, make_single_input_node(), true);
+
+    auto context = std::make_shared<llm::LLMContext>(llm::LLMTask{}, nullptr);
+    auto task    = node.execute(context);
+
+    task.resume();
+
+    // Both nodes are waiting on the event, rather than the second waiting for the first to complete
+    EXPECT_FALSE(task.is_ready());
+    EXPECT_EQ(started, 2);
+
+    e.set();
+
+    ASSERT_TRUE(task.is_ready());
+    EXPECT_EQ(context->view_outputs()["Node3"], 2);
+    EXPECT_EQ(context->view_outputs()["Node4"], 3);
+}
+
+TEST_F(TestLLMNode, FailedNodeSkipsDependents)
+{
+    std::atomic<int> executed{0};
+
+    auto make_counting_node = [&]() {
+        return llm::make_lambda_node([&executed](int i) -> Task<int> {
+            executed++;
+            co_return i + 1;
+        });
+    };
+
+    llm::LLMNode node;
+
+    node.add_node("Failing", {}, llm::make_lambda_node([]() -> Task<int> {
+                      throw std::runtime_error("failed");
+                      co_return 0;
+                  }));
+    node.add_node("Independent", {}, make_dummy_node());
+    node.add_node("Dependent", {{"/Failing"}}, make_counting_node());
+    node.add_node("Transitive", {{"/Dependent"}}, make_counting_node());
+    node.add_node("Other", {{"/Independent"}}, make_counting_node(), true);
+
+    auto context = std::make_shared<llm::LLMContext>(llm::LLMTask{}, nullptr);
+    EXPECT_THROW(coroutines::sync_wait(node.execute(context)), std::runtime_error);
+
+    // Only the node which does not depend on the failed node executed
+    EXPECT_EQ(executed, 1);
+    EXPECT_EQ(context->view_outputs()["Other"], 1);
+}
@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/llm/input_map.hpp"
+#include "morpheus/llm/llm_context.hpp"
+#include "morpheus/llm/llm_prompt_template_node.hpp"
+#include "morpheus/llm/llm_task.hpp"
+
+#include <gtest/gtest.h>
+#include <mrc/coroutines/sync_wait.hpp>
+#include <nlohmann/json.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace morpheus;
+using namespace morpheus::test;
+using namespace mrc;
+
+TEST_CLASS(LLMPromptTemplateNode);
+
+namespace {
+// Returns a context whose inputs are the given outputs of its parent
+std::shared_ptr<llm::LLMContext> make_context(const nlohmann::json& values)
+{
+    auto root = std::make_shared<llm::LLMContext>(llm::LLMTask{}, nullptr);
+    root->set_output(values);
+
+    llm::input_mappings_t inputs;
+    for (const auto& item : values.items())
+    {
+        inputs.push_back({"/" + item.key(), item.key()});
+    }
+
+    return root->push("template", std::move(inputs));
+}
+}  // namespace
+
+TEST_F(TestLLMPromptTemplateNode, InputNames)
+{
+    llm::LLMPromptTemplateNode node("One {fruit}, one {vegetable} and another {fruit}. {{not_a_field}}");
+
+    EXPECT_EQ(node.get_input_names(), (std::vector<std::string>{"fruit", "vegetable"}));
+}
+
+TEST_F(TestLLMPromptTemplateNode, InvalidTemplates)
+{
+    for (const auto* template_str : {"Hello {}!", "Hello {name!r}", "Hello {name:>10}", "{name.attr}", "{", "}"})
+    {
+        EXPECT_THROW(llm::LLMPromptTemplateNode{template_str}, std::invalid_argument) << template_str;
+        EXPECT_FALSE(llm::LLMPromptTemplateNode::is_supported(template_str)) << template_str;
+    }
+
+    EXPECT_TRUE(llm::LLMPromptTemplateNode::is_supported("Hello {name}!"));
+}
+
+TEST_F(TestLLMPromptTemplateNode, Execute)
+{
+    llm::LLMPromptTemplateNode node("{{{fruit}}} x{count}: {fruit} and {vegetable}, {ripe} {note}");
+
+    auto context = make_context({{"fruit", {"apple", "plum"}},
+                                 {"vegetable", {"carrot", "broccoli"}},
+                                 {"count", {1, 2.5}},
+                                 {"ripe", {true, false}},
+                                 {"note", {nullptr, "late"}}});
+
+    auto out_context = coroutines::sync_wait(node.execute(context));
+
+    EXPECT_EQ(out_context->view_outputs(),
+              nlohmann::json({"{apple} x1: apple and carrot, True None", "{plum} x2.5: plum and broccoli, False late"}));
+}
+
+TEST_F(TestLLMPromptTemplateNode, ExecuteWithoutFields)
+{
+    llm::LLMPromptTemplateNode node("no fields");
+
+    auto context = make_context({{"unused", {"a", "b"}}});
+
+    EXPECT_EQ(coroutines::sync_wait(node.execute(context))->view_outputs(), nlohmann::json({"no fields", "no fields"}));
+}
+
+TEST_F(TestLLMPromptTemplateNode, ExecuteMismatchedInputs)
+{
+    llm::LLMPromptTemplateNode node("{fruit} and {vegetable}");
+
+    auto context = make_context({{"fruit", {"apple", "plum"}}, {"vegetable", {"carrot"}}});
+
+    EXPECT_THROW(coroutines::sync_wait(node.execute(context)), std::invalid_argument);
+}
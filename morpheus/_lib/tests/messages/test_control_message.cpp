@@ -128,6 +128,26 @@ TEST_F(TestControlMessage, GetAllMetadata)
     EXPECT_TRUE(metadata.contains("key2"));
 }
 
+TEST_F(TestControlMessage, FindMetadata)
+{
+    auto msg = ControlMessage();
+
+    msg.set_metadata("count", 42);
+    msg.set_metadata("name", "test");
+
+    const auto* value = msg.find_metadata("count");
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 42);
+    EXPECT_EQ(msg.find_metadata("missing"), nullptr);
+
+    // Lookups return the stored value rather than a copy
+    EXPECT_EQ(value, &msg.get_metadata().at("count"));
+
+    EXPECT_EQ(msg.get_metadata_value<int>("count", 0), 42);
+    EXPECT_EQ(msg.get_metadata_value<std::string>("name", ""), "test");
+    EXPECT_EQ(msg.get_metadata_value<int>("missing", -1), -1);
+}
+
 TEST_F(TestControlMessage, SetMessageTest)
 {
     auto msg = ControlMessage();
@@ -334,3 +354,66 @@ TEST_F(TestControlMessage, GetTensorMemoryWhenNoneSet)
     // Verify that the retrieved tensor memory is nullptr
     EXPECT_EQ(nullptr, retrievedTensorMemory);
 }
+
+TEST_F(TestControlMessage, CloneSharesPayloadAndCopiesOnWrite)
+{
+    auto msg = ControlMessage();
+    msg.add_task("load", {{"loader_id", "payload"}});
+    msg.set_metadata("key", "value");
+
+    auto tensors = std::make_shared<TensorMemory>(0);
+    msg.tensors(tensors);
+
+    auto cloned = msg.clone();
+    EXPECT_EQ(cloned->tensors(), tensors);
+    EXPECT_EQ(cloned->get_metadata("key"), "value");
+
+    // The config and tasks are shared until either message modifies them
+    EXPECT_EQ(&cloned->config(), &msg.config());
+    EXPECT_EQ(cloned->get_tasks(), msg.get_tasks());
+
+    cloned->set_metadata("key", "changed");
+    cloned->remove_task("load");
+
+    EXPECT_EQ(msg.get_metadata("key"), "value");
+    EXPECT_TRUE(msg.has_task("load"));
+    EXPECT_EQ(cloned->get_metadata("key"), "changed");
+    EXPECT_FALSE(cloned->has_task("load"));
+}
+
+TEST_F(TestControlMessage, TasksAreRemovedInOrder)
+{
+    auto msg = ControlMessage();
+    msg.add_task("load", {{"id", 0}});
+    msg.add_task("inference", {{"id", 1}});
+    msg.add_task("load", {{"id", 2}});
+
+    EXPECT_EQ(msg.get_tasks()["load"].size(), 2);
+    EXPECT_EQ(msg.remove_task("load")["id"], 0);
+    EXPECT_EQ(msg.remove_task("load")["id"], 2);
+    EXPECT_FALSE(msg.has_task("load"));
+    EXPECT_TRUE(msg.has_task("inference"));
+    EXPECT_THROW(msg.remove_task("load"), std::runtime_error);
+
+    // Types whose tasks were all removed remain in the json view, as empty arrays
+    EXPECT_TRUE(msg.get_tasks()["load"].empty());
+}
+
+TEST_F(TestControlMessage, ConfigRoundTrip)
+{
+    auto msg = ControlMessage();
+    msg.add_task("load", {{"id", 0}});
+    msg.add_task("inference", {{"id", 1}});
+    msg.add_task("load", {{"id", 2}});
+    msg.set_metadata("key", "value");
+
+    // As sent by the UCX and CUDA IPC boundary stages
+    const auto header = nlohmann::json::from_msgpack(nlohmann::json::to_msgpack({{"config", msg.to_config()}}));
+    auto received     = ControlMessage(header.at("config"));
+
+    EXPECT_EQ(received.get_tasks(), msg.get_tasks());
+    EXPECT_EQ(received.get_metadata("key"), "value");
+    EXPECT_EQ(received.remove_task("load")["id"], 0);
+    EXPECT_EQ(received.remove_task("load")["id"], 2);
+    EXPECT_EQ(received.remove_task("inference")["id"], 1);
+}
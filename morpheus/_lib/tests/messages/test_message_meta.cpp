@@ -20,23 +20,104 @@
 
 #include "morpheus/io/deserializers.hpp"  // for load_table_from_file, prepare_df_index
 #include "morpheus/messages/meta.hpp"     // for MessageMeta and SlicedMessageMeta
+#include "morpheus/objects/cpp_data_table.hpp"
+#include "morpheus/objects/dtype.hpp"  // for DType, TypeId
+#include "morpheus/objects/python_data_table.hpp"
 #include "morpheus/objects/rmm_tensor.hpp"
-#include "morpheus/objects/table_info.hpp"   // for TableInfo
-#include "morpheus/utilities/cudf_util.hpp"  // for CudfHelper
+#include "morpheus/objects/table_info.hpp"    // for TableInfo
+#include "morpheus/utilities/cudf_util.hpp"   // for CudfHelper
+#include "morpheus/utilities/table_util.hpp"  // for CuDFTableUtil
 
+#include <cuda_runtime.h>  // for cudaLaunchHostFunc, cudaEventQuery
+#include <cudf/column/column.hpp>
+#include <cudf/io/types.hpp>  // for table_with_metadata
+#include <cudf/table/table.hpp>
+#include <cudf/utilities/default_stream.hpp>  // for get_default_stream
 #include <gtest/gtest.h>
 #include <mrc/cuda/common.hpp>
 #include <pybind11/gil.h>       // for gil_scoped_release, gil_scoped_acquire
 #include <pybind11/pybind11.h>  // IWYU pragma: keep
 
+#include <atomic>
+#include <chrono>      // for milliseconds
+#include <cstdint>     // for int64_t
 #include <filesystem>  // for std::filesystem::path
 #include <memory>      // for shared_ptr
-#include <utility>     // for move
+#include <optional>
+#include <string>
+#include <thread>  // for sleep_for, yield
+#include <tuple>
+#include <utility>  // for move
+#include <vector>
 
 using namespace morpheus;
 
 using TestMessageMeta = morpheus::test::TestMessages;  // NOLINT(readability-identifier-naming)
 
+namespace {
+std::unique_ptr<cudf::column> make_int64_column(const std::vector<int64_t>& values)
+{
+    rmm::device_buffer data(values.data(), values.size() * sizeof(int64_t), rmm::cuda_stream_per_thread);
+    rmm::cuda_stream_per_thread.synchronize();
+
+    return std::make_unique<cudf::column>(cudf::data_type{cudf::type_id::INT64},
+                                          static_cast<cudf::size_type>(values.size()),
+                                          std::move(data),
+                                          rmm::device_buffer{},
+                                          0);
+}
+
+bool is_sliceable(const std::vector<int64_t>& values)
+{
+    auto column = make_int64_column(values);
+    return CuDFTableUtil::is_sliceable_index(cudf::table_view({column->view()}));
+}
+
+// Holds back the work queued on a stream until opened, standing in for a long running write
+class StreamGate
+{
+  public:
+    StreamGate(cudaStream_t stream)
+    {
+        MRC_CHECK_CUDA(cudaLaunchHostFunc(stream, StreamGate::wait, &m_open));
+    }
+
+    void open()
+    {
+        m_open = true;
+    }
+
+  private:
+    static void wait(void* open)
+    {
+        while (!static_cast<std::atomic<bool>*>(open)->load())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    std::atomic<bool> m_open{false};
+};
+
+// Waits for up to a second for the work recorded by `event` to complete
+bool completes(cudaEvent_t event)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto status = cudaEventQuery(event);
+        if (status != cudaErrorNotReady)
+        {
+            MRC_CHECK_CUDA(status);
+            return true;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return false;
+}
+}  // namespace
+
 TEST_F(TestMessageMeta, SetMetaWithColumnName)
 {
     pybind11::gil_scoped_release no_gil;
@@ -65,3 +146,252 @@ TEST_F(TestMessageMeta, SetMetaWithColumnName)
         cudaMemcpy(actual_ints.data(), cm_int_meta.data<int64_t>(), count * sizeof(int64_t), cudaMemcpyDeviceToHost));
     EXPECT_EQ(expected_ints, actual_ints);
 }
+
+TEST_F(TestMessageMeta, SetMetaAsyncStrided)
+{
+    pybind11::gil_scoped_release no_gil;
+    auto test_data_dir               = test::get_morpheus_root() / "tests/tests_data";
+    std::filesystem::path input_file = test_data_dir / "csv_sample.csv";
+
+    auto table = load_table_from_file(input_file);
+    auto meta  = MessageMeta::create_from_cpp(std::move(table));
+
+    // Row major 3x2 tensor, the second column is written to the table
+    const std::size_t count = 3;
+    DType int_type(TypeId::INT64);
+    std::vector<int64_t> input_ints{1, 4, 2, 5, 3, 6};
+    std::vector<int64_t> expected_ints{4, 5, 6};
+    auto buffer = std::make_shared<rmm::device_buffer>(input_ints.size() * int_type.item_size(),
+                                                       rmm::cuda_stream_per_thread);
+
+    MRC_CHECK_CUDA(cudaMemcpy(buffer->data(), input_ints.data(), buffer->size(), cudaMemcpyHostToDevice));
+
+    ShapeType shape{3, 2};
+    auto tensor = std::make_shared<RMMTensor>(buffer, 0, int_type, shape);
+    TensorObject tensor_object(tensor);
+    meta->set_data({"int"}, {tensor_object.slice({0, 1}, {3, 2})}, rmm::cuda_stream_per_thread);
+
+    std::vector<int64_t> actual_ints(expected_ints.size());
+
+    // get_info orders the default stream after the copy
+    auto cm_int_meta = meta->get_info().get_column(0);
+    MRC_CHECK_CUDA(
+        cudaMemcpy(actual_ints.data(), cm_int_meta.data<int64_t>(), count * sizeof(int64_t), cudaMemcpyDeviceToHost));
+    EXPECT_EQ(expected_ints, actual_ints);
+}
+
+TEST_F(TestMessageMeta, CppDataTableLazyConversion)
+{
+    pybind11::gil_scoped_release no_gil;
+    auto test_data_dir               = test::get_morpheus_root() / "tests/tests_data";
+    std::filesystem::path input_file = test_data_dir / "csv_sample.csv";
+
+    auto table       = load_table_from_file(input_file);
+    auto num_rows    = table.tbl->num_rows();
+    auto num_columns = table.tbl->num_columns();
+    auto data_table  = std::make_shared<CppDataTable>(std::move(table));
+
+    EXPECT_EQ(data_table->count(), num_rows);
+    EXPECT_TRUE(data_table->has_sliceable_index());
+
+    {
+        auto info = data_table->get_info();
+        EXPECT_EQ(info.num_rows(), num_rows);
+        EXPECT_EQ(info.num_columns(), num_columns);
+        EXPECT_EQ(info.num_indices(), 1);
+    }
+
+    // None of the above should have required python
+    EXPECT_FALSE(data_table->is_py_object_created());
+
+    {
+        pybind11::gil_scoped_acquire gil;
+        const auto& df = data_table->get_py_object();
+        EXPECT_EQ(df.attr("shape").attr("__getitem__")(0).cast<cudf::size_type>(), num_rows);
+    }
+
+    EXPECT_TRUE(data_table->is_py_object_created());
+    EXPECT_EQ(data_table->count(), num_rows);
+    EXPECT_EQ(data_table->get_info().num_columns(), num_columns);
+}
+
+TEST_F(TestMessageMeta, SpillToHost)
+{
+    pybind11::gil_scoped_release no_gil;
+    auto test_data_dir               = test::get_morpheus_root() / "tests/tests_data";
+    std::filesystem::path input_file = test_data_dir / "csv_sample.csv";
+
+    auto table    = load_table_from_file(input_file);
+    auto num_rows = table.tbl->num_rows();
+    auto meta     = MessageMeta::create_from_cpp(std::move(table));
+
+    const std::size_t count = 3;
+    DType int_type(TypeId::INT64);
+    std::vector<int64_t> expected_ints{4, 5, 6};
+    auto buffer = std::make_shared<rmm::device_buffer>(count * int_type.item_size(), rmm::cuda_stream_per_thread);
+
+    MRC_CHECK_CUDA(cudaMemcpy(buffer->data(), expected_ints.data(), buffer->size(), cudaMemcpyHostToDevice));
+    meta->set_data("int", TensorObject(std::make_shared<RMMTensor>(buffer, 0, int_type, ShapeType{3, 1})));
+
+    // Not spilled while the table is being viewed
+    {
+        auto info = meta->get_info();
+        EXPECT_EQ(meta->spill(), 0);
+        EXPECT_FALSE(meta->is_spilled());
+    }
+
+    EXPECT_GT(meta->spill(), 0);
+    EXPECT_TRUE(meta->is_spilled());
+    EXPECT_EQ(meta->spill(), 0);
+    EXPECT_EQ(meta->count(), num_rows);
+
+    // Restored by the next access
+    std::vector<int64_t> actual_ints(expected_ints.size());
+
+    auto cm_int_meta = meta->get_info().get_column(0);
+    MRC_CHECK_CUDA(
+        cudaMemcpy(actual_ints.data(), cm_int_meta.data<int64_t>(), count * sizeof(int64_t), cudaMemcpyDeviceToHost));
+    EXPECT_EQ(expected_ints, actual_ints);
+    EXPECT_FALSE(meta->is_spilled());
+
+    auto reloaded = MessageMeta::create_from_cpp(load_table_from_file(input_file));
+    EXPECT_EQ(meta->get_column_names(), reloaded->get_column_names());
+}
+
+TEST_F(TestMessageMeta, PerColumnEvents)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    columns.emplace_back(make_int64_column({1, 2, 3}));
+    columns.emplace_back(make_int64_column({4, 5, 6}));
+
+    cudf::io::table_with_metadata table;
+    table.tbl = std::make_unique<cudf::table>(std::move(columns));
+    table.metadata.schema_info.emplace_back("a");
+    table.metadata.schema_info.emplace_back("b");
+    auto data_table = std::make_shared<CppDataTable>(std::move(table));
+
+    cudaStream_t a_stream;
+    cudaStream_t b_stream;
+    cudaStream_t reader_stream;
+    MRC_CHECK_CUDA(cudaStreamCreateWithFlags(&a_stream, cudaStreamNonBlocking));
+    MRC_CHECK_CUDA(cudaStreamCreateWithFlags(&b_stream, cudaStreamNonBlocking));
+    MRC_CHECK_CUDA(cudaStreamCreateWithFlags(&reader_stream, cudaStreamNonBlocking));
+
+    cudaEvent_t reader_done;
+    cudaEvent_t default_done;
+    MRC_CHECK_CUDA(cudaEventCreateWithFlags(&reader_done, cudaEventDisableTiming));
+    MRC_CHECK_CUDA(cudaEventCreateWithFlags(&default_done, cudaEventDisableTiming));
+
+    // The write of column a is held back, the one of column b completes right away
+    StreamGate a_write(a_stream);
+    data_table->record_event({"a"}, a_stream);
+    data_table->record_event({"b"}, b_stream);
+
+    {
+        // Neither the host nor a reader of column b wait on the write of column a
+        auto info = data_table->get_info();
+        info.get_slice(0, 3, {"b"}).wait_for_event(reader_stream);
+        MRC_CHECK_CUDA(cudaEventRecord(reader_done, reader_stream));
+        EXPECT_TRUE(completes(reader_done));
+
+        // get_info orders the default stream after the writes of every column
+        MRC_CHECK_CUDA(cudaEventRecord(default_done, cudf::get_default_stream().value()));
+        EXPECT_EQ(cudaEventQuery(default_done), cudaErrorNotReady);
+
+        // As does a reader of column a
+        info.get_slice(0, 3, {"a"}).wait_for_event(reader_stream);
+        MRC_CHECK_CUDA(cudaEventRecord(reader_done, reader_stream));
+        EXPECT_EQ(cudaEventQuery(reader_done), cudaErrorNotReady);
+    }
+
+    a_write.open();
+    EXPECT_TRUE(completes(default_done));
+    EXPECT_TRUE(completes(reader_done));
+
+    MRC_CHECK_CUDA(cudaStreamSynchronize(a_stream));
+    MRC_CHECK_CUDA(cudaEventDestroy(reader_done));
+    MRC_CHECK_CUDA(cudaEventDestroy(default_done));
+    MRC_CHECK_CUDA(cudaStreamDestroy(a_stream));
+    MRC_CHECK_CUDA(cudaStreamDestroy(b_stream));
+    MRC_CHECK_CUDA(cudaStreamDestroy(reader_stream));
+}
+
+TEST_F(TestMessageMeta, PyDataTableCachesTableData)
+{
+    pybind11::gil_scoped_release no_gil;
+    auto test_data_dir               = test::get_morpheus_root() / "tests/tests_data";
+    std::filesystem::path input_file = test_data_dir / "csv_sample.csv";
+
+    auto table       = load_table_from_file(input_file);
+    auto num_rows    = table.tbl->num_rows();
+    auto num_columns = table.tbl->num_columns();
+
+    std::shared_ptr<PyDataTable> data_table;
+    {
+        pybind11::gil_scoped_acquire gil;
+        data_table = std::make_shared<PyDataTable>(CudfHelper::table_from_table_with_metadata(std::move(table), 1));
+    }
+
+    EXPECT_EQ(data_table->count(), num_rows);
+    EXPECT_EQ(data_table->get_info().num_columns(), num_columns - 1);
+
+    {
+        auto mutable_info = data_table->get_mutable_info();
+        mutable_info.insert_columns({std::make_tuple("new_col", DType(TypeId::INT64))});
+    }
+
+    // The cached data must have been dropped when the mutable info was released
+    EXPECT_EQ(data_table->get_info().num_columns(), num_columns);
+    EXPECT_EQ(data_table->count(), num_rows);
+}
+
+TEST_F(TestMessageMeta, IsSliceableIndex)
+{
+    EXPECT_TRUE(is_sliceable({}));
+    EXPECT_TRUE(is_sliceable({7}));
+    EXPECT_TRUE(is_sliceable({0, 1, 2, 5}));
+    EXPECT_TRUE(is_sliceable({9, 4, 3, -1}));
+    EXPECT_FALSE(is_sliceable({0, 2, 1, 3}));
+    EXPECT_FALSE(is_sliceable({0, 1, 1, 2}));
+
+    // Concatenated batches restart their index
+    EXPECT_FALSE(is_sliceable({0, 1, 2, 0, 1, 2}));
+}
+
+TEST_F(TestMessageMeta, EnsureSliceableIndexWithoutPython)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    columns.push_back(make_int64_column({0, 1, 1, 2}));
+    columns.push_back(make_int64_column({10, 11, 12, 13}));
+
+    cudf::io::table_with_metadata table;
+    table.tbl = std::make_unique<cudf::table>(std::move(columns));
+    table.metadata.schema_info.emplace_back("id");
+    table.metadata.schema_info.emplace_back("v");
+
+    auto data_table = std::make_shared<CppDataTable>(std::move(table), 1);
+
+    EXPECT_FALSE(data_table->has_sliceable_index());
+    EXPECT_EQ(data_table->get_mutable_info().ensure_sliceable_index(), std::optional<std::string>("_index_id"));
+    EXPECT_TRUE(data_table->has_sliceable_index());
+    EXPECT_EQ(data_table->get_mutable_info().ensure_sliceable_index(), std::nullopt);
+    EXPECT_EQ(data_table->count(), 4);
+
+    auto info = data_table->get_info();
+    EXPECT_EQ(info.num_indices(), 1);
+    EXPECT_EQ(info.get_column_names(), (std::vector<std::string>{"_index_id", "v"}));
+
+    std::vector<int64_t> index(4);
+    MRC_CHECK_CUDA(cudaMemcpy(index.data(),
+                              info.get_view().column(0).data<int64_t>(),
+                              index.size() * sizeof(int64_t),
+                              cudaMemcpyDeviceToHost));
+    EXPECT_EQ(index, (std::vector<int64_t>{0, 1, 2, 3}));
+
+    // Neither the check nor the reset should have required python
+    EXPECT_FALSE(data_table->is_py_object_created());
+}
@@ -41,6 +41,7 @@
 #include <fstream>
 #include <memory>
 #include <utility>
+#include <vector>
 
 using namespace morpheus;
 using namespace morpheus::test;
@@ -284,3 +285,64 @@ TEST_F(TestDataLoaderModule, EndToEndPayloadDataLoaderTest)
 
     EXPECT_EQ(packet_count, 10);
 }
+
+TEST_F(TestDataLoaderModule, EndToEndConcurrentPayloadDataLoaderTest)
+{
+    using namespace mrc::modules;
+    using namespace mrc;
+
+    using namespace nlohmann;
+
+    using sp_msg_ctrl_t = std::shared_ptr<ControlMessage>;
+
+    std::vector<int> received;
+
+    auto init_wrapper = [&received](segment::Builder& builder) {
+        json module_config;
+        module_config["loaders"]              = {{{"id", "payload"}}};
+        module_config["max_concurrent_loads"] = 4;
+        module_config["loader_limits"]        = {{"payload", 2}};
+
+        auto data_loader_module = builder.make_module<DataLoaderModule>("DataLoaderTest", module_config);
+
+        auto source = builder.make_source<sp_msg_ctrl_t>("source", [](rxcpp::subscriber<sp_msg_ctrl_t>& sub) {
+            if (sub.is_subscribed())
+            {
+                for (int i = 0; i < 10; i++)
+                {
+                    nlohmann::json message_config;
+                    message_config["tasks"]    = {{{"type", "load"}, {"properties", {{"loader_id", "payload"}}}}};
+                    message_config["metadata"] = {{"index", i}};
+
+                    sub.on_next(std::make_shared<ControlMessage>(message_config));
+                }
+            }
+
+            sub.on_completed();
+        });
+
+        builder.make_edge(source, data_loader_module->input_port("input"));
+        auto sink = builder.make_sink<sp_msg_ctrl_t>("sink", [&received](sp_msg_ctrl_t input) {
+            received.push_back(input->get_metadata("index").get<int>());
+        });
+
+        builder.make_edge(data_loader_module->output_port("output"), sink);
+    };
+
+    auto pipeline = mrc::make_pipeline();
+
+    pipeline->make_segment("main", init_wrapper);
+
+    auto options = std::make_shared<Options>();
+    options->topology().user_cpuset("0-1");
+    options->topology().restrict_gpus(true);
+    options->engine_factories().set_default_engine_type(runnable::EngineType::Thread);
+
+    Executor executor(options);
+    executor.register_pipeline(std::move(pipeline));
+    executor.start();
+    executor.join();
+
+    // Messages are emitted in the order they were received by default
+    EXPECT_EQ(received, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
@@ -21,5 +21,6 @@
 
 namespace morpheus::test {
 
-using TestDataLoaderModule = TestWithPythonInterpreter;  // NOLINT
+using TestDataLoaderModule = TestWithPythonInterpreter;      // NOLINT
+using TestPayloadBatcherModule = TestWithPythonInterpreter;  // NOLINT
 }  // namespace morpheus::test
\ No newline at end of file
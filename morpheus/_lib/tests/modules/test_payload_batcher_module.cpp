@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // IWYU pragma: associated
+#include "test_modules.hpp"
+
+#include "morpheus/io/deserializers.hpp"  // for load_table_from_file
+#include "morpheus/messages/control.hpp"
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/modules/payload_batcher_module.hpp"
+#include "morpheus/types.hpp"  // for TensorIndex
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace morpheus;
+using namespace morpheus::test;
+
+namespace {
+std::shared_ptr<ControlMessage> make_filter_probs_message()
+{
+    auto input_file = get_morpheus_root() / "tests/tests_data/filter_probs.csv";
+
+    auto message = std::make_shared<ControlMessage>();
+    message->payload(MessageMeta::create_from_cpp(load_table_from_file(input_file), 0));
+    message->add_task("inference", {{"model", "test"}});
+
+    return message;
+}
+}  // namespace
+
+TEST_F(TestPayloadBatcherModule, InvalidConfigTest)
+{
+    using nlohmann::json;
+
+    EXPECT_THROW(PayloadBatcherModule("PayloadBatcherTest1", json{{"disable_max_batch_size", true}}),
+                 std::invalid_argument);
+    EXPECT_THROW(PayloadBatcherModule("PayloadBatcherTest2", json{{"max_batch_size", 0}}), std::invalid_argument);
+    EXPECT_THROW(PayloadBatcherModule("PayloadBatcherTest3", json{{"timestamp_column_name", "ts"}, {"period", "W"}}),
+                 std::invalid_argument);
+}
+
+TEST_F(TestPayloadBatcherModule, BatchByRowCountTest)
+{
+    PayloadBatcherModule module("PayloadBatcherTest", nlohmann::json{{"max_batch_size", 7}});
+
+    auto message = make_filter_probs_message();
+    auto batches = module.batch(message);
+
+    ASSERT_EQ(batches.size(), 3);
+    std::vector<TensorIndex> expected_counts{7, 7, 6};
+    for (std::size_t i = 0; i < batches.size(); ++i)
+    {
+        EXPECT_NE(batches[i], message);
+        EXPECT_EQ(batches[i]->payload()->count(), expected_counts[i]);
+        EXPECT_EQ(batches[i]->payload()->get_info().get_column_names(),
+                  message->payload()->get_info().get_column_names());
+        EXPECT_TRUE(batches[i]->has_task("inference"));
+    }
+
+    // A payload fitting in a single batch is sent as is
+    PayloadBatcherModule large_module("PayloadBatcherLargeTest", nlohmann::json{{"max_batch_size", 20}});
+    auto large_batches = large_module.batch(message);
+    ASSERT_EQ(large_batches.size(), 1);
+    EXPECT_EQ(large_batches[0], message);
+}
+
+TEST_F(TestPayloadBatcherModule, BatchByGroupTest)
+{
+    PayloadBatcherModule module("PayloadBatcherTest",
+                                nlohmann::json{{"group_by_columns", {"v1"}}, {"disable_max_batch_size", true}});
+
+    auto batches = module.batch(make_filter_probs_message());
+
+    ASSERT_EQ(batches.size(), 9);
+    TensorIndex total_rows = 0;
+    for (const auto& batch : batches)
+    {
+        total_rows += batch->payload()->count();
+    }
+    EXPECT_EQ(total_rows, 20);
+}
+
+TEST_F(TestPayloadBatcherModule, MissingColumnTest)
+{
+    nlohmann::json config{{"group_by_columns", {"missing"}}};
+
+    PayloadBatcherModule module("PayloadBatcherTest", config);
+    auto message = make_filter_probs_message();
+    auto batches = module.batch(message);
+
+    // Failures are recorded in the message unless `raise_on_failure` is set, failed messages being passed through
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches[0], message);
+    EXPECT_TRUE(message->has_metadata("cm_failed"));
+    EXPECT_EQ(module.batch(message).size(), 1);
+
+    config["raise_on_failure"] = true;
+    PayloadBatcherModule raising_module("PayloadBatcherRaisingTest", config);
+    EXPECT_THROW(raising_module.batch(make_filter_probs_message()), std::runtime_error);
+}
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"        // for TEST_CLASS_WITH_PYTHON, morpheus
+#include "../test_utils/tensor_utils.hpp"  // for convert_to_host
+
+#include "morpheus/io/deserializers.hpp"  // for load_table_from_file
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/stages/cidr_lookup.hpp"
+
+#include <gtest/gtest.h>
+#include <pybind11/gil.h>  // for gil_scoped_release
+
+#include <cstdint>     // for int64_t
+#include <filesystem>  // for operator/, path, remove, temp_directory_path
+#include <fstream>     // for ofstream
+#include <memory>      // for shared_ptr
+#include <stdexcept>   // for invalid_argument
+#include <string>      // for string
+#include <vector>      // for vector
+
+using namespace morpheus;
+
+namespace {
+std::string write_csv(const std::string& name, const std::string& contents)
+{
+    auto test_file = std::filesystem::temp_directory_path() / ("morpheus_test_cidr_lookup_" + name + ".csv");
+    std::ofstream(test_file) << contents;
+
+    return test_file.string();
+}
+
+// Nested IPv4 networks, a network listed twice and an IPv6 network
+std::string write_networks()
+{
+    return write_csv("networks",
+                     "network,zone\n"
+                     "10.0.0.0/8,1\n"
+                     "10.1.0.0/16,2\n"
+                     "10.1.2.0/24,3\n"
+                     "192.168.0.0/16,4\n"
+                     "10.1.0.0/16,5\n"
+                     "2001:db8::/32,6\n");
+}
+
+std::shared_ptr<MessageMeta> make_events(const std::string& columns, const std::string& rows)
+{
+    return MessageMeta::create_from_cpp(load_table_from_file(write_csv("events", columns + "\n" + rows)));
+}
+}  // namespace
+
+TEST_CLASS_WITH_PYTHON(CidrLookup);
+
+TEST_F(TestCidrLookup, LongestPrefix)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    auto filename = write_networks();
+    NetworkTable table(filename, FileTypes::CSV, "network", {});
+    EXPECT_EQ(table.label_columns(), (std::vector<std::string>{"zone"}));
+    EXPECT_EQ(table.num_networks(), 6);
+
+    // The /24 and the twice listed /16 split the /8 into 5 ranges
+    EXPECT_EQ(table.num_ranges(), 7);
+
+    auto events = make_events("src_ip", "10.1.2.3\n10.1.9.9\n10.200.0.1\n192.168.1.1\n8.8.8.8\n2001:db8::1\n");
+    auto labels = table.lookup(events->get_info().get_column(0));
+    ASSERT_EQ(labels->num_rows(), 6);
+
+    // Unresolved addresses, including IPv6 strings, hold nulls
+    EXPECT_EQ(labels->get_column(0).null_count(), 2);
+
+    auto zones = test::convert_to_host<int64_t>(labels->get_column(0).view());
+    EXPECT_EQ(zones[0], 3);
+    EXPECT_EQ(zones[1], 5);
+    EXPECT_EQ(zones[2], 1);
+    EXPECT_EQ(zones[3], 4);
+
+    // Integer IPv4 addresses, such as those of `DocaSourceStage` with `numeric_addresses`
+    auto numeric        = make_events("src_ip", "167838211\n3232235777\n134744072\n");
+    auto numeric_labels = table.lookup(numeric->get_info().get_column(0));
+    EXPECT_EQ(numeric_labels->get_column(0).null_count(), 1);
+
+    auto numeric_zones = test::convert_to_host<int64_t>(numeric_labels->get_column(0).view());
+    EXPECT_EQ(numeric_zones[0], 3);
+    EXPECT_EQ(numeric_zones[1], 4);
+
+    std::filesystem::remove(filename);
+}
+
+TEST_F(TestCidrLookup, LabelPayload)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    auto filename = write_networks();
+    CidrLookupStage stage(filename, FileTypes::CSV, "network", {"zone"}, {"src_ip", "dst_ip"});
+
+    // The appended `dst_ip_zone` replaces the column of the payload
+    auto labelled = stage.label(make_events("src_ip,dst_ip,dst_ip_zone", "10.1.2.3,8.8.8.8,0\n"));
+    EXPECT_EQ(labelled->get_column_names(),
+              (std::vector<std::string>{"src_ip", "dst_ip", "src_ip_zone", "dst_ip_zone"}));
+    EXPECT_EQ(test::convert_to_host<int64_t>(labelled->get_info().get_column(2)), (std::vector<int64_t>{3}));
+    EXPECT_EQ(labelled->get_info().get_column(3).null_count(), 1);
+
+    EXPECT_THROW(stage.label(make_events("host", "10.1.2.3\n")), std::invalid_argument);
+
+    std::filesystem::remove(filename);
+}
+
+TEST_F(TestCidrLookup, InvalidNetworks)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    for (const auto& network : {"10.0.0.0/33", "10.0.0/8", "2001:db8::/129", "10.0.0.0/"})
+    {
+        auto filename = write_csv("invalid", std::string{"network,zone\n"} + network + ",1\n");
+        EXPECT_THROW(NetworkTable(filename, FileTypes::CSV, "network", {}), std::invalid_argument) << network;
+        std::filesystem::remove(filename);
+    }
+
+    auto filename = write_networks();
+    EXPECT_THROW(NetworkTable(filename, FileTypes::CSV, "cidr", {}), std::invalid_argument);
+    EXPECT_THROW(NetworkTable(filename, FileTypes::CSV, "network", {"country"}), std::invalid_argument);
+
+    NetworkTable table(filename, FileTypes::CSV, "network", {});
+    auto events = make_events("score", "0.5\n");
+    EXPECT_THROW(table.lookup(events->get_info().get_column(0)), std::invalid_argument);
+
+    std::filesystem::remove(filename);
+}
@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"        // for TEST_CLASS_WITH_PYTHON, morpheus
+#include "../test_utils/tensor_utils.hpp"  // for convert_to_host
+
+#include "morpheus/io/deserializers.hpp"            // for load_table_from_file
+#include "morpheus/messages/meta.hpp"               // for MessageMeta
+#include "morpheus/stages/deduplicate.hpp"          // for DeduplicationWindow
+#include "morpheus/utilities/state_checkpoint.hpp"  // for StateCheckpoint
+
+#include <cudf/types.hpp>  // for data_type
+#include <cudf/unary.hpp>  // for cast
+#include <gtest/gtest.h>   // for EXPECT_EQ, EXPECT_THROW, TEST_F
+#include <pybind11/gil.h>  // for gil_scoped_release
+
+#include <chrono>      // for milliseconds, minutes
+#include <cstdint>     // for uint8_t
+#include <filesystem>  // for operator/, path, remove_all, temp_directory_path
+#include <fstream>     // for ofstream
+#include <memory>      // for shared_ptr
+#include <stdexcept>   // for invalid_argument
+#include <string>      // for string
+#include <vector>      // for vector
+
+using namespace morpheus;
+using namespace std::chrono_literals;
+
+namespace {
+std::shared_ptr<MessageMeta> load_events(const std::string& name, const std::string& rows)
+{
+    auto test_file = std::filesystem::temp_directory_path() / ("morpheus_test_deduplicate_" + name + ".csv");
+    std::ofstream(test_file) << "host,event,count\n" << rows;
+
+    return MessageMeta::create_from_cpp(load_table_from_file(test_file));
+}
+
+std::vector<uint8_t> insert(DeduplicationWindow& window,
+                            const std::shared_ptr<MessageMeta>& meta,
+                            DeduplicationWindow::clock_t::time_point now)
+{
+    auto keep = window.insert(meta->get_info(), now);
+
+    // BOOL8 columns hold one byte per row
+    auto as_bytes = cudf::cast(keep->view(), cudf::data_type{cudf::type_id::UINT8});
+    return test::convert_to_host<uint8_t>(as_bytes->view());
+}
+}  // namespace
+
+TEST_CLASS_WITH_PYTHON(Deduplicate);
+
+TEST_F(TestDeduplicate, DropDuplicates)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    DeduplicationWindow window({"host", "event"}, 10min, 10, 100);
+    const auto start = DeduplicationWindow::clock_t::now();
+
+    // Duplicates within a message keep their first row, the count column is not a key
+    auto first = load_events("first", "a,login,1\nb,login,2\na,login,3\na,logout,4\n");
+    EXPECT_EQ(insert(window, first, start), (std::vector<uint8_t>{1, 1, 0, 1}));
+    EXPECT_EQ(window.size(), 3);
+
+    auto second = load_events("second", "b,login,5\nc,login,6\n");
+    EXPECT_EQ(insert(window, second, start + 1min), (std::vector<uint8_t>{0, 1}));
+    EXPECT_EQ(window.size(), 4);
+}
+
+TEST_F(TestDeduplicate, RollOver)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    DeduplicationWindow window({"host"}, 10min, 10, 100);
+    const auto start = DeduplicationWindow::clock_t::now();
+
+    EXPECT_EQ(insert(window, load_events("a", "a,login,1\n"), start), (std::vector<uint8_t>{1}));
+    EXPECT_EQ(insert(window, load_events("b", "b,login,1\n"), start + 5min), (std::vector<uint8_t>{1}));
+
+    // The bucket of `a` ends at 1 minute and is forgotten 10 minutes later, the bucket of `b` is still in the window
+    auto both = load_events("both", "a,login,1\nb,login,1\n");
+    EXPECT_EQ(insert(window, both, start + 11min), (std::vector<uint8_t>{1, 0}));
+    EXPECT_EQ(window.size(), 2);
+}
+
+TEST_F(TestDeduplicate, MaxKeys)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    DeduplicationWindow window({"host"}, 10min, 10, 2);
+    const auto start = DeduplicationWindow::clock_t::now();
+
+    EXPECT_EQ(insert(window, load_events("a", "a,login,1\n"), start), (std::vector<uint8_t>{1}));
+    EXPECT_EQ(insert(window, load_events("bc", "b,login,1\nc,login,1\n"), start + 2min), (std::vector<uint8_t>{1, 1}));
+
+    // The oldest bucket was dropped early to stay within two keys
+    EXPECT_EQ(window.size(), 2);
+    auto all = load_events("abc", "a,login,1\nb,login,1\nc,login,1\n");
+    EXPECT_EQ(insert(window, all, start + 3min), (std::vector<uint8_t>{1, 0, 0}));
+}
+
+TEST_F(TestDeduplicate, InvalidArguments)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    EXPECT_THROW(DeduplicationWindow({}, 10min, 10, 100), std::invalid_argument);
+    EXPECT_THROW(DeduplicationWindow({"host"}, 0ms, 10, 100), std::invalid_argument);
+    EXPECT_THROW(DeduplicationWindow({"host"}, 10min, 0, 100), std::invalid_argument);
+    EXPECT_THROW(DeduplicationWindow({"host"}, 10min, 10, 0), std::invalid_argument);
+
+    DeduplicationWindow window({"missing"}, 10min, 10, 100);
+    EXPECT_THROW(window.insert(load_events("a", "a,login,1\n")->get_info()), std::invalid_argument);
+}
+
+TEST_F(TestDeduplicate, Checkpoint)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    const auto directory = std::filesystem::temp_directory_path() / "morpheus_test_deduplicate_checkpoint";
+    std::filesystem::remove_all(directory);
+    StateCheckpoint::set_directory(directory.string());
+    StateCheckpoint::record_committed_offset("events", 0, 42);
+
+    {
+        DeduplicationWindow window({"host", "event"}, 10min, 10, 100);
+        insert(window, load_events("first", "a,login,1\nb,login,2\n"), DeduplicationWindow::clock_t::now());
+
+        StateCheckpoint checkpoint("deduplicate", 1min);
+        checkpoint.save(window);
+    }
+
+    // The keys seen before the restart are still known, and the partition is replayed from its committed offset
+    DeduplicationWindow restored({"host", "event"}, 10min, 10, 100);
+    StateCheckpoint checkpoint("deduplicate", 1min);
+    ASSERT_TRUE(checkpoint.restore(restored));
+    EXPECT_EQ(restored.size(), 2);
+    EXPECT_EQ(StateCheckpoint::take_replay_offset("events", 0), 42);
+    EXPECT_FALSE(StateCheckpoint::take_replay_offset("events", 0).has_value());
+
+    auto second = load_events("second", "b,login,3\nc,login,4\n");
+    EXPECT_EQ(insert(restored, second, DeduplicationWindow::clock_t::now()), (std::vector<uint8_t>{0, 1}));
+
+    // Windows keyed on other columns are not restored
+    DeduplicationWindow other({"host"}, 10min, 10, 100);
+    EXPECT_FALSE(checkpoint.restore(other));
+    EXPECT_EQ(other.size(), 0);
+
+    StateCheckpoint::set_directory("");
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // for get_morpheus_root, TEST_CLASS, morpheus
+
+#include "morpheus/io/deserializers.hpp"    // for load_table_from_file
+#include "morpheus/messages/meta.hpp"       // for MessageMeta
+#include "morpheus/stages/deserialize.hpp"  // for coalesce_message_metas
+
+#include <gtest/gtest.h>   // for EXPECT_EQ, EXPECT_TRUE, Message, TestPartResult, TestInfo, TEST_F
+#include <pybind11/gil.h>  // for gil_scoped_release
+
+#include <filesystem>  // for path, operator/
+#include <memory>      // for shared_ptr
+#include <string>      // for string
+#include <vector>      // for vector
+
+using namespace morpheus;
+
+TEST_CLASS_WITH_PYTHON(Deserialize);
+
+TEST_F(TestDeserialize, TestCoalesceMessageMetas)
+{
+    pybind11::gil_scoped_release no_gil;
+    auto test_data_dir               = test::get_morpheus_root() / "tests/tests_data";
+    std::filesystem::path input_file = test_data_dir / "float_str.csv";
+
+    std::vector<std::shared_ptr<MessageMeta>> metas;
+    for (int i = 0; i < 3; ++i)
+    {
+        metas.push_back(MessageMeta::create_from_cpp(load_table_from_file(input_file)));
+    }
+
+    auto coalesced = coalesce_message_metas(metas);
+
+    EXPECT_EQ(coalesced->count(), 3 * metas.front()->count());
+    EXPECT_EQ(coalesced->get_column_names(), metas.front()->get_column_names());
+
+    // The repeated indexes of the inputs are replaced by a new range index
+    EXPECT_TRUE(coalesced->has_sliceable_index());
+}
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"        // for TEST_CLASS_WITH_PYTHON, morpheus
+#include "../test_utils/tensor_utils.hpp"  // for convert_to_host
+
+#include "morpheus/io/deserializers.hpp"  // for load_table_from_file
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/stages/enrich.hpp"
+
+#include <gtest/gtest.h>
+#include <pybind11/gil.h>  // for gil_scoped_release
+
+#include <chrono>      // for milliseconds
+#include <cstdint>     // for int64_t
+#include <filesystem>  // for operator/, path, remove, temp_directory_path
+#include <fstream>     // for ofstream
+#include <memory>      // for shared_ptr
+#include <stdexcept>   // for invalid_argument
+#include <string>      // for string
+#include <vector>      // for vector
+
+using namespace morpheus;
+
+namespace {
+std::string write_csv(const std::string& name, const std::string& contents)
+{
+    auto test_file = std::filesystem::temp_directory_path() / ("morpheus_test_enrich_" + name + ".csv");
+    std::ofstream(test_file) << contents;
+
+    return test_file.string();
+}
+
+std::shared_ptr<MessageMeta> make_events(const std::string& rows)
+{
+    return MessageMeta::create_from_cpp(load_table_from_file(write_csv("events", "host,bytes\n" + rows)));
+}
+
+std::vector<int64_t> column_values(const std::shared_ptr<MessageMeta>& meta, cudf::size_type index)
+{
+    return test::convert_to_host<int64_t>(meta->get_info().get_column(index));
+}
+}  // namespace
+
+TEST_CLASS_WITH_PYTHON(Enrich);
+
+TEST_F(TestEnrich, LookupAndReload)
+{
+    auto filename = write_csv("assets", "host,owner,risk\n1,10,3\n2,20,5\n2,21,6\n");
+    ReferenceTable table(filename, FileTypes::CSV, {"host"}, {}, std::chrono::milliseconds(0));
+
+    // Repeated keys keep their last row, every other column being a value
+    EXPECT_EQ(table.num_rows(), 2);
+    EXPECT_EQ(table.value_columns(), (std::vector<std::string>{"owner", "risk"}));
+
+    auto events                = make_events("2,100\n3,200\n1,300\n2,400\n");
+    auto [values, num_matched] = table.lookup(cudf::table_view{{events->get_info().get_column(0)}});
+    EXPECT_EQ(num_matched, 3);
+    ASSERT_EQ(values->num_rows(), 4);
+    EXPECT_EQ(values->get_column(0).null_count(), 1);
+
+    auto owners = test::convert_to_host<int64_t>(values->get_column(0).view());
+    EXPECT_EQ(owners[0], 21);
+    EXPECT_EQ(owners[2], 10);
+    EXPECT_EQ(owners[3], 21);
+
+    // An unchanged file is not loaded again
+    EXPECT_FALSE(table.reload());
+    EXPECT_EQ(table.num_versions(), 1);
+
+    write_csv("assets", "host,owner,risk\n3,30,1\n");
+    EXPECT_TRUE(table.reload());
+    EXPECT_EQ(table.num_versions(), 2);
+    EXPECT_EQ(table.num_rows(), 1);
+
+    auto reloaded = table.lookup(cudf::table_view{{events->get_info().get_column(0)}});
+    EXPECT_EQ(reloaded.second, 1);
+    EXPECT_EQ(reloaded.first->get_column(0).null_count(), 3);
+
+    // A version which fails to load keeps the current one
+    std::filesystem::remove(filename);
+    EXPECT_THROW(table.reload(), std::runtime_error);
+    EXPECT_EQ(table.num_rows(), 1);
+}
+
+TEST_F(TestEnrich, EnrichPayload)
+{
+    pybind11::gil_scoped_release no_gil;
+    auto filename = write_csv("intel", "address,risk,bytes\n1,7,0\n3,9,0\n");
+    EnrichStage stage(filename,
+                      FileTypes::CSV,
+                      {"address"},
+                      {"risk", "bytes"},
+                      {"host"},
+                      "",
+                      std::chrono::milliseconds(0),
+                      "enrich_test");
+
+    // The appended `bytes` replaces the column of the payload
+    auto enriched = stage.enrich(make_events("1,100\n2,200\n3,300\n"));
+    EXPECT_EQ(enriched->get_column_names(), (std::vector<std::string>{"host", "risk", "bytes"}));
+    EXPECT_EQ(column_values(enriched, 0), (std::vector<int64_t>{1, 2, 3}));
+    EXPECT_EQ(enriched->get_info().get_column(1).null_count(), 1);
+
+    auto risks = column_values(enriched, 1);
+    EXPECT_EQ(risks[0], 7);
+    EXPECT_EQ(risks[2], 9);
+
+    std::filesystem::remove(filename);
+}
+
+TEST_F(TestEnrich, InvalidArguments)
+{
+    pybind11::gil_scoped_release no_gil;
+    auto filename = write_csv("invalid", "host,owner\n1,10\n");
+    EXPECT_THROW(ReferenceTable(filename, FileTypes::CSV, {}, {}, std::chrono::milliseconds(0)),
+                 std::invalid_argument);
+    EXPECT_THROW(ReferenceTable(filename, FileTypes::CSV, {"address"}, {}, std::chrono::milliseconds(0)),
+                 std::invalid_argument);
+    EXPECT_THROW(ReferenceTable(filename, FileTypes::CSV, {"host"}, {"risk"}, std::chrono::milliseconds(0)),
+                 std::invalid_argument);
+
+    EnrichStage stage(
+        filename, FileTypes::CSV, {"host"}, {}, {"address"}, "", std::chrono::milliseconds(0), "enrich_test");
+    EXPECT_THROW(stage.enrich(make_events("1,100\n")), std::invalid_argument);
+
+    std::filesystem::remove(filename);
+    EXPECT_THROW(ReferenceTable(filename, FileTypes::CSV, {"host"}, {}, std::chrono::milliseconds(0)),
+                 std::runtime_error);
+}
@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"        // for TEST_CLASS_WITH_PYTHON, morpheus
+#include "../test_utils/tensor_utils.hpp"  // for convert_to_host
+
+#include "morpheus/io/deserializers.hpp"    // for load_table_from_file, TableSchema
+#include "morpheus/messages/meta.hpp"       // for MessageMeta
+#include "morpheus/stages/filter_rows.hpp"  // for filter_rows, RowFilter
+
+#include <cudf/types.hpp>  // for type_id
+#include <gtest/gtest.h>   // for EXPECT_EQ, EXPECT_THROW, TEST_F
+#include <pybind11/gil.h>  // for gil_scoped_release
+
+#include <cstdint>     // for int64_t
+#include <filesystem>  // for operator/, path, temp_directory_path
+#include <fstream>     // for ofstream
+#include <memory>      // for shared_ptr
+#include <optional>    // for nullopt
+#include <stdexcept>   // for invalid_argument
+#include <string>      // for string
+#include <vector>      // for vector
+
+using namespace morpheus;
+
+namespace {
+std::shared_ptr<MessageMeta> load_requests(const TableSchema& schema = {})
+{
+    auto test_file = std::filesystem::temp_directory_path() / "morpheus_test_filter_rows.csv";
+    std::ofstream(test_file) << "src_ip,url,bytes\n"
+                             << "10.0.0.1,/healthz,10\n"
+                             << "192.168.1.7,/login,200\n"
+                             << "10.1.2.3,/api/data,3000\n"
+                             << "not an ip,/healthz/ready,40\n"
+                             << "8.8.8.8,/login,500\n";
+
+    return MessageMeta::create_from_cpp(load_table_from_file(test_file, FileTypes::Auto, std::nullopt, schema));
+}
+
+std::vector<int64_t> bytes_of(const std::shared_ptr<MessageMeta>& meta)
+{
+    return test::convert_to_host<int64_t>(meta->get_info().get_column(2));
+}
+}  // namespace
+
+TEST_CLASS_WITH_PYTHON(FilterRows);
+
+TEST_F(TestFilterRows, ExcludeMatches)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    auto filtered = filter_rows(load_requests(), RowFilter({{"url", "matches", "^/healthz"}}, true, true));
+
+    ASSERT_NE(filtered, nullptr);
+    EXPECT_EQ(bytes_of(filtered), (std::vector<int64_t>{200, 3000, 500}));
+    EXPECT_EQ(filtered->get_column_names(), (std::vector<std::string>{"src_ip", "url", "bytes"}));
+}
+
+TEST_F(TestFilterRows, InCidr)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    RowFilter filter({{"src_ip", "in_cidr", "10.0.0.0/8, 192.168.1.7"}}, true, false);
+    auto filtered = filter_rows(load_requests(), filter);
+
+    ASSERT_NE(filtered, nullptr);
+    EXPECT_EQ(bytes_of(filtered), (std::vector<int64_t>{10, 200, 3000}));
+}
+
+TEST_F(TestFilterRows, CombinePredicates)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    auto meta = load_requests();
+
+    auto all_of = filter_rows(meta, RowFilter({{"bytes", ">=", "200"}, {"url", "==", "/login"}}, true, false));
+    ASSERT_NE(all_of, nullptr);
+    EXPECT_EQ(bytes_of(all_of), (std::vector<int64_t>{200, 500}));
+
+    auto any_of = filter_rows(meta, RowFilter({{"bytes", ">", "1000"}, {"bytes", "<", "20"}}, false, false));
+    ASSERT_NE(any_of, nullptr);
+    EXPECT_EQ(bytes_of(any_of), (std::vector<int64_t>{10, 3000}));
+}
+
+TEST_F(TestFilterRows, DictionaryColumns)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    auto meta = load_requests(
+        TableSchema::from_type_names({{"src_ip", "category"}, {"url", "category"}, {"bytes", "int64"}}));
+    ASSERT_EQ(meta->get_info().get_column(0).type().id(), cudf::type_id::DICTIONARY32);
+
+    auto matches = filter_rows(meta, RowFilter({{"url", "matches", "^/healthz"}}, true, true));
+    ASSERT_NE(matches, nullptr);
+    EXPECT_EQ(bytes_of(matches), (std::vector<int64_t>{200, 3000, 500}));
+
+    auto in_cidr = filter_rows(meta, RowFilter({{"src_ip", "in_cidr", "10.0.0.0/8, 192.168.1.7"}}, true, false));
+    ASSERT_NE(in_cidr, nullptr);
+    EXPECT_EQ(bytes_of(in_cidr), (std::vector<int64_t>{10, 200, 3000}));
+
+    // The kept rows are still dictionary encoded
+    EXPECT_EQ(in_cidr->get_info().get_column(1).type().id(), cudf::type_id::DICTIONARY32);
+
+    auto equal = filter_rows(meta, RowFilter({{"url", "==", "/login"}}, true, false));
+    ASSERT_NE(equal, nullptr);
+    EXPECT_EQ(bytes_of(equal), (std::vector<int64_t>{200, 500}));
+}
+
+TEST_F(TestFilterRows, KeepAllOrNone)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    auto meta = load_requests();
+
+    EXPECT_EQ(filter_rows(meta, RowFilter({{"bytes", ">", "0"}}, true, false)), meta);
+    EXPECT_EQ(filter_rows(meta, RowFilter({{"bytes", ">", "0"}}, true, true)), nullptr);
+}
+
+TEST_F(TestFilterRows, InvalidPredicates)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    EXPECT_THROW(RowFilter({}, true, false), std::invalid_argument);
+    EXPECT_THROW(RowFilter({{"bytes", "like", "1"}}, true, false), std::invalid_argument);
+    EXPECT_THROW(RowFilter({{"src_ip", "in_cidr", "10.0.0.0/33"}}, true, false), std::invalid_argument);
+    EXPECT_THROW(RowFilter({{"src_ip", "in_cidr", "10.0.256.0/8"}}, true, false), std::invalid_argument);
+
+    auto meta = load_requests();
+    EXPECT_THROW(filter_rows(meta, RowFilter({{"missing", "==", "1"}}, true, false)), std::invalid_argument);
+    EXPECT_THROW(filter_rows(meta, RowFilter({{"bytes", "matches", "1"}}, true, false)), std::invalid_argument);
+    EXPECT_THROW(filter_rows(meta, RowFilter({{"bytes", "<", "many"}}, true, false)), std::invalid_argument);
+}
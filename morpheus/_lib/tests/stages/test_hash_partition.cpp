@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"        // for TEST_CLASS_WITH_PYTHON, morpheus
+#include "../test_utils/tensor_utils.hpp"  // for convert_to_host
+
+#include "morpheus/io/deserializers.hpp"       // for load_table_from_file
+#include "morpheus/messages/control.hpp"       // for ControlMessage
+#include "morpheus/messages/meta.hpp"          // for MessageMeta
+#include "morpheus/stages/hash_partition.hpp"  // for hash_partition, HashPartitionStageCM
+
+#include <gtest/gtest.h>   // for EXPECT_EQ, EXPECT_THROW, TEST_F
+#include <pybind11/gil.h>  // for gil_scoped_release
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t
+#include <filesystem>  // for operator/, path, temp_directory_path
+#include <fstream>     // for ofstream
+#include <map>         // for map
+#include <memory>      // for shared_ptr, make_shared
+#include <stdexcept>   // for invalid_argument
+#include <string>      // for string
+#include <vector>      // for vector
+
+using namespace morpheus;
+
+namespace {
+std::shared_ptr<MessageMeta> load_flows()
+{
+    auto test_file = std::filesystem::temp_directory_path() / "morpheus_test_hash_partition.csv";
+    std::ofstream(test_file) << "flow_id,bytes\n"
+                             << "1,10\n"
+                             << "2,20\n"
+                             << "3,30\n"
+                             << "1,40\n"
+                             << "4,50\n"
+                             << "2,60\n"
+                             << "5,70\n"
+                             << "1,80\n";
+
+    return MessageMeta::create_from_cpp(load_table_from_file(test_file));
+}
+
+std::vector<int64_t> flow_ids_of(const std::shared_ptr<MessageMeta>& meta)
+{
+    return test::convert_to_host<int64_t>(meta->get_info().get_column(0));
+}
+}  // namespace
+
+TEST_CLASS_WITH_PYTHON(HashPartition);
+
+TEST_F(TestHashPartition, KeysLandInSinglePartition)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    auto meta       = load_flows();
+    auto partitions = hash_partition(meta, {"flow_id"}, 3);
+
+    ASSERT_EQ(partitions.size(), 3);
+
+    std::map<int64_t, std::size_t> partition_of_flow;
+    std::size_t num_rows = 0;
+    for (std::size_t i = 0; i < partitions.size(); ++i)
+    {
+        if (partitions[i] == nullptr)
+        {
+            continue;
+        }
+
+        EXPECT_EQ(partitions[i]->get_column_names(), (std::vector<std::string>{"flow_id", "bytes"}));
+
+        for (auto flow_id : flow_ids_of(partitions[i]))
+        {
+            auto found = partition_of_flow.emplace(flow_id, i).first;
+            EXPECT_EQ(found->second, i);
+            ++num_rows;
+        }
+    }
+
+    EXPECT_EQ(num_rows, meta->count());
+    EXPECT_EQ(partition_of_flow.size(), 5);
+
+    // The same keys are routed to the same partitions across messages
+    auto again = hash_partition(load_flows(), {"flow_id"}, 3);
+    for (std::size_t i = 0; i < again.size(); ++i)
+    {
+        ASSERT_EQ(again[i] == nullptr, partitions[i] == nullptr);
+        if (again[i] != nullptr)
+        {
+            EXPECT_EQ(flow_ids_of(again[i]), flow_ids_of(partitions[i]));
+        }
+    }
+
+    // A single partition is the message itself
+    EXPECT_EQ(hash_partition(meta, {"flow_id"}, 1), (std::vector<std::shared_ptr<MessageMeta>>{meta}));
+
+    EXPECT_THROW(hash_partition(meta, {"src_ip"}, 3), std::invalid_argument);
+}
+
+TEST_F(TestHashPartition, ControlMessagePartitionsKeepMetadata)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    auto cm = std::make_shared<ControlMessage>();
+    cm->payload(load_flows());
+    cm->set_metadata("source", "sensor-1");
+
+    auto stage  = std::make_shared<HashPartitionStageCM>(std::vector<std::string>{"flow_id"}, 2);
+    auto output = stage->on_data(cm);
+
+    ASSERT_EQ(output->partitions.size(), 2);
+
+    std::size_t num_rows = 0;
+    for (const auto& partition : output->partitions)
+    {
+        if (partition != nullptr)
+        {
+            EXPECT_EQ(partition->get_metadata("source"), "sensor-1");
+            num_rows += partition->payload()->count();
+        }
+    }
+
+    EXPECT_EQ(num_rows, cm->payload()->count());
+
+    EXPECT_THROW(HashPartitionStageCM({}, 2), std::invalid_argument);
+    EXPECT_THROW(HashPartitionStageCM({"flow_id"}, 0), std::invalid_argument);
+}
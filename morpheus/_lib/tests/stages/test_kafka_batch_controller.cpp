@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // for TEST_CLASS
+
+#include "morpheus/stages/kafka_source.hpp"  // for KafkaBatchController
+
+#include <gtest/gtest.h>  // for EXPECT_EQ, TEST_F
+
+#include <chrono>  // for milliseconds
+
+using namespace morpheus;
+
+TEST_CLASS(KafkaBatchController);
+
+TEST_F(TestKafkaBatchController, InitialValues)
+{
+    KafkaBatchController controller(1024, 100, 50);
+
+    EXPECT_EQ(controller.batch_size(), 1024);
+    EXPECT_EQ(controller.batch_timeout_ms(), 50);
+}
+
+TEST_F(TestKafkaBatchController, ShrinksWhenQuiet)
+{
+    KafkaBatchController controller(1024, 100, 50);
+
+    controller.update(10, std::chrono::milliseconds(5));
+    EXPECT_EQ(controller.batch_size(), 512);
+    EXPECT_EQ(controller.batch_timeout_ms(), 45);
+
+    // Settles between the number of messages received and twice that
+    for (int i = 0; i < 20; ++i)
+    {
+        controller.update(10, std::chrono::milliseconds(5));
+    }
+
+    EXPECT_EQ(controller.batch_size(), 16);
+}
+
+TEST_F(TestKafkaBatchController, GrowsUnderLoad)
+{
+    KafkaBatchController controller(1024, 100, 50);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        controller.update(1, std::chrono::milliseconds(1));
+    }
+
+    ASSERT_EQ(controller.batch_size(), 2);
+
+    // Full batch
+    controller.update(2, std::chrono::milliseconds(1));
+    EXPECT_EQ(controller.batch_size(), 4);
+
+    // Lag exceeds the batch size
+    controller.update(1, std::chrono::milliseconds(1), 100);
+    EXPECT_EQ(controller.batch_size(), 8);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        controller.update(controller.batch_size(), std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(controller.batch_size(), 1024);
+}
+
+TEST_F(TestKafkaBatchController, TimeoutRespectsBounds)
+{
+    KafkaBatchController controller(1024, 20, 50);
+
+    // Timeout can never exceed the configured batch timeout
+    controller.update(1, std::chrono::milliseconds(1));
+    EXPECT_EQ(controller.batch_timeout_ms(), 20);
+
+    // Processing slower than the target still waits at least 1 ms
+    for (int i = 0; i < 200; ++i)
+    {
+        controller.update(1, std::chrono::milliseconds(80));
+    }
+
+    EXPECT_EQ(controller.batch_timeout_ms(), 1);
+}
@@ -0,0 +1,184 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // for TEST_CLASS
+
+#include "morpheus/stages/kafka_source.hpp"  // for KafkaOffsetTracker, KafkaOffsetRange
+
+#include <gtest/gtest.h>  // for EXPECT_EQ, TEST_F
+#include <librdkafka/rdkafkacpp.h>
+
+#include <cstdint>  // for int32_t, int64_t
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+using commit_t = std::tuple<std::string, int32_t, int64_t>;
+
+std::vector<commit_t> take_commits(KafkaOffsetTracker& tracker,
+                                   const std::vector<RdKafka::TopicPartition*>* partitions = nullptr)
+{
+    std::vector<commit_t> commits;
+
+    for (const auto& toppar : tracker.take_commits(partitions))
+    {
+        commits.emplace_back(toppar->topic(), toppar->partition(), toppar->offset());
+    }
+
+    return commits;
+}
+}  // namespace
+
+TEST_CLASS(KafkaOffsetTracker);
+
+TEST_F(TestKafkaOffsetTracker, NothingToCommitUntilAcknowledged)
+{
+    auto tracker = std::make_shared<KafkaOffsetTracker>();
+
+    auto ack = tracker->track({{"topic", 0, 0, 10}});
+    EXPECT_TRUE(take_commits(*tracker).empty());
+
+    ack();
+    EXPECT_EQ(take_commits(*tracker), (std::vector<commit_t>{{"topic", 0, 10}}));
+
+    // Only partitions whose watermark advanced since the last call are returned
+    EXPECT_TRUE(take_commits(*tracker).empty());
+}
+
+TEST_F(TestKafkaOffsetTracker, OutOfOrderAcks)
+{
+    auto tracker = std::make_shared<KafkaOffsetTracker>();
+
+    auto ack_0 = tracker->track({{"topic", 0, 0, 10}});
+    auto ack_1 = tracker->track({{"topic", 0, 10, 20}});
+    auto ack_2 = tracker->track({{"topic", 0, 20, 30}});
+
+    ack_2();
+    ack_1();
+    EXPECT_TRUE(take_commits(*tracker).empty());
+
+    // The watermark jumps over every range acknowledged so far
+    ack_0();
+    EXPECT_EQ(take_commits(*tracker), (std::vector<commit_t>{{"topic", 0, 30}}));
+}
+
+TEST_F(TestKafkaOffsetTracker, WatermarkOnlyAdvancesOverContiguousRanges)
+{
+    auto tracker = std::make_shared<KafkaOffsetTracker>();
+
+    auto ack_0 = tracker->track({{"topic", 0, 0, 10}});
+    auto ack_1 = tracker->track({{"topic", 0, 10, 20}});
+    auto ack_2 = tracker->track({{"topic", 0, 20, 30}});
+    auto ack_3 = tracker->track({{"topic", 0, 30, 40}});
+
+    ack_0();
+    ack_2();
+    ack_3();
+    EXPECT_EQ(take_commits(*tracker), (std::vector<commit_t>{{"topic", 0, 10}}));
+
+    ack_1();
+    EXPECT_EQ(take_commits(*tracker), (std::vector<commit_t>{{"topic", 0, 40}}));
+}
+
+TEST_F(TestKafkaOffsetTracker, UnackedRangeHoldsWatermarkBack)
+{
+    auto tracker = std::make_shared<KafkaOffsetTracker>();
+
+    {
+        // Dropped without being acknowledged, as when a downstream stage fails or filters the message
+        auto dropped = tracker->track({{"topic", 0, 0, 10}});
+    }
+
+    auto ack_1 = tracker->track({{"topic", 0, 10, 20}});
+    auto ack_2 = tracker->track({{"topic", 0, 20, 30}});
+
+    ack_1();
+    ack_2();
+    EXPECT_TRUE(take_commits(*tracker).empty());
+}
+
+TEST_F(TestKafkaOffsetTracker, PartitionsAreIndependent)
+{
+    auto tracker = std::make_shared<KafkaOffsetTracker>();
+
+    auto unacked = tracker->track({{"topic", 0, 0, 10}});
+    auto ack     = tracker->track({{"topic", 1, 0, 5}, {"other", 0, 100, 110}});
+
+    ack();
+    EXPECT_EQ(take_commits(*tracker), (std::vector<commit_t>{{"other", 0, 110}, {"topic", 1, 5}}));
+
+    // Limited to the requested partitions
+    auto ack_1 = tracker->track({{"topic", 1, 5, 10}});
+    auto ack_2 = tracker->track({{"other", 0, 110, 120}});
+    ack_1();
+    ack_2();
+
+    std::unique_ptr<RdKafka::TopicPartition> toppar(RdKafka::TopicPartition::create("topic", 1));
+    std::vector<RdKafka::TopicPartition*> partitions{toppar.get()};
+
+    EXPECT_EQ(take_commits(*tracker, &partitions), (std::vector<commit_t>{{"topic", 1, 10}}));
+    EXPECT_EQ(take_commits(*tracker), (std::vector<commit_t>{{"other", 0, 120}}));
+}
+
+TEST_F(TestKafkaOffsetTracker, RepeatedAckIsIgnored)
+{
+    auto tracker = std::make_shared<KafkaOffsetTracker>();
+
+    auto ack_0 = tracker->track({{"topic", 0, 0, 10}});
+    auto ack_1 = tracker->track({{"topic", 0, 10, 20}});
+
+    ack_0();
+    ack_0();
+    EXPECT_EQ(take_commits(*tracker), (std::vector<commit_t>{{"topic", 0, 10}}));
+    EXPECT_TRUE(take_commits(*tracker).empty());
+}
+
+TEST_F(TestKafkaOffsetTracker, AckAfterRemoveIsIgnored)
+{
+    auto tracker = std::make_shared<KafkaOffsetTracker>();
+
+    auto ack_0 = tracker->track({{"topic", 0, 0, 10}});
+    auto ack_1 = tracker->track({{"topic", 1, 0, 10}});
+
+    std::unique_ptr<RdKafka::TopicPartition> toppar(RdKafka::TopicPartition::create("topic", 0));
+    tracker->remove({toppar.get()});
+
+    ack_0();
+    ack_1();
+    EXPECT_EQ(take_commits(*tracker), (std::vector<commit_t>{{"topic", 1, 10}}));
+
+    auto ack_2 = tracker->track({{"topic", 1, 10, 20}});
+    tracker->clear();
+
+    ack_2();
+    EXPECT_TRUE(take_commits(*tracker).empty());
+}
+
+TEST_F(TestKafkaOffsetTracker, AckAfterDestroyIsNoop)
+{
+    auto tracker = std::make_shared<KafkaOffsetTracker>();
+
+    auto ack = tracker->track({{"topic", 0, 0, 10}});
+    tracker.reset();
+
+    EXPECT_NO_THROW(ack());
+}
@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"        // for TEST_CLASS_WITH_PYTHON, morpheus
+#include "../test_utils/tensor_utils.hpp"  // for convert_to_host
+
+#include "morpheus/io/deserializers.hpp"      // for load_table_from_file
+#include "morpheus/messages/meta.hpp"         // for MessageMeta
+#include "morpheus/stages/load_shedding.hpp"  // for LoadSheddingSampler
+#include "morpheus/utilities/metrics.hpp"     // for MetricsRegistry
+
+#include <cudf/types.hpp>  // for data_type
+#include <cudf/unary.hpp>  // for cast
+#include <gtest/gtest.h>   // for EXPECT_EQ, EXPECT_THROW, TEST_F
+#include <pybind11/gil.h>  // for gil_scoped_release
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint8_t
+#include <filesystem>  // for operator/, path, temp_directory_path
+#include <fstream>     // for ofstream
+#include <map>         // for map
+#include <memory>      // for shared_ptr
+#include <stdexcept>   // for invalid_argument
+#include <string>      // for string
+#include <vector>      // for vector
+
+using namespace morpheus;
+
+namespace {
+// 1000 rows alternating between the priorities `high` and `low`
+std::shared_ptr<MessageMeta> load_events()
+{
+    auto test_file = std::filesystem::temp_directory_path() / "morpheus_test_load_shedding.csv";
+    std::ofstream out(test_file);
+    out << "priority,value\n";
+    for (int i = 0; i < 1000; ++i)
+    {
+        out << (i % 2 == 0 ? "high" : "low") << "," << i << "\n";
+    }
+    out.close();
+
+    return MessageMeta::create_from_cpp(load_table_from_file(test_file));
+}
+
+std::vector<uint8_t> keep_mask(LoadSheddingSampler& sampler,
+                               const std::shared_ptr<MessageMeta>& meta,
+                               const std::map<std::string, double>& rates)
+{
+    auto keep     = sampler.keep_mask(meta->get_info(), rates);
+    auto as_bytes = cudf::cast(keep->view(), cudf::data_type{cudf::type_id::UINT8});
+    return test::convert_to_host<uint8_t>(as_bytes->view());
+}
+}  // namespace
+
+TEST_CLASS_WITH_PYTHON(LoadShedding);
+
+TEST_F(TestLoadShedding, ReadPressure)
+{
+    auto gauge = MetricsRegistry::get_instance().get_gauge("test_load_shedding_queue_depth", "", {{"test", "read"}});
+
+    LoadSheddingSampler sampler(
+        "priority", {{"low", 0.1}}, "test_load_shedding_queue_depth", {{"test", "read"}}, false, 100, 300);
+
+    gauge->set(50);
+    EXPECT_DOUBLE_EQ(sampler.read_pressure(), 0.0);
+
+    gauge->set(200);
+    EXPECT_DOUBLE_EQ(sampler.read_pressure(), 0.5);
+    EXPECT_DOUBLE_EQ(sampler.sampling_rates(0.5).at("low"), 0.55);
+
+    gauge->set(1000);
+    EXPECT_DOUBLE_EQ(sampler.read_pressure(), 1.0);
+    EXPECT_DOUBLE_EQ(sampler.sampling_rates(1.0).at("low"), 0.1);
+}
+
+TEST_F(TestLoadShedding, ReadHistogramPressure)
+{
+    auto histogram = MetricsRegistry::get_instance().get_histogram("test_load_shedding_latency_seconds", "", {});
+
+    LoadSheddingSampler sampler("priority", {{"low", 0.0}}, "test_load_shedding_latency_seconds", {}, true, 1.0, 2.0);
+
+    // Only the values observed since the previous read count
+    histogram->observe(10.0);
+    sampler.read_pressure();
+
+    histogram->observe(1.5);
+    EXPECT_DOUBLE_EQ(sampler.read_pressure(), 0.5);
+    EXPECT_DOUBLE_EQ(sampler.read_pressure(), 0.5);
+}
+
+TEST_F(TestLoadShedding, SampleLowPriority)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    LoadSheddingSampler sampler("priority", {{"low", 0.2}}, "test_load_shedding_sample", {}, false, 0, 1);
+    auto meta = load_events();
+
+    auto keep = keep_mask(sampler, meta, {{"low", 0.2}});
+
+    std::size_t low_kept = 0;
+    for (std::size_t row = 0; row < keep.size(); ++row)
+    {
+        if (row % 2 == 0)
+        {
+            EXPECT_EQ(keep[row], 1) << "High priority row " << row << " was dropped";
+        }
+        else
+        {
+            low_kept += keep[row];
+        }
+    }
+
+    EXPECT_GT(low_kept, 50);
+    EXPECT_LT(low_kept, 150);
+
+    // Each message draws different samples
+    EXPECT_NE(keep_mask(sampler, meta, {{"low", 0.2}}), keep);
+}
+
+TEST_F(TestLoadShedding, InvalidArguments)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    EXPECT_THROW(LoadSheddingSampler("priority", {}, "test_load_shedding_invalid", {}, false, 0, 1),
+                 std::invalid_argument);
+    EXPECT_THROW(LoadSheddingSampler("priority", {{"low", 1.5}}, "test_load_shedding_invalid", {}, false, 0, 1),
+                 std::invalid_argument);
+    EXPECT_THROW(LoadSheddingSampler("priority", {{"low", 0.5}}, "test_load_shedding_invalid", {}, false, 1, 1),
+                 std::invalid_argument);
+
+    LoadSheddingSampler sampler("missing", {{"low", 0.5}}, "test_load_shedding_invalid", {}, false, 0, 1);
+    EXPECT_THROW(keep_mask(sampler, load_events(), {{"low", 0.5}}), std::invalid_argument);
+
+    LoadSheddingSampler by_value("value", {{"low", 0.5}}, "test_load_shedding_invalid", {}, false, 0, 1);
+    EXPECT_THROW(keep_mask(by_value, load_events(), {{"low", 0.5}}), std::invalid_argument);
+}
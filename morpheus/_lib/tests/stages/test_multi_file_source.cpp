@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // for get_morpheus_root, TEST_CLASS, morpheus
+
+#include "morpheus/stages/multi_file_source.hpp"  // for MultiFileSourceStage
+
+#include <gtest/gtest.h>  // for EXPECT_EQ, EXPECT_THROW, Message, TestPartResult, TestInfo, TEST_F
+
+#include <filesystem>  // for path, operator/
+#include <stdexcept>   // for runtime_error
+#include <string>      // for string
+#include <vector>      // for vector
+
+using namespace morpheus;
+
+TEST_CLASS(MultiFileSource);
+
+TEST_F(TestMultiFileSource, ExpandGlobs)
+{
+    auto test_data_dir = (test::get_morpheus_root() / "tests/tests_data").string();
+
+    // Entries without wildcards are kept as they are, even when they do not exist
+    auto filenames = MultiFileSourceStage::expand_globs(
+        {test_data_dir + "/countries*.csv", test_data_dir + "/does_not_exist.csv"});
+
+    std::vector<std::string> expected{test_data_dir + "/countries.csv",
+                                      test_data_dir + "/countries_sample.csv",
+                                      test_data_dir + "/does_not_exist.csv"};
+    EXPECT_EQ(filenames, expected);
+
+    EXPECT_THROW(MultiFileSourceStage::expand_globs({test_data_dir + "/does_not_exist*.csv"}), std::runtime_error);
+}
@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // for TEST_CLASS, morpheus
+
+#include "morpheus/stages/nvml_source.hpp"  // for NvmlSampler
+
+#include <cudf/types.hpp>  // for type_id
+#include <gtest/gtest.h>   // for EXPECT_EQ, TEST_F
+
+#include <cstddef>  // for size_t
+#include <string>   // for string
+#include <vector>   // for vector
+
+using namespace morpheus;
+
+TEST_CLASS(NvmlSource);
+
+TEST_F(TestNvmlSource, SamplesEveryDevice)
+{
+    NvmlSampler sampler;
+    ASSERT_GT(sampler.num_devices(), 0);
+
+    sampler.sample();
+    sampler.sample();
+    EXPECT_EQ(sampler.num_rows(), 2 * sampler.num_devices());
+
+    auto table = sampler.flush();
+    EXPECT_EQ(sampler.num_rows(), 0);
+    EXPECT_EQ(table.tbl->num_rows(), 2 * sampler.num_devices());
+
+    const auto& features = NvmlSampler::feature_columns();
+    ASSERT_EQ(table.tbl->num_columns(), features.size() + 2);
+    EXPECT_EQ(table.metadata.schema_info[0].name, "timestamp");
+    EXPECT_EQ(table.metadata.schema_info[1].name, "nvidia_smi_log.gpu.minor_number");
+
+    for (std::size_t i = 0; i < features.size(); ++i)
+    {
+        EXPECT_EQ(table.metadata.schema_info[i + 2].name, features[i]);
+        EXPECT_EQ(table.tbl->get_column(i + 2).type().id(), cudf::type_id::FLOAT64);
+    }
+
+    // Every GPU reports its memory usage
+    EXPECT_EQ(table.tbl->get_column(2).null_count(), 0);
+}
@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // for TEST_CLASS_WITH_PYTHON, morpheus
+
+#include "morpheus/io/deserializers.hpp"               // for load_table_from_file
+#include "morpheus/messages/control.hpp"               // for ControlMessage
+#include "morpheus/messages/memory/tensor_memory.hpp"  // for TensorMemory
+#include "morpheus/messages/meta.hpp"                  // for MessageMeta
+#include "morpheus/messages/multi.hpp"                 // for MultiMessage
+#include "morpheus/messages/multi_inference.hpp"       // for MultiInferenceMessage
+#include "morpheus/objects/dense_model_store.hpp"      // for DenseModelStore
+#include "morpheus/objects/feature_scalers.hpp"        // for FeatureScalers
+#include "morpheus/objects/tensor_object.hpp"          // for TensorObject
+#include "morpheus/stages/preprocess_ae.hpp"           // for PreprocessAEStageCM, PreprocessAEStageMM
+#include "morpheus/types.hpp"                          // for TensorIndex
+
+#include <cuda_runtime.h>       // for cudaMemcpy, cudaMemcpyKind
+#include <gtest/gtest.h>        // for EXPECT_EQ, TEST_F
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <pybind11/gil.h>       // for gil_scoped_release
+
+#include <cstdint>     // for int32_t
+#include <filesystem>  // for path, temp_directory_path, remove
+#include <fstream>     // for ofstream
+#include <memory>      // for make_shared, shared_ptr
+#include <stdexcept>   // for invalid_argument
+#include <string>      // for string
+#include <vector>      // for vector
+
+using namespace morpheus;
+
+namespace {
+std::filesystem::path write_file(const std::string& name, const std::string& contents)
+{
+    auto path = std::filesystem::temp_directory_path() / ("morpheus_test_preprocess_ae." + name);
+
+    std::ofstream out_stream{path};
+    out_stream << contents;
+
+    return path;
+}
+
+template <typename T>
+std::vector<T> to_host(const TensorObject& tensor)
+{
+    std::vector<T> host(tensor.count());
+    MRC_CHECK_CUDA(cudaMemcpy(host.data(), tensor.data(), host.size() * sizeof(T), cudaMemcpyDeviceToHost));
+    return host;
+}
+
+// The vocabulary is not sorted, such that the inputs of the one-hot feature follow its order rather than the sorted one
+const std::string ScalersJson = R"({
+    "features": [
+        {"column": "logcount", "scaler": "standard", "mean": 1, "std": 2},
+        {"column": "locincrement", "scaler": "minmax", "min": 0, "max": 12},
+        {"column": "appDisplayName", "scaler": "onehot", "vocabulary": ["Teams", "Office 365"]}
+    ],
+    "users": {
+        "alice": {"logcount": {"mean": 3, "std": 1}}
+    }
+})";
+
+const std::string DataCsv =
+    "logcount,locincrement,appDisplayName\n"
+    "1,0,Teams\n"
+    "3,6,Office 365\n"
+    ",12,Outlook\n";
+}  // namespace
+
+TEST_CLASS_WITH_PYTHON(PreprocessAE);
+
+TEST_F(TestPreprocessAE, TestScalesFeatures)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    auto scalers_file = write_file("json", ScalersJson);
+    auto data_file    = write_file("csv", DataCsv);
+
+    auto scalers     = std::make_shared<FeatureScalers>(scalers_file.string());
+    auto model_store = std::make_shared<DenseModelStore>(8);
+
+    EXPECT_EQ(scalers->num_inputs(), 4);
+    EXPECT_TRUE(scalers->has_user("alice"));
+    EXPECT_FALSE(scalers->has_user("bob"));
+
+    // A MultiMessage is scaled with the global scalers
+    auto mm          = std::make_shared<MultiMessage>(MessageMeta::create_from_cpp(load_table_from_file(data_file)));
+    auto mm_stage    = std::make_shared<PreprocessAEStageMM>(scalers);
+    auto mm_response = mm_stage->on_data(mm);
+
+    std::vector<float> expected_global = {0, 0, 1, 0, 1, 0.5, 0, 1, 0, 1, 0, 0};
+    EXPECT_EQ(to_host<float>(mm_response->memory->get_tensor("input")), expected_global);
+
+    std::vector<TensorIndex> expected_seq_ids = {0, 0, 3, 1, 0, 3, 2, 0, 3};
+    EXPECT_EQ(to_host<TensorIndex>(mm_response->memory->get_tensor("seq_ids")), expected_seq_ids);
+
+    // A ControlMessage is scaled with the scalers of its user, along with the index of its model
+    auto cm = std::make_shared<ControlMessage>();
+    cm->payload(MessageMeta::create_from_cpp(load_table_from_file(data_file)));
+    cm->set_metadata("user_id", "alice");
+
+    auto cm_stage    = std::make_shared<PreprocessAEStageCM>(scalers, model_store, "user_id");
+    auto cm_response = cm_stage->on_data(cm);
+    auto cm_tensors  = cm_response->tensors();
+
+    std::vector<float> expected_alice = {-2, 0, 1, 0, 0, 0.5, 0, 1, 0, 1, 0, 0};
+    EXPECT_EQ(to_host<float>(cm_tensors->get_tensor("input")), expected_alice);
+    EXPECT_EQ(to_host<TensorIndex>(cm_tensors->get_tensor("seq_ids")), expected_seq_ids);
+
+    std::vector<int32_t> expected_model_index(3, model_store->model_index("alice"));
+    EXPECT_EQ(to_host<int32_t>(cm_tensors->get_tensor("model_index")), expected_model_index);
+
+    std::filesystem::remove(scalers_file);
+    std::filesystem::remove(data_file);
+}
+
+TEST_F(TestPreprocessAE, TestInvalidScalers)
+{
+    auto unknown_scaler = write_file("json", R"({"features": [{"column": "logcount", "scaler": "log"}]})");
+    EXPECT_THROW(FeatureScalers{unknown_scaler.string()}, std::invalid_argument);
+
+    auto missing_param = write_file("json", R"({"features": [{"column": "logcount", "scaler": "standard"}]})");
+    EXPECT_THROW(FeatureScalers{missing_param.string()}, std::invalid_argument);
+
+    auto onehot_override = write_file("json", R"({
+        "features": [{"column": "app", "scaler": "onehot", "vocabulary": ["a"]}],
+        "users": {"alice": {"app": {"mean": 0, "std": 1}}}
+    })");
+    EXPECT_THROW(FeatureScalers{onehot_override.string()}, std::invalid_argument);
+
+    EXPECT_THROW(FeatureScalers{"/nonexistent/scalers.json"}, std::invalid_argument);
+
+    std::filesystem::remove(onehot_override);
+}
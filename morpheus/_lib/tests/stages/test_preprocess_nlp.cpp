@@ -23,18 +23,22 @@
 #include "morpheus/messages/meta.hpp"                  // for MessageMeta
 #include "morpheus/messages/multi.hpp"                 // for MultiMessage
 #include "morpheus/messages/multi_inference.hpp"       // for MultiInferenceMessage
+#include "morpheus/objects/dtype.hpp"                  // for DType
+#include "morpheus/objects/tokenizer.hpp"              // for BytePairTokenizer, DeduplicatingTokenizer
 #include "morpheus/objects/tensor_object.hpp"          // for TensorObject
 #include "morpheus/stages/preprocess_nlp.hpp"          // for PreprocessNLPStage, PreprocessNLPStageCC, PreprocessNL...
-#include "morpheus/types.hpp"                          // for TensorIndex
+#include "morpheus/types.hpp"                          // for TensorIndex, ShapeType
 
 #include <cuda_runtime.h>       // for cudaMemcpy, cudaMemcpyKind
 #include <gtest/gtest.h>        // for EXPECT_EQ, Message, TestPartResult, TestInfo, TEST_F
 #include <mrc/cuda/common.hpp>  // for __check_cuda_errors, MRC_CHECK_CUDA
 #include <pybind11/gil.h>       // for gil_scoped_acquire, gil_scoped_release
 
-#include <cstdint>     // for int32_t
-#include <filesystem>  // for operator/, path
+#include <cstdint>     // for int32_t, uint32_t
+#include <filesystem>  // for operator/, path, temp_directory_path
+#include <fstream>     // for ofstream
 #include <memory>      // for allocator, make_shared, __shared_ptr_access, shared_ptr
+#include <stdexcept>   // for invalid_argument
 #include <utility>     // for move
 #include <vector>      // for vector
 
@@ -127,3 +131,170 @@ TEST_F(TestPreprocessNLP, TestProcessControlMessageAndMultiMessage)
     EXPECT_EQ(expected_seq_ids, cm_seq_ids_host);
     EXPECT_EQ(cm_seq_ids_host, mm_seq_ids_host);
 }
+
+TEST_F(TestPreprocessNLP, TestUint32Tokens)
+{
+    pybind11::gil_scoped_release no_gil;
+    auto test_data_dir               = test::get_morpheus_root() / "tests/tests_data";
+    std::filesystem::path input_file = test_data_dir / "countries_sample.csv";
+
+    auto test_vocab_hash_file_dir         = test::get_morpheus_root() / "morpheus/data";
+    std::filesystem::path vocab_hash_file = test_vocab_hash_file_dir / "bert-base-cased-hash.txt";
+
+    auto table = load_table_from_file(input_file);
+    auto meta  = MessageMeta::create_from_cpp(std::move(table));
+    auto mm    = std::make_shared<MultiMessage>(meta);
+
+    auto mm_stage = std::make_shared<PreprocessNLPStageMM>(vocab_hash_file /*vocab_hash_file*/,
+                                                           1 /*sequence_length*/,
+                                                           false /*truncation*/,
+                                                           false /*do_lower_case*/,
+                                                           false /*add_special_token*/,
+                                                           1 /*stride*/,
+                                                           "country" /*column*/,
+                                                           true /*uint32_tokens*/);
+    auto mm_response = mm_stage->on_data(mm);
+    auto mm_tensors  = mm_response->memory;
+
+    // The tokenizer's outputs are passed on as they are, the seq_ids keep their type
+    auto input_ids = mm_tensors->get_tensor("input_ids");
+    EXPECT_EQ(input_ids.dtype(), DType::create<uint32_t>());
+    EXPECT_EQ(input_ids.get_host_data<uint32_t>(), std::vector<uint32_t>({6469, 10278, 11347, 1262, 27583, 13833}));
+
+    auto input_mask = mm_tensors->get_tensor("input_mask");
+    EXPECT_EQ(input_mask.dtype(), DType::create<uint32_t>());
+    EXPECT_EQ(input_mask.get_host_data<uint32_t>(), std::vector<uint32_t>({1, 1, 1, 1, 1, 1}));
+
+    EXPECT_EQ(mm_tensors->get_tensor("seq_ids").dtype(), DType::create<TensorIndex>());
+}
+
+TEST_F(TestPreprocessNLP, TestSequenceLengthBuckets)
+{
+    pybind11::gil_scoped_release no_gil;
+    auto test_data_dir               = test::get_morpheus_root() / "tests/tests_data";
+    std::filesystem::path input_file = test_data_dir / "countries_sample.csv";
+
+    auto test_vocab_hash_file_dir         = test::get_morpheus_root() / "morpheus/data";
+    std::filesystem::path vocab_hash_file = test_vocab_hash_file_dir / "bert-base-cased-hash.txt";
+
+    auto table = load_table_from_file(input_file);
+    auto meta  = MessageMeta::create_from_cpp(std::move(table));
+    auto mm    = std::make_shared<MultiMessage>(meta);
+
+    // The longest of the countries is two tokens long, fitting in the bucket of 4
+    auto mm_stage = std::make_shared<PreprocessNLPStageMM>(vocab_hash_file /*vocab_hash_file*/,
+                                                           16 /*sequence_length*/,
+                                                           true /*truncation*/,
+                                                           false /*do_lower_case*/,
+                                                           false /*add_special_token*/,
+                                                           16 /*stride*/,
+                                                           "country" /*column*/,
+                                                           true /*uint32_tokens*/,
+                                                           std::vector<TensorIndex>{8, 4} /*sequence_length_buckets*/);
+    auto mm_tensors = mm_stage->on_data(mm)->memory;
+
+    auto input_ids = mm_tensors->get_tensor("input_ids");
+    EXPECT_EQ(input_ids.get_shape(), ShapeType({5, 4}));
+    EXPECT_EQ(input_ids.get_host_data<uint32_t>(),
+              std::vector<uint32_t>(
+                  {6469, 0, 0, 0, 10278, 0, 0, 0, 11347, 0, 0, 0, 1262, 27583, 0, 0, 13833, 0, 0, 0}));
+
+    auto input_mask = mm_tensors->get_tensor("input_mask");
+    EXPECT_EQ(input_mask.get_shape(), ShapeType({5, 4}));
+    EXPECT_EQ(input_mask.get_host_data<uint32_t>(),
+              std::vector<uint32_t>({1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0}));
+
+    EXPECT_EQ(mm_tensors->get_tensor("seq_ids").shape(0), 5);
+
+    // Sequences longer than every bucket keep the full sequence length
+    auto full_stage = std::make_shared<PreprocessNLPStageMM>(vocab_hash_file /*vocab_hash_file*/,
+                                                             16 /*sequence_length*/,
+                                                             true /*truncation*/,
+                                                             false /*do_lower_case*/,
+                                                             false /*add_special_token*/,
+                                                             16 /*stride*/,
+                                                             "country" /*column*/,
+                                                             false /*uint32_tokens*/,
+                                                             std::vector<TensorIndex>{1} /*sequence_length_buckets*/);
+    auto full_ids = full_stage->on_data(std::make_shared<MultiMessage>(meta))->memory->get_tensor("input_ids");
+    EXPECT_EQ(full_ids.get_shape(), ShapeType({5, 16}));
+    EXPECT_EQ(full_ids.dtype(), DType::create<int32_t>());
+}
+
+TEST_F(TestPreprocessNLP, TestBytePairTokenizer)
+{
+    pybind11::gil_scoped_release no_gil;
+    auto test_dir = std::filesystem::temp_directory_path() / "morpheus_test_byte_pair_tokenizer";
+    std::filesystem::create_directories(test_dir);
+
+    std::ofstream(test_dir / "merges.txt") << "#version: 0.2\nh e\nl l\nhe ll\nhell o\nĠ w\no r\nĠw or\n";
+    std::ofstream(test_dir / "vocab.json") << R"({"<unk>": 0, "hello": 1, "Ġwor": 2, "l": 3, "d": 4})";
+    std::ofstream(test_dir / "input.csv") << "data\nhello world\nhello\nhi\n";
+
+    auto tokenizer = std::make_shared<BytePairTokenizer>(test_dir / "merges.txt", test_dir / "vocab.json");
+
+    auto meta = MessageMeta::create_from_cpp(load_table_from_file(test_dir / "input.csv"));
+    auto mm   = std::make_shared<MultiMessage>(meta);
+
+    // The first string is encoded as "hello Ġwor l d", overflowing onto a second row starting two tokens later
+    auto mm_stage   = std::make_shared<PreprocessNLPStageMM>(tokenizer /*tokenizer*/,
+                                                           3 /*sequence_length*/,
+                                                           false /*truncation*/,
+                                                           false /*add_special_token*/,
+                                                           2 /*stride*/,
+                                                           "data" /*column*/,
+                                                           true /*uint32_tokens*/);
+    auto mm_tensors = mm_stage->on_data(mm)->memory;
+
+    EXPECT_EQ(mm_tensors->get_tensor("input_ids").get_host_data<uint32_t>(),
+              std::vector<uint32_t>({1, 2, 3, 3, 4, 0, 1, 0, 0, 0, 0, 0}));
+    EXPECT_EQ(mm_tensors->get_tensor("input_mask").get_host_data<uint32_t>(),
+              std::vector<uint32_t>({1, 1, 1, 1, 1, 0, 1, 0, 0, 1, 1, 0}));
+    EXPECT_EQ(mm_tensors->get_tensor("seq_ids").get_host_data<TensorIndex>(),
+              std::vector<TensorIndex>({0, 0, 2, 0, 1, 1, 1, 0, 0, 2, 0, 1}));
+
+    std::filesystem::remove_all(test_dir);
+}
+
+TEST_F(TestPreprocessNLP, TestDeduplicatingTokenizer)
+{
+    pybind11::gil_scoped_release no_gil;
+    auto test_dir = std::filesystem::temp_directory_path() / "morpheus_test_deduplicating_tokenizer";
+    std::filesystem::create_directories(test_dir);
+
+    std::ofstream(test_dir / "merges.txt") << "#version: 0.2\nh e\nl l\nhe ll\nhell o\nĠ w\no r\nĠw or\n";
+    std::ofstream(test_dir / "vocab.json") << R"({"<unk>": 0, "hello": 1, "Ġwor": 2, "l": 3, "d": 4})";
+    std::ofstream(test_dir / "input.csv") << "data\nhello world\nhi\nhello world\nhello\nhi\nhello world\n";
+
+    auto tokenizer = std::make_shared<BytePairTokenizer>(test_dir / "merges.txt", test_dir / "vocab.json");
+
+    auto meta = MessageMeta::create_from_cpp(load_table_from_file(test_dir / "input.csv"));
+    auto mm   = std::make_shared<MultiMessage>(meta);
+
+    auto make_stage = [](std::shared_ptr<ITokenizer> stage_tokenizer) {
+        return std::make_shared<PreprocessNLPStageMM>(std::move(stage_tokenizer) /*tokenizer*/,
+                                                      3 /*sequence_length*/,
+                                                      false /*truncation*/,
+                                                      false /*add_special_token*/,
+                                                      2 /*stride*/,
+                                                      "data" /*column*/,
+                                                      true /*uint32_tokens*/);
+    };
+
+    // Duplicated strings, including the one overflowing onto a second row, are given the rows of their first copy
+    auto expected = make_stage(tokenizer)->on_data(mm)->memory;
+    auto deduped  = make_stage(std::make_shared<DeduplicatingTokenizer>(tokenizer))->on_data(mm)->memory;
+
+    EXPECT_EQ(deduped->count, expected->count);
+    for (const auto* name : {"input_ids", "input_mask"})
+    {
+        EXPECT_EQ(deduped->get_tensor(name).get_host_data<uint32_t>(),
+                  expected->get_tensor(name).get_host_data<uint32_t>());
+    }
+    EXPECT_EQ(deduped->get_tensor("seq_ids").get_host_data<TensorIndex>(),
+              expected->get_tensor("seq_ids").get_host_data<TensorIndex>());
+
+    EXPECT_THROW(DeduplicatingTokenizer(nullptr), std::invalid_argument);
+
+    std::filesystem::remove_all(test_dir);
+}
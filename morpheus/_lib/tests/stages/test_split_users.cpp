@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "../test_utils/common.hpp"        // for TEST_CLASS_WITH_PYTHON, morpheus
+#include "../test_utils/tensor_utils.hpp"  // for convert_to_host
+
+#include "morpheus/io/deserializers.hpp"    // for load_table_from_file
+#include "morpheus/messages/meta.hpp"       // for MessageMeta
+#include "morpheus/stages/split_users.hpp"  // for split_by_user
+
+#include <gtest/gtest.h>   // for EXPECT_EQ, EXPECT_THROW, TEST_F
+#include <pybind11/gil.h>  // for gil_scoped_release
+
+#include <algorithm>   // for sort
+#include <cstdint>     // for int64_t
+#include <filesystem>  // for operator/, path, temp_directory_path
+#include <fstream>     // for ofstream
+#include <memory>      // for shared_ptr
+#include <stdexcept>   // for invalid_argument
+#include <string>      // for string
+#include <vector>      // for vector
+
+using namespace morpheus;
+
+namespace {
+std::shared_ptr<MessageMeta> load_users()
+{
+    auto test_file = std::filesystem::temp_directory_path() / "morpheus_test_split_users.csv";
+    std::ofstream(test_file) << "user,value\nbob,0\nalice,1\nbob,2\ncarol,3\nalice,4\n";
+
+    return MessageMeta::create_from_cpp(load_table_from_file(test_file));
+}
+
+std::vector<int64_t> sorted_values_of(const std::shared_ptr<MessageMeta>& meta)
+{
+    auto values = test::convert_to_host<int64_t>(meta->get_info().get_column(1));
+    std::sort(values.begin(), values.end());
+    return values;
+}
+}  // namespace
+
+TEST_CLASS_WITH_PYTHON(SplitUsers);
+
+TEST_F(TestSplitUsers, SplitByUser)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    auto splits = split_by_user(load_users(), "user");
+
+    ASSERT_EQ(splits.size(), 3);
+    EXPECT_EQ(splits[0].first, "alice");
+    EXPECT_EQ(splits[1].first, "bob");
+    EXPECT_EQ(splits[2].first, "carol");
+
+    EXPECT_EQ(sorted_values_of(splits[0].second), (std::vector<int64_t>{1, 4}));
+    EXPECT_EQ(sorted_values_of(splits[1].second), (std::vector<int64_t>{0, 2}));
+    EXPECT_EQ(sorted_values_of(splits[2].second), (std::vector<int64_t>{3}));
+
+    for (const auto& [user_id, meta] : splits)
+    {
+        EXPECT_EQ(meta->get_column_names(), (std::vector<std::string>{"user", "value"}));
+    }
+}
+
+TEST_F(TestSplitUsers, InvalidUserColumn)
+{
+    pybind11::gil_scoped_release no_gil;
+
+    auto meta = load_users();
+
+    EXPECT_THROW(split_by_user(meta, "missing"), std::invalid_argument);
+    EXPECT_THROW(split_by_user(meta, "value"), std::invalid_argument);
+}
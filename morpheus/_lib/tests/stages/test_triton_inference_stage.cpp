@@ -25,6 +25,7 @@
 #include "morpheus/objects/tensor.hpp"
 #include "morpheus/objects/tensor_object.hpp"
 #include "morpheus/stages/inference_client_stage.hpp"
+#include "morpheus/stages/multi_endpoint_triton_client.hpp"
 #include "morpheus/stages/triton_inference.hpp"
 #include "morpheus/types.hpp"
 #include "morpheus/utilities/cudf_util.hpp"
@@ -45,14 +46,17 @@
 #include <rmm/cuda_stream_view.hpp>
 #include <rmm/device_buffer.hpp>
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
 #include <numeric>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 class FakeInferResult : public triton::client::InferResult
 {
@@ -66,7 +70,7 @@ class FakeInferResult : public triton::client::InferResult
 
     triton::client::Error RequestStatus() const override
     {
-        throw std::runtime_error("RequestStatus not implemented");
+        return triton::client::Error::Success;
     }
 
     std::string DebugString() const override
@@ -128,8 +132,20 @@ class FakeTritonClient : public morpheus::ITritonClient
     bool m_model_config_has_errored    = false;
     bool m_model_metadata_has_errored  = false;
     bool m_async_infer_has_errored     = false;
+    int m_num_model_metadata_calls     = 0;
+    int m_num_infer_requests           = 0;
 
   public:
+    int num_model_metadata_calls() const
+    {
+        return m_num_model_metadata_calls;
+    }
+
+    int num_infer_requests() const
+    {
+        return m_num_infer_requests;
+    }
+
     triton::client::Error is_server_live(bool* live) override
     {
         if (not m_is_server_live_has_errored)
@@ -201,6 +217,8 @@ class FakeTritonClient : public morpheus::ITritonClient
 
     triton::client::Error model_metadata(std::string* model_metadata, std::string& model_name) override
     {
+        m_num_model_metadata_calls++;
+
         if (not m_model_metadata_has_errored)
         {
             m_model_metadata_has_errored = true;
@@ -237,12 +255,75 @@ class FakeTritonClient : public morpheus::ITritonClient
             return triton::client::Error("async_infer error");
         }
 
+        m_num_infer_requests++;
+
         callback(new FakeInferResult({{"seq_ids", std::vector<int32_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9})}}));
 
         return triton::client::Error::Success;
     }
 };
 
+class UnavailableTritonClient : public FakeTritonClient
+{
+  public:
+    int num_async_infer_calls = 0;
+
+    triton::client::Error async_infer(triton::client::InferenceServerHttpClient::OnCompleteFn callback,
+                                      const triton::client::InferOptions& options,
+                                      const std::vector<morpheus::TritonInferInput>& inputs,
+                                      const std::vector<morpheus::TritonInferRequestedOutput>& outputs) override
+    {
+        num_async_infer_calls++;
+
+        return triton::client::Error("server unavailable");
+    }
+};
+
+// Holds each request until `complete_in_reverse` is called, responding with its `seq_ids` input
+class DeferredTritonClient : public FakeTritonClient
+{
+  private:
+    std::vector<std::pair<triton::client::InferenceServerHttpClient::OnCompleteFn, std::vector<int32_t>>> m_pending;
+
+  public:
+    triton::client::Error model_config(std::string* model_config, std::string& model_name) override
+    {
+        *model_config = R"({
+            "max_batch_size": 4
+        })";
+
+        return triton::client::Error::Success;
+    }
+
+    triton::client::Error async_infer(triton::client::InferenceServerHttpClient::OnCompleteFn callback,
+                                      const triton::client::InferOptions& options,
+                                      const std::vector<morpheus::TritonInferInput>& inputs,
+                                      const std::vector<morpheus::TritonInferRequestedOutput>& outputs) override
+    {
+        const auto& data = inputs.at(0).data;
+        const auto* rows = reinterpret_cast<const int32_t*>(data->data());
+        m_pending.emplace_back(std::move(callback), std::vector<int32_t>(rows, rows + data->size() / sizeof(int32_t)));
+
+        return triton::client::Error::Success;
+    }
+
+    std::size_t num_pending() const
+    {
+        return m_pending.size();
+    }
+
+    void complete_in_reverse()
+    {
+        auto pending = std::move(m_pending);
+        m_pending.clear();
+
+        for (auto it = pending.rbegin(); it != pending.rend(); ++it)
+        {
+            it->first(new FakeInferResult({{"seq_ids", std::move(it->second)}}));
+        }
+    }
+};
+
 class TestTritonInferenceStage : public morpheus::test::TestWithPythonInterpreter
 {
   protected:
@@ -341,3 +422,374 @@ TEST_F(TestTritonInferenceStage, SingleRow)
 
     ASSERT_EQ(results.size(), 1);
 }
+
+TEST_F(TestTritonInferenceStage, DynamicBatching)
+{
+    const auto dtype = morpheus::DType::create<int>();
+
+    auto create_message = [&](int start, std::size_t count) {
+        auto buffer = std::make_shared<rmm::device_buffer>(count * dtype.item_size(), rmm::cuda_stream_per_thread);
+        std::vector<int> seq_ids(count);
+        std::iota(seq_ids.begin(), seq_ids.end(), start);
+        cudaMemcpy(buffer->data(), seq_ids.data(), count * sizeof(int), cudaMemcpyKind::cudaMemcpyHostToDevice);
+
+        auto tensors = morpheus::TensorMap();
+        tensors["seq_ids"].swap(morpheus::Tensor::create(buffer, dtype, {count, 1}, {}));
+
+        auto memory = std::make_shared<morpheus::TensorMemory>(count, std::move(tensors));
+        auto meta   = morpheus::MessageMeta::create_from_cpp(create_test_table_with_metadata(count), 1);
+        return std::make_shared<morpheus::MultiInferenceMessage>(meta, 0, count, memory);
+    };
+
+    auto run = [](auto& stage, auto message, auto on)
+        -> mrc::coroutines::Task<std::vector<std::shared_ptr<morpheus::MultiResponseMessage>>> {
+        std::vector<std::shared_ptr<morpheus::MultiResponseMessage>> results;
+
+        auto responses_generator = stage.on_data(std::move(message), on);
+
+        auto iter = co_await responses_generator.begin();
+
+        while (iter != responses_generator.end())
+        {
+            results.emplace_back(std::move(*iter));
+
+            co_await ++iter;
+        }
+
+        co_return results;
+    };
+
+    // The fake client always responds with 10 rows, so only a merged request of both messages matches its inputs
+    auto triton_client           = std::make_unique<FakeTritonClient>();
+    auto triton_inference_client = std::make_unique<morpheus::TritonInferenceClient>(std::move(triton_client), "");
+    auto stage                   = morpheus::InferenceClientStage(
+        std::move(triton_inference_client), "", false, {}, {}, false, 10, std::chrono::milliseconds(1));
+
+    auto on = std::make_shared<mrc::coroutines::TestScheduler>();
+
+    // A full message is sent on its own, working through each of the errors of the fake client
+    auto warmup_task = run(stage, create_message(0, 10), on);
+    warmup_task.resume();
+    while (on->resume_next()) {}
+    ASSERT_NO_THROW(warmup_task.promise().result());
+
+    // The first message waits for the second, which fills the batch and sends it
+    auto first_task  = run(stage, create_message(0, 5), on);
+    auto second_task = run(stage, create_message(5, 5), on);
+    first_task.resume();
+    second_task.resume();
+    while (on->resume_next()) {}
+
+    ASSERT_NO_THROW(first_task.promise().result());
+    ASSERT_NO_THROW(second_task.promise().result());
+
+    auto first_results  = first_task.promise().result();
+    auto second_results = second_task.promise().result();
+
+    ASSERT_EQ(first_results.size(), 1);
+    ASSERT_EQ(second_results.size(), 1);
+    EXPECT_EQ(first_results[0]->mess_count, 5);
+    EXPECT_EQ(second_results[0]->mess_count, 5);
+
+    EXPECT_EQ(first_results[0]->get_output("seq_ids").get_host_data<int32_t>(), std::vector<int32_t>({0, 1, 2, 3, 4}));
+    EXPECT_EQ(second_results[0]->get_output("seq_ids").get_host_data<int32_t>(),
+              std::vector<int32_t>({5, 6, 7, 8, 9}));
+}
+
+TEST_F(TestTritonInferenceStage, CachesResults)
+{
+    const auto dtype = morpheus::DType::create<int>();
+
+    auto create_message = [&](int start, std::size_t count) {
+        auto buffer = std::make_shared<rmm::device_buffer>(count * dtype.item_size(), rmm::cuda_stream_per_thread);
+        std::vector<int> seq_ids(count);
+        std::iota(seq_ids.begin(), seq_ids.end(), start);
+        cudaMemcpy(buffer->data(), seq_ids.data(), count * sizeof(int), cudaMemcpyKind::cudaMemcpyHostToDevice);
+
+        auto tensors = morpheus::TensorMap();
+        tensors["seq_ids"].swap(morpheus::Tensor::create(buffer, dtype, {count, 1}, {}));
+
+        auto memory = std::make_shared<morpheus::TensorMemory>(count, std::move(tensors));
+        auto meta   = morpheus::MessageMeta::create_from_cpp(create_test_table_with_metadata(count), 1);
+        return std::make_shared<morpheus::MultiInferenceMessage>(meta, 0, count, memory);
+    };
+
+    auto run = [](auto& stage, auto message, auto on)
+        -> mrc::coroutines::Task<std::vector<std::shared_ptr<morpheus::MultiResponseMessage>>> {
+        std::vector<std::shared_ptr<morpheus::MultiResponseMessage>> results;
+
+        auto responses_generator = stage.on_data(std::move(message), on);
+
+        auto iter = co_await responses_generator.begin();
+
+        while (iter != responses_generator.end())
+        {
+            results.emplace_back(std::move(*iter));
+
+            co_await ++iter;
+        }
+
+        co_return results;
+    };
+
+    auto triton_client           = std::make_unique<FakeTritonClient>();
+    auto* client                 = triton_client.get();
+    auto triton_inference_client = std::make_unique<morpheus::TritonInferenceClient>(std::move(triton_client), "");
+    auto stage                   = morpheus::InferenceClientStage(
+        std::move(triton_inference_client), "", false, {}, {}, false, 0, std::chrono::milliseconds(1), 1, 100);
+
+    auto on = std::make_shared<mrc::coroutines::TestScheduler>();
+
+    // Every row of the first message misses, caching the responses of the fake client
+    auto warmup_task = run(stage, create_message(0, 10), on);
+    warmup_task.resume();
+    while (on->resume_next()) {}
+    ASSERT_NO_THROW(warmup_task.promise().result());
+
+    auto num_infer_requests = client->num_infer_requests();
+
+    // The rows of the second message were all seen before, so it is answered without a request
+    auto cached_task = run(stage, create_message(5, 5), on);
+    cached_task.resume();
+    while (on->resume_next()) {}
+    ASSERT_NO_THROW(cached_task.promise().result());
+
+    auto results = cached_task.promise().result();
+
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0]->get_output("seq_ids").get_host_data<int32_t>(), std::vector<int32_t>({5, 6, 7, 8, 9}));
+    EXPECT_EQ(client->num_infer_requests(), num_infer_requests);
+}
+
+TEST_F(TestTritonInferenceStage, FansOutModels)
+{
+    const auto dtype        = morpheus::DType::create<int>();
+    const std::size_t count = 10;
+
+    auto buffer = std::make_shared<rmm::device_buffer>(count * dtype.item_size(), rmm::cuda_stream_per_thread);
+    std::vector<int> seq_ids(count);
+    std::iota(seq_ids.begin(), seq_ids.end(), 0);
+    cudaMemcpy(buffer->data(), seq_ids.data(), count * sizeof(int), cudaMemcpyKind::cudaMemcpyHostToDevice);
+
+    auto tensors = morpheus::TensorMap();
+    tensors["seq_ids"].swap(morpheus::Tensor::create(buffer, dtype, {count, 1}, {}));
+
+    auto memory  = std::make_shared<morpheus::TensorMemory>(count, std::move(tensors));
+    auto meta    = morpheus::MessageMeta::create_from_cpp(create_test_table_with_metadata(count), 1);
+    auto message = std::make_shared<morpheus::MultiInferenceMessage>(meta, 0, count, memory);
+
+    auto create_model = [](std::string output_name) {
+        auto triton_inference_client =
+            std::make_unique<morpheus::TritonInferenceClient>(std::make_unique<FakeTritonClient>(), "");
+        return std::make_unique<morpheus::InferenceClientStage>(std::move(triton_inference_client),
+                                                                "",
+                                                                false,
+                                                                std::vector<morpheus::TensorModelMapping>{},
+                                                                std::vector<morpheus::TensorModelMapping>{
+                                                                    {"seq_ids", std::move(output_name)}});
+    };
+
+    std::vector<std::unique_ptr<morpheus::InferenceClientStage>> models;
+    models.emplace_back(create_model("first_ids"));
+    models.emplace_back(create_model("second_ids"));
+    auto stage = morpheus::FanOutInferenceClientStage(std::move(models));
+
+    auto on           = std::make_shared<mrc::coroutines::TestScheduler>();
+    auto results_task = [](auto& stage, auto message, auto on)
+        -> mrc::coroutines::Task<std::vector<std::shared_ptr<morpheus::MultiResponseMessage>>> {
+        std::vector<std::shared_ptr<morpheus::MultiResponseMessage>> results;
+
+        auto responses_generator = stage.on_data(std::move(message), on);
+
+        auto iter = co_await responses_generator.begin();
+
+        while (iter != responses_generator.end())
+        {
+            results.emplace_back(std::move(*iter));
+
+            co_await ++iter;
+        }
+
+        co_return results;
+    }(stage, message, on);
+
+    results_task.resume();
+
+    while (on->resume_next()) {}
+
+    ASSERT_NO_THROW(results_task.promise().result());
+
+    auto results = results_task.promise().result();
+
+    // The outputs of both models are merged into a single response
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0]->mess_count, 10);
+    EXPECT_EQ(results[0]->get_output("first_ids").get_host_data<int32_t>(), seq_ids);
+    EXPECT_EQ(results[0]->get_output("second_ids").get_host_data<int32_t>(), seq_ids);
+}
+
+TEST_F(TestTritonInferenceStage, CachesModelInfo)
+{
+    auto triton_client = std::make_unique<FakeTritonClient>();
+    auto* fake_client  = triton_client.get();
+
+    auto triton_inference_client = morpheus::TritonInferenceClient(std::move(triton_client), "");
+
+    // Works through each of the errors of the fake client
+    std::unique_ptr<morpheus::IInferenceClientSession> session;
+    while (session == nullptr)
+    {
+        try
+        {
+            session = triton_inference_client.create_session();
+        } catch (const std::exception&)
+        {}
+    }
+
+    auto num_model_metadata_calls = fake_client->num_model_metadata_calls();
+
+    // Later sessions, such as those replacing a session which failed, reuse the model info
+    auto second_session = triton_inference_client.create_session();
+
+    EXPECT_EQ(fake_client->num_model_metadata_calls(), num_model_metadata_calls);
+    EXPECT_EQ(second_session->get_input_mappings({}).size(), session->get_input_mappings({}).size());
+}
+
+TEST_F(TestTritonInferenceStage, ResumesOnScheduler)
+{
+    const std::size_t count = 10;
+    const auto dtype        = morpheus::DType::create<int>();
+
+    auto create_inputs = [&]() {
+        auto buffer = std::make_shared<rmm::device_buffer>(count * dtype.item_size(), rmm::cuda_stream_per_thread);
+        std::vector<int> seq_ids(count);
+        std::iota(seq_ids.begin(), seq_ids.end(), 0);
+        cudaMemcpy(buffer->data(), seq_ids.data(), count * sizeof(int), cudaMemcpyKind::cudaMemcpyHostToDevice);
+
+        auto tensors = morpheus::TensorMap();
+        tensors["seq_ids"].swap(morpheus::Tensor::create(buffer, dtype, {count, 1}, {}));
+        return tensors;
+    };
+
+    auto triton_inference_client = morpheus::TritonInferenceClient(std::make_unique<FakeTritonClient>(), "");
+
+    // Works through each of the errors of the fake client
+    std::unique_ptr<morpheus::IInferenceClientSession> session;
+    while (session == nullptr)
+    {
+        try
+        {
+            session = triton_inference_client.create_session();
+        } catch (const std::exception&)
+        {}
+    }
+
+    auto on = std::make_shared<mrc::coroutines::TestScheduler>();
+
+    auto warmup_task = session->infer(create_inputs(), on);
+    warmup_task.resume();
+    while (on->resume_next()) {}
+    EXPECT_ANY_THROW(warmup_task.promise().result());
+
+    // The fake client completes the request before returning, the session only continues once the scheduler runs it
+    auto task = session->infer(create_inputs(), on);
+    task.resume();
+    EXPECT_FALSE(task.is_ready());
+
+    while (on->resume_next()) {}
+    ASSERT_TRUE(task.is_ready());
+    ASSERT_NO_THROW(task.promise().result());
+
+    EXPECT_EQ(task.promise().result().at("seq_ids").get_host_data<int32_t>(),
+              std::vector<int32_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST_F(TestTritonInferenceStage, FailsOverAndEjectsEndpoints)
+{
+    auto unavailable_client = std::make_unique<UnavailableTritonClient>();
+    auto* unavailable       = unavailable_client.get();
+
+    std::vector<std::unique_ptr<morpheus::ITritonClient>> endpoints;
+    endpoints.emplace_back(std::move(unavailable_client));
+    endpoints.emplace_back(std::make_unique<FakeTritonClient>());
+
+    auto client = morpheus::MultiEndpointTritonClient(std::move(endpoints), false, 2);
+
+    auto options = triton::client::InferOptions("");
+    int num_results = 0;
+
+    auto infer = [&]() {
+        return client.async_infer(
+            [&](triton::client::InferResult* result) {
+                num_results++;
+                delete result;
+            },
+            options,
+            {},
+            {});
+    };
+
+    // Works through the first error of the fake client, the last requests are all failed over to it
+    for (int i = 0; i < 5; i++)
+    {
+        infer();
+    }
+
+    auto num_unavailable_calls = unavailable->num_async_infer_calls;
+
+    EXPECT_TRUE(infer().IsOk());
+    EXPECT_EQ(num_results, 5);
+
+    // Once ejected, the unavailable endpoint is no longer sent requests
+    EXPECT_EQ(client.num_ejected_endpoints(), 1);
+    EXPECT_EQ(unavailable->num_async_infer_calls, num_unavailable_calls);
+}
+
+TEST_F(TestTritonInferenceStage, ConcurrentBatchesFillTheirOwnRows)
+{
+    const std::size_t count = 10;
+    const auto dtype        = morpheus::DType::create<int>();
+
+    auto buffer = std::make_shared<rmm::device_buffer>(count * dtype.item_size(), rmm::cuda_stream_per_thread);
+    std::vector<int> seq_ids(count);
+    std::iota(seq_ids.begin(), seq_ids.end(), 0);
+    cudaMemcpy(buffer->data(), seq_ids.data(), count * sizeof(int), cudaMemcpyKind::cudaMemcpyHostToDevice);
+
+    auto tensors = morpheus::TensorMap();
+    tensors["seq_ids"].swap(morpheus::Tensor::create(buffer, dtype, {count, 1}, {}));
+
+    auto triton_client    = std::make_unique<DeferredTritonClient>();
+    auto* deferred_client = triton_client.get();
+
+    auto triton_inference_client = morpheus::TritonInferenceClient(std::move(triton_client), "", 3);
+
+    // Works through each of the errors of the fake client
+    std::unique_ptr<morpheus::IInferenceClientSession> session;
+    while (session == nullptr)
+    {
+        try
+        {
+            session = triton_inference_client.create_session();
+        } catch (const std::exception&)
+        {}
+    }
+
+    auto on   = std::make_shared<mrc::coroutines::TestScheduler>();
+    auto task = session->infer(std::move(tensors), on);
+    task.resume();
+    while (on->resume_next()) {}
+
+    // The mini-batches of 4, 4 and 2 rows are all in flight at once
+    EXPECT_EQ(deferred_client->num_pending(), 3);
+    EXPECT_FALSE(task.is_ready());
+
+    // Responses arriving in any order are copied into the rows of their own mini-batch
+    deferred_client->complete_in_reverse();
+    while (on->resume_next()) {}
+
+    ASSERT_TRUE(task.is_ready());
+    ASSERT_NO_THROW(task.promise().result());
+
+    EXPECT_EQ(task.promise().result().at("seq_ids").get_host_data<int32_t>(),
+              std::vector<int32_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"        // IWYU pragma: associated
+#include "../test_utils/tensor_utils.hpp"  // for convert_to_host
+
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/stages/window_aggregate.hpp"
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_view.hpp>  // for bit_cast
+#include <cudf/io/types.hpp>            // for table_with_metadata
+#include <cudf/table/table.hpp>
+#include <gtest/gtest.h>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <chrono>   // for seconds
+#include <cstdint>  // for int64_t
+#include <memory>
+#include <stdexcept>  // for invalid_argument
+#include <string>
+#include <utility>  // for move
+#include <vector>
+
+using namespace morpheus;
+using namespace std::chrono_literals;
+
+namespace {
+constexpr int64_t Second = 1'000'000'000;
+
+std::unique_ptr<cudf::column> make_column(cudf::type_id type, const std::vector<int64_t>& values)
+{
+    rmm::device_buffer buffer(values.data(), values.size() * sizeof(int64_t), rmm::cuda_stream_per_thread);
+    rmm::cuda_stream_per_thread.synchronize();
+
+    return std::make_unique<cudf::column>(
+        cudf::data_type{type}, static_cast<cudf::size_type>(values.size()), std::move(buffer), rmm::device_buffer{}, 0);
+}
+
+// Rows with `user` and `bytes` columns, and a `timestamp` column of `seconds`
+std::shared_ptr<MessageMeta> make_rows(const std::vector<int64_t>& users,
+                                       const std::vector<int64_t>& bytes,
+                                       const std::vector<int64_t>& seconds)
+{
+    std::vector<int64_t> timestamps;
+    for (const auto value : seconds)
+    {
+        timestamps.push_back(value * Second);
+    }
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    columns.push_back(make_column(cudf::type_id::INT64, users));
+    columns.push_back(make_column(cudf::type_id::INT64, bytes));
+    columns.push_back(make_column(cudf::type_id::TIMESTAMP_NANOSECONDS, timestamps));
+
+    cudf::io::table_with_metadata table{std::make_unique<cudf::table>(std::move(columns))};
+    table.metadata.schema_info.emplace_back("user");
+    table.metadata.schema_info.emplace_back("bytes");
+    table.metadata.schema_info.emplace_back("timestamp");
+
+    return MessageMeta::create_from_cpp(std::move(table));
+}
+
+std::vector<int64_t> int64_values(const std::shared_ptr<MessageMeta>& meta, cudf::size_type index)
+{
+    return test::convert_to_host<int64_t>(
+        cudf::bit_cast(meta->get_info().get_column(index), cudf::data_type{cudf::type_id::INT64}));
+}
+
+// Window starts in seconds
+std::vector<int64_t> window_starts(const std::shared_ptr<MessageMeta>& meta)
+{
+    auto starts = int64_values(meta, 1);
+    for (auto& start : starts)
+    {
+        start /= Second;
+    }
+
+    return starts;
+}
+}  // namespace
+
+TEST_CLASS(WindowAggregate);
+
+TEST_F(TestWindowAggregate, TumblingWindows)
+{
+    WindowAggregator aggregator({"user"}, "timestamp", {{"bytes", {"sum", "mean"}}}, 60s, 60s, 0s);
+
+    // The watermark has not passed the end of the first window
+    EXPECT_EQ(aggregator.update(make_rows({1, 1, 2}, {10, 20, 5}, {0, 30, 45})->get_info()), 0);
+    EXPECT_EQ(aggregator.take_closed(), nullptr);
+    EXPECT_EQ(aggregator.num_open(), 2);
+    EXPECT_EQ(aggregator.watermark().value(), 45 * Second);
+
+    EXPECT_EQ(aggregator.update(make_rows({1, 2}, {7, 3}, {61, 130})->get_info()), 0);
+    auto closed = aggregator.take_closed();
+    ASSERT_NE(closed, nullptr);
+    EXPECT_EQ(closed->get_column_names(),
+              (std::vector<std::string>{"user", "window_start", "window_end", "count", "bytes_sum", "bytes_mean"}));
+
+    // Ordered by window, then by key
+    EXPECT_EQ(int64_values(closed, 0), (std::vector<int64_t>{1, 2, 1}));
+    EXPECT_EQ(window_starts(closed), (std::vector<int64_t>{0, 0, 60}));
+    EXPECT_EQ(int64_values(closed, 3), (std::vector<int64_t>{2, 1, 1}));
+    EXPECT_EQ(int64_values(closed, 4), (std::vector<int64_t>{30, 5, 7}));
+    EXPECT_EQ(test::convert_to_host<double>(closed->get_info().get_column(5)), (std::vector<double>{15, 5, 7}));
+    EXPECT_EQ(aggregator.num_open(), 1);
+
+    // Rows of closed windows are late
+    EXPECT_EQ(aggregator.update(make_rows({1, 2}, {1, 1}, {10, 125})->get_info()), 1);
+    EXPECT_EQ(aggregator.take_closed(), nullptr);
+
+    auto flushed = aggregator.take_closed(true);
+    ASSERT_NE(flushed, nullptr);
+    EXPECT_EQ(int64_values(flushed, 0), (std::vector<int64_t>{2}));
+    EXPECT_EQ(window_starts(flushed), (std::vector<int64_t>{120}));
+    EXPECT_EQ(int64_values(flushed, 4), (std::vector<int64_t>{4}));
+    EXPECT_EQ(aggregator.num_open(), 0);
+}
+
+TEST_F(TestWindowAggregate, SlidingWindowsAndLateness)
+{
+    WindowAggregator aggregator({"user"}, "timestamp", {{"bytes", {"max"}}}, 60s, 30s, 30s);
+
+    // Each row belongs to two windows
+    aggregator.update(make_rows({1}, {4}, {45})->get_info());
+    EXPECT_EQ(aggregator.num_open(), 2);
+
+    // The watermark trails by 30 seconds, closing the window starting at 0 only
+    aggregator.update(make_rows({1}, {9}, {95})->get_info());
+    auto closed = aggregator.take_closed();
+    ASSERT_NE(closed, nullptr);
+    EXPECT_EQ(window_starts(closed), (std::vector<int64_t>{0}));
+    EXPECT_EQ(int64_values(closed, 4), (std::vector<int64_t>{4}));
+
+    // Within the allowed lateness, the row still counts in its open window
+    EXPECT_EQ(aggregator.update(make_rows({1}, {2}, {50})->get_info()), 0);
+
+    auto flushed = aggregator.take_closed(true);
+    ASSERT_NE(flushed, nullptr);
+    EXPECT_EQ(window_starts(flushed), (std::vector<int64_t>{30, 60, 90}));
+    EXPECT_EQ(int64_values(flushed, 3), (std::vector<int64_t>{2, 1, 1}));
+    EXPECT_EQ(int64_values(flushed, 4), (std::vector<int64_t>{4, 9, 9}));
+}
+
+TEST_F(TestWindowAggregate, InvalidArguments)
+{
+    EXPECT_THROW(WindowAggregator({}, "timestamp", {}, 60s, 60s, 0s), std::invalid_argument);
+    EXPECT_THROW(WindowAggregator({"user"}, "timestamp", {{"bytes", {"median"}}}, 60s, 60s, 0s),
+                 std::invalid_argument);
+    EXPECT_THROW(WindowAggregator({"user"}, "timestamp", {}, 60s, 7s, 0s), std::invalid_argument);
+    EXPECT_THROW(WindowAggregator({"user"}, "timestamp", {}, 60s, 60s, -1s), std::invalid_argument);
+
+    WindowAggregator aggregator({"user"}, "missing", {}, 60s, 60s, 0s);
+    EXPECT_THROW(aggregator.update(make_rows({1}, {1}, {0})->get_info()), std::invalid_argument);
+}
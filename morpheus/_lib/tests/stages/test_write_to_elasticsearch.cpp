@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // for TEST_CLASS
+
+#include "morpheus/stages/write_to_elasticsearch.hpp"  // for make_bulk_requests, parse_bulk_response
+
+#include <gtest/gtest.h>  // for EXPECT_EQ, TEST_F
+
+#include <stdexcept>  // for runtime_error
+#include <string>
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(WriteToElasticsearch);
+
+namespace {
+const std::string ACTION = R"({"index":{}})";
+}  // namespace
+
+TEST_F(TestWriteToElasticsearch, BulkRequestsInterleaveActions)
+{
+    auto requests = make_bulk_requests("{\"a\":1}\n{\"a\":2}\n", ACTION, 1 << 20, 100);
+
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests[0].body, ACTION + "\n{\"a\":1}\n" + ACTION + "\n{\"a\":2}\n");
+    EXPECT_EQ(requests[0].num_items(), 2);
+}
+
+TEST_F(TestWriteToElasticsearch, BulkRequestsSplitByDocs)
+{
+    auto requests = make_bulk_requests("{\"a\":1}\n{\"a\":2}\n{\"a\":3}\n", ACTION, 1 << 20, 2);
+
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_EQ(requests[0].num_items(), 2);
+    EXPECT_EQ(requests[1].num_items(), 1);
+    EXPECT_EQ(requests[1].body, ACTION + "\n{\"a\":3}\n");
+}
+
+TEST_F(TestWriteToElasticsearch, BulkRequestsSplitByBytes)
+{
+    // Each item is 21 bytes, the action line and the document each followed by a newline
+    auto requests = make_bulk_requests("{\"a\":1}\n{\"a\":2}\n{\"a\":3}\n", ACTION, 50, 100);
+
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_EQ(requests[0].num_items(), 2);
+    EXPECT_EQ(requests[0].body.size(), 42);
+    EXPECT_EQ(requests[1].num_items(), 1);
+
+    // A document larger than the limit is sent on its own
+    requests = make_bulk_requests("{\"a\":1}\n{\"a\":2}", ACTION, 10, 100);
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_EQ(requests[1].body, ACTION + "\n{\"a\":2}\n");
+}
+
+TEST_F(TestWriteToElasticsearch, BulkRequestSubset)
+{
+    auto requests = make_bulk_requests("{\"a\":1}\n{\"a\":2}\n{\"a\":3}\n", ACTION, 1 << 20, 100);
+    ASSERT_EQ(requests.size(), 1);
+
+    auto subset = requests[0].subset({0, 2});
+    EXPECT_EQ(subset.num_items(), 2);
+    EXPECT_EQ(subset.body, ACTION + "\n{\"a\":1}\n" + ACTION + "\n{\"a\":3}\n");
+}
+
+TEST_F(TestWriteToElasticsearch, ParseBulkResponse)
+{
+    auto result = parse_bulk_response(R"({"took":3,"errors":false,"items":[{"index":{"status":201}}]})", 1);
+    EXPECT_TRUE(result.retry_items.empty());
+    EXPECT_EQ(result.num_failed, 0);
+
+    result = parse_bulk_response(R"({"took":3,"errors":true,"items":[
+        {"index":{"status":201}},
+        {"index":{"status":429,"error":{"type":"es_rejected_execution_exception"}}},
+        {"index":{"status":400,"error":{"type":"mapper_parsing_exception"}}},
+        {"index":{"status":503,"error":{"type":"unavailable_shards_exception"}}}]})",
+                                 4);
+
+    EXPECT_EQ(result.retry_items, (std::vector<std::size_t>{1, 3}));
+    EXPECT_EQ(result.num_failed, 1);
+    EXPECT_NE(result.first_error.find("mapper_parsing_exception"), std::string::npos);
+
+    EXPECT_THROW(parse_bulk_response(R"({"errors":true,"items":[{"index":{"status":429}}]})", 2), std::runtime_error);
+}
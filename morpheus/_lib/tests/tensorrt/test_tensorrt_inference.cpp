@@ -0,0 +1,237 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/dtype.hpp"
+#include "morpheus/objects/tensor.hpp"
+#include "morpheus/objects/tensor_object.hpp"
+#include "morpheus/stages/inference_client_stage.hpp"
+#include "morpheus/tensorrt/tensorrt_inference.hpp"
+#include "morpheus/types.hpp"
+
+#include <NvInfer.h>
+#include <NvInferVersion.h>
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <mrc/coroutines/task.hpp>
+#include <mrc/coroutines/test_scheduler.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+class TestLogger : public nvinfer1::ILogger
+{
+  public:
+    void log(Severity severity, const char* msg) noexcept override
+    {
+        if (severity <= Severity::kWARNING)
+        {
+            LOG(WARNING) << "TensorRT: " << msg;
+        }
+    }
+};
+
+const int32_t NUM_COLUMNS = 3;
+
+/**
+ * @brief Builds and writes an engine doubling its `input__0` into `output__0`, both of `NUM_COLUMNS` float columns.
+ * The optimization profile allows batches of up to `max_batch_size` rows.
+ */
+std::string write_engine(const std::string& name, nvinfer1::Dims input_dims, int32_t max_batch_size)
+{
+    TestLogger logger;
+
+    std::unique_ptr<nvinfer1::IBuilder> builder{nvinfer1::createInferBuilder(logger)};
+#if NV_TENSORRT_MAJOR >= 10
+    std::unique_ptr<nvinfer1::INetworkDefinition> network{builder->createNetworkV2(0)};
+#else
+    std::unique_ptr<nvinfer1::INetworkDefinition> network{builder->createNetworkV2(
+        1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH))};
+#endif
+
+    auto* input  = network->addInput("input__0", nvinfer1::DataType::kFLOAT, input_dims);
+    auto* output = network->addElementWise(*input, *input, nvinfer1::ElementWiseOperation::kSUM)->getOutput(0);
+    output->setName("output__0");
+    network->markOutput(*output);
+
+    std::unique_ptr<nvinfer1::IBuilderConfig> config{builder->createBuilderConfig()};
+
+    if (input_dims.d[0] == -1)
+    {
+        auto* profile = builder->createOptimizationProfile();
+        auto max_dims = input_dims;
+        max_dims.d[0] = max_batch_size;
+
+        auto min_dims = max_dims;
+        min_dims.d[0] = 1;
+
+        profile->setDimensions("input__0", nvinfer1::OptProfileSelector::kMIN, min_dims);
+        profile->setDimensions("input__0", nvinfer1::OptProfileSelector::kOPT, max_dims);
+        profile->setDimensions("input__0", nvinfer1::OptProfileSelector::kMAX, max_dims);
+        config->addOptimizationProfile(profile);
+    }
+
+    std::unique_ptr<nvinfer1::IHostMemory> serialized{builder->buildSerializedNetwork(*network, *config)};
+    if (serialized == nullptr)
+    {
+        throw std::runtime_error("Unable to build the test engine");
+    }
+
+    auto engine_file = std::filesystem::temp_directory_path() / ("morpheus_test_tensorrt_" + name + ".engine");
+    std::ofstream(engine_file, std::ios::binary)
+        .write(static_cast<const char*>(serialized->data()), static_cast<std::streamsize>(serialized->size()));
+
+    return engine_file.string();
+}
+
+morpheus::TensorObject make_input(const std::vector<float>& values)
+{
+    const auto dtype = morpheus::DType::create<float>();
+    auto rows        = static_cast<morpheus::TensorIndex>(values.size() / NUM_COLUMNS);
+
+    auto buffer = std::make_shared<rmm::device_buffer>(values.size() * dtype.item_size(), rmm::cuda_stream_per_thread);
+    cudaMemcpy(buffer->data(), values.data(), values.size() * sizeof(float), cudaMemcpyKind::cudaMemcpyHostToDevice);
+
+    return morpheus::Tensor::create(buffer, dtype, {rows, NUM_COLUMNS}, {});
+}
+
+morpheus::TensorMap infer(morpheus::IInferenceClientSession& session, morpheus::TensorMap&& inputs)
+{
+    auto on   = std::make_shared<mrc::coroutines::TestScheduler>();
+    auto task = session.infer(std::move(inputs), on);
+    task.resume();
+    while (on->resume_next()) {}
+
+    EXPECT_TRUE(task.is_ready());
+    auto outputs = task.promise().result();
+
+    rmm::cuda_stream_per_thread.synchronize();
+
+    return outputs;
+}
+}  // namespace
+
+TEST_CLASS(TensorRTInference);
+
+TEST_F(TestTensorRTInference, Mappings)
+{
+    auto engine_file = write_engine("mappings", nvinfer1::Dims2{-1, NUM_COLUMNS}, 2);
+    auto client      = morpheus::TensorRTInferenceClient(engine_file);
+    auto session     = client.create_session();
+
+    auto inputs = session->get_input_mappings({});
+    ASSERT_EQ(inputs.size(), 1u);
+    EXPECT_EQ(inputs[0].model_field_name, "input__0");
+    EXPECT_EQ(inputs[0].tensor_field_name, "input__0");
+
+    // An override of an output replaces its default mapping
+    auto outputs = session->get_output_mappings({{"output__0", "probs"}});
+    ASSERT_EQ(outputs.size(), 1u);
+    EXPECT_EQ(outputs[0].model_field_name, "output__0");
+    EXPECT_EQ(outputs[0].tensor_field_name, "probs");
+
+    std::filesystem::remove(engine_file);
+}
+
+TEST_F(TestTensorRTInference, AssemblesBatchedOutputs)
+{
+    auto engine_file = write_engine("batches", nvinfer1::Dims2{-1, NUM_COLUMNS}, 2);
+    auto client      = morpheus::TensorRTInferenceClient(engine_file);
+    auto session     = client.create_session();
+
+    // Five rows are enqueued as batches of 2, 2 and 1 rows, each written to its own rows of the output
+    std::vector<float> values(5 * NUM_COLUMNS);
+    std::vector<float> expected(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i]   = static_cast<float>(i);
+        expected[i] = 2.0F * values[i];
+    }
+
+    morpheus::TensorMap inputs;
+    inputs["input__0"].swap(make_input(values));
+
+    auto outputs = infer(*session, std::move(inputs));
+    ASSERT_EQ(outputs.size(), 1u);
+
+    const auto& output = outputs.at("output__0");
+    EXPECT_EQ(output.get_shape(), (morpheus::ShapeType{5, NUM_COLUMNS}));
+    EXPECT_EQ(output.get_host_data<float>(), expected);
+
+    // A later inference of fewer rows gets outputs of its own number of rows
+    morpheus::TensorMap single;
+    single["input__0"].swap(make_input({1.0F, 2.0F, 3.0F}));
+
+    auto single_outputs = infer(*session, std::move(single));
+    EXPECT_EQ(single_outputs.at("output__0").get_host_data<float>(), (std::vector<float>{2.0F, 4.0F, 6.0F}));
+
+    std::filesystem::remove(engine_file);
+}
+
+TEST_F(TestTensorRTInference, ConvertsInputTypes)
+{
+    auto engine_file = write_engine("convert", nvinfer1::Dims2{-1, NUM_COLUMNS}, 2);
+    auto client      = morpheus::TensorRTInferenceClient(engine_file);
+    auto session     = client.create_session();
+
+    const auto dtype = morpheus::DType::create<double>();
+    std::vector<double> values{0.5, 1.5, 2.5};
+
+    auto buffer = std::make_shared<rmm::device_buffer>(values.size() * dtype.item_size(), rmm::cuda_stream_per_thread);
+    cudaMemcpy(buffer->data(), values.data(), values.size() * sizeof(double), cudaMemcpyKind::cudaMemcpyHostToDevice);
+
+    // Inputs of another type are converted to the type of the engine's input
+    morpheus::TensorMap inputs;
+    inputs["input__0"].swap(morpheus::Tensor::create(buffer, dtype, {1, NUM_COLUMNS}, {}));
+
+    auto outputs = infer(*session, std::move(inputs));
+    EXPECT_EQ(outputs.at("output__0").get_host_data<float>(), (std::vector<float>{1.0F, 3.0F, 5.0F}));
+
+    std::filesystem::remove(engine_file);
+}
+
+TEST_F(TestTensorRTInference, ValidatesEngine)
+{
+    EXPECT_THROW(morpheus::TensorRTInferenceClient("/does/not/exist.engine"), std::runtime_error);
+
+    // A serialized engine is required
+    auto not_an_engine = std::filesystem::temp_directory_path() / "morpheus_test_tensorrt_invalid.engine";
+    std::ofstream(not_an_engine) << "not an engine";
+    EXPECT_THROW(morpheus::TensorRTInferenceClient(not_an_engine.string()), std::runtime_error);
+    std::filesystem::remove(not_an_engine);
+
+    // Inputs must have a dynamic batch dimension
+    auto fixed_batch = write_engine("fixed_batch", nvinfer1::Dims2{4, NUM_COLUMNS}, 4);
+    EXPECT_THROW(morpheus::TensorRTInferenceClient{fixed_batch}, std::runtime_error);
+    std::filesystem::remove(fixed_batch);
+
+    // Only tensors of 1 or 2 dimensions are supported
+    auto three_dims = write_engine("three_dims", nvinfer1::Dims3{-1, NUM_COLUMNS, 2}, 2);
+    EXPECT_THROW(morpheus::TensorRTInferenceClient{three_dims}, std::runtime_error);
+    std::filesystem::remove(three_dims);
+}
@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/cuda_graph_cache.hpp"
+
+#include <cuda_runtime.h>
+#include <gtest/gtest.h>
+#include <rmm/cuda_stream.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstdint>  // for uint8_t
+#include <stdexcept>
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+std::vector<uint8_t> to_host(const rmm::device_buffer& buffer, rmm::cuda_stream_view stream)
+{
+    std::vector<uint8_t> host(buffer.size());
+    cudaMemcpyAsync(host.data(), buffer.data(), buffer.size(), cudaMemcpyDeviceToHost, stream.value());
+    stream.synchronize();
+
+    return host;
+}
+}  // namespace
+
+TEST_CLASS(CudaGraphCache);
+
+TEST_F(TestCudaGraphCache, UpdatesCachedGraph)
+{
+    rmm::cuda_stream stream;
+    CudaGraphCache cache;
+
+    // The same topology with a different pointer and value updates the exec rather than instantiating a new one
+    for (uint8_t value : {1, 2})
+    {
+        rmm::device_buffer buffer(16, stream.view());
+        cache.launch("memset", stream.view(), [&](rmm::cuda_stream_view capture_stream) {
+            cudaMemsetAsync(buffer.data(), value, buffer.size(), capture_stream.value());
+        });
+
+        EXPECT_EQ(to_host(buffer, stream.view()), std::vector<uint8_t>(16, value));
+    }
+
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.num_instantiations(), 1);
+}
+
+TEST_F(TestCudaGraphCache, MaxEntries)
+{
+    rmm::cuda_stream stream;
+    CudaGraphCache cache(1);
+
+    rmm::device_buffer buffer(16, stream.view());
+    auto enqueue = [&](rmm::cuda_stream_view capture_stream) {
+        cudaMemsetAsync(buffer.data(), 0, buffer.size(), capture_stream.value());
+    };
+
+    cache.launch("first", stream.view(), enqueue);
+    cache.launch("second", stream.view(), enqueue);
+    stream.synchronize();
+
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.num_instantiations(), 2);
+}
+
+TEST_F(TestCudaGraphCache, EnqueueThrows)
+{
+    rmm::cuda_stream stream;
+    CudaGraphCache cache;
+
+    EXPECT_THROW(
+        cache.launch("throws", stream.view(), [](rmm::cuda_stream_view) { throw std::runtime_error("failed"); }),
+        std::runtime_error);
+
+    // The capture was ended, the stream is still usable
+    cudaStreamCaptureStatus status;
+    EXPECT_EQ(cudaStreamIsCapturing(stream.value(), &status), cudaSuccess);
+    EXPECT_EQ(status, cudaStreamCaptureStatusNone);
+    EXPECT_EQ(cache.size(), 0);
+}
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/utilities/cuda_util.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(CudaUtil);
+
+TEST_F(TestCudaUtil, DeviceGuardRestoresDevice)
+{
+    const auto previous = CudaUtil::current_device();
+    {
+        CudaDeviceGuard guard(CudaUtil::device_count() - 1);
+        EXPECT_EQ(CudaUtil::current_device(), CudaUtil::device_count() - 1);
+    }
+    EXPECT_EQ(CudaUtil::current_device(), previous);
+}
+
+TEST_F(TestCudaUtil, RoundRobinEmptyReturnsCurrentDevice)
+{
+    DeviceRoundRobin devices;
+    EXPECT_EQ(devices.next(), CudaUtil::current_device());
+    EXPECT_EQ(devices.next(), CudaUtil::current_device());
+}
+
+TEST_F(TestCudaUtil, RoundRobinCyclesDevices)
+{
+    std::vector<int> device_ids;
+    for (int device_id = 0; device_id < CudaUtil::device_count(); ++device_id)
+    {
+        device_ids.push_back(device_id);
+    }
+
+    DeviceRoundRobin devices(device_ids);
+    for (int i = 0; i < 2 * CudaUtil::device_count(); ++i)
+    {
+        EXPECT_EQ(devices.next(), i % CudaUtil::device_count());
+    }
+}
+
+TEST_F(TestCudaUtil, RoundRobinRejectsInvalidDevice)
+{
+    EXPECT_THROW(DeviceRoundRobin({CudaUtil::device_count()}), std::invalid_argument);
+    EXPECT_THROW(DeviceRoundRobin({-1}), std::invalid_argument);
+}
@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/dense_model_store.hpp"
+#include "morpheus/types.hpp"                // for TensorIndex
+#include "morpheus/utilities/matx_util.hpp"  // for DenseActivation
+
+#include <cuda_runtime.h>  // for cudaMemcpy, cudaMemcpyDeviceToHost
+#include <gtest/gtest.h>
+#include <mrc/cuda/common.hpp>  // for MRC_CHECK_CUDA
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstdint>  // for int32_t
+#include <memory>
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <string>
+#include <utility>  // for move
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+DenseLayer make_layer(TensorIndex input_size,
+                      TensorIndex output_size,
+                      std::vector<float> weights,
+                      std::vector<float> biases,
+                      DenseActivation activation = DenseActivation::NONE)
+{
+    return DenseLayer{input_size, output_size, std::move(weights), std::move(biases), activation};
+}
+
+// Runs the rows of `inputs`, each of `input_size` values, through the models of `model_indices`
+std::vector<float> run(DenseModelStore& store,
+                       const std::vector<float>& inputs,
+                       TensorIndex input_size,
+                       const std::vector<int32_t>& model_indices)
+{
+    rmm::device_buffer input(inputs.data(), inputs.size() * sizeof(float), rmm::cuda_stream_per_thread);
+
+    TensorIndex output_size = 0;
+    auto output             = store.infer(
+        static_cast<const float*>(input.data()), input_size, model_indices, rmm::cuda_stream_per_thread, output_size);
+
+    std::vector<float> host(model_indices.size() * output_size);
+    MRC_CHECK_CUDA(cudaMemcpy(host.data(), output->data(), output->size(), cudaMemcpyDeviceToHost));
+
+    return host;
+}
+}  // namespace
+
+TEST_CLASS(DenseModelStore);
+
+TEST_F(TestDenseModelStore, RunsEachRowThroughItsModel)
+{
+    DenseModelStore store(8);
+
+    // Two models of the same architecture, and one of another
+    store.set_model("alice", {make_layer(2, 1, {1, 2}, {0})});
+    store.set_model("bob", {make_layer(2, 1, {-1, 1}, {1}, DenseActivation::RELU)});
+    store.set_model("carol", {make_layer(2, 2, {1, 0, 0, 1}, {0, 0}), make_layer(2, 1, {1, 1}, {0.5})});
+
+    const auto alice = store.model_index("alice");
+    const auto bob   = store.model_index("bob");
+    const auto carol = store.model_index("carol");
+
+    auto outputs = run(store, {1, 1, 1, 1, 2, 0, 3, 1, 4, 0}, 2, {alice, bob, alice, carol, bob});
+
+    EXPECT_EQ(outputs, (std::vector<float>{3, 1, 2, 4.5, 0}));
+    EXPECT_EQ(store.num_resident(), 3);
+}
+
+TEST_F(TestDenseModelStore, EvictsLeastRecentlyUsed)
+{
+    int num_loads = 0;
+    DenseModelStore store(1, [&num_loads](const std::string& name) {
+        ++num_loads;
+        const float weight = name == "alice" ? 1 : 2;
+        return std::vector<DenseLayer>{make_layer(1, 1, {weight}, {0})};
+    });
+
+    const auto alice = store.model_index("alice");
+    const auto bob   = store.model_index("bob");
+
+    EXPECT_EQ(run(store, {3}, 1, {alice}), (std::vector<float>{3}));
+    EXPECT_EQ(run(store, {3}, 1, {bob}), (std::vector<float>{6}));
+    EXPECT_EQ(num_loads, 2);
+    EXPECT_EQ(store.num_resident(), 1);
+    EXPECT_FALSE(store.is_resident("alice"));
+    EXPECT_TRUE(store.is_resident("bob"));
+
+    // Reloaded once evicted
+    EXPECT_EQ(run(store, {3}, 1, {alice}), (std::vector<float>{3}));
+    EXPECT_EQ(num_loads, 3);
+}
+
+TEST_F(TestDenseModelStore, FallbackModel)
+{
+    DenseModelStore store(8, nullptr, "generic");
+    store.set_model("generic", {make_layer(1, 1, {5}, {0})});
+
+    EXPECT_EQ(run(store, {1}, 1, {store.model_index("unknown")}), (std::vector<float>{5}));
+
+    DenseModelStore strict_store(8);
+    EXPECT_THROW(run(strict_store, {1}, 1, {strict_store.model_index("unknown")}), std::runtime_error);
+}
+
+TEST_F(TestDenseModelStore, InvalidModels)
+{
+    DenseModelStore store(8);
+
+    EXPECT_THROW(store.set_model("empty", {}), std::invalid_argument);
+    EXPECT_THROW(store.set_model("sizes", {make_layer(2, 1, {1}, {0})}), std::invalid_argument);
+    EXPECT_THROW(store.set_model("chain", {make_layer(1, 2, {1, 1}, {0, 0}), make_layer(1, 1, {1}, {0})}),
+                 std::invalid_argument);
+
+    // Models of a batch must share their input and output sizes
+    store.set_model("one", {make_layer(1, 1, {1}, {0})});
+    store.set_model("two", {make_layer(1, 2, {1, 1}, {0, 0})});
+    EXPECT_THROW(run(store, {1, 1}, 1, {store.model_index("one"), store.model_index("two")}), std::invalid_argument);
+}
@@ -19,11 +19,16 @@
 
 #include "morpheus/io/deserializers.hpp"
 
+#include <cudf/dictionary/dictionary_column_view.hpp>
 #include <cudf/io/csv.hpp>
 #include <cudf/io/types.hpp>
+#include <cudf/types.hpp>  // for data_type
 #include <gtest/gtest.h>
 
+#include <cstddef>  // for size_t
 #include <filesystem>
+#include <optional>
+#include <stdexcept>  // for invalid_argument
 #include <string>
 #include <vector>
 
@@ -103,3 +108,127 @@ TEST_F(TestDeserializers, GetIndexColCountValidNameInvalidType)
 
     EXPECT_EQ(get_index_col_count(table), 0);
 }
+
+TEST_F(TestDeserializers, ChunkedTableReaderReadsAllRows)
+{
+    auto test_data_dir = test::get_morpheus_root() / "tests/tests_data";
+
+    std::vector<std::filesystem::path> input_files{test_data_dir / "filter_probs.csv",
+                                                   test_data_dir / "filter_probs.jsonlines",
+                                                   test_data_dir / "filter_probs.parquet"};
+    for (const auto& input_file : input_files)
+    {
+        auto expected = load_table_from_file(input_file);
+
+        // Small enough for the file to be read in several chunks
+        ChunkedTableReader reader(input_file, FileTypes::Auto, 64);
+
+        cudf::size_type num_rows = 0;
+        std::size_t num_chunks   = 0;
+        while (auto chunk = reader.next())
+        {
+            EXPECT_EQ(get_column_names_from_table(*chunk), get_column_names_from_table(expected));
+            num_rows += chunk->tbl->num_rows();
+            ++num_chunks;
+        }
+
+        EXPECT_EQ(num_rows, expected.tbl->num_rows());
+        EXPECT_GE(num_chunks, 1);
+    }
+}
+
+TEST_F(TestDeserializers, LoadTableWithSchema)
+{
+    auto test_data_dir = test::get_morpheus_root() / "tests/tests_data";
+    auto schema        = TableSchema::from_type_names({{"v3", "float32"}, {"v1", "float64"}});
+
+    std::vector<std::filesystem::path> input_files{test_data_dir / "filter_probs.csv",
+                                                   test_data_dir / "filter_probs.jsonlines",
+                                                   test_data_dir / "filter_probs.parquet"};
+    for (const auto& input_file : input_files)
+    {
+        auto expected = load_table_from_file(input_file);
+        auto table    = load_table_from_file(input_file, FileTypes::Auto, std::nullopt, schema);
+
+        // Only the columns of the schema are read, in its order and at its types
+        EXPECT_EQ(get_column_names_from_table(table), schema.column_names);
+        EXPECT_EQ(table.tbl->num_rows(), expected.tbl->num_rows());
+        EXPECT_EQ(table.tbl->get_column(0).type(), cudf::data_type(cudf::type_id::FLOAT32));
+        EXPECT_EQ(table.tbl->get_column(1).type(), cudf::data_type(cudf::type_id::FLOAT64));
+    }
+
+    EXPECT_THROW(TableSchema::from_type_names({{"v1", "complex128"}}), std::invalid_argument);
+    EXPECT_THROW(TableSchema::from_type_names({{"v1", "int64"}, {"v1", "float64"}}), std::invalid_argument);
+}
+
+TEST_F(TestDeserializers, LoadTableWithDictionarySchema)
+{
+    const std::string data{"user,bytes\nalice,1\nbob,2\nalice,3\nalice,4\n"};
+    auto schema = TableSchema::from_type_names({{"user", "category"}, {"bytes", "int64"}});
+
+    // Parsed as a string then encoded
+    EXPECT_EQ(schema.dtypes().at("user"), cudf::data_type(cudf::type_id::STRING));
+
+    auto table = load_table_from_buffer(data.data(), data.size(), FileTypes::CSV, std::nullopt, schema);
+    ASSERT_EQ(table.tbl->get_column(0).type(), cudf::data_type(cudf::type_id::DICTIONARY32));
+    EXPECT_EQ(table.tbl->num_rows(), 4);
+
+    // Each distinct user is held once
+    EXPECT_EQ(cudf::dictionary_column_view{table.tbl->get_column(0).view()}.keys_size(), 2);
+}
+
+TEST_F(TestDeserializers, ReadJsonLinesRecovering)
+{
+    const std::string valid{"{\"a\": 1, \"b\": \"x\"}\n{\"a\": 2, \"b\": \"y\"}\n"};
+    const std::string malformed{"{\"a\": 1, \"b\": \"x\"}\n{\"a\": 2, \"b\n{\"a\": 3, \"b\": \"z\"}\n"};
+
+    cudf::size_type num_malformed = -1;
+    auto table = read_json_lines_recovering(valid.data(), valid.size(), {}, false, num_malformed);
+    EXPECT_EQ(table.tbl->num_rows(), 2);
+    EXPECT_EQ(num_malformed, 0);
+
+    // Only the malformed line is dropped, with or without a first strict parse
+    for (bool always_recover : {false, true})
+    {
+        table = read_json_lines_recovering(malformed.data(), malformed.size(), {}, always_recover, num_malformed);
+        EXPECT_EQ(get_column_names_from_table(table), std::vector<std::string>({"a", "b"}));
+        EXPECT_EQ(table.tbl->num_rows(), 2);
+        EXPECT_EQ(num_malformed, 1);
+    }
+}
+
+TEST_F(TestDeserializers, FlattenNestedColumns)
+{
+    const std::string data{
+        "{\"id\": 1, \"user\": {\"name\": \"a\", \"geo\": {\"city\": \"x\"}}, \"tags\": [{\"k\": 1}, {\"k\": 2}]}\n"
+        "{\"id\": 2, \"user\": {\"name\": \"b\", \"geo\": {\"city\": \"y\"}}, \"tags\": []}\n"};
+
+    auto table = load_table_from_buffer(data.data(), data.size(), FileTypes::JSON);
+    flatten_nested_columns(table);
+
+    // Lists are kept as they are unless exploded
+    EXPECT_EQ(get_column_names_from_table(table),
+              std::vector<std::string>({"id", "user.name", "user.geo.city", "tags"}));
+    EXPECT_EQ(table.tbl->num_rows(), 2);
+
+    // Each element of a list becomes a row, an empty list a single row holding nulls
+    flatten_nested_columns(table, true);
+    EXPECT_EQ(get_column_names_from_table(table),
+              std::vector<std::string>({"id", "user.name", "user.geo.city", "tags.k"}));
+    EXPECT_EQ(table.tbl->num_rows(), 3);
+    EXPECT_EQ(table.tbl->get_column(3).null_count(), 1);
+}
+
+TEST_F(TestDeserializers, SelectRecords)
+{
+    const std::string data{
+        "{\"Records\": [{\"eventName\": \"a\", \"userIdentity\": {\"type\": \"x\"}}, "
+        "{\"eventName\": \"b\", \"userIdentity\": {\"type\": \"y\"}}]}"};
+
+    auto table = load_table_from_buffer(data.data(), data.size(), FileTypes::JSON, false);
+    EXPECT_THROW(select_records(table, "missing"), std::invalid_argument);
+
+    select_records(table, "Records");
+    EXPECT_EQ(get_column_names_from_table(table), std::vector<std::string>({"eventName", "userIdentity.type"}));
+    EXPECT_EQ(table.tbl->num_rows(), 2);
+}
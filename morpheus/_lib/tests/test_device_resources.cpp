@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/device_resources.hpp"
+
+#include <gtest/gtest.h>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+#include <rmm/error.hpp>  // for out_of_memory
+
+#include <stdexcept>  // for logic_error
+#include <thread>
+
+using namespace morpheus;
+
+TEST_CLASS(DeviceResources);
+
+// The stack stays installed for the remainder of the process, all of the checks are made by a single test
+TEST_F(TestDeviceResources, Install)
+{
+    EXPECT_FALSE(DeviceResources::is_installed());
+    EXPECT_EQ(DeviceResources::stream(), rmm::cuda_stream_per_thread);
+
+    MemoryConfig config;
+    config.resource_type     = DeviceResourceType::POOL;
+    config.initial_pool_size = 1 << 24;
+    config.use_arena         = true;
+    config.arena_size        = 1 << 22;
+    config.limit             = 1 << 20;
+    config.dedicated_streams = true;
+
+    DeviceResources::install(config);
+    EXPECT_TRUE(DeviceResources::is_installed());
+    EXPECT_THROW(DeviceResources::install(config), std::logic_error);
+
+    // Each thread has its own stream, which is kept for the lifetime of the thread
+    auto stream = DeviceResources::stream();
+    EXPECT_NE(stream, rmm::cuda_stream_per_thread);
+    EXPECT_EQ(DeviceResources::stream(), stream);
+
+    rmm::cuda_stream_view other_stream;
+    std::thread other([&other_stream]() {
+        other_stream = DeviceResources::stream();
+    });
+    other.join();
+    EXPECT_NE(other_stream, stream);
+
+    // Allocations go through the limiting adaptor
+    {
+        rmm::device_buffer buffer(1 << 19, stream);
+        EXPECT_THROW(rmm::device_buffer(1 << 20, stream), rmm::out_of_memory);
+    }
+
+    stream.synchronize();
+}
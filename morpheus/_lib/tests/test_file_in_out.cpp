@@ -30,8 +30,10 @@
 
 #include <cstddef>
 #include <filesystem>
-#include <fstream>  // IWYU pragma: keep
-#include <memory>   // for shared_ptr
+#include <fstream>    // IWYU pragma: keep
+#include <memory>     // for shared_ptr
+#include <sstream>    // for ostringstream
+#include <stdexcept>  // for invalid_argument
 #include <string>
 #include <utility>  // for move
 #include <vector>
@@ -89,6 +91,32 @@ TEST_F(TestFileInOut, RoundTripCSV)
     }
 }
 
+TEST_F(TestFileInOut, RoundTripCSVFileSink)
+{
+    auto input_file  = test::get_morpheus_root() / "tests/tests_data/filter_probs.csv";
+    auto output_file = std::filesystem::temp_directory_path() / "morpheus_test_file_sink.csv";
+
+    auto table           = load_table_from_file(input_file);
+    auto index_col_count = prepare_df_index(table);
+
+    auto meta = MessageMeta::create_from_cpp(std::move(table), index_col_count);
+
+    pybind11::gil_scoped_release no_gil;
+    {
+        auto sink = create_file_sink(output_file.string());
+        df_to_csv(meta->get_info(), *sink, true, false, true);
+    }
+
+    auto csv_data = read_file(output_file);
+    auto src_data = read_file(input_file);
+    std::filesystem::remove(output_file);
+
+    boost::trim(csv_data);
+    boost::trim(src_data);
+
+    EXPECT_EQ(csv_data, src_data);
+}
+
 TEST_F(TestFileInOut, RoundTripJSONLines)
 {
     using nlohmann::json;
@@ -122,3 +150,38 @@ TEST_F(TestFileInOut, RoundTripJSONLines)
         EXPECT_EQ(output_data, src_data);
     }
 }
+
+TEST_F(TestFileInOut, ChunkedParquetSingleFile)
+{
+    auto input_file  = test::get_morpheus_root() / "tests/tests_data/filter_probs.csv";
+    auto meta        = MessageMeta::create_from_cpp(load_table_from_file(input_file));
+    auto output_file = std::filesystem::temp_directory_path() / "morpheus_test_chunked.parquet";
+
+    pybind11::gil_scoped_release no_gil;
+    auto table_info = meta->get_info();
+
+    {
+        std::ofstream out_stream(output_file, std::ios::out | std::ios::trunc | std::ios::binary);
+        ChunkedParquetWriter writer(out_stream, false, "zstd", 8);
+
+        // Each table is appended to the same file, the footer is only written on close
+        writer.write(table_info);
+        writer.write(table_info);
+        writer.close();
+
+        EXPECT_GT(writer.bytes_written(), 0);
+    }
+
+    auto round_trip = load_table_from_file(output_file);
+    std::filesystem::remove(output_file);
+
+    EXPECT_EQ(round_trip.tbl->num_rows(), 2 * table_info.num_rows());
+    EXPECT_EQ(round_trip.tbl->num_columns(), table_info.num_columns());
+    EXPECT_EQ(round_trip.metadata.schema_info[0].name, table_info.get_column_names()[0]);
+}
+
+TEST_F(TestFileInOut, ChunkedParquetRejectsUnknownCompression)
+{
+    std::ostringstream out_stream;
+    EXPECT_THROW(ChunkedParquetWriter(out_stream, true, "brotli"), std::invalid_argument);
+}
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/flat_map.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>  // for out_of_range
+#include <string>
+#include <string_view>
+#include <utility>  // for swap
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(FlatMap);
+
+namespace {
+// Assigning a value is an error, the map must only construct and swap its values
+struct SwapOnly
+{
+    SwapOnly() = default;
+    explicit SwapOnly(int v) : value(v) {}
+    SwapOnly(const SwapOnly& other) = default;
+
+    SwapOnly& operator=(const SwapOnly& /*other*/)
+    {
+        throw std::logic_error("SwapOnly values must not be assigned");
+    }
+
+    friend void swap(SwapOnly& lhs, SwapOnly& rhs) noexcept
+    {
+        std::swap(lhs.value, rhs.value);
+    }
+
+    int value{-1};
+};
+}  // namespace
+
+TEST_F(TestFlatMap, InsertFindErase)
+{
+    FlatMap<std::string, SwapOnly> map;
+    EXPECT_TRUE(map.empty());
+
+    EXPECT_TRUE(map.try_emplace("seq_ids", 3).second);
+    EXPECT_TRUE(map.try_emplace("input_ids", 1).second);
+    EXPECT_TRUE(map.try_emplace("probs", 2).second);
+    EXPECT_FALSE(map.try_emplace("probs", 4).second);
+    EXPECT_TRUE(map.insert({"attention_mask", SwapOnly{0}}).second);
+    EXPECT_EQ(map.size(), 4);
+
+    // Iterated in the order of the keys
+    std::vector<std::string> keys;
+    for (const auto& [key, value] : map)
+    {
+        keys.push_back(key);
+        EXPECT_EQ(value.value, static_cast<int>(keys.size()) - 1);
+    }
+    EXPECT_EQ(keys, std::vector<std::string>({"attention_mask", "input_ids", "probs", "seq_ids"}));
+
+    // Lookups without creating a key
+    EXPECT_TRUE(map.contains("probs"));
+    EXPECT_TRUE(map.contains(std::string_view{"input_ids"}));
+    EXPECT_FALSE(map.contains("logits"));
+    EXPECT_EQ(map.count("seq_ids"), 1);
+    EXPECT_EQ(map.find("logits"), map.end());
+    EXPECT_EQ(map.at("probs").value, 2);
+    EXPECT_THROW(map.at("logits"), std::out_of_range);
+
+    // Missing keys are inserted with a default value
+    EXPECT_EQ(map["logits"].value, -1);
+    EXPECT_EQ(map.size(), 5);
+    EXPECT_EQ(map["probs"].value, 2);
+
+    EXPECT_EQ(map.erase("logits"), 1);
+    EXPECT_EQ(map.erase("logits"), 0);
+
+    auto next = map.erase(map.find("input_ids"));
+    EXPECT_EQ(next->first, "probs");
+
+    keys.clear();
+    for (const auto& [key, value] : map)
+    {
+        keys.push_back(key);
+    }
+    EXPECT_EQ(keys, std::vector<std::string>({"attention_mask", "probs", "seq_ids"}));
+}
+
+TEST_F(TestFlatMap, Copy)
+{
+    FlatMap<std::string, SwapOnly> map{{"b", SwapOnly{2}}, {"a", SwapOnly{1}}};
+    EXPECT_EQ(map.begin()->first, "a");
+
+    FlatMap<std::string, SwapOnly> other{{"c", SwapOnly{3}}, {"d", SwapOnly{4}}};
+
+    // Assigning a map replaces its values rather than assigning them
+    other = map;
+    EXPECT_EQ(other.size(), 2);
+    EXPECT_EQ(other.at("a").value, 1);
+    EXPECT_EQ(other.at("b").value, 2);
+    EXPECT_FALSE(other.contains("c"));
+}
@@ -20,10 +20,10 @@
 #include "morpheus/io/deserializers.hpp"
 #include "morpheus/objects/dev_mem_info.hpp"
 #include "morpheus/objects/dtype.hpp"
-#include "morpheus/types.hpp"  // for ShapeType, TensorIndex
+#include "morpheus/types.hpp"  // for RangeType, ShapeType, TensorIndex
 #include "morpheus/utilities/matx_util.hpp"
 
-#include <cuda_runtime.h>               // for cudaMemcpy, cudaMemcpyDeviceToHost, cudaMemcpyHostToDevice
+#include <cuda_runtime.h>               // for cudaMemcpy, cudaMallocHost, cudaFreeHost
 #include <cudf/column/column.hpp>       // for column
 #include <cudf/column/column_view.hpp>  // for column_view
 #include <cudf/io/types.hpp>
@@ -34,8 +34,11 @@
 #include <rmm/cuda_stream_view.hpp>  // for cuda_stream_per_thread
 #include <rmm/device_buffer.hpp>
 
-#include <cstdint>  // for int64_t, uint8_t
-#include <memory>   // for shared_ptr, make_shared, unique_ptr
+#include <cmath>      // for exp
+#include <cstdint>    // for int64_t, uint8_t
+#include <memory>     // for shared_ptr, make_shared, unique_ptr
+#include <optional>   // for nullopt
+#include <stdexcept>  // for invalid_argument
 #include <vector>
 
 using namespace morpheus;
@@ -214,6 +217,240 @@ TEST_F(TestMatxUtil, Cast)
     }
 }
 
+TEST_F(TestMatxUtil, CastHalf)
+{
+    // Values which are exactly representable in half precision
+    std::vector<float> float_vec{0.25, 0.5, 0.75, 1.0, -2.5, 4.0};
+
+    DType float_type(TypeId::FLOAT32);
+
+    auto float_buffer =
+        std::make_shared<rmm::device_buffer>(float_vec.size() * float_type.item_size(), rmm::cuda_stream_per_thread);
+
+    MRC_CHECK_CUDA(cudaMemcpy(float_buffer->data(), float_vec.data(), float_buffer->size(), cudaMemcpyHostToDevice));
+
+    for (auto half_type_id : {TypeId::FLOAT16, TypeId::BFLOAT16})
+    {
+        DType half_type(half_type_id);
+        EXPECT_EQ(half_type.item_size(), 2);
+
+        DevMemInfo dm{float_buffer, float_type, {6, 1}, {1, 0}};
+        auto half_buffer = MatxUtil::cast(dm, half_type_id);
+        EXPECT_EQ(half_buffer->size(), float_vec.size() * half_type.item_size());
+
+        // The functors operate on half precision directly
+        DevMemInfo half_dm{half_buffer, half_type, {6, 1}, {1, 0}};
+        auto thresh_buffer = MatxUtil::threshold(half_dm, 0.6, false);
+
+        std::vector<uint8_t> thresh_vec(float_vec.size());
+        MRC_CHECK_CUDA(
+            cudaMemcpy(thresh_vec.data(), thresh_buffer->data(), thresh_buffer->size(), cudaMemcpyDeviceToHost));
+        EXPECT_EQ(thresh_vec, (std::vector<uint8_t>{0, 0, 1, 1, 0, 1}));
+
+        auto round_trip_buffer = MatxUtil::cast(half_dm, TypeId::FLOAT32);
+
+        std::vector<float> round_trip_vec(float_vec.size());
+        MRC_CHECK_CUDA(cudaMemcpy(
+            round_trip_vec.data(), round_trip_buffer->data(), round_trip_buffer->size(), cudaMemcpyDeviceToHost));
+        EXPECT_EQ(round_trip_vec, float_vec);
+    }
+}
+
+TEST_F(TestMatxUtil, GatherRows)
+{
+    // 5x2 column major input, the first column holds 0-4 and the second 10-14
+    std::vector<int32_t> input_vec{0, 1, 2, 3, 4, 10, 11, 12, 13, 14};
+
+    DType int_type(TypeId::INT32);
+
+    auto input_buffer =
+        std::make_shared<rmm::device_buffer>(input_vec.size() * int_type.item_size(), rmm::cuda_stream_per_thread);
+
+    MRC_CHECK_CUDA(cudaMemcpy(input_buffer->data(), input_vec.data(), input_buffer->size(), cudaMemcpyHostToDevice));
+
+    DevMemInfo dm{input_buffer, int_type, {5, 2}, {1, 5}};
+
+    // Empty ranges are skipped
+    std::vector<RangeType> ranges{{3, 5}, {1, 1}, {0, 2}};
+    auto output_buffer = MatxUtil::gather_rows(dm, ranges, 4);
+    EXPECT_EQ(output_buffer->size(), 4 * 2 * int_type.item_size());
+
+    std::vector<int32_t> output(8);
+    MRC_CHECK_CUDA(cudaMemcpy(output.data(), output_buffer->data(), output_buffer->size(), cudaMemcpyDeviceToHost));
+
+    // The output is row major
+    std::vector<int32_t> expected_output{3, 13, 4, 14, 0, 10, 1, 11};
+    EXPECT_EQ(output, expected_output);
+}
+
+TEST_F(TestMatxUtil, GatherRowsMultipleTensors)
+{
+    // A 5x2 column major int32 input and a 5x1 float64 input
+    std::vector<int32_t> int_input{0, 1, 2, 3, 4, 10, 11, 12, 13, 14};
+    std::vector<double> double_input{0.5, 1.5, 2.5, 3.5, 4.5};
+
+    auto stream        = rmm::cuda_stream_per_thread;
+    auto int_buffer    = std::make_shared<rmm::device_buffer>(int_input.size() * sizeof(int32_t), stream);
+    auto double_buffer = std::make_shared<rmm::device_buffer>(double_input.size() * sizeof(double), stream);
+
+    MRC_CHECK_CUDA(cudaMemcpy(int_buffer->data(), int_input.data(), int_buffer->size(), cudaMemcpyHostToDevice));
+    MRC_CHECK_CUDA(
+        cudaMemcpy(double_buffer->data(), double_input.data(), double_buffer->size(), cudaMemcpyHostToDevice));
+
+    std::vector<DevMemInfo> inputs;
+    inputs.emplace_back(int_buffer, DType(TypeId::INT32), ShapeType{5, 2}, ShapeType{1, 5});
+    inputs.emplace_back(double_buffer, DType(TypeId::FLOAT64), ShapeType{5, 1}, ShapeType{1, 1});
+
+    // Empty ranges are skipped
+    std::vector<RangeType> ranges{{3, 5}, {1, 1}, {0, 2}};
+    auto outputs = MatxUtil::gather_rows(inputs, ranges, 4);
+    ASSERT_EQ(outputs.size(), 2);
+
+    std::vector<int32_t> int_output(8);
+    MRC_CHECK_CUDA(cudaMemcpy(int_output.data(), outputs[0]->data(), outputs[0]->size(), cudaMemcpyDeviceToHost));
+    EXPECT_EQ(int_output, (std::vector<int32_t>{3, 13, 4, 14, 0, 10, 1, 11}));
+
+    std::vector<double> double_output(4);
+    MRC_CHECK_CUDA(
+        cudaMemcpy(double_output.data(), outputs[1]->data(), outputs[1]->size(), cudaMemcpyDeviceToHost));
+    EXPECT_EQ(double_output, (std::vector<double>{3.5, 4.5, 0.5, 1.5}));
+}
+
+TEST_F(TestMatxUtil, PackFeatureMatrix)
+{
+    // An int32 column read from its second row, and a float64 column whose second row is null
+    std::vector<int32_t> int_input{1, 2, 3, 4};
+    std::vector<double> double_input{0.5, 1.5, 2.5};
+    uint32_t double_mask = 0b101;
+
+    auto stream        = rmm::cuda_stream_per_thread;
+    auto int_buffer    = std::make_shared<rmm::device_buffer>(int_input.size() * sizeof(int32_t), stream);
+    auto double_buffer = std::make_shared<rmm::device_buffer>(double_input.size() * sizeof(double), stream);
+    auto mask_buffer   = std::make_shared<rmm::device_buffer>(sizeof(uint32_t), stream);
+
+    MRC_CHECK_CUDA(cudaMemcpy(int_buffer->data(), int_input.data(), int_buffer->size(), cudaMemcpyHostToDevice));
+    MRC_CHECK_CUDA(
+        cudaMemcpy(double_buffer->data(), double_input.data(), double_buffer->size(), cudaMemcpyHostToDevice));
+    MRC_CHECK_CUDA(cudaMemcpy(mask_buffer->data(), &double_mask, sizeof(uint32_t), cudaMemcpyHostToDevice));
+
+    std::vector<FeatureColumn> columns{
+        {int_buffer->data(), nullptr, 1, TypeId::INT32},
+        {double_buffer->data(), static_cast<const uint32_t*>(mask_buffer->data()), 0, TypeId::FLOAT64}};
+
+    auto features_buffer = std::make_shared<rmm::device_buffer>(3 * 2 * sizeof(float), stream);
+    auto seq_ids_buffer  = std::make_shared<rmm::device_buffer>(3 * 3 * sizeof(TensorIndex), stream);
+
+    MatxUtil::pack_feature_matrix(columns,
+                                  3,
+                                  -1,
+                                  static_cast<float*>(features_buffer->data()),
+                                  static_cast<TensorIndex*>(seq_ids_buffer->data()),
+                                  5,
+                                  stream);
+
+    std::vector<float> features(6);
+    std::vector<TensorIndex> seq_ids(9);
+    MRC_CHECK_CUDA(
+        cudaMemcpy(features.data(), features_buffer->data(), features_buffer->size(), cudaMemcpyDeviceToHost));
+    MRC_CHECK_CUDA(cudaMemcpy(seq_ids.data(), seq_ids_buffer->data(), seq_ids_buffer->size(), cudaMemcpyDeviceToHost));
+
+    // The features are row major, nulls are replaced by the fill value
+    std::vector<float> expected_features{2, 0.5, 3, -1, 4, 2.5};
+    std::vector<TensorIndex> expected_seq_ids{5, 0, 1, 6, 0, 1, 7, 0, 1};
+    EXPECT_EQ(features, expected_features);
+    EXPECT_EQ(seq_ids, expected_seq_ids);
+}
+
+TEST_F(TestMatxUtil, ReduceLogitsThreshold)
+{
+    // clang-format off
+    // disabling clang-format to illustrate row-major layout
+    std::vector<float> input{
+        0.1, 0.6,
+        0.4, 0.2,
+        0.7, 0.3,
+        0.2, 0.1};
+
+    // reducing 4 rows down to 3
+    ShapeType seq_ids{0, 0, 1, 2};
+
+    std::vector<float> expected_probs{
+        0.4, 0.6,
+        0.7, 0.3,
+        0.2, 0.1};
+
+    std::vector<uint8_t> expected_mask{
+        0, 1,
+        1, 0,
+        0, 0};
+    // clang-format on
+
+    DType dtype(TypeId::FLOAT32);
+
+    auto input_buffer = std::make_shared<rmm::device_buffer>(input.size() * dtype.item_size(),
+                                                             rmm::cuda_stream_per_thread);
+    MRC_CHECK_CUDA(cudaMemcpy(input_buffer->data(), input.data(), input_buffer->size(), cudaMemcpyHostToDevice));
+
+    DevMemInfo dm{input_buffer, dtype, {4, 2}, {2, 1}};
+
+    // Without the sigmoid the probabilities are the reduced values
+    auto output = MatxUtil::reduce_logits_threshold(dm, seq_ids, 0, 3, false, 0.5);
+    EXPECT_EQ(output.shape, (ShapeType{3, 2}));
+    EXPECT_EQ(output.stride, (ShapeType{2, 1}));
+
+    std::vector<float> probs(expected_probs.size());
+    MRC_CHECK_CUDA(cudaMemcpy(probs.data(), output.probs->data(), output.probs->size(), cudaMemcpyDeviceToHost));
+    EXPECT_EQ(probs, expected_probs);
+
+    std::vector<uint8_t> mask(expected_mask.size());
+    MRC_CHECK_CUDA(cudaMemcpy(mask.data(), output.mask->data(), output.mask->size(), cudaMemcpyDeviceToHost));
+    EXPECT_EQ(mask, expected_mask);
+
+    // sigmoid(x) > 0.6 for x > ~0.405, by row
+    output = MatxUtil::reduce_logits_threshold(dm, seq_ids, 0, 3, true, 0.6, true);
+
+    MRC_CHECK_CUDA(cudaMemcpy(probs.data(), output.probs->data(), output.probs->size(), cudaMemcpyDeviceToHost));
+    for (std::size_t i = 0; i < probs.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(probs[i], 1.0f / (1.0f + std::exp(-expected_probs[i])));
+    }
+
+    std::vector<uint8_t> row_mask(3);
+    EXPECT_EQ(output.mask->size(), row_mask.size());
+    MRC_CHECK_CUDA(cudaMemcpy(row_mask.data(), output.mask->data(), output.mask->size(), cudaMemcpyDeviceToHost));
+    EXPECT_EQ(row_mask, (std::vector<uint8_t>{1, 1, 0}));
+}
+
+TEST_F(TestMatxUtil, ReduceLogitsThresholdDeviceSeqIds)
+{
+    std::vector<float> input{0.1, 0.6, 0.4, 0.2, 0.7, 0.3, 0.2, 0.1};
+    std::vector<float> expected_probs{0.4, 0.6, 0.7, 0.3, 0.2, 0.1};
+
+    // Nx3 seq_ids of a message starting at row 5 of the dataframe, only the first column is used
+    std::vector<int32_t> seq_ids{5, 0, 1, 5, 1, 1, 6, 0, 1, 7, 0, 1};
+
+    DType dtype(TypeId::FLOAT32);
+    DType seq_id_type(TypeId::INT32);
+
+    auto input_buffer = std::make_shared<rmm::device_buffer>(input.size() * dtype.item_size(),
+                                                             rmm::cuda_stream_per_thread);
+    MRC_CHECK_CUDA(cudaMemcpy(input_buffer->data(), input.data(), input_buffer->size(), cudaMemcpyHostToDevice));
+
+    auto seq_ids_buffer = std::make_shared<rmm::device_buffer>(seq_ids.size() * seq_id_type.item_size(),
+                                                               rmm::cuda_stream_per_thread);
+    MRC_CHECK_CUDA(cudaMemcpy(seq_ids_buffer->data(), seq_ids.data(), seq_ids_buffer->size(), cudaMemcpyHostToDevice));
+
+    DevMemInfo dm{input_buffer, dtype, {4, 2}, {2, 1}};
+    DevMemInfo seq_ids_dm{seq_ids_buffer, seq_id_type, {4, 3}, {3, 1}};
+
+    auto output = MatxUtil::reduce_logits_threshold(dm, seq_ids_dm, 3, false);
+    EXPECT_EQ(output.mask, nullptr);
+
+    std::vector<float> probs(expected_probs.size());
+    MRC_CHECK_CUDA(cudaMemcpy(probs.data(), output.probs->data(), output.probs->size(), cudaMemcpyDeviceToHost));
+    EXPECT_EQ(probs, expected_probs);
+}
+
 TEST_F(TestMatxUtil, Threshold)
 {
     // clang-format off
@@ -312,3 +549,228 @@ TEST_F(TestMatxUtil, ThresholdByRow)
         EXPECT_EQ(output_val, expected_output[i]);
     }
 }
+
+TEST_F(TestMatxUtil, TopK)
+{
+    // clang-format off
+    // disabling clang-format to illustrate row-major layout
+
+    std::vector<float> input
+    {
+        1.0, 0.2, 0.7, 0.9,
+        1.0, 0.6, 0.1, 0.9,
+        0.2, 0.8, 1.0, 0.9,
+        0.1, 0.4, 0.1, 0.3,
+        0.8, 1.0, 1.0, 0.8
+    };
+
+    // Column major, ties are broken by the order of the columns and ranks not above the threshold have an id of -1
+    std::vector<int32_t> expected_ids
+    {
+        0, 0, 2, -1, 2,
+        3, 3, 3, -1, 0
+    };
+
+    std::vector<float> expected_scores
+    {
+        1.0, 1.0, 1.0, 0.3, 1.0,
+        0.9, 0.9, 0.9, 0.1, 0.8
+    };
+    // clang-format on
+
+    TensorIndex num_cols = 4;
+    TensorIndex num_rows = 5;
+    TensorIndex k        = 2;
+
+    DType dtype(TypeId::FLOAT32);
+
+    auto input_buffer = std::make_shared<rmm::device_buffer>(input.size() * dtype.item_size(),
+                                                             rmm::cuda_stream_per_thread);
+    MRC_CHECK_CUDA(cudaMemcpy(input_buffer->data(), input.data(), input_buffer->size(), cudaMemcpyHostToDevice));
+
+    DevMemInfo dm{input_buffer, dtype, {num_rows, num_cols}, {num_cols, 1}};
+
+    rmm::device_buffer ids_buffer(num_rows * k * sizeof(int32_t), rmm::cuda_stream_per_thread);
+    rmm::device_buffer scores_buffer(num_rows * k * sizeof(float), rmm::cuda_stream_per_thread);
+
+    // Column 1 is not a candidate
+    MatxUtil::top_k(dm,
+                    {0, 2, 3},
+                    k,
+                    0.5,
+                    static_cast<int32_t*>(ids_buffer.data()),
+                    static_cast<float*>(scores_buffer.data()),
+                    rmm::cuda_stream_per_thread);
+    rmm::cuda_stream_per_thread.synchronize();
+
+    std::vector<int32_t> ids(expected_ids.size());
+    std::vector<float> scores(expected_scores.size());
+    MRC_CHECK_CUDA(cudaMemcpy(ids.data(), ids_buffer.data(), ids_buffer.size(), cudaMemcpyDeviceToHost));
+    MRC_CHECK_CUDA(cudaMemcpy(scores.data(), scores_buffer.data(), scores_buffer.size(), cudaMemcpyDeviceToHost));
+
+    EXPECT_EQ(ids, expected_ids);
+    EXPECT_EQ(scores, expected_scores);
+
+    EXPECT_THROW(MatxUtil::top_k(dm, {0, 2, 3}, 4, std::nullopt, nullptr, nullptr, rmm::cuda_stream_per_thread),
+                 std::invalid_argument);
+}
+
+TEST_F(TestMatxUtil, PackLabels)
+{
+    // clang-format off
+    // disabling clang-format to illustrate row-major layout
+
+    std::vector<float> input
+    {
+        1.0, 0.2, 0.7, 0.9,
+        0.5, 0.6, 0.1, 0.2,
+        0.2, 0.8, 1.0, 0.9
+    };
+    // clang-format on
+
+    // Bit `i` holds column `i` of the packed columns, column 1 is not packed and values equal to the threshold are not
+    // above it
+    std::vector<uint64_t> expected_output{0b111, 0b000, 0b110};
+
+    TensorIndex num_cols = 4;
+    TensorIndex num_rows = 3;
+
+    DType dtype(TypeId::FLOAT32);
+
+    auto input_buffer = std::make_shared<rmm::device_buffer>(input.size() * dtype.item_size(),
+                                                             rmm::cuda_stream_per_thread);
+    MRC_CHECK_CUDA(cudaMemcpy(input_buffer->data(), input.data(), input_buffer->size(), cudaMemcpyHostToDevice));
+
+    DevMemInfo dm{input_buffer, dtype, {num_rows, num_cols}, {num_cols, 1}};
+
+    rmm::device_buffer output_buffer(num_rows * sizeof(uint64_t), rmm::cuda_stream_per_thread);
+
+    MatxUtil::pack_labels(
+        dm, {0, 2, 3}, 0.5, static_cast<uint64_t*>(output_buffer.data()), rmm::cuda_stream_per_thread);
+    rmm::cuda_stream_per_thread.synchronize();
+
+    std::vector<uint64_t> output(expected_output.size());
+    MRC_CHECK_CUDA(cudaMemcpy(output.data(), output_buffer.data(), output_buffer.size(), cudaMemcpyDeviceToHost));
+
+    EXPECT_EQ(output, expected_output);
+
+    std::vector<TensorIndex> too_many_columns(MatxUtil::MaxPackedLabels + 1, 0);
+    EXPECT_THROW(MatxUtil::pack_labels(dm, too_many_columns, 0.5, nullptr, rmm::cuda_stream_per_thread),
+                 std::invalid_argument);
+}
+
+TEST_F(TestMatxUtil, SelectedRanges)
+{
+    std::vector<uint8_t> mask{1, 1, 0, 0, 1, 0, 1, 1, 1, 0, 0, 1};
+
+    rmm::device_buffer mask_buffer(mask.size(), rmm::cuda_stream_per_thread);
+    MRC_CHECK_CUDA(cudaMemcpy(mask_buffer.data(), mask.data(), mask.size(), cudaMemcpyHostToDevice));
+
+    const auto* mask_data = static_cast<const bool*>(mask_buffer.data());
+    const auto num_rows   = static_cast<TensorIndex>(mask.size());
+
+    EXPECT_EQ(MatxUtil::selected_ranges(mask_data, num_rows, rmm::cuda_stream_per_thread),
+              std::vector<RangeType>({{0, 2}, {4, 5}, {6, 9}, {11, 12}}));
+
+    // Only the first two rows, ending on a selected row
+    EXPECT_EQ(MatxUtil::selected_ranges(mask_data, 2, rmm::cuda_stream_per_thread), std::vector<RangeType>({{0, 2}}));
+
+    // Only the middle rows, none of which are selected
+    EXPECT_TRUE(MatxUtil::selected_ranges(mask_data + 2, 2, rmm::cuda_stream_per_thread).empty());
+    EXPECT_TRUE(MatxUtil::selected_ranges(mask_data, 0, rmm::cuda_stream_per_thread).empty());
+}
+
+TEST_F(TestMatxUtil, EnqueueCastInto)
+{
+    // 3x2 column major input, the first column holds 0-2 and the second 10-12
+    std::vector<int64_t> input_vec{0, 1, 2, 10, 11, 12};
+
+    DType long_type(TypeId::INT64);
+
+    auto input_buffer =
+        std::make_shared<rmm::device_buffer>(input_vec.size() * long_type.item_size(), rmm::cuda_stream_per_thread);
+
+    MRC_CHECK_CUDA(cudaMemcpy(input_buffer->data(), input_vec.data(), input_buffer->size(), cudaMemcpyHostToDevice));
+
+    DevMemInfo dm{input_buffer, long_type, {3, 2}, {1, 3}};
+
+    // The kernel writes directly to pinned host memory
+    int32_t* output = nullptr;
+    MRC_CHECK_CUDA(cudaMallocHost(reinterpret_cast<void**>(&output), 6 * sizeof(int32_t)));
+
+    MatxUtil::enqueue_cast_into(dm, TypeId::INT32, output, rmm::cuda_stream_per_thread);
+    rmm::cuda_stream_per_thread.synchronize();
+
+    // The output is row major
+    EXPECT_EQ(std::vector<int32_t>(output, output + 6), std::vector<int32_t>({0, 10, 1, 11, 2, 12}));
+
+    // Half precision types are only converted to and from floating point types
+    EXPECT_THROW(MatxUtil::enqueue_cast_into(dm, TypeId::FLOAT16, output, rmm::cuda_stream_per_thread),
+                 std::invalid_argument);
+
+    MRC_CHECK_CUDA(cudaFreeHost(output));
+}
+
+TEST_F(TestMatxUtil, RaggedRows)
+{
+    // 3 rows of 4 tokens, padded with zeros
+    std::vector<int32_t> padded_vec{101, 7, 102, 0, 101, 0, 0, 0, 101, 5, 6, 102};
+    DType int_type(TypeId::INT32);
+
+    auto padded_buffer =
+        std::make_shared<rmm::device_buffer>(padded_vec.size() * int_type.item_size(), rmm::cuda_stream_per_thread);
+    MRC_CHECK_CUDA(cudaMemcpy(padded_buffer->data(), padded_vec.data(), padded_buffer->size(), cudaMemcpyHostToDevice));
+
+    DevMemInfo padded{padded_buffer, int_type, {3, 4}, {4, 1}};
+
+    rmm::device_buffer lengths_buffer(3 * sizeof(TensorIndex), rmm::cuda_stream_per_thread);
+    MRC_CHECK_CUDA(cudaMemset(lengths_buffer.data(), 0, lengths_buffer.size()));
+    auto* lengths = static_cast<TensorIndex*>(lengths_buffer.data());
+
+    MatxUtil::enqueue_row_lengths(padded, lengths, rmm::cuda_stream_per_thread);
+
+    std::vector<TensorIndex> host_lengths(3);
+    MRC_CHECK_CUDA(cudaMemcpy(host_lengths.data(), lengths, lengths_buffer.size(), cudaMemcpyDeviceToHost));
+    EXPECT_EQ(host_lengths, std::vector<TensorIndex>({3, 1, 4}));
+
+    std::vector<TensorIndex> offsets{0, 3, 4, 8};
+    rmm::device_buffer offsets_buffer(offsets.size() * sizeof(TensorIndex), rmm::cuda_stream_per_thread);
+    MRC_CHECK_CUDA(cudaMemcpy(offsets_buffer.data(), offsets.data(), offsets_buffer.size(), cudaMemcpyHostToDevice));
+    const auto* offsets_data = static_cast<const TensorIndex*>(offsets_buffer.data());
+
+    // The tokens of the rows are concatenated without their padding
+    rmm::device_buffer packed(8 * sizeof(int32_t), rmm::cuda_stream_per_thread);
+    MatxUtil::pack_ragged_rows(padded, offsets_data, 1, packed.data(), rmm::cuda_stream_per_thread);
+
+    std::vector<int32_t> packed_vec(8);
+    MRC_CHECK_CUDA(cudaMemcpy(packed_vec.data(), packed.data(), packed.size(), cudaMemcpyDeviceToHost));
+    EXPECT_EQ(packed_vec, std::vector<int32_t>({101, 7, 102, 101, 101, 5, 6, 102}));
+
+    // Outputs of 2 values per token are padded back into rows of 8 values
+    std::vector<float> token_outputs_vec(16);
+    for (std::size_t i = 0; i < token_outputs_vec.size(); ++i)
+    {
+        token_outputs_vec[i] = static_cast<float>(i + 1);
+    }
+
+    rmm::device_buffer token_outputs(token_outputs_vec.size() * sizeof(float), rmm::cuda_stream_per_thread);
+    MRC_CHECK_CUDA(cudaMemcpy(
+        token_outputs.data(), token_outputs_vec.data(), token_outputs.size(), cudaMemcpyHostToDevice));
+
+    DType float_type(TypeId::FLOAT32);
+    auto unpacked_buffer = std::make_shared<rmm::device_buffer>(24 * sizeof(float), rmm::cuda_stream_per_thread);
+    DevMemInfo unpacked{unpacked_buffer, float_type, {3, 8}, {8, 1}};
+
+    MatxUtil::unpack_ragged_rows(token_outputs.data(), offsets_data, 2, unpacked, rmm::cuda_stream_per_thread);
+
+    std::vector<float> unpacked_vec(24);
+    MRC_CHECK_CUDA(
+        cudaMemcpy(unpacked_vec.data(), unpacked_buffer->data(), unpacked_buffer->size(), cudaMemcpyDeviceToHost));
+    EXPECT_EQ(unpacked_vec,
+              std::vector<float>({1, 2, 3, 4, 5, 6, 0, 0, 7, 8, 0, 0, 0, 0, 0, 0, 9, 10, 11, 12, 13, 14, 15, 16}));
+
+    // Column major tensors are not supported
+    DevMemInfo col_major{padded_buffer, int_type, {3, 4}, {1, 3}};
+    EXPECT_THROW(MatxUtil::pack_ragged_rows(col_major, offsets_data, 1, packed.data(), rmm::cuda_stream_per_thread),
+                 std::invalid_argument);
+}
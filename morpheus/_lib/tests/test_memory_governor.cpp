@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/memory_governor.hpp"
+
+#include <gtest/gtest.h>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/mr/device/per_device_resource.hpp>
+
+#include <chrono>     // for milliseconds
+#include <stdexcept>  // for invalid_argument
+#include <thread>
+
+using namespace morpheus;
+
+TEST_CLASS(MemoryGovernor);
+
+TEST_F(TestMemoryGovernor, Hysteresis)
+{
+    MemoryGovernor governor(rmm::mr::get_current_device_resource(), 0, 1000, 500);
+    auto stream = rmm::cuda_stream_per_thread;
+
+    void* first = governor.allocate(600, stream);
+    EXPECT_FALSE(governor.is_throttled());
+
+    void* second = governor.allocate(600, stream);
+    EXPECT_TRUE(governor.is_throttled());
+    EXPECT_EQ(governor.live_bytes(), 1200);
+
+    // Still above the low watermark
+    governor.deallocate(first, 600, stream);
+    EXPECT_TRUE(governor.is_throttled());
+
+    governor.deallocate(second, 600, stream);
+    EXPECT_FALSE(governor.is_throttled());
+    EXPECT_EQ(governor.live_bytes(), 0);
+}
+
+TEST_F(TestMemoryGovernor, WaitForRelease)
+{
+    MemoryGovernor governor(rmm::mr::get_current_device_resource(), 0, 1000, 500);
+    auto stream = rmm::cuda_stream_per_thread;
+
+    void* ptr = governor.allocate(1200, stream);
+    EXPECT_FALSE(governor.wait_for_release(std::chrono::milliseconds(10)));
+
+    std::thread releaser([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        governor.deallocate(ptr, 1200, stream);
+    });
+
+    EXPECT_TRUE(governor.wait_for_release(std::chrono::milliseconds(5000)));
+    releaser.join();
+}
+
+TEST_F(TestMemoryGovernor, SetWatermarks)
+{
+    MemoryGovernor governor(rmm::mr::get_current_device_resource(), 0, 1000, 500);
+    auto stream = rmm::cuda_stream_per_thread;
+
+    void* ptr = governor.allocate(800, stream);
+    EXPECT_FALSE(governor.is_throttled());
+
+    // Lowering the high watermark below the live bytes throttles the governor
+    governor.set_watermarks(700, 100);
+    EXPECT_TRUE(governor.is_throttled());
+    EXPECT_EQ(governor.high_watermark(), 700);
+    EXPECT_EQ(governor.low_watermark(), 100);
+
+    EXPECT_THROW(governor.set_watermarks(0, 0), std::invalid_argument);
+    EXPECT_THROW(governor.set_watermarks(100, 200), std::invalid_argument);
+
+    governor.deallocate(ptr, 800, stream);
+    EXPECT_FALSE(governor.is_throttled());
+}
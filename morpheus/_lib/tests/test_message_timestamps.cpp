@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/messages/control.hpp"
+#include "morpheus/objects/message_timestamps.hpp"
+#include "morpheus/utilities/metrics.hpp"
+
+#include <gtest/gtest.h>  // for EXPECT_EQ, TEST_F
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>  // for pair
+#include <vector>
+
+using namespace morpheus;
+using namespace std::chrono_literals;
+
+TEST_CLASS(MessageTimestamps);
+
+TEST_F(TestMessageTimestamps, InternKeys)
+{
+    auto key = TimestampKeys::intern("test_intern::entry");
+
+    EXPECT_EQ(TimestampKeys::intern("test_intern::entry"), key);
+    EXPECT_NE(TimestampKeys::intern("test_intern::exit"), key);
+    EXPECT_EQ(TimestampKeys::name(key), "test_intern::entry");
+    EXPECT_EQ(TimestampKeys::find("test_intern::entry"), key);
+    EXPECT_FALSE(TimestampKeys::find("test_intern::never_interned").has_value());
+}
+
+TEST_F(TestMessageTimestamps, SetAndFilter)
+{
+    MessageTimestamps timestamps;
+
+    auto start = std::chrono::system_clock::now();
+    auto key   = TimestampKeys::intern("test_filter::entry");
+
+    timestamps.set(key, start);
+    timestamps.set("test_filter::exit", start + 1ms);
+    timestamps.set("other::exit", start + 2ms);
+
+    // Setting a key again replaces its value in place
+    timestamps.set(key, start + 3ms);
+
+    EXPECT_EQ(timestamps.get("test_filter::entry"), start + 3ms);
+    EXPECT_EQ(timestamps.get(key), start + 3ms);
+    EXPECT_FALSE(timestamps.get("test_filter::never_set").has_value());
+    EXPECT_EQ(timestamps.entries().size(), 3);
+    EXPECT_EQ(timestamps.entries().front().first, key);
+
+    auto filtered = timestamps.filter("^test_filter::");
+    ASSERT_EQ(filtered.size(), 2);
+    EXPECT_EQ(filtered["test_filter::entry"], start + 3ms);
+    EXPECT_EQ(filtered["test_filter::exit"], start + 1ms);
+
+    // The compiled expression is reused
+    EXPECT_EQ(timestamps.filter("^test_filter::").size(), 2);
+    EXPECT_EQ(timestamps.filter("").size(), 3);
+}
+
+TEST_F(TestMessageTimestamps, CloneCopiesTimestamps)
+{
+    ControlMessage msg;
+
+    auto start = std::chrono::system_clock::now();
+    msg.set_timestamp(TimestampKeys::intern("test_clone::entry"), start);
+
+    auto cloned = msg.clone();
+    cloned->set_timestamp("test_clone::exit", start + 1ms);
+
+    EXPECT_EQ(cloned->get_timestamp("test_clone::entry"), start);
+    EXPECT_FALSE(msg.get_timestamp("test_clone::exit").has_value());
+}
+
+TEST_F(TestMessageTimestamps, ExportTrace)
+{
+    auto& registry = MetricsRegistry::get_instance();
+    registry.clear();
+
+    auto start = std::chrono::system_clock::now();
+
+    MessageTimestamps timestamps;
+    timestamps.set("test_source::exit", start);
+    timestamps.set("test_stage::entry", start + 10ms);
+    timestamps.set("test_stage::exit", start + 40ms);
+
+    TimestampTraceExporter exporter("test_sink");
+    exporter.record(timestamps.entries(), start + 100ms);
+
+    auto message_latency = registry.get_histogram("morpheus_message_latency_seconds", "", {{"sink", "test_sink"}});
+    EXPECT_EQ(message_latency->count(), 1);
+    EXPECT_NEAR(message_latency->sum(), 0.1, 1e-9);
+
+    auto stage_latency = registry.get_histogram("morpheus_stage_latency_seconds", "", {{"stage", "test_stage"}});
+    EXPECT_EQ(stage_latency->count(), 1);
+    EXPECT_NEAR(stage_latency->sum(), 0.03, 1e-9);
+
+    // The source only has an exit timestamp, and no latency of its own
+    EXPECT_EQ(registry.serialize().find("stage=\"test_source\""), std::string::npos);
+
+    registry.clear();
+}
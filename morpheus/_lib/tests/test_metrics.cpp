@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/utilities/metrics.hpp"
+
+#include <gtest/gtest.h>  // for EXPECT_EQ, TEST_F
+
+#include <cstdint>
+#include <stdexcept>  // for invalid_argument
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(Metrics);
+
+TEST_F(TestMetrics, SameSeriesIsShared)
+{
+    auto& registry = MetricsRegistry::get_instance();
+    registry.clear();
+
+    auto counter1 = registry.get_counter("test_records_total", "Records", {{"topic", "a"}});
+    auto counter2 = registry.get_counter("test_records_total", "Records", {{"topic", "a"}});
+    auto counter3 = registry.get_counter("test_records_total", "Records", {{"topic", "b"}});
+
+    EXPECT_EQ(counter1, counter2);
+    EXPECT_NE(counter1, counter3);
+
+    counter1->increment();
+    counter2->increment(2);
+
+    EXPECT_EQ(counter1->value(), 3);
+    EXPECT_EQ(counter3->value(), 0);
+
+    EXPECT_THROW(registry.get_gauge("test_records_total", "Records"), std::invalid_argument);
+
+    registry.clear();
+}
+
+TEST_F(TestMetrics, Serialize)
+{
+    auto& registry = MetricsRegistry::get_instance();
+    registry.clear();
+
+    registry.get_counter("test_bytes_total", "Bytes read", {{"partition", "0"}, {"topic", "in\"put"}})
+        ->increment(1234567890);
+    registry.get_gauge("test_fill_ratio", "Batch fill ratio")->set(0.5);
+
+    EXPECT_EQ(registry.serialize(),
+              "# HELP test_bytes_total Bytes read\n"
+              "# TYPE test_bytes_total counter\n"
+              "test_bytes_total{partition=\"0\",topic=\"in\\\"put\"} 1234567890\n"
+              "# HELP test_fill_ratio Batch fill ratio\n"
+              "# TYPE test_fill_ratio gauge\n"
+              "test_fill_ratio 0.5\n");
+
+    registry.remove("test_fill_ratio", {});
+
+    EXPECT_EQ(registry.serialize().find("test_fill_ratio"), std::string::npos);
+
+    registry.clear();
+}
+
+TEST_F(TestMetrics, Histogram)
+{
+    auto& registry = MetricsRegistry::get_instance();
+    registry.clear();
+
+    auto histogram = registry.get_histogram("test_latency_seconds", "Latency", {{"phase", "infer"}}, {0.1, 1});
+
+    histogram->observe(0.05);
+    histogram->observe(0.1);
+    histogram->observe(0.5);
+    histogram->observe(2);
+
+    EXPECT_EQ(histogram->bucket_counts(), std::vector<uint64_t>({2, 1, 1}));
+    EXPECT_EQ(histogram->count(), 4);
+    EXPECT_DOUBLE_EQ(histogram->sum(), 2.65);
+
+    EXPECT_EQ(registry.serialize(),
+              "# HELP test_latency_seconds Latency\n"
+              "# TYPE test_latency_seconds histogram\n"
+              "test_latency_seconds_bucket{phase=\"infer\",le=\"0.1\"} 2\n"
+              "test_latency_seconds_bucket{phase=\"infer\",le=\"1\"} 3\n"
+              "test_latency_seconds_bucket{phase=\"infer\",le=\"+Inf\"} 4\n"
+              "test_latency_seconds_sum{phase=\"infer\"} 2.65\n"
+              "test_latency_seconds_count{phase=\"infer\"} 4\n");
+
+    EXPECT_EQ(Histogram::exponential_buckets(1, 2, 4), std::vector<double>({1, 2, 4, 8}));
+    EXPECT_THROW(Histogram({1, 1}), std::invalid_argument);
+    EXPECT_THROW(registry.get_histogram("test_latency_seconds", "Latency", {{"le", "1"}}), std::invalid_argument);
+
+    registry.clear();
+}
+
+TEST_F(TestMetrics, ConcurrentUpdates)
+{
+    auto& registry = MetricsRegistry::get_instance();
+    registry.clear();
+
+    auto counter   = registry.get_counter("test_rows_total", "Rows");
+    auto histogram = registry.get_histogram("test_rows", "Rows", {}, Histogram::exponential_buckets(1, 2, 10));
+
+    // More threads than shards, so some of them share a shard
+    constexpr std::size_t NumThreads = MetricShards * 2;
+    constexpr std::size_t NumUpdates = 1000;
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < NumThreads; ++i)
+    {
+        threads.emplace_back([&counter, &histogram]() {
+            for (std::size_t j = 0; j < NumUpdates; ++j)
+            {
+                counter->increment();
+                histogram->observe(static_cast<double>(j % 4));
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter->value(), NumThreads * NumUpdates);
+    EXPECT_EQ(histogram->count(), NumThreads * NumUpdates);
+    EXPECT_DOUBLE_EQ(histogram->sum(), NumThreads * NumUpdates * 1.5);
+
+    // Values 0 and 1 fall in the first bucket, 2 in the second and 3 in the third
+    const auto counts = histogram->bucket_counts();
+    EXPECT_EQ(counts[0], NumThreads * NumUpdates / 2);
+    EXPECT_EQ(counts[1], NumThreads * NumUpdates / 4);
+    EXPECT_EQ(counts[2], NumThreads * NumUpdates / 4);
+
+    registry.clear();
+}
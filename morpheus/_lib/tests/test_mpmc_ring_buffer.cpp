@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/mpmc_ring_buffer.hpp"
+
+#include <boost/fiber/channel_op_status.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace morpheus;
+using boost::fibers::channel_op_status;
+
+TEST_CLASS(MpmcRingBuffer);
+
+TEST_F(TestMpmcRingBuffer, PushPop)
+{
+    EXPECT_THROW(MpmcRingBuffer<int>(3), std::invalid_argument);
+
+    MpmcRingBuffer<int> ring(4);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(ring.try_push(int{i}), channel_op_status::success);
+    }
+    EXPECT_EQ(ring.try_push(4), channel_op_status::full);
+
+    int item = -1;
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(ring.try_pop(item), channel_op_status::success);
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_EQ(ring.try_pop(item), channel_op_status::empty);
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(ring.pop_wait_until(item, start + std::chrono::milliseconds(50)), channel_op_status::timeout);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+
+    // Items pushed before closing the ring can still be popped
+    EXPECT_EQ(ring.push(5), channel_op_status::success);
+    ring.close();
+    EXPECT_EQ(ring.try_push(6), channel_op_status::closed);
+    EXPECT_EQ(ring.pop(item), channel_op_status::success);
+    EXPECT_EQ(item, 5);
+    EXPECT_EQ(ring.pop(item), channel_op_status::closed);
+}
+
+TEST_F(TestMpmcRingBuffer, MultipleProducersAndConsumers)
+{
+    constexpr std::size_t num_threads        = 4;
+    constexpr std::size_t num_items_per_side = 10000;
+
+    MpmcRingBuffer<std::size_t> ring(8);
+
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < num_threads; ++p)
+    {
+        producers.emplace_back([&ring, p]() {
+            for (std::size_t i = 0; i < num_items_per_side; ++i)
+            {
+                ASSERT_EQ(ring.push(p * num_items_per_side + i), channel_op_status::success);
+            }
+        });
+    }
+
+    std::vector<std::vector<std::size_t>> received(num_threads);
+    std::vector<std::thread> consumers;
+    for (std::size_t c = 0; c < num_threads; ++c)
+    {
+        consumers.emplace_back([&ring, &items = received[c]]() {
+            std::size_t item;
+            while (ring.pop(item) == channel_op_status::success)
+            {
+                items.push_back(item);
+            }
+        });
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    // Wakes up the consumers once every item has been popped
+    ring.close();
+    for (auto& consumer : consumers)
+    {
+        consumer.join();
+    }
+
+    // Every item is received exactly once, in the order of its producer
+    std::vector<std::size_t> counts(num_threads * num_items_per_side, 0);
+    for (const auto& items : received)
+    {
+        std::vector<std::size_t> last_index(num_threads, 0);
+        std::vector<bool> seen(num_threads, false);
+        for (auto item : items)
+        {
+            ++counts[item];
+
+            const auto producer = item / num_items_per_side;
+            const auto index    = item % num_items_per_side;
+            EXPECT_TRUE(!seen[producer] || index > last_index[producer]);
+            seen[producer]       = true;
+            last_index[producer] = index;
+        }
+    }
+
+    for (auto count : counts)
+    {
+        EXPECT_EQ(count, 1);
+    }
+}
@@ -15,10 +15,13 @@
  * limitations under the License.
  */
 
-#include "./test_utils/common.hpp"  // IWYU pragma: associated
+#include "./test_utils/common.hpp"        // IWYU pragma: associated
+#include "./test_utils/tensor_utils.hpp"  // for assert_eq_device_to_device
 
 #include "morpheus/io/deserializers.hpp"
+#include "morpheus/messages/multi.hpp"
 
+#include <cuda_runtime.h>  // for cudaMemcpy
 #include <cudf/concatenate.hpp>
 #include <cudf/copying.hpp>
 #include <cudf/io/types.hpp>
@@ -74,3 +77,39 @@ TEST_F(TestMultiSlices, Ranges)
     auto table_c = cudf::concatenate(slices);
     EXPECT_EQ(table_c->num_rows(), 4);
 }
+
+TEST_F(TestMultiSlices, GatherMap)
+{
+    std::filesystem::path morpheus_root = get_morpheus_root();
+
+    auto input_file = morpheus_root / "tests/tests_data/filter_probs.csv";
+
+    auto table_m = load_table_from_file(input_file);
+    auto table_v = table_m.tbl->view();
+
+    // Empty ranges are skipped, the offset is applied to every range
+    std::vector<RangeType> ranges{{1, 3}, {5, 5}, {11, 13}, {13, 14}, {17, 18}};
+    auto gather_map = MultiMessage::ranges_to_gather_map(ranges, 1);
+
+    std::vector<cudf::size_type> expected{2, 3, 12, 13, 14, 18};
+    std::vector<cudf::size_type> actual(gather_map->size());
+    ASSERT_EQ(actual.size(), expected.size());
+    ASSERT_EQ(cudaMemcpy(actual.data(),
+                         gather_map->view().data<cudf::size_type>(),
+                         actual.size() * sizeof(cudf::size_type),
+                         cudaMemcpyDeviceToHost),
+              cudaSuccess);
+    EXPECT_EQ(actual, expected);
+
+    // Gathering the rows matches slicing and concatenating the ranges
+    auto table_g = cudf::gather(table_v, gather_map->view());
+    auto table_c = cudf::concatenate(cudf::slice(table_v, {2, 4, 12, 15, 18, 19}));
+    EXPECT_EQ(table_g->num_rows(), table_c->num_rows());
+    ASSERT_EQ(table_g->num_columns(), table_c->num_columns());
+
+    // Every column of filter_probs.csv holds probabilities
+    for (cudf::size_type i = 0; i < table_g->num_columns(); ++i)
+    {
+        assert_eq_device_to_device<double>(table_g->get_column(i).view(), table_c->get_column(i).view());
+    }
+}
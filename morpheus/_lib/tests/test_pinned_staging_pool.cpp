@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/pinned_staging_pool.hpp"
+
+#include <cuda_runtime.h>
+#include <gtest/gtest.h>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstdint>  // for int32_t
+#include <cstring>  // for memcpy, memcmp
+#include <memory>   // for shared_ptr
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(PinnedStagingPool);
+
+TEST_F(TestPinnedStagingPool, ReusesReleasedBuffers)
+{
+    auto pool = PinnedStagingPool::create();
+
+    auto small = pool->acquire(256);
+    auto large = pool->acquire(4096);
+    EXPECT_EQ(small->size(), 256);
+    EXPECT_EQ(large->size(), 4096);
+
+    const char* small_data = small->data();
+    const char* large_data = large->data();
+
+    small.reset();
+    large.reset();
+    EXPECT_EQ(pool->num_idle_buffers(), 2);
+
+    // The smallest buffer which fits is reused
+    auto reused = pool->acquire(128);
+    EXPECT_EQ(reused->data(), small_data);
+    EXPECT_EQ(reused->size(), 128);
+
+    reused = pool->acquire(1024);
+    EXPECT_EQ(reused->data(), large_data);
+    EXPECT_EQ(pool->num_idle_buffers(), 1);
+}
+
+TEST_F(TestPinnedStagingPool, MaxIdleBuffers)
+{
+    auto pool = PinnedStagingPool::create(1);
+
+    auto first  = pool->acquire(64);
+    auto second = pool->acquire(64);
+
+    first.reset();
+    second.reset();
+
+    EXPECT_EQ(pool->num_idle_buffers(), 1);
+}
+
+TEST_F(TestPinnedStagingPool, RoundTrip)
+{
+    std::vector<int32_t> values{1, 2, 3, 4, 5};
+    const auto bytes = values.size() * sizeof(int32_t);
+
+    rmm::device_buffer device_buffer(bytes, rmm::cuda_stream_per_thread);
+
+    auto staging = PinnedStagingPool::get_instance().acquire(bytes);
+    std::memcpy(staging->data(), values.data(), bytes);
+    cudaMemcpyAsync(
+        device_buffer.data(), staging->data(), bytes, cudaMemcpyHostToDevice, rmm::cuda_stream_per_thread.value());
+
+    auto result = PinnedStagingPool::get_instance().acquire(bytes);
+    cudaMemcpyAsync(
+        result->data(), device_buffer.data(), bytes, cudaMemcpyDeviceToHost, rmm::cuda_stream_per_thread.value());
+    result->record(rmm::cuda_stream_per_thread);
+    result->synchronize();
+
+    EXPECT_EQ(std::memcmp(result->data(), values.data(), bytes), 0);
+}
@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/utilities/pool_allocator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(PoolAllocator);
+
+TEST_F(TestPoolAllocator, ReusesFreedBlocks)
+{
+    auto first       = make_pooled<std::string>("first");
+    const void* addr = first.get();
+    first.reset();
+
+    auto second = make_pooled<std::string>("second");
+    EXPECT_EQ(second.get(), addr);
+    EXPECT_EQ(*second, "second");
+}
+
+TEST_F(TestPoolAllocator, LargeObjects)
+{
+    auto large = make_pooled<std::array<char, detail::BlockCache::MaxBlockBytes * 2>>();
+    large->fill('a');
+    EXPECT_EQ(large->back(), 'a');
+}
+
+TEST_F(TestPoolAllocator, FreedByAnotherThread)
+{
+    std::vector<std::shared_ptr<int>> values;
+    for (int i = 0; i < static_cast<int>(detail::BlockCache::MaxCachedBlocks) * 2; ++i)
+    {
+        values.push_back(make_pooled<int>(i));
+    }
+
+    // Beyond the blocks cached by the freeing thread, the blocks are returned to the heap
+    std::thread([&values]() {
+        values.clear();
+    }).join();
+
+    auto value = make_pooled<int>(42);
+    EXPECT_EQ(*value, 42);
+}
+
+TEST_F(TestPoolAllocator, StdAllocator)
+{
+    std::vector<int, PoolAllocator<int>> values;
+    for (int i = 0; i < 100; ++i)
+    {
+        values.push_back(i);
+    }
+
+    EXPECT_EQ(values.back(), 99);
+    EXPECT_TRUE(PoolAllocator<int>{} == PoolAllocator<double>{});
+}
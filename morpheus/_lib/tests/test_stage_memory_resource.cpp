@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/stage_memory_resource.hpp"
+#include "morpheus/utilities/cuda_util.hpp"
+#include "morpheus/utilities/metrics.hpp"
+
+#include <gtest/gtest.h>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <string>  // for to_string
+
+using namespace morpheus;
+
+TEST_CLASS(StageMemoryResource);
+
+TEST_F(TestStageMemoryResource, SharedPerStage)
+{
+    auto* resource = StageMemoryResource::get("test_shared");
+
+    EXPECT_EQ(StageMemoryResource::get("test_shared"), resource);
+    EXPECT_NE(StageMemoryResource::get("test_shared_other"), resource);
+}
+
+TEST_F(TestStageMemoryResource, TracksAllocations)
+{
+    auto* resource = StageMemoryResource::get("test_tracks");
+    auto stream    = rmm::cuda_stream_per_thread;
+
+    {
+        rmm::device_buffer first(1024, stream, resource);
+        rmm::device_buffer second(2048, stream, resource);
+
+        EXPECT_EQ(resource->current_bytes(), 3072);
+        EXPECT_EQ(resource->peak_bytes(), 3072);
+    }
+
+    EXPECT_EQ(resource->current_bytes(), 0);
+    EXPECT_EQ(resource->allocation_count(), 2);
+
+    // The peak is only raised by a larger allocation
+    {
+        rmm::device_buffer third(512, stream, resource);
+        EXPECT_EQ(resource->peak_bytes(), 3072);
+    }
+
+    stream.synchronize();
+
+    auto& registry = MetricsRegistry::get_instance();
+    metric_labels_t labels{{"stage", "test_tracks"}, {"device", std::to_string(CudaUtil::current_device())}};
+
+    EXPECT_EQ(registry.get_gauge("morpheus_stage_gpu_memory_bytes", "", labels)->value(), 0);
+    EXPECT_EQ(registry.get_gauge("morpheus_stage_gpu_memory_peak_bytes", "", labels)->value(), 3072);
+    EXPECT_EQ(registry.get_counter("morpheus_stage_gpu_allocations_total", "", labels)->value(), 3);
+}
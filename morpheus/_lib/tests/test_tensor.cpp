@@ -17,13 +17,14 @@
 
 #include "./test_utils/common.hpp"  // IWYU pragma: associated
 
-#include "morpheus/objects/dtype.hpp"              // for DType
-#include "morpheus/objects/memory_descriptor.hpp"  // for MemoryDescriptor
-#include "morpheus/objects/rmm_tensor.hpp"         // for RMMTensor
-#include "morpheus/objects/tensor.hpp"             // for Tensor::create
-#include "morpheus/objects/tensor_object.hpp"      // for TensorIndex
-#include "morpheus/types.hpp"                      // for ShapeType, TensorIndex
-#include "morpheus/utilities/tensor_util.hpp"      // for TensorUtils
+#include "morpheus/messages/memory/tensor_memory.hpp"  // for TensorMemory
+#include "morpheus/objects/dtype.hpp"                  // for DType
+#include "morpheus/objects/memory_descriptor.hpp"      // for MemoryDescriptor
+#include "morpheus/objects/rmm_tensor.hpp"             // for RMMTensor
+#include "morpheus/objects/tensor.hpp"                 // for Tensor::create
+#include "morpheus/objects/tensor_object.hpp"          // for TensorIndex
+#include "morpheus/types.hpp"                          // for ShapeType, TensorIndex
+#include "morpheus/utilities/tensor_util.hpp"          // for TensorUtils
 
 #include <cuda/memory_resource>
 #include <cuda_runtime.h>
@@ -33,10 +34,11 @@
 #include <rmm/device_buffer.hpp>
 #include <rmm/mr/device/per_device_resource.hpp>
 
-#include <cstddef>  // for size_t
-#include <memory>   // shared_ptr
-#include <string>   // for allocator, operator==, basic_string, string
-#include <vector>   // for vector
+#include <cstddef>    // for size_t
+#include <memory>     // shared_ptr
+#include <stdexcept>  // for length_error
+#include <string>     // for allocator, operator==, basic_string, string
+#include <vector>     // for vector
 
 // IWYU pragma: no_include "morpheus/utilities/string_util.hpp"
 // IWYU thinks we need ext/new_allocator.h for size_t for some reason
@@ -123,6 +125,20 @@ TEST_F(TestTensor, AsType)
     }
 }
 
+TEST_F(TestTensor, AsTypeSameType)
+{
+    const auto dtype = DType::create<float>();
+    auto buffer      = std::make_shared<rmm::device_buffer>(8 * dtype.item_size(), rmm::cuda_stream_per_thread);
+
+    auto tensor = std::make_shared<RMMTensor>(buffer, 2, dtype, ShapeType{3, 2}, ShapeType{2, 1});
+
+    // No conversion is needed, the result is a view of the same memory
+    auto same_tensor = tensor->as_type(dtype);
+    EXPECT_EQ(same_tensor->data(), tensor->data());
+    EXPECT_EQ(same_tensor->get_shape(), tensor->get_shape());
+    EXPECT_EQ(same_tensor->get_stride(), tensor->get_stride());
+}
+
 TEST_F(TestTensor, Create)
 {
     const std::size_t count = 100;
@@ -181,3 +197,47 @@ TEST_F(TestTensor, UtilsValidateShapeAndStride)
 
     EXPECT_EQ(stride, ShapeType({320 * 320, 320, 1}));
 }
+
+TEST_F(TestTensor, LazyTensorMemory)
+{
+    const auto dtype = DType::create<float>();
+    auto make_tensor = [&dtype](TensorIndex rows) {
+        auto buffer = std::make_shared<rmm::device_buffer>(rows * dtype.item_size(), rmm::cuda_stream_per_thread);
+        return Tensor::create(buffer, dtype, {rows, 1}, {}, 0);
+    };
+
+    TensorMemory memory(4);
+    memory.set_tensor("seq_ids", make_tensor(4));
+
+    int num_calls = 0;
+    memory.set_lazy_tensor("probs", [&]() {
+        ++num_calls;
+        return make_tensor(4);
+    });
+
+    // Reported without being computed
+    EXPECT_TRUE(memory.has_tensor("probs"));
+    EXPECT_TRUE(memory.is_lazy_tensor("probs"));
+    EXPECT_FALSE(memory.is_lazy_tensor("seq_ids"));
+    EXPECT_EQ(num_calls, 0);
+
+    // References to the other tensors stay valid once computed
+    const auto& seq_ids = memory.get_tensor("seq_ids");
+    const auto* data    = seq_ids.data();
+
+    EXPECT_EQ(memory.get_tensor("probs").shape(0), 4);
+    EXPECT_EQ(memory.get_tensor("probs").shape(0), 4);
+    EXPECT_EQ(num_calls, 1);
+    EXPECT_FALSE(memory.is_lazy_tensor("probs"));
+    EXPECT_EQ(seq_ids.data(), data);
+
+    // Lazy tensors are computed when accessing all of the tensors, and checked against the count
+    memory.set_lazy_tensor("logits", [&]() {
+        return make_tensor(3);
+    });
+    EXPECT_THROW(memory.get_tensors(), std::length_error);
+
+    // Setting a tensor replaces the lazy one
+    memory.set_tensor("logits", make_tensor(4));
+    EXPECT_EQ(memory.get_tensors().size(), 3);
+}
@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/objects/tensor_buffer_pool.hpp"
+
+#include <gtest/gtest.h>
+#include <rmm/device_buffer.hpp>
+
+#include <memory>  // for shared_ptr
+
+using namespace morpheus;
+
+TEST_CLASS(TensorBufferPool);
+
+TEST_F(TestTensorBufferPool, ReusesReleasedBuffers)
+{
+    auto pool = TensorBufferPool::create();
+
+    auto buffer = pool->get_buffer(1024);
+    EXPECT_EQ(buffer->size(), 1024);
+    const void* data = buffer->data();
+
+    buffer.reset();
+    EXPECT_EQ(pool->cached_bytes(), 1024);
+
+    // Same size is reused, a different size is allocated
+    auto reused = pool->get_buffer(1024);
+    EXPECT_EQ(reused->data(), data);
+    EXPECT_EQ(pool->cached_bytes(), 0);
+
+    auto other = pool->get_buffer(2048);
+    EXPECT_EQ(other->size(), 2048);
+    EXPECT_EQ(pool->num_allocations(), 2);
+}
+
+TEST_F(TestTensorBufferPool, MaxCachedBytes)
+{
+    auto pool = TensorBufferPool::create(1024);
+
+    auto first  = pool->get_buffer(1024);
+    auto second = pool->get_buffer(1024);
+
+    first.reset();
+    second.reset();
+
+    // Only one of the buffers fits
+    EXPECT_EQ(pool->cached_bytes(), 1024);
+
+    pool->clear();
+    EXPECT_EQ(pool->cached_bytes(), 0);
+}
+
+TEST_F(TestTensorBufferPool, BufferOutlivesPool)
+{
+    auto pool   = TensorBufferPool::create();
+    auto buffer = pool->get_buffer(256);
+
+    pool.reset();
+
+    // Released buffers are freed once the pool is gone
+    EXPECT_EQ(buffer->size(), 256);
+    buffer.reset();
+}
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/utilities/topology.hpp"
+
+#include <gtest/gtest.h>  // for EXPECT_EQ, EXPECT_THROW, TEST_F
+
+#include <stdexcept>  // for invalid_argument
+#include <string>
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(Topology);
+
+TEST_F(TestTopology, ParseCpuList)
+{
+    EXPECT_EQ(TopologyUtil::parse_cpu_list("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(TopologyUtil::parse_cpu_list("5"), (std::vector<int>{5}));
+    EXPECT_TRUE(TopologyUtil::parse_cpu_list("").empty());
+
+    EXPECT_THROW(TopologyUtil::parse_cpu_list("0-a"), std::invalid_argument);
+    EXPECT_THROW(TopologyUtil::parse_cpu_list("cpu0"), std::invalid_argument);
+}
+
+TEST_F(TestTopology, ResolvePlacement)
+{
+    EXPECT_TRUE(TopologyUtil::resolve_placement("").empty());
+
+    EXPECT_THROW(TopologyUtil::resolve_placement("bogus"), std::invalid_argument);
+    EXPECT_THROW(TopologyUtil::resolve_placement("gpu:x"), std::invalid_argument);
+    EXPECT_THROW(TopologyUtil::resolve_placement("numa:"), std::invalid_argument);
+
+    // Unknown nodes and devices resolve to an empty locality, nothing is bound to it
+    EXPECT_TRUE(TopologyUtil::resolve_placement("numa:4096").empty());
+    EXPECT_FALSE(TopologyUtil::bind_current_thread(TopologyUtil::resolve_placement("numa:4096")));
+}
+
+TEST_F(TestTopology, LocalityToString)
+{
+    EXPECT_EQ(DeviceLocality{}.to_string(), "unknown locality");
+
+    DeviceLocality locality{"0000:3b:00.0", 1, {0, 1, 2, 3, 8}};
+    EXPECT_EQ(locality.to_string(), "0000:3b:00.0, NUMA node 1, CPUs 0-3,8");
+}
@@ -0,0 +1,170 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/utilities/trace_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // for count_if, is_sorted
+#include <cstdint>    // for int64_t
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+std::vector<TraceRecord> records_of(trace_event_t event)
+{
+    std::vector<TraceRecord> records;
+    for (const auto& record : TraceBuffer::snapshot())
+    {
+        if (record.event == event)
+        {
+            records.push_back(record);
+        }
+    }
+
+    return records;
+}
+}  // namespace
+
+TEST_CLASS(TraceBuffer);
+
+TEST_F(TestTraceBuffer, RegisterEvent)
+{
+    const auto event = TraceBuffer::register_event("test.register_event");
+    EXPECT_EQ(TraceBuffer::register_event("test.register_event"), event);
+    EXPECT_NE(TraceBuffer::register_event("test.register_event_other"), event);
+    EXPECT_EQ(TraceBuffer::event_names()[event], "test.register_event");
+}
+
+TEST_F(TestTraceBuffer, MacroDisabled)
+{
+    TraceBuffer::set_enabled(false);
+    MORPHEUS_TRACE("test.macro_disabled", 1);
+
+    // The event is only registered on the first enabled call
+    const auto event = TraceBuffer::register_event("test.macro_disabled");
+    EXPECT_TRUE(records_of(event).empty());
+
+    TraceBuffer::set_enabled(true);
+    MORPHEUS_TRACE("test.macro_disabled", 2, 3);
+
+    auto records = records_of(event);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].args[0], 2);
+    EXPECT_EQ(records[0].args[1], 3);
+    EXPECT_EQ(records[0].args[2], 0);
+
+    TraceBuffer::set_enabled(false);
+}
+
+TEST_F(TestTraceBuffer, KeepsMostRecent)
+{
+    const auto event            = TraceBuffer::register_event("test.keeps_most_recent");
+    const int64_t total_records = TraceBuffer::RecordsPerThread + 100;
+
+    // Records from a thread of its own, such that the buffer holds no other event
+    std::thread([&]() {
+        for (int64_t i = 0; i < total_records; ++i)
+        {
+            TraceBuffer::record(event, i);
+        }
+    }).join();
+
+    // Buffers outlive their threads
+    auto records = records_of(event);
+    ASSERT_EQ(records.size(), TraceBuffer::RecordsPerThread);
+    EXPECT_EQ(records.front().args[0], total_records - TraceBuffer::RecordsPerThread);
+    EXPECT_EQ(records.back().args[0], total_records - 1);
+}
+
+TEST_F(TestTraceBuffer, ConcurrentThreads)
+{
+    const auto event       = TraceBuffer::register_event("test.concurrent_threads");
+    const int num_threads  = 4;
+    const int num_per_loop = 1000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < num_per_loop; ++i)
+            {
+                TraceBuffer::record(event, t, i);
+            }
+        });
+    }
+
+    // Snapshots taken while the threads write only hold complete records
+    for (int i = 0; i < 10; ++i)
+    {
+        for (const auto& record : records_of(event))
+        {
+            EXPECT_LT(record.args[0], num_threads);
+            EXPECT_LT(record.args[1], num_per_loop);
+        }
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto records = records_of(event);
+    ASSERT_EQ(records.size(), num_threads * num_per_loop);
+    EXPECT_TRUE(std::is_sorted(records.begin(), records.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.timestamp_ns < rhs.timestamp_ns;
+    }));
+
+    for (int t = 0; t < num_threads; ++t)
+    {
+        EXPECT_EQ(std::count_if(records.begin(),
+                                records.end(),
+                                [t](const auto& record) {
+                                    return record.args[0] == t;
+                                }),
+                  num_per_loop);
+    }
+}
+
+TEST_F(TestTraceBuffer, Dump)
+{
+    const auto event = TraceBuffer::register_event("test.dump");
+    TraceBuffer::record(event, -1, 2, 3, 4);
+
+    const auto path = std::filesystem::temp_directory_path() / "morpheus_test_trace_buffer.bin";
+    TraceBuffer::dump(path.string());
+
+    std::ifstream file(path, std::ios::binary);
+    std::string magic(8, '\0');
+    file.read(magic.data(), magic.size());
+    EXPECT_EQ(magic, "MTRACE01");
+
+    uint32_t num_events = 0;
+    file.read(reinterpret_cast<char*>(&num_events), sizeof(num_events));
+    EXPECT_EQ(num_events, TraceBuffer::event_names().size());
+
+    file.close();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,179 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_utils/common.hpp"        // IWYU pragma: associated
+#include "./test_utils/tensor_utils.hpp"  // for convert_to_host
+
+#include "morpheus/messages/meta.hpp"
+#include "morpheus/objects/user_history_store.hpp"
+
+#include <cudf/column/column.hpp>
+#include <cudf/io/types.hpp>  // for table_with_metadata
+#include <cudf/table/table.hpp>
+#include <gtest/gtest.h>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <chrono>   // for seconds
+#include <cstdint>  // for int64_t
+#include <memory>
+#include <stdexcept>  // for invalid_argument
+#include <string>
+#include <utility>  // for move
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+constexpr int64_t Second = 1'000'000'000;
+
+std::unique_ptr<cudf::column> make_column(cudf::type_id type, const std::vector<int64_t>& values)
+{
+    rmm::device_buffer buffer(values.data(), values.size() * sizeof(int64_t), rmm::cuda_stream_per_thread);
+    rmm::cuda_stream_per_thread.synchronize();
+
+    return std::make_unique<cudf::column>(
+        cudf::data_type{type}, static_cast<cudf::size_type>(values.size()), std::move(buffer), rmm::device_buffer{}, 0);
+}
+
+// Rows with a `timestamp` column of `seconds`, and a `value` column holding the same values
+std::shared_ptr<MessageMeta> make_rows(const std::vector<int64_t>& seconds)
+{
+    std::vector<int64_t> timestamps;
+    for (const auto value : seconds)
+    {
+        timestamps.push_back(value * Second);
+    }
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+    columns.push_back(make_column(cudf::type_id::INT64, seconds));
+    columns.push_back(make_column(cudf::type_id::TIMESTAMP_NANOSECONDS, timestamps));
+
+    cudf::io::table_with_metadata table{std::make_unique<cudf::table>(std::move(columns))};
+    table.metadata.schema_info.emplace_back("value");
+    table.metadata.schema_info.emplace_back("timestamp");
+
+    return MessageMeta::create_from_cpp(std::move(table));
+}
+
+std::vector<int64_t> values_of(const std::shared_ptr<MessageMeta>& meta)
+{
+    return test::convert_to_host<int64_t>(meta->get_info().get_column(0));
+}
+}  // namespace
+
+TEST_CLASS(UserHistoryStore);
+
+TEST_F(TestUserHistoryStore, AppendSortsAndRejectsOverlaps)
+{
+    UserHistoryStore store("timestamp", 0, std::chrono::nanoseconds(0));
+
+    EXPECT_EQ(store.append("alice", *make_rows({3, 1, 2})), HistoryAppendStatus::APPENDED);
+    EXPECT_EQ(store.append("alice", *make_rows({2, 3})), HistoryAppendStatus::NOTHING_NEW);
+    EXPECT_EQ(store.append("alice", *make_rows({0, 2})), HistoryAppendStatus::PRECEDES_HISTORY);
+    EXPECT_EQ(store.append("alice", *make_rows({3, 4})), HistoryAppendStatus::OVERLAPS_HISTORY);
+    EXPECT_EQ(store.append("alice", *make_rows({5, 4})), HistoryAppendStatus::APPENDED);
+
+    // Users are independent
+    EXPECT_EQ(store.append("bob", *make_rows({1})), HistoryAppendStatus::APPENDED);
+
+    EXPECT_EQ(store.count("alice"), 5);
+    EXPECT_EQ(store.pending_count("alice"), 5);
+    EXPECT_EQ(store.num_users(), 2);
+    EXPECT_GT(store.device_bytes(), 0);
+
+    auto window = store.window("alice");
+    EXPECT_EQ(values_of(window), (std::vector<int64_t>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(store.pending_count("alice"), 0);
+
+    EXPECT_EQ(store.window("carol"), nullptr);
+}
+
+TEST_F(TestUserHistoryStore, WindowSharesSingleChunk)
+{
+    UserHistoryStore store("timestamp", 0, std::chrono::nanoseconds(0));
+
+    auto rows = make_rows({1, 2, 3});
+    store.append("alice", *rows);
+
+    // Returned as is until another batch is appended
+    auto window = store.window("alice");
+    EXPECT_EQ(store.window("alice"), window);
+
+    store.append("alice", *make_rows({4}));
+    auto compacted = store.window("alice");
+    EXPECT_NE(compacted, window);
+    EXPECT_EQ(values_of(compacted), (std::vector<int64_t>{1, 2, 3, 4}));
+}
+
+TEST_F(TestUserHistoryStore, TrimRowsKeepsPending)
+{
+    UserHistoryStore store("timestamp", 2, std::chrono::nanoseconds(0));
+
+    // Rows which have not been part of a window are kept past the maximum
+    store.append("alice", *make_rows({1, 2, 3}));
+    EXPECT_EQ(values_of(store.window("alice")), (std::vector<int64_t>{1, 2, 3}));
+
+    store.append("alice", *make_rows({4}));
+    EXPECT_EQ(values_of(store.window("alice")), (std::vector<int64_t>{3, 4}));
+
+    store.append("alice", *make_rows({5, 6, 7}));
+    EXPECT_EQ(values_of(store.window("alice")), (std::vector<int64_t>{5, 6, 7}));
+    EXPECT_EQ(store.count("alice"), 3);
+}
+
+TEST_F(TestUserHistoryStore, TrimDuration)
+{
+    UserHistoryStore store("timestamp", 0, std::chrono::seconds(10));
+
+    store.append("alice", *make_rows({1, 5, 9}));
+    EXPECT_EQ(values_of(store.window("alice")), (std::vector<int64_t>{1, 5, 9}));
+
+    store.append("alice", *make_rows({12, 14}));
+    EXPECT_EQ(values_of(store.window("alice")), (std::vector<int64_t>{5, 9, 12, 14}));
+
+    store.append("alice", *make_rows({30}));
+    EXPECT_EQ(values_of(store.window("alice")), (std::vector<int64_t>{30}));
+
+    store.flush("alice");
+    EXPECT_EQ(store.count("alice"), 0);
+    EXPECT_EQ(store.num_users(), 0);
+    EXPECT_EQ(store.device_bytes(), 0);
+}
+
+TEST_F(TestUserHistoryStore, SpillIdleUsers)
+{
+    // Any second user exceeds the limit
+    UserHistoryStore store("timestamp", 0, std::chrono::nanoseconds(0), 1);
+
+    store.append("alice", *make_rows({1, 2, 3}));
+    const auto alice_bytes = store.device_bytes();
+
+    // Only the rows of bob remain on the device
+    store.append("bob", *make_rows({1, 2}));
+    EXPECT_LT(store.device_bytes(), alice_bytes);
+
+    // Copied back to the device when read
+    EXPECT_EQ(values_of(store.window("alice")), (std::vector<int64_t>{1, 2, 3}));
+}
+
+TEST_F(TestUserHistoryStore, MissingColumns)
+{
+    EXPECT_THROW(UserHistoryStore("time", 0, std::chrono::nanoseconds(0)).append("alice", *make_rows({1})),
+                 std::invalid_argument);
+}
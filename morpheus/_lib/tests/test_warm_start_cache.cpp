@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_utils/common.hpp"  // IWYU pragma: associated
+
+#include "morpheus/utilities/warm_start_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace morpheus;
+
+namespace {
+void write_file(const std::filesystem::path& path, const std::string& contents)
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << contents;
+}
+}  // namespace
+
+class TestWarmStartCache : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() / "morpheus_test_warm_start_cache";
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+
+        m_source = m_directory / "source.txt";
+        write_file(m_source, "source");
+    }
+
+    void TearDown() override
+    {
+        WarmStartCache::set_directory("");
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::filesystem::path m_directory;
+    std::filesystem::path m_source;
+};
+
+TEST_F(TestWarmStartCache, Disabled)
+{
+    WarmStartCache::set_directory("");
+    WarmStartCache::write("test", m_source, "contents");
+
+    EXPECT_FALSE(WarmStartCache::read("test", m_source).has_value());
+}
+
+TEST_F(TestWarmStartCache, ReadWrite)
+{
+    WarmStartCache::set_directory((m_directory / "cache").string());
+    EXPECT_FALSE(WarmStartCache::read("test", m_source).has_value());
+
+    const std::string contents{"binary\0contents", 15};
+    WarmStartCache::write("test", m_source, contents);
+
+    auto cached = WarmStartCache::read("test", m_source);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(*cached, contents);
+
+    // Entries are separate per kind
+    EXPECT_FALSE(WarmStartCache::read("other", m_source).has_value());
+}
+
+TEST_F(TestWarmStartCache, ChangedSourceMisses)
+{
+    WarmStartCache::set_directory((m_directory / "cache").string());
+    WarmStartCache::write("test", m_source, "contents");
+    ASSERT_TRUE(WarmStartCache::read("test", m_source).has_value());
+
+    write_file(m_source, "changed source");
+    EXPECT_FALSE(WarmStartCache::read("test", m_source).has_value());
+}
+
+TEST_F(TestWarmStartCache, MissingSource)
+{
+    WarmStartCache::set_directory((m_directory / "cache").string());
+    WarmStartCache::write("test", m_directory / "missing.txt", "contents");
+
+    EXPECT_FALSE(WarmStartCache::read("test", m_directory / "missing.txt").has_value());
+}
@@ -283,6 +283,36 @@ def install(**kwargs):
               help=("The size of buffered channels to use between nodes in a pipeline. Larger values reduce "
                     "backpressure at the cost of memory. Smaller values will push messages through the "
                     "pipeline quicker. Must be greater than 1 and a power of 2 (i.e. 2, 4, 8, 16, etc.)"))
+@click.option('--trace_timestamps',
+              is_flag=True,
+              default=DEFAULT_CONFIG.trace_timestamps,
+              help=("Stamp the messages entering and exiting each stage, and record the latencies of the sampled "
+                    "messages reaching the sinks to the metrics registry"))
+@click.option('--trace_sample_interval',
+              default=DEFAULT_CONFIG.trace_sample_interval,
+              type=click.IntRange(min=1),
+              help="Record the timestamps of one in every N messages reaching a sink when tracing timestamps")
+@click.option('--gpu_memory_high_watermark',
+              default=DEFAULT_CONFIG.gpu_memory_high_watermark,
+              type=click.FloatRange(min=0.0, max=1.0),
+              help=("Fraction of the GPU memory allocated by the C++ stages above which the Kafka and HTTP sources "
+                    "pause. Disabled when 0"))
+@click.option('--gpu_memory_low_watermark',
+              default=DEFAULT_CONFIG.gpu_memory_low_watermark,
+              type=click.FloatRange(min=0.0, max=1.0),
+              help=("Fraction of the GPU memory below which paused sources resume. Defaults to the high watermark "
+                    "when 0"))
+@click.option('--trace_buffer_dump',
+              default=DEFAULT_CONFIG.trace_buffer_dump,
+              type=click.Path(dir_okay=False, writable=True),
+              help=("Record the trace events of the C++ stages to in-memory ring buffers, dumping them to this path "
+                    "on SIGUSR2 or when a stage reports an error"))
+@click.option('--warm_start_cache_dir',
+              default=DEFAULT_CONFIG.warm_start_cache_dir,
+              type=click.Path(file_okay=False, writable=True),
+              envvar="MORPHEUS_WARM_START_CACHE_DIR",
+              help=("Directory caching the artifacts the C++ stages derive from their input files, such as the "
+                    "device-ready layout of the tokenizer's vocabulary, across restarts"))
 @click.option('--use_cpp',
               default=True,
               type=bool,
@@ -684,6 +714,9 @@ add_command("inf-pytorch",
             "morpheus.stages.inference.auto_encoder_inference_stage.AutoEncoderInferenceStage",
             modes=AE_ONLY)
 add_command("inf-pytorch", "morpheus.stages.inference.pytorch_inference_stage.PyTorchInferenceStage", modes=NOT_AE)
+add_command("inf-tensorrt",
+            "morpheus.stages.inference.tensorrt_inference_stage.TensorRTInferenceStage",
+            modes=NOT_AE)
 add_command("inf-triton", "morpheus.stages.inference.triton_inference_stage.TritonInferenceStage", modes=NOT_AE)
 add_command("mlflow-drift", "morpheus.stages.postprocess.ml_flow_drift_stage.MLFlowDriftStage", modes=NOT_AE)
 add_command("monitor", "morpheus.stages.general.monitor_stage.MonitorStage", modes=ALL)
@@ -704,3 +737,10 @@ add_command("trigger", "morpheus.stages.general.trigger_stage.TriggerStage", mod
 add_command("validate", "morpheus.stages.postprocess.validation_stage.ValidationStage", modes=ALL)
 
 add_command("from-doca", "morpheus.stages.doca.doca_source_stage.DocaSourceStage", modes=NLP_ONLY)
+add_command("from-doca-pcap", "morpheus.stages.doca.doca_pcap_source_stage.DocaPcapSourceStage", modes=NLP_ONLY)
+add_command("doca-flow-aggregation",
+            "morpheus.stages.doca.doca_flow_aggregation_stage.DocaFlowAggregationStage",
+            modes=ALL)
+add_command("doca-stream-reassembly",
+            "morpheus.stages.doca.doca_stream_reassembly_stage.DocaStreamReassemblyStage",
+            modes=ALL)
@@ -15,12 +15,23 @@ Module for common utilities and classes in the Morpheus library.
 """
 
 # Export symbols from the morpheus._lib.common module. Users should never be directly importing morpheus._lib
+from morpheus._lib.common import DenseActivation
+from morpheus._lib.common import DenseLayer
+from morpheus._lib.common import DenseModelStore
+from morpheus._lib.common import DeviceResources
+from morpheus._lib.common import DeviceResourceType
+from morpheus._lib.common import FeatureScalers
 from morpheus._lib.common import FiberQueue
 from morpheus._lib.common import FileTypes
 from morpheus._lib.common import FilterSource
 from morpheus._lib.common import HttpServer
+from morpheus._lib.common import MemoryConfig
+from morpheus._lib.common import MemoryGovernor
+from morpheus._lib.common import MetricsServer
 from morpheus._lib.common import Tensor
+from morpheus._lib.common import TraceBuffer
 from morpheus._lib.common import TypeId
+from morpheus._lib.common import WarmStartCache
 from morpheus._lib.common import determine_file_type
 from morpheus._lib.common import read_file_to_df
 from morpheus._lib.common import typeid_to_numpy_str
@@ -28,13 +39,24 @@ from morpheus._lib.common import write_df_to_file
 
 __all__ = [
     "determine_file_type",
+    "DenseActivation",
+    "DenseLayer",
+    "DenseModelStore",
+    "DeviceResources",
+    "DeviceResourceType",
+    "FeatureScalers",
     "FiberQueue",
     "FileTypes",
     "FilterSource",
     "HttpServer",
+    "MemoryConfig",
+    "MemoryGovernor",
+    "MetricsServer",
     "read_file_to_df",
     "Tensor",
+    "TraceBuffer",
     "typeid_to_numpy_str",
     "TypeId",
+    "WarmStartCache",
     "write_df_to_file",
 ]
@@ -132,6 +132,42 @@ class ConfigFIL(ConfigBase):
     feature_columns: typing.List[str] = None
 
 
+@dataclasses.dataclass
+class ConfigMemory(ConfigBase):
+    """
+    Device memory resources and streams of the C++ stages, installed on the current device when the pipeline is built.
+    Only takes effect when installed before anything has allocated from the device.
+
+    Parameters
+    ----------
+    resource_type : str, default = "pool"
+        Resource at the bottom of the stack, one of "cuda", "pool" or "async".
+    initial_pool_size : int, default = 0
+        Initial size in bytes of the "pool" or "async" resource, half of the free device memory when 0.
+    maximum_pool_size : int, default = 0
+        Size in bytes the "pool" resource may grow to, unbounded when 0.
+    use_arena : bool, default = False
+        Serve small allocations from per thread arenas layered over the resource.
+    arena_size : int, default = 0
+        Size in bytes of the global arena, half of the free device memory when 0.
+    limit : int, default = 0
+        Maximum number of bytes allocated at once, unlimited when 0.
+    log_file : str, default = None
+        CSV file logging every allocation and deallocation.
+    dedicated_streams : bool, default = False
+        Enqueue the work of the stages on a dedicated non-blocking stream of each thread, instead of its per-thread
+        default stream.
+    """
+    resource_type: str = "pool"
+    initial_pool_size: int = 0
+    maximum_pool_size: int = 0
+    use_arena: bool = False
+    arena_size: int = 0
+    limit: int = 0
+    log_file: str = None
+    dedicated_streams: bool = False
+
+
 class PipelineModes(str, Enum):
     """The type of usecases that can be executed by the pipeline is determined by the enum."""
     OTHER = "OTHER"
@@ -191,6 +227,28 @@ class Config(ConfigBase):
         The size of buffered channels to use between nodes in a pipeline. Larger values reduce backpressure at the cost
         of memory. Smaller values will push messages through the pipeline quicker. Must be greater than 1 and a power of
         2 (i.e., 2, 4, 8, 16, etc.).
+    trace_timestamps : bool, default = False
+        Stamp the messages entering and exiting each stage with the `<stage>::entry` and `<stage>::exit` timestamps.
+        Only `MessageMeta`, `MultiMessage` and `ControlMessage` instances are stamped. At the sinks of the pipeline the
+        timestamps of the sampled messages are recorded as the `morpheus_message_latency_seconds` and
+        `morpheus_stage_latency_seconds` histograms of the metrics registry.
+    trace_sample_interval : int, default = 100
+        When `trace_timestamps` is set, record the timestamps of one in every `trace_sample_interval` messages reaching
+        each sink.
+    gpu_memory_high_watermark : float, default = 0.0
+        Fraction of the device memory allocated by the C++ stages above which the Kafka and HTTP sources stop accepting
+        messages, until it drops below `gpu_memory_low_watermark`. Disabled when 0.
+    gpu_memory_low_watermark : float, default = 0.0
+        Fraction of the device memory below which the sources resume, the high watermark being used when 0.
+    trace_buffer_dump : str, default = None
+        Record the trace events of the C++ stages to their in-memory ring buffers, dumping them to this path on SIGUSR2
+        or when a stage reports an error. Decode the dumps with `python -m morpheus.utils.trace_decoder`.
+    warm_start_cache_dir : str, default = None
+        Directory caching the artifacts the C++ stages derive from their input files across restarts, such as the
+        device-ready layout of the tokenizer's vocabulary. Entries are keyed by the path, size and modification time of
+        the file they were derived from. Disabled when None.
+    memory : `ConfigMemory`, default = None
+        Device memory resources of the C++ stages, the current resource of the device being used when None.
 
     Attributes
     ----------
@@ -214,11 +272,22 @@ class Config(ConfigBase):
     model_max_batch_size: int = 8
     edge_buffer_size: int = 128
 
+    trace_timestamps: bool = False
+    trace_sample_interval: int = 100
+
+    gpu_memory_high_watermark: float = 0.0
+    gpu_memory_low_watermark: float = 0.0
+
+    trace_buffer_dump: str = None
+
+    warm_start_cache_dir: str = None
+
     # Class labels to convert class index to label.
     class_labels: typing.List[str] = dataclasses.field(default_factory=list)
 
     ae: ConfigAutoEncoder = dataclasses.field(default=None)
     fil: ConfigFIL = dataclasses.field(default=None)
+    memory: ConfigMemory = dataclasses.field(default=None)
 
     def save(self, filename: str):
         """
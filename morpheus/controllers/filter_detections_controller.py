@@ -19,7 +19,10 @@ import cupy as cp
 import numpy as np
 import typing_utils
 
+import morpheus._lib.messages as _messages
 from morpheus.common import FilterSource
+from morpheus.messages import ControlMessage
+from morpheus.messages import MessageMeta
 from morpheus.messages import MultiMessage
 from morpheus.messages import MultiResponseMessage
 
@@ -38,12 +41,19 @@ class FilterDetectionsController:
         The source used for filtering.
     field_name : str
         The name of the field used for filtering.
+    mask_column : str
+        When set, name of the boolean DataFrame column the result of the filter is written to by `filter_mask`.
     """
 
-    def __init__(self, threshold: float, filter_source: FilterSource, field_name: str) -> None:
+    def __init__(self,
+                 threshold: float,
+                 filter_source: FilterSource,
+                 field_name: str,
+                 mask_column: typing.Optional[str] = None) -> None:
         self._threshold = threshold
         self._filter_source = filter_source
         self._field_name = field_name
+        self._mask_column = mask_column
 
     @property
     def threshold(self):
@@ -66,47 +76,87 @@ class FilterDetectionsController:
         """
         return self._field_name
 
-    def _find_detections(self, x: MultiMessage) -> typing.Union[cp.ndarray, np.ndarray]:
+    @property
+    def mask_column(self):
+        """
+        Get the name of the mask column, `None` unless filtering by mask.
+        """
+        return self._mask_column
+
+    def _find_mask(self, x: MultiMessage | ControlMessage) -> typing.Union[cp.ndarray, np.ndarray]:
         # Determind the filter source
-        if self._filter_source == FilterSource.TENSOR:
+        if isinstance(x, ControlMessage):
+            if self._filter_source == FilterSource.TENSOR:
+                filter_source = x.tensors().get_tensor(self._field_name)
+            else:
+                filter_source = x.payload().get_data(self._field_name).values
+        elif self._filter_source == FilterSource.TENSOR:
             filter_source = x.get_output(self._field_name)
         else:
             filter_source = x.get_meta(self._field_name).values
 
-        if (isinstance(filter_source, np.ndarray)):
-            array_mod = np
-        else:
-            array_mod = cp
-
         # Get per row detections
         detections = (filter_source > self._threshold)
 
         if (len(detections.shape) > 1):
             detections = detections.any(axis=1)
 
+        return detections
+
+    def _find_detections(self, x: MultiMessage | ControlMessage) -> typing.Union[cp.ndarray, np.ndarray]:
+        detections = self._find_mask(x)
+
+        if (isinstance(detections, np.ndarray)):
+            array_mod = np
+        else:
+            array_mod = cp
+
         # Surround in False to ensure we get an even number of pairs
         detections = array_mod.concatenate([array_mod.array([False]), detections, array_mod.array([False])])
 
         return array_mod.where(detections[1:] != detections[:-1])[0].reshape((-1, 2))
 
-    def filter_copy(self, x: MultiMessage) -> MultiMessage:
+    @staticmethod
+    def _select_control_message(x: ControlMessage, rows: typing.Union[slice, cp.ndarray, np.ndarray]) -> ControlMessage:
+        # Selects `rows` of both the payload and the tensors into a new message sharing the config of `x`
+        df = x.payload().get_data()
+        selected_df = df.iloc[rows] if isinstance(rows, slice) else df[rows]
+
+        selected = ControlMessage(x)
+        selected.payload(MessageMeta(selected_df))
+
+        tensors = x.tensors()
+        if tensors is not None:
+            selected_tensors = {name: tensor[rows] for (name, tensor) in tensors.get_tensors().items()}
+            selected.tensors(_messages.TensorMemory(count=len(selected_df), tensors=selected_tensors))
+
+        return selected
+
+    def filter_copy(self, x: MultiMessage | ControlMessage) -> MultiMessage | ControlMessage:
         """
         This function uses a threshold value to filter the messages.
 
         Parameters
         ----------
-        x : `morpheus.pipeline.messages.MultiMessage`
+        x : `morpheus.pipeline.messages.MultiMessage` or `morpheus.messages.ControlMessage`
             Response message with probabilities calculated from inference results.
 
         Returns
         -------
-        `morpheus.pipeline.messages.MultiMessage`
+        `morpheus.pipeline.messages.MultiMessage` or `morpheus.messages.ControlMessage`
             A new message containing a copy of the rows above the threshold.
 
         """
         if x is None:
             return None
 
+        if isinstance(x, ControlMessage):
+            mask = self._find_mask(x)
+            if not mask.any():
+                return None
+
+            return self._select_control_message(x, mask)
+
         true_pairs = self._find_detections(x)
 
         # If we didnt have any detections, return None
@@ -115,18 +165,43 @@ class FilterDetectionsController:
 
         return x.copy_ranges(true_pairs)
 
-    def filter_slice(self, x: MultiMessage) -> typing.List[MultiMessage]:
+    def filter_mask(self, x: MultiMessage | ControlMessage) -> MultiMessage | ControlMessage:
+        """
+        This function writes the result of the threshold to the `mask_column` of the message's DataFrame, without
+        filtering any rows.
+
+        Parameters
+        ----------
+        x : `morpheus.pipeline.messages.MultiMessage` or `morpheus.messages.ControlMessage`
+            Response message with probabilities calculated from inference results.
+
+        Returns
+        -------
+        `morpheus.pipeline.messages.MultiMessage` or `morpheus.messages.ControlMessage`
+            The same message.
+
+        """
+        mask = self._find_mask(x)
+
+        if isinstance(x, ControlMessage):
+            x.payload().set_data(self._mask_column, mask)
+        else:
+            x.set_meta(self._mask_column, mask)
+
+        return x
+
+    def filter_slice(self, x: MultiMessage | ControlMessage) -> typing.List[MultiMessage | ControlMessage]:
         """
         This function uses a threshold value to filter the messages.
 
         Parameters
         ----------
-        x : `morpheus.pipeline.messages.MultiMessage`
+        x : `morpheus.pipeline.messages.MultiMessage` or `morpheus.messages.ControlMessage`
             Response message with probabilities calculated from inference results.
 
         Returns
         -------
-        typing.List[`morpheus.pipeline.messages.MultiMessage`]
+        typing.List[`morpheus.pipeline.messages.MultiMessage` or `morpheus.messages.ControlMessage`]
             List of filtered messages.
 
         """
@@ -137,7 +212,10 @@ class FilterDetectionsController:
             for pair in true_pairs:
                 pair = tuple(pair.tolist())
                 if ((pair[1] - pair[0]) > 0):
-                    output_list.append(x.get_slice(*pair))
+                    if isinstance(x, ControlMessage):
+                        output_list.append(self._select_control_message(x, slice(*pair)))
+                    else:
+                        output_list.append(x.get_slice(*pair))
 
         return output_list
 
@@ -153,7 +231,9 @@ class FilterDetectionsController:
 
         # Unfortunately we have to convert this to a list in case there are non-contiguous groups
         if self._filter_source == FilterSource.Auto:
-            if (typing_utils.issubtype(message_type, MultiResponseMessage)):
+            # Control messages reaching this stage are expected to carry the outputs of inference
+            if (typing_utils.issubtype(message_type, MultiResponseMessage)
+                    or typing_utils.issubtype(message_type, ControlMessage)):
                 self._filter_source = FilterSource.TENSOR
             else:
                 self._filter_source = FilterSource.DATAFRAME
@@ -106,10 +106,18 @@ class SerializeController:
         # Get metadata from columns
         if isinstance(x, MultiMessage):
             df = x.get_meta(self._columns)
+            source_meta = x.meta
         elif isinstance(x, ControlMessage):
             df = x.payload().get_data(columns)
+            source_meta = x.payload()
 
-        return MessageMeta(df=df)
+        meta = MessageMeta(df=df)
+
+        # Like the slices of the C++ implementation, the new meta carries the timestamps set so far
+        for (key, timestamp) in source_meta.filter_timestamp("").items():
+            meta.set_timestamp(key, timestamp)
+
+        return meta
 
     def get_include_col_pattern(self):
         """
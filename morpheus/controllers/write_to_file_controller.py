@@ -20,6 +20,7 @@ import mrc.core.operators as ops
 from morpheus.common import FileTypes
 from morpheus.common import determine_file_type
 from morpheus.io import serializers
+from morpheus.messages import ControlMessage
 from morpheus.messages import MessageMeta
 from morpheus.utils.type_aliases import DataFrameType
 
@@ -122,9 +123,10 @@ class WriteToFileController:
         # Open up the file handle
         with open(self._output_file, "a", encoding='UTF-8') as out_file:
 
-            def write_to_file(x: MessageMeta):
+            def write_to_file(x: MessageMeta | ControlMessage):
 
-                lines = self._convert_to_strings(x.df)
+                meta = x.payload() if isinstance(x, ControlMessage) else x
+                lines = self._convert_to_strings(meta.df)
 
                 out_file.writelines(lines)
 
@@ -15,6 +15,7 @@
 """DataFrame deserializers."""
 
 import io
+import json
 import typing
 
 import pandas as pd
@@ -115,3 +116,52 @@ def read_file_to_df(file_name: typing.Union[str, io.IOBase],
         df = filter_null_data(df)
 
     return df
+
+
+def read_json_records(file_name: str, lines: bool = True, record_path: str = None) -> pd.DataFrame:
+    """
+    Reads a JSON file of nested records into a DataFrame with a column per field, nested fields being named after their
+    path joined with dots, as `pandas.json_normalize` does. When C++ execution is enabled the file is parsed and
+    flattened on the GPU, otherwise each record is flattened by pandas.
+
+    Parameters
+    ----------
+    file_name : str
+        File to read.
+    lines : bool, optional
+        Whether the file holds a record per line rather than a single JSON document, by default True.
+    record_path : str, optional
+        Field holding the records, such as the `Records` array of a CloudTrail log, by default the records are the
+        top level objects of the file. The field may hold a list of records or a single record.
+
+    Returns
+    -------
+    pd.DataFrame
+        The flattened records.
+    """
+    if (CppConfig.get_should_use_cpp()):
+        df = read_file_to_df_cpp(file_name,
+                                 FileTypes.JSON,
+                                 json_lines=lines,
+                                 record_path=record_path or "",
+                                 flatten=True)
+        return df.to_pandas()
+
+    with open(file_name, encoding='UTF-8') as json_in:
+        if (lines):
+            data = [json.loads(line) for line in json_in if line.strip()]
+        else:
+            data = json.load(json_in)
+
+    if (record_path is not None):
+        records = []
+        for row in (data if isinstance(data, list) else [data]):
+            value = row.get(record_path)
+            if isinstance(value, list):
+                records.extend(value)
+            elif value is not None:
+                records.append(value)
+
+        data = records
+
+    return pd.json_normalize(data)
@@ -201,11 +201,14 @@ def write_df_to_file(df: DataFrameType, file_name: str, file_type: FileTypes = F
         filename extension
     **kwargs : dict
         Additional arguments forwarded to the underlying serialization function. Where the underlying serialization
-        function is one of `write_df_to_file_cpp`, `df_to_stream_csv`, or `df_to_stream_json`.
+        function is one of `write_df_to_file_cpp`, `df_to_stream_csv`, or `df_to_stream_json`. The C++
+        implementation accepts `device_write=True` to write through a cuDF file sink, allowing device buffers to be
+        written straight to disk using GPUDirect Storage when it is available.
     """
     if (CppConfig.get_should_use_cpp() and isinstance(df, cudf.DataFrame)):
         # Use the C++ implementation
         write_df_to_file_cpp(df=df, filename=file_name, file_type=file_type, **kwargs)
+        return
 
     mode = file_type
 
@@ -14,8 +14,16 @@
 # limitations under the License.
 """IO utilities."""
 
+import io
+
+import pyarrow as pa
+
+import cudf
+
 from morpheus.utils.type_aliases import DataFrameType
 
+PAYLOAD_FORMATS = ["json", "arrow", "parquet", "avro"]
+
 
 def filter_null_data(x: DataFrameType):
     """
@@ -31,3 +39,33 @@ def filter_null_data(x: DataFrameType):
         return x
 
     return x[~x['data'].isna()]
+
+
+def decode_payloads(payloads: list[bytes], payload_format: str = "json") -> cudf.DataFrame:
+    """
+    Decodes the payloads received by a source stage into a single DataFrame with a row per record, in the order of the
+    payloads. This is the Python counterpart of the `PayloadDecoder` used by the C++ source stages.
+
+    Parameters
+    ----------
+    payloads : list[bytes]
+        Payloads holding one or more records each.
+    payload_format : str, default = "json"
+        Wire format of the payloads, one of `PAYLOAD_FORMATS`. JSON payloads hold a JSON object per line, Arrow
+        payloads an Arrow IPC stream, Parquet payloads a Parquet file and Avro payloads an Avro object container file.
+    """
+    if payload_format == "json":
+        lines = b"".join(payload.rstrip(b"\0") + b"\n" for payload in payloads)
+        return cudf.read_json(io.BytesIO(lines), engine='cudf', lines=True, orient='records')
+
+    if payload_format == "arrow":
+        tables = [pa.ipc.open_stream(payload).read_all() for payload in payloads]
+        return cudf.DataFrame.from_arrow(pa.concat_tables(tables))
+
+    if payload_format == "parquet":
+        return cudf.read_parquet([io.BytesIO(payload) for payload in payloads])
+
+    if payload_format == "avro":
+        return cudf.concat([cudf.read_avro(io.BytesIO(payload)) for payload in payloads], ignore_index=True)
+
+    raise ValueError(f"Unknown payload format '{payload_format}', expected one of {PAYLOAD_FORMATS}")
@@ -0,0 +1,383 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import asyncio
+import logging
+import typing
+
+import cupy as cp
+import pandas as pd
+
+import cudf
+
+from morpheus.llm import LLMContext
+from morpheus.llm import LLMNodeBase
+
+logger = logging.getLogger(__name__)
+
+IMPORT_EXCEPTION = None
+IMPORT_ERROR_MESSAGE = "The ivf_pq and cagra indexes of GPUVectorIndex require the cuvs package to be installed."
+
+try:
+    from cuvs.neighbors import cagra
+    from cuvs.neighbors import ivf_pq
+except ImportError as import_exc:
+    IMPORT_EXCEPTION = import_exc
+
+# Maximum number of query to vector scores computed at once by the brute force search, 256MiB of float32
+_MAX_SCORES = 1 << 26
+
+
+class GPUVectorIndex:
+    """
+    In-process index of a corpus of vectors held in GPU memory, sized for corpora of up to a few million vectors, which
+    are searched without the round trip to a vector database.
+
+    Parameters
+    ----------
+    embeddings : array_like
+        Vectors of the corpus, of shape `(num_vectors, dim)`, copied to the device as float32.
+    documents : list[dict] | cudf.DataFrame | pd.DataFrame | None, optional
+        Document of each vector, whose fields are returned along with its hits, by default None.
+    ids : array_like | None, optional
+        Integer ID of each vector, by default its position in `embeddings`.
+    metric : str, optional
+        One of `l2`, the squared L2 distance, `inner_product` or `cosine`, the cosine similarity, by default "l2".
+    index_type : str, optional
+        One of `brute_force`, exact and computed with CuPy, or the approximate `ivf_pq` and `cagra` indexes of cuVS, by
+        default "brute_force". cuVS is only required by the approximate indexes.
+    index_params : dict | None, optional
+        Arguments of the `IndexParams` of the cuVS index, by default None.
+    search_params : dict | None, optional
+        Arguments of the `SearchParams` of the cuVS index, by default None.
+    """
+
+    METRICS = ("l2", "inner_product", "cosine")
+    INDEX_TYPES = ("brute_force", "ivf_pq", "cagra")
+
+    def __init__(self,
+                 embeddings: typing.Any,
+                 documents: list[dict] | cudf.DataFrame | pd.DataFrame | None = None,
+                 *,
+                 ids: typing.Any = None,
+                 metric: str = "l2",
+                 index_type: str = "brute_force",
+                 index_params: dict | None = None,
+                 search_params: dict | None = None) -> None:
+        if (metric not in self.METRICS):
+            raise ValueError(f"Unsupported metric '{metric}', expected one of {self.METRICS}")
+
+        if (index_type not in self.INDEX_TYPES):
+            raise ValueError(f"Unsupported index type '{index_type}', expected one of {self.INDEX_TYPES}")
+
+        self._embeddings = cp.ascontiguousarray(cp.asarray(embeddings, dtype=cp.float32))
+        if (self._embeddings.ndim != 2 or self._embeddings.shape[0] == 0):
+            raise ValueError("The embeddings must be a non-empty array of shape (num_vectors, dim)")
+
+        num_vectors = self._embeddings.shape[0]
+
+        if (ids is None):
+            self._ids = cp.arange(num_vectors, dtype=cp.int64)
+        else:
+            self._ids = cp.asarray(ids, dtype=cp.int64)
+            if (self._ids.shape != (num_vectors, )):
+                raise ValueError("The ids must hold one ID per vector")
+
+        if (isinstance(documents, cudf.DataFrame)):
+            documents = documents.to_pandas()
+
+        if (isinstance(documents, pd.DataFrame)):
+            documents = documents.to_dict(orient="records")
+
+        if (documents is not None and len(documents) != num_vectors):
+            raise ValueError("The documents must hold one document per vector")
+
+        self._documents = documents
+        self._metric = metric
+        self._index_type = index_type
+        self._search_params = search_params or {}
+
+        if (metric == "cosine"):
+            self._embeddings /= cp.maximum(cp.linalg.norm(self._embeddings, axis=1, keepdims=True), 1e-12)
+
+        # Squared norms of the vectors, the constant term of the L2 distances of the brute force search
+        self._sq_norms = cp.sum(self._embeddings * self._embeddings, axis=1) if metric == "l2" else None
+
+        self._index = None
+        self._index_module = None
+        if (index_type != "brute_force"):
+            self._build_index(index_params or {})
+
+    def _build_index(self, index_params: dict):
+        if IMPORT_EXCEPTION is not None:
+            raise ImportError(IMPORT_ERROR_MESSAGE) from IMPORT_EXCEPTION
+
+        self._index_module = ivf_pq if self._index_type == "ivf_pq" else cagra
+
+        params = {"metric": "sqeuclidean" if self._metric == "l2" else "inner_product", **index_params}
+        self._index = self._index_module.build(self._index_module.IndexParams(**params), self._embeddings)
+
+    @property
+    def size(self) -> int:
+        """Number of vectors of the corpus."""
+        return self._embeddings.shape[0]
+
+    @property
+    def dim(self) -> int:
+        """Dimension of the vectors."""
+        return self._embeddings.shape[1]
+
+    def _brute_force_search(self, queries: cp.ndarray, k: int) -> tuple[cp.ndarray, cp.ndarray]:
+        # Scores of which the lowest are the nearest, computed over chunks of the corpus to bound the memory
+        rows_per_chunk = max(1, _MAX_SCORES // queries.shape[0])
+
+        best_scores = []
+        best_indices = []
+        for start in range(0, self.size, rows_per_chunk):
+            chunk = self._embeddings[start:start + rows_per_chunk]
+            scores = -(queries @ chunk.T)
+            if (self._sq_norms is not None):
+                scores = 2 * scores + self._sq_norms[start:start + rows_per_chunk]
+
+            chunk_k = min(k, chunk.shape[0])
+            indices = cp.argpartition(scores, chunk_k - 1, axis=1)[:, :chunk_k]
+
+            best_scores.append(cp.take_along_axis(scores, indices, axis=1))
+            best_indices.append(indices + start)
+
+        scores = cp.concatenate(best_scores, axis=1)
+        indices = cp.concatenate(best_indices, axis=1)
+
+        order = cp.argsort(scores, axis=1)[:, :k]
+        scores = cp.take_along_axis(scores, order, axis=1)
+        indices = cp.take_along_axis(indices, order, axis=1)
+
+        if (self._sq_norms is not None):
+            # Adds back the squared norms of the queries, constant for each query
+            distances = cp.maximum(scores + cp.sum(queries * queries, axis=1, keepdims=True), 0)
+        else:
+            distances = -scores
+
+        return distances, indices
+
+    def search(self, queries: typing.Any, k: int) -> tuple[cp.ndarray, cp.ndarray]:
+        """
+        Finds the `k` nearest vectors of each query, nearest first.
+
+        Parameters
+        ----------
+        queries : array_like
+            Query vectors, of shape `(num_queries, dim)`.
+        k : int
+            Number of vectors found for each query, capped to the size of the corpus.
+
+        Returns
+        -------
+        tuple[cp.ndarray, cp.ndarray]
+            The distances, or similarities for the `inner_product` and `cosine` metrics, and the positions in the corpus
+            of the vectors found, both of shape `(num_queries, k)`.
+        """
+        queries = cp.ascontiguousarray(cp.asarray(queries, dtype=cp.float32))
+        if (queries.ndim != 2 or queries.shape[1] != self.dim):
+            raise ValueError(f"The queries must be of shape (num_queries, {self.dim})")
+
+        k = min(k, self.size)
+
+        if (self._metric == "cosine"):
+            queries = queries / cp.maximum(cp.linalg.norm(queries, axis=1, keepdims=True), 1e-12)
+
+        if (self._index is None):
+            return self._brute_force_search(queries, k)
+
+        search_params = self._index_module.SearchParams(**self._search_params)
+        distances, indices = self._index_module.search(search_params, self._index, queries, k)
+
+        return cp.asarray(distances), cp.asarray(indices).astype(cp.int64)
+
+    def hits(self, distances: cp.ndarray, indices: cp.ndarray) -> list[list[dict]]:
+        """
+        Converts the results of `search` into the hits of each query, each hit holding the `id` and the `distance` of
+        a vector along with the fields of its document.
+        """
+        ids = self._ids[indices].get().tolist()
+        distances = distances.get().tolist()
+        indices = indices.get().tolist()
+
+        results = []
+        for (query_ids, query_distances, query_indices) in zip(ids, distances, indices):
+            query_hits = []
+            for (vector_id, distance, index) in zip(query_ids, query_distances, query_indices):
+                hit = dict(self._documents[index]) if self._documents is not None else {}
+                hit.update({"id": vector_id, "distance": distance})
+                query_hits.append(hit)
+
+            results.append(query_hits)
+
+        return results
+
+
+class GPURetrieverNode(LLMNodeBase):
+    """
+    Node retrieving the documents nearest to the embeddings of its inputs from a `GPUVectorIndex`, a drop-in
+    replacement of `RetrieverNode` for corpora which fit in GPU memory. The queries of the contexts executing
+    concurrently are batched into a single search, flushed once `max_batch_size` queries are waiting or once the first
+    of them waited for `max_batch_delay` seconds.
+
+    The output of each context holds the hits of each of its queries, each hit holding the `id` and the `distance` of a
+    vector along with the fields of its document.
+
+    Parameters
+    ----------
+    embedding : typing.Callable[[list[str]], typing.Coroutine[typing.Any, typing.Any, list[list[float]]]] | None
+        Callable function for generating vector embeddings, by default None, the input then being the embeddings.
+    index : GPUVectorIndex
+        Index of the corpus searched.
+    k : int, optional
+        Number of documents retrieved for each query, by default 4.
+    max_batch_size : int, optional
+        Number of queries flushing a batch, by default 256.
+    max_batch_delay : float, optional
+        Maximum time in seconds a query waits for others to be batched with, by default 0.002.
+    """
+
+    def __init__(
+        self,
+        *,
+        embedding: typing.Callable[[list[str]], typing.Coroutine[typing.Any, typing.Any, list[list[float]]]] | None,
+        index: GPUVectorIndex,
+        k: int = 4,
+        max_batch_size: int = 256,
+        max_batch_delay: float = 0.002,
+    ) -> None:
+        super().__init__()
+
+        if (k < 1):
+            raise ValueError("k must be greater than 0")
+
+        if (max_batch_size < 1):
+            raise ValueError("max_batch_size must be greater than 0")
+
+        self._embedding = embedding
+        self._index = index
+        self._k = k
+        self._max_batch_size = max_batch_size
+        self._max_batch_delay = max_batch_delay
+
+        # Queries waiting for the next batch, along with the future of their context
+        self._pending: list[tuple[list[list[float]], asyncio.Future]] = []
+        self._num_pending = 0
+        self._flush_handle: asyncio.TimerHandle | None = None
+
+        # Keeps a reference to the running batches, which the event loop only weakly references
+        self._running_batches: set[asyncio.Task] = set()
+
+    def get_input_names(self) -> list[str]:
+        """
+        Get the input names for the GPURetrieverNode.
+
+        Returns
+        -------
+        list[str]
+            List of input names for the GPURetrieverNode.
+        """
+        if (self._embedding is None):
+            return ["embedding"]
+
+        return ["query"]
+
+    def _flush(self):
+        if (self._flush_handle is not None):
+            self._flush_handle.cancel()
+            self._flush_handle = None
+
+        if (len(self._pending) == 0):
+            return
+
+        batch = self._pending
+        self._pending = []
+        self._num_pending = 0
+
+        task = asyncio.ensure_future(self._search_batch(batch))
+        self._running_batches.add(task)
+        task.add_done_callback(self._running_batches.discard)
+
+    async def _search_batch(self, batch: list[tuple[list[list[float]], asyncio.Future]]):
+        queries = [query for (embeddings, _) in batch for query in embeddings]
+
+        def search() -> list[list[dict]]:
+            distances, indices = self._index.search(queries, self._k)
+            return self._index.hits(distances, indices)
+
+        try:
+            # The search synchronizes with the device, run it off the event loop
+            hits = await asyncio.get_running_loop().run_in_executor(None, search)
+        except Exception as e:
+            for (_, future) in batch:
+                if (not future.done()):
+                    future.set_exception(e)
+            return
+
+        logger.debug("Searched %d queries of %d contexts", len(queries), len(batch))
+
+        offset = 0
+        for (embeddings, future) in batch:
+            if (not future.done()):
+                future.set_result(hits[offset:offset + len(embeddings)])
+            offset += len(embeddings)
+
+    async def _search(self, embeddings: list[list[float]]) -> list[list[dict]]:
+        if (len(embeddings) == 0):
+            return []
+
+        loop = asyncio.get_running_loop()
+        future = loop.create_future()
+
+        self._pending.append((embeddings, future))
+        self._num_pending += len(embeddings)
+
+        if (self._num_pending >= self._max_batch_size):
+            self._flush()
+        elif (self._flush_handle is None):
+            self._flush_handle = loop.call_later(self._max_batch_delay, self._flush)
+
+        return await future
+
+    async def execute(self, context: LLMContext):  # pylint: disable=invalid-overridden-method
+        """
+        Execute the retrieval process based on the provided context.
+
+        Parameters
+        ----------
+        context : LLMContext
+            Context object containing necessary information for execution.
+
+        Returns
+        -------
+        LLMContext
+            Updated context object after the execution.
+        """
+
+        if (self._embedding is not None):
+            input_strings: list[str] = typing.cast(list[str], context.get_input())
+
+            embeddings = await self._embedding(input_strings)
+        else:
+            embeddings: list[list[float]] = typing.cast(list[list[float]], context.get_input())
+
+        results = await self._search(embeddings)
+
+        context.set_output(results)
+
+        return context
@@ -0,0 +1,228 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import asyncio
+import functools
+import hashlib
+import json
+import logging
+import typing
+from collections import OrderedDict
+
+from morpheus.llm import InputMap
+from morpheus.llm import LLMContext
+from morpheus.llm import LLMNodeBase
+from morpheus.service.vdb.vector_db_service import VectorDBResourceService
+
+logger = logging.getLogger(__name__)
+
+
+class LLMCacheNode(LLMNodeBase):
+    """
+    Caches the responses of a node generating one response per prompt, such as `LLMGenerateNode`, which it wraps. Each
+    row of the inputs is first looked up in an in-memory cache keyed by a hash of its values. When an `embedding` and a
+    `service` are provided, the rows which missed are then looked up by similarity of their `key_input` value, a cached
+    response being used when its prompt lies within `max_distance` of the prompt. The wrapped node only executes on the
+    remaining rows, and their responses are added to the caches, the vector database being filled in the background.
+
+    The outputs of the wrapped node must be a list, or a dict of lists, holding one value per row.
+
+    Parameters
+    ----------
+    node : LLMNodeBase
+        The node whose responses are cached.
+    max_entries : int, optional
+        Maximum number of responses held by the in-memory cache, the least recently used being evicted first, by
+        default 1024.
+    key_input : str, optional
+        Name of the input embedded for the similarity lookups, by default the first input of `node`.
+    embedding : typing.Callable[[list[str]], typing.Coroutine[typing.Any, typing.Any, list[list[float]]]] | None
+        Callable function generating the embeddings of the prompts, by default None disabling the similarity lookups.
+    service : VectorDBResourceService | None
+        Vector database resource holding the cached responses, by default None disabling the similarity lookups. The
+        collection requires a `prompt` and a `response` varchar field along with its vector field.
+    max_distance : float, optional
+        Maximum L2 distance between the embeddings of two prompts for them to share a response, by default 0.1.
+    vector_field : str, optional
+        Name of the vector field of the collection, by default "embedding".
+    """
+
+    def __init__(self,
+                 node: LLMNodeBase,
+                 *,
+                 max_entries: int = 1024,
+                 key_input: str | None = None,
+                 embedding: typing.Callable[[list[str]], typing.Coroutine[typing.Any, typing.Any, list[list[float]]]]
+                 | None = None,
+                 service: VectorDBResourceService | None = None,
+                 max_distance: float = 0.1,
+                 vector_field: str = "embedding") -> None:
+        super().__init__()
+
+        if (max_entries < 1):
+            raise ValueError("max_entries must be greater than 0")
+
+        if ((embedding is None) != (service is None)):
+            raise ValueError("Similarity lookups require both an embedding and a service")
+
+        self._node = node
+        self._max_entries = max_entries
+        self._key_input = key_input or node.get_input_names()[0]
+        self._embedding = embedding
+        self._service = service
+        self._max_distance = max_distance
+        self._vector_field = vector_field
+
+        # Maps the key of a row to its response, and whether the response is part of a dict output
+        self._cache: OrderedDict[str, tuple[typing.Any, bool]] = OrderedDict()
+
+        # Keeps a reference to the pending inserts, which the event loop only weakly references
+        self._pending_inserts: set[asyncio.Future] = set()
+
+    def get_input_names(self) -> list[str]:
+        return self._node.get_input_names()
+
+    @staticmethod
+    def _row_key(inputs: dict[str, list], input_names: list[str], row: int) -> str:
+        values = json.dumps([inputs[name][row] for name in input_names], sort_keys=True, default=str)
+        return hashlib.sha256(values.encode("utf-8")).hexdigest()
+
+    def _cache_get(self, key: str) -> tuple[typing.Any, bool] | None:
+        entry = self._cache.get(key)
+        if (entry is not None):
+            self._cache.move_to_end(key)
+
+        return entry
+
+    def _cache_put(self, key: str, entry: tuple[typing.Any, bool]):
+        self._cache[key] = entry
+        self._cache.move_to_end(key)
+
+        while (len(self._cache) > self._max_entries):
+            self._cache.popitem(last=False)
+
+    async def _similarity_lookup(self, prompts: list[str]) -> tuple[list[list[float]], list[tuple[typing.Any, bool]]]:
+        embeddings = await self._embedding(prompts)
+
+        results = await self._service.similarity_search(embeddings=embeddings,
+                                                        k=1,
+                                                        param={
+                                                            "metric_type": "L2",
+                                                            "params": {
+                                                                "ef": 10, "radius": self._max_distance
+                                                            }
+                                                        })
+
+        entries = []
+        for hits in results:
+            if (len(hits) > 0):
+                entries.append(tuple(json.loads(hits[0]["response"])))
+            else:
+                entries.append(None)
+
+        return embeddings, entries
+
+    def _insert(self, prompts: list[str], embeddings: list[list[float]], entries: list[tuple[typing.Any, bool]]):
+        data = [{
+            "prompt": prompt, "response": json.dumps(list(entry)), self._vector_field: embedding
+        } for (prompt, embedding, entry) in zip(prompts, embeddings, entries)]
+
+        # The insert blocks on the database, run it off the event loop
+        future = asyncio.get_running_loop().run_in_executor(None, functools.partial(self._service.insert, data))
+
+        self._pending_inserts.add(future)
+
+        def on_done(done: asyncio.Future):
+            self._pending_inserts.discard(done)
+            if (not done.cancelled() and done.exception() is not None):
+                logger.warning("Failed to add %d responses to the cache: %s", len(data), done.exception())
+
+        future.add_done_callback(on_done)
+
+    async def _generate(self, context: LLMContext, inputs: dict[str, list], input_names: list[str],
+                        rows: list[int]) -> list[tuple[typing.Any, bool]]:
+        num_rows = len(inputs[input_names[0]])
+
+        if (len(rows) == num_rows):
+            # Nothing was cached, the wrapped node executes on this context
+            await self._node.execute(context)
+            outputs = context.view_outputs
+        else:
+            # The wrapped node reads the inputs of the missing rows from the outputs of a context of its own
+            root_context = LLMContext(context.task(), context.message())
+            root_context.set_output({name: [inputs[name][row] for row in rows] for name in input_names})
+
+            miss_context = root_context.push("cache_miss", [InputMap(f"/{name}", name) for name in input_names])
+
+            await self._node.execute(miss_context)
+            outputs = miss_context.view_outputs
+
+        if (isinstance(outputs, dict)):
+            if (any(not isinstance(values, list) or len(values) != len(rows) for values in outputs.values())):
+                raise ValueError("LLMCacheNode expects the outputs of the wrapped node to hold one value per input")
+
+            return [({key: values[i] for (key, values) in outputs.items()}, True) for i in range(len(rows))]
+
+        if (not isinstance(outputs, list) or len(outputs) != len(rows)):
+            raise ValueError("LLMCacheNode expects the outputs of the wrapped node to hold one value per input")
+
+        return [(value, False) for value in outputs]
+
+    async def execute(self, context: LLMContext) -> LLMContext:  # pylint: disable=invalid-overridden-method
+
+        inputs: dict[str, list] = context.get_inputs()
+        input_names = self.get_input_names()
+        num_rows = len(inputs[input_names[0]])
+
+        keys = [self._row_key(inputs, input_names, row) for row in range(num_rows)]
+        entries = [self._cache_get(key) for key in keys]
+
+        missing_rows = [row for (row, entry) in enumerate(entries) if entry is None]
+        missing_embeddings = None
+
+        if (len(missing_rows) > 0 and self._service is not None):
+            prompts = [inputs[self._key_input][row] for row in missing_rows]
+            embeddings, similar_entries = await self._similarity_lookup(prompts)
+
+            missing_embeddings = []
+            still_missing = []
+            for (row, embedding, entry) in zip(missing_rows, embeddings, similar_entries):
+                if (entry is not None):
+                    entries[row] = entry
+                    self._cache_put(keys[row], entry)
+                else:
+                    still_missing.append(row)
+                    missing_embeddings.append(embedding)
+
+            missing_rows = still_missing
+
+        if (len(missing_rows) > 0):
+            generated = await self._generate(context, inputs, input_names, missing_rows)
+
+            for (row, entry) in zip(missing_rows, generated):
+                entries[row] = entry
+                self._cache_put(keys[row], entry)
+
+            if (self._service is not None):
+                self._insert([inputs[self._key_input][row] for row in missing_rows], missing_embeddings, generated)
+
+        if (entries and entries[0][1]):
+            outputs = {key: [entry[0][key] for entry in entries] for key in entries[0][0].keys()}
+        else:
+            outputs = [entry[0] for entry in entries]
+
+        context.set_output(outputs)
+
+        return context
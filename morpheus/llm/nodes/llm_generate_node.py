@@ -33,6 +33,10 @@ class LLMGenerateNode(LLMNodeBase):
 
     input_names : list[str], optional
         The names of the inputs to this node. Defaults to `["prompt"]`.
+
+    When the engine streams partial outputs, see the `streaming` argument of `LLMEngineStage`, the responses are
+    generated with `LLMClient.generate_batch_stream_async` and each piece of text is written to the context with
+    `LLMContext.stream_output` as `{"index": <index of the prompt>, "text": <text>}` as soon as it is generated.
     """
 
     def __init__(self, llm_client: LLMClient) -> None:
@@ -43,12 +47,24 @@ class LLMGenerateNode(LLMNodeBase):
     def get_input_names(self) -> list[str]:
         return self._llm_client.get_input_names()
 
+    async def _generate_stream(self, context: LLMContext, inputs: dict[str, list[str]]) -> list[str]:
+        responses: list[list[str]] = [[] for _ in next(iter(inputs.values()))]
+
+        async for (index, text) in self._llm_client.generate_batch_stream_async(inputs):
+            responses[index].append(text)
+            context.stream_output({"index": index, "text": text})
+
+        return ["".join(response) for response in responses]
+
     async def execute(self, context: LLMContext) -> LLMContext:  # pylint: disable=invalid-overridden-method
 
         # Get the inputs
         inputs: dict[str, list[str]] = context.get_inputs()
 
-        results = await self._llm_client.generate_batch_async(inputs)
+        if (context.is_streaming()):
+            results = await self._generate_stream(context, inputs)
+        else:
+            results = await self._llm_client.generate_batch_async(inputs)
 
         context.set_output(results)
 
@@ -19,6 +19,7 @@ import typing
 
 from morpheus.llm import LLMContext
 from morpheus.llm import LLMNodeBase
+from morpheus.llm import LLMPromptTemplateNode
 
 logger = logging.getLogger(__name__)
 
@@ -33,12 +34,20 @@ class PromptTemplateNode(LLMNodeBase):
         The template string to populate.
     template_format : str, optional default="f-string"
         The format of the template string. Must be one of: f-string, jinja.
+    native : bool, optional default=True
+        Populate f-string templates with an `LLMPromptTemplateNode`, which formats the rows without executing python
+        code per row, when the fields of the template are named without a format spec or conversion. Lists and dicts
+        are then formatted as JSON rather than by `str`.
     """
 
-    def __init__(self, template: str, template_format: typing.Literal["f-string", "jinja"] = "f-string") -> None:
+    def __init__(self,
+                 template: str,
+                 template_format: typing.Literal["f-string", "jinja"] = "f-string",
+                 native: bool = True) -> None:
         super().__init__()
         self._template = template
         self._template_format = template_format
+        self._native_node: LLMPromptTemplateNode | None = None
 
         if (self._template_format == "f-string"):
             formatter = string.Formatter()
@@ -53,6 +62,9 @@ class PromptTemplateNode(LLMNodeBase):
                 if field_name is not None:
                     self._input_names.append(field_name)
 
+            if (native and LLMPromptTemplateNode.is_supported(self._template)):
+                self._native_node = LLMPromptTemplateNode(self._template)
+
         elif (self._template_format == "jinja"):
             from jinja2 import Template
             from jinja2 import meta
@@ -68,6 +80,9 @@ class PromptTemplateNode(LLMNodeBase):
 
     async def execute(self, context: LLMContext):  # pylint: disable=invalid-overridden-method
 
+        if (self._native_node is not None):
+            return await self._native_node.execute(context)
+
         # Get the keys from the task
         input_dict = context.get_inputs()
 
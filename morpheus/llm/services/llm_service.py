@@ -113,6 +113,23 @@ class LLMClient(ABC):
         """
         pass
 
+    async def generate_batch_stream_async(self, inputs: dict[str, list]) -> typing.AsyncIterator[tuple[int, str]]:
+        """
+        Issue an asynchronous request to generate a list of responses based on a list of prompts, yielding the text of
+        the responses as it is generated. Each item is the index of a prompt along with the text generated for it since
+        the previous item of the same prompt. Clients which do not support streaming yield each response at once, after
+        all of them are generated.
+
+        Parameters
+        ----------
+        inputs : dict
+            Inputs containing prompt data.
+        """
+        results = await self.generate_batch_async(inputs, return_exceptions=False)
+
+        for (i, result) in enumerate(results):
+            yield (i, result)
+
 
 class LLMService(ABC):
     """
@@ -18,6 +18,7 @@ import os
 import typing
 import warnings
 
+from morpheus.llm import LLMAdmissionController
 from morpheus.llm.services.llm_service import LLMClient
 from morpheus.llm.services.llm_service import LLMService
 
@@ -46,12 +47,20 @@ class NeMoLLMClient(LLMClient):
         The parent service for this client.
     model_name : str
         The name of the model to interact with.
+    admission_controller : LLMAdmissionController, optional
+        Controller admitting the asynchronous requests, each retry waiting to be admitted again. By default None,
+        requests being sent immediately.
 
     model_kwargs : dict[str, typing.Any]
         Additional keyword arguments to pass to the model when generating text.
     """
 
-    def __init__(self, parent: "NeMoLLMService", *, model_name: str, **model_kwargs) -> None:
+    def __init__(self,
+                 parent: "NeMoLLMService",
+                 *,
+                 model_name: str,
+                 admission_controller: LLMAdmissionController | None = None,
+                 **model_kwargs) -> None:
         if IMPORT_EXCEPTION is not None:
             raise ImportError(IMPORT_ERROR_MESSAGE) from IMPORT_EXCEPTION
 
@@ -63,6 +72,7 @@ class NeMoLLMClient(LLMClient):
         self._model_name = model_name
         self._model_kwargs = model_kwargs
         self._prompt_key = "prompt"
+        self._admission_controller = admission_controller
 
     def get_input_names(self) -> list[str]:
         return [self._prompt_key]
@@ -131,6 +141,11 @@ class NeMoLLMClient(LLMClient):
         errors = []
 
         while iterations < self._parent._retry_count:
+            if (self._admission_controller is not None):
+                # Roughly 4 characters per token, plus the tokens the completion may use
+                await self._admission_controller.acquire(
+                    len(prompt) // 4 + self._model_kwargs.get("tokens_to_generate", 0))
+
             fut = await asyncio.wrap_future(
                 self._parent._conn.generate(model=self._model_name,
                                             prompt=prompt,
@@ -143,8 +158,15 @@ class NeMoLLMClient(LLMClient):
             if result.get('status', None) == 'fail':
                 iterations += 1
                 errors.append(result.get('msg', 'Unknown error'))
+
+                if (self._admission_controller is not None):
+                    self._admission_controller.on_rate_limited()
+
                 continue
 
+            if (self._admission_controller is not None):
+                self._admission_controller.on_success()
+
             return result['text']
 
         raise RuntimeError(
@@ -190,7 +212,12 @@ class NeMoLLMService(LLMService):
     A service for interacting with NeMo LLM models, this class should be used to create a client for a specific model.
     """
 
-    def __init__(self, *, api_key: str = None, org_id: str = None, retry_count=5) -> None:
+    def __init__(self,
+                 *,
+                 api_key: str = None,
+                 org_id: str = None,
+                 retry_count=5,
+                 admission_controller: LLMAdmissionController | None = None) -> None:
         """
         Creates a service for interacting with NeMo LLM models.
 
@@ -205,6 +232,10 @@ class NeMoLLMService(LLMService):
             `api_key` is a member of multiple NGC organizations., by default None
         retry_count : int, optional
             The number of times to retry a request before raising an exception, by default 5
+        admission_controller : LLMAdmissionController, optional
+            Controller admitting the asynchronous requests of every client of this service, such that they stay within
+            the rate limits of the account together. Failed requests decrease the request rate, and are retried once
+            admitted again rather than immediately. By default None
 
         """
 
@@ -216,6 +247,7 @@ class NeMoLLMService(LLMService):
         org_id = org_id if org_id is not None else os.environ.get("NGC_ORG_ID", None)
 
         self._retry_count = retry_count
+        self._admission_controller = admission_controller
 
         self._conn = nemollm.NemoLLM(
             api_host=os.environ.get("NGC_API_BASE", None),
@@ -243,4 +275,7 @@ class NeMoLLMService(LLMService):
             Additional keyword arguments to pass to the model when generating text.
         """
 
-        return NeMoLLMClient(self, model_name=model_name, **model_kwargs)
+        return NeMoLLMClient(self,
+                             model_name=model_name,
+                             admission_controller=self._admission_controller,
+                             **model_kwargs)
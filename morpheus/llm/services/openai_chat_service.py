@@ -17,11 +17,13 @@ import logging
 import os
 import time
 import typing
+from contextlib import asynccontextmanager
 from contextlib import contextmanager
 from textwrap import dedent
 
 import appdirs
 
+from morpheus.llm import LLMAdmissionController
 from morpheus.llm.services.llm_service import LLMClient
 from morpheus.llm.services.llm_service import LLMService
 
@@ -81,6 +83,10 @@ class OpenAIChatClient(LLMClient):
     max_retries: int, optional default=10
         The maximum number of retries to attempt when making a request to the OpenAI API.
 
+    admission_controller: LLMAdmissionController, optional default=None
+        Controller admitting the asynchronous requests, shared with the other clients of the same account such that
+        their requests stay within its rate limits together. By default None, requests being sent immediately.
+
     model_kwargs : dict[str, typing.Any]
         Additional keyword arguments to pass to the model when generating text.
     """
@@ -94,6 +100,7 @@ class OpenAIChatClient(LLMClient):
                  model_name: str,
                  set_assistant: bool = False,
                  max_retries: int = 10,
+                 admission_controller: LLMAdmissionController | None = None,
                  **model_kwargs) -> None:
         if IMPORT_EXCEPTION is not None:
             raise ImportError(IMPORT_ERROR_MESSAGE) from IMPORT_EXCEPTION
@@ -108,6 +115,7 @@ class OpenAIChatClient(LLMClient):
         self._set_assistant = set_assistant
         self._prompt_key = "prompt"
         self._assistant_key = "assistant"
+        self._admission_controller = admission_controller
 
         # Preserve original configuration.
         self._model_kwargs = copy.deepcopy(model_kwargs)
@@ -143,6 +151,25 @@ class OpenAIChatClient(LLMClient):
                                   api_logger.outputs,
                                   message_id)
 
+    @asynccontextmanager
+    async def _admitted(self, messages: list["openai.types.chat.ChatCompletionMessageParam"]):
+        if (self._admission_controller is None):
+            yield
+            return
+
+        # Roughly 4 characters per token, plus the tokens the completion may use
+        tokens = sum(len(message["content"]) for message in messages) // 4 + self._model_kwargs.get("max_tokens", 0)
+
+        await self._admission_controller.acquire(tokens)
+
+        try:
+            yield
+        except openai.RateLimitError as exc:
+            self._admission_controller.on_rate_limited(dict(exc.response.headers))
+            raise
+
+        self._admission_controller.on_success()
+
     def _create_messages(self,
                          prompt: str,
                          assistant: str = None) -> list["openai.types.chat.ChatCompletionMessageParam"]:
@@ -211,9 +238,10 @@ class OpenAIChatClient(LLMClient):
         with self._api_logger(inputs=messages) as msg_logger:
 
             try:
-                output = await self._client_async.chat.completions.create(model=self._model_name,
-                                                                          messages=messages,
-                                                                          **self._model_kwargs)
+                async with self._admitted(messages):
+                    output = await self._client_async.chat.completions.create(model=self._model_name,
+                                                                              messages=messages,
+                                                                              **self._model_kwargs)
             except Exception as exc:
                 self._parent._logger.error("Error generating completion: %s", exc)
                 raise
@@ -310,13 +338,86 @@ class OpenAIChatClient(LLMClient):
 
         return await asyncio.gather(*coros, return_exceptions=return_exceptions)
 
+    async def _generate_stream_async(self,
+                                     index: int,
+                                     prompt: str,
+                                     assistant: str,
+                                     queue: asyncio.Queue[tuple[int, str] | None]):
+
+        messages = self._create_messages(prompt, assistant)
+
+        with self._api_logger(inputs=messages) as msg_logger:
+
+            content = []
+
+            try:
+                async with self._admitted(messages):
+                    stream = await self._client_async.chat.completions.create(model=self._model_name,
+                                                                              messages=messages,
+                                                                              stream=True,
+                                                                              **self._model_kwargs)
+
+                async for chunk in stream:
+                    if (len(chunk.choices) > 0 and chunk.choices[0].delta.content):
+                        content.append(chunk.choices[0].delta.content)
+                        await queue.put((index, chunk.choices[0].delta.content))
+
+            except Exception as exc:
+                self._parent._logger.error("Error generating completion: %s", exc)
+                raise
+
+            msg_logger.set_output("".join(content))
+
+    async def generate_batch_stream_async(self, inputs: dict[str, list]) -> typing.AsyncIterator[tuple[int, str]]:
+        """
+        Issue an asynchronous request to generate a list of responses based on a list of prompts, yielding the tokens
+        of the responses as the model streams them. Each item is the index of a prompt along with the text generated
+        for it since the previous item of the same prompt.
+
+        Parameters
+        ----------
+        inputs : dict
+            Inputs containing prompt data.
+        """
+        prompts = inputs[self._prompt_key]
+        assistants = None
+        if (self._set_assistant):
+            assistants = inputs[self._assistant_key]
+            if len(prompts) != len(assistants):
+                raise ValueError("The number of prompts and assistants must be equal.")
+
+        queue: asyncio.Queue[tuple[int, str] | None] = asyncio.Queue()
+
+        async def generate_all():
+            try:
+                await asyncio.gather(*[
+                    self._generate_stream_async(i, prompt, assistants[i] if assistants is not None else None, queue)
+                    for (i, prompt) in enumerate(prompts)
+                ])
+            finally:
+                await queue.put(None)
+
+        task = asyncio.ensure_future(generate_all())
+
+        try:
+            while ((item := await queue.get()) is not None):
+                yield item
+
+            # Raises the error of a failed generation
+            await task
+        finally:
+            task.cancel()
+
 
 class OpenAIChatService(LLMService):
     """
     A service for interacting with OpenAI Chat models, this class should be used to create clients.
     """
 
-    def __init__(self, *, default_model_kwargs: dict = None) -> None:
+    def __init__(self,
+                 *,
+                 default_model_kwargs: dict = None,
+                 admission_controller: LLMAdmissionController | None = None) -> None:
         """
         Creates a service for interacting with OpenAI Chat models, this class should be used to create clients.
 
@@ -327,6 +428,10 @@ class OpenAIChatService(LLMService):
             will automatically be used when calling `get_client`. Arguments specified in the `get_client` function will
             overwrite default values specified here. This is useful to set model arguments before creating multiple
             clients. By default None
+        admission_controller : LLMAdmissionController, optional
+            Controller admitting the asynchronous requests of every client of this service, such that they stay within
+            the rate limits of the account together. Consider lowering `max_retries` of the clients, rate limited
+            requests being retried by the `openai` package without waiting for the controller. By default None
 
         Raises
         ------
@@ -339,6 +444,7 @@ class OpenAIChatService(LLMService):
         super().__init__()
 
         self._default_model_kwargs = default_model_kwargs or {}
+        self._admission_controller = admission_controller
 
         self._logger = logging.getLogger(f"{__package__}.{OpenAIChatService.__name__}")
 
@@ -394,4 +500,5 @@ class OpenAIChatService(LLMService):
                                 model_name=model_name,
                                 set_assistant=set_assistant,
                                 max_retries=max_retries,
+                                admission_controller=self._admission_controller,
                                 **final_model_kwargs)
@@ -134,6 +134,72 @@ class TensorMemory(MessageData, cpp_class=_messages.TensorMemory):
         """
         return self._tensors[name]
 
+    def get_tensor_object(self, name: str):
+        """
+        Get the Tensor stored in the container identified by `name`, without converting it to a CuPy array. When C++
+        execution is enabled, the returned object is a `morpheus._lib.common.Tensor` implementing both
+        `__cuda_array_interface__` and `__dlpack__`, such that consumers can create an array of their own from it.
+
+        Parameters
+        ----------
+        name : str
+            Tensor key name.
+
+        Returns
+        -------
+        typing.Any
+            Tensor.
+
+        Raises
+        ------
+        KeyError
+            If tensor name does not exist in the container.
+        """
+        return self._tensors[name]
+
+    def get_tensor_shape(self, name: str) -> typing.List[int]:
+        """
+        Get the shape of the Tensor identified by `name`, without creating a CuPy array when C++ execution is enabled.
+
+        Parameters
+        ----------
+        name : str
+            Tensor key name.
+
+        Returns
+        -------
+        typing.List[int]
+            Shape of the tensor.
+
+        Raises
+        ------
+        KeyError
+            If tensor name does not exist in the container.
+        """
+        return list(self._tensors[name].shape)
+
+    def get_tensor_dtype(self, name: str) -> str:
+        """
+        Get the numpy type string (ex: "<f4") of the Tensor identified by `name`, without creating a CuPy array when C++
+        execution is enabled.
+
+        Parameters
+        ----------
+        name : str
+            Tensor key name.
+
+        Returns
+        -------
+        str
+            Type string of the tensor.
+
+        Raises
+        ------
+        KeyError
+            If tensor name does not exist in the container.
+        """
+        return self._tensors[name].dtype.str
+
     def _get_tensor_prop(self, name: str):
         """
         This method is intended to be used by propery methods in subclasses
@@ -13,7 +13,9 @@
 # limitations under the License.
 
 import dataclasses
+import datetime
 import logging
+import re
 import threading
 import typing
 import warnings
@@ -81,6 +83,7 @@ class MessageMeta(MessageBase, cpp_class=_messages.MessageMeta):
     """
     _df: DataFrameType = dataclasses.field(init=False)
     _mutex: threading.RLock = dataclasses.field(init=False, repr=False)
+    _timestamps: dict[str, datetime.datetime] = dataclasses.field(init=False, repr=False)
 
     def __init__(self, df: DataFrameType) -> None:
         super().__init__()
@@ -89,6 +92,7 @@ class MessageMeta(MessageBase, cpp_class=_messages.MessageMeta):
 
         self._mutex = threading.RLock()
         self._df = df
+        self._timestamps = {}
 
     @property
     def df(self) -> DataFrameType:
@@ -165,6 +169,42 @@ class MessageMeta(MessageBase, cpp_class=_messages.MessageMeta):
     def get_column_names(self) -> list[str]:
         return self._df.columns.to_list()
 
+    def set_timestamp(self, key: str, timestamp: datetime.datetime):
+        """
+        Set a timestamp for a given key, replacing any previous value.
+        """
+        with self._mutex:
+            self._timestamps[key] = timestamp
+
+    def get_timestamp(self, key: str, fail_if_nonexist: bool = False) -> datetime.datetime | None:
+        """
+        Retrieve the timestamp for a given key. Returns None if the timestamp does not exist and `fail_if_nonexist` is
+        False.
+        """
+        with self._mutex:
+            timestamp = self._timestamps.get(key)
+
+        if (timestamp is None and fail_if_nonexist):
+            raise RuntimeError("Timestamp for the specified key does not exist.")
+
+        return timestamp
+
+    def filter_timestamp(self, regex_filter: str) -> dict[str, datetime.datetime]:
+        """
+        Retrieve the timestamps whose key matches a regex filter.
+        """
+        # `re` caches the compiled expressions
+        pattern = re.compile(regex_filter)
+
+        with self._mutex:
+            return {key: timestamp for (key, timestamp) in self._timestamps.items() if pattern.search(key)}
+
+    def acknowledge(self):
+        """
+        Acknowledge that the data has been fully handled, called by sinks once it has been written. Only messages
+        emitted by the C++ sources carry an acknowledgement, for all other messages this is a no-op.
+        """
+
     def get_meta_range(self,
                        mess_offset: int,
                        message_count: int,
@@ -21,6 +21,7 @@ from mrc.core import operators as ops
 import morpheus._lib.stages as _stages
 from morpheus.common import FilterSource
 from morpheus.controllers.filter_detections_controller import FilterDetectionsController
+from morpheus.messages import ControlMessage
 from morpheus.utils.module_ids import FILTER_DETECTIONS
 from morpheus.utils.module_ids import MORPHEUS_MODULE_NAMESPACE
 from morpheus.utils.module_utils import register_module
@@ -103,12 +104,17 @@ def filter_detections(builder: mrc.Builder):
     controller.update_filter_source(message_type=message_type)
 
     if use_cpp:
-        node = _stages.FilterDetectionsStage(builder,
-                                             FILTER_DETECTIONS,
-                                             controller.threshold,
-                                             copy,
-                                             controller.filter_source,
-                                             controller.field_name)
+        if (message_type == ControlMessage):
+            stage_class = _stages.FilterDetectionsControlMessageStage
+        else:
+            stage_class = _stages.FilterDetectionsMultiMessageStage
+
+        node = stage_class(builder,
+                           FILTER_DETECTIONS,
+                           controller.threshold,
+                           copy,
+                           controller.filter_source,
+                           controller.field_name)
     else:
         if copy:
             node = builder.make_node(FILTER_DETECTIONS,
@@ -16,9 +16,15 @@ import logging
 import pickle
 import time
 import typing
+from collections import deque
+from concurrent.futures import Future
+from concurrent.futures import ThreadPoolExecutor
 from dataclasses import dataclass
 
+import cupy as cp
 import mrc
+import numpy as np
+import pyarrow as pa
 from mrc.core import operators as ops
 from pydantic import ValidationError
 
@@ -69,6 +75,22 @@ def preprocess_vdb_resources(service, recreate: bool, resource_schemas: dict):
             service.create(name=resource_name, **resource_schema_config)
 
 
+def embeddings_to_series(embeddings: cp.ndarray, index: cudf.Index) -> cudf.Series:
+    """
+    Converts the rows of a 2D embeddings tensor to a list column, building its values and offsets as arrays rather
+    than creating a Python object for every element. Float16 embeddings are written as float32, which cuDF supports.
+    """
+    values = cp.asnumpy(embeddings)
+    if (values.dtype == np.float16):
+        values = values.astype(np.float32)
+    offsets = np.arange(values.shape[0] + 1, dtype=np.int32) * values.shape[1]
+
+    series = cudf.Series.from_arrow(pa.ListArray.from_arrays(pa.array(offsets), pa.array(values.ravel())))
+    series.index = index
+
+    return series
+
+
 @dataclass
 class AccumulationStats:
     msg_count: int
@@ -100,6 +122,8 @@ def _write_to_vector_db(builder: mrc.Builder):
     - 'batch_size': int, accumulates messages until reaching the specified batch size for writing to VDB.
     - 'write_time_interval': float, specifies the time interval (in seconds) for writing messages, or writing messages
     when the accumulated batch size is reached.
+    - 'max_in_flight_writes': int, number of writes performed in the background while the following messages are
+    accumulated, the oldest write being waited for once this many are in flight. When 0 the writes are synchronous.
 
     Raises
     ------
@@ -130,6 +154,7 @@ def _write_to_vector_db(builder: mrc.Builder):
     service_kwargs = write_to_vdb_config.service_kwargs
     batch_size = write_to_vdb_config.batch_size
     write_time_interval = write_to_vdb_config.write_time_interval
+    max_in_flight_writes = write_to_vdb_config.max_in_flight_writes
 
     # Check if service is serialized and convert if needed
     # pylint: disable=not-a-mapping
@@ -140,9 +165,34 @@ def _write_to_vector_db(builder: mrc.Builder):
 
     accumulator_dict = {default_resource_name: AccumulationStats(msg_count=0, last_insert_time=-1, data=[])}
 
+    executor = ThreadPoolExecutor(max_workers=max_in_flight_writes) if max_in_flight_writes > 0 else None
+    pending_writes: deque[Future] = deque()
+
+    def wait_for_oldest_write():
+        try:
+            pending_writes.popleft().result()
+        except Exception as e:
+            logger.error("Unable to upload dataframe entries to vector database: %s", e)
+
+    def insert_dataframe(resource_name: str, df: cudf.DataFrame, **kwargs):
+        if executor is None:
+            service.insert_dataframe(name=resource_name, df=df, **kwargs)
+            return
+
+        while len(pending_writes) >= max_in_flight_writes:
+            wait_for_oldest_write()
+
+        pending_writes.append(executor.submit(service.insert_dataframe, name=resource_name, df=df, **kwargs))
+
     def on_completed():
         final_df_references = []
 
+        while pending_writes:
+            wait_for_oldest_write()
+
+        if executor is not None:
+            executor.shutdown()
+
         # Pushing remaining messages
         for key, accum_stats in accumulator_dict.items():
             try:
@@ -169,7 +219,7 @@ def _write_to_vector_db(builder: mrc.Builder):
             df = msg.get_meta()
             if df is not None and not df.empty:
                 embeddings = msg.get_probs_tensor()
-                df[embedding_column_name] = embeddings.tolist()
+                df[embedding_column_name] = embeddings_to_series(embeddings, df.index)
         elif isinstance(msg, MultiMessage):
             df = msg.get_meta()
         else:
@@ -213,7 +263,7 @@ def _write_to_vector_db(builder: mrc.Builder):
                             merged_df = cudf.concat(accum_stats.data)
 
                             # pylint: disable=not-a-mapping
-                            service.insert_dataframe(name=key, df=merged_df, **resource_kwargs)
+                            insert_dataframe(key, merged_df, **resource_kwargs)
                             # Reset accumulator stats
                             accum_stats.data.clear()
                             accum_stats.last_insert_time = current_time
@@ -38,6 +38,7 @@ class WriteToVDBSchema(BaseModel):
     service_kwargs: dict = Field(default_factory=dict)
     batch_size: int = 1024
     write_time_interval: float = 1.0
+    max_in_flight_writes: int = 0
 
     @validator('service', pre=True)
     def validate_service(cls, to_validate):  # pylint: disable=no-self-argument
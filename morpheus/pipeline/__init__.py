@@ -33,6 +33,7 @@ All objects related to building and running a pipeline.
 # isort: off
 
 from morpheus.pipeline.boundary_stage_mixin import BoundaryStageMixin
+from morpheus.pipeline.column_projection_mixin import ColumnProjectionMixin
 from morpheus.pipeline.preallocator_mixin import PreallocatorMixin
 from morpheus.pipeline.stage_schema import PortSchema
 from morpheus.pipeline.stage_schema import StageSchema
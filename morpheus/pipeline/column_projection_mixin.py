@@ -0,0 +1,56 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Mixin used by source stages which are able to drop the columns no downstream stage reads."""
+
+import re
+from abc import ABC
+
+from morpheus.utils.type_aliases import DataFrameType
+
+
+class ColumnProjectionMixin(ABC):
+    """
+    Mixin intended to be added to source stages parsing records into DataFrames. During pre-build the pipeline collects
+    the columns read by the stages fed by the source, see `StageBase.get_read_columns`, and when every one of them
+    declares the columns it reads, sets their union with `set_column_projection`. The source then drops the other
+    columns right after parsing, such that they are neither kept in memory nor copied by downstream stages.
+    """
+
+    _column_projection: list[str] = []
+
+    def set_column_projection(self, column_projection: list[str]):
+        """
+        Sets the case insensitive regular expressions matching the columns to keep, an empty list keeps every column.
+        This should only be called by the Pipeline at build time.
+        """
+        self._column_projection = column_projection
+
+    def get_column_projection(self) -> list[str]:
+        """
+        Returns the regular expressions matching the columns kept by this source, empty when every column is kept.
+        """
+        return self._column_projection.copy()
+
+    def _apply_column_projection(self, df: DataFrameType) -> DataFrameType:
+        if len(self._column_projection) == 0:
+            return df
+
+        patterns = [re.compile(pattern, re.IGNORECASE) for pattern in self._column_projection]
+        columns = [col for col in df.columns if any(pattern.search(col) is not None for pattern in patterns)]
+
+        # A DataFrame without columns has no rows
+        if len(columns) == 0:
+            columns = [df.columns[0]]
+
+        return df[columns]
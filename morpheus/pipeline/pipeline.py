@@ -13,11 +13,13 @@
 # limitations under the License.
 
 import asyncio
+import contextlib
 import logging
 import os
 import signal
 import sys
 import threading
+import time
 import typing
 from collections import OrderedDict
 from collections import defaultdict
@@ -30,6 +32,7 @@ from tqdm import tqdm
 
 import morpheus.pipeline as _pipeline  # pylint: disable=cyclic-import
 from morpheus.config import Config
+from morpheus.config import CppConfig
 from morpheus.utils.type_utils import pretty_print_type_name
 
 logger = logging.getLogger(__name__)
@@ -80,6 +83,12 @@ class Pipeline():
         self.batch_size = config.pipeline_batch_size
         self.edge_buffer_size = config.edge_buffer_size
 
+        self._memory_config = config.memory
+        self._gpu_memory_high_watermark = config.gpu_memory_high_watermark
+        self._gpu_memory_low_watermark = config.gpu_memory_low_watermark
+        self._trace_buffer_dump = config.trace_buffer_dump
+        self._warm_start_cache_dir = config.warm_start_cache_dir
+
         self._segment_graphs = defaultdict(lambda: networkx.DiGraph())
 
         self._state = PipelineState.INITIALIZED
@@ -91,10 +100,37 @@ class Pipeline():
         # Future that allows post_start to propagate exceptions back to pipeline
         self._post_start_future: asyncio.Future = None
 
+        # Duration in seconds of each phase of the start up of the pipeline, in the order they ran
+        self._startup_timings: typing.Dict[str, float] = OrderedDict()
+        self._startup_begin: float = None
+
     @property
     def state(self) -> PipelineState:
         return self._state
 
+    @property
+    def startup_timings(self) -> typing.Dict[str, float]:
+        """
+        Duration in seconds of each phase of the start up of the pipeline, from its pre-build to the start of its
+        executor, in the order they ran. Only holds the phases which ran so far. The segments being built when the
+        executor starts, their phases are part of the `start executor` phase.
+        """
+        return dict(self._startup_timings)
+
+    @contextlib.contextmanager
+    def _time_startup_phase(self, phase: str):
+        start = time.perf_counter()
+        try:
+            yield
+        finally:
+            self._startup_timings[phase] = time.perf_counter() - start
+
+    def _log_startup_timings(self):
+        total = time.perf_counter() - self._startup_begin
+        report = "\n".join(f"  {phase}: {duration * 1000:.1f} ms" for phase, duration in self._startup_timings.items())
+
+        logger.info("Pipeline started in %.1f ms\n%s", total * 1000, report)
+
     def _assert_not_built(self):
         assert self._state == PipelineState.INITIALIZED, "Pipeline has already been built. Cannot modify pipeline."
 
@@ -260,6 +296,17 @@ class Pipeline():
                 for stage in preallocator_stages:
                     stage.set_needed_columns(needed_columns)
 
+            # Sources able to drop columns only keep those read by the stages they feed
+            for stage in segment_graph.nodes():
+                if (isinstance(stage, _pipeline.ColumnProjectionMixin)):
+                    column_projection = self._collect_read_columns(segment_graph, stage)
+                    if (len(column_projection) > 0):
+                        logger.debug("Stage %s only keeps the columns matching %s",
+                                     stage.unique_name,
+                                     column_projection)
+
+                    stage.set_column_projection(column_projection)
+
             if (not all(x.is_pre_built for x in segment_graph.nodes())):
                 logger.warning("Cyclic pipeline graph detected! Building with reduced constraints")
 
@@ -279,6 +326,59 @@ class Pipeline():
 
         logger.info("====Pipeline Pre-build Complete!====")
 
+    @staticmethod
+    def _collect_read_columns(segment_graph: networkx.DiGraph, source: _pipeline.StageBase) -> list[str]:
+        """
+        Returns the union of the columns read by the stages fed by `source`, not looking past the stages which emit a
+        new DataFrame. An empty list, keeping every column, is returned when any of these stages does not declare the
+        columns it reads, which is also the case of the egress stages of the segment.
+        """
+        read_columns = []
+        visited = {source}
+        pending = list(segment_graph.successors(source))
+
+        while (len(pending) > 0):
+            stage = pending.pop()
+            if (stage in visited):
+                continue
+
+            visited.add(stage)
+
+            stage_columns = stage.get_read_columns()
+            if (stage_columns is None):
+                return []
+
+            read_columns.extend(col for col in stage_columns if col not in read_columns)
+
+            if (not stage.emits_new_dataframe()):
+                pending.extend(segment_graph.successors(stage))
+
+        return read_columns
+
+    def _install_device_resources(self):
+        from morpheus.common import DeviceResources
+        from morpheus.common import DeviceResourceType
+        from morpheus.common import MemoryConfig
+
+        # Several pipelines of a process share the resources of the device, only the first one installs them
+        if (DeviceResources.is_installed()):
+            logger.warning("Device resources are already installed, ignoring the memory config of the pipeline")
+            return
+
+        memory = self._memory_config
+
+        config = MemoryConfig()
+        config.resource_type = DeviceResourceType.__members__[memory.resource_type.upper()]
+        config.initial_pool_size = memory.initial_pool_size
+        config.maximum_pool_size = memory.maximum_pool_size
+        config.use_arena = memory.use_arena
+        config.arena_size = memory.arena_size
+        config.limit = memory.limit
+        config.log_file = memory.log_file or ""
+        config.dedicated_streams = memory.dedicated_streams
+
+        DeviceResources.install(config)
+
     def build(self):
         """
         This function sequentially activates all the Morpheus pipeline stages passed by the users to execute a
@@ -291,7 +391,32 @@ class Pipeline():
         assert self._state == PipelineState.INITIALIZED, "Pipeline can only be built once!"
         assert len(self._sources) > 0, "Pipeline must have a source stage"
 
-        self._pre_build()
+        self._startup_begin = time.perf_counter()
+
+        with self._time_startup_phase("pre-build"):
+            self._pre_build()
+
+        if (self._memory_config is not None and CppConfig.get_should_use_cpp()):
+            with self._time_startup_phase("install device resources"):
+                self._install_device_resources()
+
+        # The governor is installed as the device memory resource, before the C++ stages allocate from it
+        if (self._gpu_memory_high_watermark > 0 and CppConfig.get_should_use_cpp()):
+            from morpheus.common import MemoryGovernor
+            MemoryGovernor.install(self._gpu_memory_high_watermark,
+                                   self._gpu_memory_low_watermark or self._gpu_memory_high_watermark)
+
+        if (self._trace_buffer_dump is not None and CppConfig.get_should_use_cpp()):
+            from morpheus.common import TraceBuffer
+            TraceBuffer.set_enabled(True)
+            TraceBuffer.dump_on_signal(int(signal.SIGUSR2), self._trace_buffer_dump)
+            TraceBuffer.dump_on_error(self._trace_buffer_dump)
+            logger.info("Tracing to the trace buffers, dumping them to %s on SIGUSR2", self._trace_buffer_dump)
+
+        # Set before the stages are built, as they load their artifacts when constructed
+        if (self._warm_start_cache_dir is not None and CppConfig.get_should_use_cpp()):
+            from morpheus.common import WarmStartCache
+            WarmStartCache.set_directory(self._warm_start_cache_dir)
 
         logger.info("====Registering Pipeline====")
 
@@ -302,11 +427,16 @@ class Pipeline():
         exec_options.topology.user_cpuset = f"0-{self._num_threads - 1}"
         exec_options.engine_factories.default_engine_type = mrc.core.options.EngineType.Thread
 
-        self._mrc_executor = mrc.Executor(exec_options)
+        with self._time_startup_phase("create executor"):
+            self._mrc_executor = mrc.Executor(exec_options)
 
         mrc_pipeline = mrc.Pipeline()
 
         def inner_build(builder: mrc.Builder, segment_id: str):
+            with self._time_startup_phase(f"build segment {segment_id}"):
+                inner_build_segment(builder, segment_id)
+
+        def inner_build_segment(builder: mrc.Builder, segment_id: str):
             logger.info("====Building Segment: %s====", segment_id)
             segment_graph = self._segment_graphs[segment_id]
 
@@ -348,7 +478,8 @@ class Pipeline():
 
         logger.info("====Building Pipeline Complete!====")
 
-        self._mrc_executor.register_pipeline(mrc_pipeline)
+        with self._time_startup_phase("register pipeline"):
+            self._mrc_executor.register_pipeline(mrc_pipeline)
 
         with self._mutex:
             self._state = PipelineState.BUILT
@@ -394,10 +525,13 @@ class Pipeline():
 
         logger.info("====Starting Pipeline====")
 
-        self._mrc_executor.start()
+        with self._time_startup_phase("start executor"):
+            self._mrc_executor.start()
 
         logger.info("====Pipeline Started====")
 
+        self._log_startup_timings()
+
         async def post_start(executor):
 
             try:
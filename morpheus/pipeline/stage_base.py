@@ -14,15 +14,18 @@
 # limitations under the License.
 
 import collections
+import datetime
 import functools
 import inspect
 import logging
+import re
 import typing
 import warnings
 from abc import ABC
 from abc import abstractmethod
 
 import mrc
+from mrc.core import operators as ops
 
 import morpheus.pipeline as _pipeline  # pylint: disable=cyclic-import
 from morpheus.config import Config
@@ -64,6 +67,32 @@ def _save_init_vals(func: _DecoratorType) -> _DecoratorType:
     return typing.cast(_DecoratorType, inner)
 
 
+def _make_timestamp_fn(stage_name: str, is_exit: bool, sample_interval: int) -> typing.Callable:
+    """
+    Returns the function stamping messages in Python, used when the messages are Python objects or derived message types
+    the native `TimestampStage` cannot emit.
+    """
+    # Imported here since the messages import the pipeline
+    from morpheus._lib.messages import TimestampTraceExporter
+    from morpheus.messages import MultiMessage
+
+    key = f"{stage_name}::{'exit' if is_exit else 'entry'}"
+    exporter = TimestampTraceExporter(stage_name) if sample_interval > 0 else None
+    message_count = AtomicInteger(0)
+
+    def stamp(message):
+        # MultiMessages are stamped on their meta, shared by all of the messages sliced from it
+        stamped = message.meta if isinstance(message, MultiMessage) else message
+        stamped.set_timestamp(key, datetime.datetime.now())
+
+        if (exporter is not None and message_count.get_and_inc() % sample_interval == 0):
+            exporter.record(stamped.filter_timestamp(""))
+
+        return message
+
+    return stamp
+
+
 class StageBase(ABC, collections.abc.Hashable):
     """
     This abstract class serves as the morpheus pipeline's base class. This class wraps a `mrc.SegmentObject`
@@ -99,6 +128,9 @@ class StageBase(ABC, collections.abc.Hashable):
         # Mapping of {`column_name`: `TyepId`}
         self._needed_columns = collections.OrderedDict()
 
+        # Regular expressions matching the columns read from incoming DataFrames, `None` when unknown
+        self._read_columns: typing.Optional[list[str]] = None
+
         # Schema of the stage
         self._schema = _pipeline.StageSchema(self)
 
@@ -388,6 +420,14 @@ class StageBase(ABC, collections.abc.Hashable):
 
         in_ports_nodes = [x.get_input_node(builder=builder) for x in self.input_ports]
 
+        if (self._config.trace_timestamps):
+            # Messages are exported when entering a stage without any outputs
+            in_ports_nodes = [
+                self._build_timestamp_node(builder, node, port.input_type, port.port_number, is_exit=False,
+                                           is_sink=len(self.output_ports) == 0)
+                for (node, port) in zip(in_ports_nodes, self.input_ports)
+            ]
+
         out_ports_nodes = self._build(builder=builder, input_nodes=in_ports_nodes)
 
         # Allow stages to do any post build steps (i.e., for sinks, or timing functions)
@@ -396,6 +436,14 @@ class StageBase(ABC, collections.abc.Hashable):
         assert len(out_ports_nodes) == len(self.output_ports), \
             "Build must return same number of output pairs as output ports"
 
+        if (self._config.trace_timestamps):
+            # Or when exiting through a port without any downstream stages
+            out_ports_nodes = [
+                self._build_timestamp_node(builder, node, port.output_type, port.port_number, is_exit=True,
+                                           is_sink=len(port._output_receivers) == 0)
+                for (node, port) in zip(out_ports_nodes, self.output_ports)
+            ]
+
         # Assign the output ports
         for port_idx, out_node in enumerate(out_ports_nodes):
             self.output_ports[port_idx]._output_node = out_node
@@ -445,6 +493,48 @@ class StageBase(ABC, collections.abc.Hashable):
     ) -> list[mrc.SegmentObject]:
         return out_ports_nodes
 
+    def _build_timestamp_node(self, builder: mrc.Builder, node: mrc.SegmentObject, message_type: type,
+                              port_number: int, is_exit: bool, is_sink: bool) -> mrc.SegmentObject:
+        """
+        Stamps the messages of `message_type` flowing through `node` when `Config.trace_timestamps` is set, returning the
+        node downstream stages should connect to. At the sinks, the timestamps of one in every
+        `Config.trace_sample_interval` messages are recorded to the metrics registry.
+        """
+        from morpheus.messages import ControlMessage
+        from morpheus.messages import MessageMeta
+        from morpheus.messages import MultiMessage
+
+        if (not inspect.isclass(message_type)
+                or not issubclass(message_type, (MessageMeta, MultiMessage, ControlMessage))):
+            return node
+
+        node_name = f"{self.unique_name}-ts-{'exit' if is_exit else 'entry'}[{port_number}]"
+        sample_interval = self._config.trace_sample_interval if is_sink else 0
+
+        # The native node emits its exact message type, derived types are stamped in Python instead
+        if (CppConfig.get_should_use_cpp() and message_type in (MessageMeta, MultiMessage, ControlMessage)):
+            import morpheus._lib.stages as _stages
+
+            if (message_type is MessageMeta):
+                node_cls = _stages.TimestampMessageMetaStage
+            elif (message_type is MultiMessage):
+                node_cls = _stages.TimestampMultiMessageStage
+            else:
+                node_cls = _stages.TimestampControlMessageStage
+
+            ts_node = node_cls(builder,
+                               node_name,
+                               stage_name=self.unique_name,
+                               is_exit=is_exit,
+                               sample_interval=sample_interval)
+        else:
+            ts_node = builder.make_node(node_name,
+                                        ops.map(_make_timestamp_fn(self.unique_name, is_exit, sample_interval)))
+
+        builder.make_edge(node, ts_node)
+
+        return ts_node
+
     def _start(self):
         pass
 
@@ -476,6 +566,31 @@ class StageBase(ABC, collections.abc.Hashable):
         """
         return self._needed_columns.copy()
 
+    def get_read_columns(self) -> typing.Optional[list[str]]:
+        """
+        Stages which only read some of the columns of the DataFrame of incoming messages should populate
+        `self._read_columns` with case insensitive regular expressions matching these columns, leaving it empty when no
+        column is read. Sources implementing `ColumnProjectionMixin` only keep the columns read by the stages they feed.
+        Returns `None`, keeping every column, when the stage does not declare the columns it reads.
+        """
+        if (self._read_columns is None):
+            return None
+
+        return self._read_columns.copy()
+
+    def emits_new_dataframe(self) -> bool:
+        """
+        Returns whether the messages emitted by this stage hold a new DataFrame built from the columns returned by
+        `get_read_columns`, such that the stages downstream of it do not read the DataFrame of incoming messages.
+        """
+        return False
+
+    def _set_read_column_names(self, column_names: typing.Iterable[str]):
+        """
+        Declares the columns read by this stage by their exact names, see `get_read_columns`.
+        """
+        self._read_columns = [f"^{re.escape(name)}$" for name in column_names]
+
     @abstractmethod
     def compute_schema(self, schema: _pipeline.StageSchema):
         """
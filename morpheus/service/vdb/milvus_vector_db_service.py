@@ -380,7 +380,9 @@ class MilvusVectorDBResourceService(VectorDBResourceService):
         k : int, optional
             The number of nearest neighbors to return, by default 4.
         **kwargs : dict[str, typing.Any]
-            Extra keyword arguments specific to the vector database implementation.
+            Extra keyword arguments specific to the vector database implementation. The search parameters default to
+            `{"metric_type": "L2", "params": {"ef": 10}}` and can be replaced with the `param` keyword, for instance
+            to set a `radius` bounding the distance of the results.
 
         Returns
         -------
@@ -395,7 +397,7 @@ class MilvusVectorDBResourceService(VectorDBResourceService):
         # Determine result metadata fields.
         output_fields = [x.name for x in self._fields if x.name != self._vector_field]
 
-        params = {"metric_type": "L2", "params": {"ef": 10}}
+        params = kwargs.pop("param", {"metric_type": "L2", "params": {"ef": 10}})
 
         response = self._collection.search(data=embeddings,
                                            anns_field=self._vector_field,
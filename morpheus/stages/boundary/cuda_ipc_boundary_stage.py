@@ -0,0 +1,153 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Boundary stages connecting the segments of a pipeline running in two processes of the same host over CUDA IPC."""
+
+import typing
+
+import mrc
+
+import morpheus._lib.stages as _stages
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.pipeline.boundary_stage_mixin import BoundaryStageMixin
+from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
+from morpheus.pipeline.single_output_source import SingleOutputSource
+from morpheus.pipeline.single_port_stage import SinglePortStage
+from morpheus.pipeline.stage_schema import StageSchema
+
+
+def _validate_ring_name(ring_name: str):
+    if (not ring_name or "/" in ring_name):
+        raise ValueError(f"Invalid ring name: '{ring_name}', expected a non-empty name without '/'")
+
+
+class CudaIpcBoundaryEgressStage(BoundaryStageMixin, PassThruTypeMixin, SinglePortStage):
+    """
+    Egress point of a pipeline segment continued in another process of the same host, the counterpart of
+    `UcxBoundaryEgressStage` for co-located processes. Each incoming `ControlMessage` is exported to the
+    `CudaIpcBoundaryIngressStage` of the other process, then passed through.
+
+    Only a compact header holding the config of the message and the layout of its payload and tensors is written to a
+    ring in shared memory. The device buffers of the columns and tensors are exported through CUDA IPC handles, without
+    a copy, and held until the other process released the message. At most `num_slots` messages are held, the stage
+    waiting for the other process beyond that.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    ring_name : str
+        Name of the ring, shared with the ingress.
+    num_slots : int
+        Messages exported and not yet released by the ingress.
+    max_header_bytes : int
+        Size of the largest header, which grows with the number of columns and the tasks of the messages.
+    close_timeout : float
+        Seconds to wait on completion for the ingress to release every message.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 ring_name: str,
+                 num_slots: int = 64,
+                 max_header_bytes: int = 65536,
+                 close_timeout: float = 60.0):
+        super().__init__(c)
+
+        _validate_ring_name(ring_name)
+
+        if (num_slots <= 0):
+            raise ValueError(f"Invalid number of slots: {num_slots}")
+
+        if (max_header_bytes <= 0):
+            raise ValueError(f"Invalid max header bytes: {max_header_bytes}")
+
+        self._ring_name = ring_name
+        self._num_slots = num_slots
+        self._max_header_bytes = max_header_bytes
+        self._close_timeout = close_timeout
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "cuda-ipc-boundary-egress"
+
+    def accepted_types(self) -> typing.Tuple:
+        """Input types accepted by this stage."""
+        return (ControlMessage, )
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("CudaIpcBoundaryEgressStage does not support Python nodes")
+
+        node = _stages.CudaIpcSinkStage(builder,
+                                        self.unique_name,
+                                        ring_name=self._ring_name,
+                                        num_slots=self._num_slots,
+                                        max_header_bytes=self._max_header_bytes,
+                                        close_timeout_ms=int(self._close_timeout * 1000))
+        builder.make_edge(input_node, node)
+
+        return node
+
+
+class CudaIpcBoundaryIngressStage(BoundaryStageMixin, SingleOutputSource):
+    """
+    Ingress point of a pipeline segment continued from another process of the same host, emitting the `ControlMessage`
+    objects exported by the `CudaIpcBoundaryEgressStage` of the other process. The exported buffers are mapped, then
+    copied device to device into the emitted message, each message being released to the other process right after.
+    The stage completes once the egress completes.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    ring_name : str
+        Name of the ring, shared with the egress.
+    open_timeout : float
+        Seconds to wait for the egress to create the ring.
+    """
+
+    def __init__(self, c: Config, ring_name: str, open_timeout: float = 60.0):
+        super().__init__(c)
+
+        _validate_ring_name(ring_name)
+
+        self._ring_name = ring_name
+        self._open_timeout = open_timeout
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "cuda-ipc-boundary-ingress"
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def compute_schema(self, schema: StageSchema):
+        schema.output_schema.set_type(ControlMessage)
+
+    def _build_source(self, builder: mrc.Builder) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("CudaIpcBoundaryIngressStage does not support Python nodes")
+
+        return _stages.CudaIpcSourceStage(builder,
+                                          self.unique_name,
+                                          ring_name=self._ring_name,
+                                          open_timeout_ms=int(self._open_timeout * 1000))
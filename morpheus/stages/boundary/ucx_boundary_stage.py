@@ -0,0 +1,130 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Boundary stages connecting the segments of a pipeline running on two nodes over UCX."""
+
+import typing
+
+import mrc
+
+import morpheus._lib.stages as _stages
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.pipeline.boundary_stage_mixin import BoundaryStageMixin
+from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
+from morpheus.pipeline.single_output_source import SingleOutputSource
+from morpheus.pipeline.single_port_stage import SinglePortStage
+from morpheus.pipeline.stage_schema import StageSchema
+
+
+class UcxBoundaryEgressStage(BoundaryStageMixin, PassThruTypeMixin, SinglePortStage):
+    """
+    Egress point of a pipeline segment continued on another node, the counterpart of `LinearBoundaryEgressStage` across
+    processes. Each incoming `ControlMessage` is sent to the `UcxBoundaryIngressStage` of the other node, then passed
+    through.
+
+    Only a compact header holding the config of the message and the layout of its payload and tensors is serialized,
+    the device buffers of the columns and tensors are sent as they are, GPU to GPU over GPUDirect RDMA when the nodes
+    support it. The transports are selected by UCX, see the `UCX_TLS` environment variable.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    address : str
+        Address of the node running the ingress.
+    port : int
+        Port the ingress listens on.
+    connect_timeout : float
+        Seconds to wait for the ingress to listen.
+    """
+
+    def __init__(self, c: Config, address: str, port: int, connect_timeout: float = 60.0):
+        super().__init__(c)
+
+        if (port <= 0 or port > 65535):
+            raise ValueError(f"Invalid port: {port}")
+
+        self._address = address
+        self._port = port
+        self._connect_timeout = connect_timeout
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "ucx-boundary-egress"
+
+    def accepted_types(self) -> typing.Tuple:
+        """Input types accepted by this stage."""
+        return (ControlMessage, )
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("UcxBoundaryEgressStage does not support Python nodes")
+
+        node = _stages.UcxEgressStage(builder,
+                                      self.unique_name,
+                                      address=self._address,
+                                      port=self._port,
+                                      connect_timeout_ms=int(self._connect_timeout * 1000))
+        builder.make_edge(input_node, node)
+
+        return node
+
+
+class UcxBoundaryIngressStage(BoundaryStageMixin, SingleOutputSource):
+    """
+    Ingress point of a pipeline segment continued from another node, emitting the `ControlMessage` objects sent by the
+    `UcxBoundaryEgressStage` of the other node. The columns and tensors are received straight into device memory. The
+    stage completes once the egress completes.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    bind_address : str
+        Address to listen on for the egress, an empty address listening on every interface.
+    port : int
+        Port to listen on.
+    """
+
+    def __init__(self, c: Config, bind_address: str = "0.0.0.0", port: int = 13337):
+        super().__init__(c)
+
+        if (port <= 0 or port > 65535):
+            raise ValueError(f"Invalid port: {port}")
+
+        self._bind_address = bind_address
+        self._port = port
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "ucx-boundary-ingress"
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def compute_schema(self, schema: StageSchema):
+        schema.output_schema.set_type(ControlMessage)
+
+    def _build_source(self, builder: mrc.Builder) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("UcxBoundaryIngressStage does not support Python nodes")
+
+        return _stages.UcxIngressStage(builder, self.unique_name, bind_address=self._bind_address, port=self._port)
@@ -0,0 +1,103 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+import typing
+
+import mrc
+
+from morpheus.cli import register_stage
+from morpheus.config import Config
+from morpheus.config import PipelineModes
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.single_port_stage import SinglePortStage
+from morpheus.pipeline.stage_schema import StageSchema
+
+logger = logging.getLogger(__name__)
+
+
+@register_stage("doca-flow-aggregation", modes=[PipelineModes.FIL, PipelineModes.NLP, PipelineModes.OTHER])
+class DocaFlowAggregationStage(SinglePortStage):
+    """
+    Aggregates the packets received by `DocaSourceStage` into flows on the GPU, keyed by source and destination address,
+    source and destination port, and protocol. Each time flows expire, a `MessageMeta` with one row per flow is emitted
+    containing the packet and byte counts, TCP flag counts and inter-arrival time statistics of the flow. Any remaining
+    flows are emitted once the input completes.
+
+    The upstream `DocaSourceStage` must be constructed with `numeric_addresses=True`. Flows of both IPv4 and IPv6 are
+    keyed by the 128-bit `src_ip6` and `dst_ip6` addresses, which are emitted as the `src_ip` and `dst_ip` columns.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    max_flows : int, default 262144
+        Maximum number of concurrent flows, packets of new flows are dropped once the flow table is full.
+    idle_timeout : float, default 15.0
+        Time in seconds after the last packet of a flow at which the flow is expired.
+    active_timeout : float, default 120.0
+        Time in seconds after the first packet of a flow at which the flow is expired, long-lived flows are emitted as
+        multiple records.
+    """
+
+    def __init__(self, c: Config, max_flows: int = 1 << 18, idle_timeout: float = 15.0, active_timeout: float = 120.0):
+
+        super().__init__(c)
+
+        # Attempt to import the C++ stage on creation
+        try:
+            # pylint: disable=c-extension-no-member
+            import morpheus._lib.doca as _doca
+
+            self._doca_flow_aggregation_class = _doca.DocaFlowAggregationStage
+        except ImportError as ex:
+            raise NotImplementedError(("The Morpheus DOCA components could not be imported. "
+                                       "Ensure the DOCA components have been built and installed. Error message: ") +
+                                      ex.msg) from ex
+
+        if max_flows <= 0:
+            raise ValueError("max_flows must be greater than 0")
+
+        if idle_timeout <= 0 or active_timeout <= 0:
+            raise ValueError("idle_timeout and active_timeout must be greater than 0")
+
+        self._max_flows = max_flows
+        self._idle_timeout = idle_timeout
+        self._active_timeout = active_timeout
+
+    @property
+    def name(self) -> str:
+        return "doca-flow-aggregation"
+
+    def accepted_types(self) -> typing.Tuple:
+        return (MessageMeta, )
+
+    def compute_schema(self, schema: StageSchema):
+        schema.output_schema.set_type(MessageMeta)
+
+    def supports_cpp_node(self):
+        return True
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+
+        if self._build_cpp_node():
+            node = self._doca_flow_aggregation_class(builder,
+                                                     self.unique_name,
+                                                     max_flows=self._max_flows,
+                                                     idle_timeout=self._idle_timeout,
+                                                     active_timeout=self._active_timeout)
+            builder.make_edge(input_node, node)
+            return node
+
+        raise NotImplementedError("Does not support Python nodes")
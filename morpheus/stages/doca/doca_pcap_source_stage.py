@@ -0,0 +1,121 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+
+import mrc
+
+from morpheus.cli import register_stage
+from morpheus.config import Config
+from morpheus.config import PipelineModes
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.preallocator_mixin import PreallocatorMixin
+from morpheus.pipeline.single_output_source import SingleOutputSource
+from morpheus.pipeline.stage_schema import StageSchema
+
+logger = logging.getLogger(__name__)
+
+
+@register_stage("from-doca-pcap", modes=[PipelineModes.NLP])
+class DocaPcapSourceStage(PreallocatorMixin, SingleOutputSource):
+    """
+    A source stage which replays the packets of a pcap or pcapng capture through the same GPU packet parsing used by
+    `DocaSourceStage`, emitting the same columns without requiring a NIC. Useful for reproducibly benchmarking the
+    post-receive path and the stages downstream of it, the replay throughput is logged once the replay completes.
+
+    Only TCP or UDP packets over IPv4 or IPv6 matching `traffic_type` are replayed, frames longer than 4096 bytes are
+    truncated. The `timestamp` column holds the capture timestamps in milliseconds, offset by the duration of the
+    capture on each pass so that they keep increasing.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    pcap_file : str
+        Path of the pcap or pcapng capture to replay, only Ethernet captures are supported.
+    traffic_type : str
+        Type of traffic to replay, either 'udp' or 'tcp'
+    packets_per_second : float, default 0
+        Rate at which packets are replayed, a value of 0 replays the capture as fast as possible.
+    repeat : int, default 1
+        Number of times to replay the capture.
+    numeric_addresses : bool, default False
+        When `True` the `src_mac`, `dst_mac`, `src_ip` and `dst_ip` columns are emitted as integers rather than strings,
+        along with the 128-bit `src_ip6` and `dst_ip6` columns. See `DocaSourceStage`.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 pcap_file: str,
+                 traffic_type: str,
+                 packets_per_second: float = 0,
+                 repeat: int = 1,
+                 numeric_addresses: bool = False):
+
+        super().__init__(c)
+
+        # Attempt to import the C++ stage on creation
+        try:
+            # pylint: disable=c-extension-no-member
+            import morpheus._lib.doca as _doca
+
+            self._doca_pcap_source_class = _doca.DocaPcapSourceStage
+        except ImportError as ex:
+            raise NotImplementedError(("The Morpheus DOCA components could not be imported. "
+                                       "Ensure the DOCA components have been built and installed. Error message: ") +
+                                      ex.msg) from ex
+
+        self._pcap_file = pcap_file
+        self._traffic_type = traffic_type.lower()
+        self._packets_per_second = packets_per_second
+        self._repeat = repeat
+        self._numeric_addresses = numeric_addresses
+
+        if self._traffic_type not in ('udp', 'tcp'):
+            raise NotImplementedError("The Morpheus DOCA pcap source stage allows only udp or tcp types of traffic " +
+                                      traffic_type)
+
+        if self._packets_per_second < 0:
+            raise ValueError("packets_per_second must be greater than or equal to 0")
+
+        if self._repeat < 1:
+            raise ValueError("repeat must be greater than 0")
+
+    @property
+    def name(self) -> str:
+        return "from-doca-pcap"
+
+    @property
+    def input_count(self) -> int:
+        """Return None for no max input count"""
+        return None
+
+    def compute_schema(self, schema: StageSchema):
+        schema.output_schema.set_type(MessageMeta)
+
+    def supports_cpp_node(self):
+        return True
+
+    def _build_source(self, builder: mrc.Builder) -> mrc.SegmentObject:
+
+        if self._build_cpp_node():
+            return self._doca_pcap_source_class(builder,
+                                                self.unique_name,
+                                                self._pcap_file,
+                                                self._traffic_type,
+                                                self._packets_per_second,
+                                                self._repeat,
+                                                self._numeric_addresses)
+
+        raise NotImplementedError("Does not support Python nodes")
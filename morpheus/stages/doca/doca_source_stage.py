@@ -13,6 +13,7 @@
 # limitations under the License.
 
 import logging
+import typing
 
 import mrc
 
@@ -32,6 +33,10 @@ class DocaSourceStage(PreallocatorMixin, SingleOutputSource):
     """
     A source stage used to receive raw packet data from a ConnectX-6 Dx NIC.
 
+    The filter rules are evaluated for each packet by the receive kernel, before the headers and payload are copied, so
+    dropped packets never reach the payload gather or the DataFrame. A packet is received when it matches every rule,
+    and a list rule when it matches any of its entries.
+
     Parameters
     ----------
     c : `morpheus.config.Config`
@@ -40,6 +45,39 @@ class DocaSourceStage(PreallocatorMixin, SingleOutputSource):
         The PCI Address of the NIC from which to recieve packets
     gpu_pci_address : str
         The PCI Address of the GPU which will receive packets
+    traffic_type : str
+        Type of traffic to receive, either 'udp' or 'tcp'
+    numeric_addresses : bool, default False
+        When `True` the `src_mac`, `dst_mac`, `src_ip` and `dst_ip` columns are emitted as integers rather than strings,
+        avoiding the string conversion of each burst for pipelines which only need numeric features. In this mode
+        `src_ip` and `dst_ip` only hold IPv4 addresses, while the additional `src_ip6` and `dst_ip6` columns hold the
+        128-bit addresses of both IPv4 (mapped into IPv6) and IPv6 packets.
+    src_ports : typing.List[str], default None
+        Source ports to receive, each either a port (`"53"`) or an inclusive range (`"1024-2048"`). All ports are
+        received when empty.
+    dst_ports : typing.List[str], default None
+        Destination ports to receive, in the same format as `src_ports`. When they span at most 64 ports, packets to
+        other ports are dropped by the NIC itself.
+    src_networks : typing.List[str], default None
+        Source networks to receive in CIDR notation (`"10.0.0.0/8"`, `"fd00::/8"`), a bare address matching only
+        itself. All addresses are received when empty.
+    dst_networks : typing.List[str], default None
+        Destination networks to receive, in the same format as `src_networks`.
+    min_payload_size : int, default 0
+        Smallest payload size in bytes to receive.
+    max_payload_size : int, default -1
+        Largest payload size in bytes to receive, unbounded when negative.
+    tcp_flags_mask : int, default 0
+        TCP flags to match, only packets where `flags & tcp_flags_mask == tcp_flags_value` are received. Requires
+        `tcp` traffic.
+    tcp_flags_value : int, default 0
+        Expected value of the TCP flags selected by `tcp_flags_mask`.
+    bind_to_nic : bool, default False
+        Binds each thread receiving packets to the CPUs local to the NIC, keeping the polling of its queues on the
+        socket of the NIC. The placement of each thread is logged when it starts.
+    capture_path : str, default None
+        Records the table of every received batch of packets, along with its arrival time, to this capture log such
+        that the traffic can be replayed with the `ReplaySourceStage`.
     """
 
     def __init__(
@@ -48,6 +86,17 @@ class DocaSourceStage(PreallocatorMixin, SingleOutputSource):
         nic_pci_address: str,
         gpu_pci_address: str,
         traffic_type: str,
+        numeric_addresses: bool = False,
+        src_ports: typing.List[str] = None,
+        dst_ports: typing.List[str] = None,
+        src_networks: typing.List[str] = None,
+        dst_networks: typing.List[str] = None,
+        min_payload_size: int = 0,
+        max_payload_size: int = -1,
+        tcp_flags_mask: int = 0,
+        tcp_flags_value: int = 0,
+        bind_to_nic: bool = False,
+        capture_path: str = None,
     ):
 
         super().__init__(c)
@@ -69,10 +118,23 @@ class DocaSourceStage(PreallocatorMixin, SingleOutputSource):
         self._nic_pci_address = nic_pci_address
         self._gpu_pci_address = gpu_pci_address
         self._traffic_type = traffic_type.lower()
+        self._numeric_addresses = numeric_addresses
         if self._traffic_type not in ('udp', 'tcp'):
             raise NotImplementedError("The Morpheus DOCA source stage allows a only udp or tcp types of traffic flow " +
                                       traffic_type)
 
+        # Ports may be given as integers, the rules are parsed by the C++ stage
+        self._src_ports = [str(port) for port in (src_ports or [])]
+        self._dst_ports = [str(port) for port in (dst_ports or [])]
+        self._src_networks = list(src_networks or [])
+        self._dst_networks = list(dst_networks or [])
+        self._min_payload_size = min_payload_size
+        self._max_payload_size = max_payload_size
+        self._tcp_flags_mask = tcp_flags_mask
+        self._tcp_flags_value = tcp_flags_value
+        self._bind_to_nic = bind_to_nic
+        self._capture_path = capture_path or ""
+
     @property
     def name(self) -> str:
         return "from-doca"
@@ -95,7 +157,18 @@ class DocaSourceStage(PreallocatorMixin, SingleOutputSource):
                                            self.unique_name,
                                            self._nic_pci_address,
                                            self._gpu_pci_address,
-                                           self._traffic_type)
+                                           self._traffic_type,
+                                           self._numeric_addresses,
+                                           src_ports=self._src_ports,
+                                           dst_ports=self._dst_ports,
+                                           src_networks=self._src_networks,
+                                           dst_networks=self._dst_networks,
+                                           min_payload_size=self._min_payload_size,
+                                           max_payload_size=self._max_payload_size,
+                                           tcp_flags_mask=self._tcp_flags_mask,
+                                           tcp_flags_value=self._tcp_flags_value,
+                                           bind_to_nic=self._bind_to_nic,
+                                           capture_path=self._capture_path)
             node.launch_options.pe_count = self._max_concurrent
             return node
 
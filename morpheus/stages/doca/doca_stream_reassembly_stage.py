@@ -0,0 +1,117 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+import typing
+
+import mrc
+
+from morpheus.cli import register_stage
+from morpheus.config import Config
+from morpheus.config import PipelineModes
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.single_port_stage import SinglePortStage
+from morpheus.pipeline.stage_schema import StageSchema
+
+logger = logging.getLogger(__name__)
+
+
+@register_stage("doca-stream-reassembly", modes=[PipelineModes.FIL, PipelineModes.NLP, PipelineModes.OTHER])
+class DocaStreamReassemblyStage(SinglePortStage):
+    """
+    Reassembles the TCP segments received by `DocaSourceStage` into ordered byte streams on the GPU, each direction of a
+    connection being a separate stream keyed by source and destination address and port. For each batch of packets a
+    `MessageMeta` is emitted with one chunk per stream which advanced, retransmitted bytes being trimmed and out of
+    order segments being held until the bytes preceding them arrive. Any held segments are emitted once the input
+    completes.
+
+    Each chunk holds the `src_ip`, `dst_ip`, `src_port` and `dst_port` of its stream, the `timestamp` of its latest
+    segment, the `stream_offset` of its first byte, a `gap` flag set when missing bytes were skipped before or within
+    the chunk, a `fin` flag set on the last chunk of a stream and the reassembled bytes as `data`. Chunks are not
+    aligned to application-layer messages, consumers splitting them into requests should buffer them per stream using
+    `stream_offset` and `fin`.
+
+    The upstream `DocaSourceStage` must be constructed with `traffic_type="tcp"` and `numeric_addresses=True`.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    max_streams : int, default 262144
+        Maximum number of concurrent streams, segments of new streams are dropped once the stream table is full.
+    max_buffered_bytes : int, default 268435456
+        Maximum payload bytes of out of order segments held on the GPU, every gap is skipped once exceeded.
+    idle_timeout : float, default 60.0
+        Time in seconds after the last segment of a stream at which the stream is removed.
+    gap_timeout : float, default 0.5
+        Time in seconds an out of order segment waits for the bytes preceding it before they are skipped.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 max_streams: int = 1 << 18,
+                 max_buffered_bytes: int = 1 << 28,
+                 idle_timeout: float = 60.0,
+                 gap_timeout: float = 0.5):
+
+        super().__init__(c)
+
+        # Attempt to import the C++ stage on creation
+        try:
+            # pylint: disable=c-extension-no-member
+            import morpheus._lib.doca as _doca
+
+            self._doca_stream_reassembly_class = _doca.DocaStreamReassemblyStage
+        except ImportError as ex:
+            raise NotImplementedError(("The Morpheus DOCA components could not be imported. "
+                                       "Ensure the DOCA components have been built and installed. Error message: ") +
+                                      ex.msg) from ex
+
+        if max_streams <= 0 or max_buffered_bytes <= 0:
+            raise ValueError("max_streams and max_buffered_bytes must be greater than 0")
+
+        if idle_timeout <= 0 or gap_timeout <= 0:
+            raise ValueError("idle_timeout and gap_timeout must be greater than 0")
+
+        self._max_streams = max_streams
+        self._max_buffered_bytes = max_buffered_bytes
+        self._idle_timeout = idle_timeout
+        self._gap_timeout = gap_timeout
+
+    @property
+    def name(self) -> str:
+        return "doca-stream-reassembly"
+
+    def accepted_types(self) -> typing.Tuple:
+        return (MessageMeta, )
+
+    def compute_schema(self, schema: StageSchema):
+        schema.output_schema.set_type(MessageMeta)
+
+    def supports_cpp_node(self):
+        return True
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+
+        if self._build_cpp_node():
+            node = self._doca_stream_reassembly_class(builder,
+                                                      self.unique_name,
+                                                      max_streams=self._max_streams,
+                                                      max_buffered_bytes=self._max_buffered_bytes,
+                                                      idle_timeout=self._idle_timeout,
+                                                      gap_timeout=self._gap_timeout)
+            builder.make_edge(input_node, node)
+            return node
+
+        raise NotImplementedError("Does not support Python nodes")
@@ -0,0 +1,156 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Routes the rows of each message to one of several output ports by the hash of their key columns."""
+
+import typing
+
+import mrc
+from mrc.core import operators as ops
+from mrc.core.node import Broadcast
+
+import morpheus._lib.stages as _stages
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.stage import Stage
+from morpheus.pipeline.stage_schema import StageSchema
+
+
+class HashPartitionStage(Stage):
+    """
+    Routes the rows of each message to one of `num_partitions` output ports by the hash of their key columns, such that
+    the rows sharing the same keys always reach the same port. Stateful stages, such as rolling windows, deduplication
+    or flow tables, can then be replicated once per port, each replica seeing every row of its keys and none of the
+    others, without sharing any state.
+
+    The C++ node hashes the keys of each message once on the device and copies the rows of each partition into a table
+    of its own. Ports without any row of a message do not emit it. The partitions of a `ControlMessage` copy its config
+    and metadata, but not its tensors.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    key_columns : list of str
+        Columns hashed to select the output port of each row.
+    num_partitions : int
+        Number of output ports.
+    """
+
+    def __init__(self, c: Config, key_columns: typing.List[str], num_partitions: int):
+        super().__init__(c)
+
+        if (len(key_columns) == 0):
+            raise ValueError("At least one key column is required to partition rows")
+
+        if (num_partitions < 1):
+            raise ValueError("At least one partition is required")
+
+        self._key_columns = list(key_columns)
+        self._num_partitions = num_partitions
+
+        self._create_ports(1, num_partitions)
+
+        self._set_read_column_names(self._key_columns)
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "hash-partition"
+
+    def accepted_types(self) -> typing.Tuple:
+        """Input types accepted by this stage."""
+        return (MessageMeta, ControlMessage)
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def compute_schema(self, schema: StageSchema):
+        input_type = schema.input_type
+        if (input_type not in self.accepted_types()):
+            raise RuntimeError(f"Unsupported input type {input_type} for {self.name}")
+
+        for port_schema in schema.output_schemas:
+            port_schema.set_type(input_type)
+
+    def _partition_meta(self, meta: MessageMeta) -> typing.List[typing.Optional[MessageMeta]]:
+        if (self._num_partitions == 1):
+            return [meta]
+
+        with meta.mutable_dataframe() as df:
+            parts = df.partition_by_hash(self._key_columns, self._num_partitions, keep_index=True)
+
+        return [MessageMeta(part) if len(part) > 0 else None for part in parts]
+
+    def _partition(self, message: typing.Union[MessageMeta, ControlMessage]) -> typing.List:
+        if (isinstance(message, MessageMeta)):
+            return self._partition_meta(message)
+
+        partitions = []
+        for part in self._partition_meta(message.payload()):
+            if (part is None):
+                partitions.append(None)
+                continue
+
+            # Copies the config and metadata of the message, but not its payload or tensors
+            partition = ControlMessage(message)
+            partition.payload(part)
+            partitions.append(partition)
+
+        return partitions
+
+    def _build(self, builder: mrc.Builder, input_nodes: list[mrc.SegmentObject]) -> list[mrc.SegmentObject]:
+        assert len(input_nodes) == 1, "Only 1 input supported"
+
+        is_control_message = self._schema.input_type is ControlMessage
+
+        if (self._build_cpp_node()):
+            if (is_control_message):
+                partition_node = _stages.HashPartitionControlMessageStage(builder,
+                                                                          self.unique_name,
+                                                                          key_columns=self._key_columns,
+                                                                          num_partitions=self._num_partitions)
+            else:
+                partition_node = _stages.HashPartitionMessageMetaStage(builder,
+                                                                       self.unique_name,
+                                                                       key_columns=self._key_columns,
+                                                                       num_partitions=self._num_partitions)
+        else:
+            partition_node = builder.make_node(self.unique_name, ops.map(self._partition))
+
+        builder.make_edge(input_nodes[0], partition_node)
+
+        # Every port receives the partitions of each message, keeping only its own
+        broadcast = Broadcast(builder, f"{self.unique_name}-broadcast")
+        builder.make_edge(partition_node, broadcast)
+
+        port_nodes = []
+        for partition in range(self._num_partitions):
+            port_name = f"{self.unique_name}-{partition}"
+
+            if (self._build_cpp_node()):
+                if (is_control_message):
+                    port_node = _stages.PartitionSelectControlMessageStage(builder, port_name, partition=partition)
+                else:
+                    port_node = _stages.PartitionSelectMessageMetaStage(builder, port_name, partition=partition)
+            else:
+                port_node = builder.make_node(port_name,
+                                              ops.map(lambda partitions, i=partition: partitions[i]),
+                                              ops.filter(lambda x: x is not None))
+
+            builder.make_edge(broadcast, port_node)
+            port_nodes.append(port_node)
+
+        return port_nodes
@@ -22,6 +22,9 @@ from tqdm import tqdm
 from morpheus.cli.register_stage import register_stage
 from morpheus.config import Config
 from morpheus.controllers.monitor_controller import MonitorController
+from morpheus.messages import ControlMessage
+from morpheus.messages import MessageMeta
+from morpheus.messages import MultiMessage
 from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
 from morpheus.pipeline.single_port_stage import SinglePortStage
 from morpheus.utils.logger import LogLevels
@@ -58,6 +61,14 @@ class MonitorStage(PassThruTypeMixin, SinglePortStage):
         correct counting of batched and sliced messages.
     log_level : `morpheus.utils.logger.LogLevels`, default = 'INFO'
         Enable this stage when the configured log level is at `log_level` or lower.
+    native : bool, default = False
+        When C++ execution is enabled and `determine_count_fn` is not set, count the messages and rows with the C++
+        monitor stage instead of displaying a progress bar. The C++ stage never acquires the GIL, the rates being
+        computed by a background thread every `report_interval_ms`, logged and published to the metrics returned by
+        `morpheus._lib.common.serialize_metrics`. Inputs other than `MessageMeta`, `MultiMessage` and `ControlMessage`
+        always use the progress bar.
+    report_interval_ms : int, default = 1000
+        Interval at which the C++ monitor stage reports the rates, only used when `native` is set.
     """
 
     def __init__(self,
@@ -67,9 +78,16 @@ class MonitorStage(PassThruTypeMixin, SinglePortStage):
                  unit: str = "messages",
                  delayed_start: bool = False,
                  determine_count_fn: typing.Callable[[typing.Any], int] = None,
-                 log_level: LogLevels = LogLevels.INFO):
+                 log_level: LogLevels = LogLevels.INFO,
+                 native: bool = False,
+                 report_interval_ms: int = 1000):
         super().__init__(c)
 
+        self._description = description
+        self._native = native
+        self._report_interval_ms = report_interval_ms
+        self._use_native_node = False
+
         position = MonitorController.controller_count
         self._mc = MonitorController(position=position,
                                      description=description,
@@ -80,6 +98,10 @@ class MonitorStage(PassThruTypeMixin, SinglePortStage):
                                      log_level=log_level)
         MonitorController.controller_count += 1
 
+        # The default count is the number of rows, a custom count may read any column
+        if (determine_count_fn is None):
+            self._read_columns = []
+
     @property
     def name(self) -> str:
         return "monitor"
@@ -97,13 +119,13 @@ class MonitorStage(PassThruTypeMixin, SinglePortStage):
         return (typing.Any, )
 
     def supports_cpp_node(self):
-        return False
+        return self._native and self._mc._determine_count_fn is None
 
     async def start_async(self):
         """
         Starts the pipeline stage's progress bar.
         """
-        if self._mc.is_enabled():
+        if self._mc.is_enabled() and not self._use_native_node:
             # Set the monitor interval to 0 to use prevent using tqdms monitor
             tqdm.monitor_interval = 0
 
@@ -122,6 +144,26 @@ class MonitorStage(PassThruTypeMixin, SinglePortStage):
         if not self._mc.is_enabled():
             return input_node
 
+        out_type = self.output_ports[0].output_type
+        if self._build_cpp_node() and issubclass(out_type, (MessageMeta, MultiMessage, ControlMessage)):
+            import morpheus._lib.stages as _stages
+
+            if issubclass(out_type, MessageMeta):
+                node_cls = _stages.MonitorMessageMetaStage
+            elif issubclass(out_type, MultiMessage):
+                node_cls = _stages.MonitorMultiMessageStage
+            else:
+                node_cls = _stages.MonitorControlMessageStage
+
+            self._use_native_node = True
+            node = node_cls(builder,
+                            self.unique_name,
+                            description=self._description,
+                            report_interval_ms=self._report_interval_ms)
+            builder.make_edge(input_node, node)
+
+            return node
+
         # Use a component so we track progress using the upstream progress engine. This will provide more accurate
         # results
         node = builder.make_node_component(self.unique_name,
@@ -0,0 +1,161 @@
+# Copyright (c) 2021-2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Runs the rows of many small per-user models by batch, rather than by model, on the device."""
+
+import typing
+
+import mrc
+
+import morpheus._lib.stages as _stages
+from morpheus.common import DenseActivation
+from morpheus.common import DenseLayer
+from morpheus.common import DenseModelStore
+from morpheus.config import Config
+from morpheus.stages.inference.inference_stage import InferenceStage
+from morpheus.stages.inference.inference_stage import InferenceWorker
+from morpheus.utils.producer_consumer_queue import ProducerConsumerQueue
+
+_TORCH_ACTIVATIONS = {
+    "ReLU": DenseActivation.RELU,
+    "Sigmoid": DenseActivation.SIGMOID,
+    "Tanh": DenseActivation.TANH,
+    "LeakyReLU": DenseActivation.LEAKY_RELU,
+}
+
+
+def dense_layers_from_torch(modules: typing.Iterable) -> list[DenseLayer]:
+    """
+    Converts a sequence of `torch.nn.Linear` modules, each optionally followed by a `ReLU`, `Sigmoid`, `Tanh` or
+    `LeakyReLU` (with the default slope of 0.01) module, into the layers of a `DenseModelStore` model. Other modules,
+    such as dropouts, are ignored as they have no effect during inference.
+
+    Parameters
+    ----------
+    modules : typing.Iterable
+        Modules applied in order, such as a `torch.nn.Sequential`.
+
+    Returns
+    -------
+    list[DenseLayer]
+        The layers of the model.
+    """
+    layers: list[DenseLayer] = []
+
+    for module in modules:
+        module_type = type(module).__name__
+
+        if (module_type == "Linear"):
+            layer = DenseLayer()
+            layer.input_size = module.in_features
+            layer.output_size = module.out_features
+            layer.weights = module.weight.detach().float().cpu().numpy().ravel().tolist()
+
+            if (module.bias is not None):
+                layer.biases = module.bias.detach().float().cpu().numpy().tolist()
+            else:
+                layer.biases = [0.0] * module.out_features
+
+            layers.append(layer)
+
+        elif (module_type in _TORCH_ACTIVATIONS):
+            if (len(layers) == 0 or layers[-1].activation != DenseActivation.NONE):
+                raise ValueError(f"Activation '{module_type}' must follow a Linear module")
+
+            if (module_type == "LeakyReLU" and module.negative_slope != 0.01):
+                raise ValueError("Only the default negative slope of LeakyReLU is supported")
+
+            layers[-1].activation = _TORCH_ACTIVATIONS[module_type]
+
+    return layers
+
+
+class GroupedDenseInferenceStage(InferenceStage):
+    """
+    Runs the rows of many small fully connected models, such as one autoencoder per user, held by a `DenseModelStore`.
+    Rather than running each message through its own model, the inputs of consecutive messages are merged into batches
+    of up to `max_batch_rows` rows and each layer of every model of the batch is computed by a single kernel launch.
+
+    Each message requires an `input__0` float32 tensor of features, and a `model_index` integer tensor holding the index
+    given by `DenseModelStore.model_index` of the model of each row. The outputs of the models are returned as the
+    `output__0` tensor. Use `input_mapping` and `output_mapping` to map other tensor names.
+
+    Only a C++ implementation is available.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    model_store : `morpheus.common.DenseModelStore`
+        Store of the models, which may be shared with other stages.
+    needs_logits : bool, default = False
+        Whether to apply a sigmoid to the outputs.
+    input_mapping : dict[str, str], optional
+        Maps the input names of the models (`input__0` and `model_index`) to the tensor names of the messages.
+    output_mapping : dict[str, str], optional
+        Maps the output name of the models (`output__0`) to the tensor names of the responses.
+    max_batch_rows : int, optional
+        Maximum number of rows of a batch, by default the `model_max_batch_size` of the config. Zero runs each message
+        separately.
+    max_batch_delay_ms : int, default = 1
+        Maximum time in milliseconds a message waits for others to be merged with.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 model_store: DenseModelStore,
+                 needs_logits: bool = False,
+                 input_mapping: dict[str, str] = None,
+                 output_mapping: dict[str, str] = None,
+                 max_batch_rows: int = None,
+                 max_batch_delay_ms: int = 1):
+        super().__init__(c)
+
+        if (max_batch_rows is None):
+            max_batch_rows = c.model_max_batch_size
+
+        if (max_batch_rows < 0):
+            raise ValueError("GroupedDenseInferenceStage's `max_batch_rows` must be greater than or equal to 0")
+
+        if (max_batch_delay_ms < 0):
+            raise ValueError("GroupedDenseInferenceStage's `max_batch_delay_ms` must be greater than or equal to 0")
+
+        self._model_store = model_store
+        self._needs_logits = needs_logits
+        self._input_mapping = input_mapping if input_mapping is not None else {}
+        self._output_mapping = output_mapping if output_mapping is not None else {}
+        self._max_batch_rows = max_batch_rows
+        self._max_batch_delay_ms = max_batch_delay_ms
+
+    def supports_cpp_node(self) -> bool:
+        return True
+
+    def _get_inference_worker(self, inf_queue: ProducerConsumerQueue) -> InferenceWorker:
+        raise NotImplementedError("GroupedDenseInferenceStage does not support Python nodes")
+
+    def _get_cpp_inference_node(self, builder: mrc.Builder) -> mrc.SegmentObject:
+        return _stages.InferenceClientStage(builder,
+                                            self.unique_name,
+                                            model_store=self._model_store,
+                                            needs_logits=self._needs_logits,
+                                            input_mapping=self._input_mapping,
+                                            output_mapping=self._output_mapping,
+                                            max_batch_rows=self._max_batch_rows,
+                                            max_batch_delay_ms=self._max_batch_delay_ms)
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("GroupedDenseInferenceStage does not support Python nodes")
+
+        return super()._build_single(builder, input_node)
@@ -179,6 +179,9 @@ class InferenceStage(MultiMessageStage):
         # Mark these stages to log timestamps if requested
         self._should_log_timestamps = True
 
+        # Inference only reads the tensors of incoming messages
+        self._read_columns = []
+
     @property
     def name(self) -> str:
         return "inference"
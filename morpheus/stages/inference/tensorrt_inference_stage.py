@@ -0,0 +1,159 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+
+import mrc
+
+from morpheus.cli.register_stage import register_stage
+from morpheus.config import Config
+from morpheus.config import PipelineModes
+from morpheus.stages.inference.inference_stage import InferenceStage
+from morpheus.stages.inference.inference_stage import InferenceWorker
+from morpheus.utils.producer_consumer_queue import ProducerConsumerQueue
+
+logger = logging.getLogger(__name__)
+
+
+@register_stage("inf-tensorrt", modes=[PipelineModes.NLP, PipelineModes.FIL, PipelineModes.OTHER])
+class TensorRTInferenceStage(InferenceStage):
+    """
+    Perform inference in process with a TensorRT engine.
+
+    Runs the engine on the GPU of the pipeline directly over the tensors of each message, without any copies, avoiding
+    the serialization, network and scheduling overhead of sending requests to Triton. Intended for small, latency
+    critical models. Only a C++ implementation is available, which requires Morpheus to be built with
+    `MORPHEUS_SUPPORT_TENSORRT`.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    engine_file : str
+        Path of a serialized TensorRT engine, such as those built by `morpheus tools onnx-to-trt` or `trtexec`. The
+        engine must have a dynamic batch dimension and be built with the version of TensorRT Morpheus is linked against.
+    needs_logits : bool, optional
+        Determines whether a logits calculation is needed for the outputs of the engine. If undefined, the value will be
+        inferred based on the pipeline mode, defaulting to `True` for NLP and `False` for other modes.
+    input_mapping : dict[str, str], optional
+        Dictionary used to map pipeline input names to the names of the engine's inputs. If undefined, the same default
+        mapping as `TritonInferenceStage` is used for the pipeline mode.
+    output_mapping : dict[str, str], optional
+        Dictionary used to map the names of the engine's outputs to pipeline output names. If undefined, the same
+        default mapping as `TritonInferenceStage` is used for the pipeline mode.
+    use_cuda_graphs : bool, default = False, is_flag = True
+        Launch the post-processing of the outputs, reducing the rows and calculating the logits, as a single CUDA graph
+        which is cached by the shapes of the outputs.
+    dynamic_batching : bool, default = False, is_flag = True
+        Merge the inputs of messages arriving within `max_batch_delay_ms` of each other into a single batch of up to
+        `max_batch_size` rows, splitting the outputs back up by row.
+    max_batch_delay_ms : int, default = 1
+        Maximum time in milliseconds a message waits for others to be merged with when `dynamic_batching` is enabled.
+    num_sessions : int, default = 1
+        Number of execution contexts of the engine, messages are inferred with the context with the fewest messages in
+        flight. The engine itself is only loaded once.
+    """
+
+    _INFERENCE_WORKER_DEFAULT_INOUT_MAPPING = {
+        PipelineModes.FIL: {
+            "outputs": {
+                "output__0": "probs",
+            }
+        },
+        PipelineModes.NLP: {
+            "inputs": {
+                "attention_mask": "input_mask",
+            }, "outputs": {
+                "output": "probs",
+            }
+        }
+    }
+
+    def __init__(self,
+                 c: Config,
+                 engine_file: str,
+                 needs_logits: bool = None,
+                 input_mapping: dict[str, str] = None,
+                 output_mapping: dict[str, str] = None,
+                 use_cuda_graphs: bool = False,
+                 dynamic_batching: bool = False,
+                 max_batch_delay_ms: int = 1,
+                 num_sessions: int = 1):
+        super().__init__(c)
+
+        # Attempt to import the C++ stage on creation
+        try:
+            # pylint: disable=c-extension-no-member
+            import morpheus._lib.tensorrt as _tensorrt
+
+            self._tensorrt_inference_class = _tensorrt.TensorRTInferenceStage
+        except ImportError as ex:
+            raise NotImplementedError(("The Morpheus TensorRT components could not be imported. "
+                                       "Ensure Morpheus has been built with MORPHEUS_SUPPORT_TENSORRT. "
+                                       "Error message: ") + ex.msg) from ex
+
+        if needs_logits is None:
+            needs_logits = c.mode == PipelineModes.NLP
+
+        input_mapping_ = dict(self._INFERENCE_WORKER_DEFAULT_INOUT_MAPPING.get(c.mode, {}).get("inputs", {}))
+        output_mapping_ = dict(self._INFERENCE_WORKER_DEFAULT_INOUT_MAPPING.get(c.mode, {}).get("outputs", {}))
+
+        if input_mapping is not None:
+            input_mapping_.update(input_mapping)
+
+        if output_mapping is not None:
+            output_mapping_.update(output_mapping)
+
+        if max_batch_delay_ms < 0:
+            raise ValueError("TensorRTInferenceStage's `max_batch_delay_ms` must be greater than or equal to 0")
+
+        if num_sessions < 1:
+            raise ValueError("TensorRTInferenceStage's `num_sessions` must be at least 1")
+
+        self._engine_file = engine_file
+        self._needs_logits = needs_logits
+        self._input_mapping = input_mapping_
+        self._output_mapping = output_mapping_
+        self._use_cuda_graphs = use_cuda_graphs
+        self._max_batch_rows = c.model_max_batch_size if dynamic_batching else 0
+        self._max_batch_delay_ms = max_batch_delay_ms
+        self._num_sessions = num_sessions
+
+    def supports_cpp_node(self) -> bool:
+        return True
+
+    def _get_inference_worker(self, inf_queue: ProducerConsumerQueue) -> InferenceWorker:
+        raise NotImplementedError("TensorRTInferenceStage does not support Python nodes")
+
+    def _get_cpp_inference_node(self, builder: mrc.Builder) -> mrc.SegmentObject:
+        return self._tensorrt_inference_class(builder,
+                                              self.unique_name,
+                                              self._engine_file,
+                                              self._needs_logits,
+                                              self._input_mapping,
+                                              self._output_mapping,
+                                              self._use_cuda_graphs,
+                                              self._max_batch_rows,
+                                              self._max_batch_delay_ms,
+                                              self._num_sessions)
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        node = super()._build_single(builder, input_node)
+
+        # ensure that the C++ impl only uses a single progress engine, as with `TritonInferenceStage`
+        if (self._build_cpp_node()):
+            node.launch_options.pe_count = 1
+            node.launch_options.engines_per_pe = 1
+
+        return node
@@ -656,13 +656,16 @@ class TritonInferenceStage(InferenceStage):
         Name of the model specifies which model can handle the inference requests that are sent to Triton inference
         server.
     server_url : str
-        Triton server URL.
+        Triton server URL. The C++ implementation also accepts a comma separated list of the URLs of several servers
+        serving the model, routing each request to the server with the lowest expected latency and failing over to the
+        others.
     force_convert_inputs : bool, default = False
         Instructs the stage to convert the incoming data to the same format that Triton is expecting. If set to False,
         data will only be converted if it would not result in the loss of data.
     use_shared_memory : bool, default = False, is_flag = True
         Whether or not to use CUDA Shared IPC Memory for transferring data to Triton. Using CUDA IPC reduces network
-        transfer time but requires that Morpheus and Triton are located on the same machine.
+        transfer time but requires that Morpheus and Triton are located on the same machine. The C++ implementation
+        connects to Triton over gRPC when enabled, and otherwise over HTTP.
     needs_logits : bool, optional
         Determines whether a logits calculation is needed for the value returned by the Triton inference response. If
         undefined, the value will be inferred based on the pipeline mode, defaulting to `True` for NLP and `False` for
@@ -685,6 +688,52 @@ class TritonInferenceStage(InferenceStage):
         which will be inroduced as:
 
             inout_mapping={"mask": "input_mask", "output": "probs"}
+    use_cuda_graphs : bool, default = False, is_flag = True
+        Launch the post-processing of the Triton response, reducing the rows and calculating the logits, for all output
+        tensors as a single CUDA graph which is cached by the shapes of the outputs. Reduces the kernel launch overhead
+        when consecutive batches have the same shapes, as with a fixed `max_batch_size` and sequence length. Only
+        applies to the C++ implementation.
+    max_concurrent_batches : int, default = 1
+        Maximum number of mini-batches of a single message sent to Triton at once. Messages with more rows than the
+        model's `max_batch_size` are split into mini-batches, sending several at once allows them to be processed by
+        multiple model instances in parallel. Only overlaps requests sent over gRPC with `use_shared_memory`, the HTTP
+        client sending mini-batches one after the other. Only applies to the C++ implementation.
+    dynamic_batching : bool, default = False, is_flag = True
+        Merge the inputs of messages arriving within `max_batch_delay_ms` of each other into a single request of up to
+        the model's `max_batch_size` rows, splitting the outputs back up by row. Reduces the number of requests when
+        upstream stages produce many small messages. Only applies to the C++ implementation.
+    max_batch_delay_ms : int, default = 1
+        Maximum time in milliseconds a message waits for others to be merged with when `dynamic_batching` is enabled.
+    num_connections : int, default = 1
+        Number of connections to Triton, messages are sent over the connection with the fewest messages in flight. The
+        model's metadata is only queried by the first connection. Only applies to the C++ implementation.
+    hedge_requests : bool, default = False, is_flag = True
+        Send a duplicate of requests still outstanding after the 95th percentile of their server's recent latencies to
+        a second server, using whichever response arrives first. Requires more than one server in `server_url`, which
+        are then connected over gRPC, the default HTTP port of 8000 being retried as the default gRPC port of 8001.
+        Only applies to the C++ implementation.
+    cache_size : int, default = 0
+        Maximum number of rows whose outputs are cached on the GPU, keyed by a hash of the row's inputs. Only the rows
+        missing from the cache are sent to Triton, benefiting pipelines where the same inputs recur, such as repeated
+        log lines. Zero disables the cache. Only applies to the C++ implementation.
+    warm_up : bool, default = False, is_flag = True
+        Connect to Triton and query the model when the pipeline is built, rather than when the first message arrives.
+        Avoids the latency of the first messages after a restart. Only applies to the C++ implementation.
+    fan_out_models : dict[str, dict[str, str]], optional
+        Additional models inferring each message along with `model_name`, such as a NER model sharing the tokenization
+        of a classifier, keyed by the name of each model. The values are the output mappings of the models, their
+        outputs must be named apart from those of the other models. An empty mapping prefixes the outputs of the
+        default output mapping with the name of the model, e.g. `ner_probs`, while a string prefixes them with the
+        string instead, as given by `--fan_out_models ner ner` on the command line. The outputs of every model are
+        merged into a single response, the inputs being prepared once. Only applies to the C++ implementation.
+    ragged_offsets_input : str, optional
+        Send the inputs of each request as the concatenation of their sequences without their padding, for models
+        accepting ragged batches such as TensorRT models built with the variable sequence length BERT plugins. Names
+        the model input receiving the offsets of the sequences in the concatenated inputs, starting at zero. Best
+        combined with `sequence_length_buckets` of the pre-processing stage. Only applies to the C++ implementation.
+    ragged_token_outputs : list[str], optional
+        Outputs of a ragged model holding a row per token rather than per sequence, which are padded back into a row
+        per sequence. Only applies when `ragged_offsets_input` is set.
     """
 
     _INFERENCE_WORKER_DEFAULT_INOUT_MAPPING = {
@@ -711,7 +760,18 @@ class TritonInferenceStage(InferenceStage):
                  needs_logits: bool = None,
                  inout_mapping: dict[str, str] = None,
                  input_mapping: dict[str, str] = None,
-                 output_mapping: dict[str, str] = None):
+                 output_mapping: dict[str, str] = None,
+                 use_cuda_graphs: bool = False,
+                 max_concurrent_batches: int = 1,
+                 dynamic_batching: bool = False,
+                 max_batch_delay_ms: int = 1,
+                 num_connections: int = 1,
+                 hedge_requests: bool = False,
+                 cache_size: int = 0,
+                 warm_up: bool = False,
+                 fan_out_models: dict[str, dict[str, str]] = None,
+                 ragged_offsets_input: str = None,
+                 ragged_token_outputs: list[str] = None):
         super().__init__(c)
 
         self._config = c
@@ -752,6 +812,50 @@ class TritonInferenceStage(InferenceStage):
         self._input_mapping = input_mapping_
         self._output_mapping = output_mapping_
         self._needs_logits = needs_logits
+        self._use_cuda_graphs = use_cuda_graphs
+
+        if max_concurrent_batches < 1:
+            raise ValueError("TritonInferenceStage's `max_concurrent_batches` must be at least 1")
+
+        self._max_concurrent_batches = max_concurrent_batches
+
+        if max_batch_delay_ms < 0:
+            raise ValueError("TritonInferenceStage's `max_batch_delay_ms` must be greater than or equal to 0")
+
+        self._max_batch_rows = c.model_max_batch_size if dynamic_batching else 0
+        self._max_batch_delay_ms = max_batch_delay_ms
+
+        if num_connections < 1:
+            raise ValueError("TritonInferenceStage's `num_connections` must be at least 1")
+
+        self._num_connections = num_connections
+        self._hedge_requests = hedge_requests
+
+        if cache_size < 0:
+            raise ValueError("TritonInferenceStage's `cache_size` must be greater than or equal to 0")
+
+        self._cache_size = cache_size
+        self._warm_up = warm_up
+
+        self._fan_out_models = {}
+        for (fan_out_model, fan_out_mapping) in (fan_out_models or {}).items():
+            if fan_out_model == model_name:
+                raise ValueError(f"TritonInferenceStage's `fan_out_models` cannot include `model_name` '{model_name}'")
+
+            if not isinstance(fan_out_mapping, dict) or not fan_out_mapping:
+                prefix = fan_out_mapping or fan_out_model
+                fan_out_mapping = {
+                    model_output: f"{prefix}_{tensor_name}"
+                    for (model_output, tensor_name) in output_mapping_.items()
+                }
+
+            self._fan_out_models[fan_out_model] = fan_out_mapping
+
+        if ragged_offsets_input and use_shared_memory:
+            raise ValueError("TritonInferenceStage's `ragged_offsets_input` cannot be used with `use_shared_memory`")
+
+        self._ragged_offsets_input = ragged_offsets_input or ""
+        self._ragged_token_outputs = list(ragged_token_outputs or [])
 
     def supports_cpp_node(self) -> bool:
         # Get the value from the worker class
@@ -763,6 +867,12 @@ class TritonInferenceStage(InferenceStage):
         worker.
         """
 
+        if self._fan_out_models:
+            raise NotImplementedError("TritonInferenceStage's `fan_out_models` requires the C++ implementation")
+
+        if self._ragged_offsets_input:
+            raise NotImplementedError("TritonInferenceStage's `ragged_offsets_input` requires the C++ implementation")
+
         return TritonInferenceWorker(inf_queue=inf_queue,
                                      c=self._config,
                                      server_url=self._server_url,
@@ -774,13 +884,45 @@ class TritonInferenceStage(InferenceStage):
                                      needs_logits=self._needs_logits)
 
     def _get_cpp_inference_node(self, builder: mrc.Builder) -> mrc.SegmentObject:
+        if self._fan_out_models:
+            model_output_mappings = {self._model_name: self._output_mapping, **self._fan_out_models}
+
+            return _stages.FanOutInferenceClientStage(builder,
+                                                      self.unique_name,
+                                                      self._server_url,
+                                                      model_output_mappings,
+                                                      self._needs_logits,
+                                                      self._input_mapping,
+                                                      self._use_cuda_graphs,
+                                                      self._use_shared_memory,
+                                                      self._max_concurrent_batches,
+                                                      self._max_batch_rows,
+                                                      self._max_batch_delay_ms,
+                                                      self._num_connections,
+                                                      self._hedge_requests,
+                                                      self._cache_size,
+                                                      self._warm_up,
+                                                      self._ragged_offsets_input,
+                                                      self._ragged_token_outputs)
+
         return _stages.InferenceClientStage(builder,
                                             self.unique_name,
                                             self._server_url,
                                             self._model_name,
                                             self._needs_logits,
                                             self._input_mapping,
-                                            self._output_mapping)
+                                            self._output_mapping,
+                                            self._use_cuda_graphs,
+                                            self._use_shared_memory,
+                                            self._max_concurrent_batches,
+                                            self._max_batch_rows,
+                                            self._max_batch_delay_ms,
+                                            self._num_connections,
+                                            self._hedge_requests,
+                                            self._cache_size,
+                                            self._warm_up,
+                                            self._ragged_offsets_input,
+                                            self._ragged_token_outputs)
 
     def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
         node = super()._build_single(builder, input_node)
@@ -19,6 +19,7 @@ import pandas as pd
 
 from morpheus.cli import register_stage
 from morpheus.config import PipelineModes
+from morpheus.io.deserializers import read_json_records
 from morpheus.stages.input.autoencoder_source_stage import AutoencoderSourceStage
 
 logger = logging.getLogger(__name__)
@@ -171,8 +172,7 @@ class AzureSourceStage(AutoencoderSourceStage):
 
         dfs = []
         for file in x:
-            df = pd.read_json(file, orient="records")
-            df = pd.json_normalize(df['properties'])
+            df = read_json_records(file, lines=False, record_path="properties")
             dfs = dfs + AutoencoderSourceStage.repeat_df(df, repeat_count)
 
         df_per_user = AutoencoderSourceStage.batch_user_split(dfs, userid_column_name, userid_filter)
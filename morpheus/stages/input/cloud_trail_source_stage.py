@@ -24,6 +24,7 @@ from morpheus.common import FileTypes
 from morpheus.common import determine_file_type
 from morpheus.config import PipelineModes
 from morpheus.io.deserializers import read_file_to_df
+from morpheus.io.deserializers import read_json_records
 from morpheus.stages.input.autoencoder_source_stage import AutoencoderSourceStage
 
 logger = logging.getLogger(__name__)
@@ -83,11 +84,8 @@ class CloudTrailSourceStage(AutoencoderSourceStage):
         # If reading the file only produced one line and we are a JSON file, try loading structured file
         if (determine_file_type(filename) == FileTypes.JSON and len(df) == 1 and list(df) == ["Records"]):
 
-            # Reread with lines=False
-            df = read_file_to_df(filename, file_type, df_type="pandas", parser_kwargs={"lines": False})
-
-            # Normalize
-            df = pd.json_normalize(df['Records'])
+            # Reread with lines=False, flattening the records
+            df = read_json_records(filename, lines=False, record_path="Records")
 
         return df
 
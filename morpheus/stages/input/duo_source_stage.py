@@ -13,7 +13,6 @@
 # limitations under the License.
 """Sourse stage for Duo Authentication logs."""
 
-import json
 import logging
 import typing
 
@@ -21,6 +20,7 @@ import pandas as pd
 
 from morpheus.cli import register_stage
 from morpheus.config import PipelineModes
+from morpheus.io.deserializers import read_json_records
 from morpheus.stages.input.autoencoder_source_stage import AutoencoderSourceStage
 
 DEFAULT_DATE = '1970-01-01T00:00:00.000000+00:00'
@@ -164,9 +164,7 @@ class DuoSourceStage(AutoencoderSourceStage):
         """
         dfs = []
         for file in x:
-            with open(file, encoding='UTF-8') as json_in:
-                log = json.load(json_in)
-            df = pd.json_normalize(log)
+            df = read_json_records(file, lines=False)
             df = DuoSourceStage.change_columns(df)
             dfs = dfs + AutoencoderSourceStage.repeat_df(df, repeat_count)
 
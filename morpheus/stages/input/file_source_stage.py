@@ -27,6 +27,7 @@ from morpheus.config import Config
 from morpheus.config import PipelineModes
 from morpheus.io.deserializers import read_file_to_df
 from morpheus.messages import MessageMeta
+from morpheus.pipeline.column_projection_mixin import ColumnProjectionMixin
 from morpheus.pipeline.preallocator_mixin import PreallocatorMixin
 from morpheus.pipeline.single_output_source import SingleOutputSource
 from morpheus.pipeline.stage_schema import StageSchema
@@ -35,7 +36,7 @@ logger = logging.getLogger(__name__)
 
 
 @register_stage("from-file", modes=[PipelineModes.FIL, PipelineModes.NLP, PipelineModes.OTHER])
-class FileSourceStage(PreallocatorMixin, SingleOutputSource):
+class FileSourceStage(PreallocatorMixin, ColumnProjectionMixin, SingleOutputSource):
     """
     Load messages from a file.
 
@@ -61,6 +62,15 @@ class FileSourceStage(PreallocatorMixin, SingleOutputSource):
         the line with processing. Setting this to True is recommended.
     parser_kwargs : dict, default = {}
         Extra options to pass to the file parser.
+    chunk_bytes : int, default = 0
+        When greater than 0, the file is read in chunks of about this many bytes, one message being emitted per chunk,
+        such that files larger than GPU memory can be read. CSV and JSON lines files are read by byte ranges and Parquet
+        files by row groups. Only supported by the C++ implementation.
+    schema : dict, default = None
+        Columns to read mapped to their type names, such as 'int64', 'float32', 'bool', 'str' or 'datetime64[ns]'. Only
+        these columns are parsed, directly at their types, skipping type inference. Low cardinality string columns, such
+        as addresses or user names, can be given the 'category' type to be dictionary encoded, each distinct string
+        being held once. Only supported by the C++ implementation.
     """
 
     def __init__(self,
@@ -70,7 +80,9 @@ class FileSourceStage(PreallocatorMixin, SingleOutputSource):
                  file_type: FileTypes = FileTypes.Auto,
                  repeat: int = 1,
                  filter_null: bool = True,
-                 parser_kwargs: dict = None):
+                 parser_kwargs: dict = None,
+                 chunk_bytes: int = 0,
+                 schema: dict = None):
 
         super().__init__(c)
 
@@ -80,6 +92,8 @@ class FileSourceStage(PreallocatorMixin, SingleOutputSource):
         self._file_type = file_type
         self._filter_null = filter_null
         self._parser_kwargs = parser_kwargs or {}
+        self._chunk_bytes = chunk_bytes
+        self._schema = schema or {}
 
         self._input_count = None
         self._max_concurrent = c.num_threads
@@ -114,7 +128,10 @@ class FileSourceStage(PreallocatorMixin, SingleOutputSource):
                                            self.unique_name,
                                            self._filename,
                                            self._repeat_count,
-                                           self._parser_kwargs)
+                                           self._parser_kwargs,
+                                           chunk_bytes=self._chunk_bytes,
+                                           schema=list(self._schema.items()),
+                                           projection=self._column_projection)
         else:
             node = builder.make_source(self.unique_name, self._generate_frames())
 
@@ -130,6 +147,8 @@ class FileSourceStage(PreallocatorMixin, SingleOutputSource):
             df_type="cudf",
         )
 
+        df = self._apply_column_projection(df)
+
         for i in range(self._repeat_count):
             if (self._build_cpp_node()):
                 x = CppMessageMeta(df)
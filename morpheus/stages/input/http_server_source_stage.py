@@ -27,6 +27,7 @@ import cudf
 from morpheus.cli.register_stage import register_stage
 from morpheus.config import Config
 from morpheus.messages import MessageMeta
+from morpheus.pipeline.column_projection_mixin import ColumnProjectionMixin
 from morpheus.pipeline.preallocator_mixin import PreallocatorMixin
 from morpheus.pipeline.single_output_source import SingleOutputSource
 from morpheus.pipeline.stage_schema import StageSchema
@@ -41,7 +42,7 @@ SUPPORTED_METHODS = (HTTPMethod.POST, HTTPMethod.PUT)
 
 
 @register_stage("from-http")
-class HttpServerSourceStage(PreallocatorMixin, SingleOutputSource):
+class HttpServerSourceStage(PreallocatorMixin, ColumnProjectionMixin, SingleOutputSource):
     """
     Source stage that starts an HTTP server and listens for incoming requests on a specified endpoint.
 
@@ -60,7 +61,8 @@ class HttpServerSourceStage(PreallocatorMixin, SingleOutputSource):
     accept_status: `http.HTTPStatus`, default 201, optional
         The HTTP status code to return when a request is accepted. Valid values must be in the 2xx range.
     sleep_time : float, default 0.1
-        Amount of time in seconds to sleep if the request queue is empty.
+        Amount of time in seconds to wait for a request when the request queue is empty before checking if the server is
+        still running. Requests are emitted as soon as they arrive.
     queue_timeout : int, default 5
         Maximum amount of time in seconds to wait for a request to be added to the queue before rejecting requests.
     max_queue_size : int, default None
@@ -74,9 +76,42 @@ class HttpServerSourceStage(PreallocatorMixin, SingleOutputSource):
         The maximum amount of time in seconds for any given request.
     lines : bool, default False
         If False, the HTTP server will expect each request to be a JSON array of objects. If True, the HTTP server will
-        expect each request to be a JSON object per line.
+        expect each request to be a JSON object per line. With the C++ implementation, malformed lines are dropped
+        while the valid lines of the request are kept.
     stop_after : int, default 0
         Stops ingesting after emitting `stop_after` records (rows in the dataframe). Useful for testing. Disabled if `0`
+    coalesce_payloads : bool, default False
+        When True, payloads are buffered and parsed together as a single DataFrame once either `max_batch_bytes`,
+        `max_batch_rows` or `max_batch_delay_ms` is reached, amortizing the cost of parsing many small requests. Since
+        payloads are accepted before they are parsed, malformed payloads are logged and dropped rather than rejected.
+        Only applies to the C++ implementation and requires `lines=True`.
+    max_batch_bytes : int, default 8388608
+        Maximum size in bytes of a coalesced batch. Only used when `coalesce_payloads` is True.
+    max_batch_rows : int, default None
+        Maximum number of rows in a coalesced batch. If `None` then `config.pipeline_batch_size` will be used. Only used
+        when `coalesce_payloads` is True.
+    max_batch_delay_ms : int, default 10
+        Maximum amount of time in milliseconds to wait for additional payloads after the first payload of a batch has
+        been received. Only used when `coalesce_payloads` is True.
+    stream_chunk_size : int, default 0
+        When greater than zero, request bodies are parsed as they are received in chunks of complete lines of up to
+        `stream_chunk_size` bytes, allowing large uploads, including `Transfer-Encoding: chunked` requests, to be
+        ingested without buffering the entire body. In this mode `max_payload_size` limits the size of a single chunk
+        rather than the request. Requires `lines=True`.
+    num_parse_workers : int, default 0
+        Number of threads used to parse payloads into DataFrames, each using a separate CUDA stream. When `0`, payloads
+        are parsed by the HTTP server threads, allowing malformed payloads to be rejected with a 400 status. Otherwise
+        the server threads only read requests and queue the payloads, allowing I/O and parsing to be scaled
+        independently, however since payloads are accepted before they are parsed, malformed payloads are logged and
+        dropped. Only applies to the C++ implementation, and can not be combined with `coalesce_payloads`.
+    payload_format : str, default "json"
+        Wire format of the request bodies, one of 'json', 'arrow' (an Arrow IPC stream), 'parquet', 'avro' or the
+        format of a decoder registered with the `PayloadDecoderRegistry`. Columnar payloads are copied to the device
+        without any parsing. Formats other than 'json' only apply to the C++ implementation, and can not be combined
+        with `coalesce_payloads` or `stream_chunk_size`.
+    capture_path : str, default None
+        Records every emitted batch, along with the time it was emitted, to this capture log such that the traffic can
+        be replayed with the `ReplaySourceStage`. Only applies to the C++ implementation.
     """
 
     def __init__(self,
@@ -93,7 +128,15 @@ class HttpServerSourceStage(PreallocatorMixin, SingleOutputSource):
                  max_payload_size: int = 10,
                  request_timeout_secs: int = 30,
                  lines: bool = False,
-                 stop_after: int = 0):
+                 stop_after: int = 0,
+                 coalesce_payloads: bool = False,
+                 max_batch_bytes: int = 8 * 1024 * 1024,
+                 max_batch_rows: int = None,
+                 max_batch_delay_ms: int = 10,
+                 stream_chunk_size: int = 0,
+                 num_parse_workers: int = 0,
+                 payload_format: str = "json",
+                 capture_path: str = None):
         super().__init__(config)
         self._bind_address = bind_address
         self._port = port
@@ -108,6 +151,14 @@ class HttpServerSourceStage(PreallocatorMixin, SingleOutputSource):
         self._request_timeout_secs = request_timeout_secs
         self._lines = lines
         self._stop_after = stop_after
+        self._coalesce_payloads = coalesce_payloads
+        self._max_batch_bytes = max_batch_bytes
+        self._max_batch_rows = max_batch_rows or config.pipeline_batch_size
+        self._max_batch_delay_ms = max_batch_delay_ms
+        self._stream_chunk_size = stream_chunk_size
+        self._num_parse_workers = num_parse_workers
+        self._payload_format = payload_format
+        self._capture_path = capture_path or ""
 
         # These are only used when C++ mode is disabled
         self._queue = None
@@ -120,6 +171,21 @@ class HttpServerSourceStage(PreallocatorMixin, SingleOutputSource):
         if accept_status.value < 200 or accept_status.value > 299:
             raise ValueError(f"Invalid accept_status: {accept_status}")
 
+        if coalesce_payloads and not lines:
+            raise ValueError("coalesce_payloads requires lines=True")
+
+        if stream_chunk_size > 0 and not lines:
+            raise ValueError("stream_chunk_size requires lines=True")
+
+        if coalesce_payloads and num_parse_workers > 0:
+            raise ValueError("num_parse_workers can not be combined with coalesce_payloads")
+
+        if payload_format != "json" and (coalesce_payloads or stream_chunk_size > 0):
+            raise ValueError("coalesce_payloads and stream_chunk_size require payload_format='json'")
+
+        if stream_chunk_size > self._max_payload_size_bytes:
+            raise ValueError("stream_chunk_size must not exceed max_payload_size")
+
     @property
     def name(self) -> str:
         """Unique name of the stage."""
@@ -136,6 +202,7 @@ class HttpServerSourceStage(PreallocatorMixin, SingleOutputSource):
         try:
             # engine='cudf' is needed when lines=False to avoid using pandas
             df = cudf.read_json(payload, lines=self._lines, engine='cudf')
+            df = self._apply_column_projection(df)
         except Exception as e:
             err_msg = "Error occurred converting HTTP payload to Dataframe"
             logger.error("%s: %s", err_msg, e)
@@ -177,7 +244,8 @@ class HttpServerSourceStage(PreallocatorMixin, SingleOutputSource):
                          method=self._method.value,
                          num_threads=self._num_server_threads,
                          max_payload_size=self._max_payload_size_bytes,
-                         request_timeout=self._request_timeout_secs) as http_server):
+                         request_timeout=self._request_timeout_secs,
+                         stream_chunk_size=self._stream_chunk_size) as http_server):
 
             self._processing = True
             while self._processing:
@@ -222,8 +290,23 @@ class HttpServerSourceStage(PreallocatorMixin, SingleOutputSource):
                                                  max_payload_size=self._max_payload_size_bytes,
                                                  request_timeout=self._request_timeout_secs,
                                                  lines=self._lines,
-                                                 stop_after=self._stop_after)
+                                                 stop_after=self._stop_after,
+                                                 coalesce_payloads=self._coalesce_payloads,
+                                                 max_batch_bytes=self._max_batch_bytes,
+                                                 max_batch_rows=self._max_batch_rows,
+                                                 max_batch_delay_ms=self._max_batch_delay_ms,
+                                                 stream_chunk_size=self._stream_chunk_size,
+                                                 num_parse_workers=self._num_parse_workers,
+                                                 projection=self._column_projection,
+                                                 payload_format=self._payload_format,
+                                                 capture_path=self._capture_path)
         else:
+            if self._payload_format != "json":
+                raise RuntimeError(f"payload_format='{self._payload_format}' requires the C++ implementation")
+
+            if self._capture_path:
+                raise RuntimeError("capture_path requires the C++ implementation")
+
             node = builder.make_source(self.unique_name, self._generate_frames())
 
         return node
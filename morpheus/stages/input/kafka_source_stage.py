@@ -16,20 +16,19 @@ import logging
 import time
 import typing
 from enum import Enum
-from io import StringIO
 
 import confluent_kafka as ck
 import mrc
 import pandas as pd
 
-import cudf
-
 import morpheus._lib.stages as _stages
 from morpheus.cli.register_stage import register_stage
 from morpheus.config import Config
 from morpheus.config import PipelineModes
 from morpheus.config import auto_determine_bootstrap
+from morpheus.io.utils import decode_payloads
 from morpheus.messages import MessageMeta
+from morpheus.pipeline.column_projection_mixin import ColumnProjectionMixin
 from morpheus.pipeline.preallocator_mixin import PreallocatorMixin
 from morpheus.pipeline.single_output_source import SingleOutputSource
 from morpheus.pipeline.stage_schema import StageSchema
@@ -45,7 +44,7 @@ class AutoOffsetReset(Enum):
 
 
 @register_stage("from-kafka", modes=[PipelineModes.FIL, PipelineModes.NLP, PipelineModes.OTHER])
-class KafkaSourceStage(PreallocatorMixin, SingleOutputSource):
+class KafkaSourceStage(PreallocatorMixin, ColumnProjectionMixin, SingleOutputSource):
     """
     Load messages from a Kafka cluster.
 
@@ -70,7 +69,8 @@ class KafkaSourceStage(PreallocatorMixin, SingleOutputSource):
         debugging, allowing the user to process the same messages multiple times.
     disable_pre_filtering : bool, default = False
         Enabling this option will skip pre-filtering of json messages. This is only useful when inputs are known to be
-        valid json.
+        valid json. With the C++ implementation, a batch holding malformed messages is parsed a second time, dropping
+        only the malformed messages.
     auto_offset_reset : `AutoOffsetReset`, case_sensitive = False
         Sets the value for the configuration option 'auto.offset.reset'. See the kafka documentation for more
         information on the effects of each value."
@@ -78,6 +78,44 @@ class KafkaSourceStage(PreallocatorMixin, SingleOutputSource):
         Stops ingesting after emitting `stop_after` records (rows in the dataframe). Useful for testing. Disabled if `0`
     async_commits: bool, default = True
         Enable commits to be performed asynchronously. Ignored if `disable_commit` is `True`.
+    gpu_pre_filtering: bool, default = False
+        When pre-filtering is enabled, validate json messages on the GPU while parsing instead of on the CPU. Malformed
+        messages are dropped, note that messages where every field is null are also dropped. Only applies to the C++
+        implementation.
+    parallel_partitions: bool, default = False
+        Consume each assigned partition on its own thread using librdkafka partition queues, parsing batches in
+        parallel and committing offsets per partition. Only applies to the C++ implementation.
+    latency_target_ms: int, default = 0
+        When greater than zero, the batch size and poll interval are adjusted at runtime. Batches grow towards the
+        pipeline batch size when there is a backlog and shrink when traffic is light, keeping the p99 latency within
+        this target. In this mode `poll_interval` is an upper bound. Only applies to the C++ implementation.
+    commit_on_ack: bool, default = False
+        Only commit the offsets of a message once a sink has acknowledged it by calling `MessageMeta.acknowledge`
+        after writing it out, as the C++ `WriteToFileStage` and `WriteToKafkaStage` do, rather than as soon as it is
+        emitted. Messages which are dropped or fail downstream are never acknowledged and are redelivered after a
+        restart. Ignored if `disable_commit` is `True`. Only applies to the C++ implementation.
+    device_ids: typing.List[int], default = None
+        GPUs to parse the batches on in turn, spreading a single pipeline across several devices. The downstream C++
+        stages process each message on the device it was parsed on. When `None` every batch is parsed on the current
+        device. Only applies to the C++ implementation.
+    schema: dict, default = None
+        Fields to read from the messages mapped to their type names, such as 'int64', 'float32', 'bool', 'str' or
+        'datetime64[ns]'. The fields are parsed directly at these types and any other field is dropped. Low cardinality
+        string fields, such as addresses or user names, can be given the 'category' type to be dictionary encoded. Only
+        applies to the C++ implementation.
+    payload_format: str, default = "json"
+        Wire format of the message payloads, one of 'json', 'arrow' (an Arrow IPC stream per message), 'parquet' or
+        'avro' (an object container file per message). Columnar payloads are copied to the device without any parsing.
+        The C++ implementation also accepts the formats of decoders registered with the `PayloadDecoderRegistry`.
+        Pre-filtering only applies to 'json' payloads.
+    placement: str, default = None
+        Binds the partition worker threads, and allocates the pinned batch buffers, on the NUMA node local to a device
+        to avoid crossing the socket interconnect of multi-socket hosts. One of 'gpu' for the current GPU, 'gpu:N',
+        'numa:N' or the PCI address of a device such as the NIC. The placement is logged at startup. Only applies to
+        the C++ implementation.
+    capture_path: str, default = None
+        Records every batch, along with its arrival time, to this capture log such that the traffic can be replayed
+        with the `ReplaySourceStage`. Requires the C++ implementation.
     """
 
     def __init__(self,
@@ -91,7 +129,16 @@ class KafkaSourceStage(PreallocatorMixin, SingleOutputSource):
                  disable_pre_filtering: bool = False,
                  auto_offset_reset: AutoOffsetReset = AutoOffsetReset.LATEST,
                  stop_after: int = 0,
-                 async_commits: bool = True):
+                 async_commits: bool = True,
+                 gpu_pre_filtering: bool = False,
+                 parallel_partitions: bool = False,
+                 latency_target_ms: int = 0,
+                 commit_on_ack: bool = False,
+                 device_ids: typing.List[int] = None,
+                 schema: dict = None,
+                 payload_format: str = "json",
+                 placement: str = None,
+                 capture_path: str = None):
         super().__init__(config)
 
         if (input_topic is None):
@@ -123,6 +170,15 @@ class KafkaSourceStage(PreallocatorMixin, SingleOutputSource):
         self._disable_pre_filtering = disable_pre_filtering
         self._stop_after = stop_after
         self._async_commits = async_commits
+        self._gpu_pre_filtering = gpu_pre_filtering
+        self._parallel_partitions = parallel_partitions
+        self._latency_target_ms = latency_target_ms
+        self._commit_on_ack = commit_on_ack
+        self._device_ids = device_ids or []
+        self._schema = schema or {}
+        self._payload_format = payload_format
+        self._placement = placement or ""
+        self._capture_path = capture_path or ""
         self._client = None
 
         # Flag to indicate whether or not we should stop
@@ -157,18 +213,12 @@ class KafkaSourceStage(PreallocatorMixin, SingleOutputSource):
     def _process_batch(self, consumer, batch):
         message_meta = None
         if len(batch):
-            buffer = StringIO()
-
-            for msg in batch:
-                payload = msg.value()
-                if payload is not None:
-                    buffer.write(payload.decode("utf-8"))
-                    buffer.write("\n")
+            payloads = [msg.value() for msg in batch if msg.value() is not None]
 
             df = None
             try:
-                buffer.seek(0)
-                df = cudf.io.read_json(buffer, engine='cudf', lines=True, orient='records')
+                df = decode_payloads(payloads, self._payload_format)
+                df = self._apply_column_projection(df)
             except Exception as e:
                 logger.error("Error parsing payload into a dataframe : %s", e)
             finally:
@@ -248,12 +298,25 @@ class KafkaSourceStage(PreallocatorMixin, SingleOutputSource):
                                               self._disable_commit,
                                               self._disable_pre_filtering,
                                               self._stop_after,
-                                              self._async_commits)
+                                              self._async_commits,
+                                              gpu_pre_filtering=self._gpu_pre_filtering,
+                                              parallel_partitions=self._parallel_partitions,
+                                              latency_target_ms=self._latency_target_ms,
+                                              commit_on_ack=self._commit_on_ack,
+                                              device_ids=self._device_ids,
+                                              schema=list(self._schema.items()),
+                                              projection=self._column_projection,
+                                              payload_format=self._payload_format,
+                                              placement=self._placement,
+                                              capture_path=self._capture_path)
 
             # Only use multiple progress engines with C++. The python implementation will duplicate messages with
             # multiple threads
             source.launch_options.pe_count = self._max_concurrent
         else:
+            if self._capture_path:
+                raise RuntimeError("capture_path requires the C++ implementation")
+
             source = builder.make_source(self.unique_name, self._source_generator)
 
         return source
@@ -0,0 +1,87 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Source polling the telemetry of the GPUs of the node through NVML."""
+
+import mrc
+
+import morpheus._lib.stages as _stages
+from morpheus.cli import register_stage
+from morpheus.config import Config
+from morpheus.config import PipelineModes
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.preallocator_mixin import PreallocatorMixin
+from morpheus.pipeline.single_output_source import SingleOutputSource
+from morpheus.pipeline.stage_schema import StageSchema
+
+
+@register_stage("from-nvml", modes=[PipelineModes.FIL])
+class NvmlSourceStage(PreallocatorMixin, SingleOutputSource):
+    """
+    Polls the telemetry of every GPU of the node through NVML, the library behind `nvidia-smi`, emitting a row per GPU
+    and poll. Replaces logging `nvidia-smi` output to JSON files read back by `FileSourceStage` in the ABP nvsmi
+    detection pipeline, the features of the model being built straight into a DataFrame without any text parsing.
+
+    Along with the features listed in `data/columns_fil.txt`, in the units of `nvidia-smi`, each row holds a
+    `timestamp` column in seconds since the epoch and the `nvidia_smi_log.gpu.minor_number` of its GPU. Values a GPU
+    does not report are null.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    interval_ms : int, default 1000
+        Time between two polls in milliseconds.
+    polls_per_message : int, default 1
+        Number of polls emitted as a single message.
+    max_polls : int, default 0
+        Number of polls after which the stage completes. Polls until the pipeline is stopped when `0`.
+    """
+
+    def __init__(self, c: Config, interval_ms: int = 1000, polls_per_message: int = 1, max_polls: int = 0):
+        super().__init__(c)
+
+        if (interval_ms < 0):
+            raise ValueError("interval_ms must not be negative")
+
+        if (polls_per_message < 1):
+            raise ValueError("polls_per_message must be at least 1")
+
+        if (max_polls < 0):
+            raise ValueError("max_polls must not be negative")
+
+        self._interval_ms = interval_ms
+        self._polls_per_message = polls_per_message
+        self._max_polls = max_polls
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "from-nvml"
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def compute_schema(self, schema: StageSchema):
+        schema.output_schema.set_type(MessageMeta)
+
+    def _build_source(self, builder: mrc.Builder) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("NvmlSourceStage does not support Python nodes")
+
+        return _stages.NvmlSourceStage(builder,
+                                       self.unique_name,
+                                       interval_ms=self._interval_ms,
+                                       polls_per_message=self._polls_per_message,
+                                       max_polls=self._max_polls)
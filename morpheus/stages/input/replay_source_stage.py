@@ -0,0 +1,89 @@
+# Copyright (c) 2024, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Source replaying the batches recorded by a source stage in capture mode."""
+
+import os
+
+import mrc
+
+import morpheus._lib.stages as _stages
+from morpheus.cli import register_stage
+from morpheus.config import Config
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.preallocator_mixin import PreallocatorMixin
+from morpheus.pipeline.single_output_source import SingleOutputSource
+from morpheus.pipeline.stage_schema import StageSchema
+
+
+@register_stage("from-replay")
+class ReplaySourceStage(PreallocatorMixin, SingleOutputSource):
+    """
+    Replays the batches recorded by the `capture_path` option of `KafkaSourceStage`, `HttpServerSourceStage` or
+    `DocaSourceStage`, such that a build can be measured against recorded production traffic, with its string lengths,
+    null rates and bursts, rather than synthetic data. Each batch is emitted as it was recorded, with the intervals it
+    was received with. The number of rows replayed and the achieved rate are logged once the stage completes.
+
+    The capture log is a sequence of Arrow IPC streams, one per batch, with the arrival time of the batch in the
+    metadata of its schema.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    filename : str
+        Capture log to replay.
+    speed : float, default 1.0
+        Factor the recorded rate is multiplied by, `1.0` replaying at the original rate, `2.0` twice as fast and `0`
+        as fast as possible.
+    repeat : int, default 1
+        Number of times the log is replayed.
+    """
+
+    def __init__(self, c: Config, filename: str, speed: float = 1.0, repeat: int = 1):
+        super().__init__(c)
+
+        if (not os.path.exists(filename)):
+            raise FileNotFoundError(f"Capture log not found: {filename}")
+
+        if (speed < 0):
+            raise ValueError("speed must not be negative")
+
+        if (repeat < 1):
+            raise ValueError("repeat must be at least 1")
+
+        self._filename = filename
+        self._speed = speed
+        self._repeat = repeat
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "from-replay"
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def compute_schema(self, schema: StageSchema):
+        schema.output_schema.set_type(MessageMeta)
+
+    def _build_source(self, builder: mrc.Builder) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("ReplaySourceStage does not support Python nodes")
+
+        return _stages.ReplaySourceStage(builder,
+                                         self.unique_name,
+                                         filename=self._filename,
+                                         speed=self._speed,
+                                         repeat=self._repeat)
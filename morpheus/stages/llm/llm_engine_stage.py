@@ -37,12 +37,38 @@ class LLMEngineStage(PassThruTypeMixin, SinglePortStage):
         Pipeline configuration instance.
     engine : `morpheus.llm.LLMEngine`
         LLM engine instance to execute.
+    max_concurrency : int, optional
+        Maximum number of tasks executing concurrently across all messages, tasks beyond the limit waiting for one to
+        complete. Useful to stay within the quota of rate limited LLM services, by default 0 for no limit.
+    streaming : bool, optional
+        Emit the partial outputs written by the nodes with `LLMContext.stream_output`, such as the tokens of a
+        generation, as they arrive. Each is emitted as a `ControlMessage` sharing the payload of the input message, with
+        its `llm_stream` metadata holding the `node` which wrote the `chunk`, ahead of the output messages. By default
+        False, partial outputs being dropped.
+    trace : bool, optional
+        Record the time spent on each node and task handler of a task, along with the time it waited for a concurrency
+        permit and the time python nodes waited for the GIL. The spans are appended to the `llm_trace` metadata of the
+        output messages, each holding the `name` of the node, its `kind` and its `start_time_unix_nano` and
+        `end_time_unix_nano`. By default False. The durations are recorded by the `morpheus_llm_span_seconds` histogram
+        whether or not tracing is enabled.
    """
 
-    def __init__(self, c: Config, *, engine: LLMEngine):
+    def __init__(self,
+                 c: Config,
+                 *,
+                 engine: LLMEngine,
+                 max_concurrency: int = 0,
+                 streaming: bool = False,
+                 trace: bool = False):
         super().__init__(c)
 
+        if max_concurrency < 0:
+            raise ValueError("max_concurrency must be greater than or equal to 0")
+
         self._engine = engine
+        self._max_concurrency = max_concurrency
+        self._streaming = streaming
+        self._trace = trace
 
     @property
     def name(self) -> str:
@@ -67,7 +93,12 @@ class LLMEngineStage(PassThruTypeMixin, SinglePortStage):
 
     def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
 
-        node = _llm.LLMEngineStage(builder, self.unique_name, self._engine)
+        node = _llm.LLMEngineStage(builder,
+                                   self.unique_name,
+                                   self._engine,
+                                   max_concurrency=self._max_concurrency,
+                                   streaming=self._streaming,
+                                   trace=self._trace)
         node.launch_options.pe_count = 1
 
         builder.make_edge(input_node, node)
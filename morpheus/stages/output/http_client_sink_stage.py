@@ -15,10 +15,12 @@
 
 import logging
 import typing
+import urllib.parse
 from http import HTTPStatus
 from io import StringIO
 
 import mrc
+import urllib3
 from mrc.core import operators as ops
 
 from morpheus.cli.register_stage import register_stage
@@ -127,6 +129,12 @@ class HttpClientSinkStage(PassThruTypeMixin, SinglePortStage):
         Additional arguments to pass to the `requests.Session.request` function. These values will are potentially
         overridden by the results of `df_to_request_kwargs_fn` if it is not `None`, otherwise the value of `data` will
         be overwritten, as will `url` when `static_endpoint` is False.
+    max_connections : int, default 8
+        Number of persistent connections, and concurrent requests, to use. Only applies to the C++ implementation, which
+        is used when `static_endpoint` is True, `base_url` uses the `http` protocol and both `df_to_request_kwargs_fn`
+        and `request_kwargs` are not set. When using the C++ implementation, messages are emitted once their payloads
+        have been queued, and a request which fails after `max_retries` attempts raises an error on a subsequent
+        message.
     """
 
     def __init__(self,
@@ -149,6 +157,7 @@ class HttpClientSinkStage(PassThruTypeMixin, SinglePortStage):
                  max_rows_per_payload: int = 10000,
                  lines: bool = False,
                  df_to_request_kwargs_fn: typing.Optional[typing.Callable[[str, str, DataFrameType], dict]] = None,
+                 max_connections: int = 8,
                  **request_kwargs):
         super().__init__(c)
         self._base_url = http_utils.prepare_url(base_url)
@@ -188,6 +197,7 @@ class HttpClientSinkStage(PassThruTypeMixin, SinglePortStage):
         self._lines = lines
         self._df_to_request_kwargs_fn = df_to_request_kwargs_fn
         self._requst_kwargs = request_kwargs
+        self._max_connections = max_connections
         self._http_session = None
 
     @property
@@ -209,7 +219,8 @@ class HttpClientSinkStage(PassThruTypeMixin, SinglePortStage):
 
     def supports_cpp_node(self):
         """Indicates whether this stage supports CPP nodes."""
-        return False
+        return (self._static_endpoint and self._df_to_request_kwargs_fn is None and len(self._requst_kwargs) == 0
+                and urllib3.util.parse_url(self._base_url).scheme == "http")
 
     def _df_to_url(self, df: DataFrameType) -> str:
         """
@@ -285,7 +296,34 @@ class HttpClientSinkStage(PassThruTypeMixin, SinglePortStage):
         return msg
 
     def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
-        node = builder.make_node(self.unique_name, ops.map(self._process_message))
+        if self._build_cpp_node():
+            import morpheus._lib.stages as _stages
+
+            parsed_url = urllib3.util.parse_url(f"{self._base_url}{self._endpoint}")
+            target = parsed_url.request_uri
+            if self._query_params:
+                separator = "&" if parsed_url.query else "?"
+                target = f"{target}{separator}{urllib.parse.urlencode(self._query_params, doseq=True)}"
+
+            accept_status_codes = [status.value for status in self._accept_status_codes]
+            node = _stages.HttpClientSinkStage(builder,
+                                               self.unique_name,
+                                               host=parsed_url.host,
+                                               port=parsed_url.port or 80,
+                                               target=target,
+                                               method=self._method.value,
+                                               headers=self._headers,
+                                               error_sleep_time=self._error_sleep_time,
+                                               respect_retry_after_header=self._respect_retry_after_header,
+                                               request_timeout=self._request_timeout_secs,
+                                               accept_status_codes=accept_status_codes,
+                                               max_retries=self._max_retries,
+                                               max_rows_per_payload=self._max_rows_per_payload,
+                                               lines=self._lines,
+                                               max_connections=self._max_connections)
+        else:
+            node = builder.make_node(self.unique_name, ops.map(self._process_message))
+
         builder.make_edge(input_node, node)
 
         return node
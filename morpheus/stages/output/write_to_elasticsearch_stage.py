@@ -13,8 +13,10 @@
 # limitations under the License.
 """Write to Elasticsearch stage."""
 
+import base64
 import logging
 import typing
+import urllib.parse
 
 import mrc
 import mrc.core.operators as ops
@@ -31,6 +33,51 @@ from morpheus.pipeline.single_port_stage import SinglePortStage
 
 logger = logging.getLogger(__name__)
 
+# Connection kwargs which do not affect how the C++ stage connects, and which it can therefore ignore
+_CPP_IGNORED_KWARGS = {"retry_on_status", "retry_on_timeout", "max_retries", "request_timeout"}
+
+
+def _cpp_connection_args(connection_kwargs: dict) -> typing.Optional[dict]:
+    """
+    Maps the Elasticsearch client kwargs onto the host, port and headers of the C++ stage. Returns `None` when the
+    connection needs a feature only the Python client supports, such as TLS, several hosts or sniffing.
+    """
+    unsupported = set(connection_kwargs) - {"hosts", "basic_auth", "http_auth", "api_key"} - _CPP_IGNORED_KWARGS
+    if unsupported:
+        return None
+
+    hosts = connection_kwargs.get("hosts")
+    if isinstance(hosts, list):
+        if len(hosts) != 1:
+            return None
+        hosts = hosts[0]
+
+    if isinstance(hosts, str):
+        url = urllib.parse.urlsplit(hosts)
+        scheme, host, port = url.scheme, url.hostname, url.port
+    elif isinstance(hosts, dict):
+        scheme, host, port = hosts.get("scheme", "http"), hosts.get("host"), hosts.get("port")
+    else:
+        return None
+
+    if scheme != "http" or not host:
+        return None
+
+    headers = {}
+    basic_auth = connection_kwargs.get("basic_auth", connection_kwargs.get("http_auth"))
+    if basic_auth is not None:
+        if isinstance(basic_auth, (list, tuple)):
+            basic_auth = ":".join(basic_auth)
+        headers["Authorization"] = "Basic " + base64.b64encode(basic_auth.encode()).decode()
+
+    api_key = connection_kwargs.get("api_key")
+    if api_key is not None:
+        if isinstance(api_key, (list, tuple)):
+            api_key = base64.b64encode(":".join(api_key).encode()).decode()
+        headers["Authorization"] = "ApiKey " + api_key
+
+    return {"host": host, "port": port or 9200, "headers": headers}
+
 
 @register_stage("to-elasticsearch", ignore_args=["connection_kwargs_update_func"])
 class WriteToElasticsearchStage(PassThruTypeMixin, SinglePortStage):
@@ -52,6 +99,16 @@ class WriteToElasticsearchStage(PassThruTypeMixin, SinglePortStage):
         The refresh period in seconds for client refreshing.
     connection_kwargs_update_func : typing.Callable, optional, default: None
         Custom function to update connection parameters.
+    max_bulk_bytes : int, optional, default: 5242880
+        Maximum size of the body of a single `_bulk` request, only used by the C++ stage.
+    max_bulk_docs : int, optional, default: 5000
+        Maximum number of documents in a single `_bulk` request, only used by the C++ stage.
+    max_concurrent_requests : int, optional, default: 8
+        Number of `_bulk` requests in flight at once, only used by the C++ stage.
+
+    The C++ stage serializes the documents on the GPU and sends them over pooled connections, retrying documents
+    rejected with 429 Too Many Requests. It is used when the connection is a single `http` host, optionally with basic
+    or API key authentication, any other connection settings fall back to the Python Elasticsearch client.
     """
 
     def __init__(self,
@@ -60,11 +117,19 @@ class WriteToElasticsearchStage(PassThruTypeMixin, SinglePortStage):
                  connection_conf_file: str,
                  raise_on_exception: bool = False,
                  refresh_period_secs: int = 2400,
-                 connection_kwargs_update_func: typing.Callable = None):
+                 connection_kwargs_update_func: typing.Callable = None,
+                 max_bulk_bytes: int = 5 << 20,
+                 max_bulk_docs: int = 5000,
+                 max_concurrent_requests: int = 8):
 
         super().__init__(config)
 
         self._index = index
+        self._raise_on_exception = raise_on_exception
+        self._refresh_period_secs = refresh_period_secs
+        self._max_bulk_bytes = max_bulk_bytes
+        self._max_bulk_docs = max_bulk_docs
+        self._max_concurrent_requests = max_concurrent_requests
 
         try:
             with open(connection_conf_file, "r", encoding="utf-8") as file:
@@ -78,9 +143,14 @@ class WriteToElasticsearchStage(PassThruTypeMixin, SinglePortStage):
         if connection_kwargs_update_func:
             connection_kwargs = connection_kwargs_update_func(connection_kwargs)
 
-        self._controller = ElasticsearchController(connection_kwargs=connection_kwargs,
-                                                   raise_on_exception=raise_on_exception,
-                                                   refresh_period_secs=refresh_period_secs)
+        self._connection_kwargs = connection_kwargs
+        self._cpp_connection_args = (_cpp_connection_args(connection_kwargs)
+                                     if isinstance(connection_kwargs, dict) else None)
+
+        # The Python client connects on creation, which the C++ stage has no use for
+        self._controller = None
+        if not self._build_cpp_node():
+            self._controller = self._create_controller()
 
     @property
     def name(self) -> str:
@@ -101,10 +171,32 @@ class WriteToElasticsearchStage(PassThruTypeMixin, SinglePortStage):
 
     def supports_cpp_node(self):
         """Indicates whether this stage supports a C++ node."""
-        return False
+        return self._cpp_connection_args is not None
+
+    def _create_controller(self) -> ElasticsearchController:
+        return ElasticsearchController(connection_kwargs=self._connection_kwargs,
+                                       raise_on_exception=self._raise_on_exception,
+                                       refresh_period_secs=self._refresh_period_secs)
 
     def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
 
+        if self._build_cpp_node():
+            import morpheus._lib.stages as _stages
+            node = _stages.WriteToElasticsearchStage(builder,
+                                                     self.unique_name,
+                                                     index=self._index,
+                                                     max_bulk_bytes=self._max_bulk_bytes,
+                                                     max_bulk_docs=self._max_bulk_docs,
+                                                     max_concurrent_requests=self._max_concurrent_requests,
+                                                     raise_on_exception=self._raise_on_exception,
+                                                     **self._cpp_connection_args)
+            builder.make_edge(input_node, node)
+
+            return node
+
+        if self._controller is None:
+            self._controller = self._create_controller()
+
         def on_data(meta: MessageMeta) -> MessageMeta:
 
             self._controller.refresh_client()
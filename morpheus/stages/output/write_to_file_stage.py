@@ -23,6 +23,7 @@ from morpheus.cli.register_stage import register_stage
 from morpheus.common import FileTypes
 from morpheus.config import Config
 from morpheus.controllers.write_to_file_controller import WriteToFileController
+from morpheus.messages import ControlMessage
 from morpheus.messages import MessageMeta
 from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
 from morpheus.pipeline.single_port_stage import SinglePortStage
@@ -33,7 +34,8 @@ class WriteToFileStage(PassThruTypeMixin, SinglePortStage):
     """
     Write all messages to a file.
 
-    This class writes messages to a file.
+    This class writes messages to a file. Parquet files are only written by the C++ implementation, each message being
+    appended to the same file as one or more row groups.
 
     Parameters
     ----------
@@ -50,6 +52,31 @@ class WriteToFileStage(PassThruTypeMixin, SinglePortStage):
         Write out the index as a column, by default True.
     flush : bool, default = False, is_flag = True
         When `True` flush the output buffer to disk on each message.
+    compression : str, default = None
+        One of 'none', 'snappy' or 'zstd' for Parquet files and 'none' or 'gzip' for CSV and JSON files. `None` uses
+        'snappy' for Parquet files and 'none' otherwise. Gzip compressed files have `.gz` appended to their name. Only
+        supported by the C++ implementation.
+    row_group_size_rows : int, default = 0
+        Maximum number of rows of each Parquet row group, 0 uses the cudf default.
+    max_file_bytes : int, default = 0
+        When greater than 0, files are rotated once they reach this size. The n-th file after the first is named by
+        inserting `.n` before the extension of `filename`. Only supported by the C++ implementation.
+    max_file_age_secs : int, default = 0
+        When greater than 0, files are rotated once they have been open for this many seconds. Only supported by the
+        C++ implementation.
+    max_queued_writes : int, default = 0
+        When greater than 0, CSV and JSON messages are serialized on the pipeline thread and written by a dedicated
+        thread, up to this many messages being queued. Only supported by the C++ implementation.
+    device_write : bool, default = False, is_flag = True
+        Write files through a cuDF file sink, allowing large device buffers to be written straight to disk using
+        GPUDirect Storage when it is available. Not supported along with gzip compression or `max_queued_writes`. Only
+        supported by the C++ implementation.
+    num_shards : int, default = 1
+        When greater than 1, the output is split across this many files, each with its own writer, the i-th one being
+        named by inserting `.shard-i` before the extension of `filename`. Only supported by the C++ implementation.
+    shard_column : str, default = None
+        Column whose hash selects the shard each row is written to. `None` writes each message whole to a shard not
+        being written to by another thread. Only supported by the C++ implementation.
     """
 
     def __init__(self,
@@ -58,10 +85,27 @@ class WriteToFileStage(PassThruTypeMixin, SinglePortStage):
                  overwrite: bool = False,
                  file_type: FileTypes = FileTypes.Auto,
                  include_index_col: bool = True,
-                 flush: bool = False):
+                 flush: bool = False,
+                 compression: str = None,
+                 row_group_size_rows: int = 0,
+                 max_file_bytes: int = 0,
+                 max_file_age_secs: int = 0,
+                 max_queued_writes: int = 0,
+                 device_write: bool = False,
+                 num_shards: int = 1,
+                 shard_column: str = None):
 
         super().__init__(c)
 
+        self._compression = compression
+        self._row_group_size_rows = row_group_size_rows
+        self._max_file_bytes = max_file_bytes
+        self._max_file_age_secs = max_file_age_secs
+        self._max_queued_writes = max_queued_writes
+        self._device_write = device_write
+        self._num_shards = num_shards
+        self._shard_column = shard_column
+
         self._controller = WriteToFileController(filename=filename,
                                                  overwrite=overwrite,
                                                  file_type=file_type,
@@ -79,11 +123,11 @@ class WriteToFileStage(PassThruTypeMixin, SinglePortStage):
 
         Returns
         -------
-        typing.Tuple(`morpheus.pipeline.messages.MessageMeta`, )
+        typing.Tuple(`morpheus.pipeline.messages.MessageMeta`, `morpheus.pipeline.messages.ControlMessage`)
             Accepted input types.
 
         """
-        return (MessageMeta, )
+        return (MessageMeta, ControlMessage)
 
     def supports_cpp_node(self):
         """Indicates whether this stage supports a C++ node."""
@@ -92,13 +136,26 @@ class WriteToFileStage(PassThruTypeMixin, SinglePortStage):
     def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
         # Sink to file
         if (self._build_cpp_node()):
-            to_file_node = _stages.WriteToFileStage(builder,
-                                                    self.unique_name,
-                                                    self._controller.output_file,
-                                                    "w",
-                                                    self._controller.file_type,
-                                                    self._controller.include_index_col,
-                                                    self._controller.flush)
+            if (self._schema.input_type == ControlMessage):
+                node_class = _stages.WriteToFileControlMessageStage
+            else:
+                node_class = _stages.WriteToFileStage
+
+            to_file_node = node_class(builder,
+                                      self.unique_name,
+                                      self._controller.output_file,
+                                      "w",
+                                      self._controller.file_type,
+                                      self._controller.include_index_col,
+                                      self._controller.flush,
+                                      compression=self._compression or "",
+                                      row_group_size_rows=self._row_group_size_rows,
+                                      max_file_bytes=self._max_file_bytes,
+                                      max_file_age_secs=self._max_file_age_secs,
+                                      max_queued_writes=self._max_queued_writes,
+                                      device_write=self._device_write,
+                                      num_shards=self._num_shards,
+                                      shard_column=self._shard_column or "")
         else:
 
             to_file_node = builder.make_node(self.unique_name, ops.build(self._controller.node_fn))
@@ -20,6 +20,7 @@ import confluent_kafka as ck
 import mrc
 from mrc.core import operators as ops
 
+import morpheus._lib.stages as _stages
 from morpheus.cli.register_stage import register_stage
 from morpheus.config import Config
 from morpheus.io import serializers
@@ -43,17 +44,49 @@ class WriteToKafkaStage(PassThruTypeMixin, SinglePortStage):
         Kafka cluster bootstrap servers separated by comma.
     output_topic : str
         Output kafka topic.
+    client_id : str, default = None
+        Client ID to use when producing messages.
+    key_column : str, default = None
+        Name of a string column whose values are used as the message keys, rows with the same key are written to the
+        same partition. By default rows are distributed across partitions by the Kafka partitioner.
+    consumer_group_id : str, default = None
+        Group ID of a `from-kafka` stage of this pipeline. When set, the rows are produced in transactions which also
+        commit the offsets consumed by that stage, such that each consumed message has its rows written exactly once.
+        Requires `transactional_id` and the C++ implementation, this stage should then be the last of the pipeline.
+    transactional_id : str, default = None
+        Transactional ID of the producer, which must be unique to each instance of the pipeline and stay the same
+        across restarts.
+    transaction_interval : float, default = 1.0
+        Interval in seconds at which the open transaction is committed. Longer intervals amortize the cost of each
+        commit over more rows, at the expense of latency for consumers reading committed messages only.
 
     """
 
-    def __init__(self, c: Config, bootstrap_servers: str, output_topic: str, client_id: str = None):
+    def __init__(self,
+                 c: Config,
+                 bootstrap_servers: str,
+                 output_topic: str,
+                 client_id: str = None,
+                 key_column: str = None,
+                 consumer_group_id: str = None,
+                 transactional_id: str = None,
+                 transaction_interval: float = 1.0):
         super().__init__(c)
 
         self._kafka_conf = {'bootstrap.servers': bootstrap_servers}
         if client_id is not None:
             self._kafka_conf['client.id'] = client_id
 
+        if consumer_group_id is not None:
+            if transactional_id is None:
+                raise ValueError("A transactional_id is required to commit the offsets of a consumer group")
+
+            self._kafka_conf['transactional.id'] = transactional_id
+
         self._output_topic = output_topic
+        self._key_column = key_column
+        self._consumer_group_id = consumer_group_id
+        self._transaction_interval = transaction_interval
         self._poll_time = 0.2
         self._max_concurrent = c.num_threads
 
@@ -74,10 +107,26 @@ class WriteToKafkaStage(PassThruTypeMixin, SinglePortStage):
         return (MessageMeta, )
 
     def supports_cpp_node(self):
-        return False
+        return True
 
     def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
 
+        if (self._build_cpp_node()):
+            node = _stages.WriteToKafkaStage(builder,
+                                             self.unique_name,
+                                             self._output_topic,
+                                             self._kafka_conf,
+                                             key_column=self._key_column,
+                                             poll_interval_ms=int(self._poll_time * 1000),
+                                             consumer_group_id=self._consumer_group_id,
+                                             transaction_interval=self._transaction_interval)
+            builder.make_edge(input_node, node)
+
+            return node
+
+        if self._consumer_group_id is not None:
+            raise RuntimeError("Committing the offsets of a consumer group requires the C++ implementation")
+
         # Convert the messages to rows of strings
         def node_fn(obs: mrc.Observable, sub: mrc.Subscriber):
 
@@ -101,13 +150,19 @@ class WriteToKafkaStage(PassThruTypeMixin, SinglePortStage):
                         sub.on_error(msg.error())
 
                 records = serializers.df_to_json(x.df, strip_newlines=True)
-                for mess in records:
+
+                if self._key_column is not None:
+                    keys = x.df[self._key_column].to_arrow().to_pylist()
+                else:
+                    keys = [None] * len(records)
+
+                for (mess, key) in zip(records, keys):
 
                     # Push all of the messages
                     while True:
                         try:
                             # this runs asynchronously, in C-K's thread
-                            producer.produce(self._output_topic, mess, callback=callback)
+                            producer.produce(self._output_topic, mess, key=key, callback=callback)
                             break
                         except BufferError:
                             time.sleep(self._poll_time)
@@ -55,6 +55,9 @@ class WriteToVectorDBStage(PassThruTypeMixin, SinglePortStage):
     write_time_interval : float
         Specifies the time interval (in seconds) for writing messages, or writing messages
         when the accumulated batch size is reached.
+    max_in_flight_writes : int
+        Number of writes performed in the background while the following messages are accumulated. When 0 the writes
+        are performed synchronously.
     **service_kwargs : dict
         Additional keyword arguments to pass when creating a VectorDBService instance.
 
@@ -74,6 +77,7 @@ class WriteToVectorDBStage(PassThruTypeMixin, SinglePortStage):
                  batch_size: int = 1024,
                  write_time_interval: float = 3.0,
                  resource_schemas: dict = None,
+                 max_in_flight_writes: int = 0,
                  **service_kwargs):
 
         super().__init__(config)
@@ -90,6 +94,7 @@ class WriteToVectorDBStage(PassThruTypeMixin, SinglePortStage):
             "default_resource_name": resource_name,
             "embedding_column_name": embedding_column_name,
             "is_service_serialized": is_service_serialized,
+            "max_in_flight_writes": max_in_flight_writes,
             "recreate": recreate,
             "resource_kwargs": resource_kwargs,
             "resource_schemas": resource_schemas,
@@ -48,6 +48,14 @@ class AddClassificationsStage(AddScoresStageBase):
         Datatype of the scores columns.
     threshold : typing.Optional[float], default = 0.5
         Converts all scores to a boolean value using this threshold. If `None`, scores are used, as-is.
+    top_k : int, default = 0
+        When greater than 0, write the `top_k` largest scores of each row to the `{prefix}top_{j}_id` and
+        `{prefix}top_{j}_score` columns rather than a column per label. The id of ranks whose score is not above
+        `threshold` is -1.
+    packed_column : str, default = ""
+        When set, pack the thresholded labels of each row into a single uint64 column of this name rather than a column
+        per label, bit `i` holding the `i`-th label of `packed_labels`. The boolean columns can be recovered with
+        `unpack_labels`.
 
     """
 
@@ -57,8 +65,16 @@ class AddClassificationsStage(AddScoresStageBase):
                  labels: typing.List[str] = None,
                  prefix: str = "",
                  probs_type: TypeId = TypeId.BOOL8,
-                 threshold: float = 0.5):
-        super().__init__(c, labels=labels, prefix=prefix, probs_type=probs_type, threshold=threshold)
+                 threshold: float = 0.5,
+                 top_k: int = 0,
+                 packed_column: str = ""):
+        super().__init__(c,
+                         labels=labels,
+                         prefix=prefix,
+                         probs_type=probs_type,
+                         threshold=threshold,
+                         top_k=top_k,
+                         packed_column=packed_column)
 
     @property
     def name(self) -> str:
@@ -74,9 +90,15 @@ class AddClassificationsStage(AddScoresStageBase):
             return _stages.AddClassificationsControlMessageStage(builder,
                                                                  self.unique_name,
                                                                  self._idx2label,
-                                                                 self._threshold)
+                                                                 self._threshold,
+                                                                 top_k=self._top_k,
+                                                                 top_k_prefix=self._prefix,
+                                                                 packed_column=self._packed_column)
 
         return _stages.AddClassificationsMultiResponseMessageStage(builder,
                                                                    self.unique_name,
                                                                    self._idx2label,
-                                                                   self._threshold)
+                                                                   self._threshold,
+                                                                   top_k=self._top_k,
+                                                                   top_k_prefix=self._prefix,
+                                                                   packed_column=self._packed_column)
@@ -46,6 +46,9 @@ class AddScoresStage(AddScoresStageBase):
         Prefix to add to each label. Allows adding labels different from the `Config.class_labels` property.
     probs_type : `morpheus.common.TypeId`, default = "float32"
         Datatype of the scores columns.
+    top_k : int, default = 0
+        When greater than 0, write the `top_k` largest scores of each row to the `{prefix}top_{j}_id` and
+        `{prefix}top_{j}_score` columns rather than a column per label.
     """
 
     def __init__(self,
@@ -53,9 +56,10 @@ class AddScoresStage(AddScoresStageBase):
                  *,
                  labels: typing.List[str] = None,
                  prefix: str = "",
-                 probs_type: TypeId = TypeId.FLOAT32):
+                 probs_type: TypeId = TypeId.FLOAT32,
+                 top_k: int = 0):
         # Initialize the base with threshold=None
-        super().__init__(c, labels=labels, prefix=prefix, probs_type=probs_type, threshold=None)
+        super().__init__(c, labels=labels, prefix=prefix, probs_type=probs_type, threshold=None, top_k=top_k)
 
     @property
     def name(self) -> str:
@@ -68,6 +72,14 @@ class AddScoresStage(AddScoresStageBase):
     def _get_cpp_node(self, builder: mrc.Builder):
         import morpheus._lib.stages as _stages
         if (self._schema.input_type == ControlMessage):
-            return _stages.AddScoresControlMessageStage(builder, self.unique_name, self._idx2label)
+            return _stages.AddScoresControlMessageStage(builder,
+                                                        self.unique_name,
+                                                        self._idx2label,
+                                                        top_k=self._top_k,
+                                                        top_k_prefix=self._prefix)
 
-        return _stages.AddScoresMultiResponseMessageStage(builder, self.unique_name, self._idx2label)
+        return _stages.AddScoresMultiResponseMessageStage(builder,
+                                                          self.unique_name,
+                                                          self._idx2label,
+                                                          top_k=self._top_k,
+                                                          top_k_prefix=self._prefix)
@@ -17,9 +17,12 @@ import logging
 import typing
 from abc import abstractmethod
 
+import cupy as cp
 import mrc
 import mrc.core.operators as ops
 
+import cudf
+
 from morpheus.common import TypeId
 from morpheus.config import Config
 from morpheus.messages import ControlMessage
@@ -48,6 +51,15 @@ class AddScoresStageBase(PassThruTypeMixin, SinglePortStage):
         Datatype of the scores columns.
     threshold : typing.Optional[float]
         Converts all scores to a boolean value using this threshold. If `None`, scores are used, as-is.
+    top_k : int, default = 0
+        When greater than 0, rather than a column per label the `top_k` largest scores among the labels are written to
+        the int32 `{prefix}top_{j}_id` and float32 `{prefix}top_{j}_score` columns for each rank `j`. The id is the index
+        of the label in `Config.class_labels`. When `threshold` is set, the id of ranks whose score is not above it is
+        -1.
+    packed_column : str, default = ""
+        When set, rather than a column per label the thresholded labels of each row are packed into a single uint64
+        column of this name, bit `i` being set when the `i`-th label of `packed_labels` has a score above `threshold`.
+        Requires a `threshold`, at most 64 labels, and cannot be combined with `top_k`. See `unpack_labels`.
     """
 
     def __init__(self,
@@ -56,13 +68,20 @@ class AddScoresStageBase(PassThruTypeMixin, SinglePortStage):
                  labels: typing.List[str] = None,
                  prefix: str = "",
                  probs_type: TypeId,
-                 threshold: typing.Optional[float]):
+                 threshold: typing.Optional[float],
+                 top_k: int = 0,
+                 packed_column: str = ""):
         super().__init__(c)
 
         self._feature_length = c.feature_length
         self._labels = labels if labels is not None and len(labels) > 0 else c.class_labels
         self._prefix = prefix
         self._threshold = threshold
+        self._top_k = top_k
+        self._packed_column = packed_column
+
+        # The scores are read from the probs tensor, only writing columns
+        self._read_columns = []
 
         self._class_labels = c.class_labels
 
@@ -77,10 +96,57 @@ class AddScoresStageBase(PassThruTypeMixin, SinglePortStage):
 
             prefixed_label = self._prefix + label
             self._idx2label[self._class_labels.index(label)] = prefixed_label
-            self._needed_columns[prefixed_label] = probs_type
+
+            if (top_k == 0 and not packed_column):
+                self._needed_columns[prefixed_label] = probs_type
 
         assert len(self._idx2label) > 0, "No labels were added to the stage"
 
+        if (top_k > 0):
+            # Matches MatxUtil::MaxTopK of the C++ implementation
+            assert top_k <= min(len(self._idx2label), 32), "top_k must be at most the number of labels and at most 32"
+
+            for id_column, score_column in self._top_k_columns(self._prefix, top_k):
+                self._needed_columns[id_column] = TypeId.INT32
+                self._needed_columns[score_column] = TypeId.FLOAT32
+
+        if (packed_column):
+            assert threshold is not None, "packed_column requires a threshold"
+            assert top_k == 0, "packed_column cannot be combined with top_k"
+            # Matches MatxUtil::MaxPackedLabels of the C++ implementation
+            assert len(self._idx2label) <= 64, "packed_column supports at most 64 labels"
+
+            self._needed_columns[packed_column] = TypeId.UINT64
+
+    @property
+    def packed_labels(self) -> list[str]:
+        """
+        The labels packed into `packed_column`, the `i`-th label being held by bit `i`.
+        """
+        return [self._idx2label[i] for i in sorted(self._idx2label.keys())]
+
+    @staticmethod
+    def unpack_labels(packed: cudf.Series, labels: list[str]) -> cudf.DataFrame:
+        """
+        Splits a column written with `packed_column` back into a boolean column per label.
+
+        Parameters
+        ----------
+        packed : cudf.Series
+            The uint64 packed column.
+        labels : list[str]
+            The labels held by each bit, as returned by `packed_labels`.
+
+        Returns
+        -------
+        cudf.DataFrame
+            A boolean column per label.
+        """
+        values = packed.values.astype(cp.uint64)
+        columns = {label: ((values >> cp.uint64(i)) & cp.uint64(1)).astype(bool) for i, label in enumerate(labels)}
+
+        return cudf.DataFrame(columns, index=packed.index)
+
     def accepted_types(self) -> typing.Tuple:
         """
         Accepted input types for this stage are returned.
@@ -104,48 +170,112 @@ class AddScoresStageBase(PassThruTypeMixin, SinglePortStage):
         else:
             node = builder.make_node(
                 self.unique_name,
-                ops.map(functools.partial(self._add_labels, idx2label=self._idx2label, threshold=self._threshold)))
+                ops.map(
+                    functools.partial(self._add_labels,
+                                      idx2label=self._idx2label,
+                                      threshold=self._threshold,
+                                      top_k=self._top_k,
+                                      prefix=self._prefix,
+                                      packed_column=self._packed_column)))
 
         builder.make_edge(input_node, node)
 
         # Return input type unchanged
         return node
 
+    @staticmethod
+    def _top_k_columns(prefix: str, top_k: int) -> list[tuple[str, str]]:
+        return [(f"{prefix}top_{rank}_id", f"{prefix}top_{rank}_score") for rank in range(top_k)]
+
     @typing.overload
     @staticmethod
-    def _add_labels(x: MultiResponseMessage, idx2label: dict[int, str],
-                    threshold: typing.Optional[float]) -> MultiResponseMessage:
+    def _add_labels(x: MultiResponseMessage,
+                    idx2label: dict[int, str],
+                    threshold: typing.Optional[float],
+                    top_k: int = 0,
+                    prefix: str = "",
+                    packed_column: str = "") -> MultiResponseMessage:
         ...
 
     @typing.overload
     @staticmethod
-    def _add_labels(x: ControlMessage, idx2label: dict[int, str], threshold: typing.Optional[float]) -> ControlMessage:
+    def _add_labels(x: ControlMessage,
+                    idx2label: dict[int, str],
+                    threshold: typing.Optional[float],
+                    top_k: int = 0,
+                    prefix: str = "",
+                    packed_column: str = "") -> ControlMessage:
         ...
 
     @staticmethod
     def _add_labels(x: MultiResponseMessage | ControlMessage,
                     idx2label: dict[int, str],
-                    threshold: typing.Optional[float]):
+                    threshold: typing.Optional[float],
+                    top_k: int = 0,
+                    prefix: str = "",
+                    packed_column: str = ""):
         if isinstance(x, ControlMessage):
-            return AddScoresStageBase.process_control_message(x, idx2label, threshold)
+            return AddScoresStageBase.process_control_message(x, idx2label, threshold, top_k, prefix, packed_column)
         if isinstance(x, MultiResponseMessage):
-            return AddScoresStageBase.process_multi_message(x, idx2label, threshold)
+            return AddScoresStageBase.process_multi_message(x, idx2label, threshold, top_k, prefix, packed_column)
         raise TypeError("Unsupported message type")
 
     @staticmethod
-    def process_control_message(x: ControlMessage, idx2label: typing.Dict[int, str], threshold: typing.Optional[float]):
-        probs = x.tensors().get_tensor("probs")
-
+    def _compute_outputs(probs,
+                         idx2label: typing.Dict[int, str],
+                         threshold: typing.Optional[float],
+                         top_k: int,
+                         prefix: str,
+                         packed_column: str = "") -> dict:
         if (probs.shape[1] <= max(idx2label.keys())):
             raise RuntimeError(("Model output did not contain enough columns to fufill the requested labels. "
                                 f"Label indexes: {idx2label}, Model output columns: {probs.shape[1]}"))
 
+        if (top_k > 0):
+            # Stable sort of the negated scores, such that ties are broken by the order of the labels
+            label_columns = cp.array(sorted(idx2label.keys()), dtype=cp.int32)
+            candidates = probs[:, label_columns].astype(cp.float32)
+            order = cp.argsort(-candidates, axis=1, kind="stable")[:, :top_k]
+
+            scores = cp.take_along_axis(candidates, order, axis=1)
+            ids = label_columns[order]
+
+            if (threshold is not None):
+                ids[scores <= threshold] = -1
+
+            outputs = {}
+            for rank, (id_column, score_column) in enumerate(AddScoresStageBase._top_k_columns(prefix, top_k)):
+                outputs[id_column] = ids[:, rank]
+                outputs[score_column] = scores[:, rank]
+
+            return outputs
+
+        if (packed_column):
+            label_columns = sorted(idx2label.keys())
+            bits = (probs[:, label_columns] > threshold).astype(cp.uint64)
+            weights = cp.left_shift(cp.uint64(1), cp.arange(len(label_columns), dtype=cp.uint64))
+
+            return {packed_column: (bits * weights).sum(axis=1, dtype=cp.uint64)}
+
         if (threshold is not None):
             probs = (probs > threshold).astype(bool)
 
+        return {label: probs[:, i] for i, label in idx2label.items()}
+
+    @staticmethod
+    def process_control_message(x: ControlMessage,
+                                idx2label: typing.Dict[int, str],
+                                threshold: typing.Optional[float],
+                                top_k: int = 0,
+                                prefix: str = "",
+                                packed_column: str = ""):
+        probs = x.tensors().get_tensor("probs")
+
+        outputs = AddScoresStageBase._compute_outputs(probs, idx2label, threshold, top_k, prefix, packed_column)
+
         # Do these one at a time to prevent failures
-        for i, label in idx2label.items():
-            x.payload().set_data(label, probs[:, i])
+        for column, values in outputs.items():
+            x.payload().set_data(column, values)
 
         # Return the same object
         return x
@@ -153,19 +283,17 @@ class AddScoresStageBase(PassThruTypeMixin, SinglePortStage):
     @staticmethod
     def process_multi_message(x: MultiResponseMessage,
                               idx2label: typing.Dict[int, str],
-                              threshold: typing.Optional[float]):
+                              threshold: typing.Optional[float],
+                              top_k: int = 0,
+                              prefix: str = "",
+                              packed_column: str = ""):
         probs = x.get_probs_tensor()
 
-        if (probs.shape[1] <= max(idx2label.keys())):
-            raise RuntimeError(("Model output did not contain enough columns to fufill the requested labels. "
-                                f"Label indexes: {idx2label}, Model output columns: {probs.shape[1]}"))
-
-        if (threshold is not None):
-            probs = (probs > threshold).astype(bool)
+        outputs = AddScoresStageBase._compute_outputs(probs, idx2label, threshold, top_k, prefix, packed_column)
 
         # Do these one at a time to prevent failures
-        for i, label in idx2label.items():
-            x.set_meta(label, probs[:, i])
+        for column, values in outputs.items():
+            x.set_meta(column, values)
 
         # Return the same object
         return x
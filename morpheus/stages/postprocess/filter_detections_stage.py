@@ -21,8 +21,10 @@ from mrc.core import operators as ops
 import morpheus._lib.stages as _stages
 from morpheus.cli.register_stage import register_stage
 from morpheus.common import FilterSource
+from morpheus.common import TypeId
 from morpheus.config import Config
 from morpheus.controllers.filter_detections_controller import FilterDetectionsController
+from morpheus.messages import ControlMessage
 from morpheus.messages import MultiMessage
 from morpheus.messages import MultiResponseMessage
 from morpheus.pipeline.single_port_stage import SinglePortStage
@@ -40,7 +42,7 @@ class FilterDetectionsStage(SinglePortStage):
     criteria. Rows in the `meta` dataframe are excluded if their associated value in the `probs` array is less than or
     equal to `threshold`.
 
-    This stage can operate in two different modes set by the `copy` argument.
+    This stage can operate in three different modes set by the `copy` and `mask_column` arguments.
     When the `copy` argument is `True` (default), rows that meet the filter criteria are copied into a new dataframe.
     When `False` sliced views are used instead.
 
@@ -59,6 +61,12 @@ class FilterDetectionsStage(SinglePortStage):
     Depending on the downstream stages, this can cause performance issues, especially if those stages need to acquire
     the Python GIL.
 
+    When `mask_column` is set, `copy` is ignored and each incoming message is emitted whole, with the result of the
+    filter written to the boolean `mask_column` of its DataFrame. No rows are copied or sliced, leaving downstream
+    stages to apply the mask themselves.
+
+    Both `MultiMessage` and `ControlMessage` inputs are supported.
+
     Parameters
     ----------
     c : `morpheus.config.Config`
@@ -73,6 +81,9 @@ class FilterDetectionsStage(SinglePortStage):
         otherwise.
     field_name : str
         Name of the tensor or DataFrame column to use as the filter criteria
+    mask_column : str
+        When set, name of the boolean DataFrame column the result of the filter is written to instead of filtering the
+        rows of the message.
     """
 
     def __init__(self,
@@ -80,13 +91,21 @@ class FilterDetectionsStage(SinglePortStage):
                  threshold: float = 0.5,
                  copy: bool = True,
                  filter_source: FilterSource = FilterSource.Auto,
-                 field_name: str = "probs"):
+                 field_name: str = "probs",
+                 mask_column: str = None):
         super().__init__(c)
 
         self._copy = copy
         self._controller = FilterDetectionsController(threshold=threshold,
                                                       filter_source=filter_source,
-                                                      field_name=field_name)
+                                                      field_name=field_name,
+                                                      mask_column=mask_column)
+
+        if mask_column is not None:
+            self._needed_columns[mask_column] = TypeId.BOOL8
+
+        # Only read when filtering on a DataFrame column rather than a tensor
+        self._set_read_column_names([field_name])
 
     @property
     def name(self) -> str:
@@ -98,14 +117,14 @@ class FilterDetectionsStage(SinglePortStage):
 
         Returns
         -------
-        typing.Tuple[`morpheus.pipeline.messages.MultiMessage`, ]
+        typing.Tuple[`morpheus.pipeline.messages.MultiMessage`, `morpheus.messages.ControlMessage`]
             Accepted input types.
 
         """
         if self._controller.filter_source == FilterSource.TENSOR:
-            return (MultiResponseMessage, )
+            return (MultiResponseMessage, ControlMessage)
 
-        return (MultiMessage, )
+        return (MultiMessage, ControlMessage)
 
     def compute_schema(self, schema: StageSchema):
         self._controller.update_filter_source(message_type=schema.input_type)
@@ -117,15 +136,23 @@ class FilterDetectionsStage(SinglePortStage):
 
     def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
         if self._build_cpp_node():
-            node = _stages.FilterDetectionsStage(builder,
-                                                 self.unique_name,
-                                                 self._controller.threshold,
-                                                 self._copy,
-                                                 self._controller.filter_source,
-                                                 self._controller.field_name)
+            if (self._schema.input_type == ControlMessage):
+                stage_class = _stages.FilterDetectionsControlMessageStage
+            else:
+                stage_class = _stages.FilterDetectionsMultiMessageStage
+
+            node = stage_class(builder,
+                               self.unique_name,
+                               self._controller.threshold,
+                               self._copy,
+                               self._controller.filter_source,
+                               self._controller.field_name,
+                               self._controller.mask_column or "")
         else:
 
-            if self._copy:
+            if self._controller.mask_column is not None:
+                node = builder.make_node(self.unique_name, ops.map(self._controller.filter_mask))
+            elif self._copy:
                 node = builder.make_node(self.unique_name,
                                          ops.map(self._controller.filter_copy),
                                          ops.filter(lambda x: x is not None))
@@ -0,0 +1,104 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import typing
+
+import cupy as cp
+import mrc
+import mrc.core.operators as ops
+
+from morpheus.cli.register_stage import register_stage
+from morpheus.common import TypeId
+from morpheus.config import Config
+from morpheus.messages import MultiResponseMessage
+from morpheus.messages import TensorMemory
+from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
+from morpheus.pipeline.single_port_stage import SinglePortStage
+
+_OUTPUT_DTYPES = {TypeId.FLOAT16: cp.float16, TypeId.FLOAT32: cp.float32, TypeId.FLOAT64: cp.float64}
+
+
+@register_stage("normalize-embeddings")
+class NormalizeEmbeddingsStage(PassThruTypeMixin, SinglePortStage):
+    """
+    Converts the embeddings computed by an inference stage to a single contiguous tensor per message.
+
+    Each embedding can be scaled to a unit L2 norm, such that the embeddings can be compared with an inner product, and
+    the tensor converted to float16 to halve the size of the embeddings written to a vector database. The C++
+    implementation converts a whole message with a single kernel launch.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    tensor_name : str, default = "probs"
+        Name of the 2D embeddings tensor.
+    output_type : `morpheus.common.TypeId`, default = "float16"
+        Datatype of the embeddings, one of float16, float32 or float64.
+    normalize : bool, default = True
+        Whether to scale each embedding to a unit L2 norm. Embeddings of zeros are left as is.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 *,
+                 tensor_name: str = "probs",
+                 output_type: TypeId = TypeId.FLOAT16,
+                 normalize: bool = True):
+        super().__init__(c)
+
+        if (output_type not in _OUTPUT_DTYPES):
+            raise ValueError(f"Unsupported output type {output_type}, expected one of float16, float32 or float64")
+
+        self._tensor_name = tensor_name
+        self._output_type = output_type
+        self._normalize = normalize
+
+    @property
+    def name(self) -> str:
+        return "normalize-embeddings"
+
+    def accepted_types(self) -> typing.Tuple:
+        return (MultiResponseMessage, )
+
+    def supports_cpp_node(self):
+        return True
+
+    def _normalize_embeddings(self, message: MultiResponseMessage) -> MultiResponseMessage:
+        tensors = message.tensors
+        embeddings = tensors[self._tensor_name].astype(cp.float32)
+
+        if (self._normalize):
+            norms = cp.linalg.norm(embeddings, axis=1, keepdims=True)
+            embeddings = embeddings / cp.where(norms > 0, norms, 1)
+
+        tensors[self._tensor_name] = cp.ascontiguousarray(embeddings.astype(_OUTPUT_DTYPES[self._output_type]))
+
+        return MultiResponseMessage.from_message(message, memory=TensorMemory(count=message.count, tensors=tensors))
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (self._build_cpp_node()):
+            import morpheus._lib.stages as _stages
+            node = _stages.NormalizeEmbeddingsStage(builder,
+                                                    self.unique_name,
+                                                    tensor_name=self._tensor_name,
+                                                    output_type=self._output_type,
+                                                    normalize=self._normalize)
+        else:
+            node = builder.make_node(self.unique_name, ops.map(self._normalize_embeddings))
+
+        builder.make_edge(input_node, node)
+
+        return node
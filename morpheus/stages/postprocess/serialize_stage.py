@@ -67,6 +67,10 @@ class SerializeStage(SinglePortStage):
 
         self._controller = SerializeController(include=include, exclude=exclude, fixed_columns=fixed_columns)
 
+        # Without an include list every column not excluded is serialized
+        if (len(include) > 0):
+            self._read_columns = list(include)
+
     @property
     def name(self) -> str:
         return "serialize"
@@ -86,6 +90,9 @@ class SerializeStage(SinglePortStage):
     def compute_schema(self, schema: StageSchema):
         schema.output_schema.set_type(MessageMeta)
 
+    def emits_new_dataframe(self) -> bool:
+        return True
+
     def supports_cpp_node(self):
         # Enable support by default
         return True
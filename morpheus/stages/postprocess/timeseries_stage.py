@@ -353,6 +353,10 @@ class _UserTimeSeries:
 
             new_timedata = x.get_meta([self._timestamp_col])
 
+            # The bins only depend on t0, so once it is known only the new rows need to be binned
+            if (self._t0_epoch is not None):
+                new_timedata = new_timedata.assign(event_bin=self._calc_bin_series(new_timedata[self._timestamp_col]))
+
             # Save this message event times in the event list. Ensure the values are always sorted
             self._timeseries_data = pd.concat([self._timeseries_data, new_timedata]).sort_index()
 
@@ -372,8 +376,8 @@ class _UserTimeSeries:
             # TODO(MDD): Floor to the day to unsure all buckets are always aligned with val data
             self._t0_epoch = self._t0_epoch.floor(freq="D")
 
-        # Calc the bins for the timeseries data
-        self._timeseries_data["event_bin"] = self._calc_bin_series(self._timeseries_data[self._timestamp_col])
+            # Calc the bins for the timeseries data received so far, later data being binned as it arrives
+            self._timeseries_data["event_bin"] = self._calc_bin_series(self._timeseries_data[self._timestamp_col])
 
         # At this point there are 3 things that can happen
         # 1. We are warming up to build a front buffer. Save the current message times and send the message on
@@ -0,0 +1,112 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Labels addresses with the most specific of a table of networks on the device."""
+
+import typing
+
+import mrc
+
+import morpheus._lib.stages as _stages
+from morpheus.common import FileTypes
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
+from morpheus.pipeline.single_port_stage import SinglePortStage
+
+
+class CidrLookupStage(PassThruTypeMixin, SinglePortStage):
+    """
+    Labels the addresses of the payload of each incoming `ControlMessage` with the most specific network holding them
+    among a table of labelled networks, such as a GeoIP, ASN or internal network zone database. Longest prefix matching
+    can not be expressed as a join, `EnrichStage` only matching exact keys.
+
+    The table is loaded from a Parquet, CSV or JSON file with one IPv4 or IPv6 network in CIDR notation per row, along
+    with its labels. The networks are flattened into sorted disjoint address ranges held on the device, and each address
+    is resolved with a binary search. When a network is listed more than once, its last row is kept.
+
+    Addresses may be IPv4 strings, integer IPv4 addresses, or 128-bit addresses such as the `src_ip6` and `dst_ip6`
+    columns of `DocaSourceStage` with `numeric_addresses`, which hold both IPv4 and IPv6 addresses. IPv6 strings are
+    not resolved.
+
+    Each label is appended as a `<address column>_<label>` column, holding nulls for addresses outside of every
+    network. A payload which fails to be labelled, such as one missing an address column, raises an error stopping the
+    pipeline.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    filename : str
+        File of the networks.
+    address_columns : list of str
+        Columns of the payload holding the addresses to label.
+    label_columns : list of str, optional
+        Columns of the table appended for each address, by default every column but `network_column`.
+    network_column : str, optional
+        Column of the networks in CIDR notation, by default "network" as in the GeoLite2 CSV databases.
+    file_type : `morpheus.common.FileTypes`, optional
+        Type of the file, by default inferred from its extension.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 filename: str,
+                 address_columns: typing.List[str],
+                 label_columns: typing.List[str] = None,
+                 network_column: str = "network",
+                 file_type: FileTypes = FileTypes.Auto):
+        super().__init__(c)
+
+        if (len(address_columns) == 0):
+            raise ValueError("At least one address column is required to look up networks")
+
+        self._filename = filename
+        self._address_columns = list(address_columns)
+        self._label_columns = list(label_columns) if label_columns is not None else []
+        self._network_column = network_column
+        self._file_type = file_type
+
+        if (self._network_column in self._label_columns):
+            raise ValueError(f"The network column '{network_column}' can not be a label column")
+
+        self._set_read_column_names(self._address_columns)
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "cidr-lookup"
+
+    def accepted_types(self) -> typing.Tuple:
+        """Input types accepted by this stage."""
+        return (ControlMessage, )
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("CidrLookupStage does not support Python nodes")
+
+        node = _stages.CidrLookupStage(builder,
+                                       self.unique_name,
+                                       filename=self._filename,
+                                       file_type=self._file_type,
+                                       network_column=self._network_column,
+                                       label_columns=self._label_columns,
+                                       address_columns=self._address_columns)
+        builder.make_edge(input_node, node)
+
+        return node
@@ -0,0 +1,109 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Drops the rows whose keys were already seen within a sliding time window on the device."""
+
+import typing
+
+import mrc
+
+import morpheus._lib.stages as _stages
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
+from morpheus.pipeline.single_port_stage import SinglePortStage
+
+
+class DeduplicateStage(PassThruTypeMixin, SinglePortStage):
+    """
+    Drops the rows of the payload of each incoming `ControlMessage` whose key columns were already seen within a sliding
+    time window, such as retried deliveries or the repeated events of chatty agents, before they consume inference
+    capacity. Intended to sit between `DeserializeStage` and the preprocessing stages.
+
+    The keys of each row are hashed on the device and checked against the hashes of the rows seen within the window,
+    held in device memory in `num_buckets` buckets which are dropped as a whole once older than the window. When more
+    than `max_keys` keys are held, the oldest buckets are dropped early. Messages without any row left are not emitted,
+    the others carry the number of duplicate rows dropped as their `duplicate_rows` metadata.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    key_columns : list of str
+        Columns identifying duplicate rows.
+    window_ms : int
+        Duration in milliseconds after which a key is forgotten, by default 5 minutes.
+    num_buckets : int
+        Number of buckets the window is split into, the window rolling over one bucket at a time.
+    max_keys : int
+        Maximum number of keys held on the device, each key taking 8 bytes.
+    checkpoint_interval_ms : int
+        Minimum duration in milliseconds between two checkpoints of the window, written to the directory set with
+        `morpheus._lib.common.StateCheckpoint.set_directory` and restored by a restarted pipeline, by default 0
+        disabling checkpoints.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 key_columns: typing.List[str],
+                 window_ms: int = 300000,
+                 num_buckets: int = 10,
+                 max_keys: int = 10000000,
+                 checkpoint_interval_ms: int = 0):
+        super().__init__(c)
+
+        if (len(key_columns) == 0):
+            raise ValueError("At least one key column is required to deduplicate rows")
+
+        if (window_ms <= 0 or num_buckets <= 0 or max_keys <= 0):
+            raise ValueError("window_ms, num_buckets and max_keys must be greater than 0")
+
+        if (checkpoint_interval_ms < 0):
+            raise ValueError("checkpoint_interval_ms must not be negative")
+
+        self._key_columns = list(key_columns)
+        self._window_ms = window_ms
+        self._num_buckets = num_buckets
+        self._max_keys = max_keys
+        self._checkpoint_interval_ms = checkpoint_interval_ms
+
+        self._set_read_column_names(self._key_columns)
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "deduplicate"
+
+    def accepted_types(self) -> typing.Tuple:
+        """Input types accepted by this stage."""
+        return (ControlMessage, )
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("DeduplicateStage does not support Python nodes")
+
+        node = _stages.DeduplicateStage(builder,
+                                        self.unique_name,
+                                        key_columns=self._key_columns,
+                                        window_ms=self._window_ms,
+                                        num_buckets=self._num_buckets,
+                                        max_keys=self._max_keys,
+                                        checkpoint_interval_ms=self._checkpoint_interval_ms)
+        builder.make_edge(input_node, node)
+
+        return node
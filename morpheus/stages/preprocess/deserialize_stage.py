@@ -77,6 +77,9 @@ class DeserializeStage(MultiMessageStage):
         # Mark these stages to log timestamps if requested
         self._should_log_timestamps = True
 
+        # Only slices the incoming DataFrames
+        self._read_columns = []
+
         self._message_type = message_type
         self._task_type = task_type
         self._task_payload = task_payload
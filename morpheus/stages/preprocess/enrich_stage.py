@@ -0,0 +1,127 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Enriches rows with the columns of a reference table through a hash join on the device."""
+
+import typing
+
+import mrc
+import pandas as pd
+
+import morpheus._lib.stages as _stages
+from morpheus.common import FileTypes
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
+from morpheus.pipeline.single_port_stage import SinglePortStage
+
+
+class EnrichStage(PassThruTypeMixin, SinglePortStage):
+    """
+    Enriches the payload of each incoming `ControlMessage` with the columns of a reference table, such as an asset
+    inventory or a threat intelligence feed, matched by the key columns of its rows. Replaces a pandas merge per batch
+    with a `cudf` hash join probing a hash table built once per version of the reference table.
+
+    The reference table is loaded from a Parquet, CSV or JSON file, the last row of each key being kept when keys are
+    repeated. When `reload_interval` is set, the file is checked for changes at that interval and a changed file is
+    loaded in the background, batches being enriched with the previous version until the new one is ready. A version
+    which fails to load is logged, the previous one being kept.
+
+    Rows without a match, or with a null key, hold nulls in the appended columns. A payload which fails to be enriched,
+    such as one missing a key column, raises an error stopping the pipeline. Several reference tables are joined by
+    chaining several stages.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    filename : str
+        File of the reference table.
+    key_columns : list of str
+        Key columns of the reference table.
+    value_columns : list of str, optional
+        Columns of the reference table appended to the rows, by default every other column.
+    event_key_columns : list of str, optional
+        Key columns of the rows, in the order of `key_columns`, by default the same names.
+    prefix : str, optional
+        Prepended to the names of the appended columns, which replace any column of the payload of the same name.
+    file_type : `morpheus.common.FileTypes`, optional
+        Type of the file, by default inferred from its extension.
+    reload_interval : str, optional
+        Duration between two checks of the file for a new version, parsable by `pandas.Timedelta`, by default None
+        disabling reloads.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 filename: str,
+                 key_columns: typing.List[str],
+                 value_columns: typing.List[str] = None,
+                 event_key_columns: typing.List[str] = None,
+                 prefix: str = "",
+                 file_type: FileTypes = FileTypes.Auto,
+                 reload_interval: str = None):
+        super().__init__(c)
+
+        if (len(key_columns) == 0):
+            raise ValueError("At least one key column is required to enrich rows")
+
+        if (event_key_columns is not None and len(event_key_columns) != len(key_columns)):
+            raise ValueError("event_key_columns must hold as many columns as key_columns")
+
+        self._filename = filename
+        self._key_columns = list(key_columns)
+        self._value_columns = list(value_columns) if value_columns is not None else []
+        self._event_key_columns = list(event_key_columns) if event_key_columns is not None else list(key_columns)
+        self._prefix = prefix
+        self._file_type = file_type
+
+        self._reload_interval_ms = 0
+        if (reload_interval is not None):
+            self._reload_interval_ms = int(pd.Timedelta(reload_interval).total_seconds() * 1000)
+
+            if (self._reload_interval_ms <= 0):
+                raise ValueError("reload_interval must be positive")
+
+        self._set_read_column_names(self._event_key_columns)
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "enrich"
+
+    def accepted_types(self) -> typing.Tuple:
+        """Input types accepted by this stage."""
+        return (ControlMessage, )
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("EnrichStage does not support Python nodes")
+
+        node = _stages.EnrichStage(builder,
+                                   self.unique_name,
+                                   filename=self._filename,
+                                   file_type=self._file_type,
+                                   key_columns=self._key_columns,
+                                   value_columns=self._value_columns,
+                                   event_key_columns=self._event_key_columns,
+                                   prefix=self._prefix,
+                                   reload_interval_ms=self._reload_interval_ms)
+        builder.make_edge(input_node, node)
+
+        return node
@@ -0,0 +1,164 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Filters the rows of each message with predicates on their columns evaluated on the device."""
+
+import ipaddress
+import operator
+import typing
+
+import mrc
+from mrc.core import operators as ops
+
+import cudf
+
+import morpheus._lib.stages as _stages
+from morpheus.config import Config
+from morpheus.messages import MessageMeta
+from morpheus.parsers import ip
+from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
+from morpheus.pipeline.single_port_stage import SinglePortStage
+
+COMPARISON_OPS = {
+    "==": operator.eq,
+    "!=": operator.ne,
+    "<": operator.lt,
+    "<=": operator.le,
+    ">": operator.gt,
+    ">=": operator.ge,
+}
+
+
+class FilterRowsStage(PassThruTypeMixin, SinglePortStage):
+    """
+    Drops rows early in a pipeline, before they are copied to tensors and sent to inference, such as the requests to
+    health check URLs or the traffic of allow listed addresses.
+
+    Each predicate is a tuple of a column, an operator and a value, the operator being one of:
+    - `matches` : the string contains a match of the regular expression `value`
+    - `in_cidr` : the string is an IPv4 address within one of the comma separated CIDR blocks of `value`, such as
+      `10.0.0.0/8,192.168.1.7`
+    - `==`, `!=`, `<`, `<=`, `>`, `>=` : the value compares to `value`, parsed as a number for numeric columns
+
+    Null values never match. The C++ node evaluates the predicates as a single boolean mask per message on the device
+    and emits the kept rows compacted into a new table, or the incoming message itself when every row is kept. Messages
+    without any row left are not emitted.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    predicates : list of tuple of str
+        Predicates on the columns of the rows, as tuples of the column, operator and value.
+    match_all : bool
+        Whether a row matches when all of the predicates match, rather than any of them.
+    exclude : bool
+        Whether the matching rows are dropped, rather than kept.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 predicates: typing.List[typing.Tuple[str, str, str]],
+                 match_all: bool = True,
+                 exclude: bool = False):
+        super().__init__(c)
+
+        if (len(predicates) == 0):
+            raise ValueError("At least one predicate is required to filter rows")
+
+        for (column, op, value) in predicates:
+            if (op not in ("matches", "in_cidr") and op not in COMPARISON_OPS):
+                raise ValueError(f"Unknown operator '{op}' for the column '{column}'")
+
+            if (op == "in_cidr"):
+                # Raises a ValueError for invalid blocks
+                self._parse_networks(value)
+
+        self._predicates = [tuple(predicate) for predicate in predicates]
+        self._match_all = match_all
+        self._exclude = exclude
+
+        self._set_read_column_names([column for (column, _, _) in self._predicates])
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "filter-rows"
+
+    def accepted_types(self) -> typing.Tuple:
+        """Input types accepted by this stage."""
+        return (MessageMeta, )
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    @staticmethod
+    def _parse_networks(value: str) -> typing.List[ipaddress.IPv4Network]:
+        return [ipaddress.IPv4Network(block.strip(), strict=False) for block in value.split(",") if block.strip()]
+
+    def _evaluate(self, df: cudf.DataFrame, column: str, op: str, value: str) -> cudf.Series:
+        values = df[column]
+
+        if (op == "matches"):
+            result = values.str.contains(value, regex=True)
+        elif (op == "in_cidr"):
+            addresses = ip.ip_to_int(values.where(ip.is_ip(values))).astype("int64")
+            result = None
+            for network in self._parse_networks(value):
+                in_block = (addresses & int(network.netmask)) == int(network.network_address)
+                result = in_block if result is None else (result | in_block)
+        elif (values.dtype == "object"):
+            result = COMPARISON_OPS[op](values, value)
+        else:
+            result = COMPARISON_OPS[op](values, float(value))
+
+        return result.fillna(False).astype(bool)
+
+    def _filter_rows(self, message: MessageMeta) -> typing.Optional[MessageMeta]:
+        with message.mutable_dataframe() as df:
+            keep = None
+            for (column, op, value) in self._predicates:
+                result = self._evaluate(df, column, op, value)
+                if (keep is None):
+                    keep = result
+                else:
+                    keep = (keep & result) if self._match_all else (keep | result)
+
+            if (self._exclude):
+                keep = ~keep
+
+            if (keep.all()):
+                return message
+
+            if (not keep.any()):
+                return None
+
+            return MessageMeta(df[keep.values])
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (self._build_cpp_node()):
+            node = _stages.FilterRowsStage(builder,
+                                           self.unique_name,
+                                           predicates=self._predicates,
+                                           match_all=self._match_all,
+                                           exclude=self._exclude)
+        else:
+            node = builder.make_node(self.unique_name,
+                                     ops.map(self._filter_rows),
+                                     ops.filter(lambda x: x is not None))
+
+        builder.make_edge(input_node, node)
+
+        return node
@@ -0,0 +1,128 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Samples the rows of low priority classes on the device as the pressure on the pipeline grows."""
+
+import typing
+
+import mrc
+
+import morpheus._lib.stages as _stages
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
+from morpheus.pipeline.single_port_stage import SinglePortStage
+
+
+class LoadSheddingStage(PassThruTypeMixin, SinglePortStage):
+    """
+    Sheds load during bursts by sampling the rows of the low priority classes of the payload of each incoming
+    `ControlMessage`, rather than falling behind on every row. Works on the output of `DeserializeStage` when it emits
+    control messages.
+
+    The pressure is read from a gauge of the metrics registry, such as `morpheus_kafka_source_consumer_lag`, or from
+    the mean of the values observed by a histogram since the previous message, such as
+    `morpheus_stage_latency_seconds`. It is scaled linearly from 0 at `low_watermark` to 1 at `high_watermark`, and the
+    sampling rate of each class in `min_rates` goes from 1 without pressure down to its minimum rate at full pressure.
+    Rows of the other classes, such as high priority rows, always pass through.
+
+    The rows are sampled on the device, and the sampling rate of each class is set as the `sampling_rates` metadata of
+    the messages so that downstream counts can be re-weighted by the inverse of the rates. Messages without any row left
+    are not emitted.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    priority_column : str
+        Column holding the priority class of each row, either strings or integers.
+    min_rates : dict
+        Minimum sampling rate of each low priority class at full pressure, between 0 and 1.
+    pressure_metric : str
+        Name of the metric read as the pressure.
+    pressure_labels : dict, optional
+        Labels of the series of `pressure_metric`.
+    from_histogram : bool
+        Whether `pressure_metric` is a histogram rather than a gauge.
+    low_watermark : float
+        Value of the metric below which every row is kept.
+    high_watermark : float
+        Value of the metric from which the classes are sampled at their minimum rates.
+    seed : int
+        Seed of the sampling.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 priority_column: str,
+                 min_rates: typing.Dict[typing.Union[str, int], float],
+                 pressure_metric: str,
+                 pressure_labels: typing.Dict[str, str] = None,
+                 from_histogram: bool = False,
+                 low_watermark: float = 0.0,
+                 high_watermark: float = 1.0,
+                 seed: int = 0):
+        super().__init__(c)
+
+        if (len(min_rates) == 0):
+            raise ValueError("At least one low priority class is required to shed load")
+
+        if (any(rate < 0.0 or rate > 1.0 for rate in min_rates.values())):
+            raise ValueError("The minimum sampling rates must be between 0 and 1")
+
+        if (high_watermark <= low_watermark):
+            raise ValueError("high_watermark must be greater than low_watermark")
+
+        self._priority_column = priority_column
+        # Integer classes are matched against integer priority columns by the C++ node
+        self._min_rates = {str(priority): float(rate) for (priority, rate) in min_rates.items()}
+        self._pressure_metric = pressure_metric
+        self._pressure_labels = pressure_labels if pressure_labels is not None else {}
+        self._from_histogram = from_histogram
+        self._low_watermark = low_watermark
+        self._high_watermark = high_watermark
+        self._seed = seed
+
+        self._set_read_column_names([priority_column])
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "load-shedding"
+
+    def accepted_types(self) -> typing.Tuple:
+        """Input types accepted by this stage."""
+        return (ControlMessage, )
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("LoadSheddingStage does not support Python nodes")
+
+        node = _stages.LoadSheddingStage(builder,
+                                         self.unique_name,
+                                         priority_column=self._priority_column,
+                                         min_rates=self._min_rates,
+                                         pressure_metric=self._pressure_metric,
+                                         pressure_labels=self._pressure_labels,
+                                         from_histogram=self._from_histogram,
+                                         low_watermark=self._low_watermark,
+                                         high_watermark=self._high_watermark,
+                                         seed=self._seed)
+        builder.make_edge(input_node, node)
+
+        return node
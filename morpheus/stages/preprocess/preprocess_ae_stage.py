@@ -19,37 +19,75 @@ from functools import partial
 import cupy as cp
 import mrc
 
+import morpheus._lib.stages as _stages
 from morpheus.cli.register_stage import register_stage
+from morpheus.common import DenseModelStore
+from morpheus.common import FeatureScalers
 from morpheus.config import Config
 from morpheus.config import PipelineModes
+from morpheus.messages import ControlMessage
 from morpheus.messages import InferenceMemoryAE
 from morpheus.messages import MultiInferenceMessage
 from morpheus.messages import MultiMessage
 from morpheus.messages.multi_ae_message import MultiAEMessage
+from morpheus.pipeline.stage_schema import StageSchema
 from morpheus.stages.inference.auto_encoder_inference_stage import MultiInferenceAEMessage
 from morpheus.stages.preprocess.preprocess_base_stage import PreprocessBaseStage
 
 logger = logging.getLogger(__name__)
 
 
-@register_stage("preprocess", modes=[PipelineModes.AE])
+@register_stage("preprocess", modes=[PipelineModes.AE], ignore_args=["scalers", "model_store"])
 class PreprocessAEStage(PreprocessBaseStage):
     """
     Prepare Autoencoder input DataFrames for inference.
 
+    By default the features are scaled by the model of each `MultiAEMessage`. When given precomputed `scalers`, the
+    features of `MultiMessage` and `ControlMessage` inputs are instead scaled on the device by a C++ node into an
+    `input` tensor, without any per-user work in Python. The scalers of the user held by the `user_id_key` metadata of a
+    `ControlMessage` are applied, falling back to the global scalers.
+
     Parameters
     ----------
     c : morpheus.config.Config
         Pipeline configuration instance.
+    scalers_file : str, optional
+        Path of the JSON file of precomputed scalers of the features, see `morpheus.common.FeatureScalers`. Requires
+        the C++ node.
+    scalers : `morpheus.common.FeatureScalers`, optional
+        Precomputed scalers of the features, in place of `scalers_file`, such as to share them with other stages.
+    model_store : `morpheus.common.DenseModelStore`, optional
+        Store of the per-user models, adding a `model_index` tensor of the model of the user of each `ControlMessage`
+        as expected by the `GroupedDenseInferenceStage`. Requires `scalers`.
+    user_id_key : str, default = "user_id"
+        Metadata key of the user of a `ControlMessage`.
 
     """
 
-    def __init__(self, c: Config):
+    def __init__(self,
+                 c: Config,
+                 scalers_file: str = None,
+                 scalers: FeatureScalers = None,
+                 model_store: DenseModelStore = None,
+                 user_id_key: str = "user_id"):
         super().__init__(c)
 
         self._fea_length = c.feature_length
         self._feature_columns = c.ae.feature_columns
 
+        if (scalers_file is not None):
+            if (scalers is not None):
+                raise ValueError("PreprocessAEStage accepts either `scalers_file` or `scalers`, not both")
+
+            scalers = FeatureScalers(scalers_file)
+
+        if (model_store is not None and scalers is None):
+            raise ValueError("PreprocessAEStage's `model_store` requires `scalers`")
+
+        self._scalers = scalers
+        self._model_store = model_store
+        self._user_id_key = user_id_key
+
     @property
     def name(self) -> str:
         return "preprocess-ae"
@@ -58,10 +96,20 @@ class PreprocessAEStage(PreprocessBaseStage):
         """
         Returns accepted input types for this stage.
         """
+        if (self._scalers is not None):
+            return (MultiMessage, ControlMessage)
+
         return (MultiAEMessage, )
 
     def supports_cpp_node(self):
-        return False
+        return self._scalers is not None
+
+    def compute_schema(self, schema: StageSchema):
+        super().compute_schema(schema)
+
+        # The C++ node emits plain inference messages, without the model of a `MultiInferenceAEMessage`
+        if (self._scalers is not None and not self._use_control_message):
+            schema.output_schema.set_type(MultiInferenceMessage)
 
     @staticmethod
     def pre_process_batch(x: MultiAEMessage, fea_len: int,
@@ -123,4 +171,20 @@ class PreprocessAEStage(PreprocessBaseStage):
                        feature_columns=self._feature_columns)
 
     def _get_preprocess_node(self, builder: mrc.Builder):
-        raise NotImplementedError("No C++ node for AE")
+        if (self._scalers is None):
+            raise NotImplementedError("No C++ node for AE without scalers")
+
+        if (self._use_control_message):
+            return _stages.PreprocessAEControlMessageStage(builder,
+                                                           self.unique_name,
+                                                           scalers=self._scalers,
+                                                           model_store=self._model_store,
+                                                           user_id_key=self._user_id_key)
+
+        return _stages.PreprocessAEMultiMessageStage(builder, self.unique_name, scalers=self._scalers)
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (self._scalers is not None and not self._build_cpp_node()):
+            raise RuntimeError("PreprocessAEStage's `scalers` are only applied by the C++ node")
+
+        return super()._build_single(builder, input_node)
@@ -55,6 +55,7 @@ class PreprocessFILStage(PreprocessBaseStage):
 
         self._fea_length = c.feature_length
         self.features = c.fil.feature_columns
+        self._set_read_column_names(self.features)
 
         assert self._fea_length == len(self.features), \
             f"Number of features in preprocessing {len(self.features)}, does not match configuration {self._fea_length}"
@@ -24,6 +24,7 @@ import numpy as np
 
 import cudf
 
+import morpheus._lib.common as _common
 import morpheus._lib.messages as _messages
 import morpheus._lib.stages as _stages
 from morpheus.cli.register_stage import register_stage
@@ -75,9 +76,17 @@ def base64_to_cupyarray(base64_str):
 @register_stage(
     "preprocess",
     modes=[PipelineModes.NLP],
-    option_args={"vocab_hash_file": {
-        "type": MorpheusRelativePath(exists=True, dir_okay=False, resolve_path=True)
-    }})
+    option_args={
+        "vocab_hash_file": {
+            "type": MorpheusRelativePath(exists=True, dir_okay=False, resolve_path=True)
+        },
+        "bpe_merges_file": {
+            "type": MorpheusRelativePath(exists=True, dir_okay=False, resolve_path=True)
+        },
+        "bpe_vocab_file": {
+            "type": MorpheusRelativePath(exists=True, dir_okay=False, resolve_path=True)
+        }
+    })
 class PreprocessNLPStage(PreprocessBaseStage):
     """
     Prepare NLP input DataFrames for inference.
@@ -104,6 +113,25 @@ class PreprocessNLPStage(PreprocessBaseStage):
         the second sequence and so on until the entire sentence is encoded.
     column : str
         Name of the column containing the data that needs to be preprocessed.
+    uint32_tokens : bool, default = False, is_flag = True
+        Emit `input_ids` and `input_mask` as the uint32 tensors produced by the tokenizer, adopting its buffers rather
+        than copying them into int32 tensors. Suited to models accepting uint32 inputs, other models have the tensors
+        converted by the inference stage. Only applies to the C++ implementation.
+    sequence_length_buckets : typing.List[int], default = [], show_default="Disabled"
+        Sequence lengths, such as 64, 128 and 256, to trim each message's `input_ids` and `input_mask` to. Each message
+        is trimmed to the smallest length holding its longest sequence, or padded to the full sequence length when none
+        do, and the inference stage only merges messages trimmed to the same length. Requires a model accepting a
+        variable sequence length. Only applies to the C++ implementation.
+    bpe_merges_file : str, default = None
+        Path to the `merges.txt` file of a byte-pair encoding, such as that of a RoBERTa model. When set along with
+        `bpe_vocab_file`, strings are tokenized on the GPU by byte-pair encoding instead of the WordPiece vocabulary of
+        `vocab_hash_file`. Only supported by the C++ implementation.
+    bpe_vocab_file : str, default = None
+        Path to the `vocab.json` file of the byte-pair encoding of `bpe_merges_file`.
+    deduplicate_strings : bool, default = False, is_flag = True
+        Tokenize only the distinct strings of each message, copying their tokens to every duplicate. Speeds up inputs
+        holding many exact duplicate strings, such as repeated log templates. Only supported by the C++
+        implementation.
 
     """
 
@@ -114,10 +142,16 @@ class PreprocessNLPStage(PreprocessBaseStage):
                  do_lower_case: bool = False,
                  add_special_tokens: bool = False,
                  stride: int = -1,
-                 column: str = "data"):
+                 column: str = "data",
+                 uint32_tokens: bool = False,
+                 sequence_length_buckets: typing.List[int] = None,
+                 bpe_merges_file: str = None,
+                 bpe_vocab_file: str = None,
+                 deduplicate_strings: bool = False):
         super().__init__(c)
 
         self._column = column
+        self._set_read_column_names([column])
         self._seq_length = c.feature_length
         self._vocab_hash_file = get_package_relative_file(vocab_hash_file)
 
@@ -132,6 +166,22 @@ class PreprocessNLPStage(PreprocessBaseStage):
         self._truncation = truncation
         self._do_lower_case = do_lower_case
         self._add_special_tokens = add_special_tokens
+        self._uint32_tokens = uint32_tokens
+
+        if (sequence_length_buckets is None):
+            sequence_length_buckets = []
+
+        if (any(bucket <= 0 for bucket in sequence_length_buckets)):
+            raise ValueError(f"Sequence length buckets must be positive, got {sequence_length_buckets}")
+
+        self._sequence_length_buckets = list(sequence_length_buckets)
+
+        if ((bpe_merges_file is None) != (bpe_vocab_file is None)):
+            raise ValueError("Both `bpe_merges_file` and `bpe_vocab_file` are required for byte-pair encoding")
+
+        self._bpe_merges_file = bpe_merges_file
+        self._bpe_vocab_file = bpe_vocab_file
+        self._deduplicate_strings = deduplicate_strings
 
     @property
     def name(self) -> str:
@@ -253,6 +303,12 @@ class PreprocessNLPStage(PreprocessBaseStage):
         self
     ) -> typing.Callable[[typing.Union[MultiMessage, ControlMessage]],
                          typing.Union[MultiInferenceMessage, ControlMessage]]:
+        if (self._bpe_merges_file is not None):
+            raise NotImplementedError("Byte-pair encoding is only supported by the C++ implementation")
+
+        if (self._deduplicate_strings):
+            raise NotImplementedError("Deduplicating strings is only supported by the C++ implementation")
+
         return partial(PreprocessNLPStage.pre_process_batch,
                        vocab_hash_file=self._vocab_hash_file,
                        do_lower_case=self._do_lower_case,
@@ -263,6 +319,16 @@ class PreprocessNLPStage(PreprocessBaseStage):
                        column=self._column)
 
     def _get_preprocess_node(self, builder: mrc.Builder):
+        tokenizer = None
+        if (self._bpe_merges_file is not None):
+            tokenizer = _common.BytePairTokenizer(self._bpe_merges_file, self._bpe_vocab_file)
+
+        if (self._deduplicate_strings):
+            if (tokenizer is None):
+                tokenizer = _common.WordPieceTokenizer(self._vocab_hash_file, self._do_lower_case)
+
+            tokenizer = _common.DeduplicatingTokenizer(tokenizer)
+
         if (self._use_control_message):
             return _stages.PreprocessNLPControlMessageStage(builder,
                                                             self.unique_name,
@@ -272,7 +338,10 @@ class PreprocessNLPStage(PreprocessBaseStage):
                                                             self._do_lower_case,
                                                             self._add_special_tokens,
                                                             self._stride,
-                                                            self._column)
+                                                            self._column,
+                                                            self._uint32_tokens,
+                                                            self._sequence_length_buckets,
+                                                            tokenizer)
 
         return _stages.PreprocessNLPMultiMessageStage(builder,
                                                       self.unique_name,
@@ -282,4 +351,7 @@ class PreprocessNLPStage(PreprocessBaseStage):
                                                       self._do_lower_case,
                                                       self._add_special_tokens,
                                                       self._stride,
-                                                      self._column)
+                                                      self._column,
+                                                      self._uint32_tokens,
+                                                      self._sequence_length_buckets,
+                                                      tokenizer)
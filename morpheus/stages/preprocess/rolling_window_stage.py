@@ -0,0 +1,132 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Groups the rows of each user into a rolling window on the device."""
+
+import typing
+
+import mrc
+import pandas as pd
+
+import morpheus._lib.stages as _stages
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
+from morpheus.pipeline.single_port_stage import SinglePortStage
+
+
+class RollingWindowStage(PassThruTypeMixin, SinglePortStage):
+    """
+    Groups the rows of each user into a rolling window, emitting a window only when the history requirements specified
+    by `min_history` and `min_increment` are met. Unlike the rolling window of the DFP pipelines, the history of each
+    user is held on the device by a C++ node, and a window is emitted without copying whenever it spans a single
+    batch of the history.
+
+    The rows of incoming `ControlMessage`s with a `data_type` metadata of `"streaming"`, the default, are appended to
+    the history of the user named by their `user_id` metadata. Emitted messages hold the window as their payload, with
+    a `data_type` of `"payload"`. Messages with a `data_type` of `"payload"` are passed through. Only batches newer than
+    the history of their user are appended, messages holding batches which overlap the history are dropped.
+
+    Downstream stages may add columns to the windows, but must not modify their existing columns in place as they are
+    shared with the history.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    min_history : int
+        Exclude users with less than `min_history` rows, setting this to `1` effectively disables this feature.
+    min_increment : int
+        Exclude incoming batches for users where less than `min_increment` new rows have been added since the last
+        window, setting this to `0` effectively disables this feature.
+    max_history : int or str
+        When not `None`, include up to `max_history` rows. When `max_history` is an int, then the last `max_history`
+        rows will be included. When `max_history` is a `str` it is assumed to represent a duration parsable by
+        `pandas.Timedelta` and only those rows within the window of [latest timestamp - `max_history`, latest timestamp]
+        will be included. Rows which have not been part of a window yet are always included.
+    timestamp_column_name : str, optional
+        Name of the timestamp column, by default the `timestamp_column_name` of the `ae` config, or "timestamp".
+    max_device_bytes : int, optional
+        Spill the histories of the least recently active users to host memory once the histories hold more than this
+        many bytes on the device, by default 0 disabling spilling.
+    checkpoint_interval_ms : int, optional
+        Minimum duration in milliseconds between two checkpoints of the histories, written to the directory set with
+        `morpheus._lib.common.StateCheckpoint.set_directory` and restored by a restarted pipeline, by default 0
+        disabling checkpoints.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 min_history: int,
+                 min_increment: int,
+                 max_history: typing.Union[int, str, None],
+                 timestamp_column_name: str = None,
+                 max_device_bytes: int = 0,
+                 checkpoint_interval_ms: int = 0):
+        super().__init__(c)
+
+        if (timestamp_column_name is None):
+            timestamp_column_name = c.ae.timestamp_column_name if c.ae is not None else "timestamp"
+
+        self._timestamp_column_name = timestamp_column_name
+        self._min_history = min_history
+        self._min_increment = min_increment
+        self._max_device_bytes = max_device_bytes
+        self._checkpoint_interval_ms = checkpoint_interval_ms
+
+        self._max_history_rows = 0
+        self._max_history_ns = 0
+
+        if (isinstance(max_history, int)):
+            self._max_history_rows = max_history
+        elif (isinstance(max_history, str)):
+            self._max_history_ns = pd.Timedelta(max_history).value
+        elif (max_history is not None):
+            raise ValueError(f"Unsupported max_history: {max_history}")
+
+        if (self._max_history_rows < 0 or self._max_history_ns < 0):
+            raise ValueError("max_history must not be negative")
+
+        if (checkpoint_interval_ms < 0):
+            raise ValueError("checkpoint_interval_ms must not be negative")
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "rolling-window"
+
+    def accepted_types(self) -> typing.Tuple:
+        """Input types accepted by this stage."""
+        return (ControlMessage, )
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("RollingWindowStage does not support Python nodes")
+
+        node = _stages.RollingWindowStage(builder,
+                                          self.unique_name,
+                                          timestamp_column=self._timestamp_column_name,
+                                          min_history=self._min_history,
+                                          min_increment=self._min_increment,
+                                          max_history_rows=self._max_history_rows,
+                                          max_history_ns=self._max_history_ns,
+                                          max_device_bytes=self._max_device_bytes,
+                                          checkpoint_interval_ms=self._checkpoint_interval_ms)
+        builder.make_edge(input_node, node)
+
+        return node
@@ -0,0 +1,105 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Splits the payload of each control message into one message per user on the device."""
+
+import typing
+
+import mrc
+
+import morpheus._lib.stages as _stages
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.pipeline.pass_thru_type_mixin import PassThruTypeMixin
+from morpheus.pipeline.single_port_stage import SinglePortStage
+
+
+class SplitUsersStage(PassThruTypeMixin, SinglePortStage):
+    """
+    Splits the payload of each incoming `ControlMessage` into one message per user, and potentially filters the rows
+    based on the user. Unlike the split users stage of the DFP pipelines, the rows are grouped by user with a single
+    sort on the device by a C++ node, and the payloads of the emitted messages are slices sharing that single grouped
+    table.
+
+    Each emitted message is a copy of the incoming one, holding the rows of a single user as its payload and the user
+    id as its `user_id` metadata, as expected by `RollingWindowStage`. Messages are emitted in ascending order of user
+    id. The index of the rows is not reset per user.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    include_generic : bool
+        Whether to emit a message holding the rows of every user, with a `user_id` of the `fallback_username` of the
+        `ae` config, or "generic_user".
+    include_individual : bool
+        Whether to emit a message per user.
+    skip_users : list of str, optional
+        List of user ids to skip.
+    only_users : list of str, optional
+        List of user ids to include.
+    userid_column_name : str, optional
+        Name of the string column holding the user ids, by default the `userid_column_name` of the `ae` config.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 include_generic: bool,
+                 include_individual: bool,
+                 skip_users: typing.List[str] = None,
+                 only_users: typing.List[str] = None,
+                 userid_column_name: str = None):
+        super().__init__(c)
+
+        if (userid_column_name is None):
+            if (c.ae is None):
+                raise ValueError("userid_column_name is required when the ae config is not set")
+
+            userid_column_name = c.ae.userid_column_name
+
+        self._userid_column_name = userid_column_name
+        self._fallback_username = c.ae.fallback_username if c.ae is not None else "generic_user"
+        self._include_generic = include_generic
+        self._include_individual = include_individual
+        self._skip_users = skip_users if skip_users is not None else []
+        self._only_users = only_users if only_users is not None else []
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "split-users"
+
+    def accepted_types(self) -> typing.Tuple:
+        """Input types accepted by this stage."""
+        return (ControlMessage, )
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("SplitUsersStage does not support Python nodes")
+
+        node = _stages.SplitUsersStage(builder,
+                                       self.unique_name,
+                                       userid_column=self._userid_column_name,
+                                       fallback_username=self._fallback_username,
+                                       include_generic=self._include_generic,
+                                       include_individual=self._include_individual,
+                                       skip_users=self._skip_users,
+                                       only_users=self._only_users)
+        builder.make_edge(input_node, node)
+
+        return node
@@ -0,0 +1,132 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Aggregates the rows of each key over event time windows on the device."""
+
+import typing
+
+import mrc
+import pandas as pd
+
+import morpheus._lib.stages as _stages
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.single_port_stage import SinglePortStage
+from morpheus.pipeline.stage_schema import StageSchema
+
+SUPPORTED_AGGREGATIONS = ("count", "sum", "min", "max", "mean")
+
+
+class WindowAggregateStage(SinglePortStage):
+    """
+    Aggregates the rows of the payload of each incoming `ControlMessage` per key over event time windows, such as the
+    failed logins of each user per minute or the bytes sent by each host over 5 minutes, replacing a pandas groupby
+    per batch with state kept in Python.
+
+    Windows last `window` and start every `slide`, tumbling windows by default. The partial aggregates of every open
+    (key, window) pair are held in a device table, updated by a `cudf` groupby per batch. Windows close once the
+    watermark, the newest timestamp seen less `allowed_lateness`, passes their end, their aggregates then being emitted
+    as a `MessageMeta` ordered by window and key. Rows which only belong to closed windows are late, and dropped. Every
+    window still open is emitted once the input completes.
+
+    Emitted tables hold the key columns, `window_start`, `window_end`, the number of rows of the window as `count`,
+    then a `<column>_<aggregation>` column for each aggregation.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    key_columns : list of str
+        Columns identifying the keys, rows with a null key are ignored.
+    aggregations : dict of str to list of str
+        Aggregations of each column, among "count", "sum", "min", "max" and "mean", such as `{"bytes": ["sum", "max"]}`.
+    window : str
+        Duration of the windows, parsable by `pandas.Timedelta`.
+    slide : str, optional
+        Duration between the starts of two windows, which must divide `window`, by default `window`.
+    allowed_lateness : str, optional
+        Duration the watermark trails the newest timestamp seen, by default 0.
+    timestamp_column_name : str, optional
+        Name of the timestamp column, by default the `timestamp_column_name` of the `ae` config, or "timestamp".
+    """
+
+    def __init__(self,
+                 c: Config,
+                 key_columns: typing.List[str],
+                 aggregations: typing.Dict[str, typing.List[str]],
+                 window: str,
+                 slide: str = None,
+                 allowed_lateness: str = "0s",
+                 timestamp_column_name: str = None):
+        super().__init__(c)
+
+        if (timestamp_column_name is None):
+            timestamp_column_name = c.ae.timestamp_column_name if c.ae is not None else "timestamp"
+
+        if (len(key_columns) == 0):
+            raise ValueError("At least one key column is required to aggregate windows")
+
+        for (column, names) in aggregations.items():
+            for name in names:
+                if (name not in SUPPORTED_AGGREGATIONS):
+                    raise ValueError(f"Unsupported aggregation '{name}' of the column '{column}'")
+
+        self._key_columns = list(key_columns)
+        self._aggregations = {column: list(names) for (column, names) in aggregations.items()}
+        self._timestamp_column_name = timestamp_column_name
+
+        self._window_ns = pd.Timedelta(window).value
+        self._slide_ns = pd.Timedelta(slide).value if slide is not None else self._window_ns
+        self._allowed_lateness_ns = pd.Timedelta(allowed_lateness).value
+
+        if (self._window_ns <= 0 or self._slide_ns <= 0 or self._window_ns % self._slide_ns != 0):
+            raise ValueError("window and slide must be positive, and slide must divide window")
+
+        if (self._allowed_lateness_ns < 0):
+            raise ValueError("allowed_lateness must not be negative")
+
+        self._set_read_column_names([*self._key_columns, *self._aggregations.keys(), self._timestamp_column_name])
+
+    @property
+    def name(self) -> str:
+        """Stage name."""
+        return "window-aggregate"
+
+    def accepted_types(self) -> typing.Tuple:
+        """Input types accepted by this stage."""
+        return (ControlMessage, )
+
+    def supports_cpp_node(self) -> bool:
+        """Whether this stage supports a C++ node."""
+        return True
+
+    def compute_schema(self, schema: StageSchema):
+        schema.output_schema.set_type(MessageMeta)
+
+    def _build_single(self, builder: mrc.Builder, input_node: mrc.SegmentObject) -> mrc.SegmentObject:
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("WindowAggregateStage does not support Python nodes")
+
+        node = _stages.WindowAggregateStage(builder,
+                                            self.unique_name,
+                                            key_columns=self._key_columns,
+                                            timestamp_column=self._timestamp_column_name,
+                                            aggregations=self._aggregations,
+                                            window_ns=self._window_ns,
+                                            slide_ns=self._slide_ns,
+                                            allowed_lateness_ns=self._allowed_lateness_ns)
+        builder.make_edge(input_node, node)
+
+        return node
@@ -26,5 +26,6 @@ TO_CONTROL_MESSAGE = "ToControlMessage"
 WRITE_TO_FILE = "WriteToFile"
 FILTER_CM_FAILED = "FilterCmFailed"
 PAYLOAD_BATCHER = "PayloadBatcher"
+NATIVE_PAYLOAD_BATCHER = "NativePayloadBatcher"
 WRITE_TO_ELASTICSEARCH = "WriteToElasticsearch"
 WRITE_TO_VECTOR_DB = "WriteToVectorDB"
@@ -0,0 +1,154 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Decodes the files written by `morpheus.common.TraceBuffer.dump`, either from python or from the command line:
+
+    python -m morpheus.utils.trace_decoder trace.bin [--format text|json|chrome]
+"""
+
+import argparse
+import dataclasses
+import json
+import struct
+import sys
+import typing
+
+MAGIC = b"MTRACE01"
+
+_U32 = struct.Struct("<I")
+_U64 = struct.Struct("<Q")
+_RECORD = struct.Struct("<QII4q")
+
+
+@dataclasses.dataclass
+class TraceRecord:
+    """
+    A single event recorded by a thread.
+    """
+    timestamp_ns: int
+    event: str
+    thread: int
+    args: tuple[int, int, int, int]
+
+
+def _read(data: memoryview, offset: int, fmt: struct.Struct) -> tuple[tuple, int]:
+    if (offset + fmt.size > len(data)):
+        raise ValueError("Truncated trace file")
+
+    return fmt.unpack_from(data, offset), offset + fmt.size
+
+
+def decode_bytes(data: bytes) -> list[TraceRecord]:
+    """
+    Decodes the contents of a trace file, returning the records ordered by timestamp.
+
+    Parameters
+    ----------
+    data : bytes
+        The contents of the file.
+
+    Returns
+    -------
+    list[TraceRecord]
+        The decoded records.
+    """
+    view = memoryview(data)
+
+    if (bytes(view[:len(MAGIC)]) != MAGIC):
+        raise ValueError("Not a Morpheus trace file")
+
+    offset = len(MAGIC)
+
+    (num_events, ), offset = _read(view, offset, _U32)
+    names: list[str] = []
+    for _ in range(num_events):
+        (name_len, ), offset = _read(view, offset, _U32)
+        if (offset + name_len > len(view)):
+            raise ValueError("Truncated trace file")
+
+        names.append(bytes(view[offset:offset + name_len]).decode("utf-8"))
+        offset += name_len
+
+    (num_records, ), offset = _read(view, offset, _U64)
+    records: list[TraceRecord] = []
+    for _ in range(num_records):
+        (timestamp_ns, event, thread, *args), offset = _read(view, offset, _RECORD)
+        name = names[event] if event < len(names) else f"<unknown {event}>"
+        records.append(TraceRecord(timestamp_ns=timestamp_ns, event=name, thread=thread, args=tuple(args)))
+
+    return records
+
+
+def decode(path: str) -> list[TraceRecord]:
+    """
+    Decodes the trace file at `path`, returning the records ordered by timestamp.
+
+    Parameters
+    ----------
+    path : str
+        Path of the file written by `TraceBuffer.dump`.
+
+    Returns
+    -------
+    list[TraceRecord]
+        The decoded records.
+    """
+    with open(path, "rb") as f:
+        return decode_bytes(f.read())
+
+
+def to_chrome_trace(records: list[TraceRecord]) -> dict[str, typing.Any]:
+    """
+    Converts the records to instant events of the Chrome trace event format, viewable in Perfetto or chrome://tracing.
+    """
+    events = [{
+        "name": record.event,
+        "ph": "i",
+        "s": "t",
+        "ts": record.timestamp_ns / 1000.0,
+        "pid": 0,
+        "tid": record.thread,
+        "args": {
+            f"arg{i}": value
+            for (i, value) in enumerate(record.args)
+        }
+    } for record in records]
+
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main(argv: list[str] | None = None):
+    parser = argparse.ArgumentParser(description="Decodes a Morpheus trace buffer dump.")
+    parser.add_argument("path", help="Path of the file written by TraceBuffer.dump")
+    parser.add_argument("--format", choices=["text", "json", "chrome"], default="text", help="Output format")
+    args = parser.parse_args(argv)
+
+    records = decode(args.path)
+
+    if (args.format == "chrome"):
+        json.dump(to_chrome_trace(records), sys.stdout)
+    elif (args.format == "json"):
+        json.dump([dataclasses.asdict(record) for record in records], sys.stdout)
+    else:
+        start_ns = records[0].timestamp_ns if records else 0
+        for record in records:
+            args_str = " ".join(str(arg) for arg in record.args)
+            print(f"{(record.timestamp_ns - start_ns) / 1000.0:>14.3f}us  thread {record.thread:<4} "
+                  f"{record.event:<32} {args_str}")
+
+
+if __name__ == "__main__":
+    main()
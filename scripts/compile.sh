@@ -32,6 +32,7 @@ cmake -S . -B ${BUILD_DIR} -GNinja \
    -DMORPHEUS_USE_CCACHE=ON \
    -DMORPHEUS_USE_CONDA=${MORPHEUS_USE_CONDA:-ON} \
    -DMORPHEUS_SUPPORT_DOCA=${MORPHEUS_SUPPORT_DOCA:-OFF} \
+   -DMORPHEUS_SUPPORT_TENSORRT=${MORPHEUS_SUPPORT_TENSORRT:-OFF} \
    ${INSTALL_PREFIX:+-DCMAKE_INSTALL_PREFIX=${INSTALL_PREFIX}} \
    ${CMAKE_ARGS:+${CMAKE_ARGS}} \
    ${CMAKE_CONFIGURE_EXTRA_ARGS:+${CMAKE_CONFIGURE_EXTRA_ARGS}}
@@ -13,6 +13,8 @@
 # limitations under the License.
 
 import queue
+import threading
+import time
 
 import pytest
 
@@ -36,9 +38,10 @@ def test_constructor_type_error(invalid_max_size: int):
         FiberQueue(invalid_max_size)
 
 
+@pytest.mark.parametrize("lock_free", [False, True])
 @pytest.mark.parametrize("max_size", [2, 4, 8, 16])
-def test_put_get(max_size: int):
-    with FiberQueue(max_size) as data_queue:
+def test_put_get(max_size: int, lock_free: bool):
+    with FiberQueue(max_size, lock_free=lock_free) as data_queue:
         for i in range(max_size - 1):
             data_queue.put(item=i, block=False)
 
@@ -56,16 +59,59 @@ def test_put_full_error(max_size: int):
             data_queue.put(item=42, block=False)
 
 
+@pytest.mark.parametrize("max_size", [2, 4, 8, 16])
+def test_lock_free_put_full_error(max_size: int):
+    # Unlike the fiber channel, the ring buffer holds `max_size` items
+    with FiberQueue(max_size, lock_free=True) as data_queue:
+        for i in range(max_size):
+            data_queue.put(item=i, block=False)
+
+        with pytest.raises(queue.Full):
+            data_queue.put(item=42, block=False)
+
+
+@pytest.mark.parametrize("lock_free", [False, True])
 @pytest.mark.parametrize("block", [True, False])
-def test_get_empty_error(block: bool):
-    data_queue = FiberQueue(8)
+def test_get_empty_error(block: bool, lock_free: bool):
+    data_queue = FiberQueue(8, lock_free=lock_free)
 
     with pytest.raises(queue.Empty):
         data_queue.get(block=block, timeout=0.1)
 
 
-def test_closed_error():
-    data_queue = FiberQueue(8)
+@pytest.mark.parametrize("lock_free", [False, True])
+def test_sub_second_timeout(lock_free: bool):
+    data_queue = FiberQueue(8, lock_free=lock_free)
+
+    start = time.monotonic()
+    with pytest.raises(queue.Empty):
+        data_queue.get(block=True, timeout=0.25)
+
+    elapsed = time.monotonic() - start
+    assert 0.2 <= elapsed < 1.0
+
+
+@pytest.mark.parametrize("lock_free", [False, True])
+def test_threaded_put_get(lock_free: bool):
+    num_items = 10000
+    data_queue = FiberQueue(16, lock_free=lock_free)
+
+    def produce():
+        for i in range(num_items):
+            data_queue.put(item=i)
+
+    producer = threading.Thread(target=produce)
+    producer.start()
+
+    received = [data_queue.get(block=True, timeout=5.0) for _ in range(num_items)]
+    producer.join()
+
+    assert received == list(range(num_items))
+
+
+@pytest.mark.parametrize("lock_free", [False, True])
+def test_closed_error(lock_free: bool):
+    data_queue = FiberQueue(8, lock_free=lock_free)
     assert not data_queue.is_closed()
 
     data_queue.close()
@@ -89,3 +135,52 @@ def test_ctx_closed_error():
 
     with pytest.raises(Closed):
         data_queue.put(item=5, block=False)
+
+
+@pytest.mark.parametrize("max_size", [2, 4, 8, 16])
+def test_put_get_many(max_size: int):
+    with FiberQueue(max_size) as data_queue:
+        data_queue.put_many(items=list(range(max_size - 1)), block=False)
+
+        assert data_queue.get_many(max_items=1, block=False) == [0]
+        assert data_queue.get_many(max_items=max_size, block=False) == list(range(1, max_size - 1))
+
+
+def test_put_many_full_error():
+    with FiberQueue(4) as data_queue:
+        with pytest.raises(queue.Full):
+            data_queue.put_many(items=list(range(5)), block=False)
+
+        # The items preceding the first one which could not be added remain queued
+        assert data_queue.get_many(max_items=8, block=False) == [0, 1, 2]
+
+
+@pytest.mark.parametrize("block", [True, False])
+def test_get_many_empty_error(block: bool):
+    data_queue = FiberQueue(8)
+
+    with pytest.raises(queue.Empty):
+        data_queue.get_many(max_items=4, block=block, timeout=0.1)
+
+
+def test_get_many_timeout():
+    with FiberQueue(8) as data_queue:
+        data_queue.put(item=1)
+
+        # Waits for further items until the timeout has elapsed, returning the items retrieved so far
+        assert data_queue.get_many(max_items=4, block=True, timeout=0.1) == [1]
+
+
+def test_many_closed_error():
+    data_queue = FiberQueue(8)
+    data_queue.put_many(items=[1, 2])
+    data_queue.close()
+
+    # Items queued before the queue was closed can still be retrieved
+    assert data_queue.get_many(max_items=4, block=False) == [1, 2]
+
+    with pytest.raises(Closed):
+        data_queue.get_many(max_items=4, block=False)
+
+    with pytest.raises(Closed):
+        data_queue.put_many(items=[5], block=False)
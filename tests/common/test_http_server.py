@@ -12,9 +12,11 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import gzip
 import os
 import time
 import typing
+import zlib
 from http import HTTPStatus
 from unittest import mock
 
@@ -22,7 +24,9 @@ import pytest
 import requests
 
 from _utils import make_url
+from morpheus._lib import common as _common
 from morpheus.common import HttpServer
+from morpheus.common import MetricsServer
 from morpheus.utils.http_utils import MimeTypes
 
 
@@ -115,9 +119,95 @@ def test_simple_request(port: int,
     assert not server.is_running()
 
 
+def test_metrics_server():
+    url = make_url(9464, "/metrics")
+
+    with MetricsServer() as server:
+        assert server.is_running()
+
+        response = requests.get(url, timeout=5.0)
+
+        assert response.status_code == HTTPStatus.OK.value
+        assert response.headers["Content-Type"].startswith("text/plain; version=0.0.4")
+        assert response.text == _common.serialize_metrics()
+
+        # Only GET requests are answered
+        assert requests.post(url, data="test", timeout=5.0).status_code == HTTPStatus.NOT_FOUND.value
+
+    assert not server.is_running()
+
+
 def test_constructor_errors():
     with pytest.raises(RuntimeError):
         HttpServer(parse_fn=make_parse_fn(), method="UNSUPPORTED")
 
     with pytest.raises(RuntimeError):
         HttpServer(parse_fn=make_parse_fn(), num_threads=0)
+
+
+@pytest.mark.parametrize("content_encoding", ["gzip", "deflate"])
+def test_compressed_request(content_encoding: str):
+    payload = '{"test": "this"}\n' * 100
+    if content_encoding == "gzip":
+        data = gzip.compress(payload.encode())
+    else:
+        data = zlib.compress(payload.encode())
+
+    parse_fn = make_parse_fn()
+    url = make_url(8088, "/test")
+
+    with HttpServer(parse_fn=parse_fn, port=8088, endpoint="/test", method="POST") as server:
+        assert server.is_running()
+
+        # Re-use the connection to ensure keep-alive requests are handled
+        with requests.Session() as session:
+            for _ in range(2):
+                response = session.post(url, data=data, headers={"Content-Encoding": content_encoding}, timeout=5.0)
+                assert response.status_code == HTTPStatus.OK.value
+                assert response.text == "TEST OK"
+
+        assert parse_fn.mock_calls == [mock.call(payload), mock.call(payload)]
+
+
+def test_invalid_content_encoding():
+    parse_fn = make_parse_fn()
+    url = make_url(8088, "/test")
+
+    with HttpServer(parse_fn=parse_fn, port=8088, endpoint="/test", method="POST") as server:
+        assert server.is_running()
+
+        response = requests.post(url, data="test", headers={"Content-Encoding": "br"}, timeout=5.0)
+        assert response.status_code == HTTPStatus.UNSUPPORTED_MEDIA_TYPE.value
+
+        response = requests.post(url, data="not gzip", headers={"Content-Encoding": "gzip"}, timeout=5.0)
+        assert response.status_code == HTTPStatus.BAD_REQUEST.value
+
+        parse_fn.assert_not_called()
+
+
+def test_streaming_request():
+    lines = [f'{{"row": {i}}}\n' for i in range(1000)]
+    stream_chunk_size = 1024
+
+    parse_fn = make_parse_fn()
+    url = make_url(8088, "/test")
+
+    with HttpServer(parse_fn=parse_fn,
+                    port=8088,
+                    endpoint="/test",
+                    method="POST",
+                    max_payload_size=4096,
+                    stream_chunk_size=stream_chunk_size) as server:
+        assert server.is_running()
+
+        # Passing a generator causes requests to send the body with `Transfer-Encoding: chunked`
+        response = requests.post(url, data=(line.encode() for line in lines), timeout=5.0)
+        assert response.status_code == HTTPStatus.OK.value
+
+    chunks = [call.args[0] for call in parse_fn.call_args_list]
+    assert len(chunks) > 1
+    assert "".join(chunks) == "".join(lines)
+
+    for chunk in chunks:
+        assert len(chunk) <= stream_chunk_size
+        assert chunk.endswith("\n")
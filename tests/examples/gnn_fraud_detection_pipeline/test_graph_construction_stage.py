@@ -77,3 +77,24 @@ class TestGraphConstructionStage:
         # Compare nodes.
         for node in ['client', 'merchant']:
             assert fgmm.graph.nodes(node).tolist() == list(expected_nodes[node + "_node"])
+
+    def test_graph_builder_matches_prepare_data(self, training_file: str):
+        from stages.model import FsiGraphBuilder
+        from stages.model import build_fsi_graph
+        from stages.model import prepare_data
+
+        df = cudf.read_csv(training_file, nrows=200)
+        training_data = df.head(150)
+        test_data = df.tail(50)
+
+        _, _, _, expected_test_index, _, graph_data = prepare_data(training_data, test_data)
+        expected_graph, expected_features = build_fsi_graph(graph_data, ['client_node', 'merchant_node', 'index'])
+
+        graph, features, test_index = FsiGraphBuilder(training_data).build(test_data)
+
+        assert torch.equal(test_index, torch.from_dlpack(expected_test_index.values.toDlpack()).long())
+        assert torch.allclose(features, expected_features.double())
+
+        for etype in ['buy', 'bought', 'issued', 'sell']:
+            for (edges, expected_edges) in zip(graph.edges(etype=etype), expected_graph.edges(etype=etype)):
+                assert torch.equal(edges, expected_edges)
@@ -23,10 +23,13 @@ import pytest
 
 from _utils import TEST_DIRS
 from _utils.dataset_manager import DatasetManager
+from _utils.stages.in_memory_source_x_stage import InMemSourceXStage
 from morpheus.config import Config
 from morpheus.messages import MessageMeta
 from morpheus.messages import MultiResponseMessage
 from morpheus.messages import TensorMemory
+from morpheus.pipeline import LinearPipeline
+from morpheus.stages.output.in_memory_sink_stage import InMemorySinkStage
 
 
 def build_post_proc_message(dataset_cudf: DatasetManager, log_test_data_dir: str):
@@ -73,3 +76,38 @@ def test_log_parsing_post_processing_stage(config: Config,
 
     assert isinstance(out_meta, MessageMeta)
     DatasetManager.assert_compare_df(out_meta.df, expected_df)
+
+
+@pytest.mark.use_cpp
+@pytest.mark.import_mod(os.path.join(TEST_DIRS.examples_dir, 'log_parsing', 'postprocessing.py'))
+def test_log_parsing_post_processing_cpp(config: Config,
+                                         dataset_cudf: DatasetManager,
+                                         import_mod: typing.List[types.ModuleType]):
+    postprocessing_mod = import_mod
+
+    model_vocab_file = os.path.join(TEST_DIRS.data_dir, 'bert-base-cased-vocab.txt')
+    log_test_data_dir = os.path.join(TEST_DIRS.tests_data_dir, 'examples/log_parsing')
+    model_config_file = os.path.join(log_test_data_dir, 'log-parsing-config.json')
+
+    stage = postprocessing_mod.LogParsingPostProcessingStage(config,
+                                                             vocab_path=model_vocab_file,
+                                                             model_config_path=model_config_file)
+
+    post_proc_message = build_post_proc_message(dataset_cudf, log_test_data_dir)
+
+    # The entities decoded by the python postprocessing of the same message
+    python_df = stage._postprocess(post_proc_message).copy_dataframe()
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(InMemSourceXStage(config, [post_proc_message]))
+    pipe.add_stage(stage)
+    sink = pipe.add_stage(InMemorySinkStage(config))
+    pipe.run()
+
+    messages = sink.get_messages()
+    assert len(messages) == 1
+    assert isinstance(messages[0], MessageMeta)
+
+    cpp_df = messages[0].copy_dataframe()
+    assert sorted(cpp_df.columns) == sorted(python_df.columns)
+    DatasetManager.assert_compare_df(cpp_df, python_df)
@@ -23,11 +23,14 @@ import pytest
 
 from _utils import TEST_DIRS
 from _utils.dataset_manager import DatasetManager
+from _utils.stages.in_memory_source_x_stage import InMemSourceXStage
 from morpheus.config import Config
 from morpheus.messages import MultiMessage
 from morpheus.messages.message_meta import AppShieldMessageMeta
+from morpheus.pipeline import LinearPipeline
 from morpheus.pipeline.multi_message_stage import MultiMessageStage
 from morpheus.stages.input.appshield_source_stage import AppShieldSourceStage
+from morpheus.stages.output.in_memory_sink_stage import InMemorySinkStage
 
 
 @pytest.mark.use_python
@@ -200,3 +203,46 @@ class TestCreateFeaturesRWStage:
         stage.on_completed()
 
         mock_dask_client.close.assert_called_once()
+
+
+@pytest.mark.use_cpp
+@mock.patch('stages.create_features.Client')
+def test_cpp_features(mock_dask_client,
+                      config: Config,
+                      rwd_conf: dict,
+                      interested_plugins: typing.List[str],
+                      dataset_pandas: DatasetManager):
+    from stages.create_features import CreateFeaturesRWStage
+    mock_dask_client.return_value = mock_dask_client
+
+    test_data_dir = os.path.join(TEST_DIRS.tests_data_dir, 'examples/ransomware_detection')
+    input_glob = os.path.join(TEST_DIRS.tests_data_dir, 'appshield', 'snapshot-1', '*.json')
+    input_data = AppShieldSourceStage.files_to_dfs(glob.glob(input_glob),
+                                                   cols_include=rwd_conf['raw_columns'],
+                                                   cols_exclude=["SHA256"],
+                                                   plugins_include=interested_plugins,
+                                                   encoding='latin1')
+
+    # The features are computed by the C++ AppShieldFeaturesStage rather than by dask
+    pipe = LinearPipeline(config)
+    pipe.set_source(InMemSourceXStage(config, AppShieldSourceStage._build_metadata(input_data)))
+    pipe.add_stage(
+        CreateFeaturesRWStage(config,
+                              interested_plugins=interested_plugins,
+                              feature_columns=rwd_conf['model_features'],
+                              file_extns=rwd_conf['file_extensions'],
+                              n_workers=5,
+                              threads_per_worker=6))
+    sink = pipe.add_stage(InMemorySinkStage(config))
+    pipe.run()
+
+    messages = sink.get_messages()
+    assert len(messages) > 0
+    assert all(isinstance(message, MultiMessage) and message.meta is messages[0].meta for message in messages)
+    assert sum(message.mess_count for message in messages) == messages[0].meta.count
+
+    expected_df = dataset_pandas[os.path.join(test_data_dir, 'dask_results.csv')]
+    expected_df['source_pid_process'] = 'appshield_' + expected_df.pid_process
+    expected_df.sort_values(by=["pid_process", "snapshot_id"], inplace=True)
+    expected_df.reset_index(drop=True, inplace=True)
+    dataset_pandas.assert_compare_df(messages[0].meta.copy_dataframe(), expected_df)
@@ -14,7 +14,7 @@
 # limitations under the License.
 
 import cupy as cp
-import pandas as pd
+import numpy as np
 import pytest
 
 from _utils.dataset_manager import DatasetManager
@@ -82,25 +82,19 @@ class TestPreprocessingRWStage:
         df = dataset_pandas['examples/ransomware_detection/dask_results.csv']
         assert len(df) == len(snapshot_ids)
 
-        # The snapshot_id's in the test data set are all '1', set them to different values
-        df['snapshot_id'] = snapshot_ids
-        df.index = df.snapshot_id
+        data = cp.asarray(df[rwd_conf['model_features']].fillna(0).values, dtype=cp.float64)
 
         stage = PreprocessingRWStage(config, feature_columns=rwd_conf['model_features'], sliding_window=4)
-        stage._rollover_pending_snapshots(snapshot_ids, source_pid_process, df)
+        stage._rollover_pending_snapshots(snapshot_ids, source_pid_process, data)
 
         assert list(stage._snapshot_dict.keys()) == [source_pid_process]
 
         # Due to the sliding window we should have all but the first snapshot_id in the results
-        expected_snapshot_ids = snapshot_ids[1:]
         snapshots = stage._snapshot_dict[source_pid_process]
 
-        assert len(snapshots) == len(expected_snapshot_ids)
-        for (i, snapshot) in enumerate(snapshots):
-            expected_snapshot_id = expected_snapshot_ids[i]
-            assert snapshot.snapshot_id == expected_snapshot_id
-            expected_data = df.loc[expected_snapshot_id].fillna('').values
-            assert (pd.Series(snapshot.data).fillna('').values == expected_data).all()
+        assert snapshots.snapshot_ids == snapshot_ids[1:]
+        assert isinstance(snapshots.data, cp.ndarray)
+        assert (snapshots.data == data[1:]).all()
 
     def test_rollover_pending_snapshots_empty_results(self,
                                                       config: Config,
@@ -112,41 +106,34 @@ class TestPreprocessingRWStage:
         source_pid_process = "123_test.exe"
         df = dataset_pandas['examples/ransomware_detection/dask_results.csv']
 
+        data = cp.asarray(df[rwd_conf['model_features']].fillna(0).values, dtype=cp.float64)
+
         stage = PreprocessingRWStage(config, feature_columns=rwd_conf['model_features'], sliding_window=4)
-        stage._rollover_pending_snapshots(snapshot_ids, source_pid_process, df)
+        stage._rollover_pending_snapshots(snapshot_ids, source_pid_process, data[:0])
         assert len(stage._snapshot_dict) == 0
 
     def test_merge_curr_and_prev_snapshots(self, config: Config, rwd_conf: dict, dataset_pandas: DatasetManager):
         from common.data_models import SnapshotData
         from stages.preprocessing import PreprocessingRWStage
 
-        snapshot_ids = [5, 8, 10, 13]
         source_pid_process = "123_test.exe"
         df = dataset_pandas['examples/ransomware_detection/dask_results.csv']
-        assert len(df) == len(snapshot_ids)
-        df['snapshot_id'] = snapshot_ids
-        df.index = df.snapshot_id
+        assert len(df) == 4
+        data = cp.asarray(df[rwd_conf['model_features']].fillna(0).values, dtype=cp.float64)
 
         stage = PreprocessingRWStage(config, feature_columns=rwd_conf['model_features'], sliding_window=4)
-        test_row_8 = df.loc[8].copy(deep=True)
-        test_row_8.pid_process = 'test_val1'
-
-        test_row_13 = df.loc[13].copy(deep=True)
-        test_row_13.pid_process = 'test_val2'
-
-        stage._snapshot_dict = {
-            source_pid_process: [SnapshotData(8, test_row_8.values), SnapshotData(13, test_row_13.values)]
-        }
 
-        expected_df = dataset_pandas['examples/ransomware_detection/dask_results.csv'].fillna('')
-        expected_df.loc[1, 'pid_process'] = 'test_val1'
-        expected_df.loc[3, 'pid_process'] = 'test_val2'
+        # Snapshot 8 is pending as well as part of the current run, the pending one is kept
+        pending_data = cp.full((2, data.shape[1]), -1.0)
+        stage._snapshot_dict = {source_pid_process: SnapshotData([3, 8], pending_data)}
 
-        expected_df.loc[:, 'snapshot_id'] = snapshot_ids
-        expected_df.index = expected_df.snapshot_id
+        (ids, merged_data) = stage._merge_curr_and_prev_snapshots(np.array([5, 8, 10, 13]), data, source_pid_process)
 
-        stage._merge_curr_and_prev_snapshots(df, source_pid_process)
-        dataset_pandas.assert_compare_df(df.fillna(''), expected_df)
+        assert list(ids) == [3, 5, 8, 10, 13]
+        assert (merged_data[0] == -1).all()
+        assert (merged_data[1] == data[0]).all()
+        assert (merged_data[2] == -1).all()
+        assert (merged_data[3:] == data[2:]).all()
 
     def test_pre_process_batch(self, config: Config, rwd_conf: dict, dataset_pandas: DatasetManager):
 
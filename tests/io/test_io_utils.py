@@ -0,0 +1,52 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pandas as pd
+import pyarrow as pa
+import pytest
+
+from _utils.dataset_manager import DatasetManager
+from morpheus.io.utils import decode_payloads
+
+
+def _to_arrow_stream(df: pd.DataFrame) -> bytes:
+    table = pa.Table.from_pandas(df, preserve_index=False)
+    sink = pa.BufferOutputStream()
+    with pa.ipc.new_stream(sink, table.schema) as writer:
+        writer.write_table(table)
+
+    return sink.getvalue().to_pybytes()
+
+
+def test_decode_json_payloads(dataset_cudf: DatasetManager):
+    # Payloads sent as C-strings include their terminator
+    payloads = [b'{"v": 1}\n{"v": 2}', b'{"v": 3}\0']
+
+    df = decode_payloads(payloads, "json")
+    dataset_cudf.assert_compare_df(df, pd.DataFrame({"v": [1, 2, 3]}))
+
+
+def test_decode_arrow_payloads(dataset_cudf: DatasetManager):
+    expected = dataset_cudf.pandas["filter_probs.csv"]
+    payloads = [_to_arrow_stream(expected.iloc[:10]), _to_arrow_stream(expected.iloc[10:])]
+
+    df = decode_payloads(payloads, "arrow")
+    dataset_cudf.assert_compare_df(df, expected)
+
+
+def test_decode_unknown_format():
+    with pytest.raises(ValueError):
+        decode_payloads([b""], "xml")
@@ -0,0 +1,64 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import json
+import os
+
+import pandas as pd
+
+from _utils.dataset_manager import DatasetManager
+from morpheus.config import Config
+from morpheus.io.deserializers import read_json_records
+
+RECORDS = [{
+    "eventName": "a", "userIdentity": {
+        "type": "x", "session": {
+            "mfa": True
+        }
+    }
+}, {
+    "eventName": "b", "userIdentity": {
+        "type": "y", "session": {
+            "mfa": False
+        }
+    }
+}]
+
+
+def _expected_df() -> pd.DataFrame:
+    return pd.DataFrame({
+        "eventName": ["a", "b"],
+        "userIdentity.type": ["x", "y"],
+        "userIdentity.session.mfa": [True, False],
+    })
+
+
+def test_read_json_records(config: Config, tmp_path: str):
+    input_file = os.path.join(tmp_path, "records.json")
+    with open(input_file, "w", encoding="UTF-8") as fh:
+        json.dump(RECORDS, fh)
+
+    df = read_json_records(input_file, lines=False)
+    DatasetManager.assert_compare_df(df, _expected_df())
+
+
+def test_read_json_records_record_path(config: Config, tmp_path: str):
+    input_file = os.path.join(tmp_path, "cloudtrail.json")
+    with open(input_file, "w", encoding="UTF-8") as fh:
+        json.dump({"Records": RECORDS}, fh)
+
+    df = read_json_records(input_file, lines=False, record_path="Records")
+    DatasetManager.assert_compare_df(df, _expected_df())
@@ -0,0 +1,157 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import asyncio
+from unittest import mock
+
+import numpy as np
+import pytest
+
+import cudf
+
+from _utils.llm import _mk_context
+from _utils.llm import execute_node
+from morpheus.llm import LLMContext
+from morpheus.llm import LLMNodeBase
+from morpheus.llm import LLMTask
+from morpheus.llm.nodes import gpu_retriever_node
+from morpheus.llm.nodes.gpu_retriever_node import GPURetrieverNode
+from morpheus.llm.nodes.gpu_retriever_node import GPUVectorIndex
+from morpheus.messages import ControlMessage
+
+
+def _corpus(num_vectors: int = 100, dim: int = 8) -> np.ndarray:
+    return np.random.default_rng(42).standard_normal((num_vectors, dim), dtype=np.float32)
+
+
+@pytest.mark.parametrize("metric", ["l2", "inner_product", "cosine"])
+def test_brute_force_search(metric: str):
+    corpus = _corpus()
+    queries = corpus[:5] + 0.01
+
+    if (metric == "l2"):
+        expected = ((queries[:, None, :] - corpus[None, :, :])**2).sum(axis=2)
+    elif (metric == "inner_product"):
+        expected = -(queries @ corpus.T)
+    else:
+        normalized = corpus / np.linalg.norm(corpus, axis=1, keepdims=True)
+        expected = -((queries / np.linalg.norm(queries, axis=1, keepdims=True)) @ normalized.T)
+
+    index = GPUVectorIndex(corpus, metric=metric)
+    distances, indices = index.search(queries, 3)
+
+    np.testing.assert_array_equal(indices.get(), np.argsort(expected, axis=1)[:, :3])
+
+    expected_distances = np.sort(expected, axis=1)[:, :3]
+    if (metric != "l2"):
+        expected_distances = -expected_distances
+    np.testing.assert_allclose(distances.get(), expected_distances, rtol=1e-4, atol=1e-4)
+
+
+def test_brute_force_search_chunks():
+    corpus = _corpus(num_vectors=1000)
+
+    with mock.patch.object(gpu_retriever_node, "_MAX_SCORES", 64):
+        distances, indices = GPUVectorIndex(corpus).search(corpus[:4], 2)
+
+    assert indices[:, 0].get().tolist() == [0, 1, 2, 3]
+    np.testing.assert_allclose(distances[:, 0].get(), 0, atol=1e-3)
+
+
+def test_index_validation():
+    with pytest.raises(ValueError):
+        GPUVectorIndex(_corpus(), metric="hamming")
+
+    with pytest.raises(ValueError):
+        GPUVectorIndex(_corpus(), index_type="hnsw")
+
+    with pytest.raises(ValueError):
+        GPUVectorIndex(np.zeros(8, dtype=np.float32))
+
+    with pytest.raises(ValueError):
+        GPUVectorIndex(_corpus(), ids=[1, 2, 3])
+
+    with pytest.raises(ValueError):
+        GPUVectorIndex(_corpus(), documents=[{"title": "a"}])
+
+    with pytest.raises(ValueError):
+        GPUVectorIndex(_corpus(dim=8)).search(_corpus(num_vectors=2, dim=4), 1)
+
+
+def test_hits():
+    corpus = _corpus(num_vectors=3, dim=2)
+    documents = cudf.DataFrame({"title": ["a", "b", "c"]})
+
+    index = GPUVectorIndex(corpus, documents, ids=[10, 20, 30])
+    hits = index.hits(*index.search(corpus[[2]], 5))
+
+    assert len(hits) == 1
+    assert len(hits[0]) == 3
+    assert hits[0][0]["title"] == "c"
+    assert hits[0][0]["id"] == 30
+    assert hits[0][0]["distance"] == pytest.approx(0, abs=1e-4)
+
+
+def test_constructor():
+    index = GPUVectorIndex(_corpus())
+
+    node = GPURetrieverNode(embedding=None, index=index)
+    assert isinstance(node, LLMNodeBase)
+    assert node.get_input_names() == ["embedding"]
+    assert GPURetrieverNode(embedding=mock.AsyncMock(), index=index).get_input_names() == ["query"]
+
+    with pytest.raises(ValueError):
+        GPURetrieverNode(embedding=None, index=index, k=0)
+
+    with pytest.raises(ValueError):
+        GPURetrieverNode(embedding=None, index=index, max_batch_size=0)
+
+
+def test_execute():
+    corpus = _corpus(dim=3)
+    embedding = mock.AsyncMock(return_value=corpus[[7, 9]].tolist())
+
+    node = GPURetrieverNode(embedding=embedding, index=GPUVectorIndex(corpus), k=2)
+
+    results = execute_node(node, query=["query1", "query2"])
+
+    embedding.assert_awaited_once_with(["query1", "query2"])
+    assert [hits[0]["id"] for hits in results] == [7, 9]
+    assert all(len(hits) == 2 for hits in results)
+
+
+def test_execute_batches_concurrent_contexts():
+    corpus = _corpus()
+    index = GPUVectorIndex(corpus)
+
+    node = GPURetrieverNode(embedding=None, index=index, k=1, max_batch_size=6, max_batch_delay=10)
+
+    async def execute_all():
+        contexts = []
+        for i in range(3):
+            parent_context = LLMContext(LLMTask("unittests", {}), ControlMessage())
+            contexts.append(_mk_context(parent_context, {"embedding": corpus[[2 * i, 2 * i + 1]].tolist()}))
+
+        with mock.patch.object(index, "search", wraps=index.search) as mock_search:
+            contexts = await asyncio.gather(*[node.execute(context) for context in contexts])
+
+        # The third context fills the batch, well before the delay expires
+        mock_search.assert_called_once()
+
+        return [context.view_outputs for context in contexts]
+
+    results = asyncio.run(execute_all())
+
+    assert [[hits[0]["id"] for hits in outputs] for outputs in results] == [[0, 1], [2, 3], [4, 5]]
@@ -0,0 +1,104 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import json
+from unittest import mock
+
+import pytest
+
+from _utils.llm import execute_node
+from morpheus.llm import LLMNodeBase
+from morpheus.llm.nodes.llm_cache_node import LLMCacheNode
+from morpheus.llm.nodes.llm_generate_node import LLMGenerateNode
+
+
+def _echo_responses(inputs: dict[str, list[str]]) -> list[str]:
+    return [f"response to {prompt}" for prompt in inputs["prompt"]]
+
+
+def test_constructor(mock_llm_client: mock.MagicMock):
+    node = LLMCacheNode(LLMGenerateNode(llm_client=mock_llm_client))
+    assert isinstance(node, LLMNodeBase)
+    assert node.get_input_names() == ["prompt"]
+
+
+def test_constructor_errors(mock_llm_client: mock.MagicMock):
+    with pytest.raises(ValueError):
+        LLMCacheNode(LLMGenerateNode(llm_client=mock_llm_client), max_entries=0)
+
+    with pytest.raises(ValueError):
+        LLMCacheNode(LLMGenerateNode(llm_client=mock_llm_client), embedding=mock.AsyncMock())
+
+
+def test_execute_exact_cache(mock_llm_client: mock.MagicMock):
+    mock_llm_client.generate_batch_async.side_effect = _echo_responses
+
+    node = LLMCacheNode(LLMGenerateNode(llm_client=mock_llm_client))
+
+    assert execute_node(node, prompt=["a", "b"]) == ["response to a", "response to b"]
+    mock_llm_client.generate_batch_async.assert_called_once_with({'prompt': ["a", "b"]})
+
+    # Only the new prompt is generated
+    mock_llm_client.generate_batch_async.reset_mock()
+    assert execute_node(node, prompt=["b", "c", "a"]) == ["response to b", "response to c", "response to a"]
+    mock_llm_client.generate_batch_async.assert_called_once_with({'prompt': ["c"]})
+
+    mock_llm_client.generate_batch_async.reset_mock()
+    assert execute_node(node, prompt=["a"]) == ["response to a"]
+    mock_llm_client.generate_batch_async.assert_not_called()
+
+
+def test_execute_evicts_least_recently_used(mock_llm_client: mock.MagicMock):
+    mock_llm_client.generate_batch_async.side_effect = _echo_responses
+
+    node = LLMCacheNode(LLMGenerateNode(llm_client=mock_llm_client), max_entries=2)
+
+    execute_node(node, prompt=["a", "b"])
+    execute_node(node, prompt=["a"])
+    execute_node(node, prompt=["c"])
+
+    # "b" was the least recently used entry
+    mock_llm_client.generate_batch_async.reset_mock()
+    execute_node(node, prompt=["a", "b"])
+    mock_llm_client.generate_batch_async.assert_called_once_with({'prompt': ["b"]})
+
+
+def test_execute_similarity_cache(mock_llm_client: mock.MagicMock):
+    mock_llm_client.generate_batch_async.side_effect = _echo_responses
+
+    embedding = mock.AsyncMock(return_value=[[0.1, 0.2], [0.3, 0.4]])
+
+    mock_vdb_service = mock.MagicMock()
+    mock_vdb_service.similarity_search = mock.AsyncMock(
+        return_value=[[{
+            "prompt": "similar to a", "response": json.dumps(["cached response", False])
+        }], []])
+
+    node = LLMCacheNode(LLMGenerateNode(llm_client=mock_llm_client),
+                        embedding=embedding,
+                        service=mock_vdb_service,
+                        max_distance=0.5)
+
+    assert execute_node(node, prompt=["a", "b"]) == ["cached response", "response to b"]
+
+    embedding.assert_awaited_once_with(["a", "b"])
+    mock_vdb_service.similarity_search.assert_awaited_once()
+    assert mock_vdb_service.similarity_search.call_args.kwargs["param"]["params"]["radius"] == 0.5
+    mock_llm_client.generate_batch_async.assert_called_once_with({'prompt': ["b"]})
+
+    # The generated response is added to the vector database
+    mock_vdb_service.insert.assert_called_once_with([{
+        "prompt": "b", "response": json.dumps(["response to b", False]), "embedding": [0.3, 0.4]
+    }])
@@ -13,9 +13,11 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import asyncio
 from unittest import mock
 
 from _utils.llm import execute_node
+from morpheus.llm import LLMContext
 from morpheus.llm import LLMNodeBase
 from morpheus.llm.nodes.llm_generate_node import LLMGenerateNode
 
@@ -37,3 +39,27 @@ def test_execute(mock_llm_client: mock.MagicMock):
     node = LLMGenerateNode(llm_client=mock_llm_client)
     assert execute_node(node, prompt=["prompt1", "prompt2"]) == expected_output
     mock_llm_client.generate_batch_async.assert_called_once_with({'prompt': ["prompt1", "prompt2"]})
+
+
+def test_execute_streaming(mock_llm_client: mock.MagicMock):
+
+    async def generate_stream(_: dict[str, list[str]]):
+        for item in [(0, "resp"), (1, "response2"), (0, "onse1")]:
+            yield item
+
+    mock_llm_client.generate_batch_stream_async = generate_stream
+
+    mock_context = mock.MagicMock(LLMContext)
+    mock_context.is_streaming.return_value = True
+    mock_context.get_inputs.return_value = {"prompt": ["prompt1", "prompt2"]}
+
+    node = LLMGenerateNode(llm_client=mock_llm_client)
+    asyncio.run(node.execute(mock_context))
+
+    assert mock_context.stream_output.call_args_list == [
+        mock.call({"index": 0, "text": "resp"}),
+        mock.call({"index": 1, "text": "response2"}),
+        mock.call({"index": 0, "text": "onse1"}),
+    ]
+    mock_context.set_output.assert_called_once_with(["response1", "response2"])
+    mock_llm_client.generate_batch_async.assert_not_called()
@@ -55,23 +55,37 @@ MULTI_LINE_JINJA_TEMPLATE = """Testing a loop:
           "Testing a loop:\nTitle: rockets, Summary: space\n\nquery2",
       ])],
     ids=["f-string-hello-world", "f-string-fruit-vegetable", "jinja-fruit-vegetable", "jinja-multi-line"])
-def test_prompt_template_node(template: str, template_format: str, values: dict, expected_output: list[str]):
-    node = PromptTemplateNode(template=template, template_format=template_format)
+@pytest.mark.parametrize("native", [True, False])
+def test_prompt_template_node(template: str,
+                              template_format: str,
+                              values: dict,
+                              expected_output: list[str],
+                              native: bool):
+    node = PromptTemplateNode(template=template, template_format=template_format, native=native)
     assert sorted(node.get_input_names()) == sorted(values.keys())
 
     assert execute_node(node, **values) == expected_output
 
 
 @pytest.mark.parametrize("template_format", ["f-string", "jinja"])
-def test_prompt_template_pass_thru(template_format: str):
+@pytest.mark.parametrize("native", [True, False])
+def test_prompt_template_pass_thru(template_format: str, native: bool):
     template = "template without any variables should rase an exception"
-    node = PromptTemplateNode(template=template, template_format=template_format)
+    node = PromptTemplateNode(template=template, template_format=template_format, native=native)
     assert len(node.get_input_names()) == 0
 
     inputs = {'input': ['unused', 'placeholder']}
     assert execute_node(node, **inputs) == [template, template]
 
 
+@pytest.mark.parametrize("template,expected_output", [("{value:.2f}", ["1.50", "2.25"]), ("{value!r}", ["1.5", "2.25"])],
+                         ids=["format-spec", "conversion"])
+def test_prompt_template_node_native_fallback(template: str, expected_output: list[str]):
+    # Templates the native node does not support are formatted in python
+    node = PromptTemplateNode(template=template, template_format="f-string", native=True)
+    assert execute_node(node, value=[1.5, 2.25]) == expected_output
+
+
 def test_unsupported_template_format():
     with pytest.raises(ValueError):
         PromptTemplateNode(template="Hello {name}!", template_format="unsupported")
@@ -17,6 +17,7 @@ from unittest import mock
 
 import pytest
 
+from morpheus.llm import LLMAdmissionController
 from morpheus.llm.services.llm_service import LLMClient
 from morpheus.llm.services.nemo_llm_service import NeMoLLMService
 
@@ -114,3 +115,34 @@ async def test_generate_batch_async_error_retry(mock_nemollm: mock.MagicMock):
     results = await client.generate_batch_async({'prompt': ["prompt1", "prompt2"]})
 
     assert results == ["prompt1", "prompt2"]
+
+
+async def test_generate_batch_async_admission_controller(mock_nemollm: mock.MagicMock):
+
+    count = 0
+
+    def mock_post_process_generate_response(*args, **_):
+        nonlocal count
+        if count < 1:
+            count += 1
+            return {"status": "fail", "msg": "unittest"}
+        return {"status": "success", "text": args[0]}
+
+    mock_nemollm.post_process_generate_response.side_effect = mock_post_process_generate_response
+
+    admission_controller = mock.MagicMock(LLMAdmissionController)
+    admission_controller.acquire = mock.AsyncMock(return_value=0.0)
+
+    client = NeMoLLMService(api_key="dummy", retry_count=2,
+                            admission_controller=admission_controller).get_client(model_name="test_model",
+                                                                                  tokens_to_generate=10)
+
+    results = await client.generate_batch_async({'prompt': ["prompt1", "prompt2"]})
+
+    assert results == ["prompt1", "prompt2"]
+
+    # The failed request waits to be admitted again before being retried
+    assert admission_controller.acquire.await_count == 3
+    admission_controller.acquire.assert_any_await(len("prompt1") // 4 + 10)
+    admission_controller.on_rate_limited.assert_called_once()
+    assert admission_controller.on_success.call_count == 2
@@ -52,4 +52,5 @@ def test_get_client_passed_args(mock_client: mock.MagicMock, set_assistant: bool
                                         set_assistant=set_assistant,
                                         temperature=temperature,
                                         test='this',
-                                        max_retries=max_retries)
+                                        max_retries=max_retries,
+                                        admission_controller=None)
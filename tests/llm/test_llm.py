@@ -17,14 +17,18 @@ import asyncio
 import asyncio.mixins
 import collections
 
+import pyarrow as pa
+
 import cudf
 
 from _utils.dataset_manager import DatasetManager
+from morpheus.llm import InputMap
 from morpheus.llm import LLMContext
 from morpheus.llm import LLMEngine
 from morpheus.llm import LLMLambdaNode
 from morpheus.llm import LLMNode
 from morpheus.llm import LLMNodeBase
+from morpheus.llm import LLMTask
 from morpheus.llm import LLMTaskHandler
 from morpheus.messages import ControlMessage
 from morpheus.messages import MessageMeta
@@ -233,3 +237,21 @@ async def test_simple_engine():
 
     assert len(result) == 1
     assert DatasetManager.df_equal(result[0].payload().df["response"], dataset["answers"])
+
+
+def test_context_columnar_outputs():
+    parent = LLMContext(LLMTask(), ControlMessage())
+
+    prompts = pa.array(["a", "b"])
+    responses = cudf.Series(["c", "d"])
+    parent.set_output("prompts", prompts)
+    parent.set_output("responses", responses)
+
+    # Python nodes receive the columns as is
+    child = parent.push("child", [InputMap("/prompts", "prompts"), InputMap("/responses", "responses")])
+    assert child.get_input("prompts") is prompts
+    assert child.get_inputs()["responses"] is responses
+
+    # Viewing the outputs converts the columns to lists
+    assert parent.view_outputs == {"prompts": ["a", "b"], "responses": ["c", "d"]}
+    assert child.get_input("prompts") == ["a", "b"]
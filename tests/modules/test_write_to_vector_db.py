@@ -0,0 +1,31 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import cupy as cp
+
+import cudf
+
+from morpheus.modules.output.write_to_vector_db import embeddings_to_series
+
+
+def test_embeddings_to_series():
+    embeddings = cp.arange(12, dtype=cp.float32).reshape(4, 3)
+    index = cudf.Index([10, 11, 12, 13])
+
+    series = embeddings_to_series(embeddings, index)
+
+    assert series.index.to_arrow().to_pylist() == [10, 11, 12, 13]
+    assert series.to_arrow().to_pylist() == embeddings.tolist()
@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+
+import pandas as pd
+
+from _utils import TEST_DIRS
+from _utils import assert_results
+from morpheus.config import Config
+from morpheus.pipeline import LinearPipeline
+from morpheus.stages.general.monitor_stage import MonitorStage
+from morpheus.stages.input.file_source_stage import FileSourceStage
+from morpheus.stages.output.compare_dataframe_stage import CompareDataFrameStage
+from morpheus.stages.output.in_memory_sink_stage import InMemorySinkStage
+from morpheus.stages.postprocess.serialize_stage import SerializeStage
+from morpheus.stages.preprocess.deserialize_stage import DeserializeStage
+
+
+def test_projection_pushed_to_source(config: Config, filter_probs_df: pd.DataFrame):
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+
+    pipe = LinearPipeline(config)
+    source = pipe.set_source(FileSourceStage(config, filename=input_file))
+    pipe.add_stage(DeserializeStage(config))
+    pipe.add_stage(MonitorStage(config))
+    pipe.add_stage(SerializeStage(config, include=["^v2$"]))
+    comp_stage = pipe.add_stage(CompareDataFrameStage(config, filter_probs_df[["v2"]]))
+    pipe.run()
+
+    assert source.get_column_projection() == ["^v2$"]
+    assert_results(comp_stage.get_results())
+
+
+def test_projection_disabled_by_undeclared_stage(config: Config):
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+
+    pipe = LinearPipeline(config)
+    source = pipe.set_source(FileSourceStage(config, filename=input_file))
+    pipe.add_stage(DeserializeStage(config))
+    pipe.add_stage(InMemorySinkStage(config))
+    pipe.run()
+
+    assert source.get_column_projection() == []
+
+
+def test_apply_column_projection(config: Config, filter_probs_df: pd.DataFrame):
+    source = FileSourceStage(config, filename=os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv"))
+
+    source.set_column_projection(["^V1$", "3"])
+    assert list(source._apply_column_projection(filter_probs_df).columns) == ["v1", "v3"]
+
+    # The first column is kept when no other one is, preserving the number of rows
+    source.set_column_projection(["^missing$"])
+    assert list(source._apply_column_projection(filter_probs_df).columns) == ["v1"]
@@ -81,6 +81,19 @@ async def test_normal_build_and_start(config: Config):
     assert pipeline.state == PipelineState.COMPLETED
 
 
+def test_startup_timings(config: Config):
+    pipeline = LinearPipeline(config)
+    pipeline.set_source(source_test_stage(config))
+    assert not pipeline.startup_timings
+
+    pipeline.run()
+    timings = pipeline.startup_timings
+    assert list(timings.keys())[0] == "pre-build"
+    assert "start executor" in timings
+    assert "build segment main" in timings
+    assert all(duration >= 0 for duration in timings.values())
+
+
 async def test_stop_after_start(config: Config):
 
     pipeline = LinearPipeline(config)
@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from unittest import mock
+
+import pytest
+
+from morpheus.config import Config
+from morpheus.pipeline import LinearPipeline
+from morpheus.stages.input.in_memory_source_stage import InMemorySourceStage
+from morpheus.stages.output.in_memory_sink_stage import InMemorySinkStage
+from morpheus.stages.postprocess.serialize_stage import SerializeStage
+from morpheus.stages.preprocess.deserialize_stage import DeserializeStage
+from morpheus.utils.type_aliases import DataFrameType
+
+
+def _build_pipeline(config: Config, df: DataFrameType):
+    pipe = LinearPipeline(config)
+    stages = [pipe.set_source(InMemorySourceStage(config, [df]))]
+    stages.append(pipe.add_stage(DeserializeStage(config)))
+    stages.append(pipe.add_stage(SerializeStage(config)))
+    stages.append(pipe.add_stage(InMemorySinkStage(config)))
+
+    return pipe, stages
+
+
+def test_trace_timestamps(config: Config, filter_probs_df: DataFrameType):
+    config.trace_timestamps = True
+
+    pipe, (source, deserialize, serialize, sink) = _build_pipeline(config, filter_probs_df)
+    pipe.run()
+
+    messages = sink.get_messages()
+    assert len(messages) == 1
+
+    timestamps = messages[0].filter_timestamp("")
+
+    expected_keys = [f"{source.unique_name}::exit"]
+    for stage in (deserialize, serialize, sink):
+        expected_keys.extend([f"{stage.unique_name}::entry", f"{stage.unique_name}::exit"])
+
+    assert sorted(timestamps.keys()) == sorted(expected_keys)
+
+    # Each message is stamped in the order it flows through the pipeline
+    ordered = [timestamps[key] for key in expected_keys]
+    assert ordered == sorted(ordered)
+
+
+def test_trace_timestamps_disabled(config: Config, filter_probs_df: DataFrameType):
+    pipe, (_, _, _, sink) = _build_pipeline(config, filter_probs_df)
+    pipe.run()
+
+    assert sink.get_messages()[0].filter_timestamp("") == {}
+
+
+@pytest.mark.use_python
+@mock.patch("morpheus._lib.messages.TimestampTraceExporter")
+def test_trace_timestamps_exported_at_sink(mock_exporter_cls: mock.MagicMock,
+                                           config: Config,
+                                           filter_probs_df: DataFrameType):
+    config.trace_timestamps = True
+    config.trace_sample_interval = 1
+
+    pipe, (_, _, _, sink) = _build_pipeline(config, filter_probs_df)
+    pipe.run()
+
+    # Only the exit of the sink exports the timestamps of the messages
+    mock_exporter_cls.assert_called_once_with(sink.unique_name)
+
+    mock_exporter = mock_exporter_cls.return_value
+    mock_exporter.record.assert_called_once()
+
+    timestamps = mock_exporter.record.call_args.args[0]
+    assert f"{sink.unique_name}::exit" in timestamps
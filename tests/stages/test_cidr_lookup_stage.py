@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pathlib
+
+import pytest
+
+import cudf
+
+from morpheus.common import FileTypes
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.pipeline import LinearPipeline
+from morpheus.stages.input.in_memory_source_stage import InMemorySourceStage
+from morpheus.stages.output.in_memory_sink_stage import InMemorySinkStage
+from morpheus.stages.preprocess.cidr_lookup_stage import CidrLookupStage
+from morpheus.stages.preprocess.deserialize_stage import DeserializeStage
+
+
+def test_constructor(config: Config):
+    stage = CidrLookupStage(config, filename="GeoLite2-Country-Blocks-IPv4.csv", address_columns=["src_ip", "dst_ip"])
+    assert stage.name == "cidr-lookup"
+    assert stage.accepted_types() == (ControlMessage, )
+    assert stage.supports_cpp_node()
+    assert stage._address_columns == ["src_ip", "dst_ip"]
+    assert stage._label_columns == []
+    assert stage._network_column == "network"
+    assert stage._file_type == FileTypes.Auto
+
+
+def test_constructor_labels(config: Config):
+    stage = CidrLookupStage(config,
+                            filename="zones.parquet",
+                            address_columns=["src_ip6"],
+                            label_columns=["zone"],
+                            network_column="cidr",
+                            file_type=FileTypes.PARQUET)
+    assert stage._label_columns == ["zone"]
+    assert stage._network_column == "cidr"
+    assert stage._file_type == FileTypes.PARQUET
+
+
+@pytest.mark.parametrize("kwargs", [{
+    "address_columns": []
+}, {
+    "address_columns": ["src_ip"], "label_columns": ["network"]
+}])
+def test_constructor_errors(config: Config, kwargs: dict):
+    with pytest.raises(ValueError):
+        CidrLookupStage(config, filename="zones.csv", **kwargs)
+
+
+@pytest.mark.use_cpp
+def test_cidr_lookup_error_pipe(config: Config, tmp_path: pathlib.Path):
+    filename = str(tmp_path / "zones.csv")
+    cudf.DataFrame({"network": ["10.0.0.0/8"], "zone": ["internal"]}).to_csv(filename, index=False)
+
+    # The payload has no `src_ip` column, the error stops the pipeline rather than the message being passed through
+    pipe = LinearPipeline(config)
+    pipe.set_source(InMemorySourceStage(config, [cudf.DataFrame({"dst_ip": ["10.0.0.1"], "bytes": [100]})]))
+    pipe.add_stage(DeserializeStage(config, message_type=ControlMessage))
+    pipe.add_stage(CidrLookupStage(config, filename=filename, address_columns=["src_ip"]))
+    sink = pipe.add_stage(InMemorySinkStage(config))
+
+    with pytest.raises(ValueError):
+        pipe.run()
+
+    assert len(sink.get_messages()) == 0
@@ -0,0 +1,54 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.stages.boundary.cuda_ipc_boundary_stage import CudaIpcBoundaryEgressStage
+from morpheus.stages.boundary.cuda_ipc_boundary_stage import CudaIpcBoundaryIngressStage
+
+
+def test_constructor(config: Config):
+    egress = CudaIpcBoundaryEgressStage(config, ring_name="morpheus-scores")
+    assert egress.name == "cuda-ipc-boundary-egress"
+    assert egress.accepted_types() == (ControlMessage, )
+    assert egress.supports_cpp_node()
+    assert egress._num_slots == 64
+    assert egress._close_timeout == 60.0
+
+    ingress = CudaIpcBoundaryIngressStage(config, ring_name="morpheus-scores")
+    assert ingress.name == "cuda-ipc-boundary-ingress"
+    assert ingress.supports_cpp_node()
+    assert ingress._open_timeout == 60.0
+
+
+@pytest.mark.parametrize("ring_name", ["", "morpheus/scores"])
+def test_constructor_ring_name_errors(config: Config, ring_name: str):
+    with pytest.raises(ValueError):
+        CudaIpcBoundaryEgressStage(config, ring_name=ring_name)
+
+    with pytest.raises(ValueError):
+        CudaIpcBoundaryIngressStage(config, ring_name=ring_name)
+
+
+@pytest.mark.parametrize("num_slots, max_header_bytes", [(0, 65536), (64, 0)])
+def test_constructor_errors(config: Config, num_slots: int, max_header_bytes: int):
+    with pytest.raises(ValueError):
+        CudaIpcBoundaryEgressStage(config,
+                                   ring_name="morpheus-scores",
+                                   num_slots=num_slots,
+                                   max_header_bytes=max_header_bytes)
@@ -0,0 +1,46 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.stages.preprocess.deduplicate_stage import DeduplicateStage
+
+
+def test_constructor(config: Config):
+    stage = DeduplicateStage(config, key_columns=["host", "event"], window_ms=60000)
+    assert stage.name == "deduplicate"
+    assert stage.accepted_types() == (ControlMessage, )
+    assert stage.supports_cpp_node()
+    assert stage._key_columns == ["host", "event"]
+    assert stage._window_ms == 60000
+    assert stage._num_buckets == 10
+    assert stage._max_keys == 10000000
+
+
+@pytest.mark.parametrize("kwargs", [{
+    "key_columns": []
+}, {
+    "key_columns": ["host"], "window_ms": 0
+}, {
+    "key_columns": ["host"], "num_buckets": 0
+}, {
+    "key_columns": ["host"], "max_keys": 0
+}])
+def test_constructor_errors(config: Config, kwargs: dict):
+    with pytest.raises(ValueError):
+        DeduplicateStage(config, **kwargs)
@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pathlib
+
+import pytest
+
+import cudf
+
+from morpheus.common import FileTypes
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.pipeline import LinearPipeline
+from morpheus.stages.input.in_memory_source_stage import InMemorySourceStage
+from morpheus.stages.output.in_memory_sink_stage import InMemorySinkStage
+from morpheus.stages.preprocess.deserialize_stage import DeserializeStage
+from morpheus.stages.preprocess.enrich_stage import EnrichStage
+
+
+def test_constructor(config: Config):
+    stage = EnrichStage(config, filename="assets.parquet", key_columns=["ip"])
+    assert stage.name == "enrich"
+    assert stage.accepted_types() == (ControlMessage, )
+    assert stage.supports_cpp_node()
+    assert stage._key_columns == ["ip"]
+    assert stage._event_key_columns == ["ip"]
+    assert stage._value_columns == []
+    assert stage._prefix == ""
+    assert stage._file_type == FileTypes.Auto
+    assert stage._reload_interval_ms == 0
+
+
+def test_constructor_event_keys(config: Config):
+    stage = EnrichStage(config,
+                        filename="feed.csv",
+                        key_columns=["indicator"],
+                        value_columns=["reputation"],
+                        event_key_columns=["dst_ip"],
+                        prefix="ti_",
+                        file_type=FileTypes.CSV,
+                        reload_interval="30s")
+    assert stage._event_key_columns == ["dst_ip"]
+    assert stage._value_columns == ["reputation"]
+    assert stage._prefix == "ti_"
+    assert stage._file_type == FileTypes.CSV
+    assert stage._reload_interval_ms == 30000
+
+
+@pytest.mark.parametrize("kwargs", [{
+    "key_columns": []
+}, {
+    "key_columns": ["ip"], "event_key_columns": ["src_ip", "dst_ip"]
+}, {
+    "key_columns": ["ip"], "reload_interval": "0s"
+}])
+def test_constructor_errors(config: Config, kwargs: dict):
+    with pytest.raises(ValueError):
+        EnrichStage(config, filename="assets.parquet", **kwargs)
+
+
+@pytest.mark.use_cpp
+def test_enrich_error_pipe(config: Config, tmp_path: pathlib.Path):
+    filename = str(tmp_path / "assets.csv")
+    cudf.DataFrame({"host": [1, 2], "owner": [10, 20]}).to_csv(filename, index=False)
+
+    # The payload has no `host` column, the error stops the pipeline rather than the message being passed through
+    pipe = LinearPipeline(config)
+    pipe.set_source(InMemorySourceStage(config, [cudf.DataFrame({"address": [1, 2], "bytes": [100, 200]})]))
+    pipe.add_stage(DeserializeStage(config, message_type=ControlMessage))
+    pipe.add_stage(EnrichStage(config, filename=filename, key_columns=["host"]))
+    sink = pipe.add_stage(InMemorySinkStage(config))
+
+    with pytest.raises(ValueError):
+        pipe.run()
+
+    assert len(sink.get_messages()) == 0
@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+import cudf
+
+from _utils.dataset_manager import DatasetManager
+from morpheus.config import Config
+from morpheus.messages import MessageMeta
+from morpheus.pipeline import LinearPipeline
+from morpheus.stages.input.in_memory_source_stage import InMemorySourceStage
+from morpheus.stages.output.in_memory_sink_stage import InMemorySinkStage
+from morpheus.stages.preprocess.filter_rows_stage import FilterRowsStage
+
+
+def _requests_df() -> cudf.DataFrame:
+    return cudf.DataFrame({
+        "src_ip": ["10.0.0.1", "192.168.1.7", "10.1.2.3", "not an ip", "8.8.8.8"],
+        "url": ["/healthz", "/login", "/api/data", "/healthz/ready", "/login"],
+        "bytes": [10, 200, 3000, 40, 500],
+    })
+
+
+def test_constructor(config: Config):
+    stage = FilterRowsStage(config, predicates=[("url", "matches", "^/healthz")], exclude=True)
+    assert stage.name == "filter-rows"
+    assert stage.accepted_types() == (MessageMeta, )
+    assert stage.supports_cpp_node()
+    assert stage.get_needed_columns() == {}
+
+    with pytest.raises(ValueError):
+        FilterRowsStage(config, predicates=[])
+
+    with pytest.raises(ValueError):
+        FilterRowsStage(config, predicates=[("bytes", "like", "1")])
+
+    with pytest.raises(ValueError):
+        FilterRowsStage(config, predicates=[("src_ip", "in_cidr", "10.0.0.0/33")])
+
+
+@pytest.mark.use_python
+@pytest.mark.parametrize("predicates, match_all, exclude, expected_bytes",
+                         [([("url", "matches", "^/healthz")], True, True, [200, 3000, 500]),
+                          ([("src_ip", "in_cidr", "10.0.0.0/8, 192.168.1.7")], True, False, [10, 200, 3000]),
+                          ([("bytes", ">=", "200"), ("url", "==", "/login")], True, False, [200, 500]),
+                          ([("bytes", ">", "1000"), ("bytes", "<", "20")], False, False, [10, 3000])])
+def test_filter_rows(config: Config, predicates, match_all: bool, exclude: bool, expected_bytes: list):
+    stage = FilterRowsStage(config, predicates=predicates, match_all=match_all, exclude=exclude)
+
+    output = stage._filter_rows(MessageMeta(_requests_df()))
+    assert output.copy_dataframe()["bytes"].to_arrow().to_pylist() == expected_bytes
+
+
+@pytest.mark.use_python
+def test_filter_rows_all_or_none(config: Config):
+    message = MessageMeta(_requests_df())
+
+    assert FilterRowsStage(config, predicates=[("bytes", ">", "0")])._filter_rows(message) is message
+    assert FilterRowsStage(config, predicates=[("bytes", ">", "0")], exclude=True)._filter_rows(message) is None
+
+
+def test_filter_rows_pipe(config: Config):
+    df = _requests_df()
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(InMemorySourceStage(config, [df, df[df["bytes"] < 50]]))
+    pipe.add_stage(FilterRowsStage(config, predicates=[("url", "matches", "^/healthz")], exclude=True))
+    sink = pipe.add_stage(InMemorySinkStage(config))
+    pipe.run()
+
+    # The second message only holds health checks and is not emitted
+    messages = sink.get_messages()
+    assert len(messages) == 1
+    DatasetManager.assert_compare_df(messages[0].copy_dataframe(), df.iloc[[1, 2, 4]])
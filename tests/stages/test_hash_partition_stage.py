@@ -0,0 +1,97 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+import cudf
+
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.pipeline import Pipeline
+from morpheus.stages.general.hash_partition_stage import HashPartitionStage
+from morpheus.stages.input.in_memory_source_stage import InMemorySourceStage
+from morpheus.stages.output.in_memory_sink_stage import InMemorySinkStage
+
+
+def _flows_df() -> cudf.DataFrame:
+    return cudf.DataFrame({
+        "flow_id": [1, 2, 3, 1, 4, 2, 5, 1],
+        "bytes": [10, 20, 30, 40, 50, 60, 70, 80],
+    })
+
+
+def test_constructor(config: Config):
+    stage = HashPartitionStage(config, key_columns=["flow_id"], num_partitions=3)
+    assert stage.name == "hash-partition"
+    assert stage.accepted_types() == (MessageMeta, ControlMessage)
+    assert stage.supports_cpp_node()
+    assert len(stage.output_ports) == 3
+
+    with pytest.raises(ValueError):
+        HashPartitionStage(config, key_columns=[], num_partitions=3)
+
+    with pytest.raises(ValueError):
+        HashPartitionStage(config, key_columns=["flow_id"], num_partitions=0)
+
+
+@pytest.mark.use_python
+def test_partition_control_message(config: Config):
+    message = ControlMessage()
+    message.payload(MessageMeta(_flows_df()))
+    message.set_metadata("source", "sensor-1")
+
+    partitions = HashPartitionStage(config, key_columns=["flow_id"], num_partitions=2)._partition(message)
+    assert len(partitions) == 2
+
+    rows = 0
+    for partition in partitions:
+        if partition is not None:
+            assert partition.get_metadata("source") == "sensor-1"
+            rows += partition.payload().count
+
+    assert rows == len(_flows_df())
+
+
+@pytest.mark.parametrize("num_partitions", [1, 3])
+def test_hash_partition_pipe(config: Config, num_partitions: int):
+    df = _flows_df()
+
+    pipe = Pipeline(config)
+    source = pipe.add_stage(InMemorySourceStage(config, [df, df]))
+    partition_stage = pipe.add_stage(HashPartitionStage(config, key_columns=["flow_id"], num_partitions=num_partitions))
+    pipe.add_edge(source, partition_stage)
+
+    sinks = []
+    for port in partition_stage.output_ports:
+        sink = pipe.add_stage(InMemorySinkStage(config))
+        pipe.add_edge(port, sink)
+        sinks.append(sink)
+
+    pipe.run()
+
+    # Every row reaches a single port, and every row of a flow the same one
+    ports_of_flow = {}
+    rows = 0
+    for (port, sink) in enumerate(sinks):
+        for message in sink.get_messages():
+            for flow_id in message.copy_dataframe()["flow_id"].to_arrow().to_pylist():
+                ports_of_flow.setdefault(flow_id, set()).add(port)
+                rows += 1
+
+    assert rows == 2 * len(df)
+    assert sorted(ports_of_flow) == [1, 2, 3, 4, 5]
+    assert all(len(ports) == 1 for ports in ports_of_flow.values())
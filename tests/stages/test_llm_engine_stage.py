@@ -16,6 +16,8 @@
 
 from unittest import mock
 
+import pytest
+
 from morpheus.config import Config
 from morpheus.llm import LLMEngine
 from morpheus.messages import ControlMessage
@@ -42,3 +44,8 @@ def test_accepted_types(config: Config):
 def test_supports_cpp_node(config: Config):
     stage = LLMEngineStage(config, engine=mock.MagicMock(LLMEngine))
     assert stage.supports_cpp_node()
+
+
+def test_constructor_max_concurrency(config: Config):
+    with pytest.raises(ValueError):
+        LLMEngineStage(config, engine=mock.MagicMock(LLMEngine), max_concurrency=-1)
@@ -42,7 +42,9 @@ def _build_engine() -> LLMEngine:
 
 @pytest.mark.use_cudf
 @pytest.mark.use_python
-def test_pipeline(config: Config, dataset_cudf: DatasetManager):
+@pytest.mark.parametrize("max_concurrency", [0, 1])
+@pytest.mark.parametrize("streaming,trace", [(False, False), (True, False), (False, True)])
+def test_pipeline(config: Config, dataset_cudf: DatasetManager, max_concurrency: int, streaming: bool, trace: bool):
     test_data = os.path.join(TEST_DIRS.validation_data_dir, 'root-cause-validation-data-input.jsonlines')
     input_df = dataset_cudf[test_data]
     expected_df = input_df.copy(deep=True)
@@ -53,7 +55,12 @@ def test_pipeline(config: Config, dataset_cudf: DatasetManager):
     pipe.set_source(InMemorySourceStage(config, dataframes=[input_df]))
     pipe.add_stage(
         DeserializeStage(config, message_type=ControlMessage, task_type="llm_engine", task_payload=task_payload))
-    pipe.add_stage(LLMEngineStage(config, engine=_build_engine()))
+    pipe.add_stage(
+        LLMEngineStage(config,
+                       engine=_build_engine(),
+                       max_concurrency=max_concurrency,
+                       streaming=streaming,
+                       trace=trace))
     sink = pipe.add_stage(CompareDataFrameStage(config, compare_df=expected_df))
 
     pipe.run()
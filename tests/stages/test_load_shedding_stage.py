@@ -0,0 +1,54 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.stages.preprocess.load_shedding_stage import LoadSheddingStage
+
+
+def test_constructor(config: Config):
+    stage = LoadSheddingStage(config,
+                              priority_column="severity",
+                              min_rates={
+                                  0: 0.1, "1": 0.5
+                              },
+                              pressure_metric="morpheus_kafka_source_consumer_lag",
+                              low_watermark=1000,
+                              high_watermark=10000)
+    assert stage.name == "load-shedding"
+    assert stage.accepted_types() == (ControlMessage, )
+    assert stage.supports_cpp_node()
+    assert stage._min_rates == {"0": 0.1, "1": 0.5}
+    assert stage._pressure_labels == {}
+    assert not stage._from_histogram
+
+
+@pytest.mark.parametrize("kwargs", [{
+    "min_rates": {}
+}, {
+    "min_rates": {
+        "low": 1.5
+    }
+}, {
+    "min_rates": {
+        "low": 0.5
+    }, "low_watermark": 2.0, "high_watermark": 1.0
+}])
+def test_constructor_errors(config: Config, kwargs: dict):
+    with pytest.raises(ValueError):
+        LoadSheddingStage(config, priority_column="severity", pressure_metric="queue_depth", **kwargs)
@@ -0,0 +1,35 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+from morpheus.config import Config
+from morpheus.stages.input.nvml_source_stage import NvmlSourceStage
+
+
+def test_constructor(config: Config):
+    stage = NvmlSourceStage(config, interval_ms=500, polls_per_message=10)
+    assert stage.name == "from-nvml"
+    assert stage.supports_cpp_node()
+    assert stage._interval_ms == 500
+    assert stage._polls_per_message == 10
+    assert stage._max_polls == 0
+
+
+@pytest.mark.parametrize("kwargs", [{"interval_ms": -1}, {"polls_per_message": 0}, {"max_polls": -1}])
+def test_constructor_errors(config: Config, kwargs: dict):
+    with pytest.raises(ValueError):
+        NvmlSourceStage(config, **kwargs)
@@ -0,0 +1,50 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+
+import pytest
+
+from morpheus.config import Config
+from morpheus.stages.input.replay_source_stage import ReplaySourceStage
+
+
+@pytest.fixture(name="capture_log")
+def capture_log_fixture(tmp_path: str) -> str:
+    filename = os.path.join(tmp_path, "capture.arrows")
+    with open(filename, "wb"):
+        pass
+
+    return filename
+
+
+def test_constructor(config: Config, capture_log: str):
+    stage = ReplaySourceStage(config, filename=capture_log)
+    assert stage.name == "from-replay"
+    assert stage.supports_cpp_node()
+    assert stage._speed == 1.0
+    assert stage._repeat == 1
+
+
+def test_constructor_missing_file(config: Config, tmp_path: str):
+    with pytest.raises(FileNotFoundError):
+        ReplaySourceStage(config, filename=os.path.join(tmp_path, "missing.arrows"))
+
+
+@pytest.mark.parametrize("kwargs", [{"speed": -1.0}, {"repeat": 0}])
+def test_constructor_errors(config: Config, capture_log: str, kwargs: dict):
+    with pytest.raises(ValueError):
+        ReplaySourceStage(config, filename=capture_log, **kwargs)
@@ -0,0 +1,48 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.stages.preprocess.rolling_window_stage import RollingWindowStage
+
+
+def test_constructor(config: Config):
+    stage = RollingWindowStage(config, min_history=1, min_increment=0, max_history=10)
+    assert stage.name == "rolling-window"
+    assert stage.accepted_types() == (ControlMessage, )
+    assert stage.supports_cpp_node()
+    assert stage._max_history_rows == 10
+    assert stage._max_history_ns == 0
+
+
+@pytest.mark.parametrize("max_history, expected_ns", [("60s", 60 * 10**9), ("1d", 86400 * 10**9)])
+def test_constructor_duration(config: Config, max_history: str, expected_ns: int):
+    stage = RollingWindowStage(config, min_history=1, min_increment=0, max_history=max_history)
+    assert stage._max_history_rows == 0
+    assert stage._max_history_ns == expected_ns
+
+
+def test_constructor_unbounded(config: Config):
+    stage = RollingWindowStage(config, min_history=1, min_increment=0, max_history=None)
+    assert stage._max_history_rows == 0
+    assert stage._max_history_ns == 0
+
+
+@pytest.mark.parametrize("max_history", [-1, "-5s", 1.5])
+def test_constructor_errors(config: Config, max_history):
+    with pytest.raises(ValueError):
+        RollingWindowStage(config, min_history=1, min_increment=0, max_history=max_history)
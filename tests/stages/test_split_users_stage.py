@@ -0,0 +1,45 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+from morpheus.config import Config
+from morpheus.config import ConfigAutoEncoder
+from morpheus.messages import ControlMessage
+from morpheus.stages.preprocess.split_users_stage import SplitUsersStage
+
+
+def test_constructor(config: Config):
+    config.ae = ConfigAutoEncoder(userid_column_name="user", fallback_username="everyone")
+
+    stage = SplitUsersStage(config, include_generic=True, include_individual=False, skip_users=["alice"])
+    assert stage.name == "split-users"
+    assert stage.accepted_types() == (ControlMessage, )
+    assert stage.supports_cpp_node()
+    assert stage._userid_column_name == "user"
+    assert stage._fallback_username == "everyone"
+    assert stage._skip_users == ["alice"]
+    assert stage._only_users == []
+
+
+def test_constructor_without_ae(config: Config):
+    config.ae = None
+
+    stage = SplitUsersStage(config, include_generic=False, include_individual=True, userid_column_name="user")
+    assert stage._userid_column_name == "user"
+    assert stage._fallback_username == "generic_user"
+
+    with pytest.raises(ValueError):
+        SplitUsersStage(config, include_generic=False, include_individual=True)
@@ -0,0 +1,44 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.stages.boundary.ucx_boundary_stage import UcxBoundaryEgressStage
+from morpheus.stages.boundary.ucx_boundary_stage import UcxBoundaryIngressStage
+
+
+def test_constructor(config: Config):
+    egress = UcxBoundaryEgressStage(config, address="10.0.0.2", port=13337)
+    assert egress.name == "ucx-boundary-egress"
+    assert egress.accepted_types() == (ControlMessage, )
+    assert egress.supports_cpp_node()
+    assert egress._connect_timeout == 60.0
+
+    ingress = UcxBoundaryIngressStage(config, port=13337)
+    assert ingress.name == "ucx-boundary-ingress"
+    assert ingress.supports_cpp_node()
+    assert ingress._bind_address == "0.0.0.0"
+
+
+@pytest.mark.parametrize("port", [0, 65536])
+def test_constructor_errors(config: Config, port: int):
+    with pytest.raises(ValueError):
+        UcxBoundaryEgressStage(config, address="10.0.0.2", port=port)
+
+    with pytest.raises(ValueError):
+        UcxBoundaryIngressStage(config, port=port)
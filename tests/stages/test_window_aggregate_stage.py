@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import pytest
+
+import cudf
+
+from morpheus.config import Config
+from morpheus.messages import ControlMessage
+from morpheus.pipeline import LinearPipeline
+from morpheus.stages.input.in_memory_source_stage import InMemorySourceStage
+from morpheus.stages.output.in_memory_sink_stage import InMemorySinkStage
+from morpheus.stages.preprocess.deserialize_stage import DeserializeStage
+from morpheus.stages.preprocess.window_aggregate_stage import WindowAggregateStage
+
+
+def test_constructor(config: Config):
+    stage = WindowAggregateStage(config,
+                                 key_columns=["user"],
+                                 aggregations={"bytes": ["sum", "mean"]},
+                                 window="5min",
+                                 slide="1min")
+    assert stage.name == "window-aggregate"
+    assert stage.accepted_types() == (ControlMessage, )
+    assert stage.supports_cpp_node()
+    assert stage._key_columns == ["user"]
+    assert stage._aggregations == {"bytes": ["sum", "mean"]}
+    assert stage._window_ns == 300 * 10**9
+    assert stage._slide_ns == 60 * 10**9
+    assert stage._allowed_lateness_ns == 0
+
+
+def test_constructor_tumbling(config: Config):
+    stage = WindowAggregateStage(config,
+                                 key_columns=["user"],
+                                 aggregations={"failed": ["count"]},
+                                 window="1min",
+                                 allowed_lateness="10s",
+                                 timestamp_column_name="event_time")
+    assert stage._slide_ns == stage._window_ns
+    assert stage._allowed_lateness_ns == 10 * 10**9
+    assert stage._timestamp_column_name == "event_time"
+
+
+@pytest.mark.parametrize("kwargs", [{
+    "key_columns": [], "aggregations": {}, "window": "1min"
+}, {
+    "key_columns": ["user"], "aggregations": {
+        "bytes": ["median"]
+    }, "window": "1min"
+}, {
+    "key_columns": ["user"], "aggregations": {}, "window": "0s"
+}, {
+    "key_columns": ["user"], "aggregations": {}, "window": "1min", "slide": "7s"
+}, {
+    "key_columns": ["user"], "aggregations": {}, "window": "1min", "allowed_lateness": "-1s"
+}])
+def test_constructor_errors(config: Config, kwargs: dict):
+    with pytest.raises(ValueError):
+        WindowAggregateStage(config, **kwargs)
+
+
+@pytest.mark.use_cpp
+def test_window_aggregate_error_pipe(config: Config):
+    # The payload has no `user` column, the error stops the pipeline rather than the message being dropped
+    df = cudf.DataFrame({"timestamp": cudf.Series([0, 1], dtype="datetime64[ns]"), "bytes": [100, 200]})
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(InMemorySourceStage(config, [df]))
+    pipe.add_stage(DeserializeStage(config, message_type=ControlMessage))
+    pipe.add_stage(
+        WindowAggregateStage(config,
+                             key_columns=["user"],
+                             aggregations={"bytes": ["sum"]},
+                             window="1min",
+                             timestamp_column_name="timestamp"))
+    sink = pipe.add_stage(InMemorySinkStage(config))
+
+    with pytest.raises(ValueError):
+        pipe.run()
+
+    assert len(sink.get_messages()) == 0
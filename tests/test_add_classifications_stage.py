@@ -22,6 +22,7 @@ import cudf
 from _utils.dataset_manager import DatasetManager
 # pylint: disable=morpheus-incorrect-lib-from-import
 from morpheus._lib.messages import TensorMemory as CppTensorMemory
+from morpheus.common import TypeId
 from morpheus.config import Config
 from morpheus.messages import ControlMessage
 from morpheus.messages.memory.tensor_memory import TensorMemory
@@ -124,3 +125,66 @@ def test_add_labels_with_multi_response_message_and_contgrol_message():
 
     with pytest.raises(RuntimeError):
         AddClassificationsStage._add_labels(cm, idx2label=class_labels, threshold=threshold)
+
+
+@pytest.mark.use_python
+def test_add_labels_top_k():
+
+    class_labels = {0: "frogs", 1: "lizards", 2: "toads"}
+
+    df = cudf.DataFrame([0, 1, 2], columns=["dummy"])
+    probs_array = cp.array([[0.1, 0.6, 0.8], [0.9, 0.7, 0.7], [0.2, 0.3, 0.1]])
+
+    mrm = MultiResponseMessage(meta=MessageMeta(df), memory=TensorMemory(count=3, tensors={"probs": probs_array}))
+
+    labeled_mrm = AddClassificationsStage._add_labels(mrm, idx2label=class_labels, threshold=0.5, top_k=2)
+
+    # Ties are broken by the order of the labels, and ranks not above the threshold have an id of -1
+    DatasetManager.assert_df_equal(labeled_mrm.get_meta("top_0_id"), cp.array([2, 0, -1], dtype=cp.int32))
+    DatasetManager.assert_df_equal(labeled_mrm.get_meta("top_1_id"), cp.array([1, 1, -1], dtype=cp.int32))
+    DatasetManager.assert_df_equal(labeled_mrm.get_meta("top_0_score"),
+                                   cp.array([0.8, 0.9, 0.3], dtype=cp.float32))
+    DatasetManager.assert_df_equal(labeled_mrm.get_meta("top_1_score"),
+                                   cp.array([0.6, 0.7, 0.2], dtype=cp.float32))
+
+    assert "frogs" not in labeled_mrm.meta.df.columns
+
+
+def test_constructor_packed_column(config: Config):
+    stage = AddClassificationsStage(config, labels=['toads', 'frogs'], packed_column='labels')
+    assert stage.packed_labels == ['frogs', 'toads']
+    assert stage._needed_columns == {'labels': TypeId.UINT64}
+
+    with pytest.raises(AssertionError):
+        AddClassificationsStage(config, threshold=None, packed_column='labels')
+
+    with pytest.raises(AssertionError):
+        AddClassificationsStage(config, top_k=1, packed_column='labels')
+
+
+@pytest.mark.use_python
+def test_add_labels_packed_column():
+
+    class_labels = {0: "frogs", 1: "lizards", 2: "toads"}
+
+    threshold = 0.6
+
+    df = cudf.DataFrame([0, 1], columns=["dummy"])
+    probs_array = cp.array([[0.1, 0.6, 0.8], [0.7, 0.61, 0.9]])
+
+    mrm = MultiResponseMessage(meta=MessageMeta(df), memory=TensorMemory(count=2, tensors={"probs": probs_array}))
+
+    labeled_mrm = AddClassificationsStage._add_labels(mrm,
+                                                      idx2label=class_labels,
+                                                      threshold=threshold,
+                                                      packed_column="labels")
+
+    packed = labeled_mrm.get_meta("labels")
+    DatasetManager.assert_df_equal(packed, cp.array([0b100, 0b111], dtype=cp.uint64))
+
+    unpacked = AddClassificationsStage.unpack_labels(packed, list(class_labels.values()))
+    probs_array_bool = probs_array > threshold
+    for i, label in class_labels.items():
+        DatasetManager.assert_df_equal(unpacked[label], probs_array_bool[:, i])
+
+    assert "frogs" not in labeled_mrm.meta.df.columns
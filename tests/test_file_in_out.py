@@ -194,8 +194,10 @@ def test_file_rw_index_pipe(tmp_path: pathlib.Path, config: Config, input_file:
                              "include_header": True, "include_index_col": False
                          }), (os.path.join(TEST_DIRS.tests_data_dir, "filter_probs_w_id_col.csv"), {
                              "include_header": True
+                         }), (os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv"), {
+                             "include_header": True, "include_index_col": False, "device_write": True
                          }), (os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.jsonlines"), {})],
-                         ids=["CSV", "CSV_ID", "JSON"])
+                         ids=["CSV", "CSV_ID", "CSV_DEVICE_WRITE", "JSON"])
 @pytest.mark.usefixtures("use_cpp")
 def test_file_roundtrip(tmp_path: pathlib.Path, input_file: str, extra_kwargs: dict[str, typing.Any]):
 
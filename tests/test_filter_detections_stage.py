@@ -17,7 +17,10 @@
 import cupy as cp
 import pytest
 
+import morpheus._lib.messages as _messages
 from morpheus.common import FilterSource
+from morpheus.common import TypeId
+from morpheus.messages import ControlMessage
 from morpheus.messages import MultiResponseMessage
 from morpheus.messages import ResponseMemory
 from morpheus.messages.message_meta import MessageMeta
@@ -190,3 +193,63 @@ def test_filter_slice(config, filter_probs_df):
 
     assert msg1.get_meta().to_cupy().tolist() == filter_probs_df.loc[2:2, :].to_cupy().tolist()
     assert msg2.get_meta().to_cupy().tolist() == filter_probs_df.loc[4:4, :].to_cupy().tolist()
+
+
+@pytest.mark.use_cudf
+@pytest.mark.use_python
+def test_filter_mask(config, filter_probs_df):
+    fds = FilterDetectionsStage(config, threshold=0.5, filter_source=FilterSource.TENSOR, mask_column="mask")
+    assert fds.get_needed_columns() == {"mask": TypeId.BOOL8}
+
+    probs = cp.array([
+        [0.2, 0.4, 0.3],
+        [0.1, 0.5, 0.8],
+        [0.2, 0.4, 0.3],
+        [0.1, 0.9, 0.2],
+    ])
+
+    df = filter_probs_df[0:len(probs)].copy()
+    df["mask"] = False
+    mock_message = _make_message(df, probs)
+
+    # The message is passed on whole with the result of the filter in the mask column
+    output_message = fds._controller.filter_mask(mock_message)
+    assert output_message is mock_message
+    assert output_message.count == len(probs)
+    assert output_message.get_meta("mask").to_numpy().tolist() == [False, True, False, True]
+
+
+@pytest.mark.use_cudf
+@pytest.mark.use_python
+@pytest.mark.parametrize('do_copy', [True, False])
+def test_filter_control_message(config, filter_probs_df, do_copy):
+    fds = FilterDetectionsStage(config, threshold=0.5, copy=do_copy, filter_source=FilterSource.TENSOR)
+
+    # Two non-adjacent rows have a value above the threashold
+    probs = cp.array([
+        [0.2, 0.4, 0.3],
+        [0.1, 0.2, 0.3],
+        [0.1, 0.5, 0.8],
+        [0.4, 0.3, 0.2],
+        [0.1, 0.9, 0.2],
+        [0.2, 0.4, 0.3],
+    ])
+
+    message = ControlMessage()
+    message.payload(MessageMeta(filter_probs_df[0:len(probs)]))
+    message.tensors(_messages.TensorMemory(count=len(probs), tensors={'probs': probs}))
+
+    if do_copy:
+        output_messages = [fds._controller.filter_copy(message)]
+        expected = [filter_probs_df.loc[[2, 4], :]]
+    else:
+        output_messages = fds._controller.filter_slice(message)
+        expected = [filter_probs_df.loc[2:2, :], filter_probs_df.loc[4:4, :]]
+
+    assert len(output_messages) == len(expected)
+    for (output_message, expected_df) in zip(output_messages, expected):
+        assert output_message.payload().get_data().to_cupy().tolist() == expected_df.to_cupy().tolist()
+
+        output_probs = output_message.tensors().get_tensor('probs')
+        assert output_probs.shape == (len(expected_df), 3)
+        assert (output_probs.max(axis=1) > 0.5).all()
@@ -12,11 +12,15 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import math
+import queue
 import typing
 from functools import partial
+from http import HTTPStatus
 from io import StringIO
 from unittest import mock
 
+import pandas as pd
 import pytest
 
 from _utils import make_mock_response
@@ -136,3 +140,48 @@ def test_write_to_http_stage_pipe(mock_sleep: mock.MagicMock,
                                  data=called_buffer)
 
     mock_sleep.assert_not_called()
+
+
+@pytest.mark.slow
+@pytest.mark.use_cpp
+@pytest.mark.parametrize("lines", [False, True])
+@pytest.mark.parametrize("max_connections", [1, 4])
+def test_write_to_http_stage_pipe_cpp(config: Config, dataset: DatasetManager, lines: bool, max_connections: int):
+    from morpheus.common import HttpServer
+
+    received_payloads = queue.Queue()
+
+    def parse_fn(payload: str):
+        received_payloads.put(payload)
+        return (HTTPStatus.CREATED.value, MimeTypes.TEXT.value, "", None)
+
+    df = dataset.get_df('azure_ad_logs.json', no_cache=True, parser_kwargs={'lines': False})
+    max_rows_per_payload = 5
+
+    stage = HttpClientSinkStage(config,
+                                base_url="http://127.0.0.1:8089",
+                                endpoint="/data",
+                                lines=lines,
+                                max_rows_per_payload=max_rows_per_payload,
+                                max_connections=max_connections)
+    assert stage.supports_cpp_node()
+
+    with HttpServer(parse_fn=parse_fn, port=8089, endpoint="/data", num_threads=2):
+        pipe = LinearPipeline(config)
+        pipe.set_source(InMemorySourceStage(config, [df]))
+        pipe.add_stage(stage)
+        pipe.run()
+
+    payloads = []
+    while not received_payloads.empty():
+        payloads.append(received_payloads.get())
+
+    assert len(payloads) == math.ceil(len(df) / max_rows_per_payload)
+
+    # Payloads are sent concurrently and may arrive out of order
+    received_df = pd.concat([pd.read_json(StringIO(payload), lines=lines) for payload in payloads])
+    received_df = received_df.sort_values("correlationId").reset_index(drop=True)
+    expected_df = df.to_pandas().sort_values("correlationId").reset_index(drop=True)
+
+    assert len(received_df) == len(expected_df)
+    assert list(received_df["correlationId"]) == list(expected_df["correlationId"])
@@ -33,6 +33,7 @@ from morpheus.config import Config
 from morpheus.messages import MultiMessage
 from morpheus.messages.message_meta import MessageMeta
 from morpheus.pipeline import LinearPipeline
+from morpheus.stages.output.in_memory_sink_stage import InMemorySinkStage
 from morpheus.stages.general.monitor_stage import MonitorStage
 from morpheus.stages.input.file_source_stage import FileSourceStage
 from morpheus.utils.logger import set_log_level
@@ -207,3 +208,29 @@ def test_thread(config: Config):
 
     # Check that the thread ids are the same
     assert dummy_stage.thread_id == monitor_thread_id
+
+
+@pytest.mark.usefixtures("reset_loglevel")
+@pytest.mark.use_cpp
+def test_native_monitor(config: Config):
+    """
+    Test the C++ monitor stage passes messages through and publishes the counts to the metrics
+    """
+    import morpheus._lib.common as _common
+
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+
+    set_log_level(log_level=logging.INFO)
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(FileSourceStage(config, filename=input_file))
+    monitor = pipe.add_stage(MonitorStage(config, description="test_native_monitor", native=True))
+    sink = pipe.add_stage(InMemorySinkStage(config))
+    pipe.run()
+
+    assert monitor._use_native_node
+    assert len(sink.get_messages()) == 1
+
+    metrics = _common.serialize_metrics().splitlines()
+    assert 'morpheus_monitor_messages_total{description="test_native_monitor"} 1' in metrics
+    assert 'morpheus_monitor_rows_total{description="test_native_monitor"} 20' in metrics
@@ -0,0 +1,103 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import cupy as cp
+import pytest
+
+import cudf
+
+from _utils.stages.conv_msg import ConvMsg
+from morpheus.common import TypeId
+from morpheus.config import Config
+from morpheus.messages import MultiResponseMessage
+from morpheus.messages.memory.tensor_memory import TensorMemory
+from morpheus.messages.message_meta import MessageMeta
+from morpheus.pipeline import LinearPipeline
+from morpheus.stages.input.in_memory_source_stage import InMemorySourceStage
+from morpheus.stages.output.in_memory_sink_stage import InMemorySinkStage
+from morpheus.stages.postprocess.normalize_embeddings_stage import NormalizeEmbeddingsStage
+from morpheus.stages.preprocess.deserialize_stage import DeserializeStage
+
+
+def test_constructor_errors(config: Config):
+    with pytest.raises(ValueError):
+        NormalizeEmbeddingsStage(config, output_type=TypeId.INT32)
+
+
+@pytest.mark.use_python
+def test_normalize_embeddings(config: Config):
+    df = cudf.DataFrame({"dummy": [0, 1, 2]})
+    embeddings = cp.array([[3.0, 4.0], [0.0, 0.0], [1.0, 0.0]], dtype=cp.float32)
+
+    message = MultiResponseMessage(meta=MessageMeta(df),
+                                   memory=TensorMemory(count=3, tensors={"probs": embeddings}),
+                                   offset=1,
+                                   count=2,
+                                   mess_offset=1,
+                                   mess_count=2)
+
+    stage = NormalizeEmbeddingsStage(config)
+    output = stage._normalize_embeddings(message)
+
+    probs = output.get_probs_tensor()
+    assert probs.dtype == cp.float16
+    assert probs.flags.c_contiguous
+    cp.testing.assert_array_equal(probs, cp.array([[0.0, 0.0], [1.0, 0.0]], dtype=cp.float16))
+
+    assert output.mess_offset == 1
+    assert output.mess_count == 2
+
+
+def test_normalize_embeddings_pipe(config: Config):
+    config.class_labels = ["a", "b", "c", "d"]
+
+    df = cudf.DataFrame({"dummy": range(5)})
+    probs = cudf.DataFrame({label: cp.arange(5, dtype=cp.float32) + i for i, label in enumerate(config.class_labels)})
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(InMemorySourceStage(config, [df]))
+    pipe.add_stage(DeserializeStage(config))
+    pipe.add_stage(ConvMsg(config, probs))
+    pipe.add_stage(NormalizeEmbeddingsStage(config, output_type=TypeId.FLOAT32))
+    sink = pipe.add_stage(InMemorySinkStage(config))
+    pipe.run()
+
+    embeddings = cp.concatenate([message.get_probs_tensor() for message in sink.get_messages()])
+    expected = probs.values / cp.linalg.norm(probs.values, axis=1, keepdims=True)
+
+    assert embeddings.dtype == cp.float32
+    cp.testing.assert_allclose(embeddings, expected, rtol=1e-6)
+
+
+def test_normalize_embeddings_pipe_missing_tensor(config: Config):
+    config.class_labels = ["a", "b"]
+
+    df = cudf.DataFrame({"dummy": range(5)})
+    probs = cudf.DataFrame({label: cp.arange(5, dtype=cp.float32) for label in config.class_labels})
+
+    # The messages only hold a `probs` tensor, the error stops the pipeline rather than the message being dropped
+    pipe = LinearPipeline(config)
+    pipe.set_source(InMemorySourceStage(config, [df]))
+    pipe.add_stage(DeserializeStage(config))
+    pipe.add_stage(ConvMsg(config, probs))
+    pipe.add_stage(NormalizeEmbeddingsStage(config, tensor_name="embeddings"))
+    sink = pipe.add_stage(InMemorySinkStage(config))
+
+    # The Python implementation raises a KeyError, the C++ implementation a RuntimeError
+    with pytest.raises((KeyError, RuntimeError)):
+        pipe.run()
+
+    assert len(sink.get_messages()) == 0
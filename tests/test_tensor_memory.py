@@ -23,6 +23,7 @@ import numpy as np
 import pytest
 
 from _utils import TEST_DIRS
+from morpheus._lib.common import Tensor
 from morpheus.config import Config
 from morpheus.messages.memory.inference_memory import InferenceMemory
 from morpheus.messages.memory.inference_memory import InferenceMemoryAE
@@ -238,3 +239,48 @@ def test_tensor_update(config: Config):
     for (key, cp_arr) in new_tensors.items():
         tensor = tensor_memory.get_tensor(key)
         cp.allclose(tensor, cp_arr)
+
+
+@pytest.mark.parametrize("dtype", [cp.float32, cp.float64, cp.int32, cp.uint8, cp.bool_])
+def test_tensor_dlpack_round_trip(dtype: type):
+    array = cp.arange(12).reshape(3, 4).astype(dtype)
+
+    tensor = Tensor.from_cupy(array)
+    assert tensor.__dlpack_device__() == (2, cp.cuda.runtime.getDevice())
+
+    # from_cupy copies the array, to_cupy does not copy the tensor
+    round_trip = tensor.to_cupy()
+    assert round_trip.data.ptr != array.data.ptr
+    assert round_trip.data.ptr == tensor.to_cupy().data.ptr
+    assert round_trip.dtype == array.dtype
+    cp.testing.assert_array_equal(round_trip, array)
+
+    from_dlpack = cp.from_dlpack(tensor)
+    assert from_dlpack.data.ptr == round_trip.data.ptr
+
+
+def test_tensor_dlpack_strided():
+    array = cp.arange(24, dtype=cp.float32).reshape(4, 6)[::2, 1::2]
+    assert not array.flags.c_contiguous
+
+    round_trip = Tensor.from_cupy(array).to_cupy()
+    assert round_trip.shape == array.shape
+    cp.testing.assert_array_equal(round_trip, array)
+
+
+def test_tensor_accessors(config: Config):
+    tensors = {"probs": cp.random.rand(5, 2).astype(cp.float32), "seq_ids": cp.zeros((5, 3), dtype=cp.int32)}
+    mem = TensorMemory(count=5, tensors=tensors)
+
+    assert mem.get_tensor_shape("probs") == [5, 2]
+    assert mem.get_tensor_shape("seq_ids") == [5, 3]
+    assert mem.get_tensor_dtype("probs") == "<f4"
+    assert mem.get_tensor_dtype("seq_ids") == "<i4"
+
+    tensor = mem.get_tensor_object("probs")
+    cp.testing.assert_array_equal(cp.asarray(tensor), tensors["probs"])
+    cp.testing.assert_array_equal(cp.from_dlpack(tensor), tensors["probs"])
+
+    for accessor in (mem.get_tensor_object, mem.get_tensor_shape, mem.get_tensor_dtype):
+        with pytest.raises(KeyError):
+            accessor("missing")
@@ -149,6 +149,36 @@ def test_stage_get_inference_worker(config: Config, pipeline_mode: PipelineModes
     assert worker.needs_logits == expexted_needs_logits
 
 
+@pytest.mark.use_python
+def test_stage_fan_out_models(config: Config):
+    config.mode = PipelineModes.NLP
+
+    stage = TritonInferenceStage(config,
+                                 model_name='cls',
+                                 server_url='test:0000',
+                                 fan_out_models={
+                                     'ner': {}, 'lang': {
+                                         'output': 'lang_scores'
+                                     }, 'pii': 'sensitive'
+                                 })
+
+    assert stage._fan_out_models == {
+        'ner': {
+            'output': 'ner_probs'
+        }, 'lang': {
+            'output': 'lang_scores'
+        }, 'pii': {
+            'output': 'sensitive_probs'
+        }
+    }
+
+    with pytest.raises(NotImplementedError):
+        stage._get_inference_worker(ProducerConsumerQueue())
+
+    with pytest.raises(ValueError):
+        TritonInferenceStage(config, model_name='cls', server_url='test:0000', fan_out_models={'cls': {}})
+
+
 @pytest.mark.slow
 @pytest.mark.use_python
 @pytest.mark.parametrize('num_records', [1000, 2000, 4000])
@@ -27,6 +27,7 @@ from morpheus.config import Config
 from morpheus.pipeline.linear_pipeline import LinearPipeline
 from morpheus.stages.input.in_memory_source_stage import InMemorySourceStage
 from morpheus.stages.output.write_to_elasticsearch_stage import WriteToElasticsearchStage
+from morpheus.stages.output.write_to_elasticsearch_stage import _cpp_connection_args
 
 
 def connection_kwargs_func(kwargs):
@@ -103,3 +104,35 @@ def test_write_to_elasticsearch_stage_pipe(mock_controller: typing.Any,
 
     assert expected_index == "t_index"
     assert expected_df.equals(filter_probs_df)
+
+
+@pytest.mark.parametrize(
+    "connection_kwargs, expected",
+    [({
+        "hosts": [{
+            "host": "localhost", "port": 9201, "scheme": "http"
+        }]
+    }, {
+        "host": "localhost", "port": 9201, "headers": {}
+    }),
+     ({
+         "hosts": "http://es:9200", "basic_auth": ["user", "pass"], "retry_on_status": 3
+     }, {
+         "host": "es", "port": 9200, "headers": {
+             "Authorization": "Basic dXNlcjpwYXNz"
+         }
+     }), ({
+         "hosts": ["http://es"], "api_key": ["id", "key"]
+     }, {
+         "host": "es", "port": 9200, "headers": {
+             "Authorization": "ApiKey aWQ6a2V5"
+         }
+     }), ({
+         "hosts": ["https://es:9200"]
+     }, None), ({
+         "hosts": ["http://es1:9200", "http://es2:9200"]
+     }, None), ({
+         "hosts": ["http://es:9200"], "ca_certs": "/certs/ca.crt"
+     }, None)])
+def test_cpp_connection_args(connection_kwargs: dict, expected: typing.Optional[dict]):
+    assert _cpp_connection_args(connection_kwargs) == expected
@@ -17,6 +17,7 @@
 import os
 from unittest import mock
 
+import pandas as pd
 import pytest
 
 from _utils import TEST_DIRS
@@ -46,3 +47,69 @@ def test_file_rw_pipe(tmp_path: str, config: Config, output_type: str, flush: bo
 
     assert not os.path.exists(out_file)
     assert mock_open().flush.called == flush
+
+
+@pytest.mark.use_cpp
+@pytest.mark.parametrize("compression", ["none", "gzip"])
+def test_file_rw_async(tmp_path: str, config: Config, compression: str):
+    """
+    Test writing CSV files from the I/O thread of the C++ WriteToFileStage.
+    """
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+    out_file = os.path.join(tmp_path, 'results.csv')
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(FileSourceStage(config, filename=input_file))
+    pipe.add_stage(
+        WriteToFileStage(config,
+                         filename=out_file,
+                         overwrite=False,
+                         include_index_col=False,
+                         compression=compression,
+                         max_queued_writes=2))
+    pipe.run()
+
+    if compression == "gzip":
+        out_file += ".gz"
+
+    expected = pd.read_csv(input_file)
+    output = pd.read_csv(out_file, compression="infer")
+    pd.testing.assert_frame_equal(output, expected)
+
+
+@pytest.mark.use_cpp
+@pytest.mark.parametrize("shard_column", [None, "v1"])
+def test_file_rw_sharded(tmp_path: str, config: Config, shard_column: str):
+    """
+    Test splitting the output of the C++ WriteToFileStage across several files.
+    """
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+    out_file = os.path.join(tmp_path, 'results.csv')
+    num_shards = 3
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(FileSourceStage(config, filename=input_file, iterative=True))
+    pipe.add_stage(
+        WriteToFileStage(config,
+                         filename=out_file,
+                         overwrite=False,
+                         include_index_col=False,
+                         num_shards=num_shards,
+                         shard_column=shard_column))
+    pipe.run()
+
+    shard_files = [os.path.join(tmp_path, f'results.shard-{i}.csv') for i in range(num_shards)]
+    assert all(os.path.exists(shard_file) for shard_file in shard_files)
+
+    shards = [pd.read_csv(shard_file) for shard_file in shard_files if os.path.getsize(shard_file) > 0]
+
+    expected = pd.read_csv(input_file)
+    output = pd.concat(shards).sort_values(list(expected.columns)).reset_index(drop=True)
+    pd.testing.assert_frame_equal(output, expected.sort_values(list(expected.columns)).reset_index(drop=True))
+
+    if shard_column is not None:
+        # Equal values of the shard column always end up in the same file
+        shard_values = [set(shard[shard_column]) for shard in shards]
+        for (i, values) in enumerate(shard_values):
+            for other_values in shard_values[i + 1:]:
+                assert values.isdisjoint(other_values)
@@ -65,3 +65,18 @@ def test_write_to_kafka_stage_pipe(config,
     assert len(output_df) == len(filter_probs_df)
 
     dataset_cudf.assert_compare_df(filter_probs_df, output_df)
+
+
+def test_transactional_requires_transactional_id(config):
+    with pytest.raises(ValueError, match="transactional_id"):
+        WriteToKafkaStage(config,
+                          bootstrap_servers="localhost:9092",
+                          output_topic="output",
+                          consumer_group_id="morpheus")
+
+    stage = WriteToKafkaStage(config,
+                              bootstrap_servers="localhost:9092",
+                              output_topic="output",
+                              consumer_group_id="morpheus",
+                              transactional_id="morpheus-0")
+    assert stage._kafka_conf['transactional.id'] == "morpheus-0"
@@ -0,0 +1,88 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+import json
+import os
+import struct
+
+import pytest
+
+from morpheus.utils.trace_decoder import MAGIC
+from morpheus.utils.trace_decoder import decode
+from morpheus.utils.trace_decoder import decode_bytes
+from morpheus.utils.trace_decoder import main
+
+
+def _encode(names: list[str], records: list[tuple[int, int, int, tuple[int, int, int, int]]]) -> bytes:
+    data = MAGIC + struct.pack("<I", len(names))
+    for name in names:
+        data += struct.pack("<I", len(name)) + name.encode("utf-8")
+
+    data += struct.pack("<Q", len(records))
+    for (timestamp_ns, event, thread, args) in records:
+        data += struct.pack("<QII4q", timestamp_ns, event, thread, *args)
+
+    return data
+
+
+def test_decode_bytes():
+    data = _encode(["kafka.consume_batch", "http.request"], [(100, 0, 0, (10, 2, 0, 0)), (250, 1, 3, (-1, 0, 0, 7))])
+
+    records = decode_bytes(data)
+
+    assert len(records) == 2
+    assert records[0].timestamp_ns == 100
+    assert records[0].event == "kafka.consume_batch"
+    assert records[0].thread == 0
+    assert records[0].args == (10, 2, 0, 0)
+    assert records[1].event == "http.request"
+    assert records[1].thread == 3
+    assert records[1].args == (-1, 0, 0, 7)
+
+
+def test_decode_unknown_event():
+    records = decode_bytes(_encode([], [(1, 5, 0, (0, 0, 0, 0))]))
+    assert records[0].event == "<unknown 5>"
+
+
+def test_decode_errors():
+    with pytest.raises(ValueError, match="Not a Morpheus trace file"):
+        decode_bytes(b"NOTATRACE")
+
+    data = _encode(["event"], [(1, 0, 0, (0, 0, 0, 0))])
+    with pytest.raises(ValueError, match="Truncated"):
+        decode_bytes(data[:-1])
+
+
+def test_main_chrome(tmp_path: str, capsys: pytest.CaptureFixture):
+    path = os.path.join(tmp_path, "trace.bin")
+    with open(path, "wb") as f:
+        f.write(_encode(["event"], [(2000, 0, 1, (1, 2, 3, 4))]))
+
+    assert [record.event for record in decode(path)] == ["event"]
+
+    main([path, "--format", "chrome"])
+    trace = json.loads(capsys.readouterr().out)
+
+    assert trace["traceEvents"] == [{
+        "name": "event",
+        "ph": "i",
+        "s": "t",
+        "ts": 2.0,
+        "pid": 0,
+        "tid": 1,
+        "args": {
+            "arg0": 1, "arg1": 2, "arg2": 3, "arg3": 4
+        }
+    }]